@@ -69,11 +69,19 @@ extern "C" {
 #define NRF52840DK_NOR_PAGE_SIZE          (256)
 #define NRF52840DK_NOR_PAGES_PER_SECTOR   (16)
 #define NRF52840DK_NOR_SECTOR_COUNT       (2048)
+#ifdef MODULE_PERIPH_QSPI
+#define NRF52840DK_NOR_FLAGS              (SPI_NOR_F_SECT_4K | SPI_NOR_F_SECT_32K | \
+                                           SPI_NOR_F_QSPI | SPI_NOR_F_QE_SR_BIT6)
+#else
 #define NRF52840DK_NOR_FLAGS              (SPI_NOR_F_SECT_4K | SPI_NOR_F_SECT_32K)
+#endif
 #define NRF52840DK_NOR_SPI_DEV            SPI_DEV(1)
 #define NRF52840DK_NOR_SPI_CLK            SPI_CLK_10MHZ
 #define NRF52840DK_NOR_SPI_CS             GPIO_PIN(0, 17)
 #define NRF52840DK_NOR_SPI_MODE           SPI_MODE_0
+#define NRF52840DK_NOR_QSPI_DEV           QSPI_DEV(0)
+/* quad reads are limited to 8 MHz in the default ultra low power mode */
+#define NRF52840DK_NOR_QSPI_CLK           (8000000LU)
 /** @} */
 
 /** Default MTD device */
@@ -47,6 +47,27 @@ static const spi_conf_t spi_config[] = {
 #define SPI_NUMOF           ARRAY_SIZE(spi_config)
 /** @} */
 
+/**
+ * @name    QSPI configuration
+ *
+ * Connected to the on-board MX25R6435F, shares the pins with SPI_DEV(1)
+ * @{
+ */
+static const qspi_conf_t qspi_config[] = {
+    {
+        .sclk = GPIO_PIN(0, 19),
+        .csn  = GPIO_PIN(0, 17),
+        .io   = {
+            GPIO_PIN(0, 20),
+            GPIO_PIN(0, 21),
+            GPIO_PIN(0, 22),
+            GPIO_PIN(0, 23),
+        },
+    },
+};
+#define QSPI_NUMOF          ARRAY_SIZE(qspi_config)
+/** @} */
+
 /**
  * @name    UART configuration
  * @{
@@ -40,6 +40,10 @@ static const mtd_spi_nor_params_t _nrf52840dk_nor_params = {
     .mode = NRF52840DK_NOR_SPI_MODE,
     .cs = NRF52840DK_NOR_SPI_CS,
     .addr_width = 3,
+#ifdef MODULE_PERIPH_QSPI
+    .qspi = NRF52840DK_NOR_QSPI_DEV,
+    .qspi_clk = NRF52840DK_NOR_QSPI_CLK,
+#endif
 };
 
 static mtd_spi_nor_t nrf52840dk_nor_dev = {
@@ -40,6 +40,7 @@ static const dma_conf_t dma_config[] = {
     { .stream = 3 },    /* DMA1 Stream 3 - SPI2_RX */
     { .stream = 5 },    /* DMA1 Stream 5 - SPI3_TX */
     { .stream = 0 },    /* DMA1 Stream 0 - SPI3_RX */
+    { .stream = 8 },    /* DMA2 Stream 0 - ADC1 */
 };
 
 #define DMA_0_ISR           isr_dma2_stream3
@@ -48,6 +49,7 @@ static const dma_conf_t dma_config[] = {
 #define DMA_3_ISR           isr_dma1_stream3
 #define DMA_4_ISR           isr_dma1_stream5
 #define DMA_5_ISR           isr_dma1_stream0
+#define DMA_6_ISR           isr_dma2_stream0
 
 #define DMA_NUMOF           ARRAY_SIZE(dma_config)
 /** @} */
@@ -260,6 +262,18 @@ static const spi_conf_t spi_config[] = {
     {GPIO_PIN(PORT_C, 1), 0, 11}, \
     {GPIO_PIN(PORT_C, 0), 0, 10}, \
 }
+
+/**
+ * @brief   Continuous sampling of ADC1, triggered by TIM1 CC1
+ */
+#define ADC_CONTINUOUS_CONFIG {         \
+    .tim        = TIM1,                 \
+    .rcc_mask   = RCC_APB2ENR_TIM1EN,   \
+    .bus        = APB2,                 \
+    .extsel     = 0,                    \
+    .dma        = 6,                    \
+    .dma_chan   = 0,                    \
+}
 /** @} */
 
 #ifdef __cplusplus
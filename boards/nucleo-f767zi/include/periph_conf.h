@@ -40,12 +40,18 @@ static const dma_conf_t dma_config[] = {
     { .stream = 14 },   /* DMA2 Stream 6 - USART6_TX */
     { .stream = 6 },    /* DMA1 Stream 6 - USART2_TX */
     { .stream = 8 },    /* DMA2 Stream 0 - ETH_TX    */
+    { .stream = 1 },    /* DMA1 Stream 1 - USART3_RX */
+    { .stream = 9 },    /* DMA2 Stream 1 - USART6_RX */
+    { .stream = 5 },    /* DMA1 Stream 5 - USART2_RX */
 };
 
 #define DMA_0_ISR  isr_dma1_stream4
 #define DMA_1_ISR  isr_dma2_stream6
 #define DMA_2_ISR  isr_dma1_stream6
 #define DMA_3_ISR  isr_dma2_stream0
+#define DMA_4_ISR  isr_dma1_stream1
+#define DMA_5_ISR  isr_dma2_stream1
+#define DMA_6_ISR  isr_dma1_stream5
 
 #define DMA_NUMOF           ARRAY_SIZE(dma_config)
 /** @} */
@@ -66,7 +72,11 @@ static const uart_conf_t uart_config[] = {
         .irqn       = USART3_IRQn,
 #ifdef MODULE_PERIPH_DMA
         .dma        = 0,
-        .dma_chan   = 7
+        .dma_chan   = 7,
+#endif
+#ifdef MODULE_PERIPH_UART_DMA
+        .rx_dma     = 4,
+        .rx_dma_chan = 4,
 #endif
     },
     {
@@ -80,7 +90,11 @@ static const uart_conf_t uart_config[] = {
         .irqn       = USART6_IRQn,
 #ifdef MODULE_PERIPH_DMA
         .dma        = 1,
-        .dma_chan   = 5
+        .dma_chan   = 5,
+#endif
+#ifdef MODULE_PERIPH_UART_DMA
+        .rx_dma     = 5,
+        .rx_dma_chan = 5,
 #endif
     },
     {
@@ -94,7 +108,11 @@ static const uart_conf_t uart_config[] = {
         .irqn       = USART2_IRQn,
 #ifdef MODULE_PERIPH_DMA
         .dma        = 2,
-        .dma_chan   = 4
+        .dma_chan   = 4,
+#endif
+#ifdef MODULE_PERIPH_UART_DMA
+        .rx_dma     = 6,
+        .rx_dma_chan = 4,
 #endif
     }
 };
@@ -22,16 +22,21 @@
  */
 
 #include "cpu.h"
+#include "kernel_defines.h"
 #include "panic.h"
 #include "riotboot/slot.h"
 
-void kernel_init(void)
+/* select the newest bootable slot that is not in @p skip */
+static int _select_slot(unsigned skip)
 {
     uint32_t version = 0;
     int slot = -1;
 
     for (unsigned i = 0; i < riotboot_slot_numof; i++) {
         const riotboot_hdr_t *riot_hdr = riotboot_slot_get_hdr(i);
+        if (skip & (1U << i)) {
+            continue;
+        }
         if (riotboot_slot_validate(i)) {
             /* skip slot if metadata broken */
             continue;
@@ -45,8 +50,21 @@ void kernel_init(void)
         }
     }
 
-    if (slot != -1) {
-        riotboot_slot_jump(slot);
+    return slot;
+}
+
+void kernel_init(void)
+{
+    unsigned rejected = 0;
+    int slot;
+
+    /* only hash the image that is about to be booted, fall back to older
+     * images if it is corrupted */
+    while ((slot = _select_slot(rejected)) != -1) {
+        if (!IS_USED(MODULE_RIOTBOOT_VERIFY) || !riotboot_slot_verify(slot)) {
+            riotboot_slot_jump(slot);
+        }
+        rejected |= 1U << slot;
     }
 
     /* serious trouble! nothing to boot */
@@ -98,6 +98,33 @@ extern "C" {
 #define PURE
 #endif
 
+/**
+ * @def RAMFUNC
+ * @brief The function is copied to RAM on startup and executed from there.
+ *        Only for CPUs that provide the feature `ramfunc`, i.e. whose linker
+ *        script relocates the `.ramfunc` section.
+ */
+#ifdef __GNUC__
+#define RAMFUNC  __attribute__((section(".ramfunc"), noinline))
+#else
+#define RAMFUNC
+#endif
+
+/**
+ * @def RAMFUNC_HOT
+ * @brief The function is on the hot path of scheduling, IPC or interrupt
+ *        handling. With module `ramfunc_hot`, it is a #RAMFUNC, so that it
+ *        does not stall on flash wait states or cache misses, which also makes
+ *        its timing deterministic. Whether this is faster depends on the CPU,
+ *        a flash accelerator may keep up with SRAM on the system bus. Does
+ *        not work with module `mpu_noexec_ram`.
+ */
+#ifdef MODULE_RAMFUNC_HOT
+#define RAMFUNC_HOT  RAMFUNC
+#else
+#define RAMFUNC_HOT
+#endif
+
 /**
  * @def       UNREACHABLE()
  * @brief     Tell the compiler that this line of code cannot be reached.
@@ -24,7 +24,9 @@
  * 2. have a name starting with "log_" *or* depend on the pseudo-module LOG,
  * 3. implement log_write()
  *
- * See "sys/log/log_printfnoformat" for an example.
+ * See "sys/log/log_printfnoformat" for an example. "sys/log/log_deferred"
+ * moves formatting and printing out of the caller's context into a low
+ * priority thread.
  *
  * @author      Kaspar Schleiser <kaspar@schleiser.de>
  */
@@ -25,6 +25,7 @@
 #include "list.h"
 #include "cib.h"
 #include "msg.h"
+#include "sched.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -32,7 +33,8 @@ extern "C" {
 
 /** Static initializer for mbox objects */
 #define MBOX_INIT(queue, queue_size) { \
-        { 0 }, { 0 }, CIB_INIT(queue_size), queue \
+        .readers = { 0 }, .writers = { 0 }, .cib = CIB_INIT(queue_size), \
+        .msg_array = queue \
 }
 
 /**
@@ -43,6 +45,10 @@ typedef struct {
     list_node_t writers;    /**< list of threads waiting to send        */
     cib_t cib;              /**< cib for msg array                      */
     msg_t *msg_array;       /**< ptr to array of msg queue              */
+#if defined(MODULE_CORE_MSG_SELECT) || defined(DOXYGEN)
+    thread_t *select_waiter;    /**< thread blocked in msg_select() on
+                                     this mailbox                       */
+#endif
 } mbox_t;
 
 enum {
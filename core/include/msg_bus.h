@@ -32,14 +32,40 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Number of subscribers @ref msg_send_bus handles with interrupts
+ *          disabled
+ *
+ * Interrupts are enabled briefly after that many subscribers, so the
+ * interrupt latency does not grow with the number of subscribers of a bus.
+ * Must be greater than 0.
+ */
+#ifndef CONFIG_MSG_BUS_IRQ_BATCH
+#define CONFIG_MSG_BUS_IRQ_BATCH    (4U)
+#endif
+
 /**
  * @brief A message bus is just a list of subscribers.
  */
 typedef struct {
     list_node_t subs;       /**< List of subscribers to the bus */
+    list_node_t walks;      /**< Posts in progress, internal */
     uint16_t id;            /**< Message Bus ID */
 } msg_bus_t;
 
+/**
+ * @brief   Position of a post in progress in the list of subscribers
+ *
+ * Lets @ref msg_bus_detach move a post past an entry that is detached while
+ * interrupts are enabled in between subscribers.
+ *
+ * @internal
+ */
+typedef struct {
+    list_node_t node;       /**< next post in progress */
+    list_node_t *pos;       /**< next subscriber to visit */
+} msg_bus_walk_t;
+
 /**
  * @brief Message bus subscriber entry.
  *        Should not be modified by the user.
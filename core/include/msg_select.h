@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    core_msg_select Waiting on multiple message sources
+ * @ingroup     core
+ * @brief       Block on a set of mailboxes, the thread's message queue and
+ *              thread flags at the same time
+ *
+ * msg_select() returns as soon as any of the given sources is ready, so a
+ * thread serving several mailboxes does not need to poll or use helper
+ * threads forwarding messages.
+ *
+ * It is built on @ref core_thread_flags: while a thread waits in
+ * msg_select(), putting a message into one of the mailboxes sets
+ * @ref THREAD_FLAG_MSG_WAITING for it, just like queueing a message into
+ * its message queue does.
+ *
+ * A mailbox can only be waited on by one selecting thread at a time.
+ *
+ * This API is optional and must be enabled by adding "core_msg_select" to
+ * USEMODULE.
+ *
+ * @{
+ *
+ * @file
+ * @brief       msg_select() API
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+
+#ifndef MSG_SELECT_H
+#define MSG_SELECT_H
+
+#include "mbox.h"
+#include "msg.h"
+#include "thread_flags.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Return value of msg_select() for a message from the thread's
+ *          own message queue
+ */
+#define MSG_SELECT_QUEUE        (-1)
+
+/**
+ * @brief   Return value of msg_select() if thread flags were set
+ */
+#define MSG_SELECT_FLAGS        (-2)
+
+/**
+ * @brief   Wait for the first of several message sources to become ready
+ *
+ * Sources are checked in the order: thread flags, mailboxes in array order,
+ * thread message queue. Exactly one event is consumed per call.
+ *
+ * @pre     @p mask does not contain @ref THREAD_FLAG_MSG_WAITING
+ * @pre     if messages are expected in the thread's own message queue, the
+ *          queue was initialized with msg_init_queue()
+ *
+ * @param[in] mboxes    mailboxes to wait on, may be NULL if @p numof is 0
+ * @param[in] numof     number of entries in @p mboxes
+ * @param[in] mask      thread flags to wait for, may be 0
+ * @param[out] msg      received message
+ * @param[out] flags    thread flags that were set and have been cleared,
+ *                      may be NULL if @p mask is 0
+ *
+ * @return  index into @p mboxes of the mailbox @p msg was taken from
+ * @return  @ref MSG_SELECT_QUEUE if @p msg came from the thread's message
+ *          queue
+ * @return  @ref MSG_SELECT_FLAGS if any flag of @p mask was set, @p msg is
+ *          untouched
+ */
+int msg_select(mbox_t *const *mboxes, unsigned numof, thread_flags_t mask,
+               msg_t *msg, thread_flags_t *flags);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MSG_SELECT_H */
+/** @} */
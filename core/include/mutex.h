@@ -16,6 +16,18 @@
  * @file
  * @brief       Mutex for thread synchronization
  *
+ * With module `core_mutex_priority_inheritance`, a thread holding a mutex
+ * temporarily inherits the priority of the highest priority thread blocking
+ * on that mutex, until it unlocks the mutex again. This bounds the time a
+ * high priority thread waits for a low priority thread holding the mutex,
+ * when threads of medium priority would otherwise keep the owner from
+ * running (priority inversion).
+ *
+ * The inheritance is not transitive: if the owner is itself blocked on
+ * another mutex, the owner of that mutex is not boosted. Threads holding
+ * several mutexes at once should unlock them in reverse locking order, as
+ * every unlock restores the priority the owner had when locking.
+ *
  * @author      Kaspar Schleiser <kaspar@schleiser.de>
  */
 
@@ -25,6 +37,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "kernel_types.h"
 #include "list.h"
 
 #ifdef __cplusplus
@@ -41,18 +54,47 @@ typedef struct {
      * @internal
      */
     list_node_t queue;
+#if defined(MODULE_CORE_MUTEX_PRIORITY_INHERITANCE) || defined(DOXYGEN)
+    /**
+     * @brief   The thread holding the mutex
+     *
+     * @note    Only available with module `core_mutex_priority_inheritance`
+     * @internal
+     */
+    kernel_pid_t owner;
+    /**
+     * @brief   Priority of mutex_t::owner when it locked the mutex
+     *
+     * @note    Only available with module `core_mutex_priority_inheritance`
+     * @internal
+     */
+    uint8_t owner_original_priority;
+#endif
 } mutex_t;
 
+/**
+ * @cond INTERNAL
+ * @brief Static initializer for the members following mutex_t::queue
+ */
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+#define MUTEX_INIT_OWNER , KERNEL_PID_UNDEF, 0
+#else
+#define MUTEX_INIT_OWNER
+#endif
+/**
+ * @endcond
+ */
+
 /**
  * @brief Static initializer for mutex_t.
  * @details This initializer is preferable to mutex_init().
  */
-#define MUTEX_INIT { { NULL } }
+#define MUTEX_INIT { { NULL } MUTEX_INIT_OWNER }
 
 /**
  * @brief Static initializer for mutex_t with a locked mutex
  */
-#define MUTEX_INIT_LOCKED { { MUTEX_LOCKED } }
+#define MUTEX_INIT_LOCKED { { MUTEX_LOCKED } MUTEX_INIT_OWNER }
 
 /**
  * @cond INTERNAL
@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     core_util
+ * @{
+ *
+ * @file
+ * @brief       Intrusive priority heap
+ *
+ * A pairing heap with the same ordering as @ref priority_queue_t: the
+ * lowest priority value comes first, nodes of the same priority in the order
+ * they were added. Adding a node is O(1) and removing the head O(log n)
+ * amortized, where @ref priority_queue_t needs O(n) to add.
+ *
+ * The first fields of @ref priority_heap_node_t match
+ * @ref priority_queue_node_t, so structs laid out for one can be used with
+ * the other by appending the remaining fields.
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+
+#ifndef PRIORITY_HEAP_H
+#define PRIORITY_HEAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief data type for priority heap nodes
+ */
+typedef struct priority_heap_node {
+    struct priority_heap_node *next;    /**< next sibling */
+    uint32_t priority;                  /**< heap node priority */
+    unsigned int data;                  /**< heap node data */
+    struct priority_heap_node *child;   /**< first child */
+    struct priority_heap_node *prev;    /**< previous sibling, the parent
+                                             for the first child */
+    uint32_t seq;                       /**< order of addition */
+} priority_heap_node_t;
+
+/**
+ * @brief data type for priority heaps
+ */
+typedef struct {
+    priority_heap_node_t *root;         /**< head of the heap */
+    unsigned numof;                     /**< number of nodes */
+    uint32_t seq;                       /**< order of the next node added */
+} priority_heap_t;
+
+/**
+ * @brief Static initializer for priority_heap_node_t.
+ */
+#define PRIORITY_HEAP_NODE_INIT { NULL, 0, 0, NULL, NULL, 0 }
+
+/**
+ * @brief   Initialize a priority heap node object.
+ * @details For initialization of variables use PRIORITY_HEAP_NODE_INIT
+ *          instead. Only use this function for dynamically allocated
+ *          priority heap nodes.
+ * @param[out] node
+ *          pre-allocated priority_heap_node_t object, must not be NULL.
+ */
+static inline void priority_heap_node_init(priority_heap_node_t *node)
+{
+    priority_heap_node_t n = PRIORITY_HEAP_NODE_INIT;
+
+    *node = n;
+}
+
+/**
+ * @brief Static initializer for priority_heap_t.
+ */
+#define PRIORITY_HEAP_INIT { NULL, 0, 0 }
+
+/**
+ * @brief   Initialize a priority heap object.
+ * @details For initialization of variables use PRIORITY_HEAP_INIT
+ *          instead. Only use this function for dynamically allocated
+ *          priority heaps.
+ * @param[out] heap
+ *          pre-allocated priority_heap_t object, must not be NULL.
+ */
+static inline void priority_heap_init(priority_heap_t *heap)
+{
+    priority_heap_t h = PRIORITY_HEAP_INIT;
+
+    *heap = h;
+}
+
+/**
+ * @brief get the head of the heap without removing it
+ *
+ * @param[in]   heap    the heap
+ *
+ * @return              the node with the lowest priority value, NULL if the
+ *                      heap is empty
+ */
+static inline priority_heap_node_t *priority_heap_head(const priority_heap_t *heap)
+{
+    return heap->root;
+}
+
+/**
+ * @brief remove the priority heap's head
+ *
+ * @param[in,out]   heap    the heap
+ *
+ * @return              the old head, NULL if the heap is empty
+ */
+priority_heap_node_t *priority_heap_remove_head(priority_heap_t *heap);
+
+/**
+ * @brief add `node` to `heap` based on its priority
+ *
+ * @details
+ * The node will be removed after nodes with the same priority that were
+ * added before.
+ *
+ * @param[in,out]   heap    the heap
+ * @param[in]       node    the node to add, `priority` must be set
+ *
+ * @pre The heap does not already contain @p node.
+ */
+void priority_heap_add(priority_heap_t *heap, priority_heap_node_t *node);
+
+/**
+ * @brief remove `node` from `heap`
+ *
+ * @param[in,out]   heap    the heap
+ * @param[in]       node    the node to remove
+ *
+ * @pre The heap contains @p node.
+ */
+void priority_heap_remove(priority_heap_t *heap, priority_heap_node_t *node);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+#endif /* PRIORITY_HEAP_H */
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    core_sync_rwlock Reader-writer lock
+ * @ingroup     core_sync
+ * @brief       Lock allowing concurrent readers or one exclusive writer
+ *
+ * Read-mostly data can be protected with an rwlock_t instead of a mutex, so
+ * that readers do not serialize behind each other. Waiting writers take
+ * precedence over new readers, so writers cannot starve.
+ *
+ * The lock is not recursive, and it must not be used from interrupt
+ * context.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Reader-writer lock
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+
+#ifndef RWLOCK_H
+#define RWLOCK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "cond.h"
+#include "mutex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Reader-writer lock structure. Must never be modified by the user.
+ */
+typedef struct {
+    mutex_t mutex;              /**< protects the fields below */
+    cond_t readers_cv;          /**< readers wait here for writers */
+    cond_t writers_cv;          /**< writers wait here for the lock */
+    uint16_t readers;           /**< number of active readers */
+    uint8_t writers_waiting;    /**< number of blocked writers */
+    bool writer;                /**< a writer holds the lock */
+} rwlock_t;
+
+/**
+ * @brief   Static initializer for rwlock_t
+ */
+#define RWLOCK_INIT { MUTEX_INIT, COND_INIT, COND_INIT, 0, 0, false }
+
+/**
+ * @brief   Initialize a reader-writer lock
+ *
+ * For initialization of variables use RWLOCK_INIT instead.
+ *
+ * @param[out] lock     lock to initialize
+ */
+static inline void rwlock_init(rwlock_t *lock)
+{
+    rwlock_t empty = RWLOCK_INIT;
+
+    *lock = empty;
+}
+
+/**
+ * @brief   Acquire the lock for reading, blocking
+ *
+ * @param[in] lock      lock to acquire
+ */
+void rwlock_read_lock(rwlock_t *lock);
+
+/**
+ * @brief   Try to acquire the lock for reading, non-blocking
+ *
+ * @param[in] lock      lock to acquire
+ *
+ * @return  true if the lock was acquired for reading
+ * @return  false if a writer holds or waits for the lock
+ */
+bool rwlock_read_trylock(rwlock_t *lock);
+
+/**
+ * @brief   Release the lock acquired for reading
+ *
+ * @param[in] lock      lock to release
+ */
+void rwlock_read_unlock(rwlock_t *lock);
+
+/**
+ * @brief   Acquire the lock for writing, blocking
+ *
+ * @param[in] lock      lock to acquire
+ */
+void rwlock_write_lock(rwlock_t *lock);
+
+/**
+ * @brief   Try to acquire the lock for writing, non-blocking
+ *
+ * @param[in] lock      lock to acquire
+ *
+ * @return  true if the lock was acquired for writing
+ * @return  false if the lock is held
+ */
+bool rwlock_write_trylock(rwlock_t *lock);
+
+/**
+ * @brief   Release the lock acquired for writing
+ *
+ * @param[in] lock      lock to release
+ */
+void rwlock_write_unlock(rwlock_t *lock);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RWLOCK_H */
+/** @} */
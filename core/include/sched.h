@@ -162,6 +162,34 @@ void sched_set_status(thread_t *process, thread_status_t status);
  */
 void sched_switch(uint16_t other_prio);
 
+/**
+ * @brief   Request a context switch for a thread that was just set pending
+ *
+ * Sets @ref sched_context_switch_request. With module
+ * `core_sched_fast_switch`, the request is only set if a thread of priority
+ * @p other_prio preempts the active thread, so the return from interrupt
+ * skips the scheduler pass (on Cortex-M, PendSV and sched_run()) that would
+ * not change the active thread anyway.
+ *
+ * Must be called with interrupts disabled.
+ *
+ * @param[in]   other_prio      The priority of the woken thread.
+ */
+void sched_request_switch(uint16_t other_prio);
+
+/**
+ * @brief   Change the priority of a thread
+ *
+ * If the thread is on the run queue, it is moved to the end of the run queue
+ * of its new priority. Does not yield; call @ref sched_switch or
+ * thread_yield_higher() afterwards if the change might require a context
+ * switch.
+ *
+ * @param[in]   thread      Thread to change the priority of
+ * @param[in]   priority    New priority of @p thread
+ */
+void sched_change_priority(thread_t *thread, uint8_t priority);
+
 /**
  * @brief   Call context switching at thread exit
  */
@@ -236,8 +264,70 @@ typedef void (*sched_callback_t)(kernel_pid_t active, kernel_pid_t next);
  * @param[in] callback The callback functions that will be called
  */
 void sched_register_cb(sched_callback_t callback);
+
+/**
+ * @brief   Thread status change callback
+ *
+ * Called by @ref sched_set_status with interrupts disabled, so it must be
+ * short.
+ *
+ * @param   pid         Pid of the thread changing its status
+ * @param   old_status  Status of the thread before the change
+ * @param   new_status  Status of the thread after the change
+ */
+typedef void (*sched_status_callback_t)(kernel_pid_t pid,
+                                        thread_status_t old_status,
+                                        thread_status_t new_status);
+
+/**
+ * @brief  Register a callback that will be called on every thread status
+ *         change made with @ref sched_set_status
+ *
+ * @param[in] callback The callback functions that will be called
+ */
+void sched_register_status_cb(sched_status_callback_t callback);
 #endif /* MODULE_SCHED_CB */
 
+#if defined(MODULE_SCHED_EDF) || defined(DOXYGEN)
+/**
+ * @brief   Context switch hook of the EDF scheduling class
+ *
+ * @internal
+ *
+ * Implemented by @ref sys_sched_edf, called by @ref sched_run with
+ * interrupts disabled.
+ *
+ * @param[in] active    thread switched away from, may be NULL
+ * @param[in] next      thread switched to
+ */
+void sched_edf_switch(thread_t *active, thread_t *next);
+#endif
+
+#if defined(MODULE_SCHED_ROUND_ROBIN) || defined(DOXYGEN)
+/**
+ * @brief   Context switch hook of @ref sys_sched_round_robin
+ *
+ * @internal
+ *
+ * Called by @ref sched_run with interrupts disabled.
+ *
+ * @param[in] next      thread switched to
+ */
+void sched_round_robin_switch(thread_t *next);
+
+/**
+ * @brief   Run queue hook of @ref sys_sched_round_robin
+ *
+ * @internal
+ *
+ * Called by @ref sched_set_status with interrupts disabled, after
+ * @p thread has been added to its run queue.
+ *
+ * @param[in] thread    thread that became runnable
+ */
+void sched_round_robin_runnable(thread_t *thread);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
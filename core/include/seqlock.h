@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    core_sync_seqlock Sequence lock
+ * @ingroup     core_sync
+ * @brief       Lock-free reads of small, rarely written data
+ *
+ * Readers never block writers and do not write to shared memory. They
+ * copy the protected data and retry if a writer was active in between:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * unsigned seq;
+ * do {
+ *     seq = seqlock_read_begin(&lock);
+ *     copy = shared;
+ * } while (seqlock_read_retry(&lock, seq));
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Writers are serialized by a mutex. A reader finding a write in progress
+ * blocks on that mutex, so a preempted lower priority writer can finish.
+ * Hence the read side must not be used from interrupt context.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Sequence lock
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+#include <stdbool.h>
+
+#include "mutex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Sequence lock structure. Must never be modified by the user.
+ */
+typedef struct {
+    mutex_t writer;             /**< serializes writers */
+    volatile unsigned seq;      /**< odd while a write is in progress */
+} seqlock_t;
+
+/**
+ * @brief   Static initializer for seqlock_t
+ */
+#define SEQLOCK_INIT { MUTEX_INIT, 0 }
+
+/**
+ * @brief   Compiler barrier ordering the data accesses against `seq`
+ *
+ * @internal
+ */
+static inline void _seqlock_barrier(void)
+{
+    __asm__ volatile ("" : : : "memory");
+}
+
+/**
+ * @brief   Initialize a sequence lock
+ *
+ * For initialization of variables use SEQLOCK_INIT instead.
+ *
+ * @param[out] lock     lock to initialize
+ */
+static inline void seqlock_init(seqlock_t *lock)
+{
+    seqlock_t empty = SEQLOCK_INIT;
+
+    *lock = empty;
+}
+
+/**
+ * @brief   Start a read section
+ *
+ * Waits for a write in progress to finish.
+ *
+ * @param[in] lock      lock protecting the data
+ *
+ * @return  sequence number to pass to seqlock_read_retry()
+ */
+static inline unsigned seqlock_read_begin(seqlock_t *lock)
+{
+    unsigned seq;
+
+    while ((seq = lock->seq) & 1) {
+        /* let the writer finish */
+        mutex_lock(&lock->writer);
+        mutex_unlock(&lock->writer);
+    }
+    _seqlock_barrier();
+    return seq;
+}
+
+/**
+ * @brief   End a read section
+ *
+ * @param[in] lock      lock protecting the data
+ * @param[in] seq       value returned by seqlock_read_begin()
+ *
+ * @return  true if the data read may be inconsistent and must be read again
+ * @return  false if the data read is consistent
+ */
+static inline bool seqlock_read_retry(const seqlock_t *lock, unsigned seq)
+{
+    _seqlock_barrier();
+    return lock->seq != seq;
+}
+
+/**
+ * @brief   Start a write section
+ *
+ * @param[in] lock      lock protecting the data
+ */
+static inline void seqlock_write_lock(seqlock_t *lock)
+{
+    mutex_lock(&lock->writer);
+    lock->seq++;
+    _seqlock_barrier();
+}
+
+/**
+ * @brief   End a write section
+ *
+ * @param[in] lock      lock protecting the data
+ */
+static inline void seqlock_write_unlock(seqlock_t *lock)
+{
+    _seqlock_barrier();
+    lock->seq++;
+    mutex_unlock(&lock->writer);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SEQLOCK_H */
+/** @} */
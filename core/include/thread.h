@@ -176,6 +176,10 @@ struct _thread {
     const char *name;               /**< thread's name                  */
     int stack_size;                 /**< thread's stack size            */
 #endif
+#if defined(MODULE_SCHED_STACK_HWM) || defined(DOXYGEN)
+    char *stack_hwm;                /**< lowest stack pointer seen when
+                                         switching away from the thread */
+#endif
 #ifdef HAVE_THREAD_ARCH_T
     thread_arch_t arch;             /**< architecture dependent part    */
 #endif
@@ -496,6 +500,30 @@ const char *thread_getname(kernel_pid_t pid);
 uintptr_t thread_measure_stack_free(char *stack);
 #endif /* DEVELHELP */
 
+#if defined(MODULE_SCHED_STACK_HWM) || defined(DOXYGEN)
+/**
+ * @brief Get the stack high-water mark of a thread
+ *
+ * Unlike thread_measure_stack_free(), this does not need the stack to be
+ * painted with THREAD_CREATE_STACKTEST and runs in constant time. The
+ * scheduler samples the stack pointer each time it switches away from a
+ * thread, so usage peaks between two context switches are not seen. For the
+ * running thread, the value is from its last context switch.
+ *
+ * The sample is the stack pointer the architecture stored in thread_t::sp
+ * when saving the thread's context. Architectures that save the context
+ * only after calling sched_run(), like Cortex-M, report each sample one
+ * context switch later.
+ *
+ * Requires module `sched_stack_hwm`.
+ *
+ * @param[in] thread    thread to get the high-water mark of
+ *
+ * @return          the maximum number of stack bytes in use seen so far
+ */
+uintptr_t thread_measure_stack_hwm(const thread_t *thread);
+#endif
+
 /**
  * @brief   Get the number of bytes used on the ISR stack
  */
@@ -24,6 +24,9 @@
 #include "irq.h"
 #include "sched.h"
 #include "thread.h"
+#ifdef MODULE_CORE_MSG_SELECT
+#include "thread_flags.h"
+#endif
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -87,6 +90,17 @@ int _mbox_put(mbox_t *mbox, msg_t *msg, int blocking)
         msg->sender_pid = sched_active_pid;
         /* copy msg into queue */
         mbox->msg_array[cib_put_unsafe(&mbox->cib)] = *msg;
+#ifdef MODULE_CORE_MSG_SELECT
+        thread_t *waiter = mbox->select_waiter;
+        if (waiter) {
+            waiter->flags |= THREAD_FLAG_MSG_WAITING;
+            if (thread_flags_wake(waiter)) {
+                irq_restore(irqstate);
+                thread_yield_higher();
+                return 1;
+            }
+        }
+#endif
         irq_restore(irqstate);
         return 1;
     }
@@ -33,6 +33,7 @@
 #endif
 #include "irq.h"
 #include "cib.h"
+#include "trace.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -60,7 +61,7 @@ static int queue_msg(thread_t *target, const msg_t *m)
     return 1;
 }
 
-int msg_send(msg_t *m, kernel_pid_t target_pid)
+int RAMFUNC_HOT msg_send(msg_t *m, kernel_pid_t target_pid)
 {
     if (irq_is_in()) {
         return msg_send_int(m, target_pid);
@@ -82,8 +83,8 @@ int msg_try_send(msg_t *m, kernel_pid_t target_pid)
     return _msg_send(m, target_pid, false, irq_disable());
 }
 
-static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block,
-                     unsigned state)
+static int RAMFUNC_HOT _msg_send(msg_t *m, kernel_pid_t target_pid,
+                                 bool block, unsigned state)
 {
 #ifdef DEVELHELP
     if (!pid_is_valid(target_pid)) {
@@ -91,6 +92,8 @@ static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block,
     }
 #endif /* DEVELHELP */
 
+    trace_event(TRACE_EV_MSG_SEND, target_pid);
+
     thread_t *target = (thread_t *)sched_threads[target_pid];
 
     m->sender_pid = sched_active_pid;
@@ -196,6 +199,8 @@ static int _msg_send_oneway(msg_t *m, kernel_pid_t target_pid)
     }
 #endif /* DEVELHELP */
 
+    trace_event(TRACE_EV_MSG_SEND, target_pid);
+
     thread_t *target = (thread_t *)sched_threads[target_pid];
 
     if (target == NULL) {
@@ -215,7 +220,7 @@ static int _msg_send_oneway(msg_t *m, kernel_pid_t target_pid)
 
         /* Interrupts are disabled here, we can set / re-use
            sched_context_switch_request. */
-        sched_context_switch_request = 1;
+        sched_request_switch(target->priority);
 
         return 1;
     }
@@ -225,7 +230,7 @@ static int _msg_send_oneway(msg_t *m, kernel_pid_t target_pid)
     }
 }
 
-int msg_send_int(msg_t *m, kernel_pid_t target_pid)
+int RAMFUNC_HOT msg_send_int(msg_t *m, kernel_pid_t target_pid)
 {
     int res;
 
@@ -240,24 +245,36 @@ int msg_send_bus(msg_t *m, msg_bus_t *bus)
 {
     const bool in_irq = irq_is_in();
     const uint32_t event_mask = (1 << (m->type & 0x1F));
+    msg_bus_walk_t walk;
+    unsigned visited = 0;
     int count = 0;
 
     m->sender_pid = in_irq ? KERNEL_PID_ISR : sched_active_pid;
 
     unsigned state = irq_disable();
 
-    for (list_node_t *e = bus->subs.next; e; e = e->next) {
-        msg_bus_entry_t *subscriber = container_of(e, msg_bus_entry_t, next);
+    walk.pos = bus->subs.next;
+    list_add(&bus->walks, &walk.node);
 
-        if ((subscriber->event_mask & event_mask) == 0) {
-            continue;
-        }
+    while (walk.pos) {
+        msg_bus_entry_t *subscriber = container_of(walk.pos, msg_bus_entry_t,
+                                                   next);
 
-        if (_msg_send_oneway(m, subscriber->pid) > 0) {
+        walk.pos = walk.pos->next;
+
+        if ((subscriber->event_mask & event_mask) &&
+            (_msg_send_oneway(m, subscriber->pid) > 0)) {
             ++count;
         }
+
+        /* let pending interrupts in, msg_bus_detach() keeps walk.pos valid */
+        if ((++visited % CONFIG_MSG_BUS_IRQ_BATCH) == 0) {
+            irq_restore(state);
+            state = irq_disable();
+        }
     }
 
+    list_remove(&bus->walks, &walk.node);
     irq_restore(state);
 
     if (sched_context_switch_request && !in_irq) {
@@ -325,21 +342,29 @@ int msg_reply_int(msg_t *m, msg_t *reply)
     msg_t *target_message = (msg_t *)target->wait_data;
     *target_message = *reply;
     sched_set_status(target, STATUS_PENDING);
-    sched_context_switch_request = 1;
+    sched_request_switch(target->priority);
     return 1;
 }
 
 int msg_try_receive(msg_t *m)
 {
-    return _msg_receive(m, 0);
+    int res = _msg_receive(m, 0);
+
+    if (res == 1) {
+        trace_event(TRACE_EV_MSG_RECV, m->type);
+    }
+    return res;
 }
 
-int msg_receive(msg_t *m)
+int RAMFUNC_HOT msg_receive(msg_t *m)
 {
-    return _msg_receive(m, 1);
+    int res = _msg_receive(m, 1);
+
+    trace_event(TRACE_EV_MSG_RECV, m->type);
+    return res;
 }
 
-static int _msg_receive(msg_t *m, int block)
+static int RAMFUNC_HOT _msg_receive(msg_t *m, int block)
 {
     unsigned state = irq_disable();
 
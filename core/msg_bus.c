@@ -28,6 +28,7 @@ void msg_bus_init(msg_bus_t *bus)
     static uint16_t bus_count;
 
     bus->subs.next = NULL;
+    bus->walks.next = NULL;
     bus->id = bus_count++;
 }
 
@@ -49,6 +50,14 @@ void msg_bus_detach(msg_bus_t *bus, msg_bus_entry_t *entry)
     unsigned state;
 
     state = irq_disable();
+    /* posts paused at this entry continue with the next one */
+    for (list_node_t *w = bus->walks.next; w; w = w->next) {
+        msg_bus_walk_t *walk = container_of(w, msg_bus_walk_t, node);
+
+        if (walk->pos == &entry->next) {
+            walk->pos = entry->next.next;
+        }
+    }
     list_remove(&bus->subs, &entry->next);
     irq_restore(state);
 }
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     core_msg_select
+ * @{
+ *
+ * @file
+ * @brief       msg_select() implementation
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <assert.h>
+
+#include "irq.h"
+#include "msg_select.h"
+#include "thread.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+static void _set_waiter(mbox_t *const *mboxes, unsigned numof,
+                        thread_t *waiter)
+{
+    unsigned state = irq_disable();
+
+    for (unsigned i = 0; i < numof; i++) {
+        assert(!waiter || !mboxes[i]->select_waiter ||
+               (mboxes[i]->select_waiter == waiter));
+        mboxes[i]->select_waiter = waiter;
+    }
+    irq_restore(state);
+}
+
+int msg_select(mbox_t *const *mboxes, unsigned numof, thread_flags_t mask,
+               msg_t *msg, thread_flags_t *flags)
+{
+    thread_t *me = (thread_t *)sched_active_thread;
+    thread_flags_t set = 0;
+    int res;
+
+    assert(!(mask & THREAD_FLAG_MSG_WAITING));
+    assert(!mask || flags);
+
+    /* register before checking the sources, so that a message put into a
+     * mailbox after it was found empty wakes us up */
+    _set_waiter(mboxes, numof, me);
+
+    while (1) {
+        thread_flags_clear(THREAD_FLAG_MSG_WAITING);
+
+        set |= thread_flags_clear(mask);
+        if (set) {
+            *flags = set;
+            res = MSG_SELECT_FLAGS;
+            break;
+        }
+        for (res = 0; res < (int)numof; res++) {
+            if (mbox_try_get(mboxes[res], msg)) {
+                break;
+            }
+        }
+        if (res < (int)numof) {
+            break;
+        }
+        if (msg_try_receive(msg) == 1) {
+            res = MSG_SELECT_QUEUE;
+            break;
+        }
+
+        DEBUG("msg_select: %" PRIkernel_pid ": nothing ready, waiting\n",
+              me->pid);
+        set = thread_flags_wait_any(mask | THREAD_FLAG_MSG_WAITING) & mask;
+    }
+
+    _set_waiter(mboxes, numof, NULL);
+    return res;
+}
@@ -32,7 +32,69 @@
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
-int _mutex_lock(mutex_t *mutex, volatile uint8_t *blocking)
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+static inline void _set_owner(mutex_t *mutex, thread_t *thread)
+{
+    /* a mutex locked from ISR or before the scheduler runs has no owner */
+    if (thread == NULL) {
+        mutex->owner = KERNEL_PID_UNDEF;
+        return;
+    }
+    mutex->owner = thread->pid;
+    mutex->owner_original_priority = thread->priority;
+}
+
+static inline void _set_owner_active(mutex_t *mutex)
+{
+    _set_owner(mutex, irq_is_in() ? NULL : (thread_t *)sched_active_thread);
+}
+
+static inline void _inherit_priority(mutex_t *mutex, thread_t *waiter)
+{
+    thread_t *owner = (thread_t *)thread_get(mutex->owner);
+
+    if ((owner != NULL) && (owner->priority > waiter->priority)) {
+        DEBUG("PID[%" PRIkernel_pid "]: boosting owner %" PRIkernel_pid
+              " to prio %" PRIu8 "\n", waiter->pid, owner->pid,
+              waiter->priority);
+        sched_change_priority(owner, waiter->priority);
+    }
+}
+
+static inline void _restore_priority(mutex_t *mutex)
+{
+    thread_t *owner = (thread_t *)thread_get(mutex->owner);
+
+    if (owner != NULL) {
+        sched_change_priority(owner, mutex->owner_original_priority);
+    }
+    mutex->owner = KERNEL_PID_UNDEF;
+}
+#else
+static inline void _set_owner(mutex_t *mutex, thread_t *thread)
+{
+    (void)mutex;
+    (void)thread;
+}
+
+static inline void _set_owner_active(mutex_t *mutex)
+{
+    (void)mutex;
+}
+
+static inline void _inherit_priority(mutex_t *mutex, thread_t *waiter)
+{
+    (void)mutex;
+    (void)waiter;
+}
+
+static inline void _restore_priority(mutex_t *mutex)
+{
+    (void)mutex;
+}
+#endif
+
+int RAMFUNC_HOT _mutex_lock(mutex_t *mutex, volatile uint8_t *blocking)
 {
     unsigned irqstate = irq_disable();
 
@@ -41,6 +103,7 @@ int _mutex_lock(mutex_t *mutex, volatile uint8_t *blocking)
     if (mutex->queue.next == NULL) {
         /* mutex is unlocked. */
         mutex->queue.next = MUTEX_LOCKED;
+        _set_owner_active(mutex);
         DEBUG("PID[%" PRIkernel_pid "]: mutex_wait early out.\n",
               sched_active_pid);
         irq_restore(irqstate);
@@ -58,6 +121,7 @@ int _mutex_lock(mutex_t *mutex, volatile uint8_t *blocking)
         else {
             thread_add_to_list(&mutex->queue, me);
         }
+        _inherit_priority(mutex, me);
         irq_restore(irqstate);
         thread_yield_higher();
         /* We were woken up by scheduler. Waker removed us from queue.
@@ -70,7 +134,7 @@ int _mutex_lock(mutex_t *mutex, volatile uint8_t *blocking)
     }
 }
 
-void mutex_unlock(mutex_t *mutex)
+void RAMFUNC_HOT mutex_unlock(mutex_t *mutex)
 {
     unsigned irqstate = irq_disable();
 
@@ -83,6 +147,8 @@ void mutex_unlock(mutex_t *mutex)
         return;
     }
 
+    _restore_priority(mutex);
+
     if (mutex->queue.next == MUTEX_LOCKED) {
         mutex->queue.next = NULL;
         /* the mutex was locked and no thread was waiting for it */
@@ -101,6 +167,9 @@ void mutex_unlock(mutex_t *mutex)
     if (!mutex->queue.next) {
         mutex->queue.next = MUTEX_LOCKED;
     }
+    /* waiters are sorted by priority, so none of the remaining ones has a
+     * higher priority than the new owner */
+    _set_owner(mutex, process);
 
     uint16_t process_priority = process->priority;
     irq_restore(irqstate);
@@ -114,6 +183,7 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
     unsigned irqstate = irq_disable();
 
     if (mutex->queue.next) {
+        _restore_priority(mutex);
         if (mutex->queue.next == MUTEX_LOCKED) {
             mutex->queue.next = NULL;
         }
@@ -126,6 +196,7 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
             if (!mutex->queue.next) {
                 mutex->queue.next = MUTEX_LOCKED;
             }
+            _set_owner(mutex, process);
         }
     }
 
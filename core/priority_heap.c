@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     core_util
+ * @{
+ *
+ * @file
+ * @brief       Intrusive priority heap implementation
+ *
+ * @author      ML!PA Consulting GmbH
+ * @}
+ */
+
+#include <assert.h>
+#include <stdbool.h>
+
+#include "priority_heap.h"
+
+static bool _before(const priority_heap_node_t *a, const priority_heap_node_t *b)
+{
+    if (a->priority != b->priority) {
+        return a->priority < b->priority;
+    }
+    /* the sequence number may wrap around */
+    return (int32_t)(a->seq - b->seq) < 0;
+}
+
+/* links two detached trees, the loser becomes the first child */
+static priority_heap_node_t *_meld(priority_heap_node_t *a,
+                                   priority_heap_node_t *b)
+{
+    if (!a) {
+        return b;
+    }
+    if (!b) {
+        return a;
+    }
+    if (_before(b, a)) {
+        priority_heap_node_t *tmp = a;
+        a = b;
+        b = tmp;
+    }
+    b->prev = a;
+    b->next = a->child;
+    if (a->child) {
+        a->child->prev = b;
+    }
+    a->child = b;
+    return a;
+}
+
+/* melds a list of siblings into one tree, pairing them left to right first
+ * and then melding the pairs right to left */
+static priority_heap_node_t *_meld_siblings(priority_heap_node_t *first)
+{
+    priority_heap_node_t *pairs = NULL;
+
+    while (first) {
+        priority_heap_node_t *a = first;
+        priority_heap_node_t *b = a->next;
+
+        first = b ? b->next : NULL;
+        a->next = a->prev = NULL;
+        if (b) {
+            b->next = b->prev = NULL;
+            a = _meld(a, b);
+        }
+        /* next links the pairs in reverse order */
+        a->next = pairs;
+        pairs = a;
+    }
+
+    priority_heap_node_t *root = NULL;
+
+    while (pairs) {
+        priority_heap_node_t *a = pairs;
+
+        pairs = a->next;
+        a->next = NULL;
+        root = _meld(a, root);
+    }
+    return root;
+}
+
+void priority_heap_add(priority_heap_t *heap, priority_heap_node_t *node)
+{
+    /* not trying to add the same node twice */
+    assert(node != heap->root);
+
+    node->next = node->prev = node->child = NULL;
+    node->seq = heap->seq++;
+    heap->root = _meld(heap->root, node);
+    heap->numof++;
+}
+
+priority_heap_node_t *priority_heap_remove_head(priority_heap_t *heap)
+{
+    priority_heap_node_t *head = heap->root;
+
+    if (head) {
+        heap->root = _meld_siblings(head->child);
+        head->child = NULL;
+        heap->numof--;
+    }
+    return head;
+}
+
+void priority_heap_remove(priority_heap_t *heap, priority_heap_node_t *node)
+{
+    if (node == heap->root) {
+        priority_heap_remove_head(heap);
+        return;
+    }
+    assert(node->prev);
+
+    /* unlink from the siblings, prev is the parent for the first child */
+    if (node->prev->child == node) {
+        node->prev->child = node->next;
+    }
+    else {
+        node->prev->next = node->next;
+    }
+    if (node->next) {
+        node->next->prev = node->prev;
+    }
+    heap->root = _meld(heap->root, _meld_siblings(node->child));
+    node->next = node->prev = node->child = NULL;
+    heap->numof--;
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     core_sync_rwlock
+ * @{
+ *
+ * @file
+ * @brief       Reader-writer lock implementation
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <assert.h>
+
+#include "rwlock.h"
+
+void rwlock_read_lock(rwlock_t *lock)
+{
+    mutex_lock(&lock->mutex);
+    while (lock->writer || lock->writers_waiting) {
+        cond_wait(&lock->readers_cv, &lock->mutex);
+    }
+    lock->readers++;
+    mutex_unlock(&lock->mutex);
+}
+
+bool rwlock_read_trylock(rwlock_t *lock)
+{
+    bool res = false;
+
+    mutex_lock(&lock->mutex);
+    if (!lock->writer && !lock->writers_waiting) {
+        lock->readers++;
+        res = true;
+    }
+    mutex_unlock(&lock->mutex);
+    return res;
+}
+
+void rwlock_read_unlock(rwlock_t *lock)
+{
+    mutex_lock(&lock->mutex);
+    assert(lock->readers > 0);
+    if ((--lock->readers == 0) && lock->writers_waiting) {
+        cond_signal(&lock->writers_cv);
+    }
+    mutex_unlock(&lock->mutex);
+}
+
+void rwlock_write_lock(rwlock_t *lock)
+{
+    mutex_lock(&lock->mutex);
+    lock->writers_waiting++;
+    while (lock->writer || lock->readers) {
+        cond_wait(&lock->writers_cv, &lock->mutex);
+    }
+    lock->writers_waiting--;
+    lock->writer = true;
+    mutex_unlock(&lock->mutex);
+}
+
+bool rwlock_write_trylock(rwlock_t *lock)
+{
+    bool res = false;
+
+    mutex_lock(&lock->mutex);
+    if (!lock->writer && !lock->readers) {
+        lock->writer = true;
+        res = true;
+    }
+    mutex_unlock(&lock->mutex);
+    return res;
+}
+
+void rwlock_write_unlock(rwlock_t *lock)
+{
+    mutex_lock(&lock->mutex);
+    assert(lock->writer);
+    lock->writer = false;
+    if (lock->writers_waiting) {
+        cond_signal(&lock->writers_cv);
+    }
+    else {
+        cond_broadcast(&lock->readers_cv);
+    }
+    mutex_unlock(&lock->mutex);
+}
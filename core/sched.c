@@ -19,6 +19,7 @@
  * @}
  */
 
+#include <assert.h>
 #include <stdint.h>
 
 #include "sched.h"
@@ -27,6 +28,7 @@
 #include "irq.h"
 #include "thread.h"
 #include "log.h"
+#include "trace.h"
 
 #ifdef MODULE_MPU_STACK_GUARD
 #include "mpu.h"
@@ -74,6 +76,7 @@ const uint8_t _tcb_name_offset = offsetof(thread_t, name);
 #ifdef MODULE_SCHED_CB
 static void (*sched_cb) (kernel_pid_t active_thread,
                          kernel_pid_t next_thread) = NULL;
+static sched_status_callback_t sched_status_cb = NULL;
 #endif
 
 static void _unschedule(thread_t *active_thread)
@@ -82,6 +85,11 @@ static void _unschedule(thread_t *active_thread)
         active_thread->status = STATUS_PENDING;
     }
 
+#ifdef MODULE_SCHED_STACK_HWM
+    if (active_thread->sp < active_thread->stack_hwm) {
+        active_thread->stack_hwm = active_thread->sp;
+    }
+#endif
 #ifdef SCHED_TEST_STACK
     if (*((uintptr_t *)active_thread->stack_start) !=
         (uintptr_t)active_thread->stack_start) {
@@ -97,7 +105,7 @@ static void _unschedule(thread_t *active_thread)
 #endif
 }
 
-int __attribute__((used)) sched_run(void)
+int __attribute__((used)) RAMFUNC_HOT sched_run(void)
 {
     sched_context_switch_request = 0;
     thread_t *active_thread = (thread_t *)sched_active_thread;
@@ -140,6 +148,14 @@ int __attribute__((used)) sched_run(void)
         sched_cb(KERNEL_PID_UNDEF, next_thread->pid);
     }
 #endif
+    trace_event(TRACE_EV_SCHED, next_thread->pid);
+
+#ifdef MODULE_SCHED_EDF
+    sched_edf_switch(active_thread, next_thread);
+#endif
+#ifdef MODULE_SCHED_ROUND_ROBIN
+    sched_round_robin_switch(next_thread);
+#endif
 
     next_thread->status = STATUS_RUNNING;
     sched_active_pid = next_thread->pid;
@@ -170,6 +186,9 @@ void sched_set_status(thread_t *process, thread_status_t status)
             clist_rpush(&sched_runqueues[process->priority],
                         &(process->rq_entry));
             runqueue_bitcache |= 1 << process->priority;
+#ifdef MODULE_SCHED_ROUND_ROBIN
+            sched_round_robin_runnable(process);
+#endif
         }
     }
     else {
@@ -185,9 +204,42 @@ void sched_set_status(thread_t *process, thread_status_t status)
         }
     }
 
+#ifdef MODULE_SCHED_CB
+    if (sched_status_cb && (process->status != status)) {
+        sched_status_cb(process->pid, process->status, status);
+    }
+#endif
+
     process->status = status;
 }
 
+void sched_change_priority(thread_t *thread, uint8_t priority)
+{
+    assert(priority < SCHED_PRIO_LEVELS);
+
+    unsigned irqstate = irq_disable();
+
+    if (thread->priority == priority) {
+        irq_restore(irqstate);
+        return;
+    }
+
+    DEBUG("sched_change_priority: thread %" PRIkernel_pid ": %" PRIu8
+          " -> %" PRIu8 "\n", thread->pid, thread->priority, priority);
+
+    if (thread->status >= STATUS_ON_RUNQUEUE) {
+        clist_remove(&sched_runqueues[thread->priority], &thread->rq_entry);
+        if (!sched_runqueues[thread->priority].next) {
+            runqueue_bitcache &= ~(1 << thread->priority);
+        }
+        clist_rpush(&sched_runqueues[priority], &thread->rq_entry);
+        runqueue_bitcache |= 1 << priority;
+    }
+    thread->priority = priority;
+
+    irq_restore(irqstate);
+}
+
 void sched_switch(uint16_t other_prio)
 {
     thread_t *active_thread = (thread_t *)sched_active_thread;
@@ -214,6 +266,19 @@ void sched_switch(uint16_t other_prio)
     }
 }
 
+void sched_request_switch(uint16_t other_prio)
+{
+    if (IS_USED(MODULE_CORE_SCHED_FAST_SWITCH)) {
+        thread_t *active_thread = (thread_t *)sched_active_thread;
+
+        if (active_thread && (active_thread->status >= STATUS_ON_RUNQUEUE) &&
+            (active_thread->priority <= other_prio)) {
+            return;
+        }
+    }
+    sched_context_switch_request = 1;
+}
+
 NORETURN void sched_task_exit(void)
 {
     DEBUG("sched_task_exit: ending thread %" PRIkernel_pid "...\n",
@@ -234,4 +299,9 @@ void sched_register_cb(void (*callback)(kernel_pid_t, kernel_pid_t))
 {
     sched_cb = callback;
 }
+
+void sched_register_status_cb(sched_status_callback_t callback)
+{
+    sched_status_cb = callback;
+}
 #endif
@@ -189,6 +189,14 @@ uintptr_t thread_measure_stack_free(char *stack)
 }
 #endif
 
+#ifdef MODULE_SCHED_STACK_HWM
+uintptr_t thread_measure_stack_hwm(const thread_t *thread)
+{
+    /* the thread control block sits at the top of the stack */
+    return (uintptr_t)thread - (uintptr_t)thread->stack_hwm;
+}
+#endif
+
 kernel_pid_t thread_create(char *stack, int stacksize, uint8_t priority,
                            int flags, thread_task_func_t function, void *arg,
                            const char *name)
@@ -261,6 +269,9 @@ kernel_pid_t thread_create(char *stack, int stacksize, uint8_t priority,
 
     thread->pid = pid;
     thread->sp = thread_stack_init(function, arg, stack, stacksize);
+#ifdef MODULE_SCHED_STACK_HWM
+    thread->stack_hwm = thread->sp;
+#endif
 
 #if defined(DEVELHELP) || defined(SCHED_TEST_STACK) || \
     defined(MODULE_MPU_STACK_GUARD)
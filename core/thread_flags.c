@@ -130,7 +130,7 @@ inline int __attribute__((always_inline)) thread_flags_wake(thread_t *thread)
         DEBUG("_thread_flags_wake(): waking up pid %" PRIkernel_pid "\n",
               thread->pid);
         sched_set_status(thread, STATUS_PENDING);
-        sched_context_switch_request = 1;
+        sched_request_switch(thread->priority);
     }
 
     return wakeup;
@@ -144,7 +144,10 @@ void thread_flags_set(thread_t *thread, thread_flags_t mask)
     thread->flags |= mask;
     if (thread_flags_wake(thread)) {
         irq_restore(state);
-        thread_yield_higher();
+        if (!IS_USED(MODULE_CORE_SCHED_FAST_SWITCH) ||
+            sched_context_switch_request) {
+            thread_yield_higher();
+        }
     }
     else {
         irq_restore(state);
@@ -30,7 +30,16 @@
 #include "cpu.h"
 #include "board.h"
 
+/**
+ * @brief   Type of a saved context, pushed last
+ * @{
+ */
+#define ATMEGA_CONTEXT_YIELD    (0x00)  /**< only call-saved registers */
+#define ATMEGA_CONTEXT_FULL     (0x01)  /**< all registers */
+/** @} */
+
 static void atmega_context_save(void);
+static void atmega_context_save_yield(void);
 static void atmega_context_restore(void);
 static void atmega_enter_thread_mode(void);
 
@@ -56,9 +65,13 @@ static void atmega_enter_thread_mode(void);
  * r0
  * status register
  * (Optional EIND and RAMPZ registers)
- * r1 - r23
+ * r2 - r17, r28, r29
+ * r1
+ * r18 - r23
  * pointer to arg in r24 and r25
- * r26 - r31
+ * r26, r27, r30, r31
+ * -----------------------------------------------------------------------
+ * the context type ATMEGA_CONTEXT_FULL
  * -----------------------------------------------------------------------
  *
  * After the invocation of atmega_context_restore() the pointer to task_func is
@@ -126,18 +139,29 @@ char *thread_stack_init(thread_task_func_t task_func, void *arg,
     *stk = (uint8_t)0x00;
 #endif
 
-    /* r1 - has always to be 0 */
-    stk--;
-    *stk = (uint8_t)0x00;
     /*
-     * Space for registers r2 -r23
+     * Space for registers r2 - r17, r28 and r29
      *
      * use loop for better readability, the compiler unrolls anyways
      */
 
     int i;
 
-    for (i = 2; i <= 23; i++) {
+    for (i = 2; i <= 17; i++) {
+        stk--;
+        *stk = (uint8_t)0;
+    }
+    for (i = 28; i <= 29; i++) {
+        stk--;
+        *stk = (uint8_t)0;
+    }
+
+    /* r1 - has always to be 0 */
+    stk--;
+    *stk = (uint8_t)0x00;
+
+    /* Space for registers r18 - r23 */
+    for (i = 18; i <= 23; i++) {
         stk--;
         *stk = (uint8_t)0;
     }
@@ -154,13 +178,21 @@ char *thread_stack_init(thread_task_func_t task_func, void *arg,
     *stk = (uint8_t)(tmp_adress & (uint16_t)0x00ff);
 
     /*
-     * Space for registers r26-r31
+     * Space for registers r26, r27, r30 and r31
      */
-    for (i = 26; i <= 31; i++) {
+    for (i = 26; i <= 27; i++) {
+        stk--;
+        *stk = (uint8_t)i;
+    }
+    for (i = 30; i <= 31; i++) {
         stk--;
         *stk = (uint8_t)i;
     }
 
+    /* the new thread is entered like one preempted by an interrupt */
+    stk--;
+    *stk = (uint8_t)ATMEGA_CONTEXT_FULL;
+
     stk--;
     return (char *)stk;
 }
@@ -232,10 +264,15 @@ void NORETURN atmega_enter_thread_mode(void)
     UNREACHABLE();
 }
 
-void thread_yield_higher(void)
+/*
+ * A thread calling thread_yield_higher() expects the call-clobbered registers
+ * to be lost, so only the call-saved ones are switched. The full context is
+ * only saved when a thread is preempted in atmega_exit_isr().
+ */
+__attribute__((noinline)) void thread_yield_higher(void)
 {
     if (irq_is_in() == 0) {
-        atmega_context_save();
+        atmega_context_save_yield();
         sched_run();
         atmega_context_restore();
         __asm__ volatile ("ret");
@@ -273,8 +310,7 @@ __attribute__((always_inline)) static inline void atmega_context_save(void)
         "in     __tmp_reg__, 0x3c            \n\t"
         "push   __tmp_reg__                  \n\t"
 #endif
-        "push r1                             \n\t"
-        "clr  r1                             \n\t"
+        /* call-saved registers, the part shared with a yield context */
         "push r2                             \n\t"
         "push r3                             \n\t"
         "push r4                             \n\t"
@@ -291,6 +327,11 @@ __attribute__((always_inline)) static inline void atmega_context_save(void)
         "push r15                            \n\t"
         "push r16                            \n\t"
         "push r17                            \n\t"
+        "push r28                            \n\t"
+        "push r29                            \n\t"
+        /* call-clobbered registers */
+        "push r1                             \n\t"
+        "clr  r1                             \n\t"
         "push r18                            \n\t"
         "push r19                            \n\t"
         "push r20                            \n\t"
@@ -301,10 +342,56 @@ __attribute__((always_inline)) static inline void atmega_context_save(void)
         "push r25                            \n\t"
         "push r26                            \n\t"
         "push r27                            \n\t"
-        "push r28                            \n\t"
-        "push r29                            \n\t"
         "push r30                            \n\t"
         "push r31                            \n\t"
+        "ldi  r24, %[full]                   \n\t"
+        "push r24                            \n\t"
+        "lds  r26, sched_active_thread       \n\t"
+        "lds  r27, sched_active_thread + 1   \n\t"
+        "in   __tmp_reg__, __SP_L__          \n\t"
+        "st   x+, __tmp_reg__                \n\t"
+        "in   __tmp_reg__, __SP_H__          \n\t"
+        "st   x+, __tmp_reg__                \n\t"
+        : : [full] "M" (ATMEGA_CONTEXT_FULL));
+}
+
+__attribute__((always_inline)) static inline void atmega_context_save_yield(void)
+{
+    __asm__ volatile (
+        /* keeps the frame layout of atmega_context_save(), the value of
+         * r0 does not matter */
+        "push __tmp_reg__                    \n\t"
+        "in   __tmp_reg__, __SREG__          \n\t"
+        "cli                                 \n\t"
+        "push __tmp_reg__                    \n\t"
+#if defined(RAMPZ) && !defined(__AVR_ATmega32U4__)
+        "in     __tmp_reg__, __RAMPZ__       \n\t"
+        "push   __tmp_reg__                  \n\t"
+#endif
+#if defined(EIND)
+        "in     __tmp_reg__, 0x3c            \n\t"
+        "push   __tmp_reg__                  \n\t"
+#endif
+        "push r2                             \n\t"
+        "push r3                             \n\t"
+        "push r4                             \n\t"
+        "push r5                             \n\t"
+        "push r6                             \n\t"
+        "push r7                             \n\t"
+        "push r8                             \n\t"
+        "push r9                             \n\t"
+        "push r10                            \n\t"
+        "push r11                            \n\t"
+        "push r12                            \n\t"
+        "push r13                            \n\t"
+        "push r14                            \n\t"
+        "push r15                            \n\t"
+        "push r16                            \n\t"
+        "push r17                            \n\t"
+        "push r28                            \n\t"
+        "push r29                            \n\t"
+        /* r1 is always 0 in C code, i.e. ATMEGA_CONTEXT_YIELD */
+        "push __zero_reg__                   \n\t"
         "lds  r26, sched_active_thread       \n\t"
         "lds  r27, sched_active_thread + 1   \n\t"
         "in   __tmp_reg__, __SP_L__          \n\t"
@@ -322,10 +409,12 @@ __attribute__((always_inline)) static inline void atmega_context_restore(void)
         "out  __SP_L__, r28                  \n\t"
         "ld   r29, x+                        \n\t"
         "out  __SP_H__, r29                  \n\t"
+        /* the call-clobbered registers are only saved in a full context */
+        "pop  __tmp_reg__                    \n\t"
+        "tst  __tmp_reg__                    \n\t"
+        "breq 1f                             \n\t"
         "pop  r31                            \n\t"
         "pop  r30                            \n\t"
-        "pop  r29                            \n\t"
-        "pop  r28                            \n\t"
         "pop  r27                            \n\t"
         "pop  r26                            \n\t"
         "pop  r25                            \n\t"
@@ -336,6 +425,10 @@ __attribute__((always_inline)) static inline void atmega_context_restore(void)
         "pop  r20                            \n\t"
         "pop  r19                            \n\t"
         "pop  r18                            \n\t"
+        "pop  r1                             \n\t"
+        "1:                                  \n\t"
+        "pop  r29                            \n\t"
+        "pop  r28                            \n\t"
         "pop  r17                            \n\t"
         "pop  r16                            \n\t"
         "pop  r15                            \n\t"
@@ -352,7 +445,6 @@ __attribute__((always_inline)) static inline void atmega_context_restore(void)
         "pop  r4                             \n\t"
         "pop  r3                             \n\t"
         "pop  r2                             \n\t"
-        "pop  r1                             \n\t"
 #if defined(EIND)
         "pop    __tmp_reg__                  \n\t"
         "out    0x3c, __tmp_reg__            \n\t"
@@ -314,6 +314,34 @@ void cc2538_set_monitor(bool mode);
  */
 void cc2538_set_pan(uint16_t pan);
 
+/**
+ * @brief   Add an address to the source address match table
+ *
+ * Data requests from addresses in the table are acknowledged with the frame
+ * pending subfield set. The table holds 24 short or 12 long addresses, a long
+ * address takes the place of two short ones.
+ *
+ * @param[in] addr          short or long address, in network byte order
+ * @param[in] len           length of @p addr
+ *
+ * @return  0 on success
+ * @return  -EINVAL if @p len is no address length
+ * @return  -ENOMEM if the table is full
+ */
+int cc2538_src_match_add(const uint8_t *addr, size_t len);
+
+/**
+ * @brief   Remove an address from the source address match table
+ *
+ * @param[in] addr          short or long address, in network byte order
+ * @param[in] len           length of @p addr, 0 to clear the table
+ *
+ * @return  0 on success
+ * @return  -EINVAL if @p len is no address length
+ * @return  -ENOENT if the address is not in the table
+ */
+int cc2538_src_match_del(const uint8_t *addr, size_t len);
+
 /**
  * @brief   Set the state of the device
  *
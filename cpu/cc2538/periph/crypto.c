@@ -0,0 +1,241 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_cc2538
+ * @ingroup     drivers_periph_crypto
+ * @{
+ *
+ * @file
+ * @brief       Low-level AES engine driver implementation
+ *
+ * Keys are loaded into the key store and data is moved by the DMA of the
+ * security module, so a request of any number of blocks runs without CPU
+ * interaction. The hash engine of the same module implements SHA-256.
+ *
+ * @author      ML!PA Consulting GmbH
+ * @}
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "cpu.h"
+#include "mutex.h"
+#include "periph/crypto.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/* bit fields from vendor/hw_aes.h, which conflicts with cc2538.h */
+#define ALG_SEL_KEYSTORE    (0x00000001)
+#define ALG_SEL_AES         (0x00000002)
+#define INT_CFG_LEVEL       (0x00000001)
+#define INT_RESULT_AV       (0x00000001)
+#define INT_DMA_IN_DONE     (0x00000002)
+#define INT_KEY_ST_RD_ERR   (0x20000000)
+#define INT_KEY_ST_WR_ERR   (0x40000000)
+#define INT_DMA_BUS_ERR     (0x80000000)
+#define INT_ERRORS          (INT_DMA_BUS_ERR | INT_KEY_ST_WR_ERR | \
+                             INT_KEY_ST_RD_ERR)
+#define KEY_STORE_SIZE_128  (0x00000001)
+#define KEY_STORE_BUSY      (0x80000000)
+#define ALG_SEL_HASH        (0x00000004)
+#define ALG_SEL_TAG         (0x80000000)
+#define HASH_MODE_SHA256    (0x00000008)
+#define AES_CTRL_DIRECTION  (0x00000004)
+#define DMAC_CH_EN          (0x00000001)
+#define RCGCSEC_AES         (0x00000002)
+
+/* key store area used for all operations */
+#define KEY_AREA            (0)
+
+/* number of blocks copied through the bounce buffer at once */
+#define BOUNCE_BLOCKS       (4)
+
+/* both engines share the DMA and the interrupt status */
+
+static mutex_t _lock = MUTEX_INIT;
+static uint32_t _bounce[BOUNCE_BLOCKS * CRYPTO_AES_BLOCK_SIZE / sizeof(uint32_t)];
+
+static void _acquire(void)
+{
+    mutex_lock(&_lock);
+    SYS_CTRL->RCGCSEC |= RCGCSEC_AES;
+
+    AES_CTRL_INT_CFG = INT_CFG_LEVEL;
+    AES_CTRL_INT_EN = INT_RESULT_AV | INT_DMA_IN_DONE;
+    AES_CTRL_INT_CLR = INT_RESULT_AV | INT_DMA_IN_DONE | INT_ERRORS;
+}
+
+static void _release(void)
+{
+    SYS_CTRL->RCGCSEC &= ~RCGCSEC_AES;
+    mutex_unlock(&_lock);
+}
+
+static int _wait_result(void)
+{
+    uint32_t stat;
+
+    do {
+        stat = AES_CTRL_INT_STAT;
+    } while (!(stat & (INT_RESULT_AV | INT_ERRORS)));
+
+    AES_CTRL_INT_CLR = INT_RESULT_AV | INT_DMA_IN_DONE | INT_ERRORS;
+
+    if (stat & INT_ERRORS) {
+        DEBUG("crypto: engine error 0x%08lx\n", (unsigned long)stat);
+        return -EIO;
+    }
+    return 0;
+}
+
+static int _load_key(const uint8_t *key)
+{
+    /* the DMA needs a word aligned source */
+    memcpy(_bounce, key, CRYPTO_AES_BLOCK_SIZE);
+
+    AES_CTRL_ALG_SEL = ALG_SEL_KEYSTORE;
+    AES_KEY_STORE_SIZE = KEY_STORE_SIZE_128;
+    AES_KEY_STORE_WRITE_AREA = 1 << KEY_AREA;
+
+    AES_DMAC_CH0_CTRL = DMAC_CH_EN;
+    AES_DMAC_CH0_EXTADDR = (uintptr_t)_bounce;
+    AES_DMAC_CH0_DMALENGTH = CRYPTO_AES_BLOCK_SIZE;
+
+    int res = _wait_result();
+    AES_CTRL_ALG_SEL = 0;
+    memset(_bounce, 0, sizeof(_bounce));
+    return res;
+}
+
+static int _process(const void *in, void *out, size_t len, bool encrypt)
+{
+    AES_CTRL_ALG_SEL = ALG_SEL_AES;
+
+    AES_KEY_STORE_READ_AREA = KEY_AREA;
+    while (AES_KEY_STORE_READ_AREA & KEY_STORE_BUSY) {}
+    if (AES_CTRL_INT_STAT & INT_KEY_ST_RD_ERR) {
+        AES_CTRL_INT_CLR = INT_KEY_ST_RD_ERR;
+        AES_CTRL_ALG_SEL = 0;
+        return -EIO;
+    }
+
+    /* all mode bits cleared selects ECB */
+    AES_AES_CTRL = encrypt ? AES_CTRL_DIRECTION : 0;
+    AES_AES_C_LENGTH_0 = len;
+    AES_AES_C_LENGTH_1 = 0;
+
+    AES_DMAC_CH0_CTRL = DMAC_CH_EN;
+    AES_DMAC_CH0_EXTADDR = (uintptr_t)in;
+    AES_DMAC_CH1_CTRL = DMAC_CH_EN;
+    AES_DMAC_CH1_EXTADDR = (uintptr_t)out;
+    /* writing the lengths starts the transfers */
+    AES_DMAC_CH1_DMALENGTH = len;
+    AES_DMAC_CH0_DMALENGTH = len;
+
+    int res = _wait_result();
+    AES_AES_CTRL = 0;
+    AES_CTRL_ALG_SEL = 0;
+    return res;
+}
+
+int crypto_aes_ecb(const uint8_t *key, size_t key_len, const uint8_t *in,
+                   uint8_t *out, size_t blocks, bool encrypt)
+{
+    if (key_len != CRYPTO_AES_BLOCK_SIZE) {
+        return -ENOTSUP;
+    }
+
+    _acquire();
+
+    int res = _load_key(key);
+
+    if (((uintptr_t)in | (uintptr_t)out) & (sizeof(uint32_t) - 1)) {
+        /* unaligned buffers are processed through the bounce buffer */
+        while ((res == 0) && blocks) {
+            size_t n = (blocks < BOUNCE_BLOCKS) ? blocks : BOUNCE_BLOCKS;
+            size_t len = n * CRYPTO_AES_BLOCK_SIZE;
+            memcpy(_bounce, in, len);
+            res = _process(_bounce, _bounce, len, encrypt);
+            memcpy(out, _bounce, len);
+            in += len;
+            out += len;
+            blocks -= n;
+        }
+        memset(_bounce, 0, sizeof(_bounce));
+    }
+    else if ((res == 0) && blocks) {
+        res = _process(in, out, blocks * CRYPTO_AES_BLOCK_SIZE, encrypt);
+    }
+
+    _release();
+    return res;
+}
+
+#ifdef MODULE_PERIPH_CRYPTO_SHA256
+static uint32_t _digest[8];
+
+static int _hash(uint32_t state[8], const void *data, size_t len)
+{
+    /* the digest registers hold the state in the byte order of the digest */
+    volatile uint32_t *digest = &AES_HASH_DIGEST_A;
+    for (unsigned i = 0; i < 8; i++) {
+        digest[i] = __builtin_bswap32(state[i]);
+    }
+
+    AES_CTRL_ALG_SEL = ALG_SEL_TAG | ALG_SEL_HASH;
+    AES_CTRL_INT_CLR = INT_RESULT_AV;
+    /* no NEW_HASH: continue from the state written above */
+    AES_HASH_MODE_IN = HASH_MODE_SHA256;
+
+    AES_DMAC_CH0_CTRL = DMAC_CH_EN;
+    AES_DMAC_CH0_EXTADDR = (uintptr_t)data;
+    AES_DMAC_CH0_DMALENGTH = len;
+    /* the new state is written back by the DMA */
+    AES_DMAC_CH1_CTRL = DMAC_CH_EN;
+    AES_DMAC_CH1_EXTADDR = (uintptr_t)_digest;
+    AES_DMAC_CH1_DMALENGTH = 8 * sizeof(uint32_t);
+
+    int res = _wait_result();
+    AES_CTRL_ALG_SEL = 0;
+    if (res == 0) {
+        for (unsigned i = 0; i < 8; i++) {
+            state[i] = __builtin_bswap32(_digest[i]);
+        }
+    }
+    return res;
+}
+
+int crypto_sha256_blocks(uint32_t state[8], const void *data, size_t blocks)
+{
+    const uint8_t *src = data;
+    int res = 0;
+
+    _acquire();
+
+    if ((uintptr_t)src & (sizeof(uint32_t) - 1)) {
+        /* unaligned input is processed one block at a time */
+        while ((res == 0) && blocks--) {
+            memcpy(_bounce, src, CRYPTO_SHA256_BLOCK_SIZE);
+            res = _hash(state, _bounce, CRYPTO_SHA256_BLOCK_SIZE);
+            src += CRYPTO_SHA256_BLOCK_SIZE;
+        }
+    }
+    else if (blocks) {
+        res = _hash(state, src, blocks * CRYPTO_SHA256_BLOCK_SIZE);
+    }
+
+    memset(_bounce, 0, sizeof(_bounce));
+    _release();
+    return res;
+}
+#endif /* MODULE_PERIPH_CRYPTO_SHA256 */
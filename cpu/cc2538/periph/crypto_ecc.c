@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_cc2538
+ * @ingroup     drivers_periph_crypto
+ * @{
+ *
+ * @file
+ * @brief       P-256 point arithmetic on the PKA engine
+ *
+ * The ECC-MUL and ECC-ADD sequencer programs in the PKA ROM take their
+ * operands from the PKA RAM, least significant word first. An operation
+ * takes tens of milliseconds, so the calling thread sleeps on the PKA
+ * interrupt instead of polling the run bit.
+ *
+ * @author      ML!PA Consulting GmbH
+ * @}
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "byteorder.h"
+#include "cpu.h"
+#include "mutex.h"
+#include "periph/crypto.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/* bit fields from vendor/hw_pka.h, which conflicts with cc2538.h */
+#define PKA_FUNCTION_RUN    (0x00008000)
+#define PKA_FUNCTION_ECCADD (0x00003000)
+#define PKA_FUNCTION_ECCMUL (0x00005000)
+#define RCGCSEC_PKA         (0x00000001)
+
+#define PKA_RAM             ((volatile uint32_t *)0x44006000)
+#define PKA_RAM_WORDS       (2048 / sizeof(uint32_t))
+
+/* ECC-ADD and ECC-MUL completion codes in PKA_SHIFT */
+#define PKA_SHIFT_OK        (0)
+#define PKA_SHIFT_INFINITY  (7)
+
+#define WORDS               (CRYPTO_ECC_P256_SIZE / sizeof(uint32_t))
+/* the sequencer needs two spare words after every curve parameter and
+ * coordinate */
+#define STRIDE              (WORDS + 2)
+
+static const uint32_t _p256_p[WORDS] = {
+    0xffffffff, 0xffffffff, 0xffffffff, 0x00000000,
+    0x00000000, 0x00000000, 0x00000001, 0xffffffff,
+};
+
+static const uint32_t _p256_a[WORDS] = {
+    0xfffffffc, 0xffffffff, 0xffffffff, 0x00000000,
+    0x00000000, 0x00000000, 0x00000001, 0xffffffff,
+};
+
+static const uint32_t _p256_b[WORDS] = {
+    0x27d2604b, 0x3bce3c3e, 0xcc53b0f6, 0x651d06b0,
+    0x769886bc, 0xb3ebbd55, 0xaa3a93e7, 0x5ac635d8,
+};
+
+static mutex_t _lock = MUTEX_INIT;
+static mutex_t _done = MUTEX_INIT_LOCKED;
+
+void isr_pka(void)
+{
+    /* the interrupt stays asserted while the engine is idle */
+    NVIC_DisableIRQ(PKA_ALT_IRQn);
+    mutex_unlock(&_done);
+    cortexm_isr_end();
+}
+
+static unsigned _put_words(unsigned off, const uint32_t *src)
+{
+    for (unsigned i = 0; i < WORDS; i++) {
+        PKA_RAM[off + i] = src[i];
+    }
+    return off + STRIDE;
+}
+
+static unsigned _put_be(unsigned off, const uint8_t *src)
+{
+    /* big endian bytes to least significant word first */
+    for (unsigned i = 0; i < WORDS; i++) {
+        be_uint32_t w;
+        memcpy(&w, src + (WORDS - 1 - i) * sizeof(w), sizeof(w));
+        PKA_RAM[off + i] = byteorder_ntohl(w);
+    }
+    return off + STRIDE;
+}
+
+static unsigned _get_be(unsigned off, uint8_t *dst)
+{
+    for (unsigned i = 0; i < WORDS; i++) {
+        be_uint32_t w = byteorder_htonl(PKA_RAM[off + i]);
+        memcpy(dst + (WORDS - 1 - i) * sizeof(w), &w, sizeof(w));
+    }
+    return off + STRIDE;
+}
+
+static void _acquire(void)
+{
+    mutex_lock(&_lock);
+    SYS_CTRL->RCGCSEC |= RCGCSEC_PKA;
+}
+
+static void _release(void)
+{
+    /* the sequencer uses the RAM after the result as scratch, do not leave
+     * secrets there */
+    for (unsigned i = 0; i < PKA_RAM_WORDS; i++) {
+        PKA_RAM[i] = 0;
+    }
+    SYS_CTRL->RCGCSEC &= ~RCGCSEC_PKA;
+    mutex_unlock(&_lock);
+}
+
+static int _run(uint32_t function, unsigned result, uint8_t *dst)
+{
+    PKA_FUNCTION = PKA_FUNCTION_RUN | function;
+
+    NVIC_ClearPendingIRQ(PKA_ALT_IRQn);
+    NVIC_EnableIRQ(PKA_ALT_IRQn);
+    mutex_lock(&_done);
+
+    switch (PKA_SHIFT) {
+    case PKA_SHIFT_OK:
+        result = _get_be(result, dst);
+        _get_be(result, dst + CRYPTO_ECC_P256_SIZE);
+        return 0;
+    case PKA_SHIFT_INFINITY:
+        return -EDOM;
+    default:
+        DEBUG("crypto_ecc: sequencer error %lu\n", (unsigned long)PKA_SHIFT);
+        return -EIO;
+    }
+}
+
+int crypto_ecc_p256_mul(const uint8_t *scalar, const uint8_t *point,
+                        uint8_t *result)
+{
+    unsigned off = 0;
+
+    _acquire();
+
+    /* A: scalar, B: p, a and b, C: point, D: result */
+    PKA_APTR = off;
+    off = _put_be(off, scalar);
+    PKA_BPTR = off;
+    off = _put_words(off, _p256_p);
+    off = _put_words(off, _p256_a);
+    off = _put_words(off, _p256_b);
+    PKA_CPTR = off;
+    off = _put_be(off, point);
+    off = _put_be(off, point + CRYPTO_ECC_P256_SIZE);
+    PKA_DPTR = off;
+    PKA_ALENGTH = WORDS;
+    PKA_BLENGTH = WORDS;
+
+    int res = _run(PKA_FUNCTION_ECCMUL, off, result);
+
+    _release();
+    return res;
+}
+
+int crypto_ecc_p256_add(const uint8_t *a, const uint8_t *b, uint8_t *result)
+{
+    unsigned off = 0;
+
+    _acquire();
+
+    /* A: first point, B: p and a, C: second point, D: result */
+    PKA_APTR = off;
+    off = _put_be(off, a);
+    off = _put_be(off, a + CRYPTO_ECC_P256_SIZE);
+    PKA_BPTR = off;
+    off = _put_words(off, _p256_p);
+    off = _put_words(off, _p256_a);
+    PKA_CPTR = off;
+    off = _put_be(off, b);
+    off = _put_be(off, b + CRYPTO_ECC_P256_SIZE);
+    PKA_DPTR = off;
+    PKA_BLENGTH = WORDS;
+
+    int res = _run(PKA_FUNCTION_ECCADD, off, result);
+
+    _release();
+    return res;
+}
@@ -21,6 +21,9 @@
  * @}
  */
 
+#include <errno.h>
+#include <string.h>
+
 #include "cc2538_rf.h"
 
 #define ENABLE_DEBUG (0)
@@ -241,6 +244,140 @@ void cc2538_set_pan(uint16_t pan)
     RFCORE_FFSM_PAN_ID1 = pan >> 8;
 }
 
+/* the source address table takes 24 short addresses of 4 bytes, PAN ID and
+ * address, or 12 long addresses of 8 bytes in the place of two short ones */
+#define SRC_MATCH_SLOTS     (24U)
+/* SRCMATCH: matching, AUTOPEND and pending for data requests only */
+#define SRC_MATCH_AUTOPEND  (0x07)
+
+static uint32_t _get_mask(cc2538_reg_t *reg)
+{
+    return reg[0] | (reg[1] << 8) | (reg[2] << 16);
+}
+
+static void _set_mask(cc2538_reg_t *reg, uint32_t mask)
+{
+    reg[0] = mask & 0xff;
+    reg[1] = (mask >> 8) & 0xff;
+    reg[2] = (mask >> 16) & 0xff;
+}
+
+/* converts an address to a table entry, returns the entry length */
+static int _src_match_entry(uint8_t *entry, const uint8_t *addr, size_t len)
+{
+    if (len == IEEE802154_SHORT_ADDRESS_LEN) {
+        entry[0] = RFCORE_FFSM_PAN_ID0;
+        entry[1] = RFCORE_FFSM_PAN_ID1;
+        entry[2] = addr[1];
+        entry[3] = addr[0];
+        return 4;
+    }
+    if (len == IEEE802154_LONG_ADDRESS_LEN) {
+        /* the table is in over-the-air, i.e. little endian, byte order */
+        for (unsigned i = 0; i < len; i++) {
+            entry[i] = addr[len - 1 - i];
+        }
+        return len;
+    }
+    return -EINVAL;
+}
+
+/* returns the slot of an entry, or -1 */
+static int _src_match_find(const uint8_t *entry, int len)
+{
+    uint32_t en = (len == 4) ? _get_mask(&RFCORE_XREG_SRCSHORTEN0)
+                             : _get_mask(&RFCORE_XREG_SRCEXTEN0);
+    unsigned step = len / 4;
+
+    for (unsigned slot = 0; slot < SRC_MATCH_SLOTS; slot += step) {
+        if (!(en & (1UL << slot))) {
+            continue;
+        }
+        int i = 0;
+        while ((i < len) &&
+               (RFCORE_FFSM_SRC_ADDR_TABLE[slot * 4 + i] == entry[i])) {
+            i++;
+        }
+        if (i == len) {
+            return slot;
+        }
+    }
+    return -1;
+}
+
+int cc2538_src_match_add(const uint8_t *addr, size_t len)
+{
+    uint8_t entry[IEEE802154_LONG_ADDRESS_LEN];
+    int entry_len = _src_match_entry(entry, addr, len);
+
+    if (entry_len < 0) {
+        return entry_len;
+    }
+    if (_src_match_find(entry, entry_len) >= 0) {
+        return 0;
+    }
+
+    uint32_t short_en = _get_mask(&RFCORE_XREG_SRCSHORTEN0);
+    uint32_t ext_en = _get_mask(&RFCORE_XREG_SRCEXTEN0);
+    /* a long address is enabled by the bit of its first slot */
+    uint32_t used = short_en | ext_en | (ext_en << 1);
+    uint32_t need = (entry_len == 4) ? 0x1 : 0x3;
+    unsigned step = entry_len / 4;
+
+    for (unsigned slot = 0; slot < SRC_MATCH_SLOTS; slot += step) {
+        if (used & (need << slot)) {
+            continue;
+        }
+        for (int i = 0; i < entry_len; i++) {
+            RFCORE_FFSM_SRC_ADDR_TABLE[slot * 4 + i] = entry[i];
+        }
+        if (entry_len == 4) {
+            _set_mask(&RFCORE_FFSM_SRCSHORTPENDEN0,
+                      _get_mask(&RFCORE_FFSM_SRCSHORTPENDEN0) | (1UL << slot));
+            _set_mask(&RFCORE_XREG_SRCSHORTEN0, short_en | (1UL << slot));
+        }
+        else {
+            _set_mask(&RFCORE_FFSM_SRCEXTPENDEN0,
+                      _get_mask(&RFCORE_FFSM_SRCEXTPENDEN0) | (1UL << slot));
+            _set_mask(&RFCORE_XREG_SRCEXTEN0, ext_en | (1UL << slot));
+        }
+        RFCORE_XREG_SRCMATCH = SRC_MATCH_AUTOPEND;
+        DEBUG("%s(): added entry in slot %u\n", __FUNCTION__, slot);
+        return 0;
+    }
+    return -ENOMEM;
+}
+
+int cc2538_src_match_del(const uint8_t *addr, size_t len)
+{
+    uint8_t entry[IEEE802154_LONG_ADDRESS_LEN];
+
+    if (len == 0) {
+        _set_mask(&RFCORE_XREG_SRCSHORTEN0, 0);
+        _set_mask(&RFCORE_XREG_SRCEXTEN0, 0);
+        return 0;
+    }
+
+    int entry_len = _src_match_entry(entry, addr, len);
+    if (entry_len < 0) {
+        return entry_len;
+    }
+
+    int slot = _src_match_find(entry, entry_len);
+    if (slot < 0) {
+        return -ENOENT;
+    }
+    if (entry_len == 4) {
+        _set_mask(&RFCORE_XREG_SRCSHORTEN0,
+                  _get_mask(&RFCORE_XREG_SRCSHORTEN0) & ~(1UL << slot));
+    }
+    else {
+        _set_mask(&RFCORE_XREG_SRCEXTEN0,
+                  _get_mask(&RFCORE_XREG_SRCEXTEN0) & ~(1UL << slot));
+    }
+    return 0;
+}
+
 void cc2538_set_tx_power(int dBm)
 {
     DEBUG("%s(%i): Setting TX power to ", __FUNCTION__, dBm);
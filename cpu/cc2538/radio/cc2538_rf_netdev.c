@@ -226,6 +226,20 @@ static int _set(netdev_t *netdev, netopt_t opt, const void *value, size_t value_
             res = sizeof(netopt_enable_t);
             break;
 
+        case NETOPT_SRC_MATCH_ADD:
+            res = cc2538_src_match_add(value, value_len);
+            if (res == 0) {
+                res = value_len;
+            }
+            break;
+
+        case NETOPT_SRC_MATCH_DEL:
+            res = cc2538_src_match_del(value, value_len);
+            if (res == 0) {
+                res = value_len;
+            }
+            break;
+
         case NETOPT_STATE:
             if (value_len > sizeof(netopt_state_t)) {
                 return -EOVERFLOW;
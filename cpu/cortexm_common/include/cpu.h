@@ -102,6 +102,11 @@ static inline void cortexm_init_fpu(void)
 #if defined(CPU_CORE_CORTEX_M4F) || defined(CPU_CORE_CORTEX_M7)
     /* give full access to the FPU */
     SCB->CPACR |= (uint32_t)CORTEXM_SCB_CPACR_FPU_ACCESS_FULL;
+    /* make sure automatic and lazy FP state preservation are enabled: a
+     * thread only gets an extended (FP) exception frame once it used the
+     * FPU, and s0-s15 are only written to it if the handler touches the
+     * FPU as well */
+    FPU->FPCCR |= FPU_FPCCR_ASPEN_Msk | FPU_FPCCR_LSPEN_Msk;
 #endif
 }
 
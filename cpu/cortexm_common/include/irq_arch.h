@@ -29,6 +29,16 @@
 extern "C" {
 #endif
 
+#if defined(MODULE_SCHEDSTATISTICS_IRQ) || defined(DOXYGEN)
+/**
+ * @name    IRQ-disabled time accounting hooks of @ref schedstatistics
+ * @{
+ */
+void schedstat_irq_off(void);
+void schedstat_irq_on(void);
+/** @} */
+#endif
+
 /**
  * @brief Disable all maskable interrupts
  */
@@ -37,6 +47,11 @@ static inline __attribute__((always_inline)) unsigned int irq_disable(void)
     uint32_t mask = __get_PRIMASK();
 
     __disable_irq();
+#ifdef MODULE_SCHEDSTATISTICS_IRQ
+    if (!mask) {
+        schedstat_irq_off();
+    }
+#endif
     return mask;
 }
 
@@ -48,6 +63,11 @@ irq_enable(void)
 {
     unsigned result = __get_PRIMASK();
 
+#ifdef MODULE_SCHEDSTATISTICS_IRQ
+    if (result) {
+        schedstat_irq_on();
+    }
+#endif
     __enable_irq();
     return result;
 }
@@ -58,6 +78,11 @@ irq_enable(void)
 static inline __attribute__((always_inline)) void irq_restore(
     unsigned int state)
 {
+#ifdef MODULE_SCHEDSTATISTICS_IRQ
+    if (!state && __get_PRIMASK()) {
+        schedstat_irq_on();
+    }
+#endif
     __set_PRIMASK(state);
 }
 
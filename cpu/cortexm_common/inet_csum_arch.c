@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2020 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_cortexm_common
+ * @{
+ *
+ * @file
+ * @brief       Internet checksum word summation using add with carry
+ *
+ * @}
+ */
+
+#include "cpu.h"
+
+#if IS_USED(MODULE_INET_CSUM_ARCH)
+
+#include "net/inet_csum.h"
+
+uint32_t inet_csum_words(uint32_t sum, const uint32_t *buf, size_t words)
+{
+    uint32_t carries = 0;
+    uint32_t a, b, c, d;
+
+    /* ADCS adds the carry of the previous addition, so only the carry of
+     * every fourth word has to be collected */
+    for (; words >= 4; words -= 4) {
+        __asm__ (
+            "ldrd   %[a], %[b], [%[buf]], #8        \n"
+            "ldrd   %[c], %[d], [%[buf]], #8        \n"
+            "adds   %[sum], %[sum], %[a]            \n"
+            "adcs   %[sum], %[sum], %[b]            \n"
+            "adcs   %[sum], %[sum], %[c]            \n"
+            "adcs   %[sum], %[sum], %[d]            \n"
+            "adc    %[carries], %[carries], #0      \n"
+            : [sum] "+r" (sum), [carries] "+r" (carries), [buf] "+r" (buf),
+              [a] "=&r" (a), [b] "=&r" (b), [c] "=&r" (c), [d] "=&r" (d)
+            :
+            : "cc", "memory"
+        );
+    }
+    for (; words > 0; words--) {
+        a = *buf++;
+        __asm__ (
+            "adds   %[sum], %[sum], %[a]            \n"
+            "adc    %[carries], %[carries], #0      \n"
+            : [sum] "+r" (sum), [carries] "+r" (carries)
+            : [a] "r" (a)
+            : "cc"
+        );
+    }
+    /* carries is small, so adding the last carry does not overflow */
+    __asm__ (
+        "adds   %[sum], %[sum], %[carries]          \n"
+        "adc    %[sum], %[sum], #0                  \n"
+        : [sum] "+r" (sum)
+        : [carries] "r" (carries)
+        : "cc"
+    );
+
+    return sum;
+}
+
+#endif
@@ -156,7 +156,7 @@ char *thread_stack_init(thread_task_func_t task_func,
     /* ****************************** */
 
     /* The following eight stacked registers are popped by the hardware upon
-     * return from exception. (bx instruction in select_and_restore_context) */
+     * return from exception. (bx instruction in restore_context) */
 
     /* xPSR - initial status register */
     stk--;
@@ -184,7 +184,7 @@ char *thread_stack_init(thread_task_func_t task_func,
     /* ************************* */
 
     /* The following registers are not handled by hardware in return from
-     * exception, but manually by select_and_restore_context.
+     * exception, but manually by restore_context.
      * For the Cortex-M0(plus) we write registers R11-R4 in two groups to allow
      * for more efficient context save/restore code.
      * For the Cortex-M3 and Cortex-M4 we write them continuously onto the stack
@@ -276,30 +276,45 @@ __attribute__((naked)) void NORETURN cpu_switch_context_exit(void)
     :::);
 }
 
-void thread_yield_higher(void)
+void RAMFUNC_HOT thread_yield_higher(void)
 {
     /* trigger the PENDSV interrupt to run scheduler and schedule new thread if
      * applicable */
     SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
 }
 
-void __attribute__((naked)) __attribute__((used)) isr_pendsv(void) {
+void __attribute__((naked)) __attribute__((used)) RAMFUNC_HOT isr_pendsv(void) {
     __asm__ volatile (
     /* PendSV handler entry point */
-    /* save context by pushing unsaved registers to the stack */
     /* {r0-r3,r12,LR,PC,xPSR,s0-s15,FPSCR} are saved automatically on exception entry */
     ".thumb_func                      \n"
 
-    /* skip context saving if sched_active_thread == NULL */
-    "ldr    r1, =sched_active_thread  \n" /* r1 = &sched_active_thread  */
-    "ldr    r1, [r1]                  \n" /* r1 = sched_active_thread   */
+    /* run the scheduler first: it follows the calling convention, so r4-r11
+     * and s16-s31 still hold the values of the interrupted thread after it
+     * returned */
+    "ldr    r0, =sched_active_thread  \n" /* r0 = &sched_active_thread  */
+    "ldr    r0, [r0]                  \n" /* r0 = sched_active_thread   */
+    "push   {r0, lr}                  \n" /* keep previous thread and
+                                           * exception return value */
+    "bl     sched_run                 \n" /* perform scheduling */
+    "pop    {r1, r2}                  \n" /* r1 = previous thread,
+                                           * r2 = exception return value */
+    "mov    lr, r2                    \n"
+    "cmp    r0, #0                    \n" /* if the active thread did not
+                                           * change: */
+    "bne    save_context              \n"
+    "bx     lr                        \n" /*   return to it right away */
+
+    "save_context:                    \n"
+    /* skip context saving if there was no previous thread */
     "cmp    r1, #0                    \n" /* if r1 == NULL:             */
-    "beq select_and_restore_context   \n" /*   goto select_and_restore_context */
+    "beq    restore_context           \n" /*   goto restore_context     */
 
+    /* save context by pushing unsaved registers to the stack */
     "mrs    r0, psp                   \n" /* get stack pointer from user mode */
 #if defined(CPU_CORE_CORTEX_M0) || defined(CPU_CORE_CORTEX_M0PLUS) \
     || defined(CPU_CORE_CORTEX_M23)
-    "push   {r1}                      \n" /* push sched_active_thread */
+    "push   {r1}                      \n" /* push previous thread */
     "mov    r12, sp                   \n" /* remember the exception SP */
     "mov    sp, r0                    \n" /* set user mode SP as active SP */
     /* we can not push high registers directly, so we move R11-R8 into
@@ -313,7 +328,7 @@ void __attribute__((naked)) __attribute__((used)) isr_pendsv(void) {
     "push   {r0}                      \n"
     "mov    r0, sp                    \n" /* switch back to the exception SP */
     "mov    sp, r12                   \n"
-    "pop    {r1}                      \n" /* r1 = sched_active_thread */
+    "pop    {r1}                      \n" /* r1 = previous thread */
 #else
 #if (defined(CPU_CORE_CORTEX_M4F) || defined(CPU_CORE_CORTEX_M7)) && defined(MODULE_CORTEXM_FPU)
     "tst    lr, #0x10                 \n"
@@ -325,11 +340,9 @@ void __attribute__((naked)) __attribute__((used)) isr_pendsv(void) {
 #endif
     "str    r0, [r1]                  \n" /* write r0 to thread->sp */
 
-    /* current thread context is now saved */
+    /* previous thread context is now saved */
 
-    "select_and_restore_context:      \n"
-
-    "bl     sched_run                 \n" /* perform scheduling */
+    "restore_context:                 \n"
 
     /* restore now current thread context */
 #if defined(CPU_CORE_CORTEX_M0) || defined(CPU_CORE_CORTEX_M0PLUS) \
@@ -372,7 +385,7 @@ void __attribute__((naked)) __attribute__((used)) isr_pendsv(void) {
 }
 
 #ifdef MODULE_CORTEXM_SVC
-void __attribute__((naked)) __attribute__((used)) isr_svc(void)
+void __attribute__((naked)) __attribute__((used)) RAMFUNC_HOT isr_svc(void)
 {
     /* these two variants do exactly the same, but Cortex-M3 can use Thumb2
      * conditional execution, which are a bit faster. */
@@ -441,7 +454,7 @@ static void __attribute__((used)) _svc_dispatch(unsigned int *svc_args)
 }
 
 #else /* MODULE_CORTEXM_SVC */
-void __attribute__((used)) isr_svc(void)
+void __attribute__((used)) RAMFUNC_HOT isr_svc(void)
 {
     SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
 }
@@ -240,6 +240,11 @@ static int _esp_can_send(candev_t *candev, const struct can_frame *frame)
     assert(dev);
     assert(frame);
 
+    if (can_frame_is_fd(frame)) {
+        /* the SJA1000 compatible controller only supports classic CAN */
+        return -ENOTSUP;
+    }
+
     critical_enter();
 
     /* check wthere the device is already transmitting a frame */
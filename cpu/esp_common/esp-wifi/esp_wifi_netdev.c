@@ -105,9 +105,6 @@ static const netdev_driver_t _esp_wifi_driver;
 /** guard variable to avoid reentrance to _esp_wifi_send function */
 static bool _esp_wifi_send_is_in = false;
 
-/** guard variable to to decive when receive buffer can be overwritten */
-static bool _esp_wifi_rx_in_progress = false;
-
 extern esp_err_t esp_system_event_add_handler (system_event_cb_t handler,
                                                void *arg);
 
@@ -319,11 +316,12 @@ esp_err_t _esp_wifi_rx_cb(void *buffer, uint16_t len, void *eb)
     ESP_WIFI_DEBUG("buf=%p len=%d eb=%p", buffer, len, eb);
 
     /*
-     * The ring buffer uses two bytes for the pkt length, followed by the
-     * actual packet data.
+     * The frame is queued by reference, the RX buffer of the WiFi driver is
+     * only freed once the frame has been read.
      */
-    if (ringbuffer_get_free(&_esp_wifi_dev.rx_buf) < len + sizeof(uint16_t)) {
-        ESP_WIFI_DEBUG("buffer full, dropping incoming packet of %d bytes", len);
+    int idx = cib_put(&_esp_wifi_dev.rx_cib);
+    if (idx < 0) {
+        ESP_WIFI_DEBUG("queue full, dropping incoming packet of %d bytes", len);
         /* free the receive buffer */
         if (eb) {
             esp_wifi_internal_free_rx_buffer(eb);
@@ -336,14 +334,9 @@ esp_err_t _esp_wifi_rx_cb(void *buffer, uint16_t len, void *eb)
         return ESP_OK;
     }
 
-    /* store length information as first two bytes */
-    ringbuffer_add(&_esp_wifi_dev.rx_buf, (char *)&len, sizeof(uint16_t));
-
-    /* copy the buffer and free WiFi driver buffer */
-    ringbuffer_add(&_esp_wifi_dev.rx_buf, (char *)buffer, len);
-    if (eb) {
-        esp_wifi_internal_free_rx_buffer(eb);
-    }
+    _esp_wifi_dev.rx_queue[idx].buffer = (void *)buffer;
+    _esp_wifi_dev.rx_queue[idx].eb = (void *)eb;
+    _esp_wifi_dev.rx_queue[idx].len = len;
 
     /*
      * Because this function is not executed in interrupt context but in thread
@@ -562,6 +555,19 @@ static int _esp_wifi_send(netdev_t *netdev, const iolist_t *iolist)
     }
 }
 
+/* removes the oldest frame from the RX queue and frees its RX buffer */
+static void _esp_wifi_rx_pop(esp_wifi_netdev_t *dev,
+                             const esp_wifi_rx_frame_t *frame)
+{
+    critical_enter();
+    cib_get(&dev->rx_cib);
+    critical_exit();
+
+    if (frame->eb) {
+        esp_wifi_internal_free_rx_buffer(frame->eb);
+    }
+}
+
 static int _esp_wifi_recv(netdev_t *netdev, void *buf, size_t len, void *info)
 {
     ESP_WIFI_DEBUG("%p %p %u %p", netdev, buf, len, info);
@@ -569,25 +575,26 @@ static int _esp_wifi_recv(netdev_t *netdev, void *buf, size_t len, void *info)
     assert(netdev != NULL);
 
     esp_wifi_netdev_t* dev = (esp_wifi_netdev_t*)netdev;
-    uint16_t size;
+    esp_wifi_rx_frame_t frame;
 
     critical_enter();
-
-    _esp_wifi_rx_in_progress = true;
-
-    if (ringbuffer_peek(&dev->rx_buf, (char *)&size, sizeof(uint16_t)) < sizeof(uint16_t)) {
+    int idx = cib_peek(&dev->rx_cib);
+    if (idx < 0) {
         critical_exit();
         return 0;
     }
+    /* the slot is not reused before it is removed from the queue */
+    frame = dev->rx_queue[idx];
+    critical_exit();
+
+    uint16_t size = frame.len;
 
     if (!buf) {
         /* get the size of the frame */
-        if (len > 0 && size) {
+        if (len > 0) {
             /* if len > 0, drop the frame */
-            ringbuffer_remove(&dev->rx_buf, sizeof(uint16_t) + size);
-            _esp_wifi_rx_in_progress = false;
+            _esp_wifi_rx_pop(dev, &frame);
         }
-        critical_exit();
         return size;
     }
 
@@ -595,15 +602,13 @@ static int _esp_wifi_recv(netdev_t *netdev, void *buf, size_t len, void *info)
         /* buffer is smaller than the number of received bytes */
         ESP_WIFI_DEBUG("not enough space in receive buffer");
         /* newest API requires to drop the frame in that case */
-        ringbuffer_remove(&dev->rx_buf, sizeof(uint16_t) + size);
-        _esp_wifi_rx_in_progress = false;
-        critical_exit();
+        _esp_wifi_rx_pop(dev, &frame);
         return -ENOBUFS;
     }
 
-    /* remove length bytes, copy the buffer to the ringbuffer and free it */
-    ringbuffer_remove(&dev->rx_buf, sizeof(uint16_t));
-    ringbuffer_get(&dev->rx_buf, buf, size);
+    /* the only copy of the frame, straight from the RX buffer */
+    memcpy(buf, frame.buffer, size);
+    _esp_wifi_rx_pop(dev, &frame);
 
 #if ENABLE_DEBUG
     ethernet_hdr_t *hdr = (ethernet_hdr_t *)buf;
@@ -615,7 +620,6 @@ static int _esp_wifi_recv(netdev_t *netdev, void *buf, size_t len, void *info)
 #endif /* MODULE_OD && ENABLE_DEBUG_HEXDUMP */
 #endif /* ENABLE_DEBUG */
 
-    critical_exit();
     return size;
 }
 
@@ -769,8 +773,8 @@ void esp_wifi_setup (esp_wifi_netdev_t* dev)
 {
     ESP_WIFI_DEBUG("dev=%p", dev);
 
-    /* initialize buffer */
-    ringbuffer_init(&dev->rx_buf, (char*)dev->rx_mem, sizeof(dev->rx_mem));
+    /* initialize the RX queue */
+    cib_init(&dev->rx_cib, ESP_WIFI_RX_QUEUE_LEN);
 
     /* set the event handler */
     esp_system_event_add_handler(_esp_system_event_handler, NULL);
@@ -21,20 +21,25 @@
 
 #include <stdbool.h>
 
+#include "cib.h"
 #include "mutex.h"
 #include "net/ethernet.h"
 #include "net/netdev.h"
-#include "ringbuffer.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 /**
- * @brief   Buffer size used for RX buffering
+ * @brief   Number of received frames that can be queued, must be a power of 2
+ *
+ * Received frames are queued by reference to the RX buffers of the WiFi
+ * driver, which are freed once the frame is read. The WiFi driver stops
+ * receiving while all of its RX buffers are held, so the queue should be
+ * shorter than the number of these buffers.
  */
-#ifndef ESP_WIFI_BUFSIZE
-#define ESP_WIFI_BUFSIZE (ETHERNET_MAX_LEN << 1)
+#ifndef ESP_WIFI_RX_QUEUE_LEN
+#define ESP_WIFI_RX_QUEUE_LEN   (8)
 #endif
 
 /**
@@ -42,6 +47,15 @@ extern "C" {
  */
 extern const netdev_driver_t esp_wifi_driver;
 
+/**
+ * @brief   Received frame in an RX buffer of the WiFi driver
+ */
+typedef struct {
+    void *buffer;                      /**< frame */
+    void *eb;                          /**< RX buffer to free, may be NULL */
+    uint16_t len;                      /**< length of the frame */
+} esp_wifi_rx_frame_t;
+
 /**
  * @brief   Device descriptor for ESP WiFi devices
  */
@@ -49,8 +63,8 @@ typedef struct
 {
     netdev_t netdev;                   /**< netdev parent struct */
 
-    uint8_t rx_mem[ESP_WIFI_BUFSIZE];  /**< memory holding incoming packages */
-    ringbuffer_t rx_buf;               /**< ringbuffer for incoming packages */
+    esp_wifi_rx_frame_t rx_queue[ESP_WIFI_RX_QUEUE_LEN]; /**< received frames */
+    cib_t rx_cib;                      /**< index of @p rx_queue */
 
     uint16_t tx_len;                   /**< number of bytes in transmit buffer */
     uint8_t tx_buf[ETHERNET_MAX_LEN];  /**< transmit buffer */
@@ -44,6 +44,18 @@
  */
 #define IRQ_API_INLINED     (1)
 
+/**
+ * @brief   Allow interrupts of a higher PLIC priority to preempt the
+ *          callback of an external interrupt
+ *
+ * The callback then runs with the PLIC threshold raised to the priority of
+ * its source and interrupts enabled. Timer and software interrupts are not
+ * masked by the threshold and may preempt it as well.
+ */
+#ifndef CONFIG_FE310_IRQ_NESTING
+#define CONFIG_FE310_IRQ_NESTING    0
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -34,15 +34,18 @@
 /* Default state of mstatus register */
 #define MSTATUS_DEFAULT     (MSTATUS_MPP | MSTATUS_MPIE)
 
+/* Mode bits of mtvec, interrupts jump to base + 4 * cause */
+#define MTVEC_VECTORED      (1)
+
 volatile int fe310_in_isr = 0;
 
 /* PLIC external ISR function list */
 static external_isr_ptr_t _ext_isrs[PLIC_NUM_INTERRUPTS];
 
 /**
- * @brief   ISR trap vector
+ * @brief   ISR trap vector table
  */
-void trap_entry(void);
+void trap_vectors(void);
 
 /**
  * @brief   Timer ISR
@@ -54,8 +57,9 @@ void irq_init(void)
     volatile uint64_t *mtimecmp =
         (uint64_t *) (CLINT_CTRL_ADDR + CLINT_MTIMECMP);
 
-    /* Setup trap handler function */
-    write_csr(mtvec, &trap_entry);
+    /* Setup trap vector table, local interrupts enter their handlers
+     * directly */
+    write_csr(mtvec, (uintptr_t)&trap_vectors | MTVEC_VECTORED);
 
     /* Clear all interrupt enables */
     write_csr(mie, 0);
@@ -93,14 +97,46 @@ void external_isr(void)
     uint32_t intNum = (uint32_t)PLIC_claim_interrupt();
 
     if ((intNum > 0) && (intNum < PLIC_NUM_INTERRUPTS) && (_ext_isrs[intNum] != NULL)) {
+#if CONFIG_FE310_IRQ_NESTING
+        /* Only sources of a higher priority may preempt the callback */
+        volatile uint32_t *threshold = (uint32_t *)(PLIC_CTRL_ADDR +
+                                        PLIC_THRESHOLD_OFFSET +
+                                        (read_csr(mhartid) <<
+                                         PLIC_THRESHOLD_SHIFT_PER_TARGET));
+        uint32_t prev = *threshold;
+
+        *threshold = *(volatile uint32_t *)(PLIC_CTRL_ADDR +
+                                            PLIC_PRIORITY_OFFSET +
+                                            (intNum <<
+                                             PLIC_PRIORITY_SHIFT_PER_SOURCE));
+        unsigned state = irq_enable();
+        _ext_isrs[intNum](intNum);
+        irq_restore(state);
+        *threshold = prev;
+#else
         _ext_isrs[intNum](intNum);
+#endif
     }
 
     PLIC_complete_interrupt(intNum);
 }
 
+/**
+ * @brief Software interrupt handler
+ */
+void software_isr(void)
+{
+    /* Flag for context switch */
+    sched_context_switch_request = 1;
+    CLINT_REG(0) = 0;
+}
+
 /**
  * @brief Global trap and interrupt handler
+ *
+ * Local interrupts are vectored to their handlers, so this only sees
+ * exceptions and interrupts without a vector entry. The context switch
+ * requested by a handler is done by the trap entry code.
  */
 void handle_trap(unsigned int mcause, unsigned int mepc, unsigned int mtval)
 {
@@ -108,18 +144,13 @@ void handle_trap(unsigned int mcause, unsigned int mepc, unsigned int mtval)
     (void) mepc;
     (void) mtval;
 #endif
-    /*  Tell RIOT to set sched_context_switch_request instead of
-     *  calling thread_yield(). */
-    fe310_in_isr = 1;
-
     /* Check for INT or TRAP */
     if ((mcause & MCAUSE_INT) == MCAUSE_INT) {
         /* Cause is an interrupt - determine type */
         switch (mcause & MCAUSE_CAUSE) {
             case IRQ_M_SOFT:
-                /* Handle software interrupt - flag for context switch */
-                sched_context_switch_request = 1;
-                CLINT_REG(0) = 0;
+                /* Handle software interrupt */
+                software_isr();
                 break;
 
 #ifdef MODULE_PERIPH_TIMER
@@ -149,12 +180,4 @@ void handle_trap(unsigned int mcause, unsigned int mepc, unsigned int mtval)
         /* Unknown trap */
         core_panic(PANIC_GENERAL_ERROR, "Unhandled trap");
     }
-
-    /* Check if context change was requested */
-    if (sched_context_switch_request) {
-        sched_run();
-    }
-
-    /* ISR done - no more changes to thread states */
-    fe310_in_isr = 0;
 }
@@ -23,7 +23,7 @@ __attribute__((naked)) void thread_yield_higher(void)
     __asm__("push r2"); /* save SR */
     __disable_irq();
 
-    __save_context();
+    __save_context_yield();
 
     /* have sched_active_thread point to the next thread */
     sched_run();
@@ -100,10 +100,13 @@ char *thread_stack_init(thread_task_func_t task_func, void *arg, void *stack_sta
     --stackptr;
 
     /* Space for registers. */
-    for (unsigned int i = 14; i > 4; i--) {
+    for (unsigned int i = 14; i >= 4; i--) {
         *stackptr = i;
         --stackptr;
     }
 
+    /* the new thread is entered like one preempted by an interrupt */
+    *stackptr = MSP430_CONTEXT_FULL;
+
     return (char *) stackptr;
 }
@@ -77,6 +77,14 @@ extern volatile int __irq_is_in;
  */
 extern char __isr_stack[ISR_STACKSIZE];
 
+/**
+ * @name    Type of a saved context, pushed last
+ * @{
+ */
+#define MSP430_CONTEXT_YIELD    (0)     /**< only call-saved registers */
+#define MSP430_CONTEXT_FULL     (1)     /**< all registers */
+/** @} */
+
 /**
  * @brief   Save the current thread context from inside an ISR
  */
@@ -94,6 +102,28 @@ static inline void __attribute__((always_inline)) __save_context(void)
     __asm__("push r6");
     __asm__("push r5");
     __asm__("push r4");
+    __asm__("push %0" : : "i"(MSP430_CONTEXT_FULL));
+
+    __asm__("mov.w r1,%0" : "=r"(sched_active_thread->sp));
+}
+
+/**
+ * @brief   Save the current thread context in thread_yield_higher()
+ *
+ * The caller expects the call-clobbered registers r12 - r15 to be lost, so
+ * only the call-saved ones are saved.
+ */
+static inline void __attribute__((always_inline)) __save_context_yield(void)
+{
+    __asm__("push r11");
+    __asm__("push r10");
+    __asm__("push r9");
+    __asm__("push r8");
+    __asm__("push r7");
+    __asm__("push r6");
+    __asm__("push r5");
+    __asm__("push r4");
+    __asm__("push %0" : : "i"(MSP430_CONTEXT_YIELD));
 
     __asm__("mov.w r1,%0" : "=r"(sched_active_thread->sp));
 }
@@ -105,19 +135,24 @@ static inline void __attribute__((always_inline)) __restore_context(void)
 {
     __asm__("mov.w %0,r1" : : "m"(sched_active_thread->sp));
 
-    __asm__("pop r4");
-    __asm__("pop r5");
-    __asm__("pop r6");
-    __asm__("pop r7");
-    __asm__("pop r8");
-    __asm__("pop r9");
-    __asm__("pop r10");
-    __asm__("pop r11");
-    __asm__("pop r12");
-    __asm__("pop r13");
-    __asm__("pop r14");
-    __asm__("pop r15");
-    __asm__("reti");
+    /* the call-clobbered registers are only saved in a full context */
+    __asm__("pop r15\n\t"
+            "pop r4\n\t"
+            "pop r5\n\t"
+            "pop r6\n\t"
+            "pop r7\n\t"
+            "pop r8\n\t"
+            "pop r9\n\t"
+            "pop r10\n\t"
+            "pop r11\n\t"
+            "tst r15\n\t"
+            "jz 1f\n\t"
+            "pop r12\n\t"
+            "pop r13\n\t"
+            "pop r14\n\t"
+            "pop r15\n"
+            "1:\n\t"
+            "reti");
 }
 
 /**
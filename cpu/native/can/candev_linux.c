@@ -176,6 +176,14 @@ static int _init(candev_t *candev)
         return -1;
     }
 
+#ifdef MODULE_CAN_FD
+    int enable_fd = 1;
+    if (real_setsockopt(dev->sock, SOL_CAN_RAW, CAN_RAW_FD_FRAMES,
+                        &enable_fd, sizeof(enable_fd)) < 0) {
+        DEBUG("CAN FD frames not supported by the kernel\n");
+    }
+#endif
+
     strcpy(ifr.ifr_name, dev->conf->interface_name);
     ret = real_ioctl(dev->sock, SIOCGIFINDEX, &ifr);
 
@@ -214,7 +222,8 @@ static int _send(candev_t *candev, const struct can_frame *frame)
     int nbytes;
     candev_linux_t *dev = (candev_linux_t *)candev;
 
-    nbytes = real_write(dev->sock, frame, sizeof(struct can_frame));
+    /* the kernel tells CAN FD frames from classic ones by the size */
+    nbytes = real_write(dev->sock, frame, can_frame_size(frame));
 
     if (nbytes < frame->can_dlc) {
         real_printf("CAN write op failed, nbytes=%i\n", nbytes);
@@ -231,7 +240,12 @@ static int _send(candev_t *candev, const struct can_frame *frame)
 static void _isr(candev_t *candev)
 {
     int nbytes;
-    struct can_frame rcv_frame;
+    union {
+        struct can_frame frame;
+#ifdef MODULE_CAN_FD
+        struct canfd_frame fd_frame;
+#endif
+    } rcv;
     candev_linux_t *dev = (candev_linux_t *)candev;
 
     if (dev == NULL) {
@@ -239,35 +253,46 @@ static void _isr(candev_t *candev)
     }
 
     DEBUG("candev_native _isr: CAN SIGIO interrupt received, sock = %i\n", dev->sock);
-    nbytes = real_read(dev->sock, &rcv_frame, sizeof(struct can_frame));
+    nbytes = real_read(dev->sock, &rcv, sizeof(rcv));
 
     if (nbytes < 0) {   /* SIGIO signal was probably due to an error with the socket */
         DEBUG("candev_native _isr: read: error during read\n");
         return;
     }
 
-    if (nbytes < (int)sizeof(struct can_frame)) {
+    if (nbytes == (int)CAN_MTU) {
+        /* padding must be zero for frames not to be taken for CAN FD */
+        rcv.frame.__pad = 0;
+    }
+#ifdef MODULE_CAN_FD
+    else if (nbytes == (int)CANFD_MTU) {
+        rcv.fd_frame.flags |= CANFD_FDF;
+    }
+#endif
+    else {
         DEBUG("candev_native _isr: read: incomplete CAN frame\n");
         return;
     }
 
-    if (rcv_frame.can_id & CAN_ERR_FLAG) {
+    struct can_frame *rcv_frame = &rcv.frame;
+
+    if (rcv_frame->can_id & CAN_ERR_FLAG) {
         DEBUG("candev_native _isr: error frame\n");
-        candev_event_t evt = _can_error_to_can_evt(rcv_frame);
+        candev_event_t evt = _can_error_to_can_evt(*rcv_frame);
         if ((evt != CANDEV_EVENT_NOEVENT) && (dev->candev.event_callback)) {
             dev->candev.event_callback(&dev->candev, evt, NULL);
         }
         return;
     }
 
-    if (rcv_frame.can_id & CAN_RTR_FLAG) {
+    if (rcv_frame->can_id & CAN_RTR_FLAG) {
         DEBUG("candev_native _isr: rtr frame\n");
         return;
     }
 
     if (dev->candev.event_callback) {
         DEBUG("candev_native _isr: calling event callback\n");
-        dev->candev.event_callback(&dev->candev, CANDEV_EVENT_RX_INDICATION, &rcv_frame);
+        dev->candev.event_callback(&dev->candev, CANDEV_EVENT_RX_INDICATION, rcv_frame);
     }
 
 }
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    cpu_native_vtime  Virtual time for native
+ * @ingroup     cpu_native
+ * @brief       Discrete event time for the native periph_timer
+ *
+ * With the `native_vtime` module, the native timer no longer follows the
+ * host clock. Time starts at 0 and only advances while the RIOT instance is
+ * idle: instead of sleeping until the next timer deadline, the clock jumps
+ * to it. This runs timer heavy applications faster than real time and makes
+ * them reproducible.
+ *
+ * Without `socket_zep`, every instance advances its own clock as soon as it
+ * is idle. With `socket_zep`, the first ZEP interface reports idleness and
+ * the next deadline to the ZEP dispatcher, which advances the clocks of all
+ * instances in lockstep and serializes their execution, see
+ * `dist/tools/zep_dispatch`. The dispatcher must support virtual time,
+ * otherwise timers never fire.
+ *
+ * @note    Busy waiting on the timer (e.g. `ztimer_spin()`) never ends, as
+ *          the clock stands still while a thread is running.
+ * @note    Events that do not come through the dispatcher (`netdev_tap`,
+ *          stdin, ...) still arrive in real time.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Virtual time interface of the native timer
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+
+#ifndef NATIVE_VTIME_H
+#define NATIVE_VTIME_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Deadline reported when no timer is set
+ */
+#define NATIVE_VTIME_NEVER      (UINT64_MAX)
+
+/**
+ * @brief   Callback reporting that the instance is idle
+ *
+ * Called from the idle thread with signals deferred. The callback must not
+ * block; the instance sleeps until the next signal afterwards.
+ *
+ * @param[in]   arg         argument given to @ref native_vtime_set_idle_cb
+ * @param[in]   deadline    virtual time of the next timer event in µs,
+ *                          @ref NATIVE_VTIME_NEVER if none is set
+ */
+typedef void (*native_vtime_idle_cb_t)(void *arg, uint64_t deadline);
+
+/**
+ * @brief   Get the current virtual time
+ *
+ * @return  virtual time in µs
+ */
+uint64_t native_vtime_now(void);
+
+/**
+ * @brief   Advance the virtual time and fire the timer if it is due
+ *
+ * Must be called in interrupt context. Time never goes backwards, an older
+ * @p now is ignored.
+ *
+ * @param[in]   now     new virtual time in µs
+ */
+void native_vtime_advance(uint64_t now);
+
+/**
+ * @brief   Let an external coordinator advance the virtual time
+ *
+ * Without a coordinator, the clock jumps to the next deadline as soon as
+ * the instance is idle.
+ *
+ * @param[in]   cb      callback to report idleness to the coordinator
+ * @param[in]   arg     argument for @p cb
+ */
+void native_vtime_set_idle_cb(native_vtime_idle_cb_t cb, void *arg);
+
+/**
+ * @brief   Called by `pm_set_lowest()` before the instance sleeps
+ */
+void native_vtime_idle(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NATIVE_VTIME_H */
+/** @} */
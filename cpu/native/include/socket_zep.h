@@ -50,6 +50,30 @@ typedef struct {
     uint16_t chksum_buf;            /**< buffer for send checksum calculation */
 } socket_zep_t;
 
+/**
+ * @name    Virtual time message types
+ * @{
+ */
+#define SOCKET_ZEP_VTIME_IDLE       (1U)    /**< instance is idle until deadline */
+#define SOCKET_ZEP_VTIME_ADVANCE    (2U)    /**< advance the virtual time */
+/** @} */
+
+/**
+ * @brief   Virtual time message
+ *
+ * Exchanged with the ZEP dispatcher on the ZEP socket when the
+ * `native_vtime` module is used, see @ref cpu_native_vtime. The preamble
+ * distinguishes it from ZEP frames.
+ */
+typedef struct __attribute__((packed)) {
+    char preamble[2];       /**< "VT" */
+    uint8_t type;           /**< message type */
+    uint8_t resv;           /**< reserved, 0 */
+    network_uint32_t seq;   /**< number of the advance the message refers to */
+    network_uint32_t rx;    /**< ZEP frames received so far, idle only */
+    network_uint64_t time;  /**< deadline (idle) or new time (advance) in µs */
+} socket_zep_vtime_msg_t;
+
 /**
  * @brief   ZEP device initialization parameters
  */
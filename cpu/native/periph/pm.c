@@ -24,6 +24,7 @@
 #include "periph/pm.h"
 #include "native_internal.h"
 #include "async_read.h"
+#include "native_vtime.h"
 #include "tty_uart.h"
 
 #ifdef MODULE_PERIPH_SPIDEV_LINUX
@@ -37,6 +38,9 @@
 void pm_set_lowest(void)
 {
     _native_in_syscall++; /* no switching here */
+#ifdef MODULE_NATIVE_VTIME
+    native_vtime_idle();
+#endif
     real_pause();
     _native_in_syscall--;
 
@@ -20,6 +20,9 @@
  * This is based on native's hwtimer implementation by Ludwig Knüpfer.
  * I removed the multiplexing, as xtimer does the same. (kaspar)
  *
+ * With the native_vtime module, a virtual clock is used instead, see
+ * @ref cpu_native_vtime.
+ *
  * @author      Ludwig Knüpfer <ludwig.knuepfer@fu-berlin.de>
  * @author      Kaspar Schleiser <kaspar@schleiser.de>
  *
@@ -38,6 +41,7 @@
 #include <time.h>
 #include <sys/time.h>
 #include <signal.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
@@ -46,6 +50,7 @@
 #include "cpu.h"
 #include "cpu_conf.h"
 #include "native_internal.h"
+#include "native_vtime.h"
 #include "periph/timer.h"
 
 #define ENABLE_DEBUG (0)
@@ -60,6 +65,15 @@ static void *_cb_arg;
 
 static struct itimerval itv;
 
+#ifdef MODULE_NATIVE_VTIME
+static uint64_t _vtime_now;
+static uint64_t _vtime_deadline;
+static bool _vtime_armed;
+static native_vtime_idle_cb_t _vtime_idle_cb;
+static void *_vtime_idle_arg;
+#endif
+
+#ifndef MODULE_NATIVE_VTIME
 /**
  * returns ticks for give timespec
  */
@@ -68,6 +82,7 @@ static unsigned long ts2ticks(struct timespec *tp)
     /* TODO: check for overflow */
     return(((unsigned long)tp->tv_sec * NATIVE_TIMER_SPEED) + (tp->tv_nsec / 1000));
 }
+#endif
 
 /**
  * native timer signal handler
@@ -78,6 +93,14 @@ void native_isr_timer(void)
 {
     DEBUG("%s\n", __func__);
 
+#ifdef MODULE_NATIVE_VTIME
+    /* the itimer only wakes up the instance, the deadline decides */
+    if (!_vtime_armed || (_vtime_deadline > _vtime_now)) {
+        return;
+    }
+    _vtime_armed = false;
+#endif
+
     _callback(_cb_arg, 0);
 }
 
@@ -105,14 +128,8 @@ int timer_init(tim_t dev, unsigned long freq, timer_cb_t cb, void *arg)
     return 0;
 }
 
-static void do_timer_set(unsigned int offset)
+static void _set_itimer(unsigned int offset)
 {
-    DEBUG("%s\n", __func__);
-
-    if (offset && offset < NATIVE_TIMER_MIN_RES) {
-        offset = NATIVE_TIMER_MIN_RES;
-    }
-
     memset(&itv, 0, sizeof(itv));
     itv.it_value.tv_sec = (offset / 1000000);
     itv.it_value.tv_usec = offset % 1000000;
@@ -126,6 +143,22 @@ static void do_timer_set(unsigned int offset)
     _native_syscall_leave();
 }
 
+static void do_timer_set(unsigned int offset)
+{
+    DEBUG("%s\n", __func__);
+
+    if (offset && offset < NATIVE_TIMER_MIN_RES) {
+        offset = NATIVE_TIMER_MIN_RES;
+    }
+
+#ifdef MODULE_NATIVE_VTIME
+    _vtime_deadline = _vtime_now + offset;
+    _vtime_armed = (offset != 0);
+#else
+    _set_itimer(offset);
+#endif
+}
+
 int timer_set(tim_t dev, int channel, unsigned int offset)
 {
     (void)dev;
@@ -178,10 +211,13 @@ unsigned int timer_read(tim_t dev)
         return 0;
     }
 
-    struct timespec t;
-
     DEBUG("timer_read()\n");
 
+#ifdef MODULE_NATIVE_VTIME
+    return _vtime_now;
+#else
+    struct timespec t;
+
     _native_syscall_enter();
 #ifdef __MACH__
     clock_serv_t cclock;
@@ -201,4 +237,40 @@ unsigned int timer_read(tim_t dev)
     _native_syscall_leave();
 
     return ts2ticks(&t) - time_null;
+#endif
+}
+
+#ifdef MODULE_NATIVE_VTIME
+uint64_t native_vtime_now(void)
+{
+    return _vtime_now;
+}
+
+void native_vtime_advance(uint64_t now)
+{
+    if (now > _vtime_now) {
+        _vtime_now = now;
+    }
+    native_isr_timer();
+}
+
+void native_vtime_set_idle_cb(native_vtime_idle_cb_t cb, void *arg)
+{
+    _vtime_idle_arg = arg;
+    _vtime_idle_cb = cb;
 }
+
+void native_vtime_idle(void)
+{
+    if (_vtime_idle_cb) {
+        _vtime_idle_cb(_vtime_idle_arg,
+                       _vtime_armed ? _vtime_deadline : NATIVE_VTIME_NEVER);
+    }
+    else if (_vtime_armed) {
+        /* nothing else is going to happen before the deadline, jump to it
+         * and let SIGALRM fire the timer in interrupt context */
+        _vtime_now = _vtime_deadline;
+        _set_itimer(NATIVE_TIMER_MIN_RES);
+    }
+}
+#endif
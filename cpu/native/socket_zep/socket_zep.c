@@ -28,6 +28,7 @@
 #include "byteorder.h"
 #include "checksum/ucrc16.h"
 #include "native_internal.h"
+#include "native_vtime.h"
 #include "random.h"
 
 #include "socket_zep.h"
@@ -40,12 +41,25 @@
  * (https://pubs.opengroup.org/onlinepubs/9699919799.2016edition/basedefs/time.h.html) */
 #define TV_USEC_PER_SEC         (1000000L)
 
+#ifdef MODULE_NATIVE_VTIME
+/* virtual time is coordinated with the dispatcher of the first device */
+static socket_zep_t *_vtime_dev;
+static uint32_t _vtime_seq;
+static uint32_t _vtime_rx;
+#endif
+
 static size_t _zep_hdr_fill_v2_data(socket_zep_t *dev, zep_v2_data_hdr_t *hdr,
                                     size_t payload_len)
 {
     struct timeval tv;
 
+#ifdef MODULE_NATIVE_VTIME
+    uint64_t now = native_vtime_now();
+    tv.tv_sec = now / TV_USEC_PER_SEC;
+    tv.tv_usec = now % TV_USEC_PER_SEC;
+#else
     real_gettimeofday(&tv, NULL);
+#endif
     hdr->hdr.version = 2;
     hdr->type = ZEP_V2_TYPE_DATA;
     hdr->chan = dev->netdev.chan;
@@ -197,6 +211,11 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
         size = real_read(dev->sock_fd, dev->rcv_buf, sizeof(dev->rcv_buf));
 
         if (size > 0) {
+#ifdef MODULE_NATIVE_VTIME
+            if (dev == _vtime_dev) {
+                _vtime_rx++;
+            }
+#endif
             zep_hdr_t *tmp = (zep_hdr_t *)&dev->rcv_buf;
 
             if ((tmp->preamble[0] != 'E') || (tmp->preamble[1] != 'X')) {
@@ -268,6 +287,43 @@ static void _isr(netdev_t *netdev)
     return;
 }
 
+#ifdef MODULE_NATIVE_VTIME
+/* handles pending virtual time messages, returns true if a frame follows */
+static bool _vtime_recv(socket_zep_t *dev)
+{
+    socket_zep_vtime_msg_t msg;
+
+    while (real_recv(dev->sock_fd, &msg, sizeof(msg.preamble),
+                     MSG_PEEK) == sizeof(msg.preamble)) {
+        if ((msg.preamble[0] != 'V') || (msg.preamble[1] != 'T')) {
+            return true;
+        }
+        if ((real_read(dev->sock_fd, &msg, sizeof(msg)) == sizeof(msg)) &&
+            (msg.type == SOCKET_ZEP_VTIME_ADVANCE)) {
+            _vtime_seq = byteorder_ntohl(msg.seq);
+            native_vtime_advance(byteorder_ntohll(msg.time));
+        }
+    }
+    return false;
+}
+
+static void _vtime_idle(void *arg, uint64_t deadline)
+{
+    socket_zep_t *dev = arg;
+    socket_zep_vtime_msg_t msg = {
+        .preamble = { 'V', 'T' },
+        .type = SOCKET_ZEP_VTIME_IDLE,
+        .seq = byteorder_htonl(_vtime_seq),
+        .rx = byteorder_htonl(_vtime_rx),
+        .time = byteorder_htonll(deadline),
+    };
+
+    if (real_write(dev->sock_fd, &msg, sizeof(msg)) < 0) {
+        err(EXIT_FAILURE, "ZEP: unable to report idle state");
+    }
+}
+#endif
+
 static void _socket_isr(int fd, void *arg)
 {
     (void)fd;
@@ -279,6 +335,12 @@ static void _socket_isr(int fd, void *arg)
     if (netdev == NULL) {
         return;
     }
+#ifdef MODULE_NATIVE_VTIME
+    if (((socket_zep_t *)netdev == _vtime_dev) && !_vtime_recv(_vtime_dev)) {
+        /* there were only virtual time messages */
+        return;
+    }
+#endif
     if (netdev->event_callback) {
         socket_zep_t *dev = (socket_zep_t *)netdev;
 
@@ -396,6 +458,12 @@ void socket_zep_setup(socket_zep_t *dev, const socket_zep_params_t *params)
     dev->netdev.short_addr[1] = dev->netdev.long_addr[7];
     native_async_read_setup();
     native_async_read_add_handler(dev->sock_fd, dev, _socket_isr);
+#ifdef MODULE_NATIVE_VTIME
+    if (_vtime_dev == NULL) {
+        _vtime_dev = dev;
+        native_vtime_set_idle_cb(_vtime_idle, dev);
+    }
+#endif
 }
 
 void socket_zep_cleanup(socket_zep_t *dev)
@@ -70,6 +70,11 @@ extern "C" {
 #define CONFIG_SPI_MBUF_SIZE    64
 #endif
 
+/**
+ * @brief   SPI transfers are executed asynchronously using EasyDMA
+ */
+#define PERIPH_SPI_HAS_TRANSFER_ASYNC
+
 /**
  * @brief   nRF52 specific naming of ADC lines (for convenience)
  */
@@ -210,6 +215,19 @@ typedef struct {
 } spi_conf_t;
 
 
+#if defined(CPU_MODEL_NRF52840XXAA) || defined(DOXYGEN)
+/**
+ * @brief  QSPI configuration values
+ *
+ * The pins are driven with high drive strength while the bus is acquired.
+ */
+typedef struct {
+    gpio_t sclk;        /**< CLK pin */
+    gpio_t csn;         /**< chip select pin */
+    gpio_t io[4];       /**< IO0 to IO3 pins */
+} qspi_conf_t;
+#endif
+
 /**
  * @brief Common SPI/I2C interrupt callback
  *
@@ -0,0 +1,347 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_nrf52
+ * @ingroup     drivers_periph_qspi
+ * @{
+ *
+ * @file
+ * @brief       Low-level QSPI driver implementation
+ *
+ * The nRF52840 QSPI controller only issues the standard read and page
+ * program opcodes, so the opcode passed to @ref qspi_read and
+ * @ref qspi_write is only used to pick the matching instruction for the
+ * requested data lines. With 4 byte addresses the controller sends those
+ * opcodes followed by a 4 byte address, which the flash only accepts in its
+ * 4 byte address mode. The flash is switched to that mode on every
+ * activation, where the standard opcodes behave like their dedicated 4 byte
+ * address counterparts (e.g. 0x0c, 0x12 or 0xec).
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <string.h>
+
+#include "cpu.h"
+#include "mutex.h"
+#include "assert.h"
+#include "periph/qspi.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#define RAM_MASK            (0x20000000)
+
+/**
+ * @brief   Start of the memory mapped flash
+ */
+#define QSPI_XIP_BASE       (0x12000000)
+
+/**
+ * @brief   Largest transfer of a single EasyDMA job, must be word aligned
+ */
+#define QSPI_MAX_CNT        (0x3fffc)
+
+/**
+ * @brief   Size of the buffer for unaligned transfers
+ */
+#define QSPI_BOUNCE_SIZE    (64U)
+
+/**
+ * @brief   Maximum payload of a custom instruction
+ */
+#define QSPI_CINSTR_MAX     (8U)
+
+/**
+ * @brief   Enter 4 byte address mode command of the flash
+ */
+#define QSPI_CMD_EN4B       (0xb7)
+
+static mutex_t _lock = MUTEX_INIT;
+static mutex_t _busy = MUTEX_INIT_LOCKED;
+
+static uint32_t _ifconfig0;
+static uint32_t _ifconfig1;
+static bool _addr_len_4;
+static bool _xip;
+
+static uint32_t _bounce[QSPI_BOUNCE_SIZE / sizeof(uint32_t)];
+
+static const uint8_t _readoc[] = {
+    [QSPI_LANES_1_1_1] = QSPI_IFCONFIG0_READOC_FASTREAD,
+    [QSPI_LANES_1_1_2] = QSPI_IFCONFIG0_READOC_READ2O,
+    [QSPI_LANES_1_2_2] = QSPI_IFCONFIG0_READOC_READ2IO,
+    [QSPI_LANES_1_1_4] = QSPI_IFCONFIG0_READOC_READ4O,
+    [QSPI_LANES_1_4_4] = QSPI_IFCONFIG0_READOC_READ4IO,
+};
+
+static const uint8_t _writeoc[] = {
+    [QSPI_LANES_1_1_1] = QSPI_IFCONFIG0_WRITEOC_PP,
+    [QSPI_LANES_1_1_2] = QSPI_IFCONFIG0_WRITEOC_PP2O,
+    /* there is no dual I/O page program, fall back to dual output */
+    [QSPI_LANES_1_2_2] = QSPI_IFCONFIG0_WRITEOC_PP2O,
+    [QSPI_LANES_1_1_4] = QSPI_IFCONFIG0_WRITEOC_PP4O,
+    [QSPI_LANES_1_4_4] = QSPI_IFCONFIG0_WRITEOC_PP4IO,
+};
+
+static inline bool _aligned(uintptr_t val)
+{
+    return (val & 0x3) == 0;
+}
+
+static inline bool _in_ram(const void *data)
+{
+    return ((uintptr_t)data & RAM_MASK);
+}
+
+static void _pin_init(gpio_t pin)
+{
+    NRF_GPIO_Type *port = (pin & 0x20) ? NRF_P1 : NRF_P0;
+
+    /* high drive, the peripheral controls the direction */
+    port->PIN_CNF[pin & 0x1f] = GPIO_PIN_CNF_DRIVE_H0H1 << GPIO_PIN_CNF_DRIVE_Pos;
+}
+
+static void _wait_ready(void)
+{
+    mutex_lock(&_busy);
+}
+
+static void _trigger(volatile uint32_t *task)
+{
+    NRF_QSPI->EVENTS_READY = 0;
+    *task = 1;
+    _wait_ready();
+}
+
+static void _cinstr(uint8_t command, size_t len)
+{
+    NRF_QSPI->EVENTS_READY = 0;
+    /* keep IO2 (WP) and IO3 (HOLD) high, the length includes the opcode */
+    NRF_QSPI->CINSTRCONF = (command << QSPI_CINSTRCONF_OPCODE_Pos)
+                         | ((len + 1) << QSPI_CINSTRCONF_LENGTH_Pos)
+                         | QSPI_CINSTRCONF_LIO2_Msk
+                         | QSPI_CINSTRCONF_LIO3_Msk;
+    _wait_ready();
+}
+
+static void _read_dma(uint32_t addr, void *data, size_t len, qspi_lanes_t lanes)
+{
+    NRF_QSPI->IFCONFIG0 = _ifconfig0 | (_readoc[lanes] << QSPI_IFCONFIG0_READOC_Pos);
+    NRF_QSPI->READ.SRC = addr;
+    NRF_QSPI->READ.DST = (uint32_t)data;
+    NRF_QSPI->READ.CNT = len;
+    _trigger(&NRF_QSPI->TASKS_READSTART);
+}
+
+static void _write_dma(uint32_t addr, const void *data, size_t len, qspi_lanes_t lanes)
+{
+    NRF_QSPI->IFCONFIG0 = _ifconfig0 | (_writeoc[lanes] << QSPI_IFCONFIG0_WRITEOC_Pos);
+    NRF_QSPI->WRITE.DST = addr;
+    NRF_QSPI->WRITE.SRC = (uint32_t)data;
+    NRF_QSPI->WRITE.CNT = len;
+    _trigger(&NRF_QSPI->TASKS_WRITESTART);
+}
+
+void qspi_init(qspi_t bus)
+{
+    assert(bus < QSPI_NUMOF);
+    const qspi_conf_t *conf = &qspi_config[bus];
+
+    NRF_QSPI->ENABLE = 0;
+
+    _pin_init(conf->sclk);
+    _pin_init(conf->csn);
+    for (unsigned i = 0; i < ARRAY_SIZE(conf->io); i++) {
+        _pin_init(conf->io[i]);
+    }
+
+    NRF_QSPI->PSEL.SCK = conf->sclk;
+    NRF_QSPI->PSEL.CSN = conf->csn;
+    NRF_QSPI->PSEL.IO0 = conf->io[0];
+    NRF_QSPI->PSEL.IO1 = conf->io[1];
+    NRF_QSPI->PSEL.IO2 = conf->io[2];
+    NRF_QSPI->PSEL.IO3 = conf->io[3];
+    NRF_QSPI->XIPOFFSET = 0;
+
+    NRF_QSPI->INTENSET = QSPI_INTENSET_READY_Msk;
+    NVIC_EnableIRQ(QSPI_IRQn);
+}
+
+void qspi_configure(qspi_t bus, qspi_mode_t mode, uint32_t flags, uint32_t clk_hz)
+{
+    (void)bus;
+
+    /* SCK = 32 MHz / (SCKFREQ + 1) */
+    uint32_t div = (32000000LU + clk_hz - 1) / clk_hz;
+    if (div > 16) {
+        div = 16;
+    }
+    else if (div == 0) {
+        div = 1;
+    }
+
+    _addr_len_4 = flags & QSPI_FMT_ADDR_LEN_4;
+    _ifconfig0 = _addr_len_4
+               ? (QSPI_IFCONFIG0_ADDRMODE_32BIT << QSPI_IFCONFIG0_ADDRMODE_Pos)
+               : 0;
+    _ifconfig1 = (1 << QSPI_IFCONFIG1_SCKDELAY_Pos)
+               | ((mode == QSPI_MODE_3) << QSPI_IFCONFIG1_SPIMODE_Pos)
+               | ((div - 1) << QSPI_IFCONFIG1_SCKFREQ_Pos);
+
+    DEBUG("[qspi] configure: mode %u, SCKFREQ %" PRIu32 "\n", (unsigned)mode, div - 1);
+}
+
+void qspi_acquire(qspi_t bus)
+{
+    (void)bus;
+
+    mutex_lock(&_lock);
+    if (_xip) {
+        /* the controller was kept running for the memory mapped window */
+        return;
+    }
+
+    NRF_QSPI->IFCONFIG0 = _ifconfig0;
+    NRF_QSPI->IFCONFIG1 = _ifconfig1;
+    NRF_QSPI->ENABLE = 1;
+    _trigger(&NRF_QSPI->TASKS_ACTIVATE);
+
+    /* the read and program instructions carry 4 byte addresses now, the
+     * flash may have lost its address mode while powered down */
+    if (_addr_len_4) {
+        _cinstr(QSPI_CMD_EN4B, 0);
+    }
+}
+
+void qspi_release(qspi_t bus)
+{
+    (void)bus;
+
+    if (!_xip) {
+        NRF_QSPI->TASKS_DEACTIVATE = 1;
+        NRF_QSPI->ENABLE = 0;
+    }
+    mutex_unlock(&_lock);
+}
+
+void qspi_cmd_read(qspi_t bus, uint8_t command, void *response, size_t len)
+{
+    (void)bus;
+    assert(len <= QSPI_CINSTR_MAX);
+
+    NRF_QSPI->CINSTRDAT0 = 0;
+    NRF_QSPI->CINSTRDAT1 = 0;
+    _cinstr(command, len);
+
+    uint32_t dat[2] = { NRF_QSPI->CINSTRDAT0, NRF_QSPI->CINSTRDAT1 };
+    memcpy(response, dat, len);
+}
+
+void qspi_cmd_write(qspi_t bus, uint8_t command, const void *data, size_t len)
+{
+    (void)bus;
+    assert(len <= QSPI_CINSTR_MAX);
+
+    uint32_t dat[2] = { 0 };
+    if (len) {
+        memcpy(dat, data, len);
+    }
+    NRF_QSPI->CINSTRDAT0 = dat[0];
+    NRF_QSPI->CINSTRDAT1 = dat[1];
+    _cinstr(command, len);
+}
+
+void qspi_read(qspi_t bus, uint8_t command, qspi_lanes_t lanes,
+               uint32_t addr, void *data, size_t len)
+{
+    (void)bus;
+    (void)command;
+    uint8_t *out = data;
+
+    while (len) {
+        size_t n;
+
+        if (_aligned(addr) && _aligned((uintptr_t)out) && _in_ram(out) && len >= 4) {
+            n = (len > QSPI_MAX_CNT) ? QSPI_MAX_CNT : (len & ~0x3);
+            _read_dma(addr, out, n, lanes);
+        }
+        else {
+            /* EasyDMA needs word aligned addresses and lengths */
+            uint32_t offset = addr & 0x3;
+            n = QSPI_BOUNCE_SIZE - offset;
+            if (n > len) {
+                n = len;
+            }
+            _read_dma(addr - offset, _bounce, (offset + n + 3) & ~0x3, lanes);
+            memcpy(out, (uint8_t *)_bounce + offset, n);
+        }
+
+        addr += n;
+        out += n;
+        len -= n;
+    }
+}
+
+void qspi_write(qspi_t bus, uint8_t command, qspi_lanes_t lanes,
+                uint32_t addr, const void *data, size_t len)
+{
+    (void)bus;
+    (void)command;
+    const uint8_t *in = data;
+
+    while (len) {
+        size_t n;
+
+        if (_aligned(addr) && _aligned((uintptr_t)in) && _in_ram(in) && len >= 4) {
+            n = (len > QSPI_MAX_CNT) ? QSPI_MAX_CNT : (len & ~0x3);
+            _write_dma(addr, in, n, lanes);
+        }
+        else {
+            /* pad with 0xff, programming those bits leaves the flash as is */
+            uint32_t offset = addr & 0x3;
+            n = QSPI_BOUNCE_SIZE - offset;
+            if (n > len) {
+                n = len;
+            }
+            memset(_bounce, 0xff, sizeof(_bounce));
+            memcpy((uint8_t *)_bounce + offset, in, n);
+            _write_dma(addr - offset, _bounce, (offset + n + 3) & ~0x3, lanes);
+        }
+
+        addr += n;
+        in += n;
+        len -= n;
+    }
+}
+
+const void *qspi_mmap(qspi_t bus, uint8_t command, qspi_lanes_t lanes)
+{
+    (void)command;
+
+    /* the window is only served while the controller is active, so keep it
+       running from now on */
+    qspi_acquire(bus);
+    NRF_QSPI->IFCONFIG0 = _ifconfig0 | (_readoc[lanes] << QSPI_IFCONFIG0_READOC_Pos);
+    _xip = true;
+    qspi_release(bus);
+
+    return (const void *)QSPI_XIP_BASE;
+}
+
+void isr_qspi(void)
+{
+    NRF_QSPI->EVENTS_READY = 0;
+    mutex_unlock(&_busy);
+
+    cortexm_isr_end();
+}
@@ -25,6 +25,7 @@
  */
 
 #include "cpu.h"
+#include "irq.h"
 #include "mutex.h"
 #include "assert.h"
 #include "periph/spi.h"
@@ -47,6 +48,17 @@ static mutex_t busy[SPI_NUMOF];
 
 static uint8_t _mbuf[SPI_NUMOF][CONFIG_SPI_MBUF_SIZE];
 
+/**
+ * @brief   State of the asynchronous transfer in progress on each bus
+ */
+static struct {
+    const spi_async_xfer_t *xfer;   /**< transfer, NULL if none in progress */
+    const uint8_t *out;             /**< next data to send */
+    uint8_t *in;                    /**< next data to receive */
+    size_t remaining;               /**< bytes not transferred yet */
+    size_t chunk;                   /**< bytes of the running EasyDMA job */
+} _async[SPI_NUMOF];
+
 static void spi_isr_handler(void *arg);
 
 static inline NRF_SPIM_Type *dev(spi_t bus)
@@ -249,10 +261,72 @@ void spi_transfer_bytes(spi_t bus, spi_cs_t cs, bool cont,
     }
 }
 
+bool spi_async_start(spi_t bus, const spi_async_xfer_t *xfer)
+{
+    assert(xfer->out || xfer->in);
+
+    if (xfer->cs != SPI_CS_UNDEF) {
+        gpio_clear((gpio_t)xfer->cs);
+    }
+    if (xfer->len == 1) {
+        _enable_workaround(bus);
+    }
+
+    _async[bus].xfer = xfer;
+    _async[bus].out = xfer->out;
+    _async[bus].in = xfer->in;
+    _async[bus].remaining = xfer->len;
+
+    dev(bus)->INTENSET = SPIM_INTENSET_END_Msk;
+
+    /* the END interrupt must not see the job before its length is known */
+    unsigned state = irq_disable();
+    _async[bus].chunk = _transfer(bus, _async[bus].out, _async[bus].in,
+                                  _async[bus].remaining);
+    irq_restore(state);
+
+    return true;
+}
+
+static void _async_continue(spi_t bus)
+{
+    size_t chunk = _async[bus].chunk;
+
+    _async[bus].out += _async[bus].out ? chunk : 0;
+    _async[bus].in += _async[bus].in ? chunk : 0;
+    _async[bus].remaining -= chunk;
+
+    if (_async[bus].remaining) {
+        _async[bus].chunk = _transfer(bus, _async[bus].out, _async[bus].in,
+                                      _async[bus].remaining);
+        return;
+    }
+
+    const spi_async_xfer_t *xfer = _async[bus].xfer;
+
+    dev(bus)->INTENCLR = SPIM_INTENCLR_END_Msk;
+    if (xfer->len == 1) {
+        _clear_workaround(bus);
+    }
+    if ((xfer->cs != SPI_CS_UNDEF) && (!xfer->cont)) {
+        gpio_set((gpio_t)xfer->cs);
+    }
+
+    /* the completion may start the next queued transfer right away */
+    _async[bus].xfer = NULL;
+    spi_async_done(bus);
+}
+
 void spi_isr_handler(void *arg)
 {
     spi_t bus = (spi_t)arg;
 
+    if (_async[bus].xfer) {
+        dev(bus)->EVENTS_END = 0;
+        _async_continue(bus);
+        return;
+    }
+
     mutex_unlock(&busy[bus]);
     dev(bus)->EVENTS_END = 0;
 }
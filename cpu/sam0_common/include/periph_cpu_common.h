@@ -42,6 +42,8 @@ extern "C" {
 #ifndef MODULE_PERIPH_DMA
 #define PERIPH_SPI_NEEDS_TRANSFER_REG
 #define PERIPH_SPI_NEEDS_TRANSFER_REGS
+#else
+#define PERIPH_SPI_HAS_TRANSFER_ASYNC
 #endif
 /** @} */
 
@@ -759,6 +761,13 @@ typedef struct {
  */
 typedef unsigned dma_t;
 
+/**
+ * @brief Signature of the DMA transfer complete callback
+ *
+ * @param   arg     argument given to @ref dma_set_callback
+ */
+typedef void (*dma_cb_t)(void *arg);
+
 /**
  * @brief Available DMA address increment modes
  */
@@ -945,6 +954,20 @@ void dma_start(dma_t dma);
  */
 void dma_wait(dma_t dma);
 
+/**
+ * @brief   Set a callback to invoke from interrupt context when a transfer on
+ *          the channel is complete
+ *
+ * While a callback is set, @ref dma_wait must not be used on the channel.
+ *
+ * @note Use only with DMA channels of which the interrupt is enabled
+ *
+ * @param   dma     DMA channel reference
+ * @param   cb      callback to invoke, NULL to return to @ref dma_wait
+ * @param   arg     argument passed to @p cb
+ */
+void dma_set_callback(dma_t dma, dma_cb_t cb, void *arg);
+
 /**
  * @brief   Cancel an active DMA transfer
  *
@@ -41,6 +41,12 @@ extern "C" {
  */
 #define SAM_USB_NUM_EP      USBDEV_NUM_ENDPOINTS
 
+/**
+ * Maximum size of a multi-packet transfer, limited by the 14 bit
+ * BYTE_COUNT and MULTI_PACKET_SIZE fields
+ */
+#define SAM_USB_XFER_MAX    (0x3FFF)
+
 /**
  * @brief sam0 usb peripheral device context
  */
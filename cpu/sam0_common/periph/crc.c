@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_sam0_common
+ * @ingroup     drivers_periph_crc
+ * @{
+ *
+ * @file
+ * @brief       Low-level CRC unit driver implementation
+ *
+ * The Device Service Unit calculates the IEEE 802.3 CRC32 over a memory
+ * range, reading it directly from the bus.
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <errno.h>
+
+#include "cpu.h"
+#include "mutex.h"
+#include "periph/crc.h"
+
+/* the DSU is write protected after reset */
+#define DSU_PAC_BIT     (0x00000002)
+
+static mutex_t _lock = MUTEX_INIT;
+
+static void _unlock(void)
+{
+#ifdef REG_PAC_WRCTRL
+    PAC->WRCTRL.reg = (PAC_WRCTRL_KEY_CLR | ID_DSU);
+#else
+    if (PAC1->WPSET.reg & DSU_PAC_BIT) {
+        PAC1->WPCLR.reg = DSU_PAC_BIT;
+    }
+#endif
+}
+
+int crc_crc32_update(uint32_t *state, const void *buf, size_t len)
+{
+    if (((uintptr_t)buf | len) & (sizeof(uint32_t) - 1)) {
+        return -EINVAL;
+    }
+    if (len == 0) {
+        return 0;
+    }
+
+    mutex_lock(&_lock);
+    _unlock();
+
+    DSU->STATUSA.reg = DSU_STATUSA_DONE | DSU_STATUSA_BERR;
+    DSU->ADDR.reg = (uintptr_t)buf;
+    DSU->LENGTH.reg = len;
+    DSU->DATA.reg = *state;
+    DSU->CTRL.reg = DSU_CTRL_CRC;
+
+    while (!(DSU->STATUSA.reg & DSU_STATUSA_DONE)) {}
+
+    int res = 0;
+    if (DSU->STATUSA.reg & DSU_STATUSA_BERR) {
+        res = -EIO;
+    }
+    else {
+        *state = DSU->DATA.reg;
+    }
+
+    mutex_unlock(&_lock);
+    return res;
+}
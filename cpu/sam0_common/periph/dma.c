@@ -23,6 +23,7 @@
 #include "mutex.h"
 #include "assert.h"
 #include "bitarithm.h"
+#include "irq.h"
 #include "pm_layered.h"
 #include "thread_flags.h"
 #include "periph/gpio.h"
@@ -43,6 +44,8 @@ static uint32_t channels_free = (1LLU << CONFIG_DMA_NUMOF) - 1;
 
 struct dma_ctx {
     mutex_t sync_lock;
+    dma_cb_t cb;
+    void *arg;
 };
 
 struct dma_ctx dma_ctx[CONFIG_DMA_NUMOF];
@@ -287,6 +290,14 @@ void dma_cancel(dma_t dma)
 #endif
 }
 
+void dma_set_callback(dma_t dma, dma_cb_t cb, void *arg)
+{
+    unsigned state = irq_disable();
+    dma_ctx[dma].cb = cb;
+    dma_ctx[dma].arg = arg;
+    irq_restore(state);
+}
+
 void isr_dmac(void)
 {
     /* Always holds the interrupt status for the highest priority channel with
@@ -298,7 +309,12 @@ void isr_dmac(void)
      * channel ID together with the flags to clear */
     DMAC->INTPEND.reg = status;
     if (status & DMAC_INTPEND_TCMPL) {
-        mutex_unlock(&dma_ctx[dma].sync_lock);
+        if (dma_ctx[dma].cb) {
+            dma_ctx[dma].cb(dma_ctx[dma].arg);
+        }
+        else {
+            mutex_unlock(&dma_ctx[dma].sync_lock);
+        }
     }
     DEBUG("[DMA] IRQ: %u: %x\n", dma, status);
     cortexm_isr_end();
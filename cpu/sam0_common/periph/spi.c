@@ -49,6 +49,16 @@ static struct dma_state _dma_state[SPI_NUMOF];
 
 static DmacDescriptor DMA_DESCRIPTOR_ATTRS tx_desc[SPI_NUMOF];
 static DmacDescriptor DMA_DESCRIPTOR_ATTRS rx_desc[SPI_NUMOF];
+
+/**
+ * @brief   Asynchronous transfer in progress on each bus
+ */
+static const spi_async_xfer_t *_async_xfer[SPI_NUMOF];
+
+/**
+ * @brief   Source and sink of DMA transfers with only one buffer given
+ */
+static uint8_t _dma_dummy[SPI_NUMOF];
 #endif
 
 /**
@@ -233,6 +243,7 @@ static void _blocking_transfer(spi_t bus, const void *out, void *in, size_t len)
 
 static void _dma_execute(spi_t bus)
 {
+    dma_set_callback(_dma_state[bus].rx_dma, NULL, NULL);
 #if defined(CPU_FAM_SAMD21)
     pm_block(SAMD21_PM_IDLE_1);
 #endif
@@ -245,14 +256,22 @@ static void _dma_execute(spi_t bus)
 #endif
 }
 
-static void _dma_transfer(spi_t bus, const uint8_t *out, uint8_t *in,
-                          size_t len)
+static void _dma_prepare(spi_t bus, const uint8_t *out, uint8_t *in,
+                         size_t len)
 {
-    uint8_t tmp = 0;
-    const uint8_t *out_addr = out ? out + len : &tmp;
-    uint8_t *in_addr = in ? in + len : &tmp;
+    uint8_t *dummy = &_dma_dummy[bus];
+    const uint8_t *out_addr = out ? out + len : dummy;
+    uint8_t *in_addr = in ? in + len : dummy;
+
+    *dummy = 0;
     dma_prepare_dst(_dma_state[bus].rx_dma, in_addr, len, in ? true : false);
     dma_prepare_src(_dma_state[bus].tx_dma, out_addr, len, out ? true : false);
+}
+
+static void _dma_transfer(spi_t bus, const uint8_t *out, uint8_t *in,
+                          size_t len)
+{
+    _dma_prepare(bus, out, in, len);
     _dma_execute(bus);
 }
 
@@ -326,3 +345,45 @@ void spi_transfer_bytes(spi_t bus, spi_cs_t cs, bool cont,
         gpio_set((gpio_t)cs);
     }
 }
+
+#ifdef MODULE_PERIPH_DMA
+static void _async_done(void *arg)
+{
+    spi_t bus = (spi_t)(uintptr_t)arg;
+    const spi_async_xfer_t *xfer = _async_xfer[bus];
+
+#if defined(CPU_FAM_SAMD21)
+    pm_unblock(SAMD21_PM_IDLE_1);
+#endif
+    if ((!xfer->cont) && (xfer->cs != SPI_CS_UNDEF)) {
+        gpio_set((gpio_t)xfer->cs);
+    }
+    spi_async_done(bus);
+}
+
+bool spi_async_start(spi_t bus, const spi_async_xfer_t *xfer)
+{
+    if (!_use_dma(bus)) {
+        spi_transfer_bytes(bus, xfer->cs, xfer->cont,
+                           xfer->out, xfer->in, xfer->len);
+        return false;
+    }
+
+    _async_xfer[bus] = xfer;
+    dma_set_callback(_dma_state[bus].rx_dma, _async_done,
+                     (void *)(uintptr_t)bus);
+
+    if (xfer->cs != SPI_CS_UNDEF) {
+        gpio_clear((gpio_t)xfer->cs);
+    }
+    /* The DMA promises not to modify the const out data */
+    _dma_prepare(bus, xfer->out, xfer->in, xfer->len);
+#if defined(CPU_FAM_SAMD21)
+    pm_block(SAMD21_PM_IDLE_1);
+#endif
+    dma_start(_dma_state[bus].rx_dma);
+    dma_start(_dma_state[bus].tx_dma);
+
+    return true;
+}
+#endif
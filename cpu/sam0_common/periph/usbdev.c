@@ -46,6 +46,7 @@ const usbdev_driver_t driver;
 
 static void _usbdev_ep_init(usbdev_ep_t *ep);
 static int _usbdev_ep_ready(usbdev_ep_t *ep, size_t len);
+static int _usbdev_ep_xfer(usbdev_ep_t *ep, void *buf, size_t len);
 static usbdev_ep_t *_usbdev_new_ep(usbdev_t *dev, usb_ep_type_t type,
                                    usb_ep_dir_t dir, size_t buf_len);
 
@@ -714,14 +715,50 @@ static int _ep_unready(usbdev_ep_t *ep)
 static int _usbdev_ep_ready(usbdev_ep_t *ep, size_t len)
 {
     UsbDeviceEndpoint *ep_reg = _ep_reg_from_ep(ep);
+    UsbDeviceDescBank *bank = _bank_from_ep(ep);
+
+    /* revert a preceding multi-packet transfer */
+    _bank_set_address(ep);
+    bank->PCKSIZE.bit.MULTI_PACKET_SIZE = 0;
+    bank->PCKSIZE.bit.AUTO_ZLP = 0;
+
+    if (ep->dir == USB_EP_DIR_IN) {
+        _disable_ep_stall_in(ep_reg);
+        bank->PCKSIZE.bit.BYTE_COUNT = len;
+        ep_reg->EPSTATUSSET.reg = USB_DEVICE_EPSTATUSSET_BK1RDY;
+    }
+    else {
+        _disable_ep_stall_out(ep_reg);
+        ep_reg->EPSTATUSCLR.reg = USB_DEVICE_EPSTATUSCLR_BK0RDY;
+    }
+    return 0;
+}
+
+static int _usbdev_ep_xfer(usbdev_ep_t *ep, void *buf, size_t len)
+{
+    UsbDeviceEndpoint *ep_reg = _ep_reg_from_ep(ep);
+    UsbDeviceDescBank *bank = _bank_from_ep(ep);
+
+    assert(((uintptr_t)buf & 0x3) == 0);
+    if (len > SAM_USB_XFER_MAX) {
+        return -EINVAL;
+    }
 
+    bank->ADDR.reg = (uint32_t)buf;
     if (ep->dir == USB_EP_DIR_IN) {
         _disable_ep_stall_in(ep_reg);
-        _bank_from_ep(ep)->PCKSIZE.bit.BYTE_COUNT = len;
+        /* the peripheral splits the data into packets and appends a zero
+         * length packet if needed */
+        bank->PCKSIZE.bit.MULTI_PACKET_SIZE = 0;
+        bank->PCKSIZE.bit.AUTO_ZLP = 1;
+        bank->PCKSIZE.bit.BYTE_COUNT = len;
         ep_reg->EPSTATUSSET.reg = USB_DEVICE_EPSTATUSSET_BK1RDY;
     }
     else {
         _disable_ep_stall_out(ep_reg);
+        /* the transfer completes on a short packet or a full buffer */
+        bank->PCKSIZE.bit.MULTI_PACKET_SIZE = len;
+        bank->PCKSIZE.bit.BYTE_COUNT = 0;
         ep_reg->EPSTATUSCLR.reg = USB_DEVICE_EPSTATUSCLR_BK0RDY;
     }
     return 0;
@@ -797,4 +834,5 @@ const usbdev_driver_t driver = {
     .ep_set = _usbdev_ep_set,
     .ep_esr = _usbdev_ep_esr,
     .ready = _usbdev_ep_ready,
+    .xfer = _usbdev_ep_xfer,
 };
@@ -116,6 +116,9 @@ extern "C" {
 #define PERIPH_SPI_NEEDS_TRANSFER_BYTE
 #define PERIPH_SPI_NEEDS_TRANSFER_REG
 #define PERIPH_SPI_NEEDS_TRANSFER_REGS
+#ifdef MODULE_PERIPH_DMA
+#define PERIPH_SPI_HAS_TRANSFER_ASYNC
+#endif
 /** @} */
 
 /**
@@ -432,6 +435,13 @@ typedef enum {
     DMA_MEM_TO_MEM = 2,        /**< Memory to memory */
 } dma_mode_t;
 
+/**
+ * @brief   Signature of the DMA transfer complete callback
+ *
+ * @param[in] arg       argument given to @ref dma_set_callback
+ */
+typedef void (*dma_cb_t)(void *arg);
+
 /**
  * @name    DMA Increment modes
  * @{
@@ -481,6 +491,23 @@ typedef struct {
     uint8_t chan;           /**< CPU ADC channel connected to the pin */
 } adc_conf_t;
 
+/**
+ * @brief   Timer triggered continuous ADC sampling configuration data
+ *
+ * The timer triggers the conversions of the ADC device of the sampled lines
+ * either through its TRGO output (update event) or through its first capture
+ * compare channel, as selected by @p extsel. The DMA stream must be the one
+ * serving that ADC device.
+ */
+typedef struct {
+    TIM_TypeDef *tim;       /**< timer triggering the conversions */
+    uint32_t rcc_mask;      /**< bit in clock enable register of the timer */
+    uint8_t bus;            /**< APB bus of the timer */
+    uint8_t extsel;         /**< external trigger selection of the ADC */
+    dma_t dma;              /**< logical DMA stream used for the ADC */
+    uint8_t dma_chan;       /**< DMA channel used for the ADC */
+} adc_continuous_conf_t;
+
 /**
  * @brief   DAC line configuration data
  */
@@ -643,6 +670,10 @@ typedef struct {
     dma_t dma;              /**< Logical DMA stream used for TX */
     uint8_t dma_chan;       /**< DMA channel used for TX */
 #endif
+#ifdef MODULE_PERIPH_UART_DMA
+    dma_t rx_dma;           /**< Logical DMA stream used for RX */
+    uint8_t rx_dma_chan;    /**< DMA channel used for RX */
+#endif
 } uart_conf_t;
 
 /**
@@ -931,6 +962,40 @@ void dma_stop(dma_t dma);
  */
 void dma_wait(dma_t dma);
 
+/**
+ * @brief   Set a callback to invoke from interrupt context when a transfer on
+ *          the stream is complete
+ *
+ * While a callback is set, @ref dma_wait must not be used on the stream.
+ *
+ * @param[in] dma       logical DMA stream
+ * @param[in] cb        callback to invoke, NULL to return to @ref dma_wait
+ * @param[in] arg       argument passed to @p cb
+ */
+void dma_set_callback(dma_t dma, dma_cb_t cb, void *arg);
+
+/**
+ * @brief   Enable or disable the circular mode of a stream
+ *
+ * In circular mode, the stream restarts at the beginning of the memory buffer
+ * once it reached its end and the callback set with @ref dma_set_callback is
+ * additionally invoked when the first half of the buffer is done. Call after
+ * @ref dma_setup.
+ *
+ * @param[in] dma       logical DMA stream
+ * @param[in] circular  true to enable, false to disable circular mode
+ */
+void dma_set_circular(dma_t dma, bool circular);
+
+/**
+ * @brief   Get the number of transfers remaining on a stream
+ *
+ * @param[in] dma       logical DMA stream
+ *
+ * @return  number of remaining transfers
+ */
+uint16_t dma_remaining(dma_t dma);
+
 /**
  * @brief   Configure a DMA stream for a new transfer
  *
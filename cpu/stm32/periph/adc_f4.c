@@ -120,3 +120,149 @@ int32_t adc_sample(adc_t line, adc_res_t res)
 
     return sample;
 }
+
+#ifdef MODULE_PERIPH_ADC_CONTINUOUS
+/**
+ * @brief   Load the continuous sampling configuration
+ */
+static const adc_continuous_conf_t adc_continuous_config = ADC_CONTINUOUS_CONFIG;
+
+/**
+ * @brief   State of the continuous sampling
+ */
+static struct {
+    adc_continuous_cb_t cb;     /**< callback receiving the samples, NULL
+                                     while stopped */
+    void *arg;                  /**< argument to the callback */
+    uint16_t *buf;              /**< sample buffer */
+    uint16_t len;               /**< number of samples in the buffer */
+    adc_t line;                 /**< first line, selects the ADC device */
+} continuous;
+
+static void _continuous_dma_cb(void *arg)
+{
+    (void)arg;
+    uint16_t half = continuous.len / 2;
+
+    /* the first half is done when the half transfer interrupt fires, the
+     * second one when the stream wrapped around and is reloaded */
+    if (dma_remaining(adc_continuous_config.dma) > half) {
+        continuous.cb(continuous.arg, &continuous.buf[half], half);
+    }
+    else {
+        continuous.cb(continuous.arg, continuous.buf, half);
+    }
+}
+
+static int _trigger_init(uint32_t freq)
+{
+    const adc_continuous_conf_t *conf = &adc_continuous_config;
+    uint32_t ticks = periph_timer_clk(conf->bus) / freq;
+
+    if (ticks < 2) {
+        return -1;
+    }
+
+    uint32_t psc = (ticks - 1) / 0x10000;
+    uint32_t arr = (ticks / (psc + 1)) - 1;
+
+    periph_clk_en(conf->bus, conf->rcc_mask);
+    conf->tim->CR1 = 0;
+    conf->tim->PSC = psc;
+    conf->tim->ARR = arr;
+    /* provide the update event on TRGO and a PWM edge on CC1, so both kinds
+     * of trigger selection work */
+    conf->tim->CR2 = TIM_CR2_MMS_1;
+    conf->tim->CCMR1 = TIM_CCMR1_OC1M_2 | TIM_CCMR1_OC1M_1;
+    conf->tim->CCR1 = arr / 2;
+    conf->tim->CCER = TIM_CCER_CC1E;
+    conf->tim->EGR = TIM_EGR_UG;
+
+    return 0;
+}
+
+int adc_continuous_start(const adc_t *lines, unsigned numof, adc_res_t res,
+                         uint32_t freq, uint16_t *buf, size_t len,
+                         adc_continuous_cb_t cb, void *arg)
+{
+    const adc_continuous_conf_t *conf = &adc_continuous_config;
+
+    if ((numof == 0) || (numof > 16) || (res & 0xff) || (freq == 0) ||
+        (len > UINT16_MAX) || (len == 0) || (len % (2 * numof)) || !cb ||
+        continuous.cb) {
+        return -1;
+    }
+    for (unsigned i = 0; i < numof; i++) {
+        if ((lines[i] >= ADC_NUMOF) ||
+            (adc_config[lines[i]].dev != adc_config[lines[0]].dev)) {
+            return -1;
+        }
+    }
+
+    continuous.cb = cb;
+    continuous.arg = arg;
+    continuous.buf = buf;
+    continuous.len = len;
+    continuous.line = lines[0];
+
+    /* the ADC device stays locked and powered until stopped */
+    prep(lines[0]);
+    ADC_TypeDef *adc = dev(lines[0]);
+
+    /* program the scan sequence, 6 entries per SQR3 and SQR2 register */
+    uint32_t sqr[3] = { (numof - 1) << ADC_SQR1_L_Pos, 0, 0 };
+    for (unsigned i = 0; i < numof; i++) {
+        sqr[2 - (i / 6)] |= (uint32_t)adc_config[lines[i]].chan << ((i % 6) * 5);
+    }
+    adc->SQR1 = sqr[0];
+    adc->SQR2 = sqr[1];
+    adc->SQR3 = sqr[2];
+    adc->CR1 = res | ((numof > 1) ? ADC_CR1_SCAN : 0);
+
+    dma_acquire(conf->dma);
+    dma_setup(conf->dma, conf->dma_chan, (void *)&adc->DR, DMA_PERIPH_TO_MEM,
+              DMA_DATA_WIDTH_HALF_WORD, false);
+    dma_set_circular(conf->dma, true);
+    dma_set_callback(conf->dma, _continuous_dma_cb, NULL);
+    dma_prepare(conf->dma, buf, len, true);
+    dma_start(conf->dma);
+
+    /* convert on rising edges of the selected trigger, keep issuing DMA
+     * requests after each wrap around of the buffer */
+    adc->CR2 = ADC_CR2_ADON | ADC_CR2_DMA | ADC_CR2_DDS | ADC_CR2_EXTEN_0 |
+               ((uint32_t)conf->extsel << ADC_CR2_EXTSEL_Pos);
+
+    if (_trigger_init(freq) != 0) {
+        adc_continuous_stop();
+        return -1;
+    }
+    conf->tim->CR1 = TIM_CR1_CEN;
+
+    return 0;
+}
+
+void adc_continuous_stop(void)
+{
+    const adc_continuous_conf_t *conf = &adc_continuous_config;
+
+    /* the ADC device is only locked while sampling */
+    if (!continuous.cb) {
+        return;
+    }
+
+    conf->tim->CR1 = 0;
+    periph_clk_dis(conf->bus, conf->rcc_mask);
+
+    dev(continuous.line)->CR2 = ADC_CR2_ADON;
+    dev(continuous.line)->CR1 = 0;
+    dev(continuous.line)->SQR1 = 0;
+
+    dma_stop(conf->dma);
+    dma_set_circular(conf->dma, false);
+    dma_set_callback(conf->dma, NULL, NULL);
+    dma_release(conf->dma);
+
+    done(continuous.line);
+    continuous.cb = NULL;
+}
+#endif /* MODULE_PERIPH_ADC_CONTINUOUS */
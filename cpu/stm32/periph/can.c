@@ -394,6 +394,11 @@ static int _send(candev_t *candev, const struct can_frame *frame)
 
     DEBUG("_send: candev=%p, frame=%p\n", (void *) candev, (void *) frame);
 
+    if (can_frame_is_fd(frame)) {
+        /* bxCAN only supports classic CAN */
+        return -ENOTSUP;
+    }
+
     for (mailbox = 0; mailbox < CAN_STM32_TX_MAILBOXES; mailbox++) {
         if (dev->tx_mailbox[mailbox] == NULL) {
             break;
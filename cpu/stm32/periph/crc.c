@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_stm32
+ * @ingroup     drivers_periph_crc
+ * @{
+ *
+ * @file
+ * @brief       Low-level CRC unit driver implementation
+ *
+ * The unit is reset to the IEEE 802.3 polynomial. Input and output are bit
+ * reversed by the hardware to obtain the reflected algorithm, the initial
+ * value is not, so it is reversed in software.
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <errno.h>
+
+#include "cpu.h"
+#include "mutex.h"
+#include "periph_conf.h"
+#include "periph/crc.h"
+
+#if defined(CPU_FAM_STM32F0) || defined(CPU_FAM_STM32F3) || \
+    defined(CPU_FAM_STM32L0)
+#define CRC_BUS     AHB
+#define CRC_EN      RCC_AHBENR_CRCEN
+#else
+#define CRC_BUS     AHB1
+#define CRC_EN      RCC_AHB1ENR_CRCEN
+#endif
+
+static mutex_t _lock = MUTEX_INIT;
+
+int crc_crc32_update(uint32_t *state, const void *buf, size_t len)
+{
+    const uint32_t *pos = buf;
+
+    if (((uintptr_t)buf | len) & (sizeof(uint32_t) - 1)) {
+        return -EINVAL;
+    }
+    if (len == 0) {
+        return 0;
+    }
+
+    mutex_lock(&_lock);
+    periph_clk_en(CRC_BUS, CRC_EN);
+
+    /* bit reversal of input words and output */
+    CRC->CR = CRC_CR_REV_IN | CRC_CR_REV_OUT;
+#ifdef CRC_POL_POL
+    CRC->POL = 0x04C11DB7;
+#endif
+    CRC->INIT = __RBIT(*state);
+    CRC->CR |= CRC_CR_RESET;
+
+    for (len /= sizeof(uint32_t); len; len--) {
+        CRC->DR = *pos++;
+    }
+    *state = CRC->DR;
+
+    periph_clk_dis(CRC_BUS, CRC_EN);
+    mutex_unlock(&_lock);
+    return 0;
+}
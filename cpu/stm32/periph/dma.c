@@ -22,6 +22,7 @@
 
 #include "periph_cpu.h"
 #include "periph_conf.h"
+#include "irq.h"
 #include "mutex.h"
 #include "assert.h"
 #include "pm_layered.h"
@@ -93,6 +94,8 @@ struct dma_ctx {
     mutex_t conf_lock;
     mutex_t sync_lock;
     uint16_t len;
+    dma_cb_t cb;
+    void *arg;
 };
 
 static struct dma_ctx dma_ctx[DMA_NUMOF];
@@ -502,11 +505,46 @@ void dma_wait(dma_t dma)
     mutex_lock(&dma_ctx[dma].sync_lock);
 }
 
+void dma_set_callback(dma_t dma, dma_cb_t cb, void *arg)
+{
+    unsigned state = irq_disable();
+    dma_ctx[dma].cb = cb;
+    dma_ctx[dma].arg = arg;
+    irq_restore(state);
+}
+
+void dma_set_circular(dma_t dma, bool circular)
+{
+    STM32_DMA_Stream_Type *stream = dma_ctx[dma].stream;
+
+#if CPU_FAM_STM32F2 || CPU_FAM_STM32F4 || CPU_FAM_STM32F7
+    const uint32_t bits = DMA_SxCR_CIRC | DMA_SxCR_HTIE;
+#else
+    const uint32_t bits = DMA_CCR_CIRC | DMA_CCR_HTIE;
+#endif
+    if (circular) {
+        stream->CONTROL_REG |= bits;
+    }
+    else {
+        stream->CONTROL_REG &= ~bits;
+    }
+}
+
+uint16_t dma_remaining(dma_t dma)
+{
+    return dma_ctx[dma].stream->NDTR_REG;
+}
+
 void dma_isr_handler(dma_t dma)
 {
     dma_clear_all_flags(dma);
 
-    mutex_unlock(&dma_ctx[dma].sync_lock);
+    if (dma_ctx[dma].cb) {
+        dma_ctx[dma].cb(dma_ctx[dma].arg);
+    }
+    else {
+        mutex_unlock(&dma_ctx[dma].sync_lock);
+    }
 
     cortexm_isr_end();
 }
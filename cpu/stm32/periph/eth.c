@@ -17,6 +17,7 @@
  *
  * @}
  */
+#include <errno.h>
 #include <string.h>
 
 #include "mutex.h"
@@ -49,6 +50,7 @@
 /* Internal flags for the DMA descriptors */
 #define DESC_OWN           (0x80000000)
 #define RX_DESC_FL         (0x3FFF0000)
+#define RX_DESC_ES         (0x00008000)
 #define RX_DESC_FS         (0x00000200)
 #define RX_DESC_LS         (0x00000100)
 #define RX_DESC_RCH        (0x00004000)
@@ -76,9 +78,16 @@ static edma_desc_t rx_desc[ETH_RX_BUFFER_COUNT];
 static edma_desc_t tx_desc[ETH_TX_BUFFER_COUNT];
 static edma_desc_t *rx_curr;
 static edma_desc_t *tx_curr;
+#ifdef MODULE_NETDEV_RX_ZEROCOPY
+/* next descriptor to attach a lent buffer to */
+static edma_desc_t *rx_fill;
+#endif
 
 /* Buffers */
+#ifndef MODULE_NETDEV_RX_ZEROCOPY
+/* with zero-copy reception the receive buffers are lent by the stack */
 static char rx_buffer[ETH_RX_BUFFER_COUNT][ETH_RX_BUFFER_SIZE];
+#endif
 static char tx_buffer[ETH_TX_BUFFER_COUNT][ETH_TX_BUFFER_SIZE];
 
 /** Read or write a phy register, to write the register ETH_MACMIIAR_MW is to
@@ -142,9 +151,16 @@ static void _init_buffer(void)
 {
     int i;
     for (i = 0; i < ETH_RX_BUFFER_COUNT; i++) {
+#ifdef MODULE_NETDEV_RX_ZEROCOPY
+        /* descriptors are handed to the DMA once a buffer is attached */
+        rx_desc[i].status = 0;
+        rx_desc[i].control = RX_DESC_RCH;
+        rx_desc[i].buffer_addr = NULL;
+#else
         rx_desc[i].status = DESC_OWN;
         rx_desc[i].control = RX_DESC_RCH | (ETH_RX_BUFFER_SIZE & 0x0fff);
         rx_desc[i].buffer_addr = &rx_buffer[i][0];
+#endif
         if((i+1) < ETH_RX_BUFFER_COUNT) {
             rx_desc[i].desc_next = &rx_desc[i + 1];
         }
@@ -163,6 +179,9 @@ static void _init_buffer(void)
 
     rx_curr = &rx_desc[0];
     tx_curr = &tx_desc[0];
+#ifdef MODULE_NETDEV_RX_ZEROCOPY
+    rx_fill = &rx_desc[0];
+#endif
 
     ETH->DMARDLAR = (uint32_t)rx_curr;
     ETH->DMATDLAR = (uint32_t)tx_curr;
@@ -351,9 +370,58 @@ int stm32_eth_receive_blocking(char *data, unsigned max_len)
 
 int stm32_eth_get_rx_status_owned(void)
 {
+#ifdef MODULE_NETDEV_RX_ZEROCOPY
+    if (rx_curr->buffer_addr == NULL) {
+        return 0;
+    }
+#endif
     return (!(rx_curr->status & DESC_OWN));
 }
 
+#ifdef MODULE_NETDEV_RX_ZEROCOPY
+int stm32_eth_rx_buf_give(char *buf, unsigned size)
+{
+    edma_desc_t *p = rx_fill;
+
+    if (size < ETH_RX_BUFFER_SIZE) {
+        return -EINVAL;
+    }
+    if (p->buffer_addr != NULL) {
+        /* all descriptors hold a buffer */
+        return -ENOBUFS;
+    }
+    p->buffer_addr = buf;
+    p->control = RX_DESC_RCH | (ETH_RX_BUFFER_SIZE & 0x0fff);
+    p->status = DESC_OWN;
+    rx_fill = p->desc_next;
+    /* resume reception in case the DMA ran out of descriptors */
+    ETH->DMARPDR = 0;
+    return p - rx_desc;
+}
+
+int stm32_eth_recv_zc(unsigned *idx)
+{
+    edma_desc_t *p = rx_curr;
+    int len;
+
+    if ((p->buffer_addr == NULL) || (p->status & DESC_OWN)) {
+        return 0;
+    }
+    if ((p->status & RX_DESC_ES) ||
+        ((p->status & (RX_DESC_FS | RX_DESC_LS)) != (RX_DESC_FS | RX_DESC_LS))) {
+        /* erroneous frame or frame did not fit into a single buffer */
+        len = -EIO;
+    }
+    else {
+        len = ((p->status & RX_DESC_FL) >> 16) - ETHERNET_FCS_LEN;
+    }
+    *idx = p - rx_desc;
+    p->buffer_addr = NULL;
+    rx_curr = p->desc_next;
+    return len;
+}
+#endif
+
 void stm32_eth_isr_eth_wkup(void)
 {
     cortexm_isr_end();
@@ -58,6 +58,16 @@ static inline SPI_TypeDef *dev(spi_t bus)
 }
 
 #ifdef MODULE_PERIPH_DMA
+/**
+ * @brief   Asynchronous transfer in progress on each bus
+ */
+static const spi_async_xfer_t *_async_xfer[SPI_NUMOF];
+
+/**
+ * @brief   Source and sink of DMA transfers with only one buffer given
+ */
+static uint8_t _dma_dummy[SPI_NUMOF];
+
 static inline bool _use_dma(const spi_conf_t *conf)
 {
     return conf->tx_dma != DMA_STREAM_UNDEF && conf->rx_dma != DMA_STREAM_UNDEF;
@@ -231,27 +241,36 @@ static inline void _wait_for_end(spi_t bus)
 }
 
 #ifdef MODULE_PERIPH_DMA
-static void _transfer_dma(spi_t bus, const void *out, void *in, size_t len)
+static void _start_dma(spi_t bus, const void *out, void *in, size_t len)
 {
-    uint8_t tmp = 0;
+    uint8_t *dummy = &_dma_dummy[bus];
 
     if (out) {
         dma_prepare(spi_config[bus].tx_dma, (void*)out, len, 1);
     }
     else {
-        dma_prepare(spi_config[bus].tx_dma, &tmp, len, 0);
+        *dummy = 0;
+        dma_prepare(spi_config[bus].tx_dma, dummy, len, 0);
     }
     if (in) {
         dma_prepare(spi_config[bus].rx_dma, in, len, 1);
     }
     else {
-        dma_prepare(spi_config[bus].rx_dma, &tmp, len, 0);
+        dma_prepare(spi_config[bus].rx_dma, dummy, len, 0);
     }
 
     /* Start RX first to ensure it is active before the SPI transfers are
      * triggered by the TX dma activity */
     dma_start(spi_config[bus].rx_dma);
     dma_start(spi_config[bus].tx_dma);
+}
+
+static void _transfer_dma(spi_t bus, const void *out, void *in, size_t len)
+{
+    dma_set_callback(spi_config[bus].rx_dma, NULL, NULL);
+    dma_set_callback(spi_config[bus].tx_dma, NULL, NULL);
+
+    _start_dma(bus, out, in, len);
 
     dma_wait(spi_config[bus].rx_dma);
     dma_wait(spi_config[bus].tx_dma);
@@ -303,6 +322,24 @@ static void _transfer_no_dma(spi_t bus, const void *out, void *in, size_t len)
     _wait_for_end(bus);
 }
 
+static void _cs_select(spi_t bus, spi_cs_t cs)
+{
+    dev(bus)->CR1 |= (SPI_CR1_SPE);     /* this pulls the HW CS line low */
+    if ((cs != SPI_HWCS_MASK) && (cs != SPI_CS_UNDEF)) {
+        gpio_clear((gpio_t)cs);
+    }
+}
+
+static void _cs_release(spi_t bus, spi_cs_t cs, bool cont)
+{
+    if ((!cont) && (cs != SPI_CS_UNDEF)) {
+        dev(bus)->CR1 &= ~(SPI_CR1_SPE);    /* pull HW CS line high */
+        if (cs != SPI_HWCS_MASK) {
+            gpio_set((gpio_t)cs);
+        }
+    }
+}
+
 void spi_transfer_bytes(spi_t bus, spi_cs_t cs, bool cont,
                         const void *out, void *in, size_t len)
 {
@@ -310,10 +347,7 @@ void spi_transfer_bytes(spi_t bus, spi_cs_t cs, bool cont,
     assert(out || in);
 
     /* active the given chip select line */
-    dev(bus)->CR1 |= (SPI_CR1_SPE);     /* this pulls the HW CS line low */
-    if ((cs != SPI_HWCS_MASK) && (cs != SPI_CS_UNDEF)) {
-        gpio_clear((gpio_t)cs);
-    }
+    _cs_select(bus, cs);
 
 #ifdef MODULE_PERIPH_DMA
     if (_use_dma(&spi_config[bus])) {
@@ -327,10 +361,43 @@ void spi_transfer_bytes(spi_t bus, spi_cs_t cs, bool cont,
 #endif
 
     /* release the chip select if not specified differently */
-    if ((!cont) && (cs != SPI_CS_UNDEF)) {
-        dev(bus)->CR1 &= ~(SPI_CR1_SPE);    /* pull HW CS line high */
-        if (cs != SPI_HWCS_MASK) {
-            gpio_set((gpio_t)cs);
-        }
+    _cs_release(bus, cs, cont);
+}
+
+#ifdef MODULE_PERIPH_DMA
+static void _async_tx_done(void *arg)
+{
+    /* completion is signaled by the RX stream, which finishes last */
+    (void)arg;
+}
+
+static void _async_rx_done(void *arg)
+{
+    spi_t bus = (spi_t)(uintptr_t)arg;
+    const spi_async_xfer_t *xfer = _async_xfer[bus];
+
+    _wait_for_end(bus);
+    _cs_release(bus, xfer->cs, xfer->cont);
+    spi_async_done(bus);
+}
+
+bool spi_async_start(spi_t bus, const spi_async_xfer_t *xfer)
+{
+    if (!_use_dma(&spi_config[bus])) {
+        spi_transfer_bytes(bus, xfer->cs, xfer->cont,
+                           xfer->out, xfer->in, xfer->len);
+        return false;
     }
+
+    _async_xfer[bus] = xfer;
+    dma_set_callback(spi_config[bus].tx_dma, _async_tx_done, NULL);
+    dma_set_callback(spi_config[bus].rx_dma, _async_rx_done,
+                     (void *)(uintptr_t)bus);
+
+    _cs_select(bus, xfer->cs);
+    /* The DMA promises not to modify the const out data */
+    _start_dma(bus, xfer->out, xfer->in, xfer->len);
+
+    return true;
 }
+#endif
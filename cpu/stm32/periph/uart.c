@@ -42,6 +42,7 @@
 #define ISR_TXE     USART_ISR_TXE
 #define ISR_RXNE    USART_ISR_RXNE
 #define ISR_TC      USART_ISR_TC
+#define ISR_IDLE    USART_ISR_IDLE
 #define TDR_REG     TDR
 #define RDR_REG     RDR
 #else
@@ -49,6 +50,7 @@
 #define ISR_TXE     USART_SR_TXE
 #define ISR_RXNE    USART_SR_RXNE
 #define ISR_TC      USART_SR_TC
+#define ISR_IDLE    USART_SR_IDLE
 #define TDR_REG     DR
 #define RDR_REG     DR
 #endif
@@ -77,6 +79,29 @@ static struct {
     uint8_t data_mask;    /**< mask applied to the data register */
 } isr_ctx[UART_NUMOF];
 
+#ifdef MODULE_PERIPH_UART_DMA
+/**
+ * @brief   State of the circular DMA reception
+ */
+static struct {
+    uart_rx_chunk_cb_t cb;  /**< callback receiving the data */
+    void *arg;              /**< argument to the callback */
+    uint8_t *buf;           /**< buffer written by the DMA */
+    uint16_t size;          /**< size of the buffer */
+    uint16_t pos;           /**< position of the first unconsumed byte */
+} rx_dma_ctx[UART_NUMOF];
+
+/**
+ * @brief   State of the asynchronous DMA transmission
+ */
+static struct {
+    uart_tx_done_cb_t cb;   /**< callback invoked when done */
+    void *arg;              /**< argument to the callback */
+    bool in_cb;             /**< callback is running */
+    bool chained;           /**< callback started another write */
+} tx_dma_ctx[UART_NUMOF];
+#endif
+
 static inline USART_TypeDef *dev(uart_t uart)
 {
     return uart_config[uart].dev;
@@ -441,6 +466,133 @@ void uart_poweroff(uart_t uart)
     uart_disable_clock(uart);
 }
 
+#ifdef MODULE_PERIPH_UART_DMA
+static void _rx_dma_flush(uart_t uart)
+{
+    uint16_t head = rx_dma_ctx[uart].size
+                  - dma_remaining(uart_config[uart].rx_dma);
+    uint16_t pos = rx_dma_ctx[uart].pos;
+
+    if (head == rx_dma_ctx[uart].size) {
+        head = 0;
+    }
+    if (head == pos) {
+        return;
+    }
+
+    /* hand out the data up to the end of the buffer first when wrapped */
+    if (head < pos) {
+        rx_dma_ctx[uart].cb(rx_dma_ctx[uart].arg, &rx_dma_ctx[uart].buf[pos],
+                            rx_dma_ctx[uart].size - pos);
+        pos = 0;
+    }
+    if (head > pos) {
+        rx_dma_ctx[uart].cb(rx_dma_ctx[uart].arg, &rx_dma_ctx[uart].buf[pos],
+                            head - pos);
+    }
+    rx_dma_ctx[uart].pos = head;
+}
+
+static void _rx_dma_cb(void *arg)
+{
+    _rx_dma_flush((uart_t)(uintptr_t)arg);
+}
+
+int uart_rx_dma_start(uart_t uart, uint8_t *buf, size_t size,
+                      uart_rx_chunk_cb_t cb, void *arg)
+{
+    assert(uart < UART_NUMOF);
+    assert(cb && (size <= UINT16_MAX));
+
+    dma_t dma = uart_config[uart].rx_dma;
+
+    if (dma == DMA_STREAM_UNDEF) {
+        return UART_NODEV;
+    }
+
+    rx_dma_ctx[uart].cb = cb;
+    rx_dma_ctx[uart].arg = arg;
+    rx_dma_ctx[uart].buf = buf;
+    rx_dma_ctx[uart].size = size;
+    rx_dma_ctx[uart].pos = 0;
+
+    gpio_init(uart_config[uart].rx_pin, GPIO_IN_PU);
+#ifndef CPU_FAM_STM32F1
+    gpio_init_af(uart_config[uart].rx_pin, uart_config[uart].rx_af);
+#endif
+
+    /* the stream is kept for as long as the UART receives */
+    dma_acquire(dma);
+    dma_setup(dma, uart_config[uart].rx_dma_chan,
+              (void *)&dev(uart)->RDR_REG, DMA_PERIPH_TO_MEM,
+              DMA_DATA_WIDTH_BYTE, false);
+    dma_set_circular(dma, true);
+    dma_set_callback(dma, _rx_dma_cb, (void *)(uintptr_t)uart);
+    dma_prepare(dma, buf, size, true);
+
+    dev(uart)->CR3 |= USART_CR3_DMAR;
+    dma_start(dma);
+
+    NVIC_EnableIRQ(uart_config[uart].irqn);
+    dev(uart)->CR1 |= (USART_CR1_RE | USART_CR1_IDLEIE);
+
+    return UART_OK;
+}
+
+static void _tx_dma_cb(void *arg)
+{
+    uart_t uart = (uart_t)(uintptr_t)arg;
+    uart_tx_done_cb_t cb = tx_dma_ctx[uart].cb;
+
+    dev(uart)->CR3 &= ~USART_CR3_DMAT;
+
+    tx_dma_ctx[uart].chained = false;
+    if (cb) {
+        tx_dma_ctx[uart].in_cb = true;
+        cb(tx_dma_ctx[uart].arg);
+        tx_dma_ctx[uart].in_cb = false;
+    }
+    /* keep the stream if the callback started the next write */
+    if (!tx_dma_ctx[uart].chained) {
+        dma_set_callback(uart_config[uart].dma, NULL, NULL);
+        dma_release(uart_config[uart].dma);
+    }
+}
+
+int uart_write_async(uart_t uart, const uint8_t *data, size_t len,
+                     uart_tx_done_cb_t cb, void *arg)
+{
+    assert(uart < UART_NUMOF);
+
+    dma_t dma = uart_config[uart].dma;
+
+    if (dma == DMA_STREAM_UNDEF) {
+        return UART_NODEV;
+    }
+
+    if (tx_dma_ctx[uart].in_cb) {
+        /* chained from the callback, the stream is still acquired */
+        tx_dma_ctx[uart].chained = true;
+    }
+    else {
+        assert(!irq_is_in());
+        /* blocks while a previous write is still in progress */
+        dma_acquire(dma);
+    }
+    tx_dma_ctx[uart].cb = cb;
+    tx_dma_ctx[uart].arg = arg;
+
+    dma_configure(dma, uart_config[uart].dma_chan, data,
+                  (void *)&dev(uart)->TDR_REG, len, DMA_MEM_TO_PERIPH,
+                  DMA_INC_SRC_ADDR);
+    dma_set_callback(dma, _tx_dma_cb, (void *)(uintptr_t)uart);
+    dev(uart)->CR3 |= USART_CR3_DMAT;
+    dma_start(dma);
+
+    return UART_OK;
+}
+#endif /* MODULE_PERIPH_UART_DMA */
+
 #ifdef MODULE_PERIPH_UART_NONBLOCKING
 static inline void irq_handler_tx(uart_t uart)
 {
@@ -466,10 +618,22 @@ static inline void irq_handler(uart_t uart)
     }
 #endif
 
-    if (status & ISR_RXNE) {
+    /* with DMA reception, the data register is read by the DMA */
+    if ((status & ISR_RXNE) && isr_ctx[uart].rx_cb) {
         isr_ctx[uart].rx_cb(isr_ctx[uart].arg,
                             (uint8_t)dev(uart)->RDR_REG & isr_ctx[uart].data_mask);
     }
+#ifdef MODULE_PERIPH_UART_DMA
+    if ((status & ISR_IDLE) && (dev(uart)->CR1 & USART_CR1_IDLEIE)) {
+#if defined(USART_ICR_IDLECF)
+        dev(uart)->ICR = USART_ICR_IDLECF;
+#else
+        /* USART_SR_IDLE is cleared by reading SR and DR sequentially */
+        dev(uart)->DR;
+#endif
+        _rx_dma_flush(uart);
+    }
+#endif
 #if defined(USART_ISR_ORE)
     /* USART_ISR_ORE is cleared by writing 1 to ORECF */
     if (status & USART_ISR_ORE) {
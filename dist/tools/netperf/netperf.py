@@ -0,0 +1,208 @@
+#! /usr/bin/env python3
+#
+# Copyright (C) 2021 ML!PA Consulting GmbH
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+#
+# @author   ML!PA Consulting GmbH
+
+"""
+Host side of the netperf network benchmark.
+
+As server, it echoes request/response datagrams, and reports packets,
+loss, jitter and throughput of every UDP stream and the throughput of every
+TCP connection. As client, it runs UDP stream and request/response tests
+against a node running `netperf server`.
+"""
+
+import argparse
+import socket
+import struct
+import sys
+import threading
+import time
+
+PORT = 12865
+# sequence number, time of sending in us, mode, 3 reserved bytes
+HDR = struct.Struct("!IIB3x")
+MODE_STREAM = 0
+MODE_RR = 1
+# a stream is over once no datagram arrived for that long
+STREAM_IDLE_S = 2.0
+
+
+def now_us():
+    return int(time.monotonic() * 1000000) & 0xffffffff
+
+
+def signed32(val):
+    val &= 0xffffffff
+    return val - (1 << 32) if val & 0x80000000 else val
+
+
+class Stream:
+    """Receiver statistics of a UDP stream"""
+
+    def __init__(self, now):
+        self.first = now
+        self.last = now
+        self.packets = 0
+        self.bytes = 0
+        self.next = 0
+        self.transit = None
+        self.jitter = 0.0
+
+    def add(self, seq, ts_us, length, now):
+        # RFC 3550, section 6.4.1
+        transit = signed32(int(now * 1000000) - ts_us)
+        if self.transit is not None:
+            self.jitter += (abs(transit - self.transit) - self.jitter) / 16
+        self.transit = transit
+        self.next = max(self.next, seq + 1)
+        self.packets += 1
+        self.bytes += length
+        self.last = now
+
+    def report(self, peer):
+        secs = self.last - self.first
+        lost = max(self.next - self.packets, 0)
+        print("udp_stream from {}: {} pkts {} B {:.0f} us {:.0f} kbit/s "
+              "lost {} ({:.1f}%) jitter {:.0f} us".format(
+                  peer, self.packets, self.bytes, secs * 1000000,
+                  self.bytes * 8 / secs / 1000 if secs else 0, lost,
+                  100 * lost / self.next if self.next else 0, self.jitter))
+
+
+def udp_server(sock):
+    streams = {}
+    sock.settimeout(STREAM_IDLE_S / 4)
+    while True:
+        try:
+            data, peer = sock.recvfrom(65536)
+        except socket.timeout:
+            data = None
+        now = time.monotonic()
+        for key in [k for k, s in streams.items()
+                    if now - s.last > STREAM_IDLE_S]:
+            streams.pop(key).report(key[0])
+        if data is None or len(data) < HDR.size:
+            continue
+        seq, ts_us, mode = HDR.unpack_from(data)
+        if mode == MODE_RR:
+            sock.sendto(data, peer)
+            continue
+        if seq == 0 and peer in streams:
+            streams.pop(peer).report(peer[0])
+        streams.setdefault(peer, Stream(now)).add(seq, ts_us, len(data), now)
+
+
+def tcp_conn(conn, peer):
+    total = 0
+    start = time.monotonic()
+    with conn:
+        while True:
+            data = conn.recv(65536)
+            if not data:
+                break
+            total += len(data)
+    secs = time.monotonic() - start
+    print("tcp_stream from {}: {} B {:.0f} us {:.0f} kbit/s".format(
+        peer[0], total, secs * 1000000, total * 8 / secs / 1000 if secs else 0))
+
+
+def tcp_server(sock):
+    sock.listen(1)
+    while True:
+        conn, peer = sock.accept()
+        threading.Thread(target=tcp_conn, args=(conn, peer),
+                         daemon=True).start()
+
+
+def server(args):
+    udp = socket.socket(socket.AF_INET6, socket.SOCK_DGRAM)
+    udp.bind(("::", args.port))
+    tcp = socket.socket(socket.AF_INET6, socket.SOCK_STREAM)
+    tcp.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    tcp.bind(("::", args.port))
+    threading.Thread(target=tcp_server, args=(tcp,), daemon=True).start()
+    print("netperf server on port {}".format(args.port))
+    udp_server(udp)
+
+
+def udp_stream(args):
+    sock = socket.socket(socket.AF_INET6, socket.SOCK_DGRAM)
+    pad = bytes(max(args.len - HDR.size, 0))
+    start = time.monotonic()
+    for seq in range(args.count):
+        sock.sendto(HDR.pack(seq, now_us(), MODE_STREAM) + pad,
+                    (args.host, args.port))
+        if args.gap:
+            time.sleep(max(start + (seq + 1) * args.gap / 1000000 -
+                           time.monotonic(), 0))
+    secs = time.monotonic() - start
+    print("udp_stream: {} pkts in {:.0f} us, see `netperf result` on the "
+          "node".format(args.count, secs * 1000000))
+
+
+def percentile(values, pct):
+    return values[min(int(len(values) * pct / 100), len(values) - 1)]
+
+
+def udp_rr(args):
+    sock = socket.socket(socket.AF_INET6, socket.SOCK_DGRAM)
+    sock.settimeout(args.timeout / 1000000)
+    pad = bytes(max(args.len - HDR.size, 0))
+    rtts = []
+    for seq in range(args.count):
+        sent = time.monotonic()
+        sock.sendto(HDR.pack(seq, now_us(), MODE_RR) + pad,
+                    (args.host, args.port))
+        try:
+            while True:
+                data = sock.recv(65536)
+                if len(data) >= HDR.size and HDR.unpack_from(data)[0] == seq:
+                    rtts.append((time.monotonic() - sent) * 1000000)
+                    break
+        except socket.timeout:
+            pass
+    lost = args.count - len(rtts)
+    print("udp_rr: {} pkts lost {} ({:.1f}%)".format(
+        len(rtts), lost, 100 * lost / args.count))
+    if rtts:
+        rtts.sort()
+        print("rtt: min {:.0f} p50 {:.0f} p90 {:.0f} p99 {:.0f} max {:.0f} us"
+              .format(rtts[0], percentile(rtts, 50), percentile(rtts, 90),
+                      percentile(rtts, 99), rtts[-1]))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    sub = parser.add_subparsers(dest="mode", required=True)
+    p = sub.add_parser("server", help="serve nodes running tests")
+    p.add_argument("-p", "--port", type=int, default=PORT)
+    p.set_defaults(func=server)
+    for name, func in (("udp_stream", udp_stream), ("udp_rr", udp_rr)):
+        p = sub.add_parser(name, help="test against a node")
+        p.add_argument("host", help="address of the node")
+        p.add_argument("-p", "--port", type=int, default=PORT)
+        p.add_argument("-l", "--len", type=int, default=64,
+                       help="datagram length (default: %(default)s)")
+        p.add_argument("-n", "--count", type=int, default=1000,
+                       help="number of datagrams (default: %(default)s)")
+        p.add_argument("-g", "--gap", type=int, default=0,
+                       help="gap between datagrams in us (default: none)")
+        p.add_argument("-t", "--timeout", type=int, default=1000000,
+                       help="response timeout in us (default: %(default)s)")
+        p.set_defaults(func=func)
+    args = parser.parse_args()
+    try:
+        args.func(args)
+    except KeyboardInterrupt:
+        return 0
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -19,6 +19,7 @@
 #include <string.h>
 #include <stdlib.h>
 
+#include "hashes/sha256.h"
 #include "riotboot/hdr.h"
 #include "common.h"
 
@@ -41,6 +42,39 @@ static void populate_hdr(riotboot_hdr_t *hdr, uint32_t ver, uint32_t addr)
     hdr->chksum = riotboot_hdr_checksum(hdr);
 }
 
+static int populate_digest(riotboot_hdr_digest_t *digest, const char *img_file)
+{
+    FILE *f = fopen(img_file, "rb");
+    if (f == NULL) {
+        return -1;
+    }
+
+    sha256_context_t sha256;
+    uint8_t buf[1024];
+    size_t len = 0;
+    size_t n;
+
+    sha256_init(&sha256);
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+        sha256_update(&sha256, buf, n);
+        len += n;
+    }
+    int err = ferror(f);
+    fclose(f);
+    if (err || len > UINT32_MAX) {
+        return -1;
+    }
+
+    digest->img_len = len;
+    sha256_final(&sha256, digest->digest);
+    digest->chksum = riotboot_hdr_digest_checksum(digest);
+
+    /* left erased, so the bootloader can mark the image as verified */
+    memset(digest->verified, 0xff, sizeof(digest->verified));
+
+    return 0;
+}
+
 int genhdr(int argc, char *argv[])
 {
     const char generate_usage[] = "<IMG_BIN> <APP_VER> <START_ADDR> <HDR_LEN> <outfile|->";
@@ -101,6 +135,14 @@ int genhdr(int argc, char *argv[])
 
     populate_hdr((riotboot_hdr_t*)hdr_buf, app_ver, start_addr);
 
+    if (hdr_len < sizeof(riotboot_hdr_t) + sizeof(riotboot_hdr_digest_t) ||
+        populate_digest((riotboot_hdr_digest_t *)(hdr_buf + sizeof(riotboot_hdr_t)),
+                        argv[1])) {
+        fprintf(stderr, "Error: cannot hash IMG_BIN!\n");
+        free(hdr_buf);
+        return -1;
+    }
+
     /* Write the header */
     if (!to_file(argv[5], hdr_buf, hdr_len)) {
         fprintf(stderr, "Error: cannot write output\n");
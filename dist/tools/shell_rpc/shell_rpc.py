@@ -0,0 +1,98 @@
+#! /usr/bin/env python3
+#
+# Copyright (C) 2021 ML!PA Consulting GmbH
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+#
+# @author   ML!PA Consulting GmbH
+
+"""
+Client for the binary shell RPC protocol of the shell_rpc module.
+
+Sends one CBOR encoded request over a serial port and prints the decoded
+result. Text output of the node in between is passed through to stderr.
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+import cbor2
+import serial
+
+FRAME_START = 0xc0
+
+
+def crc16_ccitt(data, crc=0x1d0f):
+    # same start value as crc16_ccitt_calc() of RIOT
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xffff
+    return crc
+
+
+def frame(payload):
+    head = struct.pack(">H", len(payload))
+    crc = crc16_ccitt(head + payload)
+    return bytes([FRAME_START]) + head + payload + struct.pack(">H", crc)
+
+
+class ShellRpc:
+    def __init__(self, port):
+        self.port = port
+        self.next_id = 0
+
+    def _read(self, num):
+        data = self.port.read(num)
+        if len(data) != num:
+            raise TimeoutError("no response")
+        return data
+
+    def call(self, name, args=None):
+        req_id = self.next_id
+        self.next_id = (self.next_id + 1) & 0xffffffff
+        self.port.write(frame(cbor2.dumps([req_id, name, args])))
+        while True:
+            byte = self._read(1)
+            if byte[0] != FRAME_START:
+                sys.stderr.buffer.write(byte)
+                continue
+            head = self._read(2)
+            payload = self._read(struct.unpack(">H", head)[0])
+            crc = struct.unpack(">H", self._read(2))[0]
+            if crc != crc16_ccitt(head + payload):
+                raise ValueError("response CRC mismatch")
+            res_id, status, result = cbor2.loads(payload)
+            if res_id != req_id:
+                # stale response of an earlier request that timed out
+                continue
+            if status != 0:
+                raise OSError(-status, "{} failed".format(name))
+            return result
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("port", help="serial port, e.g. /dev/ttyACM0")
+    parser.add_argument("command", help="RPC command, e.g. help or threads")
+    parser.add_argument("args", nargs="?", default=None,
+                        help="arguments as JSON, e.g. 6 or '[1, \"a\"]'")
+    parser.add_argument("-b", "--baudrate", type=int, default=115200)
+    parser.add_argument("-t", "--timeout", type=float, default=2.0)
+    args = parser.parse_args()
+
+    with serial.Serial(args.port, args.baudrate,
+                       timeout=args.timeout) as port:
+        rpc = ShellRpc(port)
+        cmd_args = json.loads(args.args) if args.args is not None else None
+        result = rpc.call(args.command, cmd_args)
+    print(json.dumps(result, default=lambda b: b.hex()))
+
+
+if __name__ == "__main__":
+    main()
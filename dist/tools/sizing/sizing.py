@@ -0,0 +1,104 @@
+#! /usr/bin/env python3
+#
+# Copyright (C) 2021 ML!PA Consulting GmbH
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+#
+# @author   ML!PA Consulting GmbH
+
+"""
+Table sizes of GNRC from runtime high-water marks.
+
+Reads the output of the `metrics` shell command, as logged by test runs or
+field devices, and writes a header with the sizes needed by the highest
+usage seen in any of the logs plus some headroom.
+"""
+
+import argparse
+import re
+import sys
+
+# e.g. "nib.onl_max 3", also after a prompt or timestamp of the terminal
+METRIC_RE = re.compile(r"([A-Za-z_]\w*)(?:\[\d+\])?\.(\w+) (-?\d+)\s*$")
+
+# (metric of the high-water mark, metric counting overflows, option, unit)
+TABLES = (
+    ("nib.onl_max", "nib.onl_full", "CONFIG_GNRC_IPV6_NIB_NUMOF", 1),
+    ("nib.offl_max", "nib.offl_full", "CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF", 1),
+    ("nib.dr_max", None, "CONFIG_GNRC_IPV6_NIB_DEFAULT_ROUTER_NUMOF", 1),
+    ("netif_ipv6.addrs_max", "netif_ipv6.addrs_full",
+     "CONFIG_GNRC_NETIF_IPV6_ADDRS_NUMOF", 1),
+    # the packet buffer fragments, its headroom must not be too tight
+    ("pktbuf.used_max", "pktbuf.alloc_failed", "CONFIG_GNRC_PKTBUF_SIZE", 64),
+)
+
+
+def parse(files):
+    """Largest value of every metric in all files"""
+    values = {}
+    for f in files:
+        for line in f:
+            m = METRIC_RE.search(line)
+            if m is None:
+                continue
+            name = "{}.{}".format(m.group(1), m.group(2))
+            values[name] = max(values.get(name, 0), int(m.group(3)))
+    return values
+
+
+def size(hwm, headroom, unit):
+    """hwm plus headroom in percent, at least one unit, rounded up to unit"""
+    extra = max(hwm * headroom // 100, unit)
+    return -(-(hwm + extra) // unit) * unit
+
+
+def profile(values, headroom, sources):
+    lines = [
+        "/* Generated by dist/tools/sizing/sizing.py with {}% headroom from".format(headroom),
+        " * {} */".format(" ".join(sources)),
+        "",
+        "#ifndef SIZING_PROFILE_H",
+        "#define SIZING_PROFILE_H",
+        "",
+    ]
+    for hwm_name, full_name, option, unit in TABLES:
+        if hwm_name not in values:
+            continue
+        hwm = values[hwm_name]
+        full = values.get(full_name, 0) if full_name else 0
+        if full:
+            print("warning: {} overflowed {} times, the real need is larger "
+                  "than {}".format(option, full, hwm), file=sys.stderr)
+            lines.append("/* overflowed {} times, increase and measure "
+                         "again */".format(full))
+        lines += [
+            "#ifndef {}".format(option),
+            "#define {} ({})".format(option, size(hwm, headroom, unit)),
+            "#endif",
+        ]
+    lines += ["", "#endif /* SIZING_PROFILE_H */"]
+    return "\n".join(lines) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("logs", nargs="*", type=argparse.FileType("r"),
+                        default=[sys.stdin],
+                        help="logs of the metrics shell command")
+    parser.add_argument("-o", "--output", type=argparse.FileType("w"),
+                        default=sys.stdout, help="header to write")
+    parser.add_argument("--headroom", type=int, default=25,
+                        help="headroom in percent of the high-water mark")
+    args = parser.parse_args()
+
+    values = parse(args.logs)
+    if not values:
+        sys.exit("no metrics found, is the metrics module used?")
+    args.output.write(profile(values, args.headroom,
+                              [f.name for f in args.logs]))
+
+
+if __name__ == "__main__":
+    main()
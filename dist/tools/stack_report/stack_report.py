@@ -0,0 +1,225 @@
+#! /usr/bin/env python3
+#
+# Copyright (C) 2021 ML!PA Consulting GmbH
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+#
+# @author   ML!PA Consulting GmbH
+
+"""
+Static worst case stack usage and IRQ-disabled sections of a RIOT firmware.
+
+Combines the per function stack usage written by GCC with -fstack-usage
+(*.su files) with the call graph taken from the disassembly of the ELF file.
+"""
+
+import argparse
+import collections
+import os
+import re
+import subprocess
+import sys
+
+FUNC_RE = re.compile(r"^([0-9a-f]+) <(.+)>:$")
+TARGET_RE = re.compile(r"<([^>+]+)>")
+# mnemonics of direct calls, to tell recursion from a loop
+CALL_RE = re.compile(r"^(bl|blx|call\d*|jal|rcall|jsr)$")
+# mnemonics of calls through a register
+INDIRECT_RE = re.compile(r"^(blx|callx\d*|jalr|icall|eicall)$")
+IRQ_OFF_CALLS = ("irq_disable",)
+IRQ_ON_CALLS = ("irq_restore", "irq_enable")
+
+
+class Func:
+    def __init__(self, name):
+        self.name = name
+        self.frame = None           # None: no stack usage information
+        self.dynamic = False
+        self.insns = []             # (mnemonic, operands)
+        self.callees = []           # in order of appearance
+        self.indirect = False
+
+
+def read_su(bindir):
+    frames = {}
+    for root, _, files in os.walk(bindir):
+        for name in files:
+            if not name.endswith(".su"):
+                continue
+            with open(os.path.join(root, name)) as f:
+                for line in f:
+                    fields = line.rstrip("\n").split("\t")
+                    if len(fields) < 3:
+                        continue
+                    func = fields[0].rsplit(":", 1)[-1]
+                    size = int(fields[1])
+                    dynamic = "dynamic" in fields[2]
+                    # static functions of the same name: be conservative
+                    old = frames.get(func, (0, False))
+                    frames[func] = (max(old[0], size), old[1] or dynamic)
+    return frames
+
+
+def read_elf(objdump, elffile):
+    out = subprocess.run([objdump, "-d", "--no-show-raw-insn", elffile],
+                         check=True, stdout=subprocess.PIPE,
+                         universal_newlines=True).stdout
+    funcs = collections.OrderedDict()
+    cur = None
+    for line in out.splitlines():
+        m = FUNC_RE.match(line)
+        if m:
+            cur = funcs.setdefault(m.group(2), Func(m.group(2)))
+            continue
+        if cur is None:
+            continue
+        parts = line.split("\t")
+        if len(parts) < 2 or not parts[0].strip().endswith(":"):
+            continue
+        insn = parts[-1].split(None, 1) if len(parts) == 2 else \
+            [parts[1].strip(), parts[2].strip() if len(parts) > 2 else ""]
+        if not insn or not insn[0]:
+            continue
+        mnemonic = insn[0].strip()
+        operands = insn[1].strip() if len(insn) > 1 else ""
+        # drop x86 comments naming data symbols
+        operands = re.sub(r"\s+#\s.*$", "", operands)
+        cur.insns.append((mnemonic, operands))
+        target = TARGET_RE.search(operands)
+        if target and (target.group(1) != cur.name or
+                       CALL_RE.match(mnemonic)):
+            cur.callees.append(target.group(1))
+        elif INDIRECT_RE.match(mnemonic) or \
+                (mnemonic == "call" and "<" not in operands and
+                 operands.startswith("*")):
+            cur.indirect = True
+    return funcs
+
+
+class Analysis:
+    def __init__(self, funcs):
+        self.funcs = funcs
+        self.memo = {}
+
+    def worst(self, name, stack=()):
+        """returns (bytes, path, notes) of the deepest call chain"""
+        if name in self.memo:
+            return self.memo[name]
+        func = self.funcs.get(name)
+        if func is None:
+            return 0, [name], {"unknown"}
+        if name in stack:
+            return 0, [name], {"recursion"}
+        notes = set()
+        if func.frame is None:
+            notes.add("unknown")
+        if func.dynamic:
+            notes.add("dynamic")
+        if func.indirect:
+            notes.add("indirect")
+        best, best_path = 0, []
+        recursive = False
+        for callee in dict.fromkeys(func.callees):
+            size, path, sub = self.worst(callee, stack + (name,))
+            notes |= sub
+            recursive |= "recursion" in sub
+            if size > best:
+                best, best_path = size, path
+        result = ((func.frame or 0) + best, [name] + best_path, notes)
+        # results within a recursion depend on the call stack
+        if not recursive:
+            self.memo[name] = result
+        return result
+
+
+def irq_sections(funcs):
+    """linear instruction count between disabling and restoring IRQs"""
+    sections = []
+    for func in funcs.values():
+        start = None
+        calls = []
+        for idx, (mnemonic, operands) in enumerate(func.insns):
+            target = TARGET_RE.search(operands)
+            target = target.group(1) if target else None
+            low = operands.lower()
+            if (target in IRQ_OFF_CALLS or mnemonic == "cpsid") and \
+                    func.name not in IRQ_OFF_CALLS:
+                if start is None:
+                    start, calls = idx, []
+            elif start is not None and (
+                    target in IRQ_ON_CALLS or mnemonic == "cpsie" or
+                    (mnemonic == "msr" and
+                     ("primask" in low or "basepri" in low))):
+                sections.append((idx - start, func.name, calls))
+                start = None
+            elif start is not None and target and target != func.name:
+                calls.append(target)
+    return sorted(sections, key=lambda s: -s[0])
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("elffile", help="firmware ELF file")
+    parser.add_argument("bindir", help="directory to search for *.su files")
+    parser.add_argument("--objdump", default="objdump",
+                        help="objdump of the toolchain (default: "
+                             "%(default)s)")
+    parser.add_argument("-e", "--entry", action="append", default=[],
+                        help="report this entry function, e.g. a thread "
+                             "function (may be given multiple times)")
+    parser.add_argument("-n", "--count", type=int, default=20,
+                        help="number of entries and IRQ sections to list "
+                             "without -e (default: %(default)s)")
+    parser.add_argument("-p", "--path", action="store_true",
+                        help="print the deepest call chain of each entry")
+    args = parser.parse_args()
+
+    frames = read_su(args.bindir)
+    if not frames:
+        sys.exit("error: no *.su files in {}, rebuild with -fstack-usage "
+                 "(make clean stack-report)".format(args.bindir))
+    funcs = read_elf(args.objdump, args.elffile)
+    for name, func in funcs.items():
+        if name in frames:
+            func.frame, func.dynamic = frames[name]
+
+    analysis = Analysis(funcs)
+    entries = args.entry
+    if not entries:
+        # thread functions and ISRs are only called indirectly
+        called = set(c for f in funcs.values() for c in f.callees)
+        roots = [n for n, f in funcs.items()
+                 if n not in called and f.frame is not None]
+        entries = sorted(roots, key=lambda n: -analysis.worst(n)[0])
+        entries = entries[:args.count]
+
+    print("Worst case stack usage per entry function (bytes)")
+    print("{:>7}  {:<40} {}".format("stack", "entry", "notes"))
+    for name in entries:
+        size, path, notes = analysis.worst(name)
+        print("{:>7}  {:<40} {}".format(size, name, ", ".join(sorted(notes))))
+        if args.path:
+            print("         " + " > ".join(
+                "{}({})".format(n, funcs[n].frame if n in funcs and
+                                funcs[n].frame is not None else "?")
+                for n in path))
+    print()
+    print("notes: unknown = stack usage of some function not known (no .su,")
+    print("       e.g. assembly or precompiled libraries), dynamic = alloca or")
+    print("       VLA, indirect = calls through function pointers not")
+    print("       followed, recursion = recursive call chain not followed")
+    print()
+
+    sections = irq_sections(funcs)[:args.count]
+    print("Longest IRQ-disabled sections (instructions between disabling and")
+    print("restoring IRQs in address order, called functions not included)")
+    print("{:>7}  {:<40} {}".format("insns", "function", "calls"))
+    for count, name, calls in sections:
+        print("{:>7}  {:<40} {}".format(count, name,
+                                        ", ".join(dict.fromkeys(calls))))
+
+
+if __name__ == "__main__":
+    main()
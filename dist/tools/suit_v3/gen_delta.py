@@ -0,0 +1,140 @@
+#!/usr/bin/env python3
+
+#
+# Copyright (C) 2021 ML!PA Consulting GmbH
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+#
+
+"""Generate a delta patch for riotboot_flashwrite_delta.
+
+The patch rebuilds NEW from OLD, where OLD is the image that is running on
+the device. Both images have to be the slot binaries including the riotboot
+header. The manifest still has to describe NEW, i.e. its size and digest.
+"""
+
+import argparse
+
+MAGIC = b"RBD1"
+BLOCK = 8
+
+
+def varint(val):
+    out = bytearray()
+    while True:
+        byte = val & 0x7f
+        val >>= 7
+        if val:
+            out.append(byte | 0x80)
+        else:
+            out.append(byte)
+            return out
+
+
+def zigzag(val):
+    return (val << 1) if val >= 0 else ((-val << 1) - 1)
+
+
+def encode_diff(diff):
+    """Alternating runs of unchanged and changed bytes."""
+    out = bytearray()
+    i = 0
+    while True:
+        start = i
+        while i < len(diff) and diff[i] == 0:
+            i += 1
+        out += varint(i - start)
+        if i == len(diff):
+            return out
+        start = i
+        # a single unchanged byte is cheaper inside the changed run
+        while i < len(diff) and (diff[i] or diff[i + 1:i + 2] not in (b"\0", b"")):
+            i += 1
+        out += varint(i - start)
+        out += diff[start:i]
+
+
+def build_index(old):
+    index = {}
+    for i in range(len(old) - BLOCK + 1):
+        index.setdefault(old[i:i + BLOCK], i)
+    return index
+
+
+def extend(old, new, o, n):
+    """Extend a match as long as it mostly matches."""
+    length = 0
+    while n + length < len(new) and o + length < len(old):
+        if new[n + length] != old[o + length]:
+            window = zip(new[n + length:n + length + 16],
+                         old[o + length:o + length + 16])
+            if sum(a == b for a, b in window) < 8:
+                break
+        length += 1
+    return length
+
+
+def gen_delta(old, new):
+    index = build_index(old)
+    records = []
+    diff = bytearray()
+    extra = bytearray()
+    src = 0
+    i = 0
+
+    while i < len(new):
+        block = new[i:i + BLOCK]
+        if old[src:src + BLOCK] == block:
+            o = src
+        else:
+            o = index.get(block)
+        if o is None:
+            extra.append(new[i])
+            i += 1
+            continue
+
+        if diff or extra or o != src:
+            records.append((diff, extra, o - src))
+        length = extend(old, new, o, i)
+        diff = bytearray((new[i + k] - old[o + k]) & 0xff for k in range(length))
+        extra = bytearray()
+        src = o + length
+        i += length
+
+    if diff or extra:
+        records.append((diff, extra, 0))
+
+    out = bytearray(MAGIC)
+    for diff, extra, adjust in records:
+        out += varint(len(diff))
+        out += varint(len(extra))
+        out += varint(zigzag(adjust))
+        out += encode_diff(diff) if diff else b""
+        out += extra
+    return out
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("old", help="image running on the device")
+    parser.add_argument("new", help="updated image")
+    parser.add_argument("--output", "-o", required=True, help="patch file")
+    args = parser.parse_args()
+
+    with open(args.old, "rb") as f:
+        old = f.read()
+    with open(args.new, "rb") as f:
+        new = f.read()
+
+    patch = gen_delta(old, new)
+    with open(args.output, "wb") as f:
+        f.write(patch)
+
+    print("{}: {} bytes for an image of {} bytes".format(
+        args.output, len(patch), len(new)))
+
+
+if __name__ == "__main__":
+    main()
@@ -35,6 +35,10 @@ def parse_arguments():
                         help='Manifest vendor uuid')
     parser.add_argument('--uuid-class', '-C', default="native",
                         help='Manifest class uuid')
+    parser.add_argument('--compression', '-z', default=None,
+                        choices=['heatshrink'],
+                        help='Compression of the published slot files, '
+                             'which are named <slotfile>.<compression>')
     parser.add_argument('slotfiles', nargs="+",
                         help='The list of slot file paths')
     return parser.parse_args()
@@ -64,7 +68,10 @@ def main(args):
     for slot, image in enumerate(images):
         filename, offset = image
 
-        uri = os.path.join(args.urlroot, os.path.basename(filename))
+        payload = os.path.basename(filename)
+        if args.compression:
+            payload += "." + args.compression
+        uri = os.path.join(args.urlroot, payload)
 
         component = {
             "install-id": ["00"],
@@ -77,6 +84,8 @@ def main(args):
 
         if offset:
             component.update({"offset": offset})
+        if args.compression:
+            component.update({"compression-info": args.compression})
 
         template["components"].append(component)
 
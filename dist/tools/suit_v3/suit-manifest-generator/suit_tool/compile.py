@@ -178,7 +178,7 @@ def compile_manifest(options, m):
                 'uri' : lambda cid, data: ('uri', data['uri']),
             }
             if any(['compression-info' in c and not c.get('decompress-on-load', False) for c in choices]):
-                InstParams['compression-info'] = lambda cid, data: data.get('compression-info')
+                InstParams['compression-info'] = lambda cid, data: ('compression-info', data['compression-info'])
             InstCmds = {
                 'offset': lambda cid, data: mkCommand(
                     cid, 'condition-component-offset', data['offset'])
@@ -194,7 +194,7 @@ def compile_manifest(options, m):
                     'image-digest', data.get('download-digest', data['install-digest']))
             }
             if any(['compression-info' in c and not c.get('decompress-on-load', False) for c in choices]):
-                FetchParams['compression-info'] = lambda cid, data: data.get('compression-info')
+                FetchParams['compression-info'] = lambda cid, data: ('compression-info', data['compression-info'])
 
             FetchCmds = {
                 'offset': lambda cid, data: mkCommand(
@@ -371,7 +371,8 @@ class SUITCompressionInfo(SUITKeyMap):
         'bzip2' : 2,
         'deflate' : 3,
         'lz4' : 4,
-        'lzma' : 7
+        'lzma' : 7,
+        'heatshrink' : -1
     })
 
 class SUITParameters(SUITManifestDict):
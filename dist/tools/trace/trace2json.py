@@ -0,0 +1,152 @@
+#! /usr/bin/env python3
+#
+# Copyright (C) 2021 ML!PA Consulting GmbH
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+#
+# @author   ML!PA Consulting GmbH
+
+"""
+Script to convert a binary dump of the `trace` module (see `trace_dump_bin()`)
+into the Chrome trace event format, which can be opened with Perfetto
+(https://ui.perfetto.dev) or `chrome://tracing`.
+"""
+
+import argparse
+import json
+import re
+import struct
+import sys
+
+MAGIC = b"RTRC"
+VERSION = 1
+
+EV_SCHED = 0xf0
+EV_ISR_ENTER = 0xf1
+EV_ISR_EXIT = 0xf2
+EV_MSG_SEND = 0xf3
+EV_MSG_RECV = 0xf4
+EV_NETIF_TX = 0xf5
+EV_NETIF_RX = 0xf6
+
+# all events are shown as one process, threads and ISRs as its threads
+PID = 0
+TID_ISR = "isr"
+
+
+def leb128(data, pos):
+    val = 0
+    shift = 0
+    while True:
+        if pos >= len(data):
+            raise ValueError("truncated entry at offset {}".format(pos))
+        byte = data[pos]
+        pos += 1
+        val |= (byte & 0x7f) << shift
+        shift += 7
+        if not byte & 0x80:
+            return val, pos
+
+
+def parse(data):
+    if data[:len(MAGIC)] != MAGIC:
+        raise ValueError("not a trace dump (bad magic)")
+    version, hz = struct.unpack_from("<BI", data, len(MAGIC))
+    if version != VERSION:
+        raise ValueError("unsupported trace version {}".format(version))
+    pos = len(MAGIC) + 5
+
+    entries = []
+    time = None
+    while pos < len(data):
+        zigzag, pos = leb128(data, pos)
+        val, pos = leb128(data, pos)
+        delta = (zigzag >> 1) ^ -(zigzag & 1)
+        # the first delta is the absolute (unsigned) 32 bit timestamp
+        time = (delta & 0xffffffff) if time is None else time + delta
+        entries.append((time, val))
+    return hz, entries
+
+
+def read_input(f, hex_input):
+    data = f.read()
+    if hex_input:
+        data = bytes.fromhex(re.sub(r"\s", "",
+                                    data.decode("ascii", "ignore")))
+    return data
+
+
+def convert(hz, entries):
+    events = []
+    current = None
+
+    def ts(time):
+        return time * 1000000 / hz
+
+    def instant(time, name, tid, args):
+        events.append({"name": name, "ph": "i", "s": "t", "ts": ts(time),
+                       "pid": PID, "tid": tid, "args": args})
+
+    # entries of an ISR and the interrupted thread may be slightly reordered
+    entries = sorted(entries, key=lambda e: e[0])
+    for time, val in entries:
+        etype = val >> 24
+        arg = val & 0xffffff
+        tid = current if current is not None else TID_ISR
+        if etype == EV_SCHED:
+            if current is not None:
+                events.append({"name": "running", "ph": "E", "ts": ts(time),
+                               "pid": PID, "tid": current})
+            current = arg
+            events.append({"name": "running", "ph": "B", "ts": ts(time),
+                           "pid": PID, "tid": current})
+        elif etype == EV_ISR_ENTER:
+            events.append({"name": "irq {}".format(arg), "ph": "B",
+                           "ts": ts(time), "pid": PID, "tid": TID_ISR})
+        elif etype == EV_ISR_EXIT:
+            events.append({"name": "irq {}".format(arg), "ph": "E",
+                           "ts": ts(time), "pid": PID, "tid": TID_ISR})
+        elif etype == EV_MSG_SEND:
+            instant(time, "msg_send", tid, {"target": arg})
+        elif etype == EV_MSG_RECV:
+            instant(time, "msg_receive", tid, {"type": hex(arg)})
+        elif etype == EV_NETIF_TX:
+            instant(time, "netif_tx", tid, {"netif": arg})
+        elif etype == EV_NETIF_RX:
+            instant(time, "netif_rx", tid, {"netif": arg})
+        else:
+            instant(time, "trace", tid, {"value": "0x{:08x}".format(val)})
+    if current is not None and entries:
+        events.append({"name": "running", "ph": "E", "ts": ts(entries[-1][0]),
+                       "pid": PID, "tid": current})
+    return {"traceEvents": events, "displayTimeUnit": "ns"}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("dump", nargs="?", type=argparse.FileType("rb"),
+                        default=sys.stdin.buffer,
+                        help="binary trace dump (default: stdin)")
+    parser.add_argument("-o", "--output", type=argparse.FileType("w"),
+                        default=sys.stdout,
+                        help="trace event JSON file (default: stdout)")
+    parser.add_argument("-x", "--hex", action="store_true",
+                        help="the dump is hex encoded, whitespace is "
+                             "ignored")
+    parser.add_argument("--hz", type=int,
+                        help="timestamp ticks per second, overrides the "
+                             "value of the dump")
+    args = parser.parse_args()
+
+    hz, entries = parse(read_input(args.dump, args.hex))
+    if args.hz:
+        hz = args.hz
+    if not hz:
+        sys.exit("error: clock rate unknown, specify --hz")
+    json.dump(convert(hz, entries), args.output)
+
+
+if __name__ == "__main__":
+    main()
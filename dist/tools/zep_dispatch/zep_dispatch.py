@@ -0,0 +1,206 @@
+#! /usr/bin/env python3
+#
+# Copyright (C) 2021 ML!PA Consulting GmbH
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+#
+# @author   ML!PA Consulting GmbH
+
+"""
+ZEP dispatcher for native RIOT instances using socket_zep.
+
+Every ZEP frame is relayed to all other instances. With --vtime, the
+instances built with the native_vtime module are run on a shared virtual
+clock: only one instance runs at a time, and the clock jumps to the next
+timer deadline once all of them are idle.
+"""
+
+import argparse
+import collections
+import select
+import socket
+import struct
+import sys
+import time
+
+ZEP_PREAMBLE = b"EX"
+VTIME_PREAMBLE = b"VT"
+VTIME_IDLE = 1
+VTIME_ADVANCE = 2
+# preamble, type, reserved, seq, rx, time (see socket_zep_vtime_msg_t)
+VTIME_FMT = "!2sBBIIQ"
+VTIME_NEVER = 2 ** 64 - 1
+
+
+class Node:
+    def __init__(self, addr):
+        self.addr = addr
+        self.vtime = False          # sent a virtual time message
+        self.idle = False
+        self.deadline = VTIME_NEVER
+        self.seq = 0                # last advance sent to the node
+        self.fwd = 0                # frames sent to the node
+        self.woken = 0              # host time of the last advance
+
+
+class Dispatcher:
+    def __init__(self, sock, args):
+        self.sock = sock
+        self.args = args
+        self.nodes = {}
+        self.now = 0
+        self.seq = 0
+        self.busy = None
+        # frames to deliver at the current virtual time, one at a time
+        self.queue = collections.deque()
+        self.stats = collections.Counter()
+
+    def log(self, msg):
+        if self.args.verbose:
+            print("[{:>14.6f}] {}".format(self.now / 1e6, msg),
+                  file=sys.stderr)
+
+    def node(self, addr):
+        if addr not in self.nodes:
+            self.nodes[addr] = Node(addr)
+            print("new node {}".format(addr[:2]), file=sys.stderr)
+        return self.nodes[addr]
+
+    def send_frame(self, node, data):
+        self.sock.sendto(data, node.addr)
+        node.fwd += 1
+        self.stats["frames"] += 1
+
+    def send_advance(self, node):
+        msg = struct.pack(VTIME_FMT, VTIME_PREAMBLE, VTIME_ADVANCE, 0,
+                          node.seq, 0, self.now)
+        self.sock.sendto(msg, node.addr)
+        node.woken = time.monotonic()
+
+    def wake(self, node):
+        self.seq += 1
+        node.seq = self.seq
+        node.idle = False
+        self.busy = node
+        self.send_advance(node)
+        self.stats["wakeups"] += 1
+
+    def handle(self, data, addr):
+        node = self.node(addr)
+        if data[:2] == VTIME_PREAMBLE:
+            if len(data) < struct.calcsize(VTIME_FMT):
+                return
+            _, mtype, _, seq, rx, deadline = struct.unpack_from(VTIME_FMT,
+                                                                data)
+            if mtype != VTIME_IDLE:
+                return
+            node.vtime = True
+            node.deadline = deadline
+            # stale if the node has not seen the last advance or frame yet
+            if seq == node.seq and rx == node.fwd:
+                node.idle = True
+                if self.busy is node:
+                    self.busy = None
+        elif data[:2] == ZEP_PREAMBLE:
+            for dst in sorted(self.nodes.values(), key=lambda n: n.addr):
+                if dst is node:
+                    continue
+                if self.args.vtime and dst.vtime:
+                    self.queue.append((dst, data))
+                else:
+                    self.send_frame(dst, data)
+
+    def schedule(self):
+        if not self.args.vtime or self.busy is not None:
+            return
+        vnodes = [n for n in self.nodes.values() if n.vtime]
+        if len(vnodes) < self.args.nodes or \
+           not all(n.idle for n in vnodes):
+            return
+        if self.queue:
+            dst, data = self.queue.popleft()
+            self.wake(dst)
+            self.send_frame(dst, data)
+            return
+        pending = [n for n in vnodes if n.deadline != VTIME_NEVER]
+        if not pending:
+            return
+        node = min(pending, key=lambda n: (n.deadline, n.addr))
+        if self.args.until is not None and node.deadline > self.args.until:
+            self.finish()
+        if node.deadline > self.now:
+            self.now = node.deadline
+            self.log("advance")
+        self.wake(node)
+
+    def check_timeout(self):
+        node = self.busy
+        if node is None or time.monotonic() - node.woken < self.args.retry:
+            return
+        # the wakeup may have been lost in a race with the instance going
+        # to sleep, repeating it does no harm
+        self.send_advance(node)
+        self.stats["retries"] += 1
+
+    def finish(self):
+        print("virtual time {:.6f} s, {} wakeups, {} frames, {} retries"
+              .format(self.now / 1e6, self.stats["wakeups"],
+                      self.stats["frames"], self.stats["retries"]),
+              file=sys.stderr)
+        sys.exit(0)
+
+    def run(self):
+        start = time.monotonic()
+        try:
+            while True:
+                ready, _, _ = select.select([self.sock], [], [],
+                                            self.args.retry)
+                if ready:
+                    data, addr = self.sock.recvfrom(65536)
+                    self.handle(data, addr)
+                self.check_timeout()
+                self.schedule()
+        except KeyboardInterrupt:
+            if self.args.vtime:
+                print("{:.3f} s host time".format(time.monotonic() - start),
+                      file=sys.stderr)
+                self.finish()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("-a", "--address", default="::",
+                        help="address to bind to (default: %(default)s)")
+    parser.add_argument("-p", "--port", type=int, default=17754,
+                        help="port to bind to (default: %(default)s)")
+    parser.add_argument("--vtime", action="store_true",
+                        help="coordinate the virtual time of native_vtime "
+                             "instances")
+    parser.add_argument("-n", "--nodes", type=int, default=1,
+                        help="number of native_vtime instances to wait for "
+                             "before time starts (default: %(default)s)")
+    parser.add_argument("--until", type=float,
+                        help="stop when the virtual time would pass UNTIL "
+                             "seconds")
+    parser.add_argument("--retry", type=float, default=1.0,
+                        help="host seconds after which a wakeup is repeated "
+                             "(default: %(default)s)")
+    parser.add_argument("-v", "--verbose", action="store_true",
+                        help="log every time step")
+    args = parser.parse_args()
+    if args.until is not None:
+        args.until = int(args.until * 1e6)
+
+    info = socket.getaddrinfo(args.address, args.port,
+                              type=socket.SOCK_DGRAM)[0]
+    sock = socket.socket(info[0], socket.SOCK_DGRAM)
+    if info[0] == socket.AF_INET6:
+        sock.setsockopt(socket.IPPROTO_IPV6, socket.IPV6_V6ONLY, 0)
+    sock.bind(info[4])
+    Dispatcher(sock, args).run()
+
+
+if __name__ == "__main__":
+    main()
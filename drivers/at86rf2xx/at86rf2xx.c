@@ -93,6 +93,13 @@ void at86rf2xx_reset(at86rf2xx_t *dev)
     network_uint16_t addr_short;
 
     netdev_ieee802154_reset(&dev->netdev);
+#if IS_USED(MODULE_IEEE802154_SECURITY) && \
+    !defined(MODULE_AT86RFA1) && !defined(MODULE_AT86RFR2)
+    dev->netdev.sec_ctx.dev.cipher_ops = &at86rf2xx_cipher_ops;
+    dev->netdev.sec_ctx.dev.ctx = dev;
+    dev->aes_key = NULL;
+    dev->aes_key_loaded = false;
+#endif
 
     /* Reset state machine to ensure a known state */
     if (dev->state == AT86RF2XX_STATE_P_ON) {
@@ -191,10 +198,15 @@ size_t at86rf2xx_tx_load(at86rf2xx_t *dev, const uint8_t *data,
 
 void at86rf2xx_tx_exec(const at86rf2xx_t *dev)
 {
-    netdev_t *netdev = (netdev_t *)dev;
-
     /* write frame length field in FIFO */
     at86rf2xx_sram_write(dev, 0, &(dev->tx_frame_len), 1);
+    at86rf2xx_tx_start(dev);
+}
+
+void at86rf2xx_tx_start(const at86rf2xx_t *dev)
+{
+    netdev_t *netdev = (netdev_t *)dev;
+
     /* trigger sending of pre-loaded frame */
     at86rf2xx_reg_write(dev, AT86RF2XX_REG__TRX_STATE,
                         AT86RF2XX_TRX_STATE__TX_START);
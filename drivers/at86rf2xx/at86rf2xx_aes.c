@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_at86rf2xx
+ * @{
+ *
+ * @file
+ * @brief       Cipher operations of the IEEE 802.15.4 security sublayer on
+ *              the AES engine of the transceiver
+ *
+ * A block is written together with the request to start the engine in one
+ * SRAM access, the result is read back once the engine is done. The engine
+ * is only used in ECB mode, CBC chaining is done in software.
+ *
+ * @author      ML!PA Consulting GmbH
+ * @}
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "at86rf2xx.h"
+#include "at86rf2xx_internal.h"
+#include "at86rf2xx_registers.h"
+
+#if IS_USED(MODULE_IEEE802154_SECURITY) && \
+    !defined(MODULE_AT86RFA1) && !defined(MODULE_AT86RFR2)
+
+#define BLOCK   (IEEE802154_SEC_BLOCK_SIZE)
+
+static void _write_key(const at86rf2xx_t *dev, const uint8_t *key)
+{
+    uint8_t buf[1 + BLOCK];
+
+    buf[0] = AT86RF2XX_AES_CTRL__AES_MODE_KEY;
+    memcpy(&buf[1], key, BLOCK);
+    at86rf2xx_sram_write(dev, AT86RF2XX_SRAM__AES_CTRL, buf, sizeof(buf));
+}
+
+static uint8_t _acquire(at86rf2xx_t *dev)
+{
+    uint8_t old_state = dev->state;
+
+    if (old_state == AT86RF2XX_STATE_SLEEP) {
+        at86rf2xx_assert_awake(dev);
+    }
+    /* loaded lazily, as the key does not survive sleep */
+    if (!dev->aes_key_loaded) {
+        assert(dev->aes_key != NULL);
+        _write_key(dev, dev->aes_key);
+        dev->aes_key_loaded = true;
+    }
+    return old_state;
+}
+
+static void _release(at86rf2xx_t *dev, uint8_t old_state)
+{
+    if (old_state == AT86RF2XX_STATE_SLEEP) {
+        at86rf2xx_set_state(dev, AT86RF2XX_STATE_SLEEP);
+    }
+}
+
+static void _encrypt_block(const at86rf2xx_t *dev, uint8_t *cipher,
+                           const uint8_t *plain)
+{
+    uint8_t buf[1 + BLOCK + 1];
+    uint8_t status;
+
+    /* the write to the mirror of AES_CTRL at the end starts the engine */
+    buf[0] = AT86RF2XX_AES_CTRL__AES_MODE_ECB;
+    memcpy(&buf[1], plain, BLOCK);
+    buf[1 + BLOCK] = AT86RF2XX_AES_CTRL__AES_MODE_ECB |
+                     AT86RF2XX_AES_CTRL__AES_REQUEST;
+    at86rf2xx_sram_write(dev, AT86RF2XX_SRAM__AES_CTRL, buf, sizeof(buf));
+
+    /* a block takes 24 us */
+    do {
+        at86rf2xx_sram_read(dev, AT86RF2XX_SRAM__AES_STATUS, &status, 1);
+    } while (!(status & AT86RF2XX_AES_STATUS__AES_DONE));
+
+    at86rf2xx_sram_read(dev, AT86RF2XX_SRAM__AES_STATE, cipher, BLOCK);
+}
+
+static void _set_key(ieee802154_sec_dev_t *sec_dev, const uint8_t *key)
+{
+    at86rf2xx_t *dev = sec_dev->ctx;
+
+    /* written to the engine on the next use, saves waking up the radio */
+    dev->aes_key = key;
+    dev->aes_key_loaded = false;
+}
+
+static void _ecb(const ieee802154_sec_dev_t *sec_dev, uint8_t *cipher,
+                 const uint8_t *plain, uint8_t nblocks)
+{
+    at86rf2xx_t *dev = sec_dev->ctx;
+    uint8_t old_state = _acquire(dev);
+
+    for (unsigned i = 0; i < nblocks; i++) {
+        _encrypt_block(dev, cipher, plain);
+        plain += BLOCK;
+        cipher += BLOCK;
+    }
+    _release(dev, old_state);
+}
+
+static void _cbc(const ieee802154_sec_dev_t *sec_dev, uint8_t *cipher,
+                 const uint8_t *iv, const uint8_t *plain, uint8_t nblocks)
+{
+    at86rf2xx_t *dev = sec_dev->ctx;
+    uint8_t old_state = _acquire(dev);
+    uint8_t tmp[BLOCK];
+
+    for (unsigned i = 0; i < nblocks; i++) {
+        for (unsigned j = 0; j < BLOCK; j++) {
+            tmp[j] = plain[j] ^ iv[j];
+        }
+        _encrypt_block(dev, cipher, tmp);
+        iv = cipher;
+        plain += BLOCK;
+        cipher += BLOCK;
+    }
+    _release(dev, old_state);
+}
+
+const ieee802154_radio_cipher_ops_t at86rf2xx_cipher_ops = {
+    .set_key = _set_key,
+    .ecb = _ecb,
+    .cbc = _cbc,
+};
+
+#else
+typedef int dont_be_pedantic;
+#endif
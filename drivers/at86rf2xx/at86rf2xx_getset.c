@@ -570,6 +570,10 @@ uint8_t at86rf2xx_set_state(at86rf2xx_t *dev, uint8_t state)
             *AT86RF2XX_REG__TRXPR |= (AT86RF2XX_TRXPR_SLPTR);
 #else
             gpio_set(dev->params.sleep_pin);
+#if IS_USED(MODULE_IEEE802154_SECURITY)
+            /* the AES engine loses its key */
+            dev->aes_key_loaded = false;
+#endif
 #endif
             dev->state = state;
         }
@@ -96,6 +96,34 @@ void at86rf2xx_fb_read(const at86rf2xx_t *dev,
     spi_transfer_bytes(SPIDEV, CSPIN, true, NULL, data, len);
 }
 
+void at86rf2xx_fb_write(const at86rf2xx_t *dev, uint8_t phr,
+                        const iolist_t *iolist)
+{
+    uint8_t reg = AT86RF2XX_ACCESS_FB | AT86RF2XX_ACCESS_WRITE;
+    const iolist_t *last = NULL;
+
+    /* chip select is released after the last non-empty element */
+    for (const iolist_t *iol = iolist; iol; iol = iol->iol_next) {
+        if (iol->iol_len) {
+            last = iol;
+        }
+    }
+
+    getbus(dev);
+    spi_transfer_byte(SPIDEV, CSPIN, true, reg);
+    spi_transfer_byte(SPIDEV, CSPIN, last != NULL, phr);
+    for (const iolist_t *iol = iolist; last; iol = iol->iol_next) {
+        if (iol->iol_len) {
+            spi_transfer_bytes(SPIDEV, CSPIN, iol != last, iol->iol_base,
+                               NULL, iol->iol_len);
+        }
+        if (iol == last) {
+            break;
+        }
+    }
+    spi_release(SPIDEV);
+}
+
 void at86rf2xx_fb_stop(const at86rf2xx_t *dev)
 {
     /* transfer one byte (which we ignore) to release the chip select */
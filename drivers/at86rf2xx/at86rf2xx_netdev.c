@@ -112,26 +112,24 @@ static int _init(netdev_t *netdev)
 static int _send(netdev_t *netdev, const iolist_t *iolist)
 {
     at86rf2xx_t *dev = (at86rf2xx_t *)netdev;
-    size_t len = 0;
+    size_t len = iolist_size(iolist);
+
+    /* packet data + FCS too long */
+    if ((len + IEEE802154_FCS_LEN) > AT86RF2XX_MAX_PKT_LENGTH) {
+        DEBUG("[at86rf2xx] error: packet too large (%u byte) to be send\n",
+              (unsigned)len + IEEE802154_FCS_LEN);
+        return -EOVERFLOW;
+    }
 
     at86rf2xx_tx_prepare(dev);
 
-    /* load packet data into FIFO */
-    for (const iolist_t *iol = iolist; iol; iol = iol->iol_next) {
-        /* current packet data + FCS too long */
-        if ((len + iol->iol_len + 2) > AT86RF2XX_MAX_PKT_LENGTH) {
-            DEBUG("[at86rf2xx] error: packet too large (%u byte) to be send\n",
-                  (unsigned)len + 2);
-            return -EOVERFLOW;
-        }
-        if (iol->iol_len) {
-            len = at86rf2xx_tx_load(dev, iol->iol_base, iol->iol_len, len);
-        }
-    }
+    /* load PHR and packet data into FIFO at once */
+    dev->tx_frame_len += (uint8_t)len;
+    at86rf2xx_fb_write(dev, dev->tx_frame_len, iolist);
 
     /* send data out directly if pre-loading id disabled */
     if (!(dev->flags & AT86RF2XX_OPT_PRELOADING)) {
-        at86rf2xx_tx_exec(dev);
+        at86rf2xx_tx_start(dev);
     }
     /* return the number of bytes that were actually loaded into the frame
      * buffer/send out */
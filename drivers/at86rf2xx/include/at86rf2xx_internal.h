@@ -27,6 +27,7 @@
 #include <stdint.h>
 
 #include "at86rf2xx.h"
+#include "iolist.h"
 
 #if defined(MODULE_AT86RFA1) || defined(MODULE_AT86RFR2)
 #include <string.h>
@@ -194,6 +195,40 @@ static inline void at86rf2xx_fb_stop(const at86rf2xx_t *dev) {
 #else
 void at86rf2xx_fb_stop(const at86rf2xx_t *dev);
 #endif
+/**
+ * @brief   Write a frame to the internal frame buffer of the given device
+ *
+ * The PHR and all elements of @p iolist are written in a single frame buffer
+ * transaction, i.e. with the chip select asserted only once.
+ *
+ * @param[in]  dev      device to write to
+ * @param[in]  phr      PHR, i.e. the length of the frame including the FCS
+ * @param[in]  iolist   PSDU without the FCS
+ */
+#if defined(MODULE_AT86RFA1) || defined(MODULE_AT86RFR2)
+static inline void at86rf2xx_fb_write(const at86rf2xx_t *dev, uint8_t phr,
+                                      const iolist_t *iolist) {
+    uint8_t *fb = (uint8_t *)AT86RF2XX_REG__TRXFBST;
+
+    (void)dev;
+    *fb++ = phr;
+    for (; iolist; iolist = iolist->iol_next) {
+        memcpy(fb, iolist->iol_base, iolist->iol_len);
+        fb += iolist->iol_len;
+    }
+}
+#else
+void at86rf2xx_fb_write(const at86rf2xx_t *dev, uint8_t phr,
+                        const iolist_t *iolist);
+#endif
+/**
+ * @brief   Start the transmission of the frame in the frame buffer
+ *
+ * Unlike @ref at86rf2xx_tx_exec(), the PHR is not written.
+ *
+ * @param[in]  dev      device to trigger
+ */
+void at86rf2xx_tx_start(const at86rf2xx_t *dev);
 /**
  * @brief   Convenience function for reading the status of the given device
  *
@@ -203,6 +238,15 @@ void at86rf2xx_fb_stop(const at86rf2xx_t *dev);
  */
 uint8_t at86rf2xx_get_status(const at86rf2xx_t *dev);
 
+#if IS_USED(MODULE_IEEE802154_SECURITY) || defined(DOXYGEN)
+/**
+ * @brief   Cipher operations on the AES engine of the transceiver
+ *
+ * Only available on the SPI based transceivers.
+ */
+extern const ieee802154_radio_cipher_ops_t at86rf2xx_cipher_ops;
+#endif
+
 /**
  * @brief   Make sure that device is not sleeping
  *
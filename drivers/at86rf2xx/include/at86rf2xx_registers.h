@@ -319,6 +319,35 @@ extern "C" {
 #define AT86RF2XX_IRQ_STATUS_MASK__PLL_LOCK                     (0x01)
 /** @} */
 
+/**
+ * @name    SRAM addresses of the AES engine
+ * @{
+ */
+#define AT86RF2XX_SRAM__AES_STATUS                              (0x82)
+#define AT86RF2XX_SRAM__AES_CTRL                                (0x83)
+#define AT86RF2XX_SRAM__AES_STATE                               (0x84)
+#define AT86RF2XX_SRAM__AES_CTRL_MIRROR                         (0x94)
+/** @} */
+
+/**
+ * @name    Bitfield definitions for the AES_CTRL register
+ * @{
+ */
+#define AT86RF2XX_AES_CTRL__AES_REQUEST                         (0x80)
+#define AT86RF2XX_AES_CTRL__AES_MODE_ECB                        (0x00)
+#define AT86RF2XX_AES_CTRL__AES_MODE_KEY                        (0x10)
+#define AT86RF2XX_AES_CTRL__AES_MODE_CBC                        (0x20)
+#define AT86RF2XX_AES_CTRL__AES_DIR                             (0x08)
+/** @} */
+
+/**
+ * @name    Bitfield definitions for the AES_STATUS register
+ * @{
+ */
+#define AT86RF2XX_AES_STATUS__AES_ER                            (0x80)
+#define AT86RF2XX_AES_STATUS__AES_DONE                          (0x01)
+/** @} */
+
 #endif /* END external spi transceiver */
 /**
  * @name    Bitfield definitions for the TRX_STATUS register
@@ -33,6 +33,23 @@ void disp_dev_map(const disp_dev_t *dev,
     dev->driver->map(dev, x1, x2, y1, y2, color);
 }
 
+void disp_dev_map_async(const disp_dev_t *dev,
+                        uint16_t x1, uint16_t x2, uint16_t y1, uint16_t y2,
+                        const uint16_t *color, disp_dev_done_cb_t cb, void *arg)
+{
+    assert(dev);
+
+    if (dev->driver->map_async) {
+        dev->driver->map_async(dev, x1, x2, y1, y2, color, cb, arg);
+        return;
+    }
+
+    dev->driver->map(dev, x1, x2, y1, y2, color);
+    if (cb) {
+        cb(arg);
+    }
+}
+
 uint16_t disp_dev_height(const disp_dev_t *dev)
 {
     assert(dev);
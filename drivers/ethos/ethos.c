@@ -20,6 +20,7 @@
 
 #include <assert.h>
 #include <errno.h>
+#include <stdint.h>
 #include <string.h>
 
 #include "ethos.h"
@@ -50,8 +51,49 @@ static void _get_mac_addr(netdev_t *dev, uint8_t* buf);
 static void ethos_isr(void *arg, uint8_t c);
 static const netdev_driver_t netdev_driver_ethos;
 
-static const uint8_t _esc_esc[] = {ETHOS_ESC_CHAR, (ETHOS_ESC_CHAR ^ 0x20)};
-static const uint8_t _esc_delim[] = {ETHOS_ESC_CHAR, (ETHOS_FRAME_DELIMITER ^ 0x20)};
+#ifdef MODULE_PERIPH_UART_DMA
+static void _rx_chunk(void *arg, const uint8_t *data, size_t len);
+#endif
+
+#define WORD_ONES   (0x01010101UL)
+#define WORD_HIGHS  (0x80808080UL)
+
+static inline bool _word_has(uint32_t word, uint8_t c)
+{
+    word ^= WORD_ONES * c;
+    return ((word - WORD_ONES) & ~word & WORD_HIGHS) != 0;
+}
+
+static inline bool _is_special(uint8_t c)
+{
+    return (c == ETHOS_FRAME_DELIMITER) || (c == ETHOS_ESC_CHAR);
+}
+
+/* number of leading bytes that need no escaping, checks a word at a time */
+static size_t _plain_run(const uint8_t *data, size_t len)
+{
+    size_t i = 0;
+
+    while ((i < len) && ((uintptr_t)&data[i] & (sizeof(uint32_t) - 1))) {
+        if (_is_special(data[i])) {
+            return i;
+        }
+        i++;
+    }
+    for (; (i + sizeof(uint32_t)) <= len; i += sizeof(uint32_t)) {
+        uint32_t word;
+
+        memcpy(&word, &data[i], sizeof(word));
+        if (_word_has(word, ETHOS_FRAME_DELIMITER) ||
+            _word_has(word, ETHOS_ESC_CHAR)) {
+            break;
+        }
+    }
+    while ((i < len) && !_is_special(data[i])) {
+        i++;
+    }
+    return i;
+}
 
 
 void ethos_setup(ethos_t *dev, const ethos_params_t *params)
@@ -69,7 +111,15 @@ void ethos_setup(ethos_t *dev, const ethos_params_t *params)
 
     luid_get_eui48((eui48_t *) &dev->mac_addr);
 
-    uart_init(params->uart, params->baudrate, ethos_isr, (void*)dev);
+#ifdef MODULE_PERIPH_UART_DMA
+    /* prefer chunked DMA reception, fall back to per byte interrupts */
+    if ((uart_init(params->uart, params->baudrate, NULL, NULL) != UART_OK) ||
+        (uart_rx_dma_start(params->uart, dev->rx_dma_buf,
+                           sizeof(dev->rx_dma_buf), _rx_chunk, dev) != UART_OK))
+#endif
+    {
+        uart_init(params->uart, params->baudrate, ethos_isr, (void*)dev);
+    }
 
     uint8_t frame_delim = ETHOS_FRAME_DELIMITER;
     uart_write(dev->uart, &frame_delim, 1);
@@ -110,6 +160,28 @@ static void _handle_char(ethos_t *dev, char c)
     }
 }
 
+/* like _handle_char() for a run of bytes without special chars */
+static void _handle_run(ethos_t *dev, const uint8_t *data, size_t len)
+{
+    switch (dev->frametype) {
+        case ETHOS_FRAME_TYPE_DATA:
+        case ETHOS_FRAME_TYPE_HELLO:
+        case ETHOS_FRAME_TYPE_HELLO_REPLY:
+            if (dev->accept_new) {
+                dev->framesize += tsrb_add(&dev->inbuf, data, len);
+            }
+            else {
+                _handle_char(dev, *data);
+            }
+            break;
+#ifdef MODULE_STDIO_ETHOS
+        case ETHOS_FRAME_TYPE_TEXT:
+            dev->framesize += len;
+            isrpipe_write(&stdio_uart_isrpipe, data, len);
+#endif
+    }
+}
+
 static void _end_of_frame(ethos_t *dev)
 {
     switch(dev->frametype) {
@@ -184,6 +256,37 @@ static void ethos_isr(void *arg, uint8_t c)
     }
 }
 
+#ifdef MODULE_PERIPH_UART_DMA
+static void _rx_chunk(void *arg, const uint8_t *data, size_t len)
+{
+    ethos_t *dev = (ethos_t *) arg;
+
+    while (len) {
+        size_t run = 1;
+
+        if (dev->state == WAIT_FRAMESTART) {
+            /* skip to the next frame */
+            const uint8_t *start = memchr(data, ETHOS_FRAME_DELIMITER, len);
+            if (start == NULL) {
+                return;
+            }
+            run = start - data + 1;
+            ethos_isr(dev, *start);
+        }
+        else if ((dev->state == IN_FRAME) && (run = _plain_run(data, len))) {
+            /* frame content without escapes is passed on in one go */
+            _handle_run(dev, data, run);
+        }
+        else {
+            run = 1;
+            ethos_isr(dev, *data);
+        }
+        data += run;
+        len -= run;
+    }
+}
+#endif
+
 static void _isr(netdev_t *netdev)
 {
     ethos_t *dev = (ethos_t *) netdev;
@@ -206,26 +309,23 @@ static size_t iolist_count_total(const iolist_t *iolist)
     return result;
 }
 
-static void _write_escaped(uart_t uart, uint8_t c)
+static void _write_escaped(uart_t uart, const uint8_t *data, size_t len)
 {
-    const uint8_t *out;
-    int n;
+    while (len) {
+        /* bytes that need no escaping are written in one go */
+        size_t run = _plain_run(data, len);
 
-    switch(c) {
-        case ETHOS_FRAME_DELIMITER:
-            out = _esc_delim;
-            n = 2;
-            break;
-        case ETHOS_ESC_CHAR:
-            out = _esc_esc;
-            n = 2;
+        if (run) {
+            uart_write(uart, data, run);
+        }
+        if (run == len) {
             break;
-        default:
-            out = &c;
-            n = 1;
+        }
+        uint8_t esc[2] = { ETHOS_ESC_CHAR, (data[run] ^ 0x20) };
+        uart_write(uart, esc, sizeof(esc));
+        data += run + 1;
+        len -= run + 1;
     }
-
-    uart_write(uart, out, n);
 }
 
 void ethos_send_frame(ethos_t *dev, const uint8_t *data, size_t len, unsigned frame_type)
@@ -251,9 +351,7 @@ void ethos_send_frame(ethos_t *dev, const uint8_t *data, size_t len, unsigned fr
     }
 
     /* send frame content */
-    while(len--) {
-        _write_escaped(dev->uart, *data++);
-    }
+    _write_escaped(dev->uart, data, len);
 
     /* end of frame */
     uart_write(dev->uart, &frame_delim, 1);
@@ -280,11 +378,7 @@ static int _send(netdev_t *netdev, const iolist_t *iolist)
 
     /* send iolist */
     for (const iolist_t *iol = iolist; iol; iol = iol->iol_next) {
-        size_t n = iol->iol_len;
-        uint8_t *ptr = iol->iol_base;
-        while(n--) {
-            _write_escaped(dev->uart, *ptr++);
-        }
+        _write_escaped(dev->uart, iol->iol_base, iol->iol_len);
     }
 
     uart_write(dev->uart, &frame_delim, 1);
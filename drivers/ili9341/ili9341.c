@@ -21,6 +21,7 @@
 #include <assert.h>
 #include <string.h>
 #include "byteorder.h"
+#include "event/thread.h"
 #include "periph/spi.h"
 #include "xtimer.h"
 #include "ili9341.h"
@@ -295,6 +296,95 @@ void ili9341_pixmap(const ili9341_t *dev, uint16_t x1, uint16_t x2,
     spi_release(dev->params->spi);
 }
 
+#if ILI9341_LE_MODE
+static bool _queue_le_chunk(ili9341_t *dev)
+{
+    size_t num = dev->remaining;
+
+    if (num == 0) {
+        return false;
+    }
+    if (num > ILI9341_LE_CHUNK) {
+        num = ILI9341_LE_CHUNK;
+    }
+    for (size_t i = 0; i < num; i++) {
+        dev->chunk[i] = htons(dev->pos[i]);
+    }
+    dev->pos += num;
+    dev->remaining -= num;
+
+    dev->xfer.out = dev->chunk;
+    dev->xfer.len = num * sizeof(uint16_t);
+    dev->xfer.cont = (dev->remaining != 0);
+    spi_transfer_async(dev->params->spi, &dev->xfer);
+
+    return true;
+}
+#endif
+
+static void _pixmap_release(event_t *event)
+{
+    ili9341_t *dev = container_of(event, ili9341_t, release);
+
+    spi_release(dev->params->spi);
+    if (dev->done_cb) {
+        dev->done_cb(dev->done_arg);
+    }
+}
+
+static void _pixmap_done(void *arg)
+{
+    ili9341_t *dev = arg;
+
+#if ILI9341_LE_MODE
+    if (_queue_le_chunk(dev)) {
+        return;
+    }
+#endif
+
+    /* this may run in interrupt context, the bus must be released from a
+     * thread */
+    event_post(EVENT_PRIO_HIGHEST, &dev->release);
+}
+
+void ili9341_pixmap_async(ili9341_t *dev, uint16_t x1, uint16_t x2,
+                          uint16_t y1, uint16_t y2, const uint16_t *color,
+                          spi_async_cb_t cb, void *arg)
+{
+    size_t num_pix = (x2 - x1 + 1) * (y2 - y1 + 1);
+
+    DEBUG("[ili9341]: Write async x1: %" PRIu16 ", x2: %" PRIu16 ", "
+          "y1: %" PRIu16 ", y2: %" PRIu16 ". Num pixels: %lu\n",
+          x1, x2, y1, y2, (unsigned long)num_pix);
+
+    _ili9341_spi_acquire(dev);
+
+    /* Send fill area to the display */
+    _ili9341_set_area(dev, x1, x2, y1, y2);
+
+    /* Memory access command */
+    _ili9341_cmd_start(dev, ILI9341_CMD_RAMWR, true);
+
+    dev->done_cb = cb;
+    dev->done_arg = arg;
+    dev->release.handler = _pixmap_release;
+    dev->xfer.in = NULL;
+    dev->xfer.cs = dev->params->cs_pin;
+    dev->xfer.cb = _pixmap_done;
+    dev->xfer.arg = dev;
+
+#if ILI9341_LE_MODE
+    dev->pos = color;
+    dev->remaining = num_pix;
+    _queue_le_chunk(dev);
+#else
+    dev->xfer.out = color;
+    dev->xfer.len = num_pix * sizeof(uint16_t);
+    dev->xfer.cont = false;
+    spi_transfer_async(dev->params->spi, &dev->xfer);
+#endif
+}
+
 void ili9341_invert_on(const ili9341_t *dev)
 {
     uint8_t command = (dev->params->inverted) ? ILI9341_CMD_DINVOFF
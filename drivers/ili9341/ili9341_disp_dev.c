@@ -38,6 +38,14 @@ static void _ili9341_map(const disp_dev_t *dev, uint16_t x1, uint16_t x2,
     ili9341_pixmap(ili9341, x1, x2, y1, y2, color);
 }
 
+static void _ili9341_map_async(const disp_dev_t *dev, uint16_t x1, uint16_t x2,
+                               uint16_t y1, uint16_t y2, const uint16_t *color,
+                               disp_dev_done_cb_t cb, void *arg)
+{
+    ili9341_t *ili9341 = (ili9341_t *)dev;
+    ili9341_pixmap_async(ili9341, x1, x2, y1, y2, color, cb, arg);
+}
+
 static uint16_t _ili9341_height(const disp_dev_t *disp_dev)
 {
     (void)disp_dev;
@@ -78,4 +86,5 @@ const disp_dev_driver_t ili9341_disp_dev_driver = {
     .width          = _ili9341_width,
     .color_depth    = _ili9341_color_depth,
     .set_invert     = _ili9341_set_invert,
+    .map_async      = _ili9341_map_async,
 };
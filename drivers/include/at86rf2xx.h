@@ -285,6 +285,12 @@ typedef struct {
 #if AT86RF2XX_HAVE_RETRIES
     /* Only radios with the XAH_CTRL_2 register support frame retry reporting */
     uint8_t tx_retries;                 /**< Number of NOACK retransmissions */
+#endif
+#if IS_USED(MODULE_IEEE802154_SECURITY) && \
+    !defined(MODULE_AT86RFA1) && !defined(MODULE_AT86RFR2)
+    const uint8_t *aes_key;             /**< key of the AES engine */
+    bool aes_key_loaded;                /**< at86rf2xx_t::aes_key is loaded,
+                                             the radio loses it in sleep */
 #endif
     /** @} */
 } at86rf2xx_t;
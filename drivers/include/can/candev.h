@@ -80,6 +80,9 @@ struct candev {
     candev_event_cb_t event_callback;      /**< callback for device events */
     void *isr_arg;                         /**< argument to pass on isr event */
     struct can_bittiming bittiming;        /**< device bittimings */
+#if defined(MODULE_CAN_FD) || defined(DOXYGEN)
+    struct can_bittiming data_bittiming;   /**< CAN FD data phase bittimings */
+#endif
     enum can_state state;                  /**< device state */
 };
 
@@ -90,6 +93,9 @@ typedef struct candev_driver {
     /**
      * @brief Send packet
      *
+     * @p frame is a struct canfd_frame if @ref can_frame_is_fd() is true,
+     * drivers without CAN FD support return -ENOTSUP then.
+     *
      * @param[in] dev       CAN device descriptor
      * @param[in] frame     CAN frame to send
      *
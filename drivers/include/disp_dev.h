@@ -42,6 +42,14 @@ extern "C" {
  */
 typedef struct disp_dev disp_dev_t;
 
+/**
+ * @brief   Signature of the callback invoked when an asynchronous area write
+ *          is done
+ *
+ * @param[in] arg   argument given with the write
+ */
+typedef void (*disp_dev_done_cb_t)(void *arg);
+
 /**
  * @brief   Generic type for a display driver
  */
@@ -92,6 +100,26 @@ typedef struct {
      * @param[in] invert    Invert mode (true if invert, false otherwise)
      */
     void (*set_invert)(const disp_dev_t *dev, bool invert);
+
+    /**
+     * @brief   Start mapping an area to display on the device (optional)
+     *
+     * Returns once the transfer was started, @p cb is invoked when the
+     * @p color buffer is no longer used. Drivers that can not write
+     * asynchronously leave this NULL.
+     *
+     * @param[in] dev   Pointer to the display device
+     * @param[in] x1    Left coordinate
+     * @param[in] x2    Right coordinate
+     * @param[in] y1    Top coordinate
+     * @param[in] y2    Bottom coordinate
+     * @param[in] color Array of color to map to the display
+     * @param[in] cb    Callback invoked when done, may run in interrupt context
+     * @param[in] arg   Argument passed to @p cb
+     */
+    void (*map_async)(const disp_dev_t *dev,
+                      uint16_t x1, uint16_t x2, uint16_t y1, uint16_t y2,
+                      const uint16_t *color, disp_dev_done_cb_t cb, void *arg);
 } disp_dev_driver_t;
 
 /**
@@ -115,6 +143,26 @@ void disp_dev_map(const disp_dev_t *dev,
                   uint16_t x1, uint16_t x2, uint16_t y1, uint16_t y2,
                   const uint16_t *color);
 
+/**
+ * @brief   Start mapping an area to display on the device
+ *
+ * The @p color buffer must stay untouched until @p cb was invoked, which
+ * may happen from interrupt context. Drivers without asynchronous support
+ * map the area blocking and invoke @p cb before returning.
+ *
+ * @param[in] dev   Pointer to the display device
+ * @param[in] x1    Left coordinate
+ * @param[in] x2    Right coordinate
+ * @param[in] y1    Top coordinate
+ * @param[in] y2    Bottom coordinate
+ * @param[in] color Array of color to map to the display
+ * @param[in] cb    Callback invoked when done
+ * @param[in] arg   Argument passed to @p cb
+ */
+void disp_dev_map_async(const disp_dev_t *dev,
+                        uint16_t x1, uint16_t x2, uint16_t y1, uint16_t y2,
+                        const uint16_t *color, disp_dev_done_cb_t cb, void *arg);
+
 /**
  * @brief   Get the height of the display device
  *
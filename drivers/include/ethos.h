@@ -58,6 +58,16 @@ extern "C" {
 /** @} */
 #endif
 
+/**
+ * @brief   Size of the circular buffer used for DMA reception
+ *
+ * Only used with the `periph_uart_dma` feature. The data is decoded each
+ * time half of the buffer was filled or the line becomes idle.
+ */
+#ifndef CONFIG_ETHOS_RX_DMA_BUFSIZE
+#define CONFIG_ETHOS_RX_DMA_BUFSIZE     (64U)
+#endif
+
 /**
  * @name    Escape char definitions
  * @{
@@ -95,6 +105,9 @@ typedef struct {
     size_t last_framesize;  /**< size of last completed frame */
     mutex_t out_mutex;      /**< mutex used for locking concurrent sends */
     bool accept_new;        /**< incoming frame can be stored or not */
+#if defined(MODULE_PERIPH_UART_DMA) || DOXYGEN
+    uint8_t rx_dma_buf[CONFIG_ETHOS_RX_DMA_BUFSIZE]; /**< DMA RX buffer */
+#endif
 } ethos_t;
 
 /**
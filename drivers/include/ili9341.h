@@ -33,6 +33,7 @@
 #ifndef ILI9341_H
 #define ILI9341_H
 
+#include "event.h"
 #include "periph/spi.h"
 #include "periph/gpio.h"
 
@@ -85,6 +86,14 @@ extern "C" {
 #ifndef ILI9341_LE_MODE
 #define ILI9341_LE_MODE     (0)
 #endif
+
+/**
+ * @brief Number of pixels converted at once by @ref ili9341_pixmap_async
+ *        with @ref ILI9341_LE_MODE
+ */
+#ifndef ILI9341_LE_CHUNK
+#define ILI9341_LE_CHUNK    (32U)
+#endif
 /** @} */
 
 /**
@@ -111,6 +120,15 @@ typedef struct {
     disp_dev_t *dev;                    /**< Pointer to the generic display device */
 #endif
     const ili9341_params_t *params;     /**< Device initialization parameters */
+    spi_async_xfer_t xfer;              /**< pixel data transfer */
+    spi_async_cb_t done_cb;             /**< callback of the running pixmap */
+    void *done_arg;                     /**< argument passed to done_cb */
+    event_t release;                    /**< releases the bus in thread context */
+#if ILI9341_LE_MODE || defined(DOXYGEN)
+    const uint16_t *pos;                /**< next pixel to convert */
+    size_t remaining;                   /**< pixels left to convert */
+    uint16_t chunk[ILI9341_LE_CHUNK];   /**< converted pixels */
+#endif
 } ili9341_t;
 
 
@@ -158,6 +176,32 @@ void ili9341_fill(const ili9341_t *dev, uint16_t x1, uint16_t x2,
 void ili9341_pixmap(const ili9341_t *dev, uint16_t x1, uint16_t x2, uint16_t y1,
                  uint16_t y2, const uint16_t *color);
 
+/**
+ * @brief   Start filling a rectangular area with an array of pixels
+ *
+ * Same as @ref ili9341_pixmap, but the pixel data is sent using
+ * @ref spi_transfer_async, so DMA capable buses transfer it without keeping
+ * the CPU busy. Only the area setup is done blocking. With
+ * @ref ILI9341_LE_MODE the colors are converted chunk by chunk when the next
+ * transfer is set up. Once the last transfer is done, the bus is released and
+ * @p cb is invoked from the highest priority event thread.
+ *
+ * @note @p color must have a length equal to `(x2 - x1 + 1) * (y2 - y1 + 1)`
+ *       and must stay untouched until @p cb was invoked
+ *
+ * @param[in]   dev     device descriptor
+ * @param[in]   x1      x coordinate of the first corner
+ * @param[in]   x2      x coordinate of the opposite corner
+ * @param[in]   y1      y coordinate of the first corner
+ * @param[in]   y2      y coordinate of the opposite corner
+ * @param[in]   color   array of colors to fill the area with
+ * @param[in]   cb      invoked when done, runs in thread context
+ * @param[in]   arg     argument passed to @p cb
+ */
+void ili9341_pixmap_async(ili9341_t *dev, uint16_t x1, uint16_t x2,
+                          uint16_t y1, uint16_t y2, const uint16_t *color,
+                          spi_async_cb_t cb, void *arg);
+
 /**
  * @brief   Raw write command
  *
@@ -16,8 +16,9 @@
  * now, it only provides very basic access to the device. The driver configures
  * the device to continuously read the acceleration data with statically
  * defined scale and rate, and with a fixed 10-bit resolution. The LIS2DH12's
- * FIFO is bypassed, so the driver might not be sufficient for use cases where
- * the complete history of readings is of interest.
+ * FIFO is bypassed by default. Where the complete history of readings is of
+ * interest, it is enabled with lis2dh12_set_fifo() and read out with
+ * lis2dh12_read_fifo(), with module `saul_batch` also through SAUL.
  *
  * Also, the current version of the driver supports only interfacing the sensor
  * via SPI. The driver is however written in a way, that adding I2C interface
@@ -111,6 +112,11 @@ typedef struct {
     uint16_t comp;                  /**< scale compensation factor */
 } lis2dh12_t;
 
+/**
+ * @brief   Number of samples the FIFO holds
+ */
+#define LIS2DH12_FIFO_SIZE          (32U)
+
 /**
  * @brief   Status and error return codes
  */
@@ -231,6 +237,18 @@ int lis2dh12_set_int(const lis2dh12_t *dev, const lis2dh12_int_params_t *params,
  * @return  LIS2DH12_NOBUS on bus errors
  */
 int lis2dh12_read_int_src(const lis2dh12_t *dev, uint8_t *data, uint8_t int_line);
+
+/**
+ * @brief   Set the callback of the FIFO watermark interrupt on INT1
+ *
+ * @param[in] dev      device descriptor
+ * @param[in] cb       callback, NULL to disable the interrupt
+ * @param[in] arg      argument of @p cb
+ *
+ * @return  LIS2DH12_OK on success
+ * @return  LIS2DH12_NOINT if INT1 could not be initialized
+ */
+int lis2dh12_set_fifo_int(const lis2dh12_t *dev, gpio_cb_t cb, void *arg);
 #endif /* MODULE_LIS2DH12_INT */
 
 /**
@@ -256,6 +274,44 @@ int lis2dh12_init(lis2dh12_t *dev, const lis2dh12_params_t *params);
  */
 int lis2dh12_read(const lis2dh12_t *dev, int16_t *data);
 
+/**
+ * @brief   Enable or disable the FIFO of the given device
+ *
+ * With the FIFO enabled, the device buffers up to @ref LIS2DH12_FIFO_SIZE
+ * samples, dropping the oldest one on overflow. lis2dh12_read() then returns
+ * the oldest sample buffered.
+ *
+ * @param[in] dev       device descriptor
+ * @param[in] watermark number of samples [1-31] above which the watermark
+ *                      interrupt triggers, 0 to disable the FIFO
+ *
+ * @return  LIS2DH12_OK on success
+ * @return  LIS2DH12_NOBUS on bus error
+ */
+int lis2dh12_set_fifo(const lis2dh12_t *dev, uint8_t watermark);
+
+/**
+ * @brief   Read the samples buffered in the FIFO in a single transfer
+ *
+ * @param[in]  dev      device descriptor
+ * @param[out] data     acceleration data in mili-g, oldest first
+ * @param[in]  numof    maximum number of samples to read
+ *
+ * @return  number of samples read
+ * @return  LIS2DH12_NOBUS on bus error
+ */
+int lis2dh12_read_fifo(const lis2dh12_t *dev, int16_t (*data)[3],
+                       unsigned numof);
+
+/**
+ * @brief   Get the sampling period of the given device
+ *
+ * @param[in] dev       device descriptor
+ *
+ * @return  time between two samples in µs
+ */
+uint32_t lis2dh12_period_us(const lis2dh12_t *dev);
+
 /**
  * @brief   Power on the given device
  *
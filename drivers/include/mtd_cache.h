@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_mtd_cache  MTD page cache
+ * @ingroup     drivers_storage
+ * @brief       Page cache and write-back buffer for MTD devices
+ *
+ * This MTD module is stacked on top of another MTD device and keeps a small
+ * number of its pages in RAM. File systems that issue many small reads and
+ * partial page writes then hit the RAM copy instead of issuing a full bus
+ * command sequence to the backing device for every access.
+ *
+ * - cached pages are replaced in least recently used order
+ * - a read miss that directly follows the previous page also loads the next
+ *   page (read-ahead), see @ref CONFIG_MTD_CACHE_READAHEAD
+ * - writes only modify the cached page, which is written back when it gets
+ *   evicted, erased, on @ref mtd_cache_flush or when the device is powered
+ *   down
+ *
+ * ## Usage
+ *
+ * To use this module include it in your makefile:
+ *
+ * ```
+ * USEMODULE += mtd_cache
+ * ```
+ *
+ * The cache needs one buffer of `page_size` bytes and one entry for every
+ * cached page:
+ *
+ * ```
+ * static uint8_t cache_buf[4 * PAGE_SIZE];
+ * static mtd_cache_entry_t cache_entries[4];
+ *
+ * mtd_cache_t cache = MTD_CACHE_INIT(MTD_0, cache_buf, cache_entries, 4);
+ *
+ * mtd_dev_t *dev = &cache.mtd;
+ * ```
+ * The geometry of the cache device is copied from the backing device on
+ * init.
+ *
+ * @warning As pages are only written back lazily, call @ref mtd_cache_flush
+ *          before the backing device is accessed directly or the system
+ *          goes down.
+ *
+ * @{
+ *
+ * @brief       Interface definitions for the MTD page cache
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+
+#ifndef MTD_CACHE_H
+#define MTD_CACHE_H
+
+#include <stdint.h>
+#include "mtd.h"
+#include "mutex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Load the next page on sequential read misses
+ */
+#ifndef CONFIG_MTD_CACHE_READAHEAD
+#define CONFIG_MTD_CACHE_READAHEAD  1
+#endif
+
+/**
+ * @brief Shortcut macro for initializing the members of an
+ *        @ref mtd_cache_t struct
+ */
+#define MTD_CACHE_INIT(_parent, _buf, _entries, _numof) \
+{ \
+    .mtd = { .driver = &mtd_cache_driver }, \
+    .parent = _parent, \
+    .lock = MUTEX_INIT, \
+    .buf = _buf, \
+    .entries = _entries, \
+    .numof = _numof, \
+}
+
+/**
+ * @brief Cache entry describing one buffered page
+ */
+typedef struct {
+    uint32_t page;      /**< page number on the backing device */
+    uint32_t used;      /**< time stamp of the last access, for LRU */
+    uint8_t flags;      /**< valid / dirty flags */
+} mtd_cache_entry_t;
+
+/**
+ * @brief Cache statistics
+ */
+typedef struct {
+    uint32_t hits;          /**< accesses served from the cache */
+    uint32_t misses;        /**< accesses that had to load a page */
+    uint32_t readaheads;    /**< pages loaded ahead of time */
+    uint32_t writebacks;    /**< dirty pages written to the backing device */
+} mtd_cache_stats_t;
+
+/**
+ * @brief MTD cache device
+ */
+typedef struct {
+    mtd_dev_t mtd;                  /**< MTD context */
+    mtd_dev_t *parent;              /**< backing MTD device */
+    mutex_t lock;                   /**< guards the cache state */
+    uint8_t *buf;                   /**< page buffers, numof * page_size bytes */
+    mtd_cache_entry_t *entries;     /**< one entry per page buffer */
+    uint8_t numof;                  /**< number of page buffers */
+    uint32_t clock;                 /**< access counter for LRU */
+    uint32_t last_page;             /**< last page loaded on a read miss */
+    mtd_cache_stats_t stats;        /**< hit / miss statistics */
+} mtd_cache_t;
+
+/**
+ * @brief Cache MTD device operations table
+ */
+extern const mtd_desc_t mtd_cache_driver;
+
+/**
+ * @brief   Write all dirty pages back to the backing device
+ *
+ * @param[in] cache     cache device
+ *
+ * @return 0 on success
+ * @return < 0 error of the backing device
+ */
+int mtd_cache_flush(mtd_cache_t *cache);
+
+/**
+ * @brief   Read and reset the statistics of a cache
+ *
+ * @param[in]  cache    cache device
+ * @param[out] stats    statistics since the last call
+ */
+void mtd_cache_stats_get(mtd_cache_t *cache, mtd_cache_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MTD_CACHE_H */
+/** @} */
@@ -24,12 +24,20 @@
 #ifndef MTD_SPI_NOR_H
 #define MTD_SPI_NOR_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "periph_conf.h"
 #include "periph/spi.h"
 #include "periph/gpio.h"
+#ifdef MODULE_PERIPH_QSPI
+#include "periph/qspi.h"
+#endif
 #include "mtd.h"
+#ifdef MODULE_MTD_SPI_NOR_ERASE_AHEAD
+#include "event/timeout.h"
+#include "mutex.h"
+#endif
 
 #ifdef __cplusplus
 extern "C"
@@ -46,7 +54,9 @@ typedef struct {
     uint8_t wrsr;            /**< Write status register */
     uint8_t read;            /**< Read data bytes, 3 byte address */
     uint8_t read_fast;       /**< Read data bytes, 3 byte address, at higher speed */
+    uint8_t read_quad;       /**< Read data bytes over four data lines (QSPI only) */
     uint8_t page_program;    /**< Page program */
+    uint8_t page_program_quad; /**< Page program over four data lines (QSPI only) */
     uint8_t sector_erase;    /**< Block erase 4 KiB */
     uint8_t block_erase_32k; /**< 32KiB block erase */
     uint8_t block_erase;     /**< Block erase (usually 64 KiB) */
@@ -82,6 +92,16 @@ typedef struct __attribute__((packed)) {
  * @brief   Flag to set when the device support 32KiB block erase (block_erase_32k opcode)
  */
 #define SPI_NOR_F_SECT_32K  (2)
+/**
+ * @brief   Flag to set when the device is attached to a QSPI bus
+ *          (qspi member of the params)
+ */
+#define SPI_NOR_F_QSPI      (4)
+/**
+ * @brief   Flag to set when quad mode has to be enabled by the QE bit in
+ *          bit 6 of the status register (e.g. Macronix, ISSI)
+ */
+#define SPI_NOR_F_QE_SR_BIT6    (8)
 
 /**
  * @brief Compile-time parameters for a serial flash device
@@ -99,6 +119,10 @@ typedef struct {
     spi_mode_t mode;         /**< SPI mode */
     gpio_t cs;               /**< CS pin GPIO handle */
     uint8_t addr_width;      /**< Number of bytes in addresses, usually 3 for small devices */
+#if defined(MODULE_PERIPH_QSPI) || defined(DOXYGEN)
+    qspi_t qspi;             /**< QSPI bus, used if @ref SPI_NOR_F_QSPI is set */
+    uint32_t qspi_clk;       /**< QSPI clock in Hz */
+#endif
 } mtd_spi_nor_params_t;
 
 /**
@@ -135,6 +159,17 @@ typedef struct {
      * Computed by mtd_spi_nor_init, no need to touch outside the driver.
      */
     uint8_t sec_addr_shift;
+#if defined(MODULE_MTD_SPI_NOR_ERASE_AHEAD) || defined(DOXYGEN)
+    mutex_t lock;                   /**< guards the erase ahead state */
+    event_t ahead_ev;               /**< status poll event */
+    event_timeout_t ahead_timeout;  /**< schedules the status poll */
+    uint32_t ahead_addr;            /**< start of the unit being erased */
+    uint32_t ahead_unit;            /**< size of the unit being erased */
+    uint32_t ahead_end;             /**< end of the range to erase ahead */
+    uint32_t erased_addr;           /**< start of the erased range */
+    uint32_t erased_end;            /**< end of the erased range */
+    bool ahead_busy;                /**< background erase in progress */
+#endif
 } mtd_spi_nor_t;
 
 /**
@@ -160,6 +195,47 @@ extern const mtd_spi_nor_opcode_t mtd_spi_nor_opcode_default;
  */
 extern const mtd_spi_nor_opcode_t mtd_spi_nor_opcode_default_4bytes;
 
+/**
+ * @brief   Get the memory mapped (XIP) window of the flash
+ *
+ * Data, e.g. constfs files or assets, can be used in place from the
+ * returned window without copying it to RAM first. The content is only
+ * coherent while no write or erase operation is in progress.
+ *
+ * @note    Only available for devices on a QSPI bus that supports memory
+ *          mapping. The bus is kept powered once the window is mapped.
+ *
+ * @param[in] dev   initialized device
+ *
+ * @return  start of the flash in the address space
+ * @return  NULL if the flash can not be memory mapped
+ */
+const void *mtd_spi_nor_mmap(const mtd_spi_nor_t *dev);
+
+/**
+ * @brief   Erase sectors in the background
+ *
+ * Starts erasing the given range and returns immediately. The erase is
+ * continued unit by unit from the lowest priority event thread, the bus is
+ * only used to poll the status of the flash in between. Sequential writers
+ * can use this to prepare the next sectors while they are still busy with
+ * the current one, a later @ref mtd_erase of a range that was already
+ * erased ahead returns immediately.
+ *
+ * Accesses to the device wait until a background erase is finished. A call
+ * that continues the range currently erased extends it.
+ *
+ * @note    Only available with the `mtd_spi_nor_erase_ahead` module.
+ *
+ * @param[in] dev   initialized device
+ * @param[in] addr  sector aligned start address
+ * @param[in] size  size of the range, multiple of the sector size
+ *
+ * @return  0 on success
+ * @return  -EOVERFLOW if the range is not aligned or out of bounds
+ */
+int mtd_spi_nor_erase_ahead(mtd_spi_nor_t *dev, uint32_t addr, uint32_t size);
+
 #ifdef __cplusplus
 }
 #endif
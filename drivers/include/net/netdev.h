@@ -194,10 +194,12 @@
 extern "C" {
 #endif
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <errno.h>
 
 #include "iolist.h"
+#include "kernel_defines.h"
 #include "net/netopt.h"
 
 #ifdef MODULE_L2FILTER
@@ -292,6 +294,24 @@ struct netdev {
 #endif
 };
 
+#if IS_USED(MODULE_NETDEV_RX_ZEROCOPY) || defined(DOXYGEN)
+/**
+ * @brief   Receive buffer lent to a network device for zero-copy reception
+ *
+ * The network stack hands buffers to the device with
+ * @ref netdev_driver_t::rx_buf_give. The device (usually its DMA engine)
+ * writes received frames directly into netdev_rx_buf_t::data and returns
+ * the filled buffer with @ref netdev_driver_t::recv_zc.
+ *
+ * @note    Only available with module `netdev_rx_zerocopy`
+ */
+typedef struct {
+    void *data;             /**< buffer the frame is written to */
+    size_t size;            /**< capacity of netdev_rx_buf_t::data in byte */
+    void *ctx;              /**< owner context, not touched by the driver */
+} netdev_rx_buf_t;
+#endif
+
 /**
  * @brief Structure to hold driver interface -> function mapping
  *
@@ -427,6 +447,82 @@ typedef struct netdev_driver {
      */
     int (*set)(netdev_t *dev, netopt_t opt,
                const void *value, size_t value_len);
+
+#if IS_USED(MODULE_NETDEV_RX_ZEROCOPY) || defined(DOXYGEN)
+    /**
+     * @brief   Lend a receive buffer to the device (optional)
+     *
+     * @pre `(dev != NULL) && (buf != NULL)`
+     *
+     * The device keeps @p buf until it is returned by
+     * @ref netdev_driver_t::recv_zc. Devices with a receive ring accept
+     * several buffers, which are filled in the order they were given.
+     *
+     * @note    Only available with module `netdev_rx_zerocopy`; set to NULL
+     *          if zero-copy reception is not supported by the device.
+     *
+     * @param[in] dev       network device descriptor
+     * @param[in] buf       buffer to lend to the device
+     *
+     * @return  0 on success
+     * @return  `-ENOBUFS` if the device can not take any more buffers
+     * @return  `-EINVAL` if netdev_rx_buf_t::size of @p buf is too small
+     */
+    int (*rx_buf_give)(netdev_t *dev, netdev_rx_buf_t *buf);
+
+    /**
+     * @brief   Take back a lent buffer holding a received frame (optional)
+     *
+     * @pre `(dev != NULL) && (buf != NULL)`
+     *
+     * Replaces @ref netdev_driver_t::recv for devices supporting zero-copy
+     * reception. After a successful call, the device no longer owns the
+     * buffer returned in @p buf.
+     *
+     * @note    Only available with module `netdev_rx_zerocopy`; set to NULL
+     *          if zero-copy reception is not supported by the device.
+     *
+     * @param[in] dev       network device descriptor
+     * @param[out] buf      the buffer holding the received frame
+     * @param[out] info     status information for the received frame. Might
+     *                      be of different type for different netdev devices.
+     *                      May be NULL if not needed or applicable.
+     *
+     * @return  number of bytes of the frame written to @p buf
+     * @return  0 if no frame was received
+     * @return  `-EIO` if the frame was corrupted; @p buf is still returned
+     */
+    int (*recv_zc)(netdev_t *dev, netdev_rx_buf_t **buf, void *info);
+#endif
+
+#if IS_USED(MODULE_NETDEV_TX_BURST) || defined(DOXYGEN)
+    /**
+     * @brief   Send several frames in one go (optional)
+     *
+     * @pre `(dev != NULL) && (frames != NULL) && (numof > 0)`
+     *
+     * Devices with a transmit FIFO or a DMA descriptor ring can queue the
+     * next frame while the previous one is still on the air. The device
+     * signals the same events for every frame as after
+     * @ref netdev_driver_t::send. Frames are sent in the order given.
+     *
+     * @note    Only available with module `netdev_tx_burst`; set to NULL
+     *          if the device has no way to queue frames. Use
+     *          @ref netdev_send_burst to fall back to
+     *          @ref netdev_driver_t::send in that case.
+     *
+     * @param[in] dev       network device descriptor
+     * @param[in] frames    IO vector lists of the frames to send, each as
+     *                      expected by @ref netdev_driver_t::send
+     * @param[in] numof     number of entries in @p frames
+     *
+     * @return  number of frames accepted by the device, starting with the
+     *          first
+     * @return  negative errno, if not even the first frame was accepted
+     */
+    int (*send_burst)(netdev_t *dev, const iolist_t *const *frames,
+                      unsigned numof);
+#endif
 } netdev_driver_t;
 
 /**
@@ -469,6 +565,81 @@ static inline int netdev_set_notsup(netdev_t *dev, netopt_t opt,
     return -ENOTSUP;
 }
 
+#if IS_USED(MODULE_NETDEV_RX_ZEROCOPY) || defined(DOXYGEN)
+/**
+ * @brief   Checks if a device supports zero-copy reception
+ *
+ * @note    Only available with module `netdev_rx_zerocopy`
+ *
+ * @param[in] dev   network device descriptor
+ *
+ * @return  true, if @p dev supports @ref netdev_driver_t::rx_buf_give and
+ *          @ref netdev_driver_t::recv_zc
+ */
+static inline bool netdev_rx_zerocopy(const netdev_t *dev)
+{
+    return (dev->driver->rx_buf_give != NULL) &&
+           (dev->driver->recv_zc != NULL);
+}
+
+/**
+ * @brief   Gets the size of the receive buffers to lend to a device
+ *
+ * @note    Only available with module `netdev_rx_zerocopy`
+ *
+ * @param[in] dev       network device descriptor
+ * @param[in] frame_len maximum frame length of the link layer
+ *
+ * @return  @p frame_len, or the minimum buffer size of @p dev as of
+ *          @ref NETOPT_RX_BUF_SIZE if that is larger
+ */
+static inline size_t netdev_rx_buf_size(netdev_t *dev, size_t frame_len)
+{
+    uint16_t min;
+
+    if ((dev->driver->get(dev, NETOPT_RX_BUF_SIZE, &min, sizeof(min)) > 0) &&
+        (min > frame_len)) {
+        return min;
+    }
+    return frame_len;
+}
+#endif
+
+#if IS_USED(MODULE_NETDEV_TX_BURST) || defined(DOXYGEN)
+/**
+ * @brief   Sends several frames, using @ref netdev_driver_t::send_burst if
+ *          available
+ *
+ * Devices without @ref netdev_driver_t::send_burst get the frames one by
+ * one with @ref netdev_driver_t::send, stopping at the first failing frame.
+ *
+ * @note    Only available with module `netdev_tx_burst`
+ *
+ * @param[in] dev       network device descriptor
+ * @param[in] frames    IO vector lists of the frames to send
+ * @param[in] numof     number of entries in @p frames
+ *
+ * @return  number of frames accepted by the device, starting with the first
+ * @return  negative errno, if not even the first frame was accepted
+ */
+static inline int netdev_send_burst(netdev_t *dev,
+                                    const iolist_t *const *frames,
+                                    unsigned numof)
+{
+    if (dev->driver->send_burst != NULL) {
+        return dev->driver->send_burst(dev, frames, numof);
+    }
+    for (unsigned i = 0; i < numof; i++) {
+        int res = dev->driver->send(dev, frames[i]);
+
+        if (res < 0) {
+            return (i > 0) ? (int)i : res;
+        }
+    }
+    return (int)numof;
+}
+#endif
+
 /**
  * @brief Informs netdev there was an interrupt request from the network device.
  *
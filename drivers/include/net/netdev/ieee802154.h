@@ -24,6 +24,9 @@
 #include "net/gnrc/nettype.h"
 #include "net/netopt.h"
 #include "net/netdev.h"
+#if IS_USED(MODULE_IEEE802154_SECURITY)
+#include "net/ieee802154_security.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -115,6 +118,9 @@ typedef struct {
     uint8_t page;                           /**< channel page */
     uint16_t flags;                         /**< flags as defined above */
     int16_t txpower;                        /**< tx power in dBm */
+#if IS_USED(MODULE_IEEE802154_SECURITY)
+    ieee802154_sec_context_t sec_ctx;       /**< security context */
+#endif
     /** @} */
 } netdev_ieee802154_t;
 
@@ -159,6 +165,10 @@ int netdev_ieee802154_get(netdev_ieee802154_t *dev, netopt_t opt, void *value,
  * @ref NETDEV_IEEE802154_RAW and, @ref NETDEV_IEEE802154_ACK_REQ in
  * netdev_ieee802154_t::flags can be set or unset.
  *
+ * With the `ieee802154_security` module, @ref NETOPT_ENCRYPTION toggles
+ * @ref NETDEV_IEEE802154_SECURITY_EN and @ref NETOPT_ENCRYPTION_KEY sets the
+ * key with index 1 of netdev_ieee802154_t::sec_ctx.
+ *
  * The setting of netdev_ieee802154_t::chan is omitted since the legality of
  * its value can be very device specific and can't be checked in this function.
  * Please set it in the netdev_driver_t::set function of your driver.
@@ -128,6 +128,60 @@ int adc_init(adc_t line);
  */
 int32_t adc_sample(adc_t line, adc_res_t res);
 
+#if defined(MODULE_PERIPH_ADC_CONTINUOUS) || DOXYGEN
+/**
+ * @brief   Signature of the callback receiving continuously sampled data
+ *
+ * The samples of all lines of a scan are stored next to each other, in the
+ * order the lines were given to @ref adc_continuous_start. The samples are
+ * valid until the DMA wraps around to them again, so they can be processed
+ * in place, e.g. by CMSIS-DSP, without copying.
+ *
+ * @param[in] arg           argument given to @ref adc_continuous_start
+ * @param[in] samples       half of the sample buffer that was just filled
+ * @param[in] numof         number of samples in @p samples
+ */
+typedef void (*adc_continuous_cb_t)(void *arg, const uint16_t *samples,
+                                    size_t numof);
+
+/**
+ * @brief   Start timer triggered sampling of a sequence of lines into a
+ *          double buffer
+ *
+ * At @p freq Hz all lines are converted once, the DMA stores the samples
+ * into @p buf and @p cb is called from interrupt context each time a half
+ * of @p buf was filled. The lines must have been initialized with
+ * @ref adc_init before and must all belong to the same ADC device, which is
+ * not available to @ref adc_sample until @ref adc_continuous_stop.
+ *
+ * @note    Requires the `periph_adc_continuous` feature
+ *
+ * @param[in] lines         lines to sample in each scan
+ * @param[in] numof         number of lines
+ * @param[in] res           resolution to use for conversion
+ * @param[in] freq          scans per second
+ * @param[out] buf          sample buffer
+ * @param[in] len           number of samples in @p buf, must be a multiple of
+ *                          twice @p numof
+ * @param[in] cb            callback receiving each filled half of @p buf
+ * @param[in] arg           argument passed to @p cb
+ *
+ * @return                  0 on success
+ * @return                  -1 on invalid arguments or if sampling is already
+ *                          running
+ */
+int adc_continuous_start(const adc_t *lines, unsigned numof, adc_res_t res,
+                         uint32_t freq, uint16_t *buf, size_t len,
+                         adc_continuous_cb_t cb, void *arg);
+
+/**
+ * @brief   Stop the sampling started by @ref adc_continuous_start
+ *
+ * Does nothing if no sampling is running.
+ */
+void adc_continuous_stop(void);
+#endif /* MODULE_PERIPH_ADC_CONTINUOUS */
+
 #ifdef __cplusplus
 }
 #endif
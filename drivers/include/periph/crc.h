@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_periph_crc CRC unit
+ * @ingroup     drivers_periph
+ * @brief       Low-level interface to hardware CRC units
+ *
+ * Many MCUs contain a CRC unit that calculates the IEEE 802.3 CRC32 much
+ * faster than a look-up table. Applications do not need to call this
+ * interface directly: if the `periph_crc` feature is provided,
+ * @ref sys_checksum_crc32 uses the unit for all word aligned parts of a buffer.
+ *
+ * The functions block until the calculation is finished and are thread-safe.
+ *
+ * # (Low-) Power Implications
+ *
+ * The unit **should** be clock gated while no calculation is in progress.
+ *
+ * @{
+ * @file
+ * @brief       CRC unit peripheral interface
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+
+#ifndef PERIPH_CRC_H
+#define PERIPH_CRC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Feed words into the IEEE 802.3 CRC32
+ *
+ * @p state is the raw shift register of the reflected algorithm: it starts at
+ * 0xffffffff and the checksum is its complement.
+ *
+ * @param[in,out]   state   CRC register
+ * @param[in]       buf     data, word aligned
+ * @param[in]       len     length of @p buf in bytes, multiple of 4
+ *
+ * @return  0 on success, @p state is updated
+ * @return  -EINVAL if @p buf or @p len are not word aligned
+ * @return  -EIO on hardware error, @p state is unchanged
+ */
+int crc_crc32_update(uint32_t *state, const void *buf, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PERIPH_CRC_H */
+/** @} */
@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_periph_crypto Crypto accelerator
+ * @ingroup     drivers_periph
+ * @brief       Low-level interface to hardware block cipher engines
+ *
+ * Many MCUs contain an AES engine that is both faster and smaller than the
+ * table based software implementation in @ref sys_crypto. This interface
+ * exposes the raw block cipher of such an engine. Applications do not need to
+ * call it directly: if the `periph_crypto` feature is provided, the
+ * `crypto_aes` module routes @ref CIPHER_AES_128 through the hardware and
+ * falls back to the software implementation for requests the hardware
+ * rejects. All block cipher modes built on top of the cipher interface use
+ * the engine transparently.
+ *
+ * Engines that implement the SHA-256 compression function additionally
+ * provide the `periph_crypto_sha256` feature, which @ref sys_hashes_sha256
+ * uses for all complete blocks passed to it.
+ *
+ * Public key accelerators provide the `periph_crypto_ecc` feature: point
+ * multiplication and addition on the NIST P-256 curve. These are the
+ * expensive steps of ECDH (a single multiplication) and of ECDSA
+ * verification (two multiplications and one addition); the remaining scalar
+ * arithmetic is cheap enough to be left to software.
+ *
+ * The functions process any number of consecutive blocks in one call, so
+ * engines with DMA support can stream multi-block requests without CPU
+ * interaction. The functions block until the operation is finished and are
+ * thread-safe.
+ *
+ * # (Low-) Power Implications
+ *
+ * The engine **should** be clock gated while no operation is in progress.
+ *
+ * @{
+ * @file
+ * @brief       Crypto accelerator peripheral interface
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+
+#ifndef PERIPH_CRYPTO_H
+#define PERIPH_CRYPTO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Block size of the AES engine
+ */
+#define CRYPTO_AES_BLOCK_SIZE   (16U)
+
+/**
+ * @brief   Encrypt or decrypt blocks with AES in ECB mode
+ *
+ * @p in and @p out may be the same buffer.
+ *
+ * @param[in]   key         AES key
+ * @param[in]   key_len     length of @p key in bytes
+ * @param[in]   in          input blocks
+ * @param[out]  out         output blocks
+ * @param[in]   blocks      number of blocks to process
+ * @param[in]   encrypt     true to encrypt, false to decrypt
+ *
+ * @return  0 on success
+ * @return  -ENOTSUP if the key length or direction are not supported,
+ *          @p out is left untouched
+ * @return  -EIO on hardware error, @p out may be partially written
+ */
+int crypto_aes_ecb(const uint8_t *key, size_t key_len, const uint8_t *in,
+                   uint8_t *out, size_t blocks, bool encrypt);
+
+/**
+ * @brief   Block size of the SHA-256 engine
+ */
+#define CRYPTO_SHA256_BLOCK_SIZE    (64U)
+
+/**
+ * @brief   Run the SHA-256 compression function over consecutive blocks
+ *
+ * Padding is up to the caller, so the same function serves SHA-224 and
+ * SHA-256 and can continue any intermediate state.
+ *
+ * @param[in,out]   state   intermediate hash value H0..H7, in host order
+ * @param[in]       data    message blocks
+ * @param[in]       blocks  number of blocks of @ref CRYPTO_SHA256_BLOCK_SIZE
+ *
+ * @return  0 on success, @p state is updated
+ * @return  -EIO on hardware error, @p state is unchanged
+ */
+int crypto_sha256_blocks(uint32_t state[8], const void *data, size_t blocks);
+
+/**
+ * @brief   Size of a P-256 scalar or coordinate in bytes
+ */
+#define CRYPTO_ECC_P256_SIZE    (32U)
+
+/**
+ * @brief   Multiply a point on the P-256 curve by a scalar
+ *
+ * Scalars and coordinates are big endian, a point is the x coordinate
+ * followed by the y coordinate, as in the uncompressed SEC1 encoding without
+ * the leading 0x04. @p point is not checked to be on the curve: points
+ * received from a peer must be validated before they are passed in.
+ *
+ * @p result may be the same buffer as @p point.
+ *
+ * @param[in]   scalar  scalar of @ref CRYPTO_ECC_P256_SIZE bytes, smaller
+ *                      than the group order
+ * @param[in]   point   point of 2 * @ref CRYPTO_ECC_P256_SIZE bytes
+ * @param[out]  result  @p scalar * @p point
+ *
+ * @return  0 on success
+ * @return  -EDOM if the result is the point at infinity
+ * @return  -EIO on hardware error
+ */
+int crypto_ecc_p256_mul(const uint8_t *scalar, const uint8_t *point,
+                        uint8_t *result);
+
+/**
+ * @brief   Add two points on the P-256 curve
+ *
+ * The encoding is the same as for @ref crypto_ecc_p256_mul. @p result may be
+ * the same buffer as either input.
+ *
+ * @param[in]   a       first point
+ * @param[in]   b       second point
+ * @param[out]  result  @p a + @p b
+ *
+ * @return  0 on success
+ * @return  -EDOM if the result is the point at infinity
+ * @return  -EIO on hardware error
+ */
+int crypto_ecc_p256_add(const uint8_t *a, const uint8_t *b, uint8_t *result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PERIPH_CRYPTO_H */
+/** @} */
@@ -121,6 +121,10 @@
 #include "periph_conf.h"
 #include "periph_cpu.h"
 
+#ifdef MODULE_PERIPH_I2C_ASYNC
+#include "event.h"
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -497,6 +501,78 @@ int i2c_write_reg(i2c_t dev, uint16_t addr, uint16_t reg,
 int i2c_write_regs(i2c_t dev, uint16_t addr, uint16_t reg,
                   const void *data, size_t len, uint8_t flags);
 
+#if defined(MODULE_PERIPH_I2C_ASYNC) || DOXYGEN
+/**
+ * @name    Asynchronous I2C transactions
+ *
+ * Transactions are queued as descriptors and executed one after the other
+ * by a dedicated thread, that acquires the bus for each transaction. The
+ * queueing thread is not blocked and gets notified by an event once the
+ * transaction is done.
+ *
+ * @note    Requires the `periph_i2c_async` module
+ * @{
+ */
+/**
+ * @brief   Stack size of the thread executing asynchronous transactions
+ */
+#ifndef CONFIG_I2C_ASYNC_STACKSIZE
+#define CONFIG_I2C_ASYNC_STACKSIZE      (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @brief   Priority of the thread executing asynchronous transactions
+ */
+#ifndef CONFIG_I2C_ASYNC_PRIO
+#define CONFIG_I2C_ASYNC_PRIO           (THREAD_PRIORITY_MAIN - 1)
+#endif
+
+/**
+ * @brief   Operations of an asynchronous transaction
+ */
+typedef enum {
+    I2C_ASYNC_READ_BYTES,       /**< see @ref i2c_read_bytes */
+    I2C_ASYNC_WRITE_BYTES,      /**< see @ref i2c_write_bytes */
+    I2C_ASYNC_READ_REGS,        /**< see @ref i2c_read_regs */
+    I2C_ASYNC_WRITE_REGS,       /**< see @ref i2c_write_regs */
+} i2c_async_op_t;
+
+/**
+ * @brief   Descriptor of an asynchronous I2C transaction
+ *
+ * The descriptor and its data buffer must stay valid until @p done was
+ * posted.
+ */
+typedef struct {
+    event_t super;              /**< queued on the I2C thread, internal */
+    i2c_t dev;                  /**< I2C device to use */
+    i2c_async_op_t op;          /**< operation to execute */
+    uint16_t addr;              /**< 7-bit or 10-bit device address */
+    uint16_t reg;               /**< register address, for register ops */
+    uint8_t flags;              /**< optional flags (see @ref i2c_flags_t) */
+    void *data;                 /**< data to send or buffer to receive into */
+    size_t len;                 /**< number of bytes to transfer */
+    int res;                    /**< result of the operation, once done */
+    event_queue_t *done_queue;  /**< queue to post @p done to */
+    event_t *done;              /**< posted when done, may be NULL */
+} i2c_async_xfer_t;
+
+/**
+ * @brief   Start the thread executing asynchronous transactions
+ *
+ * @note    Called by auto_init
+ */
+void i2c_async_init(void);
+
+/**
+ * @brief   Queue an asynchronous transaction
+ *
+ * @param[in] xfer          transaction to queue
+ */
+void i2c_transfer_async(i2c_async_xfer_t *xfer);
+/** @} */
+#endif /* MODULE_PERIPH_I2C_ASYNC */
+
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_periph_qspi Quad SPI
+ * @ingroup     drivers_periph
+ * @brief       Low-level Quad SPI peripheral driver
+ *
+ * This interface abstracts the dedicated Quad SPI flash controllers found on
+ * many MCUs. In contrast to @ref drivers_periph_spi, a QSPI bus talks to a
+ * single serial NOR flash and the controller takes care of the instruction
+ * framing: opcode, address, dummy cycles and data phase, each of which may be
+ * transferred over one, two or four data lines.
+ *
+ * Like SPI, the bus has to be acquired before use and released afterwards
+ * with `qspi_acquire()` and `qspi_release()`. `qspi_init()` is called once
+ * for every configured bus during system initialization, the bus is then
+ * configured by the flash driver with `qspi_configure()`.
+ *
+ * Controllers that can map the flash into the address space of the CPU
+ * implement `qspi_mmap()`, which allows to execute code or read data in place
+ * (XIP).
+ *
+ * @{
+ * @file
+ * @brief       Low-level QSPI peripheral driver interface definition
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+
+#ifndef PERIPH_QSPI_H
+#define PERIPH_QSPI_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "periph_cpu.h"
+#include "periph_conf.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Default QSPI device access macro
+ */
+#ifndef QSPI_DEV
+#define QSPI_DEV(x)     (x)
+#endif
+
+/**
+ * @brief   Default type for QSPI devices
+ */
+#ifndef HAVE_QSPI_T
+typedef unsigned int qspi_t;
+#endif
+
+/**
+ * @brief   Clock polarity and phase of the QSPI bus
+ */
+#ifndef HAVE_QSPI_MODE_T
+typedef enum {
+    QSPI_MODE_0 = 0,    /**< CPOL=0, CPHA=0 */
+    QSPI_MODE_3 = 3,    /**< CPOL=1, CPHA=1 */
+} qspi_mode_t;
+#endif
+
+/**
+ * @brief   Number of data lines used for opcode, address and data
+ *
+ * The dummy cycles of a read are derived from the opcode by the
+ * implementation, following the JEDEC defaults of the standard fast read
+ * instructions.
+ */
+typedef enum {
+    QSPI_LANES_1_1_1,   /**< everything on one line */
+    QSPI_LANES_1_1_2,   /**< data on two lines */
+    QSPI_LANES_1_2_2,   /**< address and data on two lines */
+    QSPI_LANES_1_1_4,   /**< data on four lines */
+    QSPI_LANES_1_4_4,   /**< address and data on four lines */
+} qspi_lanes_t;
+
+/**
+ * @name    Flags for @ref qspi_configure
+ *
+ * Controllers that can only send the 3 byte address opcodes switch the flash
+ * to its 4 byte address mode when @ref QSPI_FMT_ADDR_LEN_4 is used.
+ * @{
+ */
+#define QSPI_FMT_ADDR_LEN_3     (0x0)   /**< use 3 byte addresses */
+#define QSPI_FMT_ADDR_LEN_4     (0x1)   /**< use 4 byte addresses */
+/** @} */
+
+/**
+ * @brief   Basic initialization of the given QSPI bus
+ *
+ * Called once during system initialization, leaves the bus powered off.
+ *
+ * @param[in] bus       QSPI device to initialize
+ */
+void qspi_init(qspi_t bus);
+
+/**
+ * @brief   Configure the QSPI bus for the attached flash
+ *
+ * @param[in] bus       QSPI device to configure
+ * @param[in] mode      clock polarity and phase
+ * @param[in] flags     QSPI_FMT_* flags
+ * @param[in] clk_hz    bus clock, the next lower supported frequency is used
+ */
+void qspi_configure(qspi_t bus, qspi_mode_t mode, uint32_t flags, uint32_t clk_hz);
+
+/**
+ * @brief   Get exclusive access to the QSPI bus and power it on
+ *
+ * @param[in] bus       QSPI device to access
+ */
+void qspi_acquire(qspi_t bus);
+
+/**
+ * @brief   Release the QSPI bus and power it off
+ *
+ * @param[in] bus       QSPI device to release
+ */
+void qspi_release(qspi_t bus);
+
+/**
+ * @brief   Send a command and read the response
+ *
+ * All phases use a single data line.
+ *
+ * @param[in]  bus      QSPI device
+ * @param[in]  command  command opcode
+ * @param[out] response buffer for the response
+ * @param[in]  len      response length, at least 8 bytes are supported
+ */
+void qspi_cmd_read(qspi_t bus, uint8_t command, void *response, size_t len);
+
+/**
+ * @brief   Send a command with optional payload
+ *
+ * All phases use a single data line. Address based commands without data
+ * phase (e.g. erase) pass the address as payload.
+ *
+ * @param[in]  bus      QSPI device
+ * @param[in]  command  command opcode
+ * @param[in]  data     payload, may be NULL if @p len is 0
+ * @param[in]  len      payload length, at least 8 bytes are supported
+ */
+void qspi_cmd_write(qspi_t bus, uint8_t command, const void *data, size_t len);
+
+/**
+ * @brief   Read data from the flash
+ *
+ * No alignment is required on @p addr, @p data or @p len.
+ *
+ * @param[in]  bus      QSPI device
+ * @param[in]  command  read opcode
+ * @param[in]  lanes    data lines used by @p command
+ * @param[in]  addr     flash address to read from
+ * @param[out] data     destination buffer
+ * @param[in]  len      number of bytes to read
+ */
+void qspi_read(qspi_t bus, uint8_t command, qspi_lanes_t lanes,
+               uint32_t addr, void *data, size_t len);
+
+/**
+ * @brief   Program data into the flash
+ *
+ * The flash has to be write enabled before. @p addr + @p len must not cross
+ * a page boundary of the flash. The function returns once the data is
+ * transferred, the caller has to poll the flash for completion.
+ *
+ * @param[in]  bus      QSPI device
+ * @param[in]  command  page program opcode
+ * @param[in]  lanes    data lines used by @p command
+ * @param[in]  addr     flash address to write to
+ * @param[in]  data     data to write
+ * @param[in]  len      number of bytes to write
+ */
+void qspi_write(qspi_t bus, uint8_t command, qspi_lanes_t lanes,
+                uint32_t addr, const void *data, size_t len);
+
+/**
+ * @brief   Map the flash into the address space of the CPU
+ *
+ * Reads from the returned window are translated into flash reads using
+ * @p command by the controller. The content is only coherent while no
+ * program or erase operation is in progress.
+ *
+ * @param[in]  bus      QSPI device
+ * @param[in]  command  read opcode used for the window
+ * @param[in]  lanes    data lines used by @p command
+ *
+ * @return  start of the memory mapped flash
+ * @return  NULL if the controller does not support memory mapping
+ */
+const void *qspi_mmap(qspi_t bus, uint8_t command, qspi_lanes_t lanes);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PERIPH_QSPI_H */
+/** @} */
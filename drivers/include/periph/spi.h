@@ -421,6 +421,82 @@ uint8_t spi_transfer_reg(spi_t bus, spi_cs_t cs, uint8_t reg, uint8_t out);
 void spi_transfer_regs(spi_t bus, spi_cs_t cs, uint8_t reg,
                        const void *out, void *in, size_t len);
 
+/**
+ * @brief   Signature of the callback invoked when an asynchronous transfer
+ *          is done
+ *
+ * @param[in]  arg      argument given with the transfer descriptor
+ */
+typedef void (*spi_async_cb_t)(void *arg);
+
+/**
+ * @brief   Descriptor of an asynchronous SPI transfer
+ *
+ * The descriptor is owned by the driver from the call to
+ * @ref spi_transfer_async() until its callback was invoked, so it must not be
+ * allocated on a stack frame that is left before that.
+ */
+typedef struct spi_async_xfer {
+    struct spi_async_xfer *next;    /**< next queued transfer, used internally */
+    const void *out;                /**< buffer to send data from, or NULL */
+    void *in;                       /**< buffer to read into, or NULL */
+    size_t len;                     /**< number of bytes to transfer */
+    spi_cs_t cs;                    /**< chip select pin/line to use */
+    bool cont;                      /**< keep device selected after transfer */
+    spi_async_cb_t cb;              /**< completion callback, may be NULL */
+    void *arg;                      /**< argument passed to @p cb */
+} spi_async_xfer_t;
+
+/**
+ * @brief   Queue a transfer on the given SPI bus without waiting for it
+ *
+ * Transfers queued on the same bus are executed back to back in the order
+ * they were queued. Once a transfer is done, its callback is invoked, which
+ * typically sets a thread flag or posts an event to wake up the thread
+ * waiting for the data. The callback may queue further transfers.
+ *
+ * CPUs that define `PERIPH_SPI_HAS_TRANSFER_ASYNC` run the transfers using
+ * DMA and invoke the callback from interrupt context. On all other CPUs, and
+ * for buses without DMA configured, the transfers are executed blocking from
+ * within this function and the callback is invoked before it returns.
+ *
+ * The bus must have been acquired using @ref spi_acquire() and must not be
+ * released before the callback of the last queued transfer was invoked.
+ *
+ * @param[in]  bus      SPI device to use
+ * @param[in]  xfer     transfer to queue
+ */
+void spi_transfer_async(spi_t bus, spi_async_xfer_t *xfer);
+
+#if defined(PERIPH_SPI_HAS_TRANSFER_ASYNC) || DOXYGEN
+/**
+ * @brief   Start an asynchronous transfer in hardware
+ *
+ * @note    Implemented by the CPU, only called by @ref spi_transfer_async()
+ *
+ * The CPU asserts the chip select line and starts the transfer. Once done, it
+ * releases the chip select line unless `xfer->cont` is set and calls
+ * @ref spi_async_done().
+ *
+ * @param[in]  bus      SPI device to use
+ * @param[in]  xfer     transfer to start
+ *
+ * @retval  true        transfer was started and will complete asynchronously
+ * @retval  false       transfer was completed synchronously
+ */
+bool spi_async_start(spi_t bus, const spi_async_xfer_t *xfer);
+
+/**
+ * @brief   Report the completion of the transfer started by
+ *          @ref spi_async_start()
+ *
+ * @note    Called by the CPU, typically from interrupt context
+ *
+ * @param[in]  bus      SPI device the transfer was done on
+ */
+void spi_async_done(spi_t bus);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
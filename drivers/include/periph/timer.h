@@ -39,6 +39,9 @@
 #include "periph_cpu.h"
 /** @todo remove dev_enums.h include once all platforms are ported to the updated periph interface */
 #include "periph/dev_enums.h"
+#ifdef MODULE_PERIPH_TIMER_CAPTURE
+#include "periph/gpio.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -215,6 +218,104 @@ void timer_start(tim_t dev);
  */
 void timer_stop(tim_t dev);
 
+#if defined(MODULE_PERIPH_TIMER_CAPTURE) || DOXYGEN
+/**
+ * @name    Input capture
+ *
+ * Records the timer value on edges of a GPIO into a ring buffer, e.g. to
+ * timestamp the start of a frame signaled by a radio or to measure pulses.
+ *
+ * The generic implementation reads the timer first thing in the GPIO
+ * interrupt, so the values are subject to the interrupt latency. A CPU
+ * latching the timer in hardware defines `PERIPH_TIMER_PROVIDES_CAPTURE`
+ * and implements timer_capture_init() and timer_capture_stop(), adding the
+ * values with timer_capture_push().
+ *
+ * @note    Requires the `periph_timer_capture` module
+ * @{
+ */
+/**
+ * @brief   Input capture descriptor
+ */
+typedef struct {
+    unsigned int *buf;          /**< ring buffer of captured values */
+    unsigned mask;              /**< size of the buffer minus one */
+    volatile unsigned head;     /**< number of values written */
+    volatile unsigned tail;     /**< number of values read */
+    volatile unsigned lost;     /**< values dropped on a full buffer */
+    tim_t dev;                  /**< timer captured */
+    gpio_t pin;                 /**< GPIO triggering the capture */
+} timer_capture_t;
+
+/**
+ * @brief   Starts capturing the value of a timer on edges of a GPIO
+ *
+ * @pre     @p size is a power of two
+ *
+ * @param[out] cap      capture descriptor to initialize
+ * @param[in]  dev      initialized timer to capture
+ * @param[in]  pin      GPIO triggering the capture
+ * @param[in]  mode     mode of @p pin
+ * @param[in]  flank    edges triggering the capture
+ * @param[in]  buf      buffer for the captured values
+ * @param[in]  size     number of values @p buf holds
+ *
+ * @return  0 on success
+ * @return  -1 if @p pin cannot trigger a capture
+ */
+int timer_capture_init(timer_capture_t *cap, tim_t dev, gpio_t pin,
+                       gpio_mode_t mode, gpio_flank_t flank,
+                       unsigned int *buf, unsigned size);
+
+/**
+ * @brief   Stops capturing
+ *
+ * Captured values can still be read.
+ *
+ * @param[in] cap       capture descriptor
+ */
+void timer_capture_stop(timer_capture_t *cap);
+
+/**
+ * @brief   Adds a captured value, called from interrupt context
+ *
+ * @param[in] cap       capture descriptor
+ * @param[in] value     captured timer value
+ */
+static inline void timer_capture_push(timer_capture_t *cap,
+                                      unsigned int value)
+{
+    if (cap->head - cap->tail > cap->mask) {
+        cap->lost++;
+        return;
+    }
+    cap->buf[cap->head & cap->mask] = value;
+    cap->head++;
+}
+
+/**
+ * @brief   Takes the oldest captured value
+ *
+ * Must only be called by a single thread.
+ *
+ * @param[in]  cap      capture descriptor
+ * @param[out] value    captured timer value
+ *
+ * @return  0 on success
+ * @return  -1 if no value was captured
+ */
+static inline int timer_capture_read(timer_capture_t *cap, unsigned int *value)
+{
+    if (cap->head == cap->tail) {
+        return -1;
+    }
+    *value = cap->buf[cap->tail & cap->mask];
+    cap->tail++;
+    return 0;
+}
+/** @} */
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -210,6 +210,71 @@ int uart_mode(uart_t uart, uart_data_bits_t data_bits, uart_parity_t parity,
  */
 void uart_write(uart_t uart, const uint8_t *data, size_t len);
 
+#if defined(MODULE_PERIPH_UART_DMA) || DOXYGEN
+/**
+ * @name    DMA based UART transfers
+ *
+ * @note    Requires the `periph_uart_dma` feature
+ * @{
+ */
+/**
+ * @brief   Signature of the callback receiving chunks of data
+ *
+ * @param[in] arg           context to the callback (optional)
+ * @param[in] data          received data
+ * @param[in] len           number of bytes in @p data
+ */
+typedef void (*uart_rx_chunk_cb_t)(void *arg, const uint8_t *data, size_t len);
+
+/**
+ * @brief   Signature of the callback signaling the end of an asynchronous
+ *          write
+ *
+ * @param[in] arg           context to the callback (optional)
+ */
+typedef void (*uart_tx_done_cb_t)(void *arg);
+
+/**
+ * @brief   Start receiving into a circular buffer using DMA
+ *
+ * The UART must have been initialized in TX only mode before. The received
+ * data is handed to @p cb in interrupt context whenever the line becomes idle
+ * and whenever half of @p buf was filled. @p cb must consume the data before
+ * the DMA overwrites it, i.e. within the reception of another half buffer.
+ *
+ * @param[in] uart          UART device to use
+ * @param[in] buf           buffer the DMA writes into
+ * @param[in] size          size of @p buf
+ * @param[in] cb            callback receiving chunks of data
+ * @param[in] arg           argument passed to @p cb
+ *
+ * @return                  UART_OK on success
+ * @return                  UART_NODEV if the UART has no RX DMA configured
+ */
+int uart_rx_dma_start(uart_t uart, uint8_t *buf, size_t size,
+                      uart_rx_chunk_cb_t cb, void *arg);
+
+/**
+ * @brief   Write data without waiting for the transmission to finish
+ *
+ * The data is sent using DMA. @p data must stay valid until @p cb was
+ * called from interrupt context. Must not be called from interrupt context,
+ * except from @p cb itself to chain the next write without a gap.
+ *
+ * @param[in] uart          UART device to use for transmission
+ * @param[in] data          data buffer to send
+ * @param[in] len           number of bytes to send
+ * @param[in] cb            callback invoked when done, may be NULL
+ * @param[in] arg           argument passed to @p cb
+ *
+ * @return                  UART_OK on success
+ * @return                  UART_NODEV if the UART has no TX DMA configured
+ */
+int uart_write_async(uart_t uart, const uint8_t *data, size_t len,
+                     uart_tx_done_cb_t cb, void *arg);
+/** @} */
+#endif /* MODULE_PERIPH_UART_DMA */
+
 /**
  * @brief   Power on the given UART device
  *
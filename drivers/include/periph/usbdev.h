@@ -54,6 +54,11 @@
  * is done to allow the low level USB peripheral to use DMA to transfer the data
  * from and to the MCU memory.
  *
+ * Drivers may further support transfers spanning multiple packets with a
+ * buffer supplied by the caller (@ref usbdev_ep_xfer). The peripheral then
+ * moves all packets of a transfer from or to that buffer by itself and only
+ * signals the end of the transfer, instead of one event per packet.
+ *
  * A callback function is required for signalling events from the driver. The
  * @ref USBDEV_EVENT_ESR is special in that it indicates that the USB peripheral
  * had an interrupt that needs to be serviced in a non-interrupt context. This
@@ -71,6 +76,8 @@
 #ifndef PERIPH_USBDEV_H
 #define PERIPH_USBDEV_H
 
+#include <errno.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <stddef.h>
 
@@ -363,6 +370,20 @@ typedef struct usbdev_driver {
      * @param[in] len       length of the data to be transmitted
      */
     int (*ready)(usbdev_ep_t *ep, size_t len);
+
+    /**
+     * @brief Start a multi-packet transfer with a buffer of the caller
+     *
+     * Optional, NULL if not supported by the peripheral.
+     *
+     * @param[in] ep        USB endpoint descriptor
+     * @param[in] buf       buffer to transfer from or to
+     * @param[in] len       length of the data to be transmitted or the size
+     *                      of @p buf
+     *
+     * @see @ref usbdev_ep_xfer
+     */
+    int (*xfer)(usbdev_ep_t *ep, void *buf, size_t len);
 } usbdev_driver_t;
 
 /**
@@ -577,6 +598,57 @@ static inline int usbdev_ep_ready(usbdev_ep_t *ep, size_t len)
     return ep->dev->driver->ready(ep, len);
 }
 
+/**
+ * @brief Check if an endpoint supports multi-packet transfers
+ *
+ * @param[in] ep        USB endpoint descriptor
+ *
+ * @return  true, if @ref usbdev_ep_xfer is supported
+ */
+static inline bool usbdev_ep_xfer_supported(usbdev_ep_t *ep)
+{
+    assert(ep);
+    assert(ep->dev);
+    return ep->dev->driver->xfer != NULL;
+}
+
+/**
+ * @brief Start a multi-packet transfer with a buffer of the caller
+ *
+ * An IN endpoint sends the @p len bytes in @p buf in packets of the
+ * endpoint size, followed by a zero length packet if @p len is a multiple of
+ * it. An OUT endpoint receives into @p buf until a short packet is received
+ * or @p buf is full, then @ref USBOPT_EP_AVAILABLE returns the total number
+ * of bytes received. In both cases, the endpoint signals a single
+ * @ref USBDEV_EVENT_TR_COMPLETE at the end of the transfer.
+ *
+ * The peripheral accesses @p buf directly, so it must stay valid until the
+ * transfer completes and be word aligned. For OUT endpoints, @p len should be
+ * a multiple of the endpoint size. A subsequent @ref usbdev_ep_ready uses the
+ * buffer of the endpoint again.
+ *
+ * @see @ref usbdev_driver_t::xfer
+ *
+ * @pre `(ep != NULL)`
+ * @pre `(ep->dev != NULL)`
+ *
+ * @param[in] ep        USB endpoint descriptor
+ * @param[in] buf       buffer to transfer from or to
+ * @param[in] len       length of the data to be transmitted or the size of
+ *                      @p buf
+ *
+ * @return  0 on success
+ * @return  -ENOTSUP if the driver does not support multi-packet transfers
+ * @return  -EINVAL if @p len exceeds the maximum transfer size
+ */
+static inline int usbdev_ep_xfer(usbdev_ep_t *ep, void *buf, size_t len)
+{
+    if (!usbdev_ep_xfer_supported(ep)) {
+        return -ENOTSUP;
+    }
+    return ep->dev->driver->xfer(ep, buf, len);
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -27,6 +27,12 @@
  * actuators/sensor via auto_init and the access to all available devices via
  * one unified shell command.
  *
+ * With module `saul_batch`, sensors with a hardware FIFO can further expose
+ * reading all buffered samples at once (@ref saul_read_batch_t) and the
+ * configuration of the FIFO and its watermark interrupt
+ * (@ref saul_fifo_config_t), so high sampling rates do not need a bus
+ * transaction per sample.
+ *
  * @todo        So far, the interface only supports simple read and set
  *              operations. It probably needs to be extended to handling events,
  *              thresholds, and so on.
@@ -47,6 +53,7 @@
 #include <stdint.h>
 #include <errno.h>
 
+#include "kernel_defines.h"
 #include "phydat.h"
 
 #ifdef __cplusplus
@@ -273,6 +280,66 @@ typedef int(*saul_read_t)(const void *dev, phydat_t *res);
  */
 typedef int(*saul_write_t)(const void *dev, phydat_t *data);
 
+#if IS_USED(MODULE_SAUL_BATCH) || defined(DOXYGEN)
+/**
+ * @brief   Batch of samples read from a device, oldest first
+ *
+ * Sample i of n was taken at about
+ * `time - (n - 1 - i) * period_us`.
+ *
+ * @note    Only available with module `saul_batch`
+ */
+typedef struct {
+    int16_t (*val)[PHYDAT_DIM]; /**< buffer of the samples */
+    uint16_t numof;             /**< capacity of @p val */
+    uint8_t unit;               /**< unit of all samples */
+    int8_t scale;               /**< scale of all samples */
+    uint32_t time;              /**< `ZTIMER_USEC` time of the newest sample */
+    uint32_t period_us;         /**< time between two samples in µs */
+} saul_batch_t;
+
+/**
+ * @brief   Configuration of the hardware FIFO of a device
+ *
+ * @note    Only available with module `saul_batch`
+ */
+typedef struct {
+    uint16_t watermark;         /**< number of samples to trigger @p cb at,
+                                     0 to disable the FIFO */
+    void (*cb)(void *arg);      /**< watermark callback, called in interrupt
+                                     context, may be NULL */
+    void *arg;                  /**< argument of @p cb */
+} saul_fifo_cfg_t;
+
+/**
+ * @brief   Read the samples buffered by a device
+ *
+ * Reads as many samples as available and fitting into @p batch with as few
+ * bus transactions as possible, oldest first. Sets all fields of @p batch
+ * except saul_batch_t::val, saul_batch_t::numof and saul_batch_t::time.
+ *
+ * @param[in] dev       device descriptor of the target device
+ * @param[in,out] batch buffer to read to
+ *
+ * @return  number of samples read, 0 if none is available
+ * @return  -ECANCELED on errors
+ */
+typedef int(*saul_read_batch_t)(const void *dev, saul_batch_t *batch);
+
+/**
+ * @brief   Configure the hardware FIFO of a device
+ *
+ * @param[in] dev       device descriptor of the target device
+ * @param[in] cfg       FIFO configuration
+ *
+ * @return  0 on success
+ * @return  -EINVAL if the watermark exceeds the FIFO or a callback is not
+ *          supported
+ * @return  -ECANCELED on other errors
+ */
+typedef int(*saul_fifo_config_t)(const void *dev, const saul_fifo_cfg_t *cfg);
+#endif
+
 /**
  * @brief   Definition of the RIOT actuator/sensor interface
  */
@@ -280,6 +347,13 @@ typedef struct {
     saul_read_t read;       /**< read function pointer */
     saul_write_t write;     /**< write function pointer */
     uint8_t type;           /**< device class the device belongs to */
+#if IS_USED(MODULE_SAUL_BATCH) || defined(DOXYGEN)
+    saul_read_batch_t read_batch;   /**< batch read function pointer, NULL
+                                         if the device has no FIFO */
+    saul_fifo_config_t fifo_config; /**< FIFO configuration function
+                                         pointer, NULL if the device has no
+                                         FIFO */
+#endif
 } saul_driver_t;
 
 /**
@@ -193,6 +193,8 @@ typedef struct {
     int csd_structure;              /**< version of the CSD register structure */
     cid_t cid;                      /**< CID register */
     csd_t csd;                      /**< CSD register */
+    uint8_t stream_cmd;             /**< CMD18/CMD25 of the open multi-block session, 0 if none */
+    int stream_next;                /**< block address that continues the open session */
 } sdcard_spi_t;
 
 /**
@@ -255,6 +257,62 @@ int sdcard_spi_read_blocks(sdcard_spi_t *card, int blockaddr, uint8_t *data, int
 int sdcard_spi_write_blocks(sdcard_spi_t *card, int blockaddr, const uint8_t *data, int blocksize,
                             int nblocks, sd_rw_response_t *state);
 
+/**
+ * @brief                 Reads data blocks as part of a multi-block (CMD18) session.
+ *
+ * The session stays open after the call returns, so a following call that
+ * continues at the next block address skips the command overhead. Any other
+ * access to the card closes the session first.
+ *
+ * @param[in] card        Initialized sd-card struct
+ * @param[in] blockaddr   Start address to read from, given as block address
+ * @param[out] data       Buffer to store the read data in
+ * @param[in]  blocksize  Size of data blocks, see @ref sdcard_spi_read_blocks
+ * @param[in]  nblocks    Number of blocks to read
+ * @param[out] state      Contains information about the error state if something went wrong
+ *                        (if return value is lower than nblocks).
+ *
+ * @return                number of successfully read blocks (0 if no block was read).
+ */
+int sdcard_spi_read_stream(sdcard_spi_t *card, int blockaddr, uint8_t *data, int blocksize,
+                           int nblocks, sd_rw_response_t *state);
+
+/**
+ * @brief                 Writes data blocks as part of a multi-block (CMD25) session.
+ *
+ * The session stays open after the call returns, so a following call that
+ * continues at the next block address skips the command overhead. Any other
+ * access to the card closes the session first.
+ *
+ * @param[in] card        Initialized sd-card struct
+ * @param[in] blockaddr   Start address to write to, given as block address
+ * @param[in] data        Buffer that contains the data to be sent
+ * @param[in]  blocksize  Size of data blocks, see @ref sdcard_spi_write_blocks
+ * @param[in]  nblocks    Number of blocks to write
+ * @param[in]  erase_hint Number of blocks expected to be written in this
+ *                        session, passed to the card as pre-erase hint
+ *                        (ACMD23) when a new session is opened. 0 for none.
+ * @param[out] state      Contains information about the error state if something went wrong
+ *                        (if return value is lower than nblocks).
+ *
+ * @return                number of successfully written blocks (0 if no block was written).
+ */
+int sdcard_spi_write_stream(sdcard_spi_t *card, int blockaddr, const uint8_t *data, int blocksize,
+                            int nblocks, int erase_hint, sd_rw_response_t *state);
+
+/**
+ * @brief                 Closes an open multi-block session.
+ *
+ * Sends the stop token of a write session and waits for the card to finish
+ * programming, or stops a read session with CMD12. Does nothing if no
+ * session is open.
+ *
+ * @param[in] card        Initialized sd-card struct
+ *
+ * @return                SD_RW_OK on success or if no session was open
+ */
+sd_rw_response_t sdcard_spi_stream_close(sdcard_spi_t *card);
+
 /**
  * @brief                 Gets the capacity of the card.
  *
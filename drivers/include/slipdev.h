@@ -21,6 +21,7 @@
 #ifndef SLIPDEV_H
 #define SLIPDEV_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "cib.h"
@@ -52,6 +53,25 @@ extern "C" {
 #ifndef CONFIG_SLIPDEV_BUFSIZE
 #define CONFIG_SLIPDEV_BUFSIZE (2048U)
 #endif
+
+/**
+ * @brief   Size of the circular buffer used for DMA reception
+ *
+ * Only used with the `periph_uart_dma` feature. The data is copied out each
+ * time half of the buffer was filled or the line becomes idle.
+ */
+#ifndef CONFIG_SLIPDEV_RX_DMA_BUFSIZE
+#define CONFIG_SLIPDEV_RX_DMA_BUFSIZE (64U)
+#endif
+
+/**
+ * @brief   Maximum number of received frames waiting to be read
+ *
+ * @pre Needs to be power of two
+ */
+#ifndef CONFIG_SLIPDEV_RX_FRAMES
+#define CONFIG_SLIPDEV_RX_FRAMES (4U)
+#endif
 /** @} */
 
 /**
@@ -91,8 +111,17 @@ typedef struct {
 typedef struct {
     netdev_t netdev;                        /**< parent class */
     slipdev_params_t config;                /**< configuration parameters */
-    tsrb_t inbuf;                           /**< RX buffer */
+    tsrb_t inbuf;                           /**< RX buffer of unescaped frames */
     uint8_t rxmem[CONFIG_SLIPDEV_BUFSIZE];  /**< memory used by RX buffer */
+    cib_t rx_frames;                        /**< queue of received frames */
+    /** lengths of the received frames in slipdev_t::inbuf */
+    uint16_t rx_lens[CONFIG_SLIPDEV_RX_FRAMES];
+    unsigned rx_start;      /**< start of the current frame in inbuf */
+    bool rx_esc;            /**< the last byte received was SLIPDEV_ESC */
+    bool rx_drop;           /**< the current frame did not fit, drop it */
+#if defined(MODULE_PERIPH_UART_DMA) || DOXYGEN
+    uint8_t rx_dma_buf[CONFIG_SLIPDEV_RX_DMA_BUFSIZE]; /**< DMA RX buffer */
+#endif
     /**
      * @brief   Device state
      * @see     [Device state definitions](@ref drivers_slipdev_states)
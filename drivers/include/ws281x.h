@@ -42,6 +42,24 @@
  * The ESP32 implementation is frequency independent, as frequencies above 80MHz
  * are high enough to support bit banging without assembly.
  *
+ * ## SPI
+ * The SPI backend works on any MCU providing `periph_spi`, the data pin of the
+ * LEDs is connected to MOSI of the selected bus. Every data bit is sent as one
+ * byte, so a DMA capable SPI streams the whole strip while interrupts stay
+ * enabled. @ref ws281x_write_buffer only starts the transfer, which allows to
+ * render the next frame into a second buffer while the current one is sent:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * ws281x_prepare_transmission(dev);
+ * ws281x_write_buffer(dev, frame[cur], sizeof(frame[cur]));
+ * cur = !cur;
+ * render(frame[cur]);
+ * ws281x_end_transmission(dev);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * The buffer passed to @ref ws281x_write_buffer must stay valid until the next
+ * call to it or to @ref ws281x_end_transmission.
+ *
  * ## Native/VT100
  *
  * The native (VT100) implementation writes the LED state to the console.
@@ -70,6 +88,12 @@
  * USEMODULE += ws281x_esp32
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  *
+ * * the SPI backend:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Makefile
+ * USEMODULE += ws281x_spi
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
  * * the native/VT100 backend:
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Makefile
  * USEMODULE += ws281x_vt100
@@ -90,6 +114,10 @@
 
 #include "color.h"
 #include "periph/gpio.h"
+#ifdef MODULE_WS281X_SPI
+#include "mutex.h"
+#include "periph/spi.h"
+#endif
 #include "ws281x_backend.h"
 #include "ws281x_constants.h"
 #include "xtimer.h"
@@ -115,6 +143,9 @@ typedef struct {
     uint8_t *buf;
     uint16_t numof;             /**< Number of chained RGB LEDs */
     gpio_t pin;                 /**< GPIO connected to the data pin of the first LED */
+#if defined(MODULE_WS281X_SPI) || defined(DOXYGEN)
+    spi_t spi;                  /**< SPI bus with MOSI connected to the data pin */
+#endif
 } ws281x_params_t;
 
 /**
@@ -122,6 +153,16 @@ typedef struct {
  */
 typedef struct {
     ws281x_params_t params;   /**< Parameters of the LED chain */
+#if defined(MODULE_WS281X_SPI) || defined(DOXYGEN)
+    spi_async_xfer_t xfer[2]; /**< transfers of the two encoding buffers */
+    /** encoding buffers, one SPI byte per data bit */
+    uint8_t chunk[2][WS281X_SPI_CHUNK_SIZE * 8];
+    const uint8_t *pos;       /**< next color byte to encode */
+    const uint8_t *end;       /**< end of the color data */
+    size_t next_len;          /**< encoded length of the buffer sent next */
+    uint8_t cur;              /**< buffer currently sent */
+    mutex_t busy;             /**< locked while a buffer is sent */
+#endif
 } ws281x_t;
 
 #if defined(WS281X_HAVE_INIT) || defined(DOXYGEN)
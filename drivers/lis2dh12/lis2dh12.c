@@ -17,7 +17,11 @@
  * @}
  */
 
+#include <string.h>
+
 #include "assert.h"
+#include "kernel_defines.h"
+#include "timex.h"
 
 #include "lis2dh12.h"
 #include "lis2dh12_internal.h"
@@ -127,6 +131,18 @@ static void _write(const lis2dh12_t *dev, uint8_t reg, uint8_t data)
 #endif  /* MODULE_LIS2DH12_SPI */
 
 
+/* calculate the actual g-values for the x, y, and z dimension */
+static void _convert(const lis2dh12_t *dev, const uint8_t *raw, int16_t *data)
+{
+    for (int i = 0; i < 3; i++) {
+        int32_t tmp = ((raw[i * 2] >> 6) | (raw[(i * 2) + 1] << 2));
+        if (tmp & 0x00000200) {
+            tmp |= 0xfffffc00;
+        }
+        data[i] = (int16_t)((tmp * dev->comp) / 512);
+    }
+}
+
 int lis2dh12_init(lis2dh12_t *dev, const lis2dh12_params_t *params)
 {
     assert(dev && params);
@@ -182,18 +198,69 @@ int lis2dh12_read(const lis2dh12_t *dev, int16_t *data)
     _read_burst(dev, REG_OUT_X_L, raw, 6);
     _release(dev);
 
-    /* calculate the actual g-values for the x, y, and z dimension */
-    for (int i = 0; i < 3; i++) {
-        int32_t tmp = ((raw[i * 2] >> 6) | (raw[(i * 2) + 1] << 2));
-        if (tmp & 0x00000200) {
-            tmp |= 0xfffffc00;
-        }
-        data[i] = (int16_t)((tmp * dev->comp) / 512);
+    _convert(dev, raw, data);
+
+    return LIS2DH12_OK;
+}
+
+int lis2dh12_set_fifo(const lis2dh12_t *dev, uint8_t watermark)
+{
+    assert(dev && (watermark < LIS2DH12_FIFO_SIZE));
+
+    _acquire(dev);
+    if (watermark) {
+        _write(dev, REG_CTRL_REG5, CTRL_REG5_FIFO_EN);
+        _write(dev, REG_FIFO_CTRL_REG,
+               FIFO_CTRL_FM_STREAM | (watermark & FIFO_CTRL_FTH_MASK));
+    }
+    else {
+        _write(dev, REG_FIFO_CTRL_REG, FIFO_CTRL_FM_BYPASS);
+        _write(dev, REG_CTRL_REG5, 0);
     }
+    _release(dev);
 
     return LIS2DH12_OK;
 }
 
+int lis2dh12_read_fifo(const lis2dh12_t *dev, int16_t (*data)[3],
+                       unsigned numof)
+{
+    assert(dev && data);
+
+    _acquire(dev);
+    uint8_t src = _read(dev, REG_FIFO_SRC_REG);
+    /* all 32 samples are buffered on overrun, FSS only counts up to 31 */
+    unsigned avail = (src & FIFO_SRC_OVRN) ? LIS2DH12_FIFO_SIZE
+                                           : (src & FIFO_SRC_FSS_MASK);
+    if (avail > numof) {
+        avail = numof;
+    }
+    /* the address wraps around to OUT_X_L with the FIFO enabled, so all
+     * samples are read in one go, straight into the output buffer */
+    if (avail) {
+        _read_burst(dev, REG_OUT_X_L, data, avail * 6);
+    }
+    _release(dev);
+
+    for (unsigned i = 0; i < avail; i++) {
+        uint8_t raw[6];
+
+        memcpy(raw, data[i], sizeof(raw));
+        _convert(dev, raw, data[i]);
+    }
+
+    return avail;
+}
+
+uint32_t lis2dh12_period_us(const lis2dh12_t *dev)
+{
+    static const uint16_t hz[] = { 1, 10, 25, 50, 100, 200, 400 };
+    unsigned odr = dev->p->rate >> 4;
+
+    assert((odr > 0) && (odr <= ARRAY_SIZE(hz)));
+    return US_PER_SEC / hz[odr - 1];
+}
+
 #ifdef MODULE_LIS2DH12_INT
 int lis2dh12_set_int(const lis2dh12_t *dev, const lis2dh12_int_params_t *params, uint8_t int_line)
 {
@@ -264,6 +331,26 @@ int lis2dh12_read_int_src(const lis2dh12_t *dev, uint8_t *data, uint8_t int_line
 
     return LIS2DH12_OK;
 }
+
+int lis2dh12_set_fifo_int(const lis2dh12_t *dev, gpio_cb_t cb, void *arg)
+{
+    assert(dev && (dev->p->int1_pin != GPIO_UNDEF));
+
+    if (cb) {
+        if (gpio_init_int(dev->p->int1_pin, GPIO_IN, GPIO_RISING, cb, arg)) {
+            return LIS2DH12_NOINT;
+        }
+    }
+    else {
+        gpio_irq_disable(dev->p->int1_pin);
+    }
+
+    _acquire(dev);
+    _write(dev, REG_CTRL_REG3, cb ? CTRL_REG3_I1_WTM : 0);
+    _release(dev);
+
+    return LIS2DH12_OK;
+}
 #endif /* MODULE_LIS2DH12_INT */
 
 int lis2dh12_poweron(const lis2dh12_t *dev)
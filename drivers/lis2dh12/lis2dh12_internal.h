@@ -73,6 +73,13 @@ extern "C" {
  * @{
  */
 #define WHO_AM_I_VAL                (0x33)
+#define CTRL_REG3_I1_WTM            (0x04)
+#define CTRL_REG5_FIFO_EN           (0x40)
+#define FIFO_CTRL_FM_BYPASS         (0x00)
+#define FIFO_CTRL_FM_STREAM         (0x80)
+#define FIFO_CTRL_FTH_MASK          (0x1F)
+#define FIFO_SRC_OVRN               (0x40)
+#define FIFO_SRC_FSS_MASK           (0x1F)
 /** @} */
 
 #ifdef __cplusplus
@@ -31,8 +31,47 @@ static int read_accelerometer(const void *dev, phydat_t *res)
     return 3;
 }
 
+#if IS_USED(MODULE_SAUL_BATCH)
+static int read_batch(const void *dev, saul_batch_t *batch)
+{
+    int res = lis2dh12_read_fifo((const lis2dh12_t *)dev, batch->val,
+                                 batch->numof);
+    if (res < 0) {
+        return -ECANCELED;
+    }
+    batch->unit = UNIT_G;
+    batch->scale = -3;
+    batch->period_us = lis2dh12_period_us((const lis2dh12_t *)dev);
+    return res;
+}
+
+static int fifo_config(const void *dev, const saul_fifo_cfg_t *cfg)
+{
+    if (cfg->watermark >= LIS2DH12_FIFO_SIZE) {
+        return -EINVAL;
+    }
+#if IS_USED(MODULE_LIS2DH12_INT)
+    if (lis2dh12_set_fifo_int((const lis2dh12_t *)dev,
+                              cfg->watermark ? cfg->cb : NULL,
+                              cfg->arg) != LIS2DH12_OK) {
+        return -ECANCELED;
+    }
+#else
+    if (cfg->cb) {
+        return -EINVAL;
+    }
+#endif
+    lis2dh12_set_fifo((const lis2dh12_t *)dev, cfg->watermark);
+    return 0;
+}
+#endif
+
 const saul_driver_t lis2dh12_saul_driver = {
     .read = read_accelerometer,
     .write = saul_notsup,
-    .type = SAUL_SENSE_ACCEL
+    .type = SAUL_SENSE_ACCEL,
+#if IS_USED(MODULE_SAUL_BATCH)
+    .read_batch = read_batch,
+    .fifo_config = fifo_config,
+#endif
 };
@@ -21,6 +21,9 @@
 #include <errno.h>
 
 #include "mtd.h"
+#ifdef MODULE_ENERGY
+#include "energy.h"
+#endif
 
 int mtd_init(mtd_dev_t *mtd)
 {
@@ -85,7 +88,13 @@ int mtd_power(mtd_dev_t *mtd, enum mtd_power_state power)
     }
 
     if (mtd->driver->power) {
-        return mtd->driver->power(mtd, power);
+        int res = mtd->driver->power(mtd, power);
+#ifdef MODULE_ENERGY
+        if (res == 0) {
+            energy_set_state(&energy_mtd, power);
+        }
+#endif
+        return res;
     }
     else {
         return -ENOTSUP;
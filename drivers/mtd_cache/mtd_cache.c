@@ -0,0 +1,346 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_mtd_cache
+ * @{
+ *
+ * @file
+ * @brief       Page cache and write-back buffer for MTD devices
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <inttypes.h>
+
+#include "kernel_defines.h"
+#include "mtd.h"
+#include "mtd_cache.h"
+#include "mutex.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#define FLAG_VALID      (0x1)
+#define FLAG_DIRTY      (0x2)
+
+static uint32_t _size(mtd_cache_t *cache)
+{
+    return cache->mtd.page_size * cache->mtd.pages_per_sector *
+           cache->mtd.sector_count;
+}
+
+static uint32_t _min(uint32_t a, uint32_t b)
+{
+    return (a < b) ? a : b;
+}
+
+static uint8_t *_page_buf(mtd_cache_t *cache, int idx)
+{
+    return cache->buf + idx * cache->mtd.page_size;
+}
+
+static int _find(mtd_cache_t *cache, uint32_t page)
+{
+    for (unsigned i = 0; i < cache->numof; i++) {
+        mtd_cache_entry_t *e = &cache->entries[i];
+        if ((e->flags & FLAG_VALID) && (e->page == page)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void _touch(mtd_cache_t *cache, int idx)
+{
+    cache->entries[idx].used = ++cache->clock;
+}
+
+static int _writeback(mtd_cache_t *cache, int idx)
+{
+    mtd_cache_entry_t *e = &cache->entries[idx];
+
+    if (!(e->flags & FLAG_DIRTY)) {
+        return 0;
+    }
+
+    DEBUG("mtd_cache: write back page %" PRIu32 "\n", e->page);
+    int res = mtd_write(cache->parent, _page_buf(cache, idx),
+                        e->page * cache->mtd.page_size, cache->mtd.page_size);
+    if (res == 0) {
+        e->flags &= ~FLAG_DIRTY;
+        cache->stats.writebacks++;
+    }
+    return res;
+}
+
+static int _load(mtd_cache_t *cache, uint32_t page, bool fill)
+{
+    int idx = 0;
+
+    /* prefer a free entry, otherwise evict the least recently used one */
+    for (unsigned i = 0; i < cache->numof; i++) {
+        mtd_cache_entry_t *e = &cache->entries[i];
+        if (!(e->flags & FLAG_VALID)) {
+            idx = i;
+            break;
+        }
+        if ((cache->clock - e->used) > (cache->clock - cache->entries[idx].used)) {
+            idx = i;
+        }
+    }
+
+    int res = _writeback(cache, idx);
+    if (res < 0) {
+        return res;
+    }
+
+    mtd_cache_entry_t *e = &cache->entries[idx];
+    e->flags = 0;
+    e->page = page;
+
+    if (fill) {
+        res = mtd_read(cache->parent, _page_buf(cache, idx),
+                       page * cache->mtd.page_size, cache->mtd.page_size);
+        if (res < 0) {
+            return res;
+        }
+    }
+
+    e->flags = FLAG_VALID;
+    return idx;
+}
+
+static void _readahead(mtd_cache_t *cache, uint32_t page)
+{
+    uint32_t pages = cache->mtd.pages_per_sector * cache->mtd.sector_count;
+
+    if (!IS_ACTIVE(CONFIG_MTD_CACHE_READAHEAD) || cache->numof < 2) {
+        return;
+    }
+    if ((page + 1 >= pages) || (_find(cache, page + 1) >= 0)) {
+        return;
+    }
+
+    /* errors are ignored, the page will be read again on the next access */
+    int idx = _load(cache, page + 1, true);
+    if (idx >= 0) {
+        _touch(cache, idx);
+        cache->stats.readaheads++;
+    }
+}
+
+static int _init(mtd_dev_t *mtd)
+{
+    mtd_cache_t *cache = container_of(mtd, mtd_cache_t, mtd);
+
+    int res = mtd_init(cache->parent);
+    if (res < 0) {
+        return res;
+    }
+
+    mutex_lock(&cache->lock);
+    mtd->sector_count = cache->parent->sector_count;
+    mtd->pages_per_sector = cache->parent->pages_per_sector;
+    mtd->page_size = cache->parent->page_size;
+
+    for (unsigned i = 0; i < cache->numof; i++) {
+        cache->entries[i].flags = 0;
+    }
+    cache->clock = 0;
+    cache->last_page = UINT32_MAX - 1;
+    memset(&cache->stats, 0, sizeof(cache->stats));
+    mutex_unlock(&cache->lock);
+
+    return 0;
+}
+
+static int _read(mtd_dev_t *mtd, void *dest, uint32_t addr, uint32_t count)
+{
+    mtd_cache_t *cache = container_of(mtd, mtd_cache_t, mtd);
+    uint32_t page_size = mtd->page_size;
+    uint8_t *out = dest;
+    int res = 0;
+
+    if (addr + count > _size(cache)) {
+        return -EOVERFLOW;
+    }
+
+    mutex_lock(&cache->lock);
+    while (count) {
+        uint32_t page = addr / page_size;
+        uint32_t offset = addr % page_size;
+        uint32_t chunk = _min(page_size - offset, count);
+
+        int idx = _find(cache, page);
+        if (idx >= 0) {
+            cache->stats.hits++;
+        }
+        else {
+            cache->stats.misses++;
+            bool sequential = (page == cache->last_page + 1);
+            cache->last_page = page;
+
+            /* whole pages that are not cached bypass the cache, so large
+               reads do not push out the working set, and consecutive ones
+               are read from the backing device at once */
+            if (chunk == page_size) {
+                while ((count - chunk >= page_size) &&
+                       (_find(cache, page + chunk / page_size) < 0)) {
+                    chunk += page_size;
+                }
+                cache->last_page = page + chunk / page_size - 1;
+                res = mtd_read(cache->parent, out, addr, chunk);
+                if (res < 0) {
+                    break;
+                }
+                goto next;
+            }
+
+            idx = _load(cache, page, true);
+            if (idx < 0) {
+                res = idx;
+                break;
+            }
+            _touch(cache, idx);
+            if (sequential) {
+                _readahead(cache, page);
+            }
+        }
+
+        _touch(cache, idx);
+        memcpy(out, _page_buf(cache, idx) + offset, chunk);
+next:
+        addr += chunk;
+        out += chunk;
+        count -= chunk;
+    }
+    mutex_unlock(&cache->lock);
+
+    return res;
+}
+
+static int _write(mtd_dev_t *mtd, const void *src, uint32_t addr,
+                  uint32_t count)
+{
+    mtd_cache_t *cache = container_of(mtd, mtd_cache_t, mtd);
+    uint32_t page_size = mtd->page_size;
+    const uint8_t *in = src;
+    int res = 0;
+
+    if (addr + count > _size(cache)) {
+        return -EOVERFLOW;
+    }
+
+    mutex_lock(&cache->lock);
+    while (count) {
+        uint32_t page = addr / page_size;
+        uint32_t offset = addr % page_size;
+        uint32_t chunk = _min(page_size - offset, count);
+
+        int idx = _find(cache, page);
+        if (idx >= 0) {
+            cache->stats.hits++;
+        }
+        else {
+            cache->stats.misses++;
+            /* a partial write needs the rest of the page to write back */
+            idx = _load(cache, page, chunk != page_size);
+            if (idx < 0) {
+                res = idx;
+                break;
+            }
+        }
+
+        _touch(cache, idx);
+        memcpy(_page_buf(cache, idx) + offset, in, chunk);
+        cache->entries[idx].flags |= FLAG_DIRTY;
+
+        addr += chunk;
+        in += chunk;
+        count -= chunk;
+    }
+    mutex_unlock(&cache->lock);
+
+    return res;
+}
+
+static int _erase(mtd_dev_t *mtd, uint32_t addr, uint32_t count)
+{
+    mtd_cache_t *cache = container_of(mtd, mtd_cache_t, mtd);
+    uint32_t first = addr / mtd->page_size;
+    uint32_t last = (addr + count) / mtd->page_size;
+
+    if (addr + count > _size(cache)) {
+        return -EOVERFLOW;
+    }
+
+    mutex_lock(&cache->lock);
+    /* pending writes to the erased range are lost anyway */
+    for (unsigned i = 0; i < cache->numof; i++) {
+        mtd_cache_entry_t *e = &cache->entries[i];
+        if ((e->flags & FLAG_VALID) && (e->page >= first) && (e->page < last)) {
+            e->flags = 0;
+        }
+    }
+    int res = mtd_erase(cache->parent, addr, count);
+    mutex_unlock(&cache->lock);
+
+    return res;
+}
+
+static int _power(mtd_dev_t *mtd, enum mtd_power_state power)
+{
+    mtd_cache_t *cache = container_of(mtd, mtd_cache_t, mtd);
+
+    if (power == MTD_POWER_DOWN) {
+        int res = mtd_cache_flush(cache);
+        if (res < 0) {
+            return res;
+        }
+    }
+    return mtd_power(cache->parent, power);
+}
+
+int mtd_cache_flush(mtd_cache_t *cache)
+{
+    int res = 0;
+
+    mutex_lock(&cache->lock);
+    for (unsigned i = 0; i < cache->numof; i++) {
+        int err = _writeback(cache, i);
+        if (err < 0) {
+            res = err;
+        }
+    }
+    mutex_unlock(&cache->lock);
+
+    return res;
+}
+
+void mtd_cache_stats_get(mtd_cache_t *cache, mtd_cache_stats_t *stats)
+{
+    mutex_lock(&cache->lock);
+    *stats = cache->stats;
+    memset(&cache->stats, 0, sizeof(cache->stats));
+    mutex_unlock(&cache->lock);
+}
+
+const mtd_desc_t mtd_cache_driver = {
+    .init = _init,
+    .read = _read,
+    .write = _write,
+    .erase = _erase,
+    .power = _power,
+};
@@ -69,7 +69,7 @@ static int mtd_sdcard_read(mtd_dev_t *dev, void *buff, uint32_t addr,
     DEBUG("mtd_sdcard_read: addr:%" PRIu32 " size:%" PRIu32 "\n", addr, size);
     mtd_sdcard_t *mtd_sd = (mtd_sdcard_t*)dev;
     sd_rw_response_t err;
-    sdcard_spi_read_blocks(mtd_sd->sd_card, addr / SD_HC_BLOCK_SIZE,
+    sdcard_spi_read_stream(mtd_sd->sd_card, addr / SD_HC_BLOCK_SIZE,
                            buff, SD_HC_BLOCK_SIZE,
                            size / SD_HC_BLOCK_SIZE, &err);
 
@@ -85,8 +85,11 @@ static int mtd_sdcard_write(mtd_dev_t *dev, const void *buff, uint32_t addr,
     DEBUG("mtd_sdcard_write: addr:%" PRIu32 " size:%" PRIu32 "\n", addr, size);
     mtd_sdcard_t *mtd_sd = (mtd_sdcard_t*)dev;
     sd_rw_response_t err;
-    sdcard_spi_write_blocks(mtd_sd->sd_card, addr / SD_HC_BLOCK_SIZE,
+    /* sequential writes keep one CMD25 session open, the size of the
+       first write is a good enough pre-erase hint for the card */
+    sdcard_spi_write_stream(mtd_sd->sd_card, addr / SD_HC_BLOCK_SIZE,
                             buff, SD_HC_BLOCK_SIZE,
+                            size / SD_HC_BLOCK_SIZE,
                             size / SD_HC_BLOCK_SIZE, &err);
 
     if (err == SD_RW_OK) {
@@ -114,9 +117,12 @@ static int mtd_sdcard_erase(mtd_dev_t *dev,
 
 static int mtd_sdcard_power(mtd_dev_t *dev, enum mtd_power_state power)
 {
-    (void)dev;
+    mtd_sdcard_t *mtd_sd = (mtd_sdcard_t*)dev;
     (void)power;
 
+    /* make sure pending writes are committed before power is cut */
+    sdcard_spi_stream_close(mtd_sd->sd_card);
+
     /* TODO: implement power down of sdcard in sdcard_spi
     (make use of sdcard_spi_params_t.power pin) */
     return -ENOTSUP; /* currently not supported */
@@ -24,6 +24,7 @@
 #include <stdint.h>
 #include <errno.h>
 
+#include "kernel_defines.h"
 #include "mtd.h"
 #if MODULE_XTIMER
 #include "xtimer.h"
@@ -33,6 +34,9 @@
 #endif
 #include "byteorder.h"
 #include "mtd_spi_nor.h"
+#ifdef MODULE_MTD_SPI_NOR_ERASE_AHEAD
+#include "event/thread.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -56,6 +60,14 @@
 
 #define MBIT_AS_BYTES       ((1024 * 1024) / 8)
 
+/* status poll interval once the typical erase time has passed */
+#ifndef MTD_ERASE_POLL_US
+#define MTD_ERASE_POLL_US   (1000U)
+#endif
+
+#define SR_WIP              (0x01)
+#define SR_QE_BIT6          (0x40)
+
 /**
  * @brief   JEDEC memory manufacturer ID codes.
  *
@@ -83,14 +95,61 @@ const mtd_desc_t mtd_spi_nor_driver = {
     .power = mtd_spi_nor_power,
 };
 
+static inline bool _use_qspi(const mtd_spi_nor_t *dev)
+{
+    return IS_USED(MODULE_PERIPH_QSPI) && (dev->params->flag & SPI_NOR_F_QSPI);
+}
+
+#ifdef MODULE_PERIPH_QSPI
+/**
+ * @internal
+ * @brief Get the data lines used by a read or page program opcode
+ */
+static qspi_lanes_t _qspi_lanes(uint8_t opcode)
+{
+    switch (opcode) {
+    case 0x3b:
+    case 0x3c:
+        return QSPI_LANES_1_1_2;
+    case 0xbb:
+    case 0xbc:
+        return QSPI_LANES_1_2_2;
+    case 0x6b:
+    case 0x6c:
+    case 0x32:
+    case 0x34:
+        return QSPI_LANES_1_1_4;
+    case 0xeb:
+    case 0xec:
+    case 0x38:
+    case 0x3e:
+        return QSPI_LANES_1_4_4;
+    default:
+        return QSPI_LANES_1_1_1;
+    }
+}
+#endif
+
 static void mtd_spi_acquire(const mtd_spi_nor_t *dev)
 {
+#ifdef MODULE_PERIPH_QSPI
+    if (_use_qspi(dev)) {
+        qspi_acquire(dev->params->qspi);
+        return;
+    }
+#endif
     spi_acquire(dev->params->spi, dev->params->cs,
                 dev->params->mode, dev->params->clk);
 }
 
 static void mtd_spi_release(const mtd_spi_nor_t *dev)
 {
+#ifdef MODULE_PERIPH_QSPI
+    if (_use_qspi(dev)) {
+        qspi_release(dev->params->qspi);
+        return;
+    }
+#endif
     spi_release(dev->params->spi);
 }
 
@@ -125,6 +184,14 @@ static void mtd_spi_cmd_addr_read(const mtd_spi_nor_t *dev, uint8_t opcode,
         TRACE("\n");
     }
 
+#ifdef MODULE_PERIPH_QSPI
+    if (_use_qspi(dev)) {
+        qspi_read(dev->params->qspi, opcode, _qspi_lanes(opcode),
+                  byteorder_ntohl(addr), dest, count);
+        return;
+    }
+#endif
+
     do {
         /* Send opcode followed by address */
         spi_transfer_byte(dev->params->spi, dev->params->cs, true, opcode);
@@ -163,6 +230,21 @@ static void mtd_spi_cmd_addr_write(const mtd_spi_nor_t *dev, uint8_t opcode,
         TRACE("\n");
     }
 
+#ifdef MODULE_PERIPH_QSPI
+    if (_use_qspi(dev)) {
+        if (count) {
+            qspi_write(dev->params->qspi, opcode, _qspi_lanes(opcode),
+                       byteorder_ntohl(addr), src, count);
+        }
+        else {
+            /* address only commands, e.g. erase */
+            qspi_cmd_write(dev->params->qspi, opcode, addr_buf,
+                           dev->params->addr_width);
+        }
+        return;
+    }
+#endif
+
     do {
         /* Send opcode followed by address */
         spi_transfer_byte(dev->params->spi, dev->params->cs, true, opcode);
@@ -191,6 +273,13 @@ static void mtd_spi_cmd_read(const mtd_spi_nor_t *dev, uint8_t opcode, void *des
     TRACE("mtd_spi_cmd_read: %p, %02x, %p, %" PRIu32 "\n",
           (void *)dev, (unsigned int)opcode, dest, count);
 
+#ifdef MODULE_PERIPH_QSPI
+    if (_use_qspi(dev)) {
+        qspi_cmd_read(dev->params->qspi, opcode, dest, count);
+        return;
+    }
+#endif
+
     spi_transfer_regs(dev->params->spi, dev->params->cs, opcode, NULL, dest, count);
 }
 
@@ -203,11 +292,18 @@ static void mtd_spi_cmd_read(const mtd_spi_nor_t *dev, uint8_t opcode, void *des
  * @param[out] src    write buffer
  * @param[in]  count  number of bytes to write after the opcode has been sent
  */
-static void __attribute__((unused)) mtd_spi_cmd_write(const mtd_spi_nor_t *dev, uint8_t opcode, const void *src, uint32_t count)
+static void mtd_spi_cmd_write(const mtd_spi_nor_t *dev, uint8_t opcode, const void *src, uint32_t count)
 {
     TRACE("mtd_spi_cmd_write: %p, %02x, %p, %" PRIu32 "\n",
           (void *)dev, (unsigned int)opcode, src, count);
 
+#ifdef MODULE_PERIPH_QSPI
+    if (_use_qspi(dev)) {
+        qspi_cmd_write(dev->params->qspi, opcode, src, count);
+        return;
+    }
+#endif
+
     spi_transfer_regs(dev->params->spi, dev->params->cs, opcode,
                       (void *)src, NULL, count);
 }
@@ -224,6 +320,13 @@ static void mtd_spi_cmd(const mtd_spi_nor_t *dev, uint8_t opcode)
     TRACE("mtd_spi_cmd: %p, %02x\n",
           (void *)dev, (unsigned int)opcode);
 
+#ifdef MODULE_PERIPH_QSPI
+    if (_use_qspi(dev)) {
+        qspi_cmd_write(dev->params->qspi, opcode, NULL, 0);
+        return;
+    }
+#endif
+
     spi_transfer_byte(dev->params->spi, dev->params->cs, false, opcode);
 }
 
@@ -244,12 +347,54 @@ static inline uint8_t parity8(uint8_t x)
  * @internal
  * @brief Read JEDEC ID
  */
+#ifdef MODULE_PERIPH_QSPI
+/**
+ * @internal
+ * @brief Read JEDEC ID over QSPI
+ *
+ * The controller only supports fixed length responses, so read as much as
+ * possible and parse the buffer.
+ */
+static int mtd_qspi_read_jedec_id(const mtd_spi_nor_t *dev, mtd_jedec_id_t *out)
+{
+    uint8_t id[8];
+    unsigned i = 0;
+
+    qspi_cmd_read(dev->params->qspi, dev->params->opcode->rdid, id, sizeof(id));
+
+    out->bank = 1;
+    while ((id[i] == JEDEC_NEXT_BANK) && (i < sizeof(id) - 3)) {
+        ++out->bank;
+        ++i;
+    }
+    out->manuf = id[i];
+    if (parity8(out->manuf) == 0) {
+        DEBUG("mtd_qspi_read_jedec_id: Parity error (0x%02x)\n", (unsigned int)out->manuf);
+        return -2;
+    }
+    if (out->manuf == 0xFF || out->manuf == 0x00) {
+        DEBUG_PUTS("mtd_qspi_read_jedec_id: failed to read manufacturer ID");
+        return -3;
+    }
+    out->device[0] = id[i + 1];
+    out->device[1] = id[i + 2];
+
+    return 0;
+}
+#endif
+
 static int mtd_spi_read_jedec_id(const mtd_spi_nor_t *dev, mtd_jedec_id_t *out)
 {
     /* not using above read functions because of variable length rdid response */
     int status = 0;
     mtd_jedec_id_t jedec;
 
+#ifdef MODULE_PERIPH_QSPI
+    if (_use_qspi(dev)) {
+        return mtd_qspi_read_jedec_id(dev, out);
+    }
+#endif
+
     DEBUG("mtd_spi_read_jedec_id: rdid=0x%02x\n",
           (unsigned int)dev->params->opcode->rdid);
 
@@ -335,7 +480,7 @@ static inline void wait_for_write_complete(const mtd_spi_nor_t *dev, uint32_t us
         mtd_spi_cmd_read(dev, dev->params->opcode->rdsr, &status, sizeof(status));
 
         TRACE("mtd_spi_nor: wait device status = 0x%02x\n", (unsigned int)status);
-        if ((status & 1) == 0) { /* TODO magic number */
+        if ((status & SR_WIP) == 0) {
             break;
         }
         i++;
@@ -370,6 +515,232 @@ static inline void wait_for_write_complete(const mtd_spi_nor_t *dev, uint32_t us
     DEBUG("\n");
 }
 
+static uint8_t _read_opcode(const mtd_spi_nor_t *dev)
+{
+    const mtd_spi_nor_opcode_t *op = dev->params->opcode;
+
+    return (_use_qspi(dev) && op->read_quad) ? op->read_quad : op->read;
+}
+
+static uint8_t _program_opcode(const mtd_spi_nor_t *dev)
+{
+    const mtd_spi_nor_opcode_t *op = dev->params->opcode;
+
+    return (_use_qspi(dev) && op->page_program_quad) ? op->page_program_quad
+                                                     : op->page_program;
+}
+
+/**
+ * @internal
+ * @brief Wait for an erase to complete without blocking the bus
+ *
+ * The bus is only held for polling the status register, so other devices
+ * on the same bus can be used while the flash is busy.
+ */
+static void wait_for_erase_complete(const mtd_spi_nor_t *dev, uint32_t us)
+{
+    uint8_t status;
+
+    do {
+        mtd_spi_release(dev);
+#if MODULE_XTIMER
+        xtimer_usleep(us);
+        /* poll more often once the estimated time has passed */
+        us = (us > 2 * MTD_ERASE_POLL_US) ? us / 2 : MTD_ERASE_POLL_US;
+#else
+        (void)us;
+        thread_yield();
+#endif
+        mtd_spi_acquire(dev);
+        mtd_spi_cmd_read(dev, dev->params->opcode->rdsr, &status, sizeof(status));
+    } while (status & SR_WIP);
+}
+
+/**
+ * @internal
+ * @brief Start erasing the largest unit possible at @p addr
+ *
+ * @param[in]  dev    pointer to device descriptor
+ * @param[in]  addr   sector aligned address
+ * @param[in]  size   remaining size to erase
+ * @param[out] us     expected erase time
+ *
+ * @return number of bytes that are being erased
+ */
+static uint32_t mtd_spi_nor_erase_unit(const mtd_spi_nor_t *dev, uint32_t addr,
+                                       uint32_t size, uint32_t *us)
+{
+    const mtd_dev_t *mtd = &dev->base;
+    uint32_t sector_size = mtd->page_size * mtd->pages_per_sector;
+    uint32_t total_size = sector_size * mtd->sector_count;
+    be_uint32_t addr_be = byteorder_htonl(addr);
+
+    /* write enable */
+    mtd_spi_cmd(dev, dev->params->opcode->wren);
+
+    if (size == total_size) {
+        mtd_spi_cmd(dev, dev->params->opcode->chip_erase);
+        *us = dev->params->wait_chip_erase;
+        return total_size;
+    }
+    else if ((dev->params->flag & SPI_NOR_F_SECT_32K) && (size >= MTD_32K) &&
+             ((addr & MTD_32K_ADDR_MASK) == 0)) {
+        /* 32 KiB blocks can be erased with block erase command */
+        mtd_spi_cmd_addr_write(dev, dev->params->opcode->block_erase_32k, addr_be, NULL, 0);
+        *us = dev->params->wait_32k_erase;
+        return MTD_32K;
+    }
+    else if ((dev->params->flag & SPI_NOR_F_SECT_4K) && (size >= MTD_4K) &&
+             ((addr & MTD_4K_ADDR_MASK) == 0)) {
+        /* 4 KiB sectors can be erased with sector erase command */
+        mtd_spi_cmd_addr_write(dev, dev->params->opcode->sector_erase, addr_be, NULL, 0);
+        *us = dev->params->wait_4k_erase;
+        return MTD_4K;
+    }
+    else {
+        mtd_spi_cmd_addr_write(dev, dev->params->opcode->block_erase, addr_be, NULL, 0);
+        *us = dev->params->wait_sector_erase;
+        return sector_size;
+    }
+}
+
+#ifdef MODULE_MTD_SPI_NOR_ERASE_AHEAD
+static void _erase_ahead_handler(event_t *ev)
+{
+    mtd_spi_nor_t *dev = container_of(ev, mtd_spi_nor_t, ahead_ev);
+    uint8_t status;
+
+    mutex_lock(&dev->lock);
+    mtd_spi_acquire(dev);
+    mtd_spi_cmd_read(dev, dev->params->opcode->rdsr, &status, sizeof(status));
+
+    if (status & SR_WIP) {
+        event_timeout_set(&dev->ahead_timeout, MTD_ERASE_POLL_US);
+    }
+    else {
+        /* the unit in progress is done */
+        if (dev->erased_end != dev->ahead_addr) {
+            dev->erased_addr = dev->ahead_addr;
+        }
+        dev->ahead_addr += dev->ahead_unit;
+        dev->erased_end = dev->ahead_addr;
+
+        if (dev->ahead_addr < dev->ahead_end) {
+            uint32_t us;
+            dev->ahead_unit = mtd_spi_nor_erase_unit(dev, dev->ahead_addr,
+                                                     dev->ahead_end - dev->ahead_addr,
+                                                     &us);
+            event_timeout_set(&dev->ahead_timeout, us);
+        }
+        else {
+            DEBUG("mtd_spi_nor: erase ahead done up to 0x%" PRIx32 "\n",
+                  dev->ahead_end);
+            dev->ahead_busy = false;
+        }
+    }
+    mtd_spi_release(dev);
+    mutex_unlock(&dev->lock);
+}
+
+/**
+ * @internal
+ * @brief Get exclusive access to the device, waits until a background
+ *        erase is finished
+ */
+static void _ahead_lock(mtd_spi_nor_t *dev)
+{
+    mutex_lock(&dev->lock);
+    while (dev->ahead_busy) {
+        mutex_unlock(&dev->lock);
+#if MODULE_XTIMER
+        xtimer_usleep(MTD_ERASE_POLL_US);
+#else
+        thread_yield();
+#endif
+        mutex_lock(&dev->lock);
+    }
+}
+
+static void _ahead_unlock(mtd_spi_nor_t *dev)
+{
+    mutex_unlock(&dev->lock);
+}
+
+/**
+ * @internal
+ * @brief Drop the range touched by a write from the erased range
+ */
+static void _ahead_written(mtd_spi_nor_t *dev, uint32_t addr)
+{
+    if ((addr < dev->erased_addr) || (addr >= dev->erased_end)) {
+        return;
+    }
+    uint32_t sector_size = dev->base.page_size * dev->base.pages_per_sector;
+    uint32_t sector = addr - (addr % sector_size);
+    if (sector == dev->erased_addr) {
+        dev->erased_addr = sector + sector_size;
+    }
+    else {
+        dev->erased_end = sector;
+    }
+}
+
+int mtd_spi_nor_erase_ahead(mtd_spi_nor_t *dev, uint32_t addr, uint32_t size)
+{
+    mtd_dev_t *mtd = &dev->base;
+    uint32_t sector_size = mtd->page_size * mtd->pages_per_sector;
+    uint32_t total_size = sector_size * mtd->sector_count;
+
+    if ((addr % sector_size) || (size % sector_size) || (addr + size > total_size)) {
+        return -EOVERFLOW;
+    }
+
+    mutex_lock(&dev->lock);
+    if (dev->ahead_busy && (addr == dev->ahead_end)) {
+        /* continue the running erase */
+        dev->ahead_end += size;
+        mutex_unlock(&dev->lock);
+        return 0;
+    }
+    mutex_unlock(&dev->lock);
+
+    _ahead_lock(dev);
+    /* skip what is already erased */
+    if ((addr >= dev->erased_addr) && (addr < dev->erased_end)) {
+        uint32_t skip = dev->erased_end - addr;
+        if (skip >= size) {
+            _ahead_unlock(dev);
+            return 0;
+        }
+        addr += skip;
+        size -= skip;
+    }
+
+    uint32_t us;
+    mtd_spi_acquire(dev);
+    dev->ahead_addr = addr;
+    dev->ahead_end = addr + size;
+    dev->ahead_unit = mtd_spi_nor_erase_unit(dev, addr, size, &us);
+    dev->ahead_busy = true;
+    mtd_spi_release(dev);
+
+    dev->ahead_ev.handler = _erase_ahead_handler;
+    event_timeout_init(&dev->ahead_timeout, EVENT_PRIO_LOWEST, &dev->ahead_ev);
+    event_timeout_set(&dev->ahead_timeout, us);
+    _ahead_unlock(dev);
+
+    return 0;
+}
+#else
+static inline void _ahead_lock(mtd_spi_nor_t *dev) { (void)dev; }
+static inline void _ahead_unlock(mtd_spi_nor_t *dev) { (void)dev; }
+static inline void _ahead_written(mtd_spi_nor_t *dev, uint32_t addr)
+{
+    (void)dev;
+    (void)addr;
+}
+#endif
+
 static int mtd_spi_nor_init(mtd_dev_t *mtd)
 {
     DEBUG("mtd_spi_nor_init: %p\n", (void *)mtd);
@@ -382,9 +753,28 @@ static int mtd_spi_nor_init(mtd_dev_t *mtd)
         return -EINVAL;
     }
 
-    /* CS */
-    DEBUG("mtd_spi_nor_init: CS init\n");
-    spi_init_cs(dev->params->spi, dev->params->cs);
+#ifdef MODULE_MTD_SPI_NOR_ERASE_AHEAD
+    mutex_init(&dev->lock);
+    dev->ahead_busy = false;
+    dev->erased_addr = 0;
+    dev->erased_end = 0;
+#endif
+
+#ifdef MODULE_PERIPH_QSPI
+    if (_use_qspi(dev)) {
+        DEBUG("mtd_spi_nor_init: QSPI configure\n");
+        qspi_configure(dev->params->qspi, QSPI_MODE_0,
+                       (dev->params->addr_width == 4) ? QSPI_FMT_ADDR_LEN_4
+                                                     : QSPI_FMT_ADDR_LEN_3,
+                       dev->params->qspi_clk);
+    }
+    else
+#endif
+    {
+        /* CS */
+        DEBUG("mtd_spi_nor_init: CS init\n");
+        spi_init_cs(dev->params->spi, dev->params->cs);
+    }
 
     /* power up the MTD device*/
     DEBUG("mtd_spi_nor_init: power up MTD device");
@@ -420,6 +810,16 @@ static int mtd_spi_nor_init(mtd_dev_t *mtd)
 
     uint8_t status;
     mtd_spi_cmd_read(dev, dev->params->opcode->rdsr, &status, sizeof(status));
+
+    /* the quad I/O opcodes need the WP and HOLD pins as data lines */
+    if (_use_qspi(dev) && (dev->params->flag & SPI_NOR_F_QE_SR_BIT6) &&
+        !(status & SR_QE_BIT6)) {
+        DEBUG("mtd_spi_nor_init: enable quad mode\n");
+        status |= SR_QE_BIT6;
+        mtd_spi_cmd(dev, dev->params->opcode->wren);
+        mtd_spi_cmd_write(dev, dev->params->opcode->wrsr, &status, sizeof(status));
+        wait_for_write_complete(dev, 0);
+    }
     mtd_spi_release(dev);
 
     DEBUG("mtd_spi_nor_init: device status = 0x%02x\n", (unsigned int)status);
@@ -463,7 +863,7 @@ static int mtd_spi_nor_read(mtd_dev_t *mtd, void *dest, uint32_t addr, uint32_t
 {
     DEBUG("mtd_spi_nor_read: %p, %p, 0x%" PRIx32 ", 0x%" PRIx32 "\n",
           (void *)mtd, dest, addr, size);
-    const mtd_spi_nor_t *dev = (mtd_spi_nor_t *)mtd;
+    mtd_spi_nor_t *dev = (mtd_spi_nor_t *)mtd;
     size_t chipsize = mtd->page_size * mtd->pages_per_sector * mtd->sector_count;
     if (addr > chipsize) {
         return -EOVERFLOW;
@@ -476,9 +876,11 @@ static int mtd_spi_nor_read(mtd_dev_t *mtd, void *dest, uint32_t addr, uint32_t
     }
     be_uint32_t addr_be = byteorder_htonl(addr);
 
+    _ahead_lock(dev);
     mtd_spi_acquire(dev);
-    mtd_spi_cmd_addr_read(dev, dev->params->opcode->read, addr_be, dest, size);
+    mtd_spi_cmd_addr_read(dev, _read_opcode(dev), addr_be, dest, size);
     mtd_spi_release(dev);
+    _ahead_unlock(dev);
 
     return 0;
 }
@@ -492,7 +894,7 @@ static int mtd_spi_nor_write(mtd_dev_t *mtd, const void *src, uint32_t addr, uin
     if (size == 0) {
         return 0;
     }
-    const mtd_spi_nor_t *dev = (mtd_spi_nor_t *)mtd;
+    mtd_spi_nor_t *dev = (mtd_spi_nor_t *)mtd;
     if (size > mtd->page_size) {
         DEBUG("mtd_spi_nor_write: ERR: page program >1 page (%" PRIu32 ")!\n", mtd->page_size);
         return -EOVERFLOW;
@@ -507,17 +909,20 @@ static int mtd_spi_nor_write(mtd_dev_t *mtd, const void *src, uint32_t addr, uin
     }
     be_uint32_t addr_be = byteorder_htonl(addr);
 
+    _ahead_lock(dev);
+    _ahead_written(dev, addr);
     mtd_spi_acquire(dev);
     /* write enable */
     mtd_spi_cmd(dev, dev->params->opcode->wren);
 
     /* Page program */
-    mtd_spi_cmd_addr_write(dev, dev->params->opcode->page_program, addr_be, src, size);
+    mtd_spi_cmd_addr_write(dev, _program_opcode(dev), addr_be, src, size);
 
     /* waiting for the command to complete before returning */
     wait_for_write_complete(dev, 0);
 
     mtd_spi_release(dev);
+    _ahead_unlock(dev);
     return 0;
 }
 
@@ -545,45 +950,27 @@ static int mtd_spi_nor_erase(mtd_dev_t *mtd, uint32_t addr, uint32_t size)
         return -EOVERFLOW;
     }
 
+    _ahead_lock(dev);
+#ifdef MODULE_MTD_SPI_NOR_ERASE_AHEAD
+    if ((addr >= dev->erased_addr) && (addr + size <= dev->erased_end)) {
+        DEBUG("mtd_spi_nor_erase: already erased ahead\n");
+        _ahead_unlock(dev);
+        return 0;
+    }
+#endif
+
     mtd_spi_acquire(dev);
     while (size) {
         uint32_t us;
-        be_uint32_t addr_be = byteorder_htonl(addr);
-        /* write enable */
-        mtd_spi_cmd(dev, dev->params->opcode->wren);
-
-        if (size == total_size) {
-            mtd_spi_cmd(dev, dev->params->opcode->chip_erase);
-            size -= total_size;
-            us = dev->params->wait_chip_erase;
-        }
-        else if ((dev->params->flag & SPI_NOR_F_SECT_32K) && (size >= MTD_32K) &&
-                 ((addr & MTD_32K_ADDR_MASK) == 0)) {
-            /* 32 KiB blocks can be erased with block erase command */
-            mtd_spi_cmd_addr_write(dev, dev->params->opcode->block_erase_32k, addr_be, NULL, 0);
-            addr += MTD_32K;
-            size -= MTD_32K;
-            us = dev->params->wait_32k_erase;
-        }
-        else if ((dev->params->flag & SPI_NOR_F_SECT_4K) && (size >= MTD_4K) &&
-                 ((addr & MTD_4K_ADDR_MASK) == 0)) {
-            /* 4 KiB sectors can be erased with sector erase command */
-            mtd_spi_cmd_addr_write(dev, dev->params->opcode->sector_erase, addr_be, NULL, 0);
-            addr += MTD_4K;
-            size -= MTD_4K;
-            us = dev->params->wait_4k_erase;
-        }
-        else {
-            mtd_spi_cmd_addr_write(dev, dev->params->opcode->block_erase, addr_be, NULL, 0);
-            addr += sector_size;
-            size -= sector_size;
-            us = dev->params->wait_sector_erase;
-        }
+        uint32_t unit = mtd_spi_nor_erase_unit(dev, addr, size, &us);
+        addr += unit;
+        size -= unit;
 
         /* waiting for the command to complete before continuing */
-        wait_for_write_complete(dev, us);
+        wait_for_erase_complete(dev, us);
     }
     mtd_spi_release(dev);
+    _ahead_unlock(dev);
 
     return 0;
 }
@@ -592,6 +979,7 @@ static int mtd_spi_nor_power(mtd_dev_t *mtd, enum mtd_power_state power)
 {
     mtd_spi_nor_t *dev = (mtd_spi_nor_t *)mtd;
 
+    _ahead_lock(dev);
     mtd_spi_acquire(dev);
     switch (power) {
         case MTD_POWER_UP:
@@ -607,6 +995,8 @@ static int mtd_spi_nor_power(mtd_dev_t *mtd, enum mtd_power_state power)
                 retries++;
             } while (res < 0 || retries < MTD_POWER_UP_WAIT_FOR_ID);
             if (res < 0) {
+                mtd_spi_release(dev);
+                _ahead_unlock(dev);
                 return -EIO;
             }
 #endif
@@ -616,6 +1006,20 @@ static int mtd_spi_nor_power(mtd_dev_t *mtd, enum mtd_power_state power)
             break;
     }
     mtd_spi_release(dev);
+    _ahead_unlock(dev);
 
     return 0;
 }
+
+const void *mtd_spi_nor_mmap(const mtd_spi_nor_t *dev)
+{
+#ifdef MODULE_PERIPH_QSPI
+    if (_use_qspi(dev)) {
+        uint8_t opcode = _read_opcode(dev);
+        return qspi_mmap(dev->params->qspi, opcode, _qspi_lanes(opcode));
+    }
+#else
+    (void)dev;
+#endif
+    return NULL;
+}
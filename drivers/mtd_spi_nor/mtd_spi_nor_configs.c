@@ -33,7 +33,9 @@ const mtd_spi_nor_opcode_t mtd_spi_nor_opcode_default = {
     .wrsr            = 0x01,
     .read            = 0x03,
     .read_fast       = 0x0b,
+    .read_quad       = 0xeb,
     .page_program    = 0x02,
+    .page_program_quad = 0x38,
     .sector_erase    = 0x20,
     .block_erase_32k = 0x52,
     .block_erase     = 0xd8,
@@ -49,7 +51,9 @@ const mtd_spi_nor_opcode_t mtd_spi_nor_opcode_default_4bytes = {
     .wrsr            = 0x01,
     .read            = 0x13,
     .read_fast       = 0x0c,
+    .read_quad       = 0xec,
     .page_program    = 0x12,
+    .page_program_quad = 0x3e,
     .sector_erase    = 0x21,
     .block_erase_32k = 0x5c,
     .block_erase     = 0xdc,
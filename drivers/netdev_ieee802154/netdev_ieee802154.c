@@ -45,6 +45,10 @@ void netdev_ieee802154_reset(netdev_ieee802154_t *dev)
     /* Initialize PAN ID and call netdev::set to propagate it */
     dev->pan = CONFIG_IEEE802154_DEFAULT_PANID;
     dev->netdev.driver->set(&dev->netdev, NETOPT_NID, &dev->pan, sizeof(dev->pan));
+
+#if IS_USED(MODULE_IEEE802154_SECURITY)
+    ieee802154_sec_init(&dev->sec_ctx);
+#endif
 }
 
 static inline uint16_t _get_ieee802154_pdu(netdev_ieee802154_t *dev)
@@ -160,8 +164,26 @@ int netdev_ieee802154_get(netdev_ieee802154_t *dev, netopt_t opt, void *value,
             *((uint16_t *)value) = (_get_ieee802154_pdu(dev)
                                     - IEEE802154_MAX_HDR_LEN)
                                     - IEEE802154_FCS_LEN;
+#if IS_USED(MODULE_IEEE802154_SECURITY)
+            if (dev->flags & NETDEV_IEEE802154_SECURITY_EN) {
+                *((uint16_t *)value) -= IEEE802154_SEC_MAX_AUX_HDR_LEN
+                                        + IEEE802154_SEC_MAX_MIC_LEN;
+            }
+#endif
             res = sizeof(uint16_t);
             break;
+#if IS_USED(MODULE_IEEE802154_SECURITY)
+        case NETOPT_ENCRYPTION:
+            assert(max_len == sizeof(netopt_enable_t));
+            if (dev->flags & NETDEV_IEEE802154_SECURITY_EN) {
+                *((netopt_enable_t *)value) = NETOPT_ENABLE;
+            }
+            else {
+                *((netopt_enable_t *)value) = NETOPT_DISABLE;
+            }
+            res = sizeof(netopt_enable_t);
+            break;
+#endif
         default:
             break;
     }
@@ -237,6 +259,27 @@ int netdev_ieee802154_set(netdev_ieee802154_t *dev, netopt_t opt, const void *va
             }
             res = sizeof(uint16_t);
             break;
+#if IS_USED(MODULE_IEEE802154_SECURITY)
+        case NETOPT_ENCRYPTION:
+            if ((*(bool *)value)) {
+                dev->flags |= NETDEV_IEEE802154_SECURITY_EN;
+            }
+            else {
+                dev->flags &= ~NETDEV_IEEE802154_SECURITY_EN;
+            }
+            res = sizeof(netopt_enable_t);
+            break;
+        case NETOPT_ENCRYPTION_KEY:
+            if (len != IEEE802154_SEC_BLOCK_SIZE) {
+                res = -EINVAL;
+                break;
+            }
+            res = ieee802154_sec_set_key(&dev->sec_ctx, 1, value);
+            if (res == 0) {
+                res = len;
+            }
+            break;
+#endif
 #ifdef MODULE_GNRC
         case NETOPT_PROTO:
             assert(len == sizeof(gnrc_nettype_t));
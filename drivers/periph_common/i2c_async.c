@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for more
+ * details.
+ */
+
+/**
+ * @ingroup     drivers_periph_i2c
+ * @{
+ *
+ * @file
+ * @brief       Asynchronous I2C transactions executed by a worker thread
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#ifdef MODULE_PERIPH_I2C_ASYNC
+
+#include <assert.h>
+
+#include "event.h"
+#include "kernel_defines.h"
+#include "periph/i2c.h"
+#include "thread.h"
+
+static event_queue_t _queue;
+static char _stack[CONFIG_I2C_ASYNC_STACKSIZE];
+
+static void _execute(event_t *event)
+{
+    i2c_async_xfer_t *xfer = container_of(event, i2c_async_xfer_t, super);
+
+    i2c_acquire(xfer->dev);
+    switch (xfer->op) {
+    case I2C_ASYNC_READ_BYTES:
+        xfer->res = i2c_read_bytes(xfer->dev, xfer->addr, xfer->data,
+                                   xfer->len, xfer->flags);
+        break;
+    case I2C_ASYNC_WRITE_BYTES:
+        xfer->res = i2c_write_bytes(xfer->dev, xfer->addr, xfer->data,
+                                    xfer->len, xfer->flags);
+        break;
+    case I2C_ASYNC_READ_REGS:
+        xfer->res = i2c_read_regs(xfer->dev, xfer->addr, xfer->reg,
+                                  xfer->data, xfer->len, xfer->flags);
+        break;
+    case I2C_ASYNC_WRITE_REGS:
+        xfer->res = i2c_write_regs(xfer->dev, xfer->addr, xfer->reg,
+                                   xfer->data, xfer->len, xfer->flags);
+        break;
+    }
+    i2c_release(xfer->dev);
+
+    if (xfer->done) {
+        event_post(xfer->done_queue, xfer->done);
+    }
+}
+
+static void *_thread(void *arg)
+{
+    (void)arg;
+
+    event_queue_claim(&_queue);
+    event_loop(&_queue);
+
+    return NULL;
+}
+
+void i2c_async_init(void)
+{
+    event_queue_init_detached(&_queue);
+    thread_create(_stack, sizeof(_stack), CONFIG_I2C_ASYNC_PRIO, 0,
+                  _thread, NULL, "i2c_async");
+}
+
+void i2c_transfer_async(i2c_async_xfer_t *xfer)
+{
+    assert(xfer->dev < I2C_NUMOF);
+    assert(!xfer->done || xfer->done_queue);
+
+    xfer->super.handler = _execute;
+    event_post(&_queue, &xfer->super);
+}
+
+#endif /* MODULE_PERIPH_I2C_ASYNC */
@@ -29,6 +29,9 @@
 #ifdef MODULE_PERIPH_INIT_SPI
 #include "periph/spi.h"
 #endif
+#ifdef MODULE_PERIPH_INIT_QSPI
+#include "periph/qspi.h"
+#endif
 #ifdef MODULE_PERIPH_INIT_RTC
 #include "periph/rtc.h"
 #endif
@@ -63,6 +66,13 @@ void periph_init(void)
     }
 #endif
 
+    /* initialize configured QSPI devices */
+#ifdef MODULE_PERIPH_INIT_QSPI
+    for (unsigned i = 0; i < QSPI_NUMOF; i++) {
+        qspi_init(QSPI_DEV(i));
+    }
+#endif
+
     /* Initialize RTT before RTC to allow for RTT based RTC implementations */
 #ifdef MODULE_PERIPH_INIT_RTT
     rtt_init();
@@ -19,10 +19,12 @@
  *
  * @}
  */
+#include <assert.h>
 #include <stddef.h>
 
 #include "board.h"
 #include "cpu.h"
+#include "irq.h"
 #include "periph/spi.h"
 
 #ifdef SPI_NUMOF
@@ -70,4 +72,86 @@ void spi_transfer_regs(spi_t bus, spi_cs_t cs,
 }
 #endif
 
+/**
+ * @brief   Transfer currently executed on each bus
+ */
+static spi_async_xfer_t *_async_active[SPI_NUMOF];
+
+/**
+ * @brief   Transfers waiting for the active one to finish on each bus
+ */
+static spi_async_xfer_t *_async_pending[SPI_NUMOF];
+
+static bool _async_start(spi_t bus, spi_async_xfer_t *xfer)
+{
+#ifdef PERIPH_SPI_HAS_TRANSFER_ASYNC
+    return spi_async_start(bus, xfer);
+#else
+    spi_transfer_bytes(bus, xfer->cs, xfer->cont, xfer->out, xfer->in,
+                       xfer->len);
+    return false;
+#endif
+}
+
+static spi_async_xfer_t *_async_finish(spi_t bus, spi_async_xfer_t *xfer)
+{
+    /* the finished transfer stays active while the callback runs, so that
+     * transfers queued from within the callback are only appended */
+    if (xfer->cb) {
+        xfer->cb(xfer->arg);
+    }
+
+    unsigned state = irq_disable();
+    xfer = _async_pending[bus];
+    if (xfer) {
+        _async_pending[bus] = xfer->next;
+    }
+    _async_active[bus] = xfer;
+    irq_restore(state);
+
+    return xfer;
+}
+
+static void _async_run(spi_t bus, spi_async_xfer_t *xfer)
+{
+    /* transfers that completed synchronously are finished right here, the
+     * others continue from spi_async_done() */
+    while (xfer && !_async_start(bus, xfer)) {
+        xfer = _async_finish(bus, xfer);
+    }
+}
+
+void spi_transfer_async(spi_t bus, spi_async_xfer_t *xfer)
+{
+    assert(bus < SPI_NUMOF);
+    assert(xfer->out || xfer->in);
+
+    xfer->next = NULL;
+
+    unsigned state = irq_disable();
+    bool idle = (_async_active[bus] == NULL);
+    if (idle) {
+        _async_active[bus] = xfer;
+    }
+    else {
+        spi_async_xfer_t **tail = &_async_pending[bus];
+        while (*tail) {
+            tail = &(*tail)->next;
+        }
+        *tail = xfer;
+    }
+    irq_restore(state);
+
+    if (idle) {
+        _async_run(bus, xfer);
+    }
+}
+
+#ifdef PERIPH_SPI_HAS_TRANSFER_ASYNC
+void spi_async_done(spi_t bus)
+{
+    _async_run(bus, _async_finish(bus, _async_active[bus]));
+}
+#endif
+
 #endif /* SPI_NUMOF */
@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for more
+ * details.
+ */
+
+/**
+ * @ingroup     drivers_periph_timer
+ * @{
+ *
+ * @file
+ * @brief       Input capture of a timer by GPIO interrupts
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#if defined(MODULE_PERIPH_TIMER_CAPTURE) && \
+    !defined(PERIPH_TIMER_PROVIDES_CAPTURE)
+
+#include <assert.h>
+
+#include "periph/timer.h"
+
+static void _on_edge(void *arg)
+{
+    timer_capture_t *cap = arg;
+
+    timer_capture_push(cap, timer_read(cap->dev));
+}
+
+int timer_capture_init(timer_capture_t *cap, tim_t dev, gpio_t pin,
+                       gpio_mode_t mode, gpio_flank_t flank,
+                       unsigned int *buf, unsigned size)
+{
+    assert(size && !(size & (size - 1)));
+
+    cap->buf = buf;
+    cap->mask = size - 1;
+    cap->head = 0;
+    cap->tail = 0;
+    cap->lost = 0;
+    cap->dev = dev;
+    cap->pin = pin;
+    return gpio_init_int(pin, mode, flank, _on_edge, cap);
+}
+
+void timer_capture_stop(timer_capture_t *cap)
+{
+    gpio_irq_disable(cap->pin);
+}
+
+#endif /* MODULE_PERIPH_TIMER_CAPTURE && !PERIPH_TIMER_PROVIDES_CAPTURE */
@@ -64,6 +64,7 @@ int sdcard_spi_init(sdcard_spi_t *card, const sdcard_spi_params_t *params)
     sd_init_fsm_state_t state = SD_INIT_START;
     card->params = *params;
     card->spi_clk = SD_CARD_SPI_SPEED_PREINIT;
+    card->stream_cmd = 0;
 
     do {
         state = _init_sd_fsm_step(card, state);
@@ -570,6 +571,18 @@ static inline int _transfer_bytes(sdcard_spi_t *card, const uint8_t *out, uint8_
     unsigned trans_bytes = 0;
     uint8_t in_temp;
 
+    /* once the card runs on the hardware SPI the whole buffer is handed to
+       the peripheral driver at once, which lets it use DMA where available */
+    if ((_dyn_spi_rxtx_byte == &_hw_spi_rxtx_byte) && (in != NULL || out != NULL)) {
+        if (out == NULL) {
+            /* the card expects MOSI to stay high while it sends data */
+            memset(in, SD_CARD_DUMMY_BYTE, length);
+            out = in;
+        }
+        spi_transfer_bytes(card->params.spi_dev, GPIO_UNDEF, true, out, in, length);
+        return length;
+    }
+
     for (trans_bytes = 0; trans_bytes < length; trans_bytes++) {
         if (out != NULL) {
             trans_ret = _dyn_spi_rxtx_byte(card, out[trans_bytes], &in_temp);
@@ -629,6 +642,23 @@ static sd_rw_response_t _read_data_packet(sdcard_spi_t *card, uint8_t token, uin
     return SD_RW_RX_TX_ERROR;
 }
 
+static int _read_packets(sdcard_spi_t *card, uint8_t *data, int blsz, int nbl,
+                        sd_rw_response_t *state)
+{
+    int reads = 0;
+
+    for (int i = 0; i < nbl; i++) {
+        *state = _read_data_packet(card, SD_DATA_TOKEN_CMD_17_18_24, &(data[i * blsz]), blsz);
+
+        if (*state != SD_RW_OK) {
+            DEBUG("_read_packets: _read_data_packet: [FAILED]\n");
+            return reads;
+        }
+        reads++;
+    }
+    return reads;
+}
+
 static inline int _read_blocks(sdcard_spi_t *card, int cmd_idx, int bladdr, uint8_t *data, int blsz,
                                int nbl, sd_rw_response_t *state)
 {
@@ -641,17 +671,11 @@ static inline int _read_blocks(sdcard_spi_t *card, int cmd_idx, int bladdr, uint
     if (R1_VALID(cmd_r1_resu) && !R1_ERROR(cmd_r1_resu)) {
         DEBUG("_read_blocks: send CMD%d: [OK]\n", cmd_idx);
 
-        for (int i = 0; i < nbl; i++) {
-            *state = _read_data_packet(card, SD_DATA_TOKEN_CMD_17_18_24, &(data[i * blsz]), blsz);
-
-            if (*state != SD_RW_OK) {
-                DEBUG("_read_blocks: _read_data_packet: [FAILED]\n");
-                _unselect_card_spi(card);
-                return reads;
-            }
-            else {
-                reads++;
-            }
+        reads = _read_packets(card, data, blsz, nbl, state);
+        if (*state != SD_RW_OK) {
+            DEBUG("_read_blocks: _read_packets: [FAILED]\n");
+            _unselect_card_spi(card);
+            return reads;
         }
 
         /* if this was a multi-block read */
@@ -684,6 +708,8 @@ static inline int _read_blocks(sdcard_spi_t *card, int cmd_idx, int bladdr, uint
 int sdcard_spi_read_blocks(sdcard_spi_t *card, int blockaddr, uint8_t *data, int blocksize,
                            int nblocks, sd_rw_response_t *state)
 {
+    sdcard_spi_stream_close(card);
+
     if (nblocks > 1) {
         return _read_blocks(card, SD_CMD_18, blockaddr, data, blocksize, nblocks, state);
     }
@@ -745,6 +771,44 @@ static sd_rw_response_t _write_data_packet(sdcard_spi_t *card, uint8_t token, co
     }
 }
 
+static int _write_packets(sdcard_spi_t *card, uint8_t token, const uint8_t *data, int blsz,
+                         int nbl, sd_rw_response_t *state)
+{
+    int written = 0;
+
+    for (int i = 0; i < nbl; i++) {
+        sd_rw_response_t write_resu = _write_data_packet(card, token, &(data[i * blsz]), blsz);
+        if (write_resu != SD_RW_OK) {
+            DEBUG("_write_packets: _write_data_packet: [FAILED]\n");
+            *state = write_resu;
+            return written;
+        }
+        if (!_wait_for_not_busy(card, SD_WAIT_FOR_NOT_BUSY_CNT)) {
+            DEBUG("_write_packets: _wait_for_not_busy: [FAILED]\n");
+            *state = SD_RW_TIMEOUT;
+            return written;
+        }
+        written++;
+    }
+
+    *state = SD_RW_OK;
+    return written;
+}
+
+static sd_rw_response_t _write_stop(sdcard_spi_t *card)
+{
+    spi_transfer_byte(card->params.spi_dev, GPIO_UNDEF, true,
+                      SD_DATA_TOKEN_CMD_25_STOP);
+
+    /* sd card needs dummy byte before we can wait for not-busy
+       state */
+    _send_dummy_byte(card);
+    if (!_wait_for_not_busy(card, SD_WAIT_FOR_NOT_BUSY_CNT)) {
+        return SD_RW_TIMEOUT;
+    }
+    return SD_RW_OK;
+}
+
 static inline int _write_blocks(sdcard_spi_t *card, uint8_t cmd_idx, int bladdr, const uint8_t *data, int blsz,
                                 int nbl, sd_rw_response_t *state)
 {
@@ -757,7 +821,7 @@ static inline int _write_blocks(sdcard_spi_t *card, uint8_t cmd_idx, int bladdr,
     if (R1_VALID(cmd_r1_resu) && !R1_ERROR(cmd_r1_resu)) {
         DEBUG("_write_blocks: send CMD%d: [OK]\n", cmd_idx);
 
-        int token;
+        uint8_t token;
         if (cmd_idx == SD_CMD_25) {
             token = SD_DATA_TOKEN_CMD_25;
         }
@@ -765,41 +829,21 @@ static inline int _write_blocks(sdcard_spi_t *card, uint8_t cmd_idx, int bladdr,
             token = SD_DATA_TOKEN_CMD_17_18_24;
         }
 
-        for (int i = 0; i < nbl; i++) {
-            sd_rw_response_t write_resu = _write_data_packet(card, token, &(data[i * blsz]), blsz);
-            if (write_resu != SD_RW_OK) {
-                DEBUG("_write_blocks: _write_data_packet: [FAILED]\n");
-                _unselect_card_spi(card);
-                *state = write_resu;
-                return written;
-            }
-            if (!_wait_for_not_busy(card, SD_WAIT_FOR_NOT_BUSY_CNT)) {
-                DEBUG("_write_blocks: _wait_for_not_busy: [FAILED]\n");
-                _unselect_card_spi(card);
-                *state = SD_RW_TIMEOUT;
-                return written;
-            }
-            written++;
+        written = _write_packets(card, token, data, blsz, nbl, state);
+        if (*state != SD_RW_OK) {
+            DEBUG("_write_blocks: _write_packets: [FAILED]\n");
+            _unselect_card_spi(card);
+            return written;
         }
 
         /* if this is a multi-block write it is needed to issue a stop
            command */
         if (cmd_idx == SD_CMD_25) {
-            spi_transfer_byte(card->params.spi_dev, GPIO_UNDEF, true,
-                              SD_DATA_TOKEN_CMD_25_STOP);
             DEBUG("_write_blocks: write multi (%d) blocks: [OK]\n", nbl);
-
-            /* sd card needs dummy byte before we can wait for not-busy
-               state */
-            _send_dummy_byte(card);
-            if (!_wait_for_not_busy(card, SD_WAIT_FOR_NOT_BUSY_CNT)) {
-                _unselect_card_spi(card);
-                *state = SD_RW_TIMEOUT;
-            }
+            *state = _write_stop(card);
         }
         else {
             DEBUG("_write_blocks: write single block: [OK]\n");
-            *state = SD_RW_OK;
         }
 
         _unselect_card_spi(card);
@@ -816,6 +860,8 @@ static inline int _write_blocks(sdcard_spi_t *card, uint8_t cmd_idx, int bladdr,
 int sdcard_spi_write_blocks(sdcard_spi_t *card, int blockaddr, const uint8_t *data, int blocksize,
                             int nblocks, sd_rw_response_t *state)
 {
+    sdcard_spi_stream_close(card);
+
     if (nblocks > 1) {
         return _write_blocks(card, SD_CMD_25, blockaddr, data, blocksize, nblocks, state);
     }
@@ -824,6 +870,108 @@ int sdcard_spi_write_blocks(sdcard_spi_t *card, int blockaddr, const uint8_t *da
     }
 }
 
+static bool _stream_open(sdcard_spi_t *card, uint8_t cmd_idx, int bladdr, int erase_hint)
+{
+    uint8_t cmd_r1_resu;
+
+    if (erase_hint > 1) {
+        /* ACMD23 only pre-erases, a failure there is not fatal */
+        cmd_r1_resu = sdcard_spi_send_acmd(card, SD_CMD_23, erase_hint, 0);
+        DEBUG("_stream_open: ACMD23 (%d): 0x%02x\n", erase_hint, cmd_r1_resu);
+    }
+
+    uint32_t addr = card->use_block_addr ? bladdr : (bladdr * SD_HC_BLOCK_SIZE);
+    cmd_r1_resu = sdcard_spi_send_cmd(card, cmd_idx, addr, (cmd_idx == SD_CMD_25)
+                                      ? SD_BLOCK_WRITE_CMD_RETRIES : SD_BLOCK_READ_CMD_RETRIES);
+
+    if (R1_VALID(cmd_r1_resu) && !R1_ERROR(cmd_r1_resu)) {
+        DEBUG("_stream_open: send CMD%d: [OK]\n", cmd_idx);
+        card->stream_cmd = cmd_idx;
+        card->stream_next = bladdr;
+        return true;
+    }
+
+    DEBUG("_stream_open: send CMD%d: [RX_TX_ERROR]\n", cmd_idx);
+    return false;
+}
+
+int sdcard_spi_read_stream(sdcard_spi_t *card, int blockaddr, uint8_t *data, int blocksize,
+                           int nblocks, sd_rw_response_t *state)
+{
+    if ((card->stream_cmd != SD_CMD_18) || (card->stream_next != blockaddr)) {
+        sdcard_spi_stream_close(card);
+        _select_card_spi(card);
+        if (!_stream_open(card, SD_CMD_18, blockaddr, 0)) {
+            _unselect_card_spi(card);
+            *state = SD_RW_RX_TX_ERROR;
+            return 0;
+        }
+    }
+    else {
+        _select_card_spi(card);
+    }
+
+    int reads = _read_packets(card, data, blocksize, nblocks, state);
+    card->stream_next += reads;
+    _unselect_card_spi(card);
+
+    if (*state != SD_RW_OK) {
+        sdcard_spi_stream_close(card);
+    }
+    return reads;
+}
+
+int sdcard_spi_write_stream(sdcard_spi_t *card, int blockaddr, const uint8_t *data, int blocksize,
+                            int nblocks, int erase_hint, sd_rw_response_t *state)
+{
+    if ((card->stream_cmd != SD_CMD_25) || (card->stream_next != blockaddr)) {
+        sdcard_spi_stream_close(card);
+        _select_card_spi(card);
+        if (!_stream_open(card, SD_CMD_25, blockaddr, erase_hint)) {
+            _unselect_card_spi(card);
+            *state = SD_RW_RX_TX_ERROR;
+            return 0;
+        }
+    }
+    else {
+        _select_card_spi(card);
+    }
+
+    int written = _write_packets(card, SD_DATA_TOKEN_CMD_25, data, blocksize, nblocks, state);
+    card->stream_next += written;
+    _unselect_card_spi(card);
+
+    if (*state != SD_RW_OK) {
+        sdcard_spi_stream_close(card);
+    }
+    return written;
+}
+
+sd_rw_response_t sdcard_spi_stream_close(sdcard_spi_t *card)
+{
+    sd_rw_response_t state = SD_RW_OK;
+
+    if (card->stream_cmd == 0) {
+        return state;
+    }
+
+    _select_card_spi(card);
+    if (card->stream_cmd == SD_CMD_25) {
+        state = _write_stop(card);
+    }
+    else {
+        uint8_t cmd_r1_resu = sdcard_spi_send_cmd(card, SD_CMD_12, 0, 1);
+        if (!R1_VALID(cmd_r1_resu) || R1_ERROR(cmd_r1_resu)) {
+            state = SD_RW_RX_TX_ERROR;
+        }
+    }
+    _unselect_card_spi(card);
+
+    DEBUG("sdcard_spi_stream_close: CMD%d session closed (%d)\n", card->stream_cmd, state);
+    card->stream_cmd = 0;
+    return state;
+}
+
 sd_rw_response_t _read_cid(sdcard_spi_t *card)
 {
     uint8_t cid_raw_data[SD_SIZE_OF_CID_AND_CSD_REG];
@@ -951,6 +1099,7 @@ sd_rw_response_t _read_csd(sdcard_spi_t *card)
 }
 
 sd_rw_response_t sdcard_spi_read_sds(sdcard_spi_t *card, sd_status_t *sd_status){
+    sdcard_spi_stream_close(card);
     _select_card_spi(card);
     uint8_t sds_raw_data[SD_SIZE_OF_SD_STATUS];
     uint8_t r1_resu = sdcard_spi_send_cmd(card, SD_CMD_55, SD_CMD_NO_ARG, 0);
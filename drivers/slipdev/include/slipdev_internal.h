@@ -79,6 +79,28 @@ static inline void slipdev_write_byte(uart_t uart, uint8_t byte)
  */
 void slipdev_write_bytes(uart_t uart, const uint8_t *data, size_t len);
 
+/**
+ * @brief   Decodes a received byte into the RX buffer of a slipdev
+ *
+ * This is the UART RX callback of the per byte interrupt path.
+ *
+ * @param[in] arg   The slipdev_t the byte was received by.
+ * @param[in] byte  The received byte.
+ */
+void slipdev_rx_byte(void *arg, uint8_t byte);
+
+/**
+ * @brief   Decodes a chunk of received bytes into the RX buffer of a slipdev
+ *
+ * This is the callback of the `periph_uart_dma` RX path. It has the same
+ * result as passing every byte of @p data to slipdev_rx_byte().
+ *
+ * @param[in] arg   The slipdev_t the bytes were received by.
+ * @param[in] data  The received bytes.
+ * @param[in] len   Number of bytes in @p data.
+ */
+void slipdev_rx_chunk(void *arg, const uint8_t *data, size_t len);
+
 /**
  * @brief   Unstuffs a (SLIP-escaped) byte.
  *
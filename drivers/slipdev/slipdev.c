@@ -44,33 +44,174 @@ static inline void slipdev_unlock(void)
     }
 }
 
-static void _slip_rx_cb(void *arg, uint8_t byte)
+#define WORD_ONES   (0x01010101UL)
+#define WORD_HIGHS  (0x80808080UL)
+
+static inline bool _word_has(uint32_t word, uint8_t byte)
 {
-    slipdev_t *dev = arg;
+    word ^= WORD_ONES * byte;
+    return ((word - WORD_ONES) & ~word & WORD_HIGHS) != 0;
+}
 
-    if (IS_USED(MODULE_SLIPDEV_STDIO)) {
-        if (dev->state == SLIPDEV_STATE_STDIN) {
-            isrpipe_write_one(&slipdev_stdio_isrpipe, byte);
-            goto check_end;
+static inline bool _is_special(uint8_t byte)
+{
+    return (byte == SLIPDEV_END) || (byte == SLIPDEV_ESC);
+}
+
+/* number of leading bytes that need no escaping, checks a word at a time */
+static size_t _plain_run(const uint8_t *data, size_t len)
+{
+    size_t i = 0;
+
+    while ((i < len) && ((uintptr_t)&data[i] & (sizeof(uint32_t) - 1))) {
+        if (_is_special(data[i])) {
+            return i;
         }
-        else if ((byte == SLIPDEV_STDIO_START) &&
-            (dev->config.uart == STDIO_UART_DEV) &&
-            (dev->state == SLIPDEV_STATE_NONE)) {
-            dev->state = SLIPDEV_STATE_STDIN;
-            return;
+        i++;
+    }
+    for (; (i + sizeof(uint32_t)) <= len; i += sizeof(uint32_t)) {
+        uint32_t word;
+
+        memcpy(&word, &data[i], sizeof(word));
+        if (_word_has(word, SLIPDEV_END) || _word_has(word, SLIPDEV_ESC)) {
+            break;
         }
     }
+    while ((i < len) && !_is_special(data[i])) {
+        i++;
+    }
+    return i;
+}
+
+static void _rx_frame_start(slipdev_t *dev)
+{
     dev->state = SLIPDEV_STATE_NET;
-    tsrb_add_one(&dev->inbuf, byte);
-check_end:
-    if (byte == SLIPDEV_END) {
-        if (dev->state == SLIPDEV_STATE_NET) {
-            netdev_trigger_event_isr((netdev_t*) dev);
+    dev->rx_start = dev->inbuf.writes;
+    dev->rx_esc = false;
+    dev->rx_drop = false;
+}
+
+static void _rx_put(slipdev_t *dev, const uint8_t *data, size_t len)
+{
+    if (dev->rx_drop) {
+        return;
+    }
+    if (tsrb_add(&dev->inbuf, data, len) != (int)len) {
+        /* remove what was stored of the frame */
+        dev->inbuf.writes = dev->rx_start;
+        dev->rx_drop = true;
+    }
+}
+
+static void _rx_frame_end(slipdev_t *dev)
+{
+    unsigned len = dev->inbuf.writes - dev->rx_start;
+    int idx;
+
+    dev->state = SLIPDEV_STATE_NONE;
+    if (dev->rx_drop || (len == 0)) {
+        return;
+    }
+    if ((len > UINT16_MAX) || ((idx = cib_put(&dev->rx_frames)) < 0)) {
+        DEBUG("slipdev: dropping frame of %u bytes\n", len);
+        dev->inbuf.writes = dev->rx_start;
+        return;
+    }
+    dev->rx_lens[idx] = len;
+    netdev_trigger_event_isr((netdev_t*) dev);
+}
+
+void slipdev_rx_byte(void *arg, uint8_t byte)
+{
+    slipdev_t *dev = arg;
+
+    switch (dev->state) {
+        case SLIPDEV_STATE_STDIN:
+            if (IS_USED(MODULE_SLIPDEV_STDIO)) {
+                isrpipe_write_one(&slipdev_stdio_isrpipe, byte);
+                if (byte == SLIPDEV_END) {
+                    dev->state = SLIPDEV_STATE_NONE;
+                }
+            }
+            return;
+        case SLIPDEV_STATE_NONE:
+            if (IS_USED(MODULE_SLIPDEV_STDIO) &&
+                (byte == SLIPDEV_STDIO_START) &&
+                (dev->config.uart == STDIO_UART_DEV)) {
+                dev->state = SLIPDEV_STATE_STDIN;
+                return;
+            }
+            if (byte == SLIPDEV_END) {
+                /* empty frame */
+                return;
+            }
+            _rx_frame_start(dev);
+            break;
+        default:
+            break;
+    }
+
+    switch (byte) {
+        case SLIPDEV_END:
+            _rx_frame_end(dev);
+            return;
+        case SLIPDEV_ESC:
+            dev->rx_esc = true;
+            return;
+        case SLIPDEV_END_ESC:
+            if (dev->rx_esc) {
+                byte = SLIPDEV_END;
+            }
+            break;
+        case SLIPDEV_ESC_ESC:
+            if (dev->rx_esc) {
+                byte = SLIPDEV_ESC;
+            }
+            break;
+    }
+    dev->rx_esc = false;
+    _rx_put(dev, &byte, 1);
+}
+
+void slipdev_rx_chunk(void *arg, const uint8_t *data, size_t len)
+{
+    slipdev_t *dev = arg;
+
+    while (len) {
+        size_t run = 0;
+
+        /* pass bytes that need no decoding on in one go, only the marker
+         * bytes and the byte following an ESC go through the state machine */
+        if ((dev->state != SLIPDEV_STATE_NONE) && !dev->rx_esc &&
+            (run = _plain_run(data, len))) {
+            if (dev->state == SLIPDEV_STATE_NET) {
+                _rx_put(dev, data, run);
+            }
+            else if (IS_USED(MODULE_SLIPDEV_STDIO)) {
+                isrpipe_write(&slipdev_stdio_isrpipe, data, run);
+            }
+        }
+        else {
+            slipdev_rx_byte(dev, *data);
+            run = 1;
         }
-        dev->state = SLIPDEV_STATE_NONE;
+        data += run;
+        len -= run;
     }
 }
 
+#ifdef MODULE_PERIPH_UART_DMA
+static int _init_rx_dma(slipdev_t *dev)
+{
+    if (uart_init(dev->config.uart, dev->config.baudrate, NULL,
+                  NULL) != UART_OK) {
+        return -ENODEV;
+    }
+    return uart_rx_dma_start(dev->config.uart, dev->rx_dma_buf,
+                             sizeof(dev->rx_dma_buf), slipdev_rx_chunk, dev);
+}
+#endif
+
 static int _init(netdev_t *netdev)
 {
     slipdev_t *dev = (slipdev_t *)netdev;
@@ -79,7 +220,14 @@ static int _init(netdev_t *netdev)
           (void *)dev, dev->config.uart, dev->config.baudrate);
     /* initialize buffers */
     tsrb_init(&dev->inbuf, dev->rxmem, sizeof(dev->rxmem));
-    if (uart_init(dev->config.uart, dev->config.baudrate, _slip_rx_cb,
+    cib_init(&dev->rx_frames, CONFIG_SLIPDEV_RX_FRAMES);
+#ifdef MODULE_PERIPH_UART_DMA
+    /* prefer chunked DMA reception, fall back to per byte interrupts */
+    if (_init_rx_dma(dev) == UART_OK) {
+        return 0;
+    }
+#endif
+    if (uart_init(dev->config.uart, dev->config.baudrate, slipdev_rx_byte,
                   dev) != UART_OK) {
         LOG_ERROR("slipdev: error initializing UART %i with baudrate %" PRIu32 "\n",
                   dev->config.uart, dev->config.baudrate);
@@ -90,21 +238,23 @@ static int _init(netdev_t *netdev)
 
 void slipdev_write_bytes(uart_t uart, const uint8_t *data, size_t len)
 {
-    for (unsigned j = 0; j < len; j++, data++) {
-        switch (*data) {
-            case SLIPDEV_END:
-                /* escaping END byte*/
-                slipdev_write_byte(uart, SLIPDEV_ESC);
-                slipdev_write_byte(uart, SLIPDEV_END_ESC);
-                break;
-            case SLIPDEV_ESC:
-                /* escaping ESC byte*/
-                slipdev_write_byte(uart, SLIPDEV_ESC);
-                slipdev_write_byte(uart, SLIPDEV_ESC_ESC);
-                break;
-            default:
-                slipdev_write_byte(uart, *data);
+    while (len) {
+        /* bytes that need no escaping are written in one go */
+        size_t run = _plain_run(data, len);
+
+        if (run) {
+            uart_write(uart, data, run);
+        }
+        if (run == len) {
+            break;
         }
+        uint8_t esc[2] = {
+            SLIPDEV_ESC,
+            (data[run] == SLIPDEV_END) ? SLIPDEV_END_ESC : SLIPDEV_ESC_ESC,
+        };
+        uart_write(uart, esc, sizeof(esc));
+        data += run + 1;
+        len -= run + 1;
     }
 }
 
@@ -163,58 +313,38 @@ static int _send(netdev_t *netdev, const iolist_t *iolist)
 static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
 {
     slipdev_t *dev = (slipdev_t *)netdev;
-    int res = 0;
+    int idx = cib_peek(&dev->rx_frames);
 
     (void)info;
-    if (buf == NULL) {
-        if (len > 0) {
-            /* remove data */
-            for (; len > 0; len--) {
-                int byte = tsrb_get_one(&dev->inbuf);
-                if ((byte == (int)SLIPDEV_END) || (byte < 0)) {
-                    /* end early if end of packet or ringbuffer is reached;
-                     * len might be larger than the actual packet */
-                    break;
-                }
-            }
-        } else {
-            /* the user was warned not to use a buffer size > `INT_MAX` ;-) */
-            res = (int)tsrb_avail(&dev->inbuf);
-        }
+    if (idx < 0) {
+        return (buf == NULL && len == 0) ? 0 : -EIO;
     }
-    else {
-        int byte;
-        bool escaped = false;
-        uint8_t *ptr = buf;
-
-        do {
-            int tmp;
 
-            if ((byte = tsrb_get_one(&dev->inbuf)) < 0) {
-                /* something went wrong, return error */
-                return -EIO;
-            }
-            tmp = slipdev_unstuff_readbyte(ptr, byte, &escaped);
-            ptr += tmp;
-            res += tmp;
-            if ((unsigned)res > len) {
-                while (byte != SLIPDEV_END) {
-                    /* clear out unreceived packet */
-                    byte = tsrb_get_one(&dev->inbuf);
-                }
-                return -ENOBUFS;
-            }
-        } while (byte != SLIPDEV_END);
+    /* frames are stored unescaped, so they are copied out in one go */
+    unsigned size = dev->rx_lens[idx];
+    if ((buf == NULL) && (len == 0)) {
+        return size;
     }
-    return res;
+    cib_get(&dev->rx_frames);
+    if ((buf == NULL) || (size > len)) {
+        tsrb_drop(&dev->inbuf, size);
+        return (buf == NULL) ? (int)size : -ENOBUFS;
+    }
+    tsrb_get(&dev->inbuf, buf, size);
+    return size;
 }
 
 static void _isr(netdev_t *netdev)
 {
+    slipdev_t *dev = (slipdev_t *)netdev;
+
     DEBUG("slipdev: handling ISR event\n");
     if (netdev->event_callback != NULL) {
-        DEBUG("slipdev: event handler set, issuing RX_COMPLETE event\n");
-        netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
+        DEBUG("slipdev: event handler set, issuing RX_COMPLETE events\n");
+        /* one event per frame received so far */
+        for (unsigned n = cib_avail(&dev->rx_frames); n; n--) {
+            netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
+        }
     }
 }
 
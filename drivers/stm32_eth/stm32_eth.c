@@ -37,6 +37,13 @@ int stm32_eth_init(void);
 int stm32_eth_receive_blocking(char *data, unsigned max_len);
 int stm32_eth_send(const struct iolist *iolist);
 int stm32_eth_get_rx_status_owned(void);
+#ifdef MODULE_NETDEV_RX_ZEROCOPY
+int stm32_eth_rx_buf_give(char *buf, unsigned size);
+int stm32_eth_recv_zc(unsigned *idx);
+
+/* buffers lent to the DMA descriptor of the same index */
+static netdev_rx_buf_t *_rx_bufs[ETH_RX_BUFFER_COUNT];
+#endif
 
 static void _isr(netdev_t *netdev) {
     if(stm32_eth_get_rx_status_owned()) {
@@ -79,6 +86,36 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
     return ret;
 }
 
+#ifdef MODULE_NETDEV_RX_ZEROCOPY
+static int _rx_buf_give(netdev_t *netdev, netdev_rx_buf_t *buf)
+{
+    (void)netdev;
+    int idx = stm32_eth_rx_buf_give(buf->data, buf->size);
+
+    if (idx < 0) {
+        return idx;
+    }
+    _rx_bufs[idx] = buf;
+    return 0;
+}
+
+static int _recv_zc(netdev_t *netdev, netdev_rx_buf_t **buf, void *info)
+{
+    (void)netdev;
+    (void)info;
+    unsigned idx;
+    int ret = stm32_eth_recv_zc(&idx);
+
+    if (ret != 0) {
+        *buf = _rx_bufs[idx];
+        _rx_bufs[idx] = NULL;
+    }
+    DEBUG("stm32_eth_netdev: _recv_zc: %d\n", ret);
+
+    return ret;
+}
+#endif
+
 static int _send(netdev_t *netdev, const struct iolist *iolist)
 {
     (void)netdev;
@@ -127,6 +164,14 @@ static int _get(netdev_t *dev, netopt_t opt, void *value, size_t max_len)
             stm32_eth_get_mac((char *)value);
             res = ETHERNET_ADDR_LEN;
             break;
+#ifdef MODULE_NETDEV_RX_ZEROCOPY
+        case NETOPT_RX_BUF_SIZE:
+            assert(max_len == sizeof(uint16_t));
+            /* the DMA descriptors are set up for buffers of this size */
+            *((uint16_t *)value) = ETH_RX_BUFFER_SIZE;
+            res = sizeof(uint16_t);
+            break;
+#endif
         default:
             res = netdev_eth_get(dev, opt, value, max_len);
             break;
@@ -148,6 +193,10 @@ static const netdev_driver_t netdev_driver_stm32f4eth = {
     .isr = _isr,
     .get = _get,
     .set = _set,
+#ifdef MODULE_NETDEV_RX_ZEROCOPY
+    .rx_buf_give = _rx_buf_give,
+    .recv_zc = _recv_zc,
+#endif
 };
 
 void stm32_eth_netdev_setup(netdev_t *netdev)
@@ -41,6 +41,47 @@ extern "C" {
 #endif
 /** @} */
 
+/**
+ * @name    Properties of the SPI backend.
+ * @{
+ */
+#ifdef MODULE_WS281X_SPI
+#define WS281X_HAVE_INIT                    (1)
+#define WS281X_HAVE_PREPARE_TRANSMISSION    (1)
+#define WS281X_HAVE_END_TRANSMISSION        (1)
+#endif
+
+/**
+ * @brief   SPI clock used to encode the data bits
+ */
+#ifndef WS281X_SPI_CLK
+#define WS281X_SPI_CLK                      (SPI_CLK_5MHZ)
+#endif
+
+/**
+ * @brief   SPI byte sent for a zero bit, 400 ns high at 5 MHz
+ */
+#ifndef WS281X_SPI_ZERO
+#define WS281X_SPI_ZERO                     (0xc0)
+#endif
+
+/**
+ * @brief   SPI byte sent for a one bit, 800 ns high at 5 MHz
+ */
+#ifndef WS281X_SPI_ONE
+#define WS281X_SPI_ONE                      (0xf0)
+#endif
+
+/**
+ * @brief   Number of color bytes encoded into one SPI transfer
+ *
+ * Two buffers of eight times this size are part of the device descriptor.
+ */
+#ifndef WS281X_SPI_CHUNK_SIZE
+#define WS281X_SPI_CHUNK_SIZE               (12U)
+#endif
+/** @} */
+
 /**
  * @name    Properties of the VT100 terminal backend.
  * @{
@@ -36,6 +36,9 @@ extern "C" {
 #ifndef WS281X_PARAM_NUMOF
 #define WS281X_PARAM_NUMOF              (8U)            /**< Number of LEDs chained */
 #endif
+#ifndef WS281X_PARAM_SPI
+#define WS281X_PARAM_SPI                (SPI_DEV(0))    /**< SPI bus used by the SPI backend */
+#endif
 #ifndef WS281X_PARAM_BUF
 /**
  * @brief   Data buffer holding the LED states
@@ -48,11 +51,20 @@ extern uint8_t ws281x_buf[WS281X_PARAM_NUMOF * WS281X_BYTES_PER_DEVICE];
 /**
  * @brief   WS281x initialization parameters
  */
+#ifdef MODULE_WS281X_SPI
 #define WS281X_PARAMS                   { \
                                             .pin = WS281X_PARAM_PIN,  \
                                             .numof = WS281X_PARAM_NUMOF, \
                                             .buf = WS281X_PARAM_BUF, \
+                                            .spi = WS281X_PARAM_SPI, \
                                         }
+#else
+#define WS281X_PARAMS                   { \
+                                            .pin = WS281X_PARAM_PIN,  \
+                                            .numof = WS281X_PARAM_NUMOF, \
+                                            .buf = WS281X_PARAM_BUF, \
+                                        }
+#endif
 #endif
 /**@}*/
 
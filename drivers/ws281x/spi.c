@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_ws281x
+ *
+ * @{
+ *
+ * @file
+ * @brief       Implementation of `ws281x_write_buffer()` using SPI with DMA
+ *
+ * Every data bit is encoded into one SPI byte, the high time of the bit is
+ * given by the number of leading ones in @ref WS281X_SPI_ZERO and
+ * @ref WS281X_SPI_ONE. As every SPI byte ends low, gaps between the bytes
+ * only stretch the low phase, which the LEDs tolerate up to the reset time.
+ *
+ * The color data is encoded chunk by chunk into two buffers from the
+ * completion callback of the previous chunk, so the CPU is only involved
+ * for encoding and interrupts are never disabled.
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+
+#include "ws281x.h"
+#include "xtimer.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+static size_t _encode(uint8_t *dst, const uint8_t *src, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        uint8_t data = src[i];
+        for (unsigned bit = 0; bit < 8; bit++) {
+            *dst++ = (data & 0x80) ? WS281X_SPI_ONE : WS281X_SPI_ZERO;
+            data <<= 1;
+        }
+    }
+
+    return len * 8;
+}
+
+/* encode the next chunk of color data into the given buffer */
+static size_t _prepare(ws281x_t *dev, unsigned idx)
+{
+    size_t len = dev->end - dev->pos;
+
+    if (len > WS281X_SPI_CHUNK_SIZE) {
+        len = WS281X_SPI_CHUNK_SIZE;
+    }
+    dev->pos += len;
+
+    return _encode(dev->chunk[idx], dev->pos - len, len);
+}
+
+static void _queue(ws281x_t *dev, unsigned idx, size_t len)
+{
+    spi_async_xfer_t *xfer = &dev->xfer[idx];
+
+    xfer->out = dev->chunk[idx];
+    xfer->in = NULL;
+    xfer->len = len;
+    xfer->cs = SPI_CS_UNDEF;
+    xfer->cont = false;
+    xfer->arg = dev;
+
+    spi_transfer_async(dev->params.spi, xfer);
+}
+
+static void _chunk_done(void *arg)
+{
+    ws281x_t *dev = arg;
+    unsigned idx = dev->cur;
+
+    if (dev->next_len == 0) {
+        /* last chunk is out */
+        mutex_unlock(&dev->busy);
+        return;
+    }
+
+    /* the other buffer is already encoded, send it and refill this one */
+    dev->cur = !idx;
+    _queue(dev, dev->cur, dev->next_len);
+    dev->next_len = _prepare(dev, idx);
+}
+
+int ws281x_init(ws281x_t *dev, const ws281x_params_t *params)
+{
+    if (!dev || !params || !params->buf) {
+        return -EINVAL;
+    }
+
+    memset(dev, 0, sizeof(ws281x_t));
+    dev->params = *params;
+    mutex_init(&dev->busy);
+    dev->xfer[0].cb = _chunk_done;
+    dev->xfer[1].cb = _chunk_done;
+
+    return 0;
+}
+
+void ws281x_prepare_transmission(ws281x_t *dev)
+{
+    assert(dev);
+
+    spi_acquire(dev->params.spi, SPI_CS_UNDEF, SPI_MODE_0, WS281X_SPI_CLK);
+}
+
+void ws281x_write_buffer(ws281x_t *dev, const void *buf, size_t size)
+{
+    assert(dev);
+
+    if (size == 0) {
+        return;
+    }
+
+    /* wait for the previous buffer to be sent */
+    mutex_lock(&dev->busy);
+
+    dev->pos = buf;
+    dev->end = dev->pos + size;
+    dev->cur = 0;
+
+    size_t len = _prepare(dev, 0);
+    dev->next_len = _prepare(dev, 1);
+
+    DEBUG("[ws281x] spi: sending %u bytes\n", (unsigned)size);
+    _queue(dev, 0, len);
+}
+
+void ws281x_end_transmission(ws281x_t *dev)
+{
+    assert(dev);
+
+    mutex_lock(&dev->busy);
+    mutex_unlock(&dev->busy);
+
+    xtimer_usleep(WS281X_T_END_US);
+    spi_release(dev->params.spi);
+}
@@ -53,10 +53,10 @@ static const char *_link_params[] = {
 };
 
 static gcoap_listener_t _listener = {
-    &_resources[0],
-    ARRAY_SIZE(_resources),
-    _encode_link,
-    NULL
+    .resources     = &_resources[0],
+    .resources_len = ARRAY_SIZE(_resources),
+    .link_encoder  = _encode_link,
+    .next          = NULL,
 };
 
 /* Retain request path to re-request if response includes block. User must not
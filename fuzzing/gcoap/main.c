@@ -37,22 +37,24 @@ int main(void)
     gnrc_pktsnip_t *ipkt, *upkt, *cpkt;
 
     initialize();
-    if (!(ipkt = gnrc_ipv6_hdr_build(NULL, NULL, &ipv6_addr_loopback))) {
-        errx(EXIT_FAILURE, "gnrc_ipv6_hdr_build failed");
-    }
-    if (!(upkt = gnrc_udp_hdr_build(ipkt, 2342, COAP_PORT))) {
-        errx(EXIT_FAILURE, "gnrc_udp_hdr_build failed");
-    }
-
-    if (!(cpkt = gnrc_pktbuf_add(upkt, NULL, 0, GNRC_NETTYPE_UNDEF))) {
-        errx(EXIT_FAILURE, "gnrc_pktbuf_add failed");
-    }
-    if (fuzzing_read_packet(STDIN_FILENO, cpkt)) {
-        errx(EXIT_FAILURE, "fuzzing_read_packet failed");
-    }
-
-    if (!gnrc_netapi_dispatch_receive(ntype, demux, cpkt)) {
-        errx(EXIT_FAILURE, "couldn't find any subscriber");
+    while (fuzzing_loop()) {
+        if (!(ipkt = gnrc_ipv6_hdr_build(NULL, NULL, &ipv6_addr_loopback))) {
+            errx(EXIT_FAILURE, "gnrc_ipv6_hdr_build failed");
+        }
+        if (!(upkt = gnrc_udp_hdr_build(ipkt, 2342, COAP_PORT))) {
+            errx(EXIT_FAILURE, "gnrc_udp_hdr_build failed");
+        }
+
+        if (!(cpkt = gnrc_pktbuf_add(upkt, NULL, 0, GNRC_NETTYPE_UNDEF))) {
+            errx(EXIT_FAILURE, "gnrc_pktbuf_add failed");
+        }
+        if (fuzzing_read_packet(STDIN_FILENO, cpkt)) {
+            errx(EXIT_FAILURE, "fuzzing_read_packet failed");
+        }
+
+        if (!gnrc_netapi_dispatch_receive(ntype, demux, cpkt)) {
+            errx(EXIT_FAILURE, "couldn't find any subscriber");
+        }
     }
 
     return EXIT_SUCCESS;
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <err.h>
+#include <stdlib.h>
+
+#include "fuzzing.h"
+
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/nettype.h"
+#include "net/gnrc/pkt.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan.h"
+
+static uint32_t demux = GNRC_NETREG_DEMUX_CTX_ALL;
+static gnrc_nettype_t ntype = GNRC_NETTYPE_SIXLOWPAN;
+
+/* link-layer addresses the IPHC addresses of the input corpus refer to */
+static const uint8_t src_l2addr[] = { 0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x01 };
+static const uint8_t dst_l2addr[] = { 0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x02 };
+
+static gnrc_netif_t *initialize(void)
+{
+    if (fuzzing_init(NULL, 0)) {
+        errx(EXIT_FAILURE, "fuzzing_init failed");
+    }
+    if (gnrc_sixlowpan_init() <= KERNEL_PID_UNDEF) {
+        errx(EXIT_FAILURE, "gnrc_sixlowpan_init failed");
+    }
+
+    return gnrc_netif_iter(NULL);
+}
+
+int main(void)
+{
+    gnrc_netif_t *netif;
+    gnrc_pktsnip_t *npkt, *spkt;
+
+    netif = initialize();
+    while (fuzzing_loop()) {
+        if (!(npkt = gnrc_netif_hdr_build(src_l2addr, sizeof(src_l2addr),
+                                          dst_l2addr, sizeof(dst_l2addr)))) {
+            errx(EXIT_FAILURE, "gnrc_netif_hdr_build failed");
+        }
+        gnrc_netif_hdr_set_netif(npkt->data, netif);
+
+        if (!(spkt = gnrc_pktbuf_add(npkt, NULL, 0, ntype))) {
+            errx(EXIT_FAILURE, "gnrc_pktbuf_add failed");
+        }
+        if (fuzzing_read_packet(STDIN_FILENO, spkt)) {
+            errx(EXIT_FAILURE, "fuzzing_read_packet failed");
+        }
+
+        if (!gnrc_netapi_dispatch_receive(ntype, demux, spkt)) {
+            errx(EXIT_FAILURE, "couldn't find any subscriber");
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
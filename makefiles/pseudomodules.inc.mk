@@ -5,10 +5,12 @@ PSEUDOMODULES += at_urc_isr_medium
 PSEUDOMODULES += at_urc_isr_highest
 PSEUDOMODULES += at24c%
 PSEUDOMODULES += base64url
+PSEUDOMODULES += can_fd
 PSEUDOMODULES += can_mbox
 PSEUDOMODULES += can_pm
 PSEUDOMODULES += can_raw
 PSEUDOMODULES += ccn-lite-utils
+PSEUDOMODULES += checksum_slice_by_4
 PSEUDOMODULES += conn_can_isotp_multi
 PSEUDOMODULES += cord_ep_standalone
 PSEUDOMODULES += core_%
@@ -21,16 +23,22 @@ PSEUDOMODULES += dhcpv6_%
 PSEUDOMODULES += ecc_%
 PSEUDOMODULES += emb6_router
 PSEUDOMODULES += event_%
+PSEUDOMODULES += evtimer_on_ztimer
 PSEUDOMODULES += fmt_%
+PSEUDOMODULES += gcoap_workers
 PSEUDOMODULES += gnrc_dhcpv6_%
+PSEUDOMODULES += gnrc_icmpv6_error_rate_limit
 PSEUDOMODULES += gnrc_ipv6_default
 PSEUDOMODULES += gnrc_ipv6_ext_frag_stats
+PSEUDOMODULES += gnrc_ipv6_fwd_thread
 PSEUDOMODULES += gnrc_ipv6_router
 PSEUDOMODULES += gnrc_ipv6_router_default
 PSEUDOMODULES += gnrc_ipv6_nib_6lbr
 PSEUDOMODULES += gnrc_ipv6_nib_6ln
 PSEUDOMODULES += gnrc_ipv6_nib_6lr
 PSEUDOMODULES += gnrc_ipv6_nib_dns
+PSEUDOMODULES += gnrc_ipv6_nib_ft_trie
+PSEUDOMODULES += gnrc_ipv6_nib_nc_hash
 PSEUDOMODULES += gnrc_ipv6_nib_router
 PSEUDOMODULES += gnrc_netdev_default
 PSEUDOMODULES += gnrc_neterr
@@ -39,26 +47,41 @@ PSEUDOMODULES += gnrc_netapi_mbox
 PSEUDOMODULES += gnrc_netif_bus
 PSEUDOMODULES += gnrc_netif_events
 PSEUDOMODULES += gnrc_pktbuf_cmd
+PSEUDOMODULES += gnrc_pktbuf_pressure
 PSEUDOMODULES += gnrc_netif_6lo
 PSEUDOMODULES += gnrc_netif_ipv6
 PSEUDOMODULES += gnrc_netif_mac
 PSEUDOMODULES += gnrc_netif_cmd_%
 PSEUDOMODULES += gnrc_netif_dedup
+PSEUDOMODULES += gnrc_netreg_hash
+PSEUDOMODULES += gnrc_netreg_stats
 PSEUDOMODULES += gnrc_nettype_%
+PSEUDOMODULES += gnrc_priority_pktqueue_heap
+PSEUDOMODULES += gnrc_rpl_dio_filter
+PSEUDOMODULES += gnrc_rpl_srh_cache
+PSEUDOMODULES += gnrc_single_thread
 PSEUDOMODULES += gnrc_sixloenc
 PSEUDOMODULES += gnrc_sixlowpan_border_router_default
 PSEUDOMODULES += gnrc_sixlowpan_default
 PSEUDOMODULES += gnrc_sixlowpan_frag_hint
+PSEUDOMODULES += gnrc_sixlowpan_frag_rb_bitmap
+PSEUDOMODULES += gnrc_sixlowpan_frag_rb_hash
+PSEUDOMODULES += gnrc_sixlowpan_iphc_cache
 PSEUDOMODULES += gnrc_sixlowpan_iphc_nhc
 PSEUDOMODULES += gnrc_sixlowpan_nd_border_router
 PSEUDOMODULES += gnrc_sixlowpan_router
 PSEUDOMODULES += gnrc_sixlowpan_router_default
 PSEUDOMODULES += gnrc_sock_async
 PSEUDOMODULES += gnrc_sock_check_reuse
+PSEUDOMODULES += gnrc_sock_rx_stats
+PSEUDOMODULES += gnrc_tcp_sack
+PSEUDOMODULES += gnrc_udp_fastpath
 PSEUDOMODULES += gnrc_txtsnd
 PSEUDOMODULES += heap_cmd
 PSEUDOMODULES += i2c_scan
+PSEUDOMODULES += ieee802154_security
 PSEUDOMODULES += ina3221_alerts
+PSEUDOMODULES += inet_csum_arch
 PSEUDOMODULES += l2filter_blacklist
 PSEUDOMODULES += l2filter_whitelist
 PSEUDOMODULES += lis2dh12_i2c
@@ -68,11 +91,19 @@ PSEUDOMODULES += log
 PSEUDOMODULES += log_printfnoformat
 PSEUDOMODULES += log_color
 PSEUDOMODULES += lora
+PSEUDOMODULES += memarray_debug
+PSEUDOMODULES += memarray_stats
+PSEUDOMODULES += metrics_cbor
+PSEUDOMODULES += metrics_coap
 PSEUDOMODULES += mpu_stack_guard
 PSEUDOMODULES += mpu_noexec_ram
+PSEUDOMODULES += mtd_spi_nor_erase_ahead
 PSEUDOMODULES += nanocoap_%
+PSEUDOMODULES += native_vtime
 PSEUDOMODULES += netdev_default
 PSEUDOMODULES += netdev_ieee802154_%
+PSEUDOMODULES += netdev_rx_zerocopy
+PSEUDOMODULES += netdev_tx_burst
 PSEUDOMODULES += netstats
 PSEUDOMODULES += netstats_l2
 PSEUDOMODULES += netstats_ipv6
@@ -83,24 +114,40 @@ PSEUDOMODULES += newlib
 PSEUDOMODULES += newlib_gnu_source
 PSEUDOMODULES += newlib_nano
 PSEUDOMODULES += openthread
+PSEUDOMODULES += openthread_gnrc_pktbuf
 PSEUDOMODULES += pktqueue
+PSEUDOMODULES += pm_layered_stats
+PSEUDOMODULES += pm_layered_tickless
 PSEUDOMODULES += posix_headers
 PSEUDOMODULES += printf_float
 PSEUDOMODULES += prng
 PSEUDOMODULES += prng_%
 PSEUDOMODULES += qmc5883l_int
+PSEUDOMODULES += ramfunc_hot
+PSEUDOMODULES += random_pool
 PSEUDOMODULES += riotboot_%
 PSEUDOMODULES += rtt_cmd
 PSEUDOMODULES += saul_adc
+PSEUDOMODULES += saul_batch
 PSEUDOMODULES += saul_default
 PSEUDOMODULES += saul_gpio
 PSEUDOMODULES += saul_nrf_temperature
 PSEUDOMODULES += scanf_float
 PSEUDOMODULES += sched_cb
+PSEUDOMODULES += sched_stack_hwm
+PSEUDOMODULES += schedstatistics_ext
+PSEUDOMODULES += schedstatistics_irq
 PSEUDOMODULES += semtech_loramac_rx
+PSEUDOMODULES += senml_cbor
+PSEUDOMODULES += senml_coap
+PSEUDOMODULES += senml_json
+PSEUDOMODULES += senml_saul
+PSEUDOMODULES += sensor_fusion_mtd_kv
+PSEUDOMODULES += sensor_fusion_saul
 PSEUDOMODULES += slipdev_stdio
 PSEUDOMODULES += sock
 PSEUDOMODULES += sock_async
+PSEUDOMODULES += sock_dns_cache
 PSEUDOMODULES += sock_dtls
 PSEUDOMODULES += sock_ip
 PSEUDOMODULES += sock_tcp
@@ -109,7 +156,10 @@ PSEUDOMODULES += stdin
 PSEUDOMODULES += stdio_ethos
 PSEUDOMODULES += stdio_cdc_acm
 PSEUDOMODULES += stdio_uart_rx
+PSEUDOMODULES += stdio_uart_tx_async
 PSEUDOMODULES += suit_transport_%
+PSEUDOMODULES += trace_events
+PSEUDOMODULES += vfs_async
 PSEUDOMODULES += wakaama_objects_%
 PSEUDOMODULES += wifi_enterprise
 PSEUDOMODULES += xtimer_on_ztimer
@@ -247,6 +297,8 @@ PSEUDOMODULES += ds18_optimized
 PSEUDOMODULES += crypto_aes_precalculated
 # This pseudomodule causes a loop in AES to be unrolled (more flash, less CPU)
 PSEUDOMODULES += crypto_aes_unroll
+# This pseudomodule unrolls the ChaCha rounds (more flash, less CPU)
+PSEUDOMODULES += crypto_chacha_unroll
 
 # declare shell version of test_utils_interactive_sync
 PSEUDOMODULES += test_utils_interactive_sync_shell
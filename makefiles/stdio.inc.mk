@@ -40,6 +40,11 @@ ifneq (,$(filter stdio_uart_rx,$(USEMODULE)))
   USEMODULE += stdio_uart
 endif
 
+ifneq (,$(filter stdio_uart_tx_async,$(USEMODULE)))
+  USEMODULE += stdio_uart
+  FEATURES_OPTIONAL += periph_uart_dma
+endif
+
 ifneq (,$(filter stdio_uart,$(USEMODULE)))
   FEATURES_REQUIRED += periph_uart
 endif
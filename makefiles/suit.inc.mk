@@ -21,6 +21,24 @@ SUIT_NOTIFY_MANIFEST ?= $(APPLICATION)-riot.suitv3_signed.$(SUIT_NOTIFY_VERSION)
 # Long manifest names require more buffer space when parsing
 export CFLAGS += -DCONFIG_SOCK_URLPATH_MAXLEN=128
 
+# Compression of the published slot files, the device has to be built with the
+# matching riotboot_flashwrite_<compression> module. The manifest digest still
+# covers the uncompressed image.
+SUIT_COMPRESSION ?=
+HEATSHRINK ?= heatshrink
+
+ifneq (,$(SUIT_COMPRESSION))
+  SUIT_PAYLOADS ?= $(SLOT0_RIOT_BIN).$(SUIT_COMPRESSION) \
+                   $(SLOT1_RIOT_BIN).$(SUIT_COMPRESSION)
+  SUIT_COMPRESSION_FLAGS = --compression $(SUIT_COMPRESSION)
+else
+  SUIT_PAYLOADS ?= $(SLOT0_RIOT_BIN) $(SLOT1_RIOT_BIN)
+endif
+
+# window and lookahead size must match the decoder configuration
+%.bin.heatshrink: %.bin
+	$(HEATSHRINK) -e -w 8 -l 4 $< $@
+
 SUIT_VENDOR ?= "riot-os.org"
 SUIT_SEQNR ?= $(APP_VER)
 SUIT_CLASS ?= $(BOARD)
@@ -32,6 +50,7 @@ $(SUIT_MANIFEST): $(SLOT0_RIOT_BIN) $(SLOT1_RIOT_BIN)
 	  --seqnr $(SUIT_SEQNR) \
 	  --uuid-vendor $(SUIT_VENDOR) \
 	  --uuid-class $(SUIT_CLASS) \
+	  $(SUIT_COMPRESSION_FLAGS) \
 	  -o $@.tmp \
 	  $(SLOT0_RIOT_BIN):$(SLOT0_OFFSET) \
 	  $(SLOT1_RIOT_BIN):$(SLOT1_OFFSET)
@@ -57,7 +76,7 @@ SUIT_MANIFESTS := $(SUIT_MANIFEST) \
 
 suit/manifest: $(SUIT_MANIFESTS)
 
-suit/publish: $(SUIT_MANIFESTS) $(SLOT0_RIOT_BIN) $(SLOT1_RIOT_BIN)
+suit/publish: $(SUIT_MANIFESTS) $(SUIT_PAYLOADS)
 	@mkdir -p $(SUIT_COAP_FSROOT)/$(SUIT_COAP_BASEPATH)
 	@cp $^ $(SUIT_COAP_FSROOT)/$(SUIT_COAP_BASEPATH)
 	@for file in $^; do \
@@ -0,0 +1,7 @@
+include $(RIOTMAKE)/toolchain/llvm.inc.mk
+
+# afl-clang-fast supports AFL's persistent mode, see fuzzing_loop()
+CC     = afl-clang-fast
+CXX    = afl-clang-fast++
+LINK   = afl-clang-fast
+LINKXX = afl-clang-fast++
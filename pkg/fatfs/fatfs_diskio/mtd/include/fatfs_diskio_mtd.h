@@ -37,6 +37,19 @@ extern "C" {
 #define FATFS_DISKIO_FATTIME_HH_OFFS   (11)
 #define FATFS_DISKIO_FATTIME_MM_OFFS   (5)
 
+/**
+ * @brief   Number of sectors in the write-back cache of the diskio layer
+ *
+ * Single sector writes, e.g. to the FAT or to directory entries, are kept in
+ * the cache and only written to the device when they are evicted or the file
+ * is synced. This turns the FAT update for every cluster of a sequential
+ * write into one write per sync. Each entry takes FF_MAX_SS bytes of RAM.
+ * Set to 0 to disable the cache.
+ */
+#ifndef CONFIG_FATFS_DISKIO_CACHE_SECTORS
+#define CONFIG_FATFS_DISKIO_CACHE_SECTORS   (0)
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -18,11 +18,15 @@
  *
  * @}
  */
+#include <stdbool.h>
+#include <string.h>
+
 #include "fatfs/diskio.h"       /**< FatFs lower layer API */
 #include "fatfs_diskio_mtd.h"
 #include "fatfs/ffconf.h"
 #include "mtd.h"
 #include "fatfs/integer.h"
+#include "kernel_defines.h"
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
@@ -33,6 +37,129 @@
 /* mtd devices for use by FatFs should be provided by the application */
 extern mtd_dev_t *fatfs_mtd_devs[FF_VOLUMES];
 
+static int _read(BYTE pdrv, BYTE *buff, DWORD sector, UINT count)
+{
+    mtd_dev_t *mtd = fatfs_mtd_devs[pdrv];
+
+    return mtd_read(mtd, buff, sector * mtd->page_size, count * mtd->page_size);
+}
+
+static int _write(BYTE pdrv, const BYTE *buff, DWORD sector, UINT count)
+{
+    mtd_dev_t *mtd = fatfs_mtd_devs[pdrv];
+
+    /* erase memory before writing to it */
+    int res = mtd_erase(mtd, sector * mtd->page_size, count * mtd->page_size);
+    if (res != 0) {
+        return res;
+    }
+
+    return mtd_write(mtd, buff, sector * mtd->page_size, count * mtd->page_size);
+}
+
+#if CONFIG_FATFS_DISKIO_CACHE_SECTORS
+typedef struct {
+    DWORD sector;           /* cached sector */
+    BYTE pdrv;              /* drive of the sector */
+    bool valid;             /* entry holds a sector */
+    bool dirty;             /* sector has not been written back yet */
+    unsigned last_use;      /* for LRU replacement */
+} _cache_entry_t;
+
+static _cache_entry_t _cache[CONFIG_FATFS_DISKIO_CACHE_SECTORS];
+static BYTE _cache_buf[CONFIG_FATFS_DISKIO_CACHE_SECTORS][FF_MAX_SS];
+static unsigned _cache_clock;
+
+static int _cache_find(BYTE pdrv, DWORD sector)
+{
+    for (unsigned i = 0; i < ARRAY_SIZE(_cache); i++) {
+        if (_cache[i].valid && _cache[i].pdrv == pdrv &&
+            _cache[i].sector == sector) {
+            _cache[i].last_use = ++_cache_clock;
+            return i;
+        }
+    }
+    return -1;
+}
+
+static int _cache_writeback(unsigned i)
+{
+    if (!_cache[i].dirty) {
+        return 0;
+    }
+
+    DEBUG("disk cache: write back %d, %lu\n", _cache[i].pdrv,
+          (unsigned long)_cache[i].sector);
+    int res = _write(_cache[i].pdrv, _cache_buf[i], _cache[i].sector, 1);
+    if (res == 0) {
+        _cache[i].dirty = false;
+    }
+    return res;
+}
+
+/* get an entry for @p sector, evicting the least recently used one */
+static int _cache_alloc(BYTE pdrv, DWORD sector)
+{
+    unsigned victim = 0;
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_cache); i++) {
+        if (!_cache[i].valid) {
+            victim = i;
+            break;
+        }
+        if ((int)(_cache[i].last_use - _cache[victim].last_use) < 0) {
+            victim = i;
+        }
+    }
+
+    if (_cache[victim].valid && _cache_writeback(victim) != 0) {
+        return -1;
+    }
+
+    _cache[victim].valid = true;
+    _cache[victim].dirty = false;
+    _cache[victim].pdrv = pdrv;
+    _cache[victim].sector = sector;
+    _cache[victim].last_use = ++_cache_clock;
+    return victim;
+}
+
+static DRESULT _cache_sync(BYTE pdrv)
+{
+    DRESULT res = RES_OK;
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_cache); i++) {
+        if (_cache[i].valid && _cache[i].pdrv == pdrv &&
+            _cache_writeback(i) != 0) {
+            res = RES_ERROR;
+        }
+    }
+    return res;
+}
+
+/* copy cached sectors within [sector, sector + count) from or to @p buff */
+static void _cache_overlap(BYTE pdrv, BYTE *buff, DWORD sector, UINT count,
+                           bool to_cache)
+{
+    UINT page_size = fatfs_mtd_devs[pdrv]->page_size;
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_cache); i++) {
+        if (!_cache[i].valid || _cache[i].pdrv != pdrv ||
+            _cache[i].sector < sector || _cache[i].sector >= sector + count) {
+            continue;
+        }
+        BYTE *pos = buff + (_cache[i].sector - sector) * page_size;
+        if (to_cache) {
+            memcpy(_cache_buf[i], pos, page_size);
+            _cache[i].dirty = false;
+        }
+        else {
+            memcpy(pos, _cache_buf[i], page_size);
+        }
+    }
+}
+#endif
+
 /**
  * @brief           returns the status of the disk
  *
@@ -95,15 +222,34 @@ DRESULT disk_read(BYTE pdrv, BYTE *buff, DWORD sector, UINT count)
         return RES_PARERR;
     }
 
-    uint32_t nread = count * fatfs_mtd_devs[pdrv]->page_size;
-    int res = mtd_read(fatfs_mtd_devs[pdrv], buff,
-                       sector * fatfs_mtd_devs[pdrv]->page_size,
-                       nread);
+#if CONFIG_FATFS_DISKIO_CACHE_SECTORS
+    if (count == 1) {
+        UINT page_size = fatfs_mtd_devs[pdrv]->page_size;
+        int i = _cache_find(pdrv, sector);
+        if (i >= 0) {
+            memcpy(buff, _cache_buf[i], page_size);
+            return RES_OK;
+        }
+        if (_read(pdrv, buff, sector, 1) != 0) {
+            return RES_ERROR;
+        }
+        /* FAT and directory sectors are read one by one, keep them */
+        i = _cache_alloc(pdrv, sector);
+        if (i >= 0) {
+            memcpy(_cache_buf[i], buff, page_size);
+        }
+        return RES_OK;
+    }
+#endif
 
-    if (res != 0) {
+    if (_read(pdrv, buff, sector, count) != 0) {
         return RES_ERROR;
     }
-    assert((nread / fatfs_mtd_devs[pdrv]->page_size) == count);
+
+#if CONFIG_FATFS_DISKIO_CACHE_SECTORS
+    /* the cache may hold newer data than the device */
+    _cache_overlap(pdrv, buff, sector, count, false);
+#endif
     return RES_OK;
 }
 
@@ -126,24 +272,29 @@ DRESULT disk_write(BYTE pdrv, const BYTE *buff, DWORD sector, UINT count)
         return RES_PARERR;
     }
 
-    /* erase memory before writing to it */
-    int res = mtd_erase(fatfs_mtd_devs[pdrv],
-                        sector * fatfs_mtd_devs[pdrv]->page_size,
-                        count * fatfs_mtd_devs[pdrv]->page_size);
-
-    if (res != 0) {
-        return RES_ERROR; /* erase failed! */
+#if CONFIG_FATFS_DISKIO_CACHE_SECTORS
+    if (count == 1) {
+        int i = _cache_find(pdrv, sector);
+        if (i < 0) {
+            i = _cache_alloc(pdrv, sector);
+        }
+        if (i < 0) {
+            return RES_ERROR;
+        }
+        memcpy(_cache_buf[i], buff, fatfs_mtd_devs[pdrv]->page_size);
+        _cache[i].dirty = true;
+        return RES_OK;
     }
+#endif
 
-    uint32_t nwrite = count * fatfs_mtd_devs[pdrv]->page_size;
-    res = mtd_write(fatfs_mtd_devs[pdrv], buff,
-                    sector * fatfs_mtd_devs[pdrv]->page_size,
-                    nwrite);
-
-    if (res != 0) {
+    if (_write(pdrv, buff, sector, count) != 0) {
         return RES_ERROR;
     }
-    assert((nwrite / fatfs_mtd_devs[pdrv]->page_size) == count);
+
+#if CONFIG_FATFS_DISKIO_CACHE_SECTORS
+    /* cached copies of the written sectors are now outdated */
+    _cache_overlap(pdrv, (BYTE *)buff, sector, count, true);
+#endif
     return RES_OK;
 }
 
@@ -167,9 +318,13 @@ DRESULT disk_ioctl(BYTE pdrv, BYTE cmd, void *buff)
     switch (cmd) {
 #if (FF_FS_READONLY == 0)
         case CTRL_SYNC:
+#if CONFIG_FATFS_DISKIO_CACHE_SECTORS
+            return _cache_sync(pdrv);
+#else
             /* r/w is always finished within r/w-functions of mtd */
             return RES_OK;
 #endif
+#endif
 
 #if (FF_USE_MKFS == 1)
         case GET_SECTOR_COUNT:
@@ -255,6 +255,54 @@ static off_t _lseek(vfs_file_t *filp, off_t off, int whence)
     return fatfs_err_to_errno(res);
 }
 
+static int _preallocate(FIL *fp, FSIZE_t len)
+{
+    FSIZE_t pos = f_tell(fp);
+    FRESULT res;
+
+#if FF_USE_EXPAND
+    /* f_expand() allocates a contiguous chain, which only works on a file
+     * that has no clusters yet */
+    if ((f_size(fp) == 0) && (pos == 0)) {
+        res = f_expand(fp, len, 1);
+        if (res != FR_DENIED) {
+            return fatfs_err_to_errno(res);
+        }
+    }
+#endif
+
+    /* seeking beyond the end of a file opened for writing extends the
+     * cluster chain and the file size, as VFS_F_PREALLOCATE allows */
+    res = f_lseek(fp, pos + len);
+    if (res != FR_OK) {
+        return fatfs_err_to_errno(res);
+    }
+    if (f_tell(fp) != pos + len) {
+        /* the volume is full */
+        f_lseek(fp, pos);
+        return -ENOSPC;
+    }
+
+    return fatfs_err_to_errno(f_lseek(fp, pos));
+}
+
+static int _fcntl(vfs_file_t *filp, int cmd, int arg)
+{
+    fatfs_file_desc_t *fd = (fatfs_file_desc_t *)filp->private_data.buffer;
+
+    switch (cmd) {
+        case VFS_F_PREALLOCATE:
+            if (arg < 0) {
+                return -EINVAL;
+            }
+            return _preallocate(&fd->file, arg);
+        case VFS_F_TRUNCATE:
+            return fatfs_err_to_errno(f_truncate(&fd->file));
+        default:
+            return -EINVAL;
+    }
+}
+
 static int _fstat(vfs_file_t *filp, struct stat *buf)
 {
     fatfs_file_desc_t *fd = (fatfs_file_desc_t *)filp->private_data.buffer;
@@ -272,7 +320,9 @@ static int _fstat(vfs_file_t *filp, struct stat *buf)
         return fatfs_err_to_errno(res);
     }
 
-    buf->st_size = fi.fsize;
+    /* the directory entry is only updated on sync, the open file knows the
+     * current size */
+    buf->st_size = f_size(&fd->file);
 
     /* set last modification timestamp */
 #ifdef SYS_STAT_H
@@ -456,6 +506,7 @@ static const vfs_file_ops_t fatfs_file_ops = {
     .read = _read,
     .write = _write,
     .lseek = _lseek,
+    .fcntl = _fcntl,
     .fstat = _fstat,
 };
 
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+/**
+ * @ingroup  pkg_flatbuffers
+ * @{
+ * @file
+ *
+ * @brief   FlatBuffers allocator placing the builder buffer in the GNRC
+ *          packet buffer
+ * @author  ML!PA Consulting GmbH
+ *
+ * The builder fills its buffer from the back, the finished message is handed
+ * to gnrc_sock_udp_send_buf() without copying it:
+ *
+ * ~~~~~~~~~~~~~~~~ {.cpp}
+ * riot::pktbuf_allocator alloc;
+ * flatbuffers::FlatBufferBuilder fbb(128, &alloc);
+ * ...
+ * fbb.Finish(root);
+ * gnrc_pktsnip_t *snip = alloc.release(fbb);
+ * if (snip) {
+ *     gnrc_sock_udp_send_buf(&sock, snip, &remote);
+ * }
+ * ~~~~~~~~~~~~~~~~
+ *
+ * FlatBuffers has no way to handle failed allocations, so an exhausted packet
+ * buffer while building is fatal. Choose the initial size of the builder
+ * large enough for the message to avoid reallocations.
+ */
+
+#ifndef FLATBUFFERS_PKTBUF_HPP
+#define FLATBUFFERS_PKTBUF_HPP
+
+#include "flatbuffers/flatbuffers.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/sock/udp.h"
+#include "panic.h"
+
+namespace riot {
+
+/**
+ * @brief   FlatBuffers allocator using GNRC packet buffer snips
+ */
+class pktbuf_allocator : public flatbuffers::Allocator {
+public:
+    /**
+     * @brief   Allocate the builder buffer as a packet buffer snip
+     */
+    uint8_t *allocate(size_t size) override
+    {
+        gnrc_pktsnip_t *snip;
+        void *buf = gnrc_sock_udp_alloc_buf(size, &snip);
+
+        if (buf == nullptr) {
+            core_panic(PANIC_GENERAL_ERROR, "flatbuffers: pktbuf full");
+        }
+        /* while growing, the old buffer is freed after the new one was
+         * allocated */
+        m_prev = m_snip;
+        m_snip = snip;
+        return static_cast<uint8_t *>(buf);
+    }
+
+    /**
+     * @brief   Release a builder buffer, unless it was taken by release()
+     */
+    void deallocate(uint8_t *p, size_t size) override
+    {
+        (void)size;
+
+        if (m_prev && (p == m_prev->data)) {
+            gnrc_pktbuf_release(m_prev);
+            m_prev = nullptr;
+        }
+        else if (m_snip && (p == m_snip->data)) {
+            gnrc_pktbuf_release(m_snip);
+            m_snip = nullptr;
+        }
+    }
+
+    /**
+     * @brief   Take the finished message out of the builder
+     *
+     * The unused front of the buffer is split off and released, the message
+     * stays where the builder wrote it. The builder must be reset or
+     * destroyed before it is used again.
+     *
+     * @param[in]   fbb     builder that finished a message with this allocator
+     *
+     * @return  snip holding the message, ownership is passed to the caller
+     * @return  nullptr if the packet buffer is full
+     */
+    gnrc_pktsnip_t *release(flatbuffers::FlatBufferBuilder &fbb)
+    {
+        gnrc_pktsnip_t *snip = m_snip;
+        size_t front = fbb.GetBufferPointer() -
+                       static_cast<uint8_t *>(snip->data);
+
+        if (front > 0) {
+            gnrc_pktsnip_t *unused = gnrc_pktbuf_mark(snip, front,
+                                                      GNRC_NETTYPE_UNDEF);
+            if (unused == nullptr) {
+                return nullptr;
+            }
+            snip = gnrc_pktbuf_remove_snip(snip, unused);
+        }
+        /* the builder's buffer is not ours to free any more */
+        m_snip = nullptr;
+        return snip;
+    }
+
+    ~pktbuf_allocator()
+    {
+        if (m_snip) {
+            gnrc_pktbuf_release(m_snip);
+        }
+    }
+
+private:
+    gnrc_pktsnip_t *m_snip = nullptr;
+    gnrc_pktsnip_t *m_prev = nullptr;
+};
+
+} // namespace riot
+
+#endif /* FLATBUFFERS_PKTBUF_HPP */
+/** @} */
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     pkg_jerryscript
+ * @{
+ *
+ * @file
+ * @brief       RIOT integration of the JerryScript engine
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "jerry_riot.h"
+#include "thread.h"
+
+#ifdef MODULE_JERRYSCRIPT_TLSF
+static uint32_t _heap[JERRY_RIOT_HEAPSIZE_KB * 1024 / sizeof(uint32_t)];
+static tlsf_arena_t _arena;
+#endif
+
+/* empty table if the application has no snapshots */
+__attribute__((weak)) const jerry_riot_snapshot_t jerry_riot_snapshots[1];
+__attribute__((weak)) const size_t jerry_riot_snapshots_numof;
+
+void jerry_riot_init(void)
+{
+#ifdef MODULE_JERRYSCRIPT_TLSF
+    if (_arena.tlsf == NULL) {
+        tlsf_arena_init(&_arena, "jerryscript", _heap, sizeof(_heap));
+    }
+    tlsf_arena_bind(thread_getpid(), &_arena);
+#endif
+    jerry_init(JERRY_INIT_EMPTY);
+}
+
+void jerry_riot_cleanup(void)
+{
+    jerry_cleanup();
+#ifdef MODULE_JERRYSCRIPT_TLSF
+    tlsf_arena_bind(thread_getpid(), NULL);
+#endif
+}
+
+jerry_value_t jerry_riot_exec_snapshot(const char *name)
+{
+    for (size_t i = 0; i < jerry_riot_snapshots_numof; i++) {
+        const jerry_riot_snapshot_t *snap = &jerry_riot_snapshots[i];
+
+        if (strcmp(snap->name, name) == 0) {
+            /* without JERRY_SNAPSHOT_EXEC_COPY_DATA, the byte code is
+             * referenced in place */
+            return jerry_exec_snapshot(snap->data, snap->size, 0, 0);
+        }
+    }
+    return jerry_create_error(JERRY_ERROR_REFERENCE,
+                              (const jerry_char_t *)"no such snapshot");
+}
+
+#ifdef MODULE_JERRYSCRIPT_TLSF
+void jerry_riot_heap_stats(tlsf_arena_stats_t *stats)
+{
+    tlsf_arena_get_stats(&_arena, stats);
+}
+#endif
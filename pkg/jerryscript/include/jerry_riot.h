@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+/**
+ * @ingroup  pkg_jerryscript
+ * @{
+ * @file
+ *
+ * @brief   RIOT integration of the JerryScript engine
+ * @author  ML!PA Consulting GmbH
+ *
+ * With the `jerryscript-tlsf` module, the engine heap is a TLSF arena of
+ * `JERRYHEAP` KiB that is bound to the thread running the engine. Memory is
+ * then only taken when objects are created and the usage shows up in the
+ * `heap` shell command.
+ *
+ * Scripts listed in `JERRY_SNAPSHOTS` are compiled to snapshots at build time
+ * and can be executed with jerry_riot_exec_snapshot() without parsing them on
+ * the device.
+ */
+
+#ifndef JERRY_RIOT_H
+#define JERRY_RIOT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "jerryscript.h"
+#ifdef MODULE_JERRYSCRIPT_TLSF
+#include "tlsf-malloc.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Size of the engine heap in KiB, set by `JERRYHEAP`
+ */
+#ifndef JERRY_RIOT_HEAPSIZE_KB
+#define JERRY_RIOT_HEAPSIZE_KB      (16)
+#endif
+
+/**
+ * @brief   Snapshot generated at build time
+ */
+typedef struct {
+    const char *name;           /**< script file name without `.js` */
+    const uint32_t *data;       /**< snapshot, kept in flash */
+    size_t size;                /**< size of the snapshot in bytes */
+} jerry_riot_snapshot_t;
+
+/**
+ * @brief   Snapshots of the scripts in `JERRY_SNAPSHOTS`
+ */
+extern const jerry_riot_snapshot_t jerry_riot_snapshots[];
+
+/**
+ * @brief   Number of entries in @ref jerry_riot_snapshots
+ */
+extern const size_t jerry_riot_snapshots_numof;
+
+/**
+ * @brief   Initialize the engine in the calling thread
+ *
+ * With `jerryscript-tlsf`, the thread is bound to the engine arena, which is
+ * created on the first call. The engine must only be used by this thread.
+ */
+void jerry_riot_init(void);
+
+/**
+ * @brief   Release all engine resources, the counterpart of jerry_riot_init()
+ */
+void jerry_riot_cleanup(void);
+
+/**
+ * @brief   Execute a snapshot generated at build time
+ *
+ * The byte code is executed in place, only the values created at run time
+ * are allocated on the engine heap.
+ *
+ * @param[in]   name    script file name without `.js`
+ *
+ * @return  the completion value of the script, to be released by the caller
+ * @return  a reference error if there is no snapshot called @p name
+ */
+jerry_value_t jerry_riot_exec_snapshot(const char *name);
+
+#if defined(MODULE_JERRYSCRIPT_TLSF) || defined(DOXYGEN)
+/**
+ * @brief   Get the usage statistics of the engine heap
+ *
+ * @param[out]  stats   statistics of the engine arena
+ */
+void jerry_riot_heap_stats(tlsf_arena_stats_t *stats);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* JERRY_RIOT_H */
+/** @} */
@@ -86,12 +86,21 @@ static int _dev_write(const struct lfs_config *c, lfs_block_t block,
 
     const uint8_t *buf = buffer;
     uint32_t addr = ((fs->base_addr + block) * c->block_size) + off;
-    for (const uint8_t *part = buf; part < buf + size; part += c->prog_size,
-         addr += c->prog_size) {
-        int ret = mtd_write(mtd, part, addr, c->prog_size);
+    /* size is a multiple of prog_size, which may be smaller than a page:
+     * write up to the end of each page at once */
+    while (size) {
+        lfs_size_t chunk = mtd->page_size - (addr % mtd->page_size);
+
+        if (chunk > size) {
+            chunk = size;
+        }
+        int ret = mtd_write(mtd, buf, addr, chunk);
         if (ret != 0) {
             return ret;
         }
+        buf += chunk;
+        addr += chunk;
+        size -= chunk;
     }
 
     return 0;
@@ -127,7 +136,8 @@ static int prepare(littlefs_desc_t *fs)
     int ret = mtd_init(fs->dev);
 
     if (ret) {
-        return ret;
+        mutex_unlock(&fs->lock);
+        return -ENODEV;
     }
 
     memset(&fs->fs, 0, sizeof(fs->fs));
@@ -150,8 +160,16 @@ static int prepare(littlefs_desc_t *fs)
     if (!fs->config.block_cycles) {
         fs->config.block_cycles = CONFIG_LITTLEFS2_BLOCK_CYCLES;
     }
-    fs->config.lookahead_size = CONFIG_LITTLEFS2_LOOKAHEAD_SIZE;
-    fs->config.lookahead_buffer = fs->lookahead_buf;
+    if (!fs->config.lookahead_size) {
+        fs->config.lookahead_size = CONFIG_LITTLEFS2_LOOKAHEAD_SIZE;
+    }
+    if (!fs->config.lookahead_buffer) {
+        if (fs->config.lookahead_size > sizeof(fs->lookahead_buf)) {
+            mutex_unlock(&fs->lock);
+            return -EINVAL;
+        }
+        fs->config.lookahead_buffer = fs->lookahead_buf;
+    }
     fs->config.context = fs;
     fs->config.read = _dev_read;
     fs->config.prog = _dev_write;
@@ -161,10 +179,22 @@ static int prepare(littlefs_desc_t *fs)
     fs->config.file_buffer = fs->file_buf;
 #endif
 #if CONFIG_LITTLEFS2_READ_BUFFER_SIZE
-    fs->config.read_buffer = fs->read_buf;
+    if (!fs->config.read_buffer) {
+        if (fs->config.cache_size > sizeof(fs->read_buf)) {
+            mutex_unlock(&fs->lock);
+            return -EINVAL;
+        }
+        fs->config.read_buffer = fs->read_buf;
+    }
 #endif
 #if CONFIG_LITTLEFS2_PROG_BUFFER_SIZE
-    fs->config.prog_buffer = fs->prog_buf;
+    if (!fs->config.prog_buffer) {
+        if (fs->config.cache_size > sizeof(fs->prog_buf)) {
+            mutex_unlock(&fs->lock);
+            return -EINVAL;
+        }
+        fs->config.prog_buffer = fs->prog_buf;
+    }
 #endif
 
     return 0;
@@ -177,7 +207,7 @@ static int _format(vfs_mount_t *mountp)
     DEBUG("littlefs: format: mountp=%p\n", (void *)mountp);
     int ret = prepare(fs);
     if (ret) {
-        return -ENODEV;
+        return ret;
     }
 
     ret = lfs_format(&fs->fs, &fs->config);
@@ -198,7 +228,7 @@ static int _mount(vfs_mount_t *mountp)
     DEBUG("littlefs: mount: mountp=%p\n", (void *)mountp);
     int ret = prepare(fs);
     if (ret) {
-        return -ENODEV;
+        return ret;
     }
 
     ret = lfs_mount(&fs->fs, &fs->config);
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @file
+ * @brief       Host tool compiling Lua scripts into a builtin module table
+ *
+ * Usage: lua_freeze [-s] <output.c> <name>=<script.lua>...
+ *
+ * Every script is compiled to bytecode (stripped of debug information with
+ * `-s`) and emitted as a const array together with a
+ * lua_riot_builtin_lua_table sorted by module name.
+ *
+ * This tool runs on the build host, it must be built with the same sizes of
+ * `int`, `size_t` and the Lua number types as the target, i.e. as a 32 bit
+ * executable.
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lua.h"
+#include "lauxlib.h"
+
+typedef struct {
+    const char *name;
+    const char *path;
+} module_t;
+
+typedef struct {
+    FILE *out;
+    size_t len;
+} dump_t;
+
+static void *_alloc(void *ud, void *ptr, size_t osize, size_t nsize)
+{
+    (void)ud;
+    (void)osize;
+
+    if (nsize == 0) {
+        free(ptr);
+        return NULL;
+    }
+    return realloc(ptr, nsize);
+}
+
+static int _write(lua_State *L, const void *p, size_t sz, void *ud)
+{
+    dump_t *dump = ud;
+    const unsigned char *bytes = p;
+
+    (void)L;
+
+    for (size_t i = 0; i < sz; i++, dump->len++) {
+        fprintf(dump->out, "%s0x%02x,", (dump->len % 12) ? " " : "\n    ",
+                bytes[i]);
+    }
+    return 0;
+}
+
+static int _cmp(const void *a, const void *b)
+{
+    return strcmp(((const module_t *)a)->name, ((const module_t *)b)->name);
+}
+
+int main(int argc, char **argv)
+{
+    int strip = 0;
+    int arg = 1;
+
+    if ((argc > 1) && !strcmp(argv[1], "-s")) {
+        strip = 1;
+        arg++;
+    }
+    if (argc - arg < 2) {
+        fprintf(stderr, "usage: %s [-s] <output.c> <name>=<script.lua>...\n",
+                argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const char *output = argv[arg++];
+    int numof = argc - arg;
+    module_t *modules = calloc(numof, sizeof(*modules));
+
+    if (modules == NULL) {
+        return EXIT_FAILURE;
+    }
+    for (int i = 0; i < numof; i++) {
+        char *sep = strchr(argv[arg + i], '=');
+
+        if (sep == NULL) {
+            fprintf(stderr, "%s: expected <name>=<script.lua>\n",
+                    argv[arg + i]);
+            return EXIT_FAILURE;
+        }
+        *sep = '\0';
+        modules[i].name = argv[arg + i];
+        modules[i].path = sep + 1;
+    }
+    /* the loader looks modules up with a binary search */
+    qsort(modules, numof, sizeof(*modules), _cmp);
+
+    lua_State *L = lua_newstate(_alloc, NULL);
+    FILE *out = fopen(output, "w");
+
+    if ((L == NULL) || (out == NULL)) {
+        perror(output);
+        return EXIT_FAILURE;
+    }
+
+    fprintf(out, "/* generated by lua_freeze, do not edit */\n\n"
+                 "#include \"lua_builtin.h\"\n");
+    for (int i = 0; i < numof; i++) {
+        dump_t dump = { .out = out };
+
+        if (luaL_loadfile(L, modules[i].path) != LUA_OK) {
+            fprintf(stderr, "%s\n", lua_tostring(L, -1));
+            fclose(out);
+            remove(output);
+            return EXIT_FAILURE;
+        }
+        fprintf(out, "\nstatic const uint8_t _code_%d[] = {", i);
+        lua_dump(L, _write, &dump, strip);
+        fprintf(out, "\n};\n");
+        lua_pop(L, 1);
+    }
+
+    fprintf(out, "\nstatic const struct lua_riot_builtin_lua _frozen[] = {\n");
+    for (int i = 0; i < numof; i++) {
+        fprintf(out, "    { \"%s\", _code_%d, sizeof(_code_%d) },\n",
+                modules[i].name, i, i);
+    }
+    fprintf(out, "};\n\n"
+                 "const struct lua_riot_builtin_lua *const "
+                 "lua_riot_builtin_lua_table = _frozen;\n"
+                 "const size_t lua_riot_builtin_lua_table_len = %d;\n", numof);
+
+    lua_close(L);
+    free(modules);
+    return fclose(out) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
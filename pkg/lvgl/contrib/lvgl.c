@@ -43,15 +43,28 @@
 #define LVGL_TASK_HANDLER_DELAY_US  (5 * US_PER_MS)     /* 5ms */
 #endif
 
+#ifndef LVGL_COLOR_BUF_DOUBLE
+#define LVGL_COLOR_BUF_DOUBLE       (0)
+#endif
+
 #ifndef LVGL_THREAD_FLAG
 #define LVGL_THREAD_FLAG            (1 << 7)
 #endif
 
+#ifndef LVGL_FLUSH_FLAG
+#define LVGL_FLUSH_FLAG             (1 << 6)
+#endif
+
 static char _task_thread_stack[THREAD_STACKSIZE_LARGE];
 static kernel_pid_t _task_thread_pid;
 
 static lv_disp_buf_t disp_buf;
 static lv_color_t buf[LVGL_COLOR_BUF_SIZE];
+#if LVGL_COLOR_BUF_DOUBLE
+static lv_color_t buf2[LVGL_COLOR_BUF_SIZE];
+#else
+#define buf2    NULL
+#endif
 static disp_dev_t *_dev = NULL;
 
 static void *_task_thread(void *arg)
@@ -78,18 +91,38 @@ static void *_task_thread(void *arg)
     return NULL;
 }
 
+static void _disp_map_done(void *arg)
+{
+    lv_disp_flush_ready(arg);
+
+    if (pid_is_valid(_task_thread_pid)) {
+        thread_t *tcb = (thread_t *)sched_threads[_task_thread_pid];
+        thread_flags_set(tcb, LVGL_FLUSH_FLAG);
+    }
+}
+
 static void _disp_map(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p)
 {
     if (!_dev) {
         return;
     }
 
-    disp_dev_map(_dev, area->x1, area->x2, area->y1, area->y2,
-                 (const uint16_t *)color_p);
-
     LOG_DEBUG("[lvgl] flush display\n");
 
-    lv_disp_flush_ready(drv);
+    /* lvgl continues rendering into the other buffer while this one is
+       transferred */
+    disp_dev_map_async(_dev, area->x1, area->x2, area->y1, area->y2,
+                       (const uint16_t *)color_p, _disp_map_done, drv);
+}
+
+static void _disp_wait(lv_disp_drv_t *drv)
+{
+    (void)drv;
+
+    /* sleep instead of busy waiting for the running flush */
+    if (thread_getpid() == _task_thread_pid) {
+        thread_flags_wait_any(LVGL_FLUSH_FLAG);
+    }
 }
 
 void lvgl_init(disp_dev_t *dev)
@@ -104,9 +137,10 @@ void lvgl_init(disp_dev_t *dev)
     disp_drv.ver_res = disp_dev_height(dev);
 
     disp_drv.flush_cb = _disp_map;
+    disp_drv.wait_cb = _disp_wait;
     disp_drv.buffer = &disp_buf;
     lv_disp_drv_register(&disp_drv);
-    lv_disp_buf_init(&disp_buf, buf, NULL, LVGL_COLOR_BUF_SIZE);
+    lv_disp_buf_init(&disp_buf, buf, buf2, LVGL_COLOR_BUF_SIZE);
 
     lv_task_handler();
     _task_thread_pid = thread_create(_task_thread_stack, sizeof(_task_thread_stack),
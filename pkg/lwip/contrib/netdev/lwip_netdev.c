@@ -22,10 +22,12 @@
 #endif
 #include "lwip/err.h"
 #include "lwip/ethip6.h"
+#include "lwip/mem.h"
 #include "lwip/netif.h"
 #include "lwip/netif/netdev.h"
 #include "lwip/opt.h"
 #include "lwip/pbuf.h"
+#include "lwip/tcpip.h"
 #include "netif/etharp.h"
 #include "netif/lowpan6.h"
 
@@ -42,7 +44,12 @@
 
 #define LWIP_NETDEV_NAME            "lwip_netdev_mux"
 #define LWIP_NETDEV_PRIO            (THREAD_PRIORITY_MAIN - 4)
+#if LWIP_TCPIP_CORE_LOCKING_INPUT
+/* received frames are processed by the stack in this thread */
+#define LWIP_NETDEV_STACKSIZE       (TCPIP_THREAD_STACKSIZE)
+#else
 #define LWIP_NETDEV_STACKSIZE       (THREAD_STACKSIZE_DEFAULT)
+#endif
 #define LWIP_NETDEV_QUEUE_LEN       (8)
 #define LWIP_NETDEV_MSG_TYPE_EVENT 0x1235
 
@@ -52,7 +59,6 @@
 static kernel_pid_t _pid = KERNEL_PID_UNDEF;
 static char _stack[LWIP_NETDEV_STACKSIZE];
 static msg_t _queue[LWIP_NETDEV_QUEUE_LEN];
-static char _tmp_buf[LWIP_NETDEV_BUFLEN];
 
 #ifdef MODULE_NETDEV_ETH
 static err_t _eth_link_output(struct netif *netif, struct pbuf *p);
@@ -63,6 +69,119 @@ static err_t _ieee802154_link_output(struct netif *netif, struct pbuf *p);
 static void _event_cb(netdev_t *dev, netdev_event_t event);
 static void *_event_loop(void *arg);
 
+#if IS_USED(MODULE_LWIP_NETDEV_RX_ZEROCOPY)
+/**
+ * @brief   Receive buffers lent to one device
+ */
+typedef struct rx_zerocopy {
+    struct rx_zerocopy *next;   /**< next device in list */
+    netdev_t *dev;              /**< the device the buffers are lent to */
+    unsigned numof;             /**< number of buffers currently lent */
+    netdev_rx_buf_t bufs[LWIP_NETDEV_RX_ZEROCOPY_NUMOF];  /**< descriptors */
+} rx_zerocopy_t;
+
+static rx_zerocopy_t *_rx_zerocopy;
+
+static int _rx_lend(netdev_t *dev, netdev_rx_buf_t *buf, struct pbuf *p)
+{
+    int res;
+
+    buf->data = p->payload;
+    buf->size = p->len;
+    buf->ctx = p;
+    res = dev->driver->rx_buf_give(dev, buf);
+    if (res < 0) {
+        DEBUG("lwip_netdev: device refused buffer: %d\n", res);
+        buf->ctx = NULL;
+        pbuf_free(p);
+    }
+    return res;
+}
+
+static void _rx_relend(rx_zerocopy_t *zc, netdev_rx_buf_t *buf,
+                       struct pbuf *p)
+{
+    if (_rx_lend(zc->dev, buf, p) < 0) {
+        /* once the last buffer is gone, frames are copied again */
+        zc->numof--;
+        DEBUG("lwip_netdev: receive buffer lost, %u left\n", zc->numof);
+    }
+}
+
+static void _rx_zerocopy_init(netdev_t *dev)
+{
+    rx_zerocopy_t *zc;
+    size_t size;
+
+    if (!netdev_rx_zerocopy(dev)) {
+        return;
+    }
+    size = netdev_rx_buf_size(dev, LWIP_NETDEV_BUFLEN);
+    if (size > UINT16_MAX) {
+        return;
+    }
+    /* the descriptors stay with the device as long as the interface exists */
+    zc = mem_malloc(sizeof(*zc));
+    if (zc == NULL) {
+        DEBUG("lwip_netdev: can not allocate receive descriptors\n");
+        return;
+    }
+    zc->dev = dev;
+    for (zc->numof = 0; zc->numof < LWIP_NETDEV_RX_ZEROCOPY_NUMOF;
+         zc->numof++) {
+        struct pbuf *p = pbuf_alloc(PBUF_RAW, (u16_t)size, PBUF_RAM);
+
+        if ((p == NULL) || (_rx_lend(dev, &zc->bufs[zc->numof], p) < 0)) {
+            break;
+        }
+    }
+    DEBUG("lwip_netdev: lent %u receive buffers\n", zc->numof);
+    if (zc->numof == 0) {
+        /* device keeps using the copying path */
+        mem_free(zc);
+        return;
+    }
+    LL_PREPEND(_rx_zerocopy, zc);
+}
+
+static rx_zerocopy_t *_rx_zerocopy_get(netdev_t *dev)
+{
+    rx_zerocopy_t *zc;
+
+    LL_SEARCH_SCALAR(_rx_zerocopy, zc, dev, dev);
+    return zc;
+}
+
+static struct pbuf *_get_recv_pkt_zerocopy(rx_zerocopy_t *zc)
+{
+    netdev_t *dev = zc->dev;
+    netdev_rx_buf_t *buf = NULL;
+    struct pbuf *p, *fresh;
+    int len = dev->driver->recv_zc(dev, &buf, NULL);
+
+    if (buf == NULL) {
+        return NULL;
+    }
+    p = buf->ctx;
+    assert(p != NULL);
+    if (len <= 0) {
+        DEBUG("lwip_netdev: an error occurred while reading the packet\n");
+        /* hand the same buffer back to the device */
+        _rx_relend(zc, buf, p);
+        return NULL;
+    }
+    fresh = pbuf_alloc(PBUF_RAW, (u16_t)buf->size, PBUF_RAM);
+    if (fresh == NULL) {
+        DEBUG("lwip_netdev: can not allocate in pbuf, dropping frame\n");
+        _rx_relend(zc, buf, p);
+        return NULL;
+    }
+    _rx_relend(zc, buf, fresh);
+    pbuf_realloc(p, (u16_t)len);
+    return p;
+}
+#endif
+
 static void _configure_netdev(netdev_t *dev)
 {
     /* Enable RX-complete interrupts */
@@ -95,6 +214,9 @@ err_t lwip_netdev_init(struct netif *netif)
     netdev = (netdev_t *)netif->state;
     netdev->driver->init(netdev);
     _configure_netdev(netdev);
+#if IS_USED(MODULE_LWIP_NETDEV_RX_ZEROCOPY)
+    _rx_zerocopy_init(netdev);
+#endif
     netdev->event_callback = _event_cb;
     if (netdev->driver->get(netdev, NETOPT_DEVICE_TYPE, &dev_type,
                             sizeof(dev_type)) < 0) {
@@ -240,20 +362,37 @@ static err_t _ieee802154_link_output(struct netif *netif, struct pbuf *p)
 
 static struct pbuf *_get_recv_pkt(netdev_t *dev)
 {
-    int len = dev->driver->recv(dev, _tmp_buf, sizeof(_tmp_buf), NULL);
+#if IS_USED(MODULE_LWIP_NETDEV_RX_ZEROCOPY)
+    rx_zerocopy_t *zc = _rx_zerocopy_get(dev);
 
-    if (len < 0) {
+    /* fall back to copying if the device holds none of our buffers */
+    if ((zc != NULL) && (zc->numof > 0)) {
+        return _get_recv_pkt_zerocopy(zc);
+    }
+#endif
+    int len = dev->driver->recv(dev, NULL, 0, NULL);
+
+    if (len <= 0) {
         DEBUG("lwip_netdev: an error occurred while reading the packet\n");
         return NULL;
     }
     assert(((unsigned)len) <= UINT16_MAX);
-    struct pbuf *p = pbuf_alloc(PBUF_RAW, (u16_t)len, PBUF_POOL);
+    /* a PBUF_RAM pbuf is contiguous, so the device can write right into it */
+    struct pbuf *p = pbuf_alloc(PBUF_RAW, (u16_t)len, PBUF_RAM);
 
     if (p == NULL) {
         DEBUG("lwip_netdev: can not allocate in pbuf\n");
+        /* drop the packet */
+        dev->driver->recv(dev, NULL, len, NULL);
+        return NULL;
+    }
+    len = dev->driver->recv(dev, p->payload, len, NULL);
+    if (len <= 0) {
+        DEBUG("lwip_netdev: an error occurred while reading the packet\n");
+        pbuf_free(p);
         return NULL;
     }
-    pbuf_take(p, _tmp_buf, len);
+    pbuf_realloc(p, (u16_t)len);
     return p;
 }
 
@@ -287,7 +426,9 @@ static void _event_cb(netdev_t *dev, netdev_event_t event)
             }
 #ifdef MODULE_LWIP_DHCP_AUTO
             case NETDEV_EVENT_LINK_UP: {
+                LOCK_TCPIP_CORE();
                 dhcp_start(netif);
+                UNLOCK_TCPIP_CORE();
                 break;
             }
 #endif
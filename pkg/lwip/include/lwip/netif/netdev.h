@@ -32,13 +32,26 @@ extern "C" {
 #endif
 
 /**
- * @brief   Length of the temporary copying buffer for receival.
+ * @brief   Length of the receive buffers lent to devices supporting zero-copy
+ *          reception
  * @note    It should be as long as the maximum packet length of all the netdev you use.
+ *          Devices asking for larger buffers via @ref NETOPT_RX_BUF_SIZE get
+ *          those instead.
  */
 #ifndef LWIP_NETDEV_BUFLEN
 #define LWIP_NETDEV_BUFLEN      (ETHERNET_MAX_LEN)
 #endif
 
+/**
+ * @brief   Number of receive buffers lent to each device supporting zero-copy
+ *          reception
+ *
+ * Only applies with module `lwip_netdev_rx_zerocopy`.
+ */
+#ifndef LWIP_NETDEV_RX_ZEROCOPY_NUMOF
+#define LWIP_NETDEV_RX_ZEROCOPY_NUMOF   (2U)
+#endif
+
 /**
  * @brief   Initializes the netdev adapter.
  *
@@ -144,6 +144,16 @@ extern "C" {
 
 #define LWIP_SOCKET             (0)
 
+/* API calls lock the stack instead of waiting for the tcpip thread */
+#ifndef LWIP_TCPIP_CORE_LOCKING
+#define LWIP_TCPIP_CORE_LOCKING (1)
+#endif
+
+/* received frames are processed in the thread of the device */
+#ifndef LWIP_TCPIP_CORE_LOCKING_INPUT
+#define LWIP_TCPIP_CORE_LOCKING_INPUT   (LWIP_TCPIP_CORE_LOCKING)
+#endif
+
 #define LWIP_DONT_PROVIDE_BYTEORDER_FUNCTIONS
 #define MEMP_MEM_MALLOC         (1)
 #define NETIF_MAX_HWADDR_LEN    (GNRC_NETIF_HDR_L2ADDR_MAX_LEN)
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+/**
+ * @ingroup  pkg_nanocbor
+ * @{
+ * @file
+ *
+ * @brief   Encode CBOR directly into GNRC packet buffer snips
+ * @author  ML!PA Consulting GmbH
+ *
+ * The data is encoded into a buffer allocated with gnrc_sock_udp_alloc_buf()
+ * and sent with gnrc_sock_udp_send_buf(), so the payload is not copied into
+ * the packet buffer by sock_udp_send().
+ */
+
+#ifndef NANOCBOR_PKTBUF_H
+#define NANOCBOR_PKTBUF_H
+
+#include <errno.h>
+
+#include "nanocbor/nanocbor.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/sock/udp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Function encoding the payload
+ *
+ * It is called twice and must produce the same output both times.
+ *
+ * @param[in]   enc     encoder to write to
+ * @param[in]   arg     argument passed to nanocbor_sock_udp_send()
+ */
+typedef void (*nanocbor_pktbuf_cb_t)(nanocbor_encoder_t *enc, void *arg);
+
+/**
+ * @brief   Initialize an encoder writing into a packet buffer snip
+ *
+ * After encoding, the snip can be shrunk to the encoded length with
+ * `gnrc_pktbuf_realloc_data(*snip, nanocbor_encoded_len(enc))`, which does
+ * not move the data.
+ *
+ * @param[out]  enc     encoder to initialize
+ * @param[in]   size    maximum length of the encoded data
+ * @param[out]  snip    the snip holding the buffer
+ *
+ * @return  0 on success
+ * @return  -ENOMEM if the packet buffer is full
+ */
+static inline int nanocbor_encoder_init_pktbuf(nanocbor_encoder_t *enc,
+                                               size_t size,
+                                               gnrc_pktsnip_t **snip)
+{
+    uint8_t *buf = gnrc_sock_udp_alloc_buf(size, snip);
+
+    if (buf == NULL) {
+        return -ENOMEM;
+    }
+    nanocbor_encoder_init(enc, buf, size);
+    return 0;
+}
+
+/**
+ * @brief   Encode data into the packet buffer and send it over UDP
+ *
+ * @p cb is first run on an encoder without buffer to determine the exact
+ * length, then on an encoder writing into the payload snip of the datagram.
+ *
+ * @param[in]   sock    UDP sock, may be NULL
+ * @param[in]   cb      function encoding the payload
+ * @param[in]   arg     argument for @p cb
+ * @param[in]   remote  remote end point, may be NULL if @p sock has one
+ *
+ * @return  number of bytes sent on success
+ * @return  -ENOMEM if the packet buffer is full
+ * @return  the negative error codes of sock_udp_send()
+ */
+static inline ssize_t nanocbor_sock_udp_send(sock_udp_t *sock,
+                                             nanocbor_pktbuf_cb_t cb,
+                                             void *arg,
+                                             const sock_udp_ep_t *remote)
+{
+    nanocbor_encoder_t enc;
+    gnrc_pktsnip_t *snip;
+
+    nanocbor_encoder_init(&enc, NULL, 0);
+    cb(&enc, arg);
+    if (nanocbor_encoder_init_pktbuf(&enc, nanocbor_encoded_len(&enc),
+                                     &snip) < 0) {
+        return -ENOMEM;
+    }
+    cb(&enc, arg);
+    return gnrc_sock_udp_send_buf(sock, snip, remote);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NANOCBOR_PKTBUF_H */
+/** @} */
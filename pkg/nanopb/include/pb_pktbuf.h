@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+/**
+ * @ingroup  pkg_nanopb
+ * @{
+ * @file
+ *
+ * @brief   Encode protocol buffers directly into GNRC packet buffer snips
+ * @author  ML!PA Consulting GmbH
+ *
+ * The messages are encoded into a buffer allocated with
+ * gnrc_sock_udp_alloc_buf() and sent with gnrc_sock_udp_send_buf(), so the
+ * payload is not copied into the packet buffer by sock_udp_send().
+ */
+
+#ifndef PB_PKTBUF_H
+#define PB_PKTBUF_H
+
+#include <errno.h>
+
+#include "net/gnrc/pktbuf.h"
+#include "net/sock/udp.h"
+#include "pb_encode.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Create an output stream writing into a packet buffer snip
+ *
+ * After encoding, the snip can be shrunk to the encoded length with
+ * `gnrc_pktbuf_realloc_data(*snip, stream->bytes_written)`, which does not
+ * move the data.
+ *
+ * @param[out]  stream  stream to initialize
+ * @param[in]   size    maximum length of the encoded message
+ * @param[out]  snip    the snip holding the buffer
+ *
+ * @return  0 on success
+ * @return  -ENOMEM if the packet buffer is full
+ */
+static inline int pb_ostream_from_pktbuf(pb_ostream_t *stream, size_t size,
+                                         gnrc_pktsnip_t **snip)
+{
+    void *buf = gnrc_sock_udp_alloc_buf(size, snip);
+
+    if (buf == NULL) {
+        return -ENOMEM;
+    }
+    *stream = pb_ostream_from_buffer(buf, size);
+    return 0;
+}
+
+/**
+ * @brief   Encode a message into the packet buffer and send it over UDP
+ *
+ * A sizing pass determines the exact length of the message, which is then
+ * encoded directly into the payload snip of the datagram.
+ *
+ * @param[in]   sock    UDP sock, may be NULL
+ * @param[in]   fields  message descriptor
+ * @param[in]   msg     message to encode
+ * @param[in]   remote  remote end point, may be NULL if @p sock has one
+ *
+ * @return  number of bytes sent on success
+ * @return  -EINVAL if the message cannot be encoded
+ * @return  -ENOMEM if the packet buffer is full
+ * @return  the negative error codes of sock_udp_send()
+ */
+static inline ssize_t pb_sock_udp_send(sock_udp_t *sock,
+                                       const pb_msgdesc_t *fields,
+                                       const void *msg,
+                                       const sock_udp_ep_t *remote)
+{
+    gnrc_pktsnip_t *snip;
+    pb_ostream_t stream;
+    size_t len;
+
+    if (!pb_get_encoded_size(&len, fields, msg)) {
+        return -EINVAL;
+    }
+    if (pb_ostream_from_pktbuf(&stream, len, &snip) < 0) {
+        return -ENOMEM;
+    }
+    if (!pb_encode(&stream, fields, msg)) {
+        gnrc_pktbuf_release(snip);
+        return -EINVAL;
+    }
+    return gnrc_sock_udp_send_buf(sock, snip, remote);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PB_PKTBUF_H */
+/** @} */
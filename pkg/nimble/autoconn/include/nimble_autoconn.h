@@ -61,6 +61,23 @@
  * random offset are configurable.
  *
  *
+ * # Connection Event Scheduling
+ * With many connections, their connection events easily overlap and the
+ * controller has to skip some of them. Autoconn therefore only uses
+ * connection intervals that are power-of-two multiples of the configured
+ * `conn_itvl` and limits the length of each connection event to
+ * `conn_itvl / NIMBLE_NETIF_MAX_CONN`. This way the controller always finds
+ * a free anchor point for every connection within the base interval.
+ *
+ * Every @ref NIMBLE_AUTOCONN_SCHED_PERIOD, the traffic of each connection
+ * in the master role is evaluated: busy connections (more than
+ * @ref NIMBLE_AUTOCONN_SCHED_TRAFFIC_HIGH bytes, or sends stalled waiting for
+ * connection events) get a shorter interval, idle connections (less than
+ * @ref NIMBLE_AUTOCONN_SCHED_TRAFFIC_LOW bytes) a longer one, up to
+ * `conn_itvl << NIMBLE_AUTOCONN_SCHED_ITVL_EXP_MAX`. The counters of a
+ * connection are available with nimble_autoconn_link_stats().
+ *
+ *
  * # Usage
  * In the current state, the filtering of neighbors is hard coded into the
  * autoconn module. Two options are implemented:
@@ -155,6 +172,22 @@ typedef struct {
     const char *node_id;
 } nimble_autoconn_params_t;
 
+/**
+ * @brief   Statistics of a connection
+ *
+ * The controller does not report missed connection events to the host, so
+ * @p tx_stalls counts the sends that found the previous packet still
+ * queued instead.
+ */
+typedef struct {
+    uint32_t tx_bytes;      /**< bytes sent over the connection */
+    uint32_t rx_bytes;      /**< bytes received over the connection */
+    uint32_t throughput;    /**< bytes per second sent and received during
+                             *   the last scheduling period */
+    uint16_t conn_itvl;     /**< current connection interval [in ms] */
+    uint16_t tx_stalls;     /**< sends that waited for connection events */
+} nimble_autoconn_link_stats_t;
+
 /**
  * @brief   Initialize and enable the autoconn module
  *
@@ -208,6 +241,17 @@ void nimble_autoconn_enable(void);
  */
 void nimble_autoconn_disable(void);
 
+/**
+ * @brief   Get the statistics of a connection
+ *
+ * @param[in] handle        connection handle
+ * @param[out] stats        statistics of the connection
+ *
+ * @return  NIMBLE_AUTOCONN_OK on success
+ * @return  NIMBLE_AUTOCONN_PARAMERR if @p handle is not connected
+ */
+int nimble_autoconn_link_stats(int handle, nimble_autoconn_link_stats_t *stats);
+
 #ifdef __cplusplus
 }
 #endif
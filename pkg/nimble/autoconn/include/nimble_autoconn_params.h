@@ -65,6 +65,19 @@ extern "C" {
 #define NIMBLE_AUTOCONN_NODE_ID             "RIOT-autoconn"
 #endif
 
+#ifndef NIMBLE_AUTOCONN_SCHED_PERIOD
+#define NIMBLE_AUTOCONN_SCHED_PERIOD        (5000U)         /* 5s, 0 = off */
+#endif
+#ifndef NIMBLE_AUTOCONN_SCHED_ITVL_EXP_MAX
+#define NIMBLE_AUTOCONN_SCHED_ITVL_EXP_MAX  (3U)            /* 8 * CONN_ITVL */
+#endif
+#ifndef NIMBLE_AUTOCONN_SCHED_TRAFFIC_HIGH
+#define NIMBLE_AUTOCONN_SCHED_TRAFFIC_HIGH  (1024U)         /* byte/period */
+#endif
+#ifndef NIMBLE_AUTOCONN_SCHED_TRAFFIC_LOW
+#define NIMBLE_AUTOCONN_SCHED_TRAFFIC_LOW   (128U)          /* byte/period */
+#endif
+
 #ifndef NIMBLE_AUTOCONN_PARAMS
 #define NIMBLE_AUTOCONN_PARAMS                        \
     { .period_scan   = NIMBLE_AUTOCONN_PERIOD_SCAN,   \
@@ -66,6 +66,22 @@ static ble_npl_time_t _period_jitter;
 
 static nimble_netif_eventcb_t _eventcb = NULL;
 
+/* state of the connection event scheduler per connection */
+typedef struct {
+    uint32_t tx_bytes;      /* counters at the start of the current period */
+    uint32_t rx_bytes;
+    uint32_t throughput;    /* byte/s of the last period */
+    uint16_t tx_stalls;
+    uint8_t itvl_exp;       /* connection interval is _itvl_base << itvl_exp */
+} _link_t;
+
+static _link_t _links[NIMBLE_NETIF_MAX_CONN];
+static struct ble_npl_callout _sched_evt;
+static ble_npl_time_t _timeout_sched_period;
+static uint16_t _itvl_base;
+static uint16_t _ce_len;
+static uint8_t _itvl_exp_max;
+
 /* this is run inside the NimBLE host thread */
 static void _on_state_change(struct ble_npl_event *ev)
 {
@@ -95,6 +111,80 @@ static void _on_state_change(struct ble_npl_event *ev)
     }
 }
 
+static void _get_upd_params(uint8_t itvl_exp, struct ble_gap_upd_params *params)
+{
+    params->itvl_min = (_itvl_base << itvl_exp);
+    params->itvl_max = (_itvl_base << itvl_exp);
+    params->latency = _conn_params.latency;
+    params->supervision_timeout = _conn_params.supervision_timeout;
+    params->min_ce_len = _ce_len;
+    params->max_ce_len = _ce_len;
+}
+
+static void _link_reset(int handle)
+{
+    nimble_netif_conn_t *conn = nimble_netif_conn_get(handle);
+    _link_t *link = &_links[handle];
+
+    link->tx_bytes = conn->tx_bytes;
+    link->rx_bytes = conn->rx_bytes;
+    link->tx_stalls = conn->tx_stalls;
+    link->throughput = 0;
+    link->itvl_exp = 0;
+}
+
+/* adapt the connection interval to the traffic of the last period, only the
+ * master of a connection decides on its interval */
+static int _sched_link(nimble_netif_conn_t *conn, int handle, void *arg)
+{
+    (void)arg;
+    _link_t *link = &_links[handle];
+
+    uint32_t traffic = (conn->tx_bytes - link->tx_bytes) +
+                       (conn->rx_bytes - link->rx_bytes);
+    int stalled = (conn->tx_stalls != link->tx_stalls);
+    link->tx_bytes = conn->tx_bytes;
+    link->rx_bytes = conn->rx_bytes;
+    link->tx_stalls = conn->tx_stalls;
+    link->throughput = (uint32_t)(((uint64_t)traffic * 1000) /
+                                  NIMBLE_AUTOCONN_SCHED_PERIOD);
+
+    if (!(conn->state & NIMBLE_NETIF_GAP_MASTER)) {
+        return 0;
+    }
+
+    uint8_t exp = link->itvl_exp;
+    if (stalled) {
+        exp = 0;
+    }
+    else if ((traffic > NIMBLE_AUTOCONN_SCHED_TRAFFIC_HIGH) && (exp > 0)) {
+        exp--;
+    }
+    else if ((traffic < NIMBLE_AUTOCONN_SCHED_TRAFFIC_LOW) &&
+             (exp < _itvl_exp_max)) {
+        exp++;
+    }
+
+    if (exp != link->itvl_exp) {
+        struct ble_gap_upd_params params;
+        _get_upd_params(exp, &params);
+        if (nimble_netif_update(handle, &params) == NIMBLE_NETIF_OK) {
+            DEBUG("[autoconn] SCHED handle %i: itvl << %u\n", handle, exp);
+            link->itvl_exp = exp;
+        }
+    }
+
+    return 0;
+}
+
+/* this is run inside the NimBLE host thread */
+static void _on_sched(struct ble_npl_event *ev)
+{
+    (void)ev;
+    nimble_netif_conn_foreach(NIMBLE_NETIF_L2CAP_CONNECTED, _sched_link, NULL);
+    ble_npl_callout_reset(&_sched_evt, _timeout_sched_period);
+}
+
 static void _activate(void)
 {
     if (_enabled && (_state == STATE_IDLE) &&
@@ -201,10 +291,12 @@ static void _on_netif_evt(int handle, nimble_netif_event_t event,
             _evt_dbg("CONNECTED master", handle, addr);
             assert(_state == STATE_CONN);
             _state = STATE_IDLE;
+            _link_reset(handle);
             break;
         case NIMBLE_NETIF_CONNECTED_SLAVE:
             _evt_dbg("CONNECTED slave", handle, addr);
             _state = STATE_IDLE;
+            _link_reset(handle);
             break;
         case NIMBLE_NETIF_CLOSED_MASTER:
             _evt_dbg("CLOSED master", handle, addr);
@@ -242,6 +334,7 @@ static int _conn_update(nimble_netif_conn_t *conn, int handle, void *arg)
 {
     (void)conn;
     nimble_netif_update(handle, (const struct ble_gap_upd_params *)arg);
+    _links[handle].itvl_exp = 0;
     return 0;
 }
 
@@ -253,6 +346,14 @@ int nimble_autoconn_init(const nimble_autoconn_params_t *params,
     /* setup state machine timer (we use NimBLEs callouts for this) */
     ble_npl_callout_init(&_state_evt, nimble_port_get_dflt_eventq(),
                          _on_state_change, NULL);
+    /* and the timer for adapting connection intervals to the traffic */
+    if (NIMBLE_AUTOCONN_SCHED_PERIOD > 0) {
+        ble_npl_time_ms_to_ticks(NIMBLE_AUTOCONN_SCHED_PERIOD,
+                                 &_timeout_sched_period);
+        ble_npl_callout_init(&_sched_evt, nimble_port_get_dflt_eventq(),
+                             _on_sched, NULL);
+        ble_npl_callout_reset(&_sched_evt, _timeout_sched_period);
+    }
     /* at last, set the given parameters */
     return nimble_autoconn_update(params, ad, adlen);
 }
@@ -281,22 +382,31 @@ int nimble_autoconn_update(const nimble_autoconn_params_t *params,
     /* populate the connection parameters */
     _conn_params.scan_itvl = ((params->scan_win * 1000) / BLE_HCI_SCAN_ITVL);
     _conn_params.scan_window = ((params->scan_win * 1000) / BLE_HCI_SCAN_ITVL);
-    _conn_params.itvl_min = ((params->conn_itvl * 1000) / BLE_HCI_CONN_ITVL);
-    _conn_params.itvl_max = ((params->conn_itvl * 1000) / BLE_HCI_CONN_ITVL);
+    _itvl_base = ((params->conn_itvl * 1000) / BLE_HCI_CONN_ITVL);
+    /* connection events are limited to a share of the base interval, so the
+     * events of all connections fit in without overlapping (the CE length is
+     * given in units of 0.625ms, the interval in units of 1.25ms) */
+    _ce_len = (_itvl_base * 2) / NIMBLE_NETIF_MAX_CONN;
+    _conn_params.itvl_min = _itvl_base;
+    _conn_params.itvl_max = _itvl_base;
     _conn_params.latency = 0;
     _conn_params.supervision_timeout = (params->conn_super_to / 10);
-    _conn_params.min_ce_len = 0;
-    _conn_params.max_ce_len = 0;
+    _conn_params.min_ce_len = _ce_len;
+    _conn_params.max_ce_len = _ce_len;
     _conn_timeout = ((params->conn_timeout * 1000) / BLE_HCI_SCAN_ITVL);
 
+    /* the longest interval must leave room for a few connection events
+     * within the supervision timeout */
+    _itvl_exp_max = 0;
+    while ((_itvl_exp_max < NIMBLE_AUTOCONN_SCHED_ITVL_EXP_MAX) &&
+           ((params->conn_itvl << (_itvl_exp_max + 1)) * 3 <
+            params->conn_super_to)) {
+        _itvl_exp_max++;
+    }
+
     /* we use the same values to updated existing connections */
     struct ble_gap_upd_params conn_update_params;
-    conn_update_params.itvl_min = _conn_params.itvl_min;
-    conn_update_params.itvl_max = _conn_params.itvl_max;
-    conn_update_params.latency = _conn_params.latency;
-    conn_update_params.supervision_timeout = _conn_params.supervision_timeout;
-    conn_update_params.min_ce_len = 0;
-    conn_update_params.max_ce_len = 0;
+    _get_upd_params(0, &conn_update_params);
 
     /* calculate the used scan parameters */
     struct ble_gap_disc_params scan_params;
@@ -357,3 +467,22 @@ void nimble_autoconn_disable(void)
     _enabled = 0;
     _deactivate();
 }
+
+int nimble_autoconn_link_stats(int handle, nimble_autoconn_link_stats_t *stats)
+{
+    nimble_netif_conn_t *conn = nimble_netif_conn_get(handle);
+    struct ble_gap_conn_desc desc;
+
+    if ((conn == NULL) || !(conn->state & NIMBLE_NETIF_L2CAP_CONNECTED) ||
+        (ble_gap_conn_find(conn->gaphandle, &desc) != 0)) {
+        return NIMBLE_AUTOCONN_PARAMERR;
+    }
+
+    stats->tx_bytes = conn->tx_bytes;
+    stats->rx_bytes = conn->rx_bytes;
+    stats->tx_stalls = conn->tx_stalls;
+    stats->throughput = _links[handle].throughput;
+    stats->conn_itvl = ((unsigned)desc.conn_itvl * BLE_HCI_CONN_ITVL) / 1000;
+
+    return NIMBLE_AUTOCONN_OK;
+}
@@ -42,6 +42,15 @@
  * to implement parts of the netdev interface as well. This is done where
  * needed.
  *
+ * Outgoing packets are copied once from their GNRC packet snips into a NimBLE
+ * mbuf chain, incoming ones once from the mbuf chain into the GNRC packet
+ * buffer. The GNRC packet is released before the L2CAP channel is waited for,
+ * so a packet is only buffered twice during the copy.
+ *
+ * The PHY (@ref NETOPT_BLE_PHY, e.g. LE 2M) and the link layer payload
+ * (@ref NETOPT_BLE_DATA_LEN, LE Data Length Extension) are requested on all
+ * connections when they are set and on every new connection afterwards.
+ *
  * # Usage
  * This submodule is designed to work fully asynchronous, in the same way as the
  * NimBLE interfaces are designed. All functions in this submodule will only
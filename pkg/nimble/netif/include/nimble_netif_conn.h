@@ -44,6 +44,11 @@ typedef struct {
     uint16_t state;                 /**< the current state of the context */
     uint8_t addr[BLE_ADDR_LEN];     /**< BLE address of connected peer
                                          (in network byte order) */
+    uint32_t tx_bytes;              /**< bytes sent over the L2CAP channel */
+    uint32_t rx_bytes;              /**< bytes received over the L2CAP
+                                         channel */
+    uint16_t tx_stalls;             /**< number of sends that had to wait
+                                         for the previous one to leave */
 } nimble_netif_conn_t;
 
 /**
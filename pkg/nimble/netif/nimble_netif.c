@@ -63,6 +63,14 @@
 /* thread flag used for signaling transmit readiness */
 #define FLAG_TX_UNSTALLED       (1u << 13)
 
+/* link layer defaults of the Bluetooth Core Specification */
+#define PHY_DEFAULT             (1U)        /* LE 1M */
+#define PHY_MAX                 (3U)        /* LE Coded */
+#define DATA_LEN_DEFAULT        (27U)
+#define DATA_LEN_MAX            (251U)
+/* time to transmit a link layer packet of the given payload on LE 1M in us */
+#define DATA_LEN_TIME(len)      (((len) + 14U) * 8U)
+
 /* allocate a stack for the netif device */
 static char _stack[THREAD_STACKSIZE_DEFAULT];
 static thread_t *_netif_thread;
@@ -74,6 +82,10 @@ static gnrc_nettype_t _nettype = NETTYPE;
 /* keep a reference to the event callback */
 static nimble_netif_eventcb_t _eventcb;
 
+/* link layer parameters requested for all connections */
+static uint8_t _phy = PHY_DEFAULT;
+static uint16_t _data_len = DATA_LEN_DEFAULT;
+
 /* allocation of memory for buffering IP packets when handing them to NimBLE */
 static os_membuf_t _mem[OS_MEMPOOL_SIZE(MBUF_CNT, MBUF_SIZE)];
 static struct os_mempool _mem_pool;
@@ -102,43 +114,46 @@ static void _netif_init(gnrc_netif_t *netif)
 #endif  /* IS_USED(MODULE_GNRC_NETIF_6LO) */
 }
 
-static int _send_pkt(nimble_netif_conn_t *conn, gnrc_pktsnip_t *pkt)
+/* copy the packet straight from its snips into an mbuf chain, so it only
+ * needs to be buffered once while waiting for the L2CAP channel */
+static struct os_mbuf *_pkt2mbuf(gnrc_pktsnip_t *pkt)
 {
-    int res;
-    int num_bytes = 0;
-
-    if (conn == NULL || conn->coc == NULL) {
-        return -ENOTCONN;
-    }
-
-    /* copy the data into a newly allocated mbuf */
     struct os_mbuf *sdu = os_mbuf_get_pkthdr(&_mbuf_pool, 0);
     if (sdu == NULL) {
-        return -ENOBUFS;
+        return NULL;
     }
     while (pkt) {
-        res = os_mbuf_append(sdu, pkt->data, pkt->size);
-        if (res != 0) {
+        if (os_mbuf_append(sdu, pkt->data, pkt->size) != 0) {
             os_mbuf_free_chain(sdu);
-            return -ENOBUFS;
+            return NULL;
         }
-        num_bytes += (int)pkt->size;
         pkt = pkt->next;
     }
+    return sdu;
+}
+
+static int _send_sdu(nimble_netif_conn_t *conn, struct os_mbuf *sdu)
+{
+    int res;
+    int num_bytes = (int)OS_MBUF_PKTLEN(sdu);
 
     /* send packet via the given L2CAP COC */
-    do {
-        res = ble_l2cap_send(conn->coc, sdu);
-        if (res == BLE_HS_EBUSY) {
+    res = ble_l2cap_send(conn->coc, sdu);
+    if (res == BLE_HS_EBUSY) {
+        /* the connection events did not keep up with the traffic */
+        conn->tx_stalls++;
+        do {
             thread_flags_wait_all(FLAG_TX_UNSTALLED);
-        }
-    } while (res == BLE_HS_EBUSY);
+            res = ble_l2cap_send(conn->coc, sdu);
+        } while (res == BLE_HS_EBUSY);
+    }
 
     if ((res != 0) && (res != BLE_HS_ESTALLED)) {
         os_mbuf_free_chain(sdu);
         return -ENOBUFS;
     }
 
+    conn->tx_bytes += num_bytes;
     return num_bytes;
 }
 
@@ -147,7 +162,10 @@ static int _netif_send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
     assert(pkt->type == GNRC_NETTYPE_NETIF);
 
     (void)netif;
-    int res;
+    int res = -ENOTCONN;
+    struct os_mbuf *sdu[NIMBLE_NETIF_MAX_CONN] = { NULL };
+    nimble_netif_conn_t *conn[NIMBLE_NETIF_MAX_CONN];
+    unsigned num = 0;
 
     gnrc_netif_hdr_t *hdr = (gnrc_netif_hdr_t *)pkt->data;
     /* if packet is bcast or mcast, we send it to every connected node */
@@ -155,8 +173,9 @@ static int _netif_send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
         (GNRC_NETIF_HDR_FLAGS_BROADCAST | GNRC_NETIF_HDR_FLAGS_MULTICAST)) {
         int handle = nimble_netif_conn_get_next(NIMBLE_NETIF_CONN_INVALID,
                                                 NIMBLE_NETIF_L2CAP_CONNECTED);
-        while (handle != NIMBLE_NETIF_CONN_INVALID) {
-            res = _send_pkt(nimble_netif_conn_get(handle), pkt->next);
+        while ((handle != NIMBLE_NETIF_CONN_INVALID) &&
+               (num < NIMBLE_NETIF_MAX_CONN)) {
+            conn[num++] = nimble_netif_conn_get(handle);
             handle = nimble_netif_conn_get_next(handle, NIMBLE_NETIF_L2CAP_CONNECTED);
         }
     }
@@ -164,12 +183,26 @@ static int _netif_send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
     else {
         int handle = nimble_netif_conn_get_by_addr(
             gnrc_netif_hdr_get_dst_addr(hdr));
-        nimble_netif_conn_t *conn = nimble_netif_conn_get(handle);
-        res = _send_pkt(conn, pkt->next);
+        conn[0] = nimble_netif_conn_get(handle);
+        if ((conn[0] != NULL) && (conn[0]->coc != NULL)) {
+            num = 1;
+        }
     }
 
-    /* release the packet in GNRC's packet buffer */
+    /* each connection gets a copy of its own, NimBLE takes ownership of the
+     * mbufs it sends */
+    for (unsigned i = 0; i < num; i++) {
+        sdu[i] = _pkt2mbuf(pkt->next);
+    }
+
+    /* release the packet in GNRC's packet buffer before waiting for the
+     * channels, so it is not held twice */
     gnrc_pktbuf_release(pkt);
+
+    for (unsigned i = 0; i < num; i++) {
+        res = (sdu[i] != NULL) ? _send_sdu(conn[i], sdu[i]) : -ENOBUFS;
+    }
+
     return res;
 }
 
@@ -203,6 +236,28 @@ static inline int _netdev_init(netdev_t *dev)
     return 0;
 }
 
+/* request the configured PHY and data length on a connection, the controller
+ * negotiates them with the peer */
+static int _apply_link_params(nimble_netif_conn_t *conn, int handle, void *arg)
+{
+    (void)handle;
+    (void)arg;
+
+    uint8_t phy_mask = (1U << (_phy - 1));
+    int res = ble_gap_set_prefered_le_phy(conn->gaphandle, phy_mask, phy_mask,
+                                          BLE_GAP_LE_PHY_CODED_ANY);
+    if (res != 0) {
+        DEBUG("[nimble_netif] unable to request PHY %u (%d)\n", _phy, res);
+    }
+    res = ble_gap_set_data_len(conn->gaphandle, _data_len,
+                               DATA_LEN_TIME(_data_len));
+    if (res != 0) {
+        DEBUG("[nimble_netif] unable to set data length %u (%d)\n",
+              _data_len, res);
+    }
+    return 0;
+}
+
 static inline int _netdev_get(netdev_t *dev, netopt_t opt,
                               void *value, size_t max_len)
 {
@@ -236,6 +291,16 @@ static inline int _netdev_get(netdev_t *dev, netopt_t opt,
             *((uint16_t *)value) = NETDEV_TYPE_BLE;
             res = sizeof(uint16_t);
             break;
+        case NETOPT_BLE_PHY:
+            assert(max_len >= sizeof(uint8_t));
+            *((uint8_t *)value) = _phy;
+            res = sizeof(uint8_t);
+            break;
+        case NETOPT_BLE_DATA_LEN:
+            assert(max_len >= sizeof(uint16_t));
+            *((uint16_t *)value) = _data_len;
+            res = sizeof(uint16_t);
+            break;
         default:
             break;
     }
@@ -255,6 +320,32 @@ static inline int _netdev_set(netdev_t *dev, netopt_t opt,
             memcpy(&_nettype, value, sizeof(_nettype));
             res = sizeof(_nettype);
             break;
+        case NETOPT_BLE_PHY: {
+            assert(val_len == sizeof(uint8_t));
+            uint8_t phy = *((const uint8_t *)value);
+            if ((phy < PHY_DEFAULT) || (phy > PHY_MAX)) {
+                res = -EINVAL;
+                break;
+            }
+            _phy = phy;
+            nimble_netif_conn_foreach(NIMBLE_NETIF_GAP_CONNECTED,
+                                      _apply_link_params, NULL);
+            res = sizeof(uint8_t);
+            break;
+        }
+        case NETOPT_BLE_DATA_LEN: {
+            assert(val_len == sizeof(uint16_t));
+            uint16_t len = *((const uint16_t *)value);
+            if ((len < DATA_LEN_DEFAULT) || (len > DATA_LEN_MAX)) {
+                res = -EINVAL;
+                break;
+            }
+            _data_len = len;
+            nimble_netif_conn_foreach(NIMBLE_NETIF_GAP_CONNECTED,
+                                      _apply_link_params, NULL);
+            res = sizeof(uint16_t);
+            break;
+        }
         default:
             break;
     }
@@ -280,6 +371,8 @@ static void _on_data(nimble_netif_conn_t *conn, struct ble_l2cap_event *event)
     struct os_mbuf *rxb = event->receive.sdu_rx;
     size_t rx_len = (size_t)OS_MBUF_PKTLEN(rxb);
 
+    conn->rx_bytes += rx_len;
+
     /* allocate netif header */
     gnrc_pktsnip_t *if_snip = gnrc_netif_hdr_build(conn->addr, BLE_ADDR_LEN,
                                                    _netif.l2addr,
@@ -419,6 +512,10 @@ static void _on_gap_connected(nimble_netif_conn_t *conn, uint16_t conn_handle)
 
     conn->gaphandle = conn_handle;
     bluetil_addr_swapped_cp(desc.peer_id_addr.val, conn->addr);
+
+    if ((_phy != PHY_DEFAULT) || (_data_len != DATA_LEN_DEFAULT)) {
+        _apply_link_params(conn, 0, NULL);
+    }
 }
 
 static int _on_gap_master_evt(struct ble_gap_event *event, void *arg)
@@ -18,6 +18,7 @@
 
 #include <assert.h>
 
+#include "kernel_defines.h"
 #include "openthread/platform/alarm-milli.h"
 #include "openthread/platform/uart.h"
 #include "ot.h"
@@ -41,7 +42,12 @@
 static at86rf2xx_t at86rf2xx_dev;
 #endif
 
+#if IS_USED(MODULE_OPENTHREAD_GNRC_PKTBUF)
+/* received frames are stored in the GNRC packet buffer */
+#define rx_buf  NULL
+#else
 static uint8_t rx_buf[OPENTHREAD_NETDEV_BUFLEN];
+#endif
 static uint8_t tx_buf[OPENTHREAD_NETDEV_BUFLEN];
 static char ot_thread_stack[2 * THREAD_STACKSIZE_MAIN];
 
@@ -22,6 +22,7 @@
 
 #include "byteorder.h"
 #include "errno.h"
+#include "kernel_defines.h"
 #include "net/ethernet/hdr.h"
 #include "net/ethertype.h"
 #include "net/ieee802154.h"
@@ -30,6 +31,9 @@
 #include "openthread/platform/diag.h"
 #include "openthread/platform/radio.h"
 #include "ot.h"
+#if IS_USED(MODULE_OPENTHREAD_GNRC_PKTBUF)
+#include "net/gnrc/pktbuf.h"
+#endif
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -155,6 +159,21 @@ void recv_pkt(otInstance *aInstance, netdev_t *dev)
      * OpenThread do not use the data so we don't need to calculate FCS */
     sReceiveFrame.mLength = len + RADIO_IEEE802154_FCS_LEN;
 
+#if IS_USED(MODULE_OPENTHREAD_GNRC_PKTBUF)
+    /* OpenThread copies the frame into its own messages before
+     * otPlatRadioReceiveDone() returns, so it only borrows the buffer */
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL, sReceiveFrame.mLength,
+                                          GNRC_NETTYPE_UNDEF);
+    if (pkt == NULL) {
+        DEBUG("openthread: no space in packet buffer\n");
+        /* drop the frame */
+        dev->driver->recv(dev, NULL, len, NULL);
+        otPlatRadioReceiveDone(aInstance, NULL, OT_ERROR_NO_BUFS);
+        return;
+    }
+    sReceiveFrame.mPsdu = pkt->data;
+#endif
+
     /* Read received frame */
     int res = dev->driver->recv(dev, (char *) sReceiveFrame.mPsdu, len, &rx_info);
 
@@ -170,6 +189,11 @@ void recv_pkt(otInstance *aInstance, netdev_t *dev)
 
     /* Tell OpenThread that receive has finished */
     otPlatRadioReceiveDone(aInstance, res > 0 ? &sReceiveFrame : NULL, res > 0 ? OT_ERROR_NONE : OT_ERROR_ABORT);
+
+#if IS_USED(MODULE_OPENTHREAD_GNRC_PKTBUF)
+    gnrc_pktbuf_release(pkt);
+    sReceiveFrame.mPsdu = NULL;
+#endif
 }
 
 /* Called upon TX event */
@@ -122,7 +122,8 @@ void openthread_bootstrap(void);
  *
  * @param[in]  dev                pointer to a netdev interface
  * @param[in]  tb                 pointer to the TX buffer designed for OpenThread
- * @param[in]  rb                 pointer to the RX buffer designed for Open_Thread
+ * @param[in]  rb                 pointer to the RX buffer designed for Open_Thread,
+ *                                NULL with module `openthread_gnrc_pktbuf`
  */
 void openthread_radio_init(netdev_t *dev, uint8_t *tb, uint8_t *rb);
 
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     pkg_tensorflow-lite
+ * @{
+ *
+ * @file
+ * @brief       TensorFlow Lite driver of the inference manager
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <cerrno>
+
+#include "ml_infer_tflite.hpp"
+
+#include "tensorflow/lite/micro/micro_error_reporter.h"
+#include "tensorflow/lite/schema/schema_generated.h"
+#include "tensorflow/lite/version.h"
+
+namespace riot {
+
+namespace {
+tflite::MicroErrorReporter error_reporter;
+} // namespace
+
+const ml_infer_driver_t tflite_model::driver = {
+  tflite_model::do_load,
+  tflite_model::do_run,
+  tflite_model::do_unload,
+};
+
+tflite_model::tflite_model(const char* name, const void* flatbuffer,
+                           const tflite::OpResolver& resolver,
+                           io_function set_input, io_function get_output)
+    : m_model{}, m_flatbuffer{flatbuffer}, m_resolver(resolver),
+      m_set_input{set_input}, m_get_output{get_output},
+      m_interpreter{nullptr} {
+  m_model.name = name;
+  m_model.driver = &driver;
+  m_model.ctx = this;
+}
+
+int tflite_model::do_load(ml_infer_model_t* model, void* arena,
+                          size_t size) {
+  auto self = static_cast<tflite_model*>(model->ctx);
+  const tflite::Model* tfl = tflite::GetModel(self->m_flatbuffer);
+
+  if (tfl->version() != TFLITE_SCHEMA_VERSION) {
+    return -EINVAL;
+  }
+  /* the interpreter only lives while the model owns the arena */
+  self->m_interpreter = new (self->m_storage) tflite::MicroInterpreter(
+      tfl, self->m_resolver, static_cast<uint8_t*>(arena), size,
+      &error_reporter);
+  if (self->m_interpreter->AllocateTensors() != kTfLiteOk) {
+    do_unload(model);
+    return -ENOMEM;
+  }
+  return 0;
+}
+
+int tflite_model::do_run(ml_infer_model_t* model, void* arg) {
+  auto self = static_cast<tflite_model*>(model->ctx);
+  int res;
+
+  if ((res = self->m_set_input(*self->m_interpreter, arg)) < 0) {
+    return res;
+  }
+  if ((res = ml_infer_yield()) < 0) {
+    return res;
+  }
+  if (self->m_interpreter->Invoke() != kTfLiteOk) {
+    return -EIO;
+  }
+  if ((res = ml_infer_yield()) < 0) {
+    return res;
+  }
+  return self->m_get_output(*self->m_interpreter, arg);
+}
+
+void tflite_model::do_unload(ml_infer_model_t* model) {
+  auto self = static_cast<tflite_model*>(model->ctx);
+
+  if (self->m_interpreter) {
+    self->m_interpreter->~MicroInterpreter();
+    self->m_interpreter = nullptr;
+  }
+}
+
+} // namespace riot
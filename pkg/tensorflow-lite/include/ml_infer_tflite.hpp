@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     pkg_tensorflow-lite
+ * @{
+ *
+ * @file
+ * @brief       TensorFlow Lite models run by the @ref sys_ml_infer
+ *
+ * The interpreter of a model is created in the shared arena whenever the
+ * model is loaded, so no model specific arena is needed:
+ *
+ * ```cpp
+ * static tflite::MicroMutableOpResolver resolver;
+ * static riot::tflite_model kws("kws", kws_tflite, resolver,
+ *                               kws_set_input, kws_get_output);
+ *
+ * int main()
+ * {
+ *     resolver.AddBuiltin(...);
+ *     int label = kws.run(&samples);
+ * }
+ * ```
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+
+#ifndef ML_INFER_TFLITE_HPP
+#define ML_INFER_TFLITE_HPP
+
+#include <new>
+
+#include "ml_infer.h"
+
+#include "tensorflow/lite/core/api/op_resolver.h"
+#include "tensorflow/lite/micro/micro_interpreter.h"
+
+namespace riot {
+
+/**
+ * @brief   TensorFlow Lite model run by the inference manager
+ */
+class tflite_model {
+ public:
+  /**
+   * @brief   Function to write the input tensors or read the output tensors
+   *
+   * @param[in] interpreter   interpreter of the model
+   * @param[in] arg           argument passed to run()
+   *
+   * @return  0 or a positive result on success, returned by run() for
+   *          output functions
+   * @return  negative errno value on error
+   */
+  using io_function = int (*)(tflite::MicroInterpreter& interpreter,
+                              void* arg);
+
+  /**
+   * @brief   Create a model
+   *
+   * @param[in] name        name of the model, in the statistics
+   * @param[in] flatbuffer  the model in the TensorFlow Lite format
+   * @param[in] resolver    operators of the model
+   * @param[in] set_input   writes the input tensors before an inference
+   * @param[in] get_output  reads the output tensors after an inference
+   */
+  tflite_model(const char* name, const void* flatbuffer,
+               const tflite::OpResolver& resolver, io_function set_input,
+               io_function get_output);
+
+  tflite_model(const tflite_model&) = delete;
+  tflite_model& operator=(const tflite_model&) = delete;
+
+  /**
+   * @brief   Run an inference and wait for its result
+   *
+   * @param[in] arg   argument of the input and output functions
+   *
+   * @return  result of the output function
+   * @return  -ENOMEM if the model does not fit into the arena
+   * @return  -EINVAL if the model has an unsupported schema version
+   * @return  -EIO if the interpreter failed
+   * @return  -ECANCELED if the inference was cancelled
+   */
+  int run(void* arg = nullptr) { return ml_infer_run(&m_model, arg); }
+
+  /**
+   * @brief   Get the model of the inference manager, e.g. for
+   *          ml_infer_post()
+   */
+  ml_infer_model_t* native_handle() { return &m_model; }
+
+ private:
+  static int do_load(ml_infer_model_t* model, void* arena, size_t size);
+  static int do_run(ml_infer_model_t* model, void* arg);
+  static void do_unload(ml_infer_model_t* model);
+  static const ml_infer_driver_t driver;
+
+  ml_infer_model_t m_model;
+  const void* m_flatbuffer;
+  const tflite::OpResolver& m_resolver;
+  io_function m_set_input;
+  io_function m_get_output;
+  tflite::MicroInterpreter* m_interpreter;
+  alignas(tflite::MicroInterpreter)
+      unsigned char m_storage[sizeof(tflite::MicroInterpreter)];
+};
+
+} // namespace riot
+
+#endif // ML_INFER_TFLITE_HPP
+/** @} */
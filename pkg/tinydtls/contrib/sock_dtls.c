@@ -547,6 +547,88 @@ ssize_t sock_dtls_recv(sock_dtls_t *sock, sock_dtls_session_t *remote,
     }
 }
 
+/* releases all chunks of a buffer received with sock_udp_recv_buf() */
+static void _release_udp_buf(sock_udp_t *udp_sock, void *data_ctx)
+{
+    void *data;
+
+    while ((data_ctx != NULL) &&
+           (sock_udp_recv_buf(udp_sock, &data, &data_ctx, 0, NULL) > 0)) {}
+}
+
+ssize_t sock_dtls_recv_buf(sock_dtls_t *sock, sock_dtls_session_t *remote,
+                           void **data, void **buf_ctx, uint32_t timeout)
+{
+    assert(sock);
+    assert(data);
+    assert(buf_ctx);
+    assert(remote);
+
+    if (*buf_ctx != NULL) {
+        /* record returned by previous call was consumed */
+        _release_udp_buf(sock->udp_sock, *buf_ctx);
+        *data = NULL;
+        *buf_ctx = NULL;
+        return 0;
+    }
+
+    /* loop breaks when timeout or application data read */
+    while (1) {
+        ssize_t res;
+        uint32_t start_recv = xtimer_now_usec();
+        msg_t msg;
+        void *udp_ctx = NULL;
+        bool pending = false;
+
+#ifdef SOCK_HAS_ASYNC
+        if ((sock->buffer.data != NULL) && (sock->buf_ctx != NULL)) {
+            /* record decrypted by the asynchronous callback */
+            udp_ctx = sock->buf_ctx;
+            sock->buf_ctx = NULL;
+            pending = true;
+        }
+#endif
+        if (!pending) {
+            uint8_t *record;
+
+            if (mbox_try_get(&sock->mbox, &msg) &&
+                msg.type == DTLS_EVENT_CONNECTED) {
+                return _complete_handshake(sock, remote, msg.content.ptr);
+            }
+
+            res = sock_udp_recv_buf(sock->udp_sock, (void **)&record, &udp_ctx,
+                                    timeout, &remote->ep);
+            if (res <= 0) {
+                DEBUG("sock_dtls: error receiving UDP packet: %d\n", (int)res);
+                return res;
+            }
+            /* tinydtls decrypts in place, so the plaintext stays in the
+             * network stack's buffer */
+            _ep_to_session(&remote->ep, &remote->dtls_session);
+            dtls_handle_message(sock->dtls_ctx, &remote->dtls_session,
+                                record, res);
+        }
+
+        if (sock->buffer.data != NULL) {
+            *data = sock->buffer.data;
+            *buf_ctx = udp_ctx;
+            sock->buffer.data = NULL;
+            _copy_session(sock, remote);
+            return sock->buffer.datalen;
+        }
+        /* handshake or alert record */
+        _release_udp_buf(sock->udp_sock, udp_ctx);
+
+        if ((timeout != SOCK_NO_TIMEOUT) && (timeout != 0)) {
+            timeout = _update_timeout(start_recv, timeout);
+        }
+        if (timeout == 0) {
+            DEBUG("sock_dtls: timed out while decrypting message\n");
+            return -ETIMEDOUT;
+        }
+    }
+}
+
 void sock_dtls_close(sock_dtls_t *sock)
 {
     dtls_free_context(sock->dtls_ctx);
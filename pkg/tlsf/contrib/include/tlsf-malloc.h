@@ -16,14 +16,29 @@
  * It defines a global tlsf_control block and performs allocations on that
  * block. This implementation replaces the system malloc
  *
- * Additionally, the calls to TLSF are wrapped in irq_disable()/irq_restore(),
- * to make it thread-safe.
+ * Every heap (arena) is protected by its own mutex, so allocations in
+ * different arenas do not block each other and interrupts stay enabled. In
+ * ISRs, an allocation fails if the arena is in use by a thread, and a freed
+ * block is queued and released with the next operation on the arena.
  *
  * If this module is used as the system memory allocator, then the global memory
  * control block should be initialized as the first thing before the stdlib is
  * used. Boards should use tlsf_add_global_pool() at startup to add all the memory
  * regions they want to make available for dynamic allocation via malloc().
  *
+ * ## Arenas
+ *
+ * Components that allocate a lot, e.g. a network stack, a TLS library and a
+ * script interpreter, can be kept from starving each other by giving them an
+ * arena of their own. An arena is created on a memory area with
+ * tlsf_arena_init() and bound to the threads of the component with
+ * tlsf_arena_bind(). malloc() in a bound thread then allocates from its
+ * arena, free() and realloc() work on the arena a block belongs to, no matter
+ * which thread calls them. Threads without an arena use the global heap.
+ *
+ * The `heap` shell command prints the size, usage, high-water mark and
+ * fragmentation of every arena, see tlsf_arena_print_stats().
+ *
  * @{
  * @file
  *
@@ -38,6 +53,8 @@
 
 #include <stddef.h>
 
+#include "mutex.h"
+#include "sched.h"
 #include "tlsf.h"
 
 #ifdef __cplusplus
@@ -53,6 +70,37 @@ typedef struct {
     unsigned used;          /**< total used size */
 } tlsf_size_container_t;
 
+/**
+ * @brief   Arena: a TLSF heap with its own lock and statistics
+ *
+ * All members are private.
+ */
+typedef struct tlsf_arena {
+    struct tlsf_arena *next;    /**< next arena in the list of arenas */
+    const char *name;           /**< name shown in the statistics */
+    tlsf_t tlsf;                /**< TLSF control block */
+    mutex_t lock;               /**< lock of the arena */
+    void *deferred;             /**< blocks freed in ISRs while locked */
+    const void *start;          /**< start of the memory area */
+    const void *end;            /**< end of the memory area */
+    size_t size;                /**< size of the memory area(s) */
+    size_t used;                /**< size of the allocated blocks */
+    size_t used_max;            /**< high-water mark of @ref used */
+    unsigned fails;             /**< number of failed allocations */
+} tlsf_arena_t;
+
+/**
+ * @brief   Statistics of an arena
+ */
+typedef struct {
+    size_t size;            /**< size of the memory area(s) */
+    size_t used;            /**< size of the allocated blocks */
+    size_t used_max;        /**< highest value of @ref used so far */
+    size_t free;            /**< size of the free blocks */
+    size_t free_max;        /**< size of the largest free block */
+    unsigned fails;         /**< number of failed allocations */
+} tlsf_arena_stats_t;
+
 /**
  * Walk the memory pool to print all block sizes and to calculate
  * the total amount of free and used block sizes.
@@ -89,6 +137,90 @@ int tlsf_add_global_pool(void *mem, size_t bytes);
  */
 tlsf_t _tlsf_get_global_control(void);
 
+/**
+ * @brief   Create an arena on a memory area
+ *
+ * @param[out]  arena   arena to initialize
+ * @param[in]   name    name of the arena shown in the statistics
+ * @param[in]   mem     memory area, should be aligned to 4 bytes
+ * @param[in]   bytes   size of @p mem
+ *
+ * @return  0 on success
+ * @return  -EINVAL if @p mem is too small or too large for TLSF
+ */
+int tlsf_arena_init(tlsf_arena_t *arena, const char *name, void *mem,
+                    size_t bytes);
+
+/**
+ * @brief   Let a thread allocate from an arena
+ *
+ * @param[in]   pid     thread to bind
+ * @param[in]   arena   arena to use, NULL for the global heap
+ */
+void tlsf_arena_bind(kernel_pid_t pid, tlsf_arena_t *arena);
+
+/**
+ * @brief   Get the arena used by the calling thread
+ *
+ * @return  the bound arena, or the global heap for unbound threads and ISRs
+ */
+tlsf_arena_t *tlsf_arena_get(void);
+
+/**
+ * @brief   Allocate a block from an arena
+ *
+ * @param[in]   arena   arena to allocate from
+ * @param[in]   bytes   size of the block
+ *
+ * @return  the block, NULL if the arena is exhausted or locked (in ISRs)
+ */
+void *tlsf_arena_malloc(tlsf_arena_t *arena, size_t bytes);
+
+/**
+ * @brief   Allocate an aligned block from an arena
+ *
+ * @param[in]   arena   arena to allocate from
+ * @param[in]   align   alignment of the block
+ * @param[in]   bytes   size of the block
+ *
+ * @return  the block, NULL if the arena is exhausted or locked (in ISRs)
+ */
+void *tlsf_arena_memalign(tlsf_arena_t *arena, size_t align, size_t bytes);
+
+/**
+ * @brief   Resize a block within the arena it belongs to
+ *
+ * @param[in]   ptr     block to resize, NULL to allocate from the arena of
+ *                      the calling thread
+ * @param[in]   bytes   new size of the block
+ *
+ * @return  the resized block, NULL on failure with @p ptr still valid
+ */
+void *tlsf_arena_realloc(void *ptr, size_t bytes);
+
+/**
+ * @brief   Return a block to the arena it belongs to
+ *
+ * @param[in]   ptr     block to free, may be NULL
+ */
+void tlsf_arena_free(void *ptr);
+
+/**
+ * @brief   Get the statistics of an arena
+ *
+ * @note    @p free and @p free_max only cover the first memory area of the
+ *          global heap.
+ *
+ * @param[in]   arena   arena to query
+ * @param[out]  stats   statistics
+ */
+void tlsf_arena_get_stats(tlsf_arena_t *arena, tlsf_arena_stats_t *stats);
+
+/**
+ * @brief   Print the statistics of all arenas
+ */
+void tlsf_arena_print_stats(void);
+
 
 #ifdef __cplusplus
 }
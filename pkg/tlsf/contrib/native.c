@@ -23,7 +23,6 @@
 #include <string.h>
 #include <errno.h>
 
-#include "irq.h"
 #include "tlsf.h"
 #include "tlsf-malloc.h"
 #include "tlsf-malloc-internal.h"
@@ -47,21 +46,17 @@
 
 #endif /* __GNUC__ */
 
-extern tlsf_t tlsf_malloc_gheap;
-
 /**
  * Allocate a block of size "bytes"
  */
 ATTR_MALLOC void *malloc(size_t bytes)
 {
-    unsigned old_state = irq_disable();
-    void *result = tlsf_malloc(tlsf_malloc_gheap, bytes);
+    void *result = tlsf_arena_malloc(tlsf_arena_get(), bytes);
 
     if (result == NULL) {
         errno = ENOMEM;
     }
 
-    irq_restore(old_state);
     return result;
 }
 
@@ -83,14 +78,12 @@ ATTR_CALLOC void *calloc(size_t count, size_t bytes)
  */
 ATTR_MALIGN void *memalign(size_t align, size_t bytes)
 {
-    unsigned old_state = irq_disable();
-    void *result = tlsf_memalign(tlsf_malloc_gheap, align, bytes);
+    void *result = tlsf_arena_memalign(tlsf_arena_get(), align, bytes);
 
     if (result == NULL) {
         errno = ENOMEM;
     }
 
-    irq_restore(old_state);
     return result;
 }
 
@@ -99,14 +92,12 @@ ATTR_MALIGN void *memalign(size_t align, size_t bytes)
  */
 ATTR_REALLOC void *realloc(void *ptr, size_t size)
 {
-    unsigned old_state = irq_disable();
-    void *result = tlsf_realloc(tlsf_malloc_gheap, ptr, size);
+    void *result = tlsf_arena_realloc(ptr, size);
 
-    if (result == NULL) {
+    if ((result == NULL) && size) {
         errno = ENOMEM;
     }
 
-    irq_restore(old_state);
     return result;
 }
 
@@ -116,8 +107,5 @@ ATTR_REALLOC void *realloc(void *ptr, size_t size)
  */
 void free(void *ptr)
 {
-    unsigned old_state = irq_disable();
-
-    tlsf_free(tlsf_malloc_gheap, ptr);
-    irq_restore(old_state);
+    tlsf_arena_free(ptr);
 }
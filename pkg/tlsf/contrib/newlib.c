@@ -25,7 +25,6 @@
 #include <reent.h>
 #include <errno.h>
 
-#include "irq.h"
 #include "tlsf.h"
 #include "tlsf-malloc.h"
 #include "tlsf-malloc-internal.h"
@@ -55,14 +54,12 @@
  */
 ATTR_MALLOCR void *_malloc_r(struct _reent *reent_ptr, size_t bytes)
 {
-    unsigned old_state = irq_disable();
-    void *result = tlsf_malloc(tlsf_malloc_gheap, bytes);
+    void *result = tlsf_arena_malloc(tlsf_arena_get(), bytes);
 
     if (result == NULL) {
         reent_ptr->_errno = ENOMEM;
     }
 
-    irq_restore(old_state);
     return result;
 }
 
@@ -84,14 +81,12 @@ ATTR_CALLOCR void *_calloc_r(struct _reent *reent_ptr, size_t count, size_t byte
  */
 ATTR_MALIGNR void *_memalign_r(struct _reent *reent_ptr, size_t align, size_t bytes)
 {
-    unsigned old_state = irq_disable();
-    void *result = tlsf_memalign(tlsf_malloc_gheap, align, bytes);
+    void *result = tlsf_arena_memalign(tlsf_arena_get(), align, bytes);
 
     if (result == NULL) {
         reent_ptr->_errno = ENOMEM;
     }
 
-    irq_restore(old_state);
     return result;
 }
 
@@ -100,14 +95,12 @@ ATTR_MALIGNR void *_memalign_r(struct _reent *reent_ptr, size_t align, size_t by
  */
 ATTR_REALLOCR void *_realloc_r(struct _reent *reent_ptr, void *ptr, size_t size)
 {
-    unsigned old_state = irq_disable();
-    void *result = tlsf_realloc(tlsf_malloc_gheap, ptr, size);
+    void *result = tlsf_arena_realloc(ptr, size);
 
-    if (result == NULL) {
+    if ((result == NULL) && size) {
         reent_ptr->_errno = ENOMEM;
     }
 
-    irq_restore(old_state);
     return result;
 }
 
@@ -116,11 +109,9 @@ ATTR_REALLOCR void *_realloc_r(struct _reent *reent_ptr, void *ptr, size_t size)
  */
 void _free_r(struct _reent *reent_ptr, void *ptr)
 {
-    unsigned old_state = irq_disable();
     (void)reent_ptr;
 
-    tlsf_free(tlsf_malloc_gheap, ptr);
-    irq_restore(old_state);
+    tlsf_arena_free(ptr);
 }
 
 /**
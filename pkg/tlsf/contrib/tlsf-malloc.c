@@ -17,8 +17,16 @@
  *
  */
 
+#include <assert.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 
+#include "irq.h"
+#include "mutex.h"
+#include "sched.h"
+#include "thread.h"
 #include "tlsf.h"
 #include "tlsf-malloc.h"
 #include "tlsf-malloc-internal.h"
@@ -28,14 +36,238 @@
  **/
 tlsf_t tlsf_malloc_gheap = NULL;
 
+static tlsf_arena_t _global = {
+    .name = "global",
+    .lock = MUTEX_INIT,
+};
+
+/* list of all arenas, starting with the global heap */
+static tlsf_arena_t *_arenas = &_global;
+
+/* arena of each thread, NULL for the global heap */
+static tlsf_arena_t *_bound[KERNEL_PID_LAST + 1];
+
 int tlsf_add_global_pool(void *mem, size_t bytes)
 {
     if (tlsf_malloc_gheap == NULL) {
         tlsf_malloc_gheap = tlsf_create_with_pool(mem, bytes);
-        return tlsf_malloc_gheap == NULL;
+        if (tlsf_malloc_gheap == NULL) {
+            return 1;
+        }
+    }
+    else if (tlsf_add_pool(tlsf_malloc_gheap, mem, bytes) == NULL) {
+        return 1;
+    }
+    _global.tlsf = tlsf_malloc_gheap;
+    _global.size += bytes;
+    return 0;
+}
+
+int tlsf_arena_init(tlsf_arena_t *arena, const char *name, void *mem,
+                    size_t bytes)
+{
+    tlsf_t tlsf = tlsf_create_with_pool(mem, bytes);
+
+    if (tlsf == NULL) {
+        return -EINVAL;
+    }
+
+    *arena = (tlsf_arena_t){
+        .name = name,
+        .tlsf = tlsf,
+        .lock = MUTEX_INIT,
+        .start = mem,
+        .end = (uint8_t *)mem + bytes,
+        .size = bytes,
+    };
+
+    unsigned state = irq_disable();
+    arena->next = _arenas->next;
+    _arenas->next = arena;
+    irq_restore(state);
+
+    return 0;
+}
+
+void tlsf_arena_bind(kernel_pid_t pid, tlsf_arena_t *arena)
+{
+    assert(pid_is_valid(pid));
+    _bound[pid] = arena;
+}
+
+tlsf_arena_t *tlsf_arena_get(void)
+{
+    tlsf_arena_t *arena = NULL;
+
+    if (!irq_is_in() && pid_is_valid(thread_getpid())) {
+        arena = _bound[thread_getpid()];
+    }
+    return arena ? arena : &_global;
+}
+
+static tlsf_arena_t *_owner(const void *ptr)
+{
+    /* the global heap may consist of several areas, so it is the one left
+     * if no other arena contains the block */
+    for (tlsf_arena_t *arena = _arenas->next; arena; arena = arena->next) {
+        if ((ptr >= arena->start) && (ptr < arena->end)) {
+            return arena;
+        }
+    }
+    return &_global;
+}
+
+static void _free_locked(tlsf_arena_t *arena, void *ptr)
+{
+    arena->used -= tlsf_block_size(ptr);
+    tlsf_free(arena->tlsf, ptr);
+}
+
+static bool _lock(tlsf_arena_t *arena)
+{
+    if (irq_is_in()) {
+        if (!mutex_trylock(&arena->lock)) {
+            return false;
+        }
     }
     else {
-        return tlsf_add_pool(tlsf_malloc_gheap, mem, bytes) == NULL;
+        mutex_lock(&arena->lock);
+    }
+
+    /* release the blocks freed by ISRs while the arena was locked */
+    unsigned state = irq_disable();
+    void *ptr = arena->deferred;
+    arena->deferred = NULL;
+    irq_restore(state);
+
+    while (ptr) {
+        void *next = *(void **)ptr;
+        _free_locked(arena, ptr);
+        ptr = next;
+    }
+    return true;
+}
+
+static void *_account(tlsf_arena_t *arena, void *ptr)
+{
+    if (ptr == NULL) {
+        arena->fails++;
+        return NULL;
+    }
+    arena->used += tlsf_block_size(ptr);
+    if (arena->used > arena->used_max) {
+        arena->used_max = arena->used;
+    }
+    return ptr;
+}
+
+void *tlsf_arena_malloc(tlsf_arena_t *arena, size_t bytes)
+{
+    if (!_lock(arena)) {
+        return NULL;
+    }
+    void *ptr = _account(arena, tlsf_malloc(arena->tlsf, bytes));
+    mutex_unlock(&arena->lock);
+
+    return ptr;
+}
+
+void *tlsf_arena_memalign(tlsf_arena_t *arena, size_t align, size_t bytes)
+{
+    if (!_lock(arena)) {
+        return NULL;
+    }
+    void *ptr = _account(arena, tlsf_memalign(arena->tlsf, align, bytes));
+    mutex_unlock(&arena->lock);
+
+    return ptr;
+}
+
+void *tlsf_arena_realloc(void *ptr, size_t bytes)
+{
+    tlsf_arena_t *arena = ptr ? _owner(ptr) : tlsf_arena_get();
+
+    if (!_lock(arena)) {
+        return NULL;
+    }
+    size_t old = ptr ? tlsf_block_size(ptr) : 0;
+    void *res = tlsf_realloc(arena->tlsf, ptr, bytes);
+    if (res || !bytes) {
+        /* a zero size realloc frees the block */
+        arena->used -= old;
+    }
+    if (bytes) {
+        res = _account(arena, res);
+    }
+    mutex_unlock(&arena->lock);
+
+    return res;
+}
+
+void tlsf_arena_free(void *ptr)
+{
+    if (ptr == NULL) {
+        return;
+    }
+
+    tlsf_arena_t *arena = _owner(ptr);
+    if (!_lock(arena)) {
+        /* an ISR interrupted a thread working on the arena */
+        unsigned state = irq_disable();
+        *(void **)ptr = arena->deferred;
+        arena->deferred = ptr;
+        irq_restore(state);
+        return;
+    }
+    _free_locked(arena, ptr);
+    mutex_unlock(&arena->lock);
+}
+
+static void _stats_walker(void *ptr, size_t size, int used, void *user)
+{
+    tlsf_arena_stats_t *stats = user;
+
+    (void)ptr;
+    if (!used) {
+        stats->free += size;
+        if (size > stats->free_max) {
+            stats->free_max = size;
+        }
+    }
+}
+
+void tlsf_arena_get_stats(tlsf_arena_t *arena, tlsf_arena_stats_t *stats)
+{
+    *stats = (tlsf_arena_stats_t){ 0 };
+    if (arena->tlsf == NULL) {
+        return;
+    }
+
+    _lock(arena);
+    stats->size = arena->size;
+    stats->used = arena->used;
+    stats->used_max = arena->used_max;
+    stats->fails = arena->fails;
+    tlsf_walk_pool(tlsf_get_pool(arena->tlsf), _stats_walker, stats);
+    mutex_unlock(&arena->lock);
+}
+
+void tlsf_arena_print_stats(void)
+{
+    puts("arena        size    used     max    free  largest  frag  fails");
+    for (tlsf_arena_t *arena = _arenas; arena; arena = arena->next) {
+        tlsf_arena_stats_t stats;
+
+        tlsf_arena_get_stats(arena, &stats);
+        /* fragmentation: share of the free memory not usable for the
+         * largest possible allocation */
+        unsigned frag = stats.free
+                      ? 100 - (unsigned)((uint64_t)stats.free_max * 100 / stats.free)
+                      : 0;
+        printf("%-10s %6u  %6u  %6u  %6u  %7u  %3u%%  %5u\n", arena->name,
+               (unsigned)stats.size, (unsigned)stats.used,
+               (unsigned)stats.used_max, (unsigned)stats.free,
+               (unsigned)stats.free_max, frag, stats.fails);
     }
 }
 
@@ -49,6 +49,22 @@ bool lwm2m_device_reboot_requested(void);
  */
 static void *_lwm2m_client_run(void *arg);
 
+/**
+ * @brief Builds the object index of @p client_data from @p obj_list
+ *
+ * @return 0 on success
+ * @return -ENOMEM if the index could not be allocated
+ */
+static int _index_objects(lwm2m_client_data_t *client_data,
+                          lwm2m_object_t *obj_list[], uint16_t obj_numof);
+
+/**
+ * @brief Passes the changes queued by lwm2m_client_notify() to Wakaama
+ *
+ * @note Must only be called from the client thread
+ */
+static void _notify_flush(lwm2m_client_data_t *client_data);
+
 
 static char _lwm2m_client_stack[THREAD_STACKSIZE_MAIN +
                                 THREAD_EXTRA_STACKSIZE_PRINTF];
@@ -56,10 +72,137 @@ static lwm2m_client_data_t *_client_data;
 
 void lwm2m_client_init(lwm2m_client_data_t *client_data)
 {
-    (void)client_data;
+    mutex_init(&client_data->notify_lock);
+    client_data->notify_numof = 0;
+    client_data->notify_all = false;
     lwm2m_platform_init();
 }
 
+lwm2m_object_t *lwm2m_client_get_object(lwm2m_client_data_t *client_data,
+                                        uint16_t obj_id)
+{
+    int lo = 0;
+    int hi = (int)client_data->obj_numof - 1;
+
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        lwm2m_object_t *obj = client_data->obj_index[mid];
+
+        if (obj->objID == obj_id) {
+            return obj;
+        }
+        if (obj->objID < obj_id) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid - 1;
+        }
+    }
+    return NULL;
+}
+
+static bool _uri_equal(const lwm2m_uri_t *a, const lwm2m_uri_t *b)
+{
+    if ((a->flag != b->flag) || (a->objectId != b->objectId)) {
+        return false;
+    }
+    if ((a->flag & LWM2M_URI_FLAG_INSTANCE_ID) &&
+        (a->instanceId != b->instanceId)) {
+        return false;
+    }
+    if ((a->flag & LWM2M_URI_FLAG_RESOURCE_ID) &&
+        (a->resourceId != b->resourceId)) {
+        return false;
+    }
+    return true;
+}
+
+int lwm2m_client_notify(lwm2m_client_data_t *client_data,
+                        const lwm2m_uri_t *uri)
+{
+    if (!lwm2m_client_get_object(client_data, uri->objectId)) {
+        return -ENOENT;
+    }
+
+    mutex_lock(&client_data->notify_lock);
+    if (!client_data->notify_all) {
+        unsigned i;
+
+        for (i = 0; i < client_data->notify_numof; i++) {
+            if (_uri_equal(&client_data->notify_queue[i], uri)) {
+                break;
+            }
+        }
+        if (i == client_data->notify_numof) {
+            if (i < CONFIG_LWM2M_NOTIFY_QUEUE_SIZE) {
+                client_data->notify_queue[i] = *uri;
+                client_data->notify_numof++;
+            }
+            else {
+                DEBUG("[lwm2m_client_notify] queue full, notifying all\n");
+                client_data->notify_all = true;
+            }
+        }
+    }
+    mutex_unlock(&client_data->notify_lock);
+    return 0;
+}
+
+static void _notify_flush(lwm2m_client_data_t *client_data)
+{
+    lwm2m_uri_t queue[CONFIG_LWM2M_NOTIFY_QUEUE_SIZE];
+    unsigned numof;
+    bool all;
+
+    /* do not hold the lock while Wakaama walks its observations */
+    mutex_lock(&client_data->notify_lock);
+    numof = client_data->notify_numof;
+    all = client_data->notify_all;
+    memcpy(queue, client_data->notify_queue, numof * sizeof(queue[0]));
+    client_data->notify_numof = 0;
+    client_data->notify_all = false;
+    mutex_unlock(&client_data->notify_lock);
+
+    if (all) {
+        for (unsigned i = 0; i < client_data->obj_numof; i++) {
+            lwm2m_uri_t uri = { .objectId = client_data->obj_index[i]->objID };
+
+            lwm2m_resource_value_changed(client_data->lwm2m_ctx, &uri);
+        }
+        return;
+    }
+    for (unsigned i = 0; i < numof; i++) {
+        lwm2m_resource_value_changed(client_data->lwm2m_ctx, &queue[i]);
+    }
+}
+
+static int _index_objects(lwm2m_client_data_t *client_data,
+                          lwm2m_object_t *obj_list[], uint16_t obj_numof)
+{
+    lwm2m_object_t **index = lwm2m_malloc(obj_numof * sizeof(*index));
+
+    if (!index) {
+        return -ENOMEM;
+    }
+    /* insertion sort, the list is short and usually sorted already */
+    for (unsigned i = 0; i < obj_numof; i++) {
+        unsigned j = i;
+
+        while ((j > 0) && (index[j - 1]->objID > obj_list[i]->objID)) {
+            index[j] = index[j - 1];
+            j--;
+        }
+        index[j] = obj_list[i];
+    }
+
+    if (client_data->obj_index) {
+        lwm2m_free(client_data->obj_index);
+    }
+    client_data->obj_index = index;
+    client_data->obj_numof = obj_numof;
+    return 0;
+}
+
 lwm2m_context_t *lwm2m_client_run(lwm2m_client_data_t *client_data,
                                   lwm2m_object_t *obj_list[],
                                   uint16_t obj_numof)
@@ -91,6 +234,11 @@ lwm2m_context_t *lwm2m_client_run(lwm2m_client_data_t *client_data,
         return NULL;
     }
 
+    if (_index_objects(_client_data, obj_list, obj_numof)) {
+        DEBUG("[lwm2m_client_run] Failed to index objects\n");
+        return NULL;
+    }
+
     _client_data->pid = thread_create(_lwm2m_client_stack,
                                      sizeof(_lwm2m_client_stack),
                                      THREAD_PRIORITY_MAIN - 1,
@@ -137,7 +285,11 @@ static void *_lwm2m_client_run(void *arg)
          *  - Secondly it adjusts the timeout value (default 60s) depending on the
          * state of the transaction
          *    (eg. retransmission) and the time between the next operation
+         *
+         * Changes queued since the last step are passed first, so that their
+         * notifications are sent together.
          */
+        _notify_flush(_client_data);
         lwm2m_step(_client_data->lwm2m_ctx, &tv);
         DEBUG(" -> State: ");
         switch (_client_data->lwm2m_ctx->state) {
@@ -148,6 +148,17 @@ void *lwm2m_connect_server(uint16_t sec_obj_inst_id, void *user_data)
 
     new_conn = _connection_create(instance->id, client_data);
     if (new_conn) {
+        /* a bootstrap and a registration session to the same server share
+         * the connection */
+        lwm2m_client_connection_t *conn = lwm2m_client_connection_find(
+                                client_data->conn_list, &new_conn->remote);
+        if (conn) {
+            DEBUG("[lwm2m_connect_server] Reusing connection\n");
+            lwm2m_free(new_conn);
+            conn->refs++;
+            return conn;
+        }
+
         DEBUG("[lwm2m_connect_server] Connection created\n");
         /* if the connections list is empty this is the first node, if not
          * attach to the last one */
@@ -171,8 +182,13 @@ void lwm2m_close_connection(void *sessionH, void *user_data)
     lwm2m_client_connection_t *conn = (lwm2m_client_connection_t *) sessionH;
     lwm2m_client_data_t *client_data = (lwm2m_client_data_t *) user_data;
 
+    if (--conn->refs > 0) {
+        return;
+    }
+
     if (conn == client_data->conn_list) {
         client_data->conn_list = conn->next;
+        lwm2m_free(conn);
     }
     else {
         lwm2m_client_connection_t *prev = client_data->conn_list;
@@ -223,19 +239,19 @@ lwm2m_client_connection_t *lwm2m_client_connection_find(
 {
     lwm2m_client_connection_t *conn = conn_list;
 
-    char ip[128];
-    uint8_t ip_len = 128;
+    if (ENABLE_DEBUG) {
+        char ip[IPV6_ADDR_MAX_STR_LEN];
 
-    ipv6_addr_to_str(ip, (ipv6_addr_t *)&remote->addr.ipv6, ip_len);
-    DEBUG("Looking for connection from [%s]:%d\n", ip, remote->port);
+        ipv6_addr_to_str(ip, (ipv6_addr_t *)&remote->addr.ipv6, sizeof(ip));
+        DEBUG("Looking for connection from [%s]:%d\n", ip, remote->port);
+    }
 
     if (conn_list == NULL) {
         DEBUG("Conn list is null!");
     }
 
+    /* this runs for every received packet, so only compare here */
     while(conn != NULL) {
-        ipv6_addr_to_str(ip, (ipv6_addr_t *)&conn->remote.addr.ipv6, ip_len);
-        DEBUG("Comparing to [%s]:%d\n", ip, conn->remote.port);
         if ((conn->remote.port == remote->port) &&
             ipv6_addr_equal((ipv6_addr_t *)&(conn->remote.addr.ipv6),
                             (ipv6_addr_t *)&(remote->addr.ipv6))) {
@@ -385,7 +401,8 @@ static lwm2m_client_connection_t *_connection_create(int instance_id,
         DEBUG("[_connection_create] Could not allocate new connection\n");
         goto out;
     }
-    conn->next = client_data->conn_list;
+    conn->next = NULL;
+    conn->refs = 1;
 
     /* configure to any IPv6 */
     conn->remote.family = AF_INET6;
@@ -34,6 +34,7 @@ extern "C" {
 #include <unistd.h>
 #include <sys/time.h>
 
+#include "mutex.h"
 #include "periph/pm.h"
 #include "net/sock/udp.h"
 
@@ -47,6 +48,7 @@ typedef struct lwm2m_client_connection {
     struct lwm2m_client_connection *next; /**< pointer to the next connection */
     sock_udp_ep_t remote; /**< remote endpoint */
     time_t last_send; /**< last sent packet to the server */
+    uint8_t refs; /**< number of sessions using the connection */
 } lwm2m_client_connection_t;
 
 /**
@@ -59,6 +61,13 @@ typedef struct {
     lwm2m_context_t *lwm2m_ctx;    /**< LwM2M context */
     lwm2m_object_t *obj_security;  /**< LwM2M security object */
     lwm2m_client_connection_t *conn_list; /**< LwM2M connections list */
+    lwm2m_object_t **obj_index;    /**< registered objects sorted by ID */
+    uint16_t obj_numof;            /**< number of objects in obj_index */
+    mutex_t notify_lock;           /**< protects the notification queue */
+    uint8_t notify_numof;          /**< number of queued changes */
+    bool notify_all;               /**< queue overflowed, notify all objects */
+    lwm2m_uri_t notify_queue[CONFIG_LWM2M_NOTIFY_QUEUE_SIZE]; /**< changed
+                                        URIs not yet passed to Wakaama */
 } lwm2m_client_data_t;
 
 /**
@@ -103,6 +112,40 @@ lwm2m_context_t *lwm2m_client_run(lwm2m_client_data_t *client_data,
  */
 void lwm2m_client_init(lwm2m_client_data_t *client_data);
 
+/**
+ * @brief Finds a registered object by its ID
+ *
+ * Objects are indexed when the client is started, so this does a binary
+ * search instead of walking the object list.
+ *
+ * @param[in] client_data Pointer to a LwM2M client data descriptor
+ * @param[in] obj_id      ID of the object
+ *
+ * @return Pointer to the object
+ * @return NULL if no such object was passed to lwm2m_client_run()
+ */
+lwm2m_object_t *lwm2m_client_get_object(lwm2m_client_data_t *client_data,
+                                        uint16_t obj_id);
+
+/**
+ * @brief Reports a changed value of an object, instance or resource
+ *
+ * Unlike lwm2m_resource_value_changed(), this may be called from any thread.
+ * Changes are queued and passed to Wakaama by the client thread right before
+ * it steps the LwM2M state machine, so changes reported in the meantime end
+ * up in the same step, and a URI reported several times is notified once.
+ * If the queue of @ref CONFIG_LWM2M_NOTIFY_QUEUE_SIZE entries overflows,
+ * all objects are marked as changed.
+ *
+ * @param[in] client_data Pointer to a LwM2M client data descriptor
+ * @param[in] uri         URI that changed
+ *
+ * @return 0 on success
+ * @return -ENOENT if the object of @p uri is not registered
+ */
+int lwm2m_client_notify(lwm2m_client_data_t *client_data,
+                        const lwm2m_uri_t *uri);
+
 /**
  * @brief Returns the LwM2M context of a LwM2M client
  *
@@ -90,6 +90,14 @@ extern "C" {
 #define CONFIG_LWM2M_SERVER_ID 10
 #endif
 
+/**
+ * @brief Number of changed URIs lwm2m_client_notify() queues between two
+ *        steps of the client
+ */
+#ifndef CONFIG_LWM2M_NOTIFY_QUEUE_SIZE
+#define CONFIG_LWM2M_NOTIFY_QUEUE_SIZE 8
+#endif
+
 /**
  * @brief Alternate path to place LwM2M resources
  */
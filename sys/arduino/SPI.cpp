@@ -22,6 +22,7 @@
 
 extern "C" {
 #include "assert.h"
+#include "mutex.h"
 }
 
 #include "SPI.h"
@@ -64,6 +65,13 @@ SPISettings::SPISettings(uint32_t clock_hz, uint8_t bitOrder, uint8_t dataMode)
     clock = SPI_CLK_100KHZ;
 }
 
+#ifdef PERIPH_SPI_HAS_TRANSFER_ASYNC
+static void _transfer_done(void *arg)
+{
+    mutex_unlock((mutex_t *)arg);
+}
+#endif
+
 SPIClass::SPIClass(spi_t spi_dev)
 {
     /* Check if default SPI interface is valid */
@@ -108,7 +116,22 @@ void SPIClass::transfer(void *buf, size_t count)
             return;
         }
     }
+#ifdef PERIPH_SPI_HAS_TRANSFER_ASYNC
+    /* let the DMA do the transfer and sleep meanwhile, so other threads can
+     * run */
+    mutex_t done = MUTEX_INIT_LOCKED;
+    spi_async_xfer_t xfer = {};
+    xfer.out = buf;
+    xfer.in = buf;
+    xfer.len = count;
+    xfer.cs = SPI_CS_UNDEF;
+    xfer.cb = _transfer_done;
+    xfer.arg = &done;
+    spi_transfer_async(spi_dev, &xfer);
+    mutex_lock(&done);
+#else
     spi_transfer_bytes(spi_dev, SPI_CS_UNDEF, false, buf, buf, count);
+#endif
     if (!is_transaction) {
         spi_release(spi_dev);
     }
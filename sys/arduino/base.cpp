@@ -19,6 +19,7 @@
  */
 
 extern "C" {
+#include "thread.h"
 #include "xtimer.h"
 #include "periph/gpio.h"
 #include "periph/adc.h"
@@ -68,6 +69,16 @@ void delayMicroseconds(unsigned long usec)
     xtimer_usleep(usec);
 }
 
+void yield(void)
+{
+    if (ARDUINO_YIELD_US) {
+        xtimer_usleep(ARDUINO_YIELD_US);
+    }
+    else {
+        thread_yield();
+    }
+}
+
 unsigned long micros()
 {
     return xtimer_now_usec();
@@ -63,6 +63,15 @@ enum {
 #define ARDUINO_UART_DEV        UART_DEV(0)
 #endif
 
+#ifndef ARDUINO_YIELD_US
+/**
+ * @brief   Time yield() sleeps to let lower priority threads run [us]
+ *
+ * With 0, yield() only gives way to threads of the same priority.
+ */
+#define ARDUINO_YIELD_US        (1000U)
+#endif
+
 /**
  * @brief   Primary serial port (mapped to ARDUINO_UART_DEV)
  */
@@ -107,6 +116,14 @@ void delay(unsigned long msec);
  */
 void delayMicroseconds(unsigned long usec);
 
+/**
+ * @brief   Let other threads run while waiting, e.g. in a polling loop
+ *
+ * Sleeps for @ref ARDUINO_YIELD_US, so that lower priority threads get the
+ * CPU as well.
+ */
+void yield(void);
+
 /**
  * @brief   Returns the number of microseconds since start
  *
@@ -20,6 +20,7 @@
 #define ARDUINO_SERIAL_H
 
 extern "C" {
+#include "mutex.h"
 #include "ringbuffer.h"
 #include "periph/uart.h"
 }
@@ -29,6 +30,25 @@ extern "C" {
  */
 #define SERIAL_RX_BUFSIZE       (64)
 
+#if defined(MODULE_PERIPH_UART_DMA) || DOXYGEN
+/**
+ * @brief   TX buffer size, must be a power of two
+ *
+ * write() and print() return as soon as the data is in this buffer, the DMA
+ * sends it in the background.
+ */
+#ifndef SERIAL_TX_BUFSIZE
+#define SERIAL_TX_BUFSIZE       (64)
+#endif
+
+/**
+ * @brief   Size of the circular buffer the DMA receives into
+ */
+#ifndef SERIAL_RX_DMA_BUFSIZE
+#define SERIAL_RX_DMA_BUFSIZE   (32)
+#endif
+#endif
+
 /**
  * @brief   Formatting options for Serial.print(int, format)
  */
@@ -50,6 +70,21 @@ private:
     ringbuffer_t rx_buf;
     template<typename T> size_t _println(T val);
     template<typename T> size_t _println(T val, SerialFormat format);
+    void _write(const uint8_t *data, size_t len);
+#ifdef MODULE_PERIPH_UART_DMA
+    uint8_t tx_mem[SERIAL_TX_BUFSIZE];
+    unsigned tx_head;           /* bytes put into tx_mem in total */
+    unsigned tx_tail;           /* bytes sent in total */
+    unsigned tx_busy;           /* bytes currently sent by the DMA */
+    bool tx_no_dma;             /* the UART has no TX DMA */
+    mutex_t tx_lock;
+    mutex_t tx_room;
+    uint8_t rx_dma[SERIAL_RX_DMA_BUFSIZE];
+    unsigned _tx_next(void);
+    size_t _tx_put(const uint8_t *data, size_t len);
+    static void _tx_done(void *arg);
+    static void _rx_chunk(void *arg, const uint8_t *data, size_t len);
+#endif
 
 public:
     /**
@@ -481,6 +516,13 @@ public:
      * @return  the number of bytes written, reading that number is optional
      */
     int write(char *buf, int len);
+
+    /**
+     * @brief   Waits for the transmission of outgoing serial data to complete
+     *
+     * Copied from https://www.arduino.cc/en/Serial/Flush
+     */
+    void flush(void);
 };
 
 #endif /* ARDUINO_SERIAL_H */
@@ -38,6 +38,109 @@ SerialPort::SerialPort(uart_t dev)
     this->dev = dev;
 }
 
+#ifdef MODULE_PERIPH_UART_DMA
+#define TX_MASK     (SERIAL_TX_BUFSIZE - 1)
+
+/* the free running indices rely on this */
+static_assert((SERIAL_TX_BUFSIZE & TX_MASK) == 0,
+              "SERIAL_TX_BUFSIZE must be a power of two");
+
+void SerialPort::_rx_chunk(void *arg, const uint8_t *data, size_t len)
+{
+    ringbuffer_t *buf = (ringbuffer_t *)arg;
+    ringbuffer_add(buf, (const char *)data, len);
+}
+
+/* selects the next contiguous chunk to send, must be called with IRQs
+ * disabled or from the DMA callback */
+unsigned SerialPort::_tx_next(void)
+{
+    unsigned pending = tx_head - tx_tail;
+    unsigned contiguous = SERIAL_TX_BUFSIZE - (tx_tail & TX_MASK);
+
+    tx_busy = (pending < contiguous) ? pending : contiguous;
+    return tx_busy;
+}
+
+void SerialPort::_tx_done(void *arg)
+{
+    SerialPort *port = (SerialPort *)arg;
+
+    port->tx_tail += port->tx_busy;
+    if (port->_tx_next()) {
+        uart_write_async(port->dev, &port->tx_mem[port->tx_tail & TX_MASK],
+                         port->tx_busy, _tx_done, port);
+    }
+    /* wake up a writer waiting for room */
+    mutex_unlock(&port->tx_room);
+}
+
+/* copies as much as fits into the buffer and starts the DMA if idle */
+size_t SerialPort::_tx_put(const uint8_t *data, size_t len)
+{
+    unsigned state = irq_disable();
+    size_t room = SERIAL_TX_BUFSIZE - (tx_head - tx_tail);
+    size_t n = (len < room) ? len : room;
+
+    for (size_t i = 0; i < n; i++) {
+        tx_mem[(tx_head + i) & TX_MASK] = data[i];
+    }
+    tx_head += n;
+    bool start = !tx_busy && _tx_next();
+    irq_restore(state);
+
+    if (start && (uart_write_async(dev, &tx_mem[tx_tail & TX_MASK], tx_busy,
+                                   _tx_done, this) != UART_OK)) {
+        /* no TX DMA, this only happens on the first write after begin() */
+        tx_no_dma = true;
+        tx_busy = 0;
+        tx_tail = tx_head;
+        uart_write(dev, data, n);
+    }
+    return n;
+}
+#endif
+
+void SerialPort::_write(const uint8_t *data, size_t len)
+{
+#ifdef MODULE_PERIPH_UART_DMA
+    if (irq_is_in() || tx_no_dma) {
+        uart_write(dev, data, len);
+        return;
+    }
+
+    mutex_lock(&tx_lock);
+    while (len) {
+        size_t n = _tx_put(data, len);
+        data += n;
+        len -= n;
+        if (!len) {
+            break;
+        }
+        if (tx_no_dma) {
+            uart_write(dev, data, len);
+            break;
+        }
+        /* buffer full, sleep until the DMA made some room */
+        mutex_lock(&tx_room);
+    }
+    mutex_unlock(&tx_lock);
+#else
+    uart_write(dev, data, len);
+#endif
+}
+
+void SerialPort::flush(void)
+{
+#ifdef MODULE_PERIPH_UART_DMA
+    mutex_lock(&tx_lock);
+    while (tx_head != tx_tail) {
+        mutex_lock(&tx_room);
+    }
+    mutex_unlock(&tx_lock);
+#endif
+}
+
 int SerialPort::available(void)
 {
     return (int)rx_buf.avail;
@@ -47,11 +150,29 @@ void SerialPort::begin(long baudrate)
 {
     /* this clears the contents of the ringbuffer... */
     ringbuffer_init(&rx_buf, rx_mem, SERIAL_RX_BUFSIZE);
+#ifdef MODULE_PERIPH_UART_DMA
+    tx_head = 0;
+    tx_tail = 0;
+    tx_busy = 0;
+    tx_no_dma = false;
+    mutex_init(&tx_lock);
+    mutex_init(&tx_room);
+    mutex_lock(&tx_room);
+
+    /* receive in chunks, fall back to one interrupt per byte if the UART
+     * has no RX DMA */
+    uart_init(dev, (uint32_t)baudrate, NULL, NULL);
+    if (uart_rx_dma_start(dev, rx_dma, sizeof(rx_dma), _rx_chunk,
+                          (void *)&rx_buf) == UART_OK) {
+        return;
+    }
+#endif
     uart_init(dev, (uint32_t)baudrate, rx_cb, (void *)&rx_buf);
 }
 
 void SerialPort::end(void)
 {
+    flush();
     uart_poweroff(dev);
 }
 
@@ -261,18 +382,20 @@ int SerialPort::read(void)
 
 int SerialPort::write(int val)
 {
-    uart_write(dev, (uint8_t *)&val, 1);
+    uint8_t c = (uint8_t)val;
+
+    _write(&c, 1);
     return 1;
 }
 
 int SerialPort::write(const char *str)
 {
-    uart_write(dev, (uint8_t *)str, strlen(str));
+    _write((const uint8_t *)str, strlen(str));
     return strlen(str);
 }
 
 int SerialPort::write(char *buf, int len)
 {
-    uart_write(dev, (uint8_t *)buf, len);
+    _write((const uint8_t *)buf, len);
     return len;
 }
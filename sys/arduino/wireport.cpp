@@ -55,6 +55,48 @@ uint8_t TwoWire::txError = 0;
 
 uint8_t TwoWire::transmitting = 0;
 
+/* Runs a transfer on the bus. With periph_i2c_async, the transfer is
+ * executed by the I2C thread and the calling thread sleeps until it is done,
+ * so lower priority threads can run meanwhile. */
+static int _transfer(bool read, uint8_t addr, uint8_t *data, size_t len,
+                     uint8_t flags)
+{
+#ifdef MODULE_PERIPH_I2C_ASYNC
+    event_queue_t queue;
+    event_t done = {};
+    i2c_async_xfer_t xfer = {};
+
+    event_queue_init(&queue);
+    xfer.dev = ARDUINO_I2C_DEV;
+    xfer.op = read ? I2C_ASYNC_READ_BYTES : I2C_ASYNC_WRITE_BYTES;
+    xfer.addr = addr;
+    xfer.flags = flags;
+    xfer.data = data;
+    xfer.len = len;
+    xfer.done_queue = &queue;
+    xfer.done = &done;
+    i2c_transfer_async(&xfer);
+    event_wait(&queue);
+
+    return xfer.res;
+#else
+    int res;
+
+    if (i2c_acquire(ARDUINO_I2C_DEV) != 0) {
+        return -EINVAL;
+    }
+    if (read) {
+        res = i2c_read_bytes(ARDUINO_I2C_DEV, addr, data, len, flags);
+    }
+    else {
+        res = i2c_write_bytes(ARDUINO_I2C_DEV, addr, data, len, flags);
+    }
+    i2c_release(ARDUINO_I2C_DEV);
+
+    return res;
+#endif
+}
+
 /* Constructors */
 
 TwoWire::TwoWire(void)
@@ -101,12 +143,8 @@ uint8_t TwoWire::requestFrom(uint8_t addr, uint8_t size, uint8_t stop)
 
     uint8_t read = 0;
 
-    if (i2c_acquire(ARDUINO_I2C_DEV) == 0) {
-        if (i2c_read_bytes(ARDUINO_I2C_DEV, addr, rxBuffer, size,
-                           stop ? 0 : I2C_NOSTOP) == 0) {
-            read = size;
-        }
-        i2c_release(ARDUINO_I2C_DEV);
+    if (_transfer(true, addr, rxBuffer, size, stop ? 0 : I2C_NOSTOP) == 0) {
+        read = size;
     }
 
     rxBufferIndex = 0;
@@ -136,13 +174,8 @@ uint8_t TwoWire::endTransmission(uint8_t stop)
         return txError;
     }
 
-    if (i2c_acquire(ARDUINO_I2C_DEV) != 0) {
-        return WIRE_PORT_ERROR_OTHER;
-    }
-
-    int res = i2c_write_bytes(ARDUINO_I2C_DEV,
-                              txAddress, txBuffer, txBufferLength,
-                              stop ? 0 : I2C_NOSTOP);
+    int res = _transfer(false, txAddress, txBuffer, txBufferLength,
+                        stop ? 0 : I2C_NOSTOP);
     switch (res) {
         case 0: break;
         case ENXIO: res = WIRE_PORT_ERROR_ADDR_NACK;
@@ -152,8 +185,6 @@ uint8_t TwoWire::endTransmission(uint8_t stop)
         default: res = WIRE_PORT_ERROR_OTHER;
     }
 
-    i2c_release(ARDUINO_I2C_DEV);
-
     txBufferIndex = 0;
     txBufferLength = 0;
     txError = 0;
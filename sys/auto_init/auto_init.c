@@ -19,255 +19,388 @@
  * @author  Martine S. Lenders <m.lenders@fu-berlin.de>
  * @}
  */
+#include <inttypes.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
 
 #include "auto_init.h"
 #include "kernel_defines.h"
 #include "log.h"
+#if IS_USED(MODULE_AUTO_INIT_ASYNC)
+#include "mutex.h"
+#include "thread.h"
+#endif
+#if IS_USED(MODULE_AUTO_INIT_PROFILE)
+#include "ztimer.h"
+#endif
 
-void auto_init(void)
-{
-    if (IS_USED(MODULE_AUTO_INIT_RANDOM)) {
-        LOG_DEBUG("Auto init random.\n");
-        extern void auto_init_random(void);
-        auto_init_random();
-    }
-    if (IS_USED(MODULE_AUTO_INIT_ZTIMER)) {
-        LOG_DEBUG("Auto init ztimer.\n");
-        void ztimer_init(void);
-        ztimer_init();
-    }
-    if (IS_USED(MODULE_AUTO_INIT_XTIMER) &&
-            !IS_USED(MODULE_ZTIMER_XTIMER_COMPAT)) {
-        LOG_DEBUG("Auto init xtimer.\n");
-        extern void xtimer_init(void);
-        xtimer_init();
-    }
-    if (IS_USED(MODULE_SCHEDSTATISTICS)) {
-        LOG_DEBUG("Auto init schedstatistics.\n");
-        extern void init_schedstatistics(void);
-        init_schedstatistics();
-    }
-    if (IS_USED(MODULE_DUMMY_THREAD)) {
-        extern void dummy_thread_create(void);
-        dummy_thread_create();
-    }
-    if (IS_USED(MODULE_EVENT_THREAD)) {
-        LOG_DEBUG("Auto init event threads.\n");
-        extern void auto_init_event_thread(void);
-        auto_init_event_thread();
-    }
-    if (IS_USED(MODULE_MCI)) {
-        LOG_DEBUG("Auto init mci.\n");
-        extern void mci_initialize(void);
-        mci_initialize();
-    }
-    if (IS_USED(MODULE_PROFILING)) {
-        LOG_DEBUG("Auto init profiling.\n");
-        extern void profiling_init(void);
-        profiling_init();
-    }
-    if (IS_USED(MODULE_AUTO_INIT_GNRC_PKTBUF)) {
-        LOG_DEBUG("Auto init gnrc_pktbuf.\n");
-        extern void gnrc_pktbuf_init(void);
-        gnrc_pktbuf_init();
-    }
-    if (IS_USED(MODULE_AUTO_INIT_GNRC_PKTDUMP)) {
-        LOG_DEBUG("Auto init gnrc_pktdump.\n");
-        extern void gnrc_pktdump_init(void);
-        gnrc_pktdump_init();
-    }
-    if (IS_USED(MODULE_AUTO_INIT_GNRC_SIXLOWPAN)) {
-        LOG_DEBUG("Auto init gnrc_sixlowpan.\n");
-        extern void gnrc_sixlowpan_init(void);
-        gnrc_sixlowpan_init();
-    }
-    if (IS_USED(MODULE_AUTO_INIT_GNRC_IPV6)) {
-        LOG_DEBUG("Auto init gnrc_ipv6.\n");
-        extern void gnrc_ipv6_init(void);
-        gnrc_ipv6_init();
-    }
-    if (IS_USED(MODULE_AUTO_INIT_GNRC_UDP)) {
-        LOG_DEBUG("Auto init gnrc_udp.\n");
-        extern void gnrc_udp_init(void);
-        gnrc_udp_init();
-    }
-    if (IS_USED(MODULE_AUTO_INIT_GNRC_TCP)) {
-        LOG_DEBUG("Auto init gnrc_tcp.\n");
-        extern void gnrc_tcp_init(void);
-        gnrc_tcp_init();
-    }
-    if (IS_USED(MODULE_AUTO_INIT_LWIP)) {
-        LOG_DEBUG("Bootstraping lwIP.\n");
-        extern void lwip_bootstrap(void);
-        lwip_bootstrap();
-    }
-    if (IS_USED(MODULE_OPENTHREAD)) {
-        LOG_DEBUG("Bootstrapping openthread.\n");
-        extern void openthread_bootstrap(void);
-        openthread_bootstrap();
-    }
-    if (IS_USED(MODULE_AUTO_INIT_OPENWSN)) {
-        LOG_DEBUG("Bootstrapping openwsn.\n");
-        extern void openwsn_bootstrap(void);
-        openwsn_bootstrap();
-    }
-    if (IS_USED(MODULE_GCOAP) &&
-        !IS_ACTIVE(CONFIG_GCOAP_NO_AUTO_INIT)) {
-        LOG_DEBUG("Auto init gcoap.\n");
-        extern void gcoap_init(void);
-        gcoap_init();
-    }
-    if (IS_USED(MODULE_DEVFS)) {
-        LOG_DEBUG("Mounting /dev.\n");
-        extern void auto_init_devfs(void);
-        auto_init_devfs();
-    }
-    if (IS_USED(MODULE_AUTO_INIT_GNRC_IPV6_NIB)) {
-        LOG_DEBUG("Auto init gnrc_ipv6_nib.\n");
-        extern void gnrc_ipv6_nib_init(void);
-        gnrc_ipv6_nib_init();
-    }
-    if (IS_USED(MODULE_SKALD)) {
-        LOG_DEBUG("Auto init Skald.\n");
-        extern void skald_init(void);
-        skald_init();
-    }
-    if (IS_USED(MODULE_CORD_COMMON)) {
-        LOG_DEBUG("Auto init cord_common.\n");
-        extern void cord_common_init(void);
-        cord_common_init();
-    }
-    if (IS_USED(MODULE_CORD_EP_STANDALONE)) {
-        LOG_DEBUG("Auto init cord_ep_standalone.\n");
-        extern void cord_ep_standalone_run(void);
-        cord_ep_standalone_run();
-    }
-    if (IS_USED(MODULE_ASYMCUTE)) {
-        LOG_DEBUG("Auto init Asymcute.\n");
-        extern void asymcute_handler_run(void);
-        asymcute_handler_run();
-    }
-    if (IS_USED(MODULE_NIMBLE)) {
-        LOG_DEBUG("Auto init NimBLE.\n");
-        extern void nimble_riot_init(void);
-        nimble_riot_init();
-    }
-    if (IS_USED(MODULE_AUTO_INIT_LORAMAC)) {
-        LOG_DEBUG("Auto init loramac.\n");
-        extern void auto_init_loramac(void);
-        auto_init_loramac();
-    }
-    if (IS_USED(MODULE_SOCK_DTLS)) {
-        LOG_DEBUG("Auto init sock_dtls.\n");
-        extern void sock_dtls_init(void);
-        sock_dtls_init();
-    }
+/**
+ * @name    Flags of an initialization step
+ * @{
+ */
+#define AUTO_INIT_ASYNC     (0x01)  /**< may run on the init thread */
+#define AUTO_INIT_BARRIER   (0x02)  /**< waits for all previous async steps */
+#define AUTO_INIT_CLOCK     (0x04)  /**< starts the clock of the profile */
+/** @} */
 
-    /* initialize USB devices */
-    if (IS_USED(MODULE_AUTO_INIT_USBUS)) {
-        LOG_DEBUG("Auto init USB.\n");
-        extern void auto_init_usb(void);
-        auto_init_usb();
-    }
+/**
+ * @brief   Initialization step
+ *
+ * Each step depends on all synchronous steps before it in @ref _steps, a
+ * step flagged @ref AUTO_INIT_BARRIER on all steps before it.
+ */
+typedef struct {
+    void (*init)(void);     /**< init function */
+    const char *name;       /**< name for debug output and the profile */
+    uint8_t flags;          /**< AUTO_INIT_* flags */
+} auto_init_step_t;
 
+extern void auto_init_random(void);
+extern void ztimer_init(void);
+extern void xtimer_init(void);
+extern void walltime_init(void);
+extern void log_deferred_init(void);
+extern void trace_init(void);
+extern void metrics_init(void);
+extern void init_schedstatistics(void);
+extern void dummy_thread_create(void);
+extern void auto_init_event_thread(void);
+extern void ml_infer_init(void);
+extern void i2c_async_init(void);
+extern void mci_initialize(void);
+extern void profiling_init(void);
+extern void gnrc_pktbuf_init(void);
+extern void gnrc_pktdump_init(void);
+extern void gnrc_sixlowpan_init(void);
+extern void gnrc_ipv6_init(void);
+extern void gnrc_udp_init(void);
+extern void gnrc_tcp_init(void);
+extern void lwip_bootstrap(void);
+extern void openthread_bootstrap(void);
+extern void openwsn_bootstrap(void);
+extern void gcoap_init(void);
+extern void metrics_coap_init(void);
+extern void senml_coap_init(void);
+extern void auto_init_devfs(void);
+extern void gnrc_ipv6_nib_init(void);
+extern void skald_init(void);
+extern void cord_common_init(void);
+extern void cord_ep_standalone_run(void);
+extern void asymcute_handler_run(void);
+extern void nimble_riot_init(void);
+extern void auto_init_loramac(void);
+extern void sock_dtls_init(void);
+extern void auto_init_usb(void);
+extern void gnrc_netif_init_devs(void);
+extern void auto_init_gnrc_uhcpc(void);
+extern void ndn_init(void);
+extern void auto_init_sht1x(void);
+extern void saul_init_devs(void);
+extern void auto_init_gnrc_rpl(void);
+extern void auto_init_sdcard_spi(void);
+extern void auto_init_candev(void);
+extern void suit_init_conditions(void);
+extern void auto_init_atca(void);
+extern void test_utils_interactive_sync(void);
+extern void dhcpv6_client_auto_init(void);
+extern void gnrc_dhcpv6_client_6lbr_init(void);
+extern void auto_init_dfplayer(void);
+
+static const auto_init_step_t _steps[] = {
+#if IS_USED(MODULE_AUTO_INIT_RANDOM)
+    { auto_init_random, "random", 0 },
+#endif
+#if IS_USED(MODULE_AUTO_INIT_ZTIMER)
+    { ztimer_init, "ztimer", AUTO_INIT_CLOCK },
+#endif
+#if IS_USED(MODULE_AUTO_INIT_XTIMER) && !IS_USED(MODULE_ZTIMER_XTIMER_COMPAT)
+    { xtimer_init, "xtimer", 0 },
+#endif
+#if IS_USED(MODULE_AUTO_INIT_WALLTIME)
+    { walltime_init, "walltime", 0 },
+#endif
+#if IS_USED(MODULE_LOG_DEFERRED)
+    { log_deferred_init, "log_deferred", 0 },
+#endif
+#if IS_USED(MODULE_TRACE)
+    { trace_init, "trace", 0 },
+#endif
+#if IS_USED(MODULE_METRICS)
+    { metrics_init, "metrics", 0 },
+#endif
+#if IS_USED(MODULE_SCHEDSTATISTICS)
+    { init_schedstatistics, "schedstatistics", 0 },
+#endif
+#if IS_USED(MODULE_DUMMY_THREAD)
+    { dummy_thread_create, "dummy_thread", 0 },
+#endif
+#if IS_USED(MODULE_EVENT_THREAD)
+    { auto_init_event_thread, "event threads", 0 },
+#endif
+#if IS_USED(MODULE_ML_INFER)
+    { ml_infer_init, "ml_infer", 0 },
+#endif
+#if IS_USED(MODULE_PERIPH_I2C_ASYNC)
+    { i2c_async_init, "I2C async thread", 0 },
+#endif
+#if IS_USED(MODULE_MCI)
+    { mci_initialize, "mci", 0 },
+#endif
+#if IS_USED(MODULE_PROFILING)
+    { profiling_init, "profiling", 0 },
+#endif
+#if IS_USED(MODULE_AUTO_INIT_GNRC_PKTBUF)
+    { gnrc_pktbuf_init, "gnrc_pktbuf", 0 },
+#endif
+#if IS_USED(MODULE_AUTO_INIT_GNRC_PKTDUMP)
+    { gnrc_pktdump_init, "gnrc_pktdump", 0 },
+#endif
+#if IS_USED(MODULE_AUTO_INIT_GNRC_SIXLOWPAN)
+    { gnrc_sixlowpan_init, "gnrc_sixlowpan", 0 },
+#endif
+#if IS_USED(MODULE_AUTO_INIT_GNRC_IPV6)
+    { gnrc_ipv6_init, "gnrc_ipv6", 0 },
+#endif
+#if IS_USED(MODULE_AUTO_INIT_GNRC_UDP)
+    { gnrc_udp_init, "gnrc_udp", 0 },
+#endif
+#if IS_USED(MODULE_AUTO_INIT_GNRC_TCP)
+    { gnrc_tcp_init, "gnrc_tcp", 0 },
+#endif
+#if IS_USED(MODULE_AUTO_INIT_LWIP)
+    { lwip_bootstrap, "lwIP", 0 },
+#endif
+#if IS_USED(MODULE_OPENTHREAD)
+    { openthread_bootstrap, "openthread", 0 },
+#endif
+#if IS_USED(MODULE_AUTO_INIT_OPENWSN)
+    { openwsn_bootstrap, "openwsn", 0 },
+#endif
+#if IS_USED(MODULE_GCOAP) && !IS_ACTIVE(CONFIG_GCOAP_NO_AUTO_INIT)
+    { gcoap_init, "gcoap", 0 },
+#endif
+#if IS_USED(MODULE_METRICS_COAP)
+    { metrics_coap_init, "metrics_coap", 0 },
+#endif
+#if IS_USED(MODULE_SENML_COAP)
+    { senml_coap_init, "senml_coap", 0 },
+#endif
+#if IS_USED(MODULE_DEVFS)
+    { auto_init_devfs, "devfs", 0 },
+#endif
+#if IS_USED(MODULE_AUTO_INIT_GNRC_IPV6_NIB)
+    { gnrc_ipv6_nib_init, "gnrc_ipv6_nib", 0 },
+#endif
+#if IS_USED(MODULE_SKALD)
+    { skald_init, "Skald", 0 },
+#endif
+#if IS_USED(MODULE_CORD_COMMON)
+    { cord_common_init, "cord_common", 0 },
+#endif
+#if IS_USED(MODULE_CORD_EP_STANDALONE)
+    { cord_ep_standalone_run, "cord_ep_standalone", 0 },
+#endif
+#if IS_USED(MODULE_ASYMCUTE)
+    { asymcute_handler_run, "Asymcute", 0 },
+#endif
+#if IS_USED(MODULE_NIMBLE)
+    { nimble_riot_init, "NimBLE", 0 },
+#endif
+#if IS_USED(MODULE_AUTO_INIT_LORAMAC)
+    { auto_init_loramac, "loramac", AUTO_INIT_ASYNC },
+#endif
+#if IS_USED(MODULE_SOCK_DTLS)
+    { sock_dtls_init, "sock_dtls", 0 },
+#endif
+    /* initialize USB devices */
+#if IS_USED(MODULE_AUTO_INIT_USBUS)
+    { auto_init_usb, "USB", 0 },
+#endif
     /* initialize network devices */
-    if (IS_USED(MODULE_AUTO_INIT_GNRC_NETIF)) {
-        LOG_DEBUG("Auto init gnrc_netif.\n");
-        extern void gnrc_netif_init_devs(void);
-        gnrc_netif_init_devs();
-    }
+#if IS_USED(MODULE_AUTO_INIT_GNRC_NETIF)
+    { gnrc_netif_init_devs, "gnrc_netif", 0 },
+#endif
+#if IS_USED(MODULE_AUTO_INIT_GNRC_UHCPC)
+    { auto_init_gnrc_uhcpc, "gnrc_uhcpc", 0 },
+#endif
+    /* initialize NDN module after the network devices are initialized */
+#if IS_USED(MODULE_NDN_RIOT)
+    { ndn_init, "NDN", 0 },
+#endif
+    /* initialize sensors and actuators
+     *
+     * The sht1x module needs to be initialized regardless of SAUL being used,
+     * as the shell commands rely on auto-initialization. auto_init_sht1x also
+     * performs SAUL registration, but only if module auto_init_saul is used.
+     */
+#if IS_USED(MODULE_SHT1X)
+    { auto_init_sht1x, "sht1x", AUTO_INIT_ASYNC },
+#endif
+#if IS_USED(MODULE_AUTO_INIT_SAUL)
+    { saul_init_devs, "SAUL", AUTO_INIT_ASYNC },
+#endif
+#if IS_USED(MODULE_AUTO_INIT_GNRC_RPL)
+    { auto_init_gnrc_rpl, "gnrc_rpl", 0 },
+#endif
+    /* initialize storage devices */
+#if IS_USED(MODULE_AUTO_INIT_STORAGE) && IS_USED(MODULE_SDCARD_SPI)
+    { auto_init_sdcard_spi, "sdcard_spi", AUTO_INIT_ASYNC },
+#endif
+#if IS_USED(MODULE_AUTO_INIT_CAN)
+    { auto_init_candev, "CAN", 0 },
+#endif
+#if IS_USED(MODULE_SUIT)
+    { suit_init_conditions, "SUIT conditions", 0 },
+#endif
+#if IS_USED(MODULE_AUTO_INIT_SECURITY) && IS_USED(MODULE_CRYPTOAUTHLIB)
+    { auto_init_atca, "cryptoauthlib", 0 },
+#endif
+    /* the test runner may only start once everything is up */
+#if IS_USED(MODULE_TEST_UTILS_INTERACTIVE_SYNC) && !IS_USED(MODULE_SHELL)
+    { test_utils_interactive_sync, "interactive_sync", AUTO_INIT_BARRIER },
+#endif
+#if IS_USED(MODULE_AUTO_INIT_DHCPV6_CLIENT)
+    { dhcpv6_client_auto_init, "DHCPv6 client", 0 },
+#endif
+#if IS_USED(MODULE_GNRC_DHCPV6_CLIENT_6LBR)
+    { gnrc_dhcpv6_client_6lbr_init, "6LBR DHCPv6 client", 0 },
+#endif
+#if IS_USED(MODULE_AUTO_INIT_MULTIMEDIA) && IS_USED(MODULE_DFPLAYER)
+    { auto_init_dfplayer, "dfplayer", AUTO_INIT_ASYNC },
+#endif
+    /* terminates the table, which is thus never empty */
+    { NULL, NULL, 0 },
+};
 
-    if (IS_USED(MODULE_AUTO_INIT_GNRC_UHCPC)) {
-        LOG_DEBUG("Auto init gnrc_uhcpc.\n");
-        extern void auto_init_gnrc_uhcpc(void);
-        auto_init_gnrc_uhcpc();
-    }
+static const unsigned _steps_numof = ARRAY_SIZE(_steps) - 1;
 
-    /* initialize NDN module after the network devices are initialized */
-    if (IS_USED(MODULE_NDN_RIOT)) {
-        LOG_DEBUG("Auto init NDN.\n");
-        extern void ndn_init(void);
-        ndn_init();
-    }
+#if IS_USED(MODULE_AUTO_INIT_PROFILE)
+static uint32_t _time_us[ARRAY_SIZE(_steps)];
+static bool _clock;
+#endif
 
-    /* initialize sensors and actuators */
-    if (IS_USED(MODULE_SHT1X)) {
-        /* The sht1x module needs to be initialized regardless of SAUL being used,
-         * as the shell commands rely on auto-initialization. auto_init_sht1x also
-         * performs SAUL registration, but only if module auto_init_saul is used.
-         */
-        LOG_DEBUG("Auto init sht1x.\n");
-        extern void auto_init_sht1x(void);
-        auto_init_sht1x();
-    }
+#if IS_USED(MODULE_AUTO_INIT_ASYNC)
+static char _stack[CONFIG_AUTO_INIT_ASYNC_STACKSIZE];
+/* steps before _sync_pos are done or left to the init thread */
+static volatile unsigned _sync_pos;
+/* async steps before _async_pos are done */
+static volatile unsigned _async_pos;
+/* unlocked to signal progress of the respective position */
+static mutex_t _sync_progress = MUTEX_INIT_LOCKED;
+static mutex_t _async_progress = MUTEX_INIT_LOCKED;
+#endif
 
-    if (IS_USED(MODULE_AUTO_INIT_SAUL)) {
-        LOG_DEBUG("Auto init SAUL.\n");
-        extern void saul_init_devs(void);
-        saul_init_devs();
+static void _run(unsigned i)
+{
+    LOG_DEBUG("Auto init %s.\n", _steps[i].name);
+
+#if IS_USED(MODULE_AUTO_INIT_PROFILE)
+    uint32_t start = _clock ? ztimer_now(ZTIMER_USEC) : 0;
+
+    _steps[i].init();
+    if (_clock) {
+        _time_us[i] = ztimer_now(ZTIMER_USEC) - start;
+    }
+    if (_steps[i].flags & AUTO_INIT_CLOCK) {
+        _clock = true;
     }
+#else
+    _steps[i].init();
+#endif
+}
 
-    if (IS_USED(MODULE_AUTO_INIT_GNRC_RPL)) {
-        LOG_DEBUG("Auto init gnrc_rpl.\n");
-        extern void auto_init_gnrc_rpl(void);
-        auto_init_gnrc_rpl();
+#if IS_USED(MODULE_AUTO_INIT_ASYNC)
+static void _wait_async(unsigned pos)
+{
+    while (_async_pos < pos) {
+        mutex_lock(&_async_progress);
     }
+}
 
-    /* initialize storage devices */
-    if (IS_USED(MODULE_AUTO_INIT_STORAGE)) {
-        LOG_DEBUG("Auto init STORAGE.\n");
+static void *_async_thread(void *arg)
+{
+    (void)arg;
 
-        if (IS_USED(MODULE_SDCARD_SPI)) {
-            extern void auto_init_sdcard_spi(void);
-            auto_init_sdcard_spi();
+    for (unsigned i = 0; i < _steps_numof; i++) {
+        if (!(_steps[i].flags & AUTO_INIT_ASYNC)) {
+            continue;
+        }
+        _async_pos = i;
+        mutex_unlock(&_async_progress);
+        while (_sync_pos < i) {
+            mutex_lock(&_sync_progress);
         }
+        _run(i);
     }
+    _async_pos = _steps_numof;
+    mutex_unlock(&_async_progress);
 
-    if (IS_USED(MODULE_AUTO_INIT_CAN)) {
-        LOG_DEBUG("Auto init CAN.\n");
-
-        extern void auto_init_candev(void);
-        auto_init_candev();
+    if (IS_USED(MODULE_AUTO_INIT_PROFILE)) {
+        while (_sync_pos < _steps_numof) {
+            mutex_lock(&_sync_progress);
+        }
+        auto_init_profile_print();
     }
+    return NULL;
+}
+#endif
 
-    if (IS_USED(MODULE_SUIT)) {
-        LOG_DEBUG("Auto init SUIT conditions.\n");
-        extern void suit_init_conditions(void);
-        suit_init_conditions();
-    }
+void auto_init(void)
+{
+#if IS_USED(MODULE_AUTO_INIT_ASYNC)
+    bool started = false;
 
-    if (IS_USED(MODULE_AUTO_INIT_SECURITY)) {
-        if (IS_USED(MODULE_CRYPTOAUTHLIB)) {
-            LOG_DEBUG("Auto init cryptoauthlib.\n");
-            extern void auto_init_atca(void);
-            auto_init_atca();
+    for (unsigned i = 0; i < _steps_numof; i++) {
+        if (_steps[i].flags & AUTO_INIT_BARRIER) {
+            _wait_async(i);
+        }
+        if (!(_steps[i].flags & AUTO_INIT_ASYNC)) {
+            _run(i);
         }
+        else if (!started) {
+            thread_create(_stack, sizeof(_stack),
+                          CONFIG_AUTO_INIT_ASYNC_PRIO, THREAD_CREATE_STACKTEST,
+                          _async_thread, NULL, "auto_init");
+            started = true;
+        }
+        _sync_pos = i + 1;
+        mutex_unlock(&_sync_progress);
     }
-
-    if (IS_USED(MODULE_TEST_UTILS_INTERACTIVE_SYNC) && !IS_USED(MODULE_SHELL)) {
-        extern void test_utils_interactive_sync(void);
-        test_utils_interactive_sync();
+    if (started) {
+        /* the init thread prints the profile once done */
+        return;
     }
-
-    if (IS_USED(MODULE_AUTO_INIT_DHCPV6_CLIENT)) {
-        LOG_DEBUG("Auto init DHCPv6 client.\n");
-        extern void dhcpv6_client_auto_init(void);
-        dhcpv6_client_auto_init();
+#else
+    for (unsigned i = 0; i < _steps_numof; i++) {
+        _run(i);
     }
+#endif
 
-    if (IS_USED(MODULE_GNRC_DHCPV6_CLIENT_6LBR)) {
-        LOG_DEBUG("Auto init 6LoWPAN border router DHCPv6 client\n");
-        extern void gnrc_dhcpv6_client_6lbr_init(void);
-        gnrc_dhcpv6_client_6lbr_init();
+    if (IS_USED(MODULE_AUTO_INIT_PROFILE)) {
+        auto_init_profile_print();
     }
+}
 
-    if (IS_USED(MODULE_AUTO_INIT_MULTIMEDIA)) {
-        LOG_DEBUG("auto_init MULTIMEDIA\n");
-        if (IS_USED(MODULE_DFPLAYER)) {
-            extern void auto_init_dfplayer(void);
-            auto_init_dfplayer();
-        }
-    }
+void auto_init_wait(void)
+{
+#if IS_USED(MODULE_AUTO_INIT_ASYNC)
+    _wait_async(_steps_numof);
+#endif
+}
+
+#if IS_USED(MODULE_AUTO_INIT_PROFILE)
+void auto_init_profile_print(void)
+{
+    uint32_t total = 0;
+
+    puts("auto_init profile:");
+    for (unsigned i = 0; i < _steps_numof; i++) {
+        printf("%20s %8" PRIu32 " us%s\n", _steps[i].name, _time_us[i],
+               (IS_USED(MODULE_AUTO_INIT_ASYNC) &&
+                (_steps[i].flags & AUTO_INIT_ASYNC)) ? " (async)" : "");
+        total += _time_us[i];
+    }
+    printf("%20s %8" PRIu32 " us\n", "total", total);
 }
+#endif
@@ -30,6 +30,10 @@
 #include "usb/usbus/cdc/ecm.h"
 usbus_cdcecm_device_t cdcecm;
 #endif
+#ifdef MODULE_USBUS_CDC_NCM
+#include "usb/usbus/cdc/ncm.h"
+usbus_cdcncm_device_t cdcncm;
+#endif
 #ifdef MODULE_USBUS_CDC_ACM
 #include "usb/usbus/cdc/acm.h"
 #endif
@@ -56,6 +60,10 @@ void auto_init_usb(void)
     usbus_cdcecm_init(&usbus, &cdcecm);
 #endif
 
+#ifdef MODULE_USBUS_CDC_NCM
+    usbus_cdcncm_init(&usbus, &cdcncm);
+#endif
+
     /* Finally initialize USBUS thread */
     usbus_create(_stack, USBUS_STACKSIZE, USBUS_PRIO, USBUS_TNAME, &usbus);
 }
@@ -18,7 +18,10 @@
  * @}
  */
 
+#include <stdbool.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "benchmark.h"
 
@@ -34,3 +37,96 @@ void benchmark_print_time(uint32_t time, unsigned long runs, const char *name)
            "  ---  %9" PRIu32 " calls per sec\n",
            name, time, full, div, per_sec);
 }
+
+/* reads of the time source are measured this many times for the overhead */
+#define OVERHEAD_RUNS   (16U)
+
+uint32_t benchmark_overhead;
+
+void benchmark_clock_init(void)
+{
+#ifdef DWT_CTRL_CYCCNTENA_Msk
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+    /* the minimum is the cost without interrupts or cache misses */
+    uint32_t overhead = UINT32_MAX;
+    for (unsigned i = 0; i < OVERHEAD_RUNS; i++) {
+        uint32_t start = benchmark_now();
+        uint32_t elapsed = benchmark_now() - start;
+        if (elapsed < overhead) {
+            overhead = elapsed;
+        }
+    }
+    benchmark_overhead = overhead;
+}
+
+static int _cmp(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+static uint32_t _percentile(const benchmark_samples_t *set, unsigned p)
+{
+    return set->samples[((set->numof - 1) * p) / 100];
+}
+
+void benchmark_stats(benchmark_samples_t *set, benchmark_stats_t *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+    if (set->numof == 0) {
+        return;
+    }
+
+    uint64_t sum = 0;
+    for (unsigned i = 0; i < set->numof; i++) {
+        sum += set->samples[i];
+    }
+    qsort(set->samples, set->numof, sizeof(set->samples[0]), _cmp);
+
+    stats->numof = set->numof;
+    stats->min = set->samples[0];
+    stats->p50 = _percentile(set, 50);
+    stats->p90 = _percentile(set, 90);
+    stats->p99 = _percentile(set, 99);
+    stats->max = set->samples[set->numof - 1];
+    stats->mean = sum / set->numof;
+}
+
+void benchmark_print_json(const char *name, benchmark_samples_t *set)
+{
+    benchmark_stats_t stats;
+
+    benchmark_stats(set, &stats);
+    if (stats.numof == 0) {
+        printf("{\"name\":\"%s\",\"unit\":\"%s\",\"n\":0}\n",
+               name, BENCHMARK_UNIT);
+        return;
+    }
+
+    printf("{\"name\":\"%s\",\"unit\":\"%s\",\"n\":%u,"
+           "\"min\":%" PRIu32 ",\"p50\":%" PRIu32 ",\"p90\":%" PRIu32 ","
+           "\"p99\":%" PRIu32 ",\"max\":%" PRIu32 ",\"mean\":%" PRIu32 "}\n",
+           name, BENCHMARK_UNIT, stats.numof, stats.min, stats.p50, stats.p90,
+           stats.p99, stats.max, stats.mean);
+}
+
+void benchmark_print_csv(const char *name, benchmark_samples_t *set)
+{
+    static bool header_printed;
+    benchmark_stats_t stats;
+
+    if (!header_printed) {
+        puts("name,unit,n,min,p50,p90,p99,max,mean");
+        header_printed = true;
+    }
+    benchmark_stats(set, &stats);
+    printf("%s,%s,%u,%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32
+           ",%" PRIu32 "\n", name, BENCHMARK_UNIT, stats.numof, stats.min,
+           stats.p50, stats.p90, stats.p99, stats.max, stats.mean);
+}
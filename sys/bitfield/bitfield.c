@@ -18,30 +18,145 @@
  */
 
 #include <stdint.h>
+#include <string.h>
+
+#include "bitarithm.h"
 #include "bitfield.h"
+#include "byteorder.h"
 #include "irq.h"
 
-int bf_get_unset(uint8_t field[], int size)
+/* bit 0 of the bitfield is the MSB, so words are read big endian */
+static uint32_t _word(const uint8_t *bytes)
 {
-    int result = -1;
-    int nbytes = (size + 7) / 8;
-    int i = 0;
+    network_uint32_t w;
 
-    unsigned state = irq_disable();
+    memcpy(&w, bytes, sizeof(w));
+    return byteorder_ntohl(w);
+}
 
-    /* skip full bytes */
-    for (int j = 0; (j < nbytes) && (field[j] == 255); j++) {
-        i += 8;
+/* number of the first set bit of a word read by _word(), w != 0 */
+static unsigned _first(uint32_t w)
+{
+#if ARCH_32_BIT
+    return 31 - bitarithm_msb(w);
+#else
+    /* unsigned may only have 16 bits */
+    if (w >> 16) {
+        return 15 - bitarithm_msb(w >> 16);
     }
+    return 31 - bitarithm_msb(w & 0xffff);
+#endif
+}
+
+/* mask of the bits of the last byte that belong to the bitfield */
+static uint8_t _last_mask(size_t size)
+{
+    return (size % 8) ? (uint8_t)(0xff << (8 - (size % 8))) : 0xff;
+}
+
+static int _find_first(const uint8_t field[], size_t size, uint8_t inv)
+{
+    size_t nbytes = (size + 7) / 8;
+    size_t i = 0;
+    uint32_t w = 0;
 
-    for (; i < size; i++) {
-        if (!bf_isset(field, i)) {
-            bf_set(field, i);
-            result = i;
+    for (; i + 4 <= nbytes; i += 4) {
+        w = _word(&field[i]) ^ (inv ? UINT32_MAX : 0);
+        if (w) {
             break;
         }
     }
+    if (!w) {
+        /* the remaining 0 to 3 bytes */
+        for (size_t j = 0; j < 4; j++) {
+            w = (w << 8) | ((i + j < nbytes) ? (uint8_t)(field[i + j] ^ inv)
+                                             : 0);
+        }
+        if (!w) {
+            return -1;
+        }
+    }
+
+    size_t idx = i * 8 + _first(w);
+
+    return (idx < size) ? (int)idx : -1;
+}
+
+int bf_find_first_set(const uint8_t field[], size_t size)
+{
+    return _find_first(field, size, 0);
+}
+
+int bf_find_first_unset(const uint8_t field[], size_t size)
+{
+    return _find_first(field, size, 0xff);
+}
+
+int bf_get_unset(uint8_t field[], int size)
+{
+    unsigned state = irq_disable();
+    int result = bf_find_first_unset(field, size);
+
+    if (result >= 0) {
+        bf_set(field, result);
+    }
 
     irq_restore(state);
     return(result);
 }
+
+void bf_set_range(uint8_t field[], size_t start, size_t len)
+{
+    for (; len && (start % 8); start++, len--) {
+        bf_set(field, start);
+    }
+    memset(&field[start / 8], 0xff, len / 8);
+    start += len & ~7;
+    for (len %= 8; len; start++, len--) {
+        bf_set(field, start);
+    }
+}
+
+void bf_unset_range(uint8_t field[], size_t start, size_t len)
+{
+    for (; len && (start % 8); start++, len--) {
+        bf_unset(field, start);
+    }
+    memset(&field[start / 8], 0, len / 8);
+    start += len & ~7;
+    for (len %= 8; len; start++, len--) {
+        bf_unset(field, start);
+    }
+}
+
+unsigned bf_popcnt(const uint8_t field[], size_t size)
+{
+    size_t nbytes = size / 8;
+    unsigned count = 0;
+    size_t i = 0;
+
+    for (; i + 4 <= nbytes; i += 4) {
+        count += bitarithm_bits_set_u32(_word(&field[i]));
+    }
+    for (; i < nbytes; i++) {
+        count += bitarithm_bits_set(field[i]);
+    }
+    if (size % 8) {
+        count += bitarithm_bits_set(field[i] & _last_mask(size));
+    }
+    return count;
+}
+
+void bf_and(uint8_t out[], const uint8_t a[], const uint8_t b[], size_t size)
+{
+    for (size_t i = 0; i < (size + 7) / 8; i++) {
+        out[i] = a[i] & b[i];
+    }
+}
+
+void bf_or(uint8_t out[], const uint8_t a[], const uint8_t b[], size_t size)
+{
+    for (size_t i = 0; i < (size + 7) / 8; i++) {
+        out[i] = a[i] | b[i];
+    }
+}
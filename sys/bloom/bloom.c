@@ -13,6 +13,7 @@
  *
  */
 
+#include <assert.h>
 #include <limits.h>
 #include <stdarg.h>
 #include <stdbool.h>
@@ -23,12 +24,71 @@
 
 #define ROUND(size) ((size + CHAR_BIT - 1) / CHAR_BIT)
 
+#define COUNTER_MAX (0x0f)
+
+/* index generator for double hashing */
+typedef struct {
+    size_t idx;
+    size_t step;
+    size_t base;
+} _dh_t;
+
+static void _dh_init(_dh_t *dh, hashfp_t *hash, size_t m, uint8_t flags,
+                     const uint8_t *buf, size_t len)
+{
+    uint32_t h1 = hash[0](buf, len);
+    uint32_t h2 = hash[1](buf, len);
+
+    if (flags & BLOOM_FLAG_BLOCKED) {
+        size_t blocks = m / CONFIG_BLOOM_BLOCK_BITS;
+        dh->base = (h1 % blocks) * CONFIG_BLOOM_BLOCK_BITS;
+        dh->idx = h2 & (CONFIG_BLOOM_BLOCK_BITS - 1);
+        /* an odd step visits every bit of the block before repeating */
+        dh->step = ((h1 / blocks) | 1) & (CONFIG_BLOOM_BLOCK_BITS - 1);
+    }
+    else {
+        dh->base = 0;
+        dh->idx = h1 % m;
+        /* a step of zero would yield the same index k times */
+        dh->step = (h2 % m) ? (h2 % m) : 1;
+    }
+}
+
+static size_t _dh_next(_dh_t *dh, size_t m, uint8_t flags)
+{
+    size_t idx = dh->base + dh->idx;
+
+    if (flags & BLOOM_FLAG_BLOCKED) {
+        dh->idx = (dh->idx + dh->step) & (CONFIG_BLOOM_BLOCK_BITS - 1);
+    }
+    else {
+        /* both are below m, so a subtraction replaces the modulo */
+        dh->idx += dh->step;
+        if (dh->idx >= m) {
+            dh->idx -= m;
+        }
+    }
+    return idx;
+}
+
 void bloom_init(bloom_t *bloom, size_t size, uint8_t *bitfield, hashfp_t *hashes, int hashes_numof)
 {
     bloom->m = size;
     bloom->a = bitfield;
     bloom->hash = hashes;
     bloom->k = hashes_numof;
+    bloom->flags = 0;
+}
+
+void bloom_init_double(bloom_t *bloom, size_t size, uint8_t *bitfield,
+                       hashfp_t *hashes, size_t k, uint8_t flags)
+{
+    assert(!(flags & BLOOM_FLAG_BLOCKED) ||
+           ((size % CONFIG_BLOOM_BLOCK_BITS == 0) &&
+            (k <= CONFIG_BLOOM_BLOCK_BITS)));
+
+    bloom_init(bloom, size, bitfield, hashes, k);
+    bloom->flags = flags | BLOOM_FLAG_DOUBLE_HASHING;
 }
 
 void bloom_del(bloom_t *bloom)
@@ -40,10 +100,20 @@ void bloom_del(bloom_t *bloom)
     bloom->m = 0;
     bloom->hash = NULL;
     bloom->k = 0;
+    bloom->flags = 0;
 }
 
 void bloom_add(bloom_t *bloom, const uint8_t *buf, size_t len)
 {
+    if (bloom->flags & BLOOM_FLAG_DOUBLE_HASHING) {
+        _dh_t dh;
+        _dh_init(&dh, bloom->hash, bloom->m, bloom->flags, buf, len);
+        for (size_t n = 0; n < bloom->k; n++) {
+            bf_set(bloom->a, _dh_next(&dh, bloom->m, bloom->flags));
+        }
+        return;
+    }
+
     for (size_t n = 0; n < bloom->k; n++) {
         uint32_t hash = bloom->hash[n](buf, len);
         bf_set(bloom->a, (hash % bloom->m));
@@ -52,6 +122,17 @@ void bloom_add(bloom_t *bloom, const uint8_t *buf, size_t len)
 
 bool bloom_check(bloom_t *bloom, const uint8_t *buf, size_t len)
 {
+    if (bloom->flags & BLOOM_FLAG_DOUBLE_HASHING) {
+        _dh_t dh;
+        _dh_init(&dh, bloom->hash, bloom->m, bloom->flags, buf, len);
+        for (size_t n = 0; n < bloom->k; n++) {
+            if (!bf_isset(bloom->a, _dh_next(&dh, bloom->m, bloom->flags))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     for (size_t n = 0; n < bloom->k; n++) {
         uint32_t hash = bloom->hash[n](buf, len);
 
@@ -62,3 +143,69 @@ bool bloom_check(bloom_t *bloom, const uint8_t *buf, size_t len)
 
     return true; /* ? */
 }
+
+static unsigned _counter_get(const uint8_t *c, size_t idx)
+{
+    return (c[idx / 2] >> ((idx & 1) * 4)) & COUNTER_MAX;
+}
+
+static void _counter_set(uint8_t *c, size_t idx, unsigned val)
+{
+    unsigned shift = (idx & 1) * 4;
+
+    c[idx / 2] = (c[idx / 2] & ~(COUNTER_MAX << shift)) | (val << shift);
+}
+
+void bloom_counting_init(bloom_counting_t *bloom, size_t size,
+                         uint8_t *counters, hashfp_t *hashes, size_t k)
+{
+    bloom->m = size;
+    bloom->k = k;
+    bloom->c = counters;
+    bloom->hash = hashes;
+}
+
+void bloom_counting_add(bloom_counting_t *bloom, const uint8_t *buf,
+                        size_t len)
+{
+    _dh_t dh;
+
+    _dh_init(&dh, bloom->hash, bloom->m, 0, buf, len);
+    for (size_t n = 0; n < bloom->k; n++) {
+        size_t idx = _dh_next(&dh, bloom->m, 0);
+        unsigned val = _counter_get(bloom->c, idx);
+        if (val < COUNTER_MAX) {
+            _counter_set(bloom->c, idx, val + 1);
+        }
+    }
+}
+
+void bloom_counting_remove(bloom_counting_t *bloom, const uint8_t *buf,
+                           size_t len)
+{
+    _dh_t dh;
+
+    _dh_init(&dh, bloom->hash, bloom->m, 0, buf, len);
+    for (size_t n = 0; n < bloom->k; n++) {
+        size_t idx = _dh_next(&dh, bloom->m, 0);
+        unsigned val = _counter_get(bloom->c, idx);
+        /* saturated counters have lost track */
+        if ((val > 0) && (val < COUNTER_MAX)) {
+            _counter_set(bloom->c, idx, val - 1);
+        }
+    }
+}
+
+bool bloom_counting_check(const bloom_counting_t *bloom, const uint8_t *buf,
+                          size_t len)
+{
+    _dh_t dh;
+
+    _dh_init(&dh, bloom->hash, bloom->m, 0, buf, len);
+    for (size_t n = 0; n < bloom->k; n++) {
+        if (!_counter_get(bloom->c, _dh_next(&dh, bloom->m, 0))) {
+            return false;
+        }
+    }
+    return true;
+}
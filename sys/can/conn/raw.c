@@ -131,6 +131,10 @@ int conn_can_raw_send(conn_can_raw_t *conn, const struct can_frame *frame, int f
     DEBUG("conn_can_raw_send: conn=%p, frame=%p, flags=%d\n",
           (void *)conn, (void *)frame, flags);
 
+    if (can_frame_is_fd(frame) && !(conn->flags & CONN_CAN_FD_FRAMES)) {
+        return -EINVAL;
+    }
+
     if (flags & CONN_CAN_DONTWAIT) {
         handle = ret = raw_can_send(conn->ifnum, frame, 0);
         if (ret >= 0) {
@@ -198,6 +202,23 @@ static void _rx_timeout(void *arg)
     mbox_try_put(&conn->mbox, &msg);
 }
 
+/* CAN FD frames don't fit into the frame buffer of a classic conn */
+static bool _drop_fd_frame(conn_can_raw_t *conn, msg_t *msg)
+{
+    if ((msg->type != CAN_MSG_RX_INDICATION) || (conn->flags & CONN_CAN_FD_FRAMES)) {
+        return false;
+    }
+
+    can_rx_data_t *rx = msg->content.ptr;
+    if (!can_frame_is_fd(rx->data.iov_base)) {
+        return false;
+    }
+
+    DEBUG("conn_can_raw_recv: dropping CAN FD frame\n");
+    raw_can_free_frame(rx);
+    return true;
+}
+
 int conn_can_raw_recv(conn_can_raw_t *conn, struct can_frame *frame, uint32_t timeout)
 {
     assert(conn != NULL);
@@ -216,7 +237,9 @@ int conn_can_raw_recv(conn_can_raw_t *conn, struct can_frame *frame, uint32_t ti
     msg_t msg;
     can_rx_data_t *rx;
 
-    mbox_get(&conn->mbox, &msg);
+    do {
+        mbox_get(&conn->mbox, &msg);
+    } while (_drop_fd_frame(conn, &msg));
     if (timeout != 0) {
         xtimer_remove(&timer);
     }
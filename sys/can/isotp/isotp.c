@@ -66,6 +66,14 @@ enum {
 
 #define MAX_MSG_LENGTH 4095
 
+#ifdef MODULE_CAN_FD
+typedef struct canfd_frame isotp_frame_t;
+#define FRAME_LEN(frame)    ((frame)->len)
+#else
+typedef struct can_frame isotp_frame_t;
+#define FRAME_LEN(frame)    ((frame)->can_dlc)
+#endif
+
 /* N_PCI type values in bits 7-4 of N_PCI bytes */
 #define N_PCI_SF 0x00 /* single frame */
 #define N_PCI_FF 0x10 /* first frame */
@@ -74,7 +82,9 @@ enum {
 
 #define N_PCI_SZ 1  /* size of the PCI byte #1 */
 #define SF_PCI_SZ 1 /* size of SingleFrame PCI including 4 bit SF_DL */
+#define SF_PCI_SZ_FD 2 /* size of SingleFrame PCI with 8 bit SF_DL (CAN FD) */
 #define FF_PCI_SZ 2 /* size of FirstFrame PCI including 12 bit FF_DL */
+#define FF_PCI_SZ_ESC 6 /* size of FirstFrame PCI with 32 bit FF_DL escape */
 #define FC_CONTENT_SZ 3 /* flow control content size in byte (FS/BS/STmin) */
 
 /* Flow Status given in FC frame */
@@ -90,7 +100,29 @@ static mutex_t lock = MUTEX_INIT;
 
 static void _rx_timeout(void *arg);
 static int _isotp_send_fc(struct isotp *isotp, int ae, uint8_t status);
-static int _isotp_tx_send(struct isotp *isotp, struct can_frame *frame);
+static int _isotp_tx_send(struct isotp *isotp, isotp_frame_t *frame);
+
+/* data length of transmitted frames */
+static inline uint8_t _tx_dl(const struct isotp *isotp)
+{
+#ifdef MODULE_CAN_FD
+    if (isotp->opt.tx_dl > CAN_MAX_DLEN) {
+        return can_fd_valid_len(MIN(isotp->opt.tx_dl, CANFD_MAX_DLEN));
+    }
+#else
+    (void)isotp;
+#endif
+    return CAN_MAX_DLEN;
+}
+
+static void _init_frame(const struct isotp *isotp, isotp_frame_t *frame)
+{
+    frame->can_id = isotp->opt.tx_id;
+#ifdef MODULE_CAN_FD
+    frame->flags = (_tx_dl(isotp) > CAN_MAX_DLEN)
+                 ? (CANFD_FDF | isotp->opt.tx_flags) : 0;
+#endif
+}
 
 static int _send_msg(msg_t *msg, can_reg_entry_t *entry)
 {
@@ -189,7 +221,7 @@ static void _tx_timeout(void *arg)
     msg_send(&msg, isotp_pid);
 }
 
-static int _isotp_rcv_fc(struct isotp *isotp, struct can_frame *frame, int ae)
+static int _isotp_rcv_fc(struct isotp *isotp, isotp_frame_t *frame, int ae)
 {
     if (isotp->tx.state != ISOTP_WAIT_FC) {
         return 0;
@@ -197,7 +229,7 @@ static int _isotp_rcv_fc(struct isotp *isotp, struct can_frame *frame, int ae)
 
     xtimer_remove(&isotp->tx_timer);
 
-    if (frame->can_dlc < ae + FC_CONTENT_SZ) {
+    if (FRAME_LEN(frame) < ae + FC_CONTENT_SZ) {
         /* Invalid length */
         isotp->tx.state = ISOTP_IDLE;
         return 1;
@@ -254,13 +286,19 @@ static int _isotp_rcv_fc(struct isotp *isotp, struct can_frame *frame, int ae)
     return 0;
 }
 
-static int _isotp_rcv_sf(struct isotp *isotp, struct can_frame *frame, int ae)
+static int _isotp_rcv_sf(struct isotp *isotp, isotp_frame_t *frame, int ae)
 {
     xtimer_remove(&isotp->rx_timer);
     isotp->rx.state = ISOTP_IDLE;
 
     int len = (frame->data[ae] & 0x0F);
-    if (len > frame->can_dlc - (SF_PCI_SZ + ae)) {
+    int pci_len = SF_PCI_SZ;
+    if ((len == 0) && (FRAME_LEN(frame) > CAN_MAX_DLEN)) {
+        /* CAN FD single frame with SF_DL in the second byte */
+        len = frame->data[ae + 1];
+        pci_len = SF_PCI_SZ_FD;
+    }
+    if (len > FRAME_LEN(frame) - (pci_len + ae)) {
         return 1;
     }
 
@@ -271,19 +309,28 @@ static int _isotp_rcv_sf(struct isotp *isotp, struct can_frame *frame, int ae)
     isotp->rx.snip = snip;
 
     isotp->rx.idx = 0;
-    for (size_t i = SF_PCI_SZ + ae; i < isotp->rx.snip->size + ae + SF_PCI_SZ; i++) {
+    for (size_t i = pci_len + ae; i < isotp->rx.snip->size + ae + pci_len; i++) {
         ((uint8_t *)isotp->rx.snip->data)[isotp->rx.idx++] = frame->data[i];
     }
 
     return _isotp_dispatch_rx(isotp);
 }
 
-static int _isotp_rcv_ff(struct isotp *isotp, struct can_frame *frame, int ae)
+static int _isotp_rcv_ff(struct isotp *isotp, isotp_frame_t *frame, int ae)
 {
     isotp->rx.state = ISOTP_IDLE;
 
-    int len = (frame->data[ae] & 0x0F) << 8;
+    uint32_t len = (frame->data[ae] & 0x0F) << 8;
     len += frame->data[ae + 1];
+    int pci_len = FF_PCI_SZ;
+    if ((len == 0) && (FRAME_LEN(frame) >= ae + FF_PCI_SZ_ESC)) {
+        /* FF_DL escape sequence, the length follows in 32 bits */
+        len = ((uint32_t)frame->data[ae + 2] << 24) |
+              ((uint32_t)frame->data[ae + 3] << 16) |
+              ((uint32_t)frame->data[ae + 4] << 8) |
+              frame->data[ae + 5];
+        pci_len = FF_PCI_SZ_ESC;
+    }
 
     if (isotp->rx.snip) {
         DEBUG("_isotp_rcv_ff: freeing previous rx buf\n");
@@ -307,7 +354,7 @@ static int _isotp_rcv_ff(struct isotp *isotp, struct can_frame *frame, int ae)
     isotp->rx.snip = snip;
 
     isotp->rx.idx = 0;
-    for (int i = ae + FF_PCI_SZ; i < frame->can_dlc; i++) {
+    for (int i = ae + pci_len; (i < FRAME_LEN(frame)) && (isotp->rx.idx < len); i++) {
         ((uint8_t *)isotp->rx.snip->data)[isotp->rx.idx++] = frame->data[i];
     }
 
@@ -332,7 +379,7 @@ static int _isotp_rcv_ff(struct isotp *isotp, struct can_frame *frame, int ae)
     return 0;
 }
 
-static int _isotp_rcv_cf(struct isotp *isotp, struct can_frame *frame, int ae)
+static int _isotp_rcv_cf(struct isotp *isotp, isotp_frame_t *frame, int ae)
 {
     DEBUG("_isotp_rcv_cf: state=%d\n", isotp->rx.state);
 
@@ -352,7 +399,7 @@ static int _isotp_rcv_cf(struct isotp *isotp, struct can_frame *frame, int ae)
     isotp->rx.sn++;
     isotp->rx.sn %= 16;
 
-    for (int i = ae + N_PCI_SZ; i < frame->can_dlc; i++) {
+    for (int i = ae + N_PCI_SZ; i < FRAME_LEN(frame); i++) {
         ((uint8_t *)isotp->rx.snip->data)[isotp->rx.idx++] = frame->data[i];
         if (isotp->rx.idx >= isotp->rx.snip->size) {
             break;
@@ -386,14 +433,14 @@ static int _isotp_rcv_cf(struct isotp *isotp, struct can_frame *frame, int ae)
     return _isotp_send_fc(isotp, ae, ISOTP_FC_CTS);
 }
 
-static int _isotp_rcv(struct isotp *isotp, struct can_frame *frame)
+static int _isotp_rcv(struct isotp *isotp, isotp_frame_t *frame)
 {
     int ae = (isotp->opt.flags & CAN_ISOTP_EXTEND_ADDR) ? 1 : 0;
     uint8_t n_pci_type;
 
 #if ENABLE_DEBUG
     DEBUG("_isotp_rcv: id=%" PRIx32 " data=", frame->can_id);
-    for (int i = 0; i < frame->can_dlc; i++) {
+    for (int i = 0; i < FRAME_LEN(frame); i++) {
       DEBUG("%02hhx", frame->data[i]);
     }
     DEBUG("\n");
@@ -425,16 +472,16 @@ static int _isotp_rcv(struct isotp *isotp, struct can_frame *frame)
 
 static int _isotp_send_fc(struct isotp *isotp, int ae, uint8_t status)
 {
-    struct can_frame fc;
+    isotp_frame_t fc;
 
-    fc.can_id = isotp->opt.tx_id;
+    _init_frame(isotp, &fc);
 
     if (isotp->opt.flags & CAN_ISOTP_TX_PADDING) {
         memset(fc.data, isotp->opt.txpad_content, CAN_MAX_DLEN);
-        fc.can_dlc = CAN_MAX_DLEN;
+        FRAME_LEN(&fc) = CAN_MAX_DLEN;
     }
     else {
-        fc.can_dlc = ae + FC_CONTENT_SZ;
+        FRAME_LEN(&fc) = ae + FC_CONTENT_SZ;
     }
 
     fc.data[ae] = N_PCI_FC | status;
@@ -449,14 +496,15 @@ static int _isotp_send_fc(struct isotp *isotp, int ae, uint8_t status)
 
 #if ENABLE_DEBUG
     DEBUG("_isotp_send_fc: id=%" PRIx32 " data=", fc.can_id);
-    for (int i = 0; i < fc.can_dlc; i++) {
+    for (int i = 0; i < FRAME_LEN(&fc); i++) {
       DEBUG("%02hhx", fc.data[i]);
     }
     DEBUG("\n");
 #endif
 
     xtimer_set(&isotp->rx_timer, CAN_ISOTP_TIMEOUT_N_Ar);
-    isotp->rx.tx_handle = raw_can_send(isotp->entry.ifnum, &fc, isotp_pid);
+    isotp->rx.tx_handle = raw_can_send(isotp->entry.ifnum, (struct can_frame *)&fc,
+                                       isotp_pid);
 
     if (isotp->rx.tx_handle >= 0) {
         return 0;
@@ -468,11 +516,12 @@ static int _isotp_send_fc(struct isotp *isotp, int ae, uint8_t status)
     }
 }
 
-static void _isotp_create_ff(struct isotp *isotp, struct can_frame *frame, int ae)
+static void _isotp_create_ff(struct isotp *isotp, isotp_frame_t *frame, int ae)
 {
+    uint8_t dl = _tx_dl(isotp);
 
-    frame->can_id = isotp->opt.tx_id;
-    frame->can_dlc = CAN_MAX_DLEN;
+    _init_frame(isotp, frame);
+    FRAME_LEN(frame) = dl;
 
     if (ae) {
         frame->data[0] = isotp->opt.ext_address;
@@ -481,30 +530,31 @@ static void _isotp_create_ff(struct isotp *isotp, struct can_frame *frame, int a
     frame->data[ae] = (uint8_t)(isotp->tx.snip->size >> 8) | N_PCI_FF;
     frame->data[ae + 1] = (uint8_t) isotp->tx.snip->size & 0xFFU;
 
-    for (int i = ae + FF_PCI_SZ; i < CAN_MAX_DLEN; i++) {
+    for (int i = ae + FF_PCI_SZ; i < dl; i++) {
         frame->data[i] = ((uint8_t *)isotp->tx.snip->data)[isotp->tx.idx++];
     }
 
     isotp->tx.sn = 1;
 }
 
-static void _isotp_fill_dataframe(struct isotp *isotp, struct can_frame *frame, int ae)
+static void _isotp_fill_dataframe(struct isotp *isotp, isotp_frame_t *frame, int ae,
+                                  size_t pci_len)
 {
-    size_t pci_len = N_PCI_SZ + ae;
-    size_t space = CAN_MAX_DLEN - pci_len;
+    size_t space = _tx_dl(isotp) - pci_len;
     size_t num_bytes = MIN(space, isotp->tx.snip->size - isotp->tx.idx);
+    /* CAN FD frames only come in some lengths, they are always padded */
+    uint8_t len = can_fd_valid_len(num_bytes + pci_len);
 
-    frame->can_id = isotp->opt.tx_id;
-    frame->can_dlc = num_bytes + pci_len;
+    _init_frame(isotp, frame);
 
     DEBUG("_isotp_fill_dataframe: num_bytes=%d, pci_len=%d\n", (unsigned)num_bytes, (unsigned)pci_len);
 
-    if (num_bytes < space) {
-        if (isotp->opt.flags & CAN_ISOTP_TX_PADDING) {
-            frame->can_dlc = CAN_MAX_DLEN;
-            memset(frame->data, isotp->opt.txpad_content, frame->can_dlc);
-        }
+    if ((isotp->opt.flags & CAN_ISOTP_TX_PADDING) && (len < CAN_MAX_DLEN)) {
+        len = CAN_MAX_DLEN;
     }
+    memset(&frame->data[pci_len + num_bytes], isotp->opt.txpad_content,
+           len - (pci_len + num_bytes));
+    FRAME_LEN(frame) = len;
 
     for (size_t i = 0; i < num_bytes; i++) {
         frame->data[pci_len + i] = ((uint8_t *)isotp->tx.snip->data)[isotp->tx.idx++];
@@ -519,7 +569,7 @@ static void _isotp_fill_dataframe(struct isotp *isotp, struct can_frame *frame,
 static void _isotp_tx_timeout_task(struct isotp *isotp)
 {
     int ae = (isotp->opt.flags & CAN_ISOTP_EXTEND_ADDR) ? 1 : 0;
-    struct can_frame frame;
+    isotp_frame_t frame;
 
     DEBUG("_isotp_tx_timeout_task: state=%d\n", isotp->tx.state);
 
@@ -532,7 +582,7 @@ static void _isotp_tx_timeout_task(struct isotp *isotp)
 
     case ISOTP_SENDING_NEXT_CF:
         DEBUG("_isotp_tx_timeout_task: sending next CF\n");
-        _isotp_fill_dataframe(isotp, &frame, ae);
+        _isotp_fill_dataframe(isotp, &frame, ae, N_PCI_SZ + ae);
         frame.data[ae] = N_PCI_CF | isotp->tx.sn++;
         isotp->tx.sn %= 16;
         isotp->tx.bs++;
@@ -623,10 +673,11 @@ static void _isotp_rx_tx_conf(struct isotp *isotp)
     }
 }
 
-static int _isotp_tx_send(struct isotp *isotp, struct can_frame *frame)
+static int _isotp_tx_send(struct isotp *isotp, isotp_frame_t *frame)
 {
     xtimer_set(&isotp->tx_timer, CAN_ISOTP_TIMEOUT_N_As);
-    isotp->tx.tx_handle = raw_can_send(isotp->entry.ifnum, frame, isotp_pid);
+    isotp->tx.tx_handle = raw_can_send(isotp->entry.ifnum, (struct can_frame *)frame,
+                                       isotp_pid);
     DEBUG("isotp_send: FF/SF/CF sent handle=%d\n", isotp->tx.tx_handle);
     if (isotp->tx.tx_handle < 0) {
         xtimer_remove(&isotp->tx_timer);
@@ -639,18 +690,27 @@ static int _isotp_tx_send(struct isotp *isotp, struct can_frame *frame)
 
 static int _isotp_send_sf_ff(struct isotp *isotp)
 {
-    struct can_frame frame;
+    isotp_frame_t frame;
     unsigned ae = (isotp->opt.flags & CAN_ISOTP_EXTEND_ADDR) ? 1 : 0;
 
     if (isotp->tx.snip->size <= CAN_MAX_DLEN - SF_PCI_SZ - ae) {
         /* Fits into a single frame */
-        _isotp_fill_dataframe(isotp, &frame, ae);
+        _isotp_fill_dataframe(isotp, &frame, ae, SF_PCI_SZ + ae);
 
         frame.data[ae] = N_PCI_SF;
         frame.data[ae] |= isotp->tx.snip->size;
 
         isotp->tx.state = ISOTP_SENDING_SF;
     }
+    else if (isotp->tx.snip->size <= _tx_dl(isotp) - SF_PCI_SZ_FD - ae) {
+        /* Fits into a CAN FD single frame with SF_DL in the second byte */
+        _isotp_fill_dataframe(isotp, &frame, ae, SF_PCI_SZ_FD + ae);
+
+        frame.data[ae] = N_PCI_SF;
+        frame.data[ae + 1] = isotp->tx.snip->size;
+
+        isotp->tx.state = ISOTP_SENDING_SF;
+    }
     else {
         isotp->tx.state = ISOTP_SENDING_FF;
         /* Must send a First frame */
@@ -20,6 +20,7 @@
 #include <string.h>
 #include <limits.h>
 #include <errno.h>
+#include <stddef.h>
 
 #include "memarray.h"
 #include "can/pkt.h"
@@ -40,12 +41,44 @@ static mutex_t _mutex = MUTEX_INIT;
 static can_pkt_t _pkt_buf[CAN_PKT_BUF_SIZE];
 static memarray_t _pkt_array;
 
+#ifdef MODULE_CAN_FD
+#ifndef CAN_PKT_FD_BUF_SIZE
+#define CAN_PKT_FD_BUF_SIZE 16
+#endif
+
+static can_pkt_fd_t _pkt_fd_buf[CAN_PKT_FD_BUF_SIZE];
+static memarray_t _pkt_fd_array;
+
+static inline bool _is_fd_pkt(const can_pkt_t *pkt)
+{
+    return ((const void *)pkt >= (const void *)_pkt_fd_buf) &&
+           ((const void *)pkt < (const void *)&_pkt_fd_buf[CAN_PKT_FD_BUF_SIZE]);
+}
+#endif
+
+static inline memarray_t *_pool(bool fd)
+{
+#ifdef MODULE_CAN_FD
+    if (fd) {
+        return &_pkt_fd_array;
+    }
+#else
+    (void)fd;
+#endif
+    return &_pkt_array;
+}
+
 void can_pkt_init(void)
 {
     static_assert(sizeof(can_pkt_t) >= sizeof(can_rx_data_t), "sizeof(can_rx_data_t) must be at most sizeof(can_pkt_t)");
     mutex_lock(&_mutex);
     handle = 1;
     memarray_init(&_pkt_array, _pkt_buf, sizeof(can_pkt_t), CAN_PKT_BUF_SIZE);
+#ifdef MODULE_CAN_FD
+    static_assert(offsetof(can_pkt_t, frame) == offsetof(can_pkt_fd_t, frame),
+                  "frames of can_pkt_t and can_pkt_fd_t must be at the same offset");
+    memarray_init(&_pkt_fd_array, _pkt_fd_buf, sizeof(can_pkt_fd_t), CAN_PKT_FD_BUF_SIZE);
+#endif
     mutex_unlock(&_mutex);
 }
 
@@ -54,7 +87,7 @@ static can_pkt_t *_pkt_alloc(int ifnum, const struct can_frame *frame)
     can_pkt_t *pkt;
 
     mutex_lock(&_mutex);
-    pkt = memarray_alloc(&_pkt_array);
+    pkt = memarray_alloc(_pool(can_frame_is_fd(frame)));
     mutex_unlock(&_mutex);
 
     if (!pkt) {
@@ -62,7 +95,7 @@ static can_pkt_t *_pkt_alloc(int ifnum, const struct can_frame *frame)
     }
 
     pkt->entry.ifnum = ifnum;
-    pkt->frame = *frame;
+    memcpy(&pkt->frame, frame, can_frame_size(frame));
 
     DEBUG("can_pkt_alloc: pkt allocated\n");
 
@@ -140,7 +173,11 @@ void can_pkt_free(can_pkt_t *pkt)
     DEBUG("can_pkt_free: free pkt=%p\n", (void*)pkt);
 
     mutex_lock(&_mutex);
+#ifdef MODULE_CAN_FD
+    memarray_free(_pool(_is_fd_pkt(pkt)), pkt);
+#else
     memarray_free(&_pkt_array, pkt);
+#endif
     mutex_unlock(&_mutex);
 }
 
@@ -60,6 +60,17 @@ static can_reg_entry_t *table[CAN_DLL_NUMOF];
 #define CAN_ROUTER_MAX_FILTER   64
 #endif
 
+#ifndef CAN_ROUTER_HASH_BUCKETS
+#define CAN_ROUTER_HASH_BUCKETS 16
+#endif
+
+/**
+ * Filters matching a single CAN ID, hashed by the ID, per interface.
+ * A received frame is only compared to the filters of its buckets instead of
+ * all of them.
+ */
+static can_reg_entry_t *exact_table[CAN_DLL_NUMOF][CAN_ROUTER_HASH_BUCKETS];
+
 static filter_el_t _filter_buf[CAN_ROUTER_MAX_FILTER];
 static memarray_t _filter_array;
 static mutex_t lock = MUTEX_INIT;
@@ -70,16 +81,50 @@ static void _insert_to_list(can_reg_entry_t **list, filter_el_t *el);
 static filter_el_t *_find_filter_el(can_reg_entry_t *list, can_reg_entry_t *entry, canid_t can_id, canid_t mask, void *data);
 static int _filter_is_used(unsigned int ifnum, canid_t can_id, canid_t mask);
 
+/* A filter is exact if it matches a single CAN ID regardless of the RTR and
+ * ERR flags: an extended or a standard ID, or an 11 bit ID of any format */
+static inline bool _is_exact(canid_t can_id, canid_t mask)
+{
+    if ((mask != (CAN_EFF_FLAG | CAN_EFF_MASK)) &&
+        (mask != (CAN_EFF_FLAG | CAN_SFF_MASK)) &&
+        (mask != CAN_SFF_MASK)) {
+        return false;
+    }
+    return !(can_id & ~mask);
+}
+
+static inline can_reg_entry_t **_bucket(unsigned int ifnum, canid_t key)
+{
+    return &exact_table[ifnum][(key ^ (key >> 16)) % CAN_ROUTER_HASH_BUCKETS];
+}
+
+/* The list a filter is stored in */
+static can_reg_entry_t **_list(unsigned int ifnum, canid_t can_id, canid_t mask)
+{
+    if (_is_exact(can_id, mask)) {
+        return _bucket(ifnum, can_id);
+    }
+    return &table[ifnum];
+}
+
 #if ENABLE_DEBUG
+static void _print_list(can_reg_entry_t *list)
+{
+    can_reg_entry_t *entry;
+    LL_FOREACH(list, entry) {
+        filter_el_t *el = container_of(entry, filter_el_t, entry);
+        DEBUG("App pid=%" PRIkernel_pid ", el=%p, can_id=0x%" PRIx32 ", mask=0x%" PRIx32 ", data=%p\n",
+              el->entry.target.pid, (void*)el, el->can_id, el->mask, el->data);
+    }
+}
+
 static void _print_filters(void)
 {
     for (int i = 0; i < (int)CAN_DLL_NUMOF; i++) {
         DEBUG("--- Ifnum: %d ---\n", i);
-        can_reg_entry_t *entry;
-        LL_FOREACH(table[i], entry) {
-            filter_el_t *el = container_of(entry, filter_el_t, entry);
-            DEBUG("App pid=%" PRIkernel_pid ", el=%p, can_id=0x%" PRIx32 ", mask=0x%" PRIx32 ", data=%p\n",
-                  el->entry.target.pid, (void*)el, el->can_id, el->mask, el->data);
+        _print_list(table[i]);
+        for (int j = 0; j < CAN_ROUTER_HASH_BUCKETS; j++) {
+            _print_list(exact_table[i][j]);
         }
     }
 }
@@ -188,7 +233,7 @@ static filter_el_t *_find_filter_el(can_reg_entry_t *list, can_reg_entry_t *entr
 
 static int _filter_is_used(unsigned int ifnum, canid_t can_id, canid_t mask)
 {
-    filter_el_t *el = container_of(table[ifnum], filter_el_t, entry);
+    filter_el_t *el = container_of(*_list(ifnum, can_id, mask), filter_el_t, entry);
     if (!el) {
         DEBUG("_filter_is_used: empty list\n");
         return 0;
@@ -247,7 +292,7 @@ int can_router_register(can_reg_entry_t *entry, canid_t can_id, canid_t mask, vo
     filter->entry.target.pid = entry->target.pid;
 #endif
     filter->entry.ifnum = entry->ifnum;
-    _insert_to_list(&table[entry->ifnum], filter);
+    _insert_to_list(_list(entry->ifnum, can_id, mask), filter);
     mutex_unlock(&lock);
 
     PRINT_FILTERS();
@@ -273,12 +318,13 @@ int can_router_unregister(can_reg_entry_t *entry, canid_t can_id,
 #endif
 
     mutex_lock(&lock);
-    el = _find_filter_el(table[entry->ifnum], entry, can_id, mask, param);
+    can_reg_entry_t **list = _list(entry->ifnum, can_id, mask);
+    el = _find_filter_el(*list, entry, can_id, mask, param);
     if (!el) {
         mutex_unlock(&lock);
         return -EINVAL;
     }
-    LL_DELETE(table[entry->ifnum], &el->entry);
+    LL_DELETE(*list, &el->entry);
     _free_filter_el(el);
     ret = _filter_is_used(entry->ifnum, can_id, mask);
     mutex_unlock(&lock);
@@ -323,26 +369,48 @@ int can_router_dispatch_rx_indic(can_pkt_t *pkt)
           (void *)pkt, pkt->entry.ifnum, pkt->frame.can_id);
 
     mutex_lock(&lock);
-    can_reg_entry_t *entry = NULL;
-    filter_el_t *el;
-    LL_FOREACH(table[pkt->entry.ifnum], entry) {
-        el = container_of(entry, filter_el_t, entry);
-        if ((pkt->frame.can_id & el->mask) == el->can_id) {
-            DEBUG("can_router_dispatch_rx_indic: found el=%p, data=%p\n",
-                  (void *)el, (void *)el->data);
-            DEBUG("can_router_dispatch_rx_indic: rx_ind to pid: %"
-                  PRIkernel_pid "\n", entry->target.pid);
-            atomic_fetch_add(&pkt->ref_count, 1);
-            msg.content.ptr = can_pkt_alloc_rx_data(&pkt->frame, sizeof(pkt->frame), el->data);
+    canid_t can_id = pkt->frame.can_id;
+    /* IDs of exact filters that match the frame */
+    canid_t keys[] = {
+        can_id & ((can_id & CAN_EFF_FLAG) ? (CAN_EFF_FLAG | CAN_EFF_MASK)
+                                          : CAN_SFF_MASK),
+        can_id & CAN_SFF_MASK,
+    };
+    /* exact filters of the frame's buckets first, then all masked filters */
+    can_reg_entry_t *lists[] = {
+        *_bucket(pkt->entry.ifnum, keys[0]),
+        (can_id & CAN_EFF_FLAG) ? *_bucket(pkt->entry.ifnum, keys[1]) : NULL,
+        table[pkt->entry.ifnum],
+    };
+    if (lists[1] == lists[0]) {
+        lists[1] = NULL;
+    }
+    for (unsigned i = 0; (i < ARRAY_SIZE(lists)) && (res == 0); i++) {
+        can_reg_entry_t *entry = NULL;
+        filter_el_t *el;
+        LL_FOREACH(lists[i], entry) {
+            el = container_of(entry, filter_el_t, entry);
+            if ((pkt->frame.can_id & el->mask) == el->can_id) {
+                DEBUG("can_router_dispatch_rx_indic: found el=%p, data=%p\n",
+                      (void *)el, (void *)el->data);
+                DEBUG("can_router_dispatch_rx_indic: rx_ind to pid: %"
+                      PRIkernel_pid "\n", entry->target.pid);
+                atomic_fetch_add(&pkt->ref_count, 1);
+                msg.content.ptr = can_pkt_alloc_rx_data(&pkt->frame, can_frame_size(&pkt->frame), el->data);
 #if ENABLE_DEBUG
-            msg_cnt++;
+                msg_cnt++;
 #endif
-            if (!msg.content.ptr || (_send_msg(&msg, entry) <= 0)) {
-                can_pkt_free_rx_data(msg.content.ptr);
-                atomic_fetch_sub(&pkt->ref_count, 1);
-                DEBUG("can_router_dispatch_rx_indic: failed to send msg to "
-                      "pid=%" PRIkernel_pid "\n", entry->target.pid);
-                res = -EBUSY;
+                if (!msg.content.ptr || (_send_msg(&msg, entry) <= 0)) {
+                    can_pkt_free_rx_data(msg.content.ptr);
+                    atomic_fetch_sub(&pkt->ref_count, 1);
+                    DEBUG("can_router_dispatch_rx_indic: failed to send msg to "
+                          "pid=%" PRIkernel_pid "\n", entry->target.pid);
+                    res = -EBUSY;
+                    break;
+                }
+            }
+            else if ((i < ARRAY_SIZE(keys)) && (el->can_id > keys[i])) {
+                /* buckets are sorted by CAN ID */
                 break;
             }
         }
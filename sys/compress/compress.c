@@ -0,0 +1,253 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_compress
+ * @{
+ *
+ * @file
+ * @brief       Streaming compression implementation
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "compress.h"
+#include "ztimer.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+static int _flush(compress_sink_t sink, void *arg, compress_stats_t *stats,
+                  uint8_t *buf, uint16_t *len)
+{
+    if (*len == 0) {
+        return 0;
+    }
+
+    int res = sink(arg, buf, *len);
+    if (res < 0) {
+        return res;
+    }
+    stats->out += *len;
+    *len = 0;
+    return 0;
+}
+
+/* moves all output of the encoder to the sink, full chunks only unless
+ * final is set */
+static int _encoder_drain(compress_t *ctx, bool final)
+{
+    HSE_poll_res res;
+
+    do {
+        size_t n;
+
+        if (ctx->len == sizeof(ctx->buf)) {
+            int err = _flush(ctx->sink, ctx->arg, &ctx->stats, ctx->buf,
+                             &ctx->len);
+            if (err < 0) {
+                return err;
+            }
+        }
+
+        uint32_t start = ztimer_now(ZTIMER_USEC);
+        res = heatshrink_encoder_poll(&ctx->enc, ctx->buf + ctx->len,
+                                      sizeof(ctx->buf) - ctx->len, &n);
+        ctx->stats.time_us += ztimer_now(ZTIMER_USEC) - start;
+        if (res < 0) {
+            DEBUG("compress: encoder error %d\n", res);
+            return -EIO;
+        }
+        ctx->len += n;
+    } while (res == HSER_POLL_MORE);
+
+    return final ? _flush(ctx->sink, ctx->arg, &ctx->stats, ctx->buf,
+                          &ctx->len)
+                 : 0;
+}
+
+void compress_init(compress_t *ctx, compress_sink_t sink, void *arg)
+{
+    heatshrink_encoder_reset(&ctx->enc);
+    ctx->sink = sink;
+    ctx->arg = arg;
+    memset(&ctx->stats, 0, sizeof(ctx->stats));
+    ctx->len = 0;
+}
+
+int compress_write(compress_t *ctx, const void *data, size_t len)
+{
+    /* heatshrink does not modify the input, but takes no const pointer */
+    uint8_t *in = (uint8_t *)data;
+
+    while (len) {
+        size_t n;
+
+        uint32_t start = ztimer_now(ZTIMER_USEC);
+        HSE_sink_res res = heatshrink_encoder_sink(&ctx->enc, in, len, &n);
+        ctx->stats.time_us += ztimer_now(ZTIMER_USEC) - start;
+        if (res < 0) {
+            return -EIO;
+        }
+        in += n;
+        len -= n;
+        ctx->stats.in += n;
+
+        int err = _encoder_drain(ctx, false);
+        if (err < 0) {
+            return err;
+        }
+    }
+    return 0;
+}
+
+int compress_finish(compress_t *ctx)
+{
+    HSE_finish_res res;
+
+    do {
+        uint32_t start = ztimer_now(ZTIMER_USEC);
+        res = heatshrink_encoder_finish(&ctx->enc);
+        ctx->stats.time_us += ztimer_now(ZTIMER_USEC) - start;
+        if (res < 0) {
+            return -EIO;
+        }
+
+        int err = _encoder_drain(ctx, res == HSER_FINISH_DONE);
+        if (err < 0) {
+            return err;
+        }
+    } while (res == HSER_FINISH_MORE);
+
+    return 0;
+}
+
+typedef struct {
+    uint8_t *buf;
+    size_t size;
+    size_t len;
+} _out_buf_t;
+
+static int _to_buf(void *arg, const void *data, size_t len)
+{
+    _out_buf_t *out = arg;
+
+    if (len > out->size - out->len) {
+        return -ENOBUFS;
+    }
+    memcpy(out->buf + out->len, data, len);
+    out->len += len;
+    return 0;
+}
+
+ssize_t compress_buf(const void *in, size_t len, void *out, size_t size,
+                     compress_stats_t *stats)
+{
+    compress_t ctx;
+    _out_buf_t buf = { .buf = out, .size = size };
+    int res;
+
+    compress_init(&ctx, _to_buf, &buf);
+    if ((res = compress_write(&ctx, in, len)) == 0) {
+        res = compress_finish(&ctx);
+    }
+    if (stats) {
+        *stats = ctx.stats;
+    }
+    return (res < 0) ? res : (ssize_t)buf.len;
+}
+
+/* moves all output of the decoder to the sink, full chunks only */
+static int _decoder_drain(decompress_t *ctx)
+{
+    HSD_poll_res res;
+
+    do {
+        size_t n;
+
+        if (ctx->len == sizeof(ctx->buf)) {
+            int err = _flush(ctx->sink, ctx->arg, &ctx->stats, ctx->buf,
+                             &ctx->len);
+            if (err < 0) {
+                return err;
+            }
+        }
+
+        uint32_t start = ztimer_now(ZTIMER_USEC);
+        res = heatshrink_decoder_poll(&ctx->dec, ctx->buf + ctx->len,
+                                      sizeof(ctx->buf) - ctx->len, &n);
+        ctx->stats.time_us += ztimer_now(ZTIMER_USEC) - start;
+        if (res < 0) {
+            DEBUG("compress: decoder error %d\n", res);
+            return -EIO;
+        }
+        ctx->len += n;
+    } while (res == HSDR_POLL_MORE);
+
+    return 0;
+}
+
+void decompress_init(decompress_t *ctx, compress_sink_t sink, void *arg)
+{
+    heatshrink_decoder_reset(&ctx->dec);
+    ctx->sink = sink;
+    ctx->arg = arg;
+    memset(&ctx->stats, 0, sizeof(ctx->stats));
+    ctx->len = 0;
+}
+
+int decompress_write(decompress_t *ctx, const void *data, size_t len)
+{
+    uint8_t *in = (uint8_t *)data;
+
+    while (len) {
+        size_t n;
+
+        uint32_t start = ztimer_now(ZTIMER_USEC);
+        HSD_sink_res res = heatshrink_decoder_sink(&ctx->dec, in, len, &n);
+        ctx->stats.time_us += ztimer_now(ZTIMER_USEC) - start;
+        if (res < 0) {
+            return -EIO;
+        }
+        in += n;
+        len -= n;
+        ctx->stats.in += n;
+
+        int err = _decoder_drain(ctx);
+        if (err < 0) {
+            return err;
+        }
+    }
+    return 0;
+}
+
+int decompress_finish(decompress_t *ctx)
+{
+    int err = _decoder_drain(ctx);
+
+    while ((err == 0) &&
+           (heatshrink_decoder_finish(&ctx->dec) == HSDR_FINISH_MORE)) {
+        uint32_t before = ctx->stats.out + ctx->len;
+
+        err = _decoder_drain(ctx);
+        /* more to do but no progress, the input was cut short */
+        if ((err == 0) && (ctx->stats.out + ctx->len == before)) {
+            err = -EIO;
+        }
+    }
+    if (err < 0) {
+        return err;
+    }
+    return _flush(ctx->sink, ctx->arg, &ctx->stats, ctx->buf, &ctx->len);
+}
@@ -113,4 +113,18 @@ cv_status condition_variable::wait_until(unique_lock<mutex>& lock,
   return cmp < 1 ? cv_status::no_timeout : cv_status::timeout;
 }
 
+#ifdef RIOT_CHRONO_HAS_ZTIMER
+cv_status condition_variable::wait_ticks(unique_lock<mutex>& lock,
+                                         ztimer_clock_t* clock,
+                                         uint32_t ticks) {
+  ztimer_t timer = {};
+  uint32_t before = ztimer_now(clock);
+  ztimer_set_wakeup(clock, &timer, ticks, sched_active_pid);
+  wait(lock);
+  uint32_t passed = ztimer_now(clock) - before;
+  ztimer_remove(clock, &timer);
+  return passed < ticks ? cv_status::no_timeout : cv_status::timeout;
+}
+#endif
+
 } // namespace riot
@@ -12,7 +12,7 @@
  *
  * @file
  * @brief  C++11 chrono drop in replacement that adds the function now based on
- *         xtimer/timex
+ *         xtimer/timex and steady clocks based on ztimer
  * @see    <a href="http://en.cppreference.com/w/cpp/thread/thread">
  *           std::thread, defined in header thread
  *         </a>
@@ -26,11 +26,25 @@
 #define RIOT_CHRONO_HPP
 
 #include <chrono>
+#include <ratio>
+#include <cstdint>
 #include <algorithm>
+#include <type_traits>
 
 #include "time.h"
 #include "xtimer.h"
 
+#if defined(MODULE_ZTIMER_USEC) || defined(MODULE_ZTIMER_MSEC) \
+    || defined(DOXYGEN)
+#include "ztimer.h"
+
+/**
+ * @brief ztimer based clocks are available, with `ztimer_usec` or
+ *        `ztimer_msec`
+ */
+#define RIOT_CHRONO_HAS_ZTIMER  1
+#endif
+
 namespace riot {
 
 namespace {
@@ -140,6 +154,158 @@ inline bool operator>=(const time_point& lhs, const time_point& rhs) {
   return !(lhs < rhs);
 }
 
+#ifdef RIOT_CHRONO_HAS_ZTIMER
+namespace detail {
+
+template <class Period>
+struct ztimer_clock_dev;
+
+#if defined(MODULE_ZTIMER_USEC) || defined(DOXYGEN)
+template <>
+struct ztimer_clock_dev<std::micro> {
+  static ztimer_clock_t* get() noexcept { return ZTIMER_USEC; }
+};
+#endif
+
+#if defined(MODULE_ZTIMER_MSEC) || defined(DOXYGEN)
+template <>
+struct ztimer_clock_dev<std::milli> {
+  static ztimer_clock_t* get() noexcept { return ZTIMER_MSEC; }
+};
+#endif
+
+} // namespace detail
+
+/**
+ * @brief Clock like std::chrono::steady_clock, backed by a ztimer clock
+ *
+ * The period selects the clock at compile time: `std::micro` for
+ * `ZTIMER_USEC` and `std::milli` for `ZTIMER_MSEC`. now() is a single
+ * ztimer_now() and durations use the tick count of the clock as
+ * representation, so no 64 bit math is needed to get or compare times.
+ *
+ * @note  The tick count wraps around, for `ZTIMER_USEC` after about 71
+ *        minutes. Only the difference of two time points of the same clock
+ *        is meaningful, see ticks_until().
+ */
+template <class Period>
+class ztimer_clock {
+public:
+  /**
+   * @brief Representation of the tick count.
+   */
+  using rep = ztimer_now_t;
+  /**
+   * @brief Tick period in seconds.
+   */
+  using period = Period;
+  /**
+   * @brief Duration type of the clock.
+   */
+  using duration = std::chrono::duration<rep, period>;
+  /**
+   * @brief Time point type of the clock.
+   */
+  using time_point = std::chrono::time_point<ztimer_clock, duration>;
+  /**
+   * @brief The clock is monotonic.
+   */
+  static constexpr bool is_steady = true;
+
+  /**
+   * @brief Returns the current time of the clock.
+   */
+  static time_point now() noexcept {
+    return time_point(duration(ztimer_now(native_handle())));
+  }
+
+  /**
+   * @brief Provides access to the ztimer clock.
+   */
+  static ztimer_clock_t* native_handle() noexcept {
+    return detail::ztimer_clock_dev<Period>::get();
+  }
+};
+
+#if defined(MODULE_ZTIMER_USEC) || defined(DOXYGEN)
+/**
+ * @brief Steady clock based on `ZTIMER_USEC`.
+ */
+using usec_clock = ztimer_clock<std::micro>;
+#endif
+
+#if defined(MODULE_ZTIMER_MSEC) || defined(DOXYGEN)
+/**
+ * @brief Steady clock based on `ZTIMER_MSEC`.
+ */
+using msec_clock = ztimer_clock<std::milli>;
+#endif
+
+/**
+ * @brief Ticks until @p tp, zero or negative if it has passed.
+ *
+ * Time points are compared by their difference, which stays correct across
+ * a wrap around of the tick count as long as they are less than half the
+ * range of the tick count apart.
+ */
+template <class Period, class Duration>
+inline typename std::make_signed<ztimer_now_t>::type
+ticks_until(const std::chrono::time_point<ztimer_clock<Period>, Duration>& tp) {
+  using clock = ztimer_clock<Period>;
+  ztimer_now_t target = std::chrono::duration_cast<typename clock::duration>(
+                          tp.time_since_epoch()).count();
+  return static_cast<typename std::make_signed<ztimer_now_t>::type>(
+           target - ztimer_now(clock::native_handle()));
+}
+
+namespace detail {
+
+/**
+ * @brief Clock to wait for durations of Period with: `ZTIMER_MSEC` if it
+ *        is able to represent the duration, as it is cheaper to keep running,
+ *        `ZTIMER_USEC` otherwise.
+ */
+template <class Period>
+struct wait_clock {
+#if defined(MODULE_ZTIMER_USEC) && defined(MODULE_ZTIMER_MSEC)
+  using type = typename std::conditional<
+    std::ratio_divide<Period, std::milli>::den == 1,
+    ztimer_clock<std::milli>, ztimer_clock<std::micro>>::type;
+#elif defined(MODULE_ZTIMER_USEC)
+  using type = ztimer_clock<std::micro>;
+#else
+  using type = ztimer_clock<std::milli>;
+#endif
+};
+
+/**
+ * @brief Convert @p d to the duration To, rounding up.
+ */
+template <class To, class Rep, class Period>
+inline To ceil_cast(const std::chrono::duration<Rep, Period>& d) {
+  To t = std::chrono::duration_cast<To>(d);
+  if (t < d) {
+    ++t;
+  }
+  return t;
+}
+
+/**
+ * @brief Convert @p d to ticks of Clock to wait for, rounding up and
+ *        limited to half the range of the tick count.
+ */
+template <class Clock, class Rep, class Period>
+inline uint32_t wait_ticks(const std::chrono::duration<Rep, Period>& d) {
+  constexpr typename Clock::duration max{UINT32_MAX / 2};
+  if (d >= max) {
+    return max.count();
+  }
+  return ceil_cast<typename Clock::duration>(d).count();
+}
+
+} // namespace detail
+#endif /* RIOT_CHRONO_HAS_ZTIMER */
+
 } // namespace riot
 
 #endif // RIOT_CHRONO_HPP
@@ -106,6 +106,38 @@ public:
   template <class Predicate>
   bool wait_until(unique_lock<mutex>& lock, const time_point& timeout_time,
                   Predicate pred);
+#ifdef RIOT_CHRONO_HAS_ZTIMER
+  /**
+   * @brief Block until woken up through the condition variable or a specified
+   *        point in time of a ztimer_clock is reached. The lock is reacquired
+   *        either way.
+   * @param lock          A lock that is locked by the current thread.
+   * @param timeout_time  Point in time when the thread is woken up
+   *                      independently of the condition variable.
+   * @return A status to signify if woken up due to a timeout or the cv.
+   */
+  template <class Period, class Duration>
+  cv_status wait_until(unique_lock<mutex>& lock,
+                       const std::chrono::time_point<ztimer_clock<Period>,
+                                                     Duration>& timeout_time);
+  /**
+   * @brief Block until woken up through the condition variable and a predicate
+   *        is fulfilled or a specified point in time of a ztimer_clock is
+   *        reached. The lock is reacquired either way.
+   * @param lock          A lock that is locked by the current thread.
+   * @param timeout_time  Point in time when the thread is woken up
+   *                      independently of the condition variable.
+   * @param pred          A predicate that returns a bool to signify if the
+   *                      thread should continue to wait when woken up through
+   *                      the cv.
+   * @return Result of the pred when the function returns.
+   */
+  template <class Period, class Duration, class Predicate>
+  bool wait_until(unique_lock<mutex>& lock,
+                  const std::chrono::time_point<ztimer_clock<Period>,
+                                                Duration>& timeout_time,
+                  Predicate pred);
+#endif
 
   /**
    * @brief Blocks until woken up through the condition variable or when the
@@ -140,6 +172,11 @@ private:
   condition_variable(const condition_variable&);
   condition_variable& operator=(const condition_variable&);
 
+#ifdef RIOT_CHRONO_HAS_ZTIMER
+  cv_status wait_ticks(unique_lock<mutex>& lock, ztimer_clock_t* clock,
+                       uint32_t ticks);
+#endif
+
   priority_queue_t m_queue;
 };
 
@@ -171,6 +208,11 @@ cv_status condition_variable::wait_for(unique_lock<mutex>& lock,
   if (timeout_duration <= timeout_duration.zero()) {
     return cv_status::timeout;
   }
+#ifdef RIOT_CHRONO_HAS_ZTIMER
+  using clock = typename detail::wait_clock<Period>::type;
+  return wait_ticks(lock, clock::native_handle(),
+                    detail::wait_ticks<clock>(timeout_duration));
+#else
   timex_t timeout, before, after;
   auto s = duration_cast<seconds>(timeout_duration);
   timeout.seconds = s.count();
@@ -185,6 +227,7 @@ cv_status condition_variable::wait_for(unique_lock<mutex>& lock,
   auto passed = timex_sub(after, before);
   auto cmp = timex_cmp(passed, timeout);
   return cmp < 1 ? cv_status::no_timeout : cv_status::timeout;
+#endif
 }
 
 template <class Rep, class Period, class Predicate>
@@ -192,9 +235,49 @@ inline bool condition_variable::wait_for(unique_lock<mutex>& lock,
                                          const std::chrono::duration
                                          <Rep, Period>& timeout_duration,
                                          Predicate pred) {
-  return wait_until(lock, std::chrono::steady_clock::now() + timeout_duration,
-                    std::move(pred));
+#ifdef RIOT_CHRONO_HAS_ZTIMER
+  using clock = typename detail::wait_clock<Period>::type;
+  if (timeout_duration <= timeout_duration.zero()) {
+    return pred();
+  }
+  auto timeout_time = clock::now() + typename clock::duration(
+                        detail::wait_ticks<clock>(timeout_duration));
+#else
+  auto timeout_time = riot::now();
+  timeout_time += timeout_duration;
+#endif
+  return wait_until(lock, timeout_time, std::move(pred));
+}
+
+#ifdef RIOT_CHRONO_HAS_ZTIMER
+template <class Period, class Duration>
+cv_status condition_variable::wait_until(unique_lock<mutex>& lock,
+                                         const std::chrono::time_point
+                                         <ztimer_clock<Period>,
+                                         Duration>& timeout_time) {
+  auto ticks = ticks_until(timeout_time);
+  if (ticks <= 0) {
+    return cv_status::timeout;
+  }
+  wait_ticks(lock, ztimer_clock<Period>::native_handle(), ticks);
+  return (ticks_until(timeout_time) > 0) ? cv_status::no_timeout
+                                         : cv_status::timeout;
+}
+
+template <class Period, class Duration, class Predicate>
+bool condition_variable::wait_until(unique_lock<mutex>& lock,
+                                    const std::chrono::time_point
+                                    <ztimer_clock<Period>,
+                                    Duration>& timeout_time,
+                                    Predicate pred) {
+  while (!pred()) {
+    if (wait_until(lock, timeout_time) == cv_status::timeout) {
+      return pred();
+    }
+  }
+  return true;
 }
+#endif
 
 } // namespace riot
 
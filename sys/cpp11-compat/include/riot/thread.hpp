@@ -182,6 +182,17 @@ void sleep_for(const std::chrono::nanoseconds& ns);
 template <class Rep, class Period>
 void sleep_for(const std::chrono::duration<Rep, Period>& sleep_duration) {
   using namespace std::chrono;
+#ifdef RIOT_CHRONO_HAS_ZTIMER
+  using clock = typename detail::wait_clock<Period>::type;
+  using ticks = std::chrono::duration<Rep, typename clock::period>;
+  Rep left = detail::ceil_cast<ticks>(sleep_duration).count();
+  while (left > 0) {
+    constexpr Rep max = UINT32_MAX / 2;
+    uint32_t n = (left > max) ? max : left;
+    ztimer_sleep(clock::native_handle(), n);
+    left -= n;
+  }
+#else
   if (sleep_duration > std::chrono::duration<Rep, Period>::zero()) {
     constexpr std::chrono::duration<long double> max = nanoseconds::max();
     nanoseconds ns;
@@ -195,6 +206,7 @@ void sleep_for(const std::chrono::duration<Rep, Period>& sleep_duration) {
     }
     sleep_for(ns);
   }
+#endif
 }
 /**
  * @brief Puts the current thread to sleep.
@@ -209,6 +221,21 @@ inline void sleep_until(const riot::time_point& sleep_time) {
     cv.wait_until(lk, sleep_time);
   }
 }
+#ifdef RIOT_CHRONO_HAS_ZTIMER
+/**
+ * @brief Puts the current thread to sleep.
+ * @param[in] sleep_time    A point in time of a ztimer_clock that specifies
+ *                          when the thread should wake up.
+ */
+template <class Period, class Duration>
+void sleep_until(const std::chrono::time_point<ztimer_clock<Period>,
+                                               Duration>& sleep_time) {
+  auto ticks = ticks_until(sleep_time);
+  if (ticks > 0) {
+    ztimer_sleep(ztimer_clock<Period>::native_handle(), ticks);
+  }
+}
+#endif
 } // namespace this_thread
 
 /**
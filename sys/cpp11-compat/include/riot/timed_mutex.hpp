@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup cpp11-compat
+ * @{
+ *
+ * @file
+ * @brief   C++11 timed_mutex drop in replacement
+ * @see     <a href="http://en.cppreference.com/w/cpp/thread/timed_mutex">
+ *            std::timed_mutex
+ *          </a>
+ *
+ * @author  ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#ifndef RIOT_TIMED_MUTEX_HPP
+#define RIOT_TIMED_MUTEX_HPP
+
+#include "riot/chrono.hpp"
+#include "riot/condition_variable.hpp"
+#include "riot/mutex.hpp"
+
+namespace riot {
+
+/**
+ * @brief C++11 compliant implementation of timed mutex, the timeouts use
+ *        the ztimer based clocks if available
+ * @see   <a href="http://en.cppreference.com/w/cpp/thread/timed_mutex">
+ *          std::timed_mutex
+ *        </a>
+ */
+class timed_mutex {
+public:
+  inline timed_mutex() noexcept : m_locked{false} {}
+
+  /**
+   * @brief Lock the mutex.
+   */
+  void lock();
+  /**
+   * @brief Try to lock the mutex.
+   * @return `true` if the mutex was locked, `false` otherwise.
+   */
+  bool try_lock() noexcept;
+  /**
+   * @brief Try to lock the mutex, blocking for at most @p timeout_duration.
+   * @return `true` if the mutex was locked, `false` on timeout.
+   */
+  template <class Rep, class Period>
+  bool try_lock_for(const std::chrono::duration<Rep, Period>& timeout_duration) {
+    unique_lock<mutex> lk(m_guard);
+    if (!m_cv.wait_for(lk, timeout_duration, [this] { return !m_locked; })) {
+      return false;
+    }
+    m_locked = true;
+    return true;
+  }
+  /**
+   * @brief Try to lock the mutex, blocking until @p timeout_time at most.
+   * @param timeout_time  A riot::time_point or a time point of a
+   *                      riot::ztimer_clock.
+   * @return `true` if the mutex was locked, `false` on timeout.
+   */
+  template <class TimePoint>
+  bool try_lock_until(const TimePoint& timeout_time) {
+    unique_lock<mutex> lk(m_guard);
+    if (!m_cv.wait_until(lk, timeout_time, [this] { return !m_locked; })) {
+      return false;
+    }
+    m_locked = true;
+    return true;
+  }
+  /**
+   * @brief Unlock the mutex.
+   */
+  void unlock() noexcept;
+
+private:
+  timed_mutex(const timed_mutex&);
+  timed_mutex& operator=(const timed_mutex&);
+
+  mutex m_guard;
+  condition_variable m_cv;
+  bool m_locked;
+};
+
+} // namespace riot
+
+#endif // RIOT_TIMED_MUTEX_HPP
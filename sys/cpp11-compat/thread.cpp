@@ -72,9 +72,13 @@ namespace this_thread {
 
 void sleep_for(const chrono::nanoseconds& ns) {
   using namespace chrono;
+#ifdef RIOT_CHRONO_HAS_ZTIMER
+  sleep_for<nanoseconds::rep, nanoseconds::period>(ns);
+#else
   if (ns > nanoseconds::zero()) {
     xtimer_usleep64(static_cast<uint64_t>(duration_cast<microseconds>(ns).count()));
   }
+#endif
 }
 
 } // namespace this_thread
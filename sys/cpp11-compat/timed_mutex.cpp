@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup cpp11-compat
+ * @{
+ *
+ * @file
+ * @brief   C++11 timed_mutex drop in replacement
+ *
+ * @author  ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include "riot/timed_mutex.hpp"
+
+namespace riot {
+
+void timed_mutex::lock() {
+  unique_lock<mutex> lk(m_guard);
+  m_cv.wait(lk, [this] { return !m_locked; });
+  m_locked = true;
+}
+
+bool timed_mutex::try_lock() noexcept {
+  lock_guard<mutex> lk(m_guard);
+  if (m_locked) {
+    return false;
+  }
+  m_locked = true;
+  return true;
+}
+
+void timed_mutex::unlock() noexcept {
+  lock_guard<mutex> lk(m_guard);
+  m_locked = false;
+  m_cv.notify_one();
+}
+
+} // namespace riot
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup cpp_coro
+ * @{
+ *
+ * @file
+ * @brief   Coroutine task scheduling, flags and mutex
+ *
+ * @author  ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <cerrno>
+
+#include "irq.h"
+#include "riot/coro.hpp"
+
+namespace riot {
+namespace coro {
+
+int spawn(event_queue_t *queue, task<void>&& t) {
+  auto h = t.release();
+  if (!h) {
+    return -ENOMEM;
+  }
+  h.promise().detached = true;
+  detail::resume_event *ev = detail::prepare(h);
+  ev->queue = queue;
+  ev->post();
+  return 0;
+}
+
+static void _append(detail::waiter **list, detail::waiter *w) {
+  w->next = nullptr;
+  while (*list) {
+    list = &(*list)->next;
+  }
+  *list = w;
+}
+
+/* must be called with interrupts disabled */
+bool flags::_take(awaiter *w) {
+  uint32_t set = m_flags & w->m_mask;
+  if (!set || (w->m_all && (set != w->m_mask))) {
+    return false;
+  }
+  m_flags &= ~set;
+  w->m_result = set;
+  return true;
+}
+
+bool flags::_try(awaiter *w) {
+  unsigned state = irq_disable();
+  bool res = _take(w);
+  irq_restore(state);
+  return res;
+}
+
+bool flags::_wait(awaiter *w) {
+  unsigned state = irq_disable();
+  /* flags might have been set in between await_ready() and now */
+  bool suspend = !_take(w);
+  if (suspend) {
+    _append(&m_waiters, w);
+  }
+  irq_restore(state);
+  return suspend;
+}
+
+void flags::set(uint32_t mask) {
+  unsigned state = irq_disable();
+  m_flags |= mask;
+  for (detail::waiter **prev = &m_waiters; *prev;) {
+    awaiter *w = static_cast<awaiter *>(*prev);
+    if (_take(w)) {
+      *prev = w->next;
+      w->ev->post();
+    }
+    else {
+      prev = &w->next;
+    }
+  }
+  irq_restore(state);
+}
+
+uint32_t flags::clear(uint32_t mask) {
+  unsigned state = irq_disable();
+  uint32_t res = m_flags & mask;
+  m_flags &= ~mask;
+  irq_restore(state);
+  return res;
+}
+
+bool mutex::try_lock() noexcept {
+  unsigned state = irq_disable();
+  bool res = !m_locked;
+  m_locked = true;
+  irq_restore(state);
+  return res;
+}
+
+bool mutex::_wait(awaiter *w) noexcept {
+  unsigned state = irq_disable();
+  bool suspend = m_locked;
+  if (suspend) {
+    _append(&m_waiters, w);
+  }
+  m_locked = true;
+  irq_restore(state);
+  return suspend;
+}
+
+void mutex::unlock() noexcept {
+  unsigned state = irq_disable();
+  detail::waiter *w = m_waiters;
+  if (w) {
+    /* hand the mutex over, it stays locked */
+    m_waiters = w->next;
+    w->ev->post();
+  }
+  else {
+    m_locked = false;
+  }
+  irq_restore(state);
+}
+
+} // namespace coro
+} // namespace riot
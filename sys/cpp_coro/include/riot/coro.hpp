@@ -0,0 +1,524 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup  cpp_coro  C++20 coroutine tasks for RIOT
+ * @ingroup   sys
+ * @brief     Stackless tasks running on event queues
+ *
+ * A task is a C++20 coroutine returning @ref riot::coro::task. Instead of
+ * blocking a thread, it suspends at `co_await` and is resumed later by an
+ * event posted to the @ref event_queue_t it was spawned on. Many tasks thus
+ * share the stack of the thread running event_loop() on that queue, each
+ * task only needs its coroutine frame, allocated with malloc().
+ *
+ * ```cpp
+ * riot::coro::task<> blink()
+ * {
+ *     while (true) {
+ *         LED0_TOGGLE;
+ *         co_await riot::coro::sleep(500);
+ *     }
+ * }
+ *
+ * int main()
+ * {
+ *     riot::coro::spawn(EVENT_PRIO_MEDIUM, blink());
+ *     ...
+ * }
+ * ```
+ *
+ * Awaitables:
+ * - riot::coro::sleep() and riot::coro::yield()
+ * - riot::coro::flags::wait_any() and riot::coro::flags::wait_all(), the
+ *   per task equivalent of thread flags
+ * - riot::coro::mutex::lock()
+ * - another riot::coro::task, e.g. to call a coroutine returning a value
+ * - riot::coro::udp_socket::recv() in `riot/coro/udp.hpp`, with `sock_udp`
+ *
+ * Tasks must never call blocking functions, as this blocks all other tasks
+ * on the same queue. All functions are meant to be called from the thread of
+ * the queue, except for riot::coro::flags::set(), which can also be called
+ * from other threads and interrupt context.
+ *
+ * The module requires a compiler supporting C++20 coroutines, it adds
+ * `-std=c++20` to `CXXEXFLAGS`.
+ */
+
+/**
+ * @ingroup cpp_coro
+ * @{
+ *
+ * @file
+ * @brief   Coroutine tasks, their scheduling and basic awaitables
+ *
+ * @author  ML!PA Consulting GmbH
+ */
+
+#ifndef RIOT_CORO_HPP
+#define RIOT_CORO_HPP
+
+#include <coroutine>
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "event.h"
+#include "ztimer.h"
+
+namespace riot {
+namespace coro {
+
+template <class T = void>
+class task;
+
+namespace detail {
+
+/**
+ * @brief Event resuming a suspended coroutine
+ */
+struct resume_event : event_t {
+  std::coroutine_handle<> handle;   /**< coroutine to resume */
+  event_queue_t *queue = nullptr;   /**< queue the coroutine runs on */
+
+  resume_event() : event_t{ {}, _run } {}
+
+  /**
+   * @brief Post the event to resume the coroutine, can be called from
+   *        interrupt context
+   */
+  void post() { event_post(queue, this); }
+
+private:
+  static void _run(event_t *ev) {
+    static_cast<resume_event *>(ev)->handle.resume();
+  }
+};
+
+/**
+ * @brief Parts of the promise independent of the result type
+ */
+struct promise_base {
+  resume_event ev;                      /**< resumes the task */
+  std::coroutine_handle<> continuation; /**< task awaiting this one */
+  bool detached = false;                /**< frame is freed on completion */
+
+  /**
+   * @brief Allocate the frame without throwing, see
+   *        task::operator bool()
+   */
+  static void *operator new(std::size_t size) noexcept {
+    return std::malloc(size);
+  }
+
+  /**
+   * @brief Free the frame
+   */
+  static void operator delete(void *ptr) noexcept { std::free(ptr); }
+
+  /**
+   * @brief Tasks start when spawned or awaited
+   */
+  std::suspend_always initial_suspend() noexcept { return {}; }
+
+  /**
+   * @brief Continue with the awaiting task or free a detached one
+   */
+  struct final_awaiter {
+    bool await_ready() noexcept { return false; }
+    template <class P>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<P> h) noexcept {
+      promise_base &p = h.promise();
+      if (p.detached) {
+        h.destroy();
+        return std::noop_coroutine();
+      }
+      return p.continuation ? p.continuation : std::noop_coroutine();
+    }
+    void await_resume() noexcept {}
+  };
+
+  /**
+   * @brief See final_awaiter
+   */
+  final_awaiter final_suspend() noexcept { return {}; }
+
+  /**
+   * @brief Exceptions are not supported
+   */
+  void unhandled_exception() noexcept { std::abort(); }
+};
+
+/**
+ * @brief Promise of a task returning T
+ */
+template <class T>
+struct promise : promise_base {
+  std::optional<T> value; /**< result of the task */
+
+  task<T> get_return_object() noexcept;
+
+  static task<T> get_return_object_on_allocation_failure() noexcept {
+    return task<T>();
+  }
+
+  template <class U>
+  void return_value(U&& v) {
+    value.emplace(std::forward<U>(v));
+  }
+};
+
+/**
+ * @brief Promise of a task without result
+ */
+template <>
+struct promise<void> : promise_base {
+  task<void> get_return_object() noexcept;
+
+  static task<void> get_return_object_on_allocation_failure() noexcept;
+
+  void return_void() noexcept {}
+};
+
+/**
+ * @brief Prepare the resume event of the task @p h for suspending
+ * @return The resume event to post to resume @p h.
+ */
+template <class P>
+inline resume_event *prepare(std::coroutine_handle<P> h) {
+  resume_event *ev = &h.promise().ev;
+  ev->handle = h;
+  return ev;
+}
+
+} // namespace detail
+
+/**
+ * @brief Coroutine task with result type T
+ *
+ * A task starts suspended. It is either started on a queue with spawn() or
+ * awaited by another task, which then continues with its result when it
+ * completes. The task object owns the coroutine frame until it is passed to
+ * spawn().
+ */
+template <class T>
+class task {
+public:
+  /**
+   * @brief Promise type of the coroutine
+   */
+  using promise_type = detail::promise<T>;
+  /**
+   * @brief Handle of the coroutine
+   */
+  using handle_type = std::coroutine_handle<promise_type>;
+
+  /**
+   * @brief Create an empty task
+   */
+  task() noexcept = default;
+  /**
+   * @brief Take ownership of the coroutine @p h
+   */
+  explicit task(handle_type h) noexcept : m_handle{h} {}
+  task(task&& other) noexcept
+      : m_handle{std::exchange(other.m_handle, nullptr)} {}
+  task& operator=(task&& other) noexcept {
+    if (this != &other) {
+      if (m_handle) {
+        m_handle.destroy();
+      }
+      m_handle = std::exchange(other.m_handle, nullptr);
+    }
+    return *this;
+  }
+  task(const task&) = delete;
+  task& operator=(const task&) = delete;
+  ~task() {
+    if (m_handle) {
+      m_handle.destroy();
+    }
+  }
+
+  /**
+   * @brief Check if the task holds a coroutine
+   * @return `false` if allocating the coroutine frame failed.
+   */
+  explicit operator bool() const noexcept { return bool(m_handle); }
+
+  /**
+   * @brief Release ownership of the coroutine
+   */
+  handle_type release() noexcept { return std::exchange(m_handle, nullptr); }
+
+  /**
+   * @brief Awaitable running the task on the queue of the awaiting task
+   */
+  class awaiter {
+  public:
+    explicit awaiter(handle_type h) noexcept : m_handle{h} {}
+
+    bool await_ready() noexcept { return false; }
+    template <class P>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<P> caller) noexcept {
+      m_handle.promise().ev.queue = caller.promise().ev.queue;
+      m_handle.promise().continuation = caller;
+      return m_handle;
+    }
+    /**
+     * @return The result of the task.
+     */
+    T await_resume() {
+      if constexpr (!std::is_void_v<T>) {
+        return std::move(*m_handle.promise().value);
+      }
+    }
+
+  private:
+    handle_type m_handle;
+  };
+
+  /**
+   * @brief Run the task on the queue of the awaiting task and continue
+   *        with its result
+   */
+  awaiter operator co_await() && noexcept { return awaiter{m_handle}; }
+
+private:
+  handle_type m_handle = nullptr;
+};
+
+namespace detail {
+
+template <class T>
+inline task<T> promise<T>::get_return_object() noexcept {
+  return task<T>{std::coroutine_handle<promise<T>>::from_promise(*this)};
+}
+
+inline task<void> promise<void>::get_return_object() noexcept {
+  return task<void>{std::coroutine_handle<promise<void>>::from_promise(*this)};
+}
+
+inline task<void> promise<void>::get_return_object_on_allocation_failure() noexcept {
+  return task<void>();
+}
+
+} // namespace detail
+
+/**
+ * @brief Start the task @p t on @p queue
+ *
+ * The task runs detached, its frame is freed when it completes.
+ *
+ * @param[in] queue   Queue to run the task on, a thread must run
+ *                    event_loop() on it.
+ * @param[in] t       The task.
+ * @return `0` on success, `-ENOMEM` if allocating the task failed.
+ */
+int spawn(event_queue_t *queue, task<void>&& t);
+
+/**
+ * @brief Awaitable suspending the task for a while
+ */
+class sleep_awaiter {
+public:
+  /**
+   * @brief Sleep for @p val ticks of @p clock
+   */
+  sleep_awaiter(ztimer_clock_t *clock, uint32_t val) noexcept
+      : m_clock{clock}, m_val{val} {}
+  sleep_awaiter(const sleep_awaiter&) = delete;
+  sleep_awaiter& operator=(const sleep_awaiter&) = delete;
+  ~sleep_awaiter() { ztimer_remove(m_clock, &m_timer); }
+
+  bool await_ready() const noexcept { return m_val == 0; }
+  template <class P>
+  void await_suspend(std::coroutine_handle<P> h) noexcept {
+    m_timer.callback = _cb;
+    m_timer.arg = detail::prepare(h);
+    ztimer_set(m_clock, &m_timer, m_val);
+  }
+  void await_resume() noexcept {}
+
+private:
+  static void _cb(void *arg) {
+    static_cast<detail::resume_event *>(arg)->post();
+  }
+
+  ztimer_clock_t *m_clock;
+  uint32_t m_val;
+  ztimer_t m_timer = {};
+};
+
+/**
+ * @brief Suspend the task for @p ms milliseconds
+ */
+inline sleep_awaiter sleep(uint32_t ms) noexcept {
+  return sleep_awaiter{ZTIMER_MSEC, ms};
+}
+
+/**
+ * @brief Suspend the task for @p val ticks of @p clock
+ */
+inline sleep_awaiter sleep(ztimer_clock_t *clock, uint32_t val) noexcept {
+  return sleep_awaiter{clock, val};
+}
+
+/**
+ * @brief Awaitable of yield()
+ */
+class yield_awaiter {
+public:
+  bool await_ready() noexcept { return false; }
+  template <class P>
+  void await_suspend(std::coroutine_handle<P> h) noexcept {
+    detail::prepare(h)->post();
+  }
+  void await_resume() noexcept {}
+};
+
+/**
+ * @brief Let the other tasks and events queued on the same queue run
+ */
+inline yield_awaiter yield() noexcept { return yield_awaiter{}; }
+
+namespace detail {
+
+/**
+ * @brief Task suspended on a flags or mutex object
+ */
+struct waiter {
+  waiter *next = nullptr;       /**< next waiting task */
+  resume_event *ev = nullptr;   /**< resumes the task */
+};
+
+} // namespace detail
+
+/**
+ * @brief Flags tasks can wait for, set from any context
+ *
+ * Behaves like thread flags, but belongs to an object instead of a thread,
+ * as tasks share their thread.
+ */
+class flags {
+public:
+  /**
+   * @brief Awaitable of wait_any() and wait_all()
+   */
+  class awaiter : public detail::waiter {
+  public:
+    awaiter(flags& f, uint32_t mask, bool all) noexcept
+        : m_flags{f}, m_mask{mask}, m_all{all} {}
+
+    bool await_ready() noexcept { return m_flags._try(this); }
+    template <class P>
+    bool await_suspend(std::coroutine_handle<P> h) noexcept {
+      ev = detail::prepare(h);
+      return m_flags._wait(this);
+    }
+    /**
+     * @return The flags of the mask that were set, they are cleared.
+     */
+    uint32_t await_resume() noexcept { return m_result; }
+
+  private:
+    friend class flags;
+    flags& m_flags;
+    uint32_t m_mask;
+    uint32_t m_result = 0;
+    bool m_all;
+  };
+
+  /**
+   * @brief Set @p mask and resume the tasks waiting for it
+   */
+  void set(uint32_t mask);
+
+  /**
+   * @brief Clear @p mask
+   * @return The flags of @p mask that were set.
+   */
+  uint32_t clear(uint32_t mask);
+
+  /**
+   * @brief Wait until any flag of @p mask is set
+   */
+  awaiter wait_any(uint32_t mask) noexcept { return awaiter{*this, mask, false}; }
+
+  /**
+   * @brief Wait until all flags of @p mask are set
+   */
+  awaiter wait_all(uint32_t mask) noexcept { return awaiter{*this, mask, true}; }
+
+private:
+  bool _try(awaiter *w);
+  bool _wait(awaiter *w);
+  bool _take(awaiter *w);
+
+  uint32_t m_flags = 0;
+  detail::waiter *m_waiters = nullptr;
+};
+
+/**
+ * @brief Mutex for tasks, waiting tasks acquire it in FIFO order
+ */
+class mutex {
+public:
+  /**
+   * @brief Awaitable of lock()
+   */
+  class awaiter : public detail::waiter {
+  public:
+    explicit awaiter(mutex& m) noexcept : m_mutex{m} {}
+
+    bool await_ready() noexcept { return m_mutex.try_lock(); }
+    template <class P>
+    bool await_suspend(std::coroutine_handle<P> h) noexcept {
+      ev = detail::prepare(h);
+      return m_mutex._wait(this);
+    }
+    void await_resume() noexcept {}
+
+  private:
+    mutex& m_mutex;
+  };
+
+  mutex() noexcept = default;
+  mutex(const mutex&) = delete;
+  mutex& operator=(const mutex&) = delete;
+
+  /**
+   * @brief Lock the mutex, resumes the task once it owns the mutex
+   */
+  awaiter lock() noexcept { return awaiter{*this}; }
+
+  /**
+   * @brief Try to lock the mutex
+   * @return `true` if the mutex was locked, `false` otherwise.
+   */
+  bool try_lock() noexcept;
+
+  /**
+   * @brief Unlock the mutex, the first waiting task becomes its owner
+   */
+  void unlock() noexcept;
+
+private:
+  bool _wait(awaiter *w) noexcept;
+
+  bool m_locked = false;
+  detail::waiter *m_waiters = nullptr;
+};
+
+} // namespace coro
+} // namespace riot
+
+#endif // RIOT_CORO_HPP
+/** @} */
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup cpp_coro
+ * @{
+ *
+ * @file
+ * @brief   UDP sock with awaitable receive, requires `sock_udp`
+ *
+ * @author  ML!PA Consulting GmbH
+ */
+
+#ifndef RIOT_CORO_UDP_HPP
+#define RIOT_CORO_UDP_HPP
+
+#include <cerrno>
+#include <sys/types.h>
+
+#include "net/sock/async.h"
+#include "net/sock/udp.h"
+#include "riot/coro.hpp"
+
+namespace riot {
+namespace coro {
+
+/**
+ * @brief UDP sock for tasks
+ *
+ * Only one task may wait in recv() at a time. Sending does not block, so
+ * send() is a plain function.
+ */
+class udp_socket {
+public:
+  /**
+   * @brief Awaitable of recv()
+   */
+  class recv_awaiter {
+  public:
+    recv_awaiter(udp_socket& s, void *data, size_t max_len, uint32_t timeout,
+                 sock_udp_ep_t *remote) noexcept
+        : m_socket{s}, m_data{data}, m_max_len{max_len}, m_timeout{timeout},
+          m_remote{remote} {}
+    recv_awaiter(const recv_awaiter&) = delete;
+    recv_awaiter& operator=(const recv_awaiter&) = delete;
+
+    bool await_ready() noexcept;
+    template <class P>
+    void await_suspend(std::coroutine_handle<P> h) noexcept {
+      _suspend(h, h.promise().ev.queue);
+    }
+    /**
+     * @return The result of sock_udp_recv(), `-ETIMEDOUT` on timeout.
+     */
+    ssize_t await_resume() noexcept { return m_res; }
+
+  private:
+    friend class udp_socket;
+
+    struct event : event_t {
+      recv_awaiter *self;
+    };
+
+    void _suspend(std::coroutine_handle<> h, event_queue_t *queue) noexcept;
+    void _finish() noexcept;
+    static void _rx(event_t *ev);
+    static void _timeout(event_t *ev);
+    static void _timer_cb(void *arg);
+
+    udp_socket& m_socket;
+    void *m_data;
+    size_t m_max_len;
+    uint32_t m_timeout;
+    sock_udp_ep_t *m_remote;
+    ssize_t m_res = -EAGAIN;
+    std::coroutine_handle<> m_handle;
+    event_queue_t *m_queue = nullptr;
+    event m_rx_ev = {};
+    event m_timeout_ev = {};
+    ztimer_t m_timer = {};
+  };
+
+  udp_socket() noexcept = default;
+  udp_socket(const udp_socket&) = delete;
+  udp_socket& operator=(const udp_socket&) = delete;
+  ~udp_socket() { close(); }
+
+  /**
+   * @brief Create the sock, see sock_udp_create()
+   */
+  int create(const sock_udp_ep_t *local, const sock_udp_ep_t *remote = nullptr,
+             uint16_t flags = 0);
+
+  /**
+   * @brief Close the sock, see sock_udp_close()
+   */
+  void close();
+
+  /**
+   * @brief Receive a datagram, see sock_udp_recv()
+   *
+   * @param[out] data       Buffer for the payload.
+   * @param[in]  max_len    Size of @p data.
+   * @param[in]  timeout    Timeout in milliseconds, `SOCK_NO_TIMEOUT` to
+   *                        wait forever, `0` to not wait.
+   * @param[out] remote     Remote end point of the datagram, may be
+   *                        `nullptr`.
+   */
+  recv_awaiter recv(void *data, size_t max_len,
+                    uint32_t timeout = SOCK_NO_TIMEOUT,
+                    sock_udp_ep_t *remote = nullptr) noexcept {
+    return recv_awaiter{*this, data, max_len, timeout, remote};
+  }
+
+  /**
+   * @brief Send a datagram, see sock_udp_send()
+   */
+  ssize_t send(const void *data, size_t len,
+               const sock_udp_ep_t *remote = nullptr) {
+    return sock_udp_send(&m_sock, data, len, remote);
+  }
+
+  /**
+   * @brief Provides access to the sock.
+   */
+  sock_udp_t *native_handle() { return &m_sock; }
+
+private:
+  static void _cb(sock_udp_t *sock, sock_async_flags_t flags, void *arg);
+
+  sock_udp_t m_sock = {};
+  recv_awaiter *m_waiter = nullptr;
+  bool m_open = false;
+};
+
+} // namespace coro
+} // namespace riot
+
+#endif // RIOT_CORO_UDP_HPP
+/** @} */
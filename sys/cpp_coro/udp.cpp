@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup cpp_coro
+ * @{
+ *
+ * @file
+ * @brief   UDP sock with awaitable receive
+ *
+ * The sock callback runs in the context of the network stack, so it only
+ * posts an event. Receiving is done by that event on the queue of the task,
+ * as is the timeout, so they cannot race with each other.
+ *
+ * @author  ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <cassert>
+#include <cerrno>
+
+#include "irq.h"
+#include "riot/coro/udp.hpp"
+
+namespace riot {
+namespace coro {
+
+int udp_socket::create(const sock_udp_ep_t *local, const sock_udp_ep_t *remote,
+                       uint16_t flags) {
+  int res = sock_udp_create(&m_sock, local, remote, flags);
+  if (res == 0) {
+    m_open = true;
+    sock_udp_set_cb(&m_sock, _cb, this);
+  }
+  return res;
+}
+
+void udp_socket::close() {
+  assert(m_waiter == nullptr);
+  if (m_open) {
+    sock_udp_close(&m_sock);
+    m_open = false;
+  }
+}
+
+void udp_socket::_cb(sock_udp_t *sock, sock_async_flags_t flags, void *arg) {
+  (void)sock;
+  if (!(flags & SOCK_ASYNC_MSG_RECV)) {
+    return;
+  }
+  udp_socket *s = static_cast<udp_socket *>(arg);
+  unsigned state = irq_disable();
+  if (s->m_waiter) {
+    event_post(s->m_waiter->m_queue, &s->m_waiter->m_rx_ev);
+  }
+  irq_restore(state);
+}
+
+bool udp_socket::recv_awaiter::await_ready() noexcept {
+  m_res = sock_udp_recv(&m_socket.m_sock, m_data, m_max_len, 0, m_remote);
+  return (m_res != -EAGAIN) || (m_timeout == 0);
+}
+
+void udp_socket::recv_awaiter::_suspend(std::coroutine_handle<> h,
+                                        event_queue_t *queue) noexcept {
+  assert(m_socket.m_waiter == nullptr);
+  m_handle = h;
+  m_queue = queue;
+  m_rx_ev.handler = _rx;
+  m_rx_ev.self = this;
+  m_timeout_ev.handler = _timeout;
+  m_timeout_ev.self = this;
+
+  unsigned state = irq_disable();
+  m_socket.m_waiter = this;
+  irq_restore(state);
+  /* a datagram might have arrived since await_ready() */
+  event_post(m_queue, &m_rx_ev);
+
+  if (m_timeout != SOCK_NO_TIMEOUT) {
+    m_timer.callback = _timer_cb;
+    m_timer.arg = this;
+    ztimer_set(ZTIMER_MSEC, &m_timer, m_timeout);
+  }
+}
+
+void udp_socket::recv_awaiter::_finish() noexcept {
+  unsigned state = irq_disable();
+  m_socket.m_waiter = nullptr;
+  irq_restore(state);
+  ztimer_remove(ZTIMER_MSEC, &m_timer);
+  event_cancel(m_queue, &m_rx_ev);
+  event_cancel(m_queue, &m_timeout_ev);
+  /* the awaiter is gone after this */
+  m_handle.resume();
+}
+
+void udp_socket::recv_awaiter::_rx(event_t *ev) {
+  recv_awaiter *self = static_cast<event *>(ev)->self;
+  self->m_res = sock_udp_recv(&self->m_socket.m_sock, self->m_data,
+                              self->m_max_len, 0, self->m_remote);
+  if (self->m_res != -EAGAIN) {
+    self->_finish();
+  }
+}
+
+void udp_socket::recv_awaiter::_timeout(event_t *ev) {
+  recv_awaiter *self = static_cast<event *>(ev)->self;
+  self->m_res = -ETIMEDOUT;
+  self->_finish();
+}
+
+void udp_socket::recv_awaiter::_timer_cb(void *arg) {
+  recv_awaiter *self = static_cast<recv_awaiter *>(arg);
+  event_post(self->m_queue, &self->m_timeout_ev);
+}
+
+} // namespace coro
+} // namespace riot
@@ -32,14 +32,80 @@
  * @}
  */
 
+#include <errno.h>
 #include <stdio.h>
 #include <stdarg.h>
 #include <string.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <stdbool.h>
+
+#include "kernel_defines.h"
 #include "crypto/aes.h"
 #include "crypto/ciphers.h"
 
+#ifdef MODULE_PERIPH_CRYPTO
+#include "periph/crypto.h"
+
+static int aes_crypt_hw(const cipher_context_t *context, const uint8_t *input,
+                        uint8_t *output, size_t blocks, bool encrypt)
+{
+    int res = crypto_aes_ecb(context->context, AES_KEY_SIZE, input, output,
+                             blocks, encrypt);
+
+    if (res == 0) {
+        return 1;
+    }
+
+    /* only a rejected request leaves the output untouched, after a hardware
+     * error the input may already be overwritten if it is processed in place */
+    if (!IS_ACTIVE(CONFIG_CRYPTO_AES_SW_FALLBACK) || (res != -ENOTSUP)) {
+        return encrypt ? CIPHER_ERR_ENC_FAILED : CIPHER_ERR_DEC_FAILED;
+    }
+
+    return encrypt ? aes_encrypt_blocks(context, input, output, blocks)
+                   : aes_decrypt_blocks(context, input, output, blocks);
+}
+
+static int aes_encrypt_hw(const cipher_context_t *context,
+                          const uint8_t *plain_block, uint8_t *cipher_block)
+{
+    return aes_crypt_hw(context, plain_block, cipher_block, 1, true);
+}
+
+static int aes_decrypt_hw(const cipher_context_t *context,
+                          const uint8_t *cipher_block, uint8_t *plain_block)
+{
+    return aes_crypt_hw(context, cipher_block, plain_block, 1, false);
+}
+
+static int aes_encrypt_blocks_hw(const cipher_context_t *context,
+                                 const uint8_t *input, uint8_t *output,
+                                 size_t blocks)
+{
+    return aes_crypt_hw(context, input, output, blocks, true);
+}
+
+static int aes_decrypt_blocks_hw(const cipher_context_t *context,
+                                 const uint8_t *input, uint8_t *output,
+                                 size_t blocks)
+{
+    return aes_crypt_hw(context, input, output, blocks, false);
+}
+
+/**
+ * Interface to the aes cipher, backed by the hardware engine
+ */
+static const cipher_interface_t aes_interface = {
+    AES_BLOCK_SIZE,
+    AES_KEY_SIZE,
+    aes_init,
+    aes_encrypt_hw,
+    aes_decrypt_hw,
+    aes_encrypt_blocks_hw,
+    aes_decrypt_blocks_hw
+};
+#else
 /**
  * Interface to the aes cipher
  */
@@ -48,8 +114,11 @@ static const cipher_interface_t aes_interface = {
     AES_KEY_SIZE,
     aes_init,
     aes_encrypt,
-    aes_decrypt
+    aes_decrypt,
+    aes_encrypt_blocks,
+    aes_decrypt_blocks
 };
+#endif
 const cipher_id_t CIPHER_AES_128 = &aes_interface;
 
 static const u32 Te0[256] = {
@@ -1028,20 +1097,9 @@ static int aes_set_decrypt_key(const unsigned char *userKey, const int bits,
  * Encrypt a single block
  * in and out can overlap
  */
-int aes_encrypt(const cipher_context_t *context, const uint8_t *plainBlock,
-                uint8_t *cipherBlock)
+static int aes_encrypt_block(const AES_KEY *key, const uint8_t *plainBlock,
+                             uint8_t *cipherBlock)
 {
-    /* setup AES_KEY */
-    int res;
-    AES_KEY aeskey;
-    const AES_KEY *key = &aeskey;
-
-    res = aes_set_encrypt_key((unsigned char *)context->context,
-                              AES_KEY_SIZE * 8, &aeskey);
-    if (res < 0) {
-        return res;
-    }
-
     const u32 *rk;
     u32 s0, s1, s2, s3, t0, t1, t2, t3;
 #ifndef MODULE_CRYPTO_AES_UNROLL
@@ -1292,25 +1350,40 @@ int aes_encrypt(const cipher_context_t *context, const uint8_t *plainBlock,
     return 1;
 }
 
-/*
- * Decrypt a single block
- * in and out can overlap
- */
-int aes_decrypt(const cipher_context_t *context, const uint8_t *cipherBlock,
-                uint8_t *plainBlock)
+int aes_encrypt(const cipher_context_t *context, const uint8_t *plainBlock,
+                uint8_t *cipherBlock)
+{
+    return aes_encrypt_blocks(context, plainBlock, cipherBlock, 1);
+}
+
+int aes_encrypt_blocks(const cipher_context_t *context, const uint8_t *input,
+                       uint8_t *output, size_t blocks)
 {
-    /* setup AES_KEY */
+    /* setup AES_KEY once for all blocks */
     int res;
     AES_KEY aeskey;
-    const AES_KEY *key = &aeskey;
 
-    res = aes_set_decrypt_key((unsigned char *)context->context,
+    res = aes_set_encrypt_key((unsigned char *)context->context,
                               AES_KEY_SIZE * 8, &aeskey);
-
     if (res < 0) {
         return res;
     }
 
+    for (size_t i = 0; i < blocks; i++) {
+        aes_encrypt_block(&aeskey, input, output);
+        input += AES_BLOCK_SIZE;
+        output += AES_BLOCK_SIZE;
+    }
+    return 1;
+}
+
+/*
+ * Decrypt a single block
+ * in and out can overlap
+ */
+static int aes_decrypt_block(const AES_KEY *key, const uint8_t *cipherBlock,
+                             uint8_t *plainBlock)
+{
     const u32 *rk;
     u32 s0, s1, s2, s3, t0, t1, t2, t3;
 #ifndef MODULE_CRYPTO_AES_UNROLL
@@ -1553,4 +1626,31 @@ int aes_decrypt(const cipher_context_t *context, const uint8_t *cipherBlock,
     return 1;
 }
 
+int aes_decrypt(const cipher_context_t *context, const uint8_t *cipherBlock,
+                uint8_t *plainBlock)
+{
+    return aes_decrypt_blocks(context, cipherBlock, plainBlock, 1);
+}
+
+int aes_decrypt_blocks(const cipher_context_t *context, const uint8_t *input,
+                       uint8_t *output, size_t blocks)
+{
+    /* setup AES_KEY once for all blocks */
+    int res;
+    AES_KEY aeskey;
+
+    res = aes_set_decrypt_key((unsigned char *)context->context,
+                              AES_KEY_SIZE * 8, &aeskey);
+    if (res < 0) {
+        return res;
+    }
+
+    for (size_t i = 0; i < blocks; i++) {
+        aes_decrypt_block(&aeskey, input, output);
+        input += AES_BLOCK_SIZE;
+        output += AES_BLOCK_SIZE;
+    }
+    return 1;
+}
+
 #endif /* AES_ASM */
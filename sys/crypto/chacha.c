@@ -40,6 +40,64 @@
 
 #include <string.h>
 
+#ifdef MODULE_CRYPTO_CHACHA_UNROLL
+
+#define ROTL32(v, c)    (((v) << (c)) | ((v) >> (32 - (c))))
+
+#define QUARTERROUND(a, b, c, d) \
+    do { \
+        a += b; d = ROTL32(d ^ a, 16); \
+        c += d; b = ROTL32(b ^ c, 12); \
+        a += b; d = ROTL32(d ^ a,  8); \
+        c += d; b = ROTL32(b ^ c,  7); \
+    } while (0)
+
+static void _doubleround(void *output_, const uint32_t input[16],
+                         uint8_t rounds)
+{
+    uint32_t *output = (uint32_t *)output_;
+
+    /* the state is kept in locals, so the compiler can hold most of it in
+     * registers instead of going through memory for every step */
+    uint32_t x0 = input[0], x1 = input[1], x2 = input[2], x3 = input[3];
+    uint32_t x4 = input[4], x5 = input[5], x6 = input[6], x7 = input[7];
+    uint32_t x8 = input[8], x9 = input[9], x10 = input[10], x11 = input[11];
+    uint32_t x12 = input[12], x13 = input[13], x14 = input[14];
+    uint32_t x15 = input[15];
+
+    for (unsigned i = 0; i < rounds; i += 2) {
+        /* column round */
+        QUARTERROUND(x0, x4,  x8, x12);
+        QUARTERROUND(x1, x5,  x9, x13);
+        QUARTERROUND(x2, x6, x10, x14);
+        QUARTERROUND(x3, x7, x11, x15);
+        /* diagonal round */
+        QUARTERROUND(x0, x5, x10, x15);
+        QUARTERROUND(x1, x6, x11, x12);
+        QUARTERROUND(x2, x7,  x8, x13);
+        QUARTERROUND(x3, x4,  x9, x14);
+    }
+
+    output[0] = x0 + input[0];
+    output[1] = x1 + input[1];
+    output[2] = x2 + input[2];
+    output[3] = x3 + input[3];
+    output[4] = x4 + input[4];
+    output[5] = x5 + input[5];
+    output[6] = x6 + input[6];
+    output[7] = x7 + input[7];
+    output[8] = x8 + input[8];
+    output[9] = x9 + input[9];
+    output[10] = x10 + input[10];
+    output[11] = x11 + input[11];
+    output[12] = x12 + input[12];
+    output[13] = x13 + input[13];
+    output[14] = x14 + input[14];
+    output[15] = x15 + input[15];
+}
+
+#else /* !MODULE_CRYPTO_CHACHA_UNROLL */
+
 static void _r(uint32_t *d, uint32_t *a, const uint32_t *b, unsigned c)
 {
     *a += *b;
@@ -74,6 +132,8 @@ static void _doubleround(void *output_, const uint32_t input[16],
     }
 }
 
+#endif /* ?MODULE_CRYPTO_CHACHA_UNROLL */
+
 int chacha_init(chacha_ctx *ctx,
                 unsigned rounds,
                 const uint8_t *key, uint32_t keylen,
@@ -117,10 +177,15 @@ void chacha_keystream_bytes(chacha_ctx *ctx, void *x)
 
 void chacha_encrypt_bytes(chacha_ctx *ctx, const uint8_t *m, uint8_t *c)
 {
-    uint8_t x[64];
+    uint32_t x[16];
 
     chacha_keystream_bytes(ctx, x);
-    for (unsigned i = 0; i < 64; ++i) {
-        c[i] = m[i] ^ x[i];
+    /* word wise, memcpy() becomes a single load or store where the CPU
+     * supports unaligned access */
+    for (unsigned i = 0; i < 16; ++i) {
+        uint32_t tmp;
+        memcpy(&tmp, &m[4 * i], sizeof(tmp));
+        tmp ^= x[i];
+        memcpy(&c[4 * i], &tmp, sizeof(tmp));
     }
 }
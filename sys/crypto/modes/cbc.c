@@ -19,15 +19,14 @@
  */
 
 
-#include <string.h>
 #include "crypto/modes/cbc.h"
 
 int cipher_encrypt_cbc(cipher_t *cipher, uint8_t iv[16],
                        const uint8_t *input, size_t length, uint8_t *output)
 {
     size_t offset = 0;
-    uint8_t block_size, input_block[CIPHER_MAX_BLOCK_SIZE] = { 0 },
-            *output_block_last;
+    uint8_t block_size;
+    const uint8_t *output_block_last;
 
     block_size = cipher_get_block_size(cipher);
     if (length % block_size != 0) {
@@ -36,17 +35,18 @@ int cipher_encrypt_cbc(cipher_t *cipher, uint8_t iv[16],
 
     output_block_last = iv;
     do {
+        uint8_t *output_block = output + offset;
+
         /* CBC-Mode: XOR plaintext with ciphertext of (n-1)-th block */
-        memcpy(input_block, input + offset, block_size);
         for (int i = 0; i < block_size; ++i) {
-            input_block[i] ^= output_block_last[i];
+            output_block[i] = input[offset + i] ^ output_block_last[i];
         }
 
-        if (cipher_encrypt(cipher, input_block, output + offset) != 1) {
+        if (cipher_encrypt(cipher, output_block, output_block) != 1) {
             return CIPHER_ERR_ENC_FAILED;
         }
 
-        output_block_last = output + offset;
+        output_block_last = output_block;
         offset += block_size;
     } while (offset < length);
 
@@ -67,6 +67,20 @@ int cipher_decrypt_cbc(cipher_t *cipher, uint8_t iv[16],
         return CIPHER_ERR_INVALID_LENGTH;
     }
 
+    /* the blocks can be decrypted independently, as long as decrypting does
+     * not overwrite ciphertext that is still needed for the XOR */
+    if (length && cipher->interface->decrypt_blocks &&
+        ((output + length <= input) || (input + length <= output))) {
+        if (cipher_decrypt_blocks(cipher, input, output,
+                                  length / block_size) != 1) {
+            return CIPHER_ERR_DEC_FAILED;
+        }
+        for (size_t i = 0; i < length; ++i) {
+            output[i] ^= (i < block_size) ? iv[i] : input[i - block_size];
+        }
+        return length;
+    }
+
     input_block_last = iv;
     do {
         input_block = input + offset;
@@ -18,6 +18,7 @@
  * @}
  */
 
+#include <stdbool.h>
 #include <string.h>
 #include "debug.h"
 #include "crypto/helper.h"
@@ -162,6 +163,84 @@ static int ccm_compute_adata_mac(cipher_t *cipher, const uint8_t *auth_data,
 }
 
 
+/* Encrypt or decrypt the payload in counter mode and update the CBC-MAC over
+ * the plaintext in the same pass. The counter block and the MAC block are
+ * passed to the cipher together, so a multi-block capable cipher processes
+ * both with a single call. */
+static int ccm_crypt_and_mac(cipher_t *cipher, uint8_t nonce_counter[16],
+                             uint8_t ctr_len, const uint8_t *input,
+                             size_t length, uint8_t *output, uint8_t mac[16],
+                             bool encrypt)
+{
+    /* key stream block followed by the MAC block */
+    uint8_t blocks[2 * CCM_BLOCK_SIZE];
+    uint8_t *stream = blocks, *mac_block = blocks + CCM_BLOCK_SIZE;
+    bool mac_pending = false;
+    size_t offset = 0;
+
+    memcpy(mac_block, mac, CCM_BLOCK_SIZE);
+
+    while (offset < length) {
+        size_t n = min(length - offset, CCM_BLOCK_SIZE);
+
+        memcpy(stream, nonce_counter, CCM_BLOCK_SIZE);
+        crypto_block_inc_ctr(nonce_counter, ctr_len);
+
+        if (encrypt) {
+            /* the plaintext is known, MAC it along with this block */
+            for (size_t i = 0; i < n; ++i) {
+                mac_block[i] ^= input[offset + i];
+            }
+            mac_pending = true;
+        }
+
+        /* when decrypting, the MAC of the previous block is pending */
+        if (cipher_encrypt_blocks(cipher, blocks, blocks,
+                                  mac_pending ? 2 : 1) != 1) {
+            return CIPHER_ERR_ENC_FAILED;
+        }
+        mac_pending = false;
+
+        for (size_t i = 0; i < n; ++i) {
+            output[offset + i] = input[offset + i] ^ stream[i];
+        }
+
+        if (!encrypt) {
+            for (size_t i = 0; i < n; ++i) {
+                mac_block[i] ^= output[offset + i];
+            }
+            mac_pending = true;
+        }
+
+        offset += n;
+    }
+
+    if (mac_pending &&
+        cipher_encrypt_blocks(cipher, mac_block, mac_block, 1) != 1) {
+        return CIPHER_ERR_ENC_FAILED;
+    }
+
+    memcpy(mac, mac_block, CCM_BLOCK_SIZE);
+    return offset;
+}
+
+/* Compute the key stream block A_0 used for the authentication value */
+static int ccm_first_stream_block(cipher_t *cipher, uint8_t length_encoding,
+                                  const uint8_t *nonce, size_t nonce_len,
+                                  uint8_t nonce_counter[16],
+                                  uint8_t stream_block[16])
+{
+    nonce_counter[0] = length_encoding - 1;
+    memcpy(&nonce_counter[1], nonce,
+           min(nonce_len, (size_t)15 - length_encoding));
+
+    if (cipher_encrypt_blocks(cipher, nonce_counter, stream_block, 1) != 1) {
+        return CIPHER_ERR_ENC_FAILED;
+    }
+    return 0;
+}
+
+
 /* Check if 'value' can be stored in 'num_bytes' */
 static inline int _fits_in_nbytes(size_t value, uint8_t num_bytes)
 {
@@ -183,7 +262,7 @@ int cipher_encrypt_ccm(cipher_t *cipher,
 {
     int len = -1;
     uint8_t nonce_counter[16] = { 0 }, mac_iv[16] = { 0 }, mac[16] = { 0 },
-            stream_block[16] = { 0 }, zero_block[16] = { 0 }, block_size;
+            stream_block[16] = { 0 }, block_size;
 
     if (mac_length % 2 != 0  || mac_length < 4 || mac_length > 16) {
         return CCM_ERR_INVALID_MAC_LENGTH;
@@ -208,25 +287,18 @@ int cipher_encrypt_ccm(cipher_t *cipher,
         return len;
     }
 
-    len = ccm_compute_cbc_mac(cipher, mac_iv, input, input_len, mac);
-    if (len < 0) {
-        return len;
-    }
-
     /* Compute first stream block */
-    nonce_counter[0] = length_encoding - 1;
-    memcpy(&nonce_counter[1], nonce,
-           min(nonce_len, (size_t)15 - length_encoding));
-    len = cipher_encrypt_ctr(cipher, nonce_counter, block_size,
-                             zero_block, block_size, stream_block);
+    len = ccm_first_stream_block(cipher, length_encoding, nonce, nonce_len,
+                                 nonce_counter, stream_block);
     if (len < 0) {
         return len;
     }
 
-    /* Encrypt message in counter mode  */
+    /* Encrypt message in counter mode and compute its MAC */
     crypto_block_inc_ctr(nonce_counter, block_size - nonce_len);
-    len = cipher_encrypt_ctr(cipher, nonce_counter, nonce_len, input,
-                             input_len, output);
+    memcpy(mac, mac_iv, CCM_BLOCK_SIZE);
+    len = ccm_crypt_and_mac(cipher, nonce_counter, block_size - nonce_len,
+                            input, input_len, output, mac, true);
     if (len < 0) {
         return len;
     }
@@ -249,9 +321,7 @@ int cipher_decrypt_ccm(cipher_t *cipher,
 {
     int len = -1;
     uint8_t nonce_counter[16] = { 0 }, mac_iv[16] = { 0 }, mac[16] = { 0 },
-            mac_recv[16] = { 0 }, stream_block[16] = { 0 },
-            zero_block[16] = { 0 },
-            block_size;
+            mac_recv[16] = { 0 }, stream_block[16] = { 0 }, block_size;
     size_t plain_len;
 
     if (mac_length % 2 != 0  || mac_length < 4 || mac_length > 16) {
@@ -263,39 +333,33 @@ int cipher_decrypt_ccm(cipher_t *cipher,
         return CCM_ERR_INVALID_LENGTH_ENCODING;
     }
 
-    /* Compute first stream block */
-    nonce_counter[0] = length_encoding - 1;
+    /* Create B0, encrypt it (X1) and use it as mac_iv */
     block_size = cipher_get_block_size(cipher);
     assert(block_size == CCM_BLOCK_SIZE);
-    memcpy(&nonce_counter[1], nonce, min(nonce_len,
-                                         (size_t)15 - length_encoding));
-    len = cipher_encrypt_ctr(cipher, nonce_counter, block_size, zero_block,
-                             block_size, stream_block);
-    if (len < 0) {
-        return len;
-    }
-
-    /* Decrypt message in counter mode */
     plain_len = input_len - mac_length;
-    crypto_block_inc_ctr(nonce_counter, block_size - nonce_len);
-    len = cipher_encrypt_ctr(cipher, nonce_counter, nonce_len, input,
-                             plain_len, plain);
-    if (len < 0) {
-        return len;
-    }
-
-    /* Create B0, encrypt it (X1) and use it as mac_iv */
     if (ccm_create_mac_iv(cipher, auth_data_len, mac_length, length_encoding,
                           nonce, nonce_len, plain_len, mac_iv) < 0) {
         return CCM_ERR_INVALID_DATA_LENGTH;
     }
 
-    /* MAC calculation (T) with additional data and plaintext */
+    /* MAC calculation (T) with additional data */
     len = ccm_compute_adata_mac(cipher, auth_data, auth_data_len, mac_iv);
     if (len < 0) {
         return len;
     }
-    len = ccm_compute_cbc_mac(cipher, mac_iv, plain, plain_len, mac);
+
+    /* Compute first stream block */
+    len = ccm_first_stream_block(cipher, length_encoding, nonce, nonce_len,
+                                 nonce_counter, stream_block);
+    if (len < 0) {
+        return len;
+    }
+
+    /* Decrypt message in counter mode and compute the MAC of the plaintext */
+    crypto_block_inc_ctr(nonce_counter, block_size - nonce_len);
+    memcpy(mac, mac_iv, CCM_BLOCK_SIZE);
+    len = ccm_crypt_and_mac(cipher, nonce_counter, block_size - nonce_len,
+                            input, plain_len, plain, mac, false);
     if (len < 0) {
         return len;
     }
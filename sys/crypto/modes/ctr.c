@@ -18,32 +18,45 @@
  * @}
  */
 
+#include <string.h>
+
 #include "crypto/helper.h"
 #include "crypto/modes/ctr.h"
 
+/* number of key stream blocks generated per cipher call */
+#define CTR_BATCH_BLOCKS    (4)
+
 int cipher_encrypt_ctr(cipher_t *cipher, uint8_t nonce_counter[16],
                        uint8_t nonce_len, const uint8_t *input, size_t length,
                        uint8_t *output)
 {
     size_t offset = 0;
-    uint8_t stream_block[16] = { 0 }, block_size;
+    uint8_t stream[CTR_BATCH_BLOCKS * CIPHER_MAX_BLOCK_SIZE], block_size;
 
     block_size = cipher_get_block_size(cipher);
     do {
-        uint8_t block_size_input;
+        /* generate the key stream for several blocks at once */
+        unsigned blocks = 0;
+        do {
+            memcpy(stream + blocks * block_size, nonce_counter, block_size);
+            crypto_block_inc_ctr(nonce_counter, block_size - nonce_len);
+            blocks++;
+        } while ((blocks < CTR_BATCH_BLOCKS) &&
+                 (blocks * block_size < length - offset));
 
-        if (cipher_encrypt(cipher, nonce_counter, stream_block) != 1) {
+        if (cipher_encrypt_blocks(cipher, stream, stream, blocks) != 1) {
             return CIPHER_ERR_ENC_FAILED;
         }
 
-        block_size_input = (length - offset > block_size) ?
-                           block_size : length - offset;
-        for (uint8_t i = 0; i < block_size_input; ++i) {
-            output[offset + i] = stream_block[i] ^ input[offset + i];
+        size_t stream_len = blocks * block_size;
+        if (stream_len > length - offset) {
+            stream_len = length - offset;
+        }
+        for (size_t i = 0; i < stream_len; ++i) {
+            output[offset + i] = stream[i] ^ input[offset + i];
         }
 
-        offset += block_size_input;
-        crypto_block_inc_ctr(nonce_counter, block_size - nonce_len);
+        offset += stream_len;
     } while (offset < length);
 
     return offset;
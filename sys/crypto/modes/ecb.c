@@ -34,6 +34,14 @@ int cipher_encrypt_ecb(cipher_t *cipher, uint8_t *input,
         return CIPHER_ERR_INVALID_LENGTH;
     }
 
+    if (cipher->interface->encrypt_blocks) {
+        if (cipher_encrypt_blocks(cipher, input, output,
+                                  length / block_size) != 1) {
+            return CIPHER_ERR_ENC_FAILED;
+        }
+        return length;
+    }
+
     offset = 0;
     do {
         if (cipher_encrypt(cipher, input + offset, output + offset) != 1) {
@@ -57,6 +65,14 @@ int cipher_decrypt_ecb(cipher_t *cipher, uint8_t *input,
         return CIPHER_ERR_INVALID_LENGTH;
     }
 
+    if (cipher->interface->decrypt_blocks) {
+        if (cipher_decrypt_blocks(cipher, input, output,
+                                  length / block_size) != 1) {
+            return CIPHER_ERR_DEC_FAILED;
+        }
+        return length;
+    }
+
     do {
         if (cipher_decrypt(cipher, input + offset, output + offset) != 1) {
             return CIPHER_ERR_DEC_FAILED;
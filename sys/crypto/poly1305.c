@@ -103,13 +103,32 @@ static void _take_input(poly1305_ctx_t *ctx, uint8_t input)
 
 void poly1305_update(poly1305_ctx_t *ctx, const uint8_t *data, size_t len)
 {
-    for (size_t i = 0; i < len; i++) {
+    size_t i = 0;
+
+    /* complete a partial block first */
+    for (; (i < len) && ctx->c_idx; i++) {
         _take_input(ctx, data[i]);
         if (ctx->c_idx == 16) {
             poly1305_block(ctx, 1);
             _clear_c(ctx);
         }
     }
+
+    /* whole blocks are loaded word wise */
+    if (len - i >= 16) {
+        for (; len - i >= 16; i += 16) {
+            ctx->c[0] = u8to32(&data[i]);
+            ctx->c[1] = u8to32(&data[i + 4]);
+            ctx->c[2] = u8to32(&data[i + 8]);
+            ctx->c[3] = u8to32(&data[i + 12]);
+            poly1305_block(ctx, 1);
+        }
+        _clear_c(ctx);
+    }
+
+    for (; i < len; i++) {
+        _take_input(ctx, data[i]);
+    }
 }
 
 void poly1305_init(poly1305_ctx_t *ctx, const uint8_t *key)
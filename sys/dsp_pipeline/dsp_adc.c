@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_dsp_pipeline
+ * @{
+ *
+ * @file
+ * @brief       DSP pipeline source sampling an ADC line continuously
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <errno.h>
+
+#include "dsp_pipeline.h"
+#include "irq.h"
+
+static int _bits(adc_res_t res)
+{
+    switch (res) {
+    case ADC_RES_6BIT:
+        return 6;
+    case ADC_RES_8BIT:
+        return 8;
+    case ADC_RES_10BIT:
+        return 10;
+    case ADC_RES_12BIT:
+        return 12;
+    case ADC_RES_14BIT:
+        return 14;
+    case ADC_RES_16BIT:
+        return 16;
+    default:
+        return -EINVAL;
+    }
+}
+
+static void _release(dsp_block_t *block)
+{
+    dsp_adc_t *src = block->arg;
+    unsigned state = irq_disable();
+
+    src->busy &= ~(1U << (block - src->half));
+    irq_restore(state);
+}
+
+static void _isr_cb(void *arg, const uint16_t *samples, size_t numof)
+{
+    dsp_adc_t *src = arg;
+    unsigned half = (samples != src->buf);
+
+    (void)numof;
+
+    /* the pipeline did not keep up, the DMA overwrote the samples */
+    if ((src->busy | src->pending) & (1U << half)) {
+        src->super.stats.drops++;
+        return;
+    }
+    src->pending |= 1U << half;
+    src->last = half;
+    event_post(src->super.pipeline->queue, &src->super.super);
+}
+
+static void _handler(event_t *ev)
+{
+    dsp_adc_t *src = container_of(ev, dsp_adc_t, super.super);
+
+    while (src->pending) {
+        unsigned state = irq_disable();
+        /* with both halves pending, the one not filled last is older */
+        unsigned half = (src->pending == 3) ? !src->last : src->pending >> 1;
+        src->pending &= ~(1U << half);
+        src->busy |= 1U << half;
+        irq_restore(state);
+
+        dsp_block_t *block = &src->half[half];
+        uint16_t *raw = (uint16_t *)block->data;
+
+        /* in place stages may have shortened the block */
+        block->len = src->super.pipeline->block_size;
+        /* unsigned samples to signed 16 bit fractions, in place */
+        for (unsigned i = 0; i < block->len; i++) {
+            block->data[i] = (q15_t)((uint16_t)(raw[i] << src->shift) ^
+                                     0x8000U);
+        }
+        src->super.stats.blocks++;
+        if (src->super.next) {
+            dsp_stage_push(src->super.next, block);
+        }
+        else {
+            _release(block);
+        }
+    }
+}
+
+void dsp_adc_init(dsp_adc_t *src, dsp_pipeline_t *pipe)
+{
+    dsp_stage_init(&src->super, pipe, "adc", NULL, true);
+    src->super.super.handler = _handler;
+}
+
+int dsp_adc_start(dsp_adc_t *src, adc_t line, adc_res_t res, uint32_t freq,
+                  uint16_t *buf, size_t len)
+{
+    int bits = _bits(res);
+
+    if ((bits < 0) || (len != 2U * src->super.pipeline->block_size)) {
+        return -EINVAL;
+    }
+
+    src->buf = buf;
+    src->shift = 16 - bits;
+    src->pending = 0;
+    src->busy = 0;
+    for (unsigned i = 0; i < 2; i++) {
+        src->half[i] = (dsp_block_t){
+            .data = (q15_t *)&buf[i * (len / 2)],
+            .len = len / 2,
+            .release = _release,
+            .arg = src,
+        };
+    }
+
+    if (adc_continuous_start(&line, 1, res, freq, buf, len, _isr_cb,
+                             src) < 0) {
+        return -EINVAL;
+    }
+    return 0;
+}
+
+void dsp_adc_stop(dsp_adc_t *src)
+{
+    (void)src;
+
+    adc_continuous_stop();
+}
@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_dsp_pipeline
+ * @{
+ *
+ * @file
+ * @brief       DSP pipeline block queues and scheduling
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "dsp_pipeline.h"
+#include "irq.h"
+
+static bool _clock_ready;
+
+void dsp_pipeline_init(dsp_pipeline_t *pipe, event_queue_t *queue,
+                       dsp_block_t *blocks, unsigned numof, q15_t *samples,
+                       uint16_t block_size)
+{
+    pipe->queue = queue;
+    pipe->free = NULL;
+    pipe->stages = NULL;
+    pipe->block_size = block_size;
+
+    for (unsigned i = 0; i < numof; i++) {
+        blocks[i].data = &samples[i * block_size];
+        blocks[i].release = NULL;
+        blocks[i].next = pipe->free;
+        pipe->free = &blocks[i];
+    }
+
+    if (!_clock_ready) {
+        _clock_ready = true;
+        benchmark_clock_init();
+    }
+}
+
+void dsp_pipeline_print(const dsp_pipeline_t *pipe)
+{
+    printf("%-10s %10s %10s %10s %10s (" BENCHMARK_UNIT ")\n",
+           "stage", "blocks", "drops", "avg", "max");
+    for (const dsp_stage_t *s = pipe->stages; s; s = s->list) {
+        uint32_t avg = s->stats.blocks ? s->stats.time / s->stats.blocks : 0;
+
+        printf("%-10s %10" PRIu32 " %10" PRIu32 " %10" PRIu32 " %10" PRIu32
+               "\n", s->name, s->stats.blocks, s->stats.drops, avg,
+               s->stats.max);
+    }
+}
+
+dsp_block_t *dsp_block_alloc(dsp_pipeline_t *pipe)
+{
+    unsigned state = irq_disable();
+    dsp_block_t *block = pipe->free;
+
+    if (block) {
+        pipe->free = block->next;
+        block->next = NULL;
+        block->len = pipe->block_size;
+    }
+    irq_restore(state);
+    return block;
+}
+
+void dsp_block_release(dsp_pipeline_t *pipe, dsp_block_t *block)
+{
+    if (block->release) {
+        block->release(block);
+        return;
+    }
+
+    unsigned state = irq_disable();
+    block->next = pipe->free;
+    pipe->free = block;
+    irq_restore(state);
+}
+
+static dsp_block_t *_pop(dsp_stage_t *stage)
+{
+    unsigned state = irq_disable();
+    dsp_block_t *block = stage->head;
+
+    if (block) {
+        stage->head = block->next;
+        if (stage->head == NULL) {
+            stage->tail = NULL;
+        }
+        block->next = NULL;
+    }
+    irq_restore(state);
+    return block;
+}
+
+static void _handler(event_t *ev)
+{
+    dsp_stage_t *stage = container_of(ev, dsp_stage_t, super);
+    dsp_pipeline_t *pipe = stage->pipeline;
+    dsp_block_t *in = _pop(stage);
+
+    if (in == NULL) {
+        return;
+    }
+    /* one block per event, so other events on the queue are not starved */
+    if (stage->head) {
+        event_post(pipe->queue, &stage->super);
+    }
+
+    dsp_block_t *out = stage->in_place ? in : dsp_block_alloc(pipe);
+    if (out == NULL) {
+        stage->stats.drops++;
+        dsp_block_release(pipe, in);
+        return;
+    }
+
+    uint32_t start = benchmark_now();
+    int res = stage->process(stage, in, out);
+    uint32_t time = benchmark_elapsed(start);
+
+    stage->stats.blocks++;
+    stage->stats.time += time;
+    if (time > stage->stats.max) {
+        stage->stats.max = time;
+    }
+
+    if (out != in) {
+        dsp_block_release(pipe, in);
+    }
+    if (res < 0) {
+        stage->stats.drops++;
+    }
+    if ((res > 0) && stage->next) {
+        out->len = res;
+        dsp_stage_push(stage->next, out);
+    }
+    else {
+        dsp_block_release(pipe, out);
+    }
+}
+
+void dsp_stage_init(dsp_stage_t *stage, dsp_pipeline_t *pipe,
+                    const char *name, dsp_process_t process, bool in_place)
+{
+    *stage = (dsp_stage_t){
+        .super.handler = _handler,
+        .pipeline = pipe,
+        .process = process,
+        .name = name,
+        .in_place = in_place,
+    };
+
+    /* append to print the stages in the order they were created */
+    dsp_stage_t **prev = &pipe->stages;
+    while (*prev) {
+        prev = &(*prev)->list;
+    }
+    *prev = stage;
+}
+
+void dsp_stage_push(dsp_stage_t *stage, dsp_block_t *block)
+{
+    unsigned state = irq_disable();
+
+    block->next = NULL;
+    if (stage->tail) {
+        stage->tail->next = block;
+    }
+    else {
+        stage->head = block;
+    }
+    stage->tail = block;
+    irq_restore(state);
+
+    event_post(stage->pipeline->queue, &stage->super);
+}
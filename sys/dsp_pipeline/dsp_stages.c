@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_dsp_pipeline
+ * @{
+ *
+ * @file
+ * @brief       DSP pipeline stages based on CMSIS-DSP
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <errno.h>
+
+#include "dsp_pipeline.h"
+
+static int _fir(dsp_stage_t *stage, dsp_block_t *in, dsp_block_t *out)
+{
+    dsp_fir_t *fir = container_of(stage, dsp_fir_t, super);
+
+    arm_fir_q15(&fir->fir, in->data, out->data, in->len);
+    return in->len;
+}
+
+int dsp_fir_init(dsp_fir_t *stage, dsp_pipeline_t *pipe, const q15_t *coeffs,
+                 uint16_t num_taps, q15_t *state)
+{
+    dsp_stage_init(&stage->super, pipe, "fir", _fir, false);
+    if (arm_fir_init_q15(&stage->fir, num_taps, (q15_t *)coeffs, state,
+                         pipe->block_size) != ARM_MATH_SUCCESS) {
+        return -EINVAL;
+    }
+    return 0;
+}
+
+static int _decimate(dsp_stage_t *stage, dsp_block_t *in, dsp_block_t *out)
+{
+    dsp_decimate_t *dec = container_of(stage, dsp_decimate_t, super);
+
+    if (in->len % dec->fir.M) {
+        return -EINVAL;
+    }
+    arm_fir_decimate_q15(&dec->fir, in->data, out->data, in->len);
+    return in->len / dec->fir.M;
+}
+
+int dsp_decimate_init(dsp_decimate_t *stage, dsp_pipeline_t *pipe,
+                      uint8_t factor, const q15_t *coeffs, uint16_t num_taps,
+                      q15_t *state)
+{
+    dsp_stage_init(&stage->super, pipe, "decimate", _decimate, false);
+    if (arm_fir_decimate_init_q15(&stage->fir, num_taps, factor,
+                                  (q15_t *)coeffs, state, pipe->block_size)
+        != ARM_MATH_SUCCESS) {
+        return -EINVAL;
+    }
+    return 0;
+}
+
+static int _iir(dsp_stage_t *stage, dsp_block_t *in, dsp_block_t *out)
+{
+    dsp_iir_t *iir = container_of(stage, dsp_iir_t, super);
+
+    /* direct form I reads each input sample before writing its output */
+    arm_biquad_cascade_df1_q15(&iir->iir, in->data, out->data, in->len);
+    return in->len;
+}
+
+void dsp_iir_init(dsp_iir_t *stage, dsp_pipeline_t *pipe, uint8_t num_stages,
+                  const q15_t *coeffs, q15_t *state, int8_t post_shift)
+{
+    dsp_stage_init(&stage->super, pipe, "iir", _iir, true);
+    arm_biquad_cascade_df1_init_q15(&stage->iir, num_stages, (q15_t *)coeffs,
+                                    state, post_shift);
+}
+
+static int _fft(dsp_stage_t *stage, dsp_block_t *in, dsp_block_t *out)
+{
+    dsp_fft_t *fft = container_of(stage, dsp_fft_t, super);
+
+    if (in->len != fft->len) {
+        return -EINVAL;
+    }
+    /* arm_rfft_q15() uses the input as work area and writes the complex
+     * spectrum to the scratch buffer, the magnitudes go back in place */
+    arm_rfft_q15(&fft->fft, in->data, fft->scratch);
+    arm_cmplx_mag_q15(fft->scratch, out->data, fft->len / 2);
+    return fft->len / 2;
+}
+
+int dsp_fft_init(dsp_fft_t *stage, dsp_pipeline_t *pipe, uint16_t len,
+                 q15_t *scratch)
+{
+    dsp_stage_init(&stage->super, pipe, "fft", _fft, true);
+    stage->scratch = scratch;
+    stage->len = len;
+    if (arm_rfft_init_q15(&stage->fft, len, 0, 1) != ARM_MATH_SUCCESS) {
+        return -EINVAL;
+    }
+    return 0;
+}
+
+static int _rms(dsp_stage_t *stage, dsp_block_t *in, dsp_block_t *out)
+{
+    (void)stage;
+
+    arm_rms_q15(in->data, in->len, &out->data[0]);
+    return 1;
+}
+
+void dsp_rms_init(dsp_rms_t *stage, dsp_pipeline_t *pipe)
+{
+    dsp_stage_init(&stage->super, pipe, "rms", _rms, true);
+}
+
+static int _sink(dsp_stage_t *stage, dsp_block_t *in, dsp_block_t *out)
+{
+    dsp_sink_t *sink = container_of(stage, dsp_sink_t, super);
+
+    (void)out;
+
+    sink->cb(sink->arg, in->data, in->len);
+    return 0;
+}
+
+void dsp_sink_init(dsp_sink_t *stage, dsp_pipeline_t *pipe, dsp_sink_cb_t cb,
+                   void *arg)
+{
+    dsp_stage_init(&stage->super, pipe, "sink", _sink, true);
+    stage->cb = cb;
+    stage->arg = arg;
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_energy
+ * @{
+ *
+ * @file
+ * @brief       Energy accounting implementation
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <assert.h>
+
+#include "energy.h"
+#include "irq.h"
+#include "ztimer.h"
+
+#if defined(MODULE_PM_LAYERED) || defined(MODULE_GNRC_NETIF) || \
+    defined(MODULE_MTD)
+#include "board.h"
+#endif
+#ifdef MODULE_PM_LAYERED
+#include "periph_cpu.h"
+#endif
+#ifdef MODULE_GNRC_NETIF
+#include "net/netopt.h"
+#endif
+
+/* µA * ms in 1 µAh */
+#define UAMS_PER_UAH    (3600UL * 1000UL)
+
+const metrics_entry_t energy_metrics_entries[2] = {
+    METRICS_ENTRY(METRICS_U32, "uah", energy_stats_t, charge_uah),
+    METRICS_ENTRY(METRICS_HISTOGRAM, "time_ms", energy_stats_t, time_ms),
+};
+
+#ifdef MODULE_PM_LAYERED
+#ifdef ENERGY_CPU_CURRENT_UA
+static const uint32_t _cpu_ua[] = ENERGY_CPU_CURRENT_UA;
+#define _CPU_UA _cpu_ua
+#else
+#define _CPU_UA NULL
+#endif
+energy_domain_t energy_cpu = ENERGY_DOMAIN_INIT(energy_cpu, "energy_cpu",
+                                                _CPU_UA, PM_NUM_MODES + 1);
+#endif
+
+#ifdef MODULE_GNRC_NETIF
+#ifdef ENERGY_RADIO_CURRENT_UA
+static const uint32_t _radio_ua[] = ENERGY_RADIO_CURRENT_UA;
+#define _RADIO_UA _radio_ua
+#else
+#define _RADIO_UA NULL
+#endif
+energy_domain_t energy_radio = ENERGY_DOMAIN_INIT(energy_radio, "energy_radio",
+                                                  _RADIO_UA, NETOPT_STATE_IDLE);
+#endif
+
+#ifdef MODULE_MTD
+#ifdef ENERGY_MTD_CURRENT_UA
+static const uint32_t _mtd_ua[] = ENERGY_MTD_CURRENT_UA;
+#define _MTD_UA _mtd_ua
+#else
+#define _MTD_UA NULL
+#endif
+energy_domain_t energy_mtd = ENERGY_DOMAIN_INIT(energy_mtd, "energy_mtd",
+                                                _MTD_UA, 0);
+#endif
+
+static void _update(energy_domain_t *dom)
+{
+    uint32_t now = ztimer_now(ZTIMER_MSEC);
+    uint32_t diff = now - dom->since;
+
+    dom->since = now;
+    dom->stats.time_ms[dom->state] += diff;
+    if (dom->current_ua) {
+        uint64_t uams = (uint64_t)diff * dom->current_ua[dom->state] + dom->rest;
+
+        dom->stats.charge_uah += uams / UAMS_PER_UAH;
+        dom->rest = uams % UAMS_PER_UAH;
+    }
+}
+
+void energy_set_state(energy_domain_t *dom, unsigned state)
+{
+    assert(state < CONFIG_ENERGY_STATES_NUMOF);
+
+    unsigned irq = irq_disable();
+    _update(dom);
+    dom->state = state;
+    irq_restore(irq);
+}
+
+void energy_update(energy_domain_t *dom)
+{
+    unsigned irq = irq_disable();
+    _update(dom);
+    irq_restore(irq);
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_event
+ * @{
+ *
+ * @file
+ * @brief       Deferred work item implementation
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "event/deferred.h"
+#include "irq.h"
+#include "ztimer.h"
+
+static void _run(event_t *event)
+{
+    event_deferred_t *work = container_of(event, event_deferred_t, super);
+    uint32_t start = ztimer_now(ZTIMER_USEC);
+
+    /* posts from here on need another run */
+    unsigned state = irq_disable();
+    uint32_t latency = start - work->posted;
+    work->pending = false;
+    irq_restore(state);
+
+    work->stats.runs++;
+    if (work->deadline && (latency > work->deadline)) {
+        work->stats.misses++;
+    }
+    if (latency > work->stats.latency_max) {
+        work->stats.latency_max = latency;
+    }
+
+    work->handler(work);
+
+    uint32_t exec = ztimer_now(ZTIMER_USEC) - start;
+    if (exec > work->stats.exec_max) {
+        work->stats.exec_max = exec;
+    }
+    work->stats.exec_total += exec;
+}
+
+void event_deferred_init(event_deferred_t *work, event_queue_t *queue,
+                         event_deferred_handler_t handler, uint32_t deadline)
+{
+    assert(work && queue && handler);
+    memset(work, 0, sizeof(*work));
+    work->super.handler = _run;
+    work->queue = queue;
+    work->handler = handler;
+    work->deadline = deadline;
+}
+
+void event_deferred_post(event_deferred_t *work)
+{
+    unsigned state = irq_disable();
+
+    if (work->pending) {
+        work->stats.coalesced++;
+        irq_restore(state);
+        return;
+    }
+    work->pending = true;
+    work->posted = ztimer_now(ZTIMER_USEC);
+    irq_restore(state);
+
+    event_post(work->queue, &work->super);
+}
+
+void event_deferred_cancel(event_deferred_t *work)
+{
+    unsigned state = irq_disable();
+
+    event_cancel(work->queue, &work->super);
+    work->pending = false;
+    irq_restore(state);
+}
+
+void event_deferred_stats_reset(event_deferred_t *work)
+{
+    unsigned state = irq_disable();
+
+    memset(&work->stats, 0, sizeof(work->stats));
+    irq_restore(state);
+}
@@ -27,12 +27,119 @@
 
 #include "event.h"
 #include "clist.h"
+#include "kernel_defines.h"
 #include "thread.h"
 
 #ifdef MODULE_XTIMER
 #include "xtimer.h"
 #endif
 
+#if IS_USED(MODULE_EVENT_LOCKFREE)
+/* terminates event_queue_t::pending, so that list_node.next of any queued
+ * event is non-NULL */
+static clist_node_t _pending_end;
+
+static void _push(event_queue_t *queue, event_t *event)
+{
+    clist_node_t *expected = NULL;
+
+    /* claim the event first, so that concurrent posts of the same event do
+     * not queue it twice */
+    if (!__atomic_compare_exchange_n(&event->list_node.next, &expected,
+                                     &_pending_end, false, __ATOMIC_ACQUIRE,
+                                     __ATOMIC_RELAXED)) {
+        return;
+    }
+
+    clist_node_t *head = __atomic_load_n(&queue->pending, __ATOMIC_RELAXED);
+    do {
+        event->list_node.next = head ? head : &_pending_end;
+    } while (!__atomic_compare_exchange_n(&queue->pending, &head,
+                                          &event->list_node, true,
+                                          __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
+
+/* moves all pending events to the end of event_list, oldest first
+ *
+ * This runs with interrupts disabled, so that event_cancel() never sees
+ * events neither pending nor in event_list. That critical section is bounded
+ * by the number of events posted since the last call. */
+static void _drain(event_queue_t *queue)
+{
+    unsigned state = irq_disable();
+    clist_node_t *node = __atomic_exchange_n(&queue->pending, NULL,
+                                             __ATOMIC_ACQUIRE);
+
+    if (node == NULL) {
+        irq_restore(state);
+        return;
+    }
+
+    /* pending is LIFO, reverse it. The newest event ends up last and keeps
+     * pointing to _pending_end until it is spliced in */
+    clist_node_t *first = &_pending_end;
+    clist_node_t *last = node;
+    while (node != &_pending_end) {
+        clist_node_t *next = node->next;
+        node->next = first;
+        first = node;
+        node = next;
+    }
+
+    clist_node_t *tail = queue->event_list.next;
+    if (tail) {
+        last->next = tail->next;
+        tail->next = first;
+    }
+    else {
+        last->next = first;
+    }
+    queue->event_list.next = last;
+    irq_restore(state);
+}
+
+static void _cancel_pending(event_queue_t *queue, event_t *event)
+{
+    clist_node_t *prev = NULL;
+    clist_node_t *node = queue->pending;
+
+    while (node && (node != &_pending_end)) {
+        if (node == &event->list_node) {
+            if (prev) {
+                prev->next = node->next;
+            }
+            else {
+                /* the next pending event, or NULL if there was none */
+                __atomic_store_n(&queue->pending,
+                                 (node->next == &_pending_end) ? NULL
+                                                               : node->next,
+                                 __ATOMIC_RELAXED);
+            }
+            return;
+        }
+        prev = node;
+        node = node->next;
+    }
+}
+#endif
+
+static event_t *_pop(event_queue_t *queue)
+{
+#if IS_USED(MODULE_EVENT_LOCKFREE)
+    if (queue->event_list.next == NULL) {
+        _drain(queue);
+    }
+#endif
+    unsigned state = irq_disable();
+    event_t *result = (event_t *)clist_lpop(&queue->event_list);
+    irq_restore(state);
+
+    if (result) {
+        result->list_node.next = NULL;
+    }
+    return result;
+}
+
 void event_queue_init_detached(event_queue_t *queue)
 {
     assert(queue);
@@ -56,12 +163,17 @@ void event_post(event_queue_t *queue, event_t *event)
 {
     assert(queue && event);
 
+#if IS_USED(MODULE_EVENT_LOCKFREE)
+    _push(queue, event);
+    thread_t *waiter = __atomic_load_n(&queue->waiter, __ATOMIC_RELAXED);
+#else
     unsigned state = irq_disable();
     if (!event->list_node.next) {
         clist_rpush(&queue->event_list, &event->list_node);
     }
     thread_t *waiter = queue->waiter;
     irq_restore(state);
+#endif
 
     /* WARNING: there is a minimal chance, that a waiter claims a formerly
      *          detached queue between the end of the critical section above and
@@ -79,21 +191,20 @@ void event_cancel(event_queue_t *queue, event_t *event)
     assert(event);
 
     unsigned state = irq_disable();
+#if IS_USED(MODULE_EVENT_LOCKFREE)
+    if (!clist_remove(&queue->event_list, &event->list_node)) {
+        _cancel_pending(queue, event);
+    }
+#else
     clist_remove(&queue->event_list, &event->list_node);
+#endif
     event->list_node.next = NULL;
     irq_restore(state);
 }
 
 event_t *event_get(event_queue_t *queue)
 {
-    unsigned state = irq_disable();
-    event_t *result = (event_t *) clist_lpop(&queue->event_list);
-    irq_restore(state);
-
-    if (result) {
-        result->list_node.next = NULL;
-    }
-    return result;
+    return _pop(queue);
 }
 
 event_t *event_wait(event_queue_t *queue)
@@ -102,15 +213,12 @@ event_t *event_wait(event_queue_t *queue)
     event_t *result;
 
     do {
-        unsigned state = irq_disable();
-        result = (event_t *)clist_lpop(&queue->event_list);
-        irq_restore(state);
+        result = _pop(queue);
         if (result == NULL) {
             thread_flags_wait_any(THREAD_FLAG_EVENT);
         }
     } while (result == NULL);
 
-    result->list_node.next = NULL;
     return result;
 }
 
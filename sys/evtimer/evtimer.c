@@ -24,7 +24,6 @@
 
 #include "div.h"
 #include "irq.h"
-#include "xtimer.h"
 
 #include "evtimer.h"
 
@@ -91,39 +90,70 @@ static void _del_event_from_list(evtimer_t *evtimer, evtimer_event_t *event)
     }
 }
 
-static void _set_timer(xtimer_t *timer, uint32_t offset_ms)
+#if IS_USED(MODULE_EVTIMER_ON_ZTIMER)
+static void _set_timer(evtimer_t *evtimer, uint32_t offset_ms)
+{
+    evtimer->base = ztimer_now(ZTIMER_MSEC);
+    DEBUG("evtimer: now=%" PRIu32 " ms setting ztimer to %" PRIu32 " ms\n",
+          evtimer->base, offset_ms);
+
+    ztimer_set(ZTIMER_MSEC, &evtimer->timer, offset_ms);
+}
+
+static void _remove_timer(evtimer_t *evtimer)
+{
+    ztimer_remove(ZTIMER_MSEC, &evtimer->timer);
+}
+
+static uint32_t _get_offset(evtimer_t *evtimer)
+{
+    uint32_t passed = ztimer_now(ZTIMER_MSEC) - evtimer->base;
+    uint32_t offset = evtimer->events->offset;
+
+    /* the offsets of the following events now base on the current time */
+    evtimer->base += passed;
+    return (passed < offset) ? (offset - passed) : 0;
+}
+#else
+static void _set_timer(evtimer_t *evtimer, uint32_t offset_ms)
 {
     uint64_t offset_us = (uint64_t)offset_ms * US_PER_MS;
 
     DEBUG("evtimer: now=%" PRIu32 " us setting xtimer to %" PRIu32 ":%" PRIu32 " us\n",
           xtimer_now_usec(), (uint32_t)(offset_us >> 32), (uint32_t)(offset_us));
 
-    xtimer_set64(timer, offset_us);
+    xtimer_set64(&evtimer->timer, offset_us);
 }
 
+static void _remove_timer(evtimer_t *evtimer)
+{
+    xtimer_remove(&evtimer->timer);
+}
+
+static uint32_t _get_offset(evtimer_t *evtimer)
+{
+    uint64_t left = xtimer_left_usec(&evtimer->timer);
+    /* add half of 125 so integer division rounds to nearest */
+    return div_u64_by_125((left >> 3) + 62);
+}
+#endif
+
 static void _update_timer(evtimer_t *evtimer)
 {
     if (evtimer->events) {
         evtimer_event_t *event = evtimer->events;
-        _set_timer(&evtimer->timer, event->offset);
+        _set_timer(evtimer, event->offset);
     }
     else {
-        xtimer_remove(&evtimer->timer);
+        _remove_timer(evtimer);
     }
 }
 
-static uint32_t _get_offset(xtimer_t *timer)
-{
-    uint64_t left = xtimer_left_usec(timer);
-    /* add half of 125 so integer division rounds to nearest */
-    return div_u64_by_125((left >> 3) + 62);
-}
-
 static void _update_head_offset(evtimer_t *evtimer)
 {
     if (evtimer->events) {
         evtimer_event_t *event = evtimer->events;
-        event->offset = _get_offset(&evtimer->timer);
+        event->offset = _get_offset(evtimer);
         DEBUG("evtimer: _update_head_offset(): new head offset %" PRIu32 "\n", event->offset);
     }
 }
@@ -137,7 +167,7 @@ void evtimer_add(evtimer_t *evtimer, evtimer_event_t *event)
     _update_head_offset(evtimer);
     _add_event_to_list(evtimer, event);
     if (evtimer->events == event) {
-        _set_timer(&evtimer->timer, event->offset);
+        _set_timer(evtimer, event->offset);
     }
     irq_restore(state);
     if (sched_context_switch_request) {
@@ -48,6 +48,54 @@ static const uint32_t _tenmap[] = {
 
 #define TENMAP_SIZE  ARRAY_SIZE(_tenmap)
 
+/* "00" to "99", for converting two digits per division */
+static const char _dec_pairs[200] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+/* Cores without a divide instruction would call into the libgcc division
+ * routine for every digit. The compiler already replaces divisions by
+ * constants with a multiply-high on cores with a 32x32->64 multiply, but
+ * ARMv6-M and ARMv8-M Baseline lack that as well, so shift-add sequences
+ * are used there (Hacker's Delight, divu10). */
+#if defined(__ARM_ARCH_6M__) || defined(__ARM_ARCH_8M_BASE__)
+#define FMT_DIV_SHIFT_ADD   (1)
+#else
+#define FMT_DIV_SHIFT_ADD   (0)
+#endif
+
+static inline uint32_t _div10(uint32_t n)
+{
+    if (FMT_DIV_SHIFT_ADD) {
+        uint32_t q = (n >> 1) + (n >> 2);
+        q += q >> 4;
+        q += q >> 8;
+        q += q >> 16;
+        q >>= 3;
+        /* q is at most one too small */
+        return q + ((n - q * 10) > 9);
+    }
+    return n / 10;
+}
+
+static inline uint32_t _div100(uint32_t n)
+{
+    return FMT_DIV_SHIFT_ADD ? _div10(_div10(n)) : n / 100;
+}
+
+static inline uint32_t _div10000(uint32_t n)
+{
+    return FMT_DIV_SHIFT_ADD ? _div100(_div100(n)) : n / 10000;
+}
+
 static inline char _to_lower(char c)
 {
     return 'a' + (c - 'A');
@@ -199,20 +247,20 @@ size_t fmt_u64_dec(char *out, uint64_t val)
     d[3] = (val>>48) & 0xFFFF;
 
     d[0] = 656 * d[3] + 7296 * d[2] + 5536 * d[1] + d[0];
-    q = d[0] / 10000;
-    d[0] = d[0] % 10000;
+    q = _div10000(d[0]);
+    d[0] -= q * 10000;
 
     d[1] = q + 7671 * d[3] + 9496 * d[2] + 6 * d[1];
-    q = d[1] / 10000;
-    d[1] = d[1] % 10000;
+    q = _div10000(d[1]);
+    d[1] -= q * 10000;
 
     d[2] = q + 4749 * d[3] + 42 * d[2];
-    q = d[2] / 10000;
-    d[2] = d[2] % 10000;
+    q = _div10000(d[2]);
+    d[2] -= q * 10000;
 
     d[3] = q + 281 * d[3];
-    q = d[3] / 10000;
-    d[3] = d[3] % 10000;
+    q = _div10000(d[3]);
+    d[3] -= q * 10000;
 
     d[4] = q;
 
@@ -258,9 +306,18 @@ size_t fmt_u32_dec(char *out, uint32_t val)
 
     if (out) {
         char *ptr = out + len;
-        do {
-            *--ptr = (val % 10) + '0';
-        } while ((val /= 10));
+        while (val >= 100) {
+            uint32_t q = _div100(val);
+            ptr -= 2;
+            memcpy(ptr, &_dec_pairs[2 * (val - q * 100)], 2);
+            val = q;
+        }
+        if (val >= 10) {
+            memcpy(out, &_dec_pairs[2 * val], 2);
+        }
+        else {
+            *out = val + '0';
+        }
     }
 
     return len;
@@ -577,3 +634,126 @@ void print_str(const char* str)
 {
     print(str, fmt_strlen(str));
 }
+
+void fmt_writer_init(fmt_writer_t *w, char *buf, size_t size,
+                     fmt_sink_t sink, void *arg)
+{
+    w->sink = sink;
+    w->arg = arg;
+    w->buf = buf;
+    w->size = size;
+    w->len = 0;
+}
+
+static void _writer_out(fmt_writer_t *w, const char *s, size_t n)
+{
+    if (w->sink) {
+        w->sink(w->arg, s, n);
+    }
+    else {
+        print(s, n);
+    }
+}
+
+void fmt_writer_flush(fmt_writer_t *w)
+{
+    if (w->len) {
+        _writer_out(w, w->buf, w->len);
+        w->len = 0;
+    }
+}
+
+void fmt_writer_write(fmt_writer_t *w, const char *s, size_t n)
+{
+    if (w->size - w->len < n) {
+        fmt_writer_flush(w);
+        if (w->size < n) {
+            _writer_out(w, s, n);
+            return;
+        }
+    }
+    memcpy(&w->buf[w->len], s, n);
+    w->len += n;
+}
+
+void fmt_writer_str(fmt_writer_t *w, const char *str)
+{
+    fmt_writer_write(w, str, fmt_strlen(str));
+}
+
+void fmt_writer_char(fmt_writer_t *w, char c)
+{
+    fmt_writer_write(w, &c, 1);
+}
+
+/* returns where to format up to n characters, buf if the writer has no
+ * room even after a flush */
+static char *_writer_reserve(fmt_writer_t *w, size_t n, char *buf)
+{
+    if (w->size - w->len < n) {
+        fmt_writer_flush(w);
+    }
+    return (w->size - w->len < n) ? buf : &w->buf[w->len];
+}
+
+static void _writer_commit(fmt_writer_t *w, const char *out, size_t n)
+{
+    if (out == &w->buf[w->len]) {
+        w->len += n;
+    }
+    else {
+        fmt_writer_write(w, out, n);
+    }
+}
+
+void fmt_writer_u32_dec(fmt_writer_t *w, uint32_t val)
+{
+    char buf[10]; /* "4294967295" */
+    char *out = _writer_reserve(w, sizeof(buf), buf);
+    _writer_commit(w, out, fmt_u32_dec(out, val));
+}
+
+void fmt_writer_s32_dec(fmt_writer_t *w, int32_t val)
+{
+    char buf[11]; /* "-2147483648" */
+    char *out = _writer_reserve(w, sizeof(buf), buf);
+    _writer_commit(w, out, fmt_s32_dec(out, val));
+}
+
+void fmt_writer_u64_dec(fmt_writer_t *w, uint64_t val)
+{
+    char buf[20]; /* "18446744073709551615" */
+    char *out = _writer_reserve(w, sizeof(buf), buf);
+    _writer_commit(w, out, fmt_u64_dec(out, val));
+}
+
+void fmt_writer_s64_dec(fmt_writer_t *w, int64_t val)
+{
+    char buf[20]; /* "-9223372036854775808" */
+    char *out = _writer_reserve(w, sizeof(buf), buf);
+    _writer_commit(w, out, fmt_s64_dec(out, val));
+}
+
+void fmt_writer_u32_hex(fmt_writer_t *w, uint32_t val)
+{
+    char buf[8];
+    char *out = _writer_reserve(w, sizeof(buf), buf);
+    _writer_commit(w, out, fmt_u32_hex(out, val));
+}
+
+void fmt_writer_s32_dfp(fmt_writer_t *w, int32_t val, int fp_digits)
+{
+    size_t n = fmt_s32_dfp(NULL, val, fp_digits);
+    char buf[20]; /* at most "-214.7483648" for fp_digits < 0 */
+    char *out = _writer_reserve(w, n, buf);
+
+    if (n > sizeof(buf) && out == buf) {
+        /* only possible with many fp_digits and a tiny buffer */
+        fmt_writer_s32_dec(w, val);
+        while (fp_digits--) {
+            fmt_writer_char(w, '0');
+        }
+        return;
+    }
+    _writer_commit(w, out, fmt_s32_dfp(out, val, fp_digits));
+}
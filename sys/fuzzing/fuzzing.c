@@ -7,16 +7,25 @@
  */
 
 #include <errno.h>
+#include <stdlib.h>
 #include <unistd.h>
 #include <sys/types.h>
 
 #include "assert.h"
 #include "fuzzing.h"
+#include "kernel_defines.h"
+#include "mutex.h"
 
 #include "net/ipv6/addr.h"
 #include "net/gnrc/netif.h"
 #include "net/gnrc/pktbuf.h"
 #include "net/gnrc/pkt.h"
+#if IS_USED(MODULE_GNRC_IPV6_NIB)
+#include "net/gnrc/ipv6/nib.h"
+#endif
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_RB)
+#include "net/gnrc/sixlowpan/frag/rb.h"
+#endif
 
 extern int fuzzing_netdev(gnrc_netif_t *);
 extern void fuzzing_netdev_wait(void);
@@ -28,6 +37,13 @@ gnrc_pktsnip_t *gnrc_pktbuf_fuzzptr = NULL;
 #define FUZZING_BSIZE 1024
 #define FUZZING_BSTEP 128
 
+static bool _looping;
+static bool _pending;
+#ifdef __AFL_HAVE_MANUAL_CONTROL
+/* unlocked once the packet of the current input is processed */
+static mutex_t _done = MUTEX_INIT_LOCKED;
+#endif
+
 int
 fuzzing_init(ipv6_addr_t *addr, unsigned pfx_len)
 {
@@ -53,7 +69,7 @@ fuzzing_read_packet(int fd, gnrc_pktsnip_t *pkt)
     ssize_t r;
     size_t csiz, rsiz;
 
-    /* can only be called once currently */
+    /* can only be called once per input */
     assert(gnrc_pktbuf_fuzzptr == NULL);
 
     csiz = 0;
@@ -85,5 +101,52 @@ fuzzing_read_packet(int fd, gnrc_pktsnip_t *pkt)
     }
 
     gnrc_pktbuf_fuzzptr = pkt;
+    _pending = true;
     return 0;
 }
+
+#ifdef __AFL_HAVE_MANUAL_CONTROL
+static void
+_reset(void)
+{
+#if IS_USED(MODULE_GNRC_IPV6_NIB)
+    gnrc_ipv6_nib_init();
+#endif
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_RB)
+    gnrc_sixlowpan_frag_rb_reset();
+#endif
+}
+#endif
+
+bool
+fuzzing_loop(void)
+{
+#ifdef __AFL_HAVE_MANUAL_CONTROL
+    _looping = true;
+    if (_pending) {
+        mutex_lock(&_done);
+        _pending = false;
+        _reset();
+    }
+    if (!__AFL_LOOP(CONFIG_FUZZING_PERSISTENT_ITERATIONS)) {
+        /* returning from main does not end a RIOT process */
+        exit(EXIT_SUCCESS);
+    }
+    return true;
+#else
+    /* a single input per process, fuzzing_done() terminates it */
+    return !_pending;
+#endif
+}
+
+void
+fuzzing_done(void)
+{
+    if (!_looping) {
+        exit(EXIT_SUCCESS);
+    }
+#ifdef __AFL_HAVE_MANUAL_CONTROL
+    gnrc_pktbuf_fuzzptr = NULL;
+    mutex_unlock(&_done);
+#endif
+}
@@ -50,6 +50,11 @@
 #include <assert.h>
 
 #include "hashes/sha2xx_common.h"
+#include "kernel_defines.h"
+
+#ifdef MODULE_PERIPH_CRYPTO_SHA256
+#include "periph/crypto.h"
+#endif
 
 
 #ifdef __BIG_ENDIAN__
@@ -135,6 +140,23 @@ static void sha2xx_transform(uint32_t *state, const unsigned char block[64])
     }
 }
 
+/* Transform consecutive blocks, in hardware if possible */
+static void sha2xx_transform_blocks(uint32_t *state,
+                                    const unsigned char *blocks, size_t n)
+{
+#ifdef MODULE_PERIPH_CRYPTO_SHA256
+    if (IS_ACTIVE(CONFIG_HASHES_SHA256_PERIPH) &&
+        (crypto_sha256_blocks(state, blocks, n) == 0)) {
+        return;
+    }
+#endif
+
+    while (n--) {
+        sha2xx_transform(state, blocks);
+        blocks += 64;
+    }
+}
+
 static unsigned char PAD[64] = {
     0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
     0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
@@ -191,16 +213,14 @@ void sha2xx_update(sha2xx_context_t *ctx, const void *data, size_t len)
     const unsigned char *src = data;
 
     memcpy(&ctx->buf[r], src, 64 - r);
-    sha2xx_transform(ctx->state, ctx->buf);
+    sha2xx_transform_blocks(ctx->state, ctx->buf, 1);
     src += 64 - r;
     len -= 64 - r;
 
     /* Perform complete blocks */
-    while (len >= 64) {
-        sha2xx_transform(ctx->state, src);
-        src += 64;
-        len -= 64;
-    }
+    sha2xx_transform_blocks(ctx->state, src, len / 64);
+    src += len & ~(size_t)0x3f;
+    len &= 0x3f;
 
     /* Copy left over data into buffer */
     memcpy(ctx->buf, src, len);
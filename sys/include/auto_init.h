@@ -59,6 +59,26 @@
  *
  * From low-level CPU peripheral, the default initialization parameters are
  * defined in each board configuration that provides them.
+ *
+ * ## Boot time
+ *
+ * The modules are initialized in the order of a table in `auto_init.c`. Each
+ * entry depends on all entries before it. Slow entries that nothing else in
+ * `auto_init` depends on, e.g. SAUL drivers probing their sensors, SD cards,
+ * LoRaMAC and the DFPlayer, are flagged as asynchronous. With module
+ * `auto_init_async`, these run on a short-lived init thread one after the
+ * other, while the main thread continues with the remaining entries and
+ * @e main. While an asynchronous entry waits for its hardware, the main thread
+ * thus gets work done. The application must call auto_init_wait() before
+ * using any of the modules initialized asynchronously:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~ {.mk}
+ * USEMODULE += auto_init_async
+ * ~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * With module `auto_init_profile`, the time each entry takes is measured with
+ * `ZTIMER_USEC` and printed once all entries are done. Entries before ztimer
+ * is initialized are not measured.
  */
 
 /**
@@ -100,10 +120,34 @@
 #ifndef AUTO_INIT_H
 #define AUTO_INIT_H
 
+#include "kernel_defines.h"
+#if IS_USED(MODULE_AUTO_INIT_ASYNC)
+#include "thread.h"
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#if IS_USED(MODULE_AUTO_INIT_ASYNC) || defined(DOXYGEN)
+/**
+ * @brief   Stack size of the init thread of module `auto_init_async`
+ */
+#ifndef CONFIG_AUTO_INIT_ASYNC_STACKSIZE
+#define CONFIG_AUTO_INIT_ASYNC_STACKSIZE    (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @brief   Priority of the init thread of module `auto_init_async`
+ *
+ * Above the main thread by default, so that the main thread only runs while
+ * the init thread waits for hardware.
+ */
+#ifndef CONFIG_AUTO_INIT_ASYNC_PRIO
+#define CONFIG_AUTO_INIT_ASYNC_PRIO         (THREAD_PRIORITY_MAIN - 1)
+#endif
+#endif
+
 /**
  * @brief Initializes all high level modules that do not require parameters for
  *        initialization or uses default values.
@@ -113,6 +157,22 @@ extern "C" {
  */
 void auto_init(void);
 
+/**
+ * @brief   Waits until all modules initialized asynchronously are ready
+ *
+ * Returns immediately without module `auto_init_async`.
+ */
+void auto_init_wait(void);
+
+/**
+ * @brief   Prints the time each auto-initialization step took
+ *
+ * Called automatically once all steps are done.
+ *
+ * @note    Only available with module `auto_init_profile`
+ */
+void auto_init_profile_print(void);
+
 #ifdef __cplusplus
 }
 #endif
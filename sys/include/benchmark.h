@@ -23,8 +23,13 @@
 
 #include <stdint.h>
 
+#include "cpu.h"
 #include "irq.h"
+#include "kernel_defines.h"
 #include "xtimer.h"
+#if IS_USED(MODULE_ZTIMER_USEC)
+#include "ztimer.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -33,6 +38,10 @@ extern "C" {
 /**
  * @brief   Measure the runtime of a given function call
  *
+ * @deprecated  Only reports the mean with microsecond resolution, use
+ *              @ref BENCHMARK_SAMPLE and @ref benchmark_print_json or
+ *              @ref benchmark_print_csv instead.
+ *
  * As we are doing a time sensitive measurement here, there is no way around
  * using a preprocessor function, as going with a function pointer or similar
  * would influence the measured runtime...
@@ -62,6 +71,186 @@ extern "C" {
  */
 void benchmark_print_time(uint32_t time, unsigned long runs, const char *name);
 
+/**
+ * @name    Per-call sampling
+ *
+ * Instead of the total runtime of all runs, these record the duration of
+ * every single run and report percentiles. Durations are CPU cycles where
+ * a cycle counter is available (DWT CYCCNT on Cortex-M3 and up, CCOUNT on
+ * Xtensa, mcycle on RISC-V) and microseconds of `ztimer_usec` or `xtimer`
+ * otherwise. The cost of reading the time source, measured by
+ * benchmark_clock_init(), is subtracted from every sample. Interrupts stay
+ * enabled, so primitives that switch threads can be measured as well.
+ *
+ * The samples can be printed with benchmark_print_json() or
+ * benchmark_print_csv() or evaluated with benchmark_stats(), e.g. to assert
+ * an upper bound in a unit test.
+ * @{
+ */
+
+#if defined(DWT_CTRL_CYCCNTENA_Msk) || defined(__XTENSA__) || \
+    defined(__riscv) || defined(DOXYGEN)
+/**
+ * @brief   Samples are CPU cycles
+ */
+#define BENCHMARK_CYCLES    (1)
+#else
+#define BENCHMARK_CYCLES    (0)
+#endif
+
+#if BENCHMARK_CYCLES || defined(DOXYGEN)
+/**
+ * @brief   Unit of the recorded samples
+ */
+#define BENCHMARK_UNIT      "cycles"
+#else
+#define BENCHMARK_UNIT      "us"
+#endif
+
+/**
+ * @brief   Time taken by a pair of benchmark_now() calls in
+ *          @ref BENCHMARK_UNIT, subtracted from every sample
+ */
+extern uint32_t benchmark_overhead;
+
+/**
+ * @brief   Statistics of a sample set
+ */
+typedef struct {
+    unsigned numof;         /**< number of samples */
+    uint32_t min;           /**< shortest sample */
+    uint32_t p50;           /**< median */
+    uint32_t p90;           /**< 90th percentile */
+    uint32_t p99;           /**< 99th percentile */
+    uint32_t max;           /**< longest sample */
+    uint32_t mean;          /**< arithmetic mean */
+} benchmark_stats_t;
+
+/**
+ * @brief   Samples of one benchmark case
+ */
+typedef struct {
+    uint32_t *samples;      /**< buffer for the samples */
+    unsigned size;          /**< capacity of @ref samples */
+    unsigned numof;         /**< number of recorded samples */
+} benchmark_samples_t;
+
+/**
+ * @brief   Static initializer for a sample set using the array @p buf
+ */
+#define BENCHMARK_SAMPLES_INIT(buf) \
+    { .samples = (buf), .size = ARRAY_SIZE(buf), .numof = 0 }
+
+/**
+ * @brief   Prepare the time source and measure @ref benchmark_overhead,
+ *          call once before sampling
+ */
+void benchmark_clock_init(void);
+
+/**
+ * @brief   Get the current time in @ref BENCHMARK_UNIT
+ */
+static inline uint32_t benchmark_now(void)
+{
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+    return DWT->CYCCNT;
+#elif defined(__XTENSA__)
+    uint32_t ccount;
+    __asm__ volatile ("rsr %0, ccount" : "=a" (ccount));
+    return ccount;
+#elif defined(__riscv)
+    uint32_t mcycle;
+    __asm__ volatile ("csrr %0, mcycle" : "=r" (mcycle));
+    return mcycle;
+#elif IS_USED(MODULE_ZTIMER_USEC)
+    return ztimer_now(ZTIMER_USEC);
+#else
+    return xtimer_now_usec();
+#endif
+}
+
+/**
+ * @brief   Get the time elapsed since @p start without the overhead of
+ *          reading the time source
+ *
+ * @param[in] start     time returned by benchmark_now()
+ *
+ * @return  elapsed time in @ref BENCHMARK_UNIT
+ */
+static inline uint32_t benchmark_elapsed(uint32_t start)
+{
+    uint32_t elapsed = benchmark_now() - start;
+
+    return (elapsed > benchmark_overhead) ? elapsed - benchmark_overhead : 0;
+}
+
+/**
+ * @brief   Record a single sample, dropped if @p set is full
+ *
+ * @param[in,out] set   sample set to add to
+ * @param[in] duration  duration in @ref BENCHMARK_UNIT
+ */
+static inline void benchmark_record(benchmark_samples_t *set, uint32_t duration)
+{
+    if (set->numof < set->size) {
+        set->samples[set->numof++] = duration;
+    }
+}
+
+/**
+ * @brief   Measure every single of @p runs calls of @p func
+ *
+ * @param[in,out] set   sample set to record into
+ * @param[in] runs      number of times to run @p func
+ * @param[in] func      function call to benchmark
+ */
+#define BENCHMARK_SAMPLE(set, runs, func)                       \
+    for (unsigned long _benchmark_i = 0; _benchmark_i < (runs); \
+         _benchmark_i++) {                                      \
+        uint32_t _benchmark_start = benchmark_now();            \
+        func;                                                   \
+        benchmark_record((set), benchmark_elapsed(_benchmark_start)); \
+    }
+
+/**
+ * @brief   Compute the statistics of a sample set
+ *
+ * @note    Sorts the samples in place.
+ *
+ * @param[in,out] set   recorded samples
+ * @param[out] stats    statistics, all 0 if @p set is empty
+ */
+void benchmark_stats(benchmark_samples_t *set, benchmark_stats_t *stats);
+
+/**
+ * @brief   Print statistics of a sample set as a single JSON line
+ *
+ * The output looks like
+ * `{"name":"msg","unit":"cycles","n":1000,"min":10,"p50":12,"p90":13,
+ * "p99":20,"max":31,"mean":12}` and is meant to be collected by CI for
+ * regression tracking.
+ *
+ * @note    Sorts the samples in place.
+ *
+ * @param[in] name      name of the benchmark case
+ * @param[in,out] set   recorded samples
+ */
+void benchmark_print_json(const char *name, benchmark_samples_t *set);
+
+/**
+ * @brief   Print statistics of a sample set as a CSV line
+ *
+ * The header line `name,unit,n,min,p50,p90,p99,max,mean` is printed before
+ * the first line.
+ *
+ * @note    Sorts the samples in place.
+ *
+ * @param[in] name      name of the benchmark case
+ * @param[in,out] set   recorded samples
+ */
+void benchmark_print_csv(const char *name, benchmark_samples_t *set);
+/** @} */
+
 #ifdef __cplusplus
 }
 #endif
@@ -102,6 +102,84 @@ static inline bool bf_isset(uint8_t field[], size_t idx)
  */
 int bf_get_unset(uint8_t field[], int size);
 
+/**
+ * @brief   Get the number of the first set bit
+ *
+ * The bitfield is scanned a 32-bit word at a time.
+ *
+ * @param[in] field The bitfield
+ * @param[in] size  The size of the bitfield
+ *
+ * @return      number of the first set bit
+ * @return      -1 if no bit is set
+ */
+int bf_find_first_set(const uint8_t field[], size_t size);
+
+/**
+ * @brief   Get the number of the first unset bit
+ *
+ * Unlike bf_get_unset(), the bit is not set.
+ *
+ * @param[in] field The bitfield
+ * @param[in] size  The size of the bitfield
+ *
+ * @return      number of the first unset bit
+ * @return      -1 if all bits are set
+ */
+int bf_find_first_unset(const uint8_t field[], size_t size);
+
+/**
+ * @brief   Set a range of bits
+ *
+ * @param[in,out] field The bitfield
+ * @param[in]     start The number of the first bit to set
+ * @param[in]     len   The number of bits to set
+ */
+void bf_set_range(uint8_t field[], size_t start, size_t len);
+
+/**
+ * @brief   Clear a range of bits
+ *
+ * @param[in,out] field The bitfield
+ * @param[in]     start The number of the first bit to clear
+ * @param[in]     len   The number of bits to clear
+ */
+void bf_unset_range(uint8_t field[], size_t start, size_t len);
+
+/**
+ * @brief   Count the set bits
+ *
+ * @param[in] field The bitfield
+ * @param[in] size  The size of the bitfield
+ *
+ * @return      number of set bits
+ */
+unsigned bf_popcnt(const uint8_t field[], size_t size);
+
+/**
+ * @brief   Bitwise AND of two bitfields
+ *
+ * @p out may be @p a or @p b.
+ *
+ * @param[out] out  The resulting bitfield
+ * @param[in]  a    The first bitfield
+ * @param[in]  b    The second bitfield
+ * @param[in]  size The size of the bitfields
+ */
+void bf_and(uint8_t out[], const uint8_t a[], const uint8_t b[], size_t size);
+
+/**
+ * @brief   Bitwise OR of two bitfields
+ *
+ * @p out may be @p a or @p b.
+ *
+ * @param[out] out  The resulting bitfield
+ * @param[in]  a    The first bitfield
+ * @param[in]  b    The second bitfield
+ * @param[in]  size The size of the bitfields
+ */
+void bf_or(uint8_t out[], const uint8_t a[], const uint8_t b[], size_t size);
+
 #ifdef __cplusplus
 }
 #endif
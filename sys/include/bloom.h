@@ -136,6 +136,31 @@ extern "C" {
  */
 typedef uint32_t (*hashfp_t)(const uint8_t *, int len);
 
+/**
+ * @brief Number of bits in a block of a blocked Bloom filter
+ *
+ * All bits of a string are set within one block, so a check touches a
+ * single cache line. Must be a power of 2.
+ */
+#ifndef CONFIG_BLOOM_BLOCK_BITS
+#define CONFIG_BLOOM_BLOCK_BITS     (512U)
+#endif
+
+/**
+ * @name    Bloom filter flags
+ * @{
+ */
+/**
+ * @brief Derive the k indices from two hashes (Kirsch-Mitzenmacher)
+ */
+#define BLOOM_FLAG_DOUBLE_HASHING   (0x01)
+/**
+ * @brief Keep all bits of a string in one block of
+ *        @ref CONFIG_BLOOM_BLOCK_BITS bits
+ */
+#define BLOOM_FLAG_BLOCKED          (0x02)
+/** @} */
+
 /**
  * @brief bloom_t bloom filter object
  */
@@ -148,8 +173,28 @@ typedef struct {
     uint8_t *a;
     /** the hash functions */
     hashfp_t *hash;
+    /** flags, see @ref BLOOM_FLAG_DOUBLE_HASHING */
+    uint8_t flags;
 } bloom_t;
 
+/**
+ * @brief Counting Bloom filter object
+ *
+ * Every position holds a 4 bit counter instead of a bit, so strings can be
+ * removed again. A counter that reached 15 is never decremented, as the
+ * number of strings that incremented it is unknown.
+ */
+typedef struct {
+    /** number of counters */
+    size_t m;
+    /** number of indices per string */
+    size_t k;
+    /** the counters, two per byte */
+    uint8_t *c;
+    /** the two hash functions */
+    hashfp_t *hash;
+} bloom_counting_t;
+
 /**
  * @brief Initialize a Bloom Filter.
  *
@@ -165,6 +210,27 @@ typedef struct {
  */
 void bloom_init(bloom_t *bloom, size_t size, uint8_t *bitfield, hashfp_t *hashes, int hashes_numof);
 
+/**
+ * @brief Initialize a Bloom filter using double hashing
+ *
+ * Only the two hash functions in @p hashes are computed per string, the
+ * @p k indices are derived from them as h1 + i * h2. With
+ * @ref BLOOM_FLAG_BLOCKED, the first hash also selects the block the
+ * indices are placed in.
+ *
+ * @param bloom             bloom_t to initialize
+ * @param size              size of the bloom filter in bits
+ * @param bitfield          underlying bitfield of the bloom filter
+ * @param hashes            array of two hashes
+ * @param k                 number of indices per string
+ * @param flags             @ref BLOOM_FLAG_BLOCKED or 0
+ * @pre     @p bitfield MUST be large enough to hold @p size bits.
+ * @pre     With @ref BLOOM_FLAG_BLOCKED, @p size MUST be a multiple of
+ *          @ref CONFIG_BLOOM_BLOCK_BITS and @p k must not exceed it.
+ */
+void bloom_init_double(bloom_t *bloom, size_t size, uint8_t *bitfield,
+                       hashfp_t *hashes, size_t k, uint8_t flags);
+
 /**
  * @brief Delete a Bloom filter.
  *
@@ -228,6 +294,53 @@ void bloom_add(bloom_t *bloom, const uint8_t *buf, size_t len);
  */
 bool bloom_check(bloom_t *bloom, const uint8_t *buf, size_t len);
 
+/**
+ * @brief Initialize a counting Bloom filter
+ *
+ * The indices are derived with double hashing as in bloom_init_double().
+ *
+ * @param bloom             filter to initialize
+ * @param size              number of counters
+ * @param counters          zeroed array of (@p size + 1) / 2 bytes
+ * @param hashes            array of two hashes
+ * @param k                 number of indices per string
+ */
+void bloom_counting_init(bloom_counting_t *bloom, size_t size,
+                         uint8_t *counters, hashfp_t *hashes, size_t k);
+
+/**
+ * @brief Add a string to a counting Bloom filter
+ * @param bloom  counting Bloom filter
+ * @param buf    string to add
+ * @param len    the length of the string @p buf
+ */
+void bloom_counting_add(bloom_counting_t *bloom, const uint8_t *buf,
+                        size_t len);
+
+/**
+ * @brief Remove a string from a counting Bloom filter
+ *
+ * Removing a string that was not added before corrupts the filter and may
+ * lead to false negatives.
+ *
+ * @param bloom  counting Bloom filter
+ * @param buf    string to remove
+ * @param len    the length of the string @p buf
+ */
+void bloom_counting_remove(bloom_counting_t *bloom, const uint8_t *buf,
+                           size_t len);
+
+/**
+ * @brief Determine if a string is in a counting Bloom filter
+ * @param bloom  counting Bloom filter
+ * @param buf    string to check
+ * @param len    the length of the string @p buf
+ * @return       false if string does not exist in the filter
+ * @return       true if string is may be in the filter
+ */
+bool bloom_counting_check(const bloom_counting_t *bloom, const uint8_t *buf,
+                          size_t len);
+
 #ifdef __cplusplus
 }
 #endif
@@ -14,6 +14,12 @@
  * The Data Link Layer is composed of the device, router, pkt and dll files.
  * It can be used to send and receive raw CAN frames through multiple CAN
  * controllers.
+ *
+ * With the `can_fd` module, CAN FD frames with up to @ref CANFD_MAX_DLEN bytes
+ * of payload are passed through the same functions as classic frames: a
+ * struct canfd_frame with @ref CANFD_FDF set in its flags is handed over as
+ * struct can_frame pointer, see @ref can_frame_is_fd(). The padding byte
+ * of classic frames must be zero then.
  * @{
  *
  * @file
@@ -30,8 +36,12 @@
 extern "C" {
 #endif
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
+#include "kernel_defines.h"
+
 #if defined(__linux__)
 
 #include <linux/can.h>
@@ -44,6 +54,20 @@ extern "C" {
  */
 #define CAN_MAX_DLEN (8)
 
+/**
+ * @brief Max data length for a CAN FD frame
+ */
+#define CANFD_MAX_DLEN (64)
+
+/**
+ * @name CAN FD flags
+ * @{
+ */
+#define CANFD_BRS (0x01) /**< bit rate switch (second bitrate for payload data) */
+#define CANFD_ESI (0x02) /**< error state indicator of the transmitting node */
+#define CANFD_FDF (0x04) /**< mark CAN FD for dual use of struct canfd_frame */
+/** @} */
+
 /**
  * @name CAN_ID flags and masks
  * @{
@@ -95,6 +119,22 @@ struct can_frame {
     uint8_t data[CAN_MAX_DLEN] __attribute__((aligned(8)));
 };
 
+/**
+ * @brief CAN flexible data rate frame
+ *
+ * The layout matches struct can_frame up to the payload, @p len is at the
+ * position of can_frame::can_dlc and @p flags at the one of can_frame::__pad.
+ */
+struct canfd_frame {
+    canid_t can_id;  /**< 32 bit CAN_ID + EFF/RTR/ERR flags */
+    uint8_t len;     /**< frame payload length in byte (0 .. CANFD_MAX_DLEN) */
+    uint8_t flags;   /**< additional flags for CAN FD, e.g. @ref CANFD_BRS */
+    uint8_t __res0;  /**< reserved / padding */
+    uint8_t __res1;  /**< reserved / padding */
+    /** Frame data */
+    uint8_t data[CANFD_MAX_DLEN] __attribute__((aligned(8)));
+};
+
 /**
  * @brief Controller Area Network filter
  */
@@ -139,6 +179,63 @@ struct can_bittiming_const {
 
 #endif /* defined(__linux__) */
 
+#ifndef CANFD_FDF
+#define CANFD_FDF (0x04) /* older kernel headers lack it */
+#endif
+
+#ifndef CAN_MTU
+#define CAN_MTU   (sizeof(struct can_frame))   /**< size of a classic frame */
+#define CANFD_MTU (sizeof(struct canfd_frame)) /**< size of a CAN FD frame */
+#endif
+
+/**
+ * @brief Check whether a frame is a CAN FD frame
+ *
+ * @param[in] frame classic frame or CAN FD frame with @ref CANFD_FDF set
+ *
+ * @return true if @p frame points to a struct canfd_frame
+ */
+static inline bool can_frame_is_fd(const struct can_frame *frame)
+{
+    return IS_USED(MODULE_CAN_FD) &&
+           (((const struct canfd_frame *)frame)->flags & CANFD_FDF);
+}
+
+/**
+ * @brief Get the size of the structure a frame is stored in
+ *
+ * @param[in] frame classic frame or CAN FD frame with @ref CANFD_FDF set
+ *
+ * @return @ref CANFD_MTU for CAN FD frames, @ref CAN_MTU otherwise
+ */
+static inline size_t can_frame_size(const struct can_frame *frame)
+{
+    return can_frame_is_fd(frame) ? CANFD_MTU : CAN_MTU;
+}
+
+/**
+ * @brief Round a payload length up to the next one a CAN FD frame can carry
+ *
+ * CAN FD frames carry 0 to 8, 12, 16, 20, 24, 32, 48 or 64 bytes.
+ *
+ * @param[in] len   payload length, at most @ref CANFD_MAX_DLEN
+ *
+ * @return the length of the smallest frame @p len fits in
+ */
+static inline uint8_t can_fd_valid_len(uint8_t len)
+{
+    if (len <= 8) {
+        return len;
+    }
+    if (len <= 24) {
+        return (len + 3) & ~3;
+    }
+    if (len <= 32) {
+        return 32;
+    }
+    return (len <= 48) ? 48 : 64;
+}
+
 #ifdef __cplusplus
 }
 #endif
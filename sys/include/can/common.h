@@ -51,6 +51,7 @@ typedef enum {
     CANOPT_CLOCK,           /**< controller main clock */
     CANOPT_BITTIMING_CONST, /**< controller bittiming parameters */
     CANOPT_STATE,           /**< set controller state @ref canopt_state_t */
+    CANOPT_DATA_BITTIMING,  /**< CAN FD data phase bit timing parameter */
 } canopt_t;
 
 /**
@@ -46,6 +46,7 @@ extern "C" {
  */
 #define CONN_CAN_DONTWAIT     (1)     /**< Do not wait for Tx confirmation when sending */
 #define CONN_CAN_RECVONLY     (2)     /**< Do not send anything on the bus */
+#define CONN_CAN_FD_FRAMES    (4)     /**< Send and receive CAN FD frames */
 /** @} */
 
 /**
@@ -93,6 +94,10 @@ int conn_can_raw_close(conn_can_raw_t *conn);
 /**
  *  @brief  Generic can receive
  *
+ * With @ref CONN_CAN_FD_FRAMES, @p frame must point to a struct canfd_frame
+ * and receives classic and CAN FD frames, the return value tells them apart.
+ * Otherwise CAN FD frames are dropped.
+ *
  * @param[in] conn          CAN connection
  * @param[out] frame        CAN frame to receive
  * @param[in] timeout       timeout in us, 0 for infinite
@@ -105,12 +110,16 @@ int conn_can_raw_recv(conn_can_raw_t *conn, struct can_frame *frame, uint32_t ti
 /**
  * @brief  Generic can send
  *
+ * CAN FD frames (see @ref can_frame_is_fd()) need @ref CONN_CAN_FD_FRAMES.
+ *
  * @param[in] conn          CAN connection
  * @param[in] frame         frame to send
  * @param[in] flags         make function blocked or not
  *                          (CONN_CAN_DONTWAIT to ignore tx confirmation)
  *
  * @return the number of bytes sent
+ * @return -EINVAL if @p frame is a CAN FD frame and @p conn is not set up for
+ *         CAN FD frames
  * @return any other negative number in case of an error
  */
 int conn_can_raw_send(conn_can_raw_t *conn, const struct can_frame *frame, int flags);
@@ -82,6 +82,13 @@ struct isotp_options {
     uint8_t  ext_address;    /**< set address for extended addressing */
     uint8_t  txpad_content;  /**< set content of padding byte (tx) */
     uint8_t  rx_ext_address; /**< set address for extended addressing */
+    /**
+     * data length of transmitted frames (TX_DL), 0 or 8 for classic CAN,
+     * up to CANFD_MAX_DLEN for CAN FD with the `can_fd` module
+     */
+    uint8_t  tx_dl;
+    uint8_t  tx_flags;       /**< CAN FD flags of transmitted frames,
+                              *   e.g. CANFD_BRS */
 };
 
 /**
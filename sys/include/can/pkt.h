@@ -45,6 +45,23 @@ typedef struct {
     struct can_frame frame;  /**< CAN Frame */
 } can_pkt_t;
 
+#if defined(MODULE_CAN_FD) || defined(DOXYGEN)
+/**
+ * @brief A CAN FD packet
+ *
+ * CAN FD frames are stored in a pool of their own so that classic frames
+ * don't take the room of a CAN FD frame. The packet is handled as
+ * @ref can_pkt_t, its frame is a struct canfd_frame if
+ * @ref can_frame_is_fd() is true.
+ */
+typedef struct {
+    can_reg_entry_t entry;      /**< entry containing ifnum and upper layer info */
+    atomic_uint ref_count;      /**< Reference counter (for rx frames) */
+    int handle;                 /**< handle (for tx frames */
+    struct canfd_frame frame;   /**< CAN FD Frame */
+} can_pkt_fd_t;
+#endif
+
 /**
  * @brief Initialize the CAN packet module
  *
@@ -57,6 +74,7 @@ void can_pkt_init(void);
  *
  * This function allocates a CAN packet and associates it to the @p ifnum and @p tx_pid.
  * The provided @p frame is copied into the CAN packet and a unique handle is set.
+ * CAN FD frames are allocated from a separate pool.
  *
  * @param[in] ifnum  the interface number
  * @param[in] frame  the frame to copy
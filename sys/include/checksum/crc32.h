@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_checksum_crc32 CRC32
+ * @ingroup     sys_checksum
+ *
+ * @brief       CRC32 checksum algorithm
+ * @details     This implementation of CRC32 uses the polynomial of IEEE 802.3
+ *              (@$ x^{32} + x^{26} + x^{23} + x^{22} + x^{16} + x^{12} +
+ *              x^{11} + x^{10} + x^{8} + x^{7} + x^{5} + x^{4} + x^{2} + x +
+ *              1 @$) in reflected form, as used by Ethernet, zlib and PNG.
+ *
+ *              Buffers are processed with a byte-wise look-up table, or four
+ *              bytes at a time if the `checksum_slice_by_4` module is used.
+ *              If the `periph_crc` feature is available, word aligned parts of
+ *              a buffer are passed to the hardware CRC unit instead.
+ *
+ * @{
+ * @file
+ * @author      ML!PA Consulting GmbH
+ */
+
+#ifndef CHECKSUM_CRC32_H
+#define CHECKSUM_CRC32_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Use the hardware CRC unit if available
+ */
+#ifndef CONFIG_CHECKSUM_CRC32_PERIPH
+#define CONFIG_CHECKSUM_CRC32_PERIPH    1
+#endif
+
+/**
+ * @brief           Update CRC32
+ *
+ * @param[in]  crc  A start value for the CRC calculation, 0 or the
+ *                  return value of a previous call to
+ *                  crc32_calc() or crc32_update()
+ * @param[in]  buf  Start of the memory area to checksum
+ * @param[in]  len  Number of bytes to checksum
+ *
+ * @return          Checksum of the specified memory area based on the
+ *                  given start value
+ */
+uint32_t crc32_update(uint32_t crc, const void *buf, size_t len);
+
+/**
+ * @brief           Calculate CRC32
+ *
+ * @param[in]  buf  Start of the memory area to checksum
+ * @param[in]  len  Number of bytes to checksum
+ *
+ * @return          Checksum of the specified memory area
+ */
+static inline uint32_t crc32_calc(const void *buf, size_t len)
+{
+    return crc32_update(0, buf, len);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CHECKSUM_CRC32_H */
+
+/** @} */
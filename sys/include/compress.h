@@ -0,0 +1,231 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_compress Streaming compression
+ * @ingroup     sys
+ * @brief       Compresses data streams with @ref pkg_heatshrink
+ *
+ * Data is written to a compression stream piece by piece, as it becomes
+ * available. The compressed data is collected in a buffer of
+ * @ref CONFIG_COMPRESS_CHUNK_SIZE bytes that is passed to a sink whenever it
+ * is full, and once more when the stream is finished. The RAM needed is
+ * thus bounded by the heatshrink state and that buffer, no matter how long
+ * the stream is. Picking the chunk size to match the consumer saves copies,
+ * e.g. the block size of a CoAP block-wise upload, or the payload size of a
+ * @ref sys_mtd_log record:
+ *
+ * ```c
+ * static int _to_log(void *arg, const void *data, size_t len)
+ * {
+ *     return mtd_log_append(arg, data, len);
+ * }
+ *
+ * compress_init(&ctx, _to_log, &log);
+ * compress_write(&ctx, record, len);
+ * ...
+ * compress_finish(&ctx);
+ * ```
+ *
+ * For data that is in RAM already, e.g. a SenML pack, compress_buf()
+ * compresses a buffer to another in one go.
+ *
+ * Every stream counts the bytes in and out and the time spent compressing.
+ * Whether compression pays off depends on the data, so these statistics
+ * are meant to decide that per channel at runtime. Note that short messages
+ * hardly compress, as the compressor starts without any history.
+ *
+ * The window is 2^`HEATSHRINK_STATIC_WINDOW_BITS` bytes and the lookahead
+ * 2^`HEATSHRINK_STATIC_LOOKAHEAD_BITS` bytes, as configured for the package.
+ * They must match on both ends, `heatshrink -w 8 -l 4` decompresses on a
+ * host.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Streaming compression interface
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+
+#ifndef COMPRESS_H
+#define COMPRESS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "heatshrink_decoder.h"
+#include "heatshrink_encoder.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Size of the output buffer of a stream, i.e. of the chunks passed
+ *          to the sink
+ */
+#ifndef CONFIG_COMPRESS_CHUNK_SIZE
+#define CONFIG_COMPRESS_CHUNK_SIZE  (64U)
+#endif
+
+/**
+ * @brief   Receives the output of a stream
+ *
+ * @param[in] arg       argument passed on init
+ * @param[in] data      output
+ * @param[in] len       length of @p data
+ *
+ * @return  >= 0 on success
+ * @return  < 0 to abort the stream, passed on to the caller
+ */
+typedef int (*compress_sink_t)(void *arg, const void *data, size_t len);
+
+/**
+ * @brief   Statistics of a stream
+ */
+typedef struct {
+    uint32_t in;                /**< bytes written to the stream */
+    uint32_t out;               /**< bytes passed to the sink */
+    uint32_t time_us;           /**< time spent in heatshrink in µs */
+} compress_stats_t;
+
+/**
+ * @brief   Compression stream
+ */
+typedef struct {
+    heatshrink_encoder enc;         /**< heatshrink state */
+    compress_sink_t sink;           /**< sink of the output */
+    void *arg;                      /**< argument of @p sink */
+    compress_stats_t stats;         /**< statistics */
+    uint16_t len;                   /**< bytes in @p buf */
+    uint8_t buf[CONFIG_COMPRESS_CHUNK_SIZE];    /**< output buffer */
+} compress_t;
+
+/**
+ * @brief   Decompression stream
+ */
+typedef struct {
+    heatshrink_decoder dec;         /**< heatshrink state */
+    compress_sink_t sink;           /**< sink of the output */
+    void *arg;                      /**< argument of @p sink */
+    compress_stats_t stats;         /**< statistics, compressed bytes in */
+    uint16_t len;                   /**< bytes in @p buf */
+    uint8_t buf[CONFIG_COMPRESS_CHUNK_SIZE];    /**< output buffer */
+} decompress_t;
+
+/**
+ * @brief   Starts a compression stream
+ *
+ * A stream can be started again once finished.
+ *
+ * @param[out] ctx      stream
+ * @param[in] sink      sink of the compressed data
+ * @param[in] arg       argument of @p sink
+ */
+void compress_init(compress_t *ctx, compress_sink_t sink, void *arg);
+
+/**
+ * @brief   Compresses data
+ *
+ * @param[in,out] ctx   stream
+ * @param[in] data      data to compress
+ * @param[in] len       length of @p data
+ *
+ * @return  0 on success
+ * @return  -EIO on heatshrink errors
+ * @return  < 0 on sink errors
+ */
+int compress_write(compress_t *ctx, const void *data, size_t len);
+
+/**
+ * @brief   Finishes a compression stream and passes the rest of the output
+ *          to the sink
+ *
+ * @param[in,out] ctx   stream
+ *
+ * @return  0 on success
+ * @return  -EIO on heatshrink errors
+ * @return  < 0 on sink errors
+ */
+int compress_finish(compress_t *ctx);
+
+/**
+ * @brief   Compresses a buffer
+ *
+ * Needs a @ref compress_t on the stack, about 1.5 KiB with the default
+ * window of the package.
+ *
+ * @param[in] in        data to compress
+ * @param[in] len       length of @p in
+ * @param[out] out      buffer for the compressed data
+ * @param[in] size      size of @p out
+ * @param[out] stats    statistics, may be NULL
+ *
+ * @return  length of the compressed data
+ * @return  -ENOBUFS if it does not fit into @p out
+ * @return  -EIO on heatshrink errors
+ */
+ssize_t compress_buf(const void *in, size_t len, void *out, size_t size,
+                     compress_stats_t *stats);
+
+/**
+ * @brief   Starts a decompression stream
+ *
+ * @param[out] ctx      stream
+ * @param[in] sink      sink of the decompressed data
+ * @param[in] arg       argument of @p sink
+ */
+void decompress_init(decompress_t *ctx, compress_sink_t sink, void *arg);
+
+/**
+ * @brief   Decompresses data
+ *
+ * @param[in,out] ctx   stream
+ * @param[in] data      compressed data
+ * @param[in] len       length of @p data
+ *
+ * @return  0 on success
+ * @return  -EIO on heatshrink errors
+ * @return  < 0 on sink errors
+ */
+int decompress_write(decompress_t *ctx, const void *data, size_t len);
+
+/**
+ * @brief   Finishes a decompression stream and passes the rest of the
+ *          output to the sink
+ *
+ * @param[in,out] ctx   stream
+ *
+ * @return  0 on success
+ * @return  -EIO on heatshrink errors or truncated input
+ * @return  < 0 on sink errors
+ */
+int decompress_finish(decompress_t *ctx);
+
+/**
+ * @brief   Gets the size of the output relative to the input
+ *
+ * @param[in] stats     statistics of a compression stream
+ *
+ * @return  output size in per mille of the input size, 1000 if there was
+ *          no input
+ */
+static inline unsigned compress_ratio(const compress_stats_t *stats)
+{
+    return stats->in ? (unsigned)(((uint64_t)stats->out * 1000) / stats->in)
+                     : 1000;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* COMPRESS_H */
+/** @} */
@@ -48,6 +48,21 @@ typedef uint8_t u8;
 #define AES_BLOCK_SIZE    16
 #define AES_KEY_SIZE      16
 
+/**
+ * @brief   Fall back to the software implementation if the hardware AES
+ *          engine rejects a request
+ *
+ * The fallback is only taken if the engine does not support the request
+ * (`-ENOTSUP`). Hardware errors are reported, since they may happen after
+ * part of the output has been written.
+ *
+ * Only relevant if the `periph_crypto` feature is used. Without the fallback
+ * the linker can drop the lookup tables of the software implementation.
+ */
+#ifndef CONFIG_CRYPTO_AES_SW_FALLBACK
+#define CONFIG_CRYPTO_AES_SW_FALLBACK   1
+#endif
+
 /**
  * @brief AES key
  * @see cipher_context_t
@@ -126,6 +141,44 @@ int aes_encrypt(const cipher_context_t *context, const uint8_t *plain_block,
 int aes_decrypt(const cipher_context_t *context, const uint8_t *cipher_block,
                 uint8_t *plain_block);
 
+/**
+ * @brief   encrypts consecutive blocks independently (ECB)
+ *
+ * The key schedule is only computed once for all blocks.
+ *
+ * @param       context       the cipher_context_t-struct to use for this
+ *                            encryption
+ * @param       input         the plaintext blocks
+ * @param       output        the place where the ciphertext will be stored,
+ *                            may be the same as @p input
+ * @param       blocks        number of blocks
+ *
+ * @return  1 on success
+ * @return  A negative value if the cipher key cannot be expanded with the
+ *          AES key schedule
+ */
+int aes_encrypt_blocks(const cipher_context_t *context, const uint8_t *input,
+                       uint8_t *output, size_t blocks);
+
+/**
+ * @brief   decrypts consecutive blocks independently (ECB)
+ *
+ * The key schedule is only computed once for all blocks.
+ *
+ * @param       context       the cipher_context_t-struct to use for this
+ *                            decryption
+ * @param       input         the ciphertext blocks
+ * @param       output        the place where the plaintext will be stored,
+ *                            may be the same as @p input
+ * @param       blocks        number of blocks
+ *
+ * @return  1 on success
+ * @return  A negative value if the cipher key cannot be expanded with the
+ *          AES key schedule
+ */
+int aes_decrypt_blocks(const cipher_context_t *context, const uint8_t *input,
+                       uint8_t *output, size_t blocks);
+
 #ifdef __cplusplus
 }
 #endif
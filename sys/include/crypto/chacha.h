@@ -28,6 +28,9 @@
  * @file
  * @brief       ChaCha stream cipher
  *
+ * The `crypto_chacha_unroll` module unrolls the rounds, which costs flash
+ * but is much faster. It is used by default on Cortex-M4 and M7.
+ *
  * @author      René Kijewski <rene.kijewski@fu-berlin.de>
  */
 
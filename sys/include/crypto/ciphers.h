@@ -22,6 +22,7 @@
 #ifndef CRYPTO_CIPHERS_H
 #define CRYPTO_CIPHERS_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -89,6 +90,16 @@ typedef struct cipher_interface_st {
     /** the decrypt function */
     int (*decrypt)(const cipher_context_t *ctx, const uint8_t *cipher_block,
                    uint8_t *plain_block);
+
+    /** encrypt consecutive blocks independently, optional, returns 1 on
+     *  success */
+    int (*encrypt_blocks)(const cipher_context_t *ctx, const uint8_t *input,
+                          uint8_t *output, size_t blocks);
+
+    /** decrypt consecutive blocks independently, optional, returns 1 on
+     *  success */
+    int (*decrypt_blocks)(const cipher_context_t *ctx, const uint8_t *input,
+                          uint8_t *output, size_t blocks);
 } cipher_interface_t;
 
 
@@ -162,6 +173,41 @@ int cipher_decrypt(const cipher_t *cipher, const uint8_t *input,
                    uint8_t *output);
 
 
+/**
+ * @brief Encrypt several blocks of BLOCK_SIZE length independently
+ *
+ * Uses the multi-block hook of the cipher if it provides one, which allows
+ * e.g. hardware engines or the key schedule to be set up only once.
+ *
+ * @param cipher     Already initialized cipher struct
+ * @param input      pointer to the input blocks
+ * @param output     pointer to memory for the output blocks, may be the same
+ *                   as @p input
+ * @param blocks     number of blocks
+ *
+ * @return           1 on success
+ * @return           A negative value for an error
+ */
+int cipher_encrypt_blocks(const cipher_t *cipher, const uint8_t *input,
+                          uint8_t *output, size_t blocks);
+
+
+/**
+ * @brief Decrypt several blocks of BLOCK_SIZE length independently
+ *
+ * @param cipher     Already initialized cipher struct
+ * @param input      pointer to the input blocks
+ * @param output     pointer to memory for the output blocks, may be the same
+ *                   as @p input
+ * @param blocks     number of blocks
+ *
+ * @return           1 on success
+ * @return           A negative value for an error
+ */
+int cipher_decrypt_blocks(const cipher_t *cipher, const uint8_t *input,
+                          uint8_t *output, size_t blocks);
+
+
 /**
  * @brief Get block size of cipher
  * *
@@ -0,0 +1,432 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_dsp_pipeline DSP pipeline
+ * @ingroup     sys
+ * @brief       Streaming signal processing with composable CMSIS-DSP stages
+ *
+ * A pipeline is a chain of stages (FIR and IIR filters, decimation, FFT,
+ * RMS, sinks and custom stages) that pass blocks of `q15_t` samples to each
+ * other. Blocks are taken from a fixed pool of the pipeline and are handed
+ * over by reference, never copied: stages that can work in place (IIR, FFT,
+ * RMS, sinks) write their result into the block they received, the others
+ * write into a block from the pool and release their input.
+ *
+ * Every stage has an input queue and an event. Pushing a block to a stage
+ * posts its event to the event queue of the pipeline, so all stages run in
+ * the thread handling that queue (e.g. one of the @ref event_thread queues),
+ * one block per event. The CPU time spent in each stage is accounted in
+ * @ref BENCHMARK_UNIT and can be printed with dsp_pipeline_print().
+ *
+ * Samples enter the pipeline with dsp_stage_push(), or directly from the
+ * DMA buffer of @ref adc_continuous_start with a @ref dsp_adc_t source:
+ *
+ * ```c
+ * static dsp_block_t blocks[4];
+ * static q15_t samples[4][BLOCK];
+ * static uint16_t dma[2 * BLOCK];
+ *
+ * dsp_pipeline_init(&pipe, EVENT_PRIO_MEDIUM, blocks, 4, samples[0], BLOCK);
+ * dsp_adc_init(&adc, &pipe);
+ * dsp_iir_init(&hp, &pipe, 1, hp_coeffs, hp_state, 1);
+ * dsp_rms_init(&rms, &pipe);
+ * dsp_sink_init(&out, &pipe, _print_rms, NULL);
+ * dsp_stage_connect(&adc.super, &hp.super);
+ * dsp_stage_connect(&hp.super, &rms.super);
+ * dsp_stage_connect(&rms.super, &out.super);
+ * dsp_adc_start(&adc, ADC_LINE(0), ADC_RES_12BIT, 8000, dma, 2 * BLOCK);
+ * ```
+ *
+ * @note    The stages are based on the `cmsis-dsp` package and are only
+ *          available on Cortex-M
+ *
+ * @{
+ *
+ * @file
+ * @brief       DSP pipeline interface
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+
+#ifndef DSP_PIPELINE_H
+#define DSP_PIPELINE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "arm_math.h"
+#include "event.h"
+
+#ifdef MODULE_PERIPH_ADC_CONTINUOUS
+#include "periph/adc.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Block type
+ */
+typedef struct dsp_block dsp_block_t;
+
+/**
+ * @brief   Block of samples passed between stages
+ */
+struct dsp_block {
+    dsp_block_t *next;                  /**< next block in a queue */
+    q15_t *data;                        /**< the samples */
+    uint16_t len;                       /**< number of samples */
+    /**
+     * @brief   Called instead of returning the block to the pool, for
+     *          blocks referring to memory outside of the pool
+     */
+    void (*release)(dsp_block_t *block);
+    void *arg;                          /**< argument of dsp_block::release */
+};
+
+/**
+ * @brief   Stage type
+ */
+typedef struct dsp_stage dsp_stage_t;
+
+/**
+ * @brief   Pipeline
+ */
+typedef struct {
+    event_queue_t *queue;               /**< queue running the stages */
+    dsp_block_t *free;                  /**< free blocks of the pool */
+    dsp_stage_t *stages;                /**< all stages, for statistics */
+    uint16_t block_size;                /**< samples per pool block */
+} dsp_pipeline_t;
+
+/**
+ * @brief   Process a block
+ *
+ * @param[in]   stage   the stage
+ * @param[in]   in      input block
+ * @param[out]  out     output block of dsp_pipeline_t::block_size samples,
+ *                      the same as @p in for stages working in place
+ *
+ * @return  number of samples written to @p out, to pass it on
+ * @return  0 if there is no output for this block
+ * @return  negative errno value on error, the block is dropped
+ */
+typedef int (*dsp_process_t)(dsp_stage_t *stage, dsp_block_t *in,
+                             dsp_block_t *out);
+
+/**
+ * @brief   Statistics of a stage
+ */
+typedef struct {
+    uint32_t blocks;                    /**< processed blocks */
+    uint32_t drops;                     /**< blocks dropped on errors, pool
+                                             exhaustion or overruns */
+    uint64_t time;                      /**< total processing time in
+                                             @ref BENCHMARK_UNIT */
+    uint32_t max;                       /**< longest processing time of a
+                                             block */
+} dsp_stage_stats_t;
+
+/**
+ * @brief   Stage of a pipeline
+ */
+struct dsp_stage {
+    event_t super;                      /**< processes the input queue */
+    dsp_pipeline_t *pipeline;           /**< the pipeline */
+    dsp_stage_t *next;                  /**< stage to pass output to */
+    dsp_stage_t *list;                  /**< next stage of the pipeline */
+    dsp_block_t *head;                  /**< first block of the input queue */
+    dsp_block_t *tail;                  /**< last block of the input queue */
+    dsp_process_t process;              /**< processing function */
+    const char *name;                   /**< name in the statistics */
+    bool in_place;                      /**< output into the input block */
+    dsp_stage_stats_t stats;            /**< statistics */
+};
+
+/**
+ * @brief   Initialize a pipeline
+ *
+ * @param[out]  pipe        pipeline to initialize
+ * @param[in]   queue       event queue to run the stages from
+ * @param[in]   blocks      block descriptors of the pool
+ * @param[in]   numof       number of elements of @p blocks
+ * @param[in]   samples     sample memory of the pool, `numof * block_size`
+ *                          samples
+ * @param[in]   block_size  samples per block
+ */
+void dsp_pipeline_init(dsp_pipeline_t *pipe, event_queue_t *queue,
+                       dsp_block_t *blocks, unsigned numof, q15_t *samples,
+                       uint16_t block_size);
+
+/**
+ * @brief   Print the statistics of all stages of a pipeline
+ *
+ * @param[in]   pipe        the pipeline
+ */
+void dsp_pipeline_print(const dsp_pipeline_t *pipe);
+
+/**
+ * @brief   Take a block from the pool, from any context
+ *
+ * @param[in]   pipe        the pipeline
+ *
+ * @return  a block of dsp_pipeline_t::block_size samples
+ * @return  NULL if the pool is exhausted
+ */
+dsp_block_t *dsp_block_alloc(dsp_pipeline_t *pipe);
+
+/**
+ * @brief   Return a block to the pool or to its owner, from any context
+ *
+ * @param[in]   pipe        the pipeline
+ * @param[in]   block       the block
+ */
+void dsp_block_release(dsp_pipeline_t *pipe, dsp_block_t *block);
+
+/**
+ * @brief   Initialize a custom stage
+ *
+ * @param[out]  stage       stage to initialize
+ * @param[in]   pipe        pipeline of the stage
+ * @param[in]   name        name in the statistics
+ * @param[in]   process     processing function
+ * @param[in]   in_place    true if @p process writes into its input block
+ */
+void dsp_stage_init(dsp_stage_t *stage, dsp_pipeline_t *pipe,
+                    const char *name, dsp_process_t process, bool in_place);
+
+/**
+ * @brief   Pass the output of @p from to @p to
+ *
+ * @param[in,out]   from    upstream stage
+ * @param[in]       to      downstream stage
+ */
+static inline void dsp_stage_connect(dsp_stage_t *from, dsp_stage_t *to)
+{
+    from->next = to;
+}
+
+/**
+ * @brief   Queue a block for processing by @p stage, from any context
+ *
+ * @param[in]   stage       the stage
+ * @param[in]   block       the block, released by the pipeline
+ */
+void dsp_stage_push(dsp_stage_t *stage, dsp_block_t *block);
+
+/**
+ * @brief   FIR filter stage
+ */
+typedef struct {
+    dsp_stage_t super;                  /**< stage */
+    arm_fir_instance_q15 fir;           /**< CMSIS-DSP filter */
+} dsp_fir_t;
+
+/**
+ * @brief   Initialize a FIR filter stage
+ *
+ * @param[out]  stage       stage to initialize
+ * @param[in]   pipe        pipeline of the stage
+ * @param[in]   coeffs      coefficients in time reversed order
+ * @param[in]   num_taps    number of coefficients, even and at least 4
+ * @param[in]   state       state buffer of `num_taps + block_size - 1`
+ *                          samples
+ *
+ * @return  0 on success
+ * @return  -EINVAL if @p num_taps is not supported
+ */
+int dsp_fir_init(dsp_fir_t *stage, dsp_pipeline_t *pipe, const q15_t *coeffs,
+                 uint16_t num_taps, q15_t *state);
+
+/**
+ * @brief   Decimation stage, a FIR filter keeping every M-th sample
+ */
+typedef struct {
+    dsp_stage_t super;                  /**< stage */
+    arm_fir_decimate_instance_q15 fir;  /**< CMSIS-DSP filter */
+} dsp_decimate_t;
+
+/**
+ * @brief   Initialize a decimation stage
+ *
+ * @param[out]  stage       stage to initialize
+ * @param[in]   pipe        pipeline of the stage
+ * @param[in]   factor      decimation factor M, block lengths must be a
+ *                          multiple of it
+ * @param[in]   coeffs      coefficients of the anti-aliasing filter in time
+ *                          reversed order
+ * @param[in]   num_taps    number of coefficients
+ * @param[in]   state       state buffer of `num_taps + block_size - 1`
+ *                          samples
+ *
+ * @return  0 on success
+ * @return  -EINVAL if @p factor does not divide the block size
+ */
+int dsp_decimate_init(dsp_decimate_t *stage, dsp_pipeline_t *pipe,
+                      uint8_t factor, const q15_t *coeffs, uint16_t num_taps,
+                      q15_t *state);
+
+/**
+ * @brief   IIR filter stage, a cascade of biquads, works in place
+ */
+typedef struct {
+    dsp_stage_t super;                  /**< stage */
+    arm_biquad_casd_df1_inst_q15 iir;   /**< CMSIS-DSP filter */
+} dsp_iir_t;
+
+/**
+ * @brief   Initialize an IIR filter stage
+ *
+ * @param[out]  stage       stage to initialize
+ * @param[in]   pipe        pipeline of the stage
+ * @param[in]   num_stages  number of biquads
+ * @param[in]   coeffs      `{b0, 0, b1, b2, a1, a2}` for each biquad
+ * @param[in]   state       state buffer of `4 * num_stages` samples
+ * @param[in]   post_shift  shift of the accumulator, to allow coefficients
+ *                          beyond [-1, 1)
+ */
+void dsp_iir_init(dsp_iir_t *stage, dsp_pipeline_t *pipe, uint8_t num_stages,
+                  const q15_t *coeffs, q15_t *state, int8_t post_shift);
+
+/**
+ * @brief   FFT stage, outputs the magnitudes of the first half of the
+ *          bins, works in place
+ */
+typedef struct {
+    dsp_stage_t super;                  /**< stage */
+    arm_rfft_instance_q15 fft;          /**< CMSIS-DSP transform */
+    q15_t *scratch;                     /**< complex spectrum */
+    uint16_t len;                       /**< transform length */
+} dsp_fft_t;
+
+/**
+ * @brief   Initialize an FFT stage
+ *
+ * Input blocks must have @p len samples, output blocks have `len / 2`
+ * magnitudes, scaled down by the transform as documented for
+ * `arm_rfft_q15`.
+ *
+ * @param[out]  stage       stage to initialize
+ * @param[in]   pipe        pipeline of the stage
+ * @param[in]   len         transform length, a power of two from 32 to 8192
+ * @param[in]   scratch     buffer of `2 * len` samples
+ *
+ * @return  0 on success
+ * @return  -EINVAL if @p len is not supported
+ */
+int dsp_fft_init(dsp_fft_t *stage, dsp_pipeline_t *pipe, uint16_t len,
+                 q15_t *scratch);
+
+/**
+ * @brief   RMS stage, outputs a single sample per block, works in place
+ */
+typedef struct {
+    dsp_stage_t super;                  /**< stage */
+} dsp_rms_t;
+
+/**
+ * @brief   Initialize an RMS stage
+ *
+ * @param[out]  stage       stage to initialize
+ * @param[in]   pipe        pipeline of the stage
+ */
+void dsp_rms_init(dsp_rms_t *stage, dsp_pipeline_t *pipe);
+
+/**
+ * @brief   Callback of a sink stage
+ *
+ * @param[in]   arg         argument given to dsp_sink_init()
+ * @param[in]   data        the samples, only valid during the call
+ * @param[in]   len         number of samples
+ */
+typedef void (*dsp_sink_cb_t)(void *arg, const q15_t *data, size_t len);
+
+/**
+ * @brief   Sink stage, hands the blocks to a callback
+ */
+typedef struct {
+    dsp_stage_t super;                  /**< stage */
+    dsp_sink_cb_t cb;                   /**< callback */
+    void *arg;                          /**< argument of the callback */
+} dsp_sink_t;
+
+/**
+ * @brief   Initialize a sink stage
+ *
+ * @param[out]  stage       stage to initialize
+ * @param[in]   pipe        pipeline of the stage
+ * @param[in]   cb          callback receiving the blocks
+ * @param[in]   arg         argument of @p cb
+ */
+void dsp_sink_init(dsp_sink_t *stage, dsp_pipeline_t *pipe, dsp_sink_cb_t cb,
+                   void *arg);
+
+#if defined(MODULE_PERIPH_ADC_CONTINUOUS) || defined(DOXYGEN)
+/**
+ * @brief   Source stage sampling an ADC line continuously
+ *
+ * Each half of the DMA buffer is converted to `q15_t` in place and passed
+ * on as a block without copying. If a half is filled again before the
+ * pipeline released it, the new samples are dropped and counted as drops of
+ * this stage.
+ *
+ * @note    Requires the `periph_adc_continuous` feature
+ */
+typedef struct {
+    dsp_stage_t super;                  /**< stage, passes the halves on */
+    dsp_block_t half[2];                /**< the halves of the DMA buffer */
+    uint16_t *buf;                      /**< the DMA buffer */
+    uint8_t shift;                      /**< scales samples to 16 bit */
+    uint8_t last;                       /**< half filled last */
+    volatile uint8_t pending;           /**< filled halves to convert */
+    volatile uint8_t busy;              /**< halves in the pipeline */
+} dsp_adc_t;
+
+/**
+ * @brief   Initialize an ADC source
+ *
+ * @param[out]  src         source to initialize, connect it to the first
+ *                          stage with dsp_stage_connect()
+ * @param[in]   pipe        pipeline to feed
+ */
+void dsp_adc_init(dsp_adc_t *src, dsp_pipeline_t *pipe);
+
+/**
+ * @brief   Start sampling into the pipeline
+ *
+ * @param[in,out]   src     the source
+ * @param[in]   line        ADC line to sample, initialized with adc_init()
+ * @param[in]   res         resolution
+ * @param[in]   freq        sample rate in Hz
+ * @param[out]  buf         DMA buffer
+ * @param[in]   len         number of samples in @p buf, twice the block size
+ *                          of the pipeline
+ *
+ * @return  0 on success
+ * @return  -EINVAL on invalid arguments
+ */
+int dsp_adc_start(dsp_adc_t *src, adc_t line, adc_res_t res, uint32_t freq,
+                  uint16_t *buf, size_t len);
+
+/**
+ * @brief   Stop sampling
+ *
+ * @param[in]   src         the source
+ */
+void dsp_adc_stop(dsp_adc_t *src);
+#endif /* MODULE_PERIPH_ADC_CONTINUOUS */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DSP_PIPELINE_H */
+/** @} */
@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_energy Energy accounting
+ * @ingroup     sys
+ * @brief       Time spent in each power state per subsystem and the
+ *              estimated charge drawn
+ *
+ * Every subsystem with power states of its own is an energy domain
+ * (@ref energy_domain_t). On each change of its state, the time since the
+ * last change is added to the residency of the previous state and, given the
+ * current drawn in that state, to the charge of the domain. Time is measured
+ * with `ZTIMER_MSEC`, which should keep running in all power modes used.
+ *
+ * The following domains are built in, if the respective module is used:
+ *
+ * | Domain         | Module       | States                                    |
+ * |----------------|--------------|-------------------------------------------|
+ * | `energy_cpu`   | `pm_layered` | power modes, idle (@ref PM_NUM_MODES) and running |
+ * | `energy_radio` | `gnrc_netif` | @ref netopt_state_t                       |
+ * | `energy_mtd`   | `mtd`        | @ref mtd_power_state                      |
+ *
+ * The radio domain follows @ref NETOPT_STATE set through
+ * gnrc_netif_set_from_netdev() and the TX and RX events of the device. It
+ * is shared by all interfaces, as is the MTD domain by all MTD devices.
+ *
+ * Other subsystems, e.g. a UART switched with uart_poweron() and
+ * uart_poweroff(), are accounted by defining a domain and calling
+ * energy_set_state() next to the state changes:
+ *
+ * ```c
+ * static const uint32_t _uart_ua[] = { 0, 150 };
+ * static energy_domain_t _uart = ENERGY_DOMAIN_INIT(_uart, "energy_uart",
+ *                                                   _uart_ua, 1);
+ *
+ * metrics_register(&_uart.group);
+ * ...
+ * uart_poweroff(UART_DEV(1));
+ * energy_set_state(&_uart, 0);
+ * ```
+ *
+ * Boards define the current in µA per state of the built-in domains as
+ * initializers @ref ENERGY_CPU_CURRENT_UA, @ref ENERGY_RADIO_CURRENT_UA and
+ * @ref ENERGY_MTD_CURRENT_UA. Without figures, only the residency is
+ * recorded.
+ *
+ * All domains are exported by the @ref sys_metrics registry, i.e. by the
+ * `metrics` shell command and via CoAP with module `metrics_coap`. The time
+ * in the current state is added on the next change of state or
+ * energy_update().
+ *
+ * @{
+ *
+ * @file
+ * @brief       Energy accounting interface
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+
+#ifndef ENERGY_H
+#define ENERGY_H
+
+#include <stdint.h>
+
+#include "metrics.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Maximum number of states of a domain
+ */
+#ifndef CONFIG_ENERGY_STATES_NUMOF
+#define CONFIG_ENERGY_STATES_NUMOF  (8U)
+#endif
+
+#if defined(DOXYGEN)
+/**
+ * @brief   Current in µA per power mode of the CPU, followed by idle and
+ *          running, defined by the board, e.g. `{ 2, 40, 900, 1800, 4200 }`
+ */
+#define ENERGY_CPU_CURRENT_UA
+/**
+ * @brief   Current in µA of the radio per @ref netopt_state_t, defined by
+ *          the board
+ */
+#define ENERGY_RADIO_CURRENT_UA
+/**
+ * @brief   Current in µA per @ref mtd_power_state, defined by the board
+ */
+#define ENERGY_MTD_CURRENT_UA
+#endif
+
+/**
+ * @brief   Exported statistics of a domain
+ */
+typedef struct {
+    uint32_t charge_uah;                            /**< estimated charge
+                                                         in µAh */
+    uint32_t time_ms[CONFIG_ENERGY_STATES_NUMOF];   /**< residency per
+                                                         state in ms */
+} energy_stats_t;
+
+/**
+ * @brief   Energy domain
+ */
+typedef struct {
+    energy_stats_t stats;       /**< statistics */
+    metrics_group_t group;      /**< metrics group exporting @p stats */
+    const uint32_t *current_ua; /**< current per state in µA, may be NULL */
+    uint32_t since;             /**< ZTIMER_MSEC time of the last update */
+    uint32_t rest;              /**< charge below 1 µAh in µA * ms */
+    uint8_t state;              /**< current state */
+} energy_domain_t;
+
+/**
+ * @brief   Metrics describing @ref energy_stats_t
+ */
+extern const metrics_entry_t energy_metrics_entries[2];
+
+/**
+ * @brief   Static initializer of a domain
+ *
+ * @param[in]   var         the domain variable itself
+ * @param[in]   name        name of the domain
+ * @param[in]   current     array of the current per state in µA, or NULL
+ * @param[in]   init_state  initial state
+ */
+#define ENERGY_DOMAIN_INIT(var, name, current, init_state) { \
+        .group = METRICS_GROUP(name, (var).stats, energy_metrics_entries), \
+        .current_ua = current, \
+        .state = init_state, \
+    }
+
+#if defined(MODULE_PM_LAYERED) || defined(DOXYGEN)
+/**
+ * @brief   Domain of the CPU
+ */
+extern energy_domain_t energy_cpu;
+#endif
+
+#if defined(MODULE_GNRC_NETIF) || defined(DOXYGEN)
+/**
+ * @brief   Domain of the radios
+ */
+extern energy_domain_t energy_radio;
+#endif
+
+#if defined(MODULE_MTD) || defined(DOXYGEN)
+/**
+ * @brief   Domain of the MTD devices
+ */
+extern energy_domain_t energy_mtd;
+#endif
+
+/**
+ * @brief   Changes the state of a domain
+ *
+ * Can be called from interrupt context.
+ *
+ * @param[in,out]   dom     the domain
+ * @param[in]       state   new state, below @ref CONFIG_ENERGY_STATES_NUMOF
+ */
+void energy_set_state(energy_domain_t *dom, unsigned state);
+
+/**
+ * @brief   Accounts the time in the current state up to now
+ *
+ * @param[in,out]   dom     the domain
+ */
+void energy_update(energy_domain_t *dom);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ENERGY_H */
+/** @} */
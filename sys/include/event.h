@@ -47,6 +47,18 @@
  * to be queued. Thus event queues can be used safely and efficiently in combination
  * with thread flags and msg queues.
  *
+ * With module `event_lockfree`, event_post() does not disable interrupts.
+ * This applies to all event queues, including those of `event_thread` and of
+ * interfaces using `gnrc_netif_events`.
+ * Posted events are pushed to a lock-free stack using atomic compare and swap
+ * (LDREX/STREX on ARMv7-M), which the waiting thread moves to the actual queue
+ * when it runs out of events. This keeps interrupt latency low when ISRs or
+ * many threads post at high rates, at the cost of one larger critical section
+ * bounded by the number of events posted meanwhile on the consumer side. The
+ * order of events is kept. On platforms without atomic instructions (e.g.
+ * ARMv6-M), the atomic operations themselves fall back to short critical
+ * sections.
+ *
  * Examples:
  *
  * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
@@ -99,6 +111,7 @@
 #include <stdint.h>
 
 #include "irq.h"
+#include "kernel_defines.h"
 #include "thread_flags.h"
 #include "clist.h"
 
@@ -146,6 +159,13 @@ struct event {
  */
 typedef struct {
     clist_node_t event_list;    /**< list of queued events              */
+#if IS_USED(MODULE_EVENT_LOCKFREE) || defined(DOXYGEN)
+    /**
+     * @brief   Events posted but not yet moved to event_queue_t::event_list,
+     *          newest first
+     */
+    clist_node_t *pending;
+#endif
     thread_t *waiter;           /**< thread ownning event queue         */
 } event_queue_t;
 
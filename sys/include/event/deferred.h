@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_event
+ * @brief       Deferred work items for driver bottom halves
+ *
+ * A deferred work item moves work out of an ISR into one of the shared
+ * event threads (see @ref EVENT_PRIO_HIGHEST and friends), so that a driver
+ * does not need a thread, and a stack, of its own.
+ *
+ * Posting an item that is still pending does not queue it again, the posts
+ * are coalesced into a single run of the handler. Thus every queue holds
+ * at most one entry per item and never grows beyond the number of items
+ * using it. A post while the handler runs queues the item again, so no
+ * post is ever lost.
+ *
+ * Each item may have a deadline, i.e. the time in µs between the first post
+ * and the start of the handler that it must not exceed. Runs that start
+ * later are counted as misses. Along with the time the handler took, this
+ * tells whether the item is on a thread of the right priority.
+ *
+ * ```c
+ * static void _bottom_half(event_deferred_t *work)
+ * {
+ *     my_dev_t *dev = container_of(work, my_dev_t, work);
+ *     ...
+ * }
+ *
+ * event_deferred_init(&dev->work, EVENT_PRIO_HIGHEST, _bottom_half, 500);
+ *
+ * static void _isr(void *arg)
+ * {
+ *     my_dev_t *dev = arg;
+ *     event_deferred_post(&dev->work);
+ * }
+ * ```
+ *
+ * @{
+ *
+ * @file
+ * @brief       Deferred work item API
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+
+#ifndef EVENT_DEFERRED_H
+#define EVENT_DEFERRED_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "event.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Deferred work item forward declaration
+ */
+typedef struct event_deferred event_deferred_t;
+
+/**
+ * @brief   Deferred work handler
+ *
+ * @param[in] work  the work item that was posted
+ */
+typedef void (*event_deferred_handler_t)(event_deferred_t *work);
+
+/**
+ * @brief   Statistics of a deferred work item, times in µs
+ */
+typedef struct {
+    uint32_t runs;          /**< number of runs of the handler */
+    uint32_t coalesced;     /**< posts merged into a pending run */
+    uint32_t misses;        /**< runs started after the deadline */
+    uint32_t latency_max;   /**< longest time from post to start of a run */
+    uint32_t exec_max;      /**< longest run of the handler */
+    uint64_t exec_total;    /**< time spent in the handler in total */
+} event_deferred_stats_t;
+
+/**
+ * @brief   Deferred work item
+ */
+struct event_deferred {
+    event_t super;                      /**< event posted to the queue */
+    event_queue_t *queue;               /**< queue to run the handler on */
+    event_deferred_handler_t handler;   /**< handler of the work */
+    uint32_t deadline;                  /**< latest start after the first
+                                             post in µs, 0 for none */
+    uint32_t posted;                    /**< time of the first post */
+    bool pending;                       /**< posted, handler not run yet */
+    event_deferred_stats_t stats;       /**< statistics */
+};
+
+/**
+ * @brief   Initializes a deferred work item
+ *
+ * @param[out] work     work item to initialize
+ * @param[in] queue     queue to run the handler on, e.g.
+ *                      @ref EVENT_PRIO_HIGHEST
+ * @param[in] handler   handler of the work
+ * @param[in] deadline  latest start of the handler after the first post in
+ *                      µs, 0 for none
+ */
+void event_deferred_init(event_deferred_t *work, event_queue_t *queue,
+                         event_deferred_handler_t handler, uint32_t deadline);
+
+/**
+ * @brief   Posts a deferred work item
+ *
+ * Does nothing but count the post if the item is pending already.
+ *
+ * @note    May be called from ISR context.
+ *
+ * @param[in,out] work  work item to post
+ */
+void event_deferred_post(event_deferred_t *work);
+
+/**
+ * @brief   Cancels a pending deferred work item
+ *
+ * Does not wait for a run that started already.
+ *
+ * @param[in,out] work  work item to cancel
+ */
+void event_deferred_cancel(event_deferred_t *work);
+
+/**
+ * @brief   Checks whether a deferred work item is pending
+ *
+ * @param[in] work  work item
+ *
+ * @return  true if posted and the handler did not start yet
+ */
+static inline bool event_deferred_is_pending(const event_deferred_t *work)
+{
+    return work->pending;
+}
+
+/**
+ * @brief   Resets the statistics of a deferred work item
+ *
+ * @param[in,out] work  work item
+ */
+void event_deferred_stats_reset(event_deferred_t *work);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* EVENT_DEFERRED_H */
+/** @} */
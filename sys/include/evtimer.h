@@ -29,7 +29,13 @@
  *   the necessary fields, which can be extended as needed, and handlers define
  *   actions taken on timer triggers. Check out @ref evtimer_msg_event_t as
  *   example.
- * - uses @ref sys_xtimer "xtimer" as backend
+ * - uses @ref sys_xtimer "xtimer" as backend, or `ZTIMER_MSEC` with module
+ *   `evtimer_on_ztimer`
+ *
+ * All events share a single timer, armed for the head of a list of events
+ * sorted by their offset. With module `evtimer_on_ztimer`, that timer never
+ * wakes up the system earlier than needed for millisecond precision, and it
+ * profits from a @ref sys_ztimer_wheel "timing wheel" of `ZTIMER_MSEC`.
  *
  * @{
  *
@@ -45,8 +51,13 @@
 
 #include <stdint.h>
 
-#include "xtimer.h"
+#include "kernel_defines.h"
 #include "timex.h"
+#if IS_USED(MODULE_EVTIMER_ON_ZTIMER)
+#include "ztimer.h"
+#else
+#include "xtimer.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -69,7 +80,13 @@ typedef void(*evtimer_callback_t)(evtimer_event_t* event);
  * @brief   Event timer
  */
 typedef struct {
+#if IS_USED(MODULE_EVTIMER_ON_ZTIMER) || DOXYGEN
+    ztimer_t timer;                 /**< Timer */
+    uint32_t base;                  /**< `ZTIMER_MSEC` time the offset of the
+                                         first event is relative to */
+#else
     xtimer_t timer;                 /**< Timer */
+#endif
     evtimer_callback_t callback;    /**< Handler function for this evtimer's
                                          event type */
     evtimer_event_t *events;        /**< Event queue */
@@ -111,7 +128,11 @@ void evtimer_print(const evtimer_t *evtimer);
  */
 static inline uint32_t evtimer_now_msec(void)
 {
+#if IS_USED(MODULE_EVTIMER_ON_ZTIMER)
+    return ztimer_now(ZTIMER_MSEC);
+#else
     return xtimer_now_usec64() / US_PER_MS;
+#endif
 }
 
 /**
@@ -119,7 +140,12 @@ static inline uint32_t evtimer_now_msec(void)
  */
 static inline uint32_t evtimer_now_min(void)
 {
+#if IS_USED(MODULE_EVTIMER_ON_ZTIMER)
+    /* ztimer_now64 keeps this from wrapping along with the milliseconds */
+    return ztimer_now(ZTIMER_MSEC) / (MS_PER_SEC * SEC_PER_MIN);
+#else
     return xtimer_now_usec64() / (US_PER_SEC * SEC_PER_MIN);
+#endif
 }
 
 #ifdef __cplusplus
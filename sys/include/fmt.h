@@ -22,6 +22,8 @@
  * Mixing calls to standard @c printf from stdio.h with the @c print_xxx
  * functions in fmt, especially on the same output line, may cause garbled
  * output.
+ * Use a @ref fmt_writer_t to build output in a buffer and write it in one
+ * go.
  *
  * @{
  *
@@ -495,6 +497,130 @@ void print_float(float f, unsigned precision);
  */
 void print_str(const char* str);
 
+/**
+ * @brief   Output function of a @ref fmt_writer_t
+ *
+ * @param[in] arg   argument given to fmt_writer_init()
+ * @param[in] s     data to output
+ * @param[in] n     number of bytes to output
+ */
+typedef void (*fmt_sink_t)(void *arg, const char *s, size_t n);
+
+/**
+ * @brief   Buffered writer
+ *
+ * Collects the output of several fmt_writer_xxx() calls in a buffer and
+ * passes it to the sink in one go once the buffer is full, or on
+ * fmt_writer_flush(). Numbers are formatted right into the buffer. Unlike a
+ * sequence of print_xxx() calls, a line built this way reaches stdio in a
+ * single write and is not garbled by output of other threads.
+ */
+typedef struct {
+    fmt_sink_t sink;    /**< output function, NULL for print() */
+    void *arg;          /**< argument of the output function */
+    char *buf;          /**< buffer */
+    size_t size;        /**< size of the buffer */
+    size_t len;         /**< bytes in the buffer */
+} fmt_writer_t;
+
+/**
+ * @brief   Initializes a buffered writer
+ *
+ * @param[out] w    writer to initialize
+ * @param[in] buf   buffer to collect the output in
+ * @param[in] size  size of @p buf
+ * @param[in] sink  output function, NULL to output to stdout with print()
+ * @param[in] arg   argument passed to @p sink
+ */
+void fmt_writer_init(fmt_writer_t *w, char *buf, size_t size,
+                     fmt_sink_t sink, void *arg);
+
+/**
+ * @brief   Passes the buffered output on to the sink
+ *
+ * @param[in,out] w writer to flush
+ */
+void fmt_writer_flush(fmt_writer_t *w);
+
+/**
+ * @brief   Writes @p n bytes of @p s to a buffered writer
+ *
+ * Data that does not fit the buffer is passed to the sink right away.
+ *
+ * @param[in,out] w writer
+ * @param[in] s     data to write
+ * @param[in] n     number of bytes to write
+ */
+void fmt_writer_write(fmt_writer_t *w, const char *s, size_t n);
+
+/**
+ * @brief   Writes a string to a buffered writer
+ *
+ * @param[in,out] w writer
+ * @param[in] str   zero terminated string to write
+ */
+void fmt_writer_str(fmt_writer_t *w, const char *str);
+
+/**
+ * @brief   Writes a character to a buffered writer
+ *
+ * @param[in,out] w writer
+ * @param[in] c     character to write
+ */
+void fmt_writer_char(fmt_writer_t *w, char c);
+
+/**
+ * @brief   Writes a uint32 value as decimal to a buffered writer
+ *
+ * @param[in,out] w writer
+ * @param[in] val   value to write
+ */
+void fmt_writer_u32_dec(fmt_writer_t *w, uint32_t val);
+
+/**
+ * @brief   Writes an int32 value as decimal to a buffered writer
+ *
+ * @param[in,out] w writer
+ * @param[in] val   value to write
+ */
+void fmt_writer_s32_dec(fmt_writer_t *w, int32_t val);
+
+/**
+ * @brief   Writes a uint64 value as decimal to a buffered writer
+ *
+ * @param[in,out] w writer
+ * @param[in] val   value to write
+ */
+void fmt_writer_u64_dec(fmt_writer_t *w, uint64_t val);
+
+/**
+ * @brief   Writes an int64 value as decimal to a buffered writer
+ *
+ * @param[in,out] w writer
+ * @param[in] val   value to write
+ */
+void fmt_writer_s64_dec(fmt_writer_t *w, int64_t val);
+
+/**
+ * @brief   Writes a uint32 value as hex to a buffered writer, see
+ *          fmt_u32_hex()
+ *
+ * @param[in,out] w writer
+ * @param[in] val   value to write
+ */
+void fmt_writer_u32_hex(fmt_writer_t *w, uint32_t val);
+
+/**
+ * @brief   Writes a decimal fixed point number to a buffered writer, see
+ *          fmt_s32_dfp()
+ *
+ * @param[in,out] w         writer
+ * @param[in] val           value to write
+ * @param[in] fp_digits     number of digits after the decimal point,
+ *                          MUST be >= -7
+ */
+void fmt_writer_s32_dfp(fmt_writer_t *w, int32_t val, int fp_digits);
+
 /**
  * @brief Pad string to the left
  *
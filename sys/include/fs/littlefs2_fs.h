@@ -12,6 +12,34 @@
  * @ingroup     pkg_littlefs2
  * @brief       RIOT integration of littlefs version 2.x.y
  *
+ * ## Tuning
+ *
+ * Every member of littlefs_desc_t::config that is left 0 (or NULL) when the
+ * file system is mounted gets a default derived from the MTD device and the
+ * `CONFIG_LITTLEFS2_*` values below. Setting them before vfs_mount() tunes
+ * each mount on its own:
+ *
+ * ```c
+ * static uint8_t lookahead[64];
+ * static littlefs_desc_t fs_desc = {
+ *     .dev = MTD_0,
+ *     .config = {
+ *         .cache_size = 4 * 256,              // four pages of RAM cache
+ *         .lookahead_size = sizeof(lookahead),
+ *         .lookahead_buffer = lookahead,
+ *         .block_cycles = 100,
+ *     },
+ * };
+ * ```
+ *
+ * A larger `cache_size` saves repeated metadata reads of small files, a
+ * larger `lookahead_size` (a multiple of 8) speeds up the search for free
+ * blocks. The lookahead buffer must be provided if `lookahead_size` exceeds
+ * @ref CONFIG_LITTLEFS2_LOOKAHEAD_SIZE, the read and prog buffers if
+ * `cache_size` exceeds their static sizes, else mounting fails with
+ * `-EINVAL`. Stacking the file system on an @ref drivers_mtd_cache device
+ * additionally keeps recently used pages of the device in RAM.
+ *
  * @{
  *
  * @file
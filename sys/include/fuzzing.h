@@ -12,6 +12,11 @@
  *
  * @brief       Various utilities for fuzzing network applications.
  *
+ * Built with `TOOLCHAIN=afl-llvm`, applications that process their inputs
+ * in a fuzzing_loop() run in AFL's persistent mode: a single process
+ * handles up to @ref CONFIG_FUZZING_PERSISTENT_ITERATIONS inputs, with the
+ * state of GNRC reset in between.
+ *
  * @{
  * @file
  *
@@ -25,9 +30,18 @@
 extern "C" {
 #endif
 
+#include <stdbool.h>
+
 #include "net/ipv6/addr.h"
 #include "net/gnrc/pkt.h"
 
+/**
+ * @brief Number of inputs processed by a process in persistent mode
+ */
+#ifndef CONFIG_FUZZING_PERSISTENT_ITERATIONS
+#define CONFIG_FUZZING_PERSISTENT_ITERATIONS (10000U)
+#endif
+
 /**
  * @brief Initialize dummy network interface with given address.
  *
@@ -41,6 +55,10 @@ int fuzzing_init(ipv6_addr_t *addr, unsigned pfx_len);
 /**
  * @brief Read a network packet from the given file descriptor.
  *
+ * Once the packet is released (or, with gnrc_sock, once the next packet is
+ * requested), the input is considered processed. Without fuzzing_loop(),
+ * the application terminates then.
+ *
  * @param fd File descriptor to read packet from.
  * @param pkt Allocated packet structure to write packet to,
  *            will be resized accordingly.
@@ -49,6 +67,34 @@ int fuzzing_init(ipv6_addr_t *addr, unsigned pfx_len);
  */
 int fuzzing_read_packet(int fd, gnrc_pktsnip_t *pkt);
 
+/**
+ * @brief Loop condition of an application processing one input per
+ *        iteration.
+ *
+ * Waits until the packet of the previous iteration is processed and resets
+ * the NIB and the 6LoWPAN reassembly buffer. Registrations with netreg are
+ * kept, they belong to the setup of the application.
+ *
+ * ```c
+ * while (fuzzing_loop()) {
+ *     ... build pkt ...
+ *     fuzzing_read_packet(STDIN_FILENO, pkt);
+ *     gnrc_netapi_dispatch_receive(type, demux, pkt);
+ * }
+ * ```
+ *
+ * @return true if there is another input to process.
+ */
+bool fuzzing_loop(void);
+
+/**
+ * @brief Signals that the packet read by fuzzing_read_packet() was
+ *        processed.
+ *
+ * Called by GNRC, terminates the application unless fuzzing_loop() is used.
+ */
+void fuzzing_done(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -57,6 +57,17 @@
 extern "C" {
 #endif
 
+/**
+ * @brief    Use the hardware SHA-256 engine if the `periph_crypto_sha256`
+ *           feature is available
+ *
+ * The software implementation is used if this is set to 0 or if the engine
+ * reports an error.
+ */
+#ifndef CONFIG_HASHES_SHA256_PERIPH
+#define CONFIG_HASHES_SHA256_PERIPH     1
+#endif
+
 /**
  * @brief    Structure to hold the SHA-2XX context.
  */
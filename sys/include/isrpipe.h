@@ -65,6 +65,18 @@ void isrpipe_init(isrpipe_t *isrpipe, uint8_t *buf, size_t bufsize);
  */
 int isrpipe_write_one(isrpipe_t *isrpipe, uint8_t c);
 
+/**
+ * @brief   Put a chunk of data into the isrpipe's buffer
+ *
+ * @param[in]   isrpipe     isrpipe object to operate on
+ * @param[in]   buf         data to add to isrpipe buffer
+ * @param[in]   count       number of bytes in @p buf
+ *
+ * @returns     number of bytes added, less than @p count if the buffer
+ *              became full
+ */
+int isrpipe_write(isrpipe_t *isrpipe, const uint8_t *buf, size_t count);
+
 /**
  * @brief   Read data from isrpipe (blocking)
  *
@@ -22,6 +22,18 @@
  * It is important to know that using integer operations will result in lower
  * precision in the computed measures because of truncation.
  *
+ * Quantiles, e.g. tail latencies, are estimated in constant memory as well:
+ *
+ * - @ref matstat_p2_t tracks a single quantile with the P² algorithm of Jain
+ *   and Chlamtac in 5 markers. It is small and adapts to any range of
+ *   values, but cannot be merged.
+ * - @ref matstat_hist_t counts values in log-linear buckets, like HDR
+ *   histograms: exact below 2^`sub_bits`, with a relative error below
+ *   2^-`sub_bits` above. Any quantile can be read from it, and histograms
+ *   of the same layout can be merged.
+ *
+ * Quantiles are given in 1/65536, see @ref MATSTAT_QUANTILE.
+ *
  * @{
  * @file
  * @brief       Matstat library declarations
@@ -32,6 +44,7 @@
 #ifndef MATSTAT_H
 #define MATSTAT_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -109,6 +122,116 @@ uint64_t matstat_variance(const matstat_state_t *state);
  */
 void matstat_merge(matstat_state_t *dest, const matstat_state_t *src);
 
+/**
+ * @brief   Converts a quantile from a fraction, e.g. 0.99, to 1/65536
+ */
+#define MATSTAT_QUANTILE(x)     ((uint16_t)((x) * 65535 + 0.5))
+
+/**
+ * @brief   State of a P² quantile estimator
+ */
+typedef struct {
+    int32_t q[5];       /**< Marker heights */
+    int32_t n[5];       /**< Marker positions */
+    uint32_t count;     /**< Number of values added */
+    uint16_t p;         /**< Quantile to estimate in 1/65536 */
+} matstat_p2_t;
+
+/**
+ * @brief   Initializes a P² quantile estimator
+ *
+ * @param[out]  p2      Estimator
+ * @param[in]   p       Quantile to estimate in 1/65536
+ */
+void matstat_p2_init(matstat_p2_t *p2, uint16_t p);
+
+/**
+ * @brief   Add a sample to a P² quantile estimator
+ *
+ * @param[in]   p2      Estimator
+ * @param[in]   value   Value to add
+ */
+void matstat_p2_add(matstat_p2_t *p2, int32_t value);
+
+/**
+ * @brief   Get the estimated quantile
+ *
+ * Exact for up to 5 samples.
+ *
+ * @param[in]   p2      Estimator
+ *
+ * @return  Estimated quantile, 0 without samples
+ */
+int32_t matstat_p2_get(const matstat_p2_t *p2);
+
+/**
+ * @brief   Number of buckets of a histogram covering values below
+ *          2^@p max_bits, plus one for all larger values
+ *
+ * @param[in]   sub_bits    log2 of the buckets per power of two
+ * @param[in]   max_bits    log2 of the largest value to distinguish,
+ *                          > @p sub_bits
+ */
+#define MATSTAT_HIST_NUMOF(sub_bits, max_bits) \
+    ((((max_bits) - (sub_bits) + 1) << (sub_bits)) + 1)
+
+/**
+ * @brief   Log-linear histogram
+ */
+typedef struct {
+    uint32_t *buckets;  /**< Counters, one per bucket */
+    uint32_t count;     /**< Number of values added */
+    uint16_t numof;     /**< Number of buckets */
+    uint8_t sub_bits;   /**< log2 of the buckets per power of two */
+} matstat_hist_t;
+
+/**
+ * @brief   Initializes an empty histogram
+ *
+ * Values beyond the last bucket are counted in the last bucket.
+ *
+ * @param[out]  hist        Histogram
+ * @param[in]   buckets     Memory for the counters, e.g.
+ *                          `uint32_t buckets[MATSTAT_HIST_NUMOF(3, 16)]`
+ * @param[in]   numof       Number of elements of @p buckets
+ * @param[in]   sub_bits    log2 of the buckets per power of two, values
+ *                          below 2^@p sub_bits are counted exactly
+ */
+void matstat_hist_init(matstat_hist_t *hist, uint32_t *buckets, size_t numof,
+                       unsigned sub_bits);
+
+/**
+ * @brief   Add a sample to a histogram
+ *
+ * @param[in]   hist    Histogram
+ * @param[in]   value   Value to add
+ */
+void matstat_hist_add(matstat_hist_t *hist, uint32_t value);
+
+/**
+ * @brief   Get a quantile of a histogram
+ *
+ * @param[in]   hist    Histogram
+ * @param[in]   p       Quantile in 1/65536
+ *
+ * @return  Largest value of the bucket the quantile falls into
+ * @return  UINT32_MAX if it falls into the last bucket, whose values are not
+ *          bounded
+ * @return  0 without samples
+ */
+uint32_t matstat_hist_quantile(const matstat_hist_t *hist, uint16_t p);
+
+/**
+ * @brief   Combine two histograms
+ *
+ * @param[inout]    dest    destination histogram
+ * @param[in]       src     source histogram, of the same layout as @p dest
+ *
+ * @return  0 on success
+ * @return  -1 if the layouts of @p dest and @p src differ
+ */
+int matstat_hist_merge(matstat_hist_t *dest, const matstat_hist_t *src);
+
 #ifdef __cplusplus
 }
 #endif
@@ -12,6 +12,22 @@
  * @{
  *
  * @brief       pseudo dynamic allocation in static memory arrays
+ *
+ * memarray_alloc() and memarray_free() can be used concurrently by threads
+ * and ISRs without further locking. On CPUs with exclusive load/store
+ * instructions (Cortex-M3 and up) the free list is updated lock-free, any
+ * interrupt between loading and storing the list head makes the store fail
+ * and the operation is retried. Other CPUs disable interrupts for the update.
+ *
+ * With the `memarray_stats` module, a pool counts its allocated elements and
+ * their high-water mark, see memarray_stats(). The counters are updated with
+ * interrupts disabled.
+ *
+ * With the `memarray_debug` module, freed elements are filled with
+ * @ref MEMARRAY_POISON behind the free list pointer. memarray_alloc() asserts
+ * that the pattern is intact, which catches writes to freed elements, and
+ * memarray_free() asserts that the element belongs to the pool.
+ *
  * @author      Tobias Heider <heidert@nm.ifi.lmu.de>
  */
 
@@ -21,10 +37,19 @@
 #include <stdint.h>
 #include <stdlib.h>
 
+#include "kernel_defines.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief Pattern of freed elements with the `memarray_debug` module
+ */
+#ifndef MEMARRAY_POISON
+#define MEMARRAY_POISON     (0xa5)
+#endif
+
 /**
  * @brief Memory pool
  */
@@ -32,8 +57,23 @@ typedef struct {
     void *free_data;    /**< memory pool data / head of the free list */
     size_t size;        /**< size of single list element */
     size_t num;         /**< max number of elements in list */
+#if IS_USED(MODULE_MEMARRAY_DEBUG) || defined(DOXYGEN)
+    void *data;         /**< start of the memory pool data */
+#endif
+#if IS_USED(MODULE_MEMARRAY_STATS) || defined(DOXYGEN)
+    size_t used;        /**< number of allocated elements */
+    size_t used_max;    /**< high-water mark of @ref used */
+#endif
 } memarray_t;
 
+/**
+ * @brief Statistics of a memarray pool
+ */
+typedef struct {
+    size_t used;        /**< number of allocated elements */
+    size_t used_max;    /**< highest number of allocated elements so far */
+} memarray_stats_t;
+
 /**
  * @brief Initialize memarray pool with free list
  *
@@ -72,6 +112,21 @@ void *memarray_alloc(memarray_t *mem);
  */
 void memarray_free(memarray_t *mem, void *ptr);
 
+#if IS_USED(MODULE_MEMARRAY_STATS) || defined(DOXYGEN)
+/**
+ * @brief Get the usage statistics of a memarray pool
+ *
+ * @note  Only available with the `memarray_stats` module
+ *
+ * @pre `mem != NULL`
+ * @pre `stats != NULL`
+ *
+ * @param[in]  mem      memarray pool
+ * @param[out] stats    statistics
+ */
+void memarray_stats(const memarray_t *mem, memarray_stats_t *stats);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
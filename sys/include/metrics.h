@@ -0,0 +1,324 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_metrics Metrics registry
+ * @ingroup     sys
+ * @brief       Typed counters, gauges and histograms with a single export path
+ *
+ * Modules keep their metrics in a statically allocated struct and describe
+ * its fields with a constant table of @ref metrics_entry_t. Together with
+ * the address of the struct, the table forms a @ref metrics_group_t that is
+ * registered once. All registered groups are exported the same way: as text
+ * by the `metrics` shell command (@ref metrics_print), as CBOR with the
+ * `metrics_cbor` module (@ref metrics_cbor) and via CoAP on `/metrics` with
+ * the `metrics_coap` module.
+ *
+ * ```c
+ * static struct {
+ *     metrics_counter_t rx;
+ *     metrics_gauge_t queued;
+ *     metrics_histogram_t rx_len;
+ * } _metrics;
+ *
+ * static const metrics_entry_t _entries[] = {
+ *     METRICS_ENTRY(METRICS_COUNTER, "rx", _metrics, rx),
+ *     METRICS_ENTRY(METRICS_GAUGE, "queued", _metrics, queued),
+ *     METRICS_ENTRY(METRICS_HISTOGRAM, "rx_len", _metrics, rx_len),
+ * };
+ *
+ * static metrics_group_t _group = METRICS_GROUP("foo", _metrics, _entries);
+ *
+ * void foo_init(void)
+ * {
+ *     metrics_register(&_group);
+ * }
+ * ```
+ *
+ * Updates with metrics_counter_add(), metrics_gauge_set() and
+ * metrics_histogram_observe() are single atomic operations and can be used
+ * from any context without locking. Exporting reads every value on its own,
+ * so values of one group may be slightly inconsistent to each other.
+ *
+ * The counters of statistics structs predating this module (e.g.
+ * @ref netstats_t) are exported in place with the types @ref METRICS_U32 and
+ * @ref METRICS_UINT.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Metrics registry interface
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef MODULE_METRICS_CBOR
+#include "nanocbor/nanocbor.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of buckets of a @ref metrics_histogram_t
+ *
+ * Bucket 0 counts the value 0, bucket `i` the values of at least `2^(i-1)`
+ * and below `2^i`. The last bucket also counts all larger values.
+ */
+#ifndef CONFIG_METRICS_HISTOGRAM_BUCKETS
+#define CONFIG_METRICS_HISTOGRAM_BUCKETS    (16U)
+#endif
+
+/**
+ * @brief   Monotonic counter
+ */
+typedef uint32_t metrics_counter_t;
+
+/**
+ * @brief   Gauge, a value that goes up and down
+ */
+typedef int32_t metrics_gauge_t;
+
+/**
+ * @brief   Histogram with logarithmic buckets
+ */
+typedef struct {
+    uint32_t bucket[CONFIG_METRICS_HISTOGRAM_BUCKETS]; /**< see
+                                     @ref CONFIG_METRICS_HISTOGRAM_BUCKETS */
+} metrics_histogram_t;
+
+/**
+ * @brief   Types of metrics
+ */
+typedef enum {
+    METRICS_COUNTER,        /**< @ref metrics_counter_t */
+    METRICS_GAUGE,          /**< @ref metrics_gauge_t */
+    METRICS_HISTOGRAM,      /**< @ref metrics_histogram_t or any other
+                                 `uint32_t` array of buckets */
+    METRICS_U32,            /**< `uint32_t` counter of a statistics struct */
+    METRICS_U64,            /**< `uint64_t` counter of a statistics struct,
+                                 read with interrupts disabled. On 32 bit
+                                 platforms, the owner must update it with
+                                 interrupts disabled as well, or the value
+                                 may be read half updated */
+    METRICS_UINT,           /**< `unsigned` counter of a statistics struct */
+} metrics_type_t;
+
+/**
+ * @brief   Description of a metric within the struct of a group
+ */
+typedef struct {
+    const char *name;       /**< name of the metric */
+    uint16_t offset;        /**< offset of the metric in the struct */
+    uint8_t type;           /**< @ref metrics_type_t */
+    uint8_t size;           /**< size of the metric in bytes */
+} metrics_entry_t;
+
+/**
+ * @brief   Group of metrics sharing a struct
+ *
+ * With @ref metrics_group_t::count > 1 the group describes an array of
+ * structs, e.g. one per thread. Instances whose values are all zero are
+ * skipped on export.
+ */
+typedef struct metrics_group {
+    struct metrics_group *next;     /**< next registered group */
+    const char *name;               /**< name of the group */
+    const void *base;               /**< address of the (first) struct */
+    const metrics_entry_t *entries; /**< metrics in the struct */
+    uint16_t numof;                 /**< number of entries */
+    uint16_t count;                 /**< number of structs in the array */
+    uint16_t stride;                /**< size of a struct in the array */
+    int16_t id;                     /**< id of the (first) instance, -1 if
+                                         the group has a single instance
+                                         without id */
+} metrics_group_t;
+
+/**
+ * @brief   Describe the field @p field of the struct @p obj
+ *
+ * @param[in]   type    @ref metrics_type_t of the field
+ * @param[in]   name    name of the metric
+ * @param[in]   obj     struct object or type holding the field
+ * @param[in]   field   name of the field
+ */
+#define METRICS_ENTRY(type, name, obj, field) \
+    { name, offsetof(__typeof__(obj), field), type, \
+      sizeof(((__typeof__(obj) *)0)->field) }
+
+/**
+ * @brief   Static initializer of a group of a single struct @p obj
+ *
+ * @param[in]   name    name of the group
+ * @param[in]   obj     struct holding the metrics
+ * @param[in]   entries array of @ref metrics_entry_t describing @p obj
+ */
+#define METRICS_GROUP(name, obj, entries) \
+    { NULL, name, &(obj), entries, \
+      sizeof(entries) / sizeof((entries)[0]), 1, 0, -1 }
+
+/**
+ * @brief   Register a group of metrics
+ *
+ * @param[in]   group   group to register, must stay valid
+ */
+void metrics_register(metrics_group_t *group);
+
+/**
+ * @brief   Remove a registered group of metrics
+ *
+ * @param[in]   group   group to remove
+ */
+void metrics_unregister(metrics_group_t *group);
+
+/**
+ * @brief   Get the first registered group, to iterate over all of them
+ *          following @ref metrics_group_t::next
+ *
+ * @return  the first registered group, NULL if there is none
+ */
+metrics_group_t *metrics_groups(void);
+
+/**
+ * @brief   Read a metric other than a histogram
+ *
+ * @param[in]   group       group of the metric
+ * @param[in]   instance    instance of the group, below
+ *                          @ref metrics_group_t::count
+ * @param[in]   entry       the metric
+ *
+ * @return  the value, gauges are sign extended
+ */
+int64_t metrics_read(const metrics_group_t *group, unsigned instance,
+                     const metrics_entry_t *entry);
+
+/**
+ * @brief   Get the buckets of a histogram
+ *
+ * @param[in]   group       group of the metric
+ * @param[in]   instance    instance of the group
+ * @param[in]   entry       the metric, of type @ref METRICS_HISTOGRAM
+ * @param[out]  buckets     number of buckets
+ *
+ * @return  the buckets
+ */
+const uint32_t *metrics_buckets(const metrics_group_t *group,
+                                unsigned instance,
+                                const metrics_entry_t *entry,
+                                unsigned *buckets);
+
+/**
+ * @brief   Check if all metrics of an instance of a group are zero
+ *
+ * @param[in]   group       the group
+ * @param[in]   instance    instance of the group
+ *
+ * @return  1 if all metrics are zero, 0 otherwise
+ */
+int metrics_is_zero(const metrics_group_t *group, unsigned instance);
+
+/**
+ * @brief   Print all metrics, one per line
+ *
+ * Lines are `<group>[<id>].<metric> <value>`, histograms print all buckets
+ * separated by spaces.
+ */
+void metrics_print(void);
+
+#if defined(MODULE_METRICS_CBOR) || defined(DOXYGEN)
+/**
+ * @brief   Encode all metrics as CBOR
+ *
+ * The data item is an array with one array `[group, id, {metric: value}]`
+ * per group instance, `id` being `null` for groups with a single instance
+ * without id and histograms being arrays of their buckets.
+ *
+ * @note    Only available with the `metrics_cbor` module
+ *
+ * @param[out]  enc     encoder to write to
+ *
+ * @return  the length of the encoded data, which exceeds the buffer of
+ *          @p enc if it was too small
+ */
+size_t metrics_cbor(nanocbor_encoder_t *enc);
+#endif
+
+/**
+ * @brief   Add @p n to the counter @p c
+ *
+ * @param[in,out]   c   counter
+ * @param[in]       n   value to add
+ */
+static inline void metrics_counter_add(metrics_counter_t *c, uint32_t n)
+{
+    __atomic_fetch_add(c, n, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief   Increment the counter @p c
+ *
+ * @param[in,out]   c   counter
+ */
+static inline void metrics_counter_inc(metrics_counter_t *c)
+{
+    metrics_counter_add(c, 1);
+}
+
+/**
+ * @brief   Set the gauge @p g
+ *
+ * @param[out]  g       gauge
+ * @param[in]   val     new value
+ */
+static inline void metrics_gauge_set(metrics_gauge_t *g, int32_t val)
+{
+    __atomic_store_n(g, val, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief   Add @p n to the gauge @p g
+ *
+ * @param[in,out]   g   gauge
+ * @param[in]       n   value to add, may be negative
+ */
+static inline void metrics_gauge_add(metrics_gauge_t *g, int32_t n)
+{
+    __atomic_fetch_add(g, n, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief   Count the value @p val in the histogram @p h
+ *
+ * @param[in,out]   h   histogram
+ * @param[in]       val observed value
+ */
+static inline void metrics_histogram_observe(metrics_histogram_t *h,
+                                             uint32_t val)
+{
+    unsigned idx = val ? (sizeof(unsigned long) * 8) - __builtin_clzl(val)
+                       : 0;
+
+    if (idx >= CONFIG_METRICS_HISTOGRAM_BUCKETS) {
+        idx = CONFIG_METRICS_HISTOGRAM_BUCKETS - 1;
+    }
+    __atomic_fetch_add(&h->bucket[idx], 1, __ATOMIC_RELAXED);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* METRICS_H */
+/** @} */
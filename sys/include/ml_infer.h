@@ -0,0 +1,242 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_ml_infer Inference manager
+ * @ingroup     sys
+ * @brief       Runs neural network models on a low priority thread, sharing
+ *              one tensor arena
+ *
+ * Inference frameworks such as @ref pkg_tensorflow-lite place all tensors of
+ * a model in a statically allocated arena whose size is usually found by
+ * trial and error. Applications alternating between several models would
+ * need one arena per model. This module owns a single arena of
+ * @ref CONFIG_ML_INFER_ARENA_SIZE bytes that is shared by all models: models
+ * are loaded into the arena on demand, replacing the model that used it
+ * before. Models used alternately therefore only need the memory of the
+ * largest one, at the cost of reloading them when switching.
+ *
+ * Inference requests are queued and processed in order by a dedicated
+ * thread of priority @ref ML_INFER_PRIO, so inference only uses the CPU time
+ * left by the application. Run functions may call ml_infer_yield() between
+ * steps, which lets other threads of the same priority run and cancels the
+ * inference after ml_infer_cancel().
+ *
+ * After the first run of a loaded model, the number of arena bytes actually
+ * used by it is measured by painting the arena before loading (like the
+ * stack usage of threads) and reported in @ref ml_infer_stats_t::arena_used.
+ * With the `metrics` module, the statistics of each registered model are
+ * exported as metrics group named after the model.
+ *
+ * For @ref pkg_tensorflow-lite, `ml_infer_tflite.hpp` provides a ready to
+ * use model driver, using the CMSIS-NN kernels on Cortex-M.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Inference manager interface
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+
+#ifndef ML_INFER_H
+#define ML_INFER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "event.h"
+#include "kernel_defines.h"
+#include "metrics.h"
+#include "thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Size of the shared tensor arena in bytes
+ */
+#ifndef CONFIG_ML_INFER_ARENA_SIZE
+#define CONFIG_ML_INFER_ARENA_SIZE      (16U * 1024U)
+#endif
+
+/**
+ * @brief   Priority of the inference thread
+ */
+#ifndef ML_INFER_PRIO
+#define ML_INFER_PRIO                   (THREAD_PRIORITY_IDLE - 1)
+#endif
+
+/**
+ * @brief   Stack size of the inference thread
+ */
+#ifndef ML_INFER_STACKSIZE
+#define ML_INFER_STACKSIZE              (THREAD_STACKSIZE_LARGE)
+#endif
+
+/**
+ * @brief   Model type
+ */
+typedef struct ml_infer_model ml_infer_model_t;
+
+/**
+ * @brief   Functions to run a model with a specific framework
+ *
+ * All functions are called from the inference thread.
+ */
+typedef struct {
+    /**
+     * @brief   Load the model into the arena
+     *
+     * @param[in]   model   the model
+     * @param[in]   arena   the arena, aligned to 16 bytes
+     * @param[in]   size    size of the arena
+     *
+     * @return  0 on success
+     * @return  -ENOMEM if the arena is too small
+     * @return  other negative errno value on error
+     */
+    int (*load)(ml_infer_model_t *model, void *arena, size_t size);
+    /**
+     * @brief   Run an inference on the loaded model
+     *
+     * @param[in]   model   the model
+     * @param[in]   arg     argument passed to ml_infer_post()
+     *
+     * @return  0 or a positive result on success
+     * @return  -ECANCELED if ml_infer_yield() reported a cancellation
+     * @return  other negative errno value on error
+     */
+    int (*run)(ml_infer_model_t *model, void *arg);
+    /**
+     * @brief   Release the model before another model is loaded into the
+     *          arena, may be NULL
+     *
+     * @param[in]   model   the model
+     */
+    void (*unload)(ml_infer_model_t *model);
+} ml_infer_driver_t;
+
+/**
+ * @brief   Statistics of a model
+ */
+typedef struct {
+    metrics_counter_t runs;         /**< successful inferences */
+    metrics_counter_t errors;       /**< failed or cancelled inferences */
+    metrics_counter_t loads;        /**< loads into the arena */
+    metrics_gauge_t arena_used;     /**< bytes of the arena used by the model,
+                                         measured after its first run */
+    metrics_gauge_t run_ms;         /**< duration of the last inference,
+                                         only with `ztimer_msec` */
+} ml_infer_stats_t;
+
+/**
+ * @brief   Model run by the inference manager
+ */
+struct ml_infer_model {
+    ml_infer_model_t *next;             /**< next registered model */
+    const char *name;                   /**< name of the model */
+    const ml_infer_driver_t *driver;    /**< framework specific functions */
+    void *ctx;                          /**< context of the driver */
+    ml_infer_stats_t stats;             /**< statistics */
+#if IS_USED(MODULE_METRICS) || defined(DOXYGEN)
+    metrics_group_t metrics;            /**< exports ml_infer_model::stats */
+#endif
+};
+
+/**
+ * @brief   Inference request
+ */
+typedef struct ml_infer_job ml_infer_job_t;
+
+/**
+ * @brief   Callback called from the inference thread when a request is done
+ *
+ * @param[in]   job     the request, ml_infer_job::res holds the result
+ */
+typedef void (*ml_infer_cb_t)(ml_infer_job_t *job);
+
+/**
+ * @brief   Inference request
+ */
+struct ml_infer_job {
+    event_t super;              /**< event of the inference queue */
+    ml_infer_model_t *model;    /**< model to run */
+    void *arg;                  /**< argument of ml_infer_driver_t::run */
+    ml_infer_cb_t cb;           /**< completion callback */
+    int res;                    /**< result of ml_infer_driver_t::run */
+};
+
+/**
+ * @brief   Start the inference thread
+ *
+ * @note    Called by auto_init
+ */
+void ml_infer_init(void);
+
+/**
+ * @brief   Register a model, to export its statistics
+ *
+ * Models are registered on their first use if this was not called before.
+ *
+ * @param[in]   model   the model, with ml_infer_model::name,
+ *                      ml_infer_model::driver and ml_infer_model::ctx set
+ */
+void ml_infer_register(ml_infer_model_t *model);
+
+/**
+ * @brief   Queue an inference request
+ *
+ * @param[out]  job     request to queue, must stay valid until @p cb is
+ *                      called
+ * @param[in]   model   model to run
+ * @param[in]   arg     argument of ml_infer_driver_t::run
+ * @param[in]   cb      completion callback
+ */
+void ml_infer_post(ml_infer_job_t *job, ml_infer_model_t *model, void *arg,
+                   ml_infer_cb_t cb);
+
+/**
+ * @brief   Run an inference and wait for its result
+ *
+ * @warning Must not be called from the inference thread
+ *
+ * @param[in]   model   model to run
+ * @param[in]   arg     argument of ml_infer_driver_t::run
+ *
+ * @return  the result of ml_infer_driver_t::load or ml_infer_driver_t::run
+ */
+int ml_infer_run(ml_infer_model_t *model, void *arg);
+
+/**
+ * @brief   Preemption point for run functions
+ *
+ * Lets other threads of @ref ML_INFER_PRIO run. Threads of higher priority
+ * preempt the inference at any time anyway.
+ *
+ * @return  0 to continue
+ * @return  -ECANCELED if the inference was cancelled, the run function
+ *          should return this value
+ */
+int ml_infer_yield(void);
+
+/**
+ * @brief   Cancel the inference that is running
+ *
+ * The run function notices at its next call of ml_infer_yield(). The model
+ * is reloaded before its next inference.
+ */
+void ml_infer_cancel(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ML_INFER_H */
+/** @} */
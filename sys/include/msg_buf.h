@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_msg_buf Zero-copy message buffers
+ * @ingroup     sys_memory_management
+ * @brief       Pass large payloads between threads via @ref msg_t without
+ *              copying
+ *
+ * A message only carries a single pointer sized value, so passing larger
+ * data between threads usually means copying it into a buffer owned by the
+ * receiver. This module provides fixed size blocks taken from a
+ * @ref sys_memarray pool. A block is filled by the sender and handed over
+ * with @ref msg_buf_send(). On success the ownership of the block moves to
+ * the receiver, which obtains it with @ref msg_buf_get() and returns it to
+ * its pool with @ref msg_buf_free() once done (or after replying).
+ *
+ * Blocks can be allocated and freed from interrupt context.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Zero-copy message buffer definitions
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+
+#ifndef MSG_BUF_H
+#define MSG_BUF_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "memarray.h"
+#include "msg.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct msg_buf_pool msg_buf_pool_t;
+
+/**
+ * @brief   A message buffer block
+ */
+typedef struct {
+    msg_buf_pool_t *pool;   /**< pool the block belongs to */
+    size_t len;             /**< number of valid bytes in @ref data */
+    uint8_t data[];         /**< payload */
+} msg_buf_t;
+
+/**
+ * @brief   A pool of message buffer blocks
+ */
+struct msg_buf_pool {
+    memarray_t mem;         /**< backing block allocator */
+    size_t size;            /**< payload capacity of a single block */
+};
+
+/**
+ * @brief   Size of a single block in the storage array of a pool
+ *
+ * @param[in] size  payload capacity of a block
+ */
+#define MSG_BUF_BLOCK_SIZE(size) \
+    ((sizeof(msg_buf_t) + (size) + sizeof(void *) - 1) & ~(sizeof(void *) - 1))
+
+/**
+ * @brief   Initialize a message buffer pool
+ *
+ * @pre `storage` is suitably aligned and holds at least
+ *      `num * MSG_BUF_BLOCK_SIZE(size)` bytes
+ *
+ * @param[out] pool     pool to initialize
+ * @param[in] storage   backing memory for the blocks
+ * @param[in] size      payload capacity of a single block
+ * @param[in] num       number of blocks
+ */
+void msg_buf_pool_init(msg_buf_pool_t *pool, void *storage, size_t size,
+                       size_t num);
+
+/**
+ * @brief   Allocate a block from a pool
+ *
+ * @param[in] pool  pool to allocate from
+ *
+ * @return  block with `len` set to 0
+ * @return  NULL, if the pool is exhausted
+ */
+msg_buf_t *msg_buf_alloc(msg_buf_pool_t *pool);
+
+/**
+ * @brief   Return a block to its pool
+ *
+ * @param[in] buf   block to free, may be NULL
+ */
+void msg_buf_free(msg_buf_t *buf);
+
+/**
+ * @brief   Send a block to a thread, transferring its ownership
+ *
+ * Uses @ref msg_send(), so it blocks if the receiver has no message queue
+ * space and is not waiting, unless called from interrupt context.
+ *
+ * @param[in] buf   block to send
+ * @param[in] type  message type
+ * @param[in] pid   receiving thread
+ *
+ * @return  1, if sending was successful; the receiver now owns @p buf
+ * @return  0, if called from ISR and the receiver cannot take the message;
+ *          the caller still owns @p buf
+ * @return  -1, on invalid PID; the caller still owns @p buf
+ */
+int msg_buf_send(msg_buf_t *buf, uint16_t type, kernel_pid_t pid);
+
+/**
+ * @brief   Get the block carried by a received message
+ *
+ * @param[in] m     message received from @ref msg_buf_send()
+ *
+ * @return  the block, now owned by the caller
+ */
+static inline msg_buf_t *msg_buf_get(const msg_t *m)
+{
+    return m->content.ptr;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MSG_BUF_H */
+/** @} */
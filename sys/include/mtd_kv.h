@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_mtd_kv Wear-levelled key-value store on MTD
+ * @ingroup     sys
+ * @brief       Log-structured key-value store for frequently updated values
+ *
+ * @ref sys_eepreg places every entry at a fixed address, so each update of
+ * e.g. a frame counter wears the same cells. This module appends every update
+ * to a log on a MTD device instead. The sectors of the device form a ring,
+ * one sector is always kept erased. When the head sector is full, the log
+ * moves on to the erased sector and the oldest sector is compacted: its live
+ * entries are copied to the new head before it is erased. All sectors are
+ * thus erased equally often.
+ *
+ * On init the log is replayed once to build a hash index in RAM, which maps
+ * keys to the flash address of their latest value. Lookups only read the
+ * matching entry from flash.
+ *
+ * Several keys can be updated atomically with @ref mtd_kv_set_multi(): the
+ * entries are written back to back into one sector and only the last one
+ * carries the commit flag. An interrupted commit is discarded on the next
+ * replay. Every entry is protected by a CRC16-CCITT.
+ *
+ * The live entries must fit into one sector less than the device has, a
+ * single entry into one sector. Use @ref drivers_mtd_mapper to place the store
+ * in a partition, the EEPROM of a MCU can be used through its MTD driver.
+ *
+ * The store is not thread-safe.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Wear-levelled key-value store interface
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+
+#ifndef MTD_KV_H
+#define MTD_KV_H
+
+#include <stdint.h>
+
+#include "mtd.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Maximum key length
+ */
+#ifndef CONFIG_MTD_KV_KEY_LEN_MAX
+#define CONFIG_MTD_KV_KEY_LEN_MAX   (32U)
+#endif
+
+/**
+ * @brief   Entry of the RAM index, internal
+ */
+typedef struct {
+    uint32_t addr;              /**< address of the latest entry */
+    uint16_t hash;              /**< upper bits of the key hash */
+} mtd_kv_slot_t;
+
+/**
+ * @brief   Key-value store descriptor
+ */
+typedef struct {
+    mtd_dev_t *mtd;             /**< device holding the store */
+    mtd_kv_slot_t *index;       /**< RAM index */
+    uint16_t index_size;        /**< number of index slots, power of 2 */
+    uint16_t keys;              /**< number of keys stored */
+    uint32_t sector_size;       /**< size of a sector */
+    uint32_t head_sector;       /**< sector that is being written */
+    uint32_t head_off;          /**< next free offset in @p head_sector */
+    uint32_t cycle;             /**< erase cycle of @p head_sector */
+} mtd_kv_t;
+
+/**
+ * @brief   Key-value pair for @ref mtd_kv_set_multi()
+ */
+typedef struct {
+    const char *key;            /**< key, zero terminated */
+    const void *val;            /**< value, NULL to delete the key */
+    size_t len;                 /**< length of @p val */
+} mtd_kv_pair_t;
+
+/**
+ * @brief   Open the store on a MTD device, create it if there is none
+ *
+ * The device needs at least two sectors and must be initialized.
+ *
+ * @param[out]  kv          store descriptor
+ * @param[in]   mtd         device to use
+ * @param[in]   index       RAM index
+ * @param[in]   index_size  number of entries in @p index, a power of 2 and
+ *                          larger than the number of keys to store
+ *
+ * @return  0 on success
+ * @return  -EINVAL if the device or index size are not suitable
+ * @return  -ENOMEM if the stored keys do not fit into the index
+ * @return  <0 on MTD error
+ */
+int mtd_kv_init(mtd_kv_t *kv, mtd_dev_t *mtd, mtd_kv_slot_t *index,
+                uint16_t index_size);
+
+/**
+ * @brief   Read the value of a key
+ *
+ * @param[in]   kv      store descriptor
+ * @param[in]   key     key to look up
+ * @param[out]  dest    buffer for the value
+ * @param[in]   len     size of @p dest, longer values are truncated
+ *
+ * @return  length of the value
+ * @return  -ENOENT if the key is not set
+ * @return  <0 on MTD error
+ */
+int mtd_kv_get(mtd_kv_t *kv, const char *key, void *dest, size_t len);
+
+/**
+ * @brief   Set or delete several keys atomically
+ *
+ * Either all or none of the updates are visible after a power loss.
+ *
+ * @param[in]   kv      store descriptor
+ * @param[in]   pairs   keys and their new values
+ * @param[in]   n       number of @p pairs
+ *
+ * @return  0 on success
+ * @return  -EINVAL if a key is empty or too long or the entries do not fit
+ *          into one sector
+ * @return  -ENOMEM if the index is full
+ * @return  -ENOSPC if the store is full
+ * @return  <0 on MTD error
+ */
+int mtd_kv_set_multi(mtd_kv_t *kv, const mtd_kv_pair_t *pairs, unsigned n);
+
+/**
+ * @brief   Set the value of a key
+ *
+ * @param[in]   kv      store descriptor
+ * @param[in]   key     key to set
+ * @param[in]   val     new value
+ * @param[in]   len     length of @p val
+ *
+ * @return  see @ref mtd_kv_set_multi()
+ */
+static inline int mtd_kv_set(mtd_kv_t *kv, const char *key, const void *val,
+                             size_t len)
+{
+    const mtd_kv_pair_t pair = { .key = key, .val = val, .len = len };
+
+    return mtd_kv_set_multi(kv, &pair, 1);
+}
+
+/**
+ * @brief   Delete a key
+ *
+ * @param[in]   kv      store descriptor
+ * @param[in]   key     key to delete
+ *
+ * @return  see @ref mtd_kv_set_multi()
+ */
+static inline int mtd_kv_delete(mtd_kv_t *kv, const char *key)
+{
+    const mtd_kv_pair_t pair = { .key = key };
+
+    return mtd_kv_set_multi(kv, &pair, 1);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MTD_KV_H */
+/** @} */
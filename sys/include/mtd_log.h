@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_mtd_log Append-only record log on MTD
+ * @ingroup     sys
+ * @brief       Ring log of fixed-size records directly on a MTD device
+ *
+ * For high-rate telemetry a file system adds metadata updates and
+ * copy-on-write to every append. This module instead writes records
+ * sequentially into the sectors of a MTD device, which is used as a ring:
+ * once the last sector is full, the oldest sector is erased and reused. All
+ * sectors are thus erased equally often. Use @ref drivers_mtd_mapper to
+ * place the log in a partition of a larger device.
+ *
+ * Every sector starts with a header slot holding a magic number, the erase
+ * cycle of the sector and the sequence number of its first record. Records
+ * occupy one slot each and carry their sequence number, length and a
+ * CRC16-CCITT, so records torn by a power loss are skipped when reading.
+ *
+ * On init, only the sector headers are read to find the newest sector, the
+ * first free slot in it is found by a binary search.
+ *
+ * The slot size has to divide the page size of the device, so a record never
+ * crosses a page. A record can hold up to slot size - 8 bytes of payload.
+ *
+ * The log is not thread-safe.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Append-only record log on MTD interface
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+
+#ifndef MTD_LOG_H
+#define MTD_LOG_H
+
+#include <stdint.h>
+
+#include "mtd.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Size of the record header
+ */
+#define MTD_LOG_RECORD_HDR_SIZE     (8U)
+
+/**
+ * @brief   Log descriptor
+ */
+typedef struct {
+    mtd_dev_t *mtd;             /**< device holding the log */
+    uint8_t *buf;               /**< buffer of one slot */
+    uint16_t slot_size;         /**< size of a record slot */
+    uint32_t slots;             /**< slots per sector, including the header */
+    uint32_t head_sector;       /**< sector that is being written */
+    uint32_t head_slot;         /**< next free slot in @p head_sector */
+    uint32_t cycle;             /**< erase cycle of @p head_sector */
+    uint32_t seq;               /**< sequence number of the next record */
+} mtd_log_t;
+
+/**
+ * @brief   Log iterator
+ */
+typedef struct {
+    uint32_t sector;            /**< current sector */
+    uint32_t slot;              /**< next slot to read */
+    uint32_t remaining;         /**< sectors left to visit */
+} mtd_log_iter_t;
+
+/**
+ * @brief   Open the log on a MTD device, create it if there is none
+ *
+ * The device needs at least two sectors and must be initialized.
+ *
+ * @param[out]  log         log descriptor
+ * @param[in]   mtd         device to use
+ * @param[in]   buf         buffer of @p slot_size bytes
+ * @param[in]   slot_size   size of a record slot, must divide the page size
+ *
+ * @return  0 on success
+ * @return  -EINVAL if the device or slot size are not suitable
+ * @return  <0 on MTD error
+ */
+int mtd_log_init(mtd_log_t *log, mtd_dev_t *mtd, void *buf, uint16_t slot_size);
+
+/**
+ * @brief   Append a record
+ *
+ * The record gets the sequence number `log->seq` had before the call.
+ *
+ * @param[in]   log     log descriptor
+ * @param[in]   data    record payload
+ * @param[in]   len     payload length
+ *
+ * @return  0 on success
+ * @return  -EINVAL if @p len is 0 or does not fit into a slot
+ * @return  <0 on MTD error
+ */
+int mtd_log_append(mtd_log_t *log, const void *data, size_t len);
+
+/**
+ * @brief   Drop all records
+ *
+ * @param[in]   log     log descriptor
+ *
+ * @return  0 on success
+ * @return  <0 on MTD error
+ */
+int mtd_log_clear(mtd_log_t *log);
+
+/**
+ * @brief   Start iterating over the log from the oldest record
+ *
+ * Appending invalidates the iterator.
+ *
+ * @param[in]   log     log descriptor
+ * @param[out]  it      iterator
+ */
+void mtd_log_iter_init(const mtd_log_t *log, mtd_log_iter_t *it);
+
+/**
+ * @brief   Read the next valid record
+ *
+ * @param[in]       log     log descriptor
+ * @param[in,out]   it      iterator
+ * @param[out]      dest    buffer for the payload
+ * @param[in]       len     size of @p dest, longer records are truncated
+ * @param[out]      seq     sequence number of the record, may be NULL
+ *
+ * @return  length of the record payload
+ * @return  0 if there are no more records
+ * @return  <0 on MTD error
+ */
+int mtd_log_iter_next(mtd_log_t *log, mtd_log_iter_t *it, void *dest,
+                      size_t len, uint32_t *seq);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MTD_LOG_H */
+/** @} */
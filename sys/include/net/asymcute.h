@@ -143,6 +143,19 @@ extern "C" {
 #define ASYMCUTE_N_RETRY            (3U)
 #endif
 
+#ifndef ASYMCUTE_PENDING_BUCKETS
+/**
+ * @brief   Number of lists the pending requests of a connection are hashed
+ *          into by their message ID
+ *
+ * Acknowledgments are matched against a single list only, so many requests
+ * in flight (e.g. a window of QoS 1 publishes) do not slow down the lookup.
+ *
+ * @note    Must be a power of 2
+ */
+#define ASYMCUTE_PENDING_BUCKETS    (4U)
+#endif
+
 /**
  * @brief   Return values used by public Asymcute functions
  */
@@ -254,7 +267,10 @@ struct asymcute_con {
     mutex_t lock;                       /**< synchronization lock */
     sock_udp_t sock;                    /**< socket used by a connections */
     sock_udp_ep_t server_ep;            /**< the gateway's UDP endpoint */
-    asymcute_req_t *pending;            /**< list holding pending requests */
+    /**
+     * @brief   Lists holding pending requests, hashed by message ID
+     */
+    asymcute_req_t *pending[ASYMCUTE_PENDING_BUCKETS];
     asymcute_sub_t *subscriptions;      /**< list holding active subscriptions */
     asymcute_evt_cb_t user_cb;          /**< event callback provided by user */
     event_callback_t keepalive_evt;     /**< keep alive event */
@@ -275,6 +291,7 @@ struct asymcute_topic {
     char name[ASYMCUTE_TOPIC_MAXLEN + 1];   /**< topic string (ACSII only) */
     uint8_t flags;              /**< normal, short, or pre-defined */
     uint16_t id;                /**< topic id */
+    uint8_t id_enc[2];          /**< topic id as encoded in PUBLISH messages */
 };
 
 /**
@@ -495,6 +512,10 @@ int asymcute_register(asymcute_con_t *con, asymcute_req_t *req,
  * @param[in] data_len  size of @p data in bytes
  * @param[in] flags     additional flags (QoS level, DUP, and RETAIN)
  *
+ * With QoS 1, @p data is copied into @p req for retransmissions, so it must
+ * fit into @ref ASYMCUTE_BUFSIZE. With QoS 0 on GNRC, it is sent directly
+ * from @p data and @p req is released before this function returns.
+ *
  * @return  ASYMCUTE_OK if PUBLISH message has been sent
  * @return  ASYMCUTE_NOTSUP if unsupported flags have been set
  * @return  ASYMCUTE_OVERFLOW if data does not fit into transmit buffer
@@ -36,6 +36,7 @@ extern "C" {
  * @{
  */
 #define COAP_OPT_URI_HOST       (3)
+#define COAP_OPT_ETAG           (4)
 #define COAP_OPT_OBSERVE        (6)
 #define COAP_OPT_LOCATION_PATH  (8)
 #define COAP_OPT_URI_PATH       (11)
@@ -44,6 +45,7 @@ extern "C" {
 #define COAP_OPT_LOCATION_QUERY (20)
 #define COAP_OPT_BLOCK2         (23)
 #define COAP_OPT_BLOCK1         (27)
+#define COAP_OPT_SIZE2          (28)
 #define COAP_OPT_PROXY_URI      (35)
 #define COAP_OPT_PROXY_SCHEME   (39)
 /** @} */
@@ -129,6 +131,28 @@ extern "C" {
 #define COAP_CODE_PROXYING_NOT_SUPPORTED     ((5 << 5) | 5)
 /** @} */
 
+/**
+ * @name    Signaling codes, for CoAP over reliable transports
+ * @see     [RFC 8323, section 5](https://tools.ietf.org/html/rfc8323#section-5)
+ * @{
+ */
+#define COAP_CLASS_SIGNAL                     (7)
+#define COAP_CODE_CSM                        ((7 << 5) | 1)
+#define COAP_CODE_PING                       ((7 << 5) | 2)
+#define COAP_CODE_PONG                       ((7 << 5) | 3)
+#define COAP_CODE_RELEASE                    ((7 << 5) | 4)
+#define COAP_CODE_ABORT                      ((7 << 5) | 5)
+/** @} */
+
+/**
+ * @name    Option numbers of a Capabilities and Settings Message (CSM)
+ * @see     [RFC 8323, section 5.3](https://tools.ietf.org/html/rfc8323#section-5.3)
+ * @{
+ */
+#define COAP_SIGNAL_CSM_OPT_MAX_MESSAGE_SIZE  (2)
+#define COAP_SIGNAL_CSM_OPT_BLOCK_WISE        (4)
+/** @} */
+
 /**
  * @name    Content-Format option codes
  * @anchor  net_coap_format
@@ -47,6 +47,17 @@ extern "C" {
 #define CORD_UPDATE_INTERVAL    ((CORD_LT / 4) * 3)
 #endif
 
+/**
+ * @brief   Maximum random time in seconds the update interval is shortened by
+ *
+ * Spreads the updates of endpoints that registered at the same time, e.g.
+ * after a power outage, so they do not reach the RD all at once. The default
+ * is 1/10 of the update interval.
+ */
+#ifndef CORD_UPDATE_JITTER
+#define CORD_UPDATE_JITTER      (CORD_UPDATE_INTERVAL / 10)
+#endif
+
 /**
  * @name    Endpoint ID definition
  *
@@ -68,7 +68,6 @@
  * @todo        QOS level 2
  * @todo        put the node to sleep (send DISCONNECT with duration field set)
  * @todo        handle DISCONNECT messages initiated by the broker/gateway
- * @todo        support for pre-defined and short topic IDs
  * @todo        handle (previously) active subscriptions on reconnect/disconnect
  * @todo        handle re-connect/disconnect from unresponsive gateway (in case
  *              a number of ping requests are unanswered)
@@ -154,6 +153,28 @@ extern "C" {
 #define EMCUTE_N_RETRY          (3U)
 #endif
 
+#ifndef EMCUTE_SUB_BUCKETS
+/**
+ * @brief   Number of hash buckets used to find the subscription of an
+ *          incoming PUBLISH message by its topic ID
+ *
+ * Should be a power of two. Raise it for nodes with many subscriptions.
+ */
+#define EMCUTE_SUB_BUCKETS      (16U)
+#endif
+
+#ifndef EMCUTE_PIPELINE_MAX
+/**
+ * @brief   Maximum number of requests emcute_reg_multi() and
+ *          emcute_sub_multi() keep in flight
+ *
+ * The spec expects a client to wait for the acknowledgment of a request
+ * before sending the next one (spec v1.2, section 6.13). Set this to 1 for
+ * gateways that enforce this.
+ */
+#define EMCUTE_PIPELINE_MAX     (4U)
+#endif
+
 /**
  * @brief   MQTT-SN flags
  *
@@ -213,9 +234,12 @@ typedef void(*emcute_cb_t)(const emcute_topic_t *topic, void *data, size_t len);
  */
 typedef struct emcute_sub {
     struct emcute_sub *next;    /**< next subscription (saved in a list) */
+    struct emcute_sub *next_id; /**< next subscription in the same topic ID
+                                     hash bucket */
     emcute_topic_t topic;       /**< topic we subscribe to */
     emcute_cb_t cb;             /**< function called when receiving messages */
     void *arg;                  /**< optional custom argument */
+    uint8_t tit;                /**< topic ID type, set by emcute_sub() */
 } emcute_sub_t;
 
 /**
@@ -264,14 +288,38 @@ int emcute_discon(void);
  */
 int emcute_reg(emcute_topic_t *topic);
 
+/**
+ * @brief   Get topic IDs for a number of topic names from the gateway
+ *
+ * Does the same as calling emcute_reg() for each topic, but keeps up to
+ * @ref EMCUTE_PIPELINE_MAX REGISTER requests in flight instead of waiting
+ * for each REGACK in turn.
+ *
+ * @param[in,out] topics    topics to register, the names **must not** be
+ *                          NULL. The IDs of topics that failed are not
+ *                          changed.
+ * @param[in] numof         number of entries in @p topics
+ *
+ * @return  EMCUTE_OK if all topics were registered
+ * @return  EMCUTE_NOGW if not connected to a gateway
+ * @return  EMCUTE_OVERFLOW if length of a topic name exceeds
+ *          @ref EMCUTE_TOPIC_MAXLEN, nothing is sent then
+ * @return  EMCUTE_REJECT or EMCUTE_TIMEOUT if a registration failed
+ */
+int emcute_reg_multi(emcute_topic_t *topics, size_t numof);
+
 /**
  * @brief   Publish data on the given topic
  *
  * @param[in] topic     topic to send data to, topic **must** be registered
- *                      (topic.id **must** populated).
+ *                      (topic.id **must** populated), or be a pre-defined
+ *                      topic (topic.id set, flag EMCUTE_TIT_PREDEF), or a
+ *                      short topic (topic.name of two characters, flag
+ *                      EMCUTE_TIT_SHORT).
  * @param[in] buf       data to publish
  * @param[in] len       length of @p data in bytes
- * @param[in] flags     flags used for publication, allowed are QoS and retain
+ * @param[in] flags     flags used for publication, allowed are QoS, retain
+ *                      and topic ID type
  *
  * @return  EMCUTE_OK on success
  * @return  EMCUTE_NOGW if not connected to a gateway
@@ -287,7 +335,9 @@ int emcute_pub(emcute_topic_t *topic, const void *buf, size_t len,
  * @brief   Subscribe to the given topic
  *
  * When calling this function, @p sub->topic.name and @p sub->cb **must** be
- * set.
+ * set. For a pre-defined topic (flag EMCUTE_TIT_PREDEF), @p sub->topic.id is
+ * set instead of the name. A short topic (flag EMCUTE_TIT_SHORT) has a name
+ * of two characters.
  *
  * @param[in,out] sub   subscription context, @p sub->topic.name and @p sub->cb
  *                      **must** not be NULL.
@@ -302,6 +352,25 @@ int emcute_pub(emcute_topic_t *topic, const void *buf, size_t len,
  */
 int emcute_sub(emcute_sub_t *sub, unsigned flags);
 
+/**
+ * @brief   Subscribe to a number of topics
+ *
+ * Does the same as calling emcute_sub() for each subscription, but keeps up
+ * to @ref EMCUTE_PIPELINE_MAX SUBSCRIBE requests in flight instead of
+ * waiting for each SUBACK in turn.
+ *
+ * @param[in,out] subs  subscription contexts, as for emcute_sub()
+ * @param[in] numof     number of entries in @p subs
+ * @param[in] flags     flags used for all subscriptions, as for emcute_sub()
+ *
+ * @return  EMCUTE_OK if all subscriptions succeeded
+ * @return  EMCUTE_NOGW if not connected to a gateway
+ * @return  EMCUTE_OVERFLOW if length of a topic name exceeds
+ *          @ref EMCUTE_TOPIC_MAXLEN, nothing is sent then
+ * @return  EMCUTE_REJECT or EMCUTE_TIMEOUT if a subscription failed
+ */
+int emcute_sub_multi(emcute_sub_t *subs, size_t numof, unsigned flags);
+
 /**
  * @brief   Unsubscripbe the given topic
  *
@@ -196,6 +196,13 @@
  * bytes long. For resources that change slowly, this length can be reduced via
  * CONFIG_GCOAP_OBS_VALUE_WIDTH.
  *
+ * For resources that change faster than observers care about, set
+ * CONFIG_GCOAP_OBS_NOTIFY_MIN_INTERVAL. A notification sent within that
+ * interval after the previous one is held back and sent when the interval
+ * expires, unless a newer notification replaces it in the meantime. So the
+ * observer receives at most one notification per interval, always with the
+ * latest state of the resource.
+ *
  * A client always may re-register for a resource with the same token or with
  * a new token to indicate continued interest in receiving notifications about
  * it. Of course the client must not already be using any new token in the
@@ -548,6 +555,19 @@ extern "C" {
 #define CONFIG_GCOAP_OBS_REGISTRATIONS_MAX     (2)
 #endif
 
+/**
+ * @ingroup net_gcoap_conf
+ * @brief   Minimum interval between two notifications for a registration
+ *          [in ms]
+ *
+ * Notifications within the interval are coalesced, only the latest one is
+ * sent at its end. Each registration buffers a held back notification of up
+ * to @ref CONFIG_GCOAP_PDU_BUF_SIZE bytes then. 0 disables coalescing.
+ */
+#ifndef CONFIG_GCOAP_OBS_NOTIFY_MIN_INTERVAL
+#define CONFIG_GCOAP_OBS_NOTIFY_MIN_INTERVAL   (0U)
+#endif
+
 /**
  * @name    States for the memo used to track Observe registrations
  * @{
@@ -609,6 +629,27 @@ extern "C" {
                           + sizeof(coap_pkt_t))
 #endif
 
+/**
+ * @ingroup net_gcoap_conf
+ * @brief   Number of worker threads for blocking resource handlers
+ *
+ * Only used with module `gcoap_workers`. Requests for resources flagged with
+ * @ref COAP_HANDLER_MAY_BLOCK are handed to a worker, so the gcoap thread
+ * keeps serving other requests. If all workers are busy, such a request is
+ * answered with 5.03 (Service Unavailable).
+ */
+#ifndef CONFIG_GCOAP_WORKERS_NUMOF
+#define CONFIG_GCOAP_WORKERS_NUMOF     (2)
+#endif
+
+/**
+ * @brief Stack size for a worker thread of module `gcoap_workers`
+ */
+#ifndef GCOAP_WORKER_STACK_SIZE
+#define GCOAP_WORKER_STACK_SIZE (THREAD_STACKSIZE_DEFAULT + DEBUG_EXTRA_STACKSIZE \
+                                 + sizeof(coap_pkt_t))
+#endif
+
 /**
  * @ingroup net_gcoap_conf
  * @brief   Count of PDU buffers available for resending confirmable messages
@@ -658,6 +699,9 @@ typedef struct gcoap_listener {
     size_t resources_len;               /**< Length of array */
     gcoap_link_encoder_t link_encoder;  /**< Writes a link for a resource */
     struct gcoap_listener *next;        /**< Next listener in list */
+    bool indexed;                       /**< Resources are looked up by binary
+                                         *   search; set by
+                                         *   gcoap_register_listener() */
 } gcoap_listener_t;
 
 /**
@@ -711,6 +755,14 @@ typedef struct {
     const coap_resource_t *resource;    /**< Entity being observed */
     uint8_t token[GCOAP_TOKENLEN_MAX];  /**< Client token for notifications */
     unsigned token_len;                 /**< Actual length of token attribute */
+#if (CONFIG_GCOAP_OBS_NOTIFY_MIN_INTERVAL > 0) || DOXYGEN
+    uint32_t last_notify;               /**< Time of last notification [us] */
+    event_timeout_t notify_tmout;       /**< Ends the minimum interval */
+    event_callback_t notify_cb;         /**< Sends a held back notification */
+    size_t pending_len;                 /**< Length of held back notification;
+                                             none if 0 */
+    uint8_t pending[CONFIG_GCOAP_PDU_BUF_SIZE]; /**< Held back notification */
+#endif
 } gcoap_observe_memo_t;
 
 /**
@@ -871,11 +923,14 @@ int gcoap_obs_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
  *
  * Assumes a single observer for a resource.
  *
+ * With @ref CONFIG_GCOAP_OBS_NOTIFY_MIN_INTERVAL, the notification may be
+ * copied and sent later, replacing a notification held back before.
+ *
  * @param[in] buf Buffer containing the PDU
  * @param[in] len Length of the buffer
  * @param[in] resource Resource to send
  *
- * @return  length of the packet
+ * @return  length of the packet, also if it was held back
  * @return  0 if cannot send
  */
 size_t gcoap_obs_send(const uint8_t *buf, size_t len,
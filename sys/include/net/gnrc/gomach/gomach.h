@@ -270,6 +270,21 @@ extern "C" {
 #define CONFIG_GNRC_GOMACH_TX_BUSY_THRESHOLD      (5U)
 #endif
 
+/**
+ * @brief Maximum number of packets a sender sends in a row in the WP.
+ *
+ * After a successful transmission in the receiver's WP, a sender with more
+ * packets for the receiver sends the next one right away, with the frame
+ * pending bit set on all but the last one, as the receiver extends its WP
+ * upon each reception. Packets left after
+ * @ref CONFIG_GNRC_GOMACH_CP_BURST_PKT_NUM are sent in the vTDMA slots
+ * the receiver allocates according to the sender's queue-length indicator.
+ * Set to 1 to send all further packets in vTDMA slots.
+ */
+#ifndef CONFIG_GNRC_GOMACH_CP_BURST_PKT_NUM
+#define CONFIG_GNRC_GOMACH_CP_BURST_PKT_NUM       (3U)
+#endif
+
 /**
  * @brief Maximum WP period extension number in GoMacH.
  *
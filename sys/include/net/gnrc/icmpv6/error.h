@@ -28,11 +28,82 @@
 #include "net/gnrc/ipv6.h"
 #include "net/gnrc/netapi.h"
 #include "net/gnrc/pkt.h"
+#include "kernel_defines.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @defgroup net_gnrc_icmpv6_error_conf  GNRC ICMPv6 error rate limiting
+ *                                       compile configurations
+ * @ingroup  net_gnrc_conf
+ *
+ * With module `gnrc_icmpv6_error_rate_limit` error messages are rate limited
+ * as required by [RFC 4443, section 2.4 (f)](https://tools.ietf.org/html/rfc4443#section-2.4)
+ * with a token bucket per error type and destination. Suppressed errors are
+ * dropped before any packet buffer space is allocated for them.
+ * @{
+ */
+/**
+ * @brief   Number of (error type, destination) pairs rate limited
+ *          independently
+ *
+ * If more pairs are active, the one that was not used the longest is
+ * replaced.
+ */
+#ifndef CONFIG_GNRC_ICMPV6_ERROR_RATE_LIMIT_NUMOF
+#define CONFIG_GNRC_ICMPV6_ERROR_RATE_LIMIT_NUMOF           (4U)
+#endif
+
+/**
+ * @brief   Number of error messages that may be sent in a burst to a
+ *          destination
+ */
+#ifndef CONFIG_GNRC_ICMPV6_ERROR_RATE_LIMIT_BURST
+#define CONFIG_GNRC_ICMPV6_ERROR_RATE_LIMIT_BURST           (4U)
+#endif
+
+/**
+ * @brief   Interval in milliseconds in which one more error message may be
+ *          sent to a destination
+ */
+#ifndef CONFIG_GNRC_ICMPV6_ERROR_RATE_LIMIT_INTERVAL_MS
+#define CONFIG_GNRC_ICMPV6_ERROR_RATE_LIMIT_INTERVAL_MS     (100U)
+#endif
+/** @} */
+
+/**
+ * @brief   Number of ICMPv6 error types
+ *
+ * Error types start at @ref ICMPV6_DST_UNR (1).
+ */
+#define GNRC_ICMPV6_ERROR_TYPES_NUMOF   (ICMPV6_PARAM_PROB)
+
+/**
+ * @brief   Statistics on ICMPv6 error messages
+ *
+ * @note    Only available with module `gnrc_icmpv6_error_rate_limit`.
+ */
+typedef struct {
+    uint32_t sent;              /**< error messages passing the rate limit */
+    /**
+     * @brief   Error messages suppressed by the rate limit, by type
+     *
+     * Indexed by the ICMPv6 type minus 1.
+     */
+    uint32_t suppressed[GNRC_ICMPV6_ERROR_TYPES_NUMOF];
+} gnrc_icmpv6_error_stats_t;
+
+#if IS_USED(MODULE_GNRC_ICMPV6_ERROR_RATE_LIMIT) || defined(DOXYGEN)
+/**
+ * @brief   Get the current ICMPv6 error statistics
+ *
+ * @return  The current ICMPv6 error statistics
+ */
+gnrc_icmpv6_error_stats_t *gnrc_icmpv6_error_stats_get(void);
+#endif
+
 #if defined(MODULE_GNRC_ICMPV6_ERROR) || defined(DOXYGEN)
 /**
  * @brief   Sends an ICMPv6 destination unreachable message for sending.
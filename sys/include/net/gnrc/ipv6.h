@@ -86,6 +86,40 @@
  *
  * `GNRC_NETAPI_MSG_TYPE_GET` is not supported.
  *
+ * # Forwarding thread
+ *
+ * With module `gnrc_ipv6_fwd_thread`, received packets not destined to this
+ * host are forwarded by a separate thread with its own message queue
+ * (@ref GNRC_IPV6_FWD_MSG_QUEUE_SIZE) and priority (@ref GNRC_IPV6_FWD_PRIO),
+ * so forwarded traffic does not delay local delivery, ICMPv6, and neighbor
+ * discovery in the IPv6 thread (and vice versa). The packets are steered
+ * to that thread instead of the IPv6 thread by
+ * @ref gnrc_netapi_dispatch_receive() based on their destination address
+ * (see @ref gnrc_ipv6_fwd_steer()). Link-local and multicast destinations are
+ * always handled by the IPv6 thread. Other subscribers to
+ * @ref GNRC_NETTYPE_IPV6 still receive all packets.
+ *
+ * # Single network thread
+ *
+ * With module `gnrc_single_thread`, @ref net_gnrc_sixlowpan and
+ * @ref net_gnrc_udp do not start threads of their own. They register
+ * callbacks (see @ref net_gnrc_netapi_callbacks) instead, so
+ * @ref gnrc_netapi_dispatch_receive() and @ref gnrc_netapi_dispatch_send()
+ * become function calls into them:
+ *
+ * - 6LoWPAN runs in the IPv6 thread. Frames from the interface threads are
+ *   queued to the IPv6 thread, while the IPv6 thread itself compresses and
+ *   decompresses in place, i.e. without a message or context switch.
+ * - UDP keeps no state, so it runs in whichever thread dispatches to it:
+ *   received datagrams are delivered from the IPv6 thread, datagrams to send
+ *   are handed to IPv6 from the sending thread.
+ *
+ * This saves two stacks and message queues and two context switches per
+ * packet. The IPv6 thread needs a larger stack in turn (see
+ * @ref GNRC_IPV6_STACK_SIZE), and its message queue also holds the frames
+ * waiting for 6LoWPAN. The interface threads and other protocols (e.g.
+ * @ref net_gnrc_tcp or @ref net_gnrc_rpl) keep their threads.
+ *
  * @{
  *
  * @file
@@ -99,6 +133,9 @@
 #ifndef NET_GNRC_IPV6_H
 #define NET_GNRC_IPV6_H
 
+#include <stdbool.h>
+
+#include "kernel_defines.h"
 #include "kernel_types.h"
 #include "net/gnrc.h"
 #include "thread.h"
@@ -125,10 +162,16 @@ extern "C" {
  */
 /**
  * @brief   Default stack size to use for the IPv6 thread
+ *
+ * Doubled with module `gnrc_single_thread`, as 6LoWPAN and UDP run on it.
  */
 #ifndef GNRC_IPV6_STACK_SIZE
+#if IS_USED(MODULE_GNRC_SINGLE_THREAD)
+#define GNRC_IPV6_STACK_SIZE        (2 * THREAD_STACKSIZE_DEFAULT)
+#else
 #define GNRC_IPV6_STACK_SIZE        (THREAD_STACKSIZE_DEFAULT)
 #endif
+#endif
 
 /**
  * @brief   Default priority for the IPv6 thread
@@ -149,6 +192,31 @@ extern "C" {
 #define CONFIG_GNRC_IPV6_MSG_QUEUE_SIZE_EXP    (3U)
 #endif
 
+/**
+ * @brief   Default stack size to use for the IPv6 forwarding thread
+ */
+#ifndef GNRC_IPV6_FWD_STACK_SIZE
+#define GNRC_IPV6_FWD_STACK_SIZE    (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @brief   Default priority for the IPv6 forwarding thread
+ *
+ * Lower than the IPv6 thread by default, so neighbor discovery is not
+ * delayed by forwarded traffic.
+ */
+#ifndef GNRC_IPV6_FWD_PRIO
+#define GNRC_IPV6_FWD_PRIO          (GNRC_IPV6_PRIO + 1)
+#endif
+
+/**
+ * @brief   Default message queue size to use for the IPv6 forwarding thread
+ *          (as exponent of 2^n).
+ */
+#ifndef CONFIG_GNRC_IPV6_FWD_MSG_QUEUE_SIZE_EXP
+#define CONFIG_GNRC_IPV6_FWD_MSG_QUEUE_SIZE_EXP    (3U)
+#endif
+
 #ifdef DOXYGEN
 /**
  * @brief   Add a static IPv6 link local address to any network interface
@@ -186,6 +254,38 @@ extern "C" {
  */
 extern kernel_pid_t gnrc_ipv6_pid;
 
+/**
+ * @brief Message queue size to use for the IPv6 forwarding thread.
+ */
+#ifndef GNRC_IPV6_FWD_MSG_QUEUE_SIZE
+#define GNRC_IPV6_FWD_MSG_QUEUE_SIZE    (1 << CONFIG_GNRC_IPV6_FWD_MSG_QUEUE_SIZE_EXP)
+#endif
+
+#if IS_USED(MODULE_GNRC_IPV6_FWD_THREAD) || defined(DOXYGEN)
+/**
+ * @brief   The PID to the IPv6 forwarding thread.
+ *
+ * @note    Initialized by @ref gnrc_ipv6_init(). **Do not set by hand**.
+ */
+extern kernel_pid_t gnrc_ipv6_fwd_pid;
+
+/**
+ * @brief   Checks if a received packet is to be handled by the IPv6
+ *          forwarding thread instead of the IPv6 thread
+ *
+ * Called by @ref gnrc_netapi_dispatch() for every
+ * @ref GNRC_NETAPI_MSG_TYPE_RCV of type @ref GNRC_NETTYPE_IPV6 with
+ * @ref GNRC_NETREG_DEMUX_CTX_ALL. Other subscribers still receive the packet.
+ *
+ * @param[in] pkt   A packet in receive order, starting with an IPv6 header.
+ *
+ * @return  true, if the packet is not destined to this host and can be
+ *          forwarded.
+ * @return  false, if the packet needs to be handled by the IPv6 thread.
+ */
+bool gnrc_ipv6_fwd_steer(const gnrc_pktsnip_t *pkt);
+#endif
+
 #ifdef MODULE_FIB
 
 /**
@@ -68,15 +68,30 @@ extern "C" {
 #endif
 
 /**
- * @brief   The number of total allocatable @ref gnrc_ipv6_ext_frag_limits_t objects
+ * @brief   Maximum length of the fragmentable part of a reassembled datagram
  *
- * This is the maximum number of receivable fragments, shared between all
- * fragmented datagrams
+ * Every reassembly buffer entry tracks the received 8-byte units of up to this
+ * many bytes, fragments beyond are dropped. The default fits a datagram of
+ * the Ethernet MTU.
  *
  * @note    Only applicable with [gnrc_ipv6_ext_frag](@ref net_gnrc_ipv6_ext_frag) module
  */
-#ifndef CONFIG_GNRC_IPV6_EXT_FRAG_LIMITS_POOL_SIZE
-#define CONFIG_GNRC_IPV6_EXT_FRAG_LIMITS_POOL_SIZE (CONFIG_GNRC_IPV6_EXT_FRAG_RBUF_SIZE * 2U)
+#ifndef CONFIG_GNRC_IPV6_EXT_FRAG_RBUF_MAX_LEN
+#define CONFIG_GNRC_IPV6_EXT_FRAG_RBUF_MAX_LEN     (1500U)
+#endif
+
+/**
+ * @brief   Packet buffer space in bytes all reassembly buffer entries may
+ *          occupy together
+ *
+ * If a fragment would exceed it, the datagram with the fewest received bytes
+ * is dropped, so nearly complete datagrams survive.
+ *
+ * @note    Only applicable with [gnrc_ipv6_ext_frag](@ref net_gnrc_ipv6_ext_frag) module
+ */
+#ifndef CONFIG_GNRC_IPV6_EXT_FRAG_RBUF_BUDGET
+#define CONFIG_GNRC_IPV6_EXT_FRAG_RBUF_BUDGET      (CONFIG_GNRC_IPV6_EXT_FRAG_RBUF_SIZE * \
+                                                    CONFIG_GNRC_IPV6_EXT_FRAG_RBUF_MAX_LEN)
 #endif
 
 /**
@@ -23,7 +23,8 @@
 #include <stdbool.h>
 #include <stdint.h>
 
-#include "clist.h"
+#include "bitfield.h"
+#include "net/gnrc/ipv6/ext.h"
 #include "net/gnrc/pkt.h"
 #include "net/gnrc/pktbuf.h"
 #include "net/ipv6/hdr.h"
@@ -52,17 +53,6 @@ extern "C" {
  */
 #define GNRC_IPV6_EXT_FRAG_SEND         (0xfe02U)
 
-/**
- * @brief   Data type to describe limits of a single fragment in the reassembly
- *          buffer
- */
-typedef struct gnrc_ipv6_ext_frag_limits {
-    struct gnrc_ipv6_ext_frag_limits *next; /**< limits of next fragment */
-    uint16_t start;                         /**< the start (= offset) of the fragment */
-    uint16_t end;                           /**< the exclusive end (= offset + length) of the
-                                             *   fragment */
-} gnrc_ipv6_ext_frag_limits_t;
-
 /**
  * @brief   Fragmentation send buffer type
  */
@@ -75,22 +65,35 @@ typedef struct {
     uint16_t offset;                /**< current fragmentation offset */
 } gnrc_ipv6_ext_frag_send_t;
 
+/**
+ * @brief   Number of 8-byte units tracked by a reassembly buffer entry
+ */
+#define GNRC_IPV6_EXT_FRAG_RBUF_UNITS   ((CONFIG_GNRC_IPV6_EXT_FRAG_RBUF_MAX_LEN + 7U) / 8U)
+
 /**
  * @brief   A reassembly buffer entry
+ *
+ * Fragments are copied to their offset in gnrc_ipv6_ext_frag_rbuf_t::pkt
+ * right away. Which 8-byte units of the datagram were received is tracked in
+ * gnrc_ipv6_ext_frag_rbuf_t::received_map, so duplicates and overlaps are
+ * detected without walking the fragments received so far.
  */
 typedef struct {
     gnrc_pktsnip_t *pkt;    /**< the (partly) reassembled packet */
     ipv6_hdr_t *ipv6;       /**< the IPv6 header of gnrc_ipv6_ext_frag_rbuf_t::pkt */
-    /**
-     * @brief   The limits of the fragments in the reassembled packet
-     *
-     * @note    Members of this list can be cast to gnrc_ipv6_ext_frag_limits_t.
-     */
-    clist_node_t limits;
     uint32_t id;            /**< the identification from the fragment headers */
     uint32_t arrival;       /**< arrival time of last received fragment */
     uint16_t pkt_len;       /**< length of gnrc_ipv6_ext_frag_rbuf_t::pkt */
+    uint16_t received;      /**< bytes of fragmentable part received so far */
+    uint16_t total;         /**< length of the fragmentable part, 0 until the
+                             *   last fragment was received */
     uint8_t last;           /**< received last fragment */
+    uint8_t first;          /**< received first fragment */
+    uint8_t fragments;      /**< number of fragments received so far */
+    /**
+     * @brief   8-byte units of the fragmentable part received so far
+     */
+    BITFIELD(received_map, GNRC_IPV6_EXT_FRAG_RBUF_UNITS);
 } gnrc_ipv6_ext_frag_rbuf_t;
 
 /**
@@ -99,6 +102,9 @@ typedef struct {
 typedef struct {
     unsigned rbuf_full;     /**< counts the number of events where the
                              *   reassembly buffer is full */
+    unsigned rbuf_budget;   /**< counts the number of datagrams dropped to
+                             *   stay within
+                             *   @ref CONFIG_GNRC_IPV6_EXT_FRAG_RBUF_BUDGET */
     unsigned frag_full;     /**< counts the number of events that there where
                              *   no @ref gnrc_sixlowpan_frag_fb_t available */
     unsigned datagrams;     /**< reassembled datagrams */
@@ -159,8 +165,8 @@ gnrc_pktsnip_t *gnrc_ipv6_ext_frag_reass(gnrc_pktsnip_t *pkt);
  * @return  A reassembly buffer matching @p id ipv6_hdr_t::src and ipv6_hdr::dst
  *          of @p hdr or first free reassembly buffer. Will never be NULL, as
  *          in the case of the reassembly buffer being full, the entry with the
- *          lowest gnrc_ipv6_ext_frag_rbuf_t::arrival (serial-number-like) is
- *          removed.
+ *          fewest received bytes is removed. Of those, the one with the lowest
+ *          gnrc_ipv6_ext_frag_rbuf_t::arrival (serial-number-like) is chosen.
  */
 gnrc_ipv6_ext_frag_rbuf_t *gnrc_ipv6_ext_frag_rbuf_get(ipv6_hdr_t *ipv6,
                                                        uint32_t id);
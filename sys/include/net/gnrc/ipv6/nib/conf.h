@@ -261,6 +261,17 @@ extern "C" {
 #define CONFIG_GNRC_IPV6_NIB_NUMOF                   (4)
 #endif
 
+/**
+ * @brief   Number of hash buckets to look up on-link entries in NIB
+ *
+ * @note    Only applicable with module `gnrc_ipv6_nib_nc_hash`
+ *
+ * @attention   Must be a power of 2.
+ */
+#ifndef CONFIG_GNRC_IPV6_NIB_NC_HASH_SIZE
+#define CONFIG_GNRC_IPV6_NIB_NC_HASH_SIZE            (16)
+#endif
+
 /**
  * @brief   Number of off-link entries in NIB
  *
@@ -10,6 +10,13 @@
  * @defgroup    net_gnrc_ipv6_nib_ft    Forwarding table
  * @ingroup     net_gnrc_ipv6_nib
  * @brief
+ *
+ * By default, the best matching route for a destination is found by comparing
+ * the destination against every off-link entry of the NIB. With module
+ * `gnrc_ipv6_nib_ft_trie`, the off-link entries are additionally indexed in a
+ * statically allocated, path-compressed binary trie, so the lookup only walks
+ * along the bits of the destination. Iterating the forwarding table with
+ * @ref gnrc_ipv6_nib_ft_iter() is not affected by the index.
  * @{
  *
  * @file
@@ -10,6 +10,13 @@
  * @defgroup    net_gnrc_ipv6_nib_nc   Neighbor Cache
  * @ingroup     net_gnrc_ipv6_nib
  * @brief       Neighbor cache component of neighbor information base
+ *
+ * By default, neighbors are looked up by comparing the address against every
+ * entry of the NIB. With module `gnrc_ipv6_nib_nc_hash`, the entries are
+ * indexed in @ref CONFIG_GNRC_IPV6_NIB_NC_HASH_SIZE buckets hashed by their
+ * address, so a lookup only compares against the entries in one bucket. When
+ * the NIB is full, the least recently looked up garbage-collectible entry is
+ * then replaced instead of the oldest one.
  * @{
  *
  * @file
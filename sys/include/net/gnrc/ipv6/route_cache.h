@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2020 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_ipv6_route_cache IPv6 route cache
+ * @ingroup     net_gnrc_ipv6
+ * @brief       Caches the next hop and source address of recent destinations
+ *
+ * For every unicast packet, @ref net_gnrc_ipv6 selects a source address,
+ * looks up the route in the @ref net_gnrc_ipv6_nib and resolves the
+ * link-layer address of the next hop. With module `gnrc_ipv6_route_cache`,
+ * the result is kept for the last @ref CONFIG_GNRC_IPV6_ROUTE_CACHE_SIZE
+ * destinations, so packets to the same destination skip all of that.
+ *
+ * Every change to the NIB or to the addresses of an interface increments a
+ * generation counter (see @ref gnrc_ipv6_route_cache_invalidate()), which
+ * invalidates all cached entries at once. Next hops are only cached while
+ * their neighbor cache entry is reachable (or unmanaged), so neighbor
+ * unreachability detection still sees every packet to a stale neighbor.
+ * @{
+ *
+ * @file
+ * @brief   IPv6 route cache definitions
+ */
+#ifndef NET_GNRC_IPV6_ROUTE_CACHE_H
+#define NET_GNRC_IPV6_ROUTE_CACHE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "kernel_defines.h"
+#include "net/gnrc/ipv6/nib/nc.h"
+#include "net/ipv6/addr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup    net_gnrc_ipv6_route_cache_conf GNRC IPv6 route cache compile configurations
+ * @ingroup     net_gnrc_ipv6_route_cache
+ * @ingroup     net_gnrc_conf
+ * @{
+ */
+/**
+ * @brief   Number of destinations in the route cache
+ */
+#ifndef CONFIG_GNRC_IPV6_ROUTE_CACHE_SIZE
+#define CONFIG_GNRC_IPV6_ROUTE_CACHE_SIZE   (4)
+#endif
+/** @} */
+
+/**
+ * @brief   Route cache statistics
+ */
+typedef struct {
+    uint32_t hits;      /**< packets sent with a cached entry */
+    uint32_t misses;    /**< packets the NIB had to be asked for */
+    uint32_t gen;       /**< current generation of the cache */
+} gnrc_ipv6_route_cache_stats_t;
+
+#if IS_USED(MODULE_GNRC_IPV6_ROUTE_CACHE) || defined(DOXYGEN)
+/**
+ * @brief   Invalidates all entries of the route cache
+ *
+ * To be called on every change of the NIB or of the addresses of an
+ * interface. May be called from any thread.
+ *
+ * @note    Without module `gnrc_ipv6_route_cache` this function does nothing.
+ */
+void gnrc_ipv6_route_cache_invalidate(void);
+
+/**
+ * @brief   Gets the current generation of the route cache
+ *
+ * @return  The generation to pass to gnrc_ipv6_route_cache_add(), taken
+ *          *before* asking the NIB.
+ */
+uint32_t gnrc_ipv6_route_cache_gen(void);
+
+/**
+ * @brief   Gets the cached next hop and source address for a destination
+ *
+ * @note    Only to be called by the IPv6 thread or, with module
+ *          `gnrc_ipv6_fwd_thread`, the IPv6 forwarding thread.
+ *
+ * @param[in] dst       Destination of a packet.
+ * @param[in] iface     Interface the packet is requested to be sent over. 0
+ *                      for any.
+ * @param[out] nce      Neighbor cache entry of the next hop to @p dst.
+ * @param[out] src      The source address selected for @p dst. The
+ *                      unspecified address if none was selected yet.
+ *
+ * @return  true, if a valid entry for @p dst and @p iface was found.
+ * @return  false, if no valid entry was found. Counted as miss.
+ */
+bool gnrc_ipv6_route_cache_get(const ipv6_addr_t *dst, unsigned iface,
+                               gnrc_ipv6_nib_nc_t *nce, ipv6_addr_t *src);
+
+/**
+ * @brief   Adds or updates the entry for a destination
+ *
+ * The entry is not added, if @p nce requires neighbor unreachability
+ * detection or the cache was invalidated since @p gen was taken.
+ *
+ * @note    Only to be called by the IPv6 thread or, with module
+ *          `gnrc_ipv6_fwd_thread`, the IPv6 forwarding thread.
+ *
+ * @param[in] dst       Destination of a packet.
+ * @param[in] iface     Interface the packet was requested to be sent over. 0
+ *                      for any.
+ * @param[in] gen       Generation taken with gnrc_ipv6_route_cache_gen()
+ *                      before asking the NIB for @p nce.
+ * @param[in] nce       Neighbor cache entry of the next hop to @p dst.
+ * @param[in] src       The source address selected for @p dst. May be NULL
+ *                      to keep the one already cached.
+ */
+void gnrc_ipv6_route_cache_add(const ipv6_addr_t *dst, unsigned iface,
+                               uint32_t gen, const gnrc_ipv6_nib_nc_t *nce,
+                               const ipv6_addr_t *src);
+
+/**
+ * @brief   Gets the statistics of the route cache
+ *
+ * @return  The statistics of the route cache.
+ */
+const gnrc_ipv6_route_cache_stats_t *gnrc_ipv6_route_cache_stats(void);
+#else
+static inline void gnrc_ipv6_route_cache_invalidate(void)
+{
+}
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_IPV6_ROUTE_CACHE_H */
+/** @} */
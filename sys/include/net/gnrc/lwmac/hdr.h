@@ -90,6 +90,8 @@ typedef struct __attribute__((packed)) {
     gnrc_lwmac_hdr_t header;        /**< WA packet header type */
     gnrc_lwmac_l2_addr_t dst_addr;  /**< WA is broadcast, so destination address needed */
     uint32_t current_phase;         /**< Node's current phase value */
+    uint8_t wakeup_exp;             /**< Node's wake-up interval is shortened
+                                         by 2^wakeup_exp */
 } gnrc_lwmac_frame_wa_t;
 
 /**
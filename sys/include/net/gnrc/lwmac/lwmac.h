@@ -61,6 +61,23 @@
  * receiver's phase is too close to its own phase, it will run a backoff scheme to
  * randomly reselect a new wake-up phase for itself.
  *
+ * ## Adaptive wake-up interval
+ * A receiver that gets data in most of its wake-up periods wakes up more
+ * often: the interval is halved, down to
+ * @ref GNRC_LWMAC_WAKEUP_INTERVAL_US >> @ref GNRC_LWMAC_MAX_WAKEUP_EXP,
+ * and doubled again after a full @ref GNRC_LWMAC_WAKEUP_INTERVAL_US without
+ * any reception. The additional wake-ups lie in between the regular ones, so
+ * the phase within @ref GNRC_LWMAC_WAKEUP_INTERVAL_US stays the same. The
+ * receiver announces its current interval in every WA, senders keep it per
+ * neighbor and aim at the next wake-up in the shorter interval, which cuts
+ * the latency for links with heavy traffic.
+ *
+ * ## Clock drift compensation
+ * Senders also estimate the drift between their own clock and the one of a
+ * phase-locked receiver from the error of the predicted phase and correct the
+ * phase by it. Links with infrequent traffic therefore still find the
+ * receiver awake with the first or second WR.
+ *
  * @{
  *
  * @file
@@ -266,6 +283,34 @@ extern "C" {
 #define GNRC_LWMAC_MAX_TX_BURST_PKT_NUM      (GNRC_LWMAC_WAKEUP_INTERVAL_US / GNRC_LWMAC_WAKEUP_DURATION_US)
 #endif
 
+/**
+ * @brief Largest exponent by which the wake-up interval is shortened.
+ *
+ * The shortest wake-up interval is @ref GNRC_LWMAC_WAKEUP_INTERVAL_US divided
+ * by 2 to the power of this value. It must still be considerably longer than
+ * @ref GNRC_LWMAC_WAKEUP_DURATION_US. Set to 0 to disable the adaptation.
+ */
+#ifndef GNRC_LWMAC_MAX_WAKEUP_EXP
+#define GNRC_LWMAC_MAX_WAKEUP_EXP            (2U)
+#endif
+
+/**
+ * @brief Shortest time between two phase measurements of a neighbor to
+ *        update its drift estimate.
+ *
+ * Shorter periods are dominated by the jitter of the measurements.
+ */
+#ifndef GNRC_LWMAC_DRIFT_MIN_PERIOD_US
+#define GNRC_LWMAC_DRIFT_MIN_PERIOD_US       (10LU * GNRC_LWMAC_WAKEUP_INTERVAL_US)
+#endif
+
+/**
+ * @brief Largest clock drift in ppm that is compensated.
+ */
+#ifndef GNRC_LWMAC_MAX_DRIFT_PPM
+#define GNRC_LWMAC_MAX_DRIFT_PPM             (200)
+#endif
+
 /**
  * @brief MAX bad Listen period extensions a node can tolerate.
  *
@@ -65,6 +65,13 @@ extern "C" {
  */
 #define GNRC_LWMAC_EVENT_RTT_SLEEP_PENDING   (0x4306)
 
+/**
+ * @brief   LWMAC RTT additional wake-up pending event type.
+ *
+ * Wake-up in between the regular ones of an adapted wake-up interval.
+ */
+#define GNRC_LWMAC_EVENT_RTT_SUB_WAKEUP_PENDING  (0x4307)
+
 /**
  * @brief   LWMAC timeout event type.
  */
@@ -195,6 +202,10 @@ typedef struct lwmac {
     uint32_t last_wakeup;                                       /**< Used to calculate wakeup times */
     uint8_t lwmac_info;                                         /**< LWMAC's internal information (flags) */
     gnrc_lwmac_timeout_t timeouts[GNRC_LWMAC_TIMEOUT_COUNT];    /**< Store timeouts used for protocol */
+    uint8_t wakeup_exp;                                         /**< Wake-up interval is shortened by
+                                                                     2^wakeup_exp */
+    uint8_t rx_count;                                           /**< Receptions since the last regular
+                                                                     wake-up */
 
 #if (GNRC_MAC_ENABLE_DUTYCYCLE_RECORD == 1)
     /* Parameters for recording duty-cycle */
@@ -35,6 +35,9 @@
 #ifdef MODULE_GNRC_GOMACH
 #include "net/gnrc/gomach/types.h"
 #endif
+#ifdef MODULE_GNRC_TSCH
+#include "net/gnrc/tsch/types.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -128,6 +131,12 @@ typedef struct {
     gnrc_priority_pktqueue_t queue;                  /**< TX queue for this particular Neighbor */
 #endif /* (GNRC_MAC_TX_QUEUE_SIZE != 0) || defined(DOXYGEN) */
 
+#ifdef MODULE_GNRC_LWMAC
+    uint32_t phase_time;    /**< RTT ticks when the phase was measured. */
+    int16_t drift_ppm;      /**< Neighbor's clock drift relative to ours. */
+    uint8_t wakeup_exp;     /**< Neighbor's wake-up interval exponent. */
+#endif
+
 #ifdef MODULE_GNRC_GOMACH
     uint16_t pub_chanseq;   /**< Neighbor's current public channel sequence. */
     uint32_t cp_phase;      /**< Neighbor's wake-up phase. */
@@ -213,6 +222,7 @@ typedef struct {
     uint8_t last_tx_neighbor_id;                  /**< Record last TX neighbor's sequence in the neighbor list. */
     uint8_t tx_busy_count;                        /**< Counter recording csma busy feedback times. */
     uint8_t t2u_fail_count;                       /**< Preamble trial failure count. */
+    uint8_t cp_burst_count;                       /**< Packets sent in a row in the receiver's WP. */
 #endif
 } gnrc_mac_tx_t;
 
@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_mpl  MPL
+ * @ingroup     net_gnrc
+ * @brief       GNRC implementation of the Multicast Protocol for Low-Power
+ *              and Lossy Networks
+ * @see         [RFC 7731](https://tools.ietf.org/html/rfc7731)
+ *
+ * Multicast packets to a realm-local address (`ff03::/16`) are
+ * disseminated through the whole mesh instead of being dropped or flooded
+ * after one hop. The originator (the MPL Seed) inserts an MPL Option into a
+ * hop-by-hop options header. Every MPL Forwarder buffers each new message
+ * and retransmits it on its MPL interface driven by a
+ * [trickle timer](@ref sys_trickle) per message, which suppresses the
+ * retransmission when enough neighbors were heard sending it already.
+ *
+ * Only proactive forwarding is implemented, i.e. no MPL Control Messages are
+ * sent and they are ignored on reception. Encapsulation of multicast
+ * packets of a larger scope (IPv6-in-IPv6) is not supported either.
+ *
+ * The seed set does not keep the sequence numbers of the buffered messages
+ * but a sliding window of the last 32 sequence numbers per seed, so
+ * duplicates are detected even after the message left the buffered message
+ * set.
+ *
+ * Enable MPL on an interface with @ref gnrc_mpl_init(). The interface joins
+ * the ALL_MPL_FORWARDERS address, other groups are joined as usual.
+ *
+ * @{
+ *
+ * @file
+ * @brief   MPL definitions
+ *
+ * @author  ML!PA Consulting GmbH
+ */
+#ifndef NET_GNRC_MPL_H
+#define NET_GNRC_MPL_H
+
+#include <stdbool.h>
+
+#include "net/gnrc/netif.h"
+#include "net/gnrc/pkt.h"
+#include "net/ipv6/addr.h"
+#include "net/mpl.h"
+#include "trickle.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup net_gnrc_mpl_conf    GNRC MPL compile configurations
+ * @ingroup  net_gnrc_conf
+ * @{
+ */
+/**
+ * @brief   Number of seeds remembered for duplicate detection
+ */
+#ifndef CONFIG_GNRC_MPL_SEED_SET_SIZE
+#define CONFIG_GNRC_MPL_SEED_SET_SIZE               (4U)
+#endif
+
+/**
+ * @brief   Time in seconds a seed is remembered after its last message
+ *
+ * @see [RFC 7731, section 5.4](https://tools.ietf.org/html/rfc7731#section-5.4)
+ */
+#ifndef CONFIG_GNRC_MPL_SEED_SET_ENTRY_LIFETIME
+#define CONFIG_GNRC_MPL_SEED_SET_ENTRY_LIFETIME     (1800U)
+#endif
+
+/**
+ * @brief   Number of messages buffered for retransmission
+ */
+#ifndef CONFIG_GNRC_MPL_BUFFERED_MESSAGES_NUMOF
+#define CONFIG_GNRC_MPL_BUFFERED_MESSAGES_NUMOF     (4U)
+#endif
+
+/**
+ * @brief   Minimum trickle interval for data messages in milliseconds
+ *
+ * Should be about 10 times the worst-case link-layer latency.
+ *
+ * @see [RFC 7731, section 5.4](https://tools.ietf.org/html/rfc7731#section-5.4)
+ */
+#ifndef CONFIG_GNRC_MPL_DATA_MESSAGE_IMIN
+#define CONFIG_GNRC_MPL_DATA_MESSAGE_IMIN           (100U)
+#endif
+
+/**
+ * @brief   Maximum trickle interval for data messages, as number of
+ *          doublings of @ref CONFIG_GNRC_MPL_DATA_MESSAGE_IMIN
+ */
+#ifndef CONFIG_GNRC_MPL_DATA_MESSAGE_IMAX_DOUBLINGS
+#define CONFIG_GNRC_MPL_DATA_MESSAGE_IMAX_DOUBLINGS (0U)
+#endif
+
+/**
+ * @brief   Trickle redundancy constant for data messages
+ */
+#ifndef CONFIG_GNRC_MPL_DATA_MESSAGE_K
+#define CONFIG_GNRC_MPL_DATA_MESSAGE_K              (1U)
+#endif
+
+/**
+ * @brief   Number of trickle intervals a data message is buffered for
+ */
+#ifndef CONFIG_GNRC_MPL_DATA_MESSAGE_TIMER_EXPIRATIONS
+#define CONFIG_GNRC_MPL_DATA_MESSAGE_TIMER_EXPIRATIONS  (3U)
+#endif
+/** @} */
+
+/**
+ * @brief   Message type for the trickle timer of a buffered message
+ *
+ * The timers run in the IPv6 thread.
+ */
+#define GNRC_MPL_MSG_TYPE_TRICKLE   (0x0910U)
+
+/**
+ * @brief   Enables MPL on an interface
+ *
+ * Only one interface is supported, a second call moves MPL to @p netif.
+ *
+ * @param[in] netif The MPL interface
+ *
+ * @return  0 on success
+ * @return  negative errno, if the ALL_MPL_FORWARDERS address could not be
+ *          joined
+ */
+int gnrc_mpl_init(gnrc_netif_t *netif);
+
+/**
+ * @brief   Checks if an address is disseminated with MPL
+ *
+ * @param[in] addr  A destination address
+ *
+ * @return  true, if @p addr is a realm-local multicast address
+ */
+static inline bool gnrc_mpl_is_domain(const ipv6_addr_t *addr)
+{
+    return ipv6_addr_is_multicast(addr) &&
+           ((addr->u8[1] & 0x0f) == IPV6_ADDR_MCAST_SCP_REALM_LOCAL);
+}
+
+/**
+ * @brief   Processes a received MPL Option
+ *
+ * A new message is recorded in the seed set and, if received on the MPL
+ * interface with a hop limit left, buffered for retransmission.
+ *
+ * @pre The hop-by-hop options header containing @p opt is marked in @p pkt
+ *
+ * @param[in] pkt   The received packet, in receive order
+ * @param[in] opt   The MPL Option within @p pkt
+ *
+ * @return  0, if the message is new and must be processed further
+ * @return  -EALREADY, if the message was already received
+ * @return  -EINVAL, if @p opt is malformed
+ * @return  -ENOMEM, if the seed set is full
+ */
+int gnrc_mpl_opt_process(gnrc_pktsnip_t *pkt, const mpl_opt_t *opt);
+
+/**
+ * @brief   Originates an MPL message
+ *
+ * Called by the IPv6 thread for every multicast packet from an upper layer.
+ * Packets to an MPL domain address without preset extension headers get an
+ * MPL Option and are transmitted by their trickle timer.
+ *
+ * @param[in] pkt   The packet, starting with the IPv6 header
+ * @param[in] netif The interface given by the sender, may be NULL
+ *
+ * @return  true, if @p pkt was consumed by MPL
+ * @return  false, if @p pkt must be sent as usual
+ */
+bool gnrc_mpl_send(gnrc_pktsnip_t *pkt, gnrc_netif_t *netif);
+
+/**
+ * @brief   Handles a @ref GNRC_MPL_MSG_TYPE_TRICKLE message
+ *
+ * @param[in] trickle   The trickle timer, i.e. msg_t::content::ptr
+ */
+void gnrc_mpl_handle_timer(trickle_t *trickle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_MPL_H */
+/** @} */
@@ -29,6 +29,7 @@
 #include <stdbool.h>
 
 #include "kernel_types.h"
+#include "metrics.h"
 #include "msg.h"
 #ifdef MODULE_GNRC_NETIF_BUS
 #include "msg_bus.h"
@@ -38,6 +39,9 @@
 #include "net/gnrc/netapi.h"
 #include "net/gnrc/pkt.h"
 #include "net/gnrc/netif/conf.h"
+#if IS_USED(MODULE_GNRC_NETIF_ATTRS)
+#include "net/gnrc/netif/attrs.h"
+#endif
 #if IS_USED(MODULE_GNRC_NETIF_LORAWAN)
 #include "net/gnrc/netif/lorawan.h"
 #endif
@@ -54,6 +58,12 @@
 #if IS_USED(MODULE_GNRC_NETIF_MAC)
 #include "net/gnrc/netif/mac.h"
 #endif
+#if IS_USED(MODULE_GNRC_NETIF_PKTQ)
+#include "net/gnrc/netif/pktq.h"
+#endif
+#if IS_USED(MODULE_GNRC_NETIF_TX_BURST)
+#include "net/gnrc/netif/tx_burst.h"
+#endif
 #include "net/ndp.h"
 #include "net/netdev.h"
 #include "net/netopt.h"
@@ -112,6 +122,13 @@ typedef struct {
 #ifdef MODULE_NETSTATS_L2
     netstats_t stats;                       /**< transceiver's statistics */
 #endif
+#if (IS_USED(MODULE_METRICS) && IS_USED(MODULE_NETSTATS_L2)) || defined(DOXYGEN)
+    metrics_group_t metrics;                /**< exports gnrc_netif_t::stats */
+#endif
+#if (IS_USED(MODULE_METRICS) && IS_USED(MODULE_NETSTATS_IPV6) && \
+     IS_USED(MODULE_GNRC_NETIF_IPV6)) || defined(DOXYGEN)
+    metrics_group_t metrics_ipv6;           /**< exports the IPv6 statistics */
+#endif
 #if IS_USED(MODULE_GNRC_NETIF_LORAWAN) || defined(DOXYGEN)
     gnrc_netif_lorawan_t lorawan;           /**< LoRaWAN component */
 #endif
@@ -140,6 +157,42 @@ typedef struct {
      */
     event_t event_isr;
 #endif /* MODULE_GNRC_NETIF_EVENTS */
+#if IS_USED(MODULE_GNRC_NETIF_RX_ZEROCOPY) || defined(DOXYGEN)
+    /**
+     * @brief   Receive buffers lent to the network device
+     *
+     * @see net_gnrc_netif_rx_zerocopy
+     */
+    netdev_rx_buf_t rx_bufs[CONFIG_GNRC_NETIF_RX_ZEROCOPY_NUMOF];
+    /**
+     * @brief   Number of gnrc_netif_t::rx_bufs currently lent to the device
+     */
+    uint8_t rx_bufs_numof;
+#endif
+#if IS_USED(MODULE_GNRC_NETIF_TX_BURST) || defined(DOXYGEN)
+    /**
+     * @brief   Frames staged for burst transmission
+     *
+     * @see net_gnrc_netif_tx_burst
+     */
+    gnrc_netif_tx_burst_t tx_burst;
+#endif
+#if IS_USED(MODULE_GNRC_NETIF_ATTRS) || defined(DOXYGEN)
+    /**
+     * @brief   Snapshot of the stable attributes of the interface
+     *
+     * @see net_gnrc_netif_attrs
+     */
+    gnrc_netif_attrs_cache_t attrs;
+#endif
+#if IS_USED(MODULE_GNRC_NETIF_PKTQ) || defined(DOXYGEN)
+    /**
+     * @brief   Packets queued while the network device is busy
+     *
+     * @see net_gnrc_netif_pktq
+     */
+    gnrc_netif_pktq_t send_queue;
+#endif
 #if (GNRC_NETIF_L2ADDR_MAXLEN > 0) || DOXYGEN
     /**
      * @brief   The link-layer address currently used as the source address
@@ -211,6 +264,9 @@ struct gnrc_netif_ops {
      *          or is in an unexpected format.
      * @return  -ENOTSUP, if sending @p pkt in the given format isn't supported
      *          (e.g. empty payload with Ethernet).
+     * @return  -EBUSY, if the device is busy. With module `gnrc_netif_pktq`
+     *          the interface queues @p pkt to send it later. The packet
+     *          must not be changed by this method for this to work.
      * @return  Any negative error code reported by gnrc_netif_t::dev.
      */
     int (*send)(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt);
@@ -245,6 +301,9 @@ struct gnrc_netif_ops {
      * @return  Number of bytes in @p data.
      * @return  -EOVERFLOW, if @p max_len is lesser than the required space.
      * @return  -ENOTSUP, if @p opt is not supported to be set.
+     * @return  -EBUSY, if the device is busy. With module `gnrc_netif_pktq`
+     *          the interface queues @p pkt to send it later. The packet
+     *          must not be changed by this method for this to work.
      * @return  Any negative error code reported by gnrc_netif_t::dev.
      */
     int (*get)(gnrc_netif_t *netif, gnrc_netapi_opt_t *opt);
@@ -262,6 +321,9 @@ struct gnrc_netif_ops {
      * @return  -EOVERFLOW, if @p data_len is greater than the allotted space in
      *          gnrc_netif_t::dev or gnrc_netif_t.
      * @return  -ENOTSUP, if @p opt is not supported to be set.
+     * @return  -EBUSY, if the device is busy. With module `gnrc_netif_pktq`
+     *          the interface queues @p pkt to send it later. The packet
+     *          must not be changed by this method for this to work.
      * @return  Any negative error code reported by gnrc_netif_t::dev.
      */
     int (*set)(gnrc_netif_t *netif, const gnrc_netapi_opt_t *opt);
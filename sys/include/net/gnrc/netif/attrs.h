@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_netif_attrs  Cached interface attributes
+ * @ingroup     net_gnrc_netif
+ * @brief       Read stable interface attributes without asking the
+ *              interface thread
+ *
+ * Every @ref gnrc_netapi_get() is a blocking message exchange with the
+ * interface thread, i.e. two context switches. With module
+ * `gnrc_netif_attrs`, the interface thread publishes a snapshot of the
+ * attributes that only change on configuration, like the link-layer
+ * addresses, the PDU sizes and the PAN ID. It is refreshed after
+ * initialization, after every @ref gnrc_netapi_set() touching one of them
+ * and whenever the stack itself changes the IPv6 MTU, e.g. on a router
+ * advertisement.
+ *
+ * @ref gnrc_netapi_get() serves these options from the snapshot. Any other
+ * option, all writes, and reads racing with an update still go through the
+ * interface thread.
+ *
+ * The snapshot is published with a generation counter (a sequence lock): it
+ * is odd while it is written, so readers never wait and detect a torn copy
+ * by comparing the counter before and after reading. Writers hold the lock
+ * of the interface.
+ * @{
+ *
+ * @file
+ * @brief   Cached interface attributes definitions for @ref net_gnrc_netif
+ */
+#ifndef NET_GNRC_NETIF_ATTRS_H
+#define NET_GNRC_NETIF_ATTRS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "kernel_types.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netif/conf.h"
+#include "net/netopt.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name    Valid flags of @ref gnrc_netif_attrs_t::valid
+ *
+ * An attribute the interface does not support is not cached, so reading it
+ * still returns the error of the interface.
+ * @{
+ */
+#define GNRC_NETIF_ATTRS_ADDRESS        (0x01U) /**< gnrc_netif_attrs_t::addr */
+#define GNRC_NETIF_ATTRS_ADDRESS_LONG   (0x02U) /**< gnrc_netif_attrs_t::addr_long */
+#define GNRC_NETIF_ATTRS_SRC_LEN        (0x04U) /**< gnrc_netif_attrs_t::src_len */
+#define GNRC_NETIF_ATTRS_NID            (0x08U) /**< gnrc_netif_attrs_t::nid */
+#define GNRC_NETIF_ATTRS_MAX_PDU_SIZE   (0x10U) /**< gnrc_netif_attrs_t::max_pdu_size */
+#define GNRC_NETIF_ATTRS_IPV6_MTU       (0x20U) /**< gnrc_netif_attrs_t::ipv6_mtu */
+/** @} */
+
+/**
+ * @brief   Stable attributes of an interface
+ */
+typedef struct {
+#if (GNRC_NETIF_L2ADDR_MAXLEN > 0) || DOXYGEN
+    uint8_t addr[GNRC_NETIF_L2ADDR_MAXLEN];      /**< NETOPT_ADDRESS */
+    uint8_t addr_long[GNRC_NETIF_L2ADDR_MAXLEN]; /**< NETOPT_ADDRESS_LONG */
+#endif
+    uint8_t addr_len;           /**< length of gnrc_netif_attrs_t::addr */
+    uint8_t addr_long_len;      /**< length of gnrc_netif_attrs_t::addr_long */
+    uint8_t valid;              /**< valid attributes, GNRC_NETIF_ATTRS_* */
+    uint8_t device_type;        /**< NETOPT_DEVICE_TYPE */
+    uint16_t src_len;           /**< NETOPT_SRC_LEN */
+    uint16_t nid;               /**< NETOPT_NID, i.e. the PAN ID */
+    uint16_t max_pdu_size;      /**< NETOPT_MAX_PDU_SIZE of the device */
+    uint16_t ipv6_mtu;          /**< NETOPT_MAX_PDU_SIZE for IPv6 */
+} gnrc_netif_attrs_t;
+
+/**
+ * @brief   Snapshot of the stable attributes published by an interface
+ */
+typedef struct {
+    /**
+     * @brief   Generation counter, odd while an update is in progress
+     */
+    volatile uint32_t gen;
+    gnrc_netif_attrs_t attrs;   /**< the attributes */
+} gnrc_netif_attrs_cache_t;
+
+/**
+ * @brief   Checks if an option is covered by the snapshot
+ *
+ * @param[in] opt   the option
+ *
+ * @return  true, if the snapshot must be updated after @p opt was set
+ *          successfully
+ */
+bool gnrc_netif_attrs_affected(netopt_t opt);
+
+/**
+ * @brief   Copies the attributes of an interface, from any thread
+ *
+ * Never blocks: a copy racing with an update fails instead of retrying, as
+ * the interface thread may be preempted by the caller.
+ *
+ * @param[in] cache     the snapshot, i.e. gnrc_netif_t::attrs
+ * @param[out] attrs    the attributes
+ *
+ * @return  the generation of the snapshot, incremented by 2 on every update
+ * @return  0, if the snapshot was not published yet or is being updated
+ */
+uint32_t gnrc_netif_attrs_get(const gnrc_netif_attrs_cache_t *cache,
+                              gnrc_netif_attrs_t *attrs);
+
+/**
+ * @brief   Serves @ref gnrc_netapi_get() for an interface from its snapshot
+ *
+ * @param[in] pid       PID of the thread the option is requested from
+ * @param[in,out] opt   the requested option
+ *
+ * @return  the result of the get operation
+ * @return  -ENOTSUP, if @p pid is not an interface or @p opt needs to be
+ *          asked from its thread
+ */
+int gnrc_netif_attrs_netapi_get(kernel_pid_t pid, gnrc_netapi_opt_t *opt);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_NETIF_ATTRS_H */
+/** @} */
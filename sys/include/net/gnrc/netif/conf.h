@@ -156,6 +156,70 @@ extern "C" {
 #ifndef CONFIG_GNRC_NETIF_MIN_WAIT_AFTER_SEND_US
 #define CONFIG_GNRC_NETIF_MIN_WAIT_AFTER_SEND_US   (0U)
 #endif
+
+/**
+ * @brief   Number of receive buffers lent to a network device
+ *
+ * Only applies with module `gnrc_netif_rx_zerocopy` to devices supporting
+ * zero-copy reception. Every buffer occupies a full frame in the packet
+ * buffer for as long as the device holds it.
+ */
+#ifndef CONFIG_GNRC_NETIF_RX_ZEROCOPY_NUMOF
+#define CONFIG_GNRC_NETIF_RX_ZEROCOPY_NUMOF        (2U)
+#endif
+
+/**
+ * @brief   Maximum number of frames sent to a network device in one burst
+ *
+ * Only applies with module `gnrc_netif_tx_burst`.
+ */
+#ifndef CONFIG_GNRC_NETIF_TX_BURST_NUMOF
+#define CONFIG_GNRC_NETIF_TX_BURST_NUMOF           (4U)
+#endif
+
+/**
+ * @brief   Time in microseconds after which an incomplete burst is sent
+ *
+ * Only applies with module `gnrc_netif_tx_burst`. Bursts normally end with
+ * the first frame without @ref GNRC_NETIF_HDR_FLAGS_MORE_DATA set. This
+ * timeout keeps staged frames from waiting forever if that frame never
+ * comes.
+ */
+#ifndef CONFIG_GNRC_NETIF_TX_BURST_TIMEOUT_US
+#define CONFIG_GNRC_NETIF_TX_BURST_TIMEOUT_US      (10000U)
+#endif
+
+/**
+ * @brief   Maximum number of packets queued per interface while its device
+ *          is busy
+ *
+ * Only applies with module `gnrc_netif_pktq`.
+ */
+#ifndef CONFIG_GNRC_NETIF_PKTQ_LEN
+#define CONFIG_GNRC_NETIF_PKTQ_LEN                 (8U)
+#endif
+
+/**
+ * @brief   Number of priority classes of the send queue
+ *
+ * Only applies with module `gnrc_netif_pktq`. The eight class selectors of
+ * the IPv6 traffic class are mapped evenly to the priority classes, so
+ * this should be a power of two of at most 8.
+ */
+#ifndef CONFIG_GNRC_NETIF_PKTQ_PRIO_NUMOF
+#define CONFIG_GNRC_NETIF_PKTQ_PRIO_NUMOF          (2U)
+#endif
+
+/**
+ * @brief   Time in microseconds after which sending a queued packet is
+ *          retried
+ *
+ * Only applies with module `gnrc_netif_pktq`, in case the device does not
+ * report the end of a transmission.
+ */
+#ifndef CONFIG_GNRC_NETIF_PKTQ_TIMER_US
+#define CONFIG_GNRC_NETIF_PKTQ_TIMER_US            (5000U)
+#endif
 /** @} */
 
 /**
@@ -13,6 +13,13 @@
  * @file
  * @brief   IEEE 802.15.4 adaption for @ref net_gnrc_netif
  *
+ * With @ref net_gnrc_mac, the interface lets the device do CSMA-CA, ACKs and
+ * retransmissions if it supports @ref NETOPT_CSMA. Otherwise it falls back to
+ * software CSMA-CA with @ref net_csma_sender. Together with
+ * `gnrc_netif_pktq`, a busy medium doesn't block the interface thread: the
+ * frame waits in the send queue for @ref CONFIG_GNRC_NETIF_PKTQ_TIMER_US
+ * between the CCAs.
+ *
  * @author  Martine Lenders <m.lenders@fu-berlin.de>
  */
 #ifndef NET_GNRC_NETIF_IEEE802154_H
@@ -58,6 +58,39 @@ void gnrc_netif_acquire(gnrc_netif_t *netif);
  */
 void gnrc_netif_release(gnrc_netif_t *netif);
 
+#if IS_USED(MODULE_GNRC_NETIF_ATTRS) || DOXYGEN
+/**
+ * @brief   Publishes the current stable attributes of the interface
+ *
+ * @pre     Called from the thread of @p netif
+ *
+ * @see net_gnrc_netif_attrs
+ *
+ * @param[in] netif the network interface
+ *
+ * @internal
+ */
+void gnrc_netif_attrs_update(gnrc_netif_t *netif);
+
+/**
+ * @brief   Publishes the IPv6 attributes of the interface again
+ *
+ * To be called by anyone writing gnrc_netif_ipv6_t::mtu directly. Unlike
+ * gnrc_netif_attrs_update(), this does not ask the device, so it may be
+ * called from any thread.
+ *
+ * @see net_gnrc_netif_attrs
+ *
+ * @param[in] netif the network interface
+ *
+ * @internal
+ */
+void gnrc_netif_attrs_update_ipv6(gnrc_netif_t *netif);
+#else
+#define gnrc_netif_attrs_update(netif)          (void)netif
+#define gnrc_netif_attrs_update_ipv6(netif)     (void)netif
+#endif
+
 #if IS_USED(MODULE_GNRC_NETIF_IPV6) || DOXYGEN
 /**
  * @brief   Adds an IPv6 address to the interface
@@ -45,7 +45,17 @@ extern "C" {
  */
 #define GNRC_NETIF_MAC_INFO_CSMA_ENABLED       (0x0100U)
 
-#if defined(MODULE_GNRC_LWMAC) || defined(MODULE_GNRC_GOMACH)
+/**
+ * @brief   Flag to track if a device does CSMA-CA in hardware
+ *
+ * The device then also takes care of ACKs and retransmissions and reports
+ * the result of a transmission asynchronously with a TX event, so no
+ * software CSMA is needed.
+ */
+#define GNRC_NETIF_MAC_INFO_CSMA_HW            (0x0200U)
+
+#if defined(MODULE_GNRC_LWMAC) || defined(MODULE_GNRC_GOMACH) || \
+    defined(MODULE_GNRC_TSCH)
 /**
  * @brief Data type to hold MAC protocols
  */
@@ -63,6 +73,13 @@ typedef union {
      */
     gnrc_gomach_t gomach;
 #endif
+
+#ifdef MODULE_GNRC_TSCH
+    /**
+     * @brief TSCH specific structure object for storing TSCH internal states.
+     */
+    gnrc_tsch_t tsch;
+#endif
 } gnrc_mac_prot_t;
 #endif
 
@@ -80,6 +97,11 @@ typedef struct {
      */
     csma_sender_conf_t csma_conf;
 
+    /**
+     * @brief number of software CSMA backoffs of the frame being sent
+     */
+    uint8_t csma_nb;
+
 #if ((GNRC_MAC_RX_QUEUE_SIZE != 0) || (GNRC_MAC_DISPATCH_BUFFER_SIZE != 0)) || DOXYGEN
     /**
      * @brief MAC internal object which stores reception parameters, queues, and
@@ -101,7 +123,8 @@ typedef struct {
     gnrc_mac_tx_t tx;
 #endif  /* ((GNRC_MAC_TX_QUEUE_SIZE != 0) || (CONFIG_GNRC_MAC_NEIGHBOR_COUNT == 0)) || DOXYGEN */
 
-#if defined(MODULE_GNRC_LWMAC) || defined(MODULE_GNRC_GOMACH)
+#if defined(MODULE_GNRC_LWMAC) || defined(MODULE_GNRC_GOMACH) || \
+    defined(MODULE_GNRC_TSCH)
     gnrc_mac_prot_t prot;
 #endif
 } gnrc_netif_mac_t;
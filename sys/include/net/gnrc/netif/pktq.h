@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2020 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_netif_pktq  Send queue
+ * @ingroup     net_gnrc_netif
+ * @brief       Queue outgoing packets while the network device is busy
+ *
+ * With module `gnrc_netif_pktq`, a packet the device rejects with `-EBUSY`
+ * (e.g. because CSMA/CA found the medium busy) is not dropped, but queued
+ * within the interface. So are all packets arriving while the queue is not
+ * empty, to keep their order. Queued packets are sent on the next
+ * @ref NETDEV_EVENT_TX_COMPLETE, @ref NETDEV_EVENT_TX_NOACK, or
+ * @ref NETDEV_EVENT_TX_MEDIUM_BUSY event, or after
+ * @ref CONFIG_GNRC_NETIF_PKTQ_TIMER_US at the latest.
+ *
+ * The queue keeps @ref CONFIG_GNRC_NETIF_PKTQ_PRIO_NUMOF priority classes,
+ * selected by the class selector (i.e. the upper three bits) of the IPv6
+ * traffic class of a packet. Packets of a higher class are always sent
+ * first. Each interface queues at most @ref CONFIG_GNRC_NETIF_PKTQ_LEN
+ * packets; every further packet is released with `ENOBUFS` so
+ * @ref net_gnrc_neterr reports it to the sender.
+ *
+ * With @ref net_netstats_l2, the number of queued and dropped packets is
+ * counted in netstats_t::tx_queued and netstats_t::tx_dropped.
+ * @{
+ *
+ * @file
+ * @brief   Send queue definitions for @ref net_gnrc_netif
+ */
+#ifndef NET_GNRC_NETIF_PKTQ_H
+#define NET_GNRC_NETIF_PKTQ_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "kernel_types.h"
+#include "msg.h"
+#include "net/gnrc/netif/conf.h"
+#include "net/gnrc/pkt.h"
+#include "net/gnrc/pktqueue.h"
+#include "xtimer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Message type sent to the interface thread to send a queued packet
+ */
+#define GNRC_NETIF_PKTQ_DEQUEUE_MSG     (0x1236)
+
+/**
+ * @brief   Send queue of an interface
+ */
+typedef struct {
+    /**
+     * @brief   Queued packets, one queue per priority class, highest first
+     */
+    gnrc_pktqueue_t *queue[CONFIG_GNRC_NETIF_PKTQ_PRIO_NUMOF];
+    /**
+     * @brief   Queue nodes, a node is free if its packet is NULL
+     */
+    gnrc_pktqueue_t nodes[CONFIG_GNRC_NETIF_PKTQ_LEN];
+    xtimer_t retry_timer;   /**< sends a queued packet after a timeout */
+    msg_t dequeue_msg;      /**< message sent by gnrc_netif_pktq_t::retry_timer */
+    kernel_pid_t pid;       /**< PID of the interface thread */
+} gnrc_netif_pktq_t;
+
+/**
+ * @brief   Initializes the send queue of an interface
+ *
+ * @param[out] q    The send queue
+ * @param[in] pid   PID of the interface thread
+ */
+void gnrc_netif_pktq_init(gnrc_netif_pktq_t *q, kernel_pid_t pid);
+
+/**
+ * @brief   Gets the priority class of a packet
+ *
+ * @param[in] pkt   A packet in send order, starting with its netif header
+ *
+ * @return  Index of the priority class, 0 being the highest. Packets
+ *          without IPv6 traffic class (or with its class selector elided by
+ *          6LoWPAN header compression) have the class of traffic class 0.
+ */
+unsigned gnrc_netif_pktq_prio(const gnrc_pktsnip_t *pkt);
+
+/**
+ * @brief   Appends a packet to the send queue
+ *
+ * @param[in] q     The send queue
+ * @param[in] pkt   The packet to queue
+ *
+ * @return  0 on success
+ * @return  -ENOBUFS, if the queue is full
+ */
+int gnrc_netif_pktq_put(gnrc_netif_pktq_t *q, gnrc_pktsnip_t *pkt);
+
+/**
+ * @brief   Puts a packet back to the front of its priority class
+ *
+ * Used for a packet taken with gnrc_netif_pktq_get() the device was still
+ * too busy for.
+ *
+ * @param[in] q     The send queue
+ * @param[in] pkt   The packet to queue
+ *
+ * @return  0 on success
+ * @return  -ENOBUFS, if the queue is full
+ */
+int gnrc_netif_pktq_push_back(gnrc_netif_pktq_t *q, gnrc_pktsnip_t *pkt);
+
+/**
+ * @brief   Takes the next packet to send from the send queue
+ *
+ * @param[in] q     The send queue
+ *
+ * @return  The oldest packet of the highest non-empty priority class
+ * @return  NULL, if the queue is empty
+ */
+gnrc_pktsnip_t *gnrc_netif_pktq_get(gnrc_netif_pktq_t *q);
+
+/**
+ * @brief   Gets the number of queued packets
+ *
+ * @param[in] q     The send queue
+ *
+ * @return  Number of queued packets
+ */
+unsigned gnrc_netif_pktq_usage(const gnrc_netif_pktq_t *q);
+
+/**
+ * @brief   Checks if the send queue is empty
+ *
+ * @param[in] q     The send queue
+ *
+ * @return  true, if no packet is queued
+ */
+static inline bool gnrc_netif_pktq_empty(const gnrc_netif_pktq_t *q)
+{
+    for (unsigned i = 0; i < CONFIG_GNRC_NETIF_PKTQ_PRIO_NUMOF; i++) {
+        if (q->queue[i] != NULL) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief   Schedules sending a queued packet after
+ *          @ref CONFIG_GNRC_NETIF_PKTQ_TIMER_US
+ *
+ * @param[in] q     The send queue
+ */
+static inline void gnrc_netif_pktq_sched_get(gnrc_netif_pktq_t *q)
+{
+    xtimer_set_msg(&q->retry_timer, CONFIG_GNRC_NETIF_PKTQ_TIMER_US,
+                   &q->dequeue_msg, q->pid);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_NETIF_PKTQ_H */
+/** @} */
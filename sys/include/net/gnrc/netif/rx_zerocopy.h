@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2020 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_netif_rx_zerocopy  Zero-copy reception
+ * @ingroup     net_gnrc_netif
+ * @brief       Let network devices receive directly into the packet buffer
+ *
+ * With module `gnrc_netif_rx_zerocopy`, an interface whose device supports
+ * @ref netdev_driver_t::rx_buf_give and @ref netdev_driver_t::recv_zc lends
+ * @ref CONFIG_GNRC_NETIF_RX_ZEROCOPY_NUMOF frame sized packet snips to the
+ * device. The device writes received frames directly into these snips, so
+ * the interface gets a ready @ref gnrc_pktsnip_t without asking the device
+ * for the frame length first and without copying the frame.
+ *
+ * Devices without zero-copy support keep using @ref netdev_driver_t::recv.
+ * @{
+ *
+ * @file
+ * @brief   Zero-copy reception definitions for @ref net_gnrc_netif
+ */
+#ifndef NET_GNRC_NETIF_RX_ZEROCOPY_H
+#define NET_GNRC_NETIF_RX_ZEROCOPY_H
+
+#include "net/gnrc/netif.h"
+#include "net/gnrc/pkt.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Lends all receive buffers of an interface to its device
+ *
+ * Called by the interface thread once the device is initialized. Does
+ * nothing if the device does not support zero-copy reception.
+ *
+ * @param[in] netif     The network interface
+ * @param[in] size      Maximum frame size of the device. The buffers are
+ *                      larger if the device asks for it via
+ *                      @ref NETOPT_RX_BUF_SIZE.
+ *
+ * @return  Number of buffers lent to the device
+ */
+unsigned gnrc_netif_rx_zerocopy_init(gnrc_netif_t *netif, size_t size);
+
+/**
+ * @brief   Takes a received frame from the device
+ *
+ * The packet snip holding the frame is replaced by a fresh one, which is
+ * lent to the device in its place. If no fresh snip can be allocated, the
+ * received frame is dropped and its snip is lent to the device again, so
+ * the device never runs out of receive buffers. Should the device refuse a
+ * buffer, gnrc_netif_t::rx_bufs_numof is decremented and a warning logged.
+ *
+ * @pre `netdev_rx_zerocopy(netif->dev)`
+ *
+ * @param[in] netif     The network interface
+ * @param[out] info     Device specific status information for the frame.
+ *                      May be NULL.
+ *
+ * @return  Packet snip of type @ref GNRC_NETTYPE_UNDEF holding the frame
+ * @return  NULL, if no frame was received or the frame was dropped
+ */
+gnrc_pktsnip_t *gnrc_netif_rx_zerocopy_recv(gnrc_netif_t *netif, void *info);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_NETIF_RX_ZEROCOPY_H */
+/** @} */
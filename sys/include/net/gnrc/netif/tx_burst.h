@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2020 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_netif_tx_burst  Burst transmission
+ * @ingroup     net_gnrc_netif
+ * @brief       Hand consecutive frames to a network device in one call
+ *
+ * With module `gnrc_netif_tx_burst`, an interface stages outgoing frames
+ * that have @ref GNRC_NETIF_HDR_FLAGS_MORE_DATA set, e.g. all but the last
+ * fragment of a 6LoWPAN datagram. The first frame without that flag, or
+ * @ref CONFIG_GNRC_NETIF_TX_BURST_NUMOF staged frames, hand the whole burst
+ * to the device with @ref netdev_send_burst. Devices implementing
+ * @ref netdev_driver_t::send_burst can then queue the next frame while the
+ * previous one is still being transmitted.
+ *
+ * Staged frames are sent after @ref CONFIG_GNRC_NETIF_TX_BURST_TIMEOUT_US at
+ * the latest.
+ *
+ * Currently only used by the IEEE 802.15.4 adaption without CSMA/CA in
+ * software.
+ * @{
+ *
+ * @file
+ * @brief   Burst transmission definitions for @ref net_gnrc_netif
+ */
+#ifndef NET_GNRC_NETIF_TX_BURST_H
+#define NET_GNRC_NETIF_TX_BURST_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "iolist.h"
+#include "kernel_types.h"
+#include "msg.h"
+#include "net/gnrc/netif/conf.h"
+#include "net/gnrc/pkt.h"
+#include "net/ieee802154.h"
+#include "net/netdev.h"
+#include "xtimer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Message type sent to the interface thread when a burst timed out
+ */
+#define GNRC_NETIF_TX_BURST_MSG_TYPE_FLUSH  (0x1235)
+
+/**
+ * @brief   Size of the link-layer header buffer of every staged frame
+ */
+#define GNRC_NETIF_TX_BURST_HDR_LEN         (IEEE802154_MAX_HDR_LEN)
+
+/**
+ * @brief   Frames staged for burst transmission
+ */
+typedef struct {
+    /**
+     * @brief   Packets of the staged frames, released once sent
+     */
+    gnrc_pktsnip_t *pkts[CONFIG_GNRC_NETIF_TX_BURST_NUMOF];
+    /**
+     * @brief   First IO vector of every staged frame, pointing to its
+     *          link-layer header
+     */
+    iolist_t frames[CONFIG_GNRC_NETIF_TX_BURST_NUMOF];
+    /**
+     * @brief   Link-layer headers of the staged frames
+     */
+    uint8_t hdrs[CONFIG_GNRC_NETIF_TX_BURST_NUMOF][GNRC_NETIF_TX_BURST_HDR_LEN];
+    xtimer_t timer;         /**< flush timeout */
+    msg_t msg;              /**< flush message sent by gnrc_netif_tx_burst_t::timer */
+    kernel_pid_t pid;       /**< PID of the interface thread */
+    uint8_t numof;          /**< number of staged frames */
+} gnrc_netif_tx_burst_t;
+
+/**
+ * @brief   Initializes the burst stage of an interface
+ *
+ * @param[out] burst    The burst stage
+ * @param[in] pid       PID of the interface thread
+ */
+void gnrc_netif_tx_burst_init(gnrc_netif_tx_burst_t *burst, kernel_pid_t pid);
+
+/**
+ * @brief   Gets the header buffer of the next frame to stage
+ *
+ * @param[in] burst     The burst stage
+ *
+ * @return  Buffer of @ref GNRC_NETIF_TX_BURST_HDR_LEN bytes
+ */
+static inline uint8_t *gnrc_netif_tx_burst_hdr(gnrc_netif_tx_burst_t *burst)
+{
+    return burst->hdrs[burst->numof];
+}
+
+/**
+ * @brief   Stages a frame and sends the burst if it is complete
+ *
+ * The frame consists of the header written to
+ * @ref gnrc_netif_tx_burst_hdr() followed by the payload snips of @p pkt.
+ * @p pkt is released once the frame was handed to the device.
+ *
+ * @param[in] burst     The burst stage
+ * @param[in] dev       The network device to send with
+ * @param[in] pkt       The packet to send, starting with its netif header
+ * @param[in] hdr_len   Length of the link-layer header
+ * @param[in] more      Another frame of the same burst follows
+ *
+ * @return  0, if the frame was staged
+ * @return  Return value of gnrc_netif_tx_burst_flush(), if the burst was sent
+ */
+int gnrc_netif_tx_burst_send(gnrc_netif_tx_burst_t *burst, netdev_t *dev,
+                             gnrc_pktsnip_t *pkt, size_t hdr_len, bool more);
+
+/**
+ * @brief   Sends all staged frames
+ *
+ * @param[in] burst     The burst stage
+ * @param[in] dev       The network device to send with
+ *
+ * @return  Number of bytes of all frames accepted by the device
+ * @return  Negative errno, if the device accepted none of the frames
+ */
+int gnrc_netif_tx_burst_flush(gnrc_netif_tx_burst_t *burst, netdev_t *dev);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_NETIF_TX_BURST_H */
+/** @} */
@@ -10,6 +10,17 @@
  * @defgroup    net_gnrc_netreg  Network protocol registry
  * @ingroup     net_gnrc
  * @brief       Registry to receive messages of a specified protocol type by GNRC.
+ *
+ * By default the entries of every @ref gnrc_nettype_t are kept in a single
+ * list, so a lookup is linear in the number of entries registered for that
+ * type. With module `gnrc_netreg_hash` the entries of every type are
+ * distributed over @ref CONFIG_GNRC_NETREG_HASH_BUCKETS lists by their
+ * @ref gnrc_netreg_entry_t::demux_ctx "demux context". A lookup then only
+ * visits the entries of its own bucket, which is constant-time as long as
+ * there are not substantially more demux contexts registered than buckets.
+ *
+ * With module `gnrc_netreg_stats` the registry counts lookups and the entries
+ * visited by them, see @ref gnrc_netreg_get_stats().
  * @{
  *
  * @file
@@ -35,6 +46,23 @@
 extern "C" {
 #endif
 
+/**
+ * @defgroup net_gnrc_netreg_conf  GNRC network protocol registry compile configurations
+ * @ingroup net_gnrc_conf
+ * @{
+ */
+/**
+ * @brief   Number of hash buckets per @ref gnrc_nettype_t
+ *
+ * @note    Only used with module `gnrc_netreg_hash`.
+ *
+ * @attention   Must be a power of 2.
+ */
+#ifndef CONFIG_GNRC_NETREG_HASH_BUCKETS
+#define CONFIG_GNRC_NETREG_HASH_BUCKETS     (8U)
+#endif
+/** @} */
+
 #if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS) || \
     defined(DOXYGEN)
 /**
@@ -377,6 +405,38 @@ gnrc_netreg_entry_t *gnrc_netreg_getnext(gnrc_netreg_entry_t *entry);
 
 int gnrc_netreg_calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr);
 
+#if defined(MODULE_GNRC_NETREG_STATS) || defined(DOXYGEN)
+/**
+ * @brief   Lookup statistics of the registry
+ *
+ * @note    Only available with module `gnrc_netreg_stats`.
+ */
+typedef struct {
+    uint32_t lookups;   /**< number of searches, including the ones issued by
+                         *   gnrc_netreg_getnext() and gnrc_netreg_num() */
+    uint32_t visited;   /**< number of entries compared by all searches */
+} gnrc_netreg_stats_t;
+
+/**
+ * @brief   Get the lookup statistics of the registry
+ *
+ * The average lookup cost is gnrc_netreg_stats_t::visited divided by
+ * gnrc_netreg_stats_t::lookups.
+ *
+ * @note    Only available with module `gnrc_netreg_stats`.
+ *
+ * @param[out] stats    The lookup statistics
+ */
+void gnrc_netreg_get_stats(gnrc_netreg_stats_t *stats);
+
+/**
+ * @brief   Reset the lookup statistics of the registry
+ *
+ * @note    Only available with module `gnrc_netreg_stats`.
+ */
+void gnrc_netreg_reset_stats(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -120,6 +120,10 @@ typedef struct gnrc_pktsnip {
     kernel_pid_t err_sub;           /**< subscriber to errors related to this
                                      *   packet snip */
 #endif
+#ifdef MODULE_GNRC_PKTBUF_PRESSURE
+    uint8_t owner;                  /**< type the snip was created with,
+                                     *   internal */
+#endif
 } gnrc_pktsnip_t;
 
 /**
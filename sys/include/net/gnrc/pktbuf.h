@@ -62,6 +62,16 @@ extern "C" {
 #ifndef CONFIG_GNRC_PKTBUF_SIZE
 #define CONFIG_GNRC_PKTBUF_SIZE    (6144)
 #endif
+
+/**
+ * @brief   Free bytes in the packet buffer below which the callback set with
+ *          gnrc_pktbuf_set_pressure_cb() is called.
+ *
+ * @note    Only used with module `gnrc_pktbuf_pressure`
+ */
+#ifndef CONFIG_GNRC_PKTBUF_LOW_WATERMARK
+#define CONFIG_GNRC_PKTBUF_LOW_WATERMARK    (CONFIG_GNRC_PKTBUF_SIZE / 8)
+#endif
 /** @} */
 
 /**
@@ -186,7 +196,9 @@ static inline void gnrc_pktbuf_release(gnrc_pktsnip_t *pkt)
  *
  * @details This function duplicates a packet snip in the packet buffer (both
  *          the instance of the gnrc_pktsnip_t and its data) if
- *          gnrc_pktsnip_t::users of @p pkt > 1.
+ *          gnrc_pktsnip_t::users of @p pkt > 1. The snips following @p pkt
+ *          stay shared, see gnrc_pktbuf_clone_headers() to write into
+ *          several of them.
  *
  * @param[in] pkt   The packet snip you want to write into.
  *
@@ -196,6 +208,29 @@ static inline void gnrc_pktbuf_release(gnrc_pktsnip_t *pkt)
  */
 gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt);
 
+/**
+ * @brief   Gets write access to the headers of a packet while its payload
+ *          stays shared.
+ *
+ * Calls gnrc_pktbuf_start_write() on every snip from @p pkt up to
+ * @p payload and links the results, so only the headers of a packet held by
+ * several users are duplicated. This is what a sender to several
+ * destinations needs to fill in per-destination headers without a copy of
+ * the payload per destination.
+ *
+ * @note    @p pkt is released on failure.
+ *
+ * @param[in] pkt       A packet in send order.
+ * @param[in] payload   The first snip of @p pkt that is not written to.
+ *                      NULL to get write access to all snips.
+ *
+ * @return  The packet with writable headers.
+ * @return  NULL, when there is not enough space in the packet buffer. @p pkt
+ *          is released in that case.
+ */
+gnrc_pktsnip_t *gnrc_pktbuf_clone_headers(gnrc_pktsnip_t *pkt,
+                                          gnrc_pktsnip_t *payload);
+
 /**
  * @brief   Deletes a snip from a packet and the packet buffer.
  *
@@ -306,6 +341,67 @@ int gnrc_pktbuf_merge(gnrc_pktsnip_t *pkt);
 void gnrc_pktbuf_stats(void);
 #endif
 
+#if defined(MODULE_GNRC_PKTBUF_PRESSURE) || defined(DOXYGEN)
+/**
+ * @brief   Callback for memory pressure in the packet buffer
+ *
+ * Called in the thread that allocated, outside of the packet buffer's lock.
+ * As the packets to drop usually belong to other threads, the callback
+ * should only hand over to those, e.g. by sending
+ * @ref GNRC_SIXLOWPAN_FRAG_RB_RECLAIM_MSG to the 6LoWPAN thread with
+ * msg_try_send().
+ *
+ * @param[in] avail Free bytes left in the packet buffer
+ * @param[in] arg   Argument given to gnrc_pktbuf_set_pressure_cb()
+ */
+typedef void (*gnrc_pktbuf_pressure_cb_t)(size_t avail, void *arg);
+
+/**
+ * @brief   Sets the callback for memory pressure
+ *
+ * @p cb is called when the free space falls below
+ * @ref CONFIG_GNRC_PKTBUF_LOW_WATERMARK, once until it is above again, and on
+ * every failed allocation.
+ *
+ * @note    Only available with module `gnrc_pktbuf_pressure`, which requires
+ *          `gnrc_pktbuf_static`
+ *
+ * @param[in] cb    Callback, NULL to disable
+ * @param[in] arg   Argument of @p cb
+ */
+void gnrc_pktbuf_set_pressure_cb(gnrc_pktbuf_pressure_cb_t cb, void *arg);
+
+/**
+ * @brief   Gets the number of snips in the packet buffer owned by a type
+ *
+ * A snip is owned by the type it was created with, even if its type is
+ * changed later, so growing numbers point at the module holding on to
+ * packets.
+ *
+ * @note    Only available with module `gnrc_pktbuf_pressure`
+ *
+ * @param[in] owner Type the snips were created with
+ *
+ * @return  Number of snips in the packet buffer created with @p owner
+ */
+unsigned gnrc_pktbuf_owned(gnrc_nettype_t owner);
+
+/**
+ * @brief   Prints a one-line report of the packet buffer's usage
+ *
+ * Prints the bytes in use, how often the watermark was crossed and
+ * allocations failed, and the snips per owning type as `<type>:<snips>`,
+ * e.g.
+ *
+ *      pktbuf: used 1344/6144 low 2 fail 0 snips -1:1 0:1 3:4
+ *
+ * Meant to be called periodically, e.g. by a thread of the application.
+ *
+ * @note    Only available with module `gnrc_pktbuf_pressure`
+ */
+void gnrc_pktbuf_report(void);
+#endif
+
 /* for testing */
 #ifdef TEST_SUITES
 /**
@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2020 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_pktbuf_slab   Size-class slab packet buffer
+ * @ingroup     net_gnrc_pktbuf
+ * @brief       Packet buffer backend using fixed-size slabs per size class
+ *
+ * This backend replaces the first-fit free list of `gnrc_pktbuf_static` with
+ * a fixed set of size classes. Every class consists of a statically allocated
+ * array of equally sized blocks and a free list of unused blocks, so
+ * allocating and freeing a block is O(1) and the buffer can not fragment.
+ *
+ * There is one class reserved for @ref gnrc_pktsnip_t headers and three
+ * classes for packet data:
+ *
+ * - small: protocol headers (e.g. @ref gnrc_netif_hdr_t, IPv6 or UDP headers)
+ * - frame: complete IEEE 802.15.4 frames (127 bytes)
+ * - large: complete IPv6 datagrams (1280 bytes MTU)
+ *
+ * Data is allocated from the smallest class it fits in. If that class is
+ * exhausted, the next larger class is used. A block may be shared by several
+ * snips after @ref gnrc_pktbuf_mark() split its content; it is returned to
+ * its class once the last snip referencing it is released.
+ *
+ * Enable this backend with `USEMODULE += gnrc_pktbuf_slab`.
+ *
+ * @{
+ *
+ * @file
+ * @brief   Size-class slab packet buffer definitions
+ */
+#ifndef NET_GNRC_PKTBUF_SLAB_H
+#define NET_GNRC_PKTBUF_SLAB_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup net_gnrc_pktbuf_slab_conf  GNRC slab packet buffer compile configurations
+ * @ingroup net_gnrc_conf
+ * @{
+ */
+/**
+ * @brief   Number of @ref gnrc_pktsnip_t headers
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_SNIP_NUMOF
+#define CONFIG_GNRC_PKTBUF_SLAB_SNIP_NUMOF      (32U)
+#endif
+
+/**
+ * @brief   Block size of the small data class in byte
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_SMALL_SIZE
+#define CONFIG_GNRC_PKTBUF_SLAB_SMALL_SIZE      (64U)
+#endif
+
+/**
+ * @brief   Number of blocks in the small data class
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_SMALL_NUMOF
+#define CONFIG_GNRC_PKTBUF_SLAB_SMALL_NUMOF     (16U)
+#endif
+
+/**
+ * @brief   Block size of the frame data class in byte
+ *
+ * Fits a complete IEEE 802.15.4 frame by default.
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_FRAME_SIZE
+#define CONFIG_GNRC_PKTBUF_SLAB_FRAME_SIZE      (128U)
+#endif
+
+/**
+ * @brief   Number of blocks in the frame data class
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_FRAME_NUMOF
+#define CONFIG_GNRC_PKTBUF_SLAB_FRAME_NUMOF     (8U)
+#endif
+
+/**
+ * @brief   Block size of the large data class in byte
+ *
+ * Fits a complete IPv6 datagram of minimum MTU by default. When Ethernet
+ * interfaces are used, the block needs to fit a full Ethernet frame.
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_LARGE_SIZE
+#ifdef MODULE_NETDEV_ETH
+#define CONFIG_GNRC_PKTBUF_SLAB_LARGE_SIZE      (1536U)
+#else
+#define CONFIG_GNRC_PKTBUF_SLAB_LARGE_SIZE      (1280U)
+#endif
+#endif
+
+/**
+ * @brief   Number of blocks in the large data class
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_LARGE_NUMOF
+#define CONFIG_GNRC_PKTBUF_SLAB_LARGE_NUMOF     (3U)
+#endif
+/** @} */
+
+/**
+ * @brief   Size classes of the slab packet buffer
+ */
+typedef enum {
+    GNRC_PKTBUF_SLAB_SNIP = 0,  /**< @ref gnrc_pktsnip_t headers */
+    GNRC_PKTBUF_SLAB_SMALL,     /**< small data blocks */
+    GNRC_PKTBUF_SLAB_FRAME,     /**< link layer frame sized data blocks */
+    GNRC_PKTBUF_SLAB_LARGE,     /**< MTU sized data blocks */
+    GNRC_PKTBUF_SLAB_NUMOF,     /**< number of size classes */
+} gnrc_pktbuf_slab_class_t;
+
+/**
+ * @brief   Usage statistics of a size class
+ */
+typedef struct {
+    uint16_t size;          /**< block size in byte */
+    uint16_t numof;         /**< total number of blocks */
+    uint16_t used;          /**< number of blocks currently in use */
+    uint16_t max_used;      /**< high-water mark of blocks in use */
+    uint32_t fallbacks;     /**< allocations served by the next larger class
+                             *   because this class was exhausted */
+    uint32_t failures;      /**< allocations that were not served */
+} gnrc_pktbuf_slab_stats_t;
+
+/**
+ * @brief   Get usage statistics of a size class
+ *
+ * @param[in]  cls      A size class
+ * @param[out] stats    Statistics of @p cls
+ *
+ * @return  0 on success
+ * @return  -EINVAL, if @p cls is not a valid size class
+ */
+int gnrc_pktbuf_slab_get_stats(gnrc_pktbuf_slab_class_t cls,
+                               gnrc_pktbuf_slab_stats_t *stats);
+
+/**
+ * @brief   Reset the high-water marks and counters of all size classes
+ *
+ * The high-water marks are set to the number of blocks currently in use.
+ */
+void gnrc_pktbuf_slab_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_PKTBUF_SLAB_H */
+/** @} */
@@ -11,6 +11,11 @@
  * @defgroup    net_gnrc_priority_pktqueue Priority packet queue for GNRC
  * @ingroup     net_gnrc
  * @brief       Wrapper for priority_queue that holds gnrc_pktsnip_t*
+ *
+ * With module `gnrc_priority_pktqueue_heap` the queue is a
+ * @ref priority_heap_t instead of a sorted list, which adds packets in O(1)
+ * instead of O(n) at the cost of three more words per node. The order of
+ * the packets and the API stay the same.
  * @{
  *
  * @file
@@ -25,7 +30,9 @@
 
 #include <stdint.h>
 
+#include "kernel_defines.h"
 #include "priority_queue.h"
+#include "priority_heap.h"
 #include "net/gnrc/pkt.h"
 
 #ifdef __cplusplus
@@ -39,12 +46,22 @@ typedef struct gnrc_priority_pktqueue_node {
     struct gnrc_priority_pktqueue_node *next;   /**< next queue node */
     uint32_t priority;                          /**< queue node priority */
     gnrc_pktsnip_t *pkt;                        /**< queue node data */
+#if IS_USED(MODULE_GNRC_PRIORITY_PKTQUEUE_HEAP) || defined(DOXYGEN)
+    /* the remaining fields of priority_heap_node_t */
+    struct gnrc_priority_pktqueue_node *child;  /**< first child */
+    struct gnrc_priority_pktqueue_node *prev;   /**< previous sibling */
+    uint32_t seq;                               /**< order of addition */
+#endif
 } gnrc_priority_pktqueue_node_t;
 
 /**
  * @brief data type for gnrc priority packet queues
  */
+#if IS_USED(MODULE_GNRC_PRIORITY_PKTQUEUE_HEAP)
+typedef priority_heap_t gnrc_priority_pktqueue_t;
+#else
 typedef priority_queue_t gnrc_priority_pktqueue_t;
+#endif
 
 /**
  * @brief Static initializer for gnrc_priority_pktqueue_node_t.
@@ -73,6 +90,10 @@ static inline void gnrc_priority_pktqueue_node_init(gnrc_priority_pktqueue_node_
     node->next = NULL;
     node->priority = priority;
     node->pkt = pkt;
+#if IS_USED(MODULE_GNRC_PRIORITY_PKTQUEUE_HEAP)
+    node->child = NULL;
+    node->prev = NULL;
+#endif
 }
 
 /**
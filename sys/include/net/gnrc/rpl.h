@@ -29,6 +29,12 @@
  *   USEMODULE += auto_init_gnrc_rpl
  *   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  *
+ * - Skip processing of DIOs consistent with the current DODAG state (see
+ *   @ref CONFIG_GNRC_RPL_DIO_FILTER_REFRESH)
+ *   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ {.mk}
+ *   USEMODULE += gnrc_rpl_dio_filter
+ *   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
  * Auto-Initialization
  * -------------------
  *
@@ -374,8 +380,31 @@ static inline bool GNRC_RPL_COUNTER_GREATER_THAN(uint8_t A, uint8_t B)
  */
 #define CONFIG_GNRC_RPL_DAO_DELAY_JITTER   (1000UL)
 #endif
+#ifndef CONFIG_GNRC_RPL_DAO_AGGREGATION_DELAY
+/**
+ * @brief Delay for DAOs after a DAO of a child in milli seconds
+ *
+ * DAOs of children received while a DAO is scheduled do not delay it any
+ * further, so all targets received within this delay are sent in one DAO.
+ */
+#define CONFIG_GNRC_RPL_DAO_AGGREGATION_DELAY   (CONFIG_GNRC_RPL_DAO_DELAY_DEFAULT)
+#endif
 /** @} */
 
+/**
+ * @brief Interval in milliseconds in which DIOs of the preferred parent are
+ *        fully processed at least once
+ *
+ * With module `gnrc_rpl_dio_filter`, DIOs consistent with the current state
+ * of the DODAG (same version, and same rank and DTSN of a known parent) are
+ * only counted for trickle and refresh the lifetime of their parent, but
+ * their options are not processed again. This ensures options of the
+ * preferred parent, e.g. prefix lifetimes, are still refreshed.
+ */
+#ifndef CONFIG_GNRC_RPL_DIO_FILTER_REFRESH
+#define CONFIG_GNRC_RPL_DIO_FILTER_REFRESH  (60 * MS_PER_SEC)
+#endif
+
 /**
  * @brief Cleanup interval in milliseconds.
  */
@@ -644,6 +673,19 @@ void gnrc_rpl_delay_dao(gnrc_rpl_dodag_t *dodag);
  */
 void gnrc_rpl_long_delay_dao(gnrc_rpl_dodag_t *dodag);
 
+/**
+ * @brief   Delay the DAO sending interval after a DAO of a child
+ *
+ * Unlike gnrc_rpl_delay_dao(), a DAO that is already scheduled is not
+ * delayed any further, so it contains the targets of all children that sent a
+ * DAO in the meantime.
+ *
+ * @see @ref CONFIG_GNRC_RPL_DAO_AGGREGATION_DELAY
+ *
+ * @param[in] dodag     The DODAG of the DAO
+ */
+void gnrc_rpl_aggregate_dao(gnrc_rpl_dodag_t *dodag);
+
 /**
  * @brief Create a new RPL instance and RPL DODAG.
  *
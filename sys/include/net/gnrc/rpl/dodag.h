@@ -129,6 +129,17 @@ void gnrc_rpl_dodag_remove_all_parents(gnrc_rpl_dodag_t *dodag);
 bool gnrc_rpl_parent_add_by_addr(gnrc_rpl_dodag_t *dodag, ipv6_addr_t *addr,
                                  gnrc_rpl_parent_t **parent);
 
+/**
+ * @brief   Get the parent with the IPv6 address @p addr of the @p dodag.
+ *
+ * @param[in]   dodag           Pointer to the DODAG
+ * @param[in]   addr            IPV6 address of the parent
+ *
+ * @return  Pointer to the parent, if it exists.
+ * @return  NULL, otherwise.
+ */
+gnrc_rpl_parent_t *gnrc_rpl_parent_get(gnrc_rpl_dodag_t *dodag, const ipv6_addr_t *addr);
+
 /**
  * @brief   Remove the @p parent from its DODAG.
  *
@@ -147,6 +158,13 @@ bool gnrc_rpl_parent_remove(gnrc_rpl_parent_t *parent);
  */
 void gnrc_rpl_parent_update(gnrc_rpl_dodag_t *dodag, gnrc_rpl_parent_t *parent);
 
+/**
+ * @brief   Restart the lifetime of a @p parent without updating the DODAG.
+ *
+ * @param[in] parent    Pointer to the parent
+ */
+void gnrc_rpl_parent_refresh(gnrc_rpl_parent_t *parent);
+
 /**
  * @brief Removes the dodag state of @p dodag after
  * CONFIG_GNRC_RPL_CLEANUP_TIME milliseconds
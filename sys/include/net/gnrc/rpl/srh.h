@@ -13,6 +13,12 @@
  * @see <a href="https://tools.ietf.org/html/rfc6554">
  *          RFC 6554
  *      </a>
+ * A non-storing root can build compressed headers with
+ * gnrc_rpl_srh_build(). With module `gnrc_rpl_srh_cache`, built headers are
+ * kept per destination, so forwarding a packet downwards only copies the
+ * cached header instead of constructing the route again. The cache is
+ * flushed whenever a DAO changes the forwarding table.
+ *
  * @{
  *
  * @file
@@ -23,6 +29,8 @@
 #ifndef NET_GNRC_RPL_SRH_H
 #define NET_GNRC_RPL_SRH_H
 
+#include <stddef.h>
+
 #include "net/ipv6/hdr.h"
 #include "net/ipv6/addr.h"
 
@@ -30,6 +38,26 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Number of destinations in the source route cache
+ *
+ * @note    Only used with module `gnrc_rpl_srh_cache`
+ */
+#ifndef CONFIG_GNRC_RPL_SRH_CACHE_SIZE
+#define CONFIG_GNRC_RPL_SRH_CACHE_SIZE      (8U)
+#endif
+
+/**
+ * @brief   Maximum size of a cached source routing header in bytes
+ *
+ * Routes with longer headers are not cached.
+ *
+ * @note    Only used with module `gnrc_rpl_srh_cache`
+ */
+#ifndef CONFIG_GNRC_RPL_SRH_CACHE_HDR_SIZE
+#define CONFIG_GNRC_RPL_SRH_CACHE_HDR_SIZE  (64U)
+#endif
+
 /**
  * @brief   The RPL Source routing header.
  *
@@ -69,6 +97,77 @@ typedef struct __attribute__((packed)) {
  */
 int gnrc_rpl_srh_process(ipv6_hdr_t *ipv6, gnrc_rpl_srh_t *rh, void **err_ptr);
 
+/**
+ * @brief   Build a compressed RPL source routing header
+ *
+ * The packet is sent to `route[0]`, so that address becomes the destination
+ * of the IPv6 header and all others are put into the routing header. The
+ * prefix they share with `route[0]` is elided (CmprI for all but the last
+ * address, CmprE for the last one).
+ *
+ * @param[out] rh       The routing header, gnrc_rpl_srh_t::nh is left to the
+ *                      caller.
+ * @param[in] size      Size of the buffer at @p rh.
+ * @param[in] route     The hops to the destination, the destination last.
+ * @param[in] num       Number of addresses in @p route, at least 2.
+ *
+ * @return  Length of the routing header in bytes, a multiple of 8.
+ * @return  -EINVAL, if @p num is less than 2 or the route is too long for a
+ *          routing header.
+ * @return  -ENOBUFS, if @p size is too small.
+ */
+int gnrc_rpl_srh_build(gnrc_rpl_srh_t *rh, size_t size,
+                       const ipv6_addr_t *route, unsigned num);
+
+#if defined(MODULE_GNRC_RPL_SRH_CACHE) || defined(DOXYGEN)
+/**
+ * @brief   Build a routing header and cache it for the last address of
+ *          @p route
+ *
+ * When the cache is full, the oldest entry is replaced.
+ *
+ * @note    Only available with module `gnrc_rpl_srh_cache`
+ *
+ * @param[in] route     The hops to the destination, the destination last.
+ * @param[in] num       Number of addresses in @p route, at least 2.
+ *
+ * @return  0 on success.
+ * @return  -EINVAL, if @p num is less than 2 or the route is too long for a
+ *          routing header.
+ * @return  -ENOBUFS, if the header is larger than
+ *          @ref CONFIG_GNRC_RPL_SRH_CACHE_HDR_SIZE.
+ */
+int gnrc_rpl_srh_cache_add(const ipv6_addr_t *route, unsigned num);
+
+/**
+ * @brief   Get the cached routing header for a destination
+ *
+ * @note    Only available with module `gnrc_rpl_srh_cache`
+ *
+ * @param[in] dst       The final destination.
+ * @param[out] next_hop The destination of the IPv6 header.
+ * @param[out] rh       The routing header, gnrc_rpl_srh_t::nh is left to the
+ *                      caller.
+ * @param[in] size      Size of the buffer at @p rh.
+ *
+ * @return  Length of the routing header in bytes.
+ * @return  -ENOENT, if no header is cached for @p dst.
+ * @return  -ENOBUFS, if @p size is too small.
+ */
+int gnrc_rpl_srh_cache_get(const ipv6_addr_t *dst, ipv6_addr_t *next_hop,
+                           gnrc_rpl_srh_t *rh, size_t size);
+
+/**
+ * @brief   Drop all cached routing headers
+ *
+ * A changed parent affects the routes of its whole sub-DODAG, so all of them
+ * are dropped.
+ *
+ * @note    Only available with module `gnrc_rpl_srh_cache`
+ */
+void gnrc_rpl_srh_cache_flush(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -29,6 +29,7 @@ extern "C" {
 #endif
 
 #include "byteorder.h"
+#include "kernel_defines.h"
 #include "net/ipv6/addr.h"
 #include "evtimer.h"
 #include "evtimer_msg.h"
@@ -328,10 +329,15 @@ struct gnrc_rpl_dodag {
     uint8_t dao_seq;                /**< dao sequence number */
     uint8_t dao_counter;            /**< amount of retried DAOs */
     bool dao_ack_received;          /**< flag to check for DAO-ACK */
+    bool dao_scheduled;             /**< a DAO is scheduled, but not sent yet */
     uint8_t dio_opts;               /**< options in the next DIO
                                          (see @ref GNRC_RPL_REQ_DIO_OPTS "DIO Options") */
     evtimer_msg_event_t dao_event;  /**< DAO TX events (see @ref GNRC_RPL_MSG_TYPE_DODAG_DAO_TX) */
     trickle_t trickle;              /**< trickle representation */
+#if IS_USED(MODULE_GNRC_RPL_DIO_FILTER) || defined(DOXYGEN)
+    uint32_t dio_refresh;           /**< time in ms the last DIO of the preferred
+                                         parent was fully processed */
+#endif
 };
 
 struct gnrc_rpl_instance {
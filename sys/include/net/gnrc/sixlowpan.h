@@ -138,6 +138,7 @@
 #include <stdbool.h>
 
 #include "kernel_types.h"
+#include "msg.h"
 
 #include "net/gnrc/sixlowpan/config.h"
 #include "net/gnrc/sixlowpan/frag.h"
@@ -155,6 +156,9 @@ extern "C" {
  * @details If 6LoWPAN was already initialized, it will just return the PID of
  *          the 6LoWPAN thread.
  *
+ * @details With module `gnrc_single_thread`, no thread is started and the PID
+ *          of the IPv6 thread is returned.
+ *
  * @return  The PID to the 6LoWPAN thread, on success.
  * @return  -EINVAL, if @ref GNRC_SIXLOWPAN_PRIO was greater than or equal to
  *          @ref SCHED_PRIO_LEVELS
@@ -162,6 +166,28 @@ extern "C" {
  */
 kernel_pid_t gnrc_sixlowpan_init(void);
 
+/**
+ * @brief   Message type for a packet to send, queued by another thread
+ *
+ * @note    Only used with module `gnrc_single_thread`, where
+ *          @ref GNRC_NETAPI_MSG_TYPE_SND to the IPv6 thread is taken by IPv6.
+ */
+#define GNRC_SIXLOWPAN_MSG_SND              (0x0229)
+
+/**
+ * @brief   Handles a message for 6LoWPAN in the thread 6LoWPAN runs in
+ *
+ * With module `gnrc_single_thread`, the IPv6 thread passes all its messages
+ * here first. @ref GNRC_NETAPI_MSG_TYPE_RCV is only taken for packets marked
+ * with @ref GNRC_NETTYPE_SIXLOWPAN then.
+ *
+ * @param[in] msg   A message received by the 6LoWPAN thread
+ *
+ * @return  true, if @p msg was handled
+ * @return  false, if @p msg is not meant for 6LoWPAN
+ */
+bool gnrc_sixlowpan_handle_msg(msg_t *msg);
+
 #ifdef __cplusplus
 }
 #endif
@@ -158,6 +158,30 @@ extern "C" {
 #define CONFIG_GNRC_SIXLOWPAN_ND_AR_LTIME          (15U)
 #endif
 
+/**
+ * @brief   Number of hash buckets of the reassembly buffer index
+ *
+ * @note    Only applicable with module `gnrc_sixlowpan_frag_rb_hash`
+ *
+ * @attention   Must be a power of 2.
+ */
+#ifndef CONFIG_GNRC_SIXLOWPAN_FRAG_RB_HASH_SIZE
+#define CONFIG_GNRC_SIXLOWPAN_FRAG_RB_HASH_SIZE    (8U)
+#endif
+
+/**
+ * @brief   Maximum datagram size the interval bitmap of a reassembly buffer
+ *          entry can cover
+ *
+ * Each entry uses 2 bits per 8 bytes of this size. Datagrams exceeding it can
+ * not be reassembled. Defaults to the IPv6 minimum MTU.
+ *
+ * @note    Only applicable with module `gnrc_sixlowpan_frag_rb_bitmap`
+ */
+#ifndef CONFIG_GNRC_SIXLOWPAN_FRAG_RB_BITMAP_SIZE
+#define CONFIG_GNRC_SIXLOWPAN_FRAG_RB_BITMAP_SIZE  (1280U)
+#endif
+
 /**
  * @brief   Size of the virtual reassembly buffer
  *
@@ -184,6 +208,26 @@ extern "C" {
 #define CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT_US  (CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_TIMEOUT_US)
 #endif  /* CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT_US */
 
+/**
+ * @brief   Number of IPHC header templates to cache
+ *
+ * @note    Only applicable with module `gnrc_sixlowpan_iphc_cache`
+ */
+#ifndef CONFIG_GNRC_SIXLOWPAN_IPHC_CACHE_SIZE
+#define CONFIG_GNRC_SIXLOWPAN_IPHC_CACHE_SIZE       (2U)
+#endif
+
+/**
+ * @brief   Maximum time in microseconds an IPHC header template is used
+ *
+ * @attention   Must be less than 2^31.
+ *
+ * @note    Only applicable with module `gnrc_sixlowpan_iphc_cache`
+ */
+#ifndef CONFIG_GNRC_SIXLOWPAN_IPHC_CACHE_TIMEOUT_US
+#define CONFIG_GNRC_SIXLOWPAN_IPHC_CACHE_TIMEOUT_US (60000000U)
+#endif
+
 /**
  * @name Selective fragment recovery configuration
  * @see  [draft-ietf-6lo-fragment-recovery-07, section 7.1]
@@ -23,8 +23,14 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "kernel_defines.h"
 #include "msg.h"
 #include "net/gnrc/pkt.h"
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR) || defined(DOXYGEN)
+#include "bitfield.h"
+#include "net/sixlowpan/sfr.h"
+#include "xtimer.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -35,6 +41,33 @@ extern "C" {
  */
 #define GNRC_SIXLOWPAN_FRAG_FB_SND_MSG      (0x0225)
 
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR) || defined(DOXYGEN)
+/**
+ * @brief   Sender state of a datagram sent in recoverable fragments
+ *
+ * @note    Only available with module `gnrc_sixlowpan_frag_sfr`
+ */
+typedef struct {
+    xtimer_t timer;             /**< inter-frame gap and ARQ timer */
+    msg_t timer_msg;            /**< message sent by the timer */
+    uint32_t arq_timeout;       /**< current ARQ timeout in milliseconds */
+    /**
+     * @brief   Fragments acknowledged by the receiver, laid out as
+     *          sixlowpan_sfr_ack_t::bitmap
+     */
+    BITFIELD(acked, SIXLOWPAN_SFR_ACK_BITMAP_SIZE);
+    uint16_t frag_size;         /**< size of all but the last fragment */
+    uint8_t next_seq;           /**< sequence number of the next fragment */
+    uint8_t last_seq;           /**< sequence number of the last fragment */
+    uint8_t high_seq;           /**< sequence number following the highest
+                                 *   one sent so far */
+    uint8_t window;             /**< number of fragments sent per round */
+    uint8_t in_round;           /**< fragments left in the current round */
+    uint8_t retries;            /**< rounds retried without progress */
+    uint8_t dg_retries;         /**< datagram retries after an abort */
+} gnrc_sixlowpan_frag_sfr_fb_t;
+#endif
+
 /**
  * @brief   6LoWPAN fragmentation buffer entry.
  */
@@ -51,6 +84,14 @@ typedef struct {
      */
     gnrc_sixlowpan_frag_hint_t hint;
 #endif /* MODULE_GNRC_SIXLOWPAN_FRAG_HINT */
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR) || defined(DOXYGEN)
+    /**
+     * @brief   Recoverable fragments sender state
+     *
+     * @note    Only available with module `gnrc_sixlowpan_frag_sfr`
+     */
+    gnrc_sixlowpan_frag_sfr_fb_t sfr;
+#endif
 } gnrc_sixlowpan_frag_fb_t;
 
 #ifdef TEST_SUITES
@@ -10,6 +10,31 @@
  * @defgroup net_gnrc_sixlowpan_frag_rb 6LoWPAN reassembly buffer
  * @ingroup  net_gnrc_sixlowpan_frag
  * @brief    6LoWPAN reassembly buffer
+ *
+ * By default, every received fragment is looked up by a linear search over
+ * all entries, and the received intervals of all entries are kept in lists
+ * drawing from a shared pool.
+ *
+ * With module `gnrc_sixlowpan_frag_rb_hash`, entries are additionally indexed
+ * in @ref CONFIG_GNRC_SIXLOWPAN_FRAG_RB_HASH_SIZE buckets by their
+ * (source, destination, tag) tuple, so a lookup only compares the entries of
+ * one bucket. With module `gnrc_sixlowpan_frag_stats`, the number of lookups
+ * and entries compared are counted in
+ * @ref gnrc_sixlowpan_frag_stats_t::rbuf_lookups and
+ * @ref gnrc_sixlowpan_frag_stats_t::rbuf_probes.
+ *
+ * With module `gnrc_sixlowpan_frag_rb_bitmap`, every entry tracks the
+ * received parts of its datagram in a bitmap of 8 byte units instead, so
+ * checking and adding a fragment does not walk any list and an entry can not
+ * run out of intervals. Only datagrams of up to
+ * @ref CONFIG_GNRC_SIXLOWPAN_FRAG_RB_BITMAP_SIZE bytes can be reassembled then.
+ *
+ * With module `gnrc_sixlowpan_frag_sfr`, recoverable fragments
+ * (@ref net_sixlowpan_sfr) are reassembled as well. As the offsets of
+ * recoverable fragments refer to the compressed datagram, such datagrams are
+ * reassembled in their compressed form and handed to the 6LoWPAN thread again
+ * once complete. Duplicates are detected by the sequence number of the
+ * fragments, see gnrc_sixlowpan_frag_rb_t::received.
  * @{
  *
  * @file
@@ -23,10 +48,15 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "bitfield.h"
+#include "kernel_defines.h"
 #include "net/gnrc/netif/hdr.h"
 #include "net/gnrc/pkt.h"
 
 #include "net/gnrc/sixlowpan/config.h"
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR) || defined(DOXYGEN)
+#include "net/sixlowpan/sfr.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -36,6 +66,14 @@ extern "C" {
  */
 #define GNRC_SIXLOWPAN_FRAG_RB_GC_MSG       (0x0226)
 
+/**
+ * @brief   Message type for dropping the oldest reassembly buffer entry to
+ *          free the packet buffer
+ *
+ * @see gnrc_pktbuf_set_pressure_cb()
+ */
+#define GNRC_SIXLOWPAN_FRAG_RB_RECLAIM_MSG  (0x022a)
+
 /**
  * @brief   Fragment intervals to identify limits of fragments and duplicates.
  *
@@ -55,6 +93,34 @@ typedef struct gnrc_sixlowpan_frag_rb_int {
     uint16_t end;               /**< end byte of the fragment interval */
 } gnrc_sixlowpan_frag_rb_int_t;
 
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_RB_BITMAP) || defined(DOXYGEN)
+/**
+ * @brief   Number of 8 byte units tracked by a
+ *          @ref gnrc_sixlowpan_frag_rb_bitmap_t
+ */
+#define GNRC_SIXLOWPAN_FRAG_RB_BITMAP_UNITS \
+    ((CONFIG_GNRC_SIXLOWPAN_FRAG_RB_BITMAP_SIZE + 7U) / 8U)
+
+/**
+ * @brief   Received parts of a datagram in units of 8 bytes
+ *
+ * Fragment offsets are multiples of 8, so a fragment exactly covers a range of
+ * units (except for the last fragment, which may end in the middle of one).
+ *
+ * @note    Only available with module `gnrc_sixlowpan_frag_rb_bitmap`
+ */
+typedef struct {
+    /**
+     * @brief   Units covered by received fragments
+     */
+    BITFIELD(received, GNRC_SIXLOWPAN_FRAG_RB_BITMAP_UNITS);
+    /**
+     * @brief   Units received fragments start at
+     */
+    BITFIELD(starts, GNRC_SIXLOWPAN_FRAG_RB_BITMAP_UNITS);
+} gnrc_sixlowpan_frag_rb_bitmap_t;
+#endif
+
 /**
  * @brief   Base class for both reassembly buffer and virtual reassembly buffer
  *
@@ -69,7 +135,18 @@ typedef struct gnrc_sixlowpan_frag_rb_int {
  * @see https://tools.ietf.org/html/draft-ietf-lwig-6lowpan-virtual-reassembly-01
  */
 typedef struct {
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_RB_BITMAP) || defined(DOXYGEN)
+    /**
+     * @brief   Already received parts of the datagram
+     *
+     * @note    Only available with module `gnrc_sixlowpan_frag_rb_bitmap`,
+     *          replaces gnrc_sixlowpan_frag_rb_base_t::ints
+     */
+    gnrc_sixlowpan_frag_rb_bitmap_t bitmap;
+#endif
+#if !IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_RB_BITMAP) || defined(DOXYGEN)
     gnrc_sixlowpan_frag_rb_int_t *ints;         /**< intervals of already received fragments */
+#endif
     uint8_t src[IEEE802154_LONG_ADDRESS_LEN];   /**< source address */
     uint8_t dst[IEEE802154_LONG_ADDRESS_LEN];   /**< destination address */
     uint8_t src_len;                            /**< length of gnrc_sixlowpan_frag_rb_t::src */
@@ -96,6 +173,17 @@ typedef struct {
      * @brief   The reassembled packet in the packet buffer
      */
     gnrc_pktsnip_t *pkt;
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR) || defined(DOXYGEN)
+    /**
+     * @brief   Sequence numbers of the recoverable fragments received so far
+     *
+     * Laid out as the bitmap of an RFRAG acknowledgment, so it can be copied
+     * into sixlowpan_sfr_ack_t::bitmap.
+     *
+     * @note    Only available with module `gnrc_sixlowpan_frag_sfr`
+     */
+    BITFIELD(received, SIXLOWPAN_SFR_ACK_BITMAP_SIZE);
+#endif
 } gnrc_sixlowpan_frag_rb_t;
 
 /**
@@ -108,9 +196,18 @@ typedef struct {
  *                          destination address set.
  * @param[in] frag          The fragment to add. Will be released by the
  *                          function.
- * @param[in] offset        The fragment's offset.
+ * @param[in] offset        The fragment's offset. Ignored for recoverable
+ *                          fragments, which carry their offset in the
+ *                          header.
  * @param[in] page          Current 6Lo dispatch parsing page.
  *
+ * @note    A recoverable fragment of a datagram, for which the first fragment
+ *          was not received yet, is discarded. A recoverable fragment of a
+ *          datagram that was already reassembled but is not yet removed
+ *          (see @ref CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER) is discarded
+ *          and the entry with gnrc_sixlowpan_frag_rb_base_t::current_size
+ *          of 0 is returned.
+ *
  * @return  The reassembly buffer entry the fragment was added to on success.
  * @return  NULL on error.
  */
@@ -170,14 +267,17 @@ static inline bool gnrc_sixlowpan_frag_rb_entry_empty(
     return (rbuf->pkt == NULL);
 }
 
-#if defined(TEST_SUITES) || defined(DOXYGEN)
+#if defined(TEST_SUITES) || defined(MODULE_FUZZING) || defined(DOXYGEN)
 /**
  * @brief   Resets the packet buffer to a clean state
  *
- * @note    Only available when @ref TEST_SUITES is defined
+ * @note    Only available when @ref TEST_SUITES is defined or with module
+ *          `fuzzing`
  */
 void gnrc_sixlowpan_frag_rb_reset(void);
+#endif
 
+#if defined(TEST_SUITES) || defined(DOXYGEN)
 /**
  * @brief   Returns a pointer to the array representing the reassembly buffer.
  *
@@ -202,6 +302,12 @@ void gnrc_sixlowpan_frag_rb_base_rm(gnrc_sixlowpan_frag_rb_base_t *entry);
  */
 void gnrc_sixlowpan_frag_rb_gc(void);
 
+/**
+ * @brief   Drops the oldest entry of the reassembly buffer, regardless of its
+ *          age, to free space in the packet buffer
+ */
+void gnrc_sixlowpan_frag_rb_reclaim(void);
+
 /**
  * @brief   Checks if a reassembly buffer entry is complete and dispatches it
  *          to the next layer if that is the case
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2020 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_sixlowpan_frag_sfr Selective fragment recovery
+ * @ingroup     net_gnrc_sixlowpan_frag
+ * @brief       6LoWPAN selective fragment recovery
+ *
+ * With module `gnrc_sixlowpan_frag_sfr`, datagrams too large for a single
+ * frame are sent in recoverable fragments (@ref net_sixlowpan_sfr). The
+ * sender sends the fragments in rounds of up to
+ * @ref GNRC_SIXLOWPAN_SFR_OPT_WIN_SIZE fragments, paced by
+ * @ref GNRC_SIXLOWPAN_SFR_INTER_FRAME_GAP_US, and requests an acknowledgment
+ * for the last fragment of every round. Only the fragments missing in the
+ * acknowledgment bitmap are sent again, so losing a fragment does not require
+ * to send the whole datagram again.
+ *
+ * On the receiver, the fragments are reassembled by the
+ * @ref net_gnrc_sixlowpan_frag_rb. With module `gnrc_sixlowpan_frag_vrb`
+ * (pulled in for routers), fragments of datagrams not destined to
+ * this node are forwarded fragment by fragment using the
+ * @ref net_gnrc_sixlowpan_frag_vrb, and acknowledgments are relayed back along
+ * the same entries.
+ *
+ * With module `gnrc_sixlowpan_frag_stats`, the fragments sent, retried, and
+ * forwarded as well as the acknowledgments and aborts are counted in
+ * @ref gnrc_sixlowpan_frag_stats_t.
+ *
+ * @see [RFC 8931](https://tools.ietf.org/html/rfc8931)
+ * @{
+ *
+ * @file
+ * @brief   Selective fragment recovery definitions
+ */
+#ifndef NET_GNRC_SIXLOWPAN_FRAG_SFR_H
+#define NET_GNRC_SIXLOWPAN_FRAG_SFR_H
+
+#include "net/gnrc/pkt.h"
+#include "net/gnrc/sixlowpan/config.h"
+#include "net/gnrc/sixlowpan/frag/fb.h"
+#include "net/sixlowpan/sfr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Message type for an expired acknowledgment request
+ */
+#define GNRC_SIXLOWPAN_FRAG_SFR_ARQ_TIMEOUT_MSG     (0x0227)
+
+/**
+ * @brief   Message type for sending the next recoverable fragment after the
+ *          inter-frame gap
+ */
+#define GNRC_SIXLOWPAN_FRAG_SFR_INTER_FRAG_GAP_MSG  (0x0228)
+
+/**
+ * @brief   Sends a packet in recoverable fragments
+ *
+ * @pre `ctx != NULL`
+ * @pre gnrc_sixlowpan_frag_fb_t::pkt of @p ctx is equal to @p pkt or
+ *      `pkt == NULL`.
+ *
+ * @param[in] pkt   A packet. May be NULL.
+ * @param[in] ctx   Fragmentation buffer entry of @p pkt, with
+ *                  gnrc_sixlowpan_frag_fb_t::datagram_size set to the size of
+ *                  the compressed datagram and gnrc_sixlowpan_frag_fb_t::tag
+ *                  to an 8-bit tag. Expected to be of type
+ *                  @ref gnrc_sixlowpan_frag_fb_t.
+ * @param[in] page  Current 6Lo dispatch parsing page.
+ */
+void gnrc_sixlowpan_frag_sfr_send(gnrc_pktsnip_t *pkt, void *ctx,
+                                  unsigned page);
+
+/**
+ * @brief   Handles a packet containing a recoverable fragment or an
+ *          acknowledgment header
+ *
+ * @param[in] pkt   The packet to handle, starting with the selective fragment
+ *                  recovery header. Will be released by the function.
+ * @param[in] ctx   Context for the packet. May be NULL.
+ * @param[in] page  Current 6Lo dispatch parsing page.
+ */
+void gnrc_sixlowpan_frag_sfr_recv(gnrc_pktsnip_t *pkt, void *ctx,
+                                  unsigned page);
+
+/**
+ * @brief   Handles an expired acknowledgment request
+ *
+ * @see @ref GNRC_SIXLOWPAN_FRAG_SFR_ARQ_TIMEOUT_MSG
+ *
+ * @param[in] fbuf  The fragmentation buffer entry the request was sent for
+ */
+void gnrc_sixlowpan_frag_sfr_arq_timeout(gnrc_sixlowpan_frag_fb_t *fbuf);
+
+/**
+ * @brief   Sends the next recoverable fragment of the current window
+ *
+ * @see @ref GNRC_SIXLOWPAN_FRAG_SFR_INTER_FRAG_GAP_MSG
+ *
+ * @param[in] fbuf  The fragmentation buffer entry to send the next fragment
+ *                  of
+ */
+void gnrc_sixlowpan_frag_sfr_inter_frame_gap(gnrc_sixlowpan_frag_fb_t *fbuf);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_SIXLOWPAN_FRAG_SFR_H */
+/** @} */
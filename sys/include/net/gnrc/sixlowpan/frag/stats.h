@@ -37,10 +37,23 @@ typedef struct {
                              *   no @ref gnrc_sixlowpan_frag_fb_t available */
     unsigned datagrams;     /**< reassembled datagrams */
     unsigned fragments;     /**< total fragments of reassembled fragments */
+    unsigned rbuf_lookups;  /**< lookups of reassembly buffer entries */
+    unsigned rbuf_probes;   /**< reassembly buffer entries compared by all
+                             *   lookups */
 #if defined(MODULE_GNRC_SIXLOWPAN_FRAG_VRB) || DOXYGEN
     unsigned vrb_full;      /**< counts the number of events where the virtual
                              *   reassembly buffer is full */
 #endif
+#if defined(MODULE_GNRC_SIXLOWPAN_FRAG_SFR) || DOXYGEN
+    unsigned sfr_frags;     /**< recoverable fragments sent */
+    unsigned sfr_retries;   /**< recoverable fragments sent again */
+    unsigned sfr_forwarded; /**< recoverable fragments forwarded */
+    unsigned sfr_acks_sent; /**< RFRAG acknowledgments sent */
+    unsigned sfr_acks_recv; /**< RFRAG acknowledgments received for own
+                             *   datagrams */
+    unsigned sfr_timeouts;  /**< acknowledgment requests timed out */
+    unsigned sfr_aborts;    /**< datagrams aborted by either side */
+#endif
 } gnrc_sixlowpan_frag_stats_t;
 
 /**
@@ -54,6 +54,18 @@ typedef struct {
      * @brief   Outgoing tag to gnrc_sixlowpan_frag_rb_base_t::dst
      */
     uint16_t out_tag;
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR) || defined(DOXYGEN)
+    /**
+     * @brief   Change of the offsets of subsequent recoverable fragments
+     *
+     * The offsets of recoverable fragments refer to the compressed datagram,
+     * so they change with the size of the headers of the first fragment when
+     * it is recompressed for the next hop.
+     *
+     * @note    Only available with module `gnrc_sixlowpan_frag_sfr`
+     */
+    int16_t offset_diff;
+#endif
 } gnrc_sixlowpan_frag_vrb_t;
 
 /**
@@ -117,6 +129,26 @@ void gnrc_sixlowpan_frag_vrb_gc(void);
 gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_get(
         const uint8_t *src, size_t src_len, unsigned src_tag);
 
+/**
+ * @brief   Gets a VRB entry by its outgoing side
+ *
+ * Used to pass information from the next hop, e.g. acknowledgments of
+ * recoverable fragments, back towards the source of a datagram.
+ *
+ * @param[in] netif         Outgoing interface of the entry. May be NULL for
+ *                          any interface.
+ * @param[in] dst           Link-layer address of the next hop.
+ * @param[in] dst_len       Length of @p dst.
+ * @param[in] out_tag       Outgoing tag of the entry.
+ *
+ * @return  The VRB entry identified by the given parameters.
+ * @return  NULL, if there is no entry in the VRB that could be identified
+ *          by the given parameters.
+ */
+gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_reverse(
+        const gnrc_netif_t *netif, const uint8_t *dst, size_t dst_len,
+        unsigned out_tag);
+
 /**
  * @brief   Removes an entry from the VRB
  *
@@ -22,8 +22,13 @@
 
 #include <stdbool.h>
 
+#include "kernel_defines.h"
 #include "net/gnrc/pkt.h"
 #include "net/sixlowpan.h"
+#if (defined(MODULE_GNRC_SIXLOWPAN_FRAG_VRB) && \
+     IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR)) || defined(DOXYGEN)
+#include "net/gnrc/sixlowpan/frag/vrb.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -57,6 +62,59 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *pkt, void *ctx, unsigned page);
  */
 void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page);
 
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_IPHC_CACHE) || defined(DOXYGEN)
+/**
+ * @brief   Invalidates all cached IPHC header templates
+ *
+ * With module `gnrc_sixlowpan_iphc_cache`, the compressed IPv6 header of the
+ * last @ref CONFIG_GNRC_SIXLOWPAN_IPHC_CACHE_SIZE flows is kept as a
+ * template, so packets with the same IPv6 header (except for the payload
+ * length) to the same link-layer destination are not compressed again.
+ * Templates are used for at most
+ * @ref CONFIG_GNRC_SIXLOWPAN_IPHC_CACHE_TIMEOUT_US and not after the
+ * contexts they were compressed with expire.
+ *
+ * To be called whenever a compression context or the link-layer address of an
+ * interface changes. May be called from any thread.
+ *
+ * @note    Without module `gnrc_sixlowpan_iphc_cache` this function does
+ *          nothing.
+ */
+void gnrc_sixlowpan_iphc_cache_invalidate(void);
+#else
+static inline void gnrc_sixlowpan_iphc_cache_invalidate(void)
+{
+}
+#endif
+
+#if (defined(MODULE_GNRC_SIXLOWPAN_FRAG_VRB) && \
+     IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR)) || defined(DOXYGEN)
+/**
+ * @brief   Recompresses the IPHC headers of a first fragment for forwarding
+ *
+ * Used by @ref net_gnrc_sixlowpan_frag_sfr to forward a first fragment
+ * without reassembling the datagram. The headers are decompressed, a
+ * @ref net_gnrc_sixlowpan_frag_vrb entry is created from the route to the
+ * IPv6 destination, and the headers are compressed again for the next hop
+ * with the hop limit decremented. The size difference of the compressed
+ * headers is stored in gnrc_sixlowpan_frag_vrb_t::offset_diff.
+ *
+ * @pre (sixlo != NULL) && (base != NULL) && (vrbe != NULL)
+ *
+ * @param[in] sixlo     Payload of the first fragment, starting with the IPHC
+ *                      dispatch, followed by its netif header. Not released.
+ * @param[in] base      Reassembly buffer base data of the datagram.
+ * @param[out] vrbe     The created VRB entry. NULL on error.
+ *
+ * @return  The recompressed payload without netif header.
+ * @return  NULL, if there is no route to the destination or no space in the
+ *          packet buffer.
+ */
+gnrc_pktsnip_t *gnrc_sixlowpan_iphc_recompress(gnrc_pktsnip_t *sixlo,
+        const gnrc_sixlowpan_frag_rb_base_t *base,
+        gnrc_sixlowpan_frag_vrb_t **vrbe);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
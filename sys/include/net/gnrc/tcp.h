@@ -154,6 +154,77 @@ int gnrc_tcp_open_active(gnrc_tcp_tcb_t *tcb, const gnrc_tcp_ep_t *remote,
  */
 int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb, const gnrc_tcp_ep_t *local);
 
+/**
+ * @brief Initialize a listen queue.
+ *
+ * @pre @p queue must not be NULL.
+ *
+ * @param[out] queue   Listen queue to initialize.
+ */
+void gnrc_tcp_tcb_queue_init(gnrc_tcp_tcb_queue_t *queue);
+
+/**
+ * @brief Listen with a sequence of TCBs on a local endpoint.
+ *
+ * @pre gnrc_tcp_tcb_queue_init() must have been called on @p queue.
+ * @pre gnrc_tcp_tcb_init() must have been called on all TCBs in @p tcbs.
+ * @pre @p local->port must not be zero.
+ *
+ * @note Does not block. Each TCB in @p tcbs can serve one peer at a time:
+ *       the TCP thread completes the handshake of incoming connections
+ *       on its own, so @p tcbs_len is the backlog of the listen queue.
+ *       Established connections are handed out by gnrc_tcp_accept().
+ *       Each listening TCB holds a receive buffer, so
+ *       CONFIG_GNRC_TCP_RCV_BUFFERS must be at least @p tcbs_len.
+ *
+ * @param[in,out] queue      Listen queue to use.
+ * @param[in]     tcbs       TCBs to listen with.
+ * @param[in]     tcbs_len   Number of TCBs in @p tcbs.
+ * @param[in]     local      Endpoint to listen on. Its address may be
+ *                           unspecified to accept connections on any address.
+ *
+ * @return   0 on success.
+ * @return   -EAFNOSUPPORT if @p local contains an unsupported address family.
+ * @return   -EINVAL if the address family of @p local and the TCBs do not match.
+ * @return   -EISCONN if @p queue or one of the TCBs is already in use.
+ * @return   -ENOMEM if the receive buffers for the TCBs could not be allocated.
+ */
+int gnrc_tcp_listen(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t *tcbs, size_t tcbs_len,
+                    const gnrc_tcp_ep_t *local);
+
+/**
+ * @brief Accept an established connection of a listen queue.
+ *
+ * @pre @p queue must be listening, see gnrc_tcp_listen().
+ *
+ * @note Closing (gnrc_tcp_close()) or aborting (gnrc_tcp_abort()) an accepted
+ *       TCB returns it to @p queue, where it listens again.
+ *
+ * @param[in,out] queue                      Listen queue to accept from.
+ * @param[out]    tcb                        The accepted TCB.
+ * @param[in]     user_timeout_duration_us   If zero, returns immediately if no
+ *                                           connection is ready. Otherwise blocks
+ *                                           up to this duration in microseconds.
+ *
+ * @return   0 on success.
+ * @return   -EAGAIN if @p user_timeout_duration_us is zero and no connection is ready.
+ * @return   -ETIMEDOUT if @p user_timeout_duration_us expired.
+ * @return   -ENOMEM if all TCBs of @p queue are already accepted.
+ * @return   -EINVAL if @p queue is not listening.
+ */
+int gnrc_tcp_accept(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t **tcb,
+                    const uint32_t user_timeout_duration_us);
+
+/**
+ * @brief Stop listening on a listen queue.
+ *
+ * @note Connections not accepted yet are aborted. Accepted connections stay
+ *       open and are no longer returned to @p queue on close.
+ *
+ * @param[in,out] queue   Listen queue to stop.
+ */
+void gnrc_tcp_stop_listen(gnrc_tcp_tcb_queue_t *queue);
+
 /**
  * @brief Transmit data to connected peer.
  *
@@ -161,7 +232,12 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb, const gnrc_tcp_ep_t *local);
  * @pre @p tcb must not be NULL.
  * @pre @p data must not be NULL.
  *
- * @note Blocks until up to @p len bytes were transmitted or an error occurred.
+ * @note Blocks until up to @p len bytes were handed to the retransmission queue or an
+ *       error occurred. Up to @ref CONFIG_GNRC_TCP_SND_QUEUE_SIZE segments may be
+ *       in flight unacknowledged; the function only waits for acknowledgments if
+ *       the queue or the peer's window is full. With the module `gnrc_tcp_sack`,
+ *       selective acknowledgments (RFC 2018) of the peer are used to retransmit
+ *       only lost segments.
  *
  * @param[in,out] tcb                        TCB holding the connection information.
  * @param[in]     data                       Pointer to the data that should be transmitted.
@@ -167,6 +167,35 @@ extern "C" {
 #ifndef CONFIG_GNRC_TCP_PROBE_UPPER_BOUND
 #define CONFIG_GNRC_TCP_PROBE_UPPER_BOUND (60U * US_PER_SEC)
 #endif
+
+/**
+ * @brief Maximum number of unacknowledged segments in flight per connection
+ *
+ * Each segment stays in the packet buffer until it is acknowledged, so this
+ * value together with @ref CONFIG_GNRC_TCP_MSS bounds the packet buffer space
+ * a single connection holds as send buffer. With the default of 1, a
+ * connection waits for the acknowledgment of a segment before it sends the
+ * next one. The value must not exceed 32.
+ */
+#ifndef CONFIG_GNRC_TCP_SND_QUEUE_SIZE
+#define CONFIG_GNRC_TCP_SND_QUEUE_SIZE (1U)
+#endif
+
+/**
+ * @brief Number of duplicate acknowledgments that trigger a fast
+ *        retransmission (see RFC 5681)
+ */
+#ifndef CONFIG_GNRC_TCP_DUPACK_THRESHOLD
+#define CONFIG_GNRC_TCP_DUPACK_THRESHOLD (3U)
+#endif
+
+/**
+ * @brief Number of SYN+ACK retransmissions before a TCB of a listen queue
+ *        returns from SYN_RCVD to LISTEN, freeing it for other peers
+ */
+#ifndef CONFIG_GNRC_TCP_SYN_RCVD_RETRIES
+#define CONFIG_GNRC_TCP_SYN_RCVD_RETRIES (4U)
+#endif
 /** @} */
 
 #ifdef __cplusplus
@@ -21,9 +21,10 @@
 #define NET_GNRC_TCP_TCB_H
 
 #include <stdint.h>
+#include "kernel_defines.h"
 #include "kernel_types.h"
 #include "ringbuffer.h"
-#include "xtimer.h"
+#include "ztimer.h"
 #include "mutex.h"
 #include "msg.h"
 #include "mbox.h"
@@ -59,6 +60,8 @@ extern "C" {
 #define GNRC_TCP_TCB_MBOX_SIZE (1 << CONFIG_GNRC_TCP_TCB_MBOX_SIZE_EXP)
 #endif
 
+struct _gnrc_tcp_tcb_queue;
+
 /**
  * @brief Transmission control block of GNRC TCP.
  */
@@ -88,18 +91,55 @@ typedef struct _transmission_control_block {
     int32_t srtt;          /**< Smoothed round trip time */
     int32_t rto;           /**< Retransmission timeout duration */
     uint8_t retries;       /**< Number of retransmissions */
-    xtimer_t tim_tout;     /**< Timer struct for timeouts */
+    uint8_t dupacks;       /**< Number of duplicate ACKs received for snd_una */
+    ztimer_t tim_tout;     /**< Timer struct for timeouts */
     msg_t msg_tout;        /**< Message, sent on timeouts */
-    gnrc_pktsnip_t *pkt_retransmit;   /**< Pointer to packet in "retransmit queue" */
+    /**
+     * @brief Retransmission queue: unacknowledged segments, oldest first
+     */
+    gnrc_pktsnip_t *pkt_retransmit[CONFIG_GNRC_TCP_SND_QUEUE_SIZE];
+    uint8_t rtx_len;       /**< Number of segments in the retransmission queue */
+#if IS_USED(MODULE_GNRC_TCP_SACK)
+    uint32_t rtx_sacked;   /**< Bitmap of queued segments SACKed by the peer */
+#endif
     msg_t mbox_raw[GNRC_TCP_TCB_MBOX_SIZE];   /**< Msg queue for mbox */
     mbox_t mbox;             /**< TCB mbox for synchronization */
     uint8_t *rcv_buf_raw;    /**< Pointer to the receive buffer */
     ringbuffer_t rcv_buf;    /**< Receive buffer data structure */
     mutex_t fsm_lock;        /**< Mutex for FSM access synchronization */
     mutex_t function_lock;   /**< Mutex for function call synchronization */
+    struct _gnrc_tcp_tcb_queue *queue;          /**< Listen queue the TCB belongs to */
     struct _transmission_control_block *next;   /**< Pointer next TCB */
 } gnrc_tcp_tcb_t;
 
+/**
+ * @brief Callback, signaling that a connection of a listen queue can be accepted.
+ *
+ * @note Called from the context of the GNRC TCP thread. Use it to wake up
+ *       an event loop that calls gnrc_tcp_accept() with a timeout of zero.
+ *
+ * @param[in] queue   Listen queue holding the connection.
+ * @param[in] arg     Argument registered with the callback.
+ */
+typedef void (*gnrc_tcp_accept_cb_t)(struct _gnrc_tcp_tcb_queue *queue, void *arg);
+
+/**
+ * @brief Listen queue of GNRC TCP: TCBs listening on the same local endpoint.
+ *
+ *        Every TCB in the queue serves one peer. The TCBs that are not
+ *        connected yet form the SYN backlog, established connections
+ *        not handed out by gnrc_tcp_accept() form the accept queue.
+ */
+typedef struct _gnrc_tcp_tcb_queue {
+    mutex_t lock;             /**< Mutex for access synchronization */
+    gnrc_tcp_tcb_t *tcbs;     /**< Pointer to TCB sequence */
+    size_t tcbs_len;          /**< Number of TCBs behind member tcbs */
+    msg_t mbox_raw[GNRC_TCP_TCB_MBOX_SIZE];   /**< Msg queue for mbox */
+    mbox_t mbox;              /**< Mbox signaling connections to accept */
+    gnrc_tcp_accept_cb_t cb;  /**< Optional callback for connections to accept */
+    void *cb_arg;             /**< Argument for cb */
+} gnrc_tcp_tcb_queue_t;
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_tsch_conf  GNRC TSCH compile configurations
+ * @ingroup     net_gnrc_tsch
+ * @ingroup     net_gnrc_conf
+ * @{
+ *
+ * @file
+ * @brief       Configuration of the TSCH MAC protocol
+ *
+ * The default timeslot template is the one of IEEE 802.15.4-2015, table 8-86.
+ * All nodes of a network must use the same timeslot timing, slotframe length
+ * and hopping sequence.
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+
+#ifndef NET_GNRC_TSCH_CONF_H
+#define NET_GNRC_TSCH_CONF_H
+
+#include "kernel_defines.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of timeslots in the slotframe
+ *
+ * The minimal schedule of RFC 8180 has a single shared cell, so the length
+ * trades latency for energy.
+ */
+#ifndef CONFIG_GNRC_TSCH_SLOTFRAME_LENGTH
+#define CONFIG_GNRC_TSCH_SLOTFRAME_LENGTH   (11U)
+#endif
+
+/**
+ * @brief   Maximum number of links in the schedule
+ */
+#ifndef CONFIG_GNRC_TSCH_LINK_NUMOF
+#define CONFIG_GNRC_TSCH_LINK_NUMOF         (8U)
+#endif
+
+/**
+ * @brief   Length of a timeslot in microseconds
+ */
+#ifndef CONFIG_GNRC_TSCH_TIMESLOT_US
+#define CONFIG_GNRC_TSCH_TIMESLOT_US        (10000U)
+#endif
+
+/**
+ * @brief   Start of the transmission from the start of the timeslot in
+ *          microseconds
+ */
+#ifndef CONFIG_GNRC_TSCH_TX_OFFSET_US
+#define CONFIG_GNRC_TSCH_TX_OFFSET_US       (2120U)
+#endif
+
+/**
+ * @brief   Start of listening from the start of the timeslot in microseconds
+ */
+#ifndef CONFIG_GNRC_TSCH_RX_OFFSET_US
+#define CONFIG_GNRC_TSCH_RX_OFFSET_US       (1020U)
+#endif
+
+/**
+ * @brief   How long to listen for the start of a frame in microseconds
+ */
+#ifndef CONFIG_GNRC_TSCH_RX_WAIT_US
+#define CONFIG_GNRC_TSCH_RX_WAIT_US         (2200U)
+#endif
+
+/**
+ * @brief   Time between the start of a transmission and the radio reporting
+ *          the start of the reception in microseconds
+ *
+ * This covers the synchronization header and the interrupt latency of the
+ * receiving radio and is subtracted when the timeslot start is derived from
+ * a received frame.
+ */
+#ifndef CONFIG_GNRC_TSCH_RX_LATENCY_US
+#define CONFIG_GNRC_TSCH_RX_LATENCY_US      (192U)
+#endif
+
+/**
+ * @brief   Largest clock correction in microseconds that is applied at once
+ *
+ * Frames whose start deviates more from the expected time are assumed to
+ * be delayed and not used for synchronization.
+ */
+#ifndef CONFIG_GNRC_TSCH_GUARD_US
+#define CONFIG_GNRC_TSCH_GUARD_US           (1000U)
+#endif
+
+/**
+ * @brief   Time after which a node without a frame from its time source
+ *          considers itself desynchronized in milliseconds
+ */
+#ifndef CONFIG_GNRC_TSCH_DESYNC_TIMEOUT_MS
+#define CONFIG_GNRC_TSCH_DESYNC_TIMEOUT_MS  (60000U)
+#endif
+
+/**
+ * @brief   Period of Enhanced Beacons in milliseconds
+ *
+ * The period is rounded up to the next slotframe with a shared TX link.
+ */
+#ifndef CONFIG_GNRC_TSCH_EB_PERIOD_MS
+#define CONFIG_GNRC_TSCH_EB_PERIOD_MS       (4000U)
+#endif
+
+/**
+ * @brief   Number of retransmissions of a unicast frame
+ */
+#ifndef CONFIG_GNRC_TSCH_MAX_RETRIES
+#define CONFIG_GNRC_TSCH_MAX_RETRIES        (3U)
+#endif
+
+/**
+ * @brief   Initial backoff exponent in shared links
+ */
+#ifndef CONFIG_GNRC_TSCH_MIN_BE
+#define CONFIG_GNRC_TSCH_MIN_BE             (1U)
+#endif
+
+/**
+ * @brief   Maximum backoff exponent in shared links
+ */
+#ifndef CONFIG_GNRC_TSCH_MAX_BE
+#define CONFIG_GNRC_TSCH_MAX_BE             (7U)
+#endif
+
+/**
+ * @brief   Start the interface as PAN coordinator
+ *
+ * A coordinator defines the network time and sends Enhanced Beacons right
+ * away, all other nodes scan for one before they take part in the schedule.
+ */
+#ifdef DOXYGEN
+#define CONFIG_GNRC_TSCH_COORDINATOR
+#endif
+
+/**
+ * @brief   Channel hopping sequence
+ *
+ * The default is the sequence of the 2.4 GHz O-QPSK PHY used by 6TiSCH.
+ */
+#ifndef CONFIG_GNRC_TSCH_HOPPING_SEQUENCE
+#define CONFIG_GNRC_TSCH_HOPPING_SEQUENCE   { 16, 17, 23, 18, 26, 15, 25, 22, \
+                                              19, 11, 12, 13, 24, 14, 20, 21 }
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_TSCH_CONF_H */
+/** @} */
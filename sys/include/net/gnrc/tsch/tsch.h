@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_tsch TSCH
+ * @ingroup     net_gnrc
+ * @brief       IEEE 802.15.4 Time Slotted Channel Hopping MAC protocol
+ *
+ * ## Timeslots and channel hopping
+ * All nodes of a TSCH network share a notion of time divided into timeslots
+ * of @ref CONFIG_GNRC_TSCH_TIMESLOT_US, which are numbered by the absolute
+ * slot number (ASN). The timeslots repeat in a slotframe of
+ * @ref CONFIG_GNRC_TSCH_SLOTFRAME_LENGTH. A link of the schedule assigns a
+ * timeslot of the slotframe and a channel offset to transmitting, receiving
+ * or both. The channel of a link changes from slotframe to slotframe:
+ *
+ *     channel = hopping_sequence[(ASN + channel_offset) % length]
+ *
+ * so two links with different channel offsets in the same timeslot never
+ * interfere and a disturbed channel only hits some of the transmissions.
+ * The timeslots are driven by @ref ZTIMER_USEC, the radio is off outside of
+ * its links.
+ *
+ * ## Schedule
+ * @ref gnrc_tsch_schedule_minimal() installs the minimal schedule of
+ * RFC 8180, one shared link in timeslot 0 at channel offset 0 which carries
+ * Enhanced Beacons, broadcast and unicast traffic. Dedicated links to
+ * specific neighbors are added with @ref gnrc_tsch_link_add(), e.g. by a
+ * scheduling function running on top.
+ *
+ * Outgoing frames are queued per neighbor with @ref net_gnrc_mac. A dedicated
+ * TX link only serves the queue of its neighbor, shared TX links serve
+ * broadcast frames first and then the neighbor queues in turn. Failed
+ * transmissions in shared links back off for a random number of shared links
+ * with an exponent between @ref CONFIG_GNRC_TSCH_MIN_BE and
+ * @ref CONFIG_GNRC_TSCH_MAX_BE. A frame is dropped after
+ * @ref CONFIG_GNRC_TSCH_MAX_RETRIES retransmissions.
+ *
+ * ## Synchronization
+ * The PAN coordinator (@ref CONFIG_GNRC_TSCH_COORDINATOR or
+ * @ref gnrc_tsch_start_coordinator()) starts the network and sends Enhanced
+ * Beacons every @ref CONFIG_GNRC_TSCH_EB_PERIOD_MS. Other nodes scan the
+ * hopping sequence for an Enhanced Beacon, take over the ASN and the timeslot
+ * boundary from it and send Enhanced Beacons themselves from then on. The
+ * sender of the beacon becomes the time source. Every frame received from the
+ * time source in a link with @ref GNRC_TSCH_LINK_TIMEKEEPING corrects the
+ * timeslot boundary by the deviation of its start from the TX offset.
+ *
+ * @note    The radio must report @ref NETDEV_EVENT_RX_STARTED and accept
+ *          frames of version 2 for Enhanced Beacons.
+ * @note    Acknowledgements are sent by the radio. Time corrections are not
+ *          carried in Enhanced ACKs, so time sources synchronize from data
+ *          frames and Enhanced Beacons only.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Interface definition for the TSCH MAC protocol
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+
+#ifndef NET_GNRC_TSCH_TSCH_H
+#define NET_GNRC_TSCH_TSCH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "net/gnrc/netif.h"
+#include "net/gnrc/tsch/conf.h"
+#include "net/gnrc/tsch/types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Creates an IEEE 802.15.4 TSCH network interface
+ *
+ * @param[out] netif    The interface. May not be `NULL`.
+ * @param[in] stack     The stack for the TSCH network interface's thread.
+ * @param[in] stacksize Size of @p stack.
+ * @param[in] priority  Priority for the TSCH network interface's thread.
+ * @param[in] name      Name for the TSCH network interface. May be NULL.
+ * @param[in] dev       Device for the interface
+ *
+ * @see @ref gnrc_netif_create()
+ *
+ * @return  0 on success
+ * @return  negative number on error
+ */
+int gnrc_netif_tsch_create(gnrc_netif_t *netif, char *stack, int stacksize,
+                           char priority, char *name, netdev_t *dev);
+
+/**
+ * @brief   Add a link to the schedule
+ *
+ * @param[in] netif             TSCH network interface
+ * @param[in] timeslot          timeslot within the slotframe
+ * @param[in] channel_offset    channel offset
+ * @param[in] options           link options, e.g. @ref GNRC_TSCH_LINK_TX
+ * @param[in] addr              long address of the neighbor, NULL for a link
+ *                              to any neighbor
+ *
+ * @return  0 on success
+ * @return  -EINVAL if @p timeslot is outside of the slotframe
+ * @return  -EEXIST if there is a link in @p timeslot already
+ * @return  -ENOMEM if the schedule is full
+ */
+int gnrc_tsch_link_add(gnrc_netif_t *netif, uint16_t timeslot,
+                       uint8_t channel_offset, uint8_t options,
+                       const uint8_t *addr);
+
+/**
+ * @brief   Remove the link in a timeslot from the schedule
+ *
+ * @param[in] netif     TSCH network interface
+ * @param[in] timeslot  timeslot within the slotframe
+ *
+ * @return  0 on success
+ * @return  -ENOENT if there is no link in @p timeslot
+ */
+int gnrc_tsch_link_remove(gnrc_netif_t *netif, uint16_t timeslot);
+
+/**
+ * @brief   Replace the schedule by the minimal schedule of RFC 8180
+ *
+ * @param[in] netif     TSCH network interface
+ */
+void gnrc_tsch_schedule_minimal(gnrc_netif_t *netif);
+
+/**
+ * @brief   Start a new network with the interface as PAN coordinator
+ *
+ * @param[in] netif     TSCH network interface
+ */
+void gnrc_tsch_start_coordinator(gnrc_netif_t *netif);
+
+/**
+ * @brief   Check whether the interface takes part in a network
+ *
+ * @param[in] netif     TSCH network interface
+ *
+ * @return  true if the interface is synchronized
+ */
+static inline bool gnrc_tsch_is_synced(const gnrc_netif_t *netif)
+{
+    return netif->mac.prot.tsch.flags & GNRC_TSCH_FLAG_SYNCED;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_TSCH_TSCH_H */
+/** @} */
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_tsch
+ * @{
+ *
+ * @file
+ * @brief       Definition of internal types used by TSCH
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+
+#ifndef NET_GNRC_TSCH_TYPES_H
+#define NET_GNRC_TSCH_TYPES_H
+
+#include <stdint.h>
+
+#include "net/gnrc/tsch/conf.h"
+#include "net/ieee802154.h"
+#include "ztimer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   TSCH timeslot start event type
+ */
+#define GNRC_TSCH_EVENT_SLOT_TYPE           (0x4500)
+
+/**
+ * @brief   TSCH event type of the action within a timeslot
+ */
+#define GNRC_TSCH_EVENT_ACTION_TYPE         (0x4501)
+
+/**
+ * @brief   TSCH event type to start a network as coordinator
+ */
+#define GNRC_TSCH_EVENT_COORDINATOR_TYPE    (0x4502)
+
+/**
+ * @name    Link options
+ * @{
+ */
+#define GNRC_TSCH_LINK_TX           (0x01)  /**< transmit link */
+#define GNRC_TSCH_LINK_RX           (0x02)  /**< receive link */
+#define GNRC_TSCH_LINK_SHARED       (0x04)  /**< shared link, with backoff */
+#define GNRC_TSCH_LINK_TIMEKEEPING  (0x08)  /**< synchronize to frames received
+                                             *   in this link */
+/** @} */
+
+/**
+ * @name    Flags of @ref gnrc_tsch_t
+ * @{
+ */
+#define GNRC_TSCH_FLAG_COORDINATOR  (0x01)  /**< node is the PAN coordinator */
+#define GNRC_TSCH_FLAG_SYNCED       (0x02)  /**< node follows the schedule */
+#define GNRC_TSCH_FLAG_TX_EB        (0x04)  /**< an Enhanced Beacon is sent */
+/** @} */
+
+/**
+ * @brief   Action of the TSCH state machine within a timeslot
+ */
+typedef enum {
+    GNRC_TSCH_ACTION_NONE,      /**< radio is off for the rest of the slot */
+    GNRC_TSCH_ACTION_SCAN,      /**< listening for Enhanced Beacons */
+    GNRC_TSCH_ACTION_TX,        /**< waiting for the TX offset */
+    GNRC_TSCH_ACTION_TX_WAIT,   /**< waiting for the end of the transmission */
+    GNRC_TSCH_ACTION_RX,        /**< waiting for the RX offset */
+    GNRC_TSCH_ACTION_RX_WAIT,   /**< waiting for the start of a frame */
+} gnrc_tsch_action_t;
+
+/**
+ * @brief   Link of the TSCH schedule
+ */
+typedef struct {
+    uint16_t timeslot;          /**< timeslot within the slotframe */
+    uint8_t channel_offset;     /**< channel offset */
+    uint8_t options;            /**< link options, e.g.
+                                 *   @ref GNRC_TSCH_LINK_TX */
+    uint8_t addr_len;           /**< length of @p addr, 0 for a link to any
+                                 *   neighbor */
+    uint8_t addr[IEEE802154_LONG_ADDRESS_LEN];  /**< neighbor of the link */
+} gnrc_tsch_link_t;
+
+/**
+ * @brief   TSCH specific structure for storing internal states
+ */
+typedef struct {
+    ztimer_t slot_timer;        /**< timer of the next timeslot */
+    ztimer_t action_timer;      /**< timer of the action within a timeslot */
+    uint64_t asn;               /**< absolute slot number of the current slot */
+    uint32_t slot_start;        /**< start of the current slot on
+                                 *   @ref ZTIMER_USEC */
+    uint32_t rx_start;          /**< start of the last received frame */
+    uint32_t last_sync;         /**< time of the last synchronization in
+                                 *   milliseconds on @ref ZTIMER_MSEC */
+    uint32_t last_eb;           /**< time of the last Enhanced Beacon in
+                                 *   milliseconds on @ref ZTIMER_MSEC */
+    gnrc_tsch_link_t links[CONFIG_GNRC_TSCH_LINK_NUMOF];    /**< schedule */
+    gnrc_tsch_link_t link;      /**< copy of the link of the current slot */
+    uint8_t time_source[IEEE802154_LONG_ADDRESS_LEN];   /**< time source */
+    uint8_t links_numof;        /**< number of links in the schedule */
+    uint8_t action;             /**< see @ref gnrc_tsch_action_t */
+    uint8_t flags;              /**< flags, e.g.
+                                 *   @ref GNRC_TSCH_FLAG_SYNCED */
+    uint8_t join_metric;        /**< hops to the PAN coordinator */
+    uint8_t retries;            /**< transmissions of the current frame */
+    uint8_t backoff_exp;        /**< backoff exponent in shared links */
+    uint8_t backoff;            /**< shared links to skip */
+    uint8_t scan_channel;       /**< index of the channel that is scanned */
+    uint8_t next_neighbor;      /**< neighbor served next in shared links */
+} gnrc_tsch_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_TSCH_TYPES_H */
+/** @} */
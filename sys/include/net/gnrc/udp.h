@@ -11,6 +11,17 @@
  * @ingroup     net_gnrc
  * @brief       GNRC's implementation of the UDP protocol
  *
+ * With module `gnrc_udp_fastpath`, the IPv6 thread delivers datagrams for a
+ * port with a registered receiver (e.g. a bound @ref net_sock_udp) directly,
+ * skipping the message hop to and the context switch into the UDP thread.
+ * Datagrams to unknown ports, or while anyone else subscribed to all UDP or
+ * all IPv6 UDP packets (e.g. @ref net_gnrc_pktdump), take the UDP thread as
+ * before.
+ *
+ * With module `gnrc_single_thread`, there is no UDP thread at all: UDP is
+ * called by the thread dispatching a packet to it (see
+ * @ref net_gnrc_ipv6).
+ *
  * @{
  *
  * @file
@@ -22,6 +33,7 @@
 #ifndef NET_GNRC_UDP_H
 #define NET_GNRC_UDP_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "byteorder.h"
@@ -99,10 +111,25 @@ int gnrc_udp_calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr);
 gnrc_pktsnip_t *gnrc_udp_hdr_build(gnrc_pktsnip_t *payload, uint16_t src,
                                    uint16_t dst);
 
+/**
+ * @brief   Delivers a received UDP datagram to its receivers from the
+ *          calling thread
+ *
+ * @note    Only available with module `gnrc_udp_fastpath`
+ *
+ * @param[in] pkt   A received packet with the unmarked UDP header as first
+ *                  snip and the IPv6 header marked, in receive order
+ *
+ * @return  true, if @p pkt was consumed
+ * @return  false, if @p pkt needs to be dispatched to the UDP thread
+ */
+bool gnrc_udp_fastpath(gnrc_pktsnip_t *pkt);
+
 /**
  * @brief   Initialize and start UDP
  *
  * @return  PID of the UDP thread
+ * @return  0 with module `gnrc_single_thread`
  * @return  negative value on error
  */
 int gnrc_udp_init(void);
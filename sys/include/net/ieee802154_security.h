@@ -0,0 +1,306 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_ieee802154_security IEEE 802.15.4 security sublayer
+ * @ingroup     net_ieee802154
+ * @brief       Frame protection with AES-CCM* as of IEEE 802.15.4-2006
+ *
+ * Frames are protected with the security level configured in the context
+ * (@ref CONFIG_IEEE802154_SEC_DEFAULT_SECLEVEL) and one of up to
+ * @ref CONFIG_IEEE802154_SEC_KEY_NUMOF keys, which is identified in the
+ * auxiliary security header by its key index (key identifier mode 1). Having
+ * more than one key allows to roll over keys in a network without losing
+ * frames: the new key is installed on all nodes first and only then used for
+ * sending.
+ *
+ * The outgoing frame counter is incremented with every frame and never wraps.
+ * Received frames are only accepted if their frame counter is larger than the
+ * last one seen from the same sender. The last
+ * @ref CONFIG_IEEE802154_SEC_NEIGHBOR_NUMOF senders are remembered.
+ *
+ * All block cipher operations go through @ref ieee802154_radio_cipher_ops_t.
+ * By default they use the AES implementation of @ref sys_crypto, which itself
+ * uses a hardware engine of the MCU if there is one. Radio drivers with an AES
+ * engine of their own replace the operations in
+ * @ref ieee802154_sec_context_t::dev.
+ *
+ * @note    The nonce contains the extended address of the sender. As there
+ *          is no table to map short addresses to extended ones, receivers
+ *          drop secured frames with a short source address. GNRC therefore
+ *          switches the source address of an interface to the extended one
+ *          when security is enabled.
+ *
+ * @note    The frame counter is not persisted. The keys must be changed
+ *          whenever a node restarts with a counter that was used before.
+ *
+ * @{
+ *
+ * @file
+ * @brief       IEEE 802.15.4 security sublayer interface
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+
+#ifndef NET_IEEE802154_SECURITY_H
+#define NET_IEEE802154_SECURITY_H
+
+#include <stdint.h>
+
+#include "crypto/ciphers.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   AES block and key size
+ */
+#define IEEE802154_SEC_BLOCK_SIZE           (16U)
+
+/**
+ * @brief   Maximum length of the auxiliary security header
+ *
+ * security control, frame counter and key index
+ */
+#define IEEE802154_SEC_MAX_AUX_HDR_LEN      (6U)
+
+/**
+ * @brief   Maximum length of the message integrity code
+ */
+#define IEEE802154_SEC_MAX_MIC_LEN          (16U)
+
+/**
+ * @name    Security levels
+ * @{
+ */
+#define IEEE802154_SEC_SCF_SECLEVEL_MASK        (0x07)
+#define IEEE802154_SEC_SCF_SECLEVEL_NONE        (0x00)  /**< no protection */
+#define IEEE802154_SEC_SCF_SECLEVEL_MIC32       (0x01)  /**< 32 bit MIC */
+#define IEEE802154_SEC_SCF_SECLEVEL_MIC64       (0x02)  /**< 64 bit MIC */
+#define IEEE802154_SEC_SCF_SECLEVEL_MIC128      (0x03)  /**< 128 bit MIC */
+#define IEEE802154_SEC_SCF_SECLEVEL_ENC         (0x04)  /**< encryption */
+#define IEEE802154_SEC_SCF_SECLEVEL_ENC_MIC32   (0x05)  /**< enc. + 32 bit MIC */
+#define IEEE802154_SEC_SCF_SECLEVEL_ENC_MIC64   (0x06)  /**< enc. + 64 bit MIC */
+#define IEEE802154_SEC_SCF_SECLEVEL_ENC_MIC128  (0x07)  /**< enc. + 128 bit MIC */
+/** @} */
+
+/**
+ * @name    Key identifier modes
+ * @{
+ */
+#define IEEE802154_SEC_SCF_KEYMODE_SHIFT        (3U)
+#define IEEE802154_SEC_SCF_KEYMODE_MASK         (0x18)
+#define IEEE802154_SEC_SCF_KEYMODE_IMPLICIT     (0x00)  /**< key from addresses */
+#define IEEE802154_SEC_SCF_KEYMODE_INDEX        (0x08)  /**< key index */
+/** @} */
+
+/**
+ * @defgroup net_ieee802154_security_conf IEEE 802.15.4 security configuration
+ * @ingroup  config
+ * @{
+ */
+/**
+ * @brief   Security level of sent frames
+ */
+#ifndef CONFIG_IEEE802154_SEC_DEFAULT_SECLEVEL
+#define CONFIG_IEEE802154_SEC_DEFAULT_SECLEVEL  IEEE802154_SEC_SCF_SECLEVEL_ENC_MIC64
+#endif
+
+/**
+ * @brief   Number of keys, key index 1 refers to the first key
+ */
+#ifndef CONFIG_IEEE802154_SEC_KEY_NUMOF
+#define CONFIG_IEEE802154_SEC_KEY_NUMOF         (2U)
+#endif
+
+/**
+ * @brief   Number of senders whose frame counter is tracked
+ */
+#ifndef CONFIG_IEEE802154_SEC_NEIGHBOR_NUMOF
+#define CONFIG_IEEE802154_SEC_NEIGHBOR_NUMOF    (8U)
+#endif
+/** @} */
+
+/**
+ * @brief   Forward declaration of the device the cipher operations act on
+ */
+typedef struct ieee802154_sec_dev ieee802154_sec_dev_t;
+
+/**
+ * @brief   Block cipher operations of a security context
+ *
+ * All operations use AES-128 and only encrypt, CCM* needs no decryption.
+ */
+typedef struct {
+    /**
+     * @brief   Load a key
+     *
+     * @param[in]   dev     device
+     * @param[in]   key     key of @ref IEEE802154_SEC_BLOCK_SIZE bytes,
+     *                      stays valid until the next call
+     */
+    void (*set_key)(ieee802154_sec_dev_t *dev, const uint8_t *key);
+    /**
+     * @brief   Encrypt blocks in ECB mode
+     *
+     * @param[in]   dev     device
+     * @param[out]  cipher  encrypted blocks
+     * @param[in]   plain   blocks to encrypt
+     * @param[in]   nblocks number of blocks
+     */
+    void (*ecb)(const ieee802154_sec_dev_t *dev, uint8_t *cipher,
+                const uint8_t *plain, uint8_t nblocks);
+    /**
+     * @brief   Encrypt blocks in CBC mode
+     *
+     * @param[in]   dev     device
+     * @param[out]  cipher  encrypted blocks
+     * @param[in]   iv      initialization vector
+     * @param[in]   plain   blocks to encrypt
+     * @param[in]   nblocks number of blocks
+     */
+    void (*cbc)(const ieee802154_sec_dev_t *dev, uint8_t *cipher,
+                const uint8_t *iv, const uint8_t *plain, uint8_t nblocks);
+} ieee802154_radio_cipher_ops_t;
+
+/**
+ * @brief   Device the cipher operations act on
+ */
+struct ieee802154_sec_dev {
+    const ieee802154_radio_cipher_ops_t *cipher_ops;    /**< operations */
+    void *ctx;                                          /**< device context */
+};
+
+/**
+ * @brief   Last frame counter seen from a sender
+ */
+typedef struct {
+    uint8_t addr[8];                /**< extended address of the sender */
+    uint32_t frame_counter;         /**< last accepted frame counter */
+} ieee802154_sec_neighbor_t;
+
+/**
+ * @brief   Security context
+ */
+typedef struct {
+    cipher_t cipher;                /**< software cipher */
+    ieee802154_sec_dev_t dev;       /**< cipher operations */
+    /** keys, see @ref CONFIG_IEEE802154_SEC_KEY_NUMOF */
+    uint8_t keys[CONFIG_IEEE802154_SEC_KEY_NUMOF][IEEE802154_SEC_BLOCK_SIZE];
+    /** frame counters of recent senders */
+    ieee802154_sec_neighbor_t neighbors[CONFIG_IEEE802154_SEC_NEIGHBOR_NUMOF];
+    uint32_t frame_counter;         /**< outgoing frame counter */
+    uint8_t security_level;         /**< security level of sent frames */
+    uint8_t key_index;              /**< key index of sent frames */
+    uint8_t key_loaded;             /**< key index loaded into the cipher */
+    uint8_t keys_valid;             /**< bit field of configured keys */
+    uint8_t neighbor_next;          /**< neighbor entry replaced next */
+} ieee802154_sec_context_t;
+
+/**
+ * @brief   Default cipher operations using @ref sys_crypto
+ */
+extern const ieee802154_radio_cipher_ops_t ieee802154_radio_cipher_ops;
+
+/**
+ * @brief   Initialize a security context
+ *
+ * No keys are configured and the software cipher operations are used.
+ *
+ * @param[out]  ctx     security context
+ */
+void ieee802154_sec_init(ieee802154_sec_context_t *ctx);
+
+/**
+ * @brief   Configure a key
+ *
+ * The first key that is configured is also used for sending.
+ *
+ * @param[in]   ctx     security context
+ * @param[in]   index   key index, 1 to @ref CONFIG_IEEE802154_SEC_KEY_NUMOF
+ * @param[in]   key     key of @ref IEEE802154_SEC_BLOCK_SIZE bytes
+ *
+ * @return  0 on success
+ * @return  -EINVAL if @p index is out of range
+ */
+int ieee802154_sec_set_key(ieee802154_sec_context_t *ctx, uint8_t index,
+                           const uint8_t *key);
+
+/**
+ * @brief   Select the key used for sending
+ *
+ * @param[in]   ctx     security context
+ * @param[in]   index   key index of a configured key
+ *
+ * @return  0 on success
+ * @return  -EINVAL if no key with @p index is configured
+ */
+int ieee802154_sec_set_tx_key(ieee802154_sec_context_t *ctx, uint8_t index);
+
+/**
+ * @brief   Protect an outgoing frame
+ *
+ * The auxiliary security header is appended to @p header, which must have
+ * room for @ref IEEE802154_SEC_MAX_AUX_HDR_LEN more bytes. The security
+ * enabled bit and the frame version in the frame control field are set.
+ * @p payload is encrypted in place, the MIC is written to @p mic.
+ *
+ * @param[in]       ctx             security context
+ * @param[in,out]   header          MAC header
+ * @param[in,out]   header_size     length of @p header
+ * @param[in,out]   payload         frame payload
+ * @param[in]       payload_size    length of @p payload
+ * @param[out]      mic             buffer of
+ *                                  @ref IEEE802154_SEC_MAX_MIC_LEN bytes
+ * @param[out]      mic_size        length of the MIC
+ * @param[in]       src_address     extended source address
+ *
+ * @return  0 on success
+ * @return  -ENOKEY if no key is configured
+ * @return  -EOVERFLOW if the frame counter is exhausted
+ */
+int ieee802154_sec_encrypt_frame(ieee802154_sec_context_t *ctx,
+                                 uint8_t *header, uint8_t *header_size,
+                                 uint8_t *payload, uint16_t payload_size,
+                                 uint8_t *mic, uint8_t *mic_size,
+                                 const uint8_t *src_address);
+
+/**
+ * @brief   Check and decrypt an incoming frame in place
+ *
+ * @param[in]       ctx             security context
+ * @param[in]       frame_size      length of the frame without FCS
+ * @param[in]       header          frame, starting with the MAC header
+ * @param[in,out]   header_size     length of the MAC header, the auxiliary
+ *                                  security header is added on success
+ * @param[out]      payload         decrypted payload
+ * @param[out]      payload_size    length of @p payload
+ * @param[out]      mic             MIC, following the payload
+ * @param[out]      mic_size        length of @p mic
+ * @param[in]       src_address     extended source address
+ *
+ * @return  0 on success
+ * @return  -EINVAL if the frame is malformed
+ * @return  -ENOKEY if the key is unknown
+ * @return  -EBADMSG if the MIC does not match
+ * @return  -EALREADY if the frame counter was seen before
+ */
+int ieee802154_sec_decrypt_frame(ieee802154_sec_context_t *ctx,
+                                 uint16_t frame_size,
+                                 uint8_t *header, uint8_t *header_size,
+                                 uint8_t **payload, uint16_t *payload_size,
+                                 uint8_t **mic, uint8_t *mic_size,
+                                 const uint8_t *src_address);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_IEEE802154_SECURITY_H */
+/** @} */
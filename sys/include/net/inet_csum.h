@@ -49,6 +49,38 @@ extern "C" {
  */
 uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t accum_len);
 
+/**
+ * @brief   Sums up 32 bit words in one's complement arithmetic
+ *
+ * Used by inet_csum_slice() on 32 bit platforms for the word aligned part of a
+ * buffer. CPUs with faster means (e.g. add with carry instructions) provide
+ * their own implementation with the `inet_csum_arch` module, otherwise this
+ * is inet_csum_words_generic().
+ *
+ * @param[in] sum       An initial value for the sum.
+ * @param[in] buf       A word aligned buffer.
+ * @param[in] words     Number of 32 bit words in @p buf.
+ *
+ * @return  The one's complement sum of @p sum and all words of @p buf in host
+ *          byte order, not folded to 16 bit.
+ */
+uint32_t inet_csum_words(uint32_t sum, const uint32_t *buf, size_t words);
+
+/**
+ * @brief   Portable implementation of inet_csum_words()
+ *
+ * Accumulates into 64 bit and folds the carries once at the end.
+ *
+ * @param[in] sum       An initial value for the sum.
+ * @param[in] buf       A word aligned buffer.
+ * @param[in] words     Number of 32 bit words in @p buf.
+ *
+ * @return  The one's complement sum of @p sum and all words of @p buf in host
+ *          byte order, not folded to 16 bit.
+ */
+uint32_t inet_csum_words_generic(uint32_t sum, const uint32_t *buf,
+                                 size_t words);
+
 /**
  * @brief   Calculates the unnormalized Internet Checksum of @p buf, where the
  *          buffer provides a standalone domain for the checksum.
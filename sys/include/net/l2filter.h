@@ -21,6 +21,13 @@
  * The actual memory for the filter lists should be allocated for every network
  * device. This is done centrally in netdev_t type.
  *
+ * A filter list is an open addressed hash table of @ref L2FILTER_LISTSIZE
+ * slots, so checking a received frame takes constant time on average also
+ * for large lists, e.g. the allow list of a border router. Keep the list
+ * below about three quarters full, probe sequences get long beyond that.
+ * With `netstats_l2`, frames dropped by the filter are counted in
+ * netstats_t::rx_filtered.
+ *
  * @{
  * @file
  * @brief       Link layer address filter interface definition
@@ -49,6 +56,8 @@ extern "C" {
 
 /**
  * @brief   Number of slots in each filter list (filter entries per device)
+ *
+ * Filtering hundreds of addresses is fine, the list is a hash table.
  */
 #ifndef L2FILTER_LISTSIZE
 #define L2FILTER_LISTSIZE               (8U)
@@ -77,7 +86,7 @@ typedef struct {
  * @pre     @p addr != NULL
  * @pre     @p addr_maxlen <= @ref L2FILTER_ADDR_MAXLEN
  *
- * @return  0 on success
+ * @return  0 on success, also if @p addr is in @p list already
  * @return  -ENOMEM if no empty slot left in list
  */
 int l2filter_add(l2filter_t *list, const void *addr, size_t addr_len);
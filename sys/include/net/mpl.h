@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_mpl MPL
+ * @ingroup     net
+ * @brief       Definitions for the Multicast Protocol for Low-Power and Lossy
+ *              Networks
+ * @see         [RFC 7731](https://tools.ietf.org/html/rfc7731)
+ * @{
+ *
+ * @file
+ * @brief   MPL definitions
+ *
+ * @author  ML!PA Consulting GmbH
+ */
+#ifndef NET_MPL_H
+#define NET_MPL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "net/ipv6/ext/opt.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   ALL_MPL_FORWARDERS address with realm-local scope (ff03::fc)
+ *
+ * @see [RFC 7731, section 4.1](https://tools.ietf.org/html/rfc7731#section-4.1)
+ */
+#define MPL_ALL_FORWARDERS_REALM_LOCAL  {{ 0xff, 0x03, 0x00, 0x00, \
+                                           0x00, 0x00, 0x00, 0x00, \
+                                           0x00, 0x00, 0x00, 0x00, \
+                                           0x00, 0x00, 0x00, 0xfc }}
+
+/**
+ * @name    MPL Option flags
+ * @see     [RFC 7731, section 6.1](https://tools.ietf.org/html/rfc7731#section-6.1)
+ * @{
+ */
+#define MPL_OPT_S_MASK          (0xc0U) /**< mask of the seed-id length */
+#define MPL_OPT_S_POS           (6U)    /**< position of the seed-id length */
+#define MPL_OPT_M               (0x20U) /**< largest known sequence number */
+#define MPL_OPT_V               (0x10U) /**< MUST be 0 in this version */
+/** @} */
+
+/**
+ * @name    Seed-id lengths encoded in the S field
+ * @{
+ */
+#define MPL_OPT_S_SRC           (0U)    /**< seed-id is the IPv6 source */
+#define MPL_OPT_S_16            (1U)    /**< 16-bit seed-id */
+#define MPL_OPT_S_64            (2U)    /**< 64-bit seed-id */
+#define MPL_OPT_S_128           (3U)    /**< 128-bit seed-id */
+/** @} */
+
+/**
+ * @brief   MPL Option in the hop-by-hop options header, without seed-id
+ */
+typedef struct __attribute__((packed)) {
+    uint8_t type;       /**< option type, i.e. @ref IPV6_EXT_OPT_MPL */
+    uint8_t len;        /**< length of the option data */
+    uint8_t flags;      /**< S, M and V flags */
+    uint8_t seq;        /**< sequence number */
+} mpl_opt_t;
+
+/**
+ * @brief   Get the length of the seed-id of an MPL Option
+ *
+ * @param[in] opt   An MPL Option
+ *
+ * @return  Length of the seed-id following @p opt in bytes
+ */
+static inline unsigned mpl_opt_seed_id_len(const mpl_opt_t *opt)
+{
+    static const uint8_t lens[] = { 0, 2, 8, 16 };
+
+    return lens[(opt->flags & MPL_OPT_S_MASK) >> MPL_OPT_S_POS];
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_MPL_H */
+/** @} */
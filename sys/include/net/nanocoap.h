@@ -111,6 +111,9 @@ extern "C" {
 #define COAP_IPATCH             (0x40)
 #define COAP_MATCH_SUBTREE      (0x8000) /**< Path is considered as a prefix
                                               when matching */
+#define COAP_HANDLER_MAY_BLOCK  (0x4000) /**< Handler may block; gcoap runs it
+                                              in a worker thread if module
+                                              `gcoap_workers` is used */
 /** @} */
 
 /**
@@ -129,6 +132,16 @@ extern "C" {
 #define CONFIG_NANOCOAP_NOPTS_MAX          (16)
 #endif
 
+/**
+ * @brief   Option numbers below this value are covered by the option index
+ *
+ * Only used with module `nanocoap_opt_index`. The default covers all options
+ * of RFC 7252, RFC 7641 and RFC 7959.
+ */
+#ifndef NANOCOAP_OPT_INDEX_NUMOF
+#define NANOCOAP_OPT_INDEX_NUMOF           (64U)
+#endif
+
 /**
  * @brief    Maximum length of a resource path string read from or written to
  *           a message
@@ -189,6 +202,15 @@ typedef struct {
     uint16_t payload_len;                             /**< length of payload       */
     uint16_t options_len;                             /**< length of options array */
     coap_optpos_t options[CONFIG_NANOCOAP_NOPTS_MAX]; /**< option offset array     */
+#if defined(MODULE_NANOCOAP_OPT_INDEX) || defined(DOXYGEN)
+    /**
+     * @brief   position + 1 in coap_pkt_t::options by option number, 0 if
+     *          the option is not present
+     *
+     * @note    Only available with module `nanocoap_opt_index`.
+     */
+    uint8_t opt_index[NANOCOAP_OPT_INDEX_NUMOF];
+#endif
 #ifdef MODULE_GCOAP
     uint32_t observe_value;                           /**< observe value           */
 #endif
@@ -248,6 +270,49 @@ typedef struct {
     uint8_t *opt;                   /**< Pointer to the placed option       */
 } coap_block_slicer_t;
 
+/**
+ * @brief   Read callback for coap_block2_stream_reply()
+ *
+ * @param[in]   arg     coap_block2_stream_t::arg
+ * @param[in]   offset  offset into the representation
+ * @param[out]  buf     buffer to read into
+ * @param[in]   len     number of bytes to read
+ *
+ * @returns     number of bytes read, must be @p len on success
+ * @returns     <0 on error
+ */
+typedef ssize_t (*coap_block2_read_cb_t)(void *arg, size_t offset,
+                                         uint8_t *buf, size_t len);
+
+/**
+ * @brief   Write callback for coap_block1_stream_reply()
+ *
+ * @param[in]   arg     context passed to coap_block1_stream_reply()
+ * @param[in]   offset  offset of @p data in the representation
+ * @param[in]   data    received payload
+ * @param[in]   len     length of @p data
+ * @param[in]   more    true if more blocks follow
+ *
+ * @returns     0 on success
+ * @returns     -EINVAL if @p offset is not the expected one
+ * @returns     other negative values on error
+ */
+typedef int (*coap_block1_write_cb_t)(void *arg, size_t offset,
+                                      const uint8_t *data, size_t len,
+                                      bool more);
+
+/**
+ * @brief   Representation served block-wise by coap_block2_stream_reply()
+ */
+typedef struct {
+    coap_block2_read_cb_t read;     /**< reads a part of the representation */
+    void *arg;                      /**< argument for coap_block2_stream_t::read */
+    size_t len;                     /**< length of the representation       */
+    uint32_t etag;                  /**< ETag; change it whenever the
+                                         representation changes             */
+    uint16_t format;                /**< content format or COAP_FORMAT_NONE */
+} coap_block2_stream_t;
+
 /**
  * @brief   Global CoAP resource list
  */
@@ -1462,6 +1527,49 @@ ssize_t coap_block2_build_reply(coap_pkt_t *pkt, unsigned code,
                                 uint8_t *rbuf, unsigned rlen, unsigned payload_len,
                                 coap_block_slicer_t *slicer);
 
+/**
+ * @brief   Build a block2 reply by reading the requested block from a stream
+ *
+ * The requested block is read by coap_block2_stream_t::read straight into
+ * @p rbuf, so a handler does not need to generate the whole representation
+ * for every block. The reply carries ETag, Content-Format, Block2 and Size2
+ * options. If the client sends the current ETag, the reply is 2.03 (Valid)
+ * without payload. If the block does not fit into @p rbuf, a smaller block
+ * size is used.
+ *
+ * @param[in]   pkt         packet to reply to
+ * @param[out]  rbuf        buffer to write reply to
+ * @param[in]   rlen        size of @p rbuf
+ * @param[in]   stream      representation to serve
+ *
+ * @returns     size of reply packet on success
+ * @returns     -ENOSPC if @p rbuf cannot hold the smallest block
+ * @returns     <0 on other errors
+ */
+ssize_t coap_block2_stream_reply(coap_pkt_t *pkt, uint8_t *rbuf, unsigned rlen,
+                                 const coap_block2_stream_t *stream);
+
+/**
+ * @brief   Pass the payload of a (block1) request to a write callback and
+ *          build the reply
+ *
+ * The reply is 2.31 (Continue) with a Block1 option while more blocks are
+ * expected and 2.04 (Changed) after the last one. If @p write returns
+ * -EINVAL, the reply is 4.08 (Request Entity Incomplete), on other errors
+ * 5.00 (Internal Server Error).
+ *
+ * @param[in]   pkt         packet to reply to
+ * @param[out]  rbuf        buffer to write reply to
+ * @param[in]   rlen        size of @p rbuf
+ * @param[in]   write       callback consuming the payload
+ * @param[in]   arg         argument for @p write
+ *
+ * @returns     size of reply packet on success
+ * @returns     <0 on error
+ */
+ssize_t coap_block1_stream_reply(coap_pkt_t *pkt, uint8_t *rbuf, unsigned rlen,
+                                 coap_block1_write_cb_t write, void *arg);
+
 /**
  * @brief   Builds a CoAP header
  *
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_nanocoap_tcp Nanocoap TCP
+ * @ingroup     net_nanocoap
+ * @brief       Synchronous CoAP over TCP client with persistent connections
+ * @see         [RFC 8323](https://tools.ietf.org/html/rfc8323)
+ *
+ * The module `nanocoap_tcp` sends requests built with the nanocoap Buffer API
+ * over @ref net_sock_tcp, like nanocoap_request() does over UDP. A request
+ * is built in the usual UDP format, e.g. with coap_build_hdr(), and framed
+ * for TCP right before it is sent. The response is converted back, so it is
+ * read with the regular nanocoap functions. The message type and ID have no
+ * meaning over TCP and are ignored.
+ *
+ * Connections are kept open in a pool of
+ * @ref CONFIG_NANOCOAP_TCP_CONN_NUMOF entries, one per remote endpoint, so
+ * subsequent requests to the same server skip the TCP handshake and the
+ * Capabilities and Settings Message (CSM) exchange. If the pool is full, the
+ * least recently used idle connection is closed for a new one.
+ *
+ * The CSM of the peer is recorded per connection. Its Block-Wise-Transfer
+ * option signals support of block-wise transfers with extended size (BERT),
+ * i.e. blocks of a multiple of 1024 bytes, which the application may use
+ * when nanocoap_tcp_bert() returns true. Ping signals are answered while a
+ * response is awaited, a Release or Abort signal closes the connection.
+ *
+ * TLS and CoAP over WebSockets are not supported.
+ *
+ * @{
+ *
+ * @file
+ * @brief   nanocoap CoAP over TCP definitions
+ *
+ * @author  ML!PA Consulting GmbH
+ */
+#ifndef NET_NANOCOAP_TCP_H
+#define NET_NANOCOAP_TCP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "net/nanocoap.h"
+#include "net/sock/tcp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup net_nanocoap_tcp_conf    Nanocoap TCP compile configurations
+ * @ingroup  net_nanocoap_conf
+ * @{
+ */
+/**
+ * @brief   Number of persistent connections
+ */
+#ifndef CONFIG_NANOCOAP_TCP_CONN_NUMOF
+#define CONFIG_NANOCOAP_TCP_CONN_NUMOF      (2U)
+#endif
+
+/**
+ * @brief   Maximum message size announced in the CSM
+ *
+ * Must not exceed the buffer passed to nanocoap_tcp_request(). BERT is
+ * announced if it exceeds the default of 1152 bytes.
+ *
+ * @see [RFC 8323, section 5.3.1](https://tools.ietf.org/html/rfc8323#section-5.3.1)
+ */
+#ifndef CONFIG_NANOCOAP_TCP_MAX_MSG_SIZE
+#define CONFIG_NANOCOAP_TCP_MAX_MSG_SIZE    (1152U)
+#endif
+
+/**
+ * @brief   Timeout in milliseconds for connecting and for every read
+ */
+#ifndef CONFIG_NANOCOAP_TCP_TIMEOUT
+#define CONFIG_NANOCOAP_TCP_TIMEOUT         (5000U)
+#endif
+/** @} */
+
+/**
+ * @brief   Default maximum message size of a peer without CSM option
+ */
+#define NANOCOAP_TCP_DEFAULT_MAX_MSG_SIZE   (1152U)
+
+/**
+ * @brief   Sends a request over TCP and awaits the response
+ *
+ * Reuses an open connection to @p remote or opens a new one. The
+ * connection is closed on any error but -ENOBUFS.
+ *
+ * @param[in,out] pkt       Packet struct of the request in the UDP format,
+ *                          holds the parsed response on success
+ * @param[in]     remote    Remote endpoint
+ * @param[in]     len       Total length of the buffer of @p pkt
+ *
+ * @return  length of the response in the UDP format
+ * @return  -ENOBUFS, if the request or response does not fit into the buffer
+ * @return  -EAGAIN, if all connections are busy
+ * @return  -ECONNRESET, if the peer released or aborted the connection
+ * @return  -EBADMSG, if a malformed message was received
+ * @return  other negative errno of @ref net_sock_tcp
+ */
+ssize_t nanocoap_tcp_request(coap_pkt_t *pkt, const sock_tcp_ep_t *remote,
+                             size_t len);
+
+/**
+ * @brief   Gets the maximum message size announced by a peer
+ *
+ * @param[in] remote    Remote endpoint
+ *
+ * @return  maximum message size of @p remote
+ * @return  0, if no connection to @p remote is open
+ */
+uint32_t nanocoap_tcp_max_msg_size(const sock_tcp_ep_t *remote);
+
+/**
+ * @brief   Checks if a peer supports BERT
+ *
+ * @param[in] remote    Remote endpoint
+ *
+ * @return  true, if @p remote announced BERT on its open connection
+ */
+bool nanocoap_tcp_bert(const sock_tcp_ep_t *remote);
+
+/**
+ * @brief   Releases and closes the connection to a peer
+ *
+ * Waits for a request on the connection to finish.
+ *
+ * @param[in] remote    Remote endpoint
+ */
+void nanocoap_tcp_close(const sock_tcp_ep_t *remote);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_NANOCOAP_TCP_H */
+/** @} */
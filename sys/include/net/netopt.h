@@ -740,6 +740,55 @@ typedef enum {
      */
     NETOPT_RSSI,
 
+    /**
+     * @brief   (uint8_t) PHY of BLE connections
+     *
+     * 1 for LE 1M, 2 for LE 2M and 3 for LE Coded, numbered as in the
+     * Bluetooth Core Specification. Setting it requests the PHY on all
+     * connections, peers not supporting it stay on their current PHY.
+     */
+    NETOPT_BLE_PHY,
+
+    /**
+     * @brief   (uint16_t) maximum payload of BLE link layer packets in bytes
+     *
+     * 27 to 251 bytes, values above 27 use the LE Data Length Extension on
+     * connections whose peer supports it.
+     */
+    NETOPT_BLE_DATA_LEN,
+
+    /**
+     * @brief   (byte array) add an address to the source address match table
+     *
+     * The address is a short or long address, told apart by its length, in
+     * the byte order of @ref NETOPT_ADDRESS and @ref NETOPT_ADDRESS_LONG.
+     * For IEEE 802.15.4, the radio sets the frame pending subfield of ACKs to
+     * data request MAC command frames from the addresses in the table, so a
+     * coordinator answers polls of sleepy children in time. Short addresses
+     * are matched within the PAN ID set at the time they are added.
+     *
+     * Setting returns -ENOMEM if the table is full. Adding an address that is
+     * in the table already succeeds.
+     */
+    NETOPT_SRC_MATCH_ADD,
+
+    /**
+     * @brief   (byte array) remove an address from the source address match
+     *          table
+     *
+     * See @ref NETOPT_SRC_MATCH_ADD. Setting an empty address clears the table.
+     * Setting returns -ENOENT if the address is not in the table.
+     */
+    NETOPT_SRC_MATCH_DEL,
+
+    /**
+     * @brief   (uint16_t) minimum size of a receive buffer lent to the device
+     *
+     * Only answered by devices supporting zero-copy reception, whose
+     * @ref netdev_driver_t::rx_buf_give refuses smaller buffers. Read-only.
+     */
+    NETOPT_RX_BUF_SIZE,
+
     /**
      * @brief   maximum number of options defined here.
      *
@@ -0,0 +1,205 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_netperf Network benchmark
+ * @ingroup     net
+ * @brief       Measures throughput and latency over the sock API
+ *
+ * The tests only use @ref net_sock, so the same test runs over GNRC and lwIP
+ * and results of different stacks and boards can be compared:
+ *
+ * - **UDP stream**: sends datagrams as fast as possible, or with a fixed
+ *   gap, to a server that counts them and measures loss and jitter.
+ * - **UDP request/response**: sends a datagram, waits for the server to
+ *   echo it and records the round-trip time.
+ * - **TCP stream**: sends data over a TCP connection, with module
+ *   `sock_tcp`.
+ *
+ * The server is either another node running netperf_server_start(), or
+ * `dist/tools/netperf/netperf.py` on a host. Each datagram starts with a
+ * @ref netperf_hdr_t. With module `schedstatistics`, the share of time the
+ * CPU was busy during a test is reported as well.
+ *
+ * With module `shell_commands`, everything is available through the
+ * `netperf` shell command.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Network benchmark definitions
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+
+#ifndef NET_NETPERF_H
+#define NET_NETPERF_H
+
+#include <stdint.h>
+
+#include "byteorder.h"
+#include "net/sock/udp.h"
+#ifdef MODULE_SOCK_TCP
+#include "net/sock/tcp.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Default port of the server
+ */
+#define NETPERF_PORT                (12865U)
+
+/**
+ * @brief   Size of the buffers for datagrams, limits the length of a test's
+ *          datagrams
+ */
+#ifndef CONFIG_NETPERF_BUF_SIZE
+#define CONFIG_NETPERF_BUF_SIZE     (256U)
+#endif
+
+/**
+ * @brief   Number of buckets of the round-trip time histogram
+ *
+ * Bucket 0 counts round trips below 1 ms, bucket i > 0 those below
+ * 2^i ms, the last one all others.
+ */
+#ifndef CONFIG_NETPERF_RTT_BUCKETS
+#define CONFIG_NETPERF_RTT_BUCKETS  (8U)
+#endif
+
+/**
+ * @brief   Value of netperf_result_t::cpu without module `schedstatistics`
+ */
+#define NETPERF_CPU_UNKNOWN         (UINT8_MAX)
+
+/**
+ * @brief   Test modes
+ */
+enum {
+    NETPERF_MODE_STREAM = 0,    /**< server counts the datagram */
+    NETPERF_MODE_RR     = 1,    /**< server echoes the datagram */
+};
+
+/**
+ * @brief   Header of every datagram of a test
+ */
+typedef struct __attribute__((packed)) {
+    network_uint32_t seq;       /**< sequence number, 0 starts a test */
+    network_uint32_t ts_us;     /**< sender's time of sending in µs */
+    uint8_t mode;               /**< NETPERF_MODE_STREAM or NETPERF_MODE_RR */
+    uint8_t reserved[3];        /**< 0 */
+} netperf_hdr_t;
+
+/**
+ * @brief   Parameters of a test
+ */
+typedef struct {
+    uint16_t len;               /**< length of a datagram or write, at least
+                                     sizeof(netperf_hdr_t) for UDP and at
+                                     most @ref CONFIG_NETPERF_BUF_SIZE */
+    uint32_t count;             /**< number of datagrams or writes */
+    uint32_t gap_us;            /**< time between datagrams, 0 for none */
+    uint32_t timeout_us;        /**< time to wait for a response */
+} netperf_params_t;
+
+/**
+ * @brief   Result of a test
+ */
+typedef struct {
+    uint32_t packets;           /**< datagrams or writes completed */
+    uint32_t lost;              /**< datagrams lost as seen by the server,
+                                     the stack failed to send in a stream,
+                                     or without response in udp_rr */
+    uint32_t bytes;             /**< payload bytes transferred */
+    uint32_t time_us;           /**< duration */
+    uint32_t rtt_min_us;        /**< shortest round trip, udp_rr only */
+    uint32_t rtt_avg_us;        /**< average round trip, udp_rr only */
+    uint32_t rtt_max_us;        /**< longest round trip, udp_rr only */
+    uint32_t rtt_hist[CONFIG_NETPERF_RTT_BUCKETS]; /**< round-trip time
+                                     histogram, udp_rr only */
+    uint32_t jitter_us;         /**< inter-arrival jitter as of RFC 3550,
+                                     server only */
+    uint8_t cpu;                /**< CPU busy in percent, or
+                                     @ref NETPERF_CPU_UNKNOWN */
+} netperf_result_t;
+
+/**
+ * @brief   Runs a UDP stream test
+ *
+ * @param[in] remote    server
+ * @param[in] params    parameters
+ * @param[out] res      result, netperf_result_t::lost only counts datagrams
+ *                      the stack failed to send
+ *
+ * @return  0 on success
+ * @return  -EINVAL on invalid parameters
+ * @return  <0 on sock errors
+ */
+int netperf_udp_stream(const sock_udp_ep_t *remote,
+                       const netperf_params_t *params, netperf_result_t *res);
+
+/**
+ * @brief   Runs a UDP request/response test
+ *
+ * @param[in] remote    server
+ * @param[in] params    parameters
+ * @param[out] res      result
+ *
+ * @return  0 on success
+ * @return  -EINVAL on invalid parameters
+ * @return  <0 on sock errors
+ */
+int netperf_udp_rr(const sock_udp_ep_t *remote,
+                   const netperf_params_t *params, netperf_result_t *res);
+
+#if defined(MODULE_SOCK_TCP) || defined(DOXYGEN)
+/**
+ * @brief   Runs a TCP stream test
+ *
+ * @note    Only available with module `sock_tcp`
+ *
+ * @param[in] remote    server
+ * @param[in] params    parameters, netperf_params_t::gap_us and
+ *                      netperf_params_t::timeout_us are ignored
+ * @param[out] res      result
+ *
+ * @return  0 on success
+ * @return  -EINVAL on invalid parameters
+ * @return  <0 on sock errors
+ */
+int netperf_tcp_stream(const sock_tcp_ep_t *remote,
+                       const netperf_params_t *params, netperf_result_t *res);
+#endif
+
+/**
+ * @brief   Starts the UDP server in its own thread
+ *
+ * @param[in] port      port to listen on
+ *
+ * @return  0 on success
+ * @return  -EALREADY if the server is running
+ * @return  <0 on sock errors
+ */
+int netperf_server_start(uint16_t port);
+
+/**
+ * @brief   Gets the result of the last UDP stream test seen by the server
+ *
+ * @param[out] res      result
+ */
+void netperf_server_result(netperf_result_t *res);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_NETPERF_H */
+/** @} */
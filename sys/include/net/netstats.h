@@ -20,6 +20,8 @@
 
 #include <stdint.h>
 
+#include "kernel_defines.h"
+
 #ifndef NET_NETSTATS_H
 #define NET_NETSTATS_H
 
@@ -51,6 +53,29 @@ typedef struct {
     uint32_t tx_bytes;          /**< sent bytes */
     uint32_t rx_count;          /**< received (data) packets */
     uint32_t rx_bytes;          /**< received bytes */
+#if IS_USED(MODULE_GNRC_NETIF_PKTQ) || defined(DOXYGEN)
+    uint32_t tx_queued;         /**< packets queued since the device was busy
+                                     (only with module `gnrc_netif_pktq`) */
+    uint32_t tx_dropped;        /**< packets dropped since the send queue was
+                                     full (only with module
+                                     `gnrc_netif_pktq`) */
+#endif
+#if IS_USED(MODULE_L2FILTER) || defined(DOXYGEN)
+    uint32_t rx_filtered;       /**< received packets dropped by the link
+                                     layer address filter (only with module
+                                     `l2filter`) */
+#endif
+#if IS_USED(MODULE_GNRC_GOMACH) || defined(DOXYGEN)
+    uint32_t mac_slots_alloc;   /**< dynamic slots allocated to senders
+                                     (only with module `gnrc_gomach`) */
+    uint32_t mac_slots_granted; /**< dynamic slots granted by receivers
+                                     (only with module `gnrc_gomach`) */
+    uint32_t mac_collisions;    /**< transmissions deferred since the
+                                     channel was busy (only with module
+                                     `gnrc_gomach`) */
+    uint32_t mac_idle_listen;   /**< wake-up periods without reception
+                                     (only with module `gnrc_gomach`) */
+#endif
 } netstats_t;
 
 #ifdef __cplusplus
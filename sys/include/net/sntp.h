@@ -11,6 +11,21 @@
  * @defgroup    net_sntp Simple Network Time Protocol
  * @ingroup     net
  * @brief       Simple Network Time Protocol (SNTP) implementation
+ *
+ * The offset to the server is computed from all four timestamps of an
+ * exchange, so the network delay is compensated assuming it is the same in
+ * both directions. With @ref CONFIG_SNTP_DRIFT_SAMPLES greater than 1, the
+ * drift of the system clock is estimated by a linear regression over the
+ * last offsets measured and the offset returned by sntp_get_offset() is
+ * extrapolated accordingly, so @ref sntp_sync() is needed less often. An
+ * offset differing by more than 128 ms from the estimate is taken as a time
+ * step and discards the older samples.
+ *
+ * The timestamps are taken when the sock returns, hence the accuracy is
+ * limited by the latency of the network stack.
+ *
+ * With module `walltime`, every sntp_sync() corrects the @ref sys_walltime
+ * towards the time of the server.
  * @{
  *
  * @file
@@ -34,6 +49,21 @@
 extern "C" {
 #endif
 
+/**
+ * @defgroup net_sntp_conf    SNTP compile configurations
+ * @ingroup  config
+ * @{
+ */
+/**
+ * @brief   Number of synchronizations the clock drift is estimated from
+ *
+ * 1 disables the drift estimation.
+ */
+#ifndef CONFIG_SNTP_DRIFT_SAMPLES
+#define CONFIG_SNTP_DRIFT_SAMPLES   (1U)
+#endif
+/** @} */
+
 /**
  * @brief Synchronize with time server
  *
@@ -48,6 +78,9 @@ int sntp_sync(sock_udp_ep_t *server, uint32_t timeout);
 /**
  * @brief Get real time offset from system time as returned by @ref xtimer_now64()
  *
+ * Includes the estimated drift since the last synchronization, see
+ * @ref CONFIG_SNTP_DRIFT_SAMPLES.
+ *
  * @return Real time offset in microseconds relative to 1900-01-01 00:00 UTC
  */
 int64_t sntp_get_offset(void);
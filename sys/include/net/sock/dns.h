@@ -61,6 +61,43 @@ typedef struct {
 #define SOCK_DNS_MAX_NAME_LEN   (SOCK_DNS_BUF_LEN - sizeof(sock_dns_hdr_t) - 4)
 /** @} */
 
+/**
+ * @name DNS cache configuration
+ *
+ * Only used with module `sock_dns_cache`.
+ * @{
+ */
+/**
+ * @brief   Number of cached results
+ */
+#ifndef CONFIG_SOCK_DNS_CACHE_SIZE
+#define CONFIG_SOCK_DNS_CACHE_SIZE      (4)
+#endif
+
+/**
+ * @brief   Maximum length of a cached name, longer names are not cached
+ */
+#ifndef CONFIG_SOCK_DNS_CACHE_NAME_LEN
+#define CONFIG_SOCK_DNS_CACHE_NAME_LEN  (32)
+#endif
+
+/**
+ * @brief   Lifetime in seconds of a cached negative result, i.e. an answer
+ *          without matching record
+ */
+#ifndef CONFIG_SOCK_DNS_CACHE_NEG_TTL
+#define CONFIG_SOCK_DNS_CACHE_NEG_TTL   (60)
+#endif
+/** @} */
+
+/**
+ * @brief DNS cache statistics
+ */
+typedef struct {
+    uint32_t hits;      /**< queries answered from the cache */
+    uint32_t misses;    /**< queries sent to the DNS server */
+} sock_dns_cache_stats_t;
+
 /**
  * @brief Get IP address for DNS name
  *
@@ -73,6 +110,10 @@ typedef struct {
  * This function will return the first DNS record it receives. IF both A and
  * AAAA are requested, AAAA will be preferred.
  *
+ * With module `sock_dns_cache`, results are cached for the TTL of the record
+ * and answers without matching record for @ref CONFIG_SOCK_DNS_CACHE_NEG_TTL,
+ * so all users of this function share the cache.
+ *
  * @note @p addr_out needs to provide space for any possible result!
  *       (4byte when family==AF_INET, 16byte otherwise)
  *
@@ -85,6 +126,22 @@ typedef struct {
  */
 int sock_dns_query(const char *domain_name, void *addr_out, int family);
 
+/**
+ * @brief   Get the DNS cache statistics
+ *
+ * @note    Only available with module `sock_dns_cache`.
+ *
+ * @return  hit and miss counters of the cache
+ */
+const sock_dns_cache_stats_t *sock_dns_cache_get_stats(void);
+
+/**
+ * @brief   Remove all entries from the DNS cache
+ *
+ * @note    Only available with module `sock_dns_cache`.
+ */
+void sock_dns_cache_flush(void);
+
 /**
  * @brief global DNS server endpoint
  */
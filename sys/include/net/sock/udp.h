@@ -273,6 +273,8 @@
 #include <stdlib.h>
 #include <sys/types.h>
 
+#include "iolist.h"
+
 /* net/sock/async/types.h included by net/sock.h needs to re-typedef the
  * `sock_ip_t` to prevent cyclic includes */
 #if defined (__clang__)
@@ -296,6 +298,16 @@ typedef struct _sock_tl_ep sock_udp_ep_t;   /**< An end point for a UDP sock obj
  */
 typedef struct sock_udp sock_udp_t;
 
+/**
+ * @brief   Buffer descriptor for sock_udp_recv_many()
+ */
+typedef struct {
+    void *data;             /**< buffer to store the datagram in */
+    size_t max_len;         /**< maximum space available at sock_udp_mmsg_t::data */
+    size_t len;             /**< length of the datagram received into data */
+    sock_udp_ep_t remote;   /**< remote end point of the datagram */
+} sock_udp_mmsg_t;
+
 #if defined (__clang__)
 # pragma clang diagnostic pop
 #endif
@@ -413,6 +425,37 @@ int sock_udp_get_remote(sock_udp_t *sock, sock_udp_ep_t *ep);
 ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
                       uint32_t timeout, sock_udp_ep_t *remote);
 
+/**
+ * @brief   Receives several UDP messages in one call
+ *
+ * @pre `(sock != NULL) && (msgs != NULL) && (msgs_len > 0)`
+ *
+ * Only waits for the first datagram. After that, all datagrams already
+ * queued for @p sock are copied into @p msgs without blocking again,
+ * until @p msgs is full.
+ *
+ * @param[in] sock      A UDP sock object.
+ * @param[in,out] msgs  Buffers for the datagrams. sock_udp_mmsg_t::data and
+ *                      sock_udp_mmsg_t::max_len must be set, the other
+ *                      members are set for each received datagram.
+ * @param[in] msgs_len  Number of buffers in @p msgs.
+ * @param[in] timeout   Timeout for the first datagram in microseconds.
+ *                      If 0 and no data is available, the function returns
+ *                      immediately.
+ *                      May be @ref SOCK_NO_TIMEOUT for no timeout (wait until
+ *                      data is available).
+ *
+ * @experimental    This function is quite new, not implemented for all stacks
+ *                  yet, and may be subject to sudden API changes. Do not use in
+ *                  production if this is unacceptable.
+ *
+ * @return  The number of datagrams received on success.
+ * @return  Any error of sock_udp_recv(), if not even the first datagram was
+ *          received.
+ */
+ssize_t sock_udp_recv_many(sock_udp_t *sock, sock_udp_mmsg_t *msgs,
+                           size_t msgs_len, uint32_t timeout);
+
 /**
  * @brief   Provides stack-internal buffer space containing a UDP message from
  *          a remote end point
@@ -494,6 +537,32 @@ ssize_t sock_udp_recv_buf(sock_udp_t *sock, void **data, void **buf_ctx,
 ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
                       const sock_udp_ep_t *remote);
 
+/**
+ * @brief   Sends a UDP message gathered from multiple buffers to remote end
+ *          point
+ *
+ * The chunks of @p snips are sent as one UDP datagram, without the need to
+ * concatenate them into a single buffer first.
+ *
+ * @pre `((sock != NULL || remote != NULL))`
+ *
+ * @param[in] sock      A raw IPv4/IPv6 sock object. May be `NULL`.
+ *                      A sensible local end point should be selected by the
+ *                      implementation in that case.
+ * @param[in] snips     List of payload chunks. May be `NULL` for an empty
+ *                      datagram.
+ * @param[in] remote    Remote end point for the sent data.
+ *                      May be `NULL`, if @p sock has a remote end point.
+ *                      sock_udp_ep_t::family may be AF_UNSPEC, if local
+ *                      end point of @p sock provides this information.
+ *                      sock_udp_ep_t::port may not be 0.
+ *
+ * @return  The number of bytes sent on success.
+ * @return  The same negative error codes as @ref sock_udp_send().
+ */
+ssize_t sock_udp_sendv(sock_udp_t *sock, const iolist_t *snips,
+                       const sock_udp_ep_t *remote);
+
 #include "sock_types.h"
 
 #ifdef __cplusplus
@@ -117,6 +117,19 @@ pipe_t *pipe_malloc(unsigned size);
  */
 void pipe_free(pipe_t *rp);
 
+/**
+ * @brief     Make a pipe available as file descriptor, e.g. for poll().
+ * @details   Reading and writing the file descriptor behaves like
+ *            pipe_read() and pipe_write(). Closing it does not free the pipe.
+ *            Only available with the `vfs` module.
+ * @param     pipe   Pipe to bind, must stay valid until the fd is closed.
+ * @param     flags  Access flags of the fd, `O_RDONLY`, `O_WRONLY` or
+ *                   `O_RDWR`.
+ * @returns   The file descriptor on success.
+ *            `< 0` on error.
+ */
+int pipe_vfs_bind(pipe_t *pipe, int flags);
+
 #ifdef __cplusplus
 }
 #endif
@@ -25,6 +25,16 @@
  *
  * In order to use this module, you'll need to implement pm_set().
  *
+ * With module `pm_layered_tickless`, @ref pm_set_lowest() additionally looks
+ * at the next timer set on `ZTIMER_USEC` and `ZTIMER_MSEC`. It only selects a
+ * mode whose wakeup latency (@ref PM_WAKEUP_LATENCY_US) is shorter than the
+ * time until that timer triggers, and otherwise falls back to the next
+ * lighter mode. Timers on a clock that does not run in a given mode already
+ * block that mode via the clock's required power mode.
+ *
+ * With module `pm_layered_stats`, the number of times and the time spent in
+ * every mode is recorded, see @ref pm_layered_get_stats().
+ *
  * @file
  * @brief       Layered low power mode infrastructure
  *
@@ -35,6 +45,7 @@
 #define PM_LAYERED_H
 
 #include "assert.h"
+#include "kernel_defines.h"
 #include "periph_cpu.h"
 
 #ifdef __cplusplus
@@ -49,6 +60,17 @@ extern "C" {
 #define PROVIDES_PM_SET_LOWEST
 #endif
 
+/**
+ * @brief   Wakeup latency of every power mode in microseconds
+ *
+ * Initializer for an array of @ref PM_NUM_MODES entries, starting with
+ * mode 0. Used by module `pm_layered_tickless` only. Should be defined by the
+ * CPU or board, the default treats all modes as waking up instantly.
+ */
+#ifndef PM_WAKEUP_LATENCY_US
+#define PM_WAKEUP_LATENCY_US    { 0 }
+#endif
+
 /**
  * @brief Power Management mode blocker typedef
  */
@@ -92,6 +114,38 @@ void pm_set(unsigned mode);
  */
 pm_blocker_t pm_get_blocker(void);
 
+#if IS_USED(MODULE_PM_LAYERED_STATS) || defined(DOXYGEN)
+/**
+ * @brief   Power mode statistics
+ *
+ * Index @ref PM_NUM_MODES is the implicit idle mode.
+ */
+typedef struct {
+    uint32_t count[PM_NUM_MODES + 1];   /**< number of times a mode was set */
+    uint32_t time_ms[PM_NUM_MODES + 1]; /**< time spent in a mode in ms */
+} pm_layered_stats_t;
+
+/**
+ * @brief   Get the power mode statistics
+ *
+ * Time is measured with `ZTIMER_MSEC`, which should keep running in all
+ * modes used (e.g. backed by an RTT). Visits shorter than a millisecond
+ * round down.
+ *
+ * @note    Only available with module `pm_layered_stats`
+ *
+ * @param[out]  stats   the statistics
+ */
+void pm_layered_get_stats(pm_layered_stats_t *stats);
+
+/**
+ * @brief   Reset the power mode statistics
+ *
+ * @note    Only available with module `pm_layered_stats`
+ */
+void pm_layered_reset_stats(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -22,6 +22,15 @@
  *  - Simple Park-Miller PRNG
  *  - Musl C PRNG
  *  - Fortuna (CS)PRNG
+ *  - ChaCha20 CSPRNG (`prng_chacha20`)
+ *
+ * The `random_pool` module keeps a small pool of hardware entropy. It is
+ * filled from `periph_hwrng` at boot and refilled in batches by the lowest
+ * priority event thread whenever it runs low, so readers never wait for the
+ * conversion of the TRNG. Without a hardware RNG, the pool is filled once
+ * from `puf_sram`. The ChaCha20 CSPRNG is keyed from the pool and reseeds
+ * itself from it regularly; it uses fast key erasure, so earlier output
+ * cannot be reconstructed from its state.
  */
 
 #ifndef RANDOM_H
@@ -42,6 +51,21 @@ extern "C" {
 #define RANDOM_SEED_DEFAULT (1)
 #endif
 
+/**
+ * @brief   Size of the entropy pool of the `random_pool` module in bytes
+ */
+#ifndef CONFIG_RANDOM_POOL_SIZE
+#define CONFIG_RANDOM_POOL_SIZE             (64U)
+#endif
+
+/**
+ * @brief   Number of 64 byte key stream blocks `prng_chacha20` generates
+ *          between two reseeds from the entropy pool
+ */
+#ifndef CONFIG_PRNG_CHACHA20_RESEED_BLOCKS
+#define CONFIG_PRNG_CHACHA20_RESEED_BLOCKS  (256U)
+#endif
+
 /**
  * @brief Enables support for floating point random number generation
  */
@@ -94,6 +118,31 @@ void random_bytes(uint8_t *buf, size_t size);
  */
 uint32_t random_uint32_range(uint32_t a, uint32_t b);
 
+/**
+ * @brief   Fill the entropy pool
+ *
+ * Blocks until the pool is full. This is called by `auto_init_random`.
+ *
+ * @note    Only available with the `random_pool` module
+ */
+void random_pool_init(void);
+
+/**
+ * @brief   Take bytes from the entropy pool
+ *
+ * Never blocks on the entropy source: if the pool holds less than @p len
+ * bytes, only those are returned. A refill is scheduled when the pool runs
+ * low.
+ *
+ * @note    Only available with the `random_pool` module
+ *
+ * @param[out]  buf     buffer for the entropy
+ * @param[in]   len     number of bytes requested
+ *
+ * @return  number of bytes written to @p buf
+ */
+size_t random_pool_read(void *buf, size_t len);
+
 #if PRNG_FLOAT
 /* These real versions are due to Isaku Wada, 2002/01/09 added */
 
@@ -41,6 +41,14 @@
  * 2. write image starting at second block
  * 3. write first block
  *
+ * With the `riotboot_flashwrite_delta` module, the image can also be fed as
+ * a delta patch against the currently running slot, see
+ * @ref riotboot_flashwrite_delta_putbytes().
+ *
+ * With the `riotboot_flashwrite_heatshrink` module, the image can be fed
+ * compressed with heatshrink, see
+ * @ref riotboot_flashwrite_heatshrink_putbytes().
+ *
  * @author      Kaspar Schleiser <kaspar@schleiser.de>
  * @author      Koen Zandberg <koen@bergzand.net>
  *
@@ -54,9 +62,15 @@
 extern "C" {
 #endif
 
+#include <stdbool.h>
+
 #include "riotboot/slot.h"
 #include "periph/flashpage.h"
 
+#if defined(MODULE_RIOTBOOT_FLASHWRITE_HEATSHRINK) || defined(DOXYGEN)
+#include "heatshrink_decoder.h"
+#endif
+
 /**
  * @brief   firmware update state structure
  *
@@ -186,6 +200,136 @@ size_t riotboot_flashwrite_slotsize(const riotboot_flashwrite_t *state);
 int riotboot_flashwrite_verify_sha256(const uint8_t *sha256_digest,
                                       size_t img_size, int target_slot);
 
+/**
+ * @brief   Magic number at the start of a delta patch
+ */
+#define RIOTBOOT_FLASHWRITE_DELTA_MAGIC     "RBD1"
+
+/**
+ * @brief   Length of @ref RIOTBOOT_FLASHWRITE_DELTA_MAGIC
+ */
+#define RIOTBOOT_FLASHWRITE_DELTA_MAGIC_LEN (sizeof(RIOTBOOT_FLASHWRITE_DELTA_MAGIC) - 1)
+
+/**
+ * @brief   Size of the output buffer of the delta patch engine
+ */
+#ifndef RIOTBOOT_FLASHWRITE_DELTA_BUFSIZE
+#define RIOTBOOT_FLASHWRITE_DELTA_BUFSIZE   (32U)
+#endif
+
+/**
+ * @brief   Delta patch state structure
+ *
+ * The patch consists of @ref RIOTBOOT_FLASHWRITE_DELTA_MAGIC followed by
+ * records of three LEB128 encoded integers: the length of the diff section,
+ * the length of the extra section and the zigzag encoded offset by which the
+ * source position moves after the record.
+ *
+ * The diff section alternates between the length of a run of unchanged bytes,
+ * which are copied from the source, and the length of a run of bytes that are
+ * added to the source, followed by those bytes. The extra section holds
+ * literal bytes.
+ */
+typedef struct {
+    riotboot_flashwrite_t *writer;  /**< writer for the rebuilt image     */
+    const uint8_t *source;          /**< image the patch applies to       */
+    size_t source_len;              /**< size of the source slot          */
+    size_t src_pos;                 /**< current position in the source   */
+    size_t marker_pos;              /**< verified marker in the source, or 0 */
+    size_t out_pos;                 /**< current position in the image    */
+    size_t skip;                    /**< image bytes to drop at the start */
+    uint32_t varint;                /**< integer that is being decoded    */
+    uint32_t diff_left;             /**< bytes left in the diff section   */
+    uint32_t extra_left;            /**< bytes left in the extra section  */
+    int32_t adjust;                 /**< source offset after the record   */
+    uint32_t run;                   /**< bytes left in the current run    */
+    uint8_t shift;                  /**< bits of @p varint decoded so far */
+    uint8_t state;                  /**< decoder state                    */
+    uint16_t out_len;               /**< bytes in @p out                  */
+    uint8_t out[RIOTBOOT_FLASHWRITE_DELTA_BUFSIZE]; /**< output buffer    */
+} riotboot_flashwrite_delta_t;
+
+/**
+ * @brief   Initialize a delta update
+ *
+ * The rebuilt image is passed to @p writer, which must have been initialized
+ * before. As with @ref riotboot_flashwrite_putbytes(), the first
+ * `writer->offset` bytes of the image are dropped.
+ *
+ * @param[out]  delta       ptr to preallocated delta state
+ * @param[in]   writer      initialized flash writer
+ * @param[in]   source_slot slot holding the image the patch applies to
+ */
+void riotboot_flashwrite_delta_init(riotboot_flashwrite_delta_t *delta,
+                                    riotboot_flashwrite_t *writer,
+                                    int source_slot);
+
+/**
+ * @brief   Feed a delta patch into the firmware writer
+ *
+ * The patch is applied while it is streamed, using a constant amount of RAM.
+ *
+ * @param[in,out]   delta   ptr to previously initialized delta state
+ * @param[in]       bytes   ptr to patch data
+ * @param[in]       len     len of patch data
+ * @param[in]       more    whether more data is coming
+ *
+ * @returns         0 on success, <0 if the patch is invalid or writing failed
+ */
+int riotboot_flashwrite_delta_putbytes(riotboot_flashwrite_delta_t *delta,
+                                       const uint8_t *bytes, size_t len,
+                                       bool more);
+
+#if defined(MODULE_RIOTBOOT_FLASHWRITE_HEATSHRINK) || defined(DOXYGEN)
+/**
+ * @brief   Size of the output buffer of the heatshrink decompressor
+ */
+#ifndef RIOTBOOT_FLASHWRITE_HEATSHRINK_BUFSIZE
+#define RIOTBOOT_FLASHWRITE_HEATSHRINK_BUFSIZE  (64U)
+#endif
+
+/**
+ * @brief   Heatshrink decompression state structure
+ *
+ * The image has to be compressed with the window and lookahead size of the
+ * decoder, by default `heatshrink -e -w 8 -l 4`.
+ */
+typedef struct {
+    riotboot_flashwrite_t *writer;  /**< writer for the decompressed image */
+    heatshrink_decoder decoder;     /**< heatshrink decoder state          */
+    size_t skip;                    /**< image bytes to drop at the start  */
+    uint16_t out_len;               /**< bytes in @p out                   */
+    uint8_t out[RIOTBOOT_FLASHWRITE_HEATSHRINK_BUFSIZE]; /**< output buffer */
+} riotboot_flashwrite_heatshrink_t;
+
+/**
+ * @brief   Initialize a compressed update
+ *
+ * The decompressed image is passed to @p writer, which must have been
+ * initialized before. As with @ref riotboot_flashwrite_putbytes(), the first
+ * `writer->offset` bytes of the image are dropped.
+ *
+ * @param[out]  hs          ptr to preallocated decompression state
+ * @param[in]   writer      initialized flash writer
+ */
+void riotboot_flashwrite_heatshrink_init(riotboot_flashwrite_heatshrink_t *hs,
+                                         riotboot_flashwrite_t *writer);
+
+/**
+ * @brief   Feed a heatshrink compressed image into the firmware writer
+ *
+ * @param[in,out]   hs      ptr to previously initialized decompression state
+ * @param[in]       bytes   ptr to compressed data
+ * @param[in]       len     len of compressed data
+ * @param[in]       more    whether more data is coming
+ *
+ * @returns         0 on success, <0 if decompression or writing failed
+ */
+int riotboot_flashwrite_heatshrink_putbytes(riotboot_flashwrite_heatshrink_t *hs,
+                                            const uint8_t *bytes, size_t len,
+                                            bool more);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -20,6 +20,9 @@
  * - the address where the RIOT firmware is found
  * - the checksum of the three previous fields
  *
+ * It is followed by an image digest (see @ref riotboot_hdr_digest_t), which
+ * the bootloader can check before booting an image.
+ *
  * @file
  * @brief       RIOT "partition" header and tools
  *
@@ -56,6 +59,27 @@ typedef struct {
 } riotboot_hdr_t;
 /** @} */
 
+/**
+ * @brief  Value of riotboot_hdr_digest_t::verified once the image is verified
+ */
+#define RIOTBOOT_HDR_VERIFIED  0x44524556 /* "VERD" */
+
+/**
+ * @brief Image digest, stored in the header area right after riotboot_hdr_t
+ *
+ * The digest covers the @p img_len bytes starting at riotboot_hdr_t::start_addr.
+ * @p verified stays erased when the image is written and is programmed by
+ * the bootloader after the first successful check.
+ * @{
+ */
+typedef struct {
+    uint32_t img_len;           /**< Length of the image                              */
+    uint8_t digest[32];         /**< SHA256 digest of the image                       */
+    uint32_t chksum;            /**< Checksum of the two previous fields              */
+    uint32_t verified[2];       /**< RIOTBOOT_HDR_VERIFIED once checked               */
+} riotboot_hdr_digest_t;
+/** @} */
+
 /**
  * @brief  Print formatted riotboot_hdr_t to STDIO
  *
@@ -83,6 +107,37 @@ int riotboot_hdr_validate(const riotboot_hdr_t *riotboot_hdr);
  */
 uint32_t riotboot_hdr_checksum(const riotboot_hdr_t *riotboot_hdr);
 
+/**
+ * @brief  Get the image digest that follows a header
+ *
+ * @param[in] riotboot_hdr  ptr to image header
+ *
+ * @returns ptr to the image digest
+ */
+static inline const riotboot_hdr_digest_t *riotboot_hdr_get_digest(const riotboot_hdr_t *riotboot_hdr)
+{
+    return (const riotboot_hdr_digest_t *)(riotboot_hdr + 1);
+}
+
+/**
+ * @brief  Validate image digest
+ *
+ * @param[in] digest  ptr to image digest
+ *
+ * @returns 0 if OK
+ * @returns -1 if not OK
+ */
+int riotboot_hdr_digest_validate(const riotboot_hdr_digest_t *digest);
+
+/**
+ * @brief  Calculate image digest checksum
+ *
+ * @param[in] digest  ptr to image digest
+ *
+ * @returns the checksum of the given image digest
+ */
+uint32_t riotboot_hdr_digest_checksum(const riotboot_hdr_digest_t *digest);
+
 #ifdef __cplusplus
 }
 #endif
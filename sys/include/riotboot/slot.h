@@ -31,6 +31,18 @@ extern "C" {
 
 #include "riotboot/hdr.h"
 
+/**
+ * @brief   Remember a successful image check in the header
+ *
+ * With this enabled, riotboot_slot_verify() programs
+ * riotboot_hdr_digest_t::verified after hashing an image, so later boots skip
+ * the hash. Disable it on flash that can not program a block of an already
+ * written page, e.g. flash with ECC.
+ */
+#ifndef CONFIG_RIOTBOOT_VERIFY_CACHE
+#define CONFIG_RIOTBOOT_VERIFY_CACHE    1
+#endif
+
 /**
  * @brief  Get currently running image slot
  *
@@ -98,6 +110,20 @@ static inline void riotboot_slot_print_hdr(unsigned slot)
  */
 size_t riotboot_slot_offset(unsigned slot);
 
+/**
+ * @brief  Check the image of a slot against the digest in its header
+ *
+ * Images without a valid digest are rejected. The image is only hashed if
+ * it has not been marked as verified yet, see
+ * @ref CONFIG_RIOTBOOT_VERIFY_CACHE.
+ *
+ * @param[in] slot  slot to check
+ *
+ * @returns 0 if the image is intact
+ * @returns -1 otherwise
+ */
+int riotboot_slot_verify(unsigned slot);
+
 /**
  * @brief  Dump the addresses of all configured slots
  *
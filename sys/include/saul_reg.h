@@ -102,6 +102,10 @@ saul_reg_t *saul_reg_find_nth(int pos);
 /**
  * @brief   Find the first device of the given type in the registry
  *
+ * The last match is cached, so repeated lookups of the same type do not walk
+ * the registry. The returned entry stays valid, so it can be kept as handle
+ * instead of looking it up again.
+ *
  * @param[in] type      device type to look for
  *
  * @return      pointer to the first device matching the given type
@@ -112,6 +116,8 @@ saul_reg_t *saul_reg_find_type(uint8_t type);
 /**
  * @brief   Find a device by its name
  *
+ * The last match is cached, like for saul_reg_find_type().
+ *
  * @param[in] name      the name to look for
  *
  * @return      pointer to the first device matching the given name
@@ -145,6 +151,43 @@ int saul_reg_read(saul_reg_t *dev, phydat_t *res);
  */
 int saul_reg_write(saul_reg_t *dev, phydat_t *data);
 
+#if IS_USED(MODULE_SAUL_BATCH) || defined(DOXYGEN)
+/**
+ * @brief   Read a batch of samples from the given device
+ *
+ * Devices without a hardware FIFO return a single sample, read with
+ * saul_reg_read().
+ *
+ * @note    Only available with module `saul_batch`
+ *
+ * @param[in] dev       device to read from
+ * @param[in,out] batch buffer to read to, saul_batch_t::val and
+ *                      saul_batch_t::numof must be set
+ *
+ * @return      the number of samples read to @p batch
+ * @return      -ENODEV if given device is invalid
+ * @return      -ENOTSUP if read operation is not supported by the device
+ * @return      -ECANCELED on device errors
+ */
+int saul_reg_read_batch(saul_reg_t *dev, saul_batch_t *batch);
+
+/**
+ * @brief   Configure the hardware FIFO of the given device
+ *
+ * @note    Only available with module `saul_batch`
+ *
+ * @param[in] dev       device to configure
+ * @param[in] cfg       FIFO configuration
+ *
+ * @return      0 on success
+ * @return      -ENODEV if given device is invalid
+ * @return      -ENOTSUP if the device has no FIFO
+ * @return      -EINVAL if the configuration is not supported
+ * @return      -ECANCELED on device errors
+ */
+int saul_reg_fifo_config(saul_reg_t *dev, const saul_fifo_cfg_t *cfg);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_sched_edf Earliest deadline first scheduling
+ * @ingroup     sys
+ * @brief       Periodic threads with deadlines and CPU time budgets
+ *
+ * Threads registered with @ref sched_edf_add() are released periodically
+ * and scheduled earliest deadline first, above all threads with normal
+ * fixed priorities. This is implemented by reserving the priority band
+ * from @ref CONFIG_SCHED_EDF_PRIO_BASE to
+ * `CONFIG_SCHED_EDF_PRIO_BASE + CONFIG_SCHED_EDF_NUMOF - 1` and assigning
+ * these priorities to the released jobs in deadline order on every release
+ * and completion. No other thread should use a priority in this band.
+ *
+ * The deadline of a job is the next release. A job that has not completed
+ * (by calling @ref sched_edf_wait_period()) by then counts as a deadline
+ * miss; the thread then continues with the next job right away.
+ *
+ * The CPU time of each job is measured at context switches. A job
+ * exhausting its budget counts as an overrun and is demoted to
+ * @ref CONFIG_SCHED_EDF_DEPLETED_PRIO until its next release, so it cannot
+ * starve other EDF threads.
+ *
+ * Timing is done with `ZTIMER_USEC`. The statistics are shown by `ps`.
+ *
+ * A typical EDF thread looks like this:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * static void *_sampler(void *arg)
+ * {
+ *     static sched_edf_t edf;
+ *
+ *     sched_edf_add(&edf, thread_getpid(), 10000, 2000);
+ *     while (1) {
+ *         sample();
+ *         sched_edf_wait_period();
+ *     }
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @{
+ *
+ * @file
+ * @brief       Earliest deadline first scheduling class
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+
+#ifndef SCHED_EDF_H
+#define SCHED_EDF_H
+
+#include <stdint.h>
+
+#include "sched.h"
+#include "thread.h"
+#include "ztimer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Highest (numerically lowest) priority of the EDF band
+ */
+#ifndef CONFIG_SCHED_EDF_PRIO_BASE
+#define CONFIG_SCHED_EDF_PRIO_BASE      (0U)
+#endif
+
+/**
+ * @brief   Maximum number of EDF threads, also the size of the EDF band
+ */
+#ifndef CONFIG_SCHED_EDF_NUMOF
+#define CONFIG_SCHED_EDF_NUMOF          (2U)
+#endif
+
+/**
+ * @brief   Priority of a job that exhausted its budget
+ */
+#ifndef CONFIG_SCHED_EDF_DEPLETED_PRIO
+#define CONFIG_SCHED_EDF_DEPLETED_PRIO  (THREAD_PRIORITY_MIN - 1)
+#endif
+
+/**
+ * @brief   Thread flag used to release a job
+ */
+#ifndef CONFIG_SCHED_EDF_THREAD_FLAG
+#define CONFIG_SCHED_EDF_THREAD_FLAG    (1u << 13)
+#endif
+
+/**
+ * @brief   State of an EDF thread
+ */
+typedef enum {
+    SCHED_EDF_IDLE,         /**< waiting for the next release */
+    SCHED_EDF_ACTIVE,       /**< job released and within its budget */
+    SCHED_EDF_DEPLETED,     /**< job released, budget exhausted */
+} sched_edf_state_t;
+
+/**
+ * @brief   EDF parameters, state and statistics of a thread
+ *
+ * Treat as opaque, except for reading the statistics.
+ */
+typedef struct {
+    thread_t *thread;           /**< the scheduled thread */
+    ztimer_t release;           /**< periodic release timer */
+    ztimer_t budget_timer;      /**< fires when the budget is exhausted */
+    uint32_t period;            /**< period in microseconds */
+    uint32_t budget;            /**< CPU time per period in microseconds */
+    uint32_t deadline;          /**< absolute deadline of the current job */
+    uint32_t used;              /**< CPU time used by the current job */
+    uint32_t since;             /**< time the thread was last switched in */
+    sched_edf_state_t state;    /**< current state */
+    uint32_t jobs;              /**< number of released jobs */
+    uint32_t deadline_misses;   /**< jobs completed after their deadline */
+    uint32_t budget_overruns;   /**< jobs that exhausted their budget */
+} sched_edf_t;
+
+/**
+ * @brief   Make a thread periodic and schedule it earliest deadline first
+ *
+ * The first job is released immediately.
+ *
+ * @pre     @p budget <= @p period
+ *
+ * @param[out] edf      EDF state, must stay valid while the thread runs
+ * @param[in] pid       thread to schedule
+ * @param[in] period    period (and relative deadline) in microseconds
+ * @param[in] budget    CPU time per period in microseconds
+ *
+ * @return  0 on success
+ * @return  -EINVAL if @p pid is invalid or already scheduled
+ * @return  -ENOMEM if @ref CONFIG_SCHED_EDF_NUMOF threads are registered
+ */
+int sched_edf_add(sched_edf_t *edf, kernel_pid_t pid, uint32_t period,
+                  uint32_t budget);
+
+/**
+ * @brief   Stop EDF scheduling of a thread
+ *
+ * The thread keeps the priority it last had.
+ *
+ * @param[in] edf   EDF state passed to @ref sched_edf_add()
+ */
+void sched_edf_remove(sched_edf_t *edf);
+
+/**
+ * @brief   Complete the current job and wait for the next release
+ *
+ * Must be called by an EDF thread. Returns immediately if the next job has
+ * already been released.
+ */
+void sched_edf_wait_period(void);
+
+/**
+ * @brief   Get the EDF state of a thread
+ *
+ * @param[in] pid   thread to look up
+ *
+ * @return  the EDF state, NULL if @p pid is not EDF scheduled
+ */
+const sched_edf_t *sched_edf_get(kernel_pid_t pid);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCHED_EDF_H */
+/** @} */
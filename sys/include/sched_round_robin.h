@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_sched_round_robin Round robin time slicing
+ * @ingroup     sys
+ * @brief       Preemptive round robin among threads of equal priority
+ *
+ * Without this module, the running thread keeps the CPU until it blocks or
+ * calls thread_yield(), even if other threads of its priority are
+ * runnable. With it, the running thread is moved to the end of its run
+ * queue once it used up a quantum of
+ * @ref CONFIG_SCHED_ROUND_ROBIN_QUANTUM_MS milliseconds.
+ *
+ * The quantum timer only runs while another thread of the same priority
+ * as the running one is runnable, so systems without contention stay
+ * tickless.
+ *
+ * Just add `USEMODULE += sched_round_robin` to enable it.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Round robin time slicing configuration
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+
+#ifndef SCHED_ROUND_ROBIN_H
+#define SCHED_ROUND_ROBIN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Time slice length in milliseconds
+ */
+#ifndef CONFIG_SCHED_ROUND_ROBIN_QUANTUM_MS
+#define CONFIG_SCHED_ROUND_ROBIN_QUANTUM_MS     (10U)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCHED_ROUND_ROBIN_H */
+/** @} */
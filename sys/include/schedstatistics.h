@@ -16,6 +16,20 @@
  *
  * @note        If auto_init is disabled `init_schedstatistics()` needs to be
  *              called as well as xtimer_init().
+ *
+ * With module `schedstatistics_ext`, @ref sched_pidlist_ext additionally
+ * records for every thread
+ *
+ * - a histogram of the latency from becoming runnable to actually running,
+ * - the longest time the thread ran without a context switch, and
+ * - the time the thread spent blocked on a mutex or on message passing.
+ *
+ * With module `schedstatistics_irq` (Cortex-M3 and up), the time every
+ * thread kept interrupts disabled is measured as well, using the DWT cycle
+ * counter.
+ *
+ * The statistics are printed by the `schedstat` shell command, and can be
+ * exported in binary form with @ref schedstat_ext_dump().
  * @{
  *
  * @file
@@ -29,7 +43,10 @@
 #ifndef SCHEDSTATISTICS_H
 #define SCHEDSTATISTICS_H
 
+#include <stddef.h>
 #include <stdint.h>
+
+#include "kernel_defines.h"
 #include "kernel_types.h"
 
 #ifdef __cplusplus
@@ -51,6 +68,116 @@ typedef struct {
  */
 extern schedstat_t sched_pidlist[KERNEL_PID_LAST + 1];
 
+#if IS_USED(MODULE_SCHEDSTATISTICS_EXT) || defined(DOXYGEN)
+/**
+ * @brief   Number of buckets of the wakeup latency histogram
+ *
+ * Bucket 0 counts latencies below 4 xtimer ticks, bucket `i` latencies of
+ * at least `4^i` ticks and below `4^(i + 1)` ticks. The last bucket counts
+ * all latencies of at least `4^(CONFIG_SCHEDSTAT_LATENCY_BUCKETS - 1)`
+ * ticks.
+ */
+#ifndef CONFIG_SCHEDSTAT_LATENCY_BUCKETS
+#define CONFIG_SCHEDSTAT_LATENCY_BUCKETS    (8U)
+#endif
+
+/**
+ * @brief   Version of the binary format written by @ref schedstat_ext_dump
+ */
+#define SCHEDSTAT_EXT_DUMP_VERSION          (1U)
+
+/**
+ * @brief   Extended scheduler statistics of a thread
+ *
+ * All times are in xtimer ticks, except for the IRQ-disabled times, which
+ * are in CPU cycles.
+ */
+typedef struct {
+    /**
+     * @brief   Wakeup to run latency histogram
+     *
+     * @see     CONFIG_SCHEDSTAT_LATENCY_BUCKETS
+     */
+    uint32_t latency[CONFIG_SCHEDSTAT_LATENCY_BUCKETS];
+    uint32_t latency_max;   /**< Longest wakeup to run latency */
+    uint32_t slice_max;     /**< Longest run without a context switch */
+    uint32_t mutex_blocked; /**< Total time blocked on a mutex */
+    uint32_t msg_blocked;   /**< Total time blocked sending, receiving or
+                                 waiting for a reply */
+    uint32_t irq_off;       /**< Total time with interrupts disabled */
+    uint32_t irq_off_max;   /**< Longest time with interrupts disabled */
+} schedstat_ext_t;
+
+/**
+ * @brief   Header of the binary dump written by @ref schedstat_ext_dump
+ */
+typedef struct {
+    uint8_t version;        /**< @ref SCHEDSTAT_EXT_DUMP_VERSION */
+    uint8_t numof;          /**< Number of records following the header */
+    uint8_t buckets;        /**< @ref CONFIG_SCHEDSTAT_LATENCY_BUCKETS */
+    uint8_t record_size;    /**< Size of every record in bytes */
+    uint32_t ticks_hz;      /**< xtimer ticks per second */
+    uint32_t cycles_hz;     /**< CPU cycles per second, 0 if unknown */
+} schedstat_ext_dump_hdr_t;
+
+/**
+ * @brief   Record of a thread in the binary dump
+ */
+typedef struct {
+    kernel_pid_t pid;       /**< The thread's PID */
+    uint16_t reserved;      /**< Unused, 0 */
+    schedstat_t stat;       /**< Basic statistics of the thread */
+    schedstat_ext_t ext;    /**< Extended statistics of the thread */
+} schedstat_ext_dump_rec_t;
+
+/**
+ *  Extended thread statistics table
+ *
+ *  @note   Only available with module `schedstatistics_ext`
+ */
+extern schedstat_ext_t sched_pidlist_ext[KERNEL_PID_LAST + 1];
+
+/**
+ * @brief   Writes the statistics of all running threads in binary form
+ *
+ * The dump consists of a @ref schedstat_ext_dump_hdr_t followed by one
+ * @ref schedstat_ext_dump_rec_t per thread, in native byte order. The
+ * statistics are copied with interrupts disabled for every thread.
+ *
+ * @note    Only available with module `schedstatistics_ext`
+ *
+ * @param[out] buf      Buffer to write to
+ * @param[in] len       Size of @p buf
+ *
+ * @return  Number of bytes written to @p buf
+ * @return  -ENOBUFS if @p buf can not hold the statistics of all threads
+ */
+int schedstat_ext_dump(void *buf, size_t len);
+
+/**
+ * @brief   Resets the extended statistics of all threads
+ *
+ * @note    Only available with module `schedstatistics_ext`
+ */
+void schedstat_ext_reset(void);
+#endif /* MODULE_SCHEDSTATISTICS_EXT */
+
+#if IS_USED(MODULE_SCHEDSTATISTICS_IRQ) || defined(DOXYGEN)
+/**
+ * @brief   Called when interrupts get disabled
+ *
+ * @internal    Called by irq_disable() of the CPU
+ */
+void schedstat_irq_off(void);
+
+/**
+ * @brief   Called when interrupts get enabled again
+ *
+ * @internal    Called by irq_enable() and irq_restore() of the CPU
+ */
+void schedstat_irq_on(void);
+#endif /* MODULE_SCHEDSTATISTICS_IRQ */
+
 /**
  *  @brief  Registers the sched statistics callback and sets laststart for
  *          caller thread
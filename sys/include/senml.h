@@ -0,0 +1,316 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_senml SenML
+ * @ingroup     sys
+ * @brief       SenML (RFC 8428) encoder for @ref phydat_t readings
+ *
+ * Encodes readings straight from @ref phydat_t into SenML packs, as CBOR
+ * with module `senml_cbor` and as compact JSON with module `senml_json`.
+ * Both write into a buffer provided by the caller, e.g. the payload of a
+ * CoAP response, so no intermediate copy is made.
+ *
+ * A pack is started with the base values shared by all records: the base
+ * name, the base time and the base unit. Each record only carries what
+ * differs from them, i.e. the rest of the name, the time relative to the
+ * base time and the unit if it differs from the base unit.
+ *
+ * ```c
+ * senml_cbor_t ctx;
+ * senml_base_t base = { .name = "urn:dev:mac:0024befffe804ff1:" };
+ * senml_phydat_t rec = { .name = "temp", .data = &data, .dim = 1 };
+ *
+ * nanocbor_encoder_init(&enc, pdu->payload, pdu->payload_len);
+ * senml_cbor_start(&ctx, &enc, &base);
+ * senml_cbor_add(&ctx, &rec);
+ * len = senml_cbor_finish(&ctx);
+ * ```
+ *
+ * Values keep the decimal scale of the @ref phydat_t, they are encoded as
+ * CBOR decimal fractions and as JSON numbers with the decimal point placed
+ * accordingly. Values of @ref UNIT_BOOL become boolean values. Units without
+ * a SenML equivalent are converted if only a factor is needed, e.g. grams to
+ * kilograms, or left out otherwise, e.g. for degree Fahrenheit. Readings
+ * with more than one dimension become one record per dimension, with the
+ * index appended to the name, e.g. `acc:0`, `acc:1` and `acc:2`.
+ *
+ * Module `senml_saul` adds all SAUL devices, and with `saul_batch` the
+ * samples buffered by a device, to a pack. Module `senml_coap` serves the
+ * readings of all SAUL devices as SenML CBOR on the CoAP resource `/senml`.
+ *
+ * @{
+ *
+ * @file
+ * @brief       SenML encoder interface
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+
+#ifndef SENML_H
+#define SENML_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "phydat.h"
+#ifdef MODULE_SENML_CBOR
+#include "nanocbor/nanocbor.h"
+#endif
+#ifdef MODULE_SENML_SAUL
+#include "saul_reg.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Maximum length of a record name, without the base name
+ *
+ * Applies to names with an index appended only.
+ */
+#ifndef CONFIG_SENML_NAME_MAX
+#define CONFIG_SENML_NAME_MAX   (32U)
+#endif
+
+/**
+ * @brief   Base values of a pack
+ */
+typedef struct {
+    const char *name;       /**< base name, NULL to omit */
+    int64_t time_ms;        /**< base time in ms since 1970-01-01, 0 to
+                                 omit, i.e. record times are relative to
+                                 the time of reception */
+    uint8_t unit;           /**< base unit, @ref UNIT_UNDEF to omit */
+} senml_base_t;
+
+/**
+ * @brief   A reading to add to a pack
+ */
+typedef struct {
+    const char *name;       /**< name appended to the base name, NULL for
+                                 none */
+    const phydat_t *data;   /**< values, unit and scale */
+    uint8_t dim;            /**< number of values of @p data to add */
+    int32_t time_ms;        /**< time relative to the base time in ms,
+                                 0 to omit */
+} senml_phydat_t;
+
+/**
+ * @brief   A number as mantissa and decimal exponent
+ */
+typedef struct {
+    int64_t m;              /**< mantissa */
+    int8_t e;               /**< decimal exponent */
+} senml_decimal_t;
+
+/**
+ * @brief   Converts a value of a phydat unit to its SenML unit
+ *
+ * @param[in] unit      phydat unit
+ * @param[in,out] val   value to convert
+ *
+ * @return  SenML unit symbol
+ * @return  NULL if there is none, @p val is left as is then
+ */
+const char *senml_unit(uint8_t unit, senml_decimal_t *val);
+
+/**
+ * @brief   Removes trailing zeros of the mantissa
+ *
+ * @param[in,out] val   value to normalize
+ */
+void senml_decimal_normalize(senml_decimal_t *val);
+
+#if IS_USED(MODULE_SENML_CBOR) || defined(DOXYGEN)
+/**
+ * @brief   Context of a SenML CBOR pack being encoded
+ *
+ * @note    Only available with module `senml_cbor`
+ */
+typedef struct {
+    nanocbor_encoder_t *enc;    /**< encoder to write to */
+    const senml_base_t *base;   /**< base values */
+    bool first;                 /**< no record encoded yet */
+} senml_cbor_t;
+
+/**
+ * @brief   Starts a SenML CBOR pack
+ *
+ * @param[out] ctx      context to initialize
+ * @param[in] enc       encoder to write to
+ * @param[in] base      base values, must stay valid until the pack is
+ *                      finished
+ */
+void senml_cbor_start(senml_cbor_t *ctx, nanocbor_encoder_t *enc,
+                      const senml_base_t *base);
+
+/**
+ * @brief   Adds a reading to a SenML CBOR pack
+ *
+ * @param[in,out] ctx   context of the pack
+ * @param[in] rec       reading to add
+ */
+void senml_cbor_add(senml_cbor_t *ctx, const senml_phydat_t *rec);
+
+/**
+ * @brief   Finishes a SenML CBOR pack
+ *
+ * @param[in,out] ctx   context of the pack
+ *
+ * @return  length of the pack, larger than the buffer of the encoder if
+ *          it did not fit
+ */
+size_t senml_cbor_finish(senml_cbor_t *ctx);
+
+/**
+ * @brief   Encodes readings as SenML CBOR pack
+ *
+ * @param[in] enc       encoder to write to
+ * @param[in] base      base values
+ * @param[in] recs      readings
+ * @param[in] numof     number of readings
+ *
+ * @return  length of the pack, larger than the buffer of the encoder if
+ *          it did not fit
+ */
+size_t senml_cbor_encode(nanocbor_encoder_t *enc, const senml_base_t *base,
+                         const senml_phydat_t *recs, unsigned numof);
+#endif /* MODULE_SENML_CBOR */
+
+#if IS_USED(MODULE_SENML_JSON) || defined(DOXYGEN)
+/**
+ * @brief   Context of a SenML JSON pack being encoded
+ *
+ * @note    Only available with module `senml_json`
+ */
+typedef struct {
+    char *buf;                  /**< buffer to write to */
+    size_t size;                /**< size of @p buf */
+    size_t len;                 /**< length of the pack so far */
+    const senml_base_t *base;   /**< base values */
+    bool first;                 /**< no record encoded yet */
+} senml_json_t;
+
+/**
+ * @brief   Starts a SenML JSON pack
+ *
+ * @param[out] ctx      context to initialize
+ * @param[out] buf      buffer to write to
+ * @param[in] size      size of @p buf
+ * @param[in] base      base values, must stay valid until the pack is
+ *                      finished
+ */
+void senml_json_start(senml_json_t *ctx, char *buf, size_t size,
+                      const senml_base_t *base);
+
+/**
+ * @brief   Adds a reading to a SenML JSON pack
+ *
+ * @param[in,out] ctx   context of the pack
+ * @param[in] rec       reading to add
+ */
+void senml_json_add(senml_json_t *ctx, const senml_phydat_t *rec);
+
+/**
+ * @brief   Finishes a SenML JSON pack
+ *
+ * The pack is not zero terminated.
+ *
+ * @param[in,out] ctx   context of the pack
+ *
+ * @return  length of the pack, larger than the buffer if it did not fit
+ */
+size_t senml_json_finish(senml_json_t *ctx);
+
+/**
+ * @brief   Encodes readings as SenML JSON pack
+ *
+ * @param[out] buf      buffer to write to
+ * @param[in] size      size of @p buf
+ * @param[in] base      base values
+ * @param[in] recs      readings
+ * @param[in] numof     number of readings
+ *
+ * @return  length of the pack, larger than @p size if it did not fit
+ */
+size_t senml_json_encode(char *buf, size_t size, const senml_base_t *base,
+                         const senml_phydat_t *recs, unsigned numof);
+#endif /* MODULE_SENML_JSON */
+
+#if IS_USED(MODULE_SENML_SAUL) || defined(DOXYGEN)
+/**
+ * @brief   Reads the next SAUL device
+ *
+ * Devices that fail to read are skipped.
+ *
+ * @note    Only available with module `senml_saul`
+ *
+ * @param[in] dev       device to start at, e.g. @ref saul_reg
+ * @param[out] rec      reading of the device, named by the device
+ * @param[out] data     buffer for the values of the reading
+ *
+ * @return  the device read
+ * @return  NULL if there is none left
+ */
+saul_reg_t *senml_saul_read(saul_reg_t *dev, senml_phydat_t *rec,
+                            phydat_t *data);
+
+#if IS_USED(MODULE_SENML_CBOR) || defined(DOXYGEN)
+/**
+ * @brief   Adds the readings of all SAUL devices to a SenML CBOR pack
+ *
+ * @note    Only available with modules `senml_saul` and `senml_cbor`
+ *
+ * @param[in,out] ctx   context of the pack
+ */
+void senml_saul_cbor(senml_cbor_t *ctx);
+#endif
+
+#if IS_USED(MODULE_SENML_JSON) || defined(DOXYGEN)
+/**
+ * @brief   Adds the readings of all SAUL devices to a SenML JSON pack
+ *
+ * @note    Only available with modules `senml_saul` and `senml_json`
+ *
+ * @param[in,out] ctx   context of the pack
+ */
+void senml_saul_json(senml_json_t *ctx);
+#endif
+
+#if IS_USED(MODULE_SAUL_BATCH) || defined(DOXYGEN)
+/**
+ * @brief   Gets a sample of a batch of samples as reading
+ *
+ * Sets senml_phydat_t::data and senml_phydat_t::time_ms of @p rec, the
+ * name and the number of dimensions must be set by the caller. The time of
+ * the reading is relative to now, so the pack must not have a base time,
+ * or one that was taken right before encoding.
+ *
+ * @note    Only available with modules `senml_saul` and `saul_batch`
+ *
+ * @param[in,out] rec   reading
+ * @param[out] data     buffer for the values of the reading
+ * @param[in] batch     batch read by saul_reg_read_batch()
+ * @param[in] n         number of samples in @p batch
+ * @param[in] i         index of the sample
+ */
+void senml_saul_batch_sample(senml_phydat_t *rec, phydat_t *data,
+                             const saul_batch_t *batch, unsigned n,
+                             unsigned i);
+#endif
+#endif /* MODULE_SENML_SAUL */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SENML_H */
+/** @} */
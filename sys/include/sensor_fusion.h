@@ -0,0 +1,301 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_sensor_fusion Sensor fusion
+ * @ingroup     sys
+ * @brief       Fixed-point orientation filters for IMUs
+ *
+ * Estimates the orientation of an IMU from its gyroscope, accelerometer
+ * and, optionally, magnetometer with the filters of Madgwick or Mahony,
+ * without any floating point operation. This makes estimation at a few
+ * hundred Hz practical on MCUs without FPU.
+ *
+ * Inputs and outputs are Q16.16 numbers of @ref pkg_libfixmath, i.e.
+ * `fix16_t`. Internally, the orientation quaternion has 28 fractional bits,
+ * so that even slow rotations at high update rates are not lost to
+ * rounding.
+ *
+ * ```c
+ * sensor_fusion_t filter;
+ *
+ * sensor_fusion_init(&filter, SENSOR_FUSION_MADGWICK,
+ *                    CONFIG_SENSOR_FUSION_MADGWICK_BETA, 0);
+ * for (;;) {
+ *     ... read gyro in rad/s, acc and mag in any unit ...
+ *     sensor_fusion_update(&filter, gyro, acc, mag, dt_us);
+ * }
+ * sensor_fusion_euler(&filter, &angles);
+ * ```
+ *
+ * With module `sensor_fusion_saul`, the filter is fed by the SAUL devices
+ * of an IMU, reading all samples buffered by the devices with
+ * @ref saul_reg_read_batch(). With module `sensor_fusion_mtd_kv`,
+ * calibrations are stored in a @ref sys_mtd_kv.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Sensor fusion interface
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+
+#ifndef SENSOR_FUSION_H
+#define SENSOR_FUSION_H
+
+#include <stdint.h>
+
+#include "fix16.h"
+#include "kernel_defines.h"
+#ifdef MODULE_SENSOR_FUSION_SAUL
+#include "saul_reg.h"
+#endif
+#ifdef MODULE_SENSOR_FUSION_MTD_KV
+#include "mtd_kv.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Default gain of the Madgwick filter
+ */
+#ifndef CONFIG_SENSOR_FUSION_MADGWICK_BETA
+#define CONFIG_SENSOR_FUSION_MADGWICK_BETA  F16(0.1)
+#endif
+
+/**
+ * @brief   Default proportional gain of the Mahony filter
+ */
+#ifndef CONFIG_SENSOR_FUSION_MAHONY_KP
+#define CONFIG_SENSOR_FUSION_MAHONY_KP      F16(1.0)
+#endif
+
+/**
+ * @brief   Default integral gain of the Mahony filter
+ */
+#ifndef CONFIG_SENSOR_FUSION_MAHONY_KI
+#define CONFIG_SENSOR_FUSION_MAHONY_KI      F16(0.0)
+#endif
+
+/**
+ * @brief   Maximum number of samples per device read at once by
+ *          sensor_fusion_saul_update()
+ */
+#ifndef CONFIG_SENSOR_FUSION_SAUL_BATCH
+#define CONFIG_SENSOR_FUSION_SAUL_BATCH     (8U)
+#endif
+
+/**
+ * @brief   Orientation filters
+ */
+typedef enum {
+    SENSOR_FUSION_MADGWICK,     /**< gradient descent filter by Madgwick */
+    SENSOR_FUSION_MAHONY,       /**< complementary filter by Mahony */
+} sensor_fusion_algo_t;
+
+/**
+ * @brief   Calibration of an IMU
+ *
+ * Biases are subtracted from the readings, the magnetometer readings are
+ * scaled afterwards.
+ */
+typedef struct {
+    fix16_t gyro_bias[3];       /**< gyroscope bias in rad/s */
+    fix16_t acc_bias[3];        /**< accelerometer bias */
+    fix16_t mag_bias[3];        /**< magnetometer bias (hard iron) */
+    fix16_t mag_scale[3];       /**< magnetometer scale per axis (soft
+                                     iron) */
+} sensor_fusion_calib_t;
+
+/**
+ * @brief   Orientation filter state
+ */
+typedef struct {
+    int32_t q[4];                       /**< orientation quaternion w, x, y,
+                                             z with 28 fractional bits */
+    int32_t integral[3];                /**< integral feedback of Mahony in
+                                             rad/s, 28 fractional bits */
+    fix16_t gain;                       /**< beta or proportional gain */
+    fix16_t gain_i;                     /**< integral gain, Mahony only */
+    sensor_fusion_algo_t algo;          /**< filter */
+    const sensor_fusion_calib_t *calib; /**< calibration, may be NULL */
+} sensor_fusion_t;
+
+/**
+ * @brief   Orientation as Euler angles in rad, applied in the order yaw,
+ *          pitch, roll
+ */
+typedef struct {
+    fix16_t roll;               /**< rotation around x */
+    fix16_t pitch;              /**< rotation around y */
+    fix16_t yaw;                /**< rotation around z */
+} sensor_fusion_euler_t;
+
+/**
+ * @brief   Initializes a filter to the identity orientation
+ *
+ * @param[out] filter   filter to initialize
+ * @param[in] algo      filter algorithm
+ * @param[in] gain      beta of Madgwick or the proportional gain of Mahony
+ * @param[in] gain_i    integral gain of Mahony, ignored by Madgwick
+ */
+void sensor_fusion_init(sensor_fusion_t *filter, sensor_fusion_algo_t algo,
+                        fix16_t gain, fix16_t gain_i);
+
+/**
+ * @brief   Sets the calibration applied to all readings
+ *
+ * @param[in,out] filter    filter
+ * @param[in] calib         calibration, must stay valid, NULL for none
+ */
+static inline void sensor_fusion_set_calib(sensor_fusion_t *filter,
+                                           const sensor_fusion_calib_t *calib)
+{
+    filter->calib = calib;
+}
+
+/**
+ * @brief   Updates the orientation by one set of readings
+ *
+ * Accelerometer and magnetometer readings are only used for their direction,
+ * so their unit does not matter. A reading of all zeros is ignored.
+ *
+ * @param[in,out] filter    filter
+ * @param[in] gyro          angular rate in rad/s
+ * @param[in] acc           acceleration
+ * @param[in] mag           magnetic field, NULL without magnetometer
+ * @param[in] dt_us         time since the last update in µs, at most one
+ *                          second is accounted for
+ */
+void sensor_fusion_update(sensor_fusion_t *filter, const fix16_t gyro[3],
+                          const fix16_t acc[3], const fix16_t mag[3],
+                          uint32_t dt_us);
+
+/**
+ * @brief   Gets the orientation as quaternion
+ *
+ * @param[in] filter    filter
+ * @param[out] q        quaternion w, x, y, z
+ */
+void sensor_fusion_quat(const sensor_fusion_t *filter, fix16_t q[4]);
+
+/**
+ * @brief   Gets the orientation as Euler angles
+ *
+ * @param[in] filter    filter
+ * @param[out] euler    angles in rad
+ */
+void sensor_fusion_euler(const sensor_fusion_t *filter,
+                         sensor_fusion_euler_t *euler);
+
+/**
+ * @brief   Initializes a calibration to no correction
+ *
+ * @param[out] calib    calibration
+ */
+void sensor_fusion_calib_init(sensor_fusion_calib_t *calib);
+
+/**
+ * @brief   Sets the gyroscope bias from readings at rest
+ *
+ * @param[in,out] calib calibration
+ * @param[in] gyro      angular rates in rad/s
+ * @param[in] numof     number of readings in @p gyro
+ */
+void sensor_fusion_calib_gyro(sensor_fusion_calib_t *calib,
+                              const fix16_t (*gyro)[3], unsigned numof);
+
+/**
+ * @brief   Sets the magnetometer bias and scale from the extremes seen while
+ *          turning the device in all directions
+ *
+ * @param[in,out] calib calibration
+ * @param[in] min       smallest reading per axis
+ * @param[in] max       largest reading per axis
+ */
+void sensor_fusion_calib_mag(sensor_fusion_calib_t *calib,
+                             const fix16_t min[3], const fix16_t max[3]);
+
+#if IS_USED(MODULE_SENSOR_FUSION_MTD_KV) || defined(DOXYGEN)
+/**
+ * @brief   Loads a calibration from a key-value store
+ *
+ * @note    Only available with module `sensor_fusion_mtd_kv`
+ *
+ * @param[in] kv        store
+ * @param[in] key       key of the calibration
+ * @param[out] calib    calibration
+ *
+ * @return  0 on success
+ * @return  -ENOENT if there is no calibration stored
+ * @return  -EINVAL if the stored value is no calibration
+ * @return  <0 on MTD error
+ */
+int sensor_fusion_calib_load(mtd_kv_t *kv, const char *key,
+                             sensor_fusion_calib_t *calib);
+
+/**
+ * @brief   Stores a calibration in a key-value store
+ *
+ * @note    Only available with module `sensor_fusion_mtd_kv`
+ *
+ * @param[in] kv        store
+ * @param[in] key       key of the calibration
+ * @param[in] calib     calibration
+ *
+ * @return  0 on success
+ * @return  <0 on error, see @ref mtd_kv_set()
+ */
+int sensor_fusion_calib_save(mtd_kv_t *kv, const char *key,
+                             const sensor_fusion_calib_t *calib);
+#endif
+
+#if IS_USED(MODULE_SENSOR_FUSION_SAUL) || defined(DOXYGEN)
+/**
+ * @brief   SAUL devices of an IMU
+ *
+ * @note    Only available with module `sensor_fusion_saul`
+ */
+typedef struct {
+    saul_reg_t *gyro;           /**< gyroscope */
+    saul_reg_t *acc;            /**< accelerometer */
+    saul_reg_t *mag;            /**< magnetometer, NULL for none */
+    uint32_t last;              /**< `ZTIMER_USEC` time of the last sample
+                                     fused, internal */
+} sensor_fusion_saul_t;
+
+/**
+ * @brief   Updates the orientation by all samples buffered by the devices
+ *
+ * Samples of the devices are paired from the newest on, surplus older
+ * samples of a device are dropped. The gyroscope must read in
+ * @ref UNIT_DPS.
+ *
+ * @note    Only available with module `sensor_fusion_saul`
+ *
+ * @param[in,out] filter    filter
+ * @param[in,out] imu       devices to read, sensor_fusion_saul_t::last
+ *                          must be 0 on the first call
+ *
+ * @return  number of samples fused
+ * @return  <0 on device errors, see @ref saul_reg_read_batch()
+ * @return  -EINVAL if the gyroscope does not read in @ref UNIT_DPS
+ */
+int sensor_fusion_saul_update(sensor_fusion_t *filter,
+                              sensor_fusion_saul_t *imu);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SENSOR_FUSION_H */
+/** @} */
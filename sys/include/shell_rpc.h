@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_shell_rpc Binary shell RPC
+ * @ingroup     sys_shell
+ * @brief       CBOR encoded remote procedure calls over the shell's stdio
+ *
+ * With the `shell_rpc` module, the shell also accepts binary request frames
+ * in place of a text line. Handlers decode their arguments and encode their
+ * result with nanocbor instead of parsing `argv` and printing text, which
+ * saves transfer time and host side parsing for bulk queries.
+ *
+ * A frame is only recognized at the start of a line and is not echoed:
+ *
+ *     0xc0 | length (2 bytes, big endian) | CBOR | CRC (2 bytes, big endian)
+ *
+ * The CRC is the CRC-16-CCITT (@ref crc16_ccitt_calc) of the length and the
+ * CBOR data. A request is the CBOR array `[id, name, args]`, with `id` an
+ * unsigned integer chosen by the host, `name` the command as text string and
+ * `args` a single data item (`null` if there are no arguments). The response
+ * uses the same framing, its payload is `[id, status, result]` with `status`
+ * 0 or a negative errno value and `result` the data item written by the
+ * handler (`null` on error). Corrupted requests are answered with `id` being
+ * `null` and status `-EBADMSG`. See `dist/tools/shell_rpc` for a client.
+ *
+ * Built-in commands:
+ * - `help`: array of all command names
+ * - `threads`: array of `[pid, name, state, priority, stack size, stack
+ *   free]` per thread, `state` being a `thread_status_t`, name and stack
+ *   information only with `DEVELHELP` (`null` otherwise)
+ * - `nib_nc` (with `gnrc_ipv6_nib`): array of `[IPv6 address,
+ *   link-layer address, info]` per neighbor cache entry, `args` is the
+ *   interface (0 or `null` for all)
+ * - `metrics` (with `metrics_cbor`): all metrics, see @ref metrics_cbor
+ *
+ * @{
+ *
+ * @file
+ * @brief       Binary shell RPC interface
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+
+#ifndef SHELL_RPC_H
+#define SHELL_RPC_H
+
+#include "nanocbor/nanocbor.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   First byte of a frame, never part of UTF-8 text
+ */
+#define SHELL_RPC_FRAME_START   (0xc0)
+
+/**
+ * @brief   Maximum size of the CBOR data of a request or a response
+ */
+#ifndef SHELL_RPC_BUFSIZE
+#define SHELL_RPC_BUFSIZE       (512U)
+#endif
+
+/**
+ * @brief   Prototype of an RPC handler
+ *
+ * @param[in]   args    decoder positioned at the single argument item
+ * @param[out]  res     encoder to write exactly one result item to
+ *
+ * @return  0 on success
+ * @return  negative errno value on error, the result is then discarded
+ */
+typedef int (*shell_rpc_handler_t)(nanocbor_value_t *args,
+                                   nanocbor_encoder_t *res);
+
+/**
+ * @brief   RPC command
+ */
+typedef struct {
+    const char *name;               /**< name of the command */
+    shell_rpc_handler_t handler;    /**< handler of the command */
+} shell_rpc_command_t;
+
+/**
+ * @brief   Set the application specific RPC commands
+ *
+ * They take precedence over the built-in commands of the same name.
+ *
+ * @param[in]   commands    list of commands, terminated by an entry with
+ *                          `name == NULL`
+ */
+void shell_rpc_set_commands(const shell_rpc_command_t *commands);
+
+/**
+ * @brief   Read the rest of a request frame from stdin, handle it and write
+ *          the response to stdout
+ *
+ * @internal    Called by the shell after reading @ref SHELL_RPC_FRAME_START
+ *
+ * @return  0 on success
+ * @return  EOF if stdin was closed
+ */
+int shell_rpc_handle(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SHELL_RPC_H */
+/** @} */
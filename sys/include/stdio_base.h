@@ -56,6 +56,15 @@ ssize_t stdio_read(void* buffer, size_t max_len);
  */
 ssize_t stdio_write(const void* buffer, size_t len);
 
+/**
+ * @brief get the number of bytes that can be read without blocking
+ *
+ * @note    Only implemented by `stdio_uart` with `stdio_uart_rx`
+ *
+ * @return nr of bytes available
+ */
+int stdio_available(void);
+
 #ifdef __cplusplus
 }
 #endif
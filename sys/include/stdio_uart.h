@@ -47,6 +47,14 @@
  *    low power scenarios being covered by RIOT. Thus, be prepared to
  *    loose output when using STDIO from ISR.
  *
+ * With the `stdio_uart_tx_async` module, `stdio_write()` only copies the
+ * output into a buffer of @ref STDIO_UART_TX_BUFSIZE bytes, which is sent in
+ * the background using `uart_write_async()`, so threads no longer wait for
+ * the UART. If the buffer is full, the caller waits for room, unless
+ * @ref CONFIG_STDIO_UART_TX_DROP is set. Output from interrupt context
+ * bypasses the buffer. If the UART has no DMA for TX (no `periph_uart_dma`
+ * or no DMA stream configured), `uart_write()` is used as usual.
+ *
  * @{
  * @file
  *
@@ -86,6 +94,30 @@ extern "C" {
 #define STDIO_UART_RX_BUFSIZE   (64)
 #endif
 
+#ifndef STDIO_UART_RX_DMA_BUFSIZE
+/**
+ * @brief Size of the circular DMA buffer, used with `periph_uart_dma`
+ */
+#define STDIO_UART_RX_DMA_BUFSIZE   (32)
+#endif
+
+#ifndef STDIO_UART_TX_BUFSIZE
+/**
+ * @brief Size of the transmit buffer, used with `stdio_uart_tx_async`
+ *
+ * @note  Must be a power of two
+ */
+#define STDIO_UART_TX_BUFSIZE   (256)
+#endif
+
+#ifndef CONFIG_STDIO_UART_TX_DROP
+/**
+ * @brief Drop output that does not fit into the transmit buffer instead of
+ *        waiting for room, used with `stdio_uart_tx_async`
+ */
+#define CONFIG_STDIO_UART_TX_DROP   0
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -34,6 +34,7 @@
 #include <stdint.h>
 
 #include "cose/sign.h"
+#include "hashes/sha256.h"
 #include "nanocbor/nanocbor.h"
 #include "uuid.h"
 #include "riotboot/flashwrite.h"
@@ -85,6 +86,8 @@ typedef enum {
                                          current sequence number */
     SUIT_ERR_SIGNATURE        = -6, /**< Unable to verify signature */
     SUIT_ERR_DIGEST_MISMATCH  = -7, /**< Digest mismatch with COSE and SUIT */
+    SUIT_ERR_NO_MEMORY        = -8, /**< Manifest does not fit into the
+                                         buffer */
 } suit_error_t;
 
 /**
@@ -125,6 +128,23 @@ enum {
     SUIT_COMPONENT_DIGEST       = 3,    /**< Digest component */
 };
 
+/**
+ * @brief SUIT payload compression algorithms
+ *
+ * Unofficial list from
+ * [suit-manifest-generator](https://github.com/ARMmbed/suit-manifest-generator),
+ * heatshrink uses a private value
+ */
+typedef enum {
+    SUIT_COMPRESSION_NONE       = 0,    /**< Uncompressed payload */
+    SUIT_COMPRESSION_GZIP       = 1,    /**< gzip */
+    SUIT_COMPRESSION_BZIP2      = 2,    /**< bzip2 */
+    SUIT_COMPRESSION_DEFLATE    = 3,    /**< deflate */
+    SUIT_COMPRESSION_LZ4        = 4,    /**< LZ4 */
+    SUIT_COMPRESSION_LZMA       = 7,    /**< LZMA */
+    SUIT_COMPRESSION_HEATSHRINK = -1,   /**< heatshrink */
+} suit_compression_t;
+
 /**
  * @brief SUIT component struct
  */
@@ -133,6 +153,8 @@ typedef struct {
     nanocbor_value_t identifier;        /**< Identifier */
     nanocbor_value_t url;               /**< Url */
     nanocbor_value_t digest;            /**< Digest */
+    int32_t compression;                /**< Payload compression, see
+                                             @ref suit_compression_t */
 } suit_component_t;
 
 /**
@@ -180,6 +202,96 @@ typedef struct {
  */
 int suit_parse(suit_manifest_t *manifest, const uint8_t *buf, size_t len);
 
+/**
+ * @brief Streaming manifest parser context
+ *
+ * The fields are internal, see @ref suit_stream_init()
+ */
+typedef struct {
+    suit_manifest_t *manifest;      /**< manifest context */
+    uint8_t *buf;                   /**< buffer for the retained parts */
+    size_t size;                    /**< size of @p buf */
+    size_t len;                     /**< bytes used in @p buf */
+    size_t offset;                  /**< bytes fed so far */
+    size_t map_start;               /**< offset of the manifest map in @p buf */
+    sha256_context_t sha;           /**< digest of the manifest */
+    uint32_t remaining;             /**< bytes of the manifest left */
+    uint32_t body;                  /**< bytes of the current item left */
+    uint32_t entries;               /**< manifest map entries left */
+    uint32_t kept;                  /**< manifest map entries retained */
+    int res;                        /**< first error */
+    uint8_t state;                  /**< parser state */
+    uint8_t keep;                   /**< current entry is retained */
+    uint8_t head_len;               /**< bytes in @p head */
+    uint8_t head[5];                /**< CBOR head being collected */
+} suit_stream_t;
+
+/**
+ * @brief Prepare parsing a manifest that arrives in pieces
+ *
+ * Unlike @ref suit_parse(), the streaming parser does not need the whole
+ * manifest in RAM. The authentication wrapper is kept in @p buf and its
+ * signature is checked as soon as it is complete. The manifest itself is
+ * hashed on the fly, only the sections needed to run it are appended to
+ * @p buf, the text section is dropped. Once all data is fed, the digest is
+ * compared with the signed one and only then the retained sections are
+ * processed.
+ *
+ * The top level values of the manifest must be integers or byte or text
+ * strings, which is all the specification defines.
+ *
+ * @note The buffer is still required after parsing, please don't reuse the
+ * buffer while the @p manifest is used
+ *
+ * @param[out]  stream      parser context
+ * @param[in]   manifest    manifest context to store information in
+ * @param[in]   buf         buffer for the retained parts of the manifest
+ * @param[in]   size        size of @p buf
+ */
+void suit_stream_init(suit_stream_t *stream, suit_manifest_t *manifest,
+                      uint8_t *buf, size_t size);
+
+/**
+ * @brief Feed the next piece of a manifest
+ *
+ * @param[in]   stream      parser context
+ * @param[in]   data        manifest data following the previous piece
+ * @param[in]   len         length of @p data
+ *
+ * @return                  SUIT_OK if the data was accepted
+ * @return                  negative @ref suit_error_t code on error, all
+ *                          further calls fail with the same code
+ */
+int suit_stream_feed(suit_stream_t *stream, const uint8_t *data, size_t len);
+
+/**
+ * @brief Verify the digest of a completely fed manifest and process it
+ *
+ * @param[in]   stream      parser context
+ *
+ * @return                  SUIT_OK on parseable manifest
+ * @return                  negative @ref suit_error_t code on error
+ */
+int suit_stream_finish(suit_stream_t *stream);
+
+/**
+ * @brief Block transfer callback feeding a manifest to a streaming parser
+ *
+ * Can be passed to e.g. @ref suit_coap_get_blockwise_url() with the parser
+ * context as @p arg. Repeated blocks are ignored.
+ *
+ * @param[in]   arg     ptr to the @ref suit_stream_t
+ * @param[in]   offset  offset of @p buf in the manifest
+ * @param[in]   buf     manifest data
+ * @param[in]   len     length of @p buf
+ * @param[in]   more    whether more data is coming
+ *
+ * @return              0 on success
+ * @return              <0 on error
+ */
+int suit_stream_helper(void *arg, size_t offset, uint8_t *buf, size_t len,
+                       int more);
+
 /**
  * @brief Check a manifest policy
  *
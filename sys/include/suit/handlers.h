@@ -193,6 +193,20 @@ int suit_handle_manifest_structure_bstr(suit_manifest_t *manifest,
                                         const suit_manifest_handler_t *handlers,
                                         size_t handlers_len);
 
+/**
+ * @brief Compare the digest of the manifest with the authenticated COSE payload
+ *
+ * @param   manifest        SUIT manifest context, the COSE signature must be
+ *                          verified already
+ * @param   digest          SHA-256 digest of the CBOR encoded manifest
+ *
+ * @returns     SUIT_OK if the manifest is authentic
+ * @returns     SUIT_ERR_SIGNATURE if the signature was not verified
+ * @returns     SUIT_ERR_DIGEST_MISMATCH if the digests differ
+ */
+int suit_verify_manifest_digest(suit_manifest_t *manifest,
+                                const uint8_t *digest);
+
 #ifdef __cplusplus
 }
 #endif
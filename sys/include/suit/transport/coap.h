@@ -121,6 +121,25 @@ typedef enum {
     COAP_BLOCKSIZE_1024,
 } coap_blksize_t;
 
+/**
+ * @brief   Number of block requests kept in flight during a block-wise fetch
+ *
+ * Every request needs a buffer of the block size on the stack of the
+ * fetching thread.
+ */
+#ifndef CONFIG_SUIT_COAP_WINDOW
+#define CONFIG_SUIT_COAP_WINDOW     (4U)
+#endif
+
+/**
+ * @brief   Largest block size used to fetch the firmware image
+ *
+ * Smaller blocks are requested when retransmissions are needed.
+ */
+#ifndef CONFIG_SUIT_COAP_BLOCKSIZE
+#define CONFIG_SUIT_COAP_BLOCKSIZE  COAP_BLOCKSIZE_64
+#endif
+
 /**
  * @brief    Performs a blockwise coap get request to the specified url.
  *
@@ -128,6 +147,11 @@ typedef enum {
  * block-wise-transfer. A coap_blockwise_cb_t will be called on each received
  * block.
  *
+ * Up to @ref CONFIG_SUIT_COAP_WINDOW blocks are requested ahead, so the
+ * responses arrive while the callback processes the previous block. The
+ * callback is still invoked in order. The block size is reduced when
+ * retransmissions are needed and raised again up to @p blksize.
+ *
  * @param[in]   url        url pointer to source path
  * @param[in]   blksize    sender suggested SZX for the COAP block request
  * @param[in]   callback   callback to be executed on each received block
@@ -26,10 +26,42 @@
  * The trace buffer works like a ring-buffer. If it is full, it will start
  * overwriting from the beginning.
  *
- * Tracing is made thread safe by disabling interrupts for critical sections.
- *
- * It does incur some overhead (at least a function call, getting the current
- * time, a pair of enable/disable interrupts and a couple of memory accesses).
+ * Entries are timestamped with the DWT cycle counter where available
+ * (Cortex-M3 and up, see @ref TRACE_UNIT) and with `xtimer_now_usec()`
+ * otherwise. On CPUs with atomic compare-and-swap instructions, a slot of the
+ * buffer is claimed with an atomic increment and interrupts stay enabled.
+ * Entries written concurrently by a thread and an ISR may then end up slightly
+ * out of order, and an entry written while `trace_dump()` runs may be printed
+ * half-updated. Other CPUs disable interrupts for the critical section.
+ *
+ * It does incur some overhead (a function call, reading the time source, an
+ * atomic increment or a pair of disable/enable interrupts and a couple of
+ * memory accesses).
+ *
+ * ## Predefined events
+ *
+ * Values with one of the @ref trace_event_type_t types in the upper byte are
+ * reserved for predefined events, see @ref TRACE_EVENT(). With the
+ * `trace_events` module, the scheduler traces thread switches, `core_msg`
+ * traces sent and received messages and @ref net_gnrc_netif traces sent and
+ * received packets. ISR entry and exit have no generic hook and are traced
+ * by platform code with @ref trace_event().
+ *
+ * ## Binary dump
+ *
+ * `trace_dump_bin()` emits the buffer in a compact binary encoding through a
+ * user supplied callback, e.g. to a UART or as hex dump. The format is
+ *
+ * | field          | encoding                                          |
+ * |:---------------|:--------------------------------------------------|
+ * | magic          | `"RTRC"`                                          |
+ * | version        | `uint8_t`, @ref TRACE_BIN_VERSION                 |
+ * | ticks/second   | `uint32_t` little endian, 0 if unknown            |
+ * | entries        | zigzag LEB128 of the signed time delta to the     |
+ * |                | previous entry, followed by LEB128 of the value   |
+ *
+ * `dist/tools/trace/trace2json.py` decodes such a dump into the Chrome trace
+ * event format, which can be viewed with Perfetto or `chrome://tracing`.
  *
  * Example:
  *
@@ -53,17 +85,70 @@
 #ifndef TRACE_H
 #define TRACE_H
 
+#include <stddef.h>
 #include <stdint.h>
 
+#include "cpu.h"
+#include "kernel_defines.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#if defined(DWT_CTRL_CYCCNTENA_Msk) || defined(DOXYGEN)
+/**
+ * @brief   Unit of the trace timestamps
+ */
+#define TRACE_UNIT          "cycles"
+#else
+#define TRACE_UNIT          "us"
+#endif
+
+/**
+ * @brief   Version of the format written by trace_dump_bin()
+ */
+#define TRACE_BIN_VERSION   (1U)
+
+/**
+ * @brief   Types of the predefined events
+ */
+typedef enum {
+    TRACE_EV_SCHED = 0xf0,      /**< thread switch, argument is the PID of
+                                 *   the next thread */
+    TRACE_EV_ISR_ENTER,         /**< ISR entry, argument is the IRQ number */
+    TRACE_EV_ISR_EXIT,          /**< ISR exit, argument is the IRQ number */
+    TRACE_EV_MSG_SEND,          /**< message sent, argument is the PID of
+                                 *   the receiver */
+    TRACE_EV_MSG_RECV,          /**< message received, argument is the type
+                                 *   of the message */
+    TRACE_EV_NETIF_TX,          /**< packet sent, argument is the PID of the
+                                 *   interface */
+    TRACE_EV_NETIF_RX,          /**< packet received, argument is the PID of
+                                 *   the interface */
+} trace_event_type_t;
+
+/**
+ * @brief   Trace value of a predefined event
+ *
+ * @param[in]   type    event type, see @ref trace_event_type_t
+ * @param[in]   arg     event argument, truncated to 24 bit
+ */
+#define TRACE_EVENT(type, arg) \
+    (((uint32_t)(type) << 24) | ((uint32_t)(arg) & 0xffffff))
+
+/**
+ * @brief   Callback of trace_dump_bin()
+ *
+ * @param[in]   data    encoded data
+ * @param[in]   len     length of @p data
+ * @param[in]   arg     argument passed to trace_dump_bin()
+ */
+typedef void (*trace_write_t)(const void *data, size_t len, void *arg);
+
 /**
  * @brief   Add entry to trace buffer
  *
- * Adds the current time (e.g., xtimer_now_usec()) and @p val to the trace
- * buffer.
+ * Adds the current time in @ref TRACE_UNIT and @p val to the trace buffer.
  *
  * The value parameter is not used by the trace module itself. The caller is
  * supposed to provide a meaningful value.
@@ -73,6 +158,22 @@ extern "C" {
  */
 void trace(uint32_t val);
 
+/**
+ * @brief   Add a predefined event to the trace buffer
+ *
+ * Does nothing unless the `trace_events` module is used, so that hooks can be
+ * placed in code that is built without the trace module.
+ *
+ * @param[in]   type    event type
+ * @param[in]   arg     event argument, truncated to 24 bit
+ */
+static inline void trace_event(trace_event_type_t type, uint32_t arg)
+{
+    if (IS_USED(MODULE_TRACE_EVENTS)) {
+        trace(TRACE_EVENT(type, arg));
+    }
+}
+
 /**
  * @brief   Print the current trace buffer
  *
@@ -87,8 +188,28 @@ void trace(uint32_t val);
  */
 void trace_dump(void);
 
+/**
+ * @brief   Write the trace buffer in the binary format
+ *
+ * The entries are passed to @p write one by one in the order they were
+ * recorded, preceded by the header.
+ *
+ * @param[in]   write   callback receiving the encoded data
+ * @param[in]   arg     argument passed to @p write
+ */
+void trace_dump_bin(trace_write_t write, void *arg);
+
+/**
+ * @brief   Prepare the time source
+ *
+ * Called by auto_init, starts the cycle counter where it is used.
+ */
+void trace_init(void);
+
 /**
  * @brief   Empty the trace buffer
+ *
+ * Must not be called while entries are added.
  */
 void trace_reset(void);
 
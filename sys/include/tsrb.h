@@ -128,6 +128,22 @@ int tsrb_get_one(tsrb_t *rb);
  */
 int tsrb_get(tsrb_t *rb, uint8_t *dst, size_t n);
 
+/**
+ * @brief       Get the contiguous readable region of the ringbuffer
+ *
+ * Gives direct access to the oldest bytes without copying them. Once the
+ * data is processed, release it with @ref tsrb_drop(). Only the consumer
+ * may call this.
+ *
+ * If the readable data wraps around the end of the buffer, only the part
+ * up to the end is returned; call again after dropping it to get the rest.
+ *
+ * @param[in]   rb      Ringbuffer to operate on
+ * @param[out]  data    start of the readable region
+ * @return      nr of bytes readable at @p data, 0 if empty
+ */
+unsigned tsrb_peek_contig(const tsrb_t *rb, uint8_t **data);
+
 /**
  * @brief       Drop bytes from ringbuffer
  * @param[in]   rb  Ringbuffer to operate on
@@ -154,6 +170,33 @@ int tsrb_add_one(tsrb_t *rb, uint8_t c);
  */
 int tsrb_add(tsrb_t *rb, const uint8_t *src, size_t n);
 
+/**
+ * @brief       Get the contiguous writable region of the ringbuffer
+ *
+ * Allows the producer (e.g. a DMA transfer) to write directly into the
+ * ringbuffer. The written bytes become visible to the consumer only after
+ * calling @ref tsrb_commit(). Only the producer may call this.
+ *
+ * If the free space wraps around the end of the buffer, only the part up to
+ * the end is returned; call again after committing to get the rest.
+ *
+ * @param[in]   rb      Ringbuffer to operate on
+ * @param[out]  data    start of the writable region
+ * @return      nr of bytes writable at @p data, 0 if full
+ */
+unsigned tsrb_reserve_contig(const tsrb_t *rb, uint8_t **data);
+
+/**
+ * @brief       Publish bytes written into a region from
+ *              @ref tsrb_reserve_contig()
+ *
+ * @pre         @p n does not exceed the size of the reserved region
+ *
+ * @param[in]   rb  Ringbuffer to operate on
+ * @param[in]   n   nr of bytes written
+ */
+void tsrb_commit(tsrb_t *rb, size_t n);
+
 #ifdef __cplusplus
 }
 #endif
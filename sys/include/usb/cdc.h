@@ -72,6 +72,14 @@ extern "C" {
 #define USB_CDC_PROTOCOL_VENDOR        0xFF /**< Vendor-specific */
 /** @} */
 
+/**
+ * @name USB CDC data interface protocol types
+ * @{
+ */
+#define USB_CDC_DATA_PROTOCOL_NONE     0x00 /**< No protocol required */
+#define USB_CDC_DATA_PROTOCOL_NTB      0x01 /**< Network Transfer Block */
+/** @} */
+
 /**
  * @name USB CDC descriptor subtypes
  */
@@ -83,6 +91,7 @@ extern "C" {
                                                       management descriptor */
 #define USB_CDC_DESCR_SUBTYPE_UNION         0x06 /**< Union descriptor */
 #define USB_CDC_DESCR_SUBTYPE_ETH_NET       0x0f /**< Ethernet descriptor */
+#define USB_CDC_DESCR_SUBTYPE_NCM           0x1a /**< NCM descriptor */
 /** @} */
 
 /**
@@ -129,6 +138,21 @@ extern "C" {
  * @brief Get ethernet statistics
  */
 #define USB_CDC_MGNT_REQUEST_GET_ETH_STATISTICS         0x44
+
+/**
+ * @brief Get the NTB parameters of a NCM function
+ */
+#define USB_CDC_MGNT_REQUEST_GET_NTB_PARAMETERS         0x80
+
+/**
+ * @brief Get the maximum size of IN NTBs of a NCM function
+ */
+#define USB_CDC_MGNT_REQUEST_GET_NTB_INPUT_SIZE         0x85
+
+/**
+ * @brief Set the maximum size of IN NTBs of a NCM function
+ */
+#define USB_CDC_MGNT_REQUEST_SET_NTB_INPUT_SIZE         0x86
 /** @} */
 
 /**
@@ -210,6 +234,99 @@ typedef struct __attribute__((packed)) {
     uint8_t numberpowerfilters;     /**< Number of pattern filters for host wake-up */
 } usb_desc_ecm_t;
 
+/**
+ * @name USB CDC NCM network capabilities
+ * @{
+ */
+#define USB_CDC_NCM_CAP_ETH_FILTER      0x01 /**< SetEthernetPacketFilter */
+#define USB_CDC_NCM_CAP_NET_ADDRESS     0x02 /**< Get/SetNetAddress */
+#define USB_CDC_NCM_CAP_ENCAP_COMMAND   0x04 /**< Encapsulated commands */
+#define USB_CDC_NCM_CAP_MAX_DATAGRAM    0x08 /**< Get/SetMaxDatagramSize */
+#define USB_CDC_NCM_CAP_CRC_MODE        0x10 /**< Get/SetCrcMode */
+#define USB_CDC_NCM_CAP_NTB_INPUT_SIZE8 0x20 /**< 8 byte Get/SetNtbInputSize */
+/** @} */
+
+/**
+ * @name USB CDC NCM NTB signatures
+ * @{
+ */
+#define USB_CDC_NCM_NTH16_SIGNATURE     0x484D434EUL /**< "NCMH" */
+#define USB_CDC_NCM_NDP16_SIGNATURE     0x304D434EUL /**< "NCM0", without CRC */
+/** @} */
+
+/**
+ * @brief USB CDC NCM version in bcd
+ */
+#define USB_CDC_NCM_VERSION_BCD         0x0100
+
+/**
+ * @brief USB CDC NCM functional descriptor
+ *
+ * @see USB CDC NCM 1.0 spec table 5-2
+ */
+typedef struct __attribute__((packed)) {
+    uint8_t length;         /**< Size of this descriptor */
+    uint8_t type;           /**< Descriptor type (@ref USB_TYPE_DESCRIPTOR_CDC) */
+    uint8_t subtype;        /**< Descriptor subtype (@ref USB_CDC_DESCR_SUBTYPE_NCM) */
+    uint16_t bcd_ncm;       /**< NCM release number in bcd (@ref USB_CDC_NCM_VERSION_BCD) */
+    uint8_t capabilities;   /**< Bitmap of the network capabilities */
+} usb_desc_ncm_t;
+
+/**
+ * @brief USB CDC NCM NTB parameter structure
+ *
+ * @see USB CDC NCM 1.0 spec table 6-3
+ */
+typedef struct __attribute__((packed)) {
+    uint16_t length;                /**< Size of this structure */
+    uint16_t formats;               /**< Bitmap of the supported NTB formats */
+    uint32_t in_max_size;           /**< Maximum size of IN NTBs */
+    uint16_t in_divisor;            /**< Divisor for IN datagram alignment */
+    uint16_t in_remainder;          /**< Remainder for IN datagram alignment */
+    uint16_t in_alignment;          /**< Alignment of NDPs in IN NTBs */
+    uint16_t reserved;              /**< Reserved, 0 */
+    uint32_t out_max_size;          /**< Maximum size of OUT NTBs */
+    uint16_t out_divisor;           /**< Divisor for OUT datagram alignment */
+    uint16_t out_remainder;         /**< Remainder for OUT datagram alignment */
+    uint16_t out_alignment;         /**< Alignment of NDPs in OUT NTBs */
+    uint16_t out_max_datagrams;     /**< Maximum datagrams per OUT NTB, 0 for
+                                         no limit */
+} usb_cdc_ncm_ntb_params_t;
+
+/**
+ * @brief USB CDC NCM 16 bit NTB header
+ *
+ * @see USB CDC NCM 1.0 spec table 3-1
+ */
+typedef struct __attribute__((packed)) {
+    uint32_t signature;     /**< @ref USB_CDC_NCM_NTH16_SIGNATURE */
+    uint16_t header_length; /**< Size of this header */
+    uint16_t sequence;      /**< Sequence number of the NTB */
+    uint16_t block_length;  /**< Size of the NTB */
+    uint16_t ndp_index;     /**< Offset of the first NDP */
+} usb_cdc_ncm_nth16_t;
+
+/**
+ * @brief USB CDC NCM 16 bit datagram pointer table, followed by the
+ *        datagram pointers
+ *
+ * @see USB CDC NCM 1.0 spec table 3-3
+ */
+typedef struct __attribute__((packed)) {
+    uint32_t signature;     /**< @ref USB_CDC_NCM_NDP16_SIGNATURE */
+    uint16_t length;        /**< Size of the table including the pointers */
+    uint16_t next_index;    /**< Offset of the next NDP, 0 for none */
+} usb_cdc_ncm_ndp16_t;
+
+/**
+ * @brief USB CDC NCM 16 bit datagram pointer, a pointer with zero index
+ *        and length terminates the table
+ */
+typedef struct __attribute__((packed)) {
+    uint16_t index;         /**< Offset of the datagram */
+    uint16_t length;        /**< Size of the datagram */
+} usb_cdc_ncm_dpe16_t;
+
 /**
  * @brief USB CDC ACM descriptor
  *
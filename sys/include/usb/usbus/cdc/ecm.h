@@ -22,8 +22,10 @@
 #ifndef USB_USBUS_CDC_ECM_H
 #define USB_USBUS_CDC_ECM_H
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include "kernel_defines.h"
 #include "net/ethernet.h"
 #include "net/ethernet/hdr.h"
 #include "usb/descriptor.h"
@@ -61,6 +63,19 @@ extern "C" {
 #define CONFIG_USBUS_CDC_ECM_CONFIG_SPEED_UPSTREAM   CONFIG_USBUS_CDC_ECM_CONFIG_SPEED
 #endif
 
+/**
+ * @brief Disable multi-packet transfers of whole frames
+ *
+ * By default, frames are transferred with a single multi-packet transfer
+ * straight from and to the frame buffers, if the usbdev driver supports
+ * @ref usbdev_ep_xfer. Otherwise, or if this is set, every packet of
+ * @ref USBUS_CDCECM_EP_DATA_SIZE bytes is passed through the endpoint
+ * buffer, which also saves the transmit frame buffer.
+ */
+#ifdef DOXYGEN
+#define CONFIG_USBUS_CDC_ECM_NO_MULTI_PACKET
+#endif
+
 /**
  * @brief CDC ECM interrupt endpoint size.
  *
@@ -77,6 +92,13 @@ extern "C" {
  */
 #define USBUS_CDCECM_EP_DATA_SIZE  64
 
+/**
+ * @brief Size of the frame buffers, a multiple of the data endpoint size
+ */
+#define USBUS_CDCECM_FRAME_BUF_SIZE \
+    (((ETHERNET_FRAME_LEN + USBUS_CDCECM_EP_DATA_SIZE - 1) / \
+      USBUS_CDCECM_EP_DATA_SIZE) * USBUS_CDCECM_EP_DATA_SIZE)
+
 /**
  * @brief notification state, used to track which information must be send to
  * the host
@@ -108,10 +130,16 @@ typedef struct usbus_cdcecm_device {
     usbus_t *usbus;                         /**< Ptr to the USBUS context */
     mutex_t out_lock;           /**< mutex used for locking netif/USBUS send */
     size_t tx_len;              /**< Length of the current tx frame */
-    uint8_t in_buf[ETHERNET_FRAME_LEN]; /**< Buffer for the received frames */
+    /** Buffer for the received frames */
+    uint8_t in_buf[USBUS_CDCECM_FRAME_BUF_SIZE] __attribute__((aligned(4)));
+#if !IS_ACTIVE(CONFIG_USBUS_CDC_ECM_NO_MULTI_PACKET) || defined(DOXYGEN)
+    /** Buffer for the frame to transmit in a multi-packet transfer */
+    uint8_t out_buf[USBUS_CDCECM_FRAME_BUF_SIZE] __attribute__((aligned(4)));
+#endif
     size_t len;                             /**< Length of the current rx frame */
     usbus_cdcecm_notif_t notif;    /**< Startup message notification tracker */
     unsigned active_iface;          /**< Current active data interface */
+    bool multi_packet;          /**< Frames use multi-packet transfers */
 } usbus_cdcecm_device_t;
 
 /**
@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for
+ * more details.
+ */
+
+/**
+ * @defgroup    usbus_cdc_ncm USBUS CDC NCM - USBUS CDC network control model
+ * @ingroup     usb
+ * @brief       USBUS CDC NCM interface module
+ *
+ * Unlike @ref usbus_cdc_ecm, which transfers a single Ethernet frame per USB
+ * transfer, NCM aggregates several frames into a Network Transfer Block
+ * (NTB) in both directions. This cuts the number of transfers, and so of
+ * interrupts, under load.
+ *
+ * Frames are passed to the network stack through a netdev with the same
+ * Ethernet interface as the CDC ECM one. All frames of a received NTB are
+ * handed to the stack in a single netdev event. Frames to transmit are
+ * collected in one of two IN NTBs. One NTB is sent while the next is
+ * filled. A frame sent while the USB bus is idle goes out right away in an
+ * NTB of its own.
+ *
+ * Only 16 bit NTBs without CRC are supported.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Interface and definitions for USB CDC NCM type interfaces
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+
+#ifndef USB_USBUS_CDC_NCM_H
+#define USB_USBUS_CDC_NCM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "net/ethernet.h"
+#include "net/ethernet/hdr.h"
+#include "usb/cdc.h"
+#include "usb/descriptor.h"
+#include "usb/usbus.h"
+#include "usb/usbus/control.h"
+#include "net/netdev.h"
+#include "mutex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Link throughput as reported by the peripheral in bits/second
+ *
+ * This doesn't affect the actual throughput, only what the peripheral
+ * reports to the host.
+ */
+#ifndef CONFIG_USBUS_CDC_NCM_CONFIG_SPEED
+#define CONFIG_USBUS_CDC_NCM_CONFIG_SPEED   12000000
+#endif
+
+/**
+ * @brief Maximum size of IN NTBs, i.e. towards the host
+ *
+ * Two buffers of this size are used. Linux hosts require at least 2048.
+ */
+#ifndef CONFIG_USBUS_CDC_NCM_NTB_IN_SIZE
+#define CONFIG_USBUS_CDC_NCM_NTB_IN_SIZE    2048
+#endif
+
+/**
+ * @brief Maximum size of OUT NTBs, i.e. from the host
+ *
+ * Must be a multiple of @ref USBUS_CDCNCM_EP_DATA_SIZE.
+ */
+#ifndef CONFIG_USBUS_CDC_NCM_NTB_OUT_SIZE
+#define CONFIG_USBUS_CDC_NCM_NTB_OUT_SIZE   2048
+#endif
+
+/**
+ * @brief Maximum number of datagrams per IN NTB
+ */
+#ifndef CONFIG_USBUS_CDC_NCM_MAX_DATAGRAMS
+#define CONFIG_USBUS_CDC_NCM_MAX_DATAGRAMS  8
+#endif
+
+/**
+ * @brief CDC NCM interrupt endpoint size.
+ *
+ * @note Must be at least 16B to allow for reporting the link throughput
+ */
+#define USBUS_CDCNCM_EP_CTRL_SIZE   16
+
+/**
+ * @brief CDC NCM bulk data endpoint size.
+ */
+#define USBUS_CDCNCM_EP_DATA_SIZE   64
+
+/**
+ * @brief Offset of the first datagram in IN NTBs, after the NTB header and
+ *        the datagram pointer table
+ */
+#define USBUS_CDCNCM_NTB_IN_DATA_OFFSET \
+    (sizeof(usb_cdc_ncm_nth16_t) + sizeof(usb_cdc_ncm_ndp16_t) + \
+     (CONFIG_USBUS_CDC_NCM_MAX_DATAGRAMS + 1) * sizeof(usb_cdc_ncm_dpe16_t))
+
+/**
+ * @brief notification state, used to track which information must be send to
+ * the host
+ */
+typedef enum {
+    USBUS_CDCNCM_NOTIF_NONE,    /**< Nothing notified so far */
+    USBUS_CDCNCM_NOTIF_LINK_UP, /**< Link status is notified */
+    USBUS_CDCNCM_NOTIF_SPEED,   /**< Link speed is notified */
+} usbus_cdcncm_notif_t;
+
+/**
+ * @brief IN NTB under construction or in transmission
+ */
+typedef struct {
+    /** NTB header, datagram pointer table and datagrams */
+    uint8_t buf[CONFIG_USBUS_CDC_NCM_NTB_IN_SIZE] __attribute__((aligned(4)));
+    size_t len;                 /**< End of the last datagram */
+    unsigned count;             /**< Number of datagrams */
+} usbus_cdcncm_ntb_t;
+
+/**
+ * @brief USBUS CDC NCM device interface context
+ */
+typedef struct usbus_cdcncm_device {
+    usbus_handler_t handler_ctrl;           /**< Control interface handler */
+    usbus_interface_t iface_data;           /**< Data interface */
+    usbus_interface_t iface_ctrl;           /**< Control interface */
+    usbus_interface_alt_t iface_data_alt;   /**< Data alternative (active) interface */
+    usbus_endpoint_t *ep_in;                /**< Data endpoint in */
+    usbus_endpoint_t *ep_out;               /**< Data endpoint out */
+    usbus_endpoint_t *ep_ctrl;              /**< Control endpoint */
+    usbus_descr_gen_t ncm_descr;            /**< NCM descriptor generator */
+    event_t rx_flush;                       /**< Receive flush event */
+    event_t tx_xmit;                        /**< Transmit ready event */
+    netdev_t netdev;                        /**< Netdev context struct */
+    uint8_t mac_netdev[ETHERNET_ADDR_LEN];  /**< this device's MAC address */
+    char mac_host[13];                      /**< host side's MAC address as string */
+    usbus_string_t mac_str;                 /**< String context for the host side mac address */
+    usbus_t *usbus;                         /**< Ptr to the USBUS context */
+    mutex_t tx_lock;            /**< mutex protecting the IN NTBs */
+    mutex_t tx_done;            /**< unlocked whenever an IN NTB was sent */
+    usbus_cdcncm_ntb_t tx[2];   /**< IN NTBs */
+    uint8_t tx_fill;            /**< Index of the IN NTB being filled */
+    bool tx_busy;               /**< The other IN NTB is being sent */
+    uint16_t tx_seq;            /**< Sequence number of the next IN NTB */
+    size_t tx_len;              /**< Length of the IN NTB being sent */
+    size_t tx_offset;           /**< Bytes of the IN NTB sent so far */
+    size_t ntb_in_size;         /**< Maximum IN NTB size set by the host */
+    /** Buffer for the received NTB */
+    uint8_t rx_buf[CONFIG_USBUS_CDC_NCM_NTB_OUT_SIZE] __attribute__((aligned(4)));
+    size_t rx_len;              /**< Length of the received NTB, 0 while receiving */
+    size_t rx_fill;             /**< Bytes of the OUT NTB received so far */
+    size_t rx_ndp;              /**< Offset of the current NDP, 0 for none */
+    size_t rx_dpe;              /**< Offset of the current datagram pointer */
+    usbus_cdcncm_notif_t notif;     /**< Startup message notification tracker */
+    unsigned active_iface;          /**< Current active data interface */
+    bool multi_packet;          /**< NTBs use multi-packet transfers */
+} usbus_cdcncm_device_t;
+
+/**
+ * @brief CDC NCM initialization function
+ *
+ * @param   usbus   USBUS thread to use
+ * @param   handler CDCNCM device struct
+ */
+void usbus_cdcncm_init(usbus_t *usbus, usbus_cdcncm_device_t *handler);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* USB_USBUS_CDC_NCM_H */
+/** @} */
@@ -156,6 +156,26 @@ extern "C" {
  */
 #define VFS_ANY_FD (-1)
 
+/**
+ * @brief File system specific @ref vfs_fcntl commands
+ * @{
+ */
+/**
+ * @brief Reserve @c arg bytes of storage after the current file position
+ *
+ * Like posix_fallocate(), the file grows to cover the reserved space if it
+ * was shorter, the file position is not changed. Allocating the space up
+ * front avoids extending the allocation on every write of a long sequential
+ * write. If less is written in the end, cut off the rest with
+ * @ref VFS_F_TRUNCATE.
+ */
+#define VFS_F_PREALLOCATE (0x1000)
+/**
+ * @brief Truncate the file at the current file position
+ */
+#define VFS_F_TRUNCATE    (0x1001)
+/** @} */
+
 /* Forward declarations */
 /**
  * @brief struct @c vfs_file_ops typedef
@@ -368,6 +388,36 @@ struct vfs_file_ops {
      * @return <0 on error
      */
     ssize_t (*write) (vfs_file_t *filp, const void *src, size_t nbytes);
+
+    /**
+     * @brief Get direct read-only access to the content of an open file
+     *
+     * Only file systems that store the file contiguously in memory mapped
+     * storage can implement this.
+     *
+     * @param[in]  filp     pointer to open file
+     * @param[out] addr     start of the file content
+     * @param[out] len      size of the file content
+     *
+     * @return 0 on success
+     * @return <0 on error
+     */
+    int (*mmap) (vfs_file_t *filp, const void **addr, size_t *len);
+
+    /**
+     * @brief Get the readiness of an open file without blocking
+     *
+     * Drivers implementing this must call vfs_poll_notify() whenever the
+     * file may have become ready, so that poll() re-evaluates it. Files
+     * without it are always ready to poll(), like regular files.
+     *
+     * @param[in]  filp     pointer to open file
+     *
+     * @return mask of `POLLIN`, `POLLOUT`, `POLLERR` and `POLLHUP` as
+     *         defined in `poll.h`
+     * @return <0 on error
+     */
+    int (*poll) (vfs_file_t *filp);
 };
 
 /**
@@ -667,6 +717,50 @@ ssize_t vfs_read(int fd, void *dest, size_t count);
  */
 ssize_t vfs_write(int fd, const void *src, size_t count);
 
+/**
+ * @brief Get a pointer to the content of an open file
+ *
+ * This allows to use files stored in memory mapped flash, e.g. in
+ * @ref sys_fs_constfs, without copying them to RAM first. The pointer stays
+ * valid until the file is closed. The file position is not changed.
+ *
+ * @param[in]  fd       fd number obtained from vfs_open
+ * @param[out] addr     start of the file content
+ * @param[out] len      size of the file content
+ *
+ * @return 0 on success
+ * @return -ENOTSUP if the file system does not support direct access
+ * @return <0 on error
+ */
+int vfs_mmap(int fd, const void **addr, size_t *len);
+
+/**
+ * @brief Get the readiness of an open file without blocking
+ *
+ * @param[in]  fd       fd number obtained from vfs_open
+ *
+ * @return mask of `POLLIN`, `POLLOUT`, `POLLERR` and `POLLHUP`
+ * @return -ENOTSUP if the driver does not support polling
+ * @return <0 on error
+ */
+int vfs_poll(int fd);
+
+/**
+ * @brief Wake up threads blocked in poll() or select() to check the
+ *        readiness of their files again
+ *
+ * Called by drivers implementing vfs_file_ops::poll when a file may have
+ * become ready. Can be called from interrupt context and does nothing
+ * without the `posix_poll` module.
+ */
+static inline void vfs_poll_notify(void)
+{
+#ifdef MODULE_POSIX_POLL
+    extern void posix_poll_notify(void);
+    posix_poll_notify();
+#endif
+}
+
 /**
  * @brief Open a directory for reading with readdir
  *
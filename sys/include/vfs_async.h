@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup  sys_vfs_async Asynchronous VFS I/O
+ * @ingroup   sys_vfs
+ * @brief     Offload vfs_read() and vfs_write() to a worker thread
+ *
+ * File system operations can block for a long time, e.g. when littlefs
+ * compacts and erases MTD sectors. With this module, reads and writes are
+ * queued to an I/O worker thread and the caller is notified of the completion
+ * through an @ref event_t and/or thread flags.
+ *
+ * Requests are executed in the order they were queued. Writes to the same fd
+ * that are queued back to back are coalesced into a single vfs_write() call
+ * if they fit into @ref CONFIG_VFS_ASYNC_COALESCE_SIZE bytes.
+ *
+ * A worker serializes all requests queued to it, so use one worker per mount
+ * if slow operations on one file system must not delay another one.
+ *
+ * ~~~~~~~~~~~~~~~{.c}
+ * static char _stack[THREAD_STACKSIZE_DEFAULT];
+ * static vfs_async_worker_t _worker;
+ * static vfs_aio_t _req;
+ *
+ * vfs_async_worker_init(&_worker, _stack, sizeof(_stack),
+ *                       THREAD_PRIORITY_MAIN + 1, "vfs_aio");
+ * vfs_aio_set_thread_flags(&_req, thread_get_active(), THREAD_FLAG_AIO);
+ * vfs_write_async(&_worker, &_req, fd, line, strlen(line));
+ * [...]
+ * thread_flags_wait_any(THREAD_FLAG_AIO);
+ * printf("wrote %d bytes\n", (int)_req.res);
+ * ~~~~~~~~~~~~~~~
+ *
+ * @{
+ * @file
+ * @brief   Asynchronous VFS I/O API
+ * @author  ML!PA Consulting GmbH
+ */
+
+#ifndef VFS_ASYNC_H
+#define VFS_ASYNC_H
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "clist.h"
+#include "event.h"
+#include "mutex.h"
+#include "thread.h"
+#include "thread_flags.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Size of the buffer used to coalesce adjacent writes
+ *
+ * Set to 0 to disable coalescing.
+ */
+#ifndef CONFIG_VFS_ASYNC_COALESCE_SIZE
+#define CONFIG_VFS_ASYNC_COALESCE_SIZE  (64U)
+#endif
+
+/**
+ * @brief   Asynchronous I/O request
+ *
+ * Zero initialize the request before its first use, then select the
+ * notification with @ref vfs_aio_set_event() and/or
+ * @ref vfs_aio_set_thread_flags(). The request must not be modified or reused
+ * until it has completed.
+ */
+typedef struct {
+    clist_node_t node;          /**< worker queue entry, internal */
+    int fd;                     /**< file descriptor */
+    union {
+        void *dest;             /**< destination of a read */
+        const void *src;        /**< source of a write */
+    } buf;                      /**< data buffer */
+    size_t len;                 /**< number of bytes to transfer */
+    ssize_t res;                /**< result of vfs_read() / vfs_write() */
+    event_queue_t *queue;       /**< queue to post @p event to */
+    event_t *event;             /**< completion event, may be NULL */
+    thread_t *thread;           /**< thread to notify, may be NULL */
+    thread_flags_t flags;       /**< thread flags set on completion */
+    uint8_t op;                 /**< operation, internal */
+} vfs_aio_t;
+
+/**
+ * @brief   Worker statistics
+ */
+typedef struct {
+    unsigned depth;             /**< requests currently queued */
+    unsigned depth_max;         /**< highest queue depth seen */
+    unsigned completed;         /**< requests completed */
+    unsigned coalesced;         /**< writes merged into a previous one */
+} vfs_async_stats_t;
+
+/**
+ * @brief   I/O worker
+ */
+typedef struct {
+    clist_node_t queue;         /**< pending requests */
+    mutex_t lock;               /**< protects @p queue and @p stats */
+    kernel_pid_t pid;           /**< worker thread */
+    vfs_async_stats_t stats;    /**< statistics */
+#if CONFIG_VFS_ASYNC_COALESCE_SIZE || defined(DOXYGEN)
+    uint8_t buf[CONFIG_VFS_ASYNC_COALESCE_SIZE];    /**< coalescing buffer */
+#endif
+} vfs_async_worker_t;
+
+/**
+ * @brief   Start an I/O worker thread
+ *
+ * @param[out]  worker      worker to initialize
+ * @param[in]   stack       stack of the worker thread
+ * @param[in]   stacksize   size of @p stack
+ * @param[in]   prio        priority of the worker thread
+ * @param[in]   name        name of the worker thread
+ */
+void vfs_async_worker_init(vfs_async_worker_t *worker, char *stack,
+                           int stacksize, uint8_t prio, const char *name);
+
+/**
+ * @brief   Post an event on completion of @p req
+ *
+ * @param[out]  req     request to configure
+ * @param[in]   queue   event queue to post @p event to
+ * @param[in]   event   event to post
+ */
+static inline void vfs_aio_set_event(vfs_aio_t *req, event_queue_t *queue,
+                                     event_t *event)
+{
+    req->queue = queue;
+    req->event = event;
+}
+
+/**
+ * @brief   Set thread flags on completion of @p req
+ *
+ * @param[out]  req     request to configure
+ * @param[in]   thread  thread to notify
+ * @param[in]   flags   flags to set
+ */
+static inline void vfs_aio_set_thread_flags(vfs_aio_t *req, thread_t *thread,
+                                            thread_flags_t flags)
+{
+    req->thread = thread;
+    req->flags = flags;
+}
+
+/**
+ * @brief   Queue a read from an open file
+ *
+ * @param[in]   worker  worker to execute the request
+ * @param[in]   req     request, the result is stored in `req->res`
+ * @param[in]   fd      fd number obtained from vfs_open
+ * @param[out]  dest    destination buffer
+ * @param[in]   count   maximum number of bytes to read
+ *
+ * @return 0 if the request was queued
+ * @return -EINVAL if @p dest is NULL
+ */
+int vfs_read_async(vfs_async_worker_t *worker, vfs_aio_t *req, int fd,
+                   void *dest, size_t count);
+
+/**
+ * @brief   Queue a write to an open file
+ *
+ * @param[in]   worker  worker to execute the request
+ * @param[in]   req     request, the result is stored in `req->res`
+ * @param[in]   fd      fd number obtained from vfs_open
+ * @param[in]   src     data to write, must stay valid until completion
+ * @param[in]   count   number of bytes to write
+ *
+ * @return 0 if the request was queued
+ * @return -EINVAL if @p src is NULL
+ */
+int vfs_write_async(vfs_async_worker_t *worker, vfs_aio_t *req, int fd,
+                    const void *src, size_t count);
+
+/**
+ * @brief   Get the statistics of a worker
+ *
+ * @param[in]   worker  worker to query
+ * @param[out]  stats   statistics
+ */
+void vfs_async_stats_get(vfs_async_worker_t *worker, vfs_async_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VFS_ASYNC_H */
+/** @} */
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_walltime Wall-clock time
+ * @ingroup     sys
+ * @brief       Wall-clock time without peripheral accesses on reads
+ *
+ * The wall-clock time is kept as an offset against the 64 bit `ZTIMER_USEC`
+ * clock, so reading it, e.g. by gettimeofday() and time() with newlib,
+ * costs little more than reading the timer. With `periph_rtc`, the time is
+ * taken from the RTC at initialization and whenever
+ * @ref CONFIG_WALLTIME_RTC_RESYNC_S seconds passed since, to catch up with
+ * the time `ZTIMER_USEC` did not run, e.g. in deeper power modes. This only
+ * happens on reads from thread context, it steps the time by whole seconds
+ * if it deviates from the RTC by more than a second.
+ *
+ * Corrections, e.g. by @ref net_sntp, are given to walltime_adjust() or
+ * walltime_sync_us(). They are applied smoothly by slowing down or speeding
+ * up the time by 2^-@ref CONFIG_WALLTIME_SLEW_SHIFT (about 500 ppm by
+ * default), so the time never jumps and never runs backwards. Corrections
+ * beyond @ref CONFIG_WALLTIME_STEP_US are stepped right away instead.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Wall-clock time interface
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+
+#ifndef WALLTIME_H
+#define WALLTIME_H
+
+#include <stdint.h>
+#include <sys/time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Rate of the slewing as a power of two, i.e. corrections are
+ *          applied at a rate of 2^-CONFIG_WALLTIME_SLEW_SHIFT
+ */
+#ifndef CONFIG_WALLTIME_SLEW_SHIFT
+#define CONFIG_WALLTIME_SLEW_SHIFT      (11U)
+#endif
+
+/**
+ * @brief   Corrections beyond this in µs are stepped instead of slewed
+ */
+#ifndef CONFIG_WALLTIME_STEP_US
+#define CONFIG_WALLTIME_STEP_US         (128000UL)
+#endif
+
+/**
+ * @brief   Interval in seconds after which the time is read from the RTC
+ *          again, 0 to read it at initialization only
+ */
+#ifndef CONFIG_WALLTIME_RTC_RESYNC_S
+#define CONFIG_WALLTIME_RTC_RESYNC_S    (3600UL)
+#endif
+
+/**
+ * @brief   Initializes the wall-clock time from the RTC, if available
+ *
+ * Called by auto_init with module `auto_init_walltime`.
+ */
+void walltime_init(void);
+
+/**
+ * @brief   Gets the wall-clock time
+ *
+ * @return  µs since 1970-01-01 00:00:00 UTC
+ */
+uint64_t walltime_now_us(void);
+
+/**
+ * @brief   Gets the wall-clock time as struct timeval
+ *
+ * @param[out]  tv      the wall-clock time
+ */
+void walltime_gettimeofday(struct timeval *tv);
+
+/**
+ * @brief   Sets the wall-clock time, and the RTC if available
+ *
+ * Steps the time right away and drops any pending correction.
+ *
+ * @param[in]   us      µs since 1970-01-01 00:00:00 UTC
+ */
+void walltime_set_us(uint64_t us);
+
+/**
+ * @brief   Corrects the wall-clock time
+ *
+ * The correction is added to the one pending. It is slewed, unless their
+ * sum exceeds @ref CONFIG_WALLTIME_STEP_US.
+ *
+ * @param[in]   delta_us    correction in µs
+ */
+void walltime_adjust(int64_t delta_us);
+
+/**
+ * @brief   Corrects the wall-clock time towards a reference
+ *
+ * Replaces a pending correction by the difference to @p us, see
+ * walltime_adjust().
+ *
+ * @param[in]   us      current time from a reference in µs since
+ *                      1970-01-01 00:00:00 UTC
+ */
+void walltime_sync_us(uint64_t us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WALLTIME_H */
+/** @} */
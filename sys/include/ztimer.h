@@ -202,6 +202,16 @@
  * 5. Due to +-1 systemic inaccuracies, it is advisable to use ZTIMER_MSEC for
  *    second timers up to 49 days (instead of ZTIMER_SEC).
  *
+ *
+ * ## 64 bit time
+ *
+ * With module `ztimer_now64`, ztimer_now() returns 64 bit monotonic time on
+ * every clock. Reading it does not disable interrupts: the checkpoint the
+ * time is extended from is only rewritten once a quarter of the range of
+ * the clock passed, and readers detect a concurrent update through a
+ * sequence counter. An intermediate timer keeps the checkpoint fresh while
+ * no timer is set. For targets beyond 32 bit, use @ref ztimer64_t.
+ *
  * @{
  *
  * @file
@@ -214,10 +224,14 @@
 #ifndef ZTIMER_H
 #define ZTIMER_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
+#include "kernel_defines.h"
 #include "kernel_types.h"
 #include "msg.h"
+#include "mutex.h"
+#include "rmutex.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -228,6 +242,17 @@ extern "C" {
  */
 #define ZTIMER_CLOCK_NO_REQUIRED_PM_MODE (UINT8_MAX)
 
+/**
+ * @brief   Grid in milliseconds lazy timers on ZTIMER_MSEC are aligned to
+ *
+ * A timer set with ztimer_set_lazy() whose slack reaches the next multiple
+ * of the grid in ZTIMER_MSEC time triggers there, so unrelated periodic
+ * timers end up in the same wakeup. 0 disables the alignment.
+ */
+#ifndef CONFIG_ZTIMER_LAZY_GRID_MSEC
+#define CONFIG_ZTIMER_LAZY_GRID_MSEC     (100U)
+#endif
+
 /**
  * @brief ztimer_base_t forward declaration
  */
@@ -244,6 +269,10 @@ typedef struct ztimer_clock ztimer_clock_t;
 struct ztimer_base {
     ztimer_base_t *next;        /**< next timer in list */
     uint32_t offset;            /**< offset from last timer in list */
+#if MODULE_ZTIMER_WHEEL || DOXYGEN
+    ztimer_base_t **pprev;      /**< link pointing to this timer, only used on
+                                     clocks with a @ref sys_ztimer_wheel */
+#endif
 };
 
 #if MODULE_ZTIMER_NOW64
@@ -299,12 +328,17 @@ struct ztimer_clock {
 #if MODULE_ZTIMER_EXTEND || MODULE_ZTIMER_NOW64 || DOXYGEN
     /* values used for checkpointed intervals and 32bit extension */
     uint32_t max_value;             /**< maximum relative timer value       */
-    uint32_t lower_last;            /**< timer value at last now() call     */
-    ztimer_now_t checkpoint;        /**< cumulated time at last now() call  */
+    uint32_t lower_last;            /**< timer value at last checkpoint     */
+    ztimer_now_t checkpoint;        /**< cumulated time at last checkpoint  */
+    volatile uint32_t seq;          /**< odd while the checkpoint is taken  */
 #endif
 #if MODULE_PM_LAYERED || DOXYGEN
     uint8_t required_pm_mode;       /**< min. pm mode required for the clock to run */
 #endif
+#if MODULE_ZTIMER_WHEEL || DOXYGEN
+    struct ztimer_wheel *wheel;     /**< timing wheel replacing the list, or
+                                         NULL, see @ref sys_ztimer_wheel    */
+#endif
 };
 
 /**
@@ -328,6 +362,27 @@ void ztimer_handler(ztimer_clock_t *clock);
  */
 void ztimer_set(ztimer_clock_t *clock, ztimer_t *timer, uint32_t val);
 
+/**
+ * @brief   Set a timer on a clock that may trigger late
+ *
+ * For periodic low-priority work, where waking up separately for every
+ * timer costs more than the exact timing is worth. @p timer triggers within
+ * [@p val, @p val + @p slack] ticks from now, at the target of the first
+ * timer already set within that window, so both are handled in one wakeup.
+ * Otherwise, a timer on ZTIMER_MSEC is aligned to the next multiple of
+ * @ref CONFIG_ZTIMER_LAZY_GRID_MSEC within the window, to meet other lazy
+ * timers there. If neither applies, it triggers after @p val ticks.
+ *
+ * On a clock with a @ref sys_ztimer_wheel, only the grid alignment is done.
+ *
+ * @param[in]   clock       ztimer clock to operate on
+ * @param[in]   timer       timer entry to set
+ * @param[in]   val         earliest timer target (relative ticks from now)
+ * @param[in]   slack       ticks the timer may trigger later than @p val
+ */
+void ztimer_set_lazy(ztimer_clock_t *clock, ztimer_t *timer, uint32_t val,
+                     uint32_t slack);
+
 /**
  * @brief   Remove a timer from a clock
  *
@@ -392,6 +447,27 @@ int ztimer_msg_receive_timeout(ztimer_clock_t *clock, msg_t *msg,
  */
 ztimer_now_t _ztimer_now_extend(ztimer_clock_t *clock);
 
+/**
+ * @brief   Check if the time of a clock is extended in software
+ *
+ * The time of an extended clock is taken from a checkpoint, which
+ * intermediate timers at half the range of the clock keep up to date.
+ *
+ * @internal
+ *
+ * @param[in]   clock          ztimer clock to check
+ * @return  true if @p clock is extended
+ */
+static inline bool _ztimer_is_extended(const ztimer_clock_t *clock)
+{
+#if MODULE_ZTIMER_EXTEND || MODULE_ZTIMER_NOW64
+    return IS_USED(MODULE_ZTIMER_NOW64) || (clock->max_value < UINT32_MAX);
+#else
+    (void)clock;
+    return false;
+#endif
+}
+
 /**
  * @brief   Get the current time from a clock
  *
@@ -401,13 +477,7 @@ ztimer_now_t _ztimer_now_extend(ztimer_clock_t *clock);
  */
 static inline ztimer_now_t ztimer_now(ztimer_clock_t *clock)
 {
-#if MODULE_ZTIMER_NOW64
-    if (1) {
-#elif MODULE_ZTIMER_EXTEND
-    if (clock->max_value < UINT32_MAX) {
-#else
-    if (0) {
-#endif
+    if (_ztimer_is_extended(clock)) {
         return _ztimer_now_extend(clock);
     }
     else {
@@ -415,6 +485,60 @@ static inline ztimer_now_t ztimer_now(ztimer_clock_t *clock)
     }
 }
 
+#if MODULE_ZTIMER_NOW64 || DOXYGEN
+/**
+ * @brief   Timer with a 64 bit target
+ *
+ * Re-arms a 32 bit timer until its target is reached, so the callback runs
+ * in the same context as the one of a ztimer_t.
+ *
+ * Only available with module `ztimer_now64`.
+ */
+typedef struct {
+    ztimer_t timer;                 /**< underlying timer */
+    ztimer_clock_t *clock;          /**< clock the timer is set on */
+    uint64_t target;                /**< absolute target in ticks */
+    void (*callback)(void *arg);    /**< timer callback function pointer */
+    void *arg;                      /**< timer callback argument */
+} ztimer64_t;
+
+/**
+ * @brief   Set a timer to an absolute 64 bit target
+ *
+ * @param[in]   clock       ztimer clock to operate on
+ * @param[in]   timer       timer entry to set, with the callback initialized
+ * @param[in]   target      absolute target, as returned by ztimer_now();
+ *                          triggers right away if already passed
+ */
+void ztimer64_set_at(ztimer_clock_t *clock, ztimer64_t *timer,
+                     uint64_t target);
+
+/**
+ * @brief   Set a timer with a 64 bit timeout
+ *
+ * @param[in]   clock       ztimer clock to operate on
+ * @param[in]   timer       timer entry to set, with the callback initialized
+ * @param[in]   val         timer target (relative ticks from now)
+ */
+static inline void ztimer64_set(ztimer_clock_t *clock, ztimer64_t *timer,
+                                uint64_t val)
+{
+    ztimer64_set_at(clock, timer, ztimer_now(clock) + val);
+}
+
+/**
+ * @brief   Remove a timer with a 64 bit target
+ *
+ * @param[in]   timer       timer entry to remove
+ */
+static inline void ztimer64_remove(ztimer64_t *timer)
+{
+    if (timer->clock) {
+        ztimer_remove(timer->clock, &timer->timer);
+    }
+}
+#endif
+
 /**
  * @brief Suspend the calling thread until the time (@p last_wakeup + @p period)
  *
@@ -471,6 +595,57 @@ void ztimer_set_wakeup(ztimer_clock_t *clock, ztimer_t *timer, uint32_t offset,
 void ztimer_set_timeout_flag(ztimer_clock_t *clock, ztimer_t *timer,
                              uint32_t timeout);
 
+/**
+ * @brief   Try to lock a mutex, blocking at most @p timeout ticks
+ *
+ * @param[in]   clock           ztimer clock to operate on
+ * @param[in]   mutex           mutex to lock
+ * @param[in]   timeout         timeout in ticks of @p clock, 0 only tries
+ *                              to lock @p mutex
+ *
+ * @return  0 if @p mutex was locked
+ * @return  -ECANCELED on timeout
+ */
+int ztimer_mutex_lock_timeout(ztimer_clock_t *clock, mutex_t *mutex,
+                              uint32_t timeout);
+
+/**
+ * @brief   Try to lock a recursive mutex, blocking at most @p timeout ticks
+ *
+ * @param[in]   clock           ztimer clock to operate on
+ * @param[in]   rmutex          recursive mutex to lock
+ * @param[in]   timeout         timeout in ticks of @p clock
+ *
+ * @return  0 if @p rmutex was locked
+ * @return  -ECANCELED on timeout
+ */
+int ztimer_rmutex_lock_timeout(ztimer_clock_t *clock, rmutex_t *rmutex,
+                               uint32_t timeout);
+
+/**
+ * @brief   Get the time until the next timer set on a clock triggers
+ *
+ * Meant for power management deciding how long the CPU may sleep.
+ *
+ * @param[in]   clock  ztimer clock to query
+ *
+ * @return  ticks of @p clock until the next timer triggers, 0 if a timer is
+ *          overdue
+ * @return  UINT32_MAX if no timer is set on @p clock
+ */
+uint32_t ztimer_until_next(ztimer_clock_t *clock);
+
+/**
+ * @brief   Get the time until a timer triggers
+ *
+ * @param[in]   clock  ztimer clock @p timer is set on
+ * @param[in]   timer  timer to query
+ *
+ * @return  ticks of @p clock until @p timer triggers, 0 if it is not set or
+ *          overdue
+ */
+uint32_t ztimer_left(ztimer_clock_t *clock, const ztimer_t *timer);
+
 /**
  * @brief   Update ztimer clock head list offset
  *
@@ -497,9 +672,13 @@ void ztimer_init(void);
  */
 static inline void ztimer_init_extend(ztimer_clock_t *clock)
 {
-    if (clock->max_value < UINT32_MAX) {
+#if MODULE_ZTIMER_EXTEND || MODULE_ZTIMER_NOW64
+    if (_ztimer_is_extended(clock)) {
         clock->ops->set(clock, clock->max_value >> 1);
     }
+#else
+    (void)clock;
+#endif
 }
 
 /* default ztimer virtual devices */
@@ -117,6 +117,24 @@ extern "C" {
 #define CONFIG_ZTIMER_MSEC_REQUIRED_PM_MODE ZTIMER_CLOCK_NO_REQUIRED_PM_MODE
 #endif
 
+/**
+ * @brief   Use a @ref sys_ztimer_wheel for ZTIMER_USEC
+ *
+ * Only used with module `ztimer_wheel`.
+ */
+#ifndef CONFIG_ZTIMER_USEC_WHEEL
+#define CONFIG_ZTIMER_USEC_WHEEL            (0)
+#endif
+
+/**
+ * @brief   Use a @ref sys_ztimer_wheel for ZTIMER_MSEC
+ *
+ * Only used with module `ztimer_wheel`.
+ */
+#ifndef CONFIG_ZTIMER_MSEC_WHEEL
+#define CONFIG_ZTIMER_MSEC_WHEEL            (1)
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_ztimer_periodic  ztimer periodic timer
+ * @ingroup     sys_ztimer
+ * @brief       Periodic timers without drift and with overrun detection
+ *
+ * A periodic timer triggers at `reference + n * period` on its clock. Each
+ * trigger is scheduled relative to the previous target, not to the time the
+ * callback ran, so latencies do not accumulate. If the target of one or
+ * more periods already passed when the timer triggers, e.g. as interrupts
+ * were disabled for too long, these periods are skipped and reported as
+ * missed to the callback.
+ *
+ * The callback runs in interrupt context. With module `event`, the timer
+ * can post an event instead (see @ref ztimer_periodic_event_init), a period
+ * that triggers while the event is still pending counts as missed as well.
+ *
+ * ztimer_periodic_start() aligns the timer to a multiple of its period, so
+ * all timers of the same period on a clock trigger in a single interrupt
+ * instead of each needing a compare of its own.
+ *
+ * @{
+ *
+ * @file
+ * @brief       ztimer periodic timer API
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+
+#ifndef ZTIMER_PERIODIC_H
+#define ZTIMER_PERIODIC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "ztimer.h"
+#ifdef MODULE_EVENT
+#include "event.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Callback of a periodic timer
+ *
+ * @param[in]   arg     argument of the timer
+ * @param[in]   missed  periods missed since the previous call
+ *
+ * @return  true to keep the timer running, false to stop it
+ */
+typedef bool (*ztimer_periodic_cb_t)(void *arg, unsigned missed);
+
+/**
+ * @brief   Periodic timer
+ */
+typedef struct {
+    ztimer_t timer;                 /**< timer of the next period */
+    ztimer_clock_t *clock;          /**< clock the timer runs on */
+    ztimer_periodic_cb_t callback;  /**< callback */
+    void *arg;                      /**< argument of @p callback */
+    uint32_t period;                /**< period in ticks of @p clock */
+    uint32_t last;                  /**< target of the last period */
+    uint32_t missed;                /**< periods missed in total */
+} ztimer_periodic_t;
+
+/**
+ * @brief   Initialize a periodic timer
+ *
+ * @param[in]   clock       clock to run on
+ * @param[out]  timer       timer to initialize
+ * @param[in]   period      period in ticks of @p clock, not 0
+ * @param[in]   callback    callback of every period
+ * @param[in]   arg         argument of @p callback
+ */
+void ztimer_periodic_init(ztimer_clock_t *clock, ztimer_periodic_t *timer,
+                          uint32_t period, ztimer_periodic_cb_t callback,
+                          void *arg);
+
+/**
+ * @brief   Start a periodic timer at an absolute reference
+ *
+ * The timer triggers at @p reference + n * period for n > 0. Periods before
+ * the current time are skipped without counting them as missed.
+ *
+ * @param[in]   timer       timer to start
+ * @param[in]   reference   reference time on the clock of @p timer
+ */
+void ztimer_periodic_start_at(ztimer_periodic_t *timer, uint32_t reference);
+
+/**
+ * @brief   Start a periodic timer aligned to a multiple of its period
+ *
+ * The first period ends at the next multiple of the period on the clock of
+ * @p timer, at most one period from now.
+ *
+ * @param[in]   timer       timer to start
+ */
+void ztimer_periodic_start(ztimer_periodic_t *timer);
+
+/**
+ * @brief   Stop a periodic timer
+ *
+ * @param[in]   timer       timer to stop
+ */
+void ztimer_periodic_stop(ztimer_periodic_t *timer);
+
+#if defined(MODULE_EVENT) || defined(DOXYGEN)
+/**
+ * @brief   Periodic timer posting an event
+ */
+typedef struct {
+    ztimer_periodic_t periodic;     /**< periodic timer */
+    event_queue_t *queue;           /**< queue to post @p event to */
+    event_t *event;                 /**< event to post */
+} ztimer_periodic_event_t;
+
+/**
+ * @brief   Initialize a periodic timer posting an event
+ *
+ * Start and stop it with its member ztimer_periodic_event_t::periodic.
+ * Missed periods are counted in ztimer_periodic_t::missed only.
+ *
+ * @note    Only available with module `event`
+ *
+ * @param[in]   clock       clock to run on
+ * @param[out]  timer       timer to initialize
+ * @param[in]   period      period in ticks of @p clock, not 0
+ * @param[in]   queue       queue to post @p event to
+ * @param[in]   event       event to post every period
+ */
+void ztimer_periodic_event_init(ztimer_clock_t *clock,
+                                ztimer_periodic_event_t *timer,
+                                uint32_t period, event_queue_t *queue,
+                                event_t *event);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZTIMER_PERIODIC_H */
+/** @} */
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2020 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for more
+ * details.
+ */
+
+/**
+ * @defgroup    sys_ztimer_wheel  ztimer hierarchical timing wheel
+ * @ingroup     sys_ztimer
+ * @brief       Constant time timer queue for ztimer clocks
+ *
+ * By default, a ztimer clock keeps its timers in a sorted delta list.
+ * Setting a timer has to walk that list with interrupts disabled, which
+ * gets expensive on clocks with many active timers.
+ *
+ * With module `ztimer_wheel`, a clock can be given a hierarchical timing
+ * wheel instead. The 32 bit target of a timer is split into
+ * @ref ZTIMER_WHEEL_LEVELS digits of @ref CONFIG_ZTIMER_WHEEL_SLOT_BITS bits.
+ * A timer is kept in the slot of the most significant digit in which its
+ * target differs from the current time of the wheel. Whenever the wheel
+ * reaches a non-empty slot, its timers are moved down to the lower levels,
+ * until they reach the lowest level, which has a resolution of one tick.
+ *
+ * Setting and removing a timer therefore takes constant time (at most one
+ * step per level), independent of the number of timers set on the clock.
+ * Every timer is moved down at most once per level before it triggers.
+ * Timers still trigger at the exact same tick they do with the list.
+ *
+ * Timers on a clock with a wheel need one additional pointer. The wheel
+ * itself needs @ref ZTIMER_WHEEL_LEVELS * @ref ZTIMER_WHEEL_SLOTS pointers.
+ *
+ * The default clocks get a wheel assigned during @ref ztimer_init using
+ * @ref CONFIG_ZTIMER_USEC_WHEEL and @ref CONFIG_ZTIMER_MSEC_WHEEL. Any other
+ * clock can be given a wheel with @ref ztimer_wheel_init.
+ *
+ * @{
+ * @file
+ * @brief       ztimer hierarchical timing wheel API
+ */
+
+#ifndef ZTIMER_WHEEL_H
+#define ZTIMER_WHEEL_H
+
+#include <stdint.h>
+
+#include "ztimer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of bits of the timer target handled per wheel level
+ *
+ * @attention   Must be 1, 2 or 4.
+ */
+#ifndef CONFIG_ZTIMER_WHEEL_SLOT_BITS
+#define CONFIG_ZTIMER_WHEEL_SLOT_BITS   (4U)
+#endif
+
+/**
+ * @brief   Number of slots per wheel level
+ */
+#define ZTIMER_WHEEL_SLOTS      (1U << CONFIG_ZTIMER_WHEEL_SLOT_BITS)
+
+/**
+ * @brief   Number of wheel levels required to span 32 bit targets
+ */
+#define ZTIMER_WHEEL_LEVELS     (32U / CONFIG_ZTIMER_WHEEL_SLOT_BITS)
+
+/**
+ * @brief   ztimer hierarchical timing wheel
+ */
+typedef struct ztimer_wheel {
+    /**
+     * @brief   Timers by level and slot
+     */
+    ztimer_base_t *slots[ZTIMER_WHEEL_LEVELS][ZTIMER_WHEEL_SLOTS];
+    uint16_t used[ZTIMER_WHEEL_LEVELS]; /**< bitmap of non-empty slots  */
+    ztimer_base_t *expired;             /**< timers due for triggering  */
+    ztimer_base_t **expired_tail;       /**< end of the expired list    */
+    uint32_t now;                       /**< current time of the wheel  */
+} ztimer_wheel_t;
+
+/**
+ * @brief   Use a timing wheel for the timers of a clock
+ *
+ * @pre     No timer is set on @p clock
+ *
+ * @param[in]   clock   ztimer clock to operate on
+ * @param[out]  wheel   timing wheel to use for @p clock
+ */
+void ztimer_wheel_init(ztimer_clock_t *clock, ztimer_wheel_t *wheel);
+
+/**
+ * @brief   Set a timer on a clock using a timing wheel
+ *
+ * @internal    Called by @ref ztimer_set
+ *
+ * @param[in]   clock   ztimer clock to operate on
+ * @param[in]   timer   timer entry to set
+ * @param[in]   val     timer target (relative ticks from now)
+ */
+void ztimer_wheel_set(ztimer_clock_t *clock, ztimer_t *timer, uint32_t val);
+
+/**
+ * @brief   Remove a timer from a clock using a timing wheel
+ *
+ * @internal    Called by @ref ztimer_remove
+ *
+ * @param[in]   clock   ztimer clock to operate on
+ * @param[in]   timer   timer entry to remove
+ */
+void ztimer_wheel_remove(ztimer_clock_t *clock, ztimer_t *timer);
+
+/**
+ * @brief   Get the time until the next timer on a clock using a timing wheel
+ *          triggers
+ *
+ * @internal    Called by @ref ztimer_until_next
+ *
+ * @param[in]   clock   ztimer clock to operate on
+ *
+ * @return  ticks until the next timer triggers, UINT32_MAX if none is set
+ */
+uint32_t ztimer_wheel_until_next(ztimer_clock_t *clock);
+
+/**
+ * @brief   Get the time until a timer on a clock using a timing wheel
+ *          triggers
+ *
+ * @internal    Called by @ref ztimer_left
+ *
+ * @param[in]   clock   ztimer clock to operate on
+ * @param[in]   timer   timer to query
+ *
+ * @return  ticks until @p timer triggers, 0 if it is not set or due
+ */
+uint32_t ztimer_wheel_left(ztimer_clock_t *clock, const ztimer_t *timer);
+
+/**
+ * @brief   Callback handler of a clock using a timing wheel
+ *
+ * @internal    Called by @ref ztimer_handler
+ *
+ * @param[in]   clock   ztimer clock to operate on
+ */
+void ztimer_wheel_handler(ztimer_clock_t *clock);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZTIMER_WHEEL_H */
+/** @} */
@@ -14,6 +14,11 @@
  *
  * Please check out xtimer's documentation for usage.
  *
+ * Maps the whole xtimer API inline onto ZTIMER_USEC, so a build using
+ * `ztimer_xtimer_compat` links neither xtimer nor its timer. Ticks are
+ * microseconds. 64 bit timeouts beyond UINT32_MAX microseconds use the 64 bit
+ * target of @ref ztimer64_t, which requires `ztimer_now64`.
+ *
  * @author  Kaspar Schleiser <kaspar@schleiser.de>
  */
 #ifndef ZTIMER_XTIMER_COMPAT_H
@@ -29,6 +34,11 @@
 #endif /* MODULE_CORE_MSG */
 #include "mutex.h"
 #include "kernel_types.h"
+#include "rmutex.h"
+#include "thread.h"
+#ifdef MODULE_CORE_THREAD_FLAGS
+#include "thread_flags.h"
+#endif
 
 #include "ztimer.h"
 
@@ -36,28 +46,47 @@
 extern "C" {
 #endif
 
-/* the xtimer API is documented elsewhere. This is just an (incomplete) wrapper,
+/* the xtimer API is documented elsewhere. This is just a wrapper,
  * so skip doxygen.
  */
 #ifndef DOXYGEN
 
-typedef ztimer_t xtimer_t;
-typedef uint32_t xtimer_ticks32_t;
-typedef uint64_t xtimer_ticks64_t;
+/* The 64 bit target is only used by the xtimer_*64() functions, all others
+ * use ztimer64_t::timer on its own. */
+typedef ztimer64_t xtimer_t;
+
+typedef struct {
+    uint32_t ticks32;
+} xtimer_ticks32_t;
+
+typedef struct {
+    uint64_t ticks64;
+} xtimer_ticks64_t;
+
+static inline xtimer_ticks32_t xtimer_ticks(uint32_t ticks)
+{
+    xtimer_ticks32_t ret = { ticks };
+
+    return ret;
+}
+
+static inline xtimer_ticks64_t xtimer_ticks64(uint64_t ticks)
+{
+    xtimer_ticks64_t ret = { ticks };
+
+    return ret;
+}
 
 static inline xtimer_ticks32_t xtimer_now(void)
 {
-    return ztimer_now(ZTIMER_USEC);
+    return xtimer_ticks(ztimer_now(ZTIMER_USEC));
 }
 
 static inline xtimer_ticks64_t xtimer_now64(void)
 {
-    return ztimer_now(ZTIMER_USEC);
+    return xtimer_ticks64(ztimer_now(ZTIMER_USEC));
 }
 
-/*static void xtimer_now_timex(timex_t *out) {
-   }*/
-
 static inline uint32_t xtimer_now_usec(void)
 {
     return ztimer_now(ZTIMER_USEC);
@@ -68,10 +97,60 @@ static inline uint64_t xtimer_now_usec64(void)
     return ztimer_now(ZTIMER_USEC);
 }
 
-static inline void xtimer_sleep(uint32_t seconds)
+static inline void xtimer_now_timex(timex_t *out)
+{
+    uint64_t now = xtimer_now_usec64();
+
+    out->seconds = div_u64_by_1000000(now);
+    out->microseconds = now - (out->seconds * US_PER_SEC);
+}
+
+static inline uint32_t xtimer_usec_from_ticks(xtimer_ticks32_t ticks)
+{
+    return ticks.ticks32;
+}
+
+static inline uint64_t xtimer_usec_from_ticks64(xtimer_ticks64_t ticks)
+{
+    return ticks.ticks64;
+}
+
+static inline xtimer_ticks32_t xtimer_ticks_from_usec(uint32_t usec)
+{
+    return xtimer_ticks(usec);
+}
+
+static inline xtimer_ticks64_t xtimer_ticks_from_usec64(uint64_t usec)
+{
+    return xtimer_ticks64(usec);
+}
+
+static inline xtimer_ticks32_t xtimer_diff(xtimer_ticks32_t a,
+                                           xtimer_ticks32_t b)
+{
+    return xtimer_ticks(a.ticks32 - b.ticks32);
+}
+
+static inline xtimer_ticks64_t xtimer_diff64(xtimer_ticks64_t a,
+                                             xtimer_ticks64_t b)
+{
+    return xtimer_ticks64(a.ticks64 - b.ticks64);
+}
+
+static inline xtimer_ticks32_t xtimer_diff32_64(xtimer_ticks64_t a,
+                                                xtimer_ticks64_t b)
+{
+    return xtimer_ticks((uint32_t)(a.ticks64 - b.ticks64));
+}
+
+static inline bool xtimer_less(xtimer_ticks32_t a, xtimer_ticks32_t b)
+{
+    return a.ticks32 < b.ticks32;
+}
+
+static inline bool xtimer_less64(xtimer_ticks64_t a, xtimer_ticks64_t b)
 {
-    /* TODO: use ZTIMER_SEC */
-    ztimer_sleep(ZTIMER_USEC, seconds * 1000000LU);
+    return a.ticks64 < b.ticks64;
 }
 
 static inline void xtimer_usleep(uint32_t microseconds)
@@ -79,94 +158,183 @@ static inline void xtimer_usleep(uint32_t microseconds)
     ztimer_sleep(ZTIMER_USEC, microseconds);
 }
 
+static inline void xtimer_usleep64(uint64_t microseconds)
+{
+    while (microseconds > UINT32_MAX) {
+        ztimer_sleep(ZTIMER_USEC, UINT32_MAX);
+        microseconds -= UINT32_MAX;
+    }
+    ztimer_sleep(ZTIMER_USEC, microseconds);
+}
+
+static inline void xtimer_sleep(uint32_t seconds)
+{
+    xtimer_usleep64((uint64_t)seconds * US_PER_SEC);
+}
+
 static inline void xtimer_nanosleep(uint32_t nanoseconds)
 {
     ztimer_sleep(ZTIMER_USEC, nanoseconds / NS_PER_US);
 }
 
-static inline void xtimer_set(xtimer_t *timer, uint32_t offset)
+static inline void xtimer_tsleep32(xtimer_ticks32_t ticks)
 {
-    ztimer_set(ZTIMER_USEC, timer, offset);
+    xtimer_usleep(ticks.ticks32);
 }
 
-static inline void xtimer_remove(xtimer_t *timer)
+static inline void xtimer_tsleep64(xtimer_ticks64_t ticks)
 {
-    ztimer_remove(ZTIMER_USEC, timer);
+    xtimer_usleep64(ticks.ticks64);
 }
 
-static inline void xtimer_set_msg(xtimer_t *timer, uint32_t offset, msg_t *msg,
-                                  kernel_pid_t target_pid)
+static inline void xtimer_spin(xtimer_ticks32_t ticks)
 {
-    ztimer_set_msg(ZTIMER_USEC, timer, offset, msg, target_pid);
+    uint32_t start = ztimer_now(ZTIMER_USEC);
+
+    while ((uint32_t)(ztimer_now(ZTIMER_USEC) - start) < ticks.ticks32) {}
 }
 
 static inline void xtimer_periodic_wakeup(xtimer_ticks32_t *last_wakeup,
                                           uint32_t period)
 {
-    ztimer_periodic_wakeup(ZTIMER_USEC, last_wakeup, period);
+    ztimer_periodic_wakeup(ZTIMER_USEC, &last_wakeup->ticks32, period);
 }
 
-static inline uint32_t xtimer_usec_from_ticks(xtimer_ticks32_t ticks)
+static inline void xtimer_set(xtimer_t *timer, uint32_t offset)
 {
-    return ticks;
+    timer->timer.callback = timer->callback;
+    timer->timer.arg = timer->arg;
+    ztimer_set(ZTIMER_USEC, &timer->timer, offset);
 }
 
-static inline xtimer_ticks32_t xtimer_ticks_from_usec(uint32_t usec)
+static inline void xtimer_set64(xtimer_t *timer, uint64_t offset_us)
 {
-    return usec;
+    if (offset_us <= UINT32_MAX) {
+        xtimer_set(timer, offset_us);
+    }
+    else {
+        ztimer64_set(ZTIMER_USEC, timer, offset_us);
+    }
 }
 
-static inline void xtimer_now_timex(timex_t *out)
+static inline void xtimer_remove(xtimer_t *timer)
 {
-    uint64_t now = xtimer_now_usec64();
+    ztimer_remove(ZTIMER_USEC, &timer->timer);
+}
 
-    out->seconds = div_u64_by_1000000(now);
-    out->microseconds = now - (out->seconds * US_PER_SEC);
+static inline uint64_t xtimer_left_usec(const xtimer_t *timer)
+{
+    uint32_t left = ztimer_left(ZTIMER_USEC, &timer->timer);
+
+    if (left && (timer->timer.arg == timer) &&
+        (timer->timer.callback != timer->callback)) {
+        /* re-armed by ztimer64_set() towards the 64 bit target */
+        return timer->target - ztimer_now(ZTIMER_USEC);
+    }
+    return left;
 }
 
-static inline int xtimer_msg_receive_timeout(msg_t *msg, uint32_t timeout)
+static inline void _xtimer_callback_wakeup(void *arg)
 {
-    return ztimer_msg_receive_timeout(ZTIMER_USEC, msg, timeout);
+    thread_wakeup((kernel_pid_t)((intptr_t)arg));
 }
 
 static inline void xtimer_set_wakeup(xtimer_t *timer, uint32_t offset,
                                      kernel_pid_t pid)
 {
-    ztimer_set_wakeup(ZTIMER_USEC, timer, offset, pid);
+    ztimer_set_wakeup(ZTIMER_USEC, &timer->timer, offset, pid);
 }
 
-/*
-   static inline void xtimer_set64(xtimer_t *timer, uint64_t offset_us);
-   static inline void xtimer_tsleep32(xtimer_ticks32_t ticks);
-   static inline void xtimer_tsleep64(xtimer_ticks64_t ticks);
-   static inline void xtimer_spin(xtimer_ticks32_t ticks);
-   static inline void xtimer_periodic_wakeup(xtimer_ticks32_t *last_wakeup,
-                                          uint32_t period);
-   static inline void xtimer_set_wakeup64(xtimer_t *timer, uint64_t offset,
-                                       kernel_pid_t pid);
-   static inline xtimer_ticks32_t xtimer_ticks_from_usec(uint32_t usec);
-   static inline xtimer_ticks64_t xtimer_ticks_from_usec64(uint64_t usec);
-   static inline uint32_t xtimer_usec_from_ticks(xtimer_ticks32_t ticks);
-   static inline uint64_t xtimer_usec_from_ticks64(xtimer_ticks64_t ticks);
-   static inline xtimer_ticks32_t xtimer_ticks(uint32_t ticks);
-   static inline xtimer_ticks64_t xtimer_ticks64(uint64_t ticks);
-   static inline xtimer_ticks32_t xtimer_diff(xtimer_ticks32_t a,
-                                           xtimer_ticks32_t b);
-   static inline xtimer_ticks64_t xtimer_diff64(xtimer_ticks64_t a,
-                                             xtimer_ticks64_t b);
-   static inline xtimer_ticks32_t xtimer_diff32_64(xtimer_ticks64_t a,
-                                                xtimer_ticks64_t b);
-   static inline bool xtimer_less(xtimer_ticks32_t a, xtimer_ticks32_t b);
-   static inline bool xtimer_less64(xtimer_ticks64_t a, xtimer_ticks64_t b);
-   int xtimer_mutex_lock_timeout(mutex_t *mutex, uint64_t us);
-   void xtimer_set_timeout_flag(xtimer_t *t, uint32_t timeout);
-
- #if defined(MODULE_CORE_MSG) || defined(DOXYGEN)
-   static inline void xtimer_set_msg64(xtimer_t *timer, uint64_t offset,
-                                    msg_t *msg, kernel_pid_t target_pid);
-   static inline int xtimer_msg_receive_timeout64(msg_t *msg, uint64_t timeout);
- #endif
- */
+static inline void xtimer_set_wakeup64(xtimer_t *timer, uint64_t offset,
+                                       kernel_pid_t pid)
+{
+    timer->callback = _xtimer_callback_wakeup;
+    timer->arg = (void *)((intptr_t)pid);
+    xtimer_set64(timer, offset);
+}
+
+static inline int xtimer_mutex_lock_timeout(mutex_t *mutex, uint64_t us)
+{
+    while (us > UINT32_MAX) {
+        if (ztimer_mutex_lock_timeout(ZTIMER_USEC, mutex, UINT32_MAX) == 0) {
+            return 0;
+        }
+        us -= UINT32_MAX;
+    }
+    return (ztimer_mutex_lock_timeout(ZTIMER_USEC, mutex, us) == 0) ? 0 : -1;
+}
+
+static inline int xtimer_rmutex_lock_timeout(rmutex_t *rmutex, uint64_t us)
+{
+    while (us > UINT32_MAX) {
+        if (ztimer_rmutex_lock_timeout(ZTIMER_USEC, rmutex, UINT32_MAX) == 0) {
+            return 0;
+        }
+        us -= UINT32_MAX;
+    }
+    return (ztimer_rmutex_lock_timeout(ZTIMER_USEC, rmutex, us) == 0) ? 0 : -1;
+}
+
+#ifdef MODULE_CORE_THREAD_FLAGS
+static inline void _xtimer_callback_timeout_flag(void *arg)
+{
+    thread_flags_set(arg, THREAD_FLAG_TIMEOUT);
+}
+
+static inline void xtimer_set_timeout_flag(xtimer_t *t, uint32_t timeout)
+{
+    ztimer_set_timeout_flag(ZTIMER_USEC, &t->timer, timeout);
+}
+
+static inline void xtimer_set_timeout_flag64(xtimer_t *t, uint64_t timeout)
+{
+    t->callback = _xtimer_callback_timeout_flag;
+    t->arg = (thread_t *)sched_active_thread;
+    thread_flags_clear(THREAD_FLAG_TIMEOUT);
+    xtimer_set64(t, timeout);
+}
+#endif
+
+#ifdef MODULE_CORE_MSG
+static inline void _xtimer_callback_msg(void *arg)
+{
+    msg_t *msg = (msg_t *)arg;
+
+    msg_send_int(msg, msg->sender_pid);
+}
+
+static inline void xtimer_set_msg(xtimer_t *timer, uint32_t offset, msg_t *msg,
+                                  kernel_pid_t target_pid)
+{
+    ztimer_set_msg(ZTIMER_USEC, &timer->timer, offset, msg, target_pid);
+}
+
+static inline void xtimer_set_msg64(xtimer_t *timer, uint64_t offset,
+                                    msg_t *msg, kernel_pid_t target_pid)
+{
+    /* use sender_pid field to get target_pid into callback function */
+    msg->sender_pid = target_pid;
+    timer->callback = _xtimer_callback_msg;
+    timer->arg = msg;
+    xtimer_set64(timer, offset);
+}
+
+static inline int xtimer_msg_receive_timeout(msg_t *msg, uint32_t timeout)
+{
+    return ztimer_msg_receive_timeout(ZTIMER_USEC, msg, timeout);
+}
+
+static inline int xtimer_msg_receive_timeout64(msg_t *msg, uint64_t timeout)
+{
+    while (timeout > UINT32_MAX) {
+        if (ztimer_msg_receive_timeout(ZTIMER_USEC, msg, UINT32_MAX) >= 0) {
+            return 1;
+        }
+        timeout -= UINT32_MAX;
+    }
+    return ztimer_msg_receive_timeout(ZTIMER_USEC, msg, timeout);
+}
+#endif /* MODULE_CORE_MSG */
 
 #endif /* DOXYGEN */
 
@@ -0,0 +1,426 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_log_deferred
+ * @{
+ *
+ * @file
+ * @brief       Deferred log module implementation
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "irq.h"
+#include "log.h"
+#include "ringbuffer.h"
+#include "thread.h"
+#include "thread_flags.h"
+
+#define LOG_DEFERRED_FLAG   (0x0001)
+
+/* maximum length of a single conversion specification with inlined '*' */
+#define SPEC_MAX            (24U)
+
+/* how an argument is stored */
+enum {
+    ARG_NONE,       /* "%%" */
+    ARG_INT,
+    ARG_LONG,
+    ARG_LLONG,
+    ARG_SIZE,
+    ARG_PTR,
+    ARG_DOUBLE,
+    ARG_LDOUBLE,
+    ARG_STR,
+};
+
+typedef struct {
+    const char *start;  /* the '%' */
+    const char *end;    /* behind the conversion character */
+    uint8_t type;       /* how the argument is stored */
+    uint8_t stars;      /* number of '*' for width and precision */
+} _spec_t;
+
+typedef struct {
+    const char *format;
+    uint16_t len;       /* size of the stored arguments */
+    uint8_t level;
+    uint8_t specs;      /* number of stored conversions, 0xff for all */
+} _hdr_t;
+
+static char _buf[CONFIG_LOG_DEFERRED_BUFSIZE];
+static ringbuffer_t _rb = RINGBUFFER_INIT(_buf);
+static unsigned _dropped;
+static thread_t *_thread;
+static char _stack[LOG_DEFERRED_STACKSIZE];
+
+static bool _next_spec(const char *fmt, _spec_t *spec)
+{
+    const char *p = strchr(fmt, '%');
+
+    if (p == NULL) {
+        return false;
+    }
+    spec->start = p++;
+    spec->stars = 0;
+
+    while (*p && strchr("-+ #0", *p)) {
+        p++;
+    }
+    for (unsigned i = 0; i < 2; i++) {
+        /* width, then precision */
+        if (*p == '*') {
+            spec->stars++;
+            p++;
+        }
+        while (*p >= '0' && *p <= '9') {
+            p++;
+        }
+        if (i == 0 && *p == '.') {
+            p++;
+            continue;
+        }
+        break;
+    }
+
+    unsigned longs = 0;
+    uint8_t size_type = 0;
+    while (*p && strchr("hljztL", *p)) {
+        switch (*p) {
+            case 'l':
+                longs++;
+                break;
+            case 'j':
+                longs = 2;
+                break;
+            case 'z':
+            case 't':
+                size_type = ARG_SIZE;
+                break;
+            case 'L':
+                size_type = ARG_LDOUBLE;
+                break;
+        }
+        p++;
+    }
+
+    switch (*p) {
+        case '%':
+            spec->type = ARG_NONE;
+            break;
+        case 's':
+            spec->type = ARG_STR;
+            break;
+        case 'p':
+        case 'n':
+            spec->type = ARG_PTR;
+            break;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            spec->type = (size_type == ARG_LDOUBLE) ? ARG_LDOUBLE : ARG_DOUBLE;
+            break;
+        case '\0':
+            /* incomplete specification at the end of the format string */
+            spec->type = ARG_NONE;
+            spec->end = p;
+            return true;
+        default:
+            if (size_type == ARG_SIZE) {
+                spec->type = ARG_SIZE;
+            }
+            else {
+                spec->type = (longs >= 2) ? ARG_LLONG
+                           : (longs == 1) ? ARG_LONG : ARG_INT;
+            }
+            break;
+    }
+    spec->end = p + 1;
+
+    return true;
+}
+
+static bool _put(uint8_t *args, size_t *len, const void *val, size_t size)
+{
+    if (*len + size > CONFIG_LOG_DEFERRED_ARGS_SIZE) {
+        return false;
+    }
+    memcpy(&args[*len], val, size);
+    *len += size;
+    return true;
+}
+
+static bool _store_arg(uint8_t *args, size_t *len, uint8_t type, va_list *ap)
+{
+    switch (type) {
+        case ARG_INT: {
+            int v = va_arg(*ap, int);
+            return _put(args, len, &v, sizeof(v));
+        }
+        case ARG_LONG: {
+            long v = va_arg(*ap, long);
+            return _put(args, len, &v, sizeof(v));
+        }
+        case ARG_LLONG: {
+            long long v = va_arg(*ap, long long);
+            return _put(args, len, &v, sizeof(v));
+        }
+        case ARG_SIZE: {
+            size_t v = va_arg(*ap, size_t);
+            return _put(args, len, &v, sizeof(v));
+        }
+        case ARG_PTR: {
+            void *v = va_arg(*ap, void *);
+            return _put(args, len, &v, sizeof(v));
+        }
+        case ARG_DOUBLE: {
+            double v = va_arg(*ap, double);
+            return _put(args, len, &v, sizeof(v));
+        }
+        case ARG_LDOUBLE: {
+            long double v = va_arg(*ap, long double);
+            return _put(args, len, &v, sizeof(v));
+        }
+        case ARG_STR: {
+            const char *s = va_arg(*ap, const char *);
+            if (s == NULL) {
+                s = "(null)";
+            }
+            uint8_t n = strnlen(s, CONFIG_LOG_DEFERRED_STR_MAX);
+            size_t old = *len;
+            if (_put(args, len, &n, sizeof(n)) && _put(args, len, s, n)) {
+                return true;
+            }
+            *len = old;
+            return false;
+        }
+        default:
+            return true;
+    }
+}
+
+void log_write(unsigned level, const char *format, ...)
+{
+    _hdr_t hdr = { .format = format, .level = level, .specs = UINT8_MAX };
+    uint8_t args[CONFIG_LOG_DEFERRED_ARGS_SIZE];
+    size_t len = 0;
+    const char *p = format;
+    _spec_t spec;
+    va_list ap;
+
+    va_start(ap, format);
+    for (unsigned n = 0; _next_spec(p, &spec); n++) {
+        bool stored = true;
+        for (unsigned i = 0; stored && i < spec.stars; i++) {
+            stored = _store_arg(args, &len, ARG_INT, &ap);
+        }
+        if (!stored || !_store_arg(args, &len, spec.type, &ap)) {
+            hdr.specs = n;
+            break;
+        }
+        p = spec.end;
+    }
+    va_end(ap);
+    hdr.len = len;
+
+    unsigned state = irq_disable();
+    if (ringbuffer_get_free(&_rb) < sizeof(hdr) + len) {
+        _dropped++;
+        irq_restore(state);
+        return;
+    }
+    ringbuffer_add(&_rb, (char *)&hdr, sizeof(hdr));
+    ringbuffer_add(&_rb, (char *)args, len);
+    irq_restore(state);
+
+    if (_thread) {
+        thread_flags_set(_thread, LOG_DEFERRED_FLAG);
+    }
+}
+
+/* copies the specification and replaces '*' by the stored values */
+static bool _build_spec(char *buf, const _spec_t *spec, const uint8_t **args)
+{
+    size_t len = 0;
+
+    for (const char *p = spec->start; p < spec->end; p++) {
+        if (*p == '*') {
+            int v;
+            memcpy(&v, *args, sizeof(v));
+            *args += sizeof(v);
+            len += snprintf(&buf[len], SPEC_MAX - len, "%d", v);
+        }
+        else if (len < SPEC_MAX) {
+            buf[len++] = *p;
+        }
+        if (len >= SPEC_MAX) {
+            return false;
+        }
+    }
+    buf[len] = '\0';
+    return true;
+}
+
+/* fetches a stored argument of type t and prints it, unless fmt is NULL */
+#define _PRINT_ARG(t)                   \
+    do {                                \
+        t v;                            \
+        memcpy(&v, *args, sizeof(v));   \
+        *args += sizeof(v);             \
+        if (fmt) {                      \
+            printf(fmt, v);             \
+        }                               \
+    } while (0)
+
+/* Temporarily disable clang format-nonliteral warning */
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wformat-nonliteral"
+#endif /* clang */
+static void _print_arg(const char *fmt, uint8_t type, const uint8_t **args)
+{
+    switch (type) {
+        case ARG_NONE:
+            /* "%%", or an incomplete specification at the end of the format
+             * string that is printed as is */
+            if (fmt) {
+                fputs((fmt[1] == '%') ? "%" : fmt, stdout);
+            }
+            break;
+        case ARG_INT:
+            _PRINT_ARG(int);
+            break;
+        case ARG_LONG:
+            _PRINT_ARG(long);
+            break;
+        case ARG_LLONG:
+            _PRINT_ARG(long long);
+            break;
+        case ARG_SIZE:
+            _PRINT_ARG(size_t);
+            break;
+        case ARG_PTR:
+            if (fmt && fmt[strlen(fmt) - 1] == 'n') {
+                /* not supported, would write to memory that might be gone */
+                fmt = NULL;
+            }
+            _PRINT_ARG(void *);
+            break;
+        case ARG_DOUBLE:
+            _PRINT_ARG(double);
+            break;
+        case ARG_LDOUBLE:
+            _PRINT_ARG(long double);
+            break;
+        case ARG_STR: {
+            char s[CONFIG_LOG_DEFERRED_STR_MAX + 1];
+            uint8_t n = **args;
+            memcpy(s, *args + 1, n);
+            s[n] = '\0';
+            *args += 1 + n;
+            if (fmt) {
+                printf(fmt, s);
+            }
+            break;
+        }
+    }
+}
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif /* clang */
+
+static void _print(const _hdr_t *hdr, const uint8_t *args)
+{
+    const char *p = hdr->format;
+    char fmt[SPEC_MAX + 1];
+    _spec_t spec;
+
+    for (unsigned n = 0; _next_spec(p, &spec); n++) {
+        printf("%.*s", (int)(spec.start - p), p);
+        if (n == hdr->specs) {
+            puts("[...]");
+            return;
+        }
+        /* an overlong specification is skipped, but its argument still
+         * has to be consumed */
+        _print_arg(_build_spec(fmt, &spec, &args) ? fmt : NULL, spec.type,
+                   &args);
+        p = spec.end;
+    }
+    printf("%s", p);
+}
+
+void log_deferred_flush(void)
+{
+    _hdr_t hdr;
+    uint8_t args[CONFIG_LOG_DEFERRED_ARGS_SIZE];
+
+    while (1) {
+        unsigned state = irq_disable();
+        unsigned dropped = _dropped;
+        _dropped = 0;
+        if (ringbuffer_empty(&_rb)) {
+            irq_restore(state);
+            if (dropped) {
+                printf("log: %u messages dropped\n", dropped);
+            }
+            break;
+        }
+        ringbuffer_get(&_rb, (char *)&hdr, sizeof(hdr));
+        ringbuffer_get(&_rb, (char *)args, hdr.len);
+        irq_restore(state);
+
+        if (dropped) {
+            printf("log: %u messages dropped\n", dropped);
+        }
+        _print(&hdr, args);
+    }
+
+#ifdef MODULE_NEWLIB
+    /* no fflush on msp430 */
+    fflush(stdout);
+#endif
+}
+
+static void *_flush_thread(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        thread_flags_wait_any(LOG_DEFERRED_FLAG);
+        log_deferred_flush();
+    }
+
+    return NULL;
+}
+
+void log_deferred_init(void)
+{
+    kernel_pid_t pid = thread_create(_stack, sizeof(_stack), LOG_DEFERRED_PRIO,
+                                     THREAD_CREATE_STACKTEST, _flush_thread,
+                                     NULL, "log");
+
+    _thread = (thread_t *)thread_get(pid);
+    /* messages logged before the thread was started */
+    thread_flags_set(_thread, LOG_DEFERRED_FLAG);
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_log_deferred Deferred log module
+ * @ingroup     sys
+ * @brief       This module implements a logging module that formats and
+ *              prints messages in a low priority thread
+ *
+ * `log_write()` only parses the format string to fetch the arguments and
+ * stores the pointer to the format string together with the raw arguments in
+ * a ring buffer of @ref CONFIG_LOG_DEFERRED_BUFSIZE bytes. Strings passed with
+ * `%s` are copied, truncated to @ref CONFIG_LOG_DEFERRED_STR_MAX characters.
+ * Formatting and printing happens in a thread with priority
+ * @ref LOG_DEFERRED_PRIO, so logging neither blocks the caller on stdio nor
+ * distorts the timing of higher priority threads. It is also safe to log from
+ * ISRs.
+ *
+ * Messages that do not fit into the buffer are dropped, the number of dropped
+ * messages is printed with the next flushed message. Messages with more
+ * arguments than fit into @ref CONFIG_LOG_DEFERRED_ARGS_SIZE bytes are printed
+ * up to the last stored argument, followed by `[...]`.
+ *
+ * @note    The format string must stay valid until the message is flushed,
+ *          which is the case for string literals.
+ * @note    `%n` is not supported.
+ *
+ * @{
+ *
+ * @file
+ * @brief       log_module header
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+
+#ifndef LOG_MODULE_H
+#define LOG_MODULE_H
+
+#include "log.h"
+#include "thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Size of the message ring buffer in bytes
+ */
+#ifndef CONFIG_LOG_DEFERRED_BUFSIZE
+#define CONFIG_LOG_DEFERRED_BUFSIZE     (1024U)
+#endif
+
+/**
+ * @brief   Maximum size of the arguments of a single message in bytes
+ */
+#ifndef CONFIG_LOG_DEFERRED_ARGS_SIZE
+#define CONFIG_LOG_DEFERRED_ARGS_SIZE   (64U)
+#endif
+
+/**
+ * @brief   Maximum length of a string argument
+ */
+#ifndef CONFIG_LOG_DEFERRED_STR_MAX
+#define CONFIG_LOG_DEFERRED_STR_MAX     (32U)
+#endif
+
+/**
+ * @brief   Priority of the thread printing the messages
+ */
+#ifndef LOG_DEFERRED_PRIO
+#define LOG_DEFERRED_PRIO               (THREAD_PRIORITY_IDLE - 1)
+#endif
+
+/**
+ * @brief   Stack size of the thread printing the messages
+ */
+#ifndef LOG_DEFERRED_STACKSIZE
+#define LOG_DEFERRED_STACKSIZE          (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @brief   Store a log message for deferred printing
+ *
+ * @param[in]   level   log level of the message
+ * @param[in]   format  printf format string
+ */
+void log_write(unsigned level, const char *format, ...);
+
+/**
+ * @brief   Print all pending messages in the context of the caller
+ *
+ * Can be used e.g. before a reboot or from a panic handler.
+ */
+void log_deferred_flush(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* LOG_MODULE_H */
+/** @} */
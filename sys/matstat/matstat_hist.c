@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_matstat
+ * @{
+ *
+ * @file
+ * @brief       Log-linear histograms
+ *
+ * Values below 2^sub_bits have a bucket each. Above, every power of two is
+ * split into 2^sub_bits buckets of equal width.
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "bitarithm.h"
+#include "matstat.h"
+
+void matstat_hist_init(matstat_hist_t *hist, uint32_t *buckets, size_t numof,
+                       unsigned sub_bits)
+{
+    memset(buckets, 0, numof * sizeof(*buckets));
+    hist->buckets = buckets;
+    hist->count = 0;
+    hist->numof = numof;
+    hist->sub_bits = sub_bits;
+}
+
+static size_t _index(const matstat_hist_t *hist, uint32_t value)
+{
+    unsigned sub = hist->sub_bits;
+    size_t idx;
+
+    if (value < (1UL << sub)) {
+        idx = value;
+    }
+    else {
+        unsigned shift = bitarithm_msb(value) - sub;
+
+        idx = ((size_t)(shift + 1) << sub) + (value >> shift) - (1UL << sub);
+    }
+    return (idx < hist->numof) ? idx : hist->numof - 1U;
+}
+
+/* largest value counted in bucket idx */
+static uint32_t _upper(const matstat_hist_t *hist, size_t idx)
+{
+    unsigned sub = hist->sub_bits;
+
+    if (idx == hist->numof - 1U) {
+        return UINT32_MAX;
+    }
+    if (idx < (1UL << sub)) {
+        return idx;
+    }
+
+    unsigned shift = (idx >> sub) - 1;
+    uint64_t lower = ((1ULL << sub) + (idx & ((1UL << sub) - 1))) << shift;
+
+    return lower + (1ULL << shift) - 1;
+}
+
+void matstat_hist_add(matstat_hist_t *hist, uint32_t value)
+{
+    hist->buckets[_index(hist, value)]++;
+    hist->count++;
+}
+
+uint32_t matstat_hist_quantile(const matstat_hist_t *hist, uint16_t p)
+{
+    /* rank of the quantile, starting at 1 */
+    uint32_t rank = (((uint64_t)hist->count * p) >> 16) + 1;
+    uint32_t seen = 0;
+
+    if (hist->count == 0) {
+        return 0;
+    }
+    for (size_t i = 0; i < hist->numof; i++) {
+        seen += hist->buckets[i];
+        if (seen >= rank) {
+            return _upper(hist, i);
+        }
+    }
+    return UINT32_MAX;
+}
+
+int matstat_hist_merge(matstat_hist_t *dest, const matstat_hist_t *src)
+{
+    if ((dest->numof != src->numof) || (dest->sub_bits != src->sub_bits)) {
+        return -1;
+    }
+    for (size_t i = 0; i < dest->numof; i++) {
+        dest->buckets[i] += src->buckets[i];
+    }
+    dest->count += src->count;
+    return 0;
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_matstat
+ * @{
+ *
+ * @file
+ * @brief       P² quantile estimator
+ *
+ * R. Jain and I. Chlamtac, "The P² algorithm for dynamic calculation of
+ * quantiles and histograms without storing observations", 1985
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "matstat.h"
+
+void matstat_p2_init(matstat_p2_t *p2, uint16_t p)
+{
+    memset(p2, 0, sizeof(*p2));
+    p2->p = p;
+}
+
+/* piecewise-parabolic prediction of the height of marker i moved by ds */
+static int64_t _parabolic(const matstat_p2_t *p2, unsigned i, int ds)
+{
+    const int32_t *q = p2->q;
+    const int32_t *n = p2->n;
+    int64_t a = (int64_t)(n[i] - n[i - 1] + ds) * ((int64_t)q[i + 1] - q[i]) /
+                (n[i + 1] - n[i]);
+    int64_t b = (int64_t)(n[i + 1] - n[i] - ds) * ((int64_t)q[i] - q[i - 1]) /
+                (n[i] - n[i - 1]);
+
+    return q[i] + ds * (a + b) / (n[i + 1] - n[i - 1]);
+}
+
+void matstat_p2_add(matstat_p2_t *p2, int32_t value)
+{
+    int32_t *q = p2->q;
+    int32_t *n = p2->n;
+    /* increments of the desired positions of the inner markers in 1/65536 */
+    const uint32_t dn[3] = { p2->p / 2, p2->p, (0x10000UL + p2->p) / 2 };
+    unsigned k;
+
+    if (p2->count < 5) {
+        /* the first samples are kept sorted */
+        unsigned i = p2->count++;
+
+        while ((i > 0) && (q[i - 1] > value)) {
+            q[i] = q[i - 1];
+            i--;
+        }
+        q[i] = value;
+        if (p2->count == 5) {
+            for (i = 0; i < 5; i++) {
+                n[i] = i;
+            }
+        }
+        return;
+    }
+
+    /* find the cell of value and adjust the extreme markers */
+    if (value < q[0]) {
+        q[0] = value;
+        k = 0;
+    }
+    else if (value >= q[4]) {
+        q[4] = value;
+        k = 3;
+    }
+    else {
+        for (k = 0; value >= q[k + 1]; k++) {}
+    }
+    for (unsigned i = k + 1; i < 5; i++) {
+        n[i]++;
+    }
+    p2->count++;
+
+    /* move the inner markers towards their desired positions */
+    for (unsigned i = 1; i < 4; i++) {
+        int64_t d = (int64_t)(p2->count - 1) * dn[i - 1] - ((int64_t)n[i] << 16);
+        int ds;
+
+        if ((d >= 0x10000) && (n[i + 1] - n[i] > 1)) {
+            ds = 1;
+        }
+        else if ((d <= -0x10000) && (n[i - 1] - n[i] < -1)) {
+            ds = -1;
+        }
+        else {
+            continue;
+        }
+
+        int64_t qp = _parabolic(p2, i, ds);
+
+        if ((q[i - 1] < qp) && (qp < q[i + 1])) {
+            q[i] = qp;
+        }
+        else {
+            /* linear prediction keeps the heights monotonic */
+            q[i] += ds * ((int64_t)q[i + ds] - q[i]) / (n[i + ds] - n[i]);
+        }
+        n[i] += ds;
+    }
+}
+
+int32_t matstat_p2_get(const matstat_p2_t *p2)
+{
+    if (p2->count == 0) {
+        return 0;
+    }
+    if (p2->count <= 5) {
+        return p2->q[((p2->count - 1) * p2->p + 0x8000) >> 16];
+    }
+    return p2->q[2];
+}
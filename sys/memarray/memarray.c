@@ -6,12 +6,60 @@
  * directory for more details.
  */
 
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <string.h>
+
+#include "irq.h"
 #include "memarray.h"
 
+/* exclusive load/store instructions: a store to the free list head fails if
+ * anything happened in between, including an interrupt, so reading the next
+ * pointer of the head is safe from ABA problems */
+#if (defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || \
+     defined(__ARM_ARCH_8M_MAIN__)) && !IS_USED(MODULE_MEMARRAY_STATS)
+#include "cpu.h"
+#define MEMARRAY_LOCK_FREE  (1)
+#endif
+
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+static void _poison(const memarray_t *mem, void *ptr)
+{
+#if IS_USED(MODULE_MEMARRAY_DEBUG)
+    memset((char *)ptr + sizeof(void *), MEMARRAY_POISON,
+           mem->size - sizeof(void *));
+#else
+    (void)mem;
+    (void)ptr;
+#endif
+}
+
+static void _check(const memarray_t *mem, const void *ptr, bool poisoned)
+{
+#if IS_USED(MODULE_MEMARRAY_DEBUG)
+    size_t offset = (const char *)ptr - (const char *)mem->data;
+
+    /* element of this pool */
+    assert(((const char *)ptr >= (const char *)mem->data) &&
+           (offset < (mem->size * mem->num)) &&
+           ((offset % mem->size) == 0));
+
+    if (poisoned) {
+        /* no writes after the element was freed */
+        for (size_t i = sizeof(void *); i < mem->size; i++) {
+            assert(((const uint8_t *)ptr)[i] == MEMARRAY_POISON);
+        }
+    }
+#else
+    (void)mem;
+    (void)ptr;
+    (void)poisoned;
+#endif
+}
+
 void memarray_init(memarray_t *mem, void *data, size_t size, size_t num)
 {
     assert((mem != NULL) && (data != NULL) && (size >= sizeof(void *)) &&
@@ -23,23 +71,56 @@ void memarray_init(memarray_t *mem, void *data, size_t size, size_t num)
     mem->free_data = data;
     mem->size = size;
     mem->num = num;
+#if IS_USED(MODULE_MEMARRAY_DEBUG)
+    mem->data = data;
+#endif
+#if IS_USED(MODULE_MEMARRAY_STATS)
+    mem->used = 0;
+    mem->used_max = 0;
+#endif
 
     for (size_t i = 0; i < (mem->num - 1); i++) {
         void *next = ((char *)mem->free_data) + ((i + 1) * mem->size);
         memcpy(((char *)mem->free_data) + (i * mem->size), &next, sizeof(void *));
+        _poison(mem, ((char *)mem->free_data) + (i * mem->size));
     }
     memset(((char *)mem->free_data) + ((mem->num - 1) * (mem->size)), 0, sizeof(void *));
+    _poison(mem, ((char *)mem->free_data) + ((mem->num - 1) * (mem->size)));
 }
 
 void *memarray_alloc(memarray_t *mem)
 {
     assert(mem != NULL);
 
-    if (mem->free_data == NULL) {
+    void *free;
+
+#ifdef MEMARRAY_LOCK_FREE
+    void *next;
+    do {
+        free = (void *)__LDREXW((uint32_t *)&mem->free_data);
+        if (free == NULL) {
+            __CLREX();
+            return NULL;
+        }
+        next = *((void **)free);
+    } while (__STREXW((uint32_t)next, (uint32_t *)&mem->free_data));
+#else
+    unsigned state = irq_disable();
+    free = mem->free_data;
+    if (free == NULL) {
+        irq_restore(state);
         return NULL;
     }
-    void *free = mem->free_data;
-    mem->free_data = *((void **)mem->free_data);
+    mem->free_data = *((void **)free);
+#if IS_USED(MODULE_MEMARRAY_STATS)
+    if (++mem->used > mem->used_max) {
+        mem->used_max = mem->used;
+    }
+#endif
+    irq_restore(state);
+#endif
+
+    _check(mem, free, true);
     DEBUG("memarray: Allocate %u Bytes at %p\n", (unsigned)mem->size, free);
     return free;
 }
@@ -48,7 +129,36 @@ void memarray_free(memarray_t *mem, void *ptr)
 {
     assert((mem != NULL) && (ptr != NULL));
 
+    _check(mem, ptr, false);
+    _poison(mem, ptr);
+
+#ifdef MEMARRAY_LOCK_FREE
+    void *head;
+    do {
+        head = (void *)__LDREXW((uint32_t *)&mem->free_data);
+        memcpy(ptr, &head, sizeof(void *));
+    } while (__STREXW((uint32_t)ptr, (uint32_t *)&mem->free_data));
+#else
+    unsigned state = irq_disable();
     memcpy(ptr, &mem->free_data, sizeof(void *));
     mem->free_data = ptr;
+#if IS_USED(MODULE_MEMARRAY_STATS)
+    mem->used--;
+#endif
+    irq_restore(state);
+#endif
+
     DEBUG("memarray: Free %u Bytes at %p\n", (unsigned)mem->size, ptr);
 }
+
+#if IS_USED(MODULE_MEMARRAY_STATS)
+void memarray_stats(const memarray_t *mem, memarray_stats_t *stats)
+{
+    assert((mem != NULL) && (stats != NULL));
+
+    unsigned state = irq_disable();
+    stats->used = mem->used;
+    stats->used_max = mem->used_max;
+    irq_restore(state);
+}
+#endif
@@ -0,0 +1,229 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_metrics
+ * @{
+ *
+ * @file
+ * @brief       Metrics registry implementation
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "fmt.h"
+#include "irq.h"
+#include "metrics.h"
+
+static metrics_group_t *_groups;
+
+#ifdef MODULE_ENERGY
+#include "energy.h"
+#endif
+
+#ifdef MODULE_GNRC_IPV6_EXT_FRAG_STATS
+extern metrics_group_t gnrc_ipv6_ext_frag_metrics;
+#endif
+#ifdef MODULE_GNRC_IPV6_NIB
+extern metrics_group_t gnrc_ipv6_nib_metrics;
+#endif
+#ifdef MODULE_GNRC_NETIF_IPV6
+extern metrics_group_t gnrc_netif_ipv6_metrics;
+#endif
+#ifdef MODULE_GNRC_PKTBUF_STATIC
+extern metrics_group_t gnrc_pktbuf_metrics;
+#endif
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+extern metrics_group_t gnrc_sixlowpan_frag_metrics;
+#endif
+#ifdef MODULE_SCHEDSTATISTICS
+extern metrics_group_t schedstat_metrics;
+#endif
+#ifdef MODULE_SCHEDSTATISTICS_EXT
+extern metrics_group_t schedstat_ext_metrics;
+#endif
+
+void metrics_init(void)
+{
+    /* statistics of modules without an init function of their own */
+#if defined(MODULE_ENERGY) && defined(MODULE_PM_LAYERED)
+    metrics_register(&energy_cpu.group);
+#endif
+#if defined(MODULE_ENERGY) && defined(MODULE_GNRC_NETIF)
+    metrics_register(&energy_radio.group);
+#endif
+#if defined(MODULE_ENERGY) && defined(MODULE_MTD)
+    metrics_register(&energy_mtd.group);
+#endif
+#ifdef MODULE_GNRC_IPV6_EXT_FRAG_STATS
+    metrics_register(&gnrc_ipv6_ext_frag_metrics);
+#endif
+#ifdef MODULE_GNRC_IPV6_NIB
+    metrics_register(&gnrc_ipv6_nib_metrics);
+#endif
+#ifdef MODULE_GNRC_NETIF_IPV6
+    metrics_register(&gnrc_netif_ipv6_metrics);
+#endif
+#ifdef MODULE_GNRC_PKTBUF_STATIC
+    metrics_register(&gnrc_pktbuf_metrics);
+#endif
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+    metrics_register(&gnrc_sixlowpan_frag_metrics);
+#endif
+#ifdef MODULE_SCHEDSTATISTICS
+    metrics_register(&schedstat_metrics);
+#endif
+#ifdef MODULE_SCHEDSTATISTICS_EXT
+    metrics_register(&schedstat_ext_metrics);
+#endif
+}
+
+void metrics_register(metrics_group_t *group)
+{
+    unsigned state = irq_disable();
+    metrics_group_t **prev = &_groups;
+
+    /* append to keep the order of registration on export */
+    while (*prev) {
+        prev = &(*prev)->next;
+    }
+    group->next = NULL;
+    *prev = group;
+    irq_restore(state);
+}
+
+void metrics_unregister(metrics_group_t *group)
+{
+    unsigned state = irq_disable();
+
+    for (metrics_group_t **prev = &_groups; *prev; prev = &(*prev)->next) {
+        if (*prev == group) {
+            *prev = group->next;
+            break;
+        }
+    }
+    irq_restore(state);
+}
+
+metrics_group_t *metrics_groups(void)
+{
+    return _groups;
+}
+
+static const void *_ptr(const metrics_group_t *group, unsigned instance,
+                        const metrics_entry_t *entry)
+{
+    return (const uint8_t *)group->base + instance * group->stride +
+           entry->offset;
+}
+
+int64_t metrics_read(const metrics_group_t *group, unsigned instance,
+                     const metrics_entry_t *entry)
+{
+    const void *ptr = _ptr(group, instance, entry);
+
+    switch (entry->type) {
+        case METRICS_COUNTER:
+        case METRICS_U32:
+            return __atomic_load_n((const uint32_t *)ptr, __ATOMIC_RELAXED);
+        case METRICS_GAUGE:
+            return __atomic_load_n((const int32_t *)ptr, __ATOMIC_RELAXED);
+        case METRICS_U64: {
+            /* takes more than one load on 32 bit platforms, don't let an
+             * update interrupt them */
+            unsigned state = irq_disable();
+            uint64_t val = *(const volatile uint64_t *)ptr;
+            irq_restore(state);
+            return val;
+        }
+        case METRICS_UINT:
+            return *(const volatile unsigned *)ptr;
+        default:
+            return 0;
+    }
+}
+
+const uint32_t *metrics_buckets(const metrics_group_t *group,
+                                unsigned instance,
+                                const metrics_entry_t *entry,
+                                unsigned *buckets)
+{
+    *buckets = entry->size / sizeof(uint32_t);
+    return _ptr(group, instance, entry);
+}
+
+int metrics_is_zero(const metrics_group_t *group, unsigned instance)
+{
+    for (unsigned i = 0; i < group->numof; i++) {
+        const metrics_entry_t *entry = &group->entries[i];
+
+        if (entry->type == METRICS_HISTOGRAM) {
+            unsigned num;
+            const uint32_t *bucket = metrics_buckets(group, instance, entry,
+                                                     &num);
+            while (num--) {
+                if (bucket[num]) {
+                    return 0;
+                }
+            }
+        }
+        else if (metrics_read(group, instance, entry)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void _print_name(const metrics_group_t *group, unsigned instance,
+                        const metrics_entry_t *entry)
+{
+    if ((group->id < 0) && (group->count <= 1)) {
+        printf("%s.%s", group->name, entry->name);
+    }
+    else {
+        printf("%s[%d].%s", group->name,
+               (group->id < 0 ? 0 : group->id) + (int)instance, entry->name);
+    }
+}
+
+void metrics_print(void)
+{
+    char val[21];
+
+    for (metrics_group_t *group = _groups; group; group = group->next) {
+        for (unsigned inst = 0; inst < group->count; inst++) {
+            if ((group->count > 1) && metrics_is_zero(group, inst)) {
+                continue;
+            }
+            for (unsigned i = 0; i < group->numof; i++) {
+                const metrics_entry_t *entry = &group->entries[i];
+
+                _print_name(group, inst, entry);
+                if (entry->type == METRICS_HISTOGRAM) {
+                    unsigned num;
+                    const uint32_t *bucket = metrics_buckets(group, inst,
+                                                             entry, &num);
+                    for (unsigned b = 0; b < num; b++) {
+                        val[fmt_u32_dec(val, bucket[b])] = '\0';
+                        printf(" %s", val);
+                    }
+                }
+                else {
+                    val[fmt_s64_dec(val, metrics_read(group, inst, entry))] =
+                        '\0';
+                    printf(" %s", val);
+                }
+                puts("");
+            }
+        }
+    }
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_metrics
+ * @{
+ *
+ * @file
+ * @brief       CBOR export of all metrics
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include "metrics.h"
+
+static unsigned _instances(const metrics_group_t *group)
+{
+    unsigned num = 0;
+
+    for (unsigned inst = 0; inst < group->count; inst++) {
+        if ((group->count == 1) || !metrics_is_zero(group, inst)) {
+            num++;
+        }
+    }
+    return num;
+}
+
+static void _encode(nanocbor_encoder_t *enc, const metrics_group_t *group,
+                    unsigned inst)
+{
+    nanocbor_fmt_array(enc, 3);
+    nanocbor_put_tstr(enc, group->name);
+    if ((group->id < 0) && (group->count <= 1)) {
+        nanocbor_fmt_null(enc);
+    }
+    else {
+        nanocbor_fmt_uint(enc, (group->id < 0 ? 0 : group->id) + inst);
+    }
+    nanocbor_fmt_map(enc, group->numof);
+    for (unsigned i = 0; i < group->numof; i++) {
+        const metrics_entry_t *entry = &group->entries[i];
+
+        nanocbor_put_tstr(enc, entry->name);
+        if (entry->type == METRICS_HISTOGRAM) {
+            unsigned num;
+            const uint32_t *bucket = metrics_buckets(group, inst, entry, &num);
+
+            nanocbor_fmt_array(enc, num);
+            for (unsigned b = 0; b < num; b++) {
+                nanocbor_fmt_uint(enc, bucket[b]);
+            }
+        }
+        else {
+            nanocbor_fmt_int(enc, metrics_read(group, inst, entry));
+        }
+    }
+}
+
+size_t metrics_cbor(nanocbor_encoder_t *enc)
+{
+    unsigned num = 0;
+
+    for (metrics_group_t *group = metrics_groups(); group;
+         group = group->next) {
+        num += _instances(group);
+    }
+
+    /* skipped instances may change in between, keep the array well formed */
+    nanocbor_fmt_array(enc, num);
+    for (metrics_group_t *group = metrics_groups(); group && num;
+         group = group->next) {
+        for (unsigned inst = 0; (inst < group->count) && num; inst++) {
+            if ((group->count > 1) && metrics_is_zero(group, inst)) {
+                continue;
+            }
+            _encode(enc, group, inst);
+            num--;
+        }
+    }
+    while (num--) {
+        nanocbor_fmt_null(enc);
+    }
+    return nanocbor_encoded_len(enc);
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_metrics
+ * @{
+ *
+ * @file
+ * @brief       CoAP resource exporting all metrics as CBOR
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include "kernel_defines.h"
+#include "metrics.h"
+#include "net/gcoap.h"
+
+static ssize_t _metrics_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                                void *ctx)
+{
+    (void)ctx;
+
+    gcoap_resp_init(pdu, buf, len, COAP_CODE_CONTENT);
+    coap_opt_add_format(pdu, COAP_FORMAT_CBOR);
+    ssize_t hdr_len = coap_opt_finish(pdu, COAP_OPT_FINISH_PAYLOAD);
+
+    nanocbor_encoder_t enc;
+
+    nanocbor_encoder_init(&enc, pdu->payload, pdu->payload_len);
+    size_t payload_len = metrics_cbor(&enc);
+    if (payload_len > pdu->payload_len) {
+        return gcoap_response(pdu, buf, len, COAP_CODE_INTERNAL_SERVER_ERROR);
+    }
+    return hdr_len + payload_len;
+}
+
+static const coap_resource_t _resources[] = {
+    { "/metrics", COAP_GET, _metrics_handler, NULL },
+};
+
+static gcoap_listener_t _listener = {
+    .resources = _resources,
+    .resources_len = ARRAY_SIZE(_resources),
+    .next = NULL,
+};
+
+void metrics_coap_init(void)
+{
+    gcoap_register_listener(&_listener);
+}
@@ -0,0 +1,232 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_ml_infer
+ * @{
+ *
+ * @file
+ * @brief       Inference manager implementation
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+
+#include "irq.h"
+#include "log.h"
+#include "ml_infer.h"
+#include "mutex.h"
+
+#if IS_USED(MODULE_ZTIMER_MSEC)
+#include "ztimer.h"
+#endif
+
+/* pattern of unused arena words */
+#define ARENA_PAINT     (0xa5a5a5a5U)
+
+static uint32_t _arena[CONFIG_ML_INFER_ARENA_SIZE / sizeof(uint32_t)]
+    __attribute__((aligned(16)));
+static char _stack[ML_INFER_STACKSIZE];
+static event_queue_t _queue;
+
+static ml_infer_model_t *_models;
+/* model currently in the arena */
+static ml_infer_model_t *_loaded;
+/* arena usage of _loaded yet to be measured */
+static bool _measure;
+static volatile bool _cancel;
+
+#if IS_USED(MODULE_METRICS)
+static const metrics_entry_t _entries[] = {
+    METRICS_ENTRY(METRICS_COUNTER, "runs", ml_infer_stats_t, runs),
+    METRICS_ENTRY(METRICS_COUNTER, "errors", ml_infer_stats_t, errors),
+    METRICS_ENTRY(METRICS_COUNTER, "loads", ml_infer_stats_t, loads),
+    METRICS_ENTRY(METRICS_GAUGE, "arena_used", ml_infer_stats_t, arena_used),
+    METRICS_ENTRY(METRICS_GAUGE, "run_ms", ml_infer_stats_t, run_ms),
+};
+#endif
+
+static size_t _arena_used(void)
+{
+    /* the frameworks allocate from both ends of the arena, so the largest
+     * block of untouched words is what the model leaves free */
+    size_t free = 0;
+    size_t run = 0;
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_arena); i++) {
+        if (_arena[i] != ARENA_PAINT) {
+            run = 0;
+        }
+        else if (++run > free) {
+            free = run;
+        }
+    }
+    return sizeof(_arena) - (free * sizeof(uint32_t));
+}
+
+static void _unload(void)
+{
+    if (_loaded && _loaded->driver->unload) {
+        _loaded->driver->unload(_loaded);
+    }
+    _loaded = NULL;
+}
+
+static int _load(ml_infer_model_t *model)
+{
+    _unload();
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_arena); i++) {
+        _arena[i] = ARENA_PAINT;
+    }
+
+    int res = model->driver->load(model, _arena, sizeof(_arena));
+    if (res < 0) {
+        LOG_WARNING("ml_infer: loading %s failed: %d\n", model->name, res);
+        return res;
+    }
+    metrics_counter_inc(&model->stats.loads);
+    _loaded = model;
+    _measure = true;
+    return 0;
+}
+
+static int _run(ml_infer_model_t *model, void *arg)
+{
+#if IS_USED(MODULE_ZTIMER_MSEC)
+    uint32_t start = ztimer_now(ZTIMER_MSEC);
+#endif
+
+    int res = model->driver->run(model, arg);
+    if (res < 0) {
+        if (res == -ECANCELED) {
+            /* the state of the interrupted model is unknown */
+            _unload();
+        }
+        return res;
+    }
+
+#if IS_USED(MODULE_ZTIMER_MSEC)
+    metrics_gauge_set(&model->stats.run_ms, ztimer_now(ZTIMER_MSEC) - start);
+#endif
+    metrics_counter_inc(&model->stats.runs);
+    if (_measure) {
+        _measure = false;
+        metrics_gauge_set(&model->stats.arena_used, _arena_used());
+        LOG_INFO("ml_infer: %s uses %" PRIi32 " of %u bytes of the arena\n",
+                 model->name, model->stats.arena_used,
+                 (unsigned)sizeof(_arena));
+    }
+    return res;
+}
+
+static void _handler(event_t *ev)
+{
+    ml_infer_job_t *job = container_of(ev, ml_infer_job_t, super);
+    ml_infer_model_t *model = job->model;
+
+    ml_infer_register(model);
+    _cancel = false;
+
+    job->res = 0;
+    if (model != _loaded) {
+        job->res = _load(model);
+    }
+    if (job->res == 0) {
+        job->res = _run(model, job->arg);
+    }
+    if (job->res < 0) {
+        metrics_counter_inc(&model->stats.errors);
+    }
+    job->cb(job);
+}
+
+static void *_thread(void *arg)
+{
+    (void)arg;
+
+    event_queue_claim(&_queue);
+    event_loop(&_queue);
+
+    /* should be never reached */
+    return NULL;
+}
+
+void ml_infer_init(void)
+{
+    /* main might queue requests before the thread runs */
+    event_queue_init_detached(&_queue);
+    thread_create(_stack, sizeof(_stack), ML_INFER_PRIO,
+                  THREAD_CREATE_STACKTEST, _thread, NULL, "ml_infer");
+}
+
+void ml_infer_register(ml_infer_model_t *model)
+{
+    unsigned state = irq_disable();
+
+    for (ml_infer_model_t *m = _models; m; m = m->next) {
+        if (m == model) {
+            irq_restore(state);
+            return;
+        }
+    }
+    model->next = _models;
+    _models = model;
+    irq_restore(state);
+
+#if IS_USED(MODULE_METRICS)
+    model->metrics = (metrics_group_t)METRICS_GROUP(model->name, model->stats,
+                                                    _entries);
+    metrics_register(&model->metrics);
+#endif
+}
+
+void ml_infer_post(ml_infer_job_t *job, ml_infer_model_t *model, void *arg,
+                   ml_infer_cb_t cb)
+{
+    job->super.handler = _handler;
+    job->model = model;
+    job->arg = arg;
+    job->cb = cb;
+    event_post(&_queue, &job->super);
+}
+
+typedef struct {
+    ml_infer_job_t job;
+    mutex_t done;
+} _sync_job_t;
+
+static void _sync_cb(ml_infer_job_t *job)
+{
+    mutex_unlock(&container_of(job, _sync_job_t, job)->done);
+}
+
+int ml_infer_run(ml_infer_model_t *model, void *arg)
+{
+    _sync_job_t sync = { .done = MUTEX_INIT_LOCKED };
+
+    ml_infer_post(&sync.job, model, arg, _sync_cb);
+    mutex_lock(&sync.done);
+    return sync.job.res;
+}
+
+int ml_infer_yield(void)
+{
+    thread_yield();
+    return _cancel ? -ECANCELED : 0;
+}
+
+void ml_infer_cancel(void)
+{
+    _cancel = true;
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_msg_buf
+ * @{
+ *
+ * @file
+ * @brief       Zero-copy message buffer implementation
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <assert.h>
+
+#include "irq.h"
+#include "msg_buf.h"
+
+void msg_buf_pool_init(msg_buf_pool_t *pool, void *storage, size_t size,
+                       size_t num)
+{
+    assert(pool && storage && num);
+
+    pool->size = size;
+    memarray_init(&pool->mem, storage, MSG_BUF_BLOCK_SIZE(size), num);
+}
+
+msg_buf_t *msg_buf_alloc(msg_buf_pool_t *pool)
+{
+    unsigned state = irq_disable();
+    msg_buf_t *buf = memarray_alloc(&pool->mem);
+    irq_restore(state);
+
+    if (buf) {
+        buf->pool = pool;
+        buf->len = 0;
+    }
+    return buf;
+}
+
+void msg_buf_free(msg_buf_t *buf)
+{
+    if (buf == NULL) {
+        return;
+    }
+
+    unsigned state = irq_disable();
+    memarray_free(&buf->pool->mem, buf);
+    irq_restore(state);
+}
+
+int msg_buf_send(msg_buf_t *buf, uint16_t type, kernel_pid_t pid)
+{
+    msg_t m = { .type = type, .content.ptr = buf };
+
+    assert(buf && buf->len <= buf->pool->size);
+    return msg_send(&m, pid);
+}
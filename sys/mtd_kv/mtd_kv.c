@@ -0,0 +1,684 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_mtd_kv
+ * @{
+ *
+ * @file
+ * @brief       Wear-levelled key-value store on MTD
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "checksum/crc16_ccitt.h"
+#include "hashes.h"
+#include "mtd_kv.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define MTD_KV_MAGIC        (0x564b544dUL)  /* "MTKV" */
+
+#define SLOT_EMPTY          (0xffffffffUL)
+#define SLOT_DELETED        (0xfffffffeUL)
+
+/* entry flags, a flag is set by clearing its bit */
+#define FLAG_VALID          (0x80)  /* entry has been written */
+#define FLAG_START          (0x04)  /* first entry of a commit */
+#define FLAG_MORE           (0x02)  /* further entries of the commit follow */
+#define FLAG_DELETE         (0x01)  /* entry deletes the key */
+
+/* not covered by the CRC, they change when an entry is moved */
+#define FLAG_COMMIT_MASK    (FLAG_START | FLAG_MORE)
+
+#define CHUNK_SIZE          (32U)
+
+typedef struct {
+    uint32_t magic;
+    uint32_t cycle;
+} _sector_hdr_t;
+
+typedef struct {
+    uint8_t flags;
+    uint8_t key_len;
+    uint16_t val_len;
+    uint16_t crc;
+    uint16_t reserved;
+} _entry_hdr_t;
+
+/* stages writes so they are word aligned and never cross a page */
+typedef struct {
+    mtd_kv_t *kv;
+    uint32_t addr;
+    unsigned fill;
+    uint32_t buf[CHUNK_SIZE / sizeof(uint32_t)];
+} _writer_t;
+
+static uint32_t _sector_addr(const mtd_kv_t *kv, uint32_t sector)
+{
+    return sector * kv->sector_size;
+}
+
+static uint32_t _next_sector(const mtd_kv_t *kv, uint32_t sector)
+{
+    return (sector + 1 == kv->mtd->sector_count) ? 0 : sector + 1;
+}
+
+static uint32_t _entry_size(const _entry_hdr_t *hdr)
+{
+    return (sizeof(*hdr) + hdr->key_len + hdr->val_len + 3) & ~3UL;
+}
+
+static uint16_t _hdr_crc(const _entry_hdr_t *hdr)
+{
+    uint8_t head[4] = { hdr->flags | FLAG_COMMIT_MASK, hdr->key_len };
+
+    memcpy(&head[2], &hdr->val_len, sizeof(hdr->val_len));
+    return crc16_ccitt_calc(head, sizeof(head));
+}
+
+static int _w_flush(_writer_t *w)
+{
+    if (w->fill == 0) {
+        return 0;
+    }
+
+    int res = mtd_write(w->kv->mtd, w->buf, w->addr, w->fill);
+    w->addr += w->fill;
+    w->fill = 0;
+    return res;
+}
+
+static int _w_put(_writer_t *w, const void *data, size_t len)
+{
+    const uint8_t *src = data;
+
+    while (len) {
+        size_t n = sizeof(w->buf) - w->fill;
+        size_t page_left = w->kv->mtd->page_size
+                         - (w->addr + w->fill) % w->kv->mtd->page_size;
+        if (n > page_left) {
+            n = page_left;
+        }
+        if (n > len) {
+            n = len;
+        }
+        memcpy((uint8_t *)w->buf + w->fill, src, n);
+        w->fill += n;
+        src += n;
+        len -= n;
+
+        if ((w->fill == sizeof(w->buf)) ||
+            ((w->addr + w->fill) % w->kv->mtd->page_size == 0)) {
+            int res = _w_flush(w);
+            if (res < 0) {
+                return res;
+            }
+        }
+    }
+    return 0;
+}
+
+/* pad to a word boundary and write out the rest */
+static int _w_finish(_writer_t *w)
+{
+    static const uint8_t pad[3] = { 0xff, 0xff, 0xff };
+
+    int res = _w_put(w, pad, (4 - (w->fill & 3)) & 3);
+    if (res < 0) {
+        return res;
+    }
+    return _w_flush(w);
+}
+
+/* read an entry header and check the entry
+ *
+ * returns the size of the entry, 0 at the end of the sector, -EBADMSG if the
+ * rest of the sector is unusable */
+static int _read_entry(mtd_kv_t *kv, uint32_t addr, uint32_t end,
+                       _entry_hdr_t *hdr, bool *valid)
+{
+    if (addr + sizeof(*hdr) > end) {
+        return 0;
+    }
+
+    int res = mtd_read(kv->mtd, hdr, addr, sizeof(*hdr));
+    if (res < 0) {
+        return res;
+    }
+    if (hdr->flags == 0xff) {
+        return 0;
+    }
+
+    uint32_t size = _entry_size(hdr);
+    if ((hdr->flags & FLAG_VALID) || (hdr->key_len == 0) ||
+        (hdr->key_len > CONFIG_MTD_KV_KEY_LEN_MAX) || (addr + size > end)) {
+        return -EBADMSG;
+    }
+
+    uint8_t chunk[CHUNK_SIZE];
+    uint16_t crc = _hdr_crc(hdr);
+    uint32_t pos = addr + sizeof(*hdr);
+    uint32_t left = hdr->key_len + hdr->val_len;
+    while (left) {
+        uint32_t n = (left < sizeof(chunk)) ? left : sizeof(chunk);
+        res = mtd_read(kv->mtd, chunk, pos, n);
+        if (res < 0) {
+            return res;
+        }
+        crc = crc16_ccitt_update(crc, chunk, n);
+        pos += n;
+        left -= n;
+    }
+
+    *valid = (crc == hdr->crc);
+    return size;
+}
+
+static int _read_key(mtd_kv_t *kv, uint32_t addr, char *key, size_t *len)
+{
+    _entry_hdr_t hdr;
+
+    int res = mtd_read(kv->mtd, &hdr, addr, sizeof(hdr));
+    if (res < 0) {
+        return res;
+    }
+    *len = hdr.key_len;
+    return mtd_read(kv->mtd, key, addr + sizeof(hdr), hdr.key_len);
+}
+
+static uint32_t _hash(const char *key, size_t len)
+{
+    return djb2_hash((const uint8_t *)key, len);
+}
+
+/* find the index slot of @p key
+ *
+ * returns the matching slot and sets @p found, or a free slot to insert the
+ * key at, or -1 if the index is full */
+static int _find(mtd_kv_t *kv, const char *key, size_t len, uint32_t hash,
+                 bool *found)
+{
+    unsigned mask = kv->index_size - 1;
+    int free = -1;
+
+    *found = false;
+    for (unsigned i = 0, pos = hash & mask; i < kv->index_size;
+         i++, pos = (pos + 1) & mask) {
+        mtd_kv_slot_t *slot = &kv->index[pos];
+
+        if (slot->addr == SLOT_EMPTY) {
+            return (free < 0) ? (int)pos : free;
+        }
+        if (slot->addr == SLOT_DELETED) {
+            if (free < 0) {
+                free = pos;
+            }
+            continue;
+        }
+        if (slot->hash != (uint16_t)(hash >> 16)) {
+            continue;
+        }
+
+        char stored[CONFIG_MTD_KV_KEY_LEN_MAX];
+        size_t stored_len;
+        if ((_read_key(kv, slot->addr, stored, &stored_len) == 0) &&
+            (stored_len == len) && (memcmp(stored, key, len) == 0)) {
+            *found = true;
+            return pos;
+        }
+    }
+
+    return free;
+}
+
+/* point the index entry of the key stored at @p addr to it */
+static int _index_put(mtd_kv_t *kv, uint32_t addr)
+{
+    char key[CONFIG_MTD_KV_KEY_LEN_MAX];
+    size_t len;
+
+    int res = _read_key(kv, addr, key, &len);
+    if (res < 0) {
+        return res;
+    }
+
+    bool found;
+    uint32_t hash = _hash(key, len);
+    int pos = _find(kv, key, len, hash, &found);
+    if (pos < 0) {
+        return -ENOMEM;
+    }
+    if (!found) {
+        kv->keys++;
+    }
+    kv->index[pos].addr = addr;
+    kv->index[pos].hash = hash >> 16;
+    return 0;
+}
+
+static int _replay_sector(mtd_kv_t *kv, uint32_t sector)
+{
+    uint32_t start = _sector_addr(kv, sector);
+    uint32_t end = start + kv->sector_size;
+    uint32_t addr = start + sizeof(_sector_hdr_t);
+    uint32_t pending = SLOT_EMPTY;
+
+    while (1) {
+        _entry_hdr_t hdr;
+        bool valid;
+        int size = _read_entry(kv, addr, end, &hdr, &valid);
+        if (size == -EBADMSG) {
+            DEBUG("mtd_kv: sector %" PRIu32 " corrupt at %" PRIu32 "\n",
+                  sector, addr);
+            addr = end;
+            break;
+        }
+        if (size <= 0) {
+            if (size < 0) {
+                return size;
+            }
+            break;
+        }
+
+        if (!valid) {
+            pending = SLOT_EMPTY;
+        }
+        else {
+            if (!(hdr.flags & FLAG_START)) {
+                pending = addr;
+            }
+            if ((hdr.flags & FLAG_MORE) && (pending != SLOT_EMPTY)) {
+                /* commit complete, apply all of its entries */
+                for (uint32_t pos = pending; pos <= addr; ) {
+                    _entry_hdr_t tmp;
+                    int res = mtd_read(kv->mtd, &tmp, pos, sizeof(tmp));
+                    if (res == 0) {
+                        res = _index_put(kv, pos);
+                    }
+                    if (res < 0) {
+                        return res;
+                    }
+                    pos += _entry_size(&tmp);
+                }
+                pending = SLOT_EMPTY;
+            }
+        }
+        addr += size;
+    }
+
+    if (sector == kv->head_sector) {
+        kv->head_off = addr - start;
+    }
+    return 0;
+}
+
+static int _open_sector(mtd_kv_t *kv, uint32_t sector, uint32_t cycle)
+{
+    _sector_hdr_t hdr = { .magic = MTD_KV_MAGIC, .cycle = cycle };
+
+    int res = mtd_write(kv->mtd, &hdr, _sector_addr(kv, sector), sizeof(hdr));
+    if (res < 0) {
+        return res;
+    }
+
+    DEBUG("mtd_kv: sector %" PRIu32 " opened, cycle %" PRIu32 "\n",
+          sector, cycle);
+    kv->head_sector = sector;
+    kv->head_off = sizeof(hdr);
+    kv->cycle = cycle;
+    return 0;
+}
+
+/* copy an entry to the head sector */
+static int _move_entry(mtd_kv_t *kv, uint32_t addr, const _entry_hdr_t *hdr)
+{
+    _writer_t w = {
+        .kv = kv,
+        .addr = _sector_addr(kv, kv->head_sector) + kv->head_off,
+    };
+    _entry_hdr_t moved = *hdr;
+    moved.flags |= FLAG_COMMIT_MASK;
+    moved.flags &= ~FLAG_START;
+
+    int res = _w_put(&w, &moved, sizeof(moved));
+
+    uint8_t chunk[CHUNK_SIZE];
+    uint32_t pos = addr + sizeof(*hdr);
+    uint32_t left = hdr->key_len + hdr->val_len;
+    while ((res == 0) && left) {
+        uint32_t n = (left < sizeof(chunk)) ? left : sizeof(chunk);
+        res = mtd_read(kv->mtd, chunk, pos, n);
+        if (res == 0) {
+            res = _w_put(&w, chunk, n);
+        }
+        pos += n;
+        left -= n;
+    }
+    if (res == 0) {
+        res = _w_finish(&w);
+    }
+
+    kv->head_off += _entry_size(hdr);
+    return res;
+}
+
+/* move the live entries of @p sector to the head sector and erase it */
+static int _compact(mtd_kv_t *kv, uint32_t sector)
+{
+    uint32_t start = _sector_addr(kv, sector);
+    uint32_t end = start + kv->sector_size;
+    _sector_hdr_t shdr;
+
+    int res = mtd_read(kv->mtd, &shdr, start, sizeof(shdr));
+    if (res < 0) {
+        return res;
+    }
+    if ((shdr.magic == 0xffffffff) && (shdr.cycle == 0xffffffff)) {
+        /* already erased */
+        return 0;
+    }
+
+    for (uint32_t addr = start + sizeof(shdr);
+         (shdr.magic == MTD_KV_MAGIC) && (addr < end); ) {
+        _entry_hdr_t hdr;
+        bool valid;
+        int size = _read_entry(kv, addr, end, &hdr, &valid);
+        if (size == 0 || size == -EBADMSG) {
+            break;
+        }
+        if (size < 0) {
+            return size;
+        }
+
+        char key[CONFIG_MTD_KV_KEY_LEN_MAX];
+        size_t len;
+        bool found = false;
+        int pos = -1;
+        if (valid && (_read_key(kv, addr, key, &len) == 0)) {
+            pos = _find(kv, key, len, _hash(key, len), &found);
+        }
+
+        if (found && (kv->index[pos].addr == addr)) {
+            if (!(hdr.flags & FLAG_DELETE)) {
+                /* no older value is left, the tombstone can go */
+                kv->index[pos].addr = SLOT_DELETED;
+                kv->keys--;
+            }
+            else {
+                uint32_t moved = _sector_addr(kv, kv->head_sector) + kv->head_off;
+                res = _move_entry(kv, addr, &hdr);
+                if (res < 0) {
+                    return res;
+                }
+                kv->index[pos].addr = moved;
+            }
+        }
+        addr += size;
+    }
+
+    DEBUG("mtd_kv: erasing sector %" PRIu32 "\n", sector);
+    return mtd_erase(kv->mtd, start, kv->sector_size);
+}
+
+/* move the head to the erased sector and compact the oldest one */
+static int _advance(mtd_kv_t *kv)
+{
+    int res = _open_sector(kv, _next_sector(kv, kv->head_sector),
+                           kv->cycle + 1);
+    if (res < 0) {
+        return res;
+    }
+    return _compact(kv, _next_sector(kv, kv->head_sector));
+}
+
+static int _format(mtd_kv_t *kv)
+{
+    DEBUG("mtd_kv: no store found, creating one\n");
+
+    int res = mtd_erase(kv->mtd, 0, kv->mtd->sector_count * kv->sector_size);
+    if (res < 0) {
+        return res;
+    }
+    return _open_sector(kv, 0, 0);
+}
+
+int mtd_kv_init(mtd_kv_t *kv, mtd_dev_t *mtd, mtd_kv_slot_t *index,
+                uint16_t index_size)
+{
+    if ((mtd->sector_count < 2) || (mtd->page_size % 4) ||
+        (index_size == 0) || (index_size & (index_size - 1))) {
+        return -EINVAL;
+    }
+
+    memset(kv, 0, sizeof(*kv));
+    kv->mtd = mtd;
+    kv->index = index;
+    kv->index_size = index_size;
+    kv->sector_size = mtd->pages_per_sector * mtd->page_size;
+    for (unsigned i = 0; i < index_size; i++) {
+        index[i].addr = SLOT_EMPTY;
+    }
+
+    /* the newest sector has the highest erase cycle */
+    bool found = false;
+    for (uint32_t sector = 0; sector < mtd->sector_count; sector++) {
+        _sector_hdr_t hdr;
+        int res = mtd_read(mtd, &hdr, _sector_addr(kv, sector), sizeof(hdr));
+        if (res < 0) {
+            return res;
+        }
+        if ((hdr.magic == MTD_KV_MAGIC) &&
+            (!found || (int32_t)(hdr.cycle - kv->cycle) > 0)) {
+            found = true;
+            kv->head_sector = sector;
+            kv->cycle = hdr.cycle;
+        }
+    }
+
+    if (!found) {
+        return _format(kv);
+    }
+
+    /* replay from the oldest to the newest sector */
+    uint32_t sector = kv->head_sector;
+    do {
+        sector = _next_sector(kv, sector);
+
+        _sector_hdr_t hdr;
+        int res = mtd_read(mtd, &hdr, _sector_addr(kv, sector), sizeof(hdr));
+        if (res == 0 && hdr.magic == MTD_KV_MAGIC) {
+            res = _replay_sector(kv, sector);
+        }
+        if (res < 0) {
+            return res;
+        }
+    } while (sector != kv->head_sector);
+
+    DEBUG("mtd_kv: %u keys, head at sector %" PRIu32 ", offset %" PRIu32 "\n",
+          kv->keys, kv->head_sector, kv->head_off);
+
+    /* finish a compaction that was interrupted */
+    return _compact(kv, _next_sector(kv, kv->head_sector));
+}
+
+int mtd_kv_get(mtd_kv_t *kv, const char *key, void *dest, size_t len)
+{
+    size_t key_len = strlen(key);
+    bool found;
+
+    int pos = _find(kv, key, key_len, _hash(key, key_len), &found);
+    if (!found) {
+        return -ENOENT;
+    }
+
+    _entry_hdr_t hdr;
+    uint32_t addr = kv->index[pos].addr;
+    int res = mtd_read(kv->mtd, &hdr, addr, sizeof(hdr));
+    if (res < 0) {
+        return res;
+    }
+    if (!(hdr.flags & FLAG_DELETE)) {
+        return -ENOENT;
+    }
+
+    if (len > hdr.val_len) {
+        len = hdr.val_len;
+    }
+    res = mtd_read(kv->mtd, dest, addr + sizeof(hdr) + key_len, len);
+    return (res < 0) ? res : hdr.val_len;
+}
+
+/* an update is needed unless an absent key is deleted */
+static bool _needs_write(mtd_kv_t *kv, const mtd_kv_pair_t *pair, bool *is_new)
+{
+    size_t len = strlen(pair->key);
+    bool found;
+
+    int pos = _find(kv, pair->key, len, _hash(pair->key, len), &found);
+    *is_new = !found;
+    if (!found) {
+        return pair->val != NULL;
+    }
+    if (pair->val) {
+        return true;
+    }
+
+    _entry_hdr_t hdr;
+    return (mtd_read(kv->mtd, &hdr, kv->index[pos].addr, sizeof(hdr)) < 0) ||
+           (hdr.flags & FLAG_DELETE);
+}
+
+static int _write_entry(mtd_kv_t *kv, const mtd_kv_pair_t *pair, uint8_t flags)
+{
+    _entry_hdr_t hdr = {
+        .flags = flags,
+        .key_len = strlen(pair->key),
+        .val_len = pair->val ? pair->len : 0,
+        .reserved = 0xffff,
+    };
+    hdr.crc = _hdr_crc(&hdr);
+    hdr.crc = crc16_ccitt_update(hdr.crc, (const uint8_t *)pair->key,
+                                 hdr.key_len);
+    hdr.crc = crc16_ccitt_update(hdr.crc, pair->val, hdr.val_len);
+
+    _writer_t w = {
+        .kv = kv,
+        .addr = _sector_addr(kv, kv->head_sector) + kv->head_off,
+    };
+    int res = _w_put(&w, &hdr, sizeof(hdr));
+    if (res == 0) {
+        res = _w_put(&w, pair->key, hdr.key_len);
+    }
+    if (res == 0) {
+        res = _w_put(&w, pair->val, hdr.val_len);
+    }
+    if (res == 0) {
+        res = _w_finish(&w);
+    }
+
+    /* the space is used even if writing failed */
+    kv->head_off += _entry_size(&hdr);
+    return res;
+}
+
+int mtd_kv_set_multi(mtd_kv_t *kv, const mtd_kv_pair_t *pairs, unsigned n)
+{
+    uint32_t total = 0;
+    unsigned added = 0;
+    int last = -1;
+
+    for (unsigned i = 0; i < n; i++) {
+        size_t key_len = strlen(pairs[i].key);
+        if ((key_len == 0) || (key_len > CONFIG_MTD_KV_KEY_LEN_MAX) ||
+            (pairs[i].val && (pairs[i].len > UINT16_MAX))) {
+            return -EINVAL;
+        }
+
+        bool is_new;
+        if (!_needs_write(kv, &pairs[i], &is_new)) {
+            continue;
+        }
+        added += is_new;
+        last = i;
+
+        _entry_hdr_t hdr = {
+            .key_len = key_len,
+            .val_len = pairs[i].val ? pairs[i].len : 0,
+        };
+        total += _entry_size(&hdr);
+    }
+
+    if (last < 0) {
+        return 0;
+    }
+    if (total > kv->sector_size - sizeof(_sector_hdr_t)) {
+        return -EINVAL;
+    }
+    if (kv->keys + added > kv->index_size) {
+        return -ENOMEM;
+    }
+
+    /* all entries of a commit go into the same sector */
+    for (unsigned tries = 0; kv->head_off + total > kv->sector_size; tries++) {
+        if (tries == kv->mtd->sector_count) {
+            return -ENOSPC;
+        }
+        int res = _advance(kv);
+        if (res < 0) {
+            return res;
+        }
+    }
+
+    uint32_t addr = _sector_addr(kv, kv->head_sector) + kv->head_off;
+    for (int i = 0; i <= last; i++) {
+        bool is_new;
+        if ((i != last) && !_needs_write(kv, &pairs[i], &is_new)) {
+            continue;
+        }
+
+        uint8_t flags = 0xff & ~FLAG_VALID;
+        if (addr == _sector_addr(kv, kv->head_sector) + kv->head_off) {
+            flags &= ~FLAG_START;
+        }
+        if (i != last) {
+            flags &= ~FLAG_MORE;
+        }
+        if (pairs[i].val == NULL) {
+            flags &= ~FLAG_DELETE;
+        }
+
+        int res = _write_entry(kv, &pairs[i], flags);
+        if (res < 0) {
+            return res;
+        }
+    }
+
+    /* the commit is on flash, make it visible */
+    while (addr < _sector_addr(kv, kv->head_sector) + kv->head_off) {
+        _entry_hdr_t hdr;
+        int res = mtd_read(kv->mtd, &hdr, addr, sizeof(hdr));
+        if (res == 0) {
+            res = _index_put(kv, addr);
+        }
+        if (res < 0) {
+            return res;
+        }
+        addr += _entry_size(&hdr);
+    }
+
+    return 0;
+}
@@ -0,0 +1,275 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_mtd_log
+ * @{
+ *
+ * @file
+ * @brief       Append-only record log on MTD
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "checksum/crc16_ccitt.h"
+#include "mtd_log.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define MTD_LOG_MAGIC       (0x474f4c4dUL)  /* "MLOG" */
+#define MTD_LOG_ERASED      (0xffffffffUL)
+
+/* sector header, stored in the first slot of every sector */
+typedef struct __attribute__((packed)) {
+    uint32_t magic;
+    uint32_t cycle;
+    uint32_t first_seq;
+} _sector_hdr_t;
+
+/* record header, followed by the payload */
+typedef struct __attribute__((packed)) {
+    uint32_t seq;
+    uint16_t len;
+    uint16_t crc;
+} _record_hdr_t;
+
+static uint32_t _sector_size(const mtd_log_t *log)
+{
+    return log->mtd->pages_per_sector * log->mtd->page_size;
+}
+
+static uint32_t _addr(const mtd_log_t *log, uint32_t sector, uint32_t slot)
+{
+    return sector * _sector_size(log) + slot * log->slot_size;
+}
+
+static uint32_t _next_sector(const mtd_log_t *log, uint32_t sector)
+{
+    return (sector + 1 == log->mtd->sector_count) ? 0 : sector + 1;
+}
+
+static uint16_t _crc(const _record_hdr_t *hdr, const uint8_t *data, size_t len)
+{
+    uint16_t crc = crc16_ccitt_calc((const uint8_t *)hdr,
+                                    offsetof(_record_hdr_t, crc));
+    return crc16_ccitt_update(crc, data, len);
+}
+
+static int _read_sector_hdr(const mtd_log_t *log, uint32_t sector,
+                            _sector_hdr_t *hdr)
+{
+    int res = mtd_read(log->mtd, hdr, _addr(log, sector, 0), sizeof(*hdr));
+    if (res < 0) {
+        return res;
+    }
+    return (hdr->magic == MTD_LOG_MAGIC) ? 1 : 0;
+}
+
+static uint32_t _read_seq(const mtd_log_t *log, uint32_t sector, uint32_t slot)
+{
+    uint32_t seq;
+
+    if (mtd_read(log->mtd, &seq, _addr(log, sector, slot), sizeof(seq)) < 0) {
+        /* treat unreadable slots as used */
+        return 0;
+    }
+    return seq;
+}
+
+/* erase @p sector and make it the head of the log */
+static int _open_sector(mtd_log_t *log, uint32_t sector, uint32_t cycle)
+{
+    int res = mtd_erase(log->mtd, _addr(log, sector, 0), _sector_size(log));
+    if (res < 0) {
+        return res;
+    }
+
+    _sector_hdr_t *hdr = (_sector_hdr_t *)log->buf;
+    memset(log->buf, 0xff, log->slot_size);
+    hdr->magic = MTD_LOG_MAGIC;
+    hdr->cycle = cycle;
+    hdr->first_seq = log->seq;
+
+    res = mtd_write(log->mtd, log->buf, _addr(log, sector, 0), log->slot_size);
+    if (res < 0) {
+        return res;
+    }
+
+    DEBUG("mtd_log: sector %" PRIu32 " opened, cycle %" PRIu32 "\n",
+          sector, cycle);
+    log->head_sector = sector;
+    log->head_slot = 1;
+    log->cycle = cycle;
+    return 0;
+}
+
+int mtd_log_init(mtd_log_t *log, mtd_dev_t *mtd, void *buf, uint16_t slot_size)
+{
+    if ((mtd->sector_count < 2) || (slot_size < sizeof(_sector_hdr_t)) ||
+        (slot_size <= sizeof(_record_hdr_t)) || (mtd->page_size % slot_size)) {
+        return -EINVAL;
+    }
+
+    memset(log, 0, sizeof(*log));
+    log->mtd = mtd;
+    log->buf = buf;
+    log->slot_size = slot_size;
+    log->slots = _sector_size(log) / slot_size;
+
+    /* the newest sector has the highest erase cycle */
+    bool found = false;
+    _sector_hdr_t hdr;
+    for (uint32_t sector = 0; sector < mtd->sector_count; sector++) {
+        int res = _read_sector_hdr(log, sector, &hdr);
+        if (res < 0) {
+            return res;
+        }
+        uint32_t cycle = hdr.cycle;
+        if (res && (!found || (int32_t)(cycle - log->cycle) > 0)) {
+            found = true;
+            log->head_sector = sector;
+            log->cycle = cycle;
+            log->seq = hdr.first_seq;
+        }
+    }
+
+    if (!found) {
+        DEBUG("mtd_log: no log found, creating one\n");
+        return _open_sector(log, 0, 0);
+    }
+
+    /* slots are written in order, find the first free one */
+    uint32_t lo = 1;
+    uint32_t hi = log->slots;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (_read_seq(log, log->head_sector, mid) == MTD_LOG_ERASED) {
+            hi = mid;
+        }
+        else {
+            lo = mid + 1;
+        }
+    }
+    log->head_slot = lo;
+    log->seq += lo - 1;
+
+    DEBUG("mtd_log: head at sector %" PRIu32 ", slot %" PRIu32 ", seq %" PRIu32 "\n",
+          log->head_sector, log->head_slot, log->seq);
+    return 0;
+}
+
+int mtd_log_append(mtd_log_t *log, const void *data, size_t len)
+{
+    if ((len == 0) || (len > log->slot_size - sizeof(_record_hdr_t))) {
+        return -EINVAL;
+    }
+
+    if (log->head_slot == log->slots) {
+        /* reuse the oldest sector */
+        int res = _open_sector(log, _next_sector(log, log->head_sector),
+                               log->cycle + 1);
+        if (res < 0) {
+            return res;
+        }
+    }
+
+    _record_hdr_t *hdr = (_record_hdr_t *)log->buf;
+    memset(log->buf, 0xff, log->slot_size);
+    hdr->seq = log->seq;
+    hdr->len = len;
+    hdr->crc = _crc(hdr, data, len);
+    memcpy(log->buf + sizeof(*hdr), data, len);
+
+    int res = mtd_write(log->mtd, log->buf,
+                        _addr(log, log->head_sector, log->head_slot),
+                        log->slot_size);
+    /* consume the slot even if writing failed, it is no longer erased */
+    log->head_slot++;
+    log->seq++;
+
+    return (res < 0) ? res : 0;
+}
+
+int mtd_log_clear(mtd_log_t *log)
+{
+    int res = mtd_erase(log->mtd, 0, log->mtd->sector_count * _sector_size(log));
+    if (res < 0) {
+        return res;
+    }
+    return _open_sector(log, log->head_sector, log->cycle + 1);
+}
+
+void mtd_log_iter_init(const mtd_log_t *log, mtd_log_iter_t *it)
+{
+    it->sector = _next_sector(log, log->head_sector);
+    it->slot = 0;
+    it->remaining = log->mtd->sector_count;
+}
+
+int mtd_log_iter_next(mtd_log_t *log, mtd_log_iter_t *it, void *dest,
+                      size_t len, uint32_t *seq)
+{
+    while (it->remaining) {
+        uint32_t end = (it->sector == log->head_sector) ? log->head_slot
+                                                        : log->slots;
+        if (it->slot == 0) {
+            /* skip sectors that have not been used yet */
+            _sector_hdr_t hdr;
+            int res = _read_sector_hdr(log, it->sector, &hdr);
+            if (res < 0) {
+                return res;
+            }
+            it->slot = res ? 1 : end;
+        }
+
+        while (it->slot < end) {
+            uint32_t slot = it->slot++;
+            int res = mtd_read(log->mtd, log->buf,
+                               _addr(log, it->sector, slot), log->slot_size);
+            if (res < 0) {
+                return res;
+            }
+
+            _record_hdr_t *hdr = (_record_hdr_t *)log->buf;
+            if (hdr->seq == MTD_LOG_ERASED) {
+                /* rest of the sector is empty */
+                it->slot = end;
+                break;
+            }
+            size_t rlen = hdr->len;
+            if ((rlen == 0) || (rlen > log->slot_size - sizeof(*hdr)) ||
+                (_crc(hdr, log->buf + sizeof(*hdr), rlen) !=
+                 hdr->crc)) {
+                DEBUG("mtd_log: skipping corrupt record in sector %" PRIu32
+                      ", slot %" PRIu32 "\n", it->sector, slot);
+                continue;
+            }
+
+            if (seq) {
+                *seq = hdr->seq;
+            }
+            memcpy(dest, log->buf + sizeof(*hdr), (rlen < len) ? rlen : len);
+            return rlen;
+        }
+
+        it->sector = _next_sector(log, it->sector);
+        it->slot = 0;
+        it->remaining--;
+    }
+
+    return 0;
+}
@@ -51,6 +51,12 @@
 
 #define LEN_PINGRESP            (2U)
 
+/* length of a PUBLISH message without payload, incl. 3 byte length field */
+#define MAXLEN_PUBLISH_HDR      (9U)
+
+/* not every network stack implements sock_udp_sendv() yet */
+#define HAS_SENDV               IS_USED(MODULE_GNRC_SOCK_UDP)
+
 /* Internally used connection states */
 enum {
     UNINITIALIZED = 0,      /**< connection context is not initialized */
@@ -101,6 +107,18 @@ static uint16_t _msg_id_next(asymcute_con_t *con)
     return con->last_id;
 }
 
+static void _topic_set_id(asymcute_topic_t *topic, uint16_t id)
+{
+    topic->id = id;
+    /* encode once, used for every PUBLISH to the topic */
+    byteorder_htobebufs(topic->id_enc, id);
+}
+
+static asymcute_req_t **_bucket(asymcute_con_t *con, uint16_t msg_id)
+{
+    return &con->pending[msg_id & (ASYMCUTE_PENDING_BUCKETS - 1)];
+}
+
 /* @pre con is locked */
 static asymcute_req_t *_req_preprocess(asymcute_con_t *con,
                                        size_t msg_len, size_t min_len,
@@ -114,20 +132,13 @@ static asymcute_req_t *_req_preprocess(asymcute_con_t *con,
      uint16_t msg_id = (buf == NULL) ? 0 : byteorder_bebuftohs(&buf[id_pos]);
 
     asymcute_req_t *res = NULL;
-    asymcute_req_t *iter = con->pending;
-    if (iter == NULL) {
-        return NULL;
-    }
-    if (iter->msg_id == msg_id) {
-        res = iter;
-        con->pending = iter->next;
-    }
-    while (iter && !res) {
-        if (iter->next && (iter->next->msg_id == msg_id)) {
-            res = iter->next;
-            iter->next = iter->next->next;
+    for (asymcute_req_t **iter = _bucket(con, msg_id); *iter;
+         iter = &(*iter)->next) {
+        if ((*iter)->msg_id == msg_id) {
+            res = *iter;
+            *iter = res->next;
+            break;
         }
-        iter = iter->next;
     }
 
     if (res) {
@@ -140,12 +151,11 @@ static asymcute_req_t *_req_preprocess(asymcute_con_t *con,
 /* @pre con is locked */
 static void _req_remove(asymcute_con_t *con, asymcute_req_t *req)
 {
-    if (con->pending == req) {
-        con->pending = con->pending->next;
-    }
-    for (asymcute_req_t *cur = con->pending; cur; cur = cur->next) {
-        if (cur->next == req) {
-            cur->next = cur->next->next;
+    for (asymcute_req_t **iter = _bucket(con, req->msg_id); *iter;
+         iter = &(*iter)->next) {
+        if (*iter == req) {
+            *iter = req->next;
+            break;
         }
     }
     req->con = NULL;
@@ -168,6 +178,18 @@ static void _compile_sub_unsub(asymcute_req_t *req, asymcute_con_t *con,
     req->arg = (void *)sub;
 }
 
+static size_t _publish_hdr(uint8_t *buf, const asymcute_topic_t *topic,
+                           uint8_t flags, uint16_t msg_id, size_t data_len)
+{
+    size_t pos = _len_set(buf, data_len + 6);
+
+    buf[pos] = MQTTSN_PUBLISH;
+    buf[pos + 1] = (flags | topic->flags);
+    memcpy(&buf[pos + 2], topic->id_enc, sizeof(topic->id_enc));
+    byteorder_htobebufs(&buf[pos + 4], msg_id);
+    return pos + 6;
+}
+
 static void _req_resend(asymcute_req_t *req, asymcute_con_t *con)
 {
     event_timeout_set(&req->to_timer, RETRY_TO);
@@ -185,8 +207,9 @@ static void _req_send(asymcute_req_t *req, asymcute_con_t *con,
     event_callback_init(&req->to_evt, _on_req_timeout, (void *)req);
     event_timeout_init(&req->to_timer, &_queue, &req->to_evt.super);
     /* add request to the pending queue (if non-con request) */
-    req->next = con->pending;
-    con->pending = req;
+    asymcute_req_t **bucket = _bucket(con, req->msg_id);
+    req->next = *bucket;
+    *bucket = req;
     /* send request */
     _req_resend(req, con);
 }
@@ -218,10 +241,12 @@ static void _disconnect(asymcute_con_t *con, uint8_t state)
     if (con->state == CONNECTED) {
         /* cancel all pending requests */
         event_timeout_clear(&con->keepalive_timer);
-        for (asymcute_req_t *req = con->pending; req; req = req->next) {
-            _req_cancel(req);
+        for (unsigned i = 0; i < ASYMCUTE_PENDING_BUCKETS; i++) {
+            for (asymcute_req_t *req = con->pending[i]; req; req = req->next) {
+                _req_cancel(req);
+            }
+            con->pending[i] = NULL;
         }
-        con->pending = NULL;
         for (asymcute_sub_t *sub = con->subscriptions; sub; sub = sub->next) {
             _sub_cancel(sub);
         }
@@ -396,7 +421,7 @@ static void _on_regack(asymcute_con_t *con, const uint8_t *data, size_t len)
             return;
         }
 
-        topic->id = byteorder_bebuftohs(&data[2]);
+        _topic_set_id(topic, byteorder_bebuftohs(&data[2]));
         topic->con = con;
         ret = ASYMCUTE_REGISTERED;
     }
@@ -479,7 +504,7 @@ static void _on_suback(asymcute_con_t *con, const uint8_t *data, size_t len)
             return;
         }
 
-        sub->topic->id = byteorder_bebuftohs(&data[3]);
+        _topic_set_id(sub->topic, byteorder_bebuftohs(&data[3]));
         sub->topic->con = con;
         /* insert subscription to connection context */
         sub->next = con->subscriptions;
@@ -688,7 +713,7 @@ int asymcute_topic_init(asymcute_topic_t *topic, const char *topic_name,
     asymcute_topic_reset(topic);
     /* pre-defined topic ID? */
     if (topic_name == NULL) {
-        topic->id = topic_id;
+        _topic_set_id(topic, topic_id);
         topic->flags = MQTTSN_TIT_PREDEF;
         memcpy(topic->name, &topic_id, 2);
         topic->name[2] = '\0';
@@ -696,7 +721,9 @@ int asymcute_topic_init(asymcute_topic_t *topic, const char *topic_name,
     else {
         strncpy(topic->name, topic_name, sizeof(topic->name));
         if (len == 2) {
-            memcpy(&topic->id, topic_name, 2);
+            uint16_t id;
+            memcpy(&id, topic_name, 2);
+            _topic_set_id(topic, id);
             topic->flags = MQTTSN_TIT_SHORT;
         }
     }
@@ -857,8 +884,10 @@ int asymcute_publish(asymcute_con_t *con, asymcute_req_t *req,
     if ((flags & VALID_PUBLISH_FLAGS) != flags) {
         return ASYMCUTE_NOTSUP;
     }
-    /* check for message size */
-    if ((data_len + 9) > ASYMCUTE_BUFSIZE) {
+    /* check for message size, QoS 0 messages are sent without buffering */
+    if ((data_len + MAXLEN_PUBLISH_HDR) >
+        (((flags & MQTTSN_QOS_1) || !HAS_SENDV) ? ASYMCUTE_BUFSIZE
+                                                  : UINT16_MAX)) {
         return ASYMCUTE_OVERFLOW;
     }
     /* make sure topic is registered */
@@ -880,22 +909,38 @@ int asymcute_publish(asymcute_con_t *con, asymcute_req_t *req,
     /* get message id */
     req->msg_id = _msg_id_next(con);
 
-    /* assemble message */
-    size_t pos = _len_set(req->data, data_len + 6);
-    req->data[pos] = MQTTSN_PUBLISH;
-    req->data[pos + 1] = (flags | topic->flags);
-    byteorder_htobebufs(&req->data[pos + 2], topic->id);
-    byteorder_htobebufs(&req->data[pos + 4], req->msg_id);
-    memcpy(&req->data[pos + 6], data, data_len);
-    req->data_len = (pos + 6 + data_len);
-
     /* publish selected data */
-    if (flags & MQTTSN_QOS_1) {
-        _req_send(req, con, NULL);
+    if ((flags & MQTTSN_QOS_1) || !HAS_SENDV) {
+        /* keep a copy for retransmissions */
+        req->data_len = _publish_hdr(req->data, topic, flags, req->msg_id,
+                                     data_len);
+        memcpy(&req->data[req->data_len], data, data_len);
+        req->data_len += data_len;
+        if (flags & MQTTSN_QOS_1) {
+            _req_send(req, con, NULL);
+        }
+        else {
+            _req_send_once(req, con);
+        }
     }
+#if HAS_SENDV
     else {
-        _req_send_once(req, con);
+        /* send directly from the user's buffer */
+        uint8_t hdr[MAXLEN_PUBLISH_HDR];
+        iolist_t payload = {
+            .iol_base = (void *)data,
+            .iol_len = data_len,
+        };
+        iolist_t head = {
+            .iol_next = &payload,
+            .iol_base = hdr,
+            .iol_len = _publish_hdr(hdr, topic, flags, req->msg_id, data_len),
+        };
+        sock_udp_sendv(&con->sock, &head, &con->server_ep);
+        req->data_len = 0;
+        mutex_unlock(&req->lock);
     }
+#endif
 
 end:
     mutex_unlock(&con->lock);
@@ -22,6 +22,7 @@
 
 #include "log.h"
 #include "assert.h"
+#include "random.h"
 #include "thread.h"
 #include "xtimer.h"
 #include "net/cord/ep.h"
@@ -38,8 +39,6 @@
 
 #define UPDATE_TIMEOUT      (0xe537)
 
-#define TIMEOUT_US          ((uint64_t)(CORD_UPDATE_INTERVAL * US_PER_SEC))
-
 static char _stack[STACKSIZE];
 
 static xtimer_t _timer;
@@ -50,7 +49,11 @@ static cord_ep_standalone_cb_t _cb = NULL;
 
 static void _set_timer(void)
 {
-    xtimer_set_msg64(&_timer, TIMEOUT_US, &_msg, _runner_pid);
+    uint32_t interval = CORD_UPDATE_INTERVAL -
+                        random_uint32_range(0, CORD_UPDATE_JITTER + 1);
+
+    xtimer_set_msg64(&_timer, (uint64_t)interval * US_PER_SEC, &_msg,
+                     _runner_pid);
 }
 
 static void _notify(cord_ep_standalone_event_t event)
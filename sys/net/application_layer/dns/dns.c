@@ -27,12 +27,121 @@
 #include "byteorder.h"
 #endif
 
+#ifdef MODULE_SOCK_DNS_CACHE
+#include "mutex.h"
+#include "timex.h"
+#include "ztimer.h"
+#endif
+
 /* min domain name length is 1, so minimum record length is 7 */
 #define DNS_MIN_REPLY_LEN   (unsigned)(sizeof(sock_dns_hdr_t ) + 7)
 
 /* global DNS server UDP endpoint */
 sock_udp_ep_t sock_dns_server;
 
+#ifdef MODULE_SOCK_DNS_CACHE
+/* keep expiry times comparable across wrap-around of the millisecond clock */
+#define DNS_CACHE_TTL_MAX   ((UINT32_MAX / 2) / MS_PER_SEC)
+
+typedef struct {
+    char name[CONFIG_SOCK_DNS_CACHE_NAME_LEN + 1];
+    uint8_t addr[IN6ADDRSZ];
+    uint8_t addr_len;       /* 0 for a negative entry */
+    uint8_t family;
+    uint32_t expires;       /* ZTIMER_MSEC, entry unused if name is empty */
+} _dns_cache_entry_t;
+
+static _dns_cache_entry_t _cache[CONFIG_SOCK_DNS_CACHE_SIZE];
+static sock_dns_cache_stats_t _cache_stats;
+static mutex_t _cache_lock = MUTEX_INIT;
+
+static bool _cache_expired(const _dns_cache_entry_t *entry, uint32_t now)
+{
+    return (entry->name[0] == '\0') || ((int32_t)(entry->expires - now) <= 0);
+}
+
+/* returns the cached result (addrlen or -1 for a negative entry) or 0 */
+static int _cache_get(const char *domain_name, void *addr_out, int family)
+{
+    uint32_t now = ztimer_now(ZTIMER_MSEC);
+    int res = 0;
+
+    mutex_lock(&_cache_lock);
+    for (unsigned i = 0; i < CONFIG_SOCK_DNS_CACHE_SIZE; i++) {
+        _dns_cache_entry_t *entry = &_cache[i];
+        if (_cache_expired(entry, now) || (entry->family != family) ||
+            (strcmp(entry->name, domain_name) != 0)) {
+            continue;
+        }
+        if (entry->addr_len) {
+            memcpy(addr_out, entry->addr, entry->addr_len);
+            res = entry->addr_len;
+        }
+        else {
+            res = -1;
+        }
+        break;
+    }
+    if (res) {
+        _cache_stats.hits++;
+    }
+    else {
+        _cache_stats.misses++;
+    }
+    mutex_unlock(&_cache_lock);
+    return res;
+}
+
+static void _cache_add(const char *domain_name, const void *addr, int addr_len,
+                       int family, uint32_t ttl)
+{
+    size_t name_len = strlen(domain_name);
+    uint32_t now = ztimer_now(ZTIMER_MSEC);
+    _dns_cache_entry_t *entry = NULL;
+
+    if ((name_len > CONFIG_SOCK_DNS_CACHE_NAME_LEN) || (ttl == 0)) {
+        return;
+    }
+    if (ttl > DNS_CACHE_TTL_MAX) {
+        ttl = DNS_CACHE_TTL_MAX;
+    }
+
+    mutex_lock(&_cache_lock);
+    /* take a free or expired slot, else evict the entry expiring first */
+    for (unsigned i = 0; i < CONFIG_SOCK_DNS_CACHE_SIZE; i++) {
+        if (_cache_expired(&_cache[i], now)) {
+            entry = &_cache[i];
+            break;
+        }
+        if ((entry == NULL) ||
+            ((int32_t)(_cache[i].expires - entry->expires) < 0)) {
+            entry = &_cache[i];
+        }
+    }
+    memcpy(entry->name, domain_name, name_len + 1);
+    entry->addr_len = 0;
+    if (addr_len > 0) {
+        memcpy(entry->addr, addr, addr_len);
+        entry->addr_len = addr_len;
+    }
+    entry->family = family;
+    entry->expires = now + ttl * MS_PER_SEC;
+    mutex_unlock(&_cache_lock);
+}
+
+const sock_dns_cache_stats_t *sock_dns_cache_get_stats(void)
+{
+    return &_cache_stats;
+}
+
+void sock_dns_cache_flush(void)
+{
+    mutex_lock(&_cache_lock);
+    memset(_cache, 0, sizeof(_cache));
+    mutex_unlock(&_cache_lock);
+}
+#endif /* MODULE_SOCK_DNS_CACHE */
+
 static ssize_t _enc_domain_name(uint8_t *out, const char *domain_name)
 {
     /*
@@ -102,7 +211,8 @@ static ssize_t _skip_hostname(const uint8_t *buf, size_t len, uint8_t *bufpos)
     return res + 1;
 }
 
-static int _parse_dns_reply(uint8_t *buf, size_t len, void* addr_out, int family)
+static int _parse_dns_reply(uint8_t *buf, size_t len, void* addr_out, int family,
+                            uint32_t *ttl)
 {
     const uint8_t *buflim = buf + len;
     sock_dns_hdr_t *hdr = (sock_dns_hdr_t*) buf;
@@ -132,7 +242,9 @@ static int _parse_dns_reply(uint8_t *buf, size_t len, void* addr_out, int family
         bufpos += RR_TYPE_LENGTH;
         uint16_t class = ntohs(_get_short(bufpos));
         bufpos += RR_CLASS_LENGTH;
-        bufpos += RR_TTL_LENGTH; /* skip ttl */
+        uint32_t _ttl;
+        memcpy(&_ttl, bufpos, RR_TTL_LENGTH);
+        bufpos += RR_TTL_LENGTH;
 
         unsigned addrlen = ntohs(_get_short(bufpos));
         /* skip unwanted answers */
@@ -162,6 +274,7 @@ static int _parse_dns_reply(uint8_t *buf, size_t len, void* addr_out, int family
         }
 
         memcpy(addr_out, bufpos, addrlen);
+        *ttl = ntohl(_ttl);
         return addrlen;
     }
 
@@ -180,6 +293,13 @@ int sock_dns_query(const char *domain_name, void *addr_out, int family)
         return -ENOSPC;
     }
 
+#ifdef MODULE_SOCK_DNS_CACHE
+    int cached = _cache_get(domain_name, addr_out, family);
+    if (cached) {
+        return cached;
+    }
+#endif
+
     sock_udp_t sock_dns;
 
     ssize_t res = sock_udp_create(&sock_dns, NULL, &sock_dns_server, 0);
@@ -225,8 +345,19 @@ int sock_dns_query(const char *domain_name, void *addr_out, int family)
         res = sock_udp_recv(&sock_dns, dns_buf, sizeof(dns_buf), 1000000LU, NULL);
         if (res > 0) {
             if (res > (int)DNS_MIN_REPLY_LEN) {
-                if ((res = _parse_dns_reply(dns_buf, res, addr_out,
-                                            family)) > 0) {
+                uint32_t ttl = 0;
+                res = _parse_dns_reply(dns_buf, res, addr_out, family, &ttl);
+#ifdef MODULE_SOCK_DNS_CACHE
+                if (res > 0) {
+                    _cache_add(domain_name, addr_out, res, family, ttl);
+                }
+                else if (res == -1) {
+                    /* valid answer, but no matching record */
+                    _cache_add(domain_name, NULL, 0, family,
+                               CONFIG_SOCK_DNS_CACHE_NEG_TTL);
+                }
+#endif
+                if (res > 0) {
                     goto out;
                 }
             }
@@ -38,11 +38,25 @@
 
 #define PUB_FLAGS           (EMCUTE_QOS_MASK | EMCUTE_RETAIN)
 #define SUB_FLAGS           (EMCUTE_DUP | EMCUTE_QOS_MASK | EMCUTE_TIT_MASK)
+#define PUBTOPIC_FLAGS      (PUB_FLAGS | EMCUTE_TIT_MASK)
 
 #define TFLAGS_RESP         (0x0001)
 #define TFLAGS_TIMEOUT      (0x0002)
 #define TFLAGS_ANY          (TFLAGS_RESP | TFLAGS_TIMEOUT)
 
+#define SLOT_FREE           (0xffff)
+
+/* a request of emcute_reg_multi() or emcute_sub_multi() in flight */
+typedef struct {
+    uint16_t msgid;
+    volatile uint16_t idx;      /* item of the batch, or SLOT_FREE */
+    uint8_t tries;
+    volatile bool done;
+    volatile int res;
+} slot_t;
+
+typedef size_t (*build_t)(size_t idx, uint16_t msgid);
+typedef int (*done_t)(size_t idx, int res);
 
 static const char *cli_id;
 static sock_udp_t sock;
@@ -52,6 +66,7 @@ static uint8_t rbuf[EMCUTE_BUFSIZE];
 static uint8_t tbuf[EMCUTE_BUFSIZE];
 
 static emcute_sub_t *subs = NULL;
+static emcute_sub_t *subs_by_id[EMCUTE_SUB_BUCKETS];
 
 static mutex_t txlock;
 
@@ -61,6 +76,11 @@ static volatile uint8_t waiton = 0xff;
 static volatile uint16_t waitonid = 0;
 static volatile int result;
 
+static slot_t slots[EMCUTE_PIPELINE_MAX];
+static volatile uint8_t batch_waiton = 0xff;
+static void *batch_ctx;
+static unsigned batch_flags;
+
 static size_t set_len(uint8_t *buf, size_t len)
 {
     /* - `len` field minimum length == 1
@@ -124,6 +144,136 @@ static int syncsend(uint8_t resp, size_t len, bool unlock)
     return res;
 }
 
+static void send_slot(slot_t *slot, build_t build)
+{
+    size_t len = build(slot->idx, slot->msgid);
+    sock_udp_send(&sock, tbuf, len, &gateway);
+}
+
+static int multisend(uint8_t resp, size_t numof, build_t build, done_t done)
+{
+    int res = EMCUTE_OK;
+    size_t next = 0;
+    unsigned busy = 0;
+
+    for (unsigned i = 0; i < EMCUTE_PIPELINE_MAX; i++) {
+        slots[i].idx = SLOT_FREE;
+    }
+    timer.arg = (void *)sched_active_thread;
+    thread_flags_clear(TFLAGS_ANY);
+    batch_waiton = resp;
+
+    while ((next < numof) || (busy > 0)) {
+        bool sent = false;
+
+        /* fill the free slots with the next requests */
+        for (unsigned i = 0; (i < EMCUTE_PIPELINE_MAX) && (next < numof); i++) {
+            if (slots[i].idx == SLOT_FREE) {
+                slots[i].msgid = id_next++;
+                slots[i].tries = 0;
+                slots[i].done = false;
+                slots[i].idx = next++;
+                send_slot(&slots[i], build);
+                busy++;
+                sent = true;
+            }
+        }
+        if (sent) {
+            xtimer_set(&timer, (EMCUTE_T_RETRY * US_PER_SEC));
+        }
+
+        thread_flags_t flags = thread_flags_wait_any(TFLAGS_ANY);
+        sent = false;
+        for (unsigned i = 0; i < EMCUTE_PIPELINE_MAX; i++) {
+            if (slots[i].idx == SLOT_FREE) {
+                continue;
+            }
+            if (slots[i].done) {
+                DEBUG("[emcute] multisend: got response [%i] for %u\n",
+                      slots[i].res, (unsigned)slots[i].idx);
+                int r = done(slots[i].idx, slots[i].res);
+                if (r != EMCUTE_OK) {
+                    res = r;
+                }
+            }
+            else if (flags & TFLAGS_TIMEOUT) {
+                if (++slots[i].tries <= EMCUTE_N_RETRY) {
+                    send_slot(&slots[i], build);
+                    sent = true;
+                    continue;
+                }
+                res = EMCUTE_TIMEOUT;
+            }
+            else {
+                continue;
+            }
+            slots[i].idx = SLOT_FREE;
+            busy--;
+        }
+        if (sent) {
+            xtimer_set(&timer, (EMCUTE_T_RETRY * US_PER_SEC));
+        }
+    }
+
+    xtimer_remove(&timer);
+    batch_waiton = 0xff;
+    return res;
+}
+
+static unsigned sub_bucket(uint16_t tid)
+{
+    return (tid ^ (tid >> 8)) % EMCUTE_SUB_BUCKETS;
+}
+
+static emcute_sub_t *sub_find(uint16_t tid)
+{
+    emcute_sub_t *sub = subs_by_id[sub_bucket(tid)];
+
+    while (sub && (sub->topic.id != tid)) {
+        sub = sub->next_id;
+    }
+    return sub;
+}
+
+static void sub_unlink(emcute_sub_t *sub)
+{
+    emcute_sub_t **s;
+
+    for (s = &subs; *s && (*s != sub); s = &(*s)->next) {}
+    if (*s == NULL) {
+        return;
+    }
+    *s = sub->next;
+
+    /* the ID of a pre-defined topic may have been changed since linking, so
+     * fall back to searching all buckets */
+    unsigned first = sub_bucket(sub->topic.id);
+    for (unsigned i = 0; i < EMCUTE_SUB_BUCKETS; i++) {
+        unsigned bucket = (first + i) % EMCUTE_SUB_BUCKETS;
+
+        for (s = &subs_by_id[bucket]; *s && (*s != sub); s = &(*s)->next_id) {}
+        if (*s) {
+            *s = sub->next_id;
+            return;
+        }
+    }
+}
+
+static void sub_link(emcute_sub_t *sub)
+{
+    unsigned bucket = sub_bucket(sub->topic.id);
+
+    sub->next = subs;
+    subs = sub;
+    sub->next_id = subs_by_id[bucket];
+    subs_by_id[bucket] = sub;
+}
+
+static uint16_t short_id(const char *name)
+{
+    return ((uint16_t)name[0] << 8) | (uint8_t)name[1];
+}
+
 static void on_disconnect(void)
 {
     if (waiton == DISCONNECT) {
@@ -133,19 +283,35 @@ static void on_disconnect(void)
     }
 }
 
+static int ack_result(int ret_pos, int res_pos)
+{
+    if (ret_pos && (rbuf[ret_pos] != ACCEPT)) {
+        return EMCUTE_REJECT;
+    }
+    if (res_pos == 0) {
+        return EMCUTE_OK;
+    }
+    return (int)byteorder_bebuftohs(&rbuf[res_pos]);
+}
+
 static void on_ack(uint8_t type, int id_pos, int ret_pos, int res_pos)
 {
-    if ((waiton == type) &&
-        (!id_pos || (waitonid == byteorder_bebuftohs(&rbuf[id_pos])))) {
-        if (!ret_pos || (rbuf[ret_pos] == ACCEPT)) {
-            if (res_pos == 0) {
-                result = EMCUTE_OK;
-            } else {
-                result = (int)byteorder_bebuftohs(&rbuf[res_pos]);
+    if (batch_waiton == type) {
+        uint16_t id = byteorder_bebuftohs(&rbuf[id_pos]);
+
+        for (unsigned i = 0; i < EMCUTE_PIPELINE_MAX; i++) {
+            if ((slots[i].idx != SLOT_FREE) && !slots[i].done &&
+                (slots[i].msgid == id)) {
+                slots[i].res = ack_result(ret_pos, res_pos);
+                slots[i].done = true;
+                thread_flags_set((thread_t *)timer.arg, TFLAGS_RESP);
+                break;
             }
-        } else {
-            result = EMCUTE_REJECT;
         }
+    }
+    else if ((waiton == type) &&
+        (!id_pos || (waitonid == byteorder_bebuftohs(&rbuf[id_pos])))) {
+        result = ack_result(ret_pos, res_pos);
         thread_flags_set((thread_t *)timer.arg, TFLAGS_RESP);
     }
 }
@@ -167,14 +333,14 @@ static void on_publish(size_t len, size_t pos)
 
     /* return error code in case we don't support/understand active flags. So
      * far we only understand QoS 1... */
-    if (rbuf[pos + 1] & ~(EMCUTE_QOS_1 | EMCUTE_TIT_SHORT)) {
+    if (rbuf[pos + 1] & ~(EMCUTE_QOS_1 | EMCUTE_TIT_MASK)) {
         buf[6] = REJ_NOTSUP;
         sock_udp_send(&sock, &buf, 7, &gateway);
         return;
     }
 
     /* find the registered topic */
-    for (sub = subs; sub && (sub->topic.id != tid); sub = sub->next) {}
+    sub = sub_find(tid);
     if (sub == NULL) {
         buf[6] = REJ_INVTID;
         sock_udp_send(&sock, &buf, 7, &gateway);
@@ -299,6 +465,27 @@ int emcute_discon(void)
     return syncsend(DISCONNECT, 2, true);
 }
 
+static size_t build_reg(const emcute_topic_t *topic, uint16_t msgid)
+{
+    size_t len = strlen(topic->name);
+
+    tbuf[0] = (len + 6);
+    tbuf[1] = REGISTER;
+    byteorder_htobebufs(&tbuf[2], 0);
+    byteorder_htobebufs(&tbuf[4], msgid);
+    memcpy(&tbuf[6], topic->name, len);
+    return (size_t)tbuf[0];
+}
+
+static int reg_done(emcute_topic_t *topic, int res)
+{
+    if (res > 0) {
+        topic->id = (uint16_t)res;
+        res = EMCUTE_OK;
+    }
+    return res;
+}
+
 int emcute_reg(emcute_topic_t *topic)
 {
     assert(topic && topic->name);
@@ -312,18 +499,42 @@ int emcute_reg(emcute_topic_t *topic)
 
     mutex_lock(&txlock);
 
-    tbuf[0] = (strlen(topic->name) + 6);
-    tbuf[1] = REGISTER;
-    byteorder_htobebufs(&tbuf[2], 0);
-    byteorder_htobebufs(&tbuf[4], id_next);
     waitonid = id_next++;
-    memcpy(&tbuf[6], topic->name, strlen(topic->name));
+    size_t len = build_reg(topic, waitonid);
 
-    int res = syncsend(REGACK, (size_t)tbuf[0], true);
-    if (res > 0) {
-        topic->id = (uint16_t)res;
-        res = EMCUTE_OK;
+    return reg_done(topic, syncsend(REGACK, len, true));
+}
+
+static size_t build_reg_multi(size_t idx, uint16_t msgid)
+{
+    return build_reg(&((emcute_topic_t *)batch_ctx)[idx], msgid);
+}
+
+static int reg_multi_done(size_t idx, int res)
+{
+    return reg_done(&((emcute_topic_t *)batch_ctx)[idx], res);
+}
+
+int emcute_reg_multi(emcute_topic_t *topics, size_t numof)
+{
+    assert(topics || (numof == 0));
+
+    if (gateway.port == 0) {
+        return EMCUTE_NOGW;
     }
+    for (size_t i = 0; i < numof; i++) {
+        assert(topics[i].name);
+        if (strlen(topics[i].name) > EMCUTE_TOPIC_MAXLEN) {
+            return EMCUTE_OVERFLOW;
+        }
+    }
+
+    mutex_lock(&txlock);
+
+    batch_ctx = topics;
+    int res = multisend(REGACK, numof, build_reg_multi, reg_multi_done);
+
+    mutex_unlock(&txlock);
     return res;
 }
 
@@ -332,7 +543,9 @@ int emcute_pub(emcute_topic_t *topic, const void *data, size_t len,
 {
     int res = EMCUTE_OK;
 
-    assert((topic->id != 0) && data && (len > 0) && !(flags & ~PUB_FLAGS));
+    assert(data && (len > 0) && !(flags & ~PUBTOPIC_FLAGS));
+    assert(((flags & EMCUTE_TIT_MASK) == EMCUTE_TIT_SHORT) ?
+           (topic->name && (strlen(topic->name) == 2)) : (topic->id != 0));
 
     if (gateway.port == 0) {
         return EMCUTE_NOGW;
@@ -349,7 +562,9 @@ int emcute_pub(emcute_topic_t *topic, const void *data, size_t len,
     size_t pos = set_len(tbuf, (len + 6));
     tbuf[pos++] = PUBLISH;
     tbuf[pos++] = flags;
-    byteorder_htobebufs(&tbuf[pos], topic->id);
+    byteorder_htobebufs(&tbuf[pos],
+                        ((flags & EMCUTE_TIT_MASK) == EMCUTE_TIT_SHORT) ?
+                        short_id(topic->name) : topic->id);
     pos += 2;
     byteorder_htobebufs(&tbuf[pos], id_next);
     waitonid = id_next++;
@@ -367,48 +582,125 @@ int emcute_pub(emcute_topic_t *topic, const void *data, size_t len,
     return res;
 }
 
+static int sub_check(const emcute_sub_t *sub, unsigned flags)
+{
+    assert(sub && (sub->cb) && !(flags & ~SUB_FLAGS));
+
+    switch (flags & EMCUTE_TIT_MASK) {
+        case EMCUTE_TIT_PREDEF:
+            return EMCUTE_OK;
+        case EMCUTE_TIT_SHORT:
+            assert(sub->topic.name && (strlen(sub->topic.name) == 2));
+            return EMCUTE_OK;
+        default:
+            assert(sub->topic.name);
+            return (strlen(sub->topic.name) > EMCUTE_TOPIC_MAXLEN) ?
+                   EMCUTE_OVERFLOW : EMCUTE_OK;
+    }
+}
+
+/* builds a SUBSCRIBE or UNSUBSCRIBE message, which only differ in type */
+static size_t build_sub(uint8_t type, const emcute_sub_t *sub, unsigned flags,
+                        uint16_t msgid)
+{
+    tbuf[1] = type;
+    tbuf[2] = flags;
+    byteorder_htobebufs(&tbuf[3], msgid);
+    if ((flags & EMCUTE_TIT_MASK) == EMCUTE_TIT_PREDEF) {
+        byteorder_htobebufs(&tbuf[5], sub->topic.id);
+        tbuf[0] = 7;
+    }
+    else {
+        size_t len = strlen(sub->topic.name);
+        memcpy(&tbuf[5], sub->topic.name, len);
+        tbuf[0] = (len + 5);
+    }
+    return (size_t)tbuf[0];
+}
+
+static int sub_done(emcute_sub_t *sub, unsigned flags, int res)
+{
+    if (res < 0) {
+        return res;
+    }
+    DEBUG("[emcute] sub: success, topic id is %i\n", res);
+
+    /* relink in case of a subscription that is already in the list */
+    sub_unlink(sub);
+    sub->tit = flags & EMCUTE_TIT_MASK;
+    switch (sub->tit) {
+        case EMCUTE_TIT_PREDEF:
+            break;
+        case EMCUTE_TIT_SHORT:
+            sub->topic.id = short_id(sub->topic.name);
+            break;
+        default:
+            sub->topic.id = (uint16_t)res;
+            break;
+    }
+    sub_link(sub);
+    return EMCUTE_OK;
+}
+
 int emcute_sub(emcute_sub_t *sub, unsigned flags)
 {
-    assert(sub && (sub->cb) && (sub->topic.name) && !(flags & ~SUB_FLAGS));
+    int res = sub_check(sub, flags);
 
     if (gateway.port == 0) {
         return EMCUTE_NOGW;
     }
-    if (strlen(sub->topic.name) > EMCUTE_TOPIC_MAXLEN) {
-        return EMCUTE_OVERFLOW;
+    if (res != EMCUTE_OK) {
+        return res;
     }
 
     mutex_lock(&txlock);
 
-    tbuf[0] = (strlen(sub->topic.name) + 5);
-    tbuf[1] = SUBSCRIBE;
-    tbuf[2] = flags;
-    byteorder_htobebufs(&tbuf[3], id_next);
     waitonid = id_next++;
-    memcpy(&tbuf[5], sub->topic.name, strlen(sub->topic.name));
+    size_t len = build_sub(SUBSCRIBE, sub, flags, waitonid);
 
-    int res = syncsend(SUBACK, (size_t)tbuf[0], false);
-    if (res > 0) {
-        DEBUG("[emcute] sub: success, topic id is %i\n", res);
-        sub->topic.id = res;
-
-        /* check if subscription is already in the list, only insert if not*/
-        emcute_sub_t *s;
-        for (s = subs; s && (s != sub); s = s->next) {}
-        if (!s) {
-            sub->next = subs;
-            subs = sub;
-            res = EMCUTE_OK;
+    res = sub_done(sub, flags, syncsend(SUBACK, len, false));
+
+    mutex_unlock(&txlock);
+    return res;
+}
+
+static size_t build_sub_multi(size_t idx, uint16_t msgid)
+{
+    return build_sub(SUBSCRIBE, &((emcute_sub_t *)batch_ctx)[idx],
+                     batch_flags, msgid);
+}
+
+static int sub_multi_done(size_t idx, int res)
+{
+    return sub_done(&((emcute_sub_t *)batch_ctx)[idx], batch_flags, res);
+}
+
+int emcute_sub_multi(emcute_sub_t *subs, size_t numof, unsigned flags)
+{
+    assert(subs || (numof == 0));
+
+    if (gateway.port == 0) {
+        return EMCUTE_NOGW;
+    }
+    for (size_t i = 0; i < numof; i++) {
+        if (sub_check(&subs[i], flags) != EMCUTE_OK) {
+            return EMCUTE_OVERFLOW;
         }
     }
 
+    mutex_lock(&txlock);
+
+    batch_ctx = subs;
+    batch_flags = flags;
+    int res = multisend(SUBACK, numof, build_sub_multi, sub_multi_done);
+
     mutex_unlock(&txlock);
     return res;
 }
 
 int emcute_unsub(emcute_sub_t *sub)
 {
-    assert(sub && sub->topic.name);
+    assert(sub && (sub->topic.name || (sub->tit == EMCUTE_TIT_PREDEF)));
 
     if (gateway.port == 0) {
         return EMCUTE_NOGW;
@@ -416,27 +708,12 @@ int emcute_unsub(emcute_sub_t *sub)
 
     mutex_lock(&txlock);
 
-    tbuf[0] = (strlen(sub->topic.name) + 5);
-    tbuf[1] = UNSUBSCRIBE;
-    tbuf[2] = 0;
-    byteorder_htobebufs(&tbuf[3], id_next);
     waitonid = id_next++;
-    memcpy(&tbuf[5], sub->topic.name, strlen(sub->topic.name));
+    size_t len = build_sub(UNSUBSCRIBE, sub, sub->tit, waitonid);
 
-    int res = syncsend(UNSUBACK, (size_t)tbuf[0], false);
+    int res = syncsend(UNSUBACK, len, false);
     if (res == EMCUTE_OK) {
-        if (subs == sub) {
-            subs = sub->next;
-        }
-        else {
-            emcute_sub_t *s;
-            for (s = subs; s; s = s->next) {
-                if (s->next == sub) {
-                    s->next = sub->next;
-                    break;
-                }
-            }
-        }
+        sub_unlink(sub);
     }
 
     mutex_unlock(&txlock);
@@ -26,9 +26,11 @@
 #include <string.h>
 
 #include "assert.h"
+#include "hashes.h"
 #include "net/gcoap.h"
 #include "net/sock/async/event.h"
 #include "net/sock/util.h"
+#include "msg.h"
 #include "mutex.h"
 #include "random.h"
 #include "thread.h"
@@ -44,6 +46,9 @@
 /* End of the range to pick a random timeout */
 #define TIMEOUT_RANGE_END (CONFIG_COAP_ACK_TIMEOUT * CONFIG_COAP_RANDOM_FACTOR_1000 / 1000)
 
+/* Minimum interval between notifications, in usec */
+#define OBS_NOTIFY_MIN_US (CONFIG_GCOAP_OBS_NOTIFY_MIN_INTERVAL * US_PER_MS)
+
 /* Internal functions */
 static void *_event_loop(void *arg);
 static void _on_sock_evt(sock_udp_t *sock, sock_async_flags_t type, void *arg);
@@ -57,9 +62,13 @@ static int _find_resource(coap_pkt_t *pdu, const coap_resource_t **resource_ptr,
                                             gcoap_listener_t **listener_ptr);
 static int _find_observer(sock_udp_ep_t **observer, sock_udp_ep_t *remote);
 static int _find_obs_memo(gcoap_observe_memo_t **memo, sock_udp_ep_t *remote,
-                                                       coap_pkt_t *pdu);
+                          coap_pkt_t *pdu, const coap_resource_t *resource);
 static void _find_obs_memo_resource(gcoap_observe_memo_t **memo,
                                    const coap_resource_t *resource);
+#if CONFIG_GCOAP_OBS_NOTIFY_MIN_INTERVAL
+static void _obs_notify_init(void);
+static void _obs_notify_reset(gcoap_observe_memo_t *memo);
+#endif
 
 /* Internal variables */
 const coap_resource_t _default_resources[] = {
@@ -67,10 +76,10 @@ const coap_resource_t _default_resources[] = {
 };
 
 static gcoap_listener_t _default_listener = {
-    &_default_resources[0],
-    ARRAY_SIZE(_default_resources),
-    NULL,
-    NULL
+    .resources     = &_default_resources[0],
+    .resources_len = ARRAY_SIZE(_default_resources),
+    .link_encoder  = NULL,
+    .next          = NULL,
 };
 
 /* Container for the state of gcoap itself */
@@ -103,6 +112,108 @@ static event_queue_t _queue;
 static uint8_t _listen_buf[CONFIG_GCOAP_PDU_BUF_SIZE];
 static sock_udp_t _sock;
 
+#if IS_USED(MODULE_GCOAP_WORKERS)
+/* Request handed to a worker; busy is protected by _coap_state.lock */
+typedef struct {
+    uint8_t buf[CONFIG_GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+    sock_udp_ep_t remote;
+    const coap_resource_t *resource;
+    kernel_pid_t pid;
+    bool busy;
+} _worker_job_t;
+
+static char _worker_stacks[CONFIG_GCOAP_WORKERS_NUMOF][GCOAP_WORKER_STACK_SIZE];
+static _worker_job_t _worker_jobs[CONFIG_GCOAP_WORKERS_NUMOF];
+
+/* Runs blocking resource handlers and sends their responses. Each worker
+ * owns one job slot. */
+static void *_worker_loop(void *arg)
+{
+    _worker_job_t *job = arg;
+
+    while (1) {
+        msg_t msg;
+        msg_receive(&msg);
+        ssize_t pdu_len = job->resource->handler(&job->pdu, job->buf,
+                                                 sizeof(job->buf),
+                                                 job->resource->context);
+        if (pdu_len < 0) {
+            pdu_len = gcoap_response(&job->pdu, job->buf, sizeof(job->buf),
+                                     COAP_CODE_INTERNAL_SERVER_ERROR);
+        }
+        if (pdu_len > 0) {
+            ssize_t bytes = sock_udp_send(&_sock, job->buf, pdu_len,
+                                          &job->remote);
+            if (bytes <= 0) {
+                DEBUG("gcoap: send response failed: %d\n", (int)bytes);
+            }
+        }
+
+        mutex_lock(&_coap_state.lock);
+        job->busy = false;
+        mutex_unlock(&_coap_state.lock);
+    }
+
+    return NULL;
+}
+
+/*
+ * Hands a request to a worker. The request is copied, as the listen buffer
+ * is reused for the next request.
+ *
+ * return true if a worker takes the request, false if all are busy
+ */
+static bool _dispatch_to_worker(coap_pkt_t *pdu, const coap_resource_t *resource,
+                                const sock_udp_ep_t *remote)
+{
+    _worker_job_t *job = NULL;
+
+    mutex_lock(&_coap_state.lock);
+    for (unsigned i = 0; i < CONFIG_GCOAP_WORKERS_NUMOF; i++) {
+        if (!_worker_jobs[i].busy) {
+            job = &_worker_jobs[i];
+            job->busy = true;
+            break;
+        }
+    }
+    mutex_unlock(&_coap_state.lock);
+    if (job == NULL) {
+        return false;
+    }
+
+    uint8_t *start = (uint8_t *)pdu->hdr;
+    size_t req_len = (pdu->payload - start) + pdu->payload_len;
+    memcpy(job->buf, start, req_len);
+    /* rebase the parsed request onto the job buffer; option positions are
+     * relative to the header and remain valid */
+    job->pdu = *pdu;
+    job->pdu.hdr = (coap_hdr_t *)job->buf;
+    job->pdu.token = job->buf + (pdu->token - start);
+    job->pdu.payload = job->buf + (pdu->payload - start);
+    job->remote = *remote;
+    job->resource = resource;
+
+    /* an idle worker is in msg_receive() or about to enter it, so this
+     * blocks at most briefly */
+    msg_t msg = { .content.ptr = job };
+    msg_send(&msg, job->pid);
+    return true;
+}
+
+static void _workers_init(void)
+{
+    for (unsigned i = 0; i < CONFIG_GCOAP_WORKERS_NUMOF; i++) {
+        _worker_jobs[i].pid = thread_create(_worker_stacks[i],
+                                            sizeof(_worker_stacks[i]),
+                                            THREAD_PRIORITY_MAIN - 1,
+                                            THREAD_CREATE_STACKTEST,
+                                            _worker_loop, &_worker_jobs[i],
+                                            "coap worker");
+    }
+}
+#endif /* MODULE_GCOAP_WORKERS */
+
 /* Event loop for gcoap _pid thread. */
 static void *_event_loop(void *arg)
 {
@@ -294,7 +405,7 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
 
     if (coap_get_observe(pdu) == COAP_OBS_REGISTER) {
         /* lookup remote+token */
-        int empty_slot = _find_obs_memo(&memo, remote, pdu);
+        int empty_slot = _find_obs_memo(&memo, remote, pdu, resource);
         /* validate re-registration request */
         if (resource_memo != NULL) {
             if (memo != NULL) {
@@ -343,17 +454,24 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
             if (memo->token_len) {
                 memcpy(&memo->token[0], pdu->token, memo->token_len);
             }
+#if CONFIG_GCOAP_OBS_NOTIFY_MIN_INTERVAL
+            /* a held back notification may carry the old token */
+            _obs_notify_reset(memo);
+#endif
             DEBUG("gcoap: Registered observer for: %s\n", memo->resource->path);
         }
 
     } else if (coap_get_observe(pdu) == COAP_OBS_DEREGISTER) {
-        _find_obs_memo(&memo, remote, pdu);
+        _find_obs_memo(&memo, remote, pdu, NULL);
         /* clear memo, and clear observer if no other memos */
         if (memo != NULL) {
             DEBUG("gcoap: Deregistering observer for: %s\n", memo->resource->path);
+#if CONFIG_GCOAP_OBS_NOTIFY_MIN_INTERVAL
+            _obs_notify_reset(memo);
+#endif
             memo->observer = NULL;
             memo           = NULL;
-            _find_obs_memo(&memo, remote, NULL);
+            _find_obs_memo(&memo, remote, NULL, NULL);
             if (memo == NULL) {
                 _find_observer(&observer, remote);
                 if (observer != NULL) {
@@ -369,6 +487,17 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
         return -1;
     }
 
+#if IS_USED(MODULE_GCOAP_WORKERS)
+    if (resource->methods & COAP_HANDLER_MAY_BLOCK) {
+        if (_dispatch_to_worker(pdu, resource, remote)) {
+            /* worker sends the response */
+            return 0;
+        }
+        DEBUG("gcoap: all workers busy\n");
+        return gcoap_response(pdu, buf, len, COAP_CODE_SERVICE_UNAVAILABLE);
+    }
+#endif
+
     ssize_t pdu_len = resource->handler(pdu, buf, len, resource->context);
     if (pdu_len < 0) {
         pdu_len = gcoap_response(pdu, buf, len,
@@ -377,6 +506,77 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
     return pdu_len;
 }
 
+/*
+ * Hash table helpers
+ *
+ * The open request, observer and observe memo arrays are used as hash tables
+ * with linear probing. An entry is placed at the first free slot in probe
+ * order starting at the slot its key hashes to, so lookups usually succeed on
+ * the first probe. Slots are freed without tombstones, hence a lookup for a
+ * missing key still probes the whole table.
+ */
+static unsigned _token_slot(const uint8_t *token, unsigned token_len)
+{
+    return djb2_hash(token, token_len) % CONFIG_GCOAP_REQ_WAITING_MAX;
+}
+
+static unsigned _ep_slot(const sock_udp_ep_t *ep)
+{
+    const uint8_t *addr = ep->addr.ipv4;
+    size_t addr_len = sizeof(ep->addr.ipv4);
+
+#ifdef SOCK_HAS_IPV6
+    if (ep->family == AF_INET6) {
+        addr = ep->addr.ipv6;
+        addr_len = sizeof(ep->addr.ipv6);
+    }
+#endif
+    return (djb2_hash(addr, addr_len) ^ ep->port) % CONFIG_GCOAP_OBS_CLIENTS_MAX;
+}
+
+static unsigned _resource_slot(const coap_resource_t *resource)
+{
+    return ((uintptr_t)resource / sizeof(coap_resource_t))
+           % CONFIG_GCOAP_OBS_REGISTRATIONS_MAX;
+}
+
+/*
+ * Looks up a path in the resources of an indexed listener by binary search.
+ * Resources with the same path are adjacent, so all of them are checked for
+ * a matching method.
+ */
+static int _find_resource_indexed(const gcoap_listener_t *listener,
+                                  const uint8_t *uri,
+                                  coap_method_flags_t method_flag,
+                                  const coap_resource_t **resource_ptr)
+{
+    size_t lo = 0, hi = listener->resources_len;
+    int ret = GCOAP_RESOURCE_NO_PATH;
+
+    /* find first resource with path >= uri */
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (strcmp(listener->resources[mid].path, (const char *)uri) < 0) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    for (; lo < listener->resources_len; lo++) {
+        const coap_resource_t *resource = &listener->resources[lo];
+        if (strcmp(resource->path, (const char *)uri) != 0) {
+            break;
+        }
+        if (resource->methods & method_flag) {
+            *resource_ptr = resource;
+            return GCOAP_RESOURCE_FOUND;
+        }
+        ret = GCOAP_RESOURCE_WRONG_METHOD;
+    }
+    return ret;
+}
+
 /*
  * Searches listener registrations for the resource matching the path in a PDU.
  *
@@ -402,6 +602,20 @@ static int _find_resource(coap_pkt_t *pdu, const coap_resource_t **resource_ptr,
     }
 
     while (listener) {
+        if (listener->indexed) {
+            int res = _find_resource_indexed(listener, uri, method_flag,
+                                             resource_ptr);
+            if (res == GCOAP_RESOURCE_FOUND) {
+                *listener_ptr = listener;
+                return res;
+            }
+            if (res == GCOAP_RESOURCE_WRONG_METHOD) {
+                ret = res;
+            }
+            listener = listener->next;
+            continue;
+        }
+
         const coap_resource_t *resource = listener->resources;
         for (size_t i = 0; i < listener->resources_len; i++) {
             if (i) {
@@ -449,8 +663,10 @@ static void _find_req_memo(gcoap_request_memo_t **memo_ptr, coap_pkt_t *src_pdu,
     coap_pkt_t memo_pdu_data;
     coap_pkt_t *memo_pdu = &memo_pdu_data;
     unsigned cmplen      = coap_get_token_len(src_pdu);
+    unsigned slot        = _token_slot(src_pdu->token, cmplen);
 
-    for (int i = 0; i < CONFIG_GCOAP_REQ_WAITING_MAX; i++) {
+    for (int n = 0; n < CONFIG_GCOAP_REQ_WAITING_MAX; n++) {
+        unsigned i = (slot + n) % CONFIG_GCOAP_REQ_WAITING_MAX;
         if (_coap_state.open_reqs[i].state == GCOAP_MEMO_UNUSED) {
             continue;
         }
@@ -532,11 +748,15 @@ static ssize_t _well_known_core_handler(coap_pkt_t* pdu, uint8_t *buf, size_t le
 static int _find_observer(sock_udp_ep_t **observer, sock_udp_ep_t *remote)
 {
     int empty_slot = -1;
+    unsigned slot  = _ep_slot(remote);
     *observer      = NULL;
-    for (unsigned i = 0; i < CONFIG_GCOAP_OBS_CLIENTS_MAX; i++) {
+    for (unsigned n = 0; n < CONFIG_GCOAP_OBS_CLIENTS_MAX; n++) {
+        unsigned i = (slot + n) % CONFIG_GCOAP_OBS_CLIENTS_MAX;
 
         if (_coap_state.observers[i].family == AF_UNSPEC) {
-            empty_slot = i;
+            if (empty_slot < 0) {
+                empty_slot = i;
+            }
         }
         else if (sock_udp_ep_equal(&_coap_state.observers[i], remote)) {
             *observer = &_coap_state.observers[i];
@@ -552,22 +772,27 @@ static int _find_observer(sock_udp_ep_t **observer, sock_udp_ep_t *remote)
  * memo[out] -- Registered observe memo, or NULL if not found
  * remote[in] -- Endpoint for address to match
  * pdu[in] -- PDU for token to match, or NULL to match only on remote address
+ * resource[in] -- Resource a new memo is registered for, or NULL
  *
- * return Index of empty slot, suitable for registering new memo; or -1 if no
- *        empty slots. Undefined if memo found.
+ * return Index of empty slot, suitable for registering new memo for
+ *        @p resource; or -1 if no empty slots. Undefined if memo found.
  */
 static int _find_obs_memo(gcoap_observe_memo_t **memo, sock_udp_ep_t *remote,
-                                                       coap_pkt_t *pdu)
+                          coap_pkt_t *pdu, const coap_resource_t *resource)
 {
     int empty_slot = -1;
+    unsigned slot  = (resource != NULL) ? _resource_slot(resource) : 0;
     *memo          = NULL;
 
     sock_udp_ep_t *remote_observer = NULL;
     _find_observer(&remote_observer, remote);
 
-    for (unsigned i = 0; i < CONFIG_GCOAP_OBS_REGISTRATIONS_MAX; i++) {
+    for (unsigned n = 0; n < CONFIG_GCOAP_OBS_REGISTRATIONS_MAX; n++) {
+        unsigned i = (slot + n) % CONFIG_GCOAP_OBS_REGISTRATIONS_MAX;
         if (_coap_state.observe_memos[i].observer == NULL) {
-            empty_slot = i;
+            if (empty_slot < 0) {
+                empty_slot = i;
+            }
             continue;
         }
 
@@ -600,8 +825,11 @@ static int _find_obs_memo(gcoap_observe_memo_t **memo, sock_udp_ep_t *remote,
 static void _find_obs_memo_resource(gcoap_observe_memo_t **memo,
                                    const coap_resource_t *resource)
 {
+    unsigned slot = _resource_slot(resource);
+
     *memo = NULL;
-    for (int i = 0; i < CONFIG_GCOAP_OBS_REGISTRATIONS_MAX; i++) {
+    for (unsigned n = 0; n < CONFIG_GCOAP_OBS_REGISTRATIONS_MAX; n++) {
+        unsigned i = (slot + n) % CONFIG_GCOAP_OBS_REGISTRATIONS_MAX;
         if (_coap_state.observe_memos[i].observer != NULL
                 && _coap_state.observe_memos[i].resource == resource) {
             *memo = &_coap_state.observe_memos[i];
@@ -628,8 +856,14 @@ kernel_pid_t gcoap_init(void)
     memset(&_coap_state.observers[0], 0, sizeof(_coap_state.observers));
     memset(&_coap_state.observe_memos[0], 0, sizeof(_coap_state.observe_memos));
     memset(&_coap_state.resend_bufs[0], 0, sizeof(_coap_state.resend_bufs));
+#if CONFIG_GCOAP_OBS_NOTIFY_MIN_INTERVAL
+    _obs_notify_init();
+#endif
     /* randomize initial value */
     atomic_init(&_coap_state.next_message_id, (unsigned)random_uint32());
+#if IS_USED(MODULE_GCOAP_WORKERS)
+    _workers_init();
+#endif
 
     return _pid;
 }
@@ -646,6 +880,17 @@ void gcoap_register_listener(gcoap_listener_t *listener)
     if (!listener->link_encoder) {
         listener->link_encoder = gcoap_encode_link;
     }
+    /* binary search needs sorted exact paths; subtree matches are prefix
+     * matches and break the ordering, so such listeners are scanned */
+    listener->indexed = true;
+    for (size_t i = 0; i < listener->resources_len; i++) {
+        const coap_resource_t *resource = &listener->resources[i];
+        if ((resource->methods & COAP_MATCH_SUBTREE) ||
+            ((i > 0) && (strcmp(resource[-1].path, resource->path) > 0))) {
+            listener->indexed = false;
+            break;
+        }
+    }
     _last->next = listener;
 }
 
@@ -739,9 +984,14 @@ size_t gcoap_req_send(const uint8_t *buf, size_t len,
     /* Only allocate memory if necessary (i.e. if user is interested in the
      * response or request is confirmable) */
     if ((resp_handler != NULL) || (msg_type == COAP_TYPE_CON)) {
+        coap_hdr_t *hdr = (coap_hdr_t *)buf;
+        unsigned slot = _token_slot(coap_hdr_data_ptr(hdr),
+                                    hdr->ver_t_tkl & 0xf);
+
         mutex_lock(&_coap_state.lock);
-        /* Find empty slot in list of open requests. */
-        for (int i = 0; i < CONFIG_GCOAP_REQ_WAITING_MAX; i++) {
+        /* Find empty slot in list of open requests, starting at token hash */
+        for (int n = 0; n < CONFIG_GCOAP_REQ_WAITING_MAX; n++) {
+            unsigned i = (slot + n) % CONFIG_GCOAP_REQ_WAITING_MAX;
             if (_coap_state.open_reqs[i].state == GCOAP_MEMO_UNUSED) {
                 memo = &_coap_state.open_reqs[i];
                 memo->state = GCOAP_MEMO_WAIT;
@@ -839,6 +1089,9 @@ int gcoap_resp_init(coap_pkt_t *pdu, uint8_t *buf, size_t len, unsigned code)
     unsigned header_len  = coap_get_total_hdr_len(pdu);
 
     pdu->options_len = 0;
+#ifdef MODULE_NANOCOAP_OPT_INDEX
+    memset(pdu->opt_index, 0, sizeof(pdu->opt_index));
+#endif
     pdu->payload     = buf + header_len;
     pdu->payload_len = len - header_len - CONFIG_GCOAP_RESP_OPTIONS_BUF;
 
@@ -852,6 +1105,80 @@ int gcoap_resp_init(coap_pkt_t *pdu, uint8_t *buf, size_t len, unsigned code)
     return 0;
 }
 
+#if CONFIG_GCOAP_OBS_NOTIFY_MIN_INTERVAL
+/*
+ * Sends the notification held back for a registration, at the end of the
+ * minimum interval. Runs in the gcoap thread.
+ */
+static void _obs_notify_pending(void *arg)
+{
+    gcoap_observe_memo_t *memo = arg;
+
+    mutex_lock(&_coap_state.lock);
+    if ((memo->observer != NULL) && (memo->pending_len > 0)) {
+        DEBUG("gcoap: sending held back notification\n");
+        sock_udp_send(&_sock, memo->pending, memo->pending_len, memo->observer);
+        memo->last_notify = xtimer_now_usec();
+    }
+    memo->pending_len = 0;
+    mutex_unlock(&_coap_state.lock);
+}
+
+static void _obs_notify_init(void)
+{
+    for (unsigned i = 0; i < CONFIG_GCOAP_OBS_REGISTRATIONS_MAX; i++) {
+        gcoap_observe_memo_t *memo = &_coap_state.observe_memos[i];
+
+        event_callback_init(&memo->notify_cb, _obs_notify_pending, memo);
+        event_timeout_init(&memo->notify_tmout, &_queue,
+                           &memo->notify_cb.super);
+    }
+}
+
+/*
+ * Drops a held back notification and allows the next one right away.
+ */
+static void _obs_notify_reset(gcoap_observe_memo_t *memo)
+{
+    mutex_lock(&_coap_state.lock);
+    event_timeout_clear(&memo->notify_tmout);
+    memo->pending_len = 0;
+    memo->last_notify = xtimer_now_usec() - OBS_NOTIFY_MIN_US;
+    mutex_unlock(&_coap_state.lock);
+}
+
+/*
+ * Holds back a notification within the minimum interval after the previous
+ * one, replacing any notification held back before.
+ *
+ * return true if the notification was held back, false if it must be sent
+ *        now
+ */
+static bool _obs_notify_hold_back(gcoap_observe_memo_t *memo,
+                                  const uint8_t *buf, size_t len)
+{
+    uint32_t elapsed = xtimer_now_usec() - memo->last_notify;
+
+    if ((memo->pending_len == 0) && (elapsed >= OBS_NOTIFY_MIN_US)) {
+        memo->last_notify += elapsed;
+        return false;
+    }
+    if (len > sizeof(memo->pending)) {
+        /* can't be held back, so the one held back before is outdated */
+        event_timeout_clear(&memo->notify_tmout);
+        memo->pending_len = 0;
+        memo->last_notify += elapsed;
+        return false;
+    }
+    if (memo->pending_len == 0) {
+        event_timeout_set(&memo->notify_tmout, OBS_NOTIFY_MIN_US - elapsed);
+    }
+    memcpy(memo->pending, buf, len);
+    memo->pending_len = len;
+    return true;
+}
+#endif
+
 int gcoap_obs_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
                                                   const coap_resource_t *resource)
 {
@@ -891,6 +1218,14 @@ size_t gcoap_obs_send(const uint8_t *buf, size_t len,
     _find_obs_memo_resource(&memo, resource);
 
     if (memo) {
+#if CONFIG_GCOAP_OBS_NOTIFY_MIN_INTERVAL
+        mutex_lock(&_coap_state.lock);
+        bool held_back = _obs_notify_hold_back(memo, buf, len);
+        mutex_unlock(&_coap_state.lock);
+        if (held_back) {
+            return len;
+        }
+#endif
         ssize_t bytes = sock_udp_send(&_sock, buf, len, memo->observer);
         return (size_t)((bytes > 0) ? bytes : 0);
     }
@@ -32,6 +32,26 @@
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
+#ifdef MODULE_NANOCOAP_OPT_INDEX
+static_assert(CONFIG_NANOCOAP_NOPTS_MAX < UINT8_MAX,
+              "option index can't address all options");
+#endif
+
+/* Records the position of an option in the option index */
+static inline void _opt_index_add(coap_pkt_t *pkt, unsigned opt_num,
+                                  unsigned pos)
+{
+#ifdef MODULE_NANOCOAP_OPT_INDEX
+    if (opt_num < NANOCOAP_OPT_INDEX_NUMOF) {
+        pkt->opt_index[opt_num] = pos + 1;
+    }
+#else
+    (void)pkt;
+    (void)opt_num;
+    (void)pos;
+#endif
+}
+
 /**
  * @name    Internally used CoAP packet types
  * @{
@@ -96,6 +116,10 @@ int coap_parse(coap_pkt_t *pkt, uint8_t *buf, size_t len)
     unsigned option_count = 0;
     unsigned option_nr = 0;
 
+#ifdef MODULE_NANOCOAP_OPT_INDEX
+    memset(pkt->opt_index, 0, sizeof(pkt->opt_index));
+#endif
+
     /* parse options */
     while (pkt_pos < pkt_end) {
         uint8_t *option_start = pkt_pos;
@@ -128,6 +152,7 @@ int coap_parse(coap_pkt_t *pkt, uint8_t *buf, size_t len)
 
                 optpos->opt_num = option_nr;
                 optpos->offset = (uintptr_t)option_start - (uintptr_t)hdr;
+                _opt_index_add(pkt, option_nr, option_count);
                 DEBUG("optpos option_nr=%u %u\n", (unsigned)option_nr, (unsigned)optpos->offset);
                 optpos++;
                 option_count++;
@@ -178,6 +203,13 @@ int coap_match_path(const coap_resource_t *resource, uint8_t *uri)
 
 uint8_t *coap_find_option(const coap_pkt_t *pkt, unsigned opt_num)
 {
+#ifdef MODULE_NANOCOAP_OPT_INDEX
+    if (opt_num < NANOCOAP_OPT_INDEX_NUMOF) {
+        unsigned pos = pkt->opt_index[opt_num];
+        return (pos) ? (uint8_t *)pkt->hdr + pkt->options[pos - 1].offset
+                     : NULL;
+    }
+#endif
     const coap_optpos_t *optpos = pkt->options;
     unsigned opt_count = pkt->options_len;
 
@@ -817,6 +849,10 @@ static ssize_t _add_opt_pkt(coap_pkt_t *pkt, uint16_t optnum, const uint8_t *val
 
     pkt->options[pkt->options_len].opt_num = optnum;
     pkt->options[pkt->options_len].offset = pkt->payload - (uint8_t *)pkt->hdr;
+    /* repeated options are located by their first occurrence */
+    if (optnum != lastonum) {
+        _opt_index_add(pkt, optnum, pkt->options_len);
+    }
     pkt->options_len++;
     pkt->payload += optlen;
     pkt->payload_len -= optlen;
@@ -1027,6 +1063,108 @@ ssize_t coap_block2_build_reply(coap_pkt_t *pkt, unsigned code,
     return coap_build_reply(pkt, code, rbuf, rlen, payload_len);
 }
 
+/* ETag, Content-Format, Block2 and Size2 options plus payload marker */
+#define BLOCK2_STREAM_OPT_MAXLEN    ((1 + 4) + (1 + 2) + (2 + 3) + (2 + 4) + 1)
+
+ssize_t coap_block2_stream_reply(coap_pkt_t *pkt, uint8_t *rbuf, unsigned rlen,
+                                 const coap_block2_stream_t *stream)
+{
+    coap_block_slicer_t slicer;
+    uint8_t etag[sizeof(stream->etag)];
+    uint8_t *req_etag;
+    unsigned hdr_len = coap_get_total_hdr_len(pkt);
+
+    /* parse everything needed from the request before overwriting it */
+    coap_block2_init(pkt, &slicer);
+    network_uint32_t etag_be = byteorder_htonl(stream->etag);
+    memcpy(etag, &etag_be, sizeof(etag));
+    ssize_t req_etag_len = coap_opt_get_opaque(pkt, COAP_OPT_ETAG, &req_etag);
+
+    if (rlen < hdr_len + BLOCK2_STREAM_OPT_MAXLEN + coap_szx2size(0)) {
+        return -ENOSPC;
+    }
+
+    uint8_t *payload = rbuf + hdr_len;
+    uint8_t *bufpos = payload;
+
+    if ((req_etag_len == sizeof(etag)) &&
+        (memcmp(req_etag, etag, sizeof(etag)) == 0)) {
+        bufpos += coap_put_option(bufpos, 0, COAP_OPT_ETAG, etag, sizeof(etag));
+        return coap_build_reply(pkt, COAP_CODE_VALID, rbuf, rlen,
+                                bufpos - payload);
+    }
+
+    /* shrink the block until it fits into the reply buffer */
+    size_t blksize = slicer.end - slicer.start;
+    size_t avail = rlen - hdr_len - BLOCK2_STREAM_OPT_MAXLEN;
+    while (blksize > avail) {
+        blksize >>= 1;
+    }
+    coap_block_slicer_init(&slicer, slicer.start / blksize, blksize);
+
+    if ((slicer.start > stream->len) ||
+        ((slicer.start == stream->len) && (stream->len > 0))) {
+        return coap_build_reply(pkt, COAP_CODE_BAD_OPTION, rbuf, rlen, 0);
+    }
+
+    size_t chunk = stream->len - slicer.start;
+    if (chunk > blksize) {
+        chunk = blksize;
+    }
+    bool more = slicer.end < stream->len;
+    uint16_t lastonum = COAP_OPT_ETAG;
+
+    bufpos += coap_put_option(bufpos, 0, COAP_OPT_ETAG, etag, sizeof(etag));
+    if (stream->format != COAP_FORMAT_NONE) {
+        bufpos += coap_put_option_ct(bufpos, lastonum, stream->format);
+        lastonum = COAP_OPT_CONTENT_FORMAT;
+    }
+    bufpos += coap_opt_put_block2(bufpos, lastonum, &slicer, more);
+    bufpos += coap_opt_put_uint(bufpos, COAP_OPT_BLOCK2, COAP_OPT_SIZE2,
+                                stream->len);
+
+    if (chunk > 0) {
+        *bufpos++ = 0xff;
+        ssize_t res = stream->read(stream->arg, slicer.start, bufpos, chunk);
+        if (res != (ssize_t)chunk) {
+            DEBUG("nanocoap: block2 stream read failed: %d\n", (int)res);
+            return coap_build_reply(pkt, COAP_CODE_INTERNAL_SERVER_ERROR,
+                                    rbuf, rlen, 0);
+        }
+        bufpos += chunk;
+    }
+
+    return coap_build_reply(pkt, COAP_CODE_205, rbuf, rlen, bufpos - payload);
+}
+
+ssize_t coap_block1_stream_reply(coap_pkt_t *pkt, uint8_t *rbuf, unsigned rlen,
+                                 coap_block1_write_cb_t write, void *arg)
+{
+    coap_block1_t block1;
+
+    coap_get_block1(pkt, &block1);
+    int res = write(arg, block1.offset, pkt->payload, pkt->payload_len,
+                    block1.more == 1);
+    if (res == -EINVAL) {
+        return coap_build_reply(pkt, COAP_CODE_REQUEST_ENTITY_INCOMPLETE,
+                                rbuf, rlen, 0);
+    }
+    else if (res < 0) {
+        return coap_build_reply(pkt, COAP_CODE_INTERNAL_SERVER_ERROR,
+                                rbuf, rlen, 0);
+    }
+
+    /* a block1 option takes at most 4 bytes */
+    unsigned hdr_len = coap_get_total_hdr_len(pkt);
+    if (rlen < hdr_len + 4) {
+        return -ENOSPC;
+    }
+    size_t opt_len = coap_put_block1_ok(rbuf + hdr_len, &block1, 0);
+    return coap_build_reply(pkt, (block1.more == 1) ? COAP_CODE_CONTINUE
+                                                    : COAP_CODE_CHANGED,
+                            rbuf, rlen, opt_len);
+}
+
 size_t coap_blockwise_put_char(coap_block_slicer_t *slicer, uint8_t *bufpos, char c)
 {
     /* Only copy the char if it is within the window */
@@ -0,0 +1,455 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_nanocoap_tcp
+ * @{
+ *
+ * @file
+ * @brief       nanocoap CoAP over TCP implementation
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "byteorder.h"
+#include "mutex.h"
+#include "net/coap.h"
+#include "net/nanocoap_tcp.h"
+#include "net/sock/util.h"
+#include "timex.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/* Len nibbles announcing an extended length of 1, 2 or 4 bytes */
+#define LEN_EXT8            (13U)
+#define LEN_EXT16           (14U)
+#define LEN_EXT32           (15U)
+#define LEN_EXT16_OFFSET    (269U)
+#define LEN_EXT32_OFFSET    (65805UL)
+
+#define TIMEOUT_US          (CONFIG_NANOCOAP_TCP_TIMEOUT * US_PER_MS)
+
+typedef struct {
+    sock_tcp_t sock;
+    sock_tcp_ep_t remote;
+    mutex_t lock;               /* held during a request */
+    uint32_t last_used;
+    uint32_t peer_max_msg_size;
+    bool connected;
+    bool peer_bert;
+} _conn_t;
+
+static _conn_t _conns[CONFIG_NANOCOAP_TCP_CONN_NUMOF];
+static mutex_t _pool_lock = MUTEX_INIT;
+static uint32_t _uses;
+
+static int _write_all(_conn_t *conn, const uint8_t *buf, size_t len)
+{
+    while (len) {
+        ssize_t res = sock_tcp_write(&conn->sock, buf, len);
+
+        if (res < 0) {
+            return res;
+        }
+        buf += res;
+        len -= res;
+    }
+    return 0;
+}
+
+static int _read_all(_conn_t *conn, uint8_t *buf, size_t len)
+{
+    while (len) {
+        ssize_t res = sock_tcp_read(&conn->sock, buf, len, TIMEOUT_US);
+
+        if (res <= 0) {
+            return (res == 0) ? -ECONNRESET : res;
+        }
+        buf += res;
+        len -= res;
+    }
+    return 0;
+}
+
+static void _close(_conn_t *conn)
+{
+    DEBUG("nanocoap_tcp: closing connection %u\n",
+          (unsigned)(conn - _conns));
+    sock_tcp_disconnect(&conn->sock);
+    conn->connected = false;
+}
+
+static size_t _len_encode(size_t len, uint8_t *nibble, uint8_t *ext)
+{
+    if (len < LEN_EXT8) {
+        *nibble = len;
+        return 0;
+    }
+    if (len < LEN_EXT16_OFFSET) {
+        *nibble = LEN_EXT8;
+        ext[0] = len - LEN_EXT8;
+        return 1;
+    }
+    if (len < LEN_EXT32_OFFSET) {
+        *nibble = LEN_EXT16;
+        byteorder_htobebufs(ext, len - LEN_EXT16_OFFSET);
+        return 2;
+    }
+    network_uint32_t val = byteorder_htonl(len - LEN_EXT32_OFFSET);
+
+    *nibble = LEN_EXT32;
+    memcpy(ext, &val, sizeof(val));
+    return 4;
+}
+
+/* converts a message in the UDP format in place and sends it */
+static int _send_msg(_conn_t *conn, uint8_t *buf, size_t len, size_t buf_len)
+{
+    unsigned tkl = buf[0] & 0xf;
+    uint8_t code = buf[1];
+    size_t udp_hdr_len = sizeof(coap_hdr_t) + tkl;
+    size_t body_len = len - udp_hdr_len;
+    uint8_t nibble, ext[4];
+    size_t ext_len = _len_encode(body_len, &nibble, ext);
+    size_t hdr_len = 2 + ext_len + tkl;
+
+    if (len - udp_hdr_len + hdr_len > buf_len) {
+        return -ENOBUFS;
+    }
+    /* the header grows by up to two bytes, so move the body first then */
+    if (hdr_len > udp_hdr_len) {
+        memmove(buf + hdr_len, buf + udp_hdr_len, body_len);
+        memmove(buf + 2 + ext_len, buf + sizeof(coap_hdr_t), tkl);
+    }
+    else {
+        memmove(buf + 2 + ext_len, buf + sizeof(coap_hdr_t), tkl);
+        memmove(buf + hdr_len, buf + udp_hdr_len, body_len);
+    }
+    buf[0] = (nibble << 4) | tkl;
+    memcpy(buf + 1, ext, ext_len);
+    buf[1 + ext_len] = code;
+    return _write_all(conn, buf, hdr_len + body_len);
+}
+
+/* reads a message into buf and converts it to the UDP format */
+static ssize_t _recv_msg(_conn_t *conn, uint8_t *buf, size_t buf_len,
+                         uint16_t id)
+{
+    uint8_t hdr[1 + 4 + 1];
+    network_uint32_t val;
+    unsigned tkl, ext_len;
+    size_t body_len, len;
+    int res;
+
+    if ((res = _read_all(conn, hdr, 1)) < 0) {
+        return res;
+    }
+    tkl = hdr[0] & 0xf;
+    switch (hdr[0] >> 4) {
+        case LEN_EXT8:
+            ext_len = 1;
+            break;
+        case LEN_EXT16:
+            ext_len = 2;
+            break;
+        case LEN_EXT32:
+            ext_len = 4;
+            break;
+        default:
+            ext_len = 0;
+            break;
+    }
+    if ((res = _read_all(conn, hdr + 1, ext_len + 1)) < 0) {
+        return res;
+    }
+    switch (ext_len) {
+        case 1:
+            body_len = hdr[1] + LEN_EXT8;
+            break;
+        case 2:
+            body_len = byteorder_bebuftohs(hdr + 1) + LEN_EXT16_OFFSET;
+            break;
+        case 4:
+            memcpy(&val, hdr + 1, sizeof(val));
+            body_len = byteorder_ntohl(val) + LEN_EXT32_OFFSET;
+            break;
+        default:
+            body_len = hdr[0] >> 4;
+            break;
+    }
+    if (tkl > COAP_TOKEN_LENGTH_MAX) {
+        return -EBADMSG;
+    }
+    len = sizeof(coap_hdr_t) + tkl + body_len;
+    if (len > buf_len) {
+        /* skip the message to keep the connection usable */
+        DEBUG("nanocoap_tcp: message of %u bytes too large\n", (unsigned)len);
+        len = tkl + body_len;
+        while (len) {
+            size_t chunk = (len > buf_len) ? buf_len : len;
+
+            if ((res = _read_all(conn, buf, chunk)) < 0) {
+                return res;
+            }
+            len -= chunk;
+        }
+        return -ENOBUFS;
+    }
+    if ((res = _read_all(conn, buf + sizeof(coap_hdr_t), tkl + body_len)) < 0) {
+        return res;
+    }
+    buf[0] = (0x1 << 6) | (COAP_TYPE_ACK << 4) | tkl;
+    buf[1] = hdr[1 + ext_len];
+    byteorder_htobebufs(buf + 2, id);
+    return len;
+}
+
+static int _send_csm(_conn_t *conn)
+{
+    uint8_t csm[2 + 1 + 4 + 1];
+    uint32_t max = CONFIG_NANOCOAP_TCP_MAX_MSG_SIZE;
+    unsigned vlen = (max > 0xffffff) ? 4 : (max > 0xffff) ? 3 : 2;
+    size_t pos = 2;
+
+    csm[pos++] = (COAP_SIGNAL_CSM_OPT_MAX_MESSAGE_SIZE << 4) | vlen;
+    while (vlen--) {
+        csm[pos++] = max >> (8 * vlen);
+    }
+    if (max > NANOCOAP_TCP_DEFAULT_MAX_MSG_SIZE) {
+        /* empty option, delta to Max-Message-Size */
+        csm[pos++] = (COAP_SIGNAL_CSM_OPT_BLOCK_WISE -
+                      COAP_SIGNAL_CSM_OPT_MAX_MESSAGE_SIZE) << 4;
+    }
+    csm[0] = (pos - 2) << 4;
+    csm[1] = COAP_CODE_CSM;
+    return _write_all(conn, csm, pos);
+}
+
+/* returns -ECONNRESET if the connection must be closed */
+static int _handle_signal(_conn_t *conn, coap_pkt_t *pkt, size_t buf_len)
+{
+    uint32_t val;
+    uint8_t *opt;
+
+    switch (coap_get_code_raw(pkt)) {
+        case COAP_CODE_CSM:
+            if (coap_opt_get_uint(pkt, COAP_SIGNAL_CSM_OPT_MAX_MESSAGE_SIZE,
+                                  &val) == 0) {
+                conn->peer_max_msg_size = val;
+            }
+            conn->peer_bert = coap_opt_get_opaque(pkt,
+                                                  COAP_SIGNAL_CSM_OPT_BLOCK_WISE,
+                                                  &opt) >= 0;
+            DEBUG("nanocoap_tcp: peer max message size %lu, BERT %d\n",
+                  (unsigned long)conn->peer_max_msg_size, conn->peer_bert);
+            return 0;
+        case COAP_CODE_PING:
+            /* reply with the token only, dropping the Custody option */
+            pkt->hdr->code = COAP_CODE_PONG;
+            return _send_msg(conn, (uint8_t *)pkt->hdr,
+                             coap_get_total_hdr_len(pkt), buf_len);
+        case COAP_CODE_RELEASE:
+        case COAP_CODE_ABORT:
+            return -ECONNRESET;
+        default:
+            /* Pong or unknown signal */
+            return 0;
+    }
+}
+
+static int _connect(_conn_t *conn, const sock_tcp_ep_t *remote)
+{
+    int res = sock_tcp_connect(&conn->sock, remote, 0, 0);
+
+    if (res < 0) {
+        DEBUG("nanocoap_tcp: connect failed: %d\n", res);
+        return res;
+    }
+    conn->remote = *remote;
+    conn->peer_max_msg_size = NANOCOAP_TCP_DEFAULT_MAX_MSG_SIZE;
+    conn->peer_bert = false;
+    conn->connected = true;
+    if ((res = _send_csm(conn)) < 0) {
+        _close(conn);
+    }
+    return res;
+}
+
+static _conn_t *_find(const sock_tcp_ep_t *remote)
+{
+    for (unsigned i = 0; i < CONFIG_NANOCOAP_TCP_CONN_NUMOF; i++) {
+        if (_conns[i].connected &&
+            sock_tcp_ep_equal(&_conns[i].remote, remote)) {
+            return &_conns[i];
+        }
+    }
+    return NULL;
+}
+
+/* returns the locked connection to remote, opening it if needed */
+static int _acquire(const sock_tcp_ep_t *remote, _conn_t **res)
+{
+    _conn_t *conn;
+
+    while (1) {
+        mutex_lock(&_pool_lock);
+        conn = _find(remote);
+        mutex_unlock(&_pool_lock);
+        if (conn == NULL) {
+            break;
+        }
+        mutex_lock(&conn->lock);
+        /* may have been closed or reused while waiting */
+        if (conn->connected && sock_tcp_ep_equal(&conn->remote, remote)) {
+            conn->last_used = ++_uses;
+            *res = conn;
+            return 0;
+        }
+        mutex_unlock(&conn->lock);
+    }
+
+    /* take a free connection, else evict the least recently used idle one */
+    mutex_lock(&_pool_lock);
+    conn = NULL;
+    for (unsigned i = 0; i < CONFIG_NANOCOAP_TCP_CONN_NUMOF; i++) {
+        _conn_t *c = &_conns[i];
+
+        if (!mutex_trylock(&c->lock)) {
+            continue;
+        }
+        if ((conn == NULL) || !c->connected ||
+            (conn->connected && (c->last_used < conn->last_used))) {
+            if (conn) {
+                mutex_unlock(&conn->lock);
+            }
+            conn = c;
+        }
+        else {
+            mutex_unlock(&c->lock);
+        }
+    }
+    if (conn == NULL) {
+        mutex_unlock(&_pool_lock);
+        return -EAGAIN;
+    }
+    if (conn->connected) {
+        _close(conn);
+    }
+    conn->last_used = ++_uses;
+    mutex_unlock(&_pool_lock);
+
+    int err = _connect(conn, remote);
+    if (err < 0) {
+        mutex_unlock(&conn->lock);
+        return err;
+    }
+    *res = conn;
+    return 0;
+}
+
+ssize_t nanocoap_tcp_request(coap_pkt_t *pkt, const sock_tcp_ep_t *remote,
+                             size_t len)
+{
+    uint8_t *buf = (uint8_t *)pkt->hdr;
+    uint8_t token[COAP_TOKEN_LENGTH_MAX];
+    unsigned tkl = coap_get_token_len(pkt);
+    uint16_t id = coap_get_id(pkt);
+    size_t pdu_len = (pkt->payload - buf) + pkt->payload_len;
+    _conn_t *conn;
+    ssize_t res;
+
+    if ((res = _acquire(remote, &conn)) < 0) {
+        return res;
+    }
+    memcpy(token, pkt->token, tkl);
+    if ((res = _send_msg(conn, buf, pdu_len, len)) < 0) {
+        goto out;
+    }
+
+    while (1) {
+        if ((res = _recv_msg(conn, buf, len, id)) < 0) {
+            break;
+        }
+        if (coap_parse(pkt, buf, res) < 0) {
+            res = -EBADMSG;
+            break;
+        }
+        if (coap_get_code_class(pkt) == COAP_CLASS_SIGNAL) {
+            int err = _handle_signal(conn, pkt, len);
+
+            if (err < 0) {
+                res = err;
+                break;
+            }
+            continue;
+        }
+        if ((coap_get_token_len(pkt) == tkl) &&
+            (memcmp(pkt->token, token, tkl) == 0)) {
+            break;
+        }
+        DEBUG("nanocoap_tcp: skipping message with foreign token\n");
+    }
+
+out:
+    if ((res < 0) && (res != -ENOBUFS)) {
+        _close(conn);
+    }
+    mutex_unlock(&conn->lock);
+    return res;
+}
+
+uint32_t nanocoap_tcp_max_msg_size(const sock_tcp_ep_t *remote)
+{
+    uint32_t res = 0;
+
+    mutex_lock(&_pool_lock);
+    _conn_t *conn = _find(remote);
+    if (conn) {
+        res = conn->peer_max_msg_size;
+    }
+    mutex_unlock(&_pool_lock);
+    return res;
+}
+
+bool nanocoap_tcp_bert(const sock_tcp_ep_t *remote)
+{
+    bool res = false;
+
+    mutex_lock(&_pool_lock);
+    _conn_t *conn = _find(remote);
+    if (conn) {
+        res = conn->peer_bert;
+    }
+    mutex_unlock(&_pool_lock);
+    return res;
+}
+
+void nanocoap_tcp_close(const sock_tcp_ep_t *remote)
+{
+    static const uint8_t release[] = { 0x00, COAP_CODE_RELEASE };
+    _conn_t *conn;
+
+    mutex_lock(&_pool_lock);
+    conn = _find(remote);
+    mutex_unlock(&_pool_lock);
+    if (conn == NULL) {
+        return;
+    }
+    mutex_lock(&conn->lock);
+    if (conn->connected && sock_tcp_ep_equal(&conn->remote, remote)) {
+        _write_all(conn, release, sizeof(release));
+        _close(conn);
+    }
+    mutex_unlock(&conn->lock);
+}
@@ -0,0 +1,379 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_netperf
+ * @{
+ *
+ * @file
+ * @brief       Network benchmark implementation
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <string.h>
+
+#include "mutex.h"
+#include "net/netperf.h"
+#include "thread.h"
+#include "timex.h"
+#include "ztimer.h"
+#ifdef MODULE_SCHEDSTATISTICS
+#include "irq.h"
+#include "sched.h"
+#include "schedstatistics.h"
+#include "xtimer.h"
+#endif
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+typedef struct {
+    uint32_t start;         /* xtimer ticks */
+    uint64_t idle;          /* runtime of the idle thread at start */
+} _cpu_t;
+
+static mutex_t _lock = MUTEX_INIT;
+static uint8_t _buf[CONFIG_NETPERF_BUF_SIZE];
+#ifdef MODULE_SOCK_TCP
+static sock_tcp_t _tcp;
+#endif
+
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+static kernel_pid_t _server_pid = KERNEL_PID_UNDEF;
+static sock_udp_t _server;
+static uint8_t _server_buf[CONFIG_NETPERF_BUF_SIZE];
+static mutex_t _server_lock = MUTEX_INIT;
+static struct {
+    netperf_result_t res;
+    uint32_t next;          /* sequence number expected next */
+    uint32_t first;         /* arrival of sequence number 0 */
+    int32_t transit;        /* transit time of the last datagram */
+    uint32_t jitter;        /* jitter in 1/16 µs */
+    _cpu_t cpu;
+} _stream;
+
+#ifdef MODULE_SCHEDSTATISTICS
+static bool _idle_ticks(uint64_t *ticks)
+{
+    for (kernel_pid_t i = KERNEL_PID_FIRST; i <= KERNEL_PID_LAST; i++) {
+        thread_t *t = (thread_t *)sched_threads[i];
+
+        if ((t != NULL) && (t->priority == THREAD_PRIORITY_IDLE)) {
+            *ticks = sched_pidlist[i].runtime_ticks;
+            return true;
+        }
+    }
+    return false;
+}
+#endif
+
+static void _cpu_start(_cpu_t *cpu)
+{
+#ifdef MODULE_SCHEDSTATISTICS
+    unsigned state = irq_disable();
+
+    cpu->start = xtimer_now().ticks32;
+    _idle_ticks(&cpu->idle);
+    irq_restore(state);
+#else
+    (void)cpu;
+#endif
+}
+
+static uint8_t _cpu_busy(const _cpu_t *cpu)
+{
+#ifdef MODULE_SCHEDSTATISTICS
+    uint64_t idle;
+    unsigned state = irq_disable();
+    uint32_t elapsed = xtimer_now().ticks32 - cpu->start;
+    /* without an idle thread, the time spent idle is not known */
+    bool known = _idle_ticks(&idle);
+
+    irq_restore(state);
+    if (!known || (elapsed == 0)) {
+        return NETPERF_CPU_UNKNOWN;
+    }
+    idle -= cpu->idle;
+    return (idle >= elapsed) ? 0 : 100 - (uint8_t)((idle * 100) / elapsed);
+#else
+    (void)cpu;
+    return NETPERF_CPU_UNKNOWN;
+#endif
+}
+
+static bool _valid(const netperf_params_t *params, size_t min)
+{
+    return (params->len >= min) && (params->len <= sizeof(_buf)) &&
+           (params->count > 0);
+}
+
+static void _set_hdr(uint8_t *buf, uint32_t seq, uint8_t mode)
+{
+    netperf_hdr_t *hdr = (netperf_hdr_t *)buf;
+
+    hdr->seq = byteorder_htonl(seq);
+    hdr->mode = mode;
+    memset(hdr->reserved, 0, sizeof(hdr->reserved));
+    hdr->ts_us = byteorder_htonl(ztimer_now(ZTIMER_USEC));
+}
+
+static void _add_rtt(netperf_result_t *res, uint32_t rtt)
+{
+    uint32_t ms = rtt / US_PER_MS;
+    unsigned i = 0;
+
+    while ((i < CONFIG_NETPERF_RTT_BUCKETS - 1) && (ms >= (1UL << i))) {
+        i++;
+    }
+    res->rtt_hist[i]++;
+    if (rtt < res->rtt_min_us) {
+        res->rtt_min_us = rtt;
+    }
+    if (rtt > res->rtt_max_us) {
+        res->rtt_max_us = rtt;
+    }
+}
+
+int netperf_udp_stream(const sock_udp_ep_t *remote,
+                       const netperf_params_t *params, netperf_result_t *res)
+{
+    sock_udp_t sock;
+    _cpu_t cpu;
+    int err;
+
+    if (!_valid(params, sizeof(netperf_hdr_t))) {
+        return -EINVAL;
+    }
+    memset(res, 0, sizeof(*res));
+    if ((err = sock_udp_create(&sock, NULL, remote, 0)) < 0) {
+        return err;
+    }
+
+    mutex_lock(&_lock);
+    memset(_buf, 0, params->len);
+    _cpu_start(&cpu);
+    uint32_t start = ztimer_now(ZTIMER_USEC);
+    uint32_t last = start;
+
+    for (uint32_t i = 0; i < params->count; i++) {
+        _set_hdr(_buf, i, NETPERF_MODE_STREAM);
+        ssize_t n = sock_udp_send(&sock, _buf, params->len, NULL);
+        if (n < 0) {
+            /* the stack is saturated, that is part of the result */
+            DEBUG("netperf: sending %" PRIu32 " failed: %d\n", i, (int)n);
+            res->lost++;
+        }
+        else {
+            res->packets++;
+            res->bytes += n;
+        }
+        if (params->gap_us) {
+            ztimer_periodic_wakeup(ZTIMER_USEC, &last, params->gap_us);
+        }
+    }
+    res->time_us = ztimer_now(ZTIMER_USEC) - start;
+    res->cpu = _cpu_busy(&cpu);
+    mutex_unlock(&_lock);
+
+    sock_udp_close(&sock);
+    return 0;
+}
+
+int netperf_udp_rr(const sock_udp_ep_t *remote,
+                   const netperf_params_t *params, netperf_result_t *res)
+{
+    netperf_hdr_t *hdr = (netperf_hdr_t *)_buf;
+    uint64_t rtt_sum = 0;
+    sock_udp_t sock;
+    _cpu_t cpu;
+    int err;
+
+    if (!_valid(params, sizeof(netperf_hdr_t))) {
+        return -EINVAL;
+    }
+    memset(res, 0, sizeof(*res));
+    res->rtt_min_us = UINT32_MAX;
+    if ((err = sock_udp_create(&sock, NULL, remote, 0)) < 0) {
+        return err;
+    }
+
+    mutex_lock(&_lock);
+    memset(_buf, 0, params->len);
+    _cpu_start(&cpu);
+    uint32_t start = ztimer_now(ZTIMER_USEC);
+
+    for (uint32_t i = 0; i < params->count; i++) {
+        ssize_t n;
+
+        _set_hdr(_buf, i, NETPERF_MODE_RR);
+        if (sock_udp_send(&sock, _buf, params->len, NULL) < 0) {
+            res->lost++;
+            continue;
+        }
+        /* skip late responses to requests that timed out */
+        do {
+            n = sock_udp_recv(&sock, _buf, sizeof(_buf), params->timeout_us,
+                              NULL);
+        } while ((n >= (ssize_t)sizeof(*hdr)) &&
+                 (byteorder_ntohl(hdr->seq) != i));
+        if (n < (ssize_t)sizeof(*hdr)) {
+            DEBUG("netperf: no response to %" PRIu32 ": %d\n", i, (int)n);
+            res->lost++;
+            continue;
+        }
+
+        uint32_t rtt = ztimer_now(ZTIMER_USEC) - byteorder_ntohl(hdr->ts_us);
+
+        _add_rtt(res, rtt);
+        rtt_sum += rtt;
+        res->packets++;
+        res->bytes += n;
+    }
+    res->time_us = ztimer_now(ZTIMER_USEC) - start;
+    res->cpu = _cpu_busy(&cpu);
+    mutex_unlock(&_lock);
+
+    if (res->packets) {
+        res->rtt_avg_us = rtt_sum / res->packets;
+    }
+    else {
+        res->rtt_min_us = 0;
+    }
+    sock_udp_close(&sock);
+    return 0;
+}
+
+#ifdef MODULE_SOCK_TCP
+int netperf_tcp_stream(const sock_tcp_ep_t *remote,
+                       const netperf_params_t *params, netperf_result_t *res)
+{
+    _cpu_t cpu;
+    int err = 0;
+
+    if (!_valid(params, 1)) {
+        return -EINVAL;
+    }
+    memset(res, 0, sizeof(*res));
+
+    mutex_lock(&_lock);
+    if ((err = sock_tcp_connect(&_tcp, remote, 0, 0)) < 0) {
+        mutex_unlock(&_lock);
+        return err;
+    }
+    memset(_buf, 0, params->len);
+    _cpu_start(&cpu);
+    uint32_t start = ztimer_now(ZTIMER_USEC);
+
+    for (uint32_t i = 0; i < params->count; i++) {
+        ssize_t n = sock_tcp_write(&_tcp, _buf, params->len);
+
+        if (n < 0) {
+            err = n;
+            break;
+        }
+        res->packets++;
+        res->bytes += n;
+    }
+    res->time_us = ztimer_now(ZTIMER_USEC) - start;
+    res->cpu = _cpu_busy(&cpu);
+    sock_tcp_disconnect(&_tcp);
+    mutex_unlock(&_lock);
+
+    return (err < 0) ? err : 0;
+}
+#endif
+
+static void _stream_add(const netperf_hdr_t *hdr, size_t len, uint32_t now)
+{
+    uint32_t seq = byteorder_ntohl(hdr->seq);
+    int32_t transit = now - byteorder_ntohl(hdr->ts_us);
+
+    mutex_lock(&_server_lock);
+    if (seq == 0) {
+        memset(&_stream, 0, sizeof(_stream));
+        _stream.first = now;
+        _cpu_start(&_stream.cpu);
+    }
+    else {
+        /* J += (|D| - J) / 16, RFC 3550, section 6.4.1 */
+        int32_t d = transit - _stream.transit;
+
+        _stream.jitter += ((d < 0) ? -d : d) - (_stream.jitter >> 4);
+    }
+    _stream.transit = transit;
+    if (seq >= _stream.next) {
+        _stream.next = seq + 1;
+    }
+    _stream.res.packets++;
+    _stream.res.bytes += len;
+    _stream.res.time_us = now - _stream.first;
+    _stream.res.cpu = _cpu_busy(&_stream.cpu);
+    mutex_unlock(&_server_lock);
+}
+
+static void *_server_thread(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        sock_udp_ep_t remote;
+        netperf_hdr_t *hdr = (netperf_hdr_t *)_server_buf;
+        ssize_t n = sock_udp_recv(&_server, _server_buf, sizeof(_server_buf),
+                                  SOCK_NO_TIMEOUT, &remote);
+        uint32_t now = ztimer_now(ZTIMER_USEC);
+
+        if (n < (ssize_t)sizeof(*hdr)) {
+            continue;
+        }
+        if (hdr->mode == NETPERF_MODE_RR) {
+            sock_udp_send(&_server, _server_buf, n, &remote);
+        }
+        else {
+            _stream_add(hdr, n, now);
+        }
+    }
+    return NULL;
+}
+
+int netperf_server_start(uint16_t port)
+{
+    sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
+    int err;
+
+    if (_server_pid != KERNEL_PID_UNDEF) {
+        return -EALREADY;
+    }
+    local.port = port;
+    if ((err = sock_udp_create(&_server, &local, NULL, 0)) < 0) {
+        return err;
+    }
+    _server_pid = thread_create(_stack, sizeof(_stack),
+                                THREAD_PRIORITY_MAIN - 1,
+                                THREAD_CREATE_STACKTEST, _server_thread, NULL,
+                                "netperf");
+    return 0;
+}
+
+void netperf_server_result(netperf_result_t *res)
+{
+    mutex_lock(&_server_lock);
+    *res = _stream.res;
+    if (_stream.next > res->packets) {
+        res->lost = _stream.next - res->packets;
+    }
+    res->jitter_us = _stream.jitter >> 4;
+    if (res->packets == 0) {
+        res->cpu = NETPERF_CPU_UNKNOWN;
+    }
+    mutex_unlock(&_server_lock);
+}
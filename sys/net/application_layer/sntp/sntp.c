@@ -18,25 +18,108 @@
  * @}
  */
 
+#include <inttypes.h>
 #include <string.h>
+
 #include "net/sntp.h"
 #include "net/ntp_packet.h"
 #include "net/sock/udp.h"
 #include "xtimer.h"
 #include "mutex.h"
 #include "byteorder.h"
+#ifdef MODULE_WALLTIME
+#include "walltime.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+/**
+ * @brief   Offset change in microseconds considered a time step
+ *
+ * A sample deviating further from the estimated offset discards the drift
+ * history, like the step threshold of NTP.
+ *
+ * @see [RFC 5905, section 11.3](https://tools.ietf.org/html/rfc5905#section-11.3)
+ */
+#define SNTP_STEP_THRESHOLD     (128 * (int64_t)US_PER_MS)
+
+typedef struct {
+    uint64_t time;              /**< system time of the sample */
+    int64_t offset;             /**< measured offset */
+} _sample_t;
+
 static sock_udp_t _sntp_sock;
-static int64_t _sntp_offset = 0;
 static mutex_t _sntp_mutex = MUTEX_INIT;
 static ntp_packet_t _sntp_packet;
 
+/* offset estimate at _sntp_base, changing by _sntp_drift (ppb) over time */
+static int64_t _sntp_offset = 0;
+static uint64_t _sntp_base = 0;
+static int32_t _sntp_drift = 0;
+
+static _sample_t _samples[CONFIG_SNTP_DRIFT_SAMPLES];
+static unsigned _samples_numof = 0;
+static unsigned _samples_next = 0;
+
+static int64_t _ntp_to_usec(const ntp_timestamp_t *ts)
+{
+    return ((int64_t)byteorder_ntohl(ts->seconds) * US_PER_SEC) +
+           (((int64_t)byteorder_ntohl(ts->fraction) * US_PER_SEC) >> 32);
+}
+
+static int64_t _offset_at(uint64_t now)
+{
+    return _sntp_offset + ((int64_t)(now - _sntp_base) * _sntp_drift) / 1000000000LL;
+}
+
+static void _add_sample(uint64_t now, int64_t offset)
+{
+    int64_t diff = offset - _offset_at(now);
+
+    if ((diff > SNTP_STEP_THRESHOLD) || (diff < -SNTP_STEP_THRESHOLD)) {
+        DEBUG("sntp: time step of %" PRId32 " ms\n", (int32_t)(diff / US_PER_MS));
+        _samples_numof = 0;
+        _samples_next = 0;
+    }
+    _samples[_samples_next].time = now;
+    _samples[_samples_next].offset = offset;
+    _samples_next = (_samples_next + 1) % CONFIG_SNTP_DRIFT_SAMPLES;
+    if (_samples_numof < CONFIG_SNTP_DRIFT_SAMPLES) {
+        _samples_numof++;
+    }
+
+    /* least squares fit through the samples, relative to the first one */
+    const _sample_t *ref = &_samples[(_samples_next + CONFIG_SNTP_DRIFT_SAMPLES -
+                                      _samples_numof) % CONFIG_SNTP_DRIFT_SAMPLES];
+    int64_t mean_t = 0, mean_o = 0;
+    for (unsigned i = 0; i < _samples_numof; i++) {
+        mean_t += (int64_t)(_samples[i].time - ref->time);
+        mean_o += _samples[i].offset - ref->offset;
+    }
+    mean_t /= (int64_t)_samples_numof;
+    mean_o /= (int64_t)_samples_numof;
+
+    /* time in milliseconds, offset in microseconds to stay within 64 bit */
+    int64_t num = 0, den = 0;
+    for (unsigned i = 0; i < _samples_numof; i++) {
+        int64_t dt = ((int64_t)(_samples[i].time - ref->time) - mean_t) / (int64_t)US_PER_MS;
+        int64_t dof = (_samples[i].offset - ref->offset) - mean_o;
+        num += dt * dof;
+        den += dt * dt;
+    }
+    den /= 1000;
+
+    _sntp_base = ref->time + mean_t;
+    _sntp_offset = ref->offset + mean_o;
+    _sntp_drift = (den > 0) ? (int32_t)((num * 1000) / den) : 0;
+    DEBUG("sntp: %u samples, drift %" PRId32 " ppb\n", _samples_numof, _sntp_drift);
+}
+
 int sntp_sync(sock_udp_ep_t *server, uint32_t timeout)
 {
     int result;
+    uint64_t t1, t4;
 
     if ((result = sock_udp_create(&_sntp_sock,
                                   NULL,
@@ -49,6 +132,7 @@ int sntp_sync(sock_udp_ep_t *server, uint32_t timeout)
     ntp_packet_set_vn(&_sntp_packet);
     ntp_packet_set_mode(&_sntp_packet, NTP_MODE_CLIENT);
 
+    t1 = xtimer_now_usec64();
     if ((result = (int)sock_udp_send(&_sntp_sock,
                                      &_sntp_packet,
                                      sizeof(_sntp_packet),
@@ -66,12 +150,22 @@ int sntp_sync(sock_udp_ep_t *server, uint32_t timeout)
         sock_udp_close(&_sntp_sock);
         return result;
     }
+    t4 = xtimer_now_usec64();
     sock_udp_close(&_sntp_sock);
+
+    /* the path delay is assumed to be symmetric, server processing time
+     * between receive (T2) and transmit (T3) does not count */
+    int64_t t2 = _ntp_to_usec(&_sntp_packet.receive);
+    int64_t t3 = _ntp_to_usec(&_sntp_packet.transmit);
+    int64_t offset = ((t2 - (int64_t)t1) + (t3 - (int64_t)t4)) / 2;
+
+    DEBUG("sntp: round trip %" PRId32 " us\n", (int32_t)((t4 - t1) - (t3 - t2)));
     mutex_lock(&_sntp_mutex);
-    _sntp_offset = (((int64_t)byteorder_ntohl(_sntp_packet.transmit.seconds)) * US_PER_SEC) +
-                   ((((int64_t)byteorder_ntohl(_sntp_packet.transmit.fraction)) * 232)
-                   / 1000000) - xtimer_now_usec64();
+    _add_sample(t4, offset);
     mutex_unlock(&_sntp_mutex);
+#ifdef MODULE_WALLTIME
+    walltime_sync_us(sntp_get_unix_usec());
+#endif
     return 0;
 }
 
@@ -80,7 +174,7 @@ int64_t sntp_get_offset(void)
     int64_t result;
 
     mutex_lock(&_sntp_mutex);
-    result = _sntp_offset;
+    result = _offset_at(xtimer_now_usec64());
     mutex_unlock(&_sntp_mutex);
     return result;
 }
@@ -14,13 +14,61 @@
 
 #include <inttypes.h>
 #include <stdio.h>
+#include "bitarithm.h"
+#include "byteorder.h"
+#include "kernel_defines.h"
 #include "od.h"
 #include "net/inet_csum.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
-uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t accum_len)
+uint32_t inet_csum_words_generic(uint32_t sum, const uint32_t *buf,
+                                 size_t words)
+{
+    uint64_t acc = sum;
+
+    /* fold the carries only once at the end */
+    while (words--) {
+        acc += *buf++;
+    }
+    acc = (acc & 0xffffffff) + (acc >> 32);
+    acc = (acc & 0xffffffff) + (acc >> 32);
+
+    return acc;
+}
+
+#if !IS_USED(MODULE_INET_CSUM_ARCH)
+uint32_t inet_csum_words(uint32_t sum, const uint32_t *buf, size_t words)
+{
+    return inet_csum_words_generic(sum, buf, words);
+}
+#endif
+
+#if ARCH_32_BIT
+/* sums the 32 bit aligned part of an even-aligned buffer, returns the
+ * number of bytes summed */
+static uint16_t _csum_aligned(uint32_t *csum, const uint8_t *buf, uint16_t len)
+{
+    uint16_t words = len / sizeof(uint32_t);
+    uint32_t wsum;
+
+    if (words == 0) {
+        return 0;
+    }
+    /* the words are summed in host byte order, which only swaps the bytes of
+     * the final sum (see RFC 1071, section 2 (B)) */
+    wsum = inet_csum_words(0, (const uint32_t *)(uintptr_t)buf, words);
+    wsum = (wsum & 0xffff) + (wsum >> 16);
+    wsum = (wsum & 0xffff) + (wsum >> 16);
+    *csum += ntohs(wsum);
+
+    return words * sizeof(uint32_t);
+}
+#endif
+
+uint16_t RAMFUNC_HOT inet_csum_slice(uint16_t sum, const uint8_t *buf,
+                                     uint16_t len, size_t accum_len)
 {
     uint32_t csum = sum;
 
@@ -44,6 +92,19 @@ uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t
         accum_len++;
     }
 
+#if ARCH_32_BIT
+    if (!((uintptr_t)buf & 1)) {
+        if (((uintptr_t)buf & 2) && (len >= 2)) {
+            csum += (uint16_t)(*buf << 8) + *(buf + 1);
+            buf += 2;
+            len -= 2;
+        }
+        uint16_t summed = _csum_aligned(&csum, buf, len);
+        buf += summed;
+        len -= summed;
+    }
+#endif
+
     for (unsigned i = 0; i < (len >> 1); buf += 2, i++) {
         csum += (uint16_t)(*buf << 8) + *(buf + 1); /* group bytes by 16-byte words */
                                                     /* and add them */
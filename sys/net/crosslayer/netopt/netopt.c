@@ -121,6 +121,11 @@ static const char *_netopt_strmap[] = {
     [NETOPT_NUM_GATEWAYS]          = "NETOPT_NUM_GATEWAYS",
     [NETOPT_LINK_CHECK]            = "NETOPT_LINK_CHECK",
     [NETOPT_RSSI]                  = "NETOPT_RSSI",
+    [NETOPT_BLE_PHY]               = "NETOPT_BLE_PHY",
+    [NETOPT_BLE_DATA_LEN]          = "NETOPT_BLE_DATA_LEN",
+    [NETOPT_SRC_MATCH_ADD]         = "NETOPT_SRC_MATCH_ADD",
+    [NETOPT_SRC_MATCH_DEL]         = "NETOPT_SRC_MATCH_DEL",
+    [NETOPT_RX_BUF_SIZE]           = "NETOPT_RX_BUF_SIZE",
     [NETOPT_NUMOF]                 = "NETOPT_NUMOF",
 };
 
@@ -499,6 +499,7 @@ static void gomach_t2k_init(gnrc_netif_t *netif)
     gnrc_priority_pktqueue_flush(&netif->mac.rx.queue);
 
     netif->mac.tx.tx_busy_count = 0;
+    netif->mac.tx.cp_burst_count = 0;
 
     netif->mac.tx.t2k_state = GNRC_GOMACH_T2K_WAIT_CP;
     gnrc_gomach_set_update(netif, false);
@@ -598,9 +599,19 @@ static void _cp_tx_success(gnrc_netif_t *netif)
 
     netif->mac.tx.no_ack_counter = 0;
     netif->mac.tx.t2u_fail_count = 0;
-
-    /* If has pending packets, join the vTDMA period, first wait for receiver's beacon. */
-    if (gnrc_priority_pktqueue_length(&netif->mac.tx.current_neighbor->queue) > 0) {
+    netif->mac.tx.cp_burst_count++;
+
+    /* If has pending packets, send the next one right away, as the receiver
+     * extends its WP, up to the burst limit. */
+    if ((gnrc_priority_pktqueue_length(&netif->mac.tx.current_neighbor->queue) > 0) &&
+        (netif->mac.tx.cp_burst_count < CONFIG_GNRC_GOMACH_CP_BURST_PKT_NUM)) {
+        netif->mac.tx.packet =
+            gnrc_priority_pktqueue_pop(&netif->mac.tx.current_neighbor->queue);
+        netif->mac.tx.tx_busy_count = 0;
+        netif->mac.tx.t2k_state = GNRC_GOMACH_T2K_TRANS_IN_CP;
+    }
+    /* If still has pending packets, join the vTDMA period, first wait for receiver's beacon. */
+    else if (gnrc_priority_pktqueue_length(&netif->mac.tx.current_neighbor->queue) > 0) {
         netif->mac.tx.vtdma_para.slots_num = 0;
         gnrc_gomach_set_timeout(netif, GNRC_GOMACH_TIMEOUT_WAIT_BEACON,
                                 GNRC_GOMACH_WAIT_BEACON_TIME_US);
@@ -617,6 +628,9 @@ static bool _cp_tx_busy(gnrc_netif_t *netif)
 {
     /* If the channel busy counter is below threshold, retry CSMA immediately,
      * by knowing that the CP will be automatically extended. */
+#ifdef MODULE_NETSTATS_L2
+    netif->stats.mac_collisions++;
+#endif
     if (netif->mac.tx.tx_busy_count < CONFIG_GNRC_GOMACH_TX_BUSY_THRESHOLD) {
         netif->mac.tx.tx_busy_count++;
 
@@ -635,6 +649,20 @@ static bool _cp_tx_busy(gnrc_netif_t *netif)
 
 static void _cp_tx_default(gnrc_netif_t *netif)
 {
+    /* The receiver may have left its WP in the middle of a burst, that is no
+     * sign of a lost phase-lock. By marking no_ack_counter as non-zero, the
+     * packet is kept and retried in the next cycle. */
+    if (netif->mac.tx.cp_burst_count > 0) {
+        LOG_DEBUG("[GOMACH] t2k burst ended after %u packets.\n",
+                  netif->mac.tx.cp_burst_count);
+        netdev_ieee802154_t *device_state = (netdev_ieee802154_t *)netif->dev;
+        netif->mac.tx.tx_seq = device_state->seq - 1;
+        netif->mac.tx.no_ack_counter = 1;
+        netif->mac.tx.t2k_state = GNRC_GOMACH_T2K_END;
+        gnrc_gomach_set_update(netif, true);
+        return;
+    }
+
     netif->mac.tx.no_ack_counter++;
 
     LOG_DEBUG("[GOMACH] t2k %d times No-ACK.\n", netif->mac.tx.no_ack_counter);
@@ -1494,6 +1522,7 @@ static void gomach_listen_init(gnrc_netif_t *netif)
     gnrc_gomach_set_beacon_fail(netif, false);
     gnrc_gomach_set_cp_end(netif, false);
     gnrc_gomach_set_got_preamble(netif, false);
+    gnrc_gomach_set_cp_rx(netif, false);
 
     /* Flush RX queue and turn on radio. */
     gnrc_priority_pktqueue_flush(&netif->mac.rx.queue);
@@ -1511,6 +1540,7 @@ static void gomach_listen_init(gnrc_netif_t *netif)
 
 static void _cp_listen_get_pkt(gnrc_netif_t *netif)
 {
+    gnrc_gomach_set_cp_rx(netif, true);
     gnrc_gomach_cp_packet_process(netif);
 
     /* If the device has replied a preamble-ACK, it must waits for the data.
@@ -1581,6 +1611,11 @@ static void gomach_listen_cp_listen(gnrc_netif_t *netif)
 
 static void gomach_listen_cp_end(gnrc_netif_t *netif)
 {
+#ifdef MODULE_NETSTATS_L2
+    if (!gnrc_gomach_get_cp_rx(netif)) {
+        netif->stats.mac_idle_listen++;
+    }
+#endif
     gnrc_priority_pktqueue_flush(&netif->mac.rx.queue);
     gnrc_mac_dispatch(&netif->mac.rx);
 
@@ -85,6 +85,10 @@ int _gnrc_gomach_transmit(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
         src_len = netif->l2addr_len;
         src = netif->l2addr;
     }
+    /* signal further packets of a burst to the receiver */
+    if (netif_hdr->flags & GNRC_NETIF_HDR_FLAGS_MORE_DATA) {
+        flags |= IEEE802154_FCF_FRAME_PEND;
+    }
     /* fill MAC header, seq should be set by device */
     if ((res = ieee802154_set_frame_hdr(mhr, src, src_len,
                                         dst, dst_len, dev_pan,
@@ -406,6 +410,9 @@ static bool _assemble_beacon(gnrc_netif_t *netif, uint8_t total_tdma_slot_num,
     /* If there are slots to allocate, add the slots list and the ID list to
      * the beacon! */
     netif->mac.rx.vtdma_manag.total_slots_num = total_tdma_slot_num;
+#ifdef MODULE_NETSTATS_L2
+    netif->stats.mac_slots_alloc += total_tdma_slot_num;
+#endif
 
     /* Add the slots list to the beacon. */
     *pkt = gnrc_pktbuf_add(NULL, slots_list, total_tdma_node_num * sizeof(uint8_t),
@@ -1140,6 +1147,18 @@ int gnrc_gomach_send_data(gnrc_netif_t *netif, netopt_enable_t csma_enable)
             gnrc_priority_pktqueue_length(&netif->mac.tx.current_neighbor->queue);
     }
 
+    /* In the WP, announce that the next packet follows right away. */
+    gnrc_netif_hdr_t *netif_hdr = netif->mac.tx.packet->data;
+    if ((csma_enable == NETOPT_ENABLE) &&
+        (netif->mac.tx.transmit_state == GNRC_GOMACH_TRANS_TO_KNOWN) &&
+        (gnrc_priority_pktqueue_length(&netif->mac.tx.current_neighbor->queue) > 0) &&
+        ((netif->mac.tx.cp_burst_count + 1U) < CONFIG_GNRC_GOMACH_CP_BURST_PKT_NUM)) {
+        netif_hdr->flags |= GNRC_NETIF_HDR_FLAGS_MORE_DATA;
+    }
+    else {
+        netif_hdr->flags &= ~GNRC_NETIF_HDR_FLAGS_MORE_DATA;
+    }
+
     gnrc_pktbuf_hold(netif->mac.tx.packet, 1);
 
     /* Send the data packet here. */
@@ -1267,6 +1286,9 @@ void gnrc_gomach_beacon_process(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
     if (got_allocated_slots == true) {
         /* Find the slots number and the related slots position. */
         netif->mac.tx.vtdma_para.slots_num = slots_list[id_position];
+#ifdef MODULE_NETSTATS_L2
+        netif->stats.mac_slots_granted += slots_list[id_position];
+#endif
 
         uint8_t slots_position = 0;
         for (i = 0; i < id_position; i++) {
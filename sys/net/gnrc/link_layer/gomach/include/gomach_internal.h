@@ -78,6 +78,11 @@ extern "C" {
  */
 #define GNRC_GOMACH_INTERNAL_INFO_PHASE_BACKOFF          (0x0080U)
 
+/**
+ * @brief Flag to track if a packet has been received in the current WP.
+ */
+#define GNRC_GOMACH_INTERNAL_INFO_CP_RX                  (0x0100U)
+
 /**
  * @brief Flag to track if beacon transmission fail in GoMacH.
  */
@@ -237,6 +242,37 @@ static inline bool gnrc_gomach_get_got_preamble(gnrc_netif_t *netif)
     return (netif->mac.prot.gomach.gomach_info & GNRC_GOMACH_INTERNAL_INFO_GOT_PREAMBLE);
 }
 
+/**
+ * @brief Set the @ref GNRC_GOMACH_INTERNAL_INFO_CP_RX flag of the device.
+ *
+ * @param[in,out] netif    the network interface.
+ * @param[in] cp_rx        value for GoMacH's
+ *                         @ref GNRC_GOMACH_INTERNAL_INFO_CP_RX flag.
+ *
+ */
+static inline void gnrc_gomach_set_cp_rx(gnrc_netif_t *netif, bool cp_rx)
+{
+    if (cp_rx) {
+        netif->mac.prot.gomach.gomach_info |= GNRC_GOMACH_INTERNAL_INFO_CP_RX;
+    }
+    else {
+        netif->mac.prot.gomach.gomach_info &= ~GNRC_GOMACH_INTERNAL_INFO_CP_RX;
+    }
+}
+
+/**
+ * @brief Get the @ref GNRC_GOMACH_INTERNAL_INFO_CP_RX flag of the device.
+ *
+ * @param[in] netif    the network interface.
+ *
+ * @return             true if a packet was received in the current WP.
+ * @return             false if nothing was received in the current WP yet.
+ */
+static inline bool gnrc_gomach_get_cp_rx(gnrc_netif_t *netif)
+{
+    return (netif->mac.prot.gomach.gomach_info & GNRC_GOMACH_INTERNAL_INFO_CP_RX);
+}
+
 /**
  * @brief Set the @ref GNRC_GOMACH_INTERNAL_INFO_CP_END flag of the device.
  *
@@ -55,21 +55,6 @@ static size_t _get_num_used_channels(gnrc_lorawan_t *mac)
     return count;
 }
 
-static uint32_t _get_nth_channel(gnrc_lorawan_t *mac, size_t n)
-{
-    int i = 0;
-    uint32_t channel = 0;
-
-    while (n) {
-        if (mac->channel[i]) {
-            n--;
-            channel = mac->channel[i];
-            i++;
-        }
-    }
-    return channel;
-}
-
 void gnrc_lorawan_channels_init(gnrc_lorawan_t *mac)
 {
     for (unsigned i = 0; i < GNRC_LORAWAN_DEFAULT_CHANNELS_NUMOF; i++) {
@@ -80,18 +65,42 @@ void gnrc_lorawan_channels_init(gnrc_lorawan_t *mac)
          i < GNRC_LORAWAN_MAX_CHANNELS; i++) {
         mac->channel[i] = 0;
     }
+
+    mac->last_chan = GNRC_LORAWAN_MAX_CHANNELS;
 }
 
 uint32_t gnrc_lorawan_pick_channel(gnrc_lorawan_t *mac)
 {
     netdev_t *netdev = gnrc_lorawan_get_netdev(mac);
     uint32_t random_number;
+    size_t numof = _get_num_used_channels(mac);
 
     netdev->driver->get(netdev, NETOPT_RANDOM, &random_number,
                         sizeof(random_number));
 
-    return _get_nth_channel(mac,
-                            1 + (random_number % _get_num_used_channels(mac)));
+    /* Leave out the channel of the last uplink if there is another one, so
+     * that a retransmission after a collision does not hit the same
+     * colliding transmitter again */
+    bool skip_last = (numof > 1) &&
+                     (mac->last_chan < GNRC_LORAWAN_MAX_CHANNELS) &&
+                     mac->channel[mac->last_chan];
+    if (skip_last) {
+        numof--;
+    }
+
+    size_t n = random_number % numof;
+    for (unsigned i = 0; i < GNRC_LORAWAN_MAX_CHANNELS; i++) {
+        if (!mac->channel[i] || (skip_last && i == mac->last_chan)) {
+            continue;
+        }
+        if (n-- == 0) {
+            mac->last_chan = i;
+            return mac->channel[i];
+        }
+    }
+
+    assert(false);
+    return 0;
 }
 
 void gnrc_lorawan_process_cflist(gnrc_lorawan_t *mac, uint8_t *cflist)
@@ -182,6 +182,7 @@ typedef struct {
     uint8_t rx_delay;                               /**< Delay of first reception window */
     uint8_t dr_range[GNRC_LORAWAN_MAX_CHANNELS];    /**< Datarate Range for all channels */
     uint8_t last_dr;                                /**< datarate of the last transmission */
+    uint8_t last_chan;                              /**< channel index of the last transmission */
 } gnrc_lorawan_t;
 
 /**
@@ -248,6 +249,9 @@ gnrc_pktsnip_t *gnrc_lorawan_build_uplink(gnrc_lorawan_t *mac, gnrc_pktsnip_t *p
 /**
  * @brief pick a random available LoRaWAN channel
  *
+ * The channel of the previous transmission is left out if there is another
+ * one available.
+ *
  * @param[in] mac pointer to the MAC descriptor
  *
  * @return a free channel
@@ -374,6 +374,56 @@ static inline uint32_t _gnrc_lwmac_ticks_until_phase(uint32_t phase)
     return (uint32_t)tmp;
 }
 
+/**
+ * @brief Calculate how many ticks remaining to the next wake-up of a node
+ *        with a shortened wake-up interval
+ *
+ * @param[in]   phase       phase of the regular wake-ups of the node
+ * @param[in]   wakeup_exp  the node's wake-up interval is shortened by
+ *                          2^wakeup_exp
+ *
+ * @return               RTT ticks
+ */
+static inline uint32_t _gnrc_lwmac_ticks_until_wakeup(uint32_t phase,
+                                                      uint8_t wakeup_exp)
+{
+    uint32_t interval = RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_INTERVAL_US);
+    uint32_t sub_interval = interval >> wakeup_exp;
+    uint32_t until = _gnrc_lwmac_ticks_until_phase(phase);
+    /* additional wake-ups follow the previous regular one */
+    uint32_t since = interval - until;
+    uint32_t idx = (since + sub_interval - 1) / sub_interval;
+
+    if (idx >= (1U << wakeup_exp)) {
+        return until;
+    }
+    return (idx * sub_interval) - since;
+}
+
+/**
+ * @brief Predict the current phase of a phase-locked neighbor
+ *
+ * The phase measured last is corrected by the estimated clock drift of the
+ * neighbor since the measurement.
+ *
+ * @param[in]   neighbor    neighbor with known phase
+ *
+ * @return               device phase
+ */
+static inline uint32_t _gnrc_lwmac_neighbor_phase(const gnrc_mac_tx_neighbor_t *neighbor)
+{
+    int64_t interval = RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_INTERVAL_US);
+    uint32_t elapsed = (rtt_get_counter() - neighbor->phase_time) & RTT_MAX_VALUE;
+    int64_t phase = neighbor->phase +
+                    ((int64_t)neighbor->drift_ppm * elapsed) / 1000000;
+
+    phase %= interval;
+    if (phase < 0) {
+        phase += interval;
+    }
+    return (uint32_t)phase;
+}
+
 /**
  * @brief Store the received packet to the dispatch buffer and remove possible
  *        duplicate packets.
@@ -167,6 +167,9 @@ static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
                 gnrc_pktbuf_release(pkt);
                 gnrc_pktbuf_release(netif_hdr);
                 DEBUG("_recv_ieee802154: packet dropped by l2filter\n");
+#ifdef MODULE_NETSTATS_L2
+                netif->stats.rx_filtered++;
+#endif
                 return NULL;
             }
 #endif
@@ -196,6 +199,16 @@ static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
     return pkt;
 }
 
+static uint32_t _ticks_until_wakeup(const gnrc_mac_tx_neighbor_t *neighbor)
+{
+    if (neighbor->phase >= RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_INTERVAL_US)) {
+        /* phase unknown */
+        return _gnrc_lwmac_ticks_until_phase(neighbor->phase);
+    }
+    return _gnrc_lwmac_ticks_until_wakeup(_gnrc_lwmac_neighbor_phase(neighbor),
+                                          neighbor->wakeup_exp);
+}
+
 static gnrc_mac_tx_neighbor_t *_next_tx_neighbor(gnrc_netif_t *netif)
 {
     gnrc_mac_tx_neighbor_t *next = NULL;
@@ -206,7 +219,7 @@ static gnrc_mac_tx_neighbor_t *_next_tx_neighbor(gnrc_netif_t *netif)
             /* Unknown destinations are initialized with their phase at the end
              * of the local interval, so known destinations that still wakeup
              * in this interval will be preferred. */
-            uint32_t phase_check = _gnrc_lwmac_ticks_until_phase(netif->mac.tx.neighbors[i].phase);
+            uint32_t phase_check = _ticks_until_wakeup(&netif->mac.tx.neighbors[i]);
 
             if (phase_check <= phase_nearest) {
                 next = &(netif->mac.tx.neighbors[i]);
@@ -238,6 +251,46 @@ static uint32_t _next_inphase_event(uint32_t last, uint32_t interval)
     return last;
 }
 
+/* Next wake-up, which is an additional one in between the regular ones if
+ * the wake-up interval is shortened */
+static uint32_t _next_wakeup(gnrc_netif_t *netif, uint32_t *event)
+{
+    uint32_t interval = RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_INTERVAL_US);
+    uint32_t sub_interval = interval >> netif->mac.prot.lwmac.wakeup_exp;
+    uint32_t next = _next_inphase_event(netif->mac.prot.lwmac.last_wakeup, interval);
+    uint32_t now = rtt_get_counter();
+
+    for (unsigned i = 1; i < (1U << netif->mac.prot.lwmac.wakeup_exp); i++) {
+        uint32_t sub = next - interval + (i * sub_interval);
+        if (sub >= (now + GNRC_LWMAC_RTT_EVENT_MARGIN_TICKS)) {
+            *event = GNRC_LWMAC_EVENT_RTT_SUB_WAKEUP_PENDING;
+            return sub;
+        }
+    }
+    *event = GNRC_LWMAC_EVENT_RTT_WAKEUP_PENDING;
+    return next;
+}
+
+/* Adapt the wake-up interval to the receptions in the last regular one */
+static void _adapt_wakeup_interval(gnrc_netif_t *netif)
+{
+    gnrc_lwmac_t *lwmac = &netif->mac.prot.lwmac;
+
+    /* more receptions than wake-ups, wake up more often */
+    if ((lwmac->rx_count > (1U << lwmac->wakeup_exp)) &&
+        (lwmac->wakeup_exp < GNRC_LWMAC_MAX_WAKEUP_EXP)) {
+        lwmac->wakeup_exp++;
+        LOG_DEBUG("[LWMAC] wake-up interval shortened to %lu us\n",
+                  (unsigned long)(GNRC_LWMAC_WAKEUP_INTERVAL_US >> lwmac->wakeup_exp));
+    }
+    else if ((lwmac->rx_count == 0) && (lwmac->wakeup_exp > 0)) {
+        lwmac->wakeup_exp--;
+        LOG_DEBUG("[LWMAC] wake-up interval extended to %lu us\n",
+                  (unsigned long)(GNRC_LWMAC_WAKEUP_INTERVAL_US >> lwmac->wakeup_exp));
+    }
+    lwmac->rx_count = 0;
+}
+
 inline void lwmac_schedule_update(gnrc_netif_t *netif)
 {
     gnrc_lwmac_set_reschedule(netif, true);
@@ -384,12 +437,12 @@ static void _sleep_management(gnrc_netif_t *netif)
 
             /* Offset in microseconds when the earliest (phase) destination
              * node wakes up that we have packets for. */
-            uint32_t time_until_tx = RTT_TICKS_TO_US(_gnrc_lwmac_ticks_until_phase(neighbour->phase));
+            uint32_t time_until_tx = RTT_TICKS_TO_US(_ticks_until_wakeup(neighbour));
 
             /* If there's not enough time to prepare a WR to catch the phase
-             * postpone to next interval */
+             * postpone to next wake-up */
             if (time_until_tx < GNRC_LWMAC_WR_PREPARATION_US) {
-                time_until_tx += GNRC_LWMAC_WAKEUP_INTERVAL_US;
+                time_until_tx += GNRC_LWMAC_WAKEUP_INTERVAL_US >> neighbour->wakeup_exp;
             }
             time_until_tx -= GNRC_LWMAC_WR_PREPARATION_US;
 
@@ -458,6 +511,9 @@ static void _rx_management_failed(gnrc_netif_t *netif)
 static void _rx_management_success(gnrc_netif_t *netif)
 {
     LOG_DEBUG("[LWMAC] Reception was successful\n");
+    if (netif->mac.prot.lwmac.rx_count < UINT8_MAX) {
+        netif->mac.prot.lwmac.rx_count++;
+    }
     gnrc_lwmac_rx_stop(netif);
     /* Dispatch received packets, timing is not critical anymore */
     gnrc_mac_dispatch(&netif->mac.rx);
@@ -689,10 +745,14 @@ void rtt_handler(uint32_t event, gnrc_netif_t *netif)
     uint32_t alarm;
 
     switch (event & 0xffff) {
-        case GNRC_LWMAC_EVENT_RTT_WAKEUP_PENDING: {
+        case GNRC_LWMAC_EVENT_RTT_WAKEUP_PENDING:
+        case GNRC_LWMAC_EVENT_RTT_SUB_WAKEUP_PENDING: {
             /* A new cycle starts, set sleep timing and initialize related MAC-info flags. */
-            netif->mac.prot.lwmac.last_wakeup = rtt_get_alarm();
-            alarm = _next_inphase_event(netif->mac.prot.lwmac.last_wakeup,
+            if ((event & 0xffff) == GNRC_LWMAC_EVENT_RTT_WAKEUP_PENDING) {
+                netif->mac.prot.lwmac.last_wakeup = rtt_get_alarm();
+                _adapt_wakeup_interval(netif);
+            }
+            alarm = _next_inphase_event(rtt_get_alarm(),
                                         RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_DURATION_US));
             rtt_set_alarm(alarm, rtt_cb, (void *) GNRC_LWMAC_EVENT_RTT_SLEEP_PENDING);
             gnrc_lwmac_set_quit_tx(netif, false);
@@ -704,9 +764,9 @@ void rtt_handler(uint32_t event, gnrc_netif_t *netif)
         }
         case GNRC_LWMAC_EVENT_RTT_SLEEP_PENDING: {
             /* Set next wake-up timing. */
-            alarm = _next_inphase_event(netif->mac.prot.lwmac.last_wakeup,
-                                        RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_INTERVAL_US));
-            rtt_set_alarm(alarm, rtt_cb, (void *) GNRC_LWMAC_EVENT_RTT_WAKEUP_PENDING);
+            uint32_t wakeup_event;
+            alarm = _next_wakeup(netif, &wakeup_event);
+            rtt_set_alarm(alarm, rtt_cb, (void *)(uintptr_t)wakeup_event);
             lwmac_set_state(netif, GNRC_LWMAC_SLEEPING);
             break;
         }
@@ -728,10 +788,10 @@ void rtt_handler(uint32_t event, gnrc_netif_t *netif)
         }
         case GNRC_LWMAC_EVENT_RTT_RESUME: {
             LOG_DEBUG("[LWMAC] RTT: Resume duty cycling\n");
+            uint32_t wakeup_event;
             rtt_clear_alarm();
-            alarm = _next_inphase_event(netif->mac.prot.lwmac.last_wakeup,
-                                        RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_INTERVAL_US));
-            rtt_set_alarm(alarm, rtt_cb, (void *) GNRC_LWMAC_EVENT_RTT_WAKEUP_PENDING);
+            alarm = _next_wakeup(netif, &wakeup_event);
+            rtt_set_alarm(alarm, rtt_cb, (void *)(uintptr_t)wakeup_event);
             gnrc_lwmac_set_dutycycle_active(netif, true);
             break;
         }
@@ -20,6 +20,7 @@
  */
 
 #include <stdbool.h>
+#include <stddef.h>
 
 #include "periph/rtt.h"
 #include "net/gnrc.h"
@@ -135,8 +136,11 @@ int _gnrc_lwmac_parse_packet(gnrc_pktsnip_t *pkt, gnrc_lwmac_packet_info_t *info
             break;
         }
         case GNRC_LWMAC_FRAMETYPE_WA: {
-            lwmac_snip = gnrc_pktbuf_mark(pkt, sizeof(gnrc_lwmac_frame_wa_t),
-                                          GNRC_NETTYPE_LWMAC);
+            /* nodes without adaptive wake-up interval send no wakeup_exp */
+            size_t wa_len = (pkt->size < sizeof(gnrc_lwmac_frame_wa_t))
+                          ? offsetof(gnrc_lwmac_frame_wa_t, wakeup_exp)
+                          : sizeof(gnrc_lwmac_frame_wa_t);
+            lwmac_snip = gnrc_pktbuf_mark(pkt, wa_len, GNRC_NETTYPE_LWMAC);
             break;
         }
         case GNRC_LWMAC_FRAMETYPE_DATA_PENDING:
@@ -155,6 +159,11 @@ int _gnrc_lwmac_parse_packet(gnrc_pktsnip_t *pkt, gnrc_lwmac_packet_info_t *info
         }
     }
 
+    if (lwmac_snip == NULL) {
+        /* frame too short for its type or packet buffer full */
+        return -3;
+    }
+
     /* Memory location may have changed while marking */
     lwmac_hdr = lwmac_snip->data;
 
@@ -146,6 +146,8 @@ static bool _send_wa(gnrc_netif_t *netif)
         lwmac_hdr.current_phase = (phase_now + RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_INTERVAL_US)) -
                                   _gnrc_lwmac_ticks_to_phase(netif->mac.prot.lwmac.last_wakeup);
     }
+    /* Let the sender know about additional wake-ups in between */
+    lwmac_hdr.wakeup_exp = netif->mac.prot.lwmac.wakeup_exp;
 
     pkt = gnrc_pktbuf_add(NULL, &lwmac_hdr, sizeof(lwmac_hdr), GNRC_NETTYPE_LWMAC);
     if (pkt == NULL) {
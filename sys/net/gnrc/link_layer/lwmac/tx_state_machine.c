@@ -19,6 +19,8 @@
  * @}
  */
 
+#include <stdlib.h>
+
 #include "periph/rtt.h"
 #include "net/gnrc.h"
 #include "net/gnrc/lwmac/lwmac.h"
@@ -226,6 +228,51 @@ static uint8_t _send_wr(gnrc_netif_t *netif)
     return tx_info;
 }
 
+/* Store a measured phase and estimate the neighbor's clock drift from the
+ * deviation to the phase predicted with the previous measurement */
+static void _update_neighbor_phase(gnrc_mac_tx_neighbor_t *neighbor, uint32_t phase)
+{
+    int32_t interval = RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_INTERVAL_US);
+    uint32_t now = rtt_get_counter();
+    uint32_t elapsed = (now - neighbor->phase_time) & RTT_MAX_VALUE;
+    int32_t error = 0;
+
+    if (neighbor->phase < (uint32_t)interval) {
+        error = (int32_t)phase - (int32_t)_gnrc_lwmac_neighbor_phase(neighbor);
+        if (error > interval / 2) {
+            error -= interval;
+        }
+        else if (error <= -interval / 2) {
+            error += interval;
+        }
+    }
+
+    if ((neighbor->phase >= (uint32_t)interval) ||
+        (abs(error) > (int32_t)RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_DURATION_US))) {
+        /* phase was unknown or the neighbor's schedule changed, start over */
+        neighbor->drift_ppm = 0;
+    }
+    else if (elapsed >= RTT_US_TO_TICKS(GNRC_LWMAC_DRIFT_MIN_PERIOD_US)) {
+        /* smooth the estimate, a single WA is only accurate to some ticks */
+        int32_t drift = neighbor->drift_ppm +
+                        (int32_t)(((int64_t)error * 1000000) / elapsed) / 2;
+        if (drift > GNRC_LWMAC_MAX_DRIFT_PPM) {
+            drift = GNRC_LWMAC_MAX_DRIFT_PPM;
+        }
+        else if (drift < -GNRC_LWMAC_MAX_DRIFT_PPM) {
+            drift = -GNRC_LWMAC_MAX_DRIFT_PPM;
+        }
+        neighbor->drift_ppm = drift;
+    }
+    else {
+        /* too short to observe drift, the prediction is still accurate */
+        return;
+    }
+
+    neighbor->phase = phase;
+    neighbor->phase_time = now;
+}
+
 static uint8_t _packet_process_in_wait_for_wa(gnrc_netif_t *netif)
 {
     assert(netif != NULL);
@@ -233,6 +280,7 @@ static uint8_t _packet_process_in_wait_for_wa(gnrc_netif_t *netif)
     uint8_t tx_info = 0;
     gnrc_pktsnip_t *pkt;
     bool found_wa = false;
+    uint8_t wakeup_exp = 0;
     bool postponed = false;
     bool from_expected_destination = false;
 
@@ -301,8 +349,12 @@ static uint8_t _packet_process_in_wait_for_wa(gnrc_netif_t *netif)
         if (from_expected_destination) {
             /* calculate the phase of the receiver based on WA */
             netif->mac.tx.timestamp = _gnrc_lwmac_phase_now();
-            gnrc_lwmac_frame_wa_t *wa_hdr;
-            wa_hdr = (gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_LWMAC))->data;
+            gnrc_pktsnip_t *wa_snip = gnrc_pktsnip_search_type(pkt,
+                                                               GNRC_NETTYPE_LWMAC);
+            gnrc_lwmac_frame_wa_t *wa_hdr = wa_snip->data;
+            /* keep the regular interval of nodes that do not tell */
+            wakeup_exp = (wa_snip->size >= sizeof(gnrc_lwmac_frame_wa_t))
+                       ? wa_hdr->wakeup_exp : 0;
 
             if (netif->mac.tx.timestamp >= wa_hdr->current_phase) {
                 netif->mac.tx.timestamp = netif->mac.tx.timestamp -
@@ -358,8 +410,11 @@ static uint8_t _packet_process_in_wait_for_wa(gnrc_netif_t *netif)
     }
 
     /* Save newly calculated phase for destination */
-    netif->mac.tx.current_neighbor->phase = netif->mac.tx.timestamp;
-    LOG_INFO("[LWMAC-tx] New phase: %" PRIu32 "\n", netif->mac.tx.timestamp);
+    _update_neighbor_phase(netif->mac.tx.current_neighbor, netif->mac.tx.timestamp);
+    netif->mac.tx.current_neighbor->wakeup_exp = (wakeup_exp > GNRC_LWMAC_MAX_WAKEUP_EXP)
+                                                 ? GNRC_LWMAC_MAX_WAKEUP_EXP : wakeup_exp;
+    LOG_INFO("[LWMAC-tx] New phase: %" PRIu32 ", drift: %d ppm\n", netif->mac.tx.timestamp,
+             (int)netif->mac.tx.current_neighbor->drift_ppm);
 
     /* We've got our WA, so discard the rest, TODO: no flushing */
     gnrc_priority_pktqueue_flush(&netif->mac.rx.queue);
@@ -116,6 +116,10 @@ void _gnrc_mac_init_neighbor(gnrc_mac_tx_neighbor_t *neighbor, const uint8_t *ad
 
     neighbor->l2_addr_len = len;
     neighbor->phase = GNRC_MAC_PHASE_MAX;
+#ifdef MODULE_GNRC_LWMAC
+    neighbor->drift_ppm = 0;
+    neighbor->wakeup_exp = 0;
+#endif
     memcpy(&(neighbor->l2_addr), addr, len);
 }
 #endif /* CONFIG_GNRC_MAC_NEIGHBOR_COUNT != 0 */
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_tsch
+ * @{
+ *
+ * @file
+ * @brief       Internal functions of the TSCH MAC protocol
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+
+#ifndef TSCH_INTERNAL_H
+#define TSCH_INTERNAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "net/gnrc/netif.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Build an Enhanced Beacon announcing the current ASN and the
+ *          links to any neighbor
+ *
+ * @param[in]   netif   the TSCH interface
+ * @param[out]  buf     buffer of at least @ref IEEE802154_FRAME_LEN_MAX bytes
+ *
+ * @return  length of the beacon in @p buf, without FCS
+ */
+size_t gnrc_tsch_eb_build(gnrc_netif_t *netif, uint8_t *buf);
+
+/**
+ * @brief   Get the ASN and join metric from a received Enhanced Beacon
+ *
+ * @param[in]   buf         the frame, without FCS
+ * @param[in]   len         length of @p buf
+ * @param[out]  asn         absolute slot number of the beacon
+ * @param[out]  join_metric join metric of the sender
+ *
+ * @return  0 on success
+ * @return  -EINVAL if the frame is malformed or not an IEEE 802.15.4-2015
+ *          frame with information elements
+ * @return  -ENOENT if the frame carries no TSCH synchronization IE
+ */
+int gnrc_tsch_eb_parse(const uint8_t *buf, size_t len, uint64_t *asn,
+                       uint8_t *join_metric);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TSCH_INTERNAL_H */
+/** @} */
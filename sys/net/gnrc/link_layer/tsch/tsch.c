@@ -0,0 +1,888 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_tsch
+ * @{
+ *
+ * @file
+ * @brief       Implementation of the TSCH MAC protocol
+ *
+ * Two ztimers drive the state machine: the slot timer fires at every
+ * timeslot boundary, the action timer at the TX or RX offset within the
+ * slot. Both only post a message to the interface thread, all radio access
+ * happens there.
+ *
+ * @author      ML!PA Consulting GmbH
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "random.h"
+#include "timex.h"
+#include "net/gnrc.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/netif/internal.h"
+#include "net/gnrc/mac/internal.h"
+#include "net/gnrc/tsch/tsch.h"
+#include "net/ieee802154.h"
+#include "net/netdev/ieee802154.h"
+#include "ztimer.h"
+
+#include "include/tsch_internal.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#ifndef LOG_LEVEL
+/**
+ * @brief Default log level define
+ */
+#define LOG_LEVEL LOG_WARNING
+#endif
+
+#include "log.h"
+
+#define TSCH(netif)             (&(netif)->mac.prot.tsch)
+#define BCAST_NEIGHBOR          (0)
+
+static const uint8_t _hopping_sequence[] = CONFIG_GNRC_TSCH_HOPPING_SEQUENCE;
+
+static void _tsch_init(gnrc_netif_t *netif);
+static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt);
+static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif);
+static void _tsch_msg_handler(gnrc_netif_t *netif, msg_t *msg);
+
+static const gnrc_netif_ops_t tsch_ops = {
+    .init = _tsch_init,
+    .send = _send,
+    .recv = _recv,
+    .get = gnrc_netif_get_from_netdev,
+    .set = gnrc_netif_set_from_netdev,
+    .msg_handler = _tsch_msg_handler,
+};
+
+int gnrc_netif_tsch_create(gnrc_netif_t *netif, char *stack, int stacksize,
+                           char priority, char *name, netdev_t *dev)
+{
+    return gnrc_netif_create(netif, stack, stacksize, priority, name, dev,
+                             &tsch_ops);
+}
+
+static void _post(gnrc_netif_t *netif, uint16_t type)
+{
+    msg_t msg = { .type = type, .content = { .ptr = netif } };
+
+    if (msg_send(&msg, netif->pid) <= 0) {
+        LOG_WARNING("WARNING: [TSCH] possibly lost timer event\n");
+    }
+}
+
+static void _slot_cb(void *arg)
+{
+    _post(arg, GNRC_TSCH_EVENT_SLOT_TYPE);
+}
+
+static void _action_cb(void *arg)
+{
+    _post(arg, GNRC_TSCH_EVENT_ACTION_TYPE);
+}
+
+static void _set_timer_at(ztimer_t *timer, uint32_t target)
+{
+    uint32_t offset = target - ztimer_now(ZTIMER_USEC);
+
+    /* the target passed already if the offset "wrapped" */
+    if ((int32_t)offset < 0) {
+        offset = 0;
+    }
+    ztimer_set(ZTIMER_USEC, timer, offset);
+}
+
+static void _set_radio_state(gnrc_netif_t *netif, netopt_state_t state)
+{
+    netif->dev->driver->set(netif->dev, NETOPT_STATE, &state, sizeof(state));
+}
+
+static void _set_channel(gnrc_netif_t *netif, uint16_t channel)
+{
+    netif->dev->driver->set(netif->dev, NETOPT_CHANNEL, &channel,
+                            sizeof(channel));
+}
+
+static void _sleep(gnrc_netif_t *netif)
+{
+    TSCH(netif)->action = GNRC_TSCH_ACTION_NONE;
+    ztimer_remove(ZTIMER_USEC, &TSCH(netif)->action_timer);
+    _set_radio_state(netif, NETOPT_STATE_SLEEP);
+}
+
+static bool _is_time_source(gnrc_tsch_t *tsch, const uint8_t *addr,
+                            int addr_len)
+{
+    return (addr_len == IEEE802154_LONG_ADDRESS_LEN) &&
+           (memcmp(tsch->time_source, addr, addr_len) == 0);
+}
+
+/*
+ * Schedule
+ */
+
+static int _link_find(gnrc_tsch_t *tsch, uint16_t timeslot)
+{
+    for (unsigned i = 0; i < tsch->links_numof; i++) {
+        if (tsch->links[i].timeslot == timeslot) {
+            return i;
+        }
+    }
+    return -ENOENT;
+}
+
+static void _schedule_minimal(gnrc_tsch_t *tsch)
+{
+    memset(tsch->links, 0, sizeof(tsch->links));
+    tsch->links[0].options = GNRC_TSCH_LINK_TX | GNRC_TSCH_LINK_RX |
+                             GNRC_TSCH_LINK_SHARED |
+                             GNRC_TSCH_LINK_TIMEKEEPING;
+    tsch->links_numof = 1;
+}
+
+int gnrc_tsch_link_add(gnrc_netif_t *netif, uint16_t timeslot,
+                       uint8_t channel_offset, uint8_t options,
+                       const uint8_t *addr)
+{
+    gnrc_tsch_t *tsch = TSCH(netif);
+    int res = 0;
+
+    if (timeslot >= CONFIG_GNRC_TSCH_SLOTFRAME_LENGTH) {
+        return -EINVAL;
+    }
+
+    gnrc_netif_acquire(netif);
+    if (_link_find(tsch, timeslot) >= 0) {
+        res = -EEXIST;
+    }
+    else if (tsch->links_numof >= CONFIG_GNRC_TSCH_LINK_NUMOF) {
+        res = -ENOMEM;
+    }
+    else {
+        gnrc_tsch_link_t *link = &tsch->links[tsch->links_numof++];
+
+        link->timeslot = timeslot;
+        link->channel_offset = channel_offset;
+        link->options = options;
+        link->addr_len = addr ? IEEE802154_LONG_ADDRESS_LEN : 0;
+        if (addr) {
+            memcpy(link->addr, addr, IEEE802154_LONG_ADDRESS_LEN);
+        }
+    }
+    gnrc_netif_release(netif);
+
+    return res;
+}
+
+int gnrc_tsch_link_remove(gnrc_netif_t *netif, uint16_t timeslot)
+{
+    gnrc_tsch_t *tsch = TSCH(netif);
+
+    gnrc_netif_acquire(netif);
+    int idx = _link_find(tsch, timeslot);
+    if (idx >= 0) {
+        tsch->links[idx] = tsch->links[--tsch->links_numof];
+    }
+    gnrc_netif_release(netif);
+
+    return (idx < 0) ? idx : 0;
+}
+
+void gnrc_tsch_schedule_minimal(gnrc_netif_t *netif)
+{
+    gnrc_netif_acquire(netif);
+    _schedule_minimal(TSCH(netif));
+    gnrc_netif_release(netif);
+}
+
+void gnrc_tsch_start_coordinator(gnrc_netif_t *netif)
+{
+    _post(netif, GNRC_TSCH_EVENT_COORDINATOR_TYPE);
+}
+
+/*
+ * Synchronization
+ */
+
+static void _scan(gnrc_netif_t *netif)
+{
+    gnrc_tsch_t *tsch = TSCH(netif);
+
+    tsch->action = GNRC_TSCH_ACTION_SCAN;
+    _set_channel(netif, _hopping_sequence[tsch->scan_channel]);
+    _set_radio_state(netif, NETOPT_STATE_IDLE);
+    /* every channel of the sequence carries beacons eventually, change the
+     * channel after a beacon period in case this one is disturbed */
+    ztimer_set(ZTIMER_USEC, &tsch->action_timer,
+               CONFIG_GNRC_TSCH_EB_PERIOD_MS * US_PER_MS);
+    tsch->scan_channel = (tsch->scan_channel + 1) %
+                         ARRAY_SIZE(_hopping_sequence);
+}
+
+static void _desync(gnrc_netif_t *netif)
+{
+    gnrc_tsch_t *tsch = TSCH(netif);
+
+    LOG_INFO("[TSCH] lost synchronization\n");
+    tsch->flags &= ~GNRC_TSCH_FLAG_SYNCED;
+    ztimer_remove(ZTIMER_USEC, &tsch->slot_timer);
+    _scan(netif);
+}
+
+static void _begin_slot(gnrc_netif_t *netif);
+
+static void _start_coordinator(gnrc_netif_t *netif)
+{
+    gnrc_tsch_t *tsch = TSCH(netif);
+
+    ztimer_remove(ZTIMER_USEC, &tsch->action_timer);
+    tsch->flags |= GNRC_TSCH_FLAG_COORDINATOR | GNRC_TSCH_FLAG_SYNCED;
+    tsch->join_metric = 0;
+    tsch->asn = 0;
+    /* send the first beacon right away */
+    tsch->last_eb = ztimer_now(ZTIMER_MSEC) - CONFIG_GNRC_TSCH_EB_PERIOD_MS;
+    tsch->slot_start = ztimer_now(ZTIMER_USEC);
+    _set_timer_at(&tsch->slot_timer,
+                  tsch->slot_start + CONFIG_GNRC_TSCH_TIMESLOT_US);
+    _begin_slot(netif);
+}
+
+static void _join(gnrc_netif_t *netif, const uint8_t *src, uint64_t asn,
+                  uint8_t join_metric)
+{
+    gnrc_tsch_t *tsch = TSCH(netif);
+
+    /* the beacon was sent at the TX offset of slot asn */
+    tsch->asn = asn;
+    tsch->slot_start = tsch->rx_start - CONFIG_GNRC_TSCH_TX_OFFSET_US -
+                       CONFIG_GNRC_TSCH_RX_LATENCY_US;
+    tsch->join_metric = join_metric + 1;
+    tsch->flags |= GNRC_TSCH_FLAG_SYNCED;
+    tsch->last_sync = ztimer_now(ZTIMER_MSEC);
+    tsch->last_eb = tsch->last_sync;
+    memcpy(tsch->time_source, src, IEEE802154_LONG_ADDRESS_LEN);
+    _sleep(netif);
+    _set_timer_at(&tsch->slot_timer,
+                  tsch->slot_start + CONFIG_GNRC_TSCH_TIMESLOT_US);
+
+    LOG_INFO("[TSCH] joined at ASN %lu, join metric %u\n",
+             (unsigned long)asn, tsch->join_metric);
+}
+
+static void _resync(gnrc_netif_t *netif)
+{
+    gnrc_tsch_t *tsch = TSCH(netif);
+    uint32_t expected = tsch->slot_start + CONFIG_GNRC_TSCH_TX_OFFSET_US +
+                        CONFIG_GNRC_TSCH_RX_LATENCY_US;
+    int32_t drift = (int32_t)(tsch->rx_start - expected);
+
+    if ((drift > (int32_t)CONFIG_GNRC_TSCH_GUARD_US) ||
+        (drift < -(int32_t)CONFIG_GNRC_TSCH_GUARD_US)) {
+        DEBUG("[TSCH] ignoring drift of %" PRId32 " us\n", drift);
+        return;
+    }
+    tsch->slot_start += drift;
+    tsch->last_sync = ztimer_now(ZTIMER_MSEC);
+    _set_timer_at(&tsch->slot_timer,
+                  tsch->slot_start + CONFIG_GNRC_TSCH_TIMESLOT_US);
+    DEBUG("[TSCH] corrected drift of %" PRId32 " us\n", drift);
+}
+
+/*
+ * Transmission
+ */
+
+static gnrc_mac_tx_neighbor_t *_neighbor_find(gnrc_netif_t *netif,
+                                              const uint8_t *addr)
+{
+    for (unsigned i = 1; i <= CONFIG_GNRC_MAC_NEIGHBOR_COUNT; i++) {
+        gnrc_mac_tx_neighbor_t *neighbor = &netif->mac.tx.neighbors[i];
+        if ((neighbor->l2_addr_len == IEEE802154_LONG_ADDRESS_LEN) &&
+            (memcmp(neighbor->l2_addr, addr, IEEE802154_LONG_ADDRESS_LEN) == 0)) {
+            return neighbor;
+        }
+    }
+    return NULL;
+}
+
+static bool _link_serves(const gnrc_tsch_link_t *link,
+                         const gnrc_mac_tx_neighbor_t *neighbor)
+{
+    if (link->addr_len == 0) {
+        return true;
+    }
+    return (neighbor->l2_addr_len == link->addr_len) &&
+           (memcmp(neighbor->l2_addr, link->addr, link->addr_len) == 0);
+}
+
+static bool _dequeue(gnrc_netif_t *netif, gnrc_mac_tx_neighbor_t *neighbor)
+{
+    if ((neighbor == NULL) ||
+        (gnrc_priority_pktqueue_length(&neighbor->queue) == 0)) {
+        return false;
+    }
+    netif->mac.tx.packet = gnrc_priority_pktqueue_pop(&neighbor->queue);
+    netif->mac.tx.current_neighbor = neighbor;
+    TSCH(netif)->retries = 0;
+    return true;
+}
+
+/* decide what to send in a TX link, false if there is nothing */
+static bool _select_tx(gnrc_netif_t *netif)
+{
+    gnrc_tsch_t *tsch = TSCH(netif);
+    const gnrc_tsch_link_t *link = &tsch->link;
+    gnrc_mac_tx_t *tx = &netif->mac.tx;
+
+    /* a frame waiting for its retransmission goes first */
+    if (tx->packet) {
+        if (!_link_serves(link, tx->current_neighbor)) {
+            return false;
+        }
+        if ((link->options & GNRC_TSCH_LINK_SHARED) && tsch->backoff) {
+            tsch->backoff--;
+            return false;
+        }
+        return true;
+    }
+
+    if (link->addr_len) {
+        return _dequeue(netif, _neighbor_find(netif, link->addr));
+    }
+
+    if (ztimer_now(ZTIMER_MSEC) - tsch->last_eb >=
+        CONFIG_GNRC_TSCH_EB_PERIOD_MS) {
+        tsch->flags |= GNRC_TSCH_FLAG_TX_EB;
+        return true;
+    }
+    if (_dequeue(netif, &tx->neighbors[BCAST_NEIGHBOR])) {
+        return true;
+    }
+    /* serve the neighbor queues in turn */
+    for (unsigned i = 0; i < CONFIG_GNRC_MAC_NEIGHBOR_COUNT; i++) {
+        unsigned idx = 1 + (tsch->next_neighbor + i) %
+                       CONFIG_GNRC_MAC_NEIGHBOR_COUNT;
+        if (_dequeue(netif, &tx->neighbors[idx])) {
+            tsch->next_neighbor = idx % CONFIG_GNRC_MAC_NEIGHBOR_COUNT;
+            return true;
+        }
+    }
+    return false;
+}
+
+static int _transmit_pkt(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
+{
+    netdev_t *dev = netif->dev;
+    netdev_ieee802154_t *state = (netdev_ieee802154_t *)netif->dev;
+    gnrc_netif_hdr_t *netif_hdr = pkt->data;
+    const uint8_t *dst;
+    size_t dst_len;
+    uint8_t mhr[IEEE802154_MAX_HDR_LEN];
+    uint8_t flags = (uint8_t)(state->flags & NETDEV_IEEE802154_SEND_MASK);
+    le_uint16_t dev_pan = byteorder_btols(byteorder_htons(state->pan));
+    int res;
+
+    flags |= IEEE802154_FCF_TYPE_DATA | IEEE802154_FCF_ACK_REQ;
+    if (netif_hdr->flags &
+        (GNRC_NETIF_HDR_FLAGS_BROADCAST | GNRC_NETIF_HDR_FLAGS_MULTICAST)) {
+        dst = ieee802154_addr_bcast;
+        dst_len = IEEE802154_ADDR_BCAST_LEN;
+    }
+    else {
+        dst = gnrc_netif_hdr_get_dst_addr(netif_hdr);
+        dst_len = netif_hdr->dst_l2addr_len;
+    }
+    if ((res = ieee802154_set_frame_hdr(mhr, netif->l2addr, netif->l2addr_len,
+                                        dst, dst_len, dev_pan, dev_pan,
+                                        flags, state->seq++)) == 0) {
+        DEBUG("[TSCH] error preparing frame\n");
+        return -EINVAL;
+    }
+
+    iolist_t iolist = {
+        .iol_next = (iolist_t *)pkt->next,
+        .iol_base = mhr,
+        .iol_len = (size_t)res
+    };
+    return dev->driver->send(dev, &iolist);
+}
+
+static void _tx_done(gnrc_netif_t *netif, gnrc_mac_tx_feedback_t feedback)
+{
+    gnrc_tsch_t *tsch = TSCH(netif);
+    gnrc_mac_tx_t *tx = &netif->mac.tx;
+    bool shared = tsch->link.options & GNRC_TSCH_LINK_SHARED;
+
+    _sleep(netif);
+
+    if (tsch->flags & GNRC_TSCH_FLAG_TX_EB) {
+        tsch->flags &= ~GNRC_TSCH_FLAG_TX_EB;
+        tsch->last_eb = ztimer_now(ZTIMER_MSEC);
+        return;
+    }
+    if (tx->packet == NULL) {
+        return;
+    }
+
+    /* broadcast frames are not acknowledged */
+    if ((feedback == TX_FEEDBACK_SUCCESS) ||
+        (tx->current_neighbor == &tx->neighbors[BCAST_NEIGHBOR])) {
+#ifdef MODULE_NETSTATS_L2
+        netif->stats.tx_success++;
+#endif
+        gnrc_pktbuf_release(tx->packet);
+        tx->packet = NULL;
+        tx->current_neighbor = NULL;
+        if (shared) {
+            tsch->backoff_exp = CONFIG_GNRC_TSCH_MIN_BE;
+            tsch->backoff = 0;
+        }
+        return;
+    }
+
+    if (++tsch->retries > CONFIG_GNRC_TSCH_MAX_RETRIES) {
+        LOG_DEBUG("[TSCH] dropping frame after %u retransmissions\n",
+                  CONFIG_GNRC_TSCH_MAX_RETRIES);
+#ifdef MODULE_NETSTATS_L2
+        netif->stats.tx_failed++;
+#endif
+        gnrc_pktbuf_release_error(tx->packet, ETIMEDOUT);
+        tx->packet = NULL;
+        tx->current_neighbor = NULL;
+        tsch->backoff_exp = CONFIG_GNRC_TSCH_MIN_BE;
+        tsch->backoff = 0;
+        return;
+    }
+    if (shared) {
+        tsch->backoff = random_uint32_range(0, 1U << tsch->backoff_exp);
+        if (tsch->backoff_exp < CONFIG_GNRC_TSCH_MAX_BE) {
+            tsch->backoff_exp++;
+        }
+    }
+}
+
+static void _transmit(gnrc_netif_t *netif)
+{
+    gnrc_tsch_t *tsch = TSCH(netif);
+    int res;
+
+    tsch->action = GNRC_TSCH_ACTION_TX_WAIT;
+    if (tsch->flags & GNRC_TSCH_FLAG_TX_EB) {
+        uint8_t eb[IEEE802154_FRAME_LEN_MAX];
+        iolist_t iolist = {
+            .iol_base = eb,
+            .iol_len = gnrc_tsch_eb_build(netif, eb),
+        };
+        res = netif->dev->driver->send(netif->dev, &iolist);
+    }
+    else {
+        res = _transmit_pkt(netif, netif->mac.tx.packet);
+#ifdef MODULE_NETSTATS_L2
+        if (netif->mac.tx.current_neighbor ==
+            &netif->mac.tx.neighbors[BCAST_NEIGHBOR]) {
+            netif->stats.tx_mcast_count++;
+        }
+        else {
+            netif->stats.tx_unicast_count++;
+        }
+#endif
+    }
+
+    if (res < 0) {
+        DEBUG("[TSCH] send failed: %d\n", res);
+        _tx_done(netif, TX_FEEDBACK_BUSY);
+    }
+}
+
+/*
+ * Timeslots
+ */
+
+static void _begin_slot(gnrc_netif_t *netif)
+{
+    gnrc_tsch_t *tsch = TSCH(netif);
+    uint16_t timeslot = tsch->asn % CONFIG_GNRC_TSCH_SLOTFRAME_LENGTH;
+
+    gnrc_netif_acquire(netif);
+    int idx = _link_find(tsch, timeslot);
+    if (idx >= 0) {
+        tsch->link = tsch->links[idx];
+    }
+    gnrc_netif_release(netif);
+
+    if (idx < 0) {
+        _sleep(netif);
+        return;
+    }
+
+    uint8_t channel = _hopping_sequence[(tsch->asn + tsch->link.channel_offset) %
+                                        ARRAY_SIZE(_hopping_sequence)];
+
+    if ((tsch->link.options & GNRC_TSCH_LINK_TX) && _select_tx(netif)) {
+        tsch->action = GNRC_TSCH_ACTION_TX;
+        _set_channel(netif, channel);
+        _set_timer_at(&tsch->action_timer,
+                      tsch->slot_start + CONFIG_GNRC_TSCH_TX_OFFSET_US);
+    }
+    else if (tsch->link.options & GNRC_TSCH_LINK_RX) {
+        tsch->action = GNRC_TSCH_ACTION_RX;
+        _set_channel(netif, channel);
+        _set_timer_at(&tsch->action_timer,
+                      tsch->slot_start + CONFIG_GNRC_TSCH_RX_OFFSET_US);
+    }
+    else {
+        _sleep(netif);
+    }
+}
+
+static void _next_slot(gnrc_netif_t *netif)
+{
+    gnrc_tsch_t *tsch = TSCH(netif);
+
+    if (!(tsch->flags & GNRC_TSCH_FLAG_SYNCED)) {
+        return;
+    }
+
+    tsch->asn++;
+    tsch->slot_start += CONFIG_GNRC_TSCH_TIMESLOT_US;
+    _set_timer_at(&tsch->slot_timer,
+                  tsch->slot_start + CONFIG_GNRC_TSCH_TIMESLOT_US);
+
+    if (!(tsch->flags & GNRC_TSCH_FLAG_COORDINATOR) &&
+        (ztimer_now(ZTIMER_MSEC) - tsch->last_sync >
+         CONFIG_GNRC_TSCH_DESYNC_TIMEOUT_MS)) {
+        _desync(netif);
+        return;
+    }
+
+    /* a transmission that did not finish in its slot is given up */
+    if (tsch->action == GNRC_TSCH_ACTION_TX_WAIT) {
+        _tx_done(netif, TX_FEEDBACK_BUSY);
+    }
+    _begin_slot(netif);
+}
+
+static void _action(gnrc_netif_t *netif)
+{
+    gnrc_tsch_t *tsch = TSCH(netif);
+
+    switch (tsch->action) {
+        case GNRC_TSCH_ACTION_SCAN:
+            _scan(netif);
+            break;
+        case GNRC_TSCH_ACTION_TX:
+            _transmit(netif);
+            break;
+        case GNRC_TSCH_ACTION_RX:
+            tsch->action = GNRC_TSCH_ACTION_RX_WAIT;
+            gnrc_netif_set_rx_started(netif, false);
+            _set_radio_state(netif, NETOPT_STATE_IDLE);
+            _set_timer_at(&tsch->action_timer,
+                          tsch->slot_start + CONFIG_GNRC_TSCH_RX_OFFSET_US +
+                          CONFIG_GNRC_TSCH_RX_WAIT_US);
+            break;
+        case GNRC_TSCH_ACTION_RX_WAIT:
+            /* keep listening to a frame that is being received */
+            if (!gnrc_netif_get_rx_started(netif)) {
+                _sleep(netif);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+/*
+ * Reception
+ */
+
+static gnrc_pktsnip_t *_make_netif_hdr(uint8_t *mhr)
+{
+    gnrc_pktsnip_t *snip;
+    uint8_t src[IEEE802154_LONG_ADDRESS_LEN], dst[IEEE802154_LONG_ADDRESS_LEN];
+    int src_len, dst_len;
+    le_uint16_t _pan_tmp;
+
+    dst_len = ieee802154_get_dst(mhr, dst, &_pan_tmp);
+    src_len = ieee802154_get_src(mhr, src, &_pan_tmp);
+    if ((dst_len < 0) || (src_len < 0)) {
+        DEBUG("[TSCH] unable to get addresses\n");
+        return NULL;
+    }
+    snip = gnrc_netif_hdr_build(src, (size_t)src_len, dst, (size_t)dst_len);
+    if (snip == NULL) {
+        DEBUG("[TSCH] no space left in packet buffer\n");
+        return NULL;
+    }
+    if ((dst_len == 2) && (dst[0] == 0xff) && (dst[1] == 0xff)) {
+        gnrc_netif_hdr_t *hdr = snip->data;
+        hdr->flags |= GNRC_NETIF_HDR_FLAGS_BROADCAST;
+    }
+    return snip;
+}
+
+static void _recv_eb(gnrc_netif_t *netif, uint8_t *frame, size_t len)
+{
+    gnrc_tsch_t *tsch = TSCH(netif);
+    uint8_t src[IEEE802154_LONG_ADDRESS_LEN];
+    le_uint16_t pan;
+    uint64_t asn;
+    uint8_t join_metric;
+
+    if ((ieee802154_get_src(frame, src, &pan) != IEEE802154_LONG_ADDRESS_LEN) ||
+        (gnrc_tsch_eb_parse(frame, len, &asn, &join_metric) < 0)) {
+        DEBUG("[TSCH] malformed Enhanced Beacon\n");
+        return;
+    }
+    if (tsch->action == GNRC_TSCH_ACTION_SCAN) {
+        _join(netif, src, asn, join_metric);
+    }
+    else if ((tsch->flags & GNRC_TSCH_FLAG_SYNCED) &&
+             (tsch->link.options & GNRC_TSCH_LINK_TIMEKEEPING) &&
+             _is_time_source(tsch, src, sizeof(src))) {
+        _resync(netif);
+    }
+}
+
+static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
+{
+    netdev_t *dev = netif->dev;
+    netdev_ieee802154_rx_info_t rx_info;
+    netdev_ieee802154_t *state = (netdev_ieee802154_t *)netif->dev;
+    gnrc_tsch_t *tsch = TSCH(netif);
+    gnrc_pktsnip_t *pkt, *ieee802154_hdr, *netif_hdr;
+    gnrc_netif_hdr_t *hdr;
+    int bytes_expected = dev->driver->recv(dev, NULL, 0, NULL);
+    int nread;
+    size_t mhr_len;
+
+    if (bytes_expected <= 0) {
+        return NULL;
+    }
+    pkt = gnrc_pktbuf_add(NULL, NULL, bytes_expected, GNRC_NETTYPE_UNDEF);
+    if (pkt == NULL) {
+        DEBUG("[TSCH] cannot allocate pktsnip.\n");
+        /* drop the frame */
+        dev->driver->recv(dev, NULL, bytes_expected, NULL);
+        return NULL;
+    }
+    nread = dev->driver->recv(dev, pkt->data, bytes_expected, &rx_info);
+    if (nread <= 0) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+
+    switch (((uint8_t *)pkt->data)[0] & IEEE802154_FCF_TYPE_MASK) {
+        case IEEE802154_FCF_TYPE_BEACON:
+            _recv_eb(netif, pkt->data, nread);
+            gnrc_pktbuf_release(pkt);
+            return NULL;
+        case IEEE802154_FCF_TYPE_DATA:
+            if (tsch->flags & GNRC_TSCH_FLAG_SYNCED) {
+                break;
+            }
+            /* fall-through */
+        default:
+            gnrc_pktbuf_release(pkt);
+            return NULL;
+    }
+
+    mhr_len = ieee802154_get_frame_hdr_len(pkt->data);
+    if ((mhr_len == 0) || ((int)mhr_len > nread)) {
+        DEBUG("[TSCH] illegally formatted frame received\n");
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    nread -= mhr_len;
+    ieee802154_hdr = gnrc_pktbuf_mark(pkt, mhr_len, GNRC_NETTYPE_UNDEF);
+    if (ieee802154_hdr == NULL) {
+        DEBUG("[TSCH] no space left in packet buffer\n");
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    netif_hdr = _make_netif_hdr(ieee802154_hdr->data);
+    if (netif_hdr == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    hdr = netif_hdr->data;
+
+#ifdef MODULE_L2FILTER
+    if (!l2filter_pass(dev->filter, gnrc_netif_hdr_get_src_addr(hdr),
+                       hdr->src_l2addr_len)) {
+        gnrc_pktbuf_release(pkt);
+        gnrc_pktbuf_release(netif_hdr);
+        DEBUG("[TSCH] packet dropped by l2filter\n");
+#ifdef MODULE_NETSTATS_L2
+        netif->stats.rx_filtered++;
+#endif
+        return NULL;
+    }
+#endif
+
+    if ((tsch->link.options & GNRC_TSCH_LINK_TIMEKEEPING) &&
+        _is_time_source(tsch, gnrc_netif_hdr_get_src_addr(hdr),
+                        hdr->src_l2addr_len)) {
+        _resync(netif);
+    }
+
+    hdr->lqi = rx_info.lqi;
+    hdr->rssi = rx_info.rssi;
+    gnrc_netif_hdr_set_netif(hdr, netif);
+    pkt->type = state->proto;
+    gnrc_pktbuf_remove_snip(pkt, ieee802154_hdr);
+    LL_APPEND(pkt, netif_hdr);
+    gnrc_pktbuf_realloc_data(pkt, nread);
+
+    return pkt;
+}
+
+/*
+ * Events
+ */
+
+static void _tsch_event_cb(netdev_t *dev, netdev_event_t event)
+{
+    gnrc_netif_t *netif = (gnrc_netif_t *)dev->context;
+    gnrc_tsch_t *tsch = TSCH(netif);
+
+    if (event == NETDEV_EVENT_ISR) {
+        msg_t msg = { .type = NETDEV_MSG_TYPE_EVENT,
+                      .content = { .ptr = netif } };
+
+        if (msg_send(&msg, netif->pid) <= 0) {
+            LOG_WARNING("WARNING: [TSCH] gnrc_netdev: possibly lost interrupt.\n");
+        }
+        return;
+    }
+
+    switch (event) {
+        case NETDEV_EVENT_RX_STARTED:
+            /* timestamp for synchronization, as early as possible */
+            tsch->rx_start = ztimer_now(ZTIMER_USEC);
+            gnrc_netif_set_rx_started(netif, true);
+            break;
+        case NETDEV_EVENT_RX_COMPLETE: {
+            gnrc_pktsnip_t *pkt = netif->ops->recv(netif);
+
+            gnrc_netif_set_rx_started(netif, false);
+            if (tsch->action == GNRC_TSCH_ACTION_RX_WAIT) {
+                _sleep(netif);
+            }
+            if (pkt && !gnrc_netapi_dispatch_receive(pkt->type,
+                                                     GNRC_NETREG_DEMUX_CTX_ALL,
+                                                     pkt)) {
+                DEBUG("[TSCH] unable to forward packet of type %i\n",
+                      pkt->type);
+                gnrc_pktbuf_release(pkt);
+            }
+            break;
+        }
+        case NETDEV_EVENT_TX_COMPLETE:
+            if (tsch->action == GNRC_TSCH_ACTION_TX_WAIT) {
+                _tx_done(netif, TX_FEEDBACK_SUCCESS);
+            }
+            break;
+        case NETDEV_EVENT_TX_NOACK:
+            if (tsch->action == GNRC_TSCH_ACTION_TX_WAIT) {
+                _tx_done(netif, TX_FEEDBACK_NOACK);
+            }
+            break;
+        case NETDEV_EVENT_TX_MEDIUM_BUSY:
+            if (tsch->action == GNRC_TSCH_ACTION_TX_WAIT) {
+                _tx_done(netif, TX_FEEDBACK_BUSY);
+            }
+            break;
+        default:
+            DEBUG("[TSCH] unhandled netdev event: %u\n", event);
+    }
+}
+
+static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
+{
+    if (!gnrc_mac_queue_tx_packet(&netif->mac.tx, 0, pkt)) {
+        gnrc_pktbuf_release(pkt);
+        LOG_WARNING("WARNING: [TSCH] TX queue full, drop packet\n");
+        return -ENOBUFS;
+    }
+    /* sent in the next matching TX link */
+    return 0;
+}
+
+static void _tsch_msg_handler(gnrc_netif_t *netif, msg_t *msg)
+{
+    switch (msg->type) {
+        case GNRC_TSCH_EVENT_SLOT_TYPE:
+            _next_slot(netif);
+            break;
+        case GNRC_TSCH_EVENT_ACTION_TYPE:
+            _action(netif);
+            break;
+        case GNRC_TSCH_EVENT_COORDINATOR_TYPE:
+            _start_coordinator(netif);
+            break;
+        default:
+            DEBUG("[TSCH]: unknown message type 0x%04x\n", msg->type);
+            break;
+    }
+}
+
+static void _tsch_init(gnrc_netif_t *netif)
+{
+    netdev_t *dev;
+    gnrc_tsch_t *tsch = TSCH(netif);
+
+    gnrc_netif_default_init(netif);
+    dev = netif->dev;
+    dev->event_callback = _tsch_event_cb;
+
+    /* the start of a frame is the reference for synchronization */
+    netopt_enable_t enable = NETOPT_ENABLE;
+    dev->driver->set(dev, NETOPT_RX_START_IRQ, &enable, sizeof(enable));
+    dev->driver->set(dev, NETOPT_TX_END_IRQ, &enable, sizeof(enable));
+
+    /* the schedule avoids collisions and retransmissions happen in later
+     * links, not right away */
+    netopt_enable_t disable = NETOPT_DISABLE;
+    uint8_t retrans = 0;
+    dev->driver->set(dev, NETOPT_CSMA, &disable, sizeof(disable));
+    dev->driver->set(dev, NETOPT_RETRANS, &retrans, sizeof(retrans));
+
+    uint16_t src_len = IEEE802154_LONG_ADDRESS_LEN;
+    dev->driver->set(dev, NETOPT_SRC_LEN, &src_len, sizeof(src_len));
+    netif->l2addr_len = dev->driver->get(dev, NETOPT_ADDRESS_LONG,
+                                         &netif->l2addr,
+                                         IEEE802154_LONG_ADDRESS_LEN);
+
+    memset(tsch, 0, sizeof(*tsch));
+    tsch->slot_timer.callback = _slot_cb;
+    tsch->slot_timer.arg = netif;
+    tsch->action_timer.callback = _action_cb;
+    tsch->action_timer.arg = netif;
+    tsch->backoff_exp = CONFIG_GNRC_TSCH_MIN_BE;
+    _schedule_minimal(tsch);
+
+    if (IS_ACTIVE(CONFIG_GNRC_TSCH_COORDINATOR)) {
+        _start_coordinator(netif);
+    }
+    else {
+        _scan(netif);
+    }
+}
@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_tsch
+ * @{
+ *
+ * @file
+ * @brief       Enhanced Beacons of the TSCH MAC protocol
+ *
+ * @author      ML!PA Consulting GmbH
+ * @}
+ */
+
+#include <errno.h>
+#include <stdint.h>
+
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/internal.h"
+#include "net/gnrc/tsch/tsch.h"
+#include "net/ieee802154.h"
+#include "net/netdev/ieee802154.h"
+
+#include "include/tsch_internal.h"
+
+/* information element descriptors, IEEE 802.15.4-2015, 7.4 */
+#define IE_HDR_ID_MASK          (0x7f80)
+#define IE_HDR_LEN_MASK         (0x007f)
+#define IE_HT1                  (0x3f00)    /* header termination 1 */
+#define IE_HT2                  (0x3f80)    /* header termination 2 */
+#define IE_PAYLOAD              (0x8000)
+#define IE_PAYLOAD_LEN_MASK     (0x07ff)
+#define IE_PAYLOAD_GROUP_SHIFT  (11U)
+#define IE_PAYLOAD_GROUP_MLME   (0x1)
+#define IE_MLME                 (IE_PAYLOAD | \
+                                 (IE_PAYLOAD_GROUP_MLME << IE_PAYLOAD_GROUP_SHIFT))
+#define SUBIE_LONG              (0x8000)
+#define SUBIE_SHORT_LEN_MASK    (0x00ff)
+#define SUBIE_SYNC              (0x1a00)    /* TSCH synchronization */
+#define SUBIE_SLOTFRAME         (0x1b00)    /* TSCH slotframe and link */
+#define SUBIE_TIMESLOT          (0x1c00)    /* TSCH timeslot */
+#define SUBIE_HOPPING           (0xc800)    /* channel hopping, long */
+
+#define SYNC_IE_LEN             (6U)        /* ASN and join metric */
+#define ASN_LEN                 (5U)
+
+static size_t _put_le16(uint8_t *buf, size_t pos, uint16_t val)
+{
+    buf[pos++] = val & 0xff;
+    buf[pos++] = val >> 8;
+    return pos;
+}
+
+size_t gnrc_tsch_eb_build(gnrc_netif_t *netif, uint8_t *buf)
+{
+    netdev_ieee802154_t *state = (netdev_ieee802154_t *)netif->dev;
+    gnrc_tsch_t *tsch = &netif->mac.prot.tsch;
+    le_uint16_t pan = byteorder_btols(byteorder_htons(state->pan));
+    size_t pos, mlme, sfl, links;
+
+    /* no destination, source PAN and long source address */
+    pos = ieee802154_set_frame_hdr(buf, netif->l2addr, netif->l2addr_len,
+                                   NULL, 0, pan, pan,
+                                   IEEE802154_FCF_TYPE_BEACON, state->seq++);
+    buf[1] &= ~IEEE802154_FCF_VERS_MASK;
+    buf[1] |= IEEE802154_FCF_VERS_V2 | IEEE802154_FCF_IE_PRESENT;
+
+    pos = _put_le16(buf, pos, IE_HT1);
+    mlme = pos;
+    pos += 2;
+
+    pos = _put_le16(buf, pos, SUBIE_SYNC | SYNC_IE_LEN);
+    for (unsigned i = 0; i < ASN_LEN; i++) {
+        buf[pos++] = tsch->asn >> (8 * i);
+    }
+    buf[pos++] = tsch->join_metric;
+
+    /* default timeslot template and hopping sequence */
+    pos = _put_le16(buf, pos, SUBIE_TIMESLOT | 1);
+    buf[pos++] = 0;
+    pos = _put_le16(buf, pos, SUBIE_HOPPING | 1);
+    buf[pos++] = 0;
+
+    /* the links to any neighbor, so joining nodes know where to talk */
+    sfl = pos;
+    pos += 2;
+    buf[pos++] = 1;     /* number of slotframes */
+    buf[pos++] = 0;     /* slotframe handle */
+    pos = _put_le16(buf, pos, CONFIG_GNRC_TSCH_SLOTFRAME_LENGTH);
+    links = pos++;
+    buf[links] = 0;
+    gnrc_netif_acquire(netif);
+    for (unsigned i = 0; i < tsch->links_numof; i++) {
+        const gnrc_tsch_link_t *link = &tsch->links[i];
+        if (link->addr_len == 0) {
+            pos = _put_le16(buf, pos, link->timeslot);
+            pos = _put_le16(buf, pos, link->channel_offset);
+            buf[pos++] = link->options;
+            buf[links]++;
+        }
+    }
+    gnrc_netif_release(netif);
+    _put_le16(buf, sfl, SUBIE_SLOTFRAME | (pos - sfl - 2));
+    _put_le16(buf, mlme, IE_MLME | (pos - mlme - 2));
+
+    return pos;
+}
+
+int gnrc_tsch_eb_parse(const uint8_t *buf, size_t len, uint64_t *asn,
+                       uint8_t *join_metric)
+{
+    /* the header length is derived from the frame control field */
+    if (len < IEEE802154_MIN_FRAME_LEN) {
+        return -EINVAL;
+    }
+
+    size_t hdr_len = ieee802154_get_frame_hdr_len(buf);
+    const uint8_t *pos = buf + hdr_len, *end = buf + len;
+
+    if ((hdr_len == 0) || (hdr_len > len) ||
+        ((buf[1] & IEEE802154_FCF_VERS_MASK) != IEEE802154_FCF_VERS_V2) ||
+        !(buf[1] & IEEE802154_FCF_IE_PRESENT)) {
+        return -EINVAL;
+    }
+
+    /* header IEs up to the termination */
+    while (1) {
+        if (end - pos < 2) {
+            return -EINVAL;
+        }
+        uint16_t desc = pos[0] | (pos[1] << 8);
+        pos += 2;
+        if ((desc & IE_HDR_ID_MASK) == IE_HT1) {
+            break;
+        }
+        if ((desc & IE_HDR_ID_MASK) == IE_HT2) {
+            return -ENOENT;
+        }
+        pos += desc & IE_HDR_LEN_MASK;
+    }
+
+    /* payload IEs, only the MLME group is of interest */
+    while (end - pos >= 2) {
+        uint16_t desc = pos[0] | (pos[1] << 8);
+        size_t ie_len = desc & IE_PAYLOAD_LEN_MASK;
+        pos += 2;
+        if (ie_len > (size_t)(end - pos)) {
+            return -EINVAL;
+        }
+        if ((desc & ~IE_PAYLOAD_LEN_MASK) == IE_MLME) {
+            const uint8_t *sub = pos, *sub_end = pos + ie_len;
+            while (sub_end - sub >= 2) {
+                uint16_t sub_desc = sub[0] | (sub[1] << 8);
+                size_t sub_len = (sub_desc & SUBIE_LONG)
+                               ? (sub_desc & IE_PAYLOAD_LEN_MASK)
+                               : (sub_desc & SUBIE_SHORT_LEN_MASK);
+                sub += 2;
+                if (sub_len > (size_t)(sub_end - sub)) {
+                    return -EINVAL;
+                }
+                if (((sub_desc & ~SUBIE_SHORT_LEN_MASK) == SUBIE_SYNC) &&
+                    (sub_len >= SYNC_IE_LEN)) {
+                    *asn = 0;
+                    for (unsigned i = 0; i < ASN_LEN; i++) {
+                        *asn |= (uint64_t)sub[i] << (8 * i);
+                    }
+                    *join_metric = sub[ASN_LEN];
+                    return 0;
+                }
+                sub += sub_len;
+            }
+        }
+        pos += ie_len;
+    }
+    return -ENOENT;
+}
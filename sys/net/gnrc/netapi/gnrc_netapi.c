@@ -20,11 +20,18 @@
 
 #include <errno.h>
 
+#include "kernel_defines.h"
 #include "mbox.h"
 #include "msg.h"
 #include "net/gnrc/netreg.h"
 #include "net/gnrc/pktbuf.h"
 #include "net/gnrc/netapi.h"
+#if IS_USED(MODULE_GNRC_IPV6_FWD_THREAD)
+#include "net/gnrc/ipv6.h"
+#endif
+#if IS_USED(MODULE_GNRC_NETIF_ATTRS)
+#include "net/gnrc/netif/attrs.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -40,6 +47,16 @@ int _gnrc_netapi_get_set(kernel_pid_t pid, netopt_t opt, uint16_t context,
     o.context = context;
     o.data = data;
     o.data_len = data_len;
+#if IS_USED(MODULE_GNRC_NETIF_ATTRS)
+    /* stable interface attributes don't need the interface thread */
+    if (type == GNRC_NETAPI_MSG_TYPE_GET) {
+        int res = gnrc_netif_attrs_netapi_get(pid, &o);
+
+        if (res != -ENOTSUP) {
+            return res;
+        }
+    }
+#endif
     /* set outgoing message's fields */
     cmd.type = type;
     cmd.content.ptr = (void *)&o;
@@ -81,6 +98,19 @@ static inline int _snd_rcv_mbox(mbox_t *mbox, uint16_t type, gnrc_pktsnip_t *pkt
 }
 #endif
 
+static inline kernel_pid_t _target_pid(const gnrc_netreg_entry_t *entry,
+                                       bool fwd)
+{
+#if IS_USED(MODULE_GNRC_IPV6_FWD_THREAD)
+    if (fwd && (entry->target.pid == gnrc_ipv6_pid)) {
+        return gnrc_ipv6_fwd_pid;
+    }
+#else
+    (void)fwd;
+#endif
+    return entry->target.pid;
+}
+
 int gnrc_netapi_dispatch(gnrc_nettype_t type, uint32_t demux_ctx,
                          uint16_t cmd, gnrc_pktsnip_t *pkt)
 {
@@ -88,6 +118,15 @@ int gnrc_netapi_dispatch(gnrc_nettype_t type, uint32_t demux_ctx,
 
     if (numof != 0) {
         gnrc_netreg_entry_t *sendto = gnrc_netreg_lookup(type, demux_ctx);
+        bool fwd = false;
+
+#if IS_USED(MODULE_GNRC_IPV6_FWD_THREAD)
+        /* steer packets to be forwarded by destination, before any
+         * subscriber may change them */
+        fwd = (type == GNRC_NETTYPE_IPV6) &&
+              (demux_ctx == GNRC_NETREG_DEMUX_CTX_ALL) &&
+              (cmd == GNRC_NETAPI_MSG_TYPE_RCV) && gnrc_ipv6_fwd_steer(pkt);
+#endif
 
         gnrc_pktbuf_hold(pkt, numof - 1);
 
@@ -96,7 +135,7 @@ int gnrc_netapi_dispatch(gnrc_nettype_t type, uint32_t demux_ctx,
             uint32_t status = 0;
             switch (sendto->type) {
                 case GNRC_NETREG_TYPE_DEFAULT:
-                    if (_gnrc_netapi_send_recv(sendto->target.pid, pkt,
+                    if (_gnrc_netapi_send_recv(_target_pid(sendto, fwd), pkt,
                                                cmd) < 1) {
                         /* unable to dispatch packet */
                         status = EIO;
@@ -124,7 +163,7 @@ int gnrc_netapi_dispatch(gnrc_nettype_t type, uint32_t demux_ctx,
                 gnrc_pktbuf_release_error(pkt, status);
             }
 #else
-            if (_gnrc_netapi_send_recv(sendto->target.pid, pkt, cmd) < 1) {
+            if (_gnrc_netapi_send_recv(_target_pid(sendto, fwd), pkt, cmd) < 1) {
                 /* unable to dispatch packet */
                 gnrc_pktbuf_release_error(pkt, EIO);
             }
@@ -0,0 +1,233 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdatomic.h>
+#include <string.h>
+
+#include "net/gnrc/netif/attrs.h"
+#include "net/gnrc/netif/internal.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+static void _get_u16(gnrc_netif_t *netif, gnrc_netif_attrs_t *attrs,
+                     netopt_t o, uint16_t context, uint16_t *val, uint8_t flag)
+{
+    gnrc_netapi_opt_t opt = {
+        .opt = o,
+        .context = context,
+        .data = val,
+        .data_len = sizeof(*val),
+    };
+
+    if (netif->ops->get(netif, &opt) == sizeof(*val)) {
+        attrs->valid |= flag;
+    }
+}
+
+#if GNRC_NETIF_L2ADDR_MAXLEN > 0
+static uint8_t _get_addr(gnrc_netif_t *netif, gnrc_netif_attrs_t *attrs,
+                         netopt_t o, uint8_t *addr, uint8_t flag)
+{
+    gnrc_netapi_opt_t opt = {
+        .opt = o,
+        .data = addr,
+        .data_len = GNRC_NETIF_L2ADDR_MAXLEN,
+    };
+    int res = netif->ops->get(netif, &opt);
+
+    if (res <= 0) {
+        return 0;
+    }
+    attrs->valid |= flag;
+    return res;
+}
+#endif
+
+static void _set_ipv6(gnrc_netif_t *netif, gnrc_netif_attrs_t *attrs)
+{
+#if IS_USED(MODULE_GNRC_NETIF_IPV6)
+    attrs->ipv6_mtu = netif->ipv6.mtu;
+    attrs->valid |= GNRC_NETIF_ATTRS_IPV6_MTU;
+#else
+    (void)netif;
+    (void)attrs;
+#endif
+}
+
+/* the caller holds the lock of the interface, so there is only one writer */
+static void _publish(gnrc_netif_t *netif, const gnrc_netif_attrs_t *attrs)
+{
+    gnrc_netif_attrs_cache_t *cache = &netif->attrs;
+
+    cache->gen++;
+    atomic_thread_fence(memory_order_seq_cst);
+    cache->attrs = *attrs;
+    atomic_thread_fence(memory_order_seq_cst);
+    cache->gen++;
+    DEBUG("gnrc_netif_attrs: published generation %" PRIu32 " of %d\n",
+          cache->gen, netif->pid);
+}
+
+void gnrc_netif_attrs_update(gnrc_netif_t *netif)
+{
+    gnrc_netif_attrs_t attrs = { .device_type = netif->device_type };
+
+    /* gather everything before publishing, the getters may take a while */
+#if GNRC_NETIF_L2ADDR_MAXLEN > 0
+    attrs.addr_len = _get_addr(netif, &attrs, NETOPT_ADDRESS, attrs.addr,
+                               GNRC_NETIF_ATTRS_ADDRESS);
+    attrs.addr_long_len = _get_addr(netif, &attrs, NETOPT_ADDRESS_LONG,
+                                    attrs.addr_long,
+                                    GNRC_NETIF_ATTRS_ADDRESS_LONG);
+#endif
+    _get_u16(netif, &attrs, NETOPT_SRC_LEN, 0, &attrs.src_len,
+             GNRC_NETIF_ATTRS_SRC_LEN);
+    _get_u16(netif, &attrs, NETOPT_NID, 0, &attrs.nid, GNRC_NETIF_ATTRS_NID);
+    _get_u16(netif, &attrs, NETOPT_MAX_PDU_SIZE, 0, &attrs.max_pdu_size,
+             GNRC_NETIF_ATTRS_MAX_PDU_SIZE);
+
+    gnrc_netif_acquire(netif);
+    /* written by other threads as well, so only read under the lock */
+    _set_ipv6(netif, &attrs);
+    _publish(netif, &attrs);
+    gnrc_netif_release(netif);
+}
+
+void gnrc_netif_attrs_update_ipv6(gnrc_netif_t *netif)
+{
+    gnrc_netif_attrs_t attrs;
+
+    gnrc_netif_acquire(netif);
+    /* before the first full update there is nothing to refresh */
+    if (netif->attrs.gen != 0) {
+        attrs = netif->attrs.attrs;
+        _set_ipv6(netif, &attrs);
+        _publish(netif, &attrs);
+    }
+    gnrc_netif_release(netif);
+}
+
+bool gnrc_netif_attrs_affected(netopt_t opt)
+{
+    switch (opt) {
+        case NETOPT_6LO:
+        case NETOPT_ADDRESS:
+        case NETOPT_ADDRESS_LONG:
+        case NETOPT_ADDR_LEN:
+        case NETOPT_SRC_LEN:
+        case NETOPT_NID:
+        case NETOPT_MAX_PDU_SIZE:
+        case NETOPT_IEEE802154_PHY:
+        case NETOPT_ENCRYPTION:
+        case NETOPT_STATE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+uint32_t gnrc_netif_attrs_get(const gnrc_netif_attrs_cache_t *cache,
+                              gnrc_netif_attrs_t *attrs)
+{
+    uint32_t gen = cache->gen;
+
+    if ((gen == 0) || (gen & 1)) {
+        return 0;
+    }
+    atomic_thread_fence(memory_order_seq_cst);
+    memcpy(attrs, (const void *)&cache->attrs, sizeof(*attrs));
+    atomic_thread_fence(memory_order_seq_cst);
+    return (cache->gen == gen) ? gen : 0;
+}
+
+static int _reply(gnrc_netapi_opt_t *opt, const void *val, size_t len)
+{
+    if (opt->data_len < len) {
+        /* let the interface report the error */
+        return -ENOTSUP;
+    }
+    memcpy(opt->data, val, len);
+    return len;
+}
+
+int gnrc_netif_attrs_netapi_get(kernel_pid_t pid, gnrc_netapi_opt_t *opt)
+{
+    gnrc_netif_attrs_t attrs;
+    gnrc_netif_t *netif;
+    uint16_t val;
+
+    switch (opt->opt) {
+        case NETOPT_ADDRESS:
+        case NETOPT_ADDRESS_LONG:
+        case NETOPT_SRC_LEN:
+        case NETOPT_NID:
+        case NETOPT_MAX_PDU_SIZE:
+        case NETOPT_DEVICE_TYPE:
+            break;
+        default:
+            return -ENOTSUP;
+    }
+    netif = gnrc_netif_get_by_pid(pid);
+    if ((netif == NULL) || !gnrc_netif_attrs_get(&netif->attrs, &attrs)) {
+        return -ENOTSUP;
+    }
+    switch (opt->opt) {
+#if GNRC_NETIF_L2ADDR_MAXLEN > 0
+        case NETOPT_ADDRESS:
+            if (attrs.valid & GNRC_NETIF_ATTRS_ADDRESS) {
+                return _reply(opt, attrs.addr, attrs.addr_len);
+            }
+            break;
+        case NETOPT_ADDRESS_LONG:
+            if (attrs.valid & GNRC_NETIF_ATTRS_ADDRESS_LONG) {
+                return _reply(opt, attrs.addr_long, attrs.addr_long_len);
+            }
+            break;
+#endif
+        case NETOPT_SRC_LEN:
+            if (attrs.valid & GNRC_NETIF_ATTRS_SRC_LEN) {
+                return _reply(opt, &attrs.src_len, sizeof(attrs.src_len));
+            }
+            break;
+        case NETOPT_NID:
+            if (attrs.valid & GNRC_NETIF_ATTRS_NID) {
+                return _reply(opt, &attrs.nid, sizeof(attrs.nid));
+            }
+            break;
+        case NETOPT_MAX_PDU_SIZE:
+#if IS_USED(MODULE_GNRC_NETIF_IPV6)
+            if ((opt->context == GNRC_NETTYPE_IPV6) &&
+                (attrs.valid & GNRC_NETIF_ATTRS_IPV6_MTU)) {
+                return _reply(opt, &attrs.ipv6_mtu, sizeof(attrs.ipv6_mtu));
+            }
+#endif
+            if ((opt->context == 0) &&
+                (attrs.valid & GNRC_NETIF_ATTRS_MAX_PDU_SIZE)) {
+                return _reply(opt, &attrs.max_pdu_size,
+                              sizeof(attrs.max_pdu_size));
+            }
+            break;
+        case NETOPT_DEVICE_TYPE:
+            val = attrs.device_type;
+            return _reply(opt, &val, sizeof(val));
+        default:
+            break;
+    }
+    return -ENOTSUP;
+}
+
+/** @} */
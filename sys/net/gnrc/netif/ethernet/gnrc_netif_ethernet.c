@@ -17,9 +17,13 @@
 
 #include <string.h>
 
+#include "net/ethernet.h"
 #include "net/ethernet/hdr.h"
 #include "net/gnrc.h"
 #include "net/gnrc/netif/ethernet.h"
+#if IS_USED(MODULE_GNRC_NETIF_RX_ZEROCOPY)
+#include "net/gnrc/netif/rx_zerocopy.h"
+#endif
 #ifdef MODULE_GNRC_IPV6
 #include "net/ipv6/hdr.h"
 #endif
@@ -31,6 +35,7 @@
 #include "od.h"
 #endif
 
+static void _init(gnrc_netif_t *netif);
 static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt);
 static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif);
 #ifdef MODULE_GNRC_SIXLOENC
@@ -42,7 +47,7 @@ static int _set(gnrc_netif_t *netif, const gnrc_netapi_opt_t *opt);
 static char addr_str[ETHERNET_ADDR_LEN * 3];
 
 static const gnrc_netif_ops_t ethernet_ops = {
-    .init = gnrc_netif_default_init,
+    .init = _init,
     .send = _send,
     .recv = _recv,
     .get = gnrc_netif_get_from_netdev,
@@ -56,6 +61,14 @@ int gnrc_netif_ethernet_create(gnrc_netif_t *netif, char *stack, int stacksize,
                              &ethernet_ops);
 }
 
+static void _init(gnrc_netif_t *netif)
+{
+    gnrc_netif_default_init(netif);
+#if IS_USED(MODULE_GNRC_NETIF_RX_ZEROCOPY)
+    gnrc_netif_rx_zerocopy_init(netif, ETHERNET_FRAME_LEN);
+#endif
+}
+
 static inline void _addr_set_broadcast(uint8_t *dst)
 {
     memset(dst, 0xff, ETHERNET_ADDR_LEN);
@@ -165,44 +178,58 @@ static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
     return res;
 }
 
-static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
+static gnrc_pktsnip_t *_recv_frame(gnrc_netif_t *netif)
 {
     netdev_t *dev = netif->dev;
-    int bytes_expected = dev->driver->recv(dev, NULL, 0, NULL);
-    gnrc_pktsnip_t *pkt = NULL;
+    gnrc_pktsnip_t *pkt;
+    int bytes_expected, nread;
 
-    if (bytes_expected > 0) {
-        pkt = gnrc_pktbuf_add(NULL, NULL,
-                              bytes_expected,
-                              GNRC_NETTYPE_UNDEF);
+#if IS_USED(MODULE_GNRC_NETIF_RX_ZEROCOPY)
+    if (netdev_rx_zerocopy(dev)) {
+        return gnrc_netif_rx_zerocopy_recv(netif, NULL);
+    }
+#endif
+    bytes_expected = dev->driver->recv(dev, NULL, 0, NULL);
+    if (bytes_expected <= 0) {
+        return NULL;
+    }
+    pkt = gnrc_pktbuf_add(NULL, NULL, bytes_expected, GNRC_NETTYPE_UNDEF);
+    if (!pkt) {
+        DEBUG("gnrc_netif_ethernet: cannot allocate pktsnip.\n");
 
-        if (!pkt) {
-            DEBUG("gnrc_netif_ethernet: cannot allocate pktsnip.\n");
+        /* drop the packet */
+        dev->driver->recv(dev, NULL, bytes_expected, NULL);
+        return NULL;
+    }
 
-            /* drop the packet */
-            dev->driver->recv(dev, NULL, bytes_expected, NULL);
+    nread = dev->driver->recv(dev, pkt->data, bytes_expected, NULL);
+    if (nread <= 0) {
+        DEBUG("gnrc_netif_ethernet: read error.\n");
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    if (nread < bytes_expected) {
+        /* we've got less than the expected packet size,
+         * so free the unused space.*/
 
-            goto out;
-        }
+        DEBUG("gnrc_netif_ethernet: reallocating.\n");
+        gnrc_pktbuf_realloc_data(pkt, nread);
+    }
+    return pkt;
+}
+
+static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
+{
+    gnrc_pktsnip_t *pkt = _recv_frame(netif);
+
+    if (pkt != NULL) {
+        int nread = pkt->size;
 
-        int nread = dev->driver->recv(dev, pkt->data, bytes_expected, NULL);
-        if (nread <= 0) {
-            DEBUG("gnrc_netif_ethernet: read error.\n");
-            goto safe_out;
-        }
 #ifdef MODULE_NETSTATS_L2
         netif->stats.rx_count++;
         netif->stats.rx_bytes += nread;
 #endif
 
-        if (nread < bytes_expected) {
-            /* we've got less than the expected packet size,
-             * so free the unused space.*/
-
-            DEBUG("gnrc_netif_ethernet: reallocating.\n");
-            gnrc_pktbuf_realloc_data(pkt, nread);
-        }
-
         DEBUG("gnrc_netif_ethernet: received packet from %s of length %d\n",
               gnrc_netif_addr_to_str(pkt->data, ETHERNET_ADDR_LEN, addr_str),
               nread);
@@ -219,8 +246,11 @@ static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
         ethernet_hdr_t *hdr = (ethernet_hdr_t *)eth_hdr->data;
 
 #ifdef MODULE_L2FILTER
-        if (!l2filter_pass(dev->filter, hdr->src, ETHERNET_ADDR_LEN)) {
+        if (!l2filter_pass(netif->dev->filter, hdr->src, ETHERNET_ADDR_LEN)) {
             DEBUG("gnrc_netif_ethernet: incoming packet filtered by l2filter\n");
+#ifdef MODULE_NETSTATS_L2
+            netif->stats.rx_filtered++;
+#endif
             goto safe_out;
         }
 #endif
@@ -249,7 +279,6 @@ static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
         LL_APPEND(pkt, netif_hdr);
     }
 
-out:
     return pkt;
 
 safe_out:
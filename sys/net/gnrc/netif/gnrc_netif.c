@@ -15,10 +15,14 @@
  * @author  Oliver Hahm <oliver.hahm@inria.fr>
  */
 
+#include <errno.h>
 #include <string.h>
 #include <kernel_defines.h>
 
 #include "bitfield.h"
+#if IS_USED(MODULE_ENERGY)
+#include "energy.h"
+#endif
 #include "event.h"
 #include "net/ethernet.h"
 #include "net/ipv6.h"
@@ -27,12 +31,15 @@
 #include "net/gnrc/ipv6/nib.h"
 #include "net/gnrc/ipv6.h"
 #endif /* MODULE_GNRC_IPV6_NIB */
+#include "net/gnrc/ipv6/route_cache.h"
+#include "net/gnrc/sixlowpan/iphc.h"
 #ifdef MODULE_NETSTATS
 #include "net/netstats.h"
 #endif
 #include "fmt.h"
 #include "log.h"
 #include "sched.h"
+#include "trace.h"
 #include "xtimer.h"
 
 #include "net/gnrc/netif.h"
@@ -51,11 +58,102 @@ typedef struct {
 } event_netdev_t;
 #endif /* MODULE_GNRC_NETIF_EVENTS */
 
+#if IS_USED(MODULE_METRICS) && \
+    (IS_USED(MODULE_NETSTATS_L2) || IS_USED(MODULE_NETSTATS_IPV6))
+static const metrics_entry_t _netstats_entries[] = {
+    METRICS_ENTRY(METRICS_U32, "tx_unicast", netstats_t, tx_unicast_count),
+    METRICS_ENTRY(METRICS_U32, "tx_mcast", netstats_t, tx_mcast_count),
+    METRICS_ENTRY(METRICS_U32, "tx_success", netstats_t, tx_success),
+    METRICS_ENTRY(METRICS_U32, "tx_failed", netstats_t, tx_failed),
+    METRICS_ENTRY(METRICS_U32, "tx_bytes", netstats_t, tx_bytes),
+    METRICS_ENTRY(METRICS_U32, "rx_count", netstats_t, rx_count),
+    METRICS_ENTRY(METRICS_U32, "rx_bytes", netstats_t, rx_bytes),
+#if IS_USED(MODULE_GNRC_NETIF_PKTQ)
+    METRICS_ENTRY(METRICS_U32, "tx_queued", netstats_t, tx_queued),
+    METRICS_ENTRY(METRICS_U32, "tx_dropped", netstats_t, tx_dropped),
+#endif
+#if IS_USED(MODULE_L2FILTER)
+    METRICS_ENTRY(METRICS_U32, "rx_filtered", netstats_t, rx_filtered),
+#endif
+#if IS_USED(MODULE_GNRC_GOMACH)
+    METRICS_ENTRY(METRICS_U32, "mac_slots_alloc", netstats_t,
+                  mac_slots_alloc),
+    METRICS_ENTRY(METRICS_U32, "mac_slots_granted", netstats_t,
+                  mac_slots_granted),
+    METRICS_ENTRY(METRICS_U32, "mac_collisions", netstats_t, mac_collisions),
+    METRICS_ENTRY(METRICS_U32, "mac_idle_listen", netstats_t,
+                  mac_idle_listen),
+#endif
+};
+#endif
+
+#if IS_USED(MODULE_METRICS) && IS_USED(MODULE_GNRC_NETIF_IPV6)
+static struct {
+    metrics_gauge_t addrs_max;      /* addresses of an interface at most */
+    metrics_counter_t addrs_full;
+} _ipv6_metrics;
+
+static const metrics_entry_t _ipv6_metrics_entries[] = {
+    METRICS_ENTRY(METRICS_GAUGE, "addrs_max", _ipv6_metrics, addrs_max),
+    METRICS_ENTRY(METRICS_COUNTER, "addrs_full", _ipv6_metrics, addrs_full),
+};
+
+metrics_group_t gnrc_netif_ipv6_metrics = METRICS_GROUP("netif_ipv6",
+                                                        _ipv6_metrics,
+                                                        _ipv6_metrics_entries);
+#endif
+
 static void _update_l2addr_from_dev(gnrc_netif_t *netif);
 static void _configure_netdev(netdev_t *dev);
 static void *_gnrc_netif_thread(void *args);
 static void _event_cb(netdev_t *dev, netdev_event_t event);
 
+#if IS_USED(MODULE_ENERGY)
+/* state the radios return to after a frame, shared by all interfaces like
+ * the energy domain */
+static uint8_t _energy_radio_state = NETOPT_STATE_IDLE;
+
+static void _energy_set(netopt_state_t state)
+{
+    switch (state) {
+        case NETOPT_STATE_TX:
+            energy_set_state(&energy_radio, NETOPT_STATE_TX);
+            return;
+        case NETOPT_STATE_RESET:
+            state = NETOPT_STATE_IDLE;
+            break;
+        default:
+            break;
+    }
+    _energy_radio_state = state;
+    energy_set_state(&energy_radio, state);
+}
+
+static void _energy_event(netdev_event_t event)
+{
+    switch (event) {
+        case NETDEV_EVENT_TX_STARTED:
+            energy_set_state(&energy_radio, NETOPT_STATE_TX);
+            break;
+        case NETDEV_EVENT_RX_STARTED:
+            energy_set_state(&energy_radio, NETOPT_STATE_RX);
+            break;
+        case NETDEV_EVENT_RX_COMPLETE:
+        case NETDEV_EVENT_TX_COMPLETE:
+        case NETDEV_EVENT_TX_NOACK:
+        case NETDEV_EVENT_TX_MEDIUM_BUSY:
+            energy_set_state(&energy_radio, _energy_radio_state);
+            break;
+        default:
+            break;
+    }
+}
+#endif
+static void _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt, bool push_back);
+#if IS_USED(MODULE_GNRC_NETIF_PKTQ)
+static void _send_queued_pkt(gnrc_netif_t *netif);
+#endif
+
 int gnrc_netif_create(gnrc_netif_t *netif, char *stack, int stacksize,
                       char priority, const char *name, netdev_t *netdev,
                       const gnrc_netif_ops_t *ops)
@@ -73,6 +171,9 @@ int gnrc_netif_create(gnrc_netif_t *netif, char *stack, int stacksize,
     }
 #endif
     rmutex_init(&netif->mutex);
+#if IS_USED(MODULE_GNRC_NETIF_ATTRS)
+    netif->attrs.gen = 0;
+#endif
     netif->ops = ops;
     netif_register((netif_t*) netif);
     assert(netif->dev == NULL);
@@ -315,6 +416,7 @@ int gnrc_netif_set_from_netdev(gnrc_netif_t *netif,
             if (opt->context == GNRC_NETTYPE_IPV6) {
                 assert(opt->data_len == sizeof(uint16_t));
                 netif->ipv6.mtu = *((uint16_t *)opt->data);
+                gnrc_netif_attrs_update_ipv6(netif);
                 res = sizeof(uint16_t);
             }
             /* else set device */
@@ -380,12 +482,17 @@ int gnrc_netif_set_from_netdev(gnrc_netif_t *netif,
                     _update_l2addr_from_dev(netif);
                     break;
                 case NETOPT_IEEE802154_PHY:
+                case NETOPT_ENCRYPTION:
+                    /* the security headers shrink the L2-PDU */
                     gnrc_netif_ipv6_init_mtu(netif);
                     break;
                 case NETOPT_STATE:
                     if (*((netopt_state_t *)opt->data) == NETOPT_STATE_RESET) {
                         _configure_netdev(netif->dev);
                     }
+#if IS_USED(MODULE_ENERGY)
+                    _energy_set(*((netopt_state_t *)opt->data));
+#endif
                     break;
                 default:
                     break;
@@ -621,8 +728,23 @@ int gnrc_netif_ipv6_addr_add_internal(gnrc_netif_t *netif,
     }
     if (idx == UINT_MAX) {
         gnrc_netif_release(netif);
+#if IS_USED(MODULE_METRICS)
+        metrics_counter_inc(&_ipv6_metrics.addrs_full);
+#endif
         return -ENOMEM;
     }
+#if IS_USED(MODULE_METRICS)
+    int32_t used = 1;
+
+    for (unsigned i = 0; i < CONFIG_GNRC_NETIF_IPV6_ADDRS_NUMOF; i++) {
+        used += (netif->ipv6.addrs_flags[i] != 0);
+    }
+    /* interfaces are added to concurrently, a lost update only delays the
+     * maximum to the next address added */
+    if (used > _ipv6_metrics.addrs_max) {
+        metrics_gauge_set(&_ipv6_metrics.addrs_max, used);
+    }
+#endif
 #if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_ARSM)
     ipv6_addr_t sol_nodes;
     int res;
@@ -650,6 +772,7 @@ int gnrc_netif_ipv6_addr_add_internal(gnrc_netif_t *netif,
 #endif /* CONFIG_GNRC_IPV6_NIB_ARSM */
     netif->ipv6.addrs_flags[idx] = flags;
     memcpy(&netif->ipv6.addrs[idx], addr, sizeof(netif->ipv6.addrs[idx]));
+    gnrc_ipv6_route_cache_invalidate();
 #ifdef MODULE_GNRC_IPV6_NIB
     if (_get_state(netif, idx) == GNRC_NETIF_IPV6_ADDRS_FLAGS_STATE_VALID) {
         void *state = NULL;
@@ -710,6 +833,7 @@ void gnrc_netif_ipv6_addr_remove_internal(gnrc_netif_t *netif,
             }
         }
     }
+    gnrc_ipv6_route_cache_invalidate();
     if (remove_sol_nodes) {
         gnrc_netif_ipv6_group_leave_internal(netif, &sol_nodes);
     }
@@ -1217,6 +1341,8 @@ static void _update_l2addr_from_dev(gnrc_netif_t *netif)
     if (res > 0) {
         netif->l2addr_len = res;
     }
+    /* compressed headers depend on the IID derived from the address */
+    gnrc_sixlowpan_iphc_cache_invalidate();
 }
 
 static void _init_from_device(gnrc_netif_t *netif)
@@ -1499,11 +1625,31 @@ static void *_gnrc_netif_thread(void *args)
     }
     _configure_netdev(dev);
     netif->ops->init(netif);
+#if IS_USED(MODULE_GNRC_NETIF_ATTRS)
+    gnrc_netif_attrs_update(netif);
+#endif
+#if IS_USED(MODULE_GNRC_NETIF_PKTQ)
+    gnrc_netif_pktq_init(&netif->send_queue, netif->pid);
+#endif
 #if DEVELHELP
     assert(options_tested);
 #endif
 #ifdef MODULE_NETSTATS_L2
     memset(&netif->stats, 0, sizeof(netstats_t));
+#endif
+#if IS_USED(MODULE_METRICS) && IS_USED(MODULE_NETSTATS_L2)
+    netif->metrics = (metrics_group_t)METRICS_GROUP("l2", netif->stats,
+                                                    _netstats_entries);
+    netif->metrics.id = netif->pid;
+    metrics_register(&netif->metrics);
+#endif
+#if IS_USED(MODULE_METRICS) && IS_USED(MODULE_NETSTATS_IPV6) && \
+    IS_USED(MODULE_GNRC_NETIF_IPV6)
+    netif->metrics_ipv6 = (metrics_group_t)METRICS_GROUP("ipv6",
+                                                         netif->ipv6.stats,
+                                                         _netstats_entries);
+    netif->metrics_ipv6.id = netif->pid;
+    metrics_register(&netif->metrics_ipv6);
 #endif
     /* now let rest of GNRC use the interface */
     gnrc_netif_release(netif);
@@ -1526,16 +1672,7 @@ static void *_gnrc_netif_thread(void *args)
                 break;
             case GNRC_NETAPI_MSG_TYPE_SND:
                 DEBUG("gnrc_netif: GNRC_NETDEV_MSG_TYPE_SND received\n");
-                res = netif->ops->send(netif, msg.content.ptr);
-                if (res < 0) {
-                    DEBUG("gnrc_netif: error sending packet %p (code: %i)\n",
-                          msg.content.ptr, res);
-                }
-#ifdef MODULE_NETSTATS_L2
-                else {
-                    netif->stats.tx_bytes += res;
-                }
-#endif
+                _send(netif, msg.content.ptr, false);
 #if (CONFIG_GNRC_NETIF_MIN_WAIT_AFTER_SEND_US > 0U)
                 xtimer_periodic_wakeup(
                         &last_wakeup,
@@ -1546,6 +1683,26 @@ static void *_gnrc_netif_thread(void *args)
                 last_wakeup = xtimer_now();
 #endif
                 break;
+#if IS_USED(MODULE_GNRC_NETIF_TX_BURST)
+            case GNRC_NETIF_TX_BURST_MSG_TYPE_FLUSH:
+                DEBUG("gnrc_netif: GNRC_NETIF_TX_BURST_MSG_TYPE_FLUSH received\n");
+                res = gnrc_netif_tx_burst_flush(&netif->tx_burst, dev);
+                if (res < 0) {
+                    DEBUG("gnrc_netif: error sending burst (code: %i)\n", res);
+                }
+#ifdef MODULE_NETSTATS_L2
+                else {
+                    netif->stats.tx_bytes += res;
+                }
+#endif
+                break;
+#endif
+#if IS_USED(MODULE_GNRC_NETIF_PKTQ)
+            case GNRC_NETIF_PKTQ_DEQUEUE_MSG:
+                DEBUG("gnrc_netif: GNRC_NETIF_PKTQ_DEQUEUE_MSG received\n");
+                _send_queued_pkt(netif);
+                break;
+#endif
             case GNRC_NETAPI_MSG_TYPE_SET:
                 opt = msg.content.ptr;
 #ifdef MODULE_NETOPT
@@ -1558,6 +1715,11 @@ static void *_gnrc_netif_thread(void *args)
                 /* set option for device driver */
                 res = netif->ops->set(netif, opt);
                 DEBUG("gnrc_netif: response of netif->ops->set(): %i\n", res);
+#if IS_USED(MODULE_GNRC_NETIF_ATTRS)
+                if ((res >= 0) && gnrc_netif_attrs_affected(opt->opt)) {
+                    gnrc_netif_attrs_update(netif);
+                }
+#endif
                 reply.content.value = (uint32_t)res;
                 msg_reply(&msg, &reply);
                 break;
@@ -1593,6 +1755,89 @@ static void *_gnrc_netif_thread(void *args)
     return NULL;
 }
 
+#if IS_USED(MODULE_GNRC_NETIF_PKTQ)
+static void _queue_pkt(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt,
+                       bool push_back)
+{
+    int res;
+
+    if (push_back) {
+        res = gnrc_netif_pktq_push_back(&netif->send_queue, pkt);
+    }
+    else {
+        res = gnrc_netif_pktq_put(&netif->send_queue, pkt);
+    }
+    if (res < 0) {
+        DEBUG("gnrc_netif: send queue full, dropping packet %p\n",
+              (void *)pkt);
+#ifdef MODULE_NETSTATS_L2
+        netif->stats.tx_dropped++;
+#endif
+        /* let the sender know it should back off */
+        gnrc_pktbuf_release_error(pkt, ENOBUFS);
+        return;
+    }
+#ifdef MODULE_NETSTATS_L2
+    if (!push_back) {
+        netif->stats.tx_queued++;
+    }
+#endif
+    /* retry in case the device does not report the end of the current
+     * transmission */
+    gnrc_netif_pktq_sched_get(&netif->send_queue);
+}
+
+static void _send_queued_pkt(gnrc_netif_t *netif)
+{
+    gnrc_pktsnip_t *pkt;
+
+    xtimer_remove(&netif->send_queue.retry_timer);
+    if ((pkt = gnrc_netif_pktq_get(&netif->send_queue)) != NULL) {
+        _send(netif, pkt, true);
+        if (!gnrc_netif_pktq_empty(&netif->send_queue)) {
+            gnrc_netif_pktq_sched_get(&netif->send_queue);
+        }
+    }
+}
+#endif
+
+static void _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt, bool push_back)
+{
+    int res;
+
+#if IS_USED(MODULE_GNRC_NETIF_PKTQ)
+    if (!push_back && !gnrc_netif_pktq_empty(&netif->send_queue)) {
+        /* keep the order of packets of the same priority class */
+        _queue_pkt(netif, pkt, false);
+        return;
+    }
+    /* hold the packet, so it outlives netif->ops->send() releasing it if the
+     * device turns out to be busy */
+    gnrc_pktbuf_hold(pkt, 1);
+#else
+    (void)push_back;
+#endif
+    trace_event(TRACE_EV_NETIF_TX, netif->pid);
+    res = netif->ops->send(netif, pkt);
+#if IS_USED(MODULE_GNRC_NETIF_PKTQ)
+    if (res == -EBUSY) {
+        DEBUG("gnrc_netif: device busy, queueing packet %p\n", (void *)pkt);
+        _queue_pkt(netif, pkt, push_back);
+        return;
+    }
+    gnrc_pktbuf_release(pkt);
+#endif
+    if (res < 0) {
+        DEBUG("gnrc_netif: error sending packet %p (code: %i)\n",
+              (void *)pkt, res);
+    }
+#ifdef MODULE_NETSTATS_L2
+    else {
+        netif->stats.tx_bytes += res;
+    }
+#endif
+}
+
 static void _pass_on_packet(gnrc_pktsnip_t *pkt)
 {
     /* throw away packet if no one is interested */
@@ -1623,9 +1868,13 @@ static void _event_cb(netdev_t *dev, netdev_event_t event)
     }
     else {
         DEBUG("gnrc_netif: event triggered -> %i\n", event);
+#if IS_USED(MODULE_ENERGY)
+        _energy_event(event);
+#endif
         gnrc_pktsnip_t *pkt = NULL;
         switch (event) {
             case NETDEV_EVENT_RX_COMPLETE:
+                trace_event(TRACE_EV_NETIF_RX, netif->pid);
                 pkt = netif->ops->recv(netif);
                 if (pkt) {
                     _pass_on_packet(pkt);
@@ -1646,6 +1895,25 @@ static void _event_cb(netdev_t *dev, netdev_event_t event)
             default:
                 DEBUG("gnrc_netif: warning: unhandled event %u.\n", event);
         }
+#if IS_USED(MODULE_GNRC_NETIF_PKTQ)
+        switch (event) {
+            case NETDEV_EVENT_TX_COMPLETE:
+            case NETDEV_EVENT_TX_NOACK:
+            case NETDEV_EVENT_TX_MEDIUM_BUSY:
+                /* device is done with the last frame, send the next one.
+                 * Defer to the thread loop, as we are still in the driver's
+                 * ISR handling */
+                if (!gnrc_netif_pktq_empty(&netif->send_queue)) {
+                    xtimer_remove(&netif->send_queue.retry_timer);
+                    if (msg_send_to_self(&netif->send_queue.dequeue_msg) <= 0) {
+                        gnrc_netif_pktq_sched_get(&netif->send_queue);
+                    }
+                }
+                break;
+            default:
+                break;
+        }
+#endif
     }
 }
 /** @} */
@@ -22,6 +22,7 @@
 #include "net/ipv6.h"
 #endif
 #include "net/gnrc/netif.h"
+#include "net/gnrc/netif/internal.h"
 #include "net/eui48.h"
 #include "net/ethernet.h"
 #include "net/ieee802154.h"
@@ -203,6 +204,7 @@ void gnrc_netif_ipv6_init_mtu(gnrc_netif_t *netif)
             }
             break;
     }
+    gnrc_netif_attrs_update_ipv6(netif);
 }
 
 int gnrc_netif_ipv6_iid_from_addr(const gnrc_netif_t *netif,
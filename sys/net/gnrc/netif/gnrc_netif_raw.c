@@ -98,10 +98,12 @@ static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
 static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
 {
     int res = -ENOBUFS;
+    gnrc_pktsnip_t *payload = pkt;
 
     if (pkt->type == GNRC_NETTYPE_NETIF) {
-        /* we don't need the netif snip: remove it */
-        pkt = gnrc_pktbuf_remove_snip(pkt, pkt);
+        /* we don't need the netif snip: skip it (but keep the packet intact
+         * so it can be sent again with `gnrc_netif_pktq`) */
+        payload = pkt->next;
     }
 
     netdev_t *dev = netif->dev;
@@ -110,7 +112,7 @@ static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
     netif->stats.tx_unicast_count++;
 #endif
 
-    res = dev->driver->send(dev, (iolist_t *)pkt);
+    res = dev->driver->send(dev, (iolist_t *)payload);
     /* release old data */
     gnrc_pktbuf_release(pkt);
     return res;
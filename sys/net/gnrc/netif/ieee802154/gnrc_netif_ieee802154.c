@@ -15,6 +15,12 @@
 
 #include "net/gnrc.h"
 #include "net/gnrc/netif/ieee802154.h"
+#if IS_USED(MODULE_GNRC_NETIF_RX_ZEROCOPY)
+#include "net/gnrc/netif/rx_zerocopy.h"
+#endif
+#if IS_USED(MODULE_GNRC_NETIF_TX_BURST)
+#include "net/gnrc/netif/tx_burst.h"
+#endif
 #include "net/netdev/ieee802154.h"
 
 #ifdef MODULE_GNRC_IPV6
@@ -28,15 +34,27 @@
 #include "od.h"
 #endif
 
+#if IS_USED(MODULE_IEEE802154_SECURITY)
+#define _MHR_BUF_LEN    (IEEE802154_MAX_HDR_LEN + IEEE802154_SEC_MAX_AUX_HDR_LEN)
+#else
+#define _MHR_BUF_LEN    (IEEE802154_MAX_HDR_LEN)
+#endif
+
+static void _init(gnrc_netif_t *netif);
 static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt);
 static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif);
+#if IS_USED(MODULE_IEEE802154_SECURITY)
+static int _set(gnrc_netif_t *netif, const gnrc_netapi_opt_t *opt);
+#else
+#define _set    gnrc_netif_set_from_netdev
+#endif
 
 static const gnrc_netif_ops_t ieee802154_ops = {
-    .init = gnrc_netif_default_init,
+    .init = _init,
     .send = _send,
     .recv = _recv,
     .get = gnrc_netif_get_from_netdev,
-    .set = gnrc_netif_set_from_netdev,
+    .set = _set,
 };
 
 int gnrc_netif_ieee802154_create(gnrc_netif_t *netif, char *stack, int stacksize,
@@ -46,6 +64,67 @@ int gnrc_netif_ieee802154_create(gnrc_netif_t *netif, char *stack, int stacksize
                              &ieee802154_ops);
 }
 
+static void _init(gnrc_netif_t *netif)
+{
+    gnrc_netif_default_init(netif);
+#ifdef MODULE_GNRC_MAC
+    netopt_enable_t enable = NETOPT_ENABLE;
+
+    /* prefer CSMA-CA, ACKs and retransmissions done by the device, only
+     * fall back to software CSMA-CA if it can't */
+    if (netif->dev->driver->set(netif->dev, NETOPT_CSMA, &enable,
+                                sizeof(enable)) >= 0) {
+        netif->mac.mac_info |= GNRC_NETIF_MAC_INFO_CSMA_HW;
+    }
+    else {
+        netif->mac.mac_info |= GNRC_NETIF_MAC_INFO_CSMA_ENABLED;
+    }
+    netif->mac.csma_conf = CSMA_SENDER_CONF_DEFAULT;
+    netif->mac.csma_nb = 0;
+#endif
+#if IS_USED(MODULE_GNRC_NETIF_RX_ZEROCOPY)
+    gnrc_netif_rx_zerocopy_init(netif, IEEE802154_FRAME_LEN_MAX);
+#endif
+#if IS_USED(MODULE_GNRC_NETIF_TX_BURST)
+    gnrc_netif_tx_burst_init(&netif->tx_burst, netif->pid);
+#endif
+}
+
+#ifdef MODULE_GNRC_MAC
+static int _csma_send(gnrc_netif_t *netif, iolist_t *iolist)
+{
+    netdev_t *dev = netif->dev;
+
+    if (netif->mac.mac_info & GNRC_NETIF_MAC_INFO_CSMA_HW) {
+        /* the device reports the result with a TX event */
+        return dev->driver->send(dev, iolist);
+    }
+#if IS_USED(MODULE_GNRC_NETIF_PKTQ)
+    /* Don't block the thread for the backoff: try a single CCA and let the
+     * frame wait in the send queue while the medium is busy */
+    int res = csma_sender_cca_send(dev, iolist);
+
+    if (res != -EBUSY) {
+        netif->mac.csma_nb = 0;
+        return res;
+    }
+    if (++netif->mac.csma_nb <= netif->mac.csma_conf.max_backoffs) {
+        DEBUG("_send_ieee802154: medium busy, backoff %u\n",
+              netif->mac.csma_nb);
+        return -EBUSY;
+    }
+    DEBUG("_send_ieee802154: channel access failure\n");
+    netif->mac.csma_nb = 0;
+#ifdef MODULE_NETSTATS_L2
+    netif->stats.tx_failed++;
+#endif
+    return -ETIMEDOUT;
+#else
+    return csma_sender_csma_ca_send(dev, iolist, &netif->mac.csma_conf);
+#endif
+}
+#endif
+
 static gnrc_pktsnip_t *_make_netif_hdr(uint8_t *mhr)
 {
     gnrc_netif_hdr_t *hdr;
@@ -92,28 +171,147 @@ static inline bool _already_received(gnrc_netif_t *netif,
 }
 #endif /* MODULE_GNRC_NETIF_DEDUP */
 
-static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
+#if IS_USED(MODULE_IEEE802154_SECURITY)
+static int _set(gnrc_netif_t *netif, const gnrc_netapi_opt_t *opt)
 {
-    netdev_t *dev = netif->dev;
-    netdev_ieee802154_rx_info_t rx_info;
-    gnrc_pktsnip_t *pkt = NULL;
-    int bytes_expected = dev->driver->recv(dev, NULL, 0, NULL);
+    int res = gnrc_netif_set_from_netdev(netif, opt);
 
-    if (bytes_expected >= (int)IEEE802154_MIN_FRAME_LEN) {
-        int nread;
+    if ((res >= 0) && (opt->opt == NETOPT_ENCRYPTION) &&
+        (*((netopt_enable_t *)opt->data) == NETOPT_ENABLE)) {
+        /* receivers take the extended address for the nonce from the frame,
+         * so it has to be the source address */
+        uint16_t src_len = IEEE802154_LONG_ADDRESS_LEN;
+        const gnrc_netapi_opt_t src_len_opt = {
+            .opt = NETOPT_SRC_LEN,
+            .data = &src_len,
+            .data_len = sizeof(src_len),
+        };
 
-        pkt = gnrc_pktbuf_add(NULL, NULL, bytes_expected, GNRC_NETTYPE_UNDEF);
-        if (pkt == NULL) {
-            DEBUG("_recv_ieee802154: cannot allocate pktsnip.\n");
-            /* Discard packet on netdev device */
-            dev->driver->recv(dev, NULL, bytes_expected, NULL);
-            return NULL;
+        if (gnrc_netif_set_from_netdev(netif, &src_len_opt) < 0) {
+            DEBUG("_set_ieee802154: unable to use extended source address\n");
         }
-        nread = dev->driver->recv(dev, pkt->data, bytes_expected, &rx_info);
-        if (nread <= 0) {
+    }
+    return res;
+}
+
+static int _unprotect(gnrc_netif_t *netif, uint8_t *mhr, size_t *mhr_len,
+                      int *nread)
+{
+    netdev_ieee802154_t *state = (netdev_ieee802154_t *)netif->dev;
+    uint8_t src[IEEE802154_LONG_ADDRESS_LEN];
+    le_uint16_t src_pan;
+    uint8_t *payload, *mic;
+    uint16_t payload_len;
+    uint8_t hdr_len = *mhr_len;
+    uint8_t mic_len;
+
+    if (!(mhr[0] & IEEE802154_FCF_SECURITY_EN)) {
+        /* unprotected frames are only accepted with security disabled */
+        return (state->flags & NETDEV_IEEE802154_SECURITY_EN) ? -EPERM : 0;
+    }
+
+    /* the nonce needs the extended address of the sender */
+    if (ieee802154_get_src(mhr, src, &src_pan) != IEEE802154_LONG_ADDRESS_LEN) {
+        DEBUG("_recv_ieee802154: secured frame without extended source\n");
+        return -ENOTSUP;
+    }
+
+    int res = ieee802154_sec_decrypt_frame(&state->sec_ctx, *nread, mhr,
+                                           &hdr_len, &payload, &payload_len,
+                                           &mic, &mic_len, src);
+    if (res < 0) {
+        return res;
+    }
+    *mhr_len = hdr_len;
+    *nread -= mic_len;
+    return 0;
+}
+
+static gnrc_pktsnip_t *_protect(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt,
+                                uint8_t *mhr, uint8_t *mhr_len)
+{
+    netdev_ieee802154_t *state = (netdev_ieee802154_t *)netif->dev;
+    size_t payload_len = gnrc_pkt_len(pkt->next);
+    gnrc_pktsnip_t *payload;
+    uint8_t mic_len;
+    /* the payload is encrypted in a private copy that also takes the MIC,
+     * the original stays untouched in case the packet is sent again */
+    payload = gnrc_pktbuf_add(NULL, NULL,
+                              payload_len + IEEE802154_SEC_MAX_MIC_LEN,
+                              GNRC_NETTYPE_UNDEF);
+    if (payload == NULL) {
+        return NULL;
+    }
+    uint8_t *data = payload->data;
+    for (gnrc_pktsnip_t *ptr = pkt->next; ptr != NULL; ptr = ptr->next) {
+        memcpy(data, ptr->data, ptr->size);
+        data += ptr->size;
+    }
+
+    if (ieee802154_sec_encrypt_frame(&state->sec_ctx, mhr, mhr_len,
+                                     payload->data, payload_len,
+                                     data, &mic_len, state->long_addr) < 0) {
+        gnrc_pktbuf_release(payload);
+        return NULL;
+    }
+    gnrc_pktbuf_realloc_data(payload, payload_len + mic_len);
+    return payload;
+}
+#endif /* MODULE_IEEE802154_SECURITY */
+
+static gnrc_pktsnip_t *_recv_frame(gnrc_netif_t *netif,
+                                   netdev_ieee802154_rx_info_t *rx_info)
+{
+    netdev_t *dev = netif->dev;
+    gnrc_pktsnip_t *pkt;
+    int bytes_expected, nread;
+
+#if IS_USED(MODULE_GNRC_NETIF_RX_ZEROCOPY)
+    if (netdev_rx_zerocopy(dev)) {
+        pkt = gnrc_netif_rx_zerocopy_recv(netif, rx_info);
+        if ((pkt != NULL) && (pkt->size < IEEE802154_MIN_FRAME_LEN)) {
+            DEBUG("_recv_ieee802154: received frame is too short\n");
             gnrc_pktbuf_release(pkt);
             return NULL;
         }
+        return pkt;
+    }
+#endif
+    bytes_expected = dev->driver->recv(dev, NULL, 0, NULL);
+    if (bytes_expected < (int)IEEE802154_MIN_FRAME_LEN) {
+        if (bytes_expected > 0) {
+            DEBUG("_recv_ieee802154: received frame is too short\n");
+            dev->driver->recv(dev, NULL, bytes_expected, NULL);
+        }
+        return NULL;
+    }
+    pkt = gnrc_pktbuf_add(NULL, NULL, bytes_expected, GNRC_NETTYPE_UNDEF);
+    if (pkt == NULL) {
+        DEBUG("_recv_ieee802154: cannot allocate pktsnip.\n");
+        /* Discard packet on netdev device */
+        dev->driver->recv(dev, NULL, bytes_expected, NULL);
+        return NULL;
+    }
+    nread = dev->driver->recv(dev, pkt->data, bytes_expected, rx_info);
+    if (nread <= 0) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    if (nread < bytes_expected) {
+        gnrc_pktbuf_realloc_data(pkt, nread);
+    }
+    return pkt;
+}
+
+static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
+{
+    netdev_t *dev = netif->dev;
+    netdev_ieee802154_rx_info_t rx_info;
+    gnrc_pktsnip_t *pkt = _recv_frame(netif, &rx_info);
+
+    if (pkt != NULL) {
+        int nread = pkt->size;
+
 #ifdef MODULE_NETSTATS_L2
         netif->stats.rx_count++;
         netif->stats.rx_bytes += nread;
@@ -150,6 +348,13 @@ static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
                 gnrc_pktbuf_release(pkt);
                 return NULL;
             }
+#if IS_USED(MODULE_IEEE802154_SECURITY)
+            if (_unprotect(netif, pkt->data, &mhr_len, &nread) < 0) {
+                DEBUG("_recv_ieee802154: frame failed security processing\n");
+                gnrc_pktbuf_release(pkt);
+                return NULL;
+            }
+#endif
             nread -= mhr_len;
             /* mark IEEE 802.15.4 header */
             ieee802154_hdr = gnrc_pktbuf_mark(pkt, mhr_len, GNRC_NETTYPE_UNDEF);
@@ -173,6 +378,9 @@ static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
                 gnrc_pktbuf_release(pkt);
                 gnrc_pktbuf_release(netif_hdr);
                 DEBUG("_recv_ieee802154: packet dropped by l2filter\n");
+#ifdef MODULE_NETSTATS_L2
+                netif->stats.rx_filtered++;
+#endif
                 return NULL;
             }
 #endif
@@ -209,9 +417,6 @@ static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
 
         DEBUG("_recv_ieee802154: reallocating.\n");
         gnrc_pktbuf_realloc_data(pkt, nread);
-    } else if (bytes_expected > 0) {
-        DEBUG("_recv_ieee802154: received frame is too short\n");
-        dev->driver->recv(dev, NULL, bytes_expected, NULL);
     }
 
     return pkt;
@@ -225,7 +430,8 @@ static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
     const uint8_t *src, *dst = NULL;
     int res = 0;
     size_t src_len, dst_len;
-    uint8_t mhr[IEEE802154_MAX_HDR_LEN];
+    uint8_t mhr_buf[_MHR_BUF_LEN];
+    uint8_t *mhr = mhr_buf;
     uint8_t flags = (uint8_t)(state->flags & NETDEV_IEEE802154_SEND_MASK);
     le_uint16_t dev_pan = byteorder_btols(byteorder_htons(state->pan));
 
@@ -261,6 +467,23 @@ static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
         src_len = netif->l2addr_len;
         src = netif->l2addr;
     }
+#if IS_USED(MODULE_GNRC_NETIF_TX_BURST)
+    bool burst = true;
+#ifdef MODULE_GNRC_MAC
+    burst = !(netif->mac.mac_info & GNRC_NETIF_MAC_INFO_CSMA_ENABLED);
+#endif
+#if IS_USED(MODULE_IEEE802154_SECURITY)
+    /* the burst header buffers have no room for the auxiliary header */
+    burst = burst && !(state->flags & NETDEV_IEEE802154_SECURITY_EN);
+#endif
+    if (burst) {
+        mhr = gnrc_netif_tx_burst_hdr(&netif->tx_burst);
+    }
+    else {
+        /* keep frame order */
+        gnrc_netif_tx_burst_flush(&netif->tx_burst, dev);
+    }
+#endif
     /* fill MAC header, seq should be set by device */
     if ((res = ieee802154_set_frame_hdr(mhr, src, src_len,
                                         dst, dst_len, dev_pan,
@@ -268,6 +491,19 @@ static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
         DEBUG("_send_ieee802154: Error preperaring frame\n");
         return -EINVAL;
     }
+#if IS_USED(MODULE_IEEE802154_SECURITY)
+    gnrc_pktsnip_t *protected = NULL;
+    if (state->flags & NETDEV_IEEE802154_SECURITY_EN) {
+        uint8_t mhr_len = res;
+        protected = _protect(netif, pkt, mhr, &mhr_len);
+        if (protected == NULL) {
+            DEBUG("_send_ieee802154: unable to protect frame\n");
+            gnrc_pktbuf_release(pkt);
+            return -EINVAL;
+        }
+        res = mhr_len;
+    }
+#endif
 
     /* prepare iolist for netdev / mac layer */
     iolist_t iolist = {
@@ -275,6 +511,11 @@ static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
         .iol_base = mhr,
         .iol_len = (size_t)res
     };
+#if IS_USED(MODULE_IEEE802154_SECURITY)
+    if (protected) {
+        iolist.iol_next = (iolist_t *)protected;
+    }
+#endif
 
 #ifdef MODULE_NETSTATS_L2
     if (netif_hdr->flags &
@@ -285,9 +526,16 @@ static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
         netif->stats.tx_unicast_count++;
     }
 #endif
+#if IS_USED(MODULE_GNRC_NETIF_TX_BURST)
+    if (burst) {
+        return gnrc_netif_tx_burst_send(&netif->tx_burst, dev, pkt, res,
+                                        netif_hdr->flags &
+                                        GNRC_NETIF_HDR_FLAGS_MORE_DATA);
+    }
+#endif
 #ifdef MODULE_GNRC_MAC
     if (netif->mac.mac_info & GNRC_NETIF_MAC_INFO_CSMA_ENABLED) {
-        res = csma_sender_csma_ca_send(dev, &iolist, &netif->mac.csma_conf);
+        res = _csma_send(netif, &iolist);
     }
     else {
         res = dev->driver->send(dev, &iolist);
@@ -296,6 +544,11 @@ static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
     res = dev->driver->send(dev, &iolist);
 #endif
 
+#if IS_USED(MODULE_IEEE802154_SECURITY)
+    if (protected) {
+        gnrc_pktbuf_release(protected);
+    }
+#endif
     /* release old data */
     gnrc_pktbuf_release(pkt);
     return res;
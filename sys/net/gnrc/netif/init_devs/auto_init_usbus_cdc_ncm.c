@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ *
+ */
+
+/**
+ * @ingroup sys_auto_init_gnrc_netif
+ * @{
+ *
+ * @file
+ * @brief   Auto initialization for USB CDC NCM module
+ *
+ * @author  ML!PA Consulting GmbH
+ */
+
+#define USB_H_USER_IS_RIOT_INTERNAL
+
+#include "log.h"
+#include "usb/usbus/cdc/ncm.h"
+#include "net/gnrc/netif/ethernet.h"
+
+/**
+ * @brief global cdc ncm object, declared in the usb auto init file
+ */
+extern usbus_cdcncm_device_t cdcncm;
+
+/**
+ * @brief   Define stack parameters for the MAC layer thread
+ * @{
+ */
+#define CDCNCM_MAC_STACKSIZE (THREAD_STACKSIZE_DEFAULT)
+#ifndef CDCNCM_MAC_PRIO
+#define CDCNCM_MAC_PRIO      (GNRC_NETIF_PRIO)
+#endif
+/** @} */
+
+/**
+ * @brief   Stacks for the MAC layer threads
+ */
+static char _netdev_eth_stack[CDCNCM_MAC_STACKSIZE];
+static gnrc_netif_t _netif;
+extern void cdcncm_netdev_setup(usbus_cdcncm_device_t *cdcncm);
+
+void auto_init_netdev_cdcncm(void)
+{
+    LOG_DEBUG("[auto_init_netif] initializing cdc ncm #0\n");
+
+    cdcncm_netdev_setup(&cdcncm);
+    /* initialize netdev<->gnrc adapter state */
+    gnrc_netif_ethernet_create(&_netif, _netdev_eth_stack, CDCNCM_MAC_STACKSIZE,
+                               CDCNCM_MAC_PRIO, "cdcncm", &cdcncm.netdev);
+}
+/** @} */
@@ -129,6 +129,11 @@ void gnrc_netif_init_devs(void)
         auto_init_netdev_cdcecm();
     }
 
+    if (IS_USED(MODULE_USBUS_CDC_NCM)) {
+        extern void auto_init_netdev_cdcncm(void);
+        auto_init_netdev_cdcncm();
+    }
+
     if (IS_USED(MODULE_NETDEV_TAP)) {
         extern void auto_init_netdev_tap(void);
         auto_init_netdev_tap();
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2020 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "net/gnrc/netif/pktq.h"
+#include "net/gnrc/nettype.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/ipv6/hdr.h"
+#include "net/sixlowpan.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+void gnrc_netif_pktq_init(gnrc_netif_pktq_t *q, kernel_pid_t pid)
+{
+    memset(q, 0, sizeof(*q));
+    q->pid = pid;
+    q->dequeue_msg.type = GNRC_NETIF_PKTQ_DEQUEUE_MSG;
+    q->dequeue_msg.content.ptr = q;
+}
+
+/* class selector, i.e. the upper three bits of the traffic class */
+static uint8_t _class_selector(const gnrc_pktsnip_t *pkt)
+{
+#ifdef MODULE_GNRC_NETTYPE_IPV6
+    const gnrc_pktsnip_t *ipv6 = gnrc_pktsnip_search_type(
+            (gnrc_pktsnip_t *)pkt, GNRC_NETTYPE_IPV6
+        );
+
+    if ((ipv6 != NULL) && (ipv6->size >= sizeof(ipv6_hdr_t))) {
+        return ipv6_hdr_get_tc(ipv6->data) >> 5;
+    }
+#endif
+#ifdef MODULE_GNRC_NETTYPE_SIXLOWPAN
+    /* packet is compressed already */
+    const gnrc_pktsnip_t *sixlo = pkt->next;
+
+    if ((sixlo != NULL) && (sixlo->type == GNRC_NETTYPE_SIXLOWPAN) &&
+        (sixlo->size > SIXLOWPAN_IPHC_HDR_LEN) &&
+        sixlowpan_iphc_is(sixlo->data)) {
+        const uint8_t *iphc = sixlo->data;
+        unsigned tc_pos = SIXLOWPAN_IPHC_HDR_LEN;
+
+        if (iphc[1] & SIXLOWPAN_IPHC2_CID_EXT) {
+            tc_pos++;
+        }
+        /* inline traffic class is ECN (2 bit) followed by DSCP (6 bit) */
+        switch (iphc[0] & SIXLOWPAN_IPHC1_TF) {
+            case 0x00:
+            case 0x10:
+                if (tc_pos < sixlo->size) {
+                    return (iphc[tc_pos] >> 3) & 0x7;
+                }
+                break;
+            default:
+                /* DSCP elided */
+                break;
+        }
+    }
+#endif
+    (void)pkt;
+    return 0;
+}
+
+unsigned gnrc_netif_pktq_prio(const gnrc_pktsnip_t *pkt)
+{
+    return ((7U - _class_selector(pkt)) * CONFIG_GNRC_NETIF_PKTQ_PRIO_NUMOF) /
+           8U;
+}
+
+static gnrc_pktqueue_t *_alloc(gnrc_netif_pktq_t *q, gnrc_pktsnip_t *pkt)
+{
+    for (unsigned i = 0; i < CONFIG_GNRC_NETIF_PKTQ_LEN; i++) {
+        if (q->nodes[i].pkt == NULL) {
+            q->nodes[i].next = NULL;
+            q->nodes[i].pkt = pkt;
+            return &q->nodes[i];
+        }
+    }
+    DEBUG("gnrc_netif_pktq: queue full, dropping %p\n", (void *)pkt);
+    return NULL;
+}
+
+int gnrc_netif_pktq_put(gnrc_netif_pktq_t *q, gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktqueue_t *node = _alloc(q, pkt);
+
+    if (node == NULL) {
+        return -ENOBUFS;
+    }
+    gnrc_pktqueue_add(&q->queue[gnrc_netif_pktq_prio(pkt)], node);
+    return 0;
+}
+
+int gnrc_netif_pktq_push_back(gnrc_netif_pktq_t *q, gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktqueue_t *node = _alloc(q, pkt);
+    unsigned prio = gnrc_netif_pktq_prio(pkt);
+
+    if (node == NULL) {
+        return -ENOBUFS;
+    }
+    node->next = q->queue[prio];
+    q->queue[prio] = node;
+    return 0;
+}
+
+gnrc_pktsnip_t *gnrc_netif_pktq_get(gnrc_netif_pktq_t *q)
+{
+    for (unsigned i = 0; i < CONFIG_GNRC_NETIF_PKTQ_PRIO_NUMOF; i++) {
+        gnrc_pktqueue_t *node = gnrc_pktqueue_remove_head(&q->queue[i]);
+
+        if (node != NULL) {
+            gnrc_pktsnip_t *pkt = node->pkt;
+
+            node->pkt = NULL;
+            return pkt;
+        }
+    }
+    return NULL;
+}
+
+unsigned gnrc_netif_pktq_usage(const gnrc_netif_pktq_t *q)
+{
+    unsigned res = 0;
+
+    for (unsigned i = 0; i < CONFIG_GNRC_NETIF_PKTQ_LEN; i++) {
+        if (q->nodes[i].pkt != NULL) {
+            res++;
+        }
+    }
+    return res;
+}
+/** @} */
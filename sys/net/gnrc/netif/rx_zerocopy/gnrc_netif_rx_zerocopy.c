@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2020 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <assert.h>
+
+#include "log.h"
+#include "net/gnrc/netif/rx_zerocopy.h"
+#include "net/gnrc/pktbuf.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+static int _lend(gnrc_netif_t *netif, netdev_rx_buf_t *buf,
+                 gnrc_pktsnip_t *pkt)
+{
+    netdev_t *dev = netif->dev;
+    int res;
+
+    buf->data = pkt->data;
+    buf->size = pkt->size;
+    buf->ctx = pkt;
+    res = dev->driver->rx_buf_give(dev, buf);
+    if (res < 0) {
+        DEBUG("gnrc_netif_rx_zerocopy: device refused buffer: %d\n", res);
+        buf->ctx = NULL;
+        gnrc_pktbuf_release(pkt);
+    }
+    return res;
+}
+
+static void _relend(gnrc_netif_t *netif, netdev_rx_buf_t *buf,
+                    gnrc_pktsnip_t *pkt)
+{
+    if (_lend(netif, buf, pkt) < 0) {
+        /* the device is left with one receive buffer less */
+        netif->rx_bufs_numof--;
+        LOG_WARNING("gnrc_netif_rx_zerocopy: %u: receive buffer lost, "
+                    "%u left\n", netif->pid, netif->rx_bufs_numof);
+    }
+}
+
+unsigned gnrc_netif_rx_zerocopy_init(gnrc_netif_t *netif, size_t size)
+{
+    unsigned i;
+
+    if (!netdev_rx_zerocopy(netif->dev)) {
+        return 0;
+    }
+    /* the device may need room beyond the frame, e.g. for DMA alignment */
+    size = netdev_rx_buf_size(netif->dev, size);
+    for (i = 0; i < CONFIG_GNRC_NETIF_RX_ZEROCOPY_NUMOF; i++) {
+        gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL, size,
+                                              GNRC_NETTYPE_UNDEF);
+
+        if (pkt == NULL) {
+            DEBUG("gnrc_netif_rx_zerocopy: cannot allocate receive buffer\n");
+            break;
+        }
+        if (_lend(netif, &netif->rx_bufs[i], pkt) < 0) {
+            break;
+        }
+    }
+    DEBUG("gnrc_netif_rx_zerocopy: lent %u buffers to device\n", i);
+    if (i == 0) {
+        LOG_ERROR("gnrc_netif_rx_zerocopy: %u: no receive buffer lent\n",
+                  netif->pid);
+    }
+    netif->rx_bufs_numof = i;
+    return i;
+}
+
+gnrc_pktsnip_t *gnrc_netif_rx_zerocopy_recv(gnrc_netif_t *netif, void *info)
+{
+    netdev_t *dev = netif->dev;
+    netdev_rx_buf_t *buf = NULL;
+    gnrc_pktsnip_t *pkt, *fresh;
+    int nread;
+
+    assert(netdev_rx_zerocopy(dev));
+    nread = dev->driver->recv_zc(dev, &buf, info);
+    if (buf == NULL) {
+        return NULL;
+    }
+    pkt = buf->ctx;
+    assert(pkt != NULL);
+    if (nread <= 0) {
+        DEBUG("gnrc_netif_rx_zerocopy: read error\n");
+        /* hand the same buffer back to the device */
+        _relend(netif, buf, pkt);
+        return NULL;
+    }
+    fresh = gnrc_pktbuf_add(NULL, NULL, buf->size, GNRC_NETTYPE_UNDEF);
+    if (fresh == NULL) {
+        DEBUG("gnrc_netif_rx_zerocopy: no space left, dropping frame\n");
+        _relend(netif, buf, pkt);
+        return NULL;
+    }
+    _relend(netif, buf, fresh);
+    if ((size_t)nread < pkt->size) {
+        gnrc_pktbuf_realloc_data(pkt, nread);
+    }
+    return pkt;
+}
+
+/** @} */
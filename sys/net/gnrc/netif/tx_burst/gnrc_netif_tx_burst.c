@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2020 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <assert.h>
+
+#include "net/gnrc/netif/tx_burst.h"
+#include "net/gnrc/pktbuf.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+void gnrc_netif_tx_burst_init(gnrc_netif_tx_burst_t *burst, kernel_pid_t pid)
+{
+    burst->numof = 0;
+    burst->pid = pid;
+    burst->msg.type = GNRC_NETIF_TX_BURST_MSG_TYPE_FLUSH;
+    burst->msg.content.ptr = burst;
+}
+
+int gnrc_netif_tx_burst_send(gnrc_netif_tx_burst_t *burst, netdev_t *dev,
+                             gnrc_pktsnip_t *pkt, size_t hdr_len, bool more)
+{
+    unsigned idx = burst->numof++;
+
+    assert(idx < CONFIG_GNRC_NETIF_TX_BURST_NUMOF);
+    assert(hdr_len <= GNRC_NETIF_TX_BURST_HDR_LEN);
+    burst->pkts[idx] = pkt;
+    burst->frames[idx].iol_next = (iolist_t *)pkt->next;
+    burst->frames[idx].iol_base = burst->hdrs[idx];
+    burst->frames[idx].iol_len = hdr_len;
+
+    if (more && (burst->numof < CONFIG_GNRC_NETIF_TX_BURST_NUMOF)) {
+        if (idx == 0) {
+            xtimer_set_msg(&burst->timer, CONFIG_GNRC_NETIF_TX_BURST_TIMEOUT_US,
+                           &burst->msg, burst->pid);
+        }
+        DEBUG("gnrc_netif_tx_burst: staged frame %u\n", idx);
+        return 0;
+    }
+    return gnrc_netif_tx_burst_flush(burst, dev);
+}
+
+int gnrc_netif_tx_burst_flush(gnrc_netif_tx_burst_t *burst, netdev_t *dev)
+{
+    const iolist_t *frames[CONFIG_GNRC_NETIF_TX_BURST_NUMOF];
+    unsigned numof = burst->numof;
+    int res;
+
+    if (numof == 0) {
+        return 0;
+    }
+    xtimer_remove(&burst->timer);
+    for (unsigned i = 0; i < numof; i++) {
+        frames[i] = &burst->frames[i];
+    }
+    res = netdev_send_burst(dev, frames, numof);
+    DEBUG("gnrc_netif_tx_burst: device accepted %d of %u frames\n", res, numof);
+    if (res > 0) {
+        size_t bytes = 0;
+
+        for (int i = 0; i < res; i++) {
+            bytes += iolist_size(frames[i]);
+        }
+        res = (int)bytes;
+    }
+    /* release old data */
+    for (unsigned i = 0; i < numof; i++) {
+        gnrc_pktbuf_release(burst->pkts[i]);
+    }
+    burst->numof = 0;
+    return res;
+}
+/** @} */
@@ -28,13 +28,45 @@
 
 #define _INVALID_TYPE(type) (((type) < GNRC_NETTYPE_UNDEF) || ((type) >= GNRC_NETTYPE_NUMOF))
 
-/* The registry as lookup table by gnrc_nettype_t */
-static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF];
+#ifdef MODULE_GNRC_NETREG_HASH
+#define _BUCKETS            CONFIG_GNRC_NETREG_HASH_BUCKETS
+#else
+#define _BUCKETS            (1U)
+#endif
+
+/* The registry as lookup table by gnrc_nettype_t and demux_ctx hash */
+static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF][_BUCKETS];
+
+#ifdef MODULE_GNRC_NETREG_STATS
+static gnrc_netreg_stats_t _stats;
+#endif
+
+static inline gnrc_netreg_entry_t **_bucket(gnrc_nettype_t type,
+                                            uint32_t demux_ctx)
+{
+#ifdef MODULE_GNRC_NETREG_HASH
+    /* fold the demux context so ports, protocol numbers and
+     * GNRC_NETREG_DEMUX_CTX_ALL all spread over the buckets */
+    demux_ctx ^= (demux_ctx >> 16);
+    demux_ctx ^= (demux_ctx >> 8);
+    return &netreg[type][demux_ctx & (_BUCKETS - 1)];
+#else
+    (void)demux_ctx;
+    return &netreg[type][0];
+#endif
+}
 
 void gnrc_netreg_init(void)
 {
+#ifdef MODULE_GNRC_NETREG_HASH
+    static_assert((_BUCKETS & (_BUCKETS - 1)) == 0,
+                  "CONFIG_GNRC_NETREG_HASH_BUCKETS must be a power of 2");
+#endif
     /* set all pointers in registry to NULL */
-    memset(netreg, 0, GNRC_NETTYPE_NUMOF * sizeof(gnrc_netreg_entry_t *));
+    memset(netreg, 0, sizeof(netreg));
+#ifdef MODULE_GNRC_NETREG_STATS
+    memset(&_stats, 0, sizeof(_stats));
+#endif
 }
 
 int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
@@ -59,7 +91,7 @@ int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return -EINVAL;
     }
 
-    LL_PREPEND(netreg[type], entry);
+    LL_PREPEND(*_bucket(type, entry->demux_ctx), entry);
 
     return 0;
 }
@@ -70,7 +102,7 @@ void gnrc_netreg_unregister(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return;
     }
 
-    LL_DELETE(netreg[type], entry);
+    LL_DELETE(*_bucket(type, entry->demux_ctx), entry);
 }
 
 /**
@@ -92,8 +124,20 @@ static gnrc_netreg_entry_t *_netreg_lookup(gnrc_netreg_entry_t *from,
     gnrc_netreg_entry_t *res = NULL;
 
     if (from || !_INVALID_TYPE(type)) {
-        gnrc_netreg_entry_t *head = (from) ? from->next : netreg[type];
-        LL_SEARCH_SCALAR(head, res, demux_ctx, demux_ctx);
+        /* entries with equal demux_ctx are always in the same bucket, so
+         * continuing from `from` stays within the matching bucket */
+        res = (from) ? from->next : *_bucket(type, demux_ctx);
+#ifdef MODULE_GNRC_NETREG_STATS
+        _stats.lookups++;
+#endif
+        for (; res != NULL; res = res->next) {
+#ifdef MODULE_GNRC_NETREG_STATS
+            _stats.visited++;
+#endif
+            if (res->demux_ctx == demux_ctx) {
+                break;
+            }
+        }
     }
 
     return res;
@@ -147,4 +191,16 @@ int gnrc_netreg_calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr)
     }
 }
 
+#ifdef MODULE_GNRC_NETREG_STATS
+void gnrc_netreg_get_stats(gnrc_netreg_stats_t *stats)
+{
+    *stats = _stats;
+}
+
+void gnrc_netreg_reset_stats(void)
+{
+    memset(&_stats, 0, sizeof(_stats));
+}
+#endif
+
 /** @} */
@@ -16,6 +16,10 @@
 #include "net/gnrc/icmpv6.h"
 #include "net/gnrc/netif.h"
 #include "net/gnrc/pktbuf.h"
+#if IS_USED(MODULE_GNRC_ICMPV6_ERROR_RATE_LIMIT)
+#include "mutex.h"
+#include "xtimer.h"
+#endif
 
 #include "net/gnrc/icmpv6/error.h"
 
@@ -30,6 +34,91 @@
 #undef MIN
 #define MIN(a, b)   ((a) < (b)) ? (a) : (b)
 
+#if IS_USED(MODULE_GNRC_ICMPV6_ERROR_RATE_LIMIT)
+#define RATE_LIMIT_INTERVAL_US  (CONFIG_GNRC_ICMPV6_ERROR_RATE_LIMIT_INTERVAL_MS * \
+                                 US_PER_MS)
+
+/**
+ * @brief   Token bucket for an (error type, destination) pair
+ */
+typedef struct {
+    ipv6_addr_t dst;    /**< destination of the error messages */
+    uint32_t last;      /**< time of the last refill in microseconds */
+    uint8_t type;       /**< ICMPv6 type, 0 if the bucket is unused */
+    uint8_t tokens;     /**< error messages that may still be sent */
+} _bucket_t;
+
+/* errors are sent from several threads, so guard the buckets */
+static mutex_t _mutex = MUTEX_INIT;
+static _bucket_t _buckets[CONFIG_GNRC_ICMPV6_ERROR_RATE_LIMIT_NUMOF];
+static gnrc_icmpv6_error_stats_t _stats;
+
+gnrc_icmpv6_error_stats_t *gnrc_icmpv6_error_stats_get(void)
+{
+    return &_stats;
+}
+
+static _bucket_t *_get_bucket(uint8_t type, const ipv6_addr_t *dst,
+                              uint32_t now)
+{
+    _bucket_t *oldest = NULL;
+
+    for (unsigned i = 0; i < CONFIG_GNRC_ICMPV6_ERROR_RATE_LIMIT_NUMOF; i++) {
+        _bucket_t *bucket = &_buckets[i];
+
+        if (bucket->type == 0) {
+            if ((oldest == NULL) || (oldest->type != 0)) {
+                oldest = bucket;
+            }
+        }
+        else if ((bucket->type == type) &&
+                 ipv6_addr_equal(&bucket->dst, dst)) {
+            uint32_t refill = (now - bucket->last) / RATE_LIMIT_INTERVAL_US;
+
+            if ((bucket->tokens + refill) >= CONFIG_GNRC_ICMPV6_ERROR_RATE_LIMIT_BURST) {
+                bucket->tokens = CONFIG_GNRC_ICMPV6_ERROR_RATE_LIMIT_BURST;
+                bucket->last = now;
+            }
+            else if (refill > 0) {
+                bucket->tokens += refill;
+                bucket->last += refill * RATE_LIMIT_INTERVAL_US;
+            }
+            return bucket;
+        }
+        else if ((oldest == NULL) ||
+                 ((oldest->type != 0) &&
+                  ((now - bucket->last) > (now - oldest->last)))) {
+            oldest = bucket;
+        }
+    }
+    /* replace least recently used bucket */
+    memcpy(&oldest->dst, dst, sizeof(oldest->dst));
+    oldest->type = type;
+    oldest->tokens = CONFIG_GNRC_ICMPV6_ERROR_RATE_LIMIT_BURST;
+    oldest->last = now;
+    return oldest;
+}
+
+static bool _rate_limited(uint8_t type, const ipv6_addr_t *dst)
+{
+    _bucket_t *bucket;
+    bool res = false;
+
+    mutex_lock(&_mutex);
+    bucket = _get_bucket(type, dst, xtimer_now_usec());
+    if (bucket->tokens > 0) {
+        bucket->tokens--;
+        _stats.sent++;
+    }
+    else {
+        _stats.suppressed[type - 1]++;
+        res = true;
+    }
+    mutex_unlock(&_mutex);
+    return res;
+}
+#endif
+
 /**
  * @brief   Get packet fit.
  *
@@ -259,6 +348,15 @@ static gnrc_pktsnip_t *_check_ipv6_hdr(const gnrc_pktsnip_t *orig_pkt,
             ipv6 = NULL;
         }
     }
+#if IS_USED(MODULE_GNRC_ICMPV6_ERROR_RATE_LIMIT)
+    /* see https://tools.ietf.org/html/rfc4443#section-2.4 (f); check before
+     * building the message so suppressed ones do not take up any packet
+     * buffer space */
+    if ((ipv6 != NULL) && _rate_limited(type, &ipv6_hdr->src)) {
+        DEBUG("gnrc_icmpv6_error: rate limit for type %u exceeded\n", type);
+        ipv6 = NULL;
+    }
+#endif
     return ipv6;
 }
 
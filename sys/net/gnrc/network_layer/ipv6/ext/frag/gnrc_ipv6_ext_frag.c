@@ -15,8 +15,10 @@
 
 #include <assert.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include "byteorder.h"
+#include "metrics.h"
 #include "net/ipv6/ext/frag.h"
 #include "net/ipv6/addr.h"
 #include "net/ipv6/hdr.h"
@@ -36,12 +38,23 @@
 
 static gnrc_ipv6_ext_frag_send_t _snd_bufs[CONFIG_GNRC_IPV6_EXT_FRAG_SEND_SIZE];
 static gnrc_ipv6_ext_frag_rbuf_t _rbuf[CONFIG_GNRC_IPV6_EXT_FRAG_RBUF_SIZE];
-static gnrc_ipv6_ext_frag_limits_t _limits_pool[CONFIG_GNRC_IPV6_EXT_FRAG_LIMITS_POOL_SIZE];
-static clist_node_t _free_limits;
 static xtimer_t _gc_xtimer;
 static msg_t _gc_msg = { .type = GNRC_IPV6_EXT_FRAG_RBUF_GC };
 static gnrc_ipv6_ext_frag_stats_t _stats;
 
+#if IS_USED(MODULE_GNRC_IPV6_EXT_FRAG_STATS) && IS_USED(MODULE_METRICS)
+static const metrics_entry_t _metrics_entries[] = {
+    METRICS_ENTRY(METRICS_UINT, "rbuf_full", _stats, rbuf_full),
+    METRICS_ENTRY(METRICS_UINT, "rbuf_budget", _stats, rbuf_budget),
+    METRICS_ENTRY(METRICS_UINT, "frag_full", _stats, frag_full),
+    METRICS_ENTRY(METRICS_UINT, "datagrams", _stats, datagrams),
+    METRICS_ENTRY(METRICS_UINT, "fragments", _stats, fragments),
+};
+
+metrics_group_t gnrc_ipv6_ext_frag_metrics = METRICS_GROUP("ipv6_frag", _stats,
+                                                           _metrics_entries);
+#endif
+
 /**
  * @todo    Implement better mechanism as described in
  *          https://tools.ietf.org/html/rfc7739 (for minimal approach
@@ -50,10 +63,10 @@ static gnrc_ipv6_ext_frag_stats_t _stats;
 static uint32_t _last_id;
 
 typedef enum {
-    FRAG_LIMITS_NEW = 0,        /**< limits are not present and do not overlap */
-    FRAG_LIMITS_DUPLICATE,      /**< fragment limits are already present */
-    FRAG_LIMITS_OVERLAP,        /**< limits overlap */
-    FRAG_LIMITS_FULL,           /**< no free gnrc_ipv6_ext_frag_limits_t object */
+    FRAG_LIMITS_NEW = 0,        /**< fragment was not received and does not
+                                 *   overlap */
+    FRAG_LIMITS_DUPLICATE,      /**< fragment was already received */
+    FRAG_LIMITS_OVERLAP,        /**< fragment overlaps received fragments */
 } _limits_res_t;
 
 void gnrc_ipv6_ext_frag_init(void)
@@ -62,9 +75,6 @@ void gnrc_ipv6_ext_frag_init(void)
     memset(_rbuf, 0, sizeof(_rbuf));
 #endif
     _last_id = random_uint32();
-    for (unsigned i = 0; i < CONFIG_GNRC_IPV6_EXT_FRAG_LIMITS_POOL_SIZE; i++) {
-        clist_rpush(&_free_limits, (clist_node_t *)&_limits_pool[i]);
-    }
 }
 
 /*
@@ -364,10 +374,10 @@ static inline void _init_rbuf(gnrc_ipv6_ext_frag_rbuf_t *rbuf, ipv6_hdr_t *ipv6,
                               uint32_t id);
 
 /**
- * @brief   Checks if given fragment limits overlap with fragment limits already
- *          in a given reassembly buffer entry
+ * @brief   Checks if a fragment overlaps with the fragments already in a given
+ *          reassembly buffer entry
  *
- * If no overlap exists the new limits are added to @p rbuf.
+ * If no overlap exists the fragment is marked as received in @p rbuf.
  *
  * @param[in, out] rbuf A reassembly buffer entry.
  * @param[in] offset    A fragment offset.
@@ -378,6 +388,20 @@ static inline void _init_rbuf(gnrc_ipv6_ext_frag_rbuf_t *rbuf, ipv6_hdr_t *ipv6,
 static _limits_res_t _overlaps(gnrc_ipv6_ext_frag_rbuf_t *rbuf,
                                unsigned offset, unsigned pkt_len);
 
+/**
+ * @brief   Makes sure the reassembly buffer entries stay within
+ *          @ref CONFIG_GNRC_IPV6_EXT_FRAG_RBUF_BUDGET when @p rbuf grows
+ *
+ * Drops other entries with fewer received bytes than @p rbuf if needed.
+ *
+ * @param[in] rbuf  A reassembly buffer entry.
+ * @param[in] size  The new size of gnrc_ipv6_ext_frag_rbuf_t::pkt of @p rbuf.
+ *
+ * @return  true, if @p rbuf may grow to @p size.
+ * @return  false, if @p rbuf is to be dropped instead.
+ */
+static bool _reserve(gnrc_ipv6_ext_frag_rbuf_t *rbuf, size_t size);
+
 /**
  * @brief   Sets the next header field of a header.
  *
@@ -405,6 +429,7 @@ gnrc_pktsnip_t *gnrc_ipv6_ext_frag_reass(gnrc_pktsnip_t *pkt)
     ipv6_hdr_t *ipv6;
     ipv6_ext_frag_t *fh;
     unsigned offset;
+    size_t size_until;
     uint8_t nh;
 
     fh_snip = gnrc_pktbuf_mark(pkt, sizeof(ipv6_ext_frag_t),
@@ -428,6 +453,42 @@ gnrc_pktsnip_t *gnrc_ipv6_ext_frag_reass(gnrc_pktsnip_t *pkt)
                    sched_active_pid);
     nh = fh->nh;
     offset = ipv6_ext_frag_get_offset(fh);
+    size_until = offset + pkt->size;
+    if ((offset == 0) && !ipv6_ext_frag_more(fh)) {
+        /* first fragment but actually not fragmented */
+        _set_nh(fh_snip->next, nh);
+        gnrc_pktbuf_remove_snip(pkt, fh_snip);
+        gnrc_ipv6_ext_frag_rbuf_del(rbuf);
+        ipv6->len = byteorder_htons(byteorder_ntohs(ipv6->len) -
+                                    sizeof(ipv6_ext_frag_t));
+        if (IS_USED(MODULE_GNRC_IPV6_EXT_FRAG_STATS)) {
+            _stats.fragments++;
+            _stats.datagrams++;
+        }
+        return pkt;
+    }
+    if (size_until > CONFIG_GNRC_IPV6_EXT_FRAG_RBUF_MAX_LEN) {
+        DEBUG("ipv6_ext_frag: datagram exceeds reassembly buffer length\n");
+        goto error_exit;
+    }
+    if (ipv6_ext_frag_more(fh)) {
+        /* not divisible by 8 or beyond the last fragment */
+        if ((pkt->size & 0x7) || (rbuf->last && (size_until > rbuf->total))) {
+            DEBUG("ipv6_ext_frag: invalid fragment length\n");
+            goto error_exit;
+        }
+    }
+    else if (rbuf->last ? (size_until != rbuf->total)
+                        : (rbuf->pkt && (rbuf->pkt->size > size_until))) {
+        /* another last fragment or data received beyond the end */
+        DEBUG("ipv6_ext_frag: inconsistent last fragment\n");
+        goto error_exit;
+    }
+    else if (rbuf->last && (pkt->size == 0)) {
+        /* duplicate of an empty last fragment, it does not cover any unit */
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
     switch (_overlaps(rbuf, offset, pkt->size)) {
         case FRAG_LIMITS_NEW:
             break;
@@ -435,28 +496,25 @@ gnrc_pktsnip_t *gnrc_ipv6_ext_frag_reass(gnrc_pktsnip_t *pkt)
             gnrc_pktbuf_release(pkt);
             return NULL;
         case FRAG_LIMITS_OVERLAP:
-            DEBUG("ipv6_ext_frag: fragment overlaps with existing fragments\n");
-            /* intentionally falls through */
-        case FRAG_LIMITS_FULL:
         default:
-            DEBUG("ipv6_ext_frag: can't store fragment limits\n");
+            DEBUG("ipv6_ext_frag: fragment overlaps with existing fragments\n");
             goto error_exit;
     }
     if (offset > 0) {
-        size_t size_until = offset + pkt->size;
-
         /* use IPv6 header in reassembly buffer from here on */
         ipv6 = rbuf->ipv6;
         /* subsequent fragment */
         if (!ipv6_ext_frag_more(fh)) {
             /* last fragment; add to rbuf->pkt_len */
             rbuf->last++;
+            rbuf->total = size_until;
             rbuf->pkt_len += size_until;
         }
-        /* not divisible by 8 */
-        else if ((pkt->size & 0x7)) {
-            DEBUG("ipv6_ext_frag: fragment length not divisible by 8");
-            goto error_exit;
+        if ((rbuf->pkt == NULL) || (rbuf->pkt->size < size_until)) {
+            if (!_reserve(rbuf, size_until)) {
+                DEBUG("ipv6_ext_frag: reassembly buffer budget exceeded\n");
+                goto error_exit;
+            }
         }
         if (rbuf->pkt == NULL) {
             /* entry did not exist yet */
@@ -492,26 +550,13 @@ gnrc_pktsnip_t *gnrc_ipv6_ext_frag_reass(gnrc_pktsnip_t *pkt)
         }
         return _completed(rbuf);
     }
-    else if (!ipv6_ext_frag_more(fh)) {
-        /* first fragment but actually not fragmented */
-        _set_nh(fh_snip->next, nh);
-        gnrc_pktbuf_remove_snip(pkt, fh_snip);
-        gnrc_ipv6_ext_frag_rbuf_del(rbuf);
-        ipv6->len = byteorder_htons(byteorder_ntohs(ipv6->len) -
-                                    sizeof(ipv6_ext_frag_t));
-        if (IS_USED(MODULE_GNRC_IPV6_EXT_FRAG_STATS)) {
-            _stats.fragments++;
-            _stats.datagrams++;
-        }
-        return pkt;
-    }
     else {
         /* first fragment */
         uint16_t ipv6_len = byteorder_ntohs(ipv6->len);
 
-        /* not divisible by 8*/
-        if ((pkt->size & 0x7)) {
-            DEBUG("ipv6_ext_frag: fragment length not divisible by 8");
+        rbuf->first++;
+        if ((rbuf->pkt == NULL) && !_reserve(rbuf, pkt->size)) {
+            DEBUG("ipv6_ext_frag: reassembly buffer budget exceeded\n");
             goto error_exit;
         }
         _set_nh(fh_snip->next, nh);
@@ -522,6 +567,8 @@ gnrc_pktsnip_t *gnrc_ipv6_ext_frag_reass(gnrc_pktsnip_t *pkt)
         if (rbuf->pkt != NULL) {
             /* first fragment but not first arriving */
             memcpy(rbuf->pkt->data, pkt->data, pkt->size);
+            /* headers kept from the first arriving fragment are replaced */
+            gnrc_pktbuf_release(rbuf->pkt->next);
             rbuf->pkt->next = pkt->next;
             rbuf->pkt->type = pkt->type;
             /* payload was copied to reassembly buffer so remove it */
@@ -542,10 +589,40 @@ error_release:
     return NULL;
 }
 
+/**
+ * @brief   Finds the reassembly buffer entry with the fewest received bytes
+ *
+ * @param[in] skip  An entry not to consider, may be NULL.
+ *
+ * @return  The entry with the fewest received bytes, the one with the oldest
+ *          gnrc_ipv6_ext_frag_rbuf_t::arrival of those.
+ * @return  NULL, if there is no entry in use but @p skip.
+ */
+static gnrc_ipv6_ext_frag_rbuf_t *_least_complete(
+                                        const gnrc_ipv6_ext_frag_rbuf_t *skip)
+{
+    gnrc_ipv6_ext_frag_rbuf_t *res = NULL;
+
+    for (unsigned i = 0; i < CONFIG_GNRC_IPV6_EXT_FRAG_RBUF_SIZE; i++) {
+        gnrc_ipv6_ext_frag_rbuf_t *tmp = &_rbuf[i];
+
+        if ((tmp == skip) || (tmp->ipv6 == NULL)) {
+            continue;
+        }
+        if ((res == NULL) || (tmp->received < res->received) ||
+            ((tmp->received == res->received) &&
+             /* xtimer_now_usec() overflows every ~1.2 hours */
+             ((res->arrival - tmp->arrival) < (UINT32_MAX / 2)))) {
+            res = tmp;
+        }
+    }
+    return res;
+}
+
 gnrc_ipv6_ext_frag_rbuf_t *gnrc_ipv6_ext_frag_rbuf_get(ipv6_hdr_t *ipv6,
                                                        uint32_t id)
 {
-    gnrc_ipv6_ext_frag_rbuf_t *res = NULL, *oldest = NULL;
+    gnrc_ipv6_ext_frag_rbuf_t *res = NULL;
     for (unsigned i = 0; i < CONFIG_GNRC_IPV6_EXT_FRAG_RBUF_SIZE; i++) {
         gnrc_ipv6_ext_frag_rbuf_t *tmp = &_rbuf[i];
         if (tmp->ipv6 != NULL) {
@@ -557,27 +634,23 @@ gnrc_ipv6_ext_frag_rbuf_t *gnrc_ipv6_ext_frag_rbuf_get(ipv6_hdr_t *ipv6,
         }
         else if (res == NULL) {
             res = tmp;
-            _init_rbuf(res, ipv6, id);
-        }
-        if ((oldest == NULL) ||
-            /* xtimer_now_usec() overflows every ~1.2 hours */
-            ((tmp->arrival - oldest->arrival) < (UINT32_MAX / 2))) {
-            oldest = tmp;
         }
     }
-    if ((res == NULL) &&
-        !IS_ACTIVE(CONFIG_GNRC_IPV6_EXT_FRAG_RBUF_DO_NOT_OVERRIDE)) {
-        assert(oldest != NULL); /* reassembly buffer is full, so there needs
-                                 * to be an oldest entry */
-        DEBUG("ipv6_ext_frag: dropping oldest entry\n");
+    if (res != NULL) {
+        _init_rbuf(res, ipv6, id);
+    }
+    else if (!IS_ACTIVE(CONFIG_GNRC_IPV6_EXT_FRAG_RBUF_DO_NOT_OVERRIDE)) {
+        /* reassembly buffer is full, so there needs to be an entry */
+        res = _least_complete(NULL);
+        assert(res != NULL);
+        DEBUG("ipv6_ext_frag: dropping least complete entry\n");
         if (IS_USED(MODULE_GNRC_IPV6_EXT_FRAG_STATS)) {
             _stats.rbuf_full++;
         }
-        gnrc_ipv6_ext_frag_rbuf_del(oldest);
-        res = oldest;
+        gnrc_ipv6_ext_frag_rbuf_del(res);
         _init_rbuf(res, ipv6, id);
     }
-    else if (IS_USED(MODULE_GNRC_IPV6_EXT_FRAG_STATS) && (res == NULL)) {
+    else if (IS_USED(MODULE_GNRC_IPV6_EXT_FRAG_STATS)) {
         _stats.rbuf_full++;
     }
     return res;
@@ -586,10 +659,8 @@ gnrc_ipv6_ext_frag_rbuf_t *gnrc_ipv6_ext_frag_rbuf_get(ipv6_hdr_t *ipv6,
 void gnrc_ipv6_ext_frag_rbuf_free(gnrc_ipv6_ext_frag_rbuf_t *rbuf)
 {
     rbuf->ipv6 = NULL;
-    while (rbuf->limits.next != NULL) {
-        clist_node_t *tmp = clist_lpop(&rbuf->limits);
-        clist_rpush(&_free_limits, tmp);
-    }
+    rbuf->received = 0;
+    memset(rbuf->received_map, 0, sizeof(rbuf->received_map));
 }
 
 void gnrc_ipv6_ext_frag_rbuf_gc(void)
@@ -608,68 +679,73 @@ gnrc_ipv6_ext_frag_stats_t *gnrc_ipv6_ext_frag_stats(void)
     return (IS_USED(MODULE_GNRC_IPV6_EXT_FRAG_STATS)) ? &_stats : NULL;
 }
 
-typedef struct {
-    uint16_t start;
-    uint16_t end;
-} _check_limits_t;
-
 static inline void _init_rbuf(gnrc_ipv6_ext_frag_rbuf_t *rbuf, ipv6_hdr_t *ipv6,
                               uint32_t id)
 {
     rbuf->ipv6 = ipv6;
     rbuf->id = id;
     rbuf->pkt_len = 0;
+    rbuf->received = 0;
+    rbuf->total = 0;
     rbuf->last = 0;
-}
-
-static int _check_overlap(clist_node_t *node, void *arg)
-{
-    _check_limits_t *limits = arg;
-    gnrc_ipv6_ext_frag_limits_t *cur = (gnrc_ipv6_ext_frag_limits_t *)node;
-
-    return ((cur->start < limits->end) && (limits->start < cur->end));
-}
-
-static int _limits_cmp(clist_node_t *a, clist_node_t *b)
-{
-    gnrc_ipv6_ext_frag_limits_t *al = (gnrc_ipv6_ext_frag_limits_t *)a;
-    gnrc_ipv6_ext_frag_limits_t *bl = (gnrc_ipv6_ext_frag_limits_t *)b;
-
-    return (int)al->start - (int)bl->start;
+    rbuf->first = 0;
+    rbuf->fragments = 0;
+    memset(rbuf->received_map, 0, sizeof(rbuf->received_map));
 }
 
 static _limits_res_t _overlaps(gnrc_ipv6_ext_frag_rbuf_t *rbuf,
                                unsigned offset, unsigned pkt_len)
 {
-    _check_limits_t limits = { .start = offset >> 3U,
-                               .end = (offset + pkt_len) >> 3U };
-    gnrc_ipv6_ext_frag_limits_t *res;
-
-    if (limits.start == limits.end) {
-        /* might happen with last fragment */
-        limits.end++;
-    }
-    res = (gnrc_ipv6_ext_frag_limits_t *)clist_foreach(&rbuf->limits,
-                                                       _check_overlap,
-                                                       &limits);
-    if (res == NULL) {
-        res = (gnrc_ipv6_ext_frag_limits_t *)clist_lpop(&_free_limits);
-        if (res != NULL) {
-            res->start = limits.start;
-            res->end = limits.end;
-            clist_rpush(&rbuf->limits, (clist_node_t *)res);
-            clist_sort(&rbuf->limits, _limits_cmp);
-            return FRAG_LIMITS_NEW;
+    /* all but the last fragment are multiples of 8 bytes, so units are
+     * either fully received or not at all */
+    unsigned start = offset >> 3U;
+    unsigned end = (offset + pkt_len + 7U) >> 3U;
+    unsigned set = 0;
+
+    assert(end <= GNRC_IPV6_EXT_FRAG_RBUF_UNITS);
+    for (unsigned i = start; i < end; i++) {
+        if (bf_isset(rbuf->received_map, i)) {
+            set++;
         }
-        else {
-            return FRAG_LIMITS_FULL;
+    }
+    if (set == 0) {
+        for (unsigned i = start; i < end; i++) {
+            bf_set(rbuf->received_map, i);
         }
+        rbuf->received += pkt_len;
+        rbuf->fragments++;
+        return FRAG_LIMITS_NEW;
     }
-    else if ((res->start == limits.start) && (res->end == limits.end)) {
-        return FRAG_LIMITS_DUPLICATE;
+    return (set == (end - start)) ? FRAG_LIMITS_DUPLICATE : FRAG_LIMITS_OVERLAP;
+}
+
+static bool _reserve(gnrc_ipv6_ext_frag_rbuf_t *rbuf, size_t size)
+{
+    if (size > CONFIG_GNRC_IPV6_EXT_FRAG_RBUF_BUDGET) {
+        return false;
     }
-    else {
-        return FRAG_LIMITS_NEW;
+    while (1) {
+        gnrc_ipv6_ext_frag_rbuf_t *victim;
+        size_t used = size;
+
+        for (unsigned i = 0; i < CONFIG_GNRC_IPV6_EXT_FRAG_RBUF_SIZE; i++) {
+            if ((&_rbuf[i] != rbuf) && (_rbuf[i].pkt != NULL)) {
+                used += _rbuf[i].pkt->size;
+            }
+        }
+        if (used <= CONFIG_GNRC_IPV6_EXT_FRAG_RBUF_BUDGET) {
+            return true;
+        }
+        if (IS_USED(MODULE_GNRC_IPV6_EXT_FRAG_STATS)) {
+            _stats.rbuf_budget++;
+        }
+        /* favor the datagram closer to completion */
+        victim = _least_complete(rbuf);
+        if ((victim == NULL) || (victim->received >= rbuf->received)) {
+            return false;
+        }
+        DEBUG("ipv6_ext_frag: dropping less complete datagram\n");
+        gnrc_ipv6_ext_frag_rbuf_del(victim);
     }
 }
 
@@ -695,30 +771,18 @@ static inline void _set_nh(gnrc_pktsnip_t *hdr_snip, uint8_t nh)
 
 static gnrc_pktsnip_t *_completed(gnrc_ipv6_ext_frag_rbuf_t *rbuf)
 {
-    assert(rbuf->limits.next != NULL);    /* this function is only called when
-                                           * at least one fragment was already
-                                           * added */
-    /* clist: first element is second element ;-) (from next of head) */
-    gnrc_ipv6_ext_frag_limits_t *ptr =
-            (gnrc_ipv6_ext_frag_limits_t *)rbuf->limits.next->next;
-    if (rbuf->last && (ptr->start == 0)) {
-        gnrc_pktsnip_t *res = NULL;
-
-        /* last and first fragment were received, so check if everything
-         * in-between is there */
-        do {
-            gnrc_ipv6_ext_frag_limits_t *next = ptr->next;
-            if (ptr->end < next->start) {
-                return NULL;
-            }
-            ptr = next;
-        } while (((clist_node_t *)ptr) != rbuf->limits.next);
-        res = rbuf->pkt;
+    assert(rbuf->fragments > 0);    /* this function is only called when at
+                                     * least one fragment was already added */
+    /* fragments never overlap, so all bytes are there once their count adds
+     * up to the length of the last fragment's end */
+    if (rbuf->first && rbuf->last && (rbuf->received == rbuf->total)) {
+        gnrc_pktsnip_t *res = rbuf->pkt;
+
         /* rewrite length */
         rbuf->ipv6->len = byteorder_htons(rbuf->pkt_len);
         rbuf->pkt = NULL;
         if (IS_USED(MODULE_GNRC_IPV6_EXT_FRAG_STATS)) {
-            _stats.fragments += clist_count(&rbuf->limits);
+            _stats.fragments += rbuf->fragments;
             _stats.datagrams++;
         }
         gnrc_ipv6_ext_frag_rbuf_free(rbuf);
@@ -18,6 +18,9 @@
 #include "net/ipv6/ext/opt.h"
 #include "net/gnrc/icmpv6/error.h"
 #include "net/gnrc/pktbuf.h"
+#ifdef MODULE_GNRC_MPL
+#include "net/gnrc/mpl.h"
+#endif
 
 #include "net/gnrc/ipv6/ext/opt.h"
 
@@ -87,6 +90,26 @@ gnrc_pktsnip_t *gnrc_ipv6_ext_opt_process(gnrc_pktsnip_t *pkt,
             case IPV6_EXT_OPT_PADN:
                 /* nothing to do, offset will be progressed below */
                 break;
+#ifdef MODULE_GNRC_MPL
+            case IPV6_EXT_OPT_MPL:
+                if (protnum != PROTNUM_IPV6_EXT_HOPOPT) {
+                    DEBUG("gnrc_ipv6_ext_opt: MPL option outside of "
+                          "hop-by-hop options header\n");
+                    goto error;
+                }
+                switch (gnrc_mpl_opt_process(pkt,
+                                             (mpl_opt_t *)&opts[offset - 2U])) {
+                    case 0:
+                        break;
+                    case -EALREADY:
+                        /* duplicate, silently drop */
+                        gnrc_pktbuf_release(pkt);
+                        return NULL;
+                    default:
+                        goto error;
+                }
+                break;
+#endif  /* MODULE_GNRC_MPL */
             default: {
                 bool send_error = false;
 
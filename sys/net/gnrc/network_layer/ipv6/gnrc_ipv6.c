@@ -32,10 +32,20 @@
 #include "net/gnrc/netif/internal.h"
 #include "net/gnrc/ipv6/whitelist.h"
 #include "net/gnrc/ipv6/blacklist.h"
+#include "net/gnrc/ipv6/route_cache.h"
 
 #ifdef MODULE_GNRC_IPV6_EXT_FRAG
 #include "net/gnrc/ipv6/ext/frag.h"
 #endif
+#ifdef MODULE_GNRC_MPL
+#include "net/gnrc/mpl.h"
+#endif
+#if IS_USED(MODULE_GNRC_SINGLE_THREAD) && IS_USED(MODULE_GNRC_SIXLOWPAN)
+#include "net/gnrc/sixlowpan.h"
+#endif
+#ifdef MODULE_GNRC_UDP_FASTPATH
+#include "net/gnrc/udp.h"
+#endif
 
 #include "net/gnrc/ipv6.h"
 
@@ -50,6 +60,14 @@ static char _stack[GNRC_IPV6_STACK_SIZE + THREAD_EXTRA_STACKSIZE_PRINTF];
 static char _stack[GNRC_IPV6_STACK_SIZE];
 #endif
 
+#if IS_USED(MODULE_GNRC_IPV6_FWD_THREAD)
+#if ENABLE_DEBUG
+static char _fwd_stack[GNRC_IPV6_FWD_STACK_SIZE + THREAD_EXTRA_STACKSIZE_PRINTF];
+#else
+static char _fwd_stack[GNRC_IPV6_FWD_STACK_SIZE];
+#endif
+#endif
+
 #ifdef MODULE_FIB
 #include "net/fib.h"
 #include "net/fib/table.h"
@@ -67,6 +85,9 @@ fib_table_t gnrc_ipv6_fib_table;
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 
 kernel_pid_t gnrc_ipv6_pid = KERNEL_PID_UNDEF;
+#if IS_USED(MODULE_GNRC_IPV6_FWD_THREAD)
+kernel_pid_t gnrc_ipv6_fwd_pid = KERNEL_PID_UNDEF;
+#endif
 
 /* handles GNRC_NETAPI_MSG_TYPE_RCV commands */
 static void _receive(gnrc_pktsnip_t *pkt);
@@ -80,6 +101,10 @@ static void _send_by_netif_hdr(gnrc_pktsnip_t *pkt);
 #endif  /* MODULE_GNRC_IPV6_EXT_FRAG */
 /* Main event loop for IPv6 */
 static void *_event_loop(void *args);
+#if IS_USED(MODULE_GNRC_IPV6_FWD_THREAD)
+/* Event loop for forwarded packets */
+static void *_fwd_event_loop(void *args);
+#endif
 
 kernel_pid_t gnrc_ipv6_init(void)
 {
@@ -88,6 +113,14 @@ kernel_pid_t gnrc_ipv6_init(void)
                                       THREAD_CREATE_STACKTEST,
                                       _event_loop, NULL, "ipv6");
     }
+#if IS_USED(MODULE_GNRC_IPV6_FWD_THREAD)
+    if (gnrc_ipv6_fwd_pid == KERNEL_PID_UNDEF) {
+        gnrc_ipv6_fwd_pid = thread_create(_fwd_stack, sizeof(_fwd_stack),
+                                          GNRC_IPV6_FWD_PRIO,
+                                          THREAD_CREATE_STACKTEST,
+                                          _fwd_event_loop, NULL, "ipv6_fwd");
+    }
+#endif
 
 #ifdef MODULE_FIB
     gnrc_ipv6_fib_table.data.entries = _fib_entries;
@@ -113,6 +146,12 @@ static inline bool _gnrc_ipv6_is_interested(unsigned nh) {
 static void _demux(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt, unsigned nh)
 {
     pkt->type = gnrc_nettype_from_protnum(nh);
+#ifdef MODULE_GNRC_UDP_FASTPATH
+    if ((nh == PROTNUM_UDP) && gnrc_udp_fastpath(pkt)) {
+        DEBUG("ipv6: UDP packet delivered on fast path\n");
+        return;
+    }
+#endif  /* MODULE_GNRC_UDP_FASTPATH */
     _dispatch_next_header(pkt, nh, _gnrc_ipv6_is_interested(nh));
     switch (nh) {
 #ifdef MODULE_GNRC_ICMPV6
@@ -195,6 +234,12 @@ static void *_event_loop(void *args)
         DEBUG("ipv6: waiting for incoming message.\n");
         msg_receive(&msg);
 
+#if IS_USED(MODULE_GNRC_SINGLE_THREAD) && IS_USED(MODULE_GNRC_SIXLOWPAN)
+        if (gnrc_sixlowpan_handle_msg(&msg)) {
+            continue;
+        }
+#endif
+
         switch (msg.type) {
             case GNRC_NETAPI_MSG_TYPE_RCV:
                 DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_RCV received\n");
@@ -226,6 +271,12 @@ static void *_event_loop(void *args)
                 _send_by_netif_hdr(msg.content.ptr);
                 break;
 #endif  /* MODULE_GNRC_IPV6_EXT_FRAG */
+#ifdef MODULE_GNRC_MPL
+            case GNRC_MPL_MSG_TYPE_TRICKLE:
+                DEBUG("ipv6: MPL trickle timer expired\n");
+                gnrc_mpl_handle_timer(msg.content.ptr);
+                break;
+#endif  /* MODULE_GNRC_MPL */
             case GNRC_IPV6_NIB_SND_UC_NS:
             case GNRC_IPV6_NIB_SND_MC_NS:
             case GNRC_IPV6_NIB_SND_NA:
@@ -253,6 +304,62 @@ static void *_event_loop(void *args)
     return NULL;
 }
 
+#if IS_USED(MODULE_GNRC_IPV6_FWD_THREAD)
+static void *_fwd_event_loop(void *args)
+{
+    msg_t msg, reply, msg_q[GNRC_IPV6_FWD_MSG_QUEUE_SIZE];
+
+    (void)args;
+    msg_init_queue(msg_q, GNRC_IPV6_FWD_MSG_QUEUE_SIZE);
+
+    /* preinitialize ACK */
+    reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
+
+    /* start event loop */
+    while (1) {
+        DEBUG("ipv6_fwd: waiting for incoming message.\n");
+        msg_receive(&msg);
+
+        switch (msg.type) {
+            case GNRC_NETAPI_MSG_TYPE_RCV:
+                DEBUG("ipv6_fwd: GNRC_NETAPI_MSG_TYPE_RCV received\n");
+                /* goes through the same checks as in the IPv6 thread, in case
+                 * the packet is destined to this host by now */
+                _receive(msg.content.ptr);
+                break;
+
+            case GNRC_NETAPI_MSG_TYPE_GET:
+            case GNRC_NETAPI_MSG_TYPE_SET:
+                DEBUG("ipv6_fwd: reply to unsupported get/set\n");
+                reply.content.value = -ENOTSUP;
+                msg_reply(&msg, &reply);
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    return NULL;
+}
+
+bool gnrc_ipv6_fwd_steer(const gnrc_pktsnip_t *pkt)
+{
+    const ipv6_hdr_t *hdr = pkt->data;
+
+    return (gnrc_ipv6_fwd_pid != KERNEL_PID_UNDEF) &&
+           (pkt->data != NULL) && (pkt->size >= sizeof(ipv6_hdr_t)) &&
+           ipv6_hdr_is(hdr) &&
+           /* link-local and multicast packets are never forwarded, the IPv6
+            * thread drops or delivers them */
+           !ipv6_addr_is_multicast(&hdr->dst) &&
+           !ipv6_addr_is_link_local(&hdr->dst) &&
+           !ipv6_addr_is_link_local(&hdr->src) &&
+           !ipv6_addr_is_loopback(&hdr->dst) &&
+           (gnrc_netif_get_by_ipv6_addr(&hdr->dst) == NULL);
+}
+#endif  /* MODULE_GNRC_IPV6_FWD_THREAD */
+
 static void _send_to_iface(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
 {
     const ipv6_hdr_t *hdr = pkt->next->data;
@@ -487,10 +594,26 @@ static void _send_unicast(gnrc_pktsnip_t *pkt, bool prep_hdr,
                           uint8_t netif_hdr_flags)
 {
     gnrc_ipv6_nib_nc_t nce;
+#if IS_USED(MODULE_GNRC_IPV6_ROUTE_CACHE)
+    unsigned iface = (netif == NULL) ? 0 : netif->pid;
+    uint32_t gen = gnrc_ipv6_route_cache_gen();
+    bool select_src = prep_hdr && ipv6_addr_is_unspecified(&ipv6_hdr->src);
+    ipv6_addr_t src;
+#endif
+    bool hit = false;
 
     DEBUG("ipv6: send unicast\n");
-    if (gnrc_ipv6_nib_get_next_hop_l2addr(&ipv6_hdr->dst, netif, pkt,
-                                          &nce) < 0) {
+#if IS_USED(MODULE_GNRC_IPV6_ROUTE_CACHE)
+    hit = gnrc_ipv6_route_cache_get(&ipv6_hdr->dst, iface, &nce, &src);
+    if (hit && select_src && !ipv6_addr_is_unspecified(&src)) {
+        DEBUG("ipv6: use cached source address for %s\n",
+              ipv6_addr_to_str(addr_str, &ipv6_hdr->dst, sizeof(addr_str)));
+        memcpy(&ipv6_hdr->src, &src, sizeof(ipv6_hdr->src));
+        select_src = false;
+    }
+#endif
+    if (!hit && (gnrc_ipv6_nib_get_next_hop_l2addr(&ipv6_hdr->dst, netif, pkt,
+                                                   &nce) < 0)) {
         /* packet is released by NIB */
         DEBUG("ipv6: no link-layer address or interface for next hop to %s\n",
               ipv6_addr_to_str(addr_str, &ipv6_hdr->dst, sizeof(addr_str)));
@@ -499,6 +622,16 @@ static void _send_unicast(gnrc_pktsnip_t *pkt, bool prep_hdr,
     netif = gnrc_netif_get_by_pid(gnrc_ipv6_nib_nc_get_iface(&nce));
     assert(netif != NULL);
     if (_safe_fill_ipv6_hdr(netif, pkt, prep_hdr)) {
+#if IS_USED(MODULE_GNRC_IPV6_ROUTE_CACHE)
+        /* only remember global or link-local source addresses selected for
+         * this destination, not e.g. the loopback address */
+        select_src = select_src && !ipv6_addr_is_unspecified(&ipv6_hdr->src) &&
+                     !ipv6_addr_is_loopback(&ipv6_hdr->src);
+        if (!hit || select_src) {
+            gnrc_ipv6_route_cache_add(&ipv6_hdr->dst, iface, gen, &nce,
+                                      select_src ? &ipv6_hdr->src : NULL);
+        }
+#endif
         DEBUG("ipv6: add interface header to packet\n");
         if ((pkt = _create_netif_hdr(nce.l2addr, nce.l2addr_len, pkt,
                                      netif_hdr_flags)) == NULL) {
@@ -693,6 +826,12 @@ static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
     ipv6_hdr = pkt->data;
 
     if (ipv6_addr_is_multicast(&ipv6_hdr->dst)) {
+#ifdef MODULE_GNRC_MPL
+        if (prep_hdr && gnrc_mpl_send(pkt, netif)) {
+            DEBUG("ipv6: packet is disseminated by MPL\n");
+            return;
+        }
+#endif  /* MODULE_GNRC_MPL */
         _send_multicast(pkt, prep_hdr, netif, netif_hdr_flags);
     }
     else {
@@ -839,6 +978,14 @@ static void _receive(gnrc_pktsnip_t *pkt)
     if (_pkt_not_for_me(&netif, hdr)) { /* if packet is not for me */
         DEBUG("ipv6: packet destination not this host\n");
 
+#ifdef MODULE_GNRC_MPL
+        if (gnrc_mpl_is_domain(&hdr->dst)) {
+            /* MPL retransmits the packet, if it is new */
+            DEBUG("ipv6: packet is disseminated by MPL\n");
+            gnrc_pktbuf_release(pkt);
+            return;
+        }
+#endif  /* MODULE_GNRC_MPL */
 #ifdef MODULE_GNRC_IPV6_ROUTER    /* only routers redirect */
         /* redirect to next hop */
         DEBUG("ipv6: decrement hop limit to %u\n", (uint8_t) (hdr->hl - 1));
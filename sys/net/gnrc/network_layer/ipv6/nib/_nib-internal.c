@@ -18,6 +18,7 @@
 #include <string.h>
 #include <kernel_defines.h>
 
+#include "metrics.h"
 #include "net/gnrc/icmpv6/error.h"
 #include "net/gnrc/ipv6.h"
 #include "net/gnrc/ipv6/nib/conf.h"
@@ -37,16 +38,70 @@ _nib_dr_entry_t *_prime_def_router = NULL;
 static clist_node_t _next_removable = { NULL };
 
 static _nib_onl_entry_t _nodes[CONFIG_GNRC_IPV6_NIB_NUMOF];
+#if IS_USED(MODULE_GNRC_IPV6_NIB_NC_HASH)
+/* first entry of every bucket, entries are in order of _nodes within a bucket */
+static _nib_onl_entry_t *_node_buckets[CONFIG_GNRC_IPV6_NIB_NC_HASH_SIZE];
+/* counts the lookups to order entries by their last use */
+static uint32_t _node_uses = 0;
+#endif  /* MODULE_GNRC_IPV6_NIB_NC_HASH */
 static _nib_offl_entry_t _dsts[CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF];
 static _nib_dr_entry_t _def_routers[CONFIG_GNRC_IPV6_NIB_DEFAULT_ROUTER_NUMOF];
 
 #if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_MULTIHOP_P6C)
 static _nib_abr_entry_t _abrs[CONFIG_GNRC_IPV6_NIB_ABR_NUMOF];
 #endif  /* CONFIG_GNRC_IPV6_NIB_MULTIHOP_P6C */
+#if IS_USED(MODULE_GNRC_IPV6_NIB_FT_TRIE)
+/**
+ * @brief   Node of the prefix trie over the off-link entries
+ */
+typedef struct _offl_trie_node {
+    struct _offl_trie_node *child[2];   /**< sub-tries by the next prefix bit */
+    _nib_offl_entry_t *entries; /**< entries with this prefix, NULL if the
+                                 *   node only branches */
+    ipv6_addr_t pfx;            /**< prefix of the node */
+    uint8_t pfx_len;            /**< prefix-length in bits of the node */
+} _offl_trie_node_t;
+
+/* every prefix needs at most one node of its own and one node to branch off
+ * from the others */
+static _offl_trie_node_t _offl_trie[(2 * CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF) - 1];
+static _offl_trie_node_t *_offl_trie_root = NULL;
+#endif  /* MODULE_GNRC_IPV6_NIB_FT_TRIE */
 static rmutex_t _nib_mutex = RMUTEX_INIT;
 
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 
+#if IS_USED(MODULE_METRICS)
+static struct {
+    metrics_gauge_t onl_max;        /* on-link entries in use at most */
+    metrics_gauge_t offl_max;       /* off-link entries in use at most */
+    metrics_gauge_t dr_max;         /* default routers at most */
+    metrics_counter_t onl_full;
+    metrics_counter_t offl_full;
+} _metrics;
+
+static const metrics_entry_t _metrics_entries[] = {
+    METRICS_ENTRY(METRICS_GAUGE, "onl_max", _metrics, onl_max),
+    METRICS_ENTRY(METRICS_GAUGE, "offl_max", _metrics, offl_max),
+    METRICS_ENTRY(METRICS_GAUGE, "dr_max", _metrics, dr_max),
+    METRICS_ENTRY(METRICS_COUNTER, "onl_full", _metrics, onl_full),
+    METRICS_ENTRY(METRICS_COUNTER, "offl_full", _metrics, offl_full),
+};
+
+metrics_group_t gnrc_ipv6_nib_metrics = METRICS_GROUP("nib", _metrics,
+                                                      _metrics_entries);
+
+/* entries are only allocated on changes of the neighborhood or the routes,
+ * so counting them there is cheap enough. Updates are serialized by the
+ * NIB mutex. */
+static void _metrics_max(metrics_gauge_t *max, int32_t used)
+{
+    if (used > *max) {
+        metrics_gauge_set(max, used);
+    }
+}
+#endif
+
 evtimer_msg_t _nib_evtimer;
 
 static void _override_node(const ipv6_addr_t *addr, unsigned iface,
@@ -59,11 +114,19 @@ void _nib_init(void)
     _prime_def_router = NULL;
     _next_removable.next = NULL;
     memset(_nodes, 0, sizeof(_nodes));
+#if IS_USED(MODULE_GNRC_IPV6_NIB_NC_HASH)
+    memset(_node_buckets, 0, sizeof(_node_buckets));
+    _node_uses = 0;
+#endif  /* MODULE_GNRC_IPV6_NIB_NC_HASH */
     memset(_def_routers, 0, sizeof(_def_routers));
     memset(_dsts, 0, sizeof(_dsts));
 #if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_MULTIHOP_P6C)
     memset(_abrs, 0, sizeof(_abrs));
 #endif  /* CONFIG_GNRC_IPV6_NIB_MULTIHOP_P6C */
+#if IS_USED(MODULE_GNRC_IPV6_NIB_FT_TRIE)
+    memset(_offl_trie, 0, sizeof(_offl_trie));
+    _offl_trie_root = NULL;
+#endif  /* MODULE_GNRC_IPV6_NIB_FT_TRIE */
 #endif  /* TEST_SUITES */
     evtimer_init_msg(&_nib_evtimer);
     /* TODO: load ABR information from persistent memory */
@@ -86,6 +149,43 @@ static inline bool _addr_equals(const ipv6_addr_t *addr,
            (ipv6_addr_equal(addr, &node->ipv6));
 }
 
+#if IS_USED(MODULE_GNRC_IPV6_NIB_NC_HASH)
+static _nib_onl_entry_t **_onl_bucket(const ipv6_addr_t *addr)
+{
+    /* neighbors mostly share their prefix, so mix in the IID the most */
+    uint32_t hash = addr->u32[0].u32 ^ addr->u32[1].u32;
+
+    hash = (hash * 31) ^ addr->u32[2].u32;
+    hash = (hash * 31) ^ addr->u32[3].u32;
+    hash ^= hash >> 16;
+    hash ^= hash >> 8;
+    return &_node_buckets[hash & (CONFIG_GNRC_IPV6_NIB_NC_HASH_SIZE - 1)];
+}
+
+static void _onl_index_add(_nib_onl_entry_t *node)
+{
+    _nib_onl_entry_t **ptr = _onl_bucket(&node->ipv6);
+
+    while ((*ptr != NULL) && (*ptr < node)) {
+        ptr = &(*ptr)->bucket_next;
+    }
+    node->bucket_next = *ptr;
+    *ptr = node;
+}
+
+void _nib_onl_index_rm(_nib_onl_entry_t *node)
+{
+    for (_nib_onl_entry_t **ptr = _onl_bucket(&node->ipv6); *ptr != NULL;
+         ptr = &(*ptr)->bucket_next) {
+        if (*ptr == node) {
+            *ptr = node->bucket_next;
+            node->bucket_next = NULL;
+            return;
+        }
+    }
+}
+#endif  /* MODULE_GNRC_IPV6_NIB_NC_HASH */
+
 _nib_onl_entry_t *_nib_onl_alloc(const ipv6_addr_t *addr, unsigned iface)
 {
     _nib_onl_entry_t *node = NULL;
@@ -108,13 +208,23 @@ _nib_onl_entry_t *_nib_onl_alloc(const ipv6_addr_t *addr, unsigned iface)
         }
     }
     if (node != NULL) {
+#if IS_USED(MODULE_METRICS)
+        /* the caller sets the mode of a new node */
+        int32_t used = (node->mode == _EMPTY);
+
+        for (unsigned i = 0; i < CONFIG_GNRC_IPV6_NIB_NUMOF; i++) {
+            used += (_nodes[i].mode != _EMPTY);
+        }
+        _metrics_max(&_metrics.onl_max, used);
+#endif
         _override_node(addr, iface, node);
     }
-#if ENABLE_DEBUG
     else {
         DEBUG("  NIB full\n");
+#if IS_USED(MODULE_METRICS)
+        metrics_counter_inc(&_metrics.onl_full);
+#endif
     }
-#endif  /* ENABLE_DEBUG */
     return node;
 }
 
@@ -125,6 +235,46 @@ static inline bool _is_gc(_nib_onl_entry_t *node)
             GNRC_IPV6_NIB_NC_INFO_AR_STATE_GC);
 }
 
+#if IS_USED(MODULE_GNRC_IPV6_NIB_NC_HASH)
+static inline _nib_onl_entry_t *_cache_out_onl_entry(const ipv6_addr_t *addr,
+                                                     unsigned iface,
+                                                     uint16_t cstate)
+{
+    _nib_onl_entry_t *last = (_nib_onl_entry_t *)_next_removable.next;
+    _nib_onl_entry_t *tmp = last, *res = NULL;
+
+    DEBUG("nib: Searching for least recently used replaceable entry "
+          "(addr = %s, iface = %u)\n",
+          ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)), iface);
+    if (tmp == NULL) {
+        return NULL;
+    }
+    /* start with the oldest entry in the FIFO, so it is taken on a tie */
+    do {
+        tmp = tmp->next;
+        if (_is_gc(tmp) && ((res == NULL) ||
+            ((_node_uses - tmp->last_used) > (_node_uses - res->last_used)))) {
+            res = tmp;
+        }
+    } while (tmp != last);
+    if (res != NULL) {
+        DEBUG("nib: Removing neighbor cache entry (addr = %s, iface = %u) ",
+              ipv6_addr_to_str(addr_str, &res->ipv6, sizeof(addr_str)),
+              _nib_onl_get_if(res));
+        DEBUG("for (addr = %s, iface = %u)\n",
+              ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)), iface);
+        /* call _nib_nc_remove to remove timers from _evtimer and the entry
+         * from the removable entries */
+        _nib_nc_remove(res);
+        _override_node(addr, iface, res);
+        /* cstate masked in _nib_nc_add() already */
+        res->info |= cstate;
+        res->mode = _NC;
+        clist_rpush(&_next_removable, (clist_node_t *)res);
+    }
+    return res;
+}
+#else   /* MODULE_GNRC_IPV6_NIB_NC_HASH */
 static inline _nib_onl_entry_t *_cache_out_onl_entry(const ipv6_addr_t *addr,
                                                      unsigned iface,
                                                      uint16_t cstate)
@@ -171,6 +321,7 @@ static inline _nib_onl_entry_t *_cache_out_onl_entry(const ipv6_addr_t *addr,
     }
     return res;
 }
+#endif  /* MODULE_GNRC_IPV6_NIB_NC_HASH */
 
 _nib_onl_entry_t *_nib_nc_add(const ipv6_addr_t *addr, unsigned iface,
                               uint16_t cstate)
@@ -220,6 +371,19 @@ _nib_onl_entry_t *_nib_onl_get(const ipv6_addr_t *addr, unsigned iface)
     assert(addr != NULL);
     DEBUG("nib: Getting on-link node entry (addr = %s, iface = %u)\n",
           ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)), iface);
+#if IS_USED(MODULE_GNRC_IPV6_NIB_NC_HASH)
+    for (_nib_onl_entry_t *node = *_onl_bucket(addr); node != NULL;
+         node = node->bucket_next) {
+        if ((node->mode != _EMPTY) &&
+            ((_nib_onl_get_if(node) == 0) || (iface == 0) ||
+             (_nib_onl_get_if(node) == iface)) &&
+            ipv6_addr_equal(&node->ipv6, addr)) {
+            DEBUG("  Found %p\n", (void *)node);
+            node->last_used = ++_node_uses;
+            return node;
+        }
+    }
+#else   /* MODULE_GNRC_IPV6_NIB_NC_HASH */
     for (unsigned i = 0; i < CONFIG_GNRC_IPV6_NIB_NUMOF; i++) {
         _nib_onl_entry_t *node = &_nodes[i];
 
@@ -233,6 +397,7 @@ _nib_onl_entry_t *_nib_onl_get(const ipv6_addr_t *addr, unsigned iface)
             return node;
         }
     }
+#endif  /* MODULE_GNRC_IPV6_NIB_NC_HASH */
     DEBUG("  No suitable entry found\n");
     return NULL;
 }
@@ -370,6 +535,15 @@ _nib_dr_entry_t *_nib_drl_add(const ipv6_addr_t *router_addr, unsigned iface)
         }
         _override_node(router_addr, iface, def_router->next_hop);
         def_router->next_hop->mode |= _DRL;
+#if IS_USED(MODULE_METRICS)
+        int32_t used = 0;
+
+        for (unsigned i = 0; i < CONFIG_GNRC_IPV6_NIB_DEFAULT_ROUTER_NUMOF;
+             i++) {
+            used += (_def_routers[i].next_hop != NULL);
+        }
+        _metrics_max(&_metrics.dr_max, used);
+#endif
     }
     return def_router;
 }
@@ -468,6 +642,147 @@ void _nib_drl_ft_get(const _nib_dr_entry_t *drl, gnrc_ipv6_nib_ft_t *fte)
     fte->iface = _nib_onl_get_if(drl->next_hop);
 }
 
+#if IS_USED(MODULE_GNRC_IPV6_NIB_FT_TRIE)
+static inline unsigned _pfx_bit(const ipv6_addr_t *pfx, unsigned idx)
+{
+    return (pfx->u8[idx / 8] >> (7 - (idx % 8))) & 0x1;
+}
+
+static inline _offl_trie_node_t *_offl_trie_only_child(_offl_trie_node_t *node)
+{
+    return (node->child[0] != NULL) ? node->child[0] : node->child[1];
+}
+
+static _offl_trie_node_t *_offl_trie_node_alloc(const ipv6_addr_t *pfx,
+                                                unsigned pfx_len)
+{
+    for (unsigned i = 0; i < ARRAY_SIZE(_offl_trie); i++) {
+        _offl_trie_node_t *node = &_offl_trie[i];
+
+        /* nodes in use either hold entries or branch */
+        if ((node->entries == NULL) && (node->child[0] == NULL) &&
+            (node->child[1] == NULL)) {
+            ipv6_addr_init_prefix(&node->pfx, pfx, pfx_len);
+            node->pfx_len = pfx_len;
+            return node;
+        }
+    }
+    /* can't happen, see size of _offl_trie */
+    assert(false);
+    return NULL;
+}
+
+static void _offl_trie_add(_nib_offl_entry_t *dst)
+{
+    _offl_trie_node_t **link = &_offl_trie_root;
+    _offl_trie_node_t *node, *new_node;
+    unsigned common = 0;
+
+    while ((node = *link) != NULL) {
+        common = ipv6_addr_match_prefix(&node->pfx, &dst->pfx);
+        if (common > dst->pfx_len) {
+            common = dst->pfx_len;
+        }
+        if (common < node->pfx_len) {
+            /* dst branches off above node */
+            break;
+        }
+        if (node->pfx_len == dst->pfx_len) {
+            _nib_offl_entry_t **ptr = &node->entries;
+
+            /* keep entries in order of _dsts, so the same entry matches as
+             * with a search over _dsts */
+            while ((*ptr != NULL) && (*ptr < dst)) {
+                ptr = &(*ptr)->trie_next;
+            }
+            dst->trie_next = *ptr;
+            *ptr = dst;
+            return;
+        }
+        link = &node->child[_pfx_bit(&dst->pfx, node->pfx_len)];
+    }
+    new_node = _offl_trie_node_alloc(&dst->pfx, dst->pfx_len);
+    new_node->entries = dst;
+    dst->trie_next = NULL;
+    if (node != NULL) {
+        if (common == dst->pfx_len) {
+            /* prefix of dst is a prefix of the prefix of node */
+            new_node->child[_pfx_bit(&node->pfx, common)] = node;
+        }
+        else {
+            _offl_trie_node_t *branch = _offl_trie_node_alloc(&dst->pfx,
+                                                              common);
+
+            branch->child[_pfx_bit(&dst->pfx, common)] = new_node;
+            branch->child[_pfx_bit(&node->pfx, common)] = node;
+            new_node = branch;
+        }
+    }
+    *link = new_node;
+}
+
+static void _offl_trie_remove(_nib_offl_entry_t *dst)
+{
+    _offl_trie_node_t **parent = NULL, **link = &_offl_trie_root;
+    _offl_trie_node_t *node;
+    _nib_offl_entry_t **ptr;
+
+    while (((node = *link) != NULL) && (node->pfx_len < dst->pfx_len)) {
+        parent = link;
+        link = &node->child[_pfx_bit(&dst->pfx, node->pfx_len)];
+    }
+    if ((node == NULL) || (node->pfx_len != dst->pfx_len)) {
+        return;
+    }
+    for (ptr = &node->entries; (*ptr != NULL) && (*ptr != dst);
+         ptr = &(*ptr)->trie_next) {}
+    if (*ptr == NULL) {
+        return;
+    }
+    *ptr = dst->trie_next;
+    dst->trie_next = NULL;
+    if ((node->entries != NULL) ||
+        ((node->child[0] != NULL) && (node->child[1] != NULL))) {
+        /* node still holds entries or keeps branching */
+        return;
+    }
+    *link = _offl_trie_only_child(node);
+    memset(node, 0, sizeof(*node));
+    if ((*link == NULL) && (parent != NULL) && ((*parent)->entries == NULL)) {
+        /* node was a leaf, so its parent does not need to branch anymore */
+        node = *parent;
+        *parent = _offl_trie_only_child(node);
+        memset(node, 0, sizeof(*node));
+    }
+}
+
+static _nib_offl_entry_t *_offl_trie_get_match(const ipv6_addr_t *dst)
+{
+    _offl_trie_node_t *node = _offl_trie_root;
+    _nib_offl_entry_t *res = NULL;
+
+    while ((node != NULL) &&
+           (ipv6_addr_match_prefix(&node->pfx, dst) >= node->pfx_len)) {
+        for (_nib_offl_entry_t *entry = node->entries; entry != NULL;
+             entry = entry->trie_next) {
+            if (entry->mode != _EMPTY) {
+                DEBUG("nib: best match so far %s/%u\n",
+                      ipv6_addr_to_str(addr_str, &entry->pfx,
+                                       sizeof(addr_str)),
+                      entry->pfx_len);
+                res = entry;
+                break;
+            }
+        }
+        if (node->pfx_len >= IPV6_ADDR_BIT_LEN) {
+            break;
+        }
+        node = node->child[_pfx_bit(dst, node->pfx_len)];
+    }
+    return res;
+}
+#endif  /* MODULE_GNRC_IPV6_NIB_FT_TRIE */
+
 _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
                                    const ipv6_addr_t *pfx, unsigned pfx_len)
 {
@@ -494,7 +809,13 @@ _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
             /* exact match (or next hop address was previously unset) */
             DEBUG("  %p is an exact match\n", (void *)tmp);
             if (next_hop != NULL) {
+#if IS_USED(MODULE_GNRC_IPV6_NIB_NC_HASH)
+                _nib_onl_index_rm(tmp_node);
+#endif  /* MODULE_GNRC_IPV6_NIB_NC_HASH */
                 memcpy(&tmp_node->ipv6, next_hop, sizeof(tmp_node->ipv6));
+#if IS_USED(MODULE_GNRC_IPV6_NIB_NC_HASH)
+                _onl_index_add(tmp_node);
+#endif  /* MODULE_GNRC_IPV6_NIB_NC_HASH */
             }
             tmp->next_hop->mode |= _DST;
             return tmp;
@@ -515,7 +836,23 @@ _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
         dst->next_hop->mode |= _DST;
         ipv6_addr_init_prefix(&dst->pfx, pfx, pfx_len);
         dst->pfx_len = pfx_len;
+#if IS_USED(MODULE_GNRC_IPV6_NIB_FT_TRIE)
+        _offl_trie_add(dst);
+#endif  /* MODULE_GNRC_IPV6_NIB_FT_TRIE */
+#if IS_USED(MODULE_METRICS)
+        int32_t used = 0;
+
+        for (unsigned i = 0; i < CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF; i++) {
+            used += (_dsts[i].next_hop != NULL);
+        }
+        _metrics_max(&_metrics.offl_max, used);
+#endif
+    }
+#if IS_USED(MODULE_METRICS)
+    else {
+        metrics_counter_inc(&_metrics.offl_full);
     }
+#endif
     return dst;
 }
 
@@ -551,6 +888,9 @@ void _nib_offl_clear(_nib_offl_entry_t *dst)
             dst->next_hop->mode &= ~(_DST);
             _nib_onl_clear(dst->next_hop);
         }
+#if IS_USED(MODULE_GNRC_IPV6_NIB_FT_TRIE)
+        _offl_trie_remove(dst);
+#endif  /* MODULE_GNRC_IPV6_NIB_FT_TRIE */
         memset(dst, 0, sizeof(_nib_offl_entry_t));
     }
 }
@@ -576,11 +916,14 @@ bool _nib_offl_is_entry(const _nib_offl_entry_t *entry)
 
 static _nib_offl_entry_t *_nib_offl_get_match(const ipv6_addr_t *dst)
 {
+    DEBUG("nib: get match for destination %s from NIB\n",
+          ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)));
+#if IS_USED(MODULE_GNRC_IPV6_NIB_FT_TRIE)
+    return _offl_trie_get_match(dst);
+#else   /* MODULE_GNRC_IPV6_NIB_FT_TRIE */
     _nib_offl_entry_t *res = NULL;
     uint8_t best_match = 0;
 
-    DEBUG("nib: get match for destination %s from NIB\n",
-          ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)));
     for (_nib_offl_entry_t *entry = _dsts; _in_dsts(entry); entry++) {
         if (entry->mode != _EMPTY) {
             uint8_t match = ipv6_addr_match_prefix(&entry->pfx, dst);
@@ -601,6 +944,7 @@ static _nib_offl_entry_t *_nib_offl_get_match(const ipv6_addr_t *dst)
         }
     }
     return res;
+#endif  /* MODULE_GNRC_IPV6_NIB_FT_TRIE */
 }
 
 void _nib_ft_get(const _nib_offl_entry_t *dst, gnrc_ipv6_nib_ft_t *fte)
@@ -828,10 +1172,17 @@ static void _override_node(const ipv6_addr_t *addr, unsigned iface,
                            _nib_onl_entry_t *node)
 {
     _nib_onl_clear(node);
+#if IS_USED(MODULE_GNRC_IPV6_NIB_NC_HASH)
+    _nib_onl_index_rm(node);
+#endif  /* MODULE_GNRC_IPV6_NIB_NC_HASH */
     if (addr != NULL) {
         memcpy(&node->ipv6, addr, sizeof(node->ipv6));
     }
     _nib_onl_set_if(node, iface);
+#if IS_USED(MODULE_GNRC_IPV6_NIB_NC_HASH)
+    _onl_index_add(node);
+    node->last_used = _node_uses;
+#endif  /* MODULE_GNRC_IPV6_NIB_NC_HASH */
 }
 
 static inline bool _node_unreachable(_nib_onl_entry_t *node)
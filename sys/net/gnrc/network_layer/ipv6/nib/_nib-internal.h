@@ -92,6 +92,20 @@ extern "C" {
  */
 typedef struct _nib_onl_entry {
     struct _nib_onl_entry *next;        /**< next removable entry */
+#if IS_USED(MODULE_GNRC_IPV6_NIB_NC_HASH) || defined(DOXYGEN)
+    /**
+     * @brief   Next entry in the same hash bucket
+     *
+     * @note    Only available with module `gnrc_ipv6_nib_nc_hash`
+     */
+    struct _nib_onl_entry *bucket_next;
+    /**
+     * @brief   Value of the use counter when the entry was last looked up
+     *
+     * @note    Only available with module `gnrc_ipv6_nib_nc_hash`
+     */
+    uint32_t last_used;
+#endif
 #if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_QUEUE_PKT) || defined(DOXYGEN)
     /**
      * @brief   queue for packets currently in address resolution
@@ -195,8 +209,16 @@ typedef struct {
 /**
  * @brief   Off-link NIB entry
  */
-typedef struct {
+typedef struct _nib_offl_entry {
     _nib_onl_entry_t *next_hop; /**< next hop to destination */
+#if IS_USED(MODULE_GNRC_IPV6_NIB_FT_TRIE) || defined(DOXYGEN)
+    /**
+     * @brief   Next entry with the same prefix in the prefix trie
+     *
+     * @note    Only available with module `gnrc_ipv6_nib_ft_trie`
+     */
+    struct _nib_offl_entry *trie_next;
+#endif
     ipv6_addr_t pfx;            /**< prefix to the destination */
     /**
      * @brief   Event for @ref GNRC_IPV6_NIB_PFX_TIMEOUT
@@ -310,6 +332,17 @@ static inline void _nib_onl_set_if(_nib_onl_entry_t *node, unsigned iface)
  */
 _nib_onl_entry_t *_nib_onl_alloc(const ipv6_addr_t *addr, unsigned iface);
 
+#if IS_USED(MODULE_GNRC_IPV6_NIB_NC_HASH) || defined(DOXYGEN)
+/**
+ * @brief   Removes an on-link entry from the hash bucket of its address
+ *
+ * @note    Only available with module `gnrc_ipv6_nib_nc_hash`
+ *
+ * @param[in,out] node  An entry. May not be in any bucket.
+ */
+void _nib_onl_index_rm(_nib_onl_entry_t *node);
+#endif
+
 /**
  * @brief   Clears out a NIB entry (on-link version)
  *
@@ -321,6 +354,9 @@ _nib_onl_entry_t *_nib_onl_alloc(const ipv6_addr_t *addr, unsigned iface);
 static inline bool _nib_onl_clear(_nib_onl_entry_t *node)
 {
     if (node->mode == _EMPTY) {
+#if IS_USED(MODULE_GNRC_IPV6_NIB_NC_HASH)
+        _nib_onl_index_rm(node);
+#endif
         memset(node, 0, sizeof(_nib_onl_entry_t));
         return true;
     }
@@ -23,6 +23,7 @@
 #include "net/gnrc/nettype.h"
 #include "net/gnrc/netif/internal.h"
 #include "net/gnrc/ipv6/nib.h"
+#include "net/gnrc/ipv6/route_cache.h"
 #include "net/gnrc/ndp.h"
 #include "net/gnrc/pktqueue.h"
 #include "net/gnrc/sixlowpan/nd.h"
@@ -95,6 +96,7 @@ void gnrc_ipv6_nib_init(void)
         evtimer_del((evtimer_t *)(&_nib_evtimer), ptr);
     }
     _nib_init();
+    gnrc_ipv6_route_cache_invalidate();
     _nib_release();
 }
 
@@ -321,6 +323,7 @@ void gnrc_ipv6_nib_handle_pkt(gnrc_netif_t *netif, const ipv6_hdr_t *ipv6,
             break;
 #endif  /* CONFIG_GNRC_IPV6_NIB_MULTIHOP_DAD */
     }
+    gnrc_ipv6_route_cache_invalidate();
     _nib_release();
     gnrc_netif_release(netif);
 }
@@ -395,6 +398,7 @@ void gnrc_ipv6_nib_handle_timer_event(void *ctx, uint16_t type)
         default:
             break;
     }
+    gnrc_ipv6_route_cache_invalidate();
     _nib_release();
 }
 
@@ -1361,6 +1365,7 @@ static void _handle_mtuo(gnrc_netif_t *netif, const icmpv6_hdr_t *icmpv6,
     }
     if (byteorder_ntohl(mtuo->mtu) >= IPV6_MIN_MTU) {
         netif->ipv6.mtu = byteorder_ntohl(mtuo->mtu);
+        gnrc_netif_attrs_update_ipv6(netif);
     }
 }
 
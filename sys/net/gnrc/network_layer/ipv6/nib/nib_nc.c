@@ -21,6 +21,7 @@
 #include "net/gnrc/netif.h"
 
 #include "net/gnrc/ipv6/nib/nc.h"
+#include "net/gnrc/ipv6/route_cache.h"
 
 #include "_nib-internal.h"
 
@@ -51,6 +52,7 @@ int gnrc_ipv6_nib_nc_set(const ipv6_addr_t *ipv6, unsigned iface,
                     GNRC_IPV6_NIB_NC_INFO_NUD_STATE_MASK);
     node->info |= (GNRC_IPV6_NIB_NC_INFO_AR_STATE_MANUAL |
                    GNRC_IPV6_NIB_NC_INFO_NUD_STATE_UNMANAGED);
+    gnrc_ipv6_route_cache_invalidate();
     _nib_release();
     return 0;
 }
@@ -64,6 +66,7 @@ void gnrc_ipv6_nib_nc_del(const ipv6_addr_t *ipv6, unsigned iface)
         if ((_nib_onl_get_if(node) == iface) &&
             ipv6_addr_equal(ipv6, &node->ipv6)) {
             _nib_nc_remove(node);
+            gnrc_ipv6_route_cache_invalidate();
             break;
         }
     }
@@ -80,6 +83,7 @@ void gnrc_ipv6_nib_nc_mark_reachable(const ipv6_addr_t *ipv6)
             /* only set reachable if not unmanaged */
             if ((node->info & GNRC_IPV6_NIB_NC_INFO_NUD_STATE_MASK)) {
                 _nib_nc_set_reachable(node);
+                gnrc_ipv6_route_cache_invalidate();
             }
             break;
         }
@@ -19,6 +19,7 @@
 #include <kernel_defines.h>
 
 #include "net/gnrc/ipv6/nib/pl.h"
+#include "net/gnrc/ipv6/route_cache.h"
 #include "net/gnrc/netif/internal.h"
 #include "timex.h"
 #include "evtimer.h"
@@ -50,6 +51,7 @@ int gnrc_ipv6_nib_pl_set(unsigned iface,
         _nib_release();
         return -ENOMEM;
     }
+    gnrc_ipv6_route_cache_invalidate();
 #ifdef MODULE_GNRC_NETIF
     gnrc_netif_t *netif = gnrc_netif_get_by_pid(iface);
     int idx;
@@ -105,6 +107,7 @@ void gnrc_ipv6_nib_pl_del(unsigned iface,
             ((iface == 0) || (iface == _nib_onl_get_if(dst->next_hop))) &&
             (ipv6_addr_match_prefix(pfx, &dst->pfx) >= pfx_len)) {
             _nib_pl_remove(dst);
+            gnrc_ipv6_route_cache_invalidate();
             _nib_release();
 #if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_ROUTER)
             gnrc_netif_t *netif = gnrc_netif_get_by_pid(iface);
@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2020 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <string.h>
+
+#include "irq.h"
+#include "mutex.h"
+#include "net/gnrc/ipv6/nib/conf.h"
+
+#include "net/gnrc/ipv6/route_cache.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+typedef struct {
+    ipv6_addr_t dst;
+    ipv6_addr_t src;
+    gnrc_ipv6_nib_nc_t nce;
+    uint32_t gen;
+    uint16_t iface;
+} _entry_t;
+
+static _entry_t _cache[CONFIG_GNRC_IPV6_ROUTE_CACHE_SIZE];
+static gnrc_ipv6_route_cache_stats_t _stats;
+static unsigned _next;
+/* the forwarding thread uses the cache concurrently to the IPv6 thread */
+static mutex_t _mutex = MUTEX_INIT;
+
+/* generation 0 is never valid, so zeroed entries are never used */
+static uint32_t _gen = 1;
+
+static inline bool _valid(const _entry_t *entry, uint32_t gen)
+{
+    return entry->gen == gen;
+}
+
+static _entry_t *_find(const ipv6_addr_t *dst, unsigned iface, uint32_t gen)
+{
+    for (unsigned i = 0; i < CONFIG_GNRC_IPV6_ROUTE_CACHE_SIZE; i++) {
+        _entry_t *entry = &_cache[i];
+
+        if (_valid(entry, gen) && (entry->iface == iface) &&
+            ipv6_addr_equal(&entry->dst, dst)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static bool _cacheable(const gnrc_ipv6_nib_nc_t *nce)
+{
+    if (!IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_ARSM)) {
+        return true;
+    }
+    switch (gnrc_ipv6_nib_nc_get_nud_state(nce)) {
+        case GNRC_IPV6_NIB_NC_INFO_NUD_STATE_UNMANAGED:
+        case GNRC_IPV6_NIB_NC_INFO_NUD_STATE_REACHABLE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void gnrc_ipv6_route_cache_invalidate(void)
+{
+    unsigned state = irq_disable();
+
+    /* skip 0 on overflow */
+    if (++_gen == 0) {
+        _gen = 1;
+    }
+    irq_restore(state);
+}
+
+uint32_t gnrc_ipv6_route_cache_gen(void)
+{
+    unsigned state = irq_disable();
+    uint32_t gen = _gen;
+
+    irq_restore(state);
+    return gen;
+}
+
+bool gnrc_ipv6_route_cache_get(const ipv6_addr_t *dst, unsigned iface,
+                               gnrc_ipv6_nib_nc_t *nce, ipv6_addr_t *src)
+{
+    _entry_t *entry;
+
+    mutex_lock(&_mutex);
+    entry = _find(dst, iface, gnrc_ipv6_route_cache_gen());
+    if (entry == NULL) {
+        _stats.misses++;
+        mutex_unlock(&_mutex);
+        return false;
+    }
+    _stats.hits++;
+    *nce = entry->nce;
+    *src = entry->src;
+    mutex_unlock(&_mutex);
+    return true;
+}
+
+void gnrc_ipv6_route_cache_add(const ipv6_addr_t *dst, unsigned iface,
+                               uint32_t gen, const gnrc_ipv6_nib_nc_t *nce,
+                               const ipv6_addr_t *src)
+{
+    _entry_t *entry;
+
+    if ((gen != gnrc_ipv6_route_cache_gen()) || !_cacheable(nce)) {
+        return;
+    }
+    mutex_lock(&_mutex);
+    if ((entry = _find(dst, iface, gen)) == NULL) {
+        /* prefer entries of an older generation, round-robin otherwise */
+        for (unsigned i = 0; i < CONFIG_GNRC_IPV6_ROUTE_CACHE_SIZE; i++) {
+            if (!_valid(&_cache[i], gen)) {
+                entry = &_cache[i];
+                break;
+            }
+        }
+        if (entry == NULL) {
+            entry = &_cache[_next];
+            _next = (_next + 1) % CONFIG_GNRC_IPV6_ROUTE_CACHE_SIZE;
+        }
+        memcpy(&entry->dst, dst, sizeof(entry->dst));
+        ipv6_addr_set_unspecified(&entry->src);
+        entry->iface = iface;
+        entry->gen = gen;
+    }
+    entry->nce = *nce;
+    if (src != NULL) {
+        memcpy(&entry->src, src, sizeof(entry->src));
+    }
+    mutex_unlock(&_mutex);
+}
+
+const gnrc_ipv6_route_cache_stats_t *gnrc_ipv6_route_cache_stats(void)
+{
+    _stats.gen = gnrc_ipv6_route_cache_gen();
+    return &_stats;
+}
+
+/** @} */
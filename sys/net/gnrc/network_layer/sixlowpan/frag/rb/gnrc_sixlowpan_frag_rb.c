@@ -45,6 +45,7 @@
 #define GNRC_SIXLOWPAN_FRAG_SIZE (104 - 5)
 #endif
 
+#if !IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_RB_BITMAP)
 #ifndef RBUF_INT_SIZE
 /* same as ((int) ceil((double) N / D)) */
 #define DIV_CEIL(N, D) (((N) + (D) - 1) / (D))
@@ -53,9 +54,18 @@
 #endif
 
 static gnrc_sixlowpan_frag_rb_int_t rbuf_int[RBUF_INT_SIZE];
+#endif
 
 static gnrc_sixlowpan_frag_rb_t rbuf[CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE];
 
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_RB_HASH)
+/* first entry of every bucket and next entry in the bucket of every entry,
+ * both as index into rbuf + 1, so 0 ends a bucket. Removed entries are only
+ * unlinked by the next lookup or reuse of the entry */
+static uint8_t _buckets[CONFIG_GNRC_SIXLOWPAN_FRAG_RB_HASH_SIZE];
+static uint8_t _chain[CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE];
+#endif
+
 static char l2addr_str[3 * IEEE802154_LONG_ADDRESS_LEN];
 
 static xtimer_t _gc_timer;
@@ -64,11 +74,13 @@ static msg_t _gc_timer_msg = { .type = GNRC_SIXLOWPAN_FRAG_RB_GC_MSG };
 /* ------------------------------------
  * internal function definitions
  * ------------------------------------*/
+#if !IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_RB_BITMAP)
 /* checks whether start and end overlaps, but not identical to, given interval i */
 static inline bool _rbuf_int_overlap_partially(gnrc_sixlowpan_frag_rb_int_t *i,
                                                uint16_t start, uint16_t end);
 /* gets a free entry from interval buffer */
 static gnrc_sixlowpan_frag_rb_int_t *_rbuf_int_get_free(void);
+#endif
 /* update interval buffer of entry */
 static bool _rbuf_update_ints(gnrc_sixlowpan_frag_rb_base_t *entry,
                               uint16_t offset, size_t frag_size);
@@ -76,10 +88,12 @@ static bool _rbuf_update_ints(gnrc_sixlowpan_frag_rb_base_t *entry,
 static int _rbuf_get(const void *src, size_t src_len,
                      const void *dst, size_t dst_len,
                      size_t size, uint16_t tag,
-                     unsigned page);
+                     gnrc_nettype_t reass_type);
 /* gets an entry only by link-layer information and tag */
 static gnrc_sixlowpan_frag_rb_t *_rbuf_get_by_tag(const gnrc_netif_hdr_t *netif_hdr,
                                                   uint16_t tag);
+/* (re-)sets the garbage collection timer */
+static inline void _set_rbuf_timeout(void);
 /* internal add to repeat add when fragments overlapped */
 static int _rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
                      size_t offset, unsigned page);
@@ -92,6 +106,49 @@ enum {
     RBUF_ADD_DUPLICATE = -3,
 };
 
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_RB_BITMAP)
+static int _check_fragments(gnrc_sixlowpan_frag_rb_base_t *entry,
+                            size_t frag_size, size_t offset)
+{
+    gnrc_sixlowpan_frag_rb_bitmap_t *bitmap = &entry->bitmap;
+    unsigned start = offset / 8U;
+    unsigned end = (offset + frag_size - 1) / 8U;
+    bool received = false;
+    bool identical = true;
+
+    if (end >= GNRC_SIXLOWPAN_FRAG_RB_BITMAP_UNITS) {
+        /* caught by _rbuf_update_ints() */
+        return RBUF_ADD_SUCCESS;
+    }
+    /* A previous fragment is identical if it starts at start, covers the
+     * whole range and no other fragment starts within the range */
+    for (unsigned i = start; i <= end; i++) {
+        bool is_received = bf_isset(bitmap->received, i);
+
+        received |= is_received;
+        if (!is_received || (bf_isset(bitmap->starts, i) != (i == start))) {
+            identical = false;
+        }
+    }
+    if (!received) {
+        return RBUF_ADD_SUCCESS;
+    }
+    /* ... and ends at end, i.e. the next unit is not part of it */
+    if (identical && ((end + 1) < GNRC_SIXLOWPAN_FRAG_RB_BITMAP_UNITS) &&
+        bf_isset(bitmap->received, end + 1) &&
+        !bf_isset(bitmap->starts, end + 1)) {
+        identical = false;
+    }
+    if (!identical) {
+        /* If the fragment overlaps another fragment and differs in either the
+         * size or the offset of the overlapped fragment, discards the datagram
+         * https://tools.ietf.org/html/rfc4944#section-5.3 */
+        return RBUF_ADD_REPEAT;
+    }
+    DEBUG("6lo rbuf: fragment already in reassembly buffer\n");
+    return RBUF_ADD_DUPLICATE;
+}
+#else
 static int _check_fragments(gnrc_sixlowpan_frag_rb_base_t *entry,
                             size_t frag_size, size_t offset)
 {
@@ -117,6 +174,7 @@ static int _check_fragments(gnrc_sixlowpan_frag_rb_base_t *entry,
     }
     return RBUF_ADD_SUCCESS;
 }
+#endif
 
 gnrc_sixlowpan_frag_rb_t *gnrc_sixlowpan_frag_rb_add(gnrc_netif_hdr_t *netif_hdr,
                                                      gnrc_pktsnip_t *pkt,
@@ -155,27 +213,133 @@ void gnrc_sixlowpan_frag_rb_rm_by_datagram(const gnrc_netif_hdr_t *netif_hdr,
     }
 }
 
+static inline bool _rbuf_match(const gnrc_sixlowpan_frag_rb_t *e,
+                               const void *src, size_t src_len,
+                               const void *dst, size_t dst_len,
+                               size_t size, uint16_t tag)
+{
+    return (e->pkt != NULL) && (e->super.tag == tag) &&
+           ((size == 0) || (e->super.datagram_size == size)) &&
+           (e->super.src_len == src_len) &&
+           (e->super.dst_len == dst_len) &&
+           (memcmp(e->super.src, src, src_len) == 0) &&
+           (memcmp(e->super.dst, dst, dst_len) == 0);
+}
+
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_RB_HASH)
+static uint8_t *_rbuf_bucket(const uint8_t *src, size_t src_len,
+                             const uint8_t *dst, size_t dst_len,
+                             uint16_t tag)
+{
+    uint32_t hash = tag;
+
+    for (unsigned i = 0; i < src_len; i++) {
+        hash = (hash * 31) + src[i];
+    }
+    for (unsigned i = 0; i < dst_len; i++) {
+        hash = (hash * 31) + dst[i];
+    }
+    hash ^= hash >> 16;
+    hash ^= hash >> 8;
+    return &_buckets[hash & (CONFIG_GNRC_SIXLOWPAN_FRAG_RB_HASH_SIZE - 1)];
+}
+
+static void _rbuf_index_rm(gnrc_sixlowpan_frag_rb_t *e)
+{
+    uint8_t *next = _rbuf_bucket(e->super.src, e->super.src_len,
+                                 e->super.dst, e->super.dst_len,
+                                 e->super.tag);
+    uint8_t id = (e - rbuf) + 1;
+
+    while (*next != 0) {
+        if (*next == id) {
+            *next = _chain[id - 1];
+            _chain[id - 1] = 0;
+            return;
+        }
+        next = &_chain[*next - 1];
+    }
+}
+
+static void _rbuf_index_add(gnrc_sixlowpan_frag_rb_t *e)
+{
+    uint8_t *bucket = _rbuf_bucket(e->super.src, e->super.src_len,
+                                   e->super.dst, e->super.dst_len,
+                                   e->super.tag);
+    uint8_t id = (e - rbuf) + 1;
+
+    _chain[id - 1] = *bucket;
+    *bucket = id;
+}
+#endif
+
+/* gets an entry by its tuple, if size is 0 it is ignored */
+static gnrc_sixlowpan_frag_rb_t *_rbuf_find(const void *src, size_t src_len,
+                                            const void *dst, size_t dst_len,
+                                            size_t size, uint16_t tag)
+{
+    gnrc_sixlowpan_frag_rb_t *res = NULL;
+    unsigned probes = 0;
+
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_RB_HASH)
+    uint8_t *next = _rbuf_bucket(src, src_len, dst, dst_len, tag);
+
+    while (*next != 0) {
+        gnrc_sixlowpan_frag_rb_t *e = &rbuf[*next - 1];
+
+        probes++;
+        if (gnrc_sixlowpan_frag_rb_entry_empty(e)) {
+            /* unlink removed entry */
+            *next = _chain[*next - 1];
+            _chain[e - rbuf] = 0;
+            continue;
+        }
+        if (_rbuf_match(e, src, src_len, dst, dst_len, size, tag)) {
+            res = e;
+            break;
+        }
+        next = &_chain[*next - 1];
+    }
+#else
+    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
+        probes++;
+        if (_rbuf_match(&rbuf[i], src, src_len, dst, dst_len, size, tag)) {
+            res = &rbuf[i];
+            break;
+        }
+    }
+#endif
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+    gnrc_sixlowpan_frag_stats_get()->rbuf_lookups++;
+    gnrc_sixlowpan_frag_stats_get()->rbuf_probes += probes;
+#else
+    (void)probes;
+#endif
+    return res;
+}
+
 static gnrc_sixlowpan_frag_rb_t *_rbuf_get_by_tag(const gnrc_netif_hdr_t *netif_hdr,
                                                   uint16_t tag)
 {
     assert(netif_hdr != NULL);
-    const uint8_t *src = gnrc_netif_hdr_get_src_addr(netif_hdr);
-    const uint8_t *dst = gnrc_netif_hdr_get_dst_addr(netif_hdr);
-    const uint8_t src_len = netif_hdr->src_l2addr_len;
-    const uint8_t dst_len = netif_hdr->dst_l2addr_len;
 
-    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
-        gnrc_sixlowpan_frag_rb_t *e = &rbuf[i];
-
-        if ((e->pkt != NULL) && (e->super.tag == tag) &&
-            (e->super.src_len == src_len) &&
-            (e->super.dst_len == dst_len) &&
-            (memcmp(e->super.src, src, src_len) == 0) &&
-            (memcmp(e->super.dst, dst, dst_len) == 0)) {
-            return e;
-        }
+    return _rbuf_find(gnrc_netif_hdr_get_src_addr(netif_hdr),
+                      netif_hdr->src_l2addr_len,
+                      gnrc_netif_hdr_get_dst_addr(netif_hdr),
+                      netif_hdr->dst_l2addr_len, 0, tag);
+}
+
+static gnrc_nettype_t _reass_type(unsigned page)
+{
+    switch (page) {
+        /* use switch(page) to be extendable */
+#ifdef MODULE_GNRC_IPV6
+        case 0U:
+            return GNRC_NETTYPE_IPV6;
+#endif
+        default:
+            return GNRC_NETTYPE_UNDEF;
     }
-    return NULL;
 }
 
 #ifndef NDEBUG
@@ -215,6 +379,82 @@ static size_t _6lo_frag_size(gnrc_pktsnip_t *pkt, size_t offset, uint8_t *data)
     return frag_size;
 }
 
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR)
+static int _rbuf_add_rfrag(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt)
+{
+    sixlowpan_sfr_rfrag_t *hdr = pkt->data;
+    gnrc_sixlowpan_frag_rb_t *entry;
+    uint8_t seq = sixlowpan_sfr_rfrag_get_seq(hdr);
+    size_t frag_size = sixlowpan_sfr_rfrag_get_frag_size(hdr);
+    /* the offset of the first fragment is the size of the compressed
+     * datagram */
+    size_t offset = (seq == 0) ? 0 : sixlowpan_sfr_rfrag_get_offset(hdr);
+    int res;
+
+    if ((frag_size == 0) || (pkt->size < sizeof(*hdr)) ||
+        ((pkt->size - sizeof(*hdr)) < frag_size)) {
+        DEBUG("6lo rfrag: RFRAG empty or shorter than its fragment size\n");
+        gnrc_pktbuf_release(pkt);
+        return RBUF_ADD_ERROR;
+    }
+    gnrc_sixlowpan_frag_rb_gc();
+    entry = _rbuf_get_by_tag(netif_hdr, hdr->base.tag);
+    if (entry != NULL) {
+#if CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER > 0
+        if (entry->super.current_size == 0) {
+            DEBUG("6lo rfrag: datagram already reassembled\n");
+            gnrc_pktbuf_release(pkt);
+            return entry - &(rbuf[0]);
+        }
+#endif
+        entry->super.arrival = xtimer_now_usec();
+        _set_rbuf_timeout();
+        res = entry - &(rbuf[0]);
+    }
+    else if (seq == 0) {
+        res = _rbuf_get(gnrc_netif_hdr_get_src_addr(netif_hdr),
+                        netif_hdr->src_l2addr_len,
+                        gnrc_netif_hdr_get_dst_addr(netif_hdr),
+                        netif_hdr->dst_l2addr_len,
+                        sixlowpan_sfr_rfrag_get_offset(hdr), hdr->base.tag,
+                        GNRC_NETTYPE_SIXLOWPAN);
+        if (res < 0) {
+            DEBUG("6lo rfrag: reassembly buffer full.\n");
+            gnrc_pktbuf_release(pkt);
+            return RBUF_ADD_ERROR;
+        }
+        entry = &rbuf[res];
+    }
+    else {
+        DEBUG("6lo rfrag: first fragment of datagram not received yet\n");
+        gnrc_pktbuf_release(pkt);
+        return RBUF_ADD_ERROR;
+    }
+    if ((offset + frag_size) > entry->super.datagram_size) {
+        DEBUG("6lo rfrag: fragment too big for resulting datagram, discarding datagram\n");
+        gnrc_pktbuf_release(entry->pkt);
+        gnrc_pktbuf_release(pkt);
+        gnrc_sixlowpan_frag_rb_remove(entry);
+        return RBUF_ADD_ERROR;
+    }
+    if (!bf_isset(entry->received, seq)) {
+        DEBUG("6lo rfrag: add RFRAG %u (%u, %u) to entry (%s, ",
+              seq, (unsigned)offset, (unsigned)(offset + frag_size - 1),
+              gnrc_netif_addr_to_str(entry->super.src, entry->super.src_len,
+                                     l2addr_str));
+        DEBUG("%s, %u, %u)\n",
+              gnrc_netif_addr_to_str(entry->super.dst, entry->super.dst_len,
+                                     l2addr_str),
+              entry->super.datagram_size, entry->super.tag);
+        bf_set(entry->received, seq);
+        entry->super.current_size += (uint16_t)frag_size;
+        memcpy(((uint8_t *)entry->pkt->data) + offset, hdr + 1, frag_size);
+    }
+    gnrc_pktbuf_release(pkt);
+    return res;
+}
+#endif
+
 static int _rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
                      size_t offset, unsigned page)
 {
@@ -225,6 +465,11 @@ static int _rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
     uint16_t datagram_size;
     uint16_t datagram_tag;
 
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR)
+    if (sixlowpan_sfr_rfrag_is(pkt->data)) {
+        return _rbuf_add_rfrag(netif_hdr, pkt);
+    }
+#endif
     /* check if provided offset is the same as in fragment */
     assert(_valid_offset(pkt, offset));
     data = _6lo_frag_payload(pkt);
@@ -235,7 +480,7 @@ static int _rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
     gnrc_sixlowpan_frag_rb_gc();
     res = _rbuf_get(gnrc_netif_hdr_get_src_addr(netif_hdr), netif_hdr->src_l2addr_len,
                     gnrc_netif_hdr_get_dst_addr(netif_hdr), netif_hdr->dst_l2addr_len,
-                    datagram_size, datagram_tag, page);
+                    datagram_size, datagram_tag, _reass_type(page));
 
     if (res < 0) {
         DEBUG("6lo rbuf: reassembly buffer full.\n");
@@ -313,6 +558,31 @@ static int _rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
     return res;
 }
 
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_RB_BITMAP)
+static bool _rbuf_update_ints(gnrc_sixlowpan_frag_rb_base_t *entry,
+                              uint16_t offset, size_t frag_size)
+{
+    unsigned start = offset / 8U;
+    unsigned end = (offset + frag_size - 1) / 8U;
+
+    if (end >= GNRC_SIXLOWPAN_FRAG_RB_BITMAP_UNITS) {
+        DEBUG("6lo rfrag: datagram exceeds interval bitmap.\n");
+        return false;
+    }
+    DEBUG("6lo rfrag: add interval (%u, %u) to entry (%s, ", offset,
+          (unsigned)(offset + frag_size - 1),
+          gnrc_netif_addr_to_str(entry->src, entry->src_len, l2addr_str));
+    DEBUG("%s, %u, %u)\n", gnrc_netif_addr_to_str(entry->dst,
+                                                  entry->dst_len,
+                                                  l2addr_str),
+          entry->datagram_size, entry->tag);
+    bf_set(entry->bitmap.starts, start);
+    for (unsigned i = start; i <= end; i++) {
+        bf_set(entry->bitmap.received, i);
+    }
+    return true;
+}
+#else
 static inline bool _rbuf_int_overlap_partially(gnrc_sixlowpan_frag_rb_int_t *i,
                                                uint16_t start, uint16_t end)
 {
@@ -361,6 +631,7 @@ static bool _rbuf_update_ints(gnrc_sixlowpan_frag_rb_base_t *entry,
 
     return true;
 }
+#endif
 
 static void _gc_pkt(gnrc_sixlowpan_frag_rb_t *rbuf)
 {
@@ -403,6 +674,24 @@ void gnrc_sixlowpan_frag_rb_gc(void)
 #endif
 }
 
+void gnrc_sixlowpan_frag_rb_reclaim(void)
+{
+    gnrc_sixlowpan_frag_rb_t *oldest = NULL;
+
+    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
+        if (!gnrc_sixlowpan_frag_rb_entry_empty(&rbuf[i]) &&
+            ((oldest == NULL) ||
+             (oldest->super.arrival - rbuf[i].super.arrival < UINT32_MAX / 2))) {
+            oldest = &(rbuf[i]);
+        }
+    }
+    if (oldest != NULL) {
+        DEBUG("6lo rfrag: packet buffer low, remove oldest entry\n");
+        _gc_pkt(oldest);
+        gnrc_sixlowpan_frag_rb_remove(oldest);
+    }
+}
+
 static inline void _set_rbuf_timeout(void)
 {
     xtimer_set_msg(&_gc_timer, CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_TIMEOUT_US,
@@ -412,40 +701,36 @@ static inline void _set_rbuf_timeout(void)
 static int _rbuf_get(const void *src, size_t src_len,
                      const void *dst, size_t dst_len,
                      size_t size, uint16_t tag,
-                     unsigned page)
+                     gnrc_nettype_t reass_type)
 {
-    gnrc_sixlowpan_frag_rb_t *res = NULL, *oldest = NULL;
+    gnrc_sixlowpan_frag_rb_t *res, *oldest = NULL;
     uint32_t now_usec = xtimer_now_usec();
 
-    for (unsigned int i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
-        /* check first if entry already available */
-        if ((rbuf[i].pkt != NULL) && (rbuf[i].super.datagram_size == size) &&
-            (rbuf[i].super.tag == tag) && (rbuf[i].super.src_len == src_len) &&
-            (rbuf[i].super.dst_len == dst_len) &&
-            (memcmp(rbuf[i].super.src, src, src_len) == 0) &&
-            (memcmp(rbuf[i].super.dst, dst, dst_len) == 0)) {
-            DEBUG("6lo rfrag: entry %p (%s, ", (void *)(&rbuf[i]),
-                  gnrc_netif_addr_to_str(rbuf[i].super.src,
-                                         rbuf[i].super.src_len,
-                                         l2addr_str));
-            DEBUG("%s, %u, %u) found\n",
-                  gnrc_netif_addr_to_str(rbuf[i].super.dst,
-                                         rbuf[i].super.dst_len,
-                                         l2addr_str),
-                  (unsigned)rbuf[i].super.datagram_size, rbuf[i].super.tag);
+    /* check first if entry already available */
+    assert(size > 0);
+    res = _rbuf_find(src, src_len, dst, dst_len, size, tag);
+    if (res != NULL) {
+        DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
+              gnrc_netif_addr_to_str(res->super.src, res->super.src_len,
+                                     l2addr_str));
+        DEBUG("%s, %u, %u) found\n",
+              gnrc_netif_addr_to_str(res->super.dst, res->super.dst_len,
+                                     l2addr_str),
+              (unsigned)res->super.datagram_size, res->super.tag);
 #if CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER > 0
-            if (rbuf[i].super.current_size == 0) {
-                /* ensure that only empty reassembly buffer entries and entries
-                 * scheduled for deletion have `current_size == 0` */
-                DEBUG("6lo rfrag: scheduled for deletion, don't add fragment\n");
-                return -1;
-            }
-#endif
-            rbuf[i].super.arrival = now_usec;
-            _set_rbuf_timeout();
-            return i;
+        if (res->super.current_size == 0) {
+            /* ensure that only empty reassembly buffer entries and entries
+             * scheduled for deletion have `current_size == 0` */
+            DEBUG("6lo rfrag: scheduled for deletion, don't add fragment\n");
+            return -1;
         }
+#endif
+        res->super.arrival = now_usec;
+        _set_rbuf_timeout();
+        return res - &(rbuf[0]);
+    }
 
+    for (unsigned int i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
         /* if there is a free spot: remember it */
         if ((res == NULL) && gnrc_sixlowpan_frag_rb_entry_empty(&rbuf[i])) {
             res = &(rbuf[i]);
@@ -486,18 +771,6 @@ static int _rbuf_get(const void *src, size_t src_len,
     }
 
     /* now we have an empty spot */
-
-    gnrc_nettype_t reass_type;
-    switch (page) {
-        /* use switch(page) to be extendable */
-#ifdef MODULE_GNRC_IPV6
-        case 0U:
-            reass_type = GNRC_NETTYPE_IPV6;
-            break;
-#endif
-        default:
-            reass_type = GNRC_NETTYPE_UNDEF;
-    }
     res->pkt = gnrc_pktbuf_add(NULL, NULL, size, reass_type);
     if (res->pkt == NULL) {
         DEBUG("6lo rfrag: can not allocate reassembly buffer space.\n");
@@ -506,6 +779,11 @@ static int _rbuf_get(const void *src, size_t src_len,
 
     *((uint64_t *)res->pkt->data) = 0;  /* clean first few bytes for later
                                                * look-ups */
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_RB_HASH)
+    /* still linked to the bucket of its previous datagram, if not yet
+     * unlinked by a lookup */
+    _rbuf_index_rm(res);
+#endif
     res->super.datagram_size = size;
     res->super.arrival = now_usec;
     memcpy(res->super.src, src, src_len);
@@ -514,6 +792,12 @@ static int _rbuf_get(const void *src, size_t src_len,
     res->super.dst_len = dst_len;
     res->super.tag = tag;
     res->super.current_size = 0;
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR)
+    memset(res->received, 0, sizeof(res->received));
+#endif
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_RB_HASH)
+    _rbuf_index_add(res);
+#endif
 
     DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
           gnrc_netif_addr_to_str(res->super.src, res->super.src_len,
@@ -528,11 +812,17 @@ static int _rbuf_get(const void *src, size_t src_len,
     return res - &(rbuf[0]);
 }
 
-#ifdef TEST_SUITES
+#if defined(TEST_SUITES) || defined(MODULE_FUZZING)
 void gnrc_sixlowpan_frag_rb_reset(void)
 {
     xtimer_remove(&_gc_timer);
+#if !IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_RB_BITMAP)
     memset(rbuf_int, 0, sizeof(rbuf_int));
+#endif
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_RB_HASH)
+    memset(_buckets, 0, sizeof(_buckets));
+    memset(_chain, 0, sizeof(_chain));
+#endif
     for (unsigned int i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
         if ((rbuf[i].pkt != NULL) &&
             (rbuf[i].pkt->users > 0)) {
@@ -541,7 +831,9 @@ void gnrc_sixlowpan_frag_rb_reset(void)
     }
     memset(rbuf, 0, sizeof(rbuf));
 }
+#endif
 
+#ifdef TEST_SUITES
 const gnrc_sixlowpan_frag_rb_t *gnrc_sixlowpan_frag_rb_array(void)
 {
     return &rbuf[0];
@@ -550,6 +842,9 @@ const gnrc_sixlowpan_frag_rb_t *gnrc_sixlowpan_frag_rb_array(void)
 
 void gnrc_sixlowpan_frag_rb_base_rm(gnrc_sixlowpan_frag_rb_base_t *entry)
 {
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_RB_BITMAP)
+    memset(&entry->bitmap, 0, sizeof(entry->bitmap));
+#else
     while (entry->ints != NULL) {
         gnrc_sixlowpan_frag_rb_int_t *next = entry->ints->next;
 
@@ -558,6 +853,7 @@ void gnrc_sixlowpan_frag_rb_base_rm(gnrc_sixlowpan_frag_rb_base_t *entry)
         entry->ints->next = NULL;
         entry->ints = next;
     }
+#endif
     entry->datagram_size = 0;
 }
 
@@ -584,12 +880,26 @@ static void _tmp_rm(gnrc_sixlowpan_frag_rb_t *rbuf)
 static inline unsigned _count_frags(gnrc_sixlowpan_frag_rb_t *rbuf)
 {
     unsigned frags = 0;
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR)
+    if (rbuf->pkt->type == GNRC_NETTYPE_SIXLOWPAN) {
+        for (unsigned i = 0; i < SIXLOWPAN_SFR_ACK_BITMAP_SIZE; i++) {
+            frags += bf_isset(rbuf->received, i);
+        }
+        return frags;
+    }
+#endif
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_RB_BITMAP)
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_RB_BITMAP_UNITS; i++) {
+        frags += bf_isset(rbuf->super.bitmap.starts, i);
+    }
+#else
     gnrc_sixlowpan_frag_rb_int_t *frag = rbuf->super.ints;
 
     while (frag) {
         frag = frag->next;
         frags++;
     }
+#endif
     return frags;
 }
 #endif
@@ -627,6 +937,18 @@ int gnrc_sixlowpan_frag_rb_dispatch_when_complete(gnrc_sixlowpan_frag_rb_t *rbuf
 #if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_STATS)
         gnrc_sixlowpan_frag_stats_get()->fragments += _count_frags(rbuf);
         gnrc_sixlowpan_frag_stats_get()->datagrams++;
+#endif
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR)
+        if (rbuf->pkt->type == GNRC_NETTYPE_SIXLOWPAN) {
+            /* datagram was reassembled in compressed form, so let the 6LoWPAN
+             * thread parse its dispatch */
+            if (gnrc_netapi_receive(gnrc_sixlowpan_get_pid(), rbuf->pkt) < 1) {
+                DEBUG("6lo rbuf: unable to hand reassembled datagram to 6LoWPAN\n");
+                gnrc_pktbuf_release(rbuf->pkt);
+            }
+            _tmp_rm(rbuf);
+            return res;
+        }
 #endif
         gnrc_sixlowpan_dispatch_recv(rbuf->pkt, NULL, 0);
         _tmp_rm(rbuf);
@@ -0,0 +1,715 @@
+/*
+ * Copyright (C) 2020 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "bitfield.h"
+#include "net/gnrc/neterr.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan.h"
+#include "net/gnrc/sixlowpan/frag/rb.h"
+#include "net/gnrc/sixlowpan/frag/sfr.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+#include "net/gnrc/sixlowpan/frag/stats.h"
+#endif
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+#include "net/gnrc/sixlowpan/frag/vrb.h"
+#endif
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC
+#include "net/gnrc/sixlowpan/iphc.h"
+#endif
+#include "net/sixlowpan.h"
+#include "timex.h"
+#include "utlist.h"
+#include "xtimer.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+#define _STATS_INC(field)   (gnrc_sixlowpan_frag_stats_get()->field++)
+#else
+#define _STATS_INC(field)   (void)0
+#endif
+
+static const BITFIELD(_null_bitmap, SIXLOWPAN_SFR_ACK_BITMAP_SIZE);
+static const BITFIELD(_full_bitmap, SIXLOWPAN_SFR_ACK_BITMAP_SIZE) = {
+    0xff, 0xff, 0xff, 0xff,
+};
+
+static inline bool _bitmap_is(const uint8_t *bitmap, const uint8_t *cmp)
+{
+    return (memcmp(bitmap, cmp, sizeof(_null_bitmap)) == 0);
+}
+
+static inline bool _is_abort(const sixlowpan_sfr_rfrag_t *hdr)
+{
+    return (sixlowpan_sfr_rfrag_get_seq(hdr) == 0) &&
+           (sixlowpan_sfr_rfrag_get_frag_size(hdr) == 0) &&
+           (sixlowpan_sfr_rfrag_get_offset(hdr) == 0);
+}
+
+/*
+ * Sender
+ */
+static void _clean_up_fbuf(gnrc_sixlowpan_frag_fb_t *fbuf, uint32_t error)
+{
+    xtimer_remove(&fbuf->sfr.timer);
+    /* ignore timer messages that were already queued */
+    fbuf->sfr.timer_msg.type = 0;
+    gnrc_pktbuf_release_error(fbuf->pkt, error);
+    fbuf->pkt = NULL;
+}
+
+static void _set_timer(gnrc_sixlowpan_frag_fb_t *fbuf, uint32_t offset,
+                       uint16_t type)
+{
+    fbuf->sfr.timer_msg.type = type;
+    fbuf->sfr.timer_msg.content.ptr = fbuf;
+    xtimer_set_msg(&fbuf->sfr.timer, offset, &fbuf->sfr.timer_msg,
+                   gnrc_sixlowpan_get_pid());
+}
+
+static unsigned _next_unacked(gnrc_sixlowpan_frag_fb_t *fbuf, unsigned seq)
+{
+    while ((seq <= fbuf->sfr.last_seq) && bf_isset(fbuf->sfr.acked, seq)) {
+        seq++;
+    }
+    return seq;
+}
+
+static void _copy_from_pkt(uint8_t *data, const gnrc_pktsnip_t *pkt,
+                           size_t offset, size_t len)
+{
+    while ((pkt != NULL) && (len > 0)) {
+        if (offset >= pkt->size) {
+            offset -= pkt->size;
+        }
+        else {
+            size_t chunk = pkt->size - offset;
+
+            if (chunk > len) {
+                chunk = len;
+            }
+            memcpy(data, ((uint8_t *)pkt->data) + offset, chunk);
+            data += chunk;
+            len -= chunk;
+            offset = 0;
+        }
+        pkt = pkt->next;
+    }
+}
+
+static gnrc_pktsnip_t *_build_rfrag(gnrc_sixlowpan_frag_fb_t *fbuf,
+                                    size_t frag_size, bool more)
+{
+    gnrc_netif_hdr_t *netif_hdr = fbuf->pkt->data, *new_netif_hdr;
+    gnrc_pktsnip_t *netif, *frag;
+    sixlowpan_sfr_rfrag_t *hdr;
+
+    netif = gnrc_netif_hdr_build(gnrc_netif_hdr_get_src_addr(netif_hdr),
+                                 netif_hdr->src_l2addr_len,
+                                 gnrc_netif_hdr_get_dst_addr(netif_hdr),
+                                 netif_hdr->dst_l2addr_len);
+    if (netif == NULL) {
+        DEBUG("6lo sfr: error allocating new link-layer header\n");
+        return NULL;
+    }
+    new_netif_hdr = netif->data;
+    /* src_l2addr_len and dst_l2addr_len are already the same, now copy the
+     * rest */
+    *new_netif_hdr = *netif_hdr;
+    if (more) {
+        new_netif_hdr->flags |= GNRC_NETIF_HDR_FLAGS_MORE_DATA;
+    }
+    else {
+        new_netif_hdr->flags &= ~GNRC_NETIF_HDR_FLAGS_MORE_DATA;
+    }
+    frag = gnrc_pktbuf_add(NULL, NULL, sizeof(*hdr) + frag_size,
+                           GNRC_NETTYPE_SIXLOWPAN);
+    if (frag == NULL) {
+        DEBUG("6lo sfr: error allocating fragment\n");
+        gnrc_pktbuf_release(netif);
+        return NULL;
+    }
+    hdr = frag->data;
+    memset(hdr, 0, sizeof(*hdr));
+    sixlowpan_sfr_rfrag_set_disp(&hdr->base);
+    hdr->base.tag = (uint8_t)fbuf->tag;
+    LL_PREPEND(frag, netif);
+    return frag;
+}
+
+static int _send_rfrag(gnrc_sixlowpan_frag_fb_t *fbuf, unsigned seq,
+                       bool ack_req)
+{
+    gnrc_pktsnip_t *frag;
+    sixlowpan_sfr_rfrag_t *hdr;
+    size_t offset = seq * fbuf->sfr.frag_size;
+    size_t frag_size = fbuf->datagram_size - offset;
+
+    if (frag_size > fbuf->sfr.frag_size) {
+        frag_size = fbuf->sfr.frag_size;
+    }
+    if ((frag = _build_rfrag(fbuf, frag_size, !ack_req)) == NULL) {
+        return -ENOMEM;
+    }
+    hdr = frag->next->data;
+    sixlowpan_sfr_rfrag_set_seq(hdr, seq);
+    sixlowpan_sfr_rfrag_set_frag_size(hdr, frag_size);
+    /* the first fragment carries the size of the compressed datagram */
+    sixlowpan_sfr_rfrag_set_offset(hdr, (seq == 0) ? fbuf->datagram_size
+                                                   : offset);
+    if (ack_req) {
+        sixlowpan_sfr_rfrag_set_ack_req(hdr);
+    }
+    _copy_from_pkt((uint8_t *)(hdr + 1), fbuf->pkt->next, offset, frag_size);
+    DEBUG("6lo sfr: send RFRAG %u (%u, %u) of tag %u%s\n", seq,
+          (unsigned)offset, (unsigned)frag_size, (unsigned)fbuf->tag,
+          (ack_req) ? " requesting ACK" : "");
+    gnrc_sixlowpan_dispatch_send(frag, NULL, 0);
+    _STATS_INC(sfr_frags);
+    if (seq < fbuf->sfr.high_seq) {
+        _STATS_INC(sfr_retries);
+    }
+    else {
+        fbuf->sfr.high_seq = seq + 1;
+    }
+    return 0;
+}
+
+static void _send_abort(gnrc_sixlowpan_frag_fb_t *fbuf)
+{
+    gnrc_pktsnip_t *frag;
+
+    /* sequence number, fragment size, and offset of 0 signal the abort */
+    if ((frag = _build_rfrag(fbuf, 0, false)) != NULL) {
+        DEBUG("6lo sfr: send abort for tag %u\n", (unsigned)fbuf->tag);
+        gnrc_sixlowpan_dispatch_send(frag, NULL, 0);
+    }
+}
+
+static void _send_next(gnrc_sixlowpan_frag_fb_t *fbuf)
+{
+    unsigned seq = _next_unacked(fbuf, fbuf->sfr.next_seq);
+    bool last;
+
+    if (seq > fbuf->sfr.last_seq) {
+        /* can only happen when the round started with everything
+         * acknowledged */
+        _clean_up_fbuf(fbuf, GNRC_NETERR_SUCCESS);
+        return;
+    }
+    /* request an acknowledgment for the last fragment of every round */
+    last = (fbuf->sfr.in_round <= 1) ||
+           (_next_unacked(fbuf, seq + 1) > fbuf->sfr.last_seq);
+    if (_send_rfrag(fbuf, seq, last) < 0) {
+        _clean_up_fbuf(fbuf, ENOMEM);
+        return;
+    }
+    fbuf->sfr.next_seq = seq + 1;
+    if (last) {
+        fbuf->sfr.in_round = 0;
+        _set_timer(fbuf, fbuf->sfr.arq_timeout * US_PER_MS,
+                   GNRC_SIXLOWPAN_FRAG_SFR_ARQ_TIMEOUT_MSG);
+    }
+    else {
+        fbuf->sfr.in_round--;
+        _set_timer(fbuf, GNRC_SIXLOWPAN_SFR_INTER_FRAME_GAP_US,
+                   GNRC_SIXLOWPAN_FRAG_SFR_INTER_FRAG_GAP_MSG);
+    }
+}
+
+static void _start_round(gnrc_sixlowpan_frag_fb_t *fbuf)
+{
+    fbuf->sfr.next_seq = 0;
+    fbuf->sfr.in_round = fbuf->sfr.window;
+    _send_next(fbuf);
+}
+
+static void _start_datagram(gnrc_sixlowpan_frag_fb_t *fbuf)
+{
+    memset(fbuf->sfr.acked, 0, sizeof(fbuf->sfr.acked));
+    fbuf->sfr.arq_timeout = GNRC_SIXLOWPAN_SFR_OPT_ARQ_TIMEOUT_MS;
+    fbuf->sfr.window = GNRC_SIXLOWPAN_SFR_OPT_WIN_SIZE;
+    fbuf->sfr.retries = 0;
+    fbuf->sfr.high_seq = 0;
+    _start_round(fbuf);
+}
+
+static void _abort(gnrc_sixlowpan_frag_fb_t *fbuf, bool notify)
+{
+    xtimer_remove(&fbuf->sfr.timer);
+    fbuf->sfr.timer_msg.type = 0;
+    if (notify) {
+        _send_abort(fbuf);
+    }
+    _STATS_INC(sfr_aborts);
+#if GNRC_SIXLOWPAN_SFR_DG_RETRIES > 0
+    if (fbuf->sfr.dg_retries < GNRC_SIXLOWPAN_SFR_DG_RETRIES) {
+        DEBUG("6lo sfr: retry datagram of tag %u\n", (unsigned)fbuf->tag);
+        fbuf->sfr.dg_retries++;
+        /* the receiver dropped its state for the old tag */
+        fbuf->tag = (uint8_t)gnrc_sixlowpan_frag_fb_next_tag();
+        _start_datagram(fbuf);
+        return;
+    }
+#endif
+    DEBUG("6lo sfr: abort datagram of tag %u\n", (unsigned)fbuf->tag);
+    _clean_up_fbuf(fbuf, ETIMEDOUT);
+}
+
+void gnrc_sixlowpan_frag_sfr_send(gnrc_pktsnip_t *pkt, void *ctx,
+                                  unsigned page)
+{
+    assert(ctx != NULL);
+    gnrc_sixlowpan_frag_fb_t *fbuf = ctx;
+    gnrc_netif_t *netif;
+    size_t frag_size;
+
+    assert((fbuf->pkt == pkt) || (pkt == NULL));
+    (void)pkt;
+    (void)page;
+    netif = gnrc_netif_hdr_get_netif(fbuf->pkt->data);
+    assert(netif != NULL);
+    if (netif->sixlo.max_frag_size <= sizeof(sixlowpan_sfr_rfrag_t)) {
+        DEBUG("6lo sfr: no space for fragment payload\n");
+        _clean_up_fbuf(fbuf, EMSGSIZE);
+        return;
+    }
+    frag_size = netif->sixlo.max_frag_size - sizeof(sixlowpan_sfr_rfrag_t);
+    if (frag_size > GNRC_SIXLOWPAN_SFR_OPT_FRAG_SIZE) {
+        frag_size = GNRC_SIXLOWPAN_SFR_OPT_FRAG_SIZE;
+    }
+    /* the acknowledgment bitmap limits the number of fragments */
+    if (fbuf->datagram_size > (frag_size * SIXLOWPAN_SFR_ACK_BITMAP_SIZE)) {
+        frag_size = (fbuf->datagram_size + SIXLOWPAN_SFR_ACK_BITMAP_SIZE - 1) /
+                    SIXLOWPAN_SFR_ACK_BITMAP_SIZE;
+        if ((frag_size > SIXLOWPAN_SFR_FRAG_SIZE_MAX) ||
+            ((frag_size + sizeof(sixlowpan_sfr_rfrag_t)) >
+             netif->sixlo.max_frag_size)) {
+            DEBUG("6lo sfr: datagram of %u bytes too large\n",
+                  (unsigned)fbuf->datagram_size);
+            _clean_up_fbuf(fbuf, EMSGSIZE);
+            return;
+        }
+    }
+    fbuf->sfr.frag_size = frag_size;
+    fbuf->sfr.last_seq = (fbuf->datagram_size - 1) / frag_size;
+    fbuf->sfr.dg_retries = 0;
+    DEBUG("6lo sfr: send %u bytes of tag %u in %u fragments\n",
+          (unsigned)fbuf->datagram_size, (unsigned)fbuf->tag,
+          fbuf->sfr.last_seq + 1U);
+    _start_datagram(fbuf);
+}
+
+void gnrc_sixlowpan_frag_sfr_arq_timeout(gnrc_sixlowpan_frag_fb_t *fbuf)
+{
+    if ((fbuf->pkt == NULL) ||
+        (fbuf->sfr.timer_msg.type != GNRC_SIXLOWPAN_FRAG_SFR_ARQ_TIMEOUT_MSG)) {
+        /* stale timer message */
+        return;
+    }
+    DEBUG("6lo sfr: ACK for tag %u timed out\n", (unsigned)fbuf->tag);
+    _STATS_INC(sfr_timeouts);
+    if (++fbuf->sfr.retries > GNRC_SIXLOWPAN_SFR_FRAG_RETRIES) {
+        _abort(fbuf, true);
+        return;
+    }
+    /* back off */
+    fbuf->sfr.arq_timeout *= 2;
+    if (fbuf->sfr.arq_timeout > GNRC_SIXLOWPAN_SFR_MAX_ARQ_TIMEOUT_MS) {
+        fbuf->sfr.arq_timeout = GNRC_SIXLOWPAN_SFR_MAX_ARQ_TIMEOUT_MS;
+    }
+    _start_round(fbuf);
+}
+
+void gnrc_sixlowpan_frag_sfr_inter_frame_gap(gnrc_sixlowpan_frag_fb_t *fbuf)
+{
+    if ((fbuf->pkt == NULL) ||
+        (fbuf->sfr.timer_msg.type != GNRC_SIXLOWPAN_FRAG_SFR_INTER_FRAG_GAP_MSG)) {
+        /* stale timer message */
+        return;
+    }
+    _send_next(fbuf);
+}
+
+static bool _ack_from_dst(const gnrc_sixlowpan_frag_fb_t *fbuf,
+                          const gnrc_netif_hdr_t *netif_hdr)
+{
+    const gnrc_netif_hdr_t *fbuf_hdr = fbuf->pkt->data;
+
+    return (fbuf_hdr->dst_l2addr_len == netif_hdr->src_l2addr_len) &&
+           (memcmp(gnrc_netif_hdr_get_dst_addr(fbuf_hdr),
+                   gnrc_netif_hdr_get_src_addr(netif_hdr),
+                   netif_hdr->src_l2addr_len) == 0);
+}
+
+static void _handle_ack(gnrc_sixlowpan_frag_fb_t *fbuf,
+                        sixlowpan_sfr_ack_t *ack)
+{
+    bool progress = false;
+
+    _STATS_INC(sfr_acks_recv);
+    xtimer_remove(&fbuf->sfr.timer);
+    fbuf->sfr.timer_msg.type = 0;
+    if (_bitmap_is(ack->bitmap, _null_bitmap)) {
+        DEBUG("6lo sfr: receiver aborted tag %u\n", (unsigned)fbuf->tag);
+        _abort(fbuf, false);
+        return;
+    }
+    for (unsigned seq = 0; seq <= fbuf->sfr.last_seq; seq++) {
+        if (bf_isset(ack->bitmap, seq) && !bf_isset(fbuf->sfr.acked, seq)) {
+            bf_set(fbuf->sfr.acked, seq);
+            progress = true;
+        }
+    }
+    if (_bitmap_is(ack->bitmap, _full_bitmap) ||
+        (_next_unacked(fbuf, 0) > fbuf->sfr.last_seq)) {
+        DEBUG("6lo sfr: datagram of tag %u complete\n", (unsigned)fbuf->tag);
+        _clean_up_fbuf(fbuf, GNRC_NETERR_SUCCESS);
+        return;
+    }
+    if (progress) {
+        fbuf->sfr.retries = 0;
+    }
+    else if (++fbuf->sfr.retries > GNRC_SIXLOWPAN_SFR_FRAG_RETRIES) {
+        _abort(fbuf, true);
+        return;
+    }
+    if (GNRC_SIXLOWPAN_SFR_USE_ECN) {
+        if (sixlowpan_sfr_ecn(&ack->base)) {
+            fbuf->sfr.window /= 2;
+            if (fbuf->sfr.window < GNRC_SIXLOWPAN_SFR_MIN_WIN_SIZE) {
+                fbuf->sfr.window = GNRC_SIXLOWPAN_SFR_MIN_WIN_SIZE;
+            }
+        }
+        else if (fbuf->sfr.window < GNRC_SIXLOWPAN_SFR_MAX_WIN_SIZE) {
+            fbuf->sfr.window++;
+        }
+    }
+    _start_round(fbuf);
+}
+
+/*
+ * Receiver
+ */
+static void _send_ack(const gnrc_netif_hdr_t *netif_hdr, uint8_t tag,
+                      const uint8_t *bitmap, bool ecn)
+{
+    gnrc_pktsnip_t *netif, *snip;
+    sixlowpan_sfr_ack_t *ack;
+
+    netif = gnrc_netif_hdr_build(NULL, 0,
+                                 gnrc_netif_hdr_get_src_addr(netif_hdr),
+                                 netif_hdr->src_l2addr_len);
+    if (netif == NULL) {
+        DEBUG("6lo sfr: error allocating link-layer header for ACK\n");
+        return;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = netif_hdr->if_pid;
+    snip = gnrc_pktbuf_add(NULL, NULL, sizeof(*ack), GNRC_NETTYPE_SIXLOWPAN);
+    if (snip == NULL) {
+        DEBUG("6lo sfr: error allocating ACK\n");
+        gnrc_pktbuf_release(netif);
+        return;
+    }
+    ack = snip->data;
+    ack->base.disp_ecn = 0;
+    sixlowpan_sfr_ack_set_disp(&ack->base);
+    if (ecn) {
+        sixlowpan_sfr_set_ecn(&ack->base);
+    }
+    ack->base.tag = tag;
+    memcpy(ack->bitmap, bitmap, sizeof(ack->bitmap));
+    LL_PREPEND(snip, netif);
+    DEBUG("6lo sfr: send ACK %02x%02x%02x%02x for tag %u\n", bitmap[0],
+          bitmap[1], bitmap[2], bitmap[3], tag);
+    _STATS_INC(sfr_acks_sent);
+    gnrc_sixlowpan_dispatch_send(snip, NULL, 0);
+}
+
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+static void _send_forward(gnrc_pktsnip_t *pkt,
+                          gnrc_sixlowpan_frag_vrb_t *vrbe, unsigned page)
+{
+    gnrc_pktsnip_t *netif = gnrc_netif_hdr_build(NULL, 0, vrbe->super.dst,
+                                                 vrbe->super.dst_len);
+
+    if (netif == NULL) {
+        DEBUG("6lo sfr: error allocating link-layer header for forwarding\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    gnrc_netif_hdr_set_netif(netif->data, vrbe->out_netif);
+    LL_PREPEND(pkt, netif);
+    vrbe->super.arrival = xtimer_now_usec();
+    _STATS_INC(sfr_forwarded);
+    gnrc_sixlowpan_dispatch_send(pkt, NULL, page);
+}
+
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC
+static bool _forward_first(gnrc_pktsnip_t *pkt,
+                           const gnrc_netif_hdr_t *netif_hdr, unsigned page)
+{
+    sixlowpan_sfr_rfrag_t *hdr = pkt->data, *new_hdr;
+    gnrc_sixlowpan_frag_rb_base_t base;
+    gnrc_sixlowpan_frag_vrb_t *vrbe;
+    gnrc_pktsnip_t *netif = pkt->next, *sixlo, *frag;
+    size_t frag_size = sixlowpan_sfr_rfrag_get_frag_size(hdr);
+    size_t new_size;
+
+    if ((frag_size == 0) || ((pkt->size - sizeof(*hdr)) < frag_size) ||
+        !sixlowpan_iphc_is((uint8_t *)(hdr + 1))) {
+        return false;
+    }
+    memset(&base, 0, sizeof(base));
+    memcpy(base.src, gnrc_netif_hdr_get_src_addr(netif_hdr),
+           netif_hdr->src_l2addr_len);
+    base.src_len = netif_hdr->src_l2addr_len;
+    memcpy(base.dst, gnrc_netif_hdr_get_dst_addr(netif_hdr),
+           netif_hdr->dst_l2addr_len);
+    base.dst_len = netif_hdr->dst_l2addr_len;
+    base.tag = hdr->base.tag;
+    base.datagram_size = sixlowpan_sfr_rfrag_get_offset(hdr);
+    base.current_size = frag_size;
+    base.arrival = xtimer_now_usec();
+    /* copy the compressed headers so the fragment stays intact for
+     * reassembly in case there is no route */
+    gnrc_pktbuf_hold(netif, 1);
+    sixlo = gnrc_pktbuf_add(netif, hdr + 1, frag_size, GNRC_NETTYPE_SIXLOWPAN);
+    if (sixlo == NULL) {
+        gnrc_pktbuf_release(netif);
+        return false;
+    }
+    frag = gnrc_sixlowpan_iphc_recompress(sixlo, &base, &vrbe);
+    gnrc_pktbuf_release(sixlo);
+    if (frag == NULL) {
+        return false;
+    }
+    /* tags of recoverable fragments are only 8 bit long */
+    vrbe->out_tag = (uint8_t)vrbe->out_tag;
+    new_size = gnrc_pkt_len(frag);
+    if ((new_size > SIXLOWPAN_SFR_FRAG_SIZE_MAX) ||
+        ((new_size + sizeof(*hdr)) > vrbe->out_netif->sixlo.max_frag_size)) {
+        DEBUG("6lo sfr: recompressed first fragment too large\n");
+        goto error;
+    }
+    sixlo = frag;
+    if ((frag = gnrc_pktbuf_add(sixlo, hdr, sizeof(*hdr),
+                                GNRC_NETTYPE_SIXLOWPAN)) == NULL) {
+        DEBUG("6lo sfr: error allocating header for forwarding\n");
+        frag = sixlo;
+        goto error;
+    }
+    new_hdr = frag->data;
+    new_hdr->base.tag = (uint8_t)vrbe->out_tag;
+    sixlowpan_sfr_rfrag_set_frag_size(new_hdr, new_size);
+    sixlowpan_sfr_rfrag_set_offset(new_hdr,
+                                   base.datagram_size + vrbe->offset_diff);
+    gnrc_pktbuf_release(pkt);
+    _send_forward(frag, vrbe, page);
+    return true;
+
+error:
+    gnrc_sixlowpan_frag_vrb_rm(vrbe);
+    gnrc_pktbuf_release(frag);
+    gnrc_pktbuf_release(pkt);
+    return true;
+}
+#endif  /* MODULE_GNRC_SIXLOWPAN_IPHC */
+
+static bool _forward_rfrag(gnrc_pktsnip_t *pkt,
+                           const gnrc_netif_hdr_t *netif_hdr, unsigned page)
+{
+    sixlowpan_sfr_rfrag_t *hdr = pkt->data;
+    gnrc_sixlowpan_frag_vrb_t *vrbe;
+
+    vrbe = gnrc_sixlowpan_frag_vrb_get(gnrc_netif_hdr_get_src_addr(netif_hdr),
+                                       netif_hdr->src_l2addr_len,
+                                       hdr->base.tag);
+    if ((sixlowpan_sfr_rfrag_get_seq(hdr) == 0) && !_is_abort(hdr)) {
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC
+        if ((vrbe == NULL) &&
+            gnrc_sixlowpan_frag_rb_exists(netif_hdr, hdr->base.tag)) {
+            /* already reassembling this datagram */
+            return false;
+        }
+        /* the compressed headers may change for the next hop, so every
+         * (repeated) first fragment is recompressed */
+        return _forward_first(pkt, netif_hdr, page);
+#else   /* MODULE_GNRC_SIXLOWPAN_IPHC */
+        /* without IPHC only a route learned from a previous first fragment
+         * can be used */
+        if (vrbe == NULL) {
+            return false;
+        }
+#endif  /* MODULE_GNRC_SIXLOWPAN_IPHC */
+    }
+    else if (vrbe == NULL) {
+        return false;
+    }
+    DEBUG("6lo sfr: forward RFRAG %u of tag %u as tag %u\n",
+          sixlowpan_sfr_rfrag_get_seq(hdr), hdr->base.tag, vrbe->out_tag);
+    bool abort = _is_abort(hdr);
+
+    hdr->base.tag = (uint8_t)vrbe->out_tag;
+    if (!abort && (sixlowpan_sfr_rfrag_get_seq(hdr) > 0)) {
+        sixlowpan_sfr_rfrag_set_offset(hdr, sixlowpan_sfr_rfrag_get_offset(hdr) +
+                                            vrbe->offset_diff);
+    }
+    pkt = gnrc_pktbuf_remove_snip(pkt, pkt->next);
+    _send_forward(pkt, vrbe, page);
+    if (abort) {
+        gnrc_sixlowpan_frag_vrb_rm(vrbe);
+    }
+    return true;
+}
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
+
+static void _recv_rfrag(gnrc_pktsnip_t *pkt, unsigned page)
+{
+    gnrc_pktsnip_t *netif = pkt->next;
+    gnrc_netif_hdr_t *netif_hdr = netif->data;
+    sixlowpan_sfr_rfrag_t *hdr = pkt->data;
+    gnrc_sixlowpan_frag_rb_t *rbe;
+    uint8_t tag = hdr->base.tag;
+    bool ack_req = sixlowpan_sfr_rfrag_ack_req(hdr);
+    bool ecn = sixlowpan_sfr_ecn(&hdr->base);
+
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+    if (_forward_rfrag(pkt, netif_hdr, page)) {
+        return;
+    }
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
+    if (_is_abort(hdr)) {
+        DEBUG("6lo sfr: sender aborted tag %u\n", tag);
+        _STATS_INC(sfr_aborts);
+        gnrc_sixlowpan_frag_rb_rm_by_datagram(netif_hdr, tag);
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    gnrc_pktbuf_hold(netif, 1); /* hold netif header to use it with
+                                 * dispatch_when_complete() and for the ACK
+                                 * (rb_add() releases `pkt`) */
+    rbe = gnrc_sixlowpan_frag_rb_add(netif_hdr, pkt, 0, page);
+    if (rbe == NULL) {
+        /* no state for the datagram (anymore) */
+        if (ack_req) {
+            _send_ack(netif_hdr, tag, _null_bitmap, ecn);
+        }
+    }
+    else if (rbe->super.current_size == 0) {
+        /* late duplicate of an already reassembled datagram, the previous
+         * FULL ACK might have been lost */
+        _send_ack(netif_hdr, tag, _full_bitmap, ecn);
+    }
+    else {
+        BITFIELD(bitmap, SIXLOWPAN_SFR_ACK_BITMAP_SIZE);
+        int res;
+
+        memcpy(bitmap, rbe->received, sizeof(bitmap));
+        res = gnrc_sixlowpan_frag_rb_dispatch_when_complete(rbe, netif_hdr);
+        if (res > 0) {
+            /* let the sender stop early, even without request */
+            _send_ack(netif_hdr, tag, _full_bitmap, ecn);
+        }
+        else if (res < 0) {
+            _send_ack(netif_hdr, tag, _null_bitmap, ecn);
+        }
+        else if (ack_req) {
+            _send_ack(netif_hdr, tag, bitmap, ecn);
+        }
+    }
+    gnrc_pktbuf_release(netif);
+}
+
+static void _recv_ack(gnrc_pktsnip_t *pkt, unsigned page)
+{
+    gnrc_netif_hdr_t *netif_hdr = pkt->next->data;
+    sixlowpan_sfr_ack_t *ack = pkt->data;
+    gnrc_sixlowpan_frag_fb_t *fbuf;
+
+    fbuf = gnrc_sixlowpan_frag_fb_get_by_tag(ack->base.tag);
+    if ((fbuf != NULL) && _ack_from_dst(fbuf, netif_hdr)) {
+        DEBUG("6lo sfr: received ACK for tag %u\n", ack->base.tag);
+        _handle_ack(fbuf, ack);
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+    gnrc_sixlowpan_frag_vrb_t *vrbe = gnrc_sixlowpan_frag_vrb_reverse(
+            gnrc_netif_hdr_get_netif(netif_hdr),
+            gnrc_netif_hdr_get_src_addr(netif_hdr), netif_hdr->src_l2addr_len,
+            ack->base.tag
+        );
+
+    if (vrbe != NULL) {
+        gnrc_pktsnip_t *netif = gnrc_netif_hdr_build(NULL, 0, vrbe->super.src,
+                                                     vrbe->super.src_len);
+
+        DEBUG("6lo sfr: relay ACK for tag %u as tag %u\n", ack->base.tag,
+              vrbe->super.tag);
+        if (netif == NULL) {
+            DEBUG("6lo sfr: error allocating link-layer header for ACK\n");
+            gnrc_pktbuf_release(pkt);
+            return;
+        }
+        /* the reassembly buffer base does not record the incoming interface,
+         * so relay over the interface the ACK was received on */
+        ((gnrc_netif_hdr_t *)netif->data)->if_pid = netif_hdr->if_pid;
+        ack->base.tag = vrbe->super.tag;
+        if (_bitmap_is(ack->bitmap, _null_bitmap) ||
+            _bitmap_is(ack->bitmap, _full_bitmap)) {
+            /* datagram is either aborted or complete */
+            gnrc_sixlowpan_frag_vrb_rm(vrbe);
+        }
+        else {
+            vrbe->super.arrival = xtimer_now_usec();
+        }
+        pkt = gnrc_pktbuf_remove_snip(pkt, pkt->next);
+        LL_PREPEND(pkt, netif);
+        gnrc_sixlowpan_dispatch_send(pkt, NULL, page);
+        return;
+    }
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
+    (void)page;
+    DEBUG("6lo sfr: no datagram for ACK of tag %u\n", ack->base.tag);
+    gnrc_pktbuf_release(pkt);
+}
+
+void gnrc_sixlowpan_frag_sfr_recv(gnrc_pktsnip_t *pkt, void *ctx,
+                                  unsigned page)
+{
+    sixlowpan_sfr_t *hdr = pkt->data;
+
+    (void)ctx;
+    if (sixlowpan_sfr_rfrag_is(hdr) &&
+        (pkt->size >= sizeof(sixlowpan_sfr_rfrag_t))) {
+        _recv_rfrag(pkt, page);
+    }
+    else if (sixlowpan_sfr_ack_is(hdr) &&
+             (pkt->size >= sizeof(sixlowpan_sfr_ack_t))) {
+        _recv_ack(pkt, page);
+    }
+    else {
+        DEBUG("6lo sfr: invalid selective fragment recovery header\n");
+        gnrc_pktbuf_release(pkt);
+    }
+}
+
+/** @} */
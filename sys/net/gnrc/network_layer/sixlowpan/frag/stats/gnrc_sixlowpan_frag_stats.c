@@ -13,10 +13,37 @@
  * @author  Martine Lenders <m.lenders@fu-berlin.de>
  */
 
+#include "metrics.h"
 #include "net/gnrc/sixlowpan/frag/stats.h"
 
 static gnrc_sixlowpan_frag_stats_t _stats;
 
+#ifdef MODULE_METRICS
+static const metrics_entry_t _metrics_entries[] = {
+    METRICS_ENTRY(METRICS_UINT, "rbuf_full", _stats, rbuf_full),
+    METRICS_ENTRY(METRICS_UINT, "frag_full", _stats, frag_full),
+    METRICS_ENTRY(METRICS_UINT, "datagrams", _stats, datagrams),
+    METRICS_ENTRY(METRICS_UINT, "fragments", _stats, fragments),
+    METRICS_ENTRY(METRICS_UINT, "rbuf_lookups", _stats, rbuf_lookups),
+    METRICS_ENTRY(METRICS_UINT, "rbuf_probes", _stats, rbuf_probes),
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+    METRICS_ENTRY(METRICS_UINT, "vrb_full", _stats, vrb_full),
+#endif
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    METRICS_ENTRY(METRICS_UINT, "sfr_frags", _stats, sfr_frags),
+    METRICS_ENTRY(METRICS_UINT, "sfr_retries", _stats, sfr_retries),
+    METRICS_ENTRY(METRICS_UINT, "sfr_forwarded", _stats, sfr_forwarded),
+    METRICS_ENTRY(METRICS_UINT, "sfr_acks_sent", _stats, sfr_acks_sent),
+    METRICS_ENTRY(METRICS_UINT, "sfr_acks_recv", _stats, sfr_acks_recv),
+    METRICS_ENTRY(METRICS_UINT, "sfr_timeouts", _stats, sfr_timeouts),
+    METRICS_ENTRY(METRICS_UINT, "sfr_aborts", _stats, sfr_aborts),
+#endif
+};
+
+metrics_group_t gnrc_sixlowpan_frag_metrics = METRICS_GROUP("6lo_frag", _stats,
+                                                            _metrics_entries);
+#endif
+
 gnrc_sixlowpan_frag_stats_t *gnrc_sixlowpan_frag_stats_get(void)
 {
     return &_stats;
@@ -69,6 +69,9 @@ gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_add(
                 memcpy(vrbe->super.dst, out_dst, out_dst_len);
                 vrbe->out_tag = gnrc_sixlowpan_frag_fb_next_tag();
                 vrbe->super.dst_len = out_dst_len;
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR)
+                vrbe->offset_diff = 0;
+#endif
                 DEBUG("6lo vrb: creating entry (%s, ",
                       gnrc_netif_addr_to_str(vrbe->super.src,
                                              vrbe->super.src_len,
@@ -83,6 +86,16 @@ gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_add(
                                              vrbe->super.dst_len,
                                              addr_str), vrbe->out_tag);
             }
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_RB_BITMAP)
+            /* _equal_index() => merge intervals of `base`, so they don't get
+             * lost */
+            else {
+                for (unsigned j = 0; j < sizeof(base->bitmap.received); j++) {
+                    vrbe->super.bitmap.received[j] |= base->bitmap.received[j];
+                    vrbe->super.bitmap.starts[j] |= base->bitmap.starts[j];
+                }
+            }
+#else
             /* _equal_index() => append intervals of `base`, so they don't get
              * lost. We use append, so we don't need to change base! */
             else if (base->ints != NULL) {
@@ -111,6 +124,7 @@ gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_add(
                     }
                 }
             }
+#endif
             break;
         }
     }
@@ -186,6 +200,31 @@ gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_get(
     return NULL;
 }
 
+gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_reverse(
+        const gnrc_netif_t *netif, const uint8_t *dst, size_t dst_len,
+        unsigned out_tag)
+{
+    DEBUG("6lo vrb: trying to get entry for reverse (%s, %u)\n",
+          gnrc_netif_addr_to_str(dst, dst_len, addr_str), out_tag);
+    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
+        gnrc_sixlowpan_frag_vrb_t *vrbe = &_vrb[i];
+
+        if (!gnrc_sixlowpan_frag_vrb_entry_empty(vrbe) &&
+            (vrbe->out_tag == out_tag) &&
+            ((netif == NULL) || (vrbe->out_netif == netif)) &&
+            (vrbe->super.dst_len == dst_len) &&
+            (memcmp(vrbe->super.dst, dst, dst_len) == 0)) {
+            DEBUG("6lo vrb: got VRB entry from (%s, %u)\n",
+                  gnrc_netif_addr_to_str(vrbe->super.src,
+                                         vrbe->super.src_len,
+                                         addr_str), vrbe->super.tag);
+            return vrbe;
+        }
+    }
+    DEBUG("6lo vrb: no entry found\n");
+    return NULL;
+}
+
 void gnrc_sixlowpan_frag_vrb_gc(void)
 {
     uint32_t now_usec = xtimer_now_usec();
@@ -17,10 +17,14 @@
 #include "thread.h"
 #include "utlist.h"
 
+#include "net/gnrc/ipv6.h"
 #include "net/gnrc/ipv6/hdr.h"
 #include "net/gnrc/sixlowpan.h"
 #include "net/gnrc/sixlowpan/frag.h"
 #include "net/gnrc/sixlowpan/frag/rb.h"
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR)
+#include "net/gnrc/sixlowpan/frag/sfr.h"
+#endif
 #include "net/gnrc/sixlowpan/iphc.h"
 #include "net/gnrc/netif.h"
 #include "net/sixlowpan.h"
@@ -30,19 +34,26 @@
 
 static kernel_pid_t _pid = KERNEL_PID_UNDEF;
 
+#if !IS_USED(MODULE_GNRC_SINGLE_THREAD)
 #if ENABLE_DEBUG
 static char _stack[GNRC_SIXLOWPAN_STACK_SIZE + THREAD_EXTRA_STACKSIZE_PRINTF];
 #else
 static char _stack[GNRC_SIXLOWPAN_STACK_SIZE];
 #endif
+#endif
 
 
 /* handles GNRC_NETAPI_MSG_TYPE_RCV commands */
 static void _receive(gnrc_pktsnip_t *pkt);
 /* handles GNRC_NETAPI_MSG_TYPE_SND commands */
 static void _send(gnrc_pktsnip_t *pkt);
+#if IS_USED(MODULE_GNRC_SINGLE_THREAD)
+/* netreg callback running 6LoWPAN in the IPv6 thread */
+static void _netapi_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx);
+#else
 /* Main event loop for 6LoWPAN */
 static void *_event_loop(void *args);
+#endif
 
 kernel_pid_t gnrc_sixlowpan_init(void)
 {
@@ -50,8 +61,21 @@ kernel_pid_t gnrc_sixlowpan_init(void)
         return _pid;
     }
 
+#if IS_USED(MODULE_GNRC_SINGLE_THREAD)
+    static gnrc_netreg_entry_cbd_t cbd = { .cb = _netapi_cb };
+    static gnrc_netreg_entry_t me_reg = GNRC_NETREG_ENTRY_INIT_CB(
+                                            GNRC_NETREG_DEMUX_CTX_ALL, &cbd
+                                        );
+
+    _pid = gnrc_ipv6_init();
+    if (_pid > KERNEL_PID_UNDEF) {
+        /* register interest in all 6LoWPAN packets */
+        gnrc_netreg_register(GNRC_NETTYPE_SIXLOWPAN, &me_reg);
+    }
+#else
     _pid = thread_create(_stack, sizeof(_stack), GNRC_SIXLOWPAN_PRIO,
                          THREAD_CREATE_STACKTEST, _event_loop, NULL, "6lo");
+#endif
 
     return _pid;
 }
@@ -117,6 +141,33 @@ void gnrc_sixlowpan_multiplex_by_size(gnrc_pktsnip_t *pkt,
         DEBUG("6lo: Dispatch for sending\n");
         gnrc_sixlowpan_dispatch_send(pkt, NULL, page);
     }
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR)
+    else {
+        DEBUG("6lo: Send in recoverable fragments (%u > %u)\n",
+              (unsigned int)datagram_size, netif->sixlo.max_frag_size);
+        gnrc_sixlowpan_frag_fb_t *fbuf;
+
+        (void)orig_datagram_size;
+        fbuf = gnrc_sixlowpan_frag_fb_get();
+        if (fbuf == NULL) {
+            DEBUG("6lo: Not enough resources to fragment packet. "
+                  "Dropping packet\n");
+            gnrc_pktbuf_release_error(pkt, ENOMEM);
+            return;
+        }
+        fbuf->pkt = pkt;
+        /* offsets of recoverable fragments refer to the compressed datagram */
+        fbuf->datagram_size = datagram_size;
+        /* tags of recoverable fragments are only 8 bit long */
+        fbuf->tag = (uint8_t)gnrc_sixlowpan_frag_fb_next_tag();
+        fbuf->offset = 0;
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_HINT
+        fbuf->hint.fragsz = 0;
+#endif
+
+        gnrc_sixlowpan_frag_sfr_send(pkt, fbuf, page);
+    }
+#else   /* MODULE_GNRC_SIXLOWPAN_FRAG_SFR */
 #ifdef MODULE_GNRC_SIXLOWPAN_FRAG
     else if (orig_datagram_size <= SIXLOWPAN_FRAG_MAX_LEN) {
         DEBUG("6lo: Send fragmented (%u > %u)\n",
@@ -148,6 +199,7 @@ void gnrc_sixlowpan_multiplex_by_size(gnrc_pktsnip_t *pkt,
               (unsigned int)datagram_size, netif->sixlo.max_frag_size);
         gnrc_pktbuf_release_error(pkt, EMSGSIZE);
     }
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_SFR */
 }
 
 static void _receive(gnrc_pktsnip_t *pkt)
@@ -212,6 +264,13 @@ static void _receive(gnrc_pktsnip_t *pkt)
         payload->type = GNRC_NETTYPE_UNDEF;
 #endif
     }
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR)
+    else if (sixlowpan_sfr_is((sixlowpan_sfr_t *)dispatch)) {
+        DEBUG("6lo: received 6LoWPAN recoverable fragment or ACK\n");
+        gnrc_sixlowpan_frag_sfr_recv(pkt, NULL, 0);
+        return;
+    }
+#endif
 #ifdef MODULE_GNRC_SIXLOWPAN_FRAG
     else if (sixlowpan_frag_is((sixlowpan_frag_t *)dispatch)) {
         DEBUG("6lo: received 6LoWPAN fragment\n");
@@ -306,6 +365,93 @@ static void _send(gnrc_pktsnip_t *pkt)
     gnrc_sixlowpan_multiplex_by_size(pkt, datagram_size, netif, 0);
 }
 
+bool gnrc_sixlowpan_handle_msg(msg_t *msg)
+{
+    switch (msg->type) {
+        case GNRC_NETAPI_MSG_TYPE_RCV:
+#if IS_USED(MODULE_GNRC_SINGLE_THREAD)
+            if (((gnrc_pktsnip_t *)msg->content.ptr)->type !=
+                GNRC_NETTYPE_SIXLOWPAN) {
+                /* IPv6 packet for the IPv6 thread we are running in */
+                return false;
+            }
+#endif
+            DEBUG("6lo: GNRC_NETDEV_MSG_TYPE_RCV received\n");
+            _receive(msg->content.ptr);
+            break;
+
+#if IS_USED(MODULE_GNRC_SINGLE_THREAD)
+        case GNRC_SIXLOWPAN_MSG_SND:
+#else
+        case GNRC_NETAPI_MSG_TYPE_SND:
+#endif
+            DEBUG("6lo: GNRC_NETDEV_MSG_TYPE_SND received\n");
+            _send(msg->content.ptr);
+            break;
+
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_FB
+        case GNRC_SIXLOWPAN_FRAG_FB_SND_MSG:
+            DEBUG("6lo: send fragmented event received\n");
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG
+            gnrc_sixlowpan_frag_send(NULL, msg->content.ptr, 0);
+#else   /* MODULE_GNRC_SIXLOWPAN_FRAG_FB */
+            DEBUG("6lo: No fragmentation implementation available to sent\n");
+            assert(false);
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_FB */
+            break;
+#endif
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR)
+        case GNRC_SIXLOWPAN_FRAG_SFR_ARQ_TIMEOUT_MSG:
+            DEBUG("6lo: ARQ timeout event received\n");
+            gnrc_sixlowpan_frag_sfr_arq_timeout(msg->content.ptr);
+            break;
+        case GNRC_SIXLOWPAN_FRAG_SFR_INTER_FRAG_GAP_MSG:
+            DEBUG("6lo: inter-frame gap event received\n");
+            gnrc_sixlowpan_frag_sfr_inter_frame_gap(msg->content.ptr);
+            break;
+#endif
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_RB
+        case GNRC_SIXLOWPAN_FRAG_RB_GC_MSG:
+            DEBUG("6lo: garbage collect reassembly buffer event received\n");
+            gnrc_sixlowpan_frag_rb_gc();
+            break;
+        case GNRC_SIXLOWPAN_FRAG_RB_RECLAIM_MSG:
+            DEBUG("6lo: reclaim reassembly buffer event received\n");
+            gnrc_sixlowpan_frag_rb_reclaim();
+            break;
+#endif
+
+        default:
+            return false;
+    }
+    return true;
+}
+
+#if IS_USED(MODULE_GNRC_SINGLE_THREAD)
+static void _netapi_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    msg_t msg = { .content = { .ptr = pkt } };
+
+    (void)ctx;
+    if (thread_getpid() == _pid) {
+        /* run to completion, no need to go through the message queue */
+        if (cmd == GNRC_NETAPI_MSG_TYPE_RCV) {
+            _receive(pkt);
+        }
+        else {
+            _send(pkt);
+        }
+        return;
+    }
+    /* called by an interface thread, hand over to the IPv6 thread */
+    msg.type = (cmd == GNRC_NETAPI_MSG_TYPE_RCV) ? GNRC_NETAPI_MSG_TYPE_RCV
+                                                : GNRC_SIXLOWPAN_MSG_SND;
+    if (msg_try_send(&msg, _pid) < 1) {
+        DEBUG("6lo: unable to queue packet to %" PRIkernel_pid "\n", _pid);
+        gnrc_pktbuf_release_error(pkt, EIO);
+    }
+}
+#else
 static void *_event_loop(void *args)
 {
     msg_t msg, reply, msg_q[GNRC_SIXLOWPAN_MSG_QUEUE_SIZE];
@@ -326,40 +472,16 @@ static void *_event_loop(void *args)
         DEBUG("6lo: waiting for incoming message.\n");
         msg_receive(&msg);
 
+        if (gnrc_sixlowpan_handle_msg(&msg)) {
+            continue;
+        }
         switch (msg.type) {
-            case GNRC_NETAPI_MSG_TYPE_RCV:
-                DEBUG("6lo: GNRC_NETDEV_MSG_TYPE_RCV received\n");
-                _receive(msg.content.ptr);
-                break;
-
-            case GNRC_NETAPI_MSG_TYPE_SND:
-                DEBUG("6lo: GNRC_NETDEV_MSG_TYPE_SND received\n");
-                _send(msg.content.ptr);
-                break;
-
             case GNRC_NETAPI_MSG_TYPE_GET:
             case GNRC_NETAPI_MSG_TYPE_SET:
                 DEBUG("6lo: reply to unsupported get/set\n");
                 reply.content.value = -ENOTSUP;
                 msg_reply(&msg, &reply);
                 break;
-#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_FB
-            case GNRC_SIXLOWPAN_FRAG_FB_SND_MSG:
-                DEBUG("6lo: send fragmented event received\n");
-#ifdef MODULE_GNRC_SIXLOWPAN_FRAG
-                gnrc_sixlowpan_frag_send(NULL, msg.content.ptr, 0);
-#else   /* MODULE_GNRC_SIXLOWPAN_FRAG_FB */
-                DEBUG("6lo: No fragmentation implementation available to sent\n");
-                assert(false);
-#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_FB */
-                break;
-#endif
-#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_RB
-            case GNRC_SIXLOWPAN_FRAG_RB_GC_MSG:
-                DEBUG("6lo: garbage collect reassembly buffer event received\n");
-                gnrc_sixlowpan_frag_rb_gc();
-                break;
-#endif
 
             default:
                 DEBUG("6lo: operation not supported\n");
@@ -369,5 +491,6 @@ static void *_event_loop(void *args)
 
     return NULL;
 }
+#endif
 
 /** @} */
@@ -17,6 +17,7 @@
  */
 
 #include <stdbool.h>
+#include <stddef.h>
 
 #include "byteorder.h"
 #include "net/ipv6/hdr.h"
@@ -35,6 +36,10 @@
 #include "net/gnrc/nettype.h"
 #include "net/gnrc/udp.h"
 #include "od.h"
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_IPHC_CACHE)
+#include "irq.h"
+#include "xtimer.h"
+#endif
 
 #include "net/gnrc/sixlowpan/iphc.h"
 
@@ -681,6 +686,86 @@ static size_t _iphc_nhc_udp_decode(gnrc_pktsnip_t *sixlo, size_t offset,
 }
 #endif
 
+/**
+ * @brief   Decodes the IPHC header and all NHC headers following it
+ *
+ * @param[in] sixlo                 The IPHC encoded packet
+ * @param[in] netif_hdr             The network interface header of @p sixlo
+ * @param[in] iface                 The network interface @p sixlo was
+ *                                  received on
+ * @param[in] rbuf                  Reassembly buffer entry if @p ipv6 is a
+ *                                  fragmented datagram. May be NULL, if @p ipv6
+ *                                  is not fragmented
+ * @param[out] ipv6                 The packet to write the decoded headers to
+ * @param[in,out] uncomp_hdr_len    Number of bytes decoded into @p ipv6
+ *
+ * @return  The offset of the payload in @p sixlo on success.
+ * @return  0 on error.
+ */
+static size_t _iphc_decode(gnrc_pktsnip_t *sixlo,
+                           const gnrc_netif_hdr_t *netif_hdr,
+                           gnrc_netif_t *iface,
+                           const gnrc_sixlowpan_frag_rb_t *rbuf,
+                           gnrc_pktsnip_t *ipv6, size_t *uncomp_hdr_len)
+{
+    uint8_t *iphc_hdr = sixlo->data;
+    size_t payload_offset;
+
+    payload_offset = _iphc_ipv6_decode(iphc_hdr, netif_hdr, iface,
+                                       ipv6->data);
+    if (payload_offset == 0) {
+        return 0;
+    }
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_NHC
+    if (iphc_hdr[IPHC1_IDX] & SIXLOWPAN_IPHC1_NH) {
+        bool nhc_header = true;
+        ipv6_hdr_t *ipv6_hdr = ipv6->data;
+        size_t prev_nh_offset = (&ipv6_hdr->nh) - ((uint8_t *)ipv6->data);
+
+        while (nhc_header) {
+            switch (iphc_hdr[payload_offset] & NHC_ID_MASK) {
+                case NHC_IPV6_EXT_ID:
+                case NHC_IPV6_EXT_ID_ALT:
+                    payload_offset = _iphc_nhc_ipv6_decode(sixlo,
+                                                           payload_offset,
+                                                           rbuf,
+                                                           &prev_nh_offset,
+                                                           ipv6,
+                                                           uncomp_hdr_len);
+                    if (payload_offset == 0) {
+                        return 0;
+                    }
+                    /* prev_nh_offset is set to 0 if next header is not
+                     * compressed (== NH flag in compression header not set) */
+                    nhc_header = (prev_nh_offset > 0);
+                    break;
+                case NHC_UDP_ID: {
+                    payload_offset = _iphc_nhc_udp_decode(sixlo,
+                                                          payload_offset,
+                                                          rbuf,
+                                                          prev_nh_offset,
+                                                          ipv6,
+                                                          uncomp_hdr_len);
+                    if (payload_offset == 0) {
+                        return 0;
+                    }
+                    /* no NHC after UDP header */
+                    nhc_header = false;
+                    break;
+                }
+                default:
+                    nhc_header = false;
+                    break;
+            }
+        }
+    }
+#else   /* MODULE_GNRC_SIXLOWPAN_IPHC_NHC */
+    (void)rbuf;
+    (void)uncomp_hdr_len;
+#endif  /* MODULE_GNRC_SIXLOWPAN_IPHC_NHC */
+    return payload_offset;
+}
+
 static inline void _recv_error_release(gnrc_pktsnip_t *sixlo,
                                        gnrc_pktsnip_t *ipv6,
                                        gnrc_sixlowpan_frag_rb_t *rbuf) {
@@ -698,7 +783,6 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
     gnrc_pktsnip_t *ipv6, *netif;
     gnrc_netif_t *iface;
     ipv6_hdr_t *ipv6_hdr;
-    uint8_t *iphc_hdr = sixlo->data;
     size_t payload_offset;
     size_t uncomp_hdr_len = sizeof(ipv6_hdr_t);
     gnrc_sixlowpan_frag_rb_t *rbuf = rbuf_ptr;
@@ -724,59 +808,13 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
     netif = gnrc_pktsnip_search_type(sixlo, GNRC_NETTYPE_NETIF);
     assert(netif != NULL);
     iface = gnrc_netif_hdr_get_netif(netif->data);
-    payload_offset = _iphc_ipv6_decode(iphc_hdr, netif->data, iface,
-                                       ipv6->data);
+    payload_offset = _iphc_decode(sixlo, netif->data, iface, rbuf, ipv6,
+                                  &uncomp_hdr_len);
     if (payload_offset == 0) {
         /* unable to parse IPHC header */
         _recv_error_release(sixlo, ipv6, rbuf);
         return;
     }
-#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_NHC
-    if (iphc_hdr[IPHC1_IDX] & SIXLOWPAN_IPHC1_NH) {
-        bool nhc_header = true;
-        ipv6_hdr = ipv6->data;
-        size_t prev_nh_offset = (&ipv6_hdr->nh) - ((uint8_t *)ipv6->data);
-
-        while (nhc_header) {
-            switch (iphc_hdr[payload_offset] & NHC_ID_MASK) {
-                case NHC_IPV6_EXT_ID:
-                case NHC_IPV6_EXT_ID_ALT:
-                    payload_offset = _iphc_nhc_ipv6_decode(sixlo,
-                                                           payload_offset,
-                                                           rbuf,
-                                                           &prev_nh_offset,
-                                                           ipv6,
-                                                           &uncomp_hdr_len);
-                    if (payload_offset == 0) {
-                        _recv_error_release(sixlo, ipv6, rbuf);
-                        return;
-                    }
-                    /* prev_nh_offset is set to 0 if next header is not
-                     * compressed (== NH flag in compression header not set) */
-                    nhc_header = (prev_nh_offset > 0);
-                    break;
-                case NHC_UDP_ID: {
-                    payload_offset = _iphc_nhc_udp_decode(sixlo,
-                                                          payload_offset,
-                                                          rbuf,
-                                                          prev_nh_offset,
-                                                          ipv6,
-                                                          &uncomp_hdr_len);
-                    if (payload_offset == 0) {
-                        _recv_error_release(sixlo, ipv6, rbuf);
-                        return;
-                    }
-                    /* no NHC after UDP header */
-                    nhc_header = false;
-                    break;
-                }
-                default:
-                    nhc_header = false;
-                    break;
-            }
-        }
-    }
-#endif
     uint16_t payload_len;
     if (rbuf != NULL) {
         /* for a fragmented datagram we know the overall length already */
@@ -846,8 +884,10 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
                 if ((res = _forward_frag(ipv6, sixlo->next, vrbe, page)) == 0) {
                     DEBUG("6lo iphc: successfully recompressed and forwarded "
                           "1st fragment\n");
+#if !IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_RB_BITMAP)
                     /* empty list, as it should be in VRB now */
                     rbuf->super.ints = NULL;
+#endif
                 }
             }
             if ((ipv6 == NULL) || (res < 0)) {
@@ -938,6 +978,71 @@ static int _forward_frag(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *frag_hdr,
     (void)page;
     return -ENOTSUP;
 }
+
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR)
+gnrc_pktsnip_t *gnrc_sixlowpan_iphc_recompress(gnrc_pktsnip_t *sixlo,
+        const gnrc_sixlowpan_frag_rb_base_t *base,
+        gnrc_sixlowpan_frag_vrb_t **vrbe)
+{
+    assert((sixlo != NULL) && (base != NULL) && (vrbe != NULL));
+    gnrc_pktsnip_t *ipv6, *netif;
+    gnrc_netif_t *iface;
+    ipv6_hdr_t *ipv6_hdr;
+    size_t payload_offset;
+    size_t uncomp_hdr_len = sizeof(ipv6_hdr_t);
+
+    *vrbe = NULL;
+    netif = gnrc_pktsnip_search_type(sixlo, GNRC_NETTYPE_NETIF);
+    assert(netif != NULL);
+    iface = gnrc_netif_hdr_get_netif(netif->data);
+    ipv6 = gnrc_pktbuf_add(NULL, NULL, sizeof(ipv6_hdr_t), GNRC_NETTYPE_IPV6);
+    if (ipv6 == NULL) {
+        DEBUG("6lo iphc: unable to allocate IPv6 header for recompression\n");
+        return NULL;
+    }
+    payload_offset = _iphc_decode(sixlo, netif->data, iface, NULL, ipv6,
+                                  &uncomp_hdr_len);
+    ipv6_hdr = ipv6->data;
+    if ((payload_offset == 0) || (payload_offset > sixlo->size) ||
+        (ipv6_hdr->hl <= 1U) ||
+        !(*vrbe = gnrc_sixlowpan_frag_vrb_from_route(base, iface, ipv6))) {
+        DEBUG("6lo iphc: unable to find route for first fragment\n");
+        gnrc_pktbuf_release(ipv6);
+        return NULL;
+    }
+    ipv6_hdr->hl--;
+    if (gnrc_pktbuf_realloc_data(ipv6, uncomp_hdr_len + sixlo->size -
+                                 payload_offset) != 0) {
+        DEBUG("6lo iphc: no space left to copy payload\n");
+        goto error;
+    }
+    memcpy(((uint8_t *)ipv6->data) + uncomp_hdr_len,
+           ((uint8_t *)sixlo->data) + payload_offset,
+           sixlo->size - payload_offset);
+    if ((netif = gnrc_netif_hdr_build(NULL, 0, NULL, 0)) == NULL) {
+        DEBUG("6lo iphc: unable to allocate netif header\n");
+        goto error;
+    }
+    LL_APPEND(ipv6, netif);
+    if ((ipv6 = _encode_frag_for_forwarding(ipv6, *vrbe)) == NULL) {
+        gnrc_sixlowpan_frag_vrb_rm(*vrbe);
+        *vrbe = NULL;
+        return NULL;
+    }
+    /* compressed headers may be shorter or longer now, so later fragments
+     * need to be shifted by that difference */
+    (*vrbe)->offset_diff = (int16_t)(gnrc_pkt_len(ipv6->next) - sixlo->size);
+    /* the fragmentation header is added by the caller, so remove the netif
+     * header added for _encode_frag_for_forwarding() */
+    return gnrc_pktbuf_remove_snip(ipv6, ipv6);
+
+error:
+    gnrc_sixlowpan_frag_vrb_rm(*vrbe);
+    *vrbe = NULL;
+    gnrc_pktbuf_release(ipv6);
+    return NULL;
+}
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_SFR */
 #endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
 
 static inline bool _compressible_nh(uint8_t nh)
@@ -1483,6 +1588,151 @@ static inline bool _compressible(gnrc_pktsnip_t *hdr)
     }
 }
 
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_IPHC_CACHE)
+/* longest IPv6 header _iphc_ipv6_encode() produces: dispatch + CID + 4 bytes
+ * TF + NH + HL + full source and destination */
+#define IPHC_CACHE_HDR_MAX      (sizeof(ipv6_hdr_t) + 1)
+#define IPHC_CACHE_MIN_PER_US   (US_PER_SEC * 60U)
+
+typedef struct {
+    ipv6_hdr_t ipv6;        /* header the template is for, length is ignored */
+    uint32_t gen;           /* generation of the cache the template is for */
+    uint32_t expires;       /* time in microseconds the template expires */
+    uint8_t l2addr[GNRC_NETIF_L2ADDR_MAXLEN];   /* link-layer destination */
+    kernel_pid_t iface;
+    uint8_t l2addr_len;
+    uint8_t len;            /* length of iphc_hdr */
+    uint8_t iphc_hdr[IPHC_CACHE_HDR_MAX];
+} _iphc_cache_t;
+
+static _iphc_cache_t _iphc_cache[CONFIG_GNRC_SIXLOWPAN_IPHC_CACHE_SIZE];
+static unsigned _iphc_cache_next;
+/* generation 0 is never valid, so zeroed templates are never used */
+static uint32_t _iphc_cache_gen = 1;
+
+void gnrc_sixlowpan_iphc_cache_invalidate(void)
+{
+    unsigned state = irq_disable();
+
+    /* skip 0 on overflow */
+    if (++_iphc_cache_gen == 0) {
+        _iphc_cache_gen = 1;
+    }
+    irq_restore(state);
+}
+
+static inline uint32_t _iphc_cache_get_gen(void)
+{
+    unsigned state = irq_disable();
+    uint32_t gen = _iphc_cache_gen;
+
+    irq_restore(state);
+    return gen;
+}
+
+static bool _iphc_cache_match(const _iphc_cache_t *tmpl,
+                              const ipv6_hdr_t *ipv6_hdr,
+                              const gnrc_netif_hdr_t *netif_hdr,
+                              const gnrc_netif_t *iface)
+{
+    /* everything but the payload length goes into the compressed header */
+    return (tmpl->iface == iface->pid) &&
+           (tmpl->ipv6.v_tc_fl.u32 == ipv6_hdr->v_tc_fl.u32) &&
+           (memcmp(&tmpl->ipv6.nh, &ipv6_hdr->nh,
+                   sizeof(ipv6_hdr_t) - offsetof(ipv6_hdr_t, nh)) == 0) &&
+           (tmpl->l2addr_len == netif_hdr->dst_l2addr_len) &&
+           (memcmp(tmpl->l2addr, gnrc_netif_hdr_get_dst_addr(netif_hdr),
+                   netif_hdr->dst_l2addr_len) == 0);
+}
+
+/* returns the time in microseconds the compressed header stays valid based
+ * on the lifetime of the contexts it uses, 0 if it should not be cached */
+static uint32_t _iphc_cache_lifetime(const uint8_t *iphc_hdr)
+{
+    uint32_t lifetime = CONFIG_GNRC_SIXLOWPAN_IPHC_CACHE_TIMEOUT_US;
+    uint8_t cids[2] = { 0, 0 };
+    bool used[2] = {
+        (iphc_hdr[IPHC2_IDX] & SIXLOWPAN_IPHC2_SAC),
+        (iphc_hdr[IPHC2_IDX] & SIXLOWPAN_IPHC2_DAC),
+    };
+
+    if (iphc_hdr[IPHC2_IDX] & SIXLOWPAN_IPHC2_CID_EXT) {
+        cids[0] = iphc_hdr[CID_EXT_IDX] >> 4;
+        cids[1] = iphc_hdr[CID_EXT_IDX] & 0x0f;
+    }
+    for (unsigned i = 0; i < ARRAY_SIZE(cids); i++) {
+        gnrc_sixlowpan_ctx_t *ctx;
+
+        if (!used[i] ||
+            ((ctx = gnrc_sixlowpan_ctx_lookup_id(cids[i])) == NULL)) {
+            /* SAC is also set for the unspecified source address */
+            continue;
+        }
+        /* ctx->ltime is in whole minutes, so the context might already expire
+         * within the next minute */
+        if (ctx->ltime <= 1) {
+            return 0;
+        }
+        if ((uint32_t)(ctx->ltime - 1) <
+            (CONFIG_GNRC_SIXLOWPAN_IPHC_CACHE_TIMEOUT_US / IPHC_CACHE_MIN_PER_US)) {
+            lifetime = (ctx->ltime - 1) * IPHC_CACHE_MIN_PER_US;
+        }
+    }
+    return lifetime;
+}
+
+static size_t _iphc_ipv6_encode_cached(gnrc_pktsnip_t *pkt,
+                                       const gnrc_netif_hdr_t *netif_hdr,
+                                       gnrc_netif_t *iface,
+                                       uint8_t *iphc_hdr)
+{
+    const ipv6_hdr_t *ipv6_hdr = pkt->next->data;
+    uint32_t gen = _iphc_cache_get_gen();
+    uint32_t now = xtimer_now_usec();
+    _iphc_cache_t *tmpl;
+    size_t res;
+
+    assert(iface != NULL);
+    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_IPHC_CACHE_SIZE; i++) {
+        tmpl = &_iphc_cache[i];
+        if ((tmpl->gen == gen) && ((int32_t)(tmpl->expires - now) > 0) &&
+            _iphc_cache_match(tmpl, ipv6_hdr, netif_hdr, iface)) {
+            DEBUG("6lo iphc: use cached header template %u\n", i);
+            memcpy(iphc_hdr, tmpl->iphc_hdr, tmpl->len);
+            return tmpl->len;
+        }
+    }
+    res = _iphc_ipv6_encode(pkt, netif_hdr, iface, iphc_hdr);
+    if ((res == 0) || (res > IPHC_CACHE_HDR_MAX) ||
+        (netif_hdr->dst_l2addr_len > sizeof(tmpl->l2addr))) {
+        return res;
+    }
+    uint32_t lifetime = _iphc_cache_lifetime(iphc_hdr);
+
+    if (lifetime == 0) {
+        return res;
+    }
+    tmpl = &_iphc_cache[_iphc_cache_next];
+    _iphc_cache_next = (_iphc_cache_next + 1) %
+                       CONFIG_GNRC_SIXLOWPAN_IPHC_CACHE_SIZE;
+    memcpy(&tmpl->ipv6, ipv6_hdr, sizeof(tmpl->ipv6));
+    memcpy(tmpl->l2addr, gnrc_netif_hdr_get_dst_addr(netif_hdr),
+           netif_hdr->dst_l2addr_len);
+    memcpy(tmpl->iphc_hdr, iphc_hdr, res);
+    tmpl->l2addr_len = netif_hdr->dst_l2addr_len;
+    tmpl->iface = iface->pid;
+    tmpl->len = res;
+    tmpl->expires = now + lifetime;
+    /* gen was taken before compressing, so the template is never used if the
+     * cache was invalidated meanwhile */
+    tmpl->gen = gen;
+    return res;
+}
+#else   /* MODULE_GNRC_SIXLOWPAN_IPHC_CACHE */
+#define _iphc_ipv6_encode_cached(pkt, netif_hdr, iface, iphc_hdr) \
+    _iphc_ipv6_encode(pkt, netif_hdr, iface, iphc_hdr)
+#endif  /* MODULE_GNRC_SIXLOWPAN_IPHC_CACHE */
+
 static gnrc_pktsnip_t *_iphc_encode(gnrc_pktsnip_t *pkt,
                                     const gnrc_netif_hdr_t *netif_hdr,
                                     gnrc_netif_t *iface)
@@ -1538,7 +1788,7 @@ static gnrc_pktsnip_t *_iphc_encode(gnrc_pktsnip_t *pkt,
     }
 
     iphc_hdr = dispatch->data;
-    inline_pos = _iphc_ipv6_encode(pkt, netif_hdr, iface, iphc_hdr);
+    inline_pos = _iphc_ipv6_encode_cached(pkt, netif_hdr, iface, iphc_hdr);
 
     if (inline_pos == 0) {
         DEBUG("6lo iphc: error encoding IPv6 header\n");
@@ -50,6 +50,33 @@ gnrc_pktsnip_t *gnrc_pktbuf_replace_snip(gnrc_pktsnip_t *pkt,
     return pkt;
 }
 
+gnrc_pktsnip_t *gnrc_pktbuf_clone_headers(gnrc_pktsnip_t *pkt,
+                                          gnrc_pktsnip_t *payload)
+{
+    gnrc_pktsnip_t *head, *prev;
+
+    if (pkt == payload) {
+        return pkt;
+    }
+    if ((head = gnrc_pktbuf_start_write(pkt)) == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    prev = head;
+    while ((prev->next != NULL) && (prev->next != payload)) {
+        gnrc_pktsnip_t *snip = gnrc_pktbuf_start_write(prev->next);
+
+        if (snip == NULL) {
+            /* the duplicates so far hold our reference to the rest */
+            gnrc_pktbuf_release(head);
+            return NULL;
+        }
+        prev->next = snip;
+        prev = snip;
+    }
+    return head;
+}
+
 gnrc_pktsnip_t *gnrc_pktbuf_reverse_snips(gnrc_pktsnip_t *pkt)
 {
     gnrc_pktsnip_t *reversed = NULL, *ptr = pkt;
@@ -39,6 +39,7 @@
 static mutex_t _mutex = MUTEX_INIT;
 
 #ifdef MODULE_FUZZING
+#include "fuzzing.h"
 extern gnrc_pktsnip_t *gnrc_pktbuf_fuzzptr;
 #endif
 
@@ -57,10 +58,10 @@ static inline void _free(void *ptr)
         /* The fuzzing module is only enabled when building a fuzzing
          * application from the fuzzing/ subdirectory. If _free is
          * called on the crafted fuzzing packet, the setup assumes that
-         * input processing has completed and the application terminates. */
+         * input processing has completed. */
 #if defined(MODULE_FUZZING) && !defined(MODULE_GNRC_SOCK)
         if (ptr == gnrc_pktbuf_fuzzptr) {
-           exit(EXIT_SUCCESS);
+           fuzzing_done();
         }
 #endif
         mallocs--;
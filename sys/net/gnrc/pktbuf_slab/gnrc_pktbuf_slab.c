@@ -0,0 +1,519 @@
+/*
+ * Copyright (C) 2020 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup net_gnrc_pktbuf_slab
+ * @{
+ *
+ * @file
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+#include <sys/types.h>
+
+#include "mutex.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/pktbuf_slab.h"
+#include "net/gnrc/nettype.h"
+#include "net/gnrc/pkt.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define _ALIGNMENT_MASK    (sizeof(_block_t) - 1)
+
+/* fits size to byte alignment */
+#define _ALIGN(size)       (((size) + _ALIGNMENT_MASK) & ~(_ALIGNMENT_MASK))
+
+#define _SNIP_SIZE         _ALIGN(sizeof(gnrc_pktsnip_t))
+#define _SMALL_SIZE        _ALIGN(CONFIG_GNRC_PKTBUF_SLAB_SMALL_SIZE)
+#define _FRAME_SIZE        _ALIGN(CONFIG_GNRC_PKTBUF_SLAB_FRAME_SIZE)
+#define _LARGE_SIZE        _ALIGN(CONFIG_GNRC_PKTBUF_SLAB_LARGE_SIZE)
+
+/**
+ * @brief   Free list entry, stored inside of unused blocks
+ */
+typedef union _block {
+    union _block *next;
+    /* enforce strictest alignment for all blocks */
+    uint64_t u64;
+    void *ptr;
+} _block_t;
+
+typedef struct {
+    uint8_t *pool;          /**< block storage */
+    uint8_t *refs;          /**< number of snips referencing a block */
+    _block_t *free;         /**< first unused block */
+    uint16_t size;          /**< (aligned) block size */
+    uint16_t numof;         /**< number of blocks */
+    uint16_t used;          /**< number of blocks in use */
+    uint16_t max_used;      /**< high-water mark of blocks in use */
+    uint32_t fallbacks;     /**< allocations passed on to the next class */
+    uint32_t failures;      /**< allocations not served */
+} _slab_t;
+
+static mutex_t _mutex = MUTEX_INIT;
+
+static _block_t _snip_pool[CONFIG_GNRC_PKTBUF_SLAB_SNIP_NUMOF *
+                           (_SNIP_SIZE / sizeof(_block_t))];
+static _block_t _small_pool[CONFIG_GNRC_PKTBUF_SLAB_SMALL_NUMOF *
+                            (_SMALL_SIZE / sizeof(_block_t))];
+static _block_t _frame_pool[CONFIG_GNRC_PKTBUF_SLAB_FRAME_NUMOF *
+                            (_FRAME_SIZE / sizeof(_block_t))];
+static _block_t _large_pool[CONFIG_GNRC_PKTBUF_SLAB_LARGE_NUMOF *
+                            (_LARGE_SIZE / sizeof(_block_t))];
+
+static uint8_t _snip_refs[CONFIG_GNRC_PKTBUF_SLAB_SNIP_NUMOF];
+static uint8_t _small_refs[CONFIG_GNRC_PKTBUF_SLAB_SMALL_NUMOF];
+static uint8_t _frame_refs[CONFIG_GNRC_PKTBUF_SLAB_FRAME_NUMOF];
+static uint8_t _large_refs[CONFIG_GNRC_PKTBUF_SLAB_LARGE_NUMOF];
+
+static _slab_t _slabs[GNRC_PKTBUF_SLAB_NUMOF] = {
+    [GNRC_PKTBUF_SLAB_SNIP] = {
+        .pool = (uint8_t *)_snip_pool, .refs = _snip_refs,
+        .size = _SNIP_SIZE, .numof = CONFIG_GNRC_PKTBUF_SLAB_SNIP_NUMOF,
+    },
+    [GNRC_PKTBUF_SLAB_SMALL] = {
+        .pool = (uint8_t *)_small_pool, .refs = _small_refs,
+        .size = _SMALL_SIZE, .numof = CONFIG_GNRC_PKTBUF_SLAB_SMALL_NUMOF,
+    },
+    [GNRC_PKTBUF_SLAB_FRAME] = {
+        .pool = (uint8_t *)_frame_pool, .refs = _frame_refs,
+        .size = _FRAME_SIZE, .numof = CONFIG_GNRC_PKTBUF_SLAB_FRAME_NUMOF,
+    },
+    [GNRC_PKTBUF_SLAB_LARGE] = {
+        .pool = (uint8_t *)_large_pool, .refs = _large_refs,
+        .size = _LARGE_SIZE, .numof = CONFIG_GNRC_PKTBUF_SLAB_LARGE_NUMOF,
+    },
+};
+
+/* internal gnrc_pktbuf functions */
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                    gnrc_nettype_t type);
+static void *_pktbuf_alloc(size_t size);
+static void _pktbuf_free(void *data);
+
+static inline bool _slab_contains(const _slab_t *slab, const void *ptr)
+{
+    return (unsigned)((uint8_t *)ptr - slab->pool) <
+           ((unsigned)slab->size * slab->numof);
+}
+
+static inline unsigned _slab_idx(const _slab_t *slab, const void *ptr)
+{
+    return ((uint8_t *)ptr - slab->pool) / slab->size;
+}
+
+static _slab_t *_slab_of(const void *ptr)
+{
+    for (unsigned i = 0; i < GNRC_PKTBUF_SLAB_NUMOF; i++) {
+        if (_slab_contains(&_slabs[i], ptr)) {
+            return &_slabs[i];
+        }
+    }
+    return NULL;
+}
+
+static inline void _set_pktsnip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *next,
+                                void *data, size_t size, gnrc_nettype_t type)
+{
+    pkt->next = next;
+    pkt->data = data;
+    pkt->size = size;
+    pkt->type = type;
+    pkt->users = 1;
+#ifdef MODULE_GNRC_NETERR
+    pkt->err_sub = KERNEL_PID_UNDEF;
+#endif
+}
+
+static void _slab_init(_slab_t *slab)
+{
+    slab->free = NULL;
+    /* link blocks in reverse so the first block is handed out first */
+    for (unsigned i = slab->numof; i > 0; i--) {
+        _block_t *block = (_block_t *)&slab->pool[(i - 1) * slab->size];
+
+        block->next = slab->free;
+        slab->free = block;
+        slab->refs[i - 1] = 0;
+    }
+    slab->used = 0;
+    slab->max_used = 0;
+    slab->fallbacks = 0;
+    slab->failures = 0;
+}
+
+static void *_slab_alloc(_slab_t *slab)
+{
+    _block_t *block = slab->free;
+
+    if (block == NULL) {
+        return NULL;
+    }
+    slab->free = block->next;
+    slab->refs[_slab_idx(slab, block)] = 1;
+    if (++slab->used > slab->max_used) {
+        slab->max_used = slab->used;
+    }
+    return block;
+}
+
+void gnrc_pktbuf_init(void)
+{
+    static_assert(CONFIG_GNRC_PKTBUF_SLAB_SMALL_SIZE < CONFIG_GNRC_PKTBUF_SLAB_FRAME_SIZE,
+                  "small class must be smaller than frame class");
+    static_assert(CONFIG_GNRC_PKTBUF_SLAB_FRAME_SIZE < CONFIG_GNRC_PKTBUF_SLAB_LARGE_SIZE,
+                  "frame class must be smaller than large class");
+    static_assert(CONFIG_GNRC_PKTBUF_SLAB_LARGE_SIZE <= UINT16_MAX,
+                  "large class exceeds maximum block size");
+
+    mutex_lock(&_mutex);
+    for (unsigned i = 0; i < GNRC_PKTBUF_SLAB_NUMOF; i++) {
+        _slab_init(&_slabs[i]);
+    }
+    mutex_unlock(&_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt;
+
+    if (size > _LARGE_SIZE) {
+        DEBUG("pktbuf: size (%u) > CONFIG_GNRC_PKTBUF_SLAB_LARGE_SIZE (%u)\n",
+              (unsigned)size, (unsigned)CONFIG_GNRC_PKTBUF_SLAB_LARGE_SIZE);
+        return NULL;
+    }
+    mutex_lock(&_mutex);
+    pkt = _create_snip(next, data, size, type);
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *marked_snip;
+    void *new_data_marked;
+
+    mutex_lock(&_mutex);
+    if ((size == 0) || (pkt == NULL) || (size > pkt->size) || (pkt->data == NULL)) {
+        DEBUG("pktbuf: size == 0 (was %u) or pkt == NULL (was %p) or "
+              "size > pkt->size (was %u) or pkt->data == NULL (was %p)\n",
+              (unsigned)size, (void *)pkt, (pkt ? (unsigned)pkt->size : 0),
+              (pkt ? pkt->data : NULL));
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    /* create new snip descriptor for marked data */
+    marked_snip = _slab_alloc(&_slabs[GNRC_PKTBUF_SLAB_SNIP]);
+    if (marked_snip == NULL) {
+        DEBUG("pktbuf: could not allocate marked snip.\n");
+        _slabs[GNRC_PKTBUF_SLAB_SNIP].failures++;
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    new_data_marked = pkt->data;
+    if (pkt->size != size) {
+        /* both snips now reference the same block */
+        _slab_t *slab = _slab_of(pkt->data);
+
+        assert(slab != NULL);
+        assert(slab->refs[_slab_idx(slab, pkt->data)] < UINT8_MAX);
+        slab->refs[_slab_idx(slab, pkt->data)]++;
+        pkt->data = ((uint8_t *)pkt->data) + size;
+    }
+    else {
+        pkt->data = NULL;
+    }
+    pkt->size -= size;
+    _set_pktsnip(marked_snip, pkt->next, new_data_marked, size, type);
+    pkt->next = marked_snip;
+    mutex_unlock(&_mutex);
+    return marked_snip;
+}
+
+int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
+{
+    mutex_lock(&_mutex);
+    assert(pkt != NULL);
+    assert(((pkt->size == 0) && (pkt->data == NULL)) ||
+           ((pkt->size > 0) && (pkt->data != NULL) && (_slab_of(pkt->data) != NULL)));
+    /* new size and old size are equal */
+    if (size == pkt->size) {
+        /* nothing to do */
+        mutex_unlock(&_mutex);
+        return 0;
+    }
+    /* new size is 0 and data pointer isn't already NULL */
+    if ((size == 0) && (pkt->data != NULL)) {
+        /* set data pointer to NULL */
+        _pktbuf_free(pkt->data);
+        pkt->data = NULL;
+    }
+    /* if new size is bigger than old size */
+    else if (size > pkt->size) {
+        _slab_t *slab = (pkt->data != NULL) ? _slab_of(pkt->data) : NULL;
+
+        /* grow in place if nobody else references the block and it has
+         * enough room left behind the data */
+        if ((slab == NULL) || (slab->refs[_slab_idx(slab, pkt->data)] > 1) ||
+            ((((uint8_t *)pkt->data - slab->pool) % slab->size) + size > slab->size)) {
+            void *new_data = _pktbuf_alloc(size);
+
+            if (new_data == NULL) {
+                DEBUG("pktbuf: error allocating new data section\n");
+                mutex_unlock(&_mutex);
+                return ENOMEM;
+            }
+            if (pkt->data != NULL) {            /* if old data exist */
+                memcpy(new_data, pkt->data, pkt->size);
+                _pktbuf_free(pkt->data);
+            }
+            pkt->data = new_data;
+        }
+    }
+    /* a smaller size just leaves the tail of the block unused */
+    pkt->size = size;
+    mutex_unlock(&_mutex);
+    return 0;
+}
+
+void gnrc_pktbuf_hold(gnrc_pktsnip_t *pkt, unsigned int num)
+{
+    mutex_lock(&_mutex);
+    while (pkt) {
+        pkt->users += num;
+        pkt = pkt->next;
+    }
+    mutex_unlock(&_mutex);
+}
+
+static void _release_error_locked(gnrc_pktsnip_t *pkt, uint32_t err)
+{
+    while (pkt) {
+        gnrc_pktsnip_t *tmp;
+        assert(_slab_contains(&_slabs[GNRC_PKTBUF_SLAB_SNIP], pkt));
+        assert(pkt->users > 0);
+        tmp = pkt->next;
+        if (pkt->users == 1) {
+            pkt->users = 0; /* not necessary but to be on the safe side */
+            _pktbuf_free(pkt->data);
+            _pktbuf_free(pkt);
+        }
+        else {
+            pkt->users--;
+        }
+        DEBUG("pktbuf: report status code %" PRIu32 "\n", err);
+        gnrc_neterr_report(pkt, err);
+        pkt = tmp;
+    }
+}
+
+void gnrc_pktbuf_release_error(gnrc_pktsnip_t *pkt, uint32_t err)
+{
+    mutex_lock(&_mutex);
+    _release_error_locked(pkt, err);
+    mutex_unlock(&_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
+{
+    mutex_lock(&_mutex);
+    if (pkt == NULL) {
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    if (pkt->users > 1) {
+        gnrc_pktsnip_t *new;
+        new = _create_snip(pkt->next, pkt->data, pkt->size, pkt->type);
+        if (new != NULL) {
+            pkt->users--;
+        }
+        mutex_unlock(&_mutex);
+        return new;
+    }
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+int gnrc_pktbuf_slab_get_stats(gnrc_pktbuf_slab_class_t cls,
+                               gnrc_pktbuf_slab_stats_t *stats)
+{
+    const _slab_t *slab;
+
+    if ((unsigned)cls >= GNRC_PKTBUF_SLAB_NUMOF) {
+        return -EINVAL;
+    }
+    slab = &_slabs[cls];
+    mutex_lock(&_mutex);
+    stats->size = slab->size;
+    stats->numof = slab->numof;
+    stats->used = slab->used;
+    stats->max_used = slab->max_used;
+    stats->fallbacks = slab->fallbacks;
+    stats->failures = slab->failures;
+    mutex_unlock(&_mutex);
+    return 0;
+}
+
+void gnrc_pktbuf_slab_reset_stats(void)
+{
+    mutex_lock(&_mutex);
+    for (unsigned i = 0; i < GNRC_PKTBUF_SLAB_NUMOF; i++) {
+        _slabs[i].max_used = _slabs[i].used;
+        _slabs[i].fallbacks = 0;
+        _slabs[i].failures = 0;
+    }
+    mutex_unlock(&_mutex);
+}
+
+#ifdef DEVELHELP
+void gnrc_pktbuf_stats(void)
+{
+    static const char *names[] = { "snip", "small", "frame", "large" };
+
+    printf("packet buffer: slab allocator\n");
+    printf("  class  size  numof  used  max used  fallbacks  failures\n");
+    mutex_lock(&_mutex);
+    for (unsigned i = 0; i < GNRC_PKTBUF_SLAB_NUMOF; i++) {
+        const _slab_t *slab = &_slabs[i];
+
+        printf("  %-5s  %4u  %5u  %4u  %8u  %9" PRIu32 "  %8" PRIu32 "\n",
+               names[i], (unsigned)slab->size, (unsigned)slab->numof,
+               (unsigned)slab->used, (unsigned)slab->max_used,
+               slab->fallbacks, slab->failures);
+    }
+    mutex_unlock(&_mutex);
+}
+#endif
+
+#ifdef TEST_SUITES
+bool gnrc_pktbuf_is_empty(void)
+{
+    for (unsigned i = 0; i < GNRC_PKTBUF_SLAB_NUMOF; i++) {
+        if (_slabs[i].used > 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool gnrc_pktbuf_is_sane(void)
+{
+    /* Invariants of this implementation:
+     *  - forall blocks in free list of slab: block is in slab->pool
+     *  - forall blocks in free list of slab: block is at a block boundary
+     *  - forall blocks in free list of slab: block is not referenced
+     *  - number of blocks in free list of slab == slab->numof - slab->used
+     */
+    for (unsigned i = 0; i < GNRC_PKTBUF_SLAB_NUMOF; i++) {
+        const _slab_t *slab = &_slabs[i];
+        unsigned numof_free = 0;
+
+        for (_block_t *ptr = slab->free; ptr != NULL; ptr = ptr->next) {
+            if (!_slab_contains(slab, ptr) ||
+                ((((uint8_t *)ptr) - slab->pool) % slab->size) != 0 ||
+                (slab->refs[_slab_idx(slab, ptr)] != 0) ||
+                (++numof_free > slab->numof)) {
+                return false;
+            }
+        }
+        if (numof_free != (unsigned)(slab->numof - slab->used)) {
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                    gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt = _slab_alloc(&_slabs[GNRC_PKTBUF_SLAB_SNIP]);
+    void *_data = NULL;
+
+    if (pkt == NULL) {
+        DEBUG("pktbuf: error allocating new packet snip\n");
+        _slabs[GNRC_PKTBUF_SLAB_SNIP].failures++;
+        return NULL;
+    }
+    if (size > 0) {
+        _data = _pktbuf_alloc(size);
+        if (_data == NULL) {
+            DEBUG("pktbuf: error allocating data for new packet snip\n");
+            _pktbuf_free(pkt);
+            return NULL;
+        }
+        if (data != NULL) {
+            memcpy(_data, data, size);
+        }
+    }
+    _set_pktsnip(pkt, next, _data, size, type);
+    return pkt;
+}
+
+static void *_pktbuf_alloc(size_t size)
+{
+    unsigned i = GNRC_PKTBUF_SLAB_SMALL;
+
+    /* find smallest class that fits */
+    while ((i < GNRC_PKTBUF_SLAB_NUMOF) && (size > _slabs[i].size)) {
+        i++;
+    }
+    if (i == GNRC_PKTBUF_SLAB_NUMOF) {
+        DEBUG("pktbuf: %u byte do not fit any size class\n", (unsigned)size);
+        return NULL;
+    }
+    /* fall back to larger classes if exhausted */
+    for (unsigned first = i; i < GNRC_PKTBUF_SLAB_NUMOF; i++) {
+        void *data = _slab_alloc(&_slabs[i]);
+
+        if (data != NULL) {
+            return data;
+        }
+        if ((i + 1) < GNRC_PKTBUF_SLAB_NUMOF) {
+            _slabs[i].fallbacks++;
+        }
+        else {
+            _slabs[first].failures++;
+        }
+    }
+    DEBUG("pktbuf: no space left in packet buffer\n");
+    return NULL;
+}
+
+static void _pktbuf_free(void *data)
+{
+    _slab_t *slab;
+    unsigned idx;
+
+    if (data == NULL) {
+        return;
+    }
+    slab = _slab_of(data);
+    if (slab == NULL) {
+        return;
+    }
+    idx = _slab_idx(slab, data);
+    assert(slab->refs[idx] > 0);
+    if (--slab->refs[idx] == 0) {
+        _block_t *block = (_block_t *)&slab->pool[idx * slab->size];
+
+        block->next = slab->free;
+        slab->free = block;
+        slab->used--;
+    }
+}
+
+/** @} */
@@ -23,6 +23,8 @@
 #include <stdio.h>
 #include <sys/types.h>
 
+#include "kernel_defines.h"
+#include "metrics.h"
 #include "mutex.h"
 #include "od.h"
 #include "utlist.h"
@@ -49,6 +51,39 @@ static _unused_t *_first_unused;
 static uint16_t max_byte_count = 0;
 #endif
 
+#ifdef MODULE_METRICS
+static struct {
+    metrics_gauge_t used;           /* bytes allocated, after alignment */
+    metrics_gauge_t used_max;
+    metrics_counter_t alloc_failed;
+} _metrics;
+
+static const metrics_entry_t _metrics_entries[] = {
+    METRICS_ENTRY(METRICS_GAUGE, "used", _metrics, used),
+    METRICS_ENTRY(METRICS_GAUGE, "used_max", _metrics, used_max),
+    METRICS_ENTRY(METRICS_COUNTER, "alloc_failed", _metrics, alloc_failed),
+};
+
+metrics_group_t gnrc_pktbuf_metrics = METRICS_GROUP("pktbuf", _metrics,
+                                                    _metrics_entries);
+#endif
+
+#ifdef MODULE_GNRC_PKTBUF_PRESSURE
+/* snips are owned by the type they were created with, as types change while
+ * a packet is handled */
+#define _OWNER(type)    ((type) - GNRC_NETTYPE_IOVEC)
+#define _OWNER_NUMOF    (GNRC_NETTYPE_NUMOF - GNRC_NETTYPE_IOVEC)
+
+static uint16_t _owned[_OWNER_NUMOF];
+static size_t _used;                /* bytes allocated, after alignment */
+static uint16_t _fails;
+static uint16_t _lows;              /* times the watermark was crossed */
+static bool _low;
+static bool _failed;                /* allocation failed since last unlock */
+static gnrc_pktbuf_pressure_cb_t _pressure_cb;
+static void *_pressure_arg;
+#endif
+
 /* internal gnrc_pktbuf functions */
 static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size_t size,
                                     gnrc_nettype_t type);
@@ -74,11 +109,44 @@ static inline void _set_pktsnip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *next,
     pkt->size = size;
     pkt->type = type;
     pkt->users = 1;
+#ifdef MODULE_GNRC_PKTBUF_PRESSURE
+    pkt->owner = _OWNER(type);
+    _owned[pkt->owner]++;
+#endif
 #ifdef MODULE_GNRC_NETERR
     pkt->err_sub = KERNEL_PID_UNDEF;
 #endif
 }
 
+/* unlocks _mutex and tells the pressure callback about failed allocations
+ * and the free space falling below the watermark */
+static void _unlock(void)
+{
+#ifdef MODULE_GNRC_PKTBUF_PRESSURE
+    size_t avail = CONFIG_GNRC_PKTBUF_SIZE - _used;
+    gnrc_pktbuf_pressure_cb_t cb = _pressure_cb;
+    void *arg = _pressure_arg;
+    bool notify = _failed;
+
+    _failed = false;
+    if (avail >= CONFIG_GNRC_PKTBUF_LOW_WATERMARK) {
+        _low = false;
+    }
+    else if (!_low) {
+        _low = true;
+        _lows++;
+        notify = true;
+    }
+    mutex_unlock(&_mutex);
+    /* outside of the lock, so the callback may release packets */
+    if (notify && (cb != NULL)) {
+        cb(avail, arg);
+    }
+#else
+    mutex_unlock(&_mutex);
+#endif
+}
+
 void gnrc_pktbuf_init(void)
 {
     mutex_lock(&_mutex);
@@ -100,7 +168,7 @@ gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, const void *data, size_t s
     }
     mutex_lock(&_mutex);
     pkt = _create_snip(next, data, size, type);
-    mutex_unlock(&_mutex);
+    _unlock();
     return pkt;
 }
 
@@ -117,14 +185,14 @@ gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_
               "size > pkt->size (was %u) or pkt->data == NULL (was %p)\n",
               (unsigned)size, (void *)pkt, (pkt ? (unsigned)pkt->size : 0),
               (pkt ? pkt->data : NULL));
-        mutex_unlock(&_mutex);
+        _unlock();
         return NULL;
     }
     /* create new snip descriptor for marked data */
     marked_snip = _pktbuf_alloc(sizeof(gnrc_pktsnip_t));
     if (marked_snip == NULL) {
         DEBUG("pktbuf: could not reallocate marked section.\n");
-        mutex_unlock(&_mutex);
+        _unlock();
         return NULL;
     }
     /* marked data would not fit _unused_t marker => move data around to allow
@@ -135,7 +203,7 @@ gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_
         if (new_data_marked == NULL) {
             DEBUG("pktbuf: could not reallocate marked section.\n");
             _pktbuf_free(marked_snip, sizeof(gnrc_pktsnip_t));
-            mutex_unlock(&_mutex);
+            _unlock();
             return NULL;
         }
         new_data_rest = _pktbuf_alloc(pkt->size - size);
@@ -143,7 +211,7 @@ gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_
             DEBUG("pktbuf: could not reallocate remaining section.\n");
             _pktbuf_free(marked_snip, sizeof(gnrc_pktsnip_t));
             _pktbuf_free(new_data_marked, size);
-            mutex_unlock(&_mutex);
+            _unlock();
             return NULL;
         }
         memcpy(new_data_marked, pkt->data, size);
@@ -161,7 +229,7 @@ gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_
     pkt->size -= size;
     _set_pktsnip(marked_snip, pkt->next, new_data_marked, size, type);
     pkt->next = marked_snip;
-    mutex_unlock(&_mutex);
+    _unlock();
     return marked_snip;
 }
 
@@ -176,7 +244,7 @@ int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
     /* new size and old size are equal */
     if (size == pkt->size) {
         /* nothing to do */
-        mutex_unlock(&_mutex);
+        _unlock();
         return 0;
     }
     /* new size is 0 and data pointer isn't already NULL */
@@ -190,7 +258,7 @@ int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
         void *new_data = _pktbuf_alloc(size);
         if (new_data == NULL) {
             DEBUG("pktbuf: error allocating new data section\n");
-            mutex_unlock(&_mutex);
+            _unlock();
             return ENOMEM;
         }
         if (pkt->data != NULL) {            /* if old data exist */
@@ -204,7 +272,7 @@ int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
                      pkt->size - aligned_size);
     }
     pkt->size = size;
-    mutex_unlock(&_mutex);
+    _unlock();
     return 0;
 }
 
@@ -227,6 +295,9 @@ static void _release_error_locked(gnrc_pktsnip_t *pkt, uint32_t err)
         tmp = pkt->next;
         if (pkt->users == 1) {
             pkt->users = 0; /* not necessary but to be on the safe side */
+#ifdef MODULE_GNRC_PKTBUF_PRESSURE
+            _owned[pkt->owner]--;
+#endif
             _pktbuf_free(pkt->data, pkt->size);
             _pktbuf_free(pkt, sizeof(gnrc_pktsnip_t));
         }
@@ -250,7 +321,7 @@ gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
 {
     mutex_lock(&_mutex);
     if (pkt == NULL) {
-        mutex_unlock(&_mutex);
+        _unlock();
         return NULL;
     }
     if (pkt->users > 1) {
@@ -259,10 +330,10 @@ gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
         if (new != NULL) {
             pkt->users--;
         }
-        mutex_unlock(&_mutex);
+        _unlock();
         return new;
     }
-    mutex_unlock(&_mutex);
+    _unlock();
     return pkt;
 }
 
@@ -337,6 +408,44 @@ void gnrc_pktbuf_stats(void)
 }
 #endif
 
+#ifdef MODULE_GNRC_PKTBUF_PRESSURE
+void gnrc_pktbuf_set_pressure_cb(gnrc_pktbuf_pressure_cb_t cb, void *arg)
+{
+    mutex_lock(&_mutex);
+    _pressure_cb = cb;
+    _pressure_arg = arg;
+    mutex_unlock(&_mutex);
+}
+
+unsigned gnrc_pktbuf_owned(gnrc_nettype_t owner)
+{
+    return _owned[_OWNER(owner)];
+}
+
+void gnrc_pktbuf_report(void)
+{
+    uint16_t owned[_OWNER_NUMOF];
+    size_t used;
+    unsigned fails, lows;
+
+    mutex_lock(&_mutex);
+    memcpy(owned, _owned, sizeof(owned));
+    used = _used;
+    fails = _fails;
+    lows = _lows;
+    mutex_unlock(&_mutex);
+
+    printf("pktbuf: used %u/%u low %u fail %u snips",
+           (unsigned)used, CONFIG_GNRC_PKTBUF_SIZE, lows, fails);
+    for (unsigned i = 0; i < _OWNER_NUMOF; i++) {
+        if (owned[i]) {
+            printf(" %d:%u", (int)i + GNRC_NETTYPE_IOVEC, owned[i]);
+        }
+    }
+    puts("");
+}
+#endif
+
 #ifdef TEST_SUITES
 bool gnrc_pktbuf_is_empty(void)
 {
@@ -412,6 +521,13 @@ static void *_pktbuf_alloc(size_t size)
     }
     if (ptr == NULL) {
         DEBUG("pktbuf: no space left in packet buffer\n");
+#ifdef MODULE_METRICS
+        metrics_counter_inc(&_metrics.alloc_failed);
+#endif
+#ifdef MODULE_GNRC_PKTBUF_PRESSURE
+        _fails++;
+        _failed = true;
+#endif
         return NULL;
     }
     /* _unused_t struct would fit => add new space at ptr */
@@ -444,6 +560,16 @@ static void *_pktbuf_alloc(size_t size)
     if (last_byte > max_byte_count) {
         max_byte_count = last_byte;
     }
+#endif
+#ifdef MODULE_METRICS
+    metrics_gauge_add(&_metrics.used, size);
+    /* updates are serialized by _mutex */
+    if (_metrics.used > _metrics.used_max) {
+        metrics_gauge_set(&_metrics.used_max, _metrics.used);
+    }
+#endif
+#ifdef MODULE_GNRC_PKTBUF_PRESSURE
+    _used += size;
 #endif
     return (void *)ptr;
 }
@@ -476,6 +602,12 @@ static void _pktbuf_free(void *data, size_t size)
     }
     new->next = ptr;
     new->size = _align(size);
+#ifdef MODULE_METRICS
+    metrics_gauge_add(&_metrics.used, -(int32_t)new->size);
+#endif
+#ifdef MODULE_GNRC_PKTBUF_PRESSURE
+    _used -= new->size;
+#endif
     /* calculate number of bytes between new _unused_t chunk and end of packet
      * buffer */
     bytes_at_end = ((&_pktbuf[0] + CONFIG_GNRC_PKTBUF_SIZE) - (((uint8_t *)new) + new->size));
@@ -22,23 +22,37 @@
 #include "net/gnrc/pktbuf.h"
 #include "net/gnrc/priority_pktqueue.h"
 
+#if IS_USED(MODULE_GNRC_PRIORITY_PKTQUEUE_HEAP)
+typedef priority_heap_node_t _node_t;
+#define _node_init          priority_heap_node_init
+#define _add                priority_heap_add
+#define _remove_head        priority_heap_remove_head
+#define _head(queue)        ((queue)->root)
+#else
+typedef priority_queue_node_t _node_t;
+#define _node_init          priority_queue_node_init
+#define _add                priority_queue_add
+#define _remove_head        priority_queue_remove_head
+#define _head(queue)        ((queue)->first)
+#endif
+
 /******************************************************************************/
 
 static inline void _free_node(gnrc_priority_pktqueue_node_t *node)
 {
     assert(node != NULL);
 
-    priority_queue_node_init((priority_queue_node_t *)node);
+    _node_init((_node_t *)node);
 }
 
 /******************************************************************************/
 
 gnrc_pktsnip_t *gnrc_priority_pktqueue_pop(gnrc_priority_pktqueue_t *queue)
 {
-    if (!queue || (gnrc_priority_pktqueue_length(queue) == 0)) {
+    if (!queue || !_head(queue)) {
         return NULL;
     }
-    priority_queue_node_t *head = priority_queue_remove_head(queue);
+    _node_t *head = _remove_head(queue);
     gnrc_pktsnip_t *pkt = (gnrc_pktsnip_t *) head->data;
     _free_node((gnrc_priority_pktqueue_node_t *)head);
     return pkt;
@@ -48,10 +62,10 @@ gnrc_pktsnip_t *gnrc_priority_pktqueue_pop(gnrc_priority_pktqueue_t *queue)
 
 gnrc_pktsnip_t *gnrc_priority_pktqueue_head(gnrc_priority_pktqueue_t *queue)
 {
-    if (!queue || (gnrc_priority_pktqueue_length(queue) == 0)) {
+    if (!queue || !_head(queue)) {
         return NULL;
     }
-    return (gnrc_pktsnip_t *)queue->first->data;
+    return (gnrc_pktsnip_t *)_head(queue)->data;
 }
 /******************************************************************************/
 
@@ -63,7 +77,7 @@ void gnrc_priority_pktqueue_push(gnrc_priority_pktqueue_t *queue,
     assert(node->pkt != NULL);
     assert(sizeof(unsigned int) == sizeof(gnrc_pktsnip_t *));
 
-    priority_queue_add(queue, (priority_queue_node_t *)node);
+    _add(queue, (_node_t *)node);
 }
 
 /******************************************************************************/
@@ -72,11 +86,8 @@ void gnrc_priority_pktqueue_flush(gnrc_priority_pktqueue_t *queue)
 {
     assert(queue != NULL);
 
-    if (gnrc_priority_pktqueue_length(queue) == 0) {
-        return;
-    }
     gnrc_priority_pktqueue_node_t *node;
-    while ((node = (gnrc_priority_pktqueue_node_t *)priority_queue_remove_head(queue))) {
+    while ((node = (gnrc_priority_pktqueue_node_t *)_remove_head(queue))) {
         gnrc_pktbuf_release(node->pkt);
         _free_node(node);
     }
@@ -87,6 +98,9 @@ uint32_t gnrc_priority_pktqueue_length(gnrc_priority_pktqueue_t *queue)
 {
     assert(queue != NULL);
 
+#if IS_USED(MODULE_GNRC_PRIORITY_PKTQUEUE_HEAP)
+    return queue->numof;
+#else
     uint32_t length = 0;
     priority_queue_node_t *node = queue->first;
     if (!node) {
@@ -99,4 +113,5 @@ uint32_t gnrc_priority_pktqueue_length(gnrc_priority_pktqueue_t *queue)
         node = node->next;
     }
     return length;
+#endif
 }
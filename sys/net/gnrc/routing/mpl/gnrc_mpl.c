@@ -0,0 +1,381 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @author  ML!PA Consulting GmbH
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "kernel_defines.h"
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/netif/internal.h"
+#include "net/gnrc/nettype.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/ipv6/ext.h"
+#include "net/protnum.h"
+#include "random.h"
+#include "xtimer.h"
+
+#include "net/gnrc/mpl.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/**
+ * @brief   Size of the sequence number window of a seed
+ */
+#define SEQ_WINDOW      (32U)
+
+/**
+ * @brief   Hop-by-hop options header with an MPL Option using the IPv6
+ *          source as seed-id, padded to 8 bytes
+ */
+#define HBH_LEN         (sizeof(ipv6_ext_t) + sizeof(mpl_opt_t) + 2U)
+
+typedef struct {
+    uint8_t id[sizeof(ipv6_addr_t)];    /**< seed-id */
+    uint8_t id_len;                     /**< 0 if the entry is unused */
+    uint8_t min_seq;                    /**< first sequence in the window */
+    uint32_t window;                    /**< received sequence numbers */
+    uint32_t expires;                   /**< expiry in seconds */
+} _seed_t;
+
+typedef struct {
+    trickle_t trickle;                  /**< retransmission timer */
+    gnrc_pktsnip_t *pkt;                /**< NULL if the entry is unused */
+    _seed_t *seed;                      /**< seed of the message */
+    uint8_t seq;                        /**< sequence number */
+    uint8_t expirations;                /**< trickle intervals passed */
+} _msg_t;
+
+enum {
+    SEQ_NEW,
+    SEQ_DUPLICATE,
+};
+
+static const ipv6_addr_t _all_mpl_forwarders = MPL_ALL_FORWARDERS_REALM_LOCAL;
+static gnrc_netif_t *_netif;
+static uint8_t _seq;
+static _seed_t _seeds[CONFIG_GNRC_MPL_SEED_SET_SIZE];
+static _msg_t _msgs[CONFIG_GNRC_MPL_BUFFERED_MESSAGES_NUMOF];
+
+static inline uint32_t _now_sec(void)
+{
+    return (uint32_t)(xtimer_now_usec64() / US_PER_SEC);
+}
+
+static bool _seed_buffered(const _seed_t *seed)
+{
+    for (unsigned i = 0; i < ARRAY_SIZE(_msgs); i++) {
+        if ((_msgs[i].pkt != NULL) && (_msgs[i].seed == seed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static _seed_t *_seed_get(const uint8_t *id, unsigned id_len, uint8_t seq)
+{
+    uint32_t now = _now_sec();
+    _seed_t *res = NULL;
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_seeds); i++) {
+        _seed_t *seed = &_seeds[i];
+
+        if ((seed->id_len == id_len) && (memcmp(seed->id, id, id_len) == 0)) {
+            seed->expires = now + CONFIG_GNRC_MPL_SEED_SET_ENTRY_LIFETIME;
+            return seed;
+        }
+        if ((res == NULL) &&
+            ((seed->id_len == 0) ||
+             (((int32_t)(seed->expires - now) <= 0) && !_seed_buffered(seed)))) {
+            res = seed;
+        }
+    }
+    if (res != NULL) {
+        DEBUG("gnrc_mpl: new seed starting at sequence %u\n", seq);
+        memcpy(res->id, id, id_len);
+        res->id_len = id_len;
+        res->min_seq = seq;
+        res->window = 0;
+        res->expires = now + CONFIG_GNRC_MPL_SEED_SET_ENTRY_LIFETIME;
+    }
+    return res;
+}
+
+static int _seed_accept(_seed_t *seed, uint8_t seq)
+{
+    uint8_t diff = seq - seed->min_seq;
+
+    if (diff >= 128U) {
+        /* older than the window (RFC 1982 serial number arithmetic) */
+        return SEQ_DUPLICATE;
+    }
+    if (diff >= SEQ_WINDOW) {
+        unsigned shift = diff - (SEQ_WINDOW - 1);
+
+        seed->window = (shift < SEQ_WINDOW) ? (seed->window >> shift) : 0;
+        seed->min_seq += shift;
+        diff = SEQ_WINDOW - 1;
+    }
+    if (seed->window & (1UL << diff)) {
+        return SEQ_DUPLICATE;
+    }
+    seed->window |= (1UL << diff);
+    return SEQ_NEW;
+}
+
+static void _msg_free(_msg_t *msg)
+{
+    trickle_stop(&msg->trickle);
+    gnrc_pktbuf_release(msg->pkt);
+    msg->pkt = NULL;
+}
+
+static _msg_t *_msg_find(const _seed_t *seed, uint8_t seq)
+{
+    for (unsigned i = 0; i < ARRAY_SIZE(_msgs); i++) {
+        if ((_msgs[i].pkt != NULL) && (_msgs[i].seed == seed) &&
+            (_msgs[i].seq == seq)) {
+            return &_msgs[i];
+        }
+    }
+    return NULL;
+}
+
+static void _transmit(void *arg)
+{
+    _msg_t *msg = arg;
+    gnrc_pktsnip_t *netif_hdr = gnrc_netif_hdr_build(NULL, 0, NULL, 0);
+
+    if ((netif_hdr == NULL) || (_netif == NULL)) {
+        DEBUG("gnrc_mpl: unable to transmit message %u\n", msg->seq);
+        gnrc_pktbuf_release(netif_hdr);
+        return;
+    }
+    gnrc_netif_hdr_set_netif(netif_hdr->data, _netif);
+    gnrc_pktbuf_hold(msg->pkt, 1);
+    netif_hdr->next = msg->pkt;
+    DEBUG("gnrc_mpl: transmit message %u\n", msg->seq);
+    if (gnrc_netapi_send(gnrc_ipv6_pid, netif_hdr) < 1) {
+        gnrc_pktbuf_release(netif_hdr);
+    }
+}
+
+static void _msg_add(gnrc_pktsnip_t *pkt, _seed_t *seed, uint8_t seq)
+{
+    _msg_t *msg = NULL;
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_msgs); i++) {
+        if (_msgs[i].pkt == NULL) {
+            msg = &_msgs[i];
+            break;
+        }
+        /* otherwise replace the message closest to the end of its
+         * dissemination */
+        if ((msg == NULL) || (_msgs[i].expirations > msg->expirations)) {
+            msg = &_msgs[i];
+        }
+    }
+    if (msg->pkt != NULL) {
+        DEBUG("gnrc_mpl: buffered message set full, dropping message %u\n",
+              msg->seq);
+        _msg_free(msg);
+    }
+    msg->pkt = pkt;
+    msg->seed = seed;
+    msg->seq = seq;
+    msg->expirations = 0;
+    msg->trickle.callback.func = _transmit;
+    msg->trickle.callback.args = msg;
+    trickle_start(gnrc_ipv6_pid, &msg->trickle, GNRC_MPL_MSG_TYPE_TRICKLE,
+                  CONFIG_GNRC_MPL_DATA_MESSAGE_IMIN,
+                  CONFIG_GNRC_MPL_DATA_MESSAGE_IMAX_DOUBLINGS,
+                  CONFIG_GNRC_MPL_DATA_MESSAGE_K);
+}
+
+/* copies a received message to send order for retransmission */
+static gnrc_pktsnip_t *_copy(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *ipv6)
+{
+    gnrc_pktsnip_t *payload, *res;
+    size_t len = 0;
+
+    for (gnrc_pktsnip_t *snip = pkt; snip != ipv6; snip = snip->next) {
+        len += snip->size;
+    }
+    payload = gnrc_pktbuf_add(NULL, NULL, len, GNRC_NETTYPE_UNDEF);
+    if (payload == NULL) {
+        return NULL;
+    }
+    /* receive order: the payload comes first, the hop-by-hop options
+     * header last */
+    for (gnrc_pktsnip_t *snip = pkt; snip != ipv6; snip = snip->next) {
+        len -= snip->size;
+        memcpy((uint8_t *)payload->data + len, snip->data, snip->size);
+    }
+    res = gnrc_pktbuf_add(payload, ipv6->data, ipv6->size, GNRC_NETTYPE_IPV6);
+    if (res == NULL) {
+        gnrc_pktbuf_release(payload);
+        return NULL;
+    }
+    ((ipv6_hdr_t *)res->data)->hl--;
+    return res;
+}
+
+int gnrc_mpl_init(gnrc_netif_t *netif)
+{
+    int res;
+
+    assert(netif != NULL);
+    if (_netif == NULL) {
+        _seq = random_uint32();
+    }
+    res = gnrc_netif_ipv6_group_join_internal(netif, &_all_mpl_forwarders);
+    if (res < 0) {
+        return res;
+    }
+    _netif = netif;
+    return 0;
+}
+
+int gnrc_mpl_opt_process(gnrc_pktsnip_t *pkt, const mpl_opt_t *opt)
+{
+    gnrc_pktsnip_t *ipv6 = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_IPV6);
+    gnrc_pktsnip_t *netif_hdr;
+    ipv6_hdr_t *hdr;
+    const uint8_t *id = (const uint8_t *)(opt + 1);
+    unsigned id_len = mpl_opt_seed_id_len(opt);
+    _seed_t *seed;
+    _msg_t *msg;
+
+    assert(ipv6 != NULL);
+    hdr = ipv6->data;
+    if ((opt->len < (sizeof(mpl_opt_t) - 2U + id_len)) ||
+        (opt->flags & MPL_OPT_V)) {
+        DEBUG("gnrc_mpl: invalid MPL Option\n");
+        return -EINVAL;
+    }
+    if (id_len == 0) {
+        id = hdr->src.u8;
+        id_len = sizeof(hdr->src);
+    }
+    if ((seed = _seed_get(id, id_len, opt->seq)) == NULL) {
+        DEBUG("gnrc_mpl: seed set full\n");
+        return -ENOMEM;
+    }
+    if (_seed_accept(seed, opt->seq) == SEQ_DUPLICATE) {
+        DEBUG("gnrc_mpl: duplicate of message %u\n", opt->seq);
+        if ((msg = _msg_find(seed, opt->seq)) != NULL) {
+            /* consistent transmission */
+            trickle_increment_counter(&msg->trickle);
+        }
+        return -EALREADY;
+    }
+    netif_hdr = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_NETIF);
+    if ((_netif != NULL) && (netif_hdr != NULL) && (hdr->hl > 1) &&
+        gnrc_mpl_is_domain(&hdr->dst) &&
+        (gnrc_netif_hdr_get_netif(netif_hdr->data) == _netif)) {
+        gnrc_pktsnip_t *copy = _copy(pkt, ipv6);
+
+        if (copy == NULL) {
+            DEBUG("gnrc_mpl: unable to buffer message %u\n", opt->seq);
+            return 0;
+        }
+        DEBUG("gnrc_mpl: buffer message %u\n", opt->seq);
+        _msg_add(copy, seed, opt->seq);
+    }
+    return 0;
+}
+
+bool gnrc_mpl_send(gnrc_pktsnip_t *pkt, gnrc_netif_t *netif)
+{
+    ipv6_hdr_t *hdr = pkt->data;
+    gnrc_pktsnip_t *hbh;
+    ipv6_ext_t *ext;
+    mpl_opt_t *opt;
+    uint8_t *pad;
+    _seed_t *seed;
+
+    /* a preset next header means preset extension headers or a message
+     * buffered by MPL already */
+    if ((_netif == NULL) || !gnrc_mpl_is_domain(&hdr->dst) ||
+        (hdr->nh != PROTNUM_RESERVED) ||
+        ((netif != NULL) && (netif != _netif))) {
+        return false;
+    }
+    if (ipv6_addr_is_unspecified(&hdr->src)) {
+        /* the source is the seed-id, so it must be fixed for all
+         * retransmissions */
+        ipv6_addr_t *src = gnrc_netif_ipv6_addr_best_src(_netif, &hdr->dst,
+                                                         false);
+
+        if (src == NULL) {
+            DEBUG("gnrc_mpl: no source address for message\n");
+            goto error;
+        }
+        hdr->src = *src;
+    }
+    if ((seed = _seed_get(hdr->src.u8, sizeof(hdr->src), _seq)) == NULL) {
+        DEBUG("gnrc_mpl: seed set full\n");
+        goto error;
+    }
+    hbh = gnrc_pktbuf_add(pkt->next, NULL, HBH_LEN, GNRC_NETTYPE_IPV6_EXT);
+    if (hbh == NULL) {
+        DEBUG("gnrc_mpl: unable to allocate hop-by-hop options header\n");
+        goto error;
+    }
+    ext = hbh->data;
+    ext->nh = (pkt->next == NULL) ? PROTNUM_RESERVED
+                                  : gnrc_nettype_to_protnum(pkt->next->type);
+    if (ext->nh == PROTNUM_RESERVED) {
+        ext->nh = PROTNUM_IPV6_NONXT;
+    }
+    ext->len = (HBH_LEN / IPV6_EXT_LEN_UNIT) - 1;
+    opt = (mpl_opt_t *)(ext + 1);
+    opt->type = IPV6_EXT_OPT_MPL;
+    opt->len = sizeof(mpl_opt_t) - 2U;
+    opt->flags = (MPL_OPT_S_SRC << MPL_OPT_S_POS) | MPL_OPT_M;
+    opt->seq = _seq++;
+    pad = (uint8_t *)(opt + 1);
+    pad[0] = IPV6_EXT_OPT_PADN;
+    pad[1] = 0;
+    pkt->next = hbh;
+    hdr->nh = PROTNUM_IPV6_EXT_HOPOPT;
+    /* so our own message is not accepted again */
+    _seed_accept(seed, opt->seq);
+    DEBUG("gnrc_mpl: originate message %u\n", opt->seq);
+    _msg_add(pkt, seed, opt->seq);
+    return true;
+error:
+    gnrc_pktbuf_release_error(pkt, ENOMEM);
+    return true;
+}
+
+void gnrc_mpl_handle_timer(trickle_t *trickle)
+{
+    _msg_t *msg = container_of(trickle, _msg_t, trickle);
+
+    if (msg->pkt == NULL) {
+        /* timer message of a message dropped in the meantime */
+        return;
+    }
+    trickle_callback(trickle);
+    if (++msg->expirations >= CONFIG_GNRC_MPL_DATA_MESSAGE_TIMER_EXPIRATIONS) {
+        DEBUG("gnrc_mpl: dissemination of message %u finished\n", msg->seq);
+        _msg_free(msg);
+    }
+}
+
+/** @} */
@@ -331,6 +331,24 @@ void gnrc_rpl_delay_dao(gnrc_rpl_dodag_t *dodag)
     evtimer_add_msg(&gnrc_rpl_evtimer, &dodag->dao_event, gnrc_rpl_pid);
     dodag->dao_counter = 0;
     dodag->dao_ack_received = false;
+    dodag->dao_scheduled = true;
+}
+
+void gnrc_rpl_aggregate_dao(gnrc_rpl_dodag_t *dodag)
+{
+    if (dodag->dao_scheduled) {
+        /* the scheduled DAO will contain the new targets as well */
+        return;
+    }
+    evtimer_del(&gnrc_rpl_evtimer, (evtimer_event_t *)&dodag->dao_event);
+    ((evtimer_event_t *)&(dodag->dao_event))->offset = random_uint32_range(
+        CONFIG_GNRC_RPL_DAO_AGGREGATION_DELAY,
+        CONFIG_GNRC_RPL_DAO_AGGREGATION_DELAY + CONFIG_GNRC_RPL_DAO_DELAY_JITTER
+    );
+    evtimer_add_msg(&gnrc_rpl_evtimer, &dodag->dao_event, gnrc_rpl_pid);
+    dodag->dao_counter = 0;
+    dodag->dao_ack_received = false;
+    dodag->dao_scheduled = true;
 }
 
 void gnrc_rpl_long_delay_dao(gnrc_rpl_dodag_t *dodag)
@@ -343,10 +361,12 @@ void gnrc_rpl_long_delay_dao(gnrc_rpl_dodag_t *dodag)
     evtimer_add_msg(&gnrc_rpl_evtimer, &dodag->dao_event, gnrc_rpl_pid);
     dodag->dao_counter = 0;
     dodag->dao_ack_received = false;
+    dodag->dao_scheduled = false;
 }
 
 void _dao_handle_send(gnrc_rpl_dodag_t *dodag)
 {
+    dodag->dao_scheduled = false;
     if (dodag->node_status == GNRC_RPL_ROOT_NODE) {
         return;
     }
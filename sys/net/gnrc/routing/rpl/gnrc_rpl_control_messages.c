@@ -34,6 +34,9 @@
 #endif
 
 #include "net/gnrc/rpl.h"
+#ifdef MODULE_GNRC_RPL_SRH_CACHE
+#include "net/gnrc/rpl/srh.h"
+#endif
 #include "gnrc_rpl_internal/validation.h"
 
 #ifdef MODULE_GNRC_RPL_P2P
@@ -624,6 +627,10 @@ bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt
                 gnrc_ipv6_nib_ft_add(&(target->target), target->prefix_length, src,
                                      dodag->iface,
                                      dodag->default_lifetime * dodag->lifetime_unit);
+#ifdef MODULE_GNRC_RPL_SRH_CACHE
+                /* cached source routes may go through the changed entry */
+                gnrc_rpl_srh_cache_flush();
+#endif
                 break;
 
             case (GNRC_RPL_OPT_TRANSIT):
@@ -643,10 +650,13 @@ bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt
 
                     gnrc_ipv6_nib_ft_del(&(first_target->target),
                                          first_target->prefix_length);
-                    gnrc_ipv6_nib_ft_add(&(first_target->target),
-                                         first_target->prefix_length, src,
-                                         dodag->iface,
-                                         transit->path_lifetime * dodag->lifetime_unit);
+                    /* a path lifetime of 0 announces a No-Path */
+                    if (transit->path_lifetime != 0) {
+                        gnrc_ipv6_nib_ft_add(&(first_target->target),
+                                             first_target->prefix_length, src,
+                                             dodag->iface,
+                                             transit->path_lifetime * dodag->lifetime_unit);
+                    }
 
                     first_target = (gnrc_rpl_opt_target_t *) (((uint8_t *) (first_target)) +
                                    sizeof(gnrc_rpl_opt_t) + first_target->length);
@@ -654,6 +664,9 @@ bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt
                 while (first_target->type == GNRC_RPL_OPT_TARGET);
 
                 first_target = NULL;
+#ifdef MODULE_GNRC_RPL_SRH_CACHE
+                gnrc_rpl_srh_cache_flush();
+#endif
                 break;
 
 #ifdef MODULE_GNRC_RPL_P2P
@@ -716,6 +729,66 @@ void gnrc_rpl_recv_DIS(gnrc_rpl_dis_t *dis, kernel_pid_t iface, ipv6_addr_t *src
     }
 }
 
+#if IS_USED(MODULE_GNRC_RPL_DIO_FILTER)
+/**
+ * @brief   Handles a DIO consistent with the current state of its DODAG
+ *          without processing it in full
+ *
+ * @param[in]   dio     The DIO control message
+ * @param[in]   src     Source address of the DIO
+ *
+ * @return  true, if @p dio was handled.
+ * @return  false, if @p dio needs to be processed in full.
+ */
+static bool _dio_consistent(gnrc_rpl_dio_t *dio, ipv6_addr_t *src)
+{
+    gnrc_rpl_instance_t *inst = gnrc_rpl_instance_get(dio->instance_id);
+    gnrc_rpl_dodag_t *dodag;
+    gnrc_rpl_parent_t *parent;
+
+    if (inst == NULL) {
+        return false;
+    }
+
+    dodag = &inst->dodag;
+
+    /* roots only count DIOs anyway */
+    if ((dodag->node_status == GNRC_RPL_ROOT_NODE) ||
+        (inst->mop != ((dio->g_mop_prf >> GNRC_RPL_MOP_SHIFT) & GNRC_RPL_SHIFTED_MOP_MASK)) ||
+        (dio->version_number != dodag->version) ||
+        !ipv6_addr_equal(&dodag->dodag_id, &dio->dodag_id)) {
+        return false;
+    }
+
+#ifdef MODULE_GNRC_RPL_P2P
+    if (inst->mop == GNRC_RPL_P2P_MOP) {
+        return false;
+    }
+#endif
+
+    parent = gnrc_rpl_parent_get(dodag, src);
+    if ((parent == NULL) || (parent->state != GNRC_RPL_PARENT_ACTIVE) ||
+        (parent->rank == GNRC_RPL_INFINITE_RANK) ||
+        (parent->rank != byteorder_ntohs(dio->rank))) {
+        return false;
+    }
+
+    /* only the options of the preferred parent are processed */
+    if ((parent == dodag->parents) &&
+        ((parent->dtsn != dio->dtsn) ||
+         (dodag->grounded != (dio->g_mop_prf >> GNRC_RPL_GROUNDED_SHIFT)) ||
+         (dodag->prf != (dio->g_mop_prf & GNRC_RPL_PRF_MASK)) ||
+         ((evtimer_now_msec() - dodag->dio_refresh) >= CONFIG_GNRC_RPL_DIO_FILTER_REFRESH))) {
+        return false;
+    }
+
+    DEBUG("RPL: DIO consistent with DODAG - skip processing\n");
+    trickle_increment_counter(&dodag->trickle);
+    gnrc_rpl_parent_refresh(parent);
+    return true;
+}
+#endif
+
 void gnrc_rpl_recv_DIO(gnrc_rpl_dio_t *dio, kernel_pid_t iface, ipv6_addr_t *src, ipv6_addr_t *dst,
                        uint16_t len)
 {
@@ -733,6 +806,12 @@ void gnrc_rpl_recv_DIO(gnrc_rpl_dio_t *dio, kernel_pid_t iface, ipv6_addr_t *src
         }
     }
 
+#if IS_USED(MODULE_GNRC_RPL_DIO_FILTER)
+    if (_dio_consistent(dio, src)) {
+        return;
+    }
+#endif
+
     len -= (sizeof(gnrc_rpl_dio_t) + sizeof(icmpv6_hdr_t));
 
     if (gnrc_rpl_instance_add(dio->instance_id, &inst)) {
@@ -797,6 +876,9 @@ void gnrc_rpl_recv_DIO(gnrc_rpl_dio_t *dio, kernel_pid_t iface, ipv6_addr_t *src
                 gnrc_rpl_send_DIS(NULL, src, NULL, 0);
             }
         }
+#if IS_USED(MODULE_GNRC_RPL_DIO_FILTER)
+        dodag->dio_refresh = evtimer_now_msec();
+#endif
 
         /* if there was no address created manually or by a PIO on the interface,
          * leave this DODAG */
@@ -911,6 +993,9 @@ void gnrc_rpl_recv_DIO(gnrc_rpl_dio_t *dio, kernel_pid_t iface, ipv6_addr_t *src
             gnrc_rpl_instance_remove(inst);
             return;
         }
+#if IS_USED(MODULE_GNRC_RPL_DIO_FILTER)
+        dodag->dio_refresh = evtimer_now_msec();
+#endif
     }
 }
 
@@ -999,17 +1084,19 @@ void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint
     idx = gnrc_netif_ipv6_addr_match(netif, &dodag->dodag_id);
     me = &netif->ipv6.addrs[idx];
 
+    /* all targets share the transit option following them (the packet is
+     * built back to front) */
+    DEBUG("RPL: Send DAO - building transit option\n");
+    if ((pkt = _dao_transit_build(pkt, lifetime, false)) == NULL) {
+        DEBUG("RPL: Send DAO - no space left in packet buffer\n");
+        return;
+    }
+
     /* add external and RPL FT entries */
     /* TODO: nib: dropped support for external transit options for now */
     void *ft_state = NULL;
     gnrc_ipv6_nib_ft_t fte;
     while(gnrc_ipv6_nib_ft_iter(NULL, dodag->iface, &ft_state, &fte)) {
-        DEBUG("RPL: Send DAO - building transit option\n");
-
-        if ((pkt = _dao_transit_build(pkt, lifetime, false)) == NULL) {
-            DEBUG("RPL: Send DAO - no space left in packet buffer\n");
-            return;
-        }
         if (ipv6_addr_is_global(&fte.dst) &&
             !ipv6_addr_is_unspecified(&fte.next_hop)) {
             DEBUG("RPL: Send DAO - building target %s/%d\n",
@@ -1194,7 +1281,7 @@ void gnrc_rpl_recv_DAO(gnrc_rpl_dao_t *dao, kernel_pid_t iface, ipv6_addr_t *src
         gnrc_rpl_send_DAO_ACK(inst, src, dao->dao_sequence);
     }
 
-    gnrc_rpl_delay_dao(dodag);
+    gnrc_rpl_aggregate_dao(dodag);
 }
 
 void gnrc_rpl_recv_DAO_ACK(gnrc_rpl_dao_ack_t *dao_ack, kernel_pid_t iface, ipv6_addr_t *src,
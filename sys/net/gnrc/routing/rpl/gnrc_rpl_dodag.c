@@ -155,6 +155,7 @@ bool gnrc_rpl_dodag_init(gnrc_rpl_instance_t *instance, ipv6_addr_t *dodag_id, k
     dodag->dtsn = 0;
     dodag->dao_ack_received = false;
     dodag->dao_counter = 0;
+    dodag->dao_scheduled = false;
     dodag->instance = instance;
     dodag->iface = iface;
     dodag->dao_event.msg.content.ptr = instance;
@@ -224,6 +225,17 @@ bool gnrc_rpl_parent_add_by_addr(gnrc_rpl_dodag_t *dodag, ipv6_addr_t *addr,
     return false;
 }
 
+gnrc_rpl_parent_t *gnrc_rpl_parent_get(gnrc_rpl_dodag_t *dodag, const ipv6_addr_t *addr)
+{
+    for (uint8_t i = 0; i < GNRC_RPL_PARENTS_NUMOF; ++i) {
+        if ((gnrc_rpl_parents[i].state != 0) && (gnrc_rpl_parents[i].dodag == dodag) &&
+            ipv6_addr_equal(&gnrc_rpl_parents[i].addr, addr)) {
+            return &gnrc_rpl_parents[i];
+        }
+    }
+    return NULL;
+}
+
 bool gnrc_rpl_parent_remove(gnrc_rpl_parent_t *parent)
 {
     assert(parent != NULL);
@@ -276,11 +288,7 @@ void gnrc_rpl_parent_update(gnrc_rpl_dodag_t *dodag, gnrc_rpl_parent_t *parent)
 {
     /* update Parent lifetime */
     if ((parent != NULL) && (parent->state != GNRC_RPL_PARENT_UNUSED)) {
-        parent->state = GNRC_RPL_PARENT_ACTIVE;
-        evtimer_del((evtimer_t *)(&gnrc_rpl_evtimer), (evtimer_event_t *)&parent->timeout_event);
-        ((evtimer_event_t *)&(parent->timeout_event))->offset = dodag->default_lifetime * dodag->lifetime_unit * MS_PER_SEC;
-        parent->timeout_event.msg.type = GNRC_RPL_MSG_TYPE_PARENT_TIMEOUT;
-        evtimer_add_msg(&gnrc_rpl_evtimer, &parent->timeout_event, gnrc_rpl_pid);
+        gnrc_rpl_parent_refresh(parent);
 #ifdef MODULE_GNRC_RPL_P2P
         if (dodag->instance->mop != GNRC_RPL_P2P_MOP) {
 #endif
@@ -299,6 +307,17 @@ void gnrc_rpl_parent_update(gnrc_rpl_dodag_t *dodag, gnrc_rpl_parent_t *parent)
     }
 }
 
+void gnrc_rpl_parent_refresh(gnrc_rpl_parent_t *parent)
+{
+    gnrc_rpl_dodag_t *dodag = parent->dodag;
+
+    parent->state = GNRC_RPL_PARENT_ACTIVE;
+    evtimer_del((evtimer_t *)(&gnrc_rpl_evtimer), (evtimer_event_t *)&parent->timeout_event);
+    ((evtimer_event_t *)&(parent->timeout_event))->offset = dodag->default_lifetime * dodag->lifetime_unit * MS_PER_SEC;
+    parent->timeout_event.msg.type = GNRC_RPL_MSG_TYPE_PARENT_TIMEOUT;
+    evtimer_add_msg(&gnrc_rpl_evtimer, &parent->timeout_event, gnrc_rpl_pid);
+}
+
 /**
  * @brief   Find the parent with the lowest rank and update the DODAG's preferred parent
  *
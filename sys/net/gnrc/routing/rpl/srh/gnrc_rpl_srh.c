@@ -15,9 +15,12 @@
  * @author Martine Lenders <m.lenders@fu-berlin.de>
  */
 
+#include <errno.h>
 #include <string.h>
+#include "mutex.h"
 #include "net/gnrc/netif/internal.h"
 #include "net/gnrc/ipv6/ext/rh.h"
+#include "net/ipv6/ext/rh.h"
 #include "net/gnrc/rpl/srh.h"
 
 #define ENABLE_DEBUG    (0)
@@ -29,6 +32,19 @@ static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 #define GNRC_RPL_SRH_COMPRE(X)      (X & 0x0F)
 #define GNRC_RPL_SRH_COMPRI(X)      ((X & 0xF0) >> 4)
 
+#ifdef MODULE_GNRC_RPL_SRH_CACHE
+typedef struct {
+    ipv6_addr_t dst;
+    ipv6_addr_t next_hop;
+    uint8_t len;                /* length of hdr, 0 if unused */
+    uint8_t hdr[CONFIG_GNRC_RPL_SRH_CACHE_HDR_SIZE];
+} _cache_entry_t;
+
+static mutex_t _cache_lock = MUTEX_INIT;
+static _cache_entry_t _cache[CONFIG_GNRC_RPL_SRH_CACHE_SIZE];
+static unsigned _cache_next;
+#endif
+
 /* checks if multiple addresses within the source routing header exist on my
  * interfaces */
 static void *_contains_multiple_of_my_addr(const ipv6_addr_t *dst,
@@ -106,8 +122,10 @@ int gnrc_rpl_srh_process(ipv6_hdr_t *ipv6, gnrc_rpl_srh_t *rh, void **err_ptr)
         return GNRC_IPV6_EXT_RH_ERROR;
     }
 
-    /* check if multiple addresses of my interface exist */
-    if ((*err_ptr = _contains_multiple_of_my_addr(&ipv6->dst, rh, num_addr,
+    /* check if multiple addresses of my interface exist, which needs at
+     * least one address in between */
+    if ((num_addr > 2) &&
+        (*err_ptr = _contains_multiple_of_my_addr(&ipv6->dst, rh, num_addr,
                                                   compri_addr_len))) {
         return GNRC_IPV6_EXT_RH_ERROR;
     }
@@ -122,4 +140,130 @@ int gnrc_rpl_srh_process(ipv6_hdr_t *ipv6, gnrc_rpl_srh_t *rh, void **err_ptr)
     return GNRC_IPV6_EXT_RH_FORWARDED;
 }
 
+/* number of leading octets a and b have in common, at most 15 */
+static uint8_t _common_octets(const ipv6_addr_t *a, const ipv6_addr_t *b)
+{
+    uint8_t i = 0;
+
+    while ((i < 15) && (a->u8[i] == b->u8[i])) {
+        i++;
+    }
+    return i;
+}
+
+int gnrc_rpl_srh_build(gnrc_rpl_srh_t *rh, size_t size,
+                       const ipv6_addr_t *route, unsigned num)
+{
+    const ipv6_addr_t *first = &route[0];
+    uint8_t *addr_vec = (uint8_t *)(rh + 1);
+    uint8_t compri = 15, compre, pad;
+    size_t len;
+
+    if ((num < 2) || (num > UINT8_MAX + 1)) {
+        return -EINVAL;
+    }
+    for (unsigned i = 1; i < num - 1; i++) {
+        uint8_t common = _common_octets(first, &route[i]);
+
+        if (common < compri) {
+            compri = common;
+        }
+    }
+    compre = _common_octets(first, &route[num - 1]);
+    len = sizeof(*rh) + (num - 2) * (sizeof(ipv6_addr_t) - compri) +
+          sizeof(ipv6_addr_t) - compre;
+    pad = (8 - (len % 8)) % 8;
+    if (((len + pad - 8) / 8) > UINT8_MAX) {
+        return -EINVAL;
+    }
+    if (len + pad > size) {
+        return -ENOBUFS;
+    }
+
+    rh->len = (len + pad - 8) / 8;
+    rh->type = IPV6_EXT_RH_TYPE_RPL_SRH;
+    rh->seg_left = num - 1;
+    rh->compr = (compri << 4) | compre;
+    rh->pad_resv = pad << 4;
+    rh->resv = 0;
+    for (unsigned i = 1; i < num - 1; i++) {
+        memcpy(addr_vec, &route[i].u8[compri], sizeof(ipv6_addr_t) - compri);
+        addr_vec += sizeof(ipv6_addr_t) - compri;
+    }
+    memcpy(addr_vec, &route[num - 1].u8[compre], sizeof(ipv6_addr_t) - compre);
+    memset(addr_vec + sizeof(ipv6_addr_t) - compre, 0, pad);
+
+    return len + pad;
+}
+
+#ifdef MODULE_GNRC_RPL_SRH_CACHE
+static _cache_entry_t *_cache_find(const ipv6_addr_t *dst)
+{
+    for (unsigned i = 0; i < CONFIG_GNRC_RPL_SRH_CACHE_SIZE; i++) {
+        if ((_cache[i].len != 0) && ipv6_addr_equal(&_cache[i].dst, dst)) {
+            return &_cache[i];
+        }
+    }
+    return NULL;
+}
+
+int gnrc_rpl_srh_cache_add(const ipv6_addr_t *route, unsigned num)
+{
+    _cache_entry_t *entry;
+    int res;
+
+    if (num < 2) {
+        return -EINVAL;
+    }
+    mutex_lock(&_cache_lock);
+    if ((entry = _cache_find(&route[num - 1])) == NULL) {
+        entry = &_cache[_cache_next];
+        _cache_next = (_cache_next + 1) % CONFIG_GNRC_RPL_SRH_CACHE_SIZE;
+    }
+    res = gnrc_rpl_srh_build((gnrc_rpl_srh_t *)entry->hdr, sizeof(entry->hdr),
+                             route, num);
+    if (res < 0) {
+        entry->len = 0;
+    }
+    else {
+        memcpy(&entry->dst, &route[num - 1], sizeof(entry->dst));
+        memcpy(&entry->next_hop, &route[0], sizeof(entry->next_hop));
+        entry->len = res;
+        res = 0;
+    }
+    mutex_unlock(&_cache_lock);
+    return res;
+}
+
+int gnrc_rpl_srh_cache_get(const ipv6_addr_t *dst, ipv6_addr_t *next_hop,
+                           gnrc_rpl_srh_t *rh, size_t size)
+{
+    _cache_entry_t *entry;
+    int res = -ENOENT;
+
+    mutex_lock(&_cache_lock);
+    if ((entry = _cache_find(dst)) != NULL) {
+        if (entry->len > size) {
+            res = -ENOBUFS;
+        }
+        else {
+            memcpy(next_hop, &entry->next_hop, sizeof(*next_hop));
+            memcpy(rh, entry->hdr, entry->len);
+            res = entry->len;
+        }
+    }
+    mutex_unlock(&_cache_lock);
+    return res;
+}
+
+void gnrc_rpl_srh_cache_flush(void)
+{
+    mutex_lock(&_cache_lock);
+    for (unsigned i = 0; i < CONFIG_GNRC_RPL_SRH_CACHE_SIZE; i++) {
+        _cache[i].len = 0;
+    }
+    mutex_unlock(&_cache_lock);
+}
+#endif
+
 /** @} */
@@ -30,6 +30,7 @@
 #include "gnrc_sock_internal.h"
 
 #ifdef MODULE_FUZZING
+#include "fuzzing.h"
 extern gnrc_pktsnip_t *gnrc_pktbuf_fuzzptr;
 gnrc_pktsnip_t *gnrc_sock_prevpkt = NULL;
 #endif
@@ -51,7 +52,7 @@ static void _callback_put(void *arg)
 }
 #endif
 
-#ifdef SOCK_HAS_ASYNC
+#if defined(SOCK_HAS_ASYNC) || IS_USED(MODULE_GNRC_SOCK_RX_STATS)
 static void _netapi_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
 {
     if (cmd == GNRC_NETAPI_MSG_TYPE_RCV) {
@@ -62,28 +63,46 @@ static void _netapi_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
         if (mbox_try_put(&reg->mbox, &msg) < 1) {
             LOG_WARNING("gnrc_sock: dropped message to %p (was full)\n",
                         (void *)&reg->mbox);
+#if IS_USED(MODULE_GNRC_SOCK_RX_STATS)
+            reg->rx_stats.dropped++;
+#endif
             /* packet could not be delivered so it should be dropped */
             gnrc_pktbuf_release(pkt);
             return;
         }
+#if IS_USED(MODULE_GNRC_SOCK_RX_STATS)
+        unsigned fill = cib_avail(&reg->mbox.cib);
+
+        reg->rx_stats.received++;
+        if (fill > reg->rx_stats.high_water) {
+            reg->rx_stats.high_water = fill;
+        }
+#endif
+#ifdef SOCK_HAS_ASYNC
         if (reg->async_cb.generic) {
             reg->async_cb.generic(reg, SOCK_ASYNC_MSG_RECV, reg->async_cb_arg);
         }
+#endif
     }
 }
-#endif /* SOCK_HAS_ASYNC */
+#endif /* SOCK_HAS_ASYNC || MODULE_GNRC_SOCK_RX_STATS */
 
 void gnrc_sock_create(gnrc_sock_reg_t *reg, gnrc_nettype_t type, uint32_t demux_ctx)
 {
     mbox_init(&reg->mbox, reg->mbox_queue, GNRC_SOCK_MBOX_SIZE);
 #ifdef SOCK_HAS_ASYNC
     reg->async_cb.generic = NULL;
+#endif
+#if defined(SOCK_HAS_ASYNC) || IS_USED(MODULE_GNRC_SOCK_RX_STATS)
+#if IS_USED(MODULE_GNRC_SOCK_RX_STATS)
+    memset(&reg->rx_stats, 0, sizeof(reg->rx_stats));
+#endif
     reg->netreg_cb.cb = _netapi_cb;
     reg->netreg_cb.ctx = reg;
     gnrc_netreg_entry_init_cb(&reg->entry, demux_ctx, &reg->netreg_cb);
-#else   /* SOCK_HAS_ASYNC */
+#else   /* SOCK_HAS_ASYNC || MODULE_GNRC_SOCK_RX_STATS */
     gnrc_netreg_entry_init_mbox(&reg->entry, demux_ctx, &reg->mbox);
-#endif  /* SOCK_HAS_ASYNC */
+#endif  /* SOCK_HAS_ASYNC || MODULE_GNRC_SOCK_RX_STATS */
     gnrc_netreg_register(type, &reg->entry);
 }
 
@@ -97,12 +116,12 @@ ssize_t gnrc_sock_recv(gnrc_sock_reg_t *reg, gnrc_pktsnip_t **pkt_out,
      * application from the fuzzing/ subdirectory. When using gnrc_sock
      * the fuzzer assumes that gnrc_sock_recv is called in a loop. If it
      * is called again and the previous return value was the special
-     * crafted fuzzing packet, the fuzzing application terminates.
+     * crafted fuzzing packet, input processing has completed.
      *
      * sock_async_event has its on fuzzing termination condition. */
 #if defined(MODULE_FUZZING) && !defined(MODULE_SOCK_ASYNC_EVENT)
     if (gnrc_sock_prevpkt && gnrc_sock_prevpkt == gnrc_pktbuf_fuzzptr) {
-        exit(EXIT_SUCCESS);
+        fuzzing_done();
     }
 #endif
 
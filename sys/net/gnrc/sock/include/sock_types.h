@@ -25,6 +25,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "kernel_defines.h"
 #include "mbox.h"
 #include "net/af.h"
 #include "net/gnrc.h"
@@ -63,6 +64,17 @@ extern "C" {
 #define GNRC_SOCK_MBOX_SIZE  (1 << CONFIG_GNRC_SOCK_MBOX_SIZE_EXP)
 #endif
 
+/**
+ * @brief   Receive statistics of a sock
+ *
+ * @note    Only available with module `gnrc_sock_rx_stats`.
+ */
+typedef struct {
+    uint32_t received;      /**< packets put into the receive queue */
+    uint32_t dropped;       /**< packets dropped, because the receive queue was full */
+    uint16_t high_water;    /**< maximum fill level of the receive queue */
+} gnrc_sock_rx_stats_t;
+
 /**
  * @brief   Forward declaration
  * @internal
@@ -90,6 +102,12 @@ struct gnrc_sock_reg {
     gnrc_netreg_entry_t entry;             /**< @ref net_gnrc_netreg entry for mbox */
     mbox_t mbox;                           /**< @ref core_mbox target for the sock */
     msg_t mbox_queue[GNRC_SOCK_MBOX_SIZE]; /**< queue for gnrc_sock_reg_t::mbox */
+#if IS_USED(MODULE_GNRC_SOCK_RX_STATS)
+    gnrc_sock_rx_stats_t rx_stats;         /**< receive statistics */
+#if !defined(SOCK_HAS_ASYNC)
+    gnrc_netreg_entry_cbd_t netreg_cb;     /**< netreg callback */
+#endif
+#endif
 #ifdef SOCK_HAS_ASYNC
     gnrc_netreg_entry_cbd_t netreg_cb;     /**< netreg callback */
     /**
@@ -136,6 +154,52 @@ struct sock_udp {
     uint16_t flags;                        /**< option flags */
 };
 
+#if IS_USED(MODULE_GNRC_SOCK_RX_STATS) || defined(DOXYGEN)
+/**
+ * @brief   Get the receive statistics of a UDP sock
+ *
+ * @param[in] sock  A UDP sock object.
+ *
+ * @return  The receive statistics of @p sock.
+ */
+static inline const gnrc_sock_rx_stats_t *gnrc_sock_udp_get_rx_stats(const sock_udp_t *sock)
+{
+    return &sock->reg.rx_stats;
+}
+#endif
+
+/**
+ * @brief   Allocates a transmit buffer for a UDP sock in the packet buffer
+ *
+ * The application can write the payload directly into the returned buffer
+ * and hand it to @ref gnrc_sock_udp_send_buf(). The UDP and IP headers are
+ * prepended as separate snips, so the payload is never copied again.
+ *
+ * @param[in] len       Length of the payload.
+ * @param[out] buf_ctx  Packet snip holding the buffer. Must be passed to
+ *                      @ref gnrc_sock_udp_send_buf() or released with
+ *                      @ref gnrc_pktbuf_release().
+ *
+ * @return  Pointer to the payload buffer of length @p len.
+ * @return  NULL, if the packet buffer is full.
+ */
+void *gnrc_sock_udp_alloc_buf(size_t len, gnrc_pktsnip_t **buf_ctx);
+
+/**
+ * @brief   Sends a buffer allocated with @ref gnrc_sock_udp_alloc_buf()
+ *
+ * @param[in] sock      A UDP sock object. May be `NULL`.
+ * @param[in] buf_ctx   Packet snip returned by @ref gnrc_sock_udp_alloc_buf().
+ *                      Ownership is passed to the stack, also on error.
+ * @param[in] remote    Remote end point for the sent data. May be `NULL`, if
+ *                      @p sock has a remote end point.
+ *
+ * @return  The number of bytes sent on success.
+ * @return  The same negative error codes as @ref sock_udp_send().
+ */
+ssize_t gnrc_sock_udp_send_buf(sock_udp_t *sock, gnrc_pktsnip_t *buf_ctx,
+                               const sock_udp_ep_t *remote);
+
 #ifdef __cplusplus
 }
 #endif
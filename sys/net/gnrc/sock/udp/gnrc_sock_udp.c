@@ -194,6 +194,31 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
     return (nobufs) ? -ENOBUFS : ((res < 0) ? res : ret);
 }
 
+ssize_t sock_udp_recv_many(sock_udp_t *sock, sock_udp_mmsg_t *msgs,
+                           size_t msgs_len, uint32_t timeout)
+{
+    size_t i = 0;
+
+    assert((sock != NULL) && (msgs != NULL) && (msgs_len > 0));
+    while (i < msgs_len) {
+        ssize_t res = sock_udp_recv(sock, msgs[i].data, msgs[i].max_len,
+                                    timeout, &msgs[i].remote);
+
+        if (res < 0) {
+            /* skip datagrams not fitting into the buffer or the remote of
+             * sock, but stop once the receive queue is drained */
+            if ((i > 0) && ((res == -ENOBUFS) || (res == -EPROTO))) {
+                continue;
+            }
+            return (i > 0) ? (ssize_t)i : res;
+        }
+        msgs[i++].len = res;
+        /* only wait for the first datagram */
+        timeout = 0;
+    }
+    return i;
+}
+
 ssize_t sock_udp_recv_buf(sock_udp_t *sock, void **data, void **buf_ctx,
                           uint32_t timeout, sock_udp_ep_t *remote)
 {
@@ -241,19 +266,8 @@ ssize_t sock_udp_recv_buf(sock_udp_t *sock, void **data, void **buf_ctx,
     return res;
 }
 
-ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
-                      const sock_udp_ep_t *remote)
+static int _check_remote(const sock_udp_t *sock, const sock_udp_ep_t *remote)
 {
-    int res;
-    gnrc_pktsnip_t *payload, *pkt;
-    uint16_t src_port = 0, dst_port;
-    sock_ip_ep_t local;
-    sock_udp_ep_t remote_cpy;
-    sock_ip_ep_t *rem;
-
-    assert((sock != NULL) || (remote != NULL));
-    assert((len == 0) || (data != NULL)); /* (len != 0) => (data != NULL) */
-
     if (remote != NULL) {
         if (remote->port == 0) {
             return -EINVAL;
@@ -274,6 +288,24 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
     else if (sock->remote.family == AF_UNSPEC) {
         return -ENOTCONN;
     }
+    return 0;
+}
+
+/* takes ownership of payload, also on error */
+static ssize_t _send_payload(sock_udp_t *sock, gnrc_pktsnip_t *payload,
+                             const sock_udp_ep_t *remote)
+{
+    int res;
+    gnrc_pktsnip_t *pkt;
+    uint16_t src_port = 0, dst_port;
+    sock_ip_ep_t local;
+    sock_udp_ep_t remote_cpy;
+    sock_ip_ep_t *rem;
+
+    if ((res = _check_remote(sock, remote)) < 0) {
+        gnrc_pktbuf_release(payload);
+        return res;
+    }
     /* cppcheck-suppress nullPointerRedundantCheck
      * (reason: compiler evaluates lazily so this isn't a redundundant check and
      * cppcheck is being weird here anyways) */
@@ -281,6 +313,7 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
         /* no sock or sock currently unbound */
         memset(&local, 0, sizeof(local));
         if ((src_port = _get_dyn_port(sock)) == GNRC_SOCK_DYN_PORTRANGE_ERR) {
+            gnrc_pktbuf_release(payload);
             return -EADDRINUSE;
         }
         /* cppcheck-suppress nullPointer
@@ -322,13 +355,10 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
         local.family = rem->family;
     }
     else if (local.family != rem->family) {
+        gnrc_pktbuf_release(payload);
         return -EINVAL;
     }
-    /* generate payload and header snips */
-    payload = gnrc_pktbuf_add(NULL, (void *)data, len, GNRC_NETTYPE_UNDEF);
-    if (payload == NULL) {
-        return -ENOMEM;
-    }
+    /* generate header snips */
     pkt = gnrc_udp_hdr_build(payload, src_port, dst_port);
     if (pkt == NULL) {
         gnrc_pktbuf_release(payload);
@@ -347,6 +377,70 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
     return res;
 }
 
+ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
+                      const sock_udp_ep_t *remote)
+{
+    gnrc_pktsnip_t *payload;
+    int res;
+
+    assert((sock != NULL) || (remote != NULL));
+    assert((len == 0) || (data != NULL)); /* (len != 0) => (data != NULL) */
+
+    /* check before allocating, to not waste packet buffer on errors */
+    if ((res = _check_remote(sock, remote)) < 0) {
+        return res;
+    }
+    payload = gnrc_pktbuf_add(NULL, (void *)data, len, GNRC_NETTYPE_UNDEF);
+    if (payload == NULL) {
+        return -ENOMEM;
+    }
+    return _send_payload(sock, payload, remote);
+}
+
+ssize_t sock_udp_sendv(sock_udp_t *sock, const iolist_t *snips,
+                       const sock_udp_ep_t *remote)
+{
+    gnrc_pktsnip_t *payload;
+    uint8_t *ptr;
+    int res;
+
+    assert((sock != NULL) || (remote != NULL));
+
+    if ((res = _check_remote(sock, remote)) < 0) {
+        return res;
+    }
+    /* gather all chunks into a single snip, which is the only copy made */
+    payload = gnrc_pktbuf_add(NULL, NULL, iolist_size(snips),
+                              GNRC_NETTYPE_UNDEF);
+    if (payload == NULL) {
+        return -ENOMEM;
+    }
+    ptr = payload->data;
+    for (const iolist_t *iol = snips; iol != NULL; iol = iol->iol_next) {
+        memcpy(ptr, iol->iol_base, iol->iol_len);
+        ptr += iol->iol_len;
+    }
+    return _send_payload(sock, payload, remote);
+}
+
+void *gnrc_sock_udp_alloc_buf(size_t len, gnrc_pktsnip_t **buf_ctx)
+{
+    assert(buf_ctx != NULL);
+    *buf_ctx = gnrc_pktbuf_add(NULL, NULL, len, GNRC_NETTYPE_UNDEF);
+    if (*buf_ctx == NULL) {
+        return NULL;
+    }
+    return (*buf_ctx)->data;
+}
+
+ssize_t gnrc_sock_udp_send_buf(sock_udp_t *sock, gnrc_pktsnip_t *buf_ctx,
+                               const sock_udp_ep_t *remote)
+{
+    assert((sock != NULL) || (remote != NULL));
+    assert(buf_ctx != NULL);
+    return _send_payload(sock, buf_ctx, remote);
+}
+
 #ifdef SOCK_HAS_ASYNC
 void sock_udp_set_cb(sock_udp_t *sock, sock_udp_cb_t cb, void *arg)
 {
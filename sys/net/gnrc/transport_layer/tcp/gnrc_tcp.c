@@ -71,7 +71,7 @@ typedef struct _cb_arg {
 } cb_arg_t;
 
 /**
- * @brief Callback for xtimer, puts a message in a mbox.
+ * @brief Callback for ztimer, puts a message in a mbox.
  *
  * @param[in] arg   Ptr to cb_arg_t. Must not be NULL or anything else.
  */
@@ -90,12 +90,12 @@ static void _cb_mbox_put_msg(void *arg)
  * @param[in] cb          Function to be called after @p duration.
  * @param[in] arg         Arguments for @p cb.
  */
-static void _setup_timeout(xtimer_t *timer, const uint32_t duration, const xtimer_callback_t cb,
+static void _setup_timeout(ztimer_t *timer, const uint32_t duration, void (*cb)(void *),
                            cb_arg_t *arg)
 {
     timer->callback = cb;
     timer->arg = arg;
-    xtimer_set(timer, duration);
+    ztimer_set(ZTIMER_USEC, timer, duration);
 }
 
 /**
@@ -119,8 +119,8 @@ static int _gnrc_tcp_open(gnrc_tcp_tcb_t *tcb, const gnrc_tcp_ep_t *remote,
                           const uint8_t *local_addr, uint16_t local_port, int passive)
 {
     msg_t msg;
-    xtimer_t connection_timeout;
     cb_arg_t connection_timeout_arg = {MSG_TYPE_CONNECTION_TIMEOUT, &(tcb->mbox)};
+    ztimer_t connection_timeout = { .callback = _cb_mbox_put_msg, .arg = &connection_timeout_arg };
     int ret = 0;
 
     /* Lock the TCB for this function call */
@@ -239,7 +239,7 @@ static int _gnrc_tcp_open(gnrc_tcp_tcb_t *tcb, const gnrc_tcp_ep_t *remote,
     }
 
     /* Cleanup */
-    xtimer_remove(&connection_timeout);
+    ztimer_remove(ZTIMER_USEC, &connection_timeout);
     if (tcb->state == FSM_STATE_CLOSED && ret == 0) {
         ret = -ECONNREFUSED;
     }
@@ -459,6 +459,187 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb, const gnrc_tcp_ep_t *local)
 #endif
 }
 
+void gnrc_tcp_tcb_queue_init(gnrc_tcp_tcb_queue_t *queue)
+{
+    memset(queue, 0, sizeof(gnrc_tcp_tcb_queue_t));
+    mutex_init(&(queue->lock));
+    mbox_init(&(queue->mbox), queue->mbox_raw, GNRC_TCP_TCB_MBOX_SIZE);
+}
+
+/**
+ * @brief Puts a TCB of a listen queue (back) into LISTEN state.
+ *
+ * @param[in,out] tcb   TCB to listen with, must be in CLOSED state.
+ *
+ * @returns   Zero on success.
+ *            -ENOMEM if the receive buffer for the TCB could not be allocated.
+ */
+static int _listen(gnrc_tcp_tcb_t *tcb)
+{
+    tcb->status &= ~STATUS_ACCEPTED;
+    tcb->status |= STATUS_PASSIVE | STATUS_LISTENING;
+    return _fsm(tcb, FSM_EVENT_CALL_OPEN, NULL, NULL, 0);
+}
+
+int gnrc_tcp_listen(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t *tcbs, size_t tcbs_len,
+                    const gnrc_tcp_ep_t *local)
+{
+    assert(queue != NULL);
+    assert(tcbs != NULL);
+    assert(tcbs_len > 0);
+    assert(local != NULL);
+    assert(local->port != PORT_UNSPEC);
+
+#ifdef MODULE_GNRC_IPV6
+    if (local->family != AF_INET6) {
+        return -EAFNOSUPPORT;
+    }
+#else
+    return -EAFNOSUPPORT;
+#endif
+
+    mutex_lock(&(queue->lock));
+    if (queue->tcbs != NULL) {
+        mutex_unlock(&(queue->lock));
+        return -EISCONN;
+    }
+
+    for (size_t i = 0; i < tcbs_len; i++) {
+        gnrc_tcp_tcb_t *tcb = &tcbs[i];
+
+        if (tcb->state != FSM_STATE_CLOSED) {
+            mutex_unlock(&(queue->lock));
+            return -EISCONN;
+        }
+        if (local->family != tcb->address_family) {
+            mutex_unlock(&(queue->lock));
+            return -EINVAL;
+        }
+#ifdef MODULE_GNRC_IPV6
+        memcpy(tcb->local_addr, local->addr.ipv6, sizeof(tcb->local_addr));
+        if (ipv6_addr_is_unspecified((ipv6_addr_t *) tcb->local_addr)) {
+            tcb->status |= STATUS_ALLOW_ANY_ADDR;
+        }
+#endif
+        tcb->local_port = local->port;
+        tcb->queue = queue;
+    }
+
+    queue->tcbs = tcbs;
+    queue->tcbs_len = tcbs_len;
+
+    for (size_t i = 0; i < tcbs_len; i++) {
+        int ret = _listen(&tcbs[i]);
+        if (ret < 0) {
+            DEBUG("gnrc_tcp.c : gnrc_tcp_listen() : Out of receive buffers.\n");
+            mutex_unlock(&(queue->lock));
+            gnrc_tcp_stop_listen(queue);
+            return ret;
+        }
+    }
+    mutex_unlock(&(queue->lock));
+    return 0;
+}
+
+/**
+ * @brief Hands out an established, not yet accepted connection of a listen queue.
+ *
+ * @note Must be called with the queue locked. TCBs that were closed by
+ *       their peer before they were accepted start listening again.
+ *
+ * @param[in,out] queue   Listen queue to search.
+ * @param[out]    tcb     Accepted TCB.
+ *
+ * @returns   Zero if a connection was accepted.
+ *            -EAGAIN if no connection is ready to be accepted.
+ *            -ENOMEM if all TCBs of @p queue are already accepted.
+ */
+static int _accept(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t **tcb)
+{
+    size_t accepted = 0;
+
+    for (size_t i = 0; i < queue->tcbs_len; i++) {
+        gnrc_tcp_tcb_t *iter = &(queue->tcbs[i]);
+
+        if (iter->status & STATUS_ACCEPTED) {
+            accepted++;
+        }
+        else if (iter->state == FSM_STATE_ESTABLISHED || iter->state == FSM_STATE_CLOSE_WAIT) {
+            iter->status |= STATUS_ACCEPTED;
+            *tcb = iter;
+            return 0;
+        }
+        else if (iter->state == FSM_STATE_CLOSED) {
+            _listen(iter);
+        }
+    }
+    return (accepted == queue->tcbs_len) ? -ENOMEM : -EAGAIN;
+}
+
+int gnrc_tcp_accept(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t **tcb,
+                    const uint32_t user_timeout_duration_us)
+{
+    assert(queue != NULL);
+    assert(tcb != NULL);
+
+    msg_t msg;
+    cb_arg_t user_timeout_arg = {MSG_TYPE_USER_SPEC_TIMEOUT, &(queue->mbox)};
+    ztimer_t user_timeout = { .callback = _cb_mbox_put_msg, .arg = &user_timeout_arg };
+    int ret = 0;
+
+    mutex_lock(&(queue->lock));
+    if (queue->tcbs == NULL) {
+        mutex_unlock(&(queue->lock));
+        return -EINVAL;
+    }
+
+    /* 'Flush' mbox */
+    while (mbox_try_get(&(queue->mbox), &msg) != 0) {
+    }
+
+    if (user_timeout_duration_us > 0) {
+        _setup_timeout(&user_timeout, user_timeout_duration_us, _cb_mbox_put_msg,
+                       &user_timeout_arg);
+    }
+
+    /* Loop until a connection was accepted or the timeout expired */
+    while ((ret = _accept(queue, tcb)) == -EAGAIN && user_timeout_duration_us > 0) {
+        mbox_get(&(queue->mbox), &msg);
+        if (msg.type == MSG_TYPE_USER_SPEC_TIMEOUT) {
+            DEBUG("gnrc_tcp.c : gnrc_tcp_accept() : USER_SPEC_TIMEOUT\n");
+            ret = -ETIMEDOUT;
+            break;
+        }
+    }
+
+    /* Cleanup */
+    ztimer_remove(ZTIMER_USEC, &user_timeout);
+    mutex_unlock(&(queue->lock));
+    return ret;
+}
+
+void gnrc_tcp_stop_listen(gnrc_tcp_tcb_queue_t *queue)
+{
+    assert(queue != NULL);
+
+    mutex_lock(&(queue->lock));
+    for (size_t i = 0; i < queue->tcbs_len; i++) {
+        gnrc_tcp_tcb_t *tcb = &(queue->tcbs[i]);
+
+        /* Accepted connections belong to the user: only detach them */
+        if (!(tcb->status & STATUS_ACCEPTED)) {
+            gnrc_tcp_abort(tcb);
+        }
+        mutex_lock(&(tcb->function_lock));
+        tcb->status &= ~(STATUS_LISTENING | STATUS_ACCEPTED);
+        tcb->queue = NULL;
+        mutex_unlock(&(tcb->function_lock));
+    }
+    queue->tcbs = NULL;
+    queue->tcbs_len = 0;
+    mutex_unlock(&(queue->lock));
+}
+
 ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                       const uint32_t timeout_duration_us)
 {
@@ -466,12 +647,12 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
     assert(data != NULL);
 
     msg_t msg;
-    xtimer_t connection_timeout;
     cb_arg_t connection_timeout_arg = {MSG_TYPE_CONNECTION_TIMEOUT, &(tcb->mbox)};
-    xtimer_t user_timeout;
+    ztimer_t connection_timeout = { .callback = _cb_mbox_put_msg, .arg = &connection_timeout_arg };
     cb_arg_t user_timeout_arg = {MSG_TYPE_USER_SPEC_TIMEOUT, &(tcb->mbox)};
-    xtimer_t probe_timeout;
+    ztimer_t user_timeout = { .callback = _cb_mbox_put_msg, .arg = &user_timeout_arg };
     cb_arg_t probe_timeout_arg = {MSG_TYPE_PROBE_TIMEOUT, &(tcb->mbox)};
+    ztimer_t probe_timeout = { .callback = _cb_mbox_put_msg, .arg = &probe_timeout_arg };
     uint32_t probe_timeout_duration_us = 0;
     ssize_t ret = 0;
     bool probing_mode = false;
@@ -501,8 +682,8 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
         _setup_timeout(&user_timeout, timeout_duration_us, _cb_mbox_put_msg, &user_timeout_arg);
     }
 
-    /* Loop until something was sent and acked */
-    while (ret == 0 || tcb->pkt_retransmit != NULL) {
+    /* Loop until something was queued for transmission */
+    while (ret == 0) {
         /* Check if the connections state is closed. If so, a reset was received */
         if (tcb->state == FSM_STATE_CLOSED) {
             ret = -ECONNRESET;
@@ -566,7 +747,7 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                 /* If the window re-opened and we are probing: Stop it */
                 if (tcb->snd_wnd > 0 && probing_mode) {
                     probing_mode = false;
-                    xtimer_remove(&probe_timeout);
+                    ztimer_remove(ZTIMER_USEC, &probe_timeout);
                 }
                 break;
 
@@ -576,9 +757,9 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
     }
 
     /* Cleanup */
-    xtimer_remove(&probe_timeout);
-    xtimer_remove(&connection_timeout);
-    xtimer_remove(&user_timeout);
+    ztimer_remove(ZTIMER_USEC, &probe_timeout);
+    ztimer_remove(ZTIMER_USEC, &connection_timeout);
+    ztimer_remove(ZTIMER_USEC, &user_timeout);
     tcb->status &= ~STATUS_WAIT_FOR_MSG;
     mutex_unlock(&(tcb->function_lock));
     return ret;
@@ -591,10 +772,10 @@ ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
     assert(data != NULL);
 
     msg_t msg;
-    xtimer_t connection_timeout;
     cb_arg_t connection_timeout_arg = {MSG_TYPE_CONNECTION_TIMEOUT, &(tcb->mbox)};
-    xtimer_t user_timeout;
+    ztimer_t connection_timeout = { .callback = _cb_mbox_put_msg, .arg = &connection_timeout_arg };
     cb_arg_t user_timeout_arg = {MSG_TYPE_USER_SPEC_TIMEOUT, &(tcb->mbox)};
+    ztimer_t user_timeout = { .callback = _cb_mbox_put_msg, .arg = &user_timeout_arg };
     ssize_t ret = 0;
 
     /* Lock the TCB for this function call */
@@ -682,8 +863,8 @@ ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
     }
 
     /* Cleanup */
-    xtimer_remove(&connection_timeout);
-    xtimer_remove(&user_timeout);
+    ztimer_remove(ZTIMER_USEC, &connection_timeout);
+    ztimer_remove(ZTIMER_USEC, &user_timeout);
     tcb->status &= ~STATUS_WAIT_FOR_MSG;
     mutex_unlock(&(tcb->function_lock));
     return ret;
@@ -694,8 +875,8 @@ void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb)
     assert(tcb != NULL);
 
     msg_t msg;
-    xtimer_t connection_timeout;
     cb_arg_t connection_timeout_arg = {MSG_TYPE_CONNECTION_TIMEOUT, &(tcb->mbox)};
+    ztimer_t connection_timeout = { .callback = _cb_mbox_put_msg, .arg = &connection_timeout_arg };
 
     /* Lock the TCB for this function call */
     mutex_lock(&(tcb->function_lock));
@@ -717,6 +898,15 @@ void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb)
     _setup_timeout(&connection_timeout, CONFIG_GNRC_TCP_CONNECTION_TIMEOUT_DURATION,
                    _cb_mbox_put_msg, &connection_timeout_arg);
 
+    /* Wait until the retransmission queue has room for our FIN */
+    while (tcb->state != FSM_STATE_CLOSED && tcb->rtx_len >= CONFIG_GNRC_TCP_SND_QUEUE_SIZE) {
+        mbox_get(&(tcb->mbox), &msg);
+        if (msg.type == MSG_TYPE_CONNECTION_TIMEOUT) {
+            DEBUG("gnrc_tcp.c : gnrc_tcp_close() : CONNECTION_TIMEOUT\n");
+            _fsm(tcb, FSM_EVENT_TIMEOUT_CONNECTION, NULL, NULL, 0);
+        }
+    }
+
     /* Start connection teardown sequence */
     _fsm(tcb, FSM_EVENT_CALL_CLOSE, NULL, NULL, 0);
 
@@ -739,8 +929,11 @@ void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb)
     }
 
     /* Cleanup */
-    xtimer_remove(&connection_timeout);
+    ztimer_remove(ZTIMER_USEC, &connection_timeout);
     tcb->status &= ~STATUS_WAIT_FOR_MSG;
+
+    /* A closed TCB of a listen queue returns to its queue */
+    tcb->status &= ~STATUS_ACCEPTED;
     mutex_unlock(&(tcb->function_lock));
 }
 
@@ -754,6 +947,9 @@ void gnrc_tcp_abort(gnrc_tcp_tcb_t *tcb)
         /* Call FSM ABORT event */
         _fsm(tcb, FSM_EVENT_CALL_ABORT, NULL, NULL, 0);
     }
+
+    /* A closed TCB of a listen queue returns to its queue */
+    tcb->status &= ~STATUS_ACCEPTED;
     mutex_unlock(&(tcb->function_lock));
 }
 
@@ -83,10 +83,16 @@ static uint16_t _get_random_local_port(void)
  */
 static int _clear_retransmit(gnrc_tcp_tcb_t *tcb)
 {
-    if (tcb->pkt_retransmit != NULL) {
-        gnrc_pktbuf_release(tcb->pkt_retransmit);
-        xtimer_remove(&(tcb->tim_tout));
-        tcb->pkt_retransmit = NULL;
+    if (tcb->rtx_len > 0) {
+        for (uint8_t i = 0; i < tcb->rtx_len; i++) {
+            gnrc_pktbuf_release(tcb->pkt_retransmit[i]);
+            tcb->pkt_retransmit[i] = NULL;
+        }
+        ztimer_remove(ZTIMER_USEC, &(tcb->tim_tout));
+        tcb->rtx_len = 0;
+#if IS_USED(MODULE_GNRC_TCP_SACK)
+        tcb->rtx_sacked = 0;
+#endif
     }
     return 0;
 }
@@ -100,10 +106,11 @@ static int _clear_retransmit(gnrc_tcp_tcb_t *tcb)
  */
 static int _restart_timewait_timer(gnrc_tcp_tcb_t *tcb)
 {
-    xtimer_remove(&tcb->tim_tout);
+    ztimer_remove(ZTIMER_USEC, &tcb->tim_tout);
     tcb->msg_tout.type = MSG_TYPE_TIMEWAIT;
     tcb->msg_tout.content.ptr = (void *)tcb;
-    xtimer_set_msg(&tcb->tim_tout, 2 * CONFIG_GNRC_TCP_MSL, &tcb->msg_tout, gnrc_tcp_pid);
+    ztimer_set_msg(ZTIMER_USEC, &tcb->tim_tout, 2 * CONFIG_GNRC_TCP_MSL, &tcb->msg_tout,
+                   gnrc_tcp_pid);
     return 0;
 }
 
@@ -125,6 +132,7 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
         case FSM_STATE_CLOSED:
             /* Clear retransmit queue */
             _clear_retransmit(tcb);
+            tcb->status &= ~STATUS_SACK_PERMITTED;
 
             /* Remove connection from active connections */
             mutex_lock(&_list_tcb_lock);
@@ -267,24 +275,33 @@ static int _fsm_call_send(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
 {
     DEBUG("gnrc_tcp_fsm.c : _fsm_call_send()\n");
 
-    size_t payload = (tcb->snd_una + tcb->snd_wnd) - tcb->snd_nxt;
+    size_t sent = 0;
+
+    /* Send segments while the window is open and the retransmit queue has room */
+    while (sent < len && tcb->snd_wnd > 0 && tcb->rtx_len < CONFIG_GNRC_TCP_SND_QUEUE_SIZE) {
+        uint32_t r_edge = tcb->snd_una + tcb->snd_wnd;
+        if (LEQ_32_BIT(r_edge, tcb->snd_nxt)) {
+            break;
+        }
 
-    /* Check if window is open and all packets were transmitted */
-    if (payload > 0 && tcb->snd_wnd > 0 && tcb->pkt_retransmit == NULL) {
         /* Calculate segment size */
+        size_t payload = r_edge - tcb->snd_nxt;
         payload = (payload < CONFIG_GNRC_TCP_MSS) ? payload : CONFIG_GNRC_TCP_MSS;
         payload = (payload < tcb->mss) ? payload : tcb->mss;
-        payload = (payload < len) ? payload : len;
+        payload = (payload < (len - sent)) ? payload : (len - sent);
 
         /* Calculate payload size for this segment */
         gnrc_pktsnip_t *out_pkt = NULL;
         uint16_t seq_con = 0;
-        _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK | MSK_PSH, tcb->snd_nxt, tcb->rcv_nxt, buf, payload);
+        if (_pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK | MSK_PSH, tcb->snd_nxt, tcb->rcv_nxt,
+                       (uint8_t *)buf + sent, payload) < 0) {
+            break;
+        }
         _pkt_setup_retransmit(tcb, out_pkt, false);
         _pkt_send(tcb, out_pkt, seq_con, false);
-        return payload;
+        sent += payload;
     }
-    return 0;
+    return sent;
 }
 
 /**
@@ -633,8 +650,16 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 /* Acknowledge previously sent data */
                 if (LSS_32_BIT(tcb->snd_una, seg_ack) && LEQ_32_BIT(seg_ack, tcb->snd_nxt)) {
                     tcb->snd_una = seg_ack;
+                    tcb->dupacks = 0;
                     _pkt_acknowledge(tcb, seg_ack);
                 }
+                /* Count duplicate ACKs: Retransmit lost segments without waiting for RTO */
+                else if (seg_ack == tcb->snd_una && pay_len == 0 && seg_wnd == tcb->snd_wnd &&
+                         tcb->rtx_len > 0) {
+                    if (++tcb->dupacks == CONFIG_GNRC_TCP_DUPACK_THRESHOLD) {
+                        _pkt_retransmit_lost(tcb);
+                    }
+                }
                 /* ACK received for something not yet sent: Reply with pure ACK */
                 else if (LSS_32_BIT(tcb->snd_nxt, seg_ack)) {
                     _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt,
@@ -657,25 +682,25 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 /* Additional processing */
                 /* Check additionally if previously sent FIN was acknowledged */
                 if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->rtx_len == 0) {
                         _transition_to(tcb, FSM_STATE_FIN_WAIT_2);
                     }
                 }
                 /* If retransmission queue is empty, acknowledge close operation */
                 if (tcb->state == FSM_STATE_FIN_WAIT_2) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->rtx_len == 0) {
                         /* Optional: Unblock user close operation */
                     }
                 }
                 /* If our FIN has been acknowledged: Transition to TIME_WAIT */
                 if (tcb->state == FSM_STATE_CLOSING) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->rtx_len == 0) {
                         _transition_to(tcb, FSM_STATE_TIME_WAIT);
                     }
                 }
                 /* If our FIN was acknowledged and status is LAST_ACK: close connection */
                 if (tcb->state == FSM_STATE_LAST_ACK) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->rtx_len == 0) {
                         _transition_to(tcb, FSM_STATE_CLOSED);
                         return 0;
                     }
@@ -729,7 +754,7 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 _transition_to(tcb, FSM_STATE_CLOSE_WAIT);
             }
             else if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                if (tcb->pkt_retransmit == NULL) {
+                if (tcb->rtx_len == 0) {
                     _transition_to(tcb, FSM_STATE_TIME_WAIT);
                 }
                 else {
@@ -771,9 +796,21 @@ static int _fsm_timeout_timewait(gnrc_tcp_tcb_t *tcb)
 static int _fsm_timeout_retransmit(gnrc_tcp_tcb_t *tcb)
 {
     DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_retransmit()\n");
-    if (tcb->pkt_retransmit != NULL) {
-        _pkt_setup_retransmit(tcb, tcb->pkt_retransmit, true);
-        _pkt_send(tcb, tcb->pkt_retransmit, 0, true);
+    /* A listen queue TCB waiting in vain for an ACK is freed for other peers */
+    if (tcb->state == FSM_STATE_SYN_RCVD && (tcb->status & STATUS_LISTENING) &&
+        tcb->retries >= CONFIG_GNRC_TCP_SYN_RCVD_RETRIES) {
+        DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_retransmit() : SYN_RCVD -> LISTEN\n");
+        _clear_retransmit(tcb);
+        _transition_to(tcb, FSM_STATE_LISTEN);
+        return 0;
+    }
+    if (tcb->rtx_len > 0) {
+#if IS_USED(MODULE_GNRC_TCP_SACK)
+        /* The peer may discard SACKed data: forget SACK state (see RFC 2018) */
+        tcb->rtx_sacked = 0;
+#endif
+        _pkt_setup_retransmit(tcb, tcb->pkt_retransmit[0], true);
+        _pkt_send(tcb, tcb->pkt_retransmit[0], 0, true);
     }
     else {
         DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_retransmit() : Retransmit queue is empty\n");
@@ -902,6 +939,17 @@ int _fsm(gnrc_tcp_tcb_t *tcb, fsm_event_t event, gnrc_pktsnip_t *in_pkt, void *b
         msg.type = MSG_TYPE_NOTIFY_USER;
         mbox_try_put(&(tcb->mbox), &msg);
     }
+    /* Notify listen queue if the connection might be ready for accept */
+    if ((tcb->status & STATUS_NOTIFY_USER) && (tcb->status & STATUS_LISTENING) &&
+        !(tcb->status & STATUS_ACCEPTED)) {
+        msg_t msg;
+        msg.type = MSG_TYPE_NOTIFY_USER;
+        mbox_try_put(&(tcb->queue->mbox), &msg);
+        if (tcb->queue->cb &&
+            (tcb->state == FSM_STATE_ESTABLISHED || tcb->state == FSM_STATE_CLOSE_WAIT)) {
+            tcb->queue->cb(tcb->queue, tcb->queue->cb_arg);
+        }
+    }
     /* Unlock FSM */
     mutex_unlock(&(tcb->fsm_lock));
     return result;
@@ -16,8 +16,10 @@
  * @author      Simon Brummer <simon.brummer@posteo.de>
  * @}
  */
+#include <string.h>
 #include "internal/common.h"
 #include "internal/option.h"
+#include "internal/pkt.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -62,6 +64,39 @@ int _option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
                       tcb->mss);
                 break;
 
+            case TCP_OPTION_KIND_SACK_PERM:
+                if (opt_left < TCP_OPTION_LENGTH_MIN || option->length > opt_left ||
+                    option->length != TCP_OPTION_LENGTH_SACK_PERM) {
+
+                    DEBUG("gnrc_tcp_option.c : _option_parse() : invalid SACK permitted Option length.\n");
+                    return -1;
+                }
+                if (IS_USED(MODULE_GNRC_TCP_SACK)) {
+                    tcb->status |= STATUS_SACK_PERMITTED;
+                }
+                DEBUG("gnrc_tcp_option.c : _option_parse() : SACK permitted option found.\n");
+                break;
+
+#if IS_USED(MODULE_GNRC_TCP_SACK)
+            case TCP_OPTION_KIND_SACK:
+                if (opt_left < TCP_OPTION_LENGTH_MIN || option->length > opt_left ||
+                    ((option->length - TCP_OPTION_LENGTH_MIN) % (sizeof(network_uint32_t) * 2)) != 0) {
+
+                    DEBUG("gnrc_tcp_option.c : _option_parse() : invalid SACK Option length.\n");
+                    return -1;
+                }
+                /* Ignore SACK blocks if SACK was not negotiated on connection setup */
+                if (tcb->status & STATUS_SACK_PERMITTED) {
+                    for (uint8_t i = 0; i < option->length - TCP_OPTION_LENGTH_MIN;
+                         i += sizeof(network_uint32_t) * 2) {
+                        network_uint32_t edges[2];
+                        memcpy(edges, &option->value[i], sizeof(edges));
+                        _pkt_sack(tcb, byteorder_ntohl(edges[0]), byteorder_ntohl(edges[1]));
+                    }
+                }
+                break;
+#endif
+
             default:
                 if (opt_left >= TCP_OPTION_LENGTH_MIN) {
                     DEBUG("gnrc_tcp_option.c : _option_parse() : Unsupported option found.\
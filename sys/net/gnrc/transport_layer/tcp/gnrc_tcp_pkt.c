@@ -171,6 +171,10 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
     /* Add MSS option if SYN is sent */
     if (ctl & MSK_SYN) {
         offset += 1;
+#if IS_USED(MODULE_GNRC_TCP_SACK)
+        /* Add SACK permitted option, padded with two NOP options */
+        offset += 1;
+#endif
     }
     /* Set offset and control bit accordingly */
     tcp_hdr.off_ctl = byteorder_htons(_option_build_offset_control(offset, ctl));
@@ -203,8 +207,18 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
             if (ctl & MSK_SYN) {
                 network_uint32_t mss_option = byteorder_htonl(_option_build_mss(CONFIG_GNRC_TCP_MSS));
                 memcpy(opt_ptr, &mss_option, sizeof(mss_option));
+                opt_ptr += sizeof(mss_option);
+                opt_left -= sizeof(mss_option);
+            }
+#if IS_USED(MODULE_GNRC_TCP_SACK)
+            /* If SYN flag is set: Add SACK permitted option */
+            if (ctl & MSK_SYN) {
+                network_uint32_t sack_perm_option = byteorder_htonl(_option_build_sack_perm());
+                memcpy(opt_ptr, &sack_perm_option, sizeof(sack_perm_option));
+                opt_ptr += sizeof(sack_perm_option);
+                opt_left -= sizeof(sack_perm_option);
             }
-            /* Increase opt_ptr and decrease opt_left, if other options are added */
+#endif
             /* NOTE: Add additional options here */
         }
         *(out_pkt) = tcp_snp;
@@ -267,11 +281,15 @@ int _pkt_send(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *out_pkt, const uint16_t seq_c
         return -EINVAL;
     }
 
-    /* If this is no retransmission, advance sequence number and measure time */
+    /* If this is no retransmission, advance sequence number */
     if (!retransmit) {
-        tcb->retries = 0;
         tcb->snd_nxt += seq_con;
-        tcb->rtt_start = xtimer_now().ticks32;
+
+        /* Measure time if this segment starts a new flight of data */
+        if (seq_con > 0 && tcb->rtx_len <= 1) {
+            tcb->retries = 0;
+            tcb->rtt_start = ztimer_now(ZTIMER_USEC);
+        }
     }
     else {
         tcb->retries += 1;
@@ -349,6 +367,58 @@ uint32_t _pkt_get_pay_len(gnrc_pktsnip_t *pkt)
     return seg_len;
 }
 
+/**
+ * @brief Calculates the retransmission timeout from the current RTT estimates.
+ *
+ * @param[in,out] tcb   TCB holding the RTT estimates.
+ */
+static void _calc_rto(gnrc_tcp_tcb_t *tcb)
+{
+    /* If there is no measurement yet: rto is 1 sec (Lower Bound) */
+    if (tcb->srtt == RTO_UNINITIALIZED || tcb->rtt_var == RTO_UNINITIALIZED) {
+        tcb->rto = CONFIG_GNRC_TCP_RTO_LOWER_BOUND;
+    }
+    else {
+        tcb->rto = tcb->srtt + _max(CONFIG_GNRC_TCP_RTO_GRANULARITY, CONFIG_GNRC_TCP_RTO_K * tcb->rtt_var);
+    }
+}
+
+/**
+ * @brief (Re)starts the retransmission timer for the oldest queued segment.
+ *
+ * @param[in,out] tcb   TCB holding the retransmission timer.
+ */
+static void _start_rtx_timer(gnrc_tcp_tcb_t *tcb)
+{
+    /* Perform boundary checks on current RTO before usage */
+    if (tcb->rto < (int32_t) CONFIG_GNRC_TCP_RTO_LOWER_BOUND) {
+        tcb->rto = CONFIG_GNRC_TCP_RTO_LOWER_BOUND;
+    }
+    else if (tcb->rto > (int32_t) CONFIG_GNRC_TCP_RTO_UPPER_BOUND) {
+        tcb->rto = CONFIG_GNRC_TCP_RTO_UPPER_BOUND;
+    }
+
+    /* Setup retransmission timer, msg to TCP thread with ptr to TCB */
+    tcb->msg_tout.type = MSG_TYPE_RETRANSMISSION;
+    tcb->msg_tout.content.ptr = (void *) tcb;
+    ztimer_set_msg(ZTIMER_USEC, &tcb->tim_tout, tcb->rto, &tcb->msg_tout, gnrc_tcp_pid);
+}
+
+/**
+ * @brief Extracts the sequence number of a queued segment.
+ *
+ * @param[in] pkt   Segment in the retransmission queue.
+ *
+ * @returns   Sequence number of @p pkt.
+ */
+static uint32_t _get_seq_num(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *snp = NULL;
+
+    LL_SEARCH_SCALAR(pkt, snp, type, GNRC_NETTYPE_TCP);
+    return byteorder_ntohl(((tcp_hdr_t *) snp->data)->seq_num);
+}
+
 int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool retransmit)
 {
     gnrc_pktsnip_t *snp = NULL;
@@ -361,9 +431,32 @@ int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool r
         return -EINVAL;
     }
 
-    /* Check if retransmit queue is full and pkt is not already in retransmit queue */
-    if (tcb->pkt_retransmit != NULL && tcb->pkt_retransmit != pkt) {
-        DEBUG("gnrc_tcp_pkt.c : _pkt_setup_retransmit() : Nothing to do\n");
+    /* Retransmissions are only done for the oldest segment in the queue */
+    if (retransmit) {
+        if (tcb->rtx_len == 0 || tcb->pkt_retransmit[0] != pkt) {
+            DEBUG("gnrc_tcp_pkt.c : _pkt_setup_retransmit() : Nothing to do\n");
+            return -EINVAL;
+        }
+
+        /* Every send attempt consumes a user */
+        gnrc_pktbuf_hold(pkt, 1);
+
+        /* Double the rto (Timer Backoff) */
+        tcb->rto *= 2;
+
+        /* If the transmission has been tried five times, we assume srtt and rtt_var are bogus */
+        /* New measurements must be taken the next time something is sent. */
+        if (tcb->retries >= 5) {
+            tcb->srtt = RTO_UNINITIALIZED;
+            tcb->rtt_var = RTO_UNINITIALIZED;
+        }
+        _start_rtx_timer(tcb);
+        return 0;
+    }
+
+    /* Check if retransmit queue is full */
+    if (tcb->rtx_len >= CONFIG_GNRC_TCP_SND_QUEUE_SIZE) {
+        DEBUG("gnrc_tcp_pkt.c : _pkt_setup_retransmit() : Retransmit queue is full\n");
         return -ENOMEM;
     }
 
@@ -377,89 +470,126 @@ int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool r
         return 0;
     }
 
-    /* Assign pkt and increase users: every send attempt consumes a user */
-    tcb->pkt_retransmit = pkt;
+    /* Append pkt and increase users: every send attempt consumes a user */
+    tcb->pkt_retransmit[tcb->rtx_len++] = pkt;
     gnrc_pktbuf_hold(pkt, 1);
 
-    /* RTO adjustment */
-    if (!retransmit) {
-        /* If this is the first transmission: rto is 1 sec (Lower Bound) */
-        if (tcb->srtt == RTO_UNINITIALIZED || tcb->rtt_var == RTO_UNINITIALIZED) {
-            tcb->rto = CONFIG_GNRC_TCP_RTO_LOWER_BOUND;
-        }
-        else {
-            tcb->rto = tcb->srtt + _max(CONFIG_GNRC_TCP_RTO_GRANULARITY, CONFIG_GNRC_TCP_RTO_K * tcb->rtt_var);
-        }
+    /* The timer is already running for an older segment */
+    if (tcb->rtx_len > 1) {
+        return 0;
     }
-    else {
-        /* If this is a retransmission: Double the rto (Timer Backoff) */
-        tcb->rto *= 2;
+    _calc_rto(tcb);
+    _start_rtx_timer(tcb);
+    return 0;
+}
 
-        /* If the transmission has been tried five times, we assume srtt and rtt_var are bogus */
-        /* New measurements must be taken the next time something is sent. */
-        if (tcb->retries >= 5) {
-            tcb->srtt = RTO_UNINITIALIZED;
-            tcb->rtt_var = RTO_UNINITIALIZED;
+int _pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack)
+{
+    uint8_t acked = 0;
+
+    /* Retransmission queue is empty. Nothing to ACK there */
+    if (tcb->rtx_len == 0) {
+        DEBUG("gnrc_tcp_pkt.c : _pkt_acknowledge() : There is no packet to ack\n");
+        return -ENODATA;
+    }
+
+    /* Release all segments that are acknowledged in full */
+    while (acked < tcb->rtx_len) {
+        gnrc_pktsnip_t *pkt = tcb->pkt_retransmit[acked];
+        uint32_t seg = _get_seq_num(pkt) + _pkt_get_seg_len(pkt) - 1;
+
+        if (!LSS_32_BIT(seg, ack)) {
+            break;
         }
+        gnrc_pktbuf_release(pkt);
+        acked++;
+    }
+    if (acked == 0) {
+        return 0;
     }
 
-    /* Perform boundary checks on current RTO before usage */
-    if (tcb->rto < (int32_t) CONFIG_GNRC_TCP_RTO_LOWER_BOUND) {
-        tcb->rto = CONFIG_GNRC_TCP_RTO_LOWER_BOUND;
+    ztimer_remove(ZTIMER_USEC, &(tcb->tim_tout));
+    tcb->rtx_len -= acked;
+    memmove(tcb->pkt_retransmit, &tcb->pkt_retransmit[acked],
+            tcb->rtx_len * sizeof(tcb->pkt_retransmit[0]));
+#if IS_USED(MODULE_GNRC_TCP_SACK)
+    tcb->rtx_sacked = (acked < 32) ? (tcb->rtx_sacked >> acked) : 0;
+#endif
+
+    /* Measure round trip time */
+    int32_t rtt = ztimer_now(ZTIMER_USEC) - tcb->rtt_start;
+
+    /* Use time only if there was no timer overflow and no retransmission (Karns Algorithm) */
+    if (tcb->retries == 0 && rtt > 0 && tcb->rtt_start != 0) {
+        /* If this is the first sample taken */
+        if (tcb->srtt == RTO_UNINITIALIZED && tcb->rtt_var == RTO_UNINITIALIZED) {
+            tcb->srtt = rtt;
+            tcb->rtt_var = (rtt >> 1);
+        }
+        /* If this is a subsequent sample */
+        else {
+            tcb->rtt_var = (tcb->rtt_var / CONFIG_GNRC_TCP_RTO_B_DIV) * (CONFIG_GNRC_TCP_RTO_B_DIV-1);
+            tcb->rtt_var += abs(tcb->srtt - rtt) / CONFIG_GNRC_TCP_RTO_B_DIV;
+            tcb->srtt = (tcb->srtt / CONFIG_GNRC_TCP_RTO_A_DIV) * (CONFIG_GNRC_TCP_RTO_A_DIV-1);
+            tcb->srtt += rtt / CONFIG_GNRC_TCP_RTO_A_DIV;
+        }
     }
-    else if (tcb->rto > (int32_t) CONFIG_GNRC_TCP_RTO_UPPER_BOUND) {
-        tcb->rto = CONFIG_GNRC_TCP_RTO_UPPER_BOUND;
+    /* Only one sample per window of data: the measured segment left the queue */
+    tcb->rtt_start = 0;
+    tcb->retries = 0;
+
+    /* Restart the timer for the remaining segments (see RFC 6298, 5.3) */
+    _calc_rto(tcb);
+    if (tcb->rtx_len > 0) {
+        _start_rtx_timer(tcb);
     }
 
-    /* Setup retransmission timer, msg to TCP thread with ptr to TCB */
-    tcb->msg_tout.type = MSG_TYPE_RETRANSMISSION;
-    tcb->msg_tout.content.ptr = (void *) tcb;
-    xtimer_set_msg(&tcb->tim_tout, tcb->rto, &tcb->msg_tout, gnrc_tcp_pid);
+    /* Space in the send queue became available: wake up a blocked sender */
+    tcb->status |= STATUS_NOTIFY_USER;
     return 0;
 }
 
-int _pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack)
+#if IS_USED(MODULE_GNRC_TCP_SACK)
+void _pkt_sack(gnrc_tcp_tcb_t *tcb, const uint32_t left, const uint32_t right)
 {
-    uint32_t seg = 0;
-    gnrc_pktsnip_t *snp = NULL;
-    tcp_hdr_t *hdr;
+    for (uint8_t i = 0; i < tcb->rtx_len; i++) {
+        gnrc_pktsnip_t *pkt = tcb->pkt_retransmit[i];
+        uint32_t seq = _get_seq_num(pkt);
 
-    /* Retransmission queue is empty. Nothing to ACK there */
-    if (tcb->pkt_retransmit == NULL) {
-        DEBUG("gnrc_tcp_pkt.c : _pkt_acknowledge() : There is no packet to ack\n");
-        return -ENODATA;
+        if (LEQ_32_BIT(left, seq) && LEQ_32_BIT(seq + _pkt_get_seg_len(pkt), right)) {
+            tcb->rtx_sacked |= (1UL << i);
+        }
     }
+}
+#endif
 
-    LL_SEARCH_SCALAR(tcb->pkt_retransmit, snp, type, GNRC_NETTYPE_TCP);
-    hdr = (tcp_hdr_t *) snp->data;
-
-    /* There must be a packet, waiting to be acknowledged. */
-    seg = byteorder_ntohl(hdr->seq_num) + _pkt_get_seg_len(tcb->pkt_retransmit) - 1;
+int _pkt_retransmit_lost(gnrc_tcp_tcb_t *tcb)
+{
+    uint8_t last = 1;
 
-    /* If segment can be acknowledged -> stop timer, release packet from pktbuf and update rto. */
-    if (LSS_32_BIT(seg, ack)) {
-        xtimer_remove(&(tcb->tim_tout));
-        gnrc_pktbuf_release(tcb->pkt_retransmit);
-        tcb->pkt_retransmit = NULL;
+    if (tcb->rtx_len == 0) {
+        return -ENODATA;
+    }
 
-        /* Measure round trip time */
-        int32_t rtt = xtimer_now().ticks32 - tcb->rtt_start;
+#if IS_USED(MODULE_GNRC_TCP_SACK)
+    /* All segments below the highest SACKed one are considered lost */
+    for (uint8_t i = 0; i < tcb->rtx_len; i++) {
+        if (tcb->rtx_sacked & (1UL << i)) {
+            last = i;
+        }
+    }
+    last = (last == 0) ? 1 : last;
+#endif
 
-        /* Use time only if there was no timer overflow and no retransmission (Karns Algorithm) */
-        if (tcb->retries == 0 && rtt > 0) {
-            /* If this is the first sample taken */
-            if (tcb->srtt == RTO_UNINITIALIZED && tcb->rtt_var == RTO_UNINITIALIZED) {
-                tcb->srtt = rtt;
-                tcb->rtt_var = (rtt >> 1);
-            }
-            /* If this is a subsequent sample */
-            else {
-                tcb->rtt_var = (tcb->rtt_var / CONFIG_GNRC_TCP_RTO_B_DIV) * (CONFIG_GNRC_TCP_RTO_B_DIV-1);
-                tcb->rtt_var += abs(tcb->srtt - rtt) / CONFIG_GNRC_TCP_RTO_B_DIV;
-                tcb->srtt = (tcb->srtt / CONFIG_GNRC_TCP_RTO_A_DIV) * (CONFIG_GNRC_TCP_RTO_A_DIV-1);
-                tcb->srtt += rtt / CONFIG_GNRC_TCP_RTO_A_DIV;
-            }
+    for (uint8_t i = 0; i < last; i++) {
+#if IS_USED(MODULE_GNRC_TCP_SACK)
+        if (tcb->rtx_sacked & (1UL << i)) {
+            continue;
         }
+#endif
+        /* Every send attempt consumes a user */
+        gnrc_pktbuf_hold(tcb->pkt_retransmit[i], 1);
+        _pkt_send(tcb, tcb->pkt_retransmit[i], 0, true);
     }
     return 0;
 }
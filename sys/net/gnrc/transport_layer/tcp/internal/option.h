@@ -42,6 +42,19 @@ static inline uint32_t _option_build_mss(uint16_t mss)
             ((uint32_t) TCP_OPTION_LENGTH_MSS << 16) | mss);
 }
 
+/**
+ * @brief Helper function to build the SACK permitted option, preceded by
+ *        two NOP options for alignment.
+ *
+ * @returns   SACK permitted option value.
+ */
+static inline uint32_t _option_build_sack_perm(void)
+{
+    return (((uint32_t) TCP_OPTION_KIND_NOP << 24) |
+            ((uint32_t) TCP_OPTION_KIND_NOP << 16) |
+            ((uint32_t) TCP_OPTION_KIND_SACK_PERM << 8) | TCP_OPTION_LENGTH_SACK_PERM);
+}
+
 /**
  * @brief Helper function to build the combined option and control flag field.
  *
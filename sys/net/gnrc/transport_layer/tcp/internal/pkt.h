@@ -129,6 +129,30 @@ int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool r
  */
 int _pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack);
 
+/**
+ * @brief Marks segments in the retransmission queue as selectively
+ *        acknowledged (see RFC 2018).
+ *
+ * @param[in,out] tcb     TCB holding the connection information.
+ * @param[in]     left    Left edge of the SACK block.
+ * @param[in]     right   Right edge of the SACK block.
+ */
+void _pkt_sack(gnrc_tcp_tcb_t *tcb, const uint32_t left, const uint32_t right);
+
+/**
+ * @brief Retransmits segments considered lost after duplicate ACKs.
+ *
+ * @note Without module `gnrc_tcp_sack`, only the oldest segment is
+ *       retransmitted. Otherwise all segments that are not SACKed and below
+ *       the highest SACKed segment are retransmitted.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ *
+ * @returns   Zero on success.
+ *            -ENODATA if the retransmission queue is empty.
+ */
+int _pkt_retransmit_lost(gnrc_tcp_tcb_t *tcb);
+
 /**
  * @brief Calculates checksum over payload, TCP header and network layer header.
  *
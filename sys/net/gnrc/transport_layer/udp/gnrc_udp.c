@@ -34,11 +34,16 @@
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+#if !IS_USED(MODULE_GNRC_SINGLE_THREAD) || IS_USED(MODULE_GNRC_UDP_FASTPATH)
 /**
  * @brief   Save the UDP's thread PID for later reference
+ *
+ * Never set with module `gnrc_single_thread`, which calls UDP directly anyway.
  */
 static kernel_pid_t _pid = KERNEL_PID_UNDEF;
+#endif
 
+#if !IS_USED(MODULE_GNRC_SINGLE_THREAD)
 /**
  * @brief   Allocate memory for the UDP thread's stack
  */
@@ -47,6 +52,7 @@ static char _stack[GNRC_UDP_STACK_SIZE + THREAD_EXTRA_STACKSIZE_PRINTF];
 #else
 static char _stack[GNRC_UDP_STACK_SIZE];
 #endif
+#endif
 
 /**
  * @brief   Calculate the UDP checksum dependent on the network protocol
@@ -164,45 +170,44 @@ static void _receive(gnrc_pktsnip_t *pkt)
     }
 }
 
+#if IS_USED(MODULE_GNRC_UDP_FASTPATH)
+bool gnrc_udp_fastpath(gnrc_pktsnip_t *pkt)
+{
+    const udp_hdr_t *hdr = pkt->data;
+
+    /* the UDP thread is registered for all UDP packets once it runs, no one
+     * else may miss out on the packet by skipping it */
+    if ((_pid == KERNEL_PID_UNDEF) || (pkt->size < sizeof(udp_hdr_t)) ||
+        (gnrc_netreg_num(GNRC_NETTYPE_UDP, GNRC_NETREG_DEMUX_CTX_ALL) != 1) ||
+        (gnrc_netreg_num(GNRC_NETTYPE_IPV6, PROTNUM_UDP) != 0) ||
+        (gnrc_netreg_num(GNRC_NETTYPE_UDP,
+                         byteorder_ntohs(hdr->dst_port)) == 0)) {
+        return false;
+    }
+    DEBUG("udp: deliver packet to port %u on fast path\n",
+          byteorder_ntohs(hdr->dst_port));
+    _receive(pkt);
+    return true;
+}
+#endif
+
 static void _send(gnrc_pktsnip_t *pkt)
 {
     udp_hdr_t *hdr;
-    gnrc_pktsnip_t *udp_snip, *tmp;
+    gnrc_pktsnip_t *udp_snip;
     gnrc_nettype_t target_type = pkt->type;
 
-    /* write protect first header */
-    tmp = gnrc_pktbuf_start_write(pkt);
-    if (tmp == NULL) {
-        DEBUG("udp: cannot send packet: unable to allocate packet\n");
-        gnrc_pktbuf_release(pkt);
-        return;
-    }
-    pkt = tmp;
-    udp_snip = tmp->next;
-
-    /* get and write protect until udp snip */
-    while ((udp_snip != NULL) && (udp_snip->type != GNRC_NETTYPE_UDP)) {
-        udp_snip = gnrc_pktbuf_start_write(udp_snip);
-        if (udp_snip == NULL) {
-            DEBUG("udp: cannot send packet: unable to allocate packet\n");
-            gnrc_pktbuf_release(pkt);
-            return;
-        }
-        tmp->next = udp_snip;
-        tmp = udp_snip;
-        udp_snip = udp_snip->next;
-    }
-
+    udp_snip = gnrc_pktsnip_search_type(pkt->next, GNRC_NETTYPE_UDP);
     assert(udp_snip != NULL);
 
-    /* write protect UDP snip */
-    udp_snip = gnrc_pktbuf_start_write(udp_snip);
-    if (udp_snip == NULL) {
+    /* write protect all headers up to and including the UDP header, the
+     * payload stays shared */
+    pkt = gnrc_pktbuf_clone_headers(pkt, udp_snip->next);
+    if (pkt == NULL) {
         DEBUG("udp: cannot send packet: unable to allocate packet\n");
-        gnrc_pktbuf_release(pkt);
         return;
     }
-    tmp->next = udp_snip;
+    udp_snip = gnrc_pktsnip_search_type(pkt->next, GNRC_NETTYPE_UDP);
     hdr = (udp_hdr_t *)udp_snip->data;
     /* fill in size field */
     hdr->length = byteorder_htons(gnrc_pkt_len(udp_snip));
@@ -220,6 +225,21 @@ static void _send(gnrc_pktsnip_t *pkt)
     }
 }
 
+#if IS_USED(MODULE_GNRC_SINGLE_THREAD)
+static void _netapi_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    (void)ctx;
+    /* UDP keeps no state, so it runs to completion in the dispatching thread */
+    if (cmd == GNRC_NETAPI_MSG_TYPE_RCV) {
+        DEBUG("udp: GNRC_NETAPI_MSG_TYPE_RCV\n");
+        _receive(pkt);
+    }
+    else {
+        DEBUG("udp: GNRC_NETAPI_MSG_TYPE_SND\n");
+        _send(pkt);
+    }
+}
+#else
 static void *_event_loop(void *arg)
 {
     (void)arg;
@@ -260,6 +280,7 @@ static void *_event_loop(void *arg)
     /* never reached */
     return NULL;
 }
+#endif
 
 int gnrc_udp_calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr)
 {
@@ -303,6 +324,19 @@ gnrc_pktsnip_t *gnrc_udp_hdr_build(gnrc_pktsnip_t *payload, uint16_t src,
 
 int gnrc_udp_init(void)
 {
+#if IS_USED(MODULE_GNRC_SINGLE_THREAD)
+    static gnrc_netreg_entry_cbd_t cbd;
+    static gnrc_netreg_entry_t netreg = GNRC_NETREG_ENTRY_INIT_CB(
+                                            GNRC_NETREG_DEMUX_CTX_ALL, &cbd
+                                        );
+
+    /* check if UDP is already registered */
+    if (cbd.cb == NULL) {
+        cbd.cb = _netapi_cb;
+        gnrc_netreg_register(GNRC_NETTYPE_UDP, &netreg);
+    }
+    return 0;
+#else
     /* check if thread is already running */
     if (_pid == KERNEL_PID_UNDEF) {
         /* start UDP thread */
@@ -310,4 +344,5 @@ int gnrc_udp_init(void)
                              THREAD_CREATE_STACKTEST, _event_loop, NULL, "udp");
     }
     return _pid;
+#endif
 }
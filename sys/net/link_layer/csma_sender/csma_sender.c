@@ -162,7 +162,7 @@ int csma_sender_csma_ca_send(netdev_t *dev, iolist_t *iolist,
 
     int nb = 0, be = conf->min_be;
 
-    while (nb <= conf->max_be) {
+    while (nb <= conf->max_backoffs) {
         /* delay for an adequate random backoff period */
         uint32_t bp = choose_backoff_period(be, conf);
         xtimer_usleep(bp);
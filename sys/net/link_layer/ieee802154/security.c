@@ -0,0 +1,420 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_ieee802154_security
+ * @{
+ *
+ * @file
+ * @brief       IEEE 802.15.4 security sublayer implementation
+ *
+ * CCM* is built from the ECB and CBC operations of the context, so that radio
+ * AES engines only need to provide the raw block cipher. The data is passed
+ * to the engine in chunks of several blocks to save round trips.
+ *
+ * @author      ML!PA Consulting GmbH
+ * @}
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "byteorder.h"
+#include "net/ieee802154.h"
+#include "net/ieee802154_security.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define BLOCK               IEEE802154_SEC_BLOCK_SIZE
+/* blocks passed to the cipher operations at once */
+#define CHUNK_BLOCKS        (4U)
+#define NONCE_LEN           (13U)
+/* length of the message length field, 15 - NONCE_LEN */
+#define CCM_L               (2U)
+
+typedef struct {
+    uint8_t buf[CHUNK_BLOCKS * BLOCK];
+    uint8_t x[BLOCK];
+    unsigned fill;
+} _mac_t;
+
+static void _put_le32(uint8_t *buf, uint32_t val)
+{
+    for (unsigned i = 0; i < sizeof(val); i++) {
+        buf[i] = val >> (8 * i);
+    }
+}
+
+static uint32_t _get_le32(const uint8_t *buf)
+{
+    uint32_t val = 0;
+
+    for (unsigned i = sizeof(val); i > 0; i--) {
+        val = (val << 8) | buf[i - 1];
+    }
+    return val;
+}
+
+static void _sw_set_key(ieee802154_sec_dev_t *dev, const uint8_t *key)
+{
+    ieee802154_sec_context_t *ctx = dev->ctx;
+
+    cipher_init(&ctx->cipher, CIPHER_AES_128, key, BLOCK);
+}
+
+static void _sw_ecb(const ieee802154_sec_dev_t *dev, uint8_t *cipher,
+                    const uint8_t *plain, uint8_t nblocks)
+{
+    ieee802154_sec_context_t *ctx = dev->ctx;
+
+    cipher_encrypt_blocks(&ctx->cipher, plain, cipher, nblocks);
+}
+
+static void _sw_cbc(const ieee802154_sec_dev_t *dev, uint8_t *cipher,
+                    const uint8_t *iv, const uint8_t *plain, uint8_t nblocks)
+{
+    ieee802154_sec_context_t *ctx = dev->ctx;
+    uint8_t tmp[BLOCK];
+
+    for (unsigned i = 0; i < nblocks; i++) {
+        for (unsigned j = 0; j < BLOCK; j++) {
+            tmp[j] = plain[j] ^ iv[j];
+        }
+        cipher_encrypt(&ctx->cipher, tmp, cipher);
+        iv = cipher;
+        plain += BLOCK;
+        cipher += BLOCK;
+    }
+}
+
+const ieee802154_radio_cipher_ops_t ieee802154_radio_cipher_ops = {
+    .set_key = _sw_set_key,
+    .ecb = _sw_ecb,
+    .cbc = _sw_cbc,
+};
+
+static uint8_t _mic_len(uint8_t level)
+{
+    static const uint8_t len[] = { 0, 4, 8, 16 };
+
+    return len[level & 0x03];
+}
+
+static bool _encrypts(uint8_t level)
+{
+    return level & IEEE802154_SEC_SCF_SECLEVEL_ENC;
+}
+
+static void _load_key(ieee802154_sec_context_t *ctx, uint8_t index)
+{
+    if (ctx->key_loaded != index) {
+        ctx->dev.cipher_ops->set_key(&ctx->dev, ctx->keys[index - 1]);
+        ctx->key_loaded = index;
+    }
+}
+
+static void _nonce(uint8_t *nonce, const uint8_t *src_address,
+                   uint32_t frame_counter, uint8_t level)
+{
+    be_uint32_t fc = byteorder_htonl(frame_counter);
+
+    memcpy(nonce, src_address, IEEE802154_LONG_ADDRESS_LEN);
+    memcpy(nonce + IEEE802154_LONG_ADDRESS_LEN, &fc, sizeof(fc));
+    nonce[NONCE_LEN - 1] = level;
+}
+
+static void _mac_flush(ieee802154_sec_context_t *ctx, _mac_t *m)
+{
+    unsigned nblocks = m->fill / BLOCK;
+
+    if (nblocks) {
+        ctx->dev.cipher_ops->cbc(&ctx->dev, m->buf, m->x, m->buf, nblocks);
+        memcpy(m->x, m->buf + (nblocks - 1) * BLOCK, BLOCK);
+        m->fill = 0;
+    }
+}
+
+static void _mac_update(ieee802154_sec_context_t *ctx, _mac_t *m,
+                        const uint8_t *data, size_t len)
+{
+    while (len) {
+        size_t n = sizeof(m->buf) - m->fill;
+        if (n > len) {
+            n = len;
+        }
+        memcpy(m->buf + m->fill, data, n);
+        m->fill += n;
+        data += n;
+        len -= n;
+        if (m->fill == sizeof(m->buf)) {
+            _mac_flush(ctx, m);
+        }
+    }
+}
+
+static void _mac_pad(_mac_t *m)
+{
+    unsigned rem = m->fill % BLOCK;
+
+    if (rem) {
+        memset(m->buf + m->fill, 0, BLOCK - rem);
+        m->fill += BLOCK - rem;
+    }
+}
+
+/* CBC-MAC over B0, the additional data and the message. Without encryption
+ * the payload is part of the additional data, otherwise it is the message. */
+static void _mac(ieee802154_sec_context_t *ctx, uint8_t *mac,
+                 const uint8_t *nonce, uint8_t level,
+                 const uint8_t *header, uint16_t header_len,
+                 const uint8_t *payload, uint16_t payload_len)
+{
+    uint8_t mic_len = _mic_len(level);
+    uint16_t a_len = header_len;
+    uint16_t msg_len = payload_len;
+    _mac_t m = { .fill = BLOCK };
+    uint8_t l_a[2];
+
+    if (!_encrypts(level)) {
+        a_len += payload_len;
+        msg_len = 0;
+    }
+
+    m.buf[0] = 0x40 | (((mic_len - 2) / 2) << 3) | (CCM_L - 1);
+    memcpy(&m.buf[1], nonce, NONCE_LEN);
+    byteorder_htobebufs(&m.buf[1 + NONCE_LEN], msg_len);
+
+    /* the header is never empty, so there always is additional data */
+    byteorder_htobebufs(l_a, a_len);
+    _mac_update(ctx, &m, l_a, sizeof(l_a));
+    _mac_update(ctx, &m, header, header_len);
+    if (!msg_len) {
+        _mac_update(ctx, &m, payload, payload_len);
+    }
+    _mac_pad(&m);
+    if (msg_len) {
+        _mac_update(ctx, &m, payload, payload_len);
+        _mac_pad(&m);
+    }
+    _mac_flush(ctx, &m);
+
+    memcpy(mac, m.x, mic_len);
+}
+
+/* encrypts or decrypts data with the key stream starting at counter i */
+static void _ctr(ieee802154_sec_context_t *ctx, const uint8_t *nonce,
+                 uint16_t i, uint8_t *data, size_t len)
+{
+    uint8_t buf[CHUNK_BLOCKS * BLOCK];
+
+    while (len) {
+        unsigned nblocks = (len + BLOCK - 1) / BLOCK;
+        if (nblocks > CHUNK_BLOCKS) {
+            nblocks = CHUNK_BLOCKS;
+        }
+        for (unsigned b = 0; b < nblocks; b++) {
+            uint8_t *a = &buf[b * BLOCK];
+            a[0] = CCM_L - 1;
+            memcpy(&a[1], nonce, NONCE_LEN);
+            byteorder_htobebufs(&a[1 + NONCE_LEN], i++);
+        }
+        ctx->dev.cipher_ops->ecb(&ctx->dev, buf, buf, nblocks);
+
+        size_t n = (len < sizeof(buf)) ? len : nblocks * BLOCK;
+        for (unsigned j = 0; j < n; j++) {
+            data[j] ^= buf[j];
+        }
+        data += n;
+        len -= n;
+    }
+}
+
+void ieee802154_sec_init(ieee802154_sec_context_t *ctx)
+{
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->dev.cipher_ops = &ieee802154_radio_cipher_ops;
+    ctx->dev.ctx = ctx;
+    ctx->security_level = CONFIG_IEEE802154_SEC_DEFAULT_SECLEVEL;
+}
+
+int ieee802154_sec_set_key(ieee802154_sec_context_t *ctx, uint8_t index,
+                           const uint8_t *key)
+{
+    if ((index == 0) || (index > CONFIG_IEEE802154_SEC_KEY_NUMOF)) {
+        return -EINVAL;
+    }
+
+    memcpy(ctx->keys[index - 1], key, BLOCK);
+    ctx->keys_valid |= 1 << (index - 1);
+    if (ctx->key_loaded == index) {
+        /* force reload */
+        ctx->key_loaded = 0;
+    }
+    if (!ctx->key_index) {
+        ctx->key_index = index;
+    }
+    return 0;
+}
+
+int ieee802154_sec_set_tx_key(ieee802154_sec_context_t *ctx, uint8_t index)
+{
+    if ((index == 0) || (index > CONFIG_IEEE802154_SEC_KEY_NUMOF) ||
+        !(ctx->keys_valid & (1 << (index - 1)))) {
+        return -EINVAL;
+    }
+
+    ctx->key_index = index;
+    return 0;
+}
+
+int ieee802154_sec_encrypt_frame(ieee802154_sec_context_t *ctx,
+                                 uint8_t *header, uint8_t *header_size,
+                                 uint8_t *payload, uint16_t payload_size,
+                                 uint8_t *mic, uint8_t *mic_size,
+                                 const uint8_t *src_address)
+{
+    uint8_t level = ctx->security_level;
+    uint8_t mic_len = _mic_len(level);
+    uint8_t nonce[NONCE_LEN];
+
+    if (!ctx->key_index) {
+        return -ENOKEY;
+    }
+    /* the frame counter must never repeat under the same key */
+    if (ctx->frame_counter == UINT32_MAX) {
+        return -EOVERFLOW;
+    }
+
+    uint32_t frame_counter = ctx->frame_counter++;
+
+    /* frame version 2006 carries the auxiliary security header */
+    header[0] |= IEEE802154_FCF_SECURITY_EN;
+    header[1] = (header[1] & ~IEEE802154_FCF_VERS_MASK) | IEEE802154_FCF_VERS_V1;
+
+    uint8_t *aux = &header[*header_size];
+    aux[0] = level | IEEE802154_SEC_SCF_KEYMODE_INDEX;
+    _put_le32(&aux[1], frame_counter);
+    aux[5] = ctx->key_index;
+    *header_size += IEEE802154_SEC_MAX_AUX_HDR_LEN;
+
+    _load_key(ctx, ctx->key_index);
+    _nonce(nonce, src_address, frame_counter, level);
+
+    if (mic_len) {
+        uint8_t s0[BLOCK];
+
+        _mac(ctx, mic, nonce, level, header, *header_size,
+             payload, payload_size);
+        memset(s0, 0, sizeof(s0));
+        _ctr(ctx, nonce, 0, s0, sizeof(s0));
+        for (unsigned i = 0; i < mic_len; i++) {
+            mic[i] ^= s0[i];
+        }
+    }
+    if (_encrypts(level)) {
+        _ctr(ctx, nonce, 1, payload, payload_size);
+    }
+
+    *mic_size = mic_len;
+    return 0;
+}
+
+static ieee802154_sec_neighbor_t *_neighbor(ieee802154_sec_context_t *ctx,
+                                            const uint8_t *src_address)
+{
+    for (unsigned i = 0; i < CONFIG_IEEE802154_SEC_NEIGHBOR_NUMOF; i++) {
+        if (!memcmp(ctx->neighbors[i].addr, src_address,
+                    IEEE802154_LONG_ADDRESS_LEN)) {
+            return &ctx->neighbors[i];
+        }
+    }
+    return NULL;
+}
+
+int ieee802154_sec_decrypt_frame(ieee802154_sec_context_t *ctx,
+                                 uint16_t frame_size,
+                                 uint8_t *header, uint8_t *header_size,
+                                 uint8_t **payload, uint16_t *payload_size,
+                                 uint8_t **mic, uint8_t *mic_size,
+                                 const uint8_t *src_address)
+{
+    uint8_t nonce[NONCE_LEN];
+    uint16_t aux_end = *header_size + IEEE802154_SEC_MAX_AUX_HDR_LEN;
+
+    if (frame_size < aux_end) {
+        return -EINVAL;
+    }
+
+    const uint8_t *aux = &header[*header_size];
+    uint8_t level = aux[0] & IEEE802154_SEC_SCF_SECLEVEL_MASK;
+    uint8_t mic_len = _mic_len(level);
+    uint32_t frame_counter = _get_le32(&aux[1]);
+    uint8_t index = aux[5];
+
+    /* only accept the configured level to prevent downgrades */
+    if (((aux[0] & IEEE802154_SEC_SCF_KEYMODE_MASK) !=
+         IEEE802154_SEC_SCF_KEYMODE_INDEX) ||
+        (level != ctx->security_level) ||
+        (frame_size < aux_end + mic_len)) {
+        return -EINVAL;
+    }
+    if ((index == 0) || (index > CONFIG_IEEE802154_SEC_KEY_NUMOF) ||
+        !(ctx->keys_valid & (1 << (index - 1)))) {
+        return -ENOKEY;
+    }
+
+    ieee802154_sec_neighbor_t *neighbor = _neighbor(ctx, src_address);
+    if (neighbor && (frame_counter <= neighbor->frame_counter)) {
+        DEBUG("ieee802154_security: replayed frame counter %lu\n",
+              (unsigned long)frame_counter);
+        return -EALREADY;
+    }
+
+    uint8_t *data = header + aux_end;
+    uint16_t data_len = frame_size - aux_end - mic_len;
+    uint8_t *received = data + data_len;
+
+    _load_key(ctx, index);
+    _nonce(nonce, src_address, frame_counter, level);
+
+    if (_encrypts(level)) {
+        _ctr(ctx, nonce, 1, data, data_len);
+    }
+    if (mic_len) {
+        uint8_t expected[IEEE802154_SEC_MAX_MIC_LEN];
+        uint8_t s0[BLOCK];
+        uint8_t diff = 0;
+
+        _mac(ctx, expected, nonce, level, header, aux_end, data, data_len);
+        memset(s0, 0, sizeof(s0));
+        _ctr(ctx, nonce, 0, s0, sizeof(s0));
+        for (unsigned i = 0; i < mic_len; i++) {
+            diff |= expected[i] ^ s0[i] ^ received[i];
+        }
+        if (diff) {
+            return -EBADMSG;
+        }
+    }
+
+    if (!neighbor) {
+        neighbor = &ctx->neighbors[ctx->neighbor_next];
+        ctx->neighbor_next = (ctx->neighbor_next + 1) %
+                             CONFIG_IEEE802154_SEC_NEIGHBOR_NUMOF;
+        memcpy(neighbor->addr, src_address, IEEE802154_LONG_ADDRESS_LEN);
+    }
+    neighbor->frame_counter = frame_counter;
+
+    *header_size = aux_end;
+    *payload = data;
+    *payload_size = data_len;
+    *mic = received;
+    *mic_size = mic_len;
+    return 0;
+}
@@ -26,6 +26,10 @@
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+/* FNV-1a parameters */
+#define FNV32_PRIME     (16777619UL)
+#define FNV32_OFFSET    (2166136261UL)
+
 static inline bool match(const l2filter_t *filter,
                          const void *addr, size_t addr_len)
 {
@@ -33,6 +37,41 @@ static inline bool match(const l2filter_t *filter,
             (memcmp(filter->addr, addr, addr_len) == 0));
 }
 
+/* Home slot of an address in the open addressed filter list */
+static unsigned _slot(const void *addr, size_t addr_len)
+{
+    const uint8_t *bytes = addr;
+    uint32_t hash = FNV32_OFFSET;
+
+    for (size_t i = 0; i < addr_len; i++) {
+        hash = (hash ^ bytes[i]) * FNV32_PRIME;
+    }
+    return hash % L2FILTER_LISTSIZE;
+}
+
+static inline unsigned _next(unsigned slot)
+{
+    return (slot + 1) % L2FILTER_LISTSIZE;
+}
+
+/* Probe for an address, returns its slot or -1 if it is not in the list */
+static int _find(const l2filter_t *list, const void *addr, size_t addr_len)
+{
+    unsigned slot = _slot(addr, addr_len);
+
+    for (unsigned i = 0; i < L2FILTER_LISTSIZE; i++) {
+        if (list[slot].addr_len == 0) {
+            /* entries are never behind an empty slot of their probe run */
+            break;
+        }
+        if (match(&list[slot], addr, addr_len)) {
+            return slot;
+        }
+        slot = _next(slot);
+    }
+    return -1;
+}
+
 void l2filter_init(l2filter_t *list)
 {
     assert(list);
@@ -46,62 +85,72 @@ int l2filter_add(l2filter_t *list, const void *addr, size_t addr_len)
 {
     assert(list && addr && (addr_len <= L2FILTER_ADDR_MAXLEN));
 
-    int res = -ENOMEM;
+    if (_find(list, addr, addr_len) >= 0) {
+        return 0;
+    }
+
+    unsigned slot = _slot(addr, addr_len);
 
     for (unsigned i = 0; i < L2FILTER_LISTSIZE; i++) {
-        if (list[i].addr_len == 0) {
-            list[i].addr_len = addr_len;
-            memcpy(list[i].addr, addr, addr_len);
-            res = 0;
-            break;
+        if (list[slot].addr_len == 0) {
+            list[slot].addr_len = addr_len;
+            memcpy(list[slot].addr, addr, addr_len);
+            return 0;
         }
+        slot = _next(slot);
     }
 
-    return res;
+    return -ENOMEM;
 }
 
 int l2filter_rm(l2filter_t *list, const void *addr, size_t addr_len)
 {
     assert(list && addr && (addr_len <= L2FILTER_ADDR_MAXLEN));
 
-    int res = -ENOENT;
+    int pos = _find(list, addr, addr_len);
 
-    for (unsigned i = 0; i < L2FILTER_LISTSIZE; i++) {
-        if (match(&list[i], addr, addr_len)) {
-            list[i].addr_len = 0;
-            res = 0;
+    if (pos < 0) {
+        return -ENOENT;
+    }
+
+    /* close the gap, so that following entries of the probe run stay
+     * reachable from their home slot */
+    unsigned hole = pos;
+    unsigned slot = _next(hole);
+
+    while (list[slot].addr_len != 0) {
+        unsigned home = _slot(list[slot].addr, list[slot].addr_len);
+        /* move the entry unless its home slot lies cyclically in
+         * (hole, slot] */
+        bool keep = (hole <= slot) ? ((hole < home) && (home <= slot))
+                                   : ((hole < home) || (home <= slot));
+        if (!keep) {
+            list[hole] = list[slot];
+            hole = slot;
+        }
+        slot = _next(slot);
+        if (slot == (unsigned)pos) {
             break;
         }
     }
+    list[hole].addr_len = 0;
 
-    return res;
+    return 0;
 }
 
 bool l2filter_pass(const l2filter_t *list, const void *addr, size_t addr_len)
 {
     assert(list && addr && (addr_len <= L2FILTER_ADDR_MAXLEN));
 
+    bool found = (_find(list, addr, addr_len) >= 0);
+
 #ifdef MODULE_L2FILTER_WHITELIST
-    bool res = false;
-    for (unsigned i = 0; i < L2FILTER_LISTSIZE; i++) {
-        if (match(&list[i], addr, addr_len)) {
-            DEBUG("[l2filter] whitelist: address match -> packet passes\n");
-            res = true;
-            break;
-        }
-    }
-    DEBUG("[l2filter] whitelist: no match -> packet dropped\n");
+    DEBUG("[l2filter] whitelist: %s\n", found ? "address match -> packet passes"
+                                              : "no match -> packet dropped");
+    return found;
 #else
-    bool res = true;
-    for (unsigned i = 0; i < L2FILTER_LISTSIZE; i++) {
-        if (match(&list[i], addr, addr_len)) {
-            DEBUG("[l2filter] blacklist: address match -> packet dropped\n");
-            res = false;
-            break;
-        }
-    }
-    DEBUG("[l2fitler] blacklist: no match -> packet passes\n");
+    DEBUG("[l2filter] blacklist: %s\n", found ? "address match -> packet dropped"
+                                              : "no match -> packet passes");
+    return !found;
 #endif
-
-    return res;
 }
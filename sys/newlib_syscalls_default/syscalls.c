@@ -50,7 +50,9 @@
 
 #include <sys/times.h>
 
-#ifdef MODULE_XTIMER
+#ifdef MODULE_WALLTIME
+#include "walltime.h"
+#elif defined(MODULE_XTIMER)
 #include <sys/time.h>
 #include "div.h"
 #include "xtimer.h"
@@ -616,7 +618,15 @@ int _kill(pid_t pid, int sig)
     return -1;
 }
 
-#ifdef MODULE_XTIMER
+#ifdef MODULE_WALLTIME
+int _gettimeofday_r(struct _reent *r, struct timeval *restrict tp, void *restrict tzp)
+{
+    (void) r;
+    (void) tzp;
+    walltime_gettimeofday(tp);
+    return 0;
+}
+#elif defined(MODULE_XTIMER)
 int _gettimeofday_r(struct _reent *r, struct timeval *restrict tp, void *restrict tzp)
 {
     (void) r;
@@ -29,6 +29,10 @@
 #include "pipe.h"
 #include "sched.h"
 
+#ifdef MODULE_POSIX_POLL
+#include "vfs.h"
+#endif
+
 typedef unsigned (*ringbuffer_op_t)(ringbuffer_t *restrict rb, char *buf, unsigned n);
 
 static ssize_t pipe_rw(ringbuffer_t *rb,
@@ -58,6 +62,11 @@ static ssize_t pipe_rw(ringbuffer_t *rb,
 
             irq_restore(old_state);
 
+#ifdef MODULE_POSIX_POLL
+            /* the pipe became readable or writable for the other side */
+            vfs_poll_notify();
+#endif
+
             if (other_prio >= 0) {
                 sched_switch(other_prio);
             }
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_pipe
+ * @{
+ * @file
+ * @brief       VFS file descriptors for pipes.
+ * @author      ML!PA Consulting GmbH
+ * @}
+ */
+
+#include "pipe.h"
+#include "vfs.h"
+
+#ifdef MODULE_POSIX_POLL
+#include "poll.h"
+#endif
+
+static ssize_t _pipe_vfs_read(vfs_file_t *filp, void *dest, size_t nbytes)
+{
+    return pipe_read(filp->private_data.ptr, dest, nbytes);
+}
+
+static ssize_t _pipe_vfs_write(vfs_file_t *filp, const void *src, size_t nbytes)
+{
+    return pipe_write(filp->private_data.ptr, src, nbytes);
+}
+
+#ifdef MODULE_POSIX_POLL
+static int _pipe_vfs_poll(vfs_file_t *filp)
+{
+    pipe_t *pipe = filp->private_data.ptr;
+    int res = 0;
+
+    if (!ringbuffer_empty(pipe->rb)) {
+        res |= POLLIN;
+    }
+    if (!ringbuffer_full(pipe->rb)) {
+        res |= POLLOUT;
+    }
+    return res;
+}
+#endif
+
+static const vfs_file_ops_t _pipe_vfs_ops = {
+    .read = _pipe_vfs_read,
+    .write = _pipe_vfs_write,
+#ifdef MODULE_POSIX_POLL
+    .poll = _pipe_vfs_poll,
+#endif
+};
+
+int pipe_vfs_bind(pipe_t *pipe, int flags)
+{
+    return vfs_bind(VFS_ANY_FD, flags, &_pipe_vfs_ops, pipe);
+}
@@ -18,9 +18,17 @@
  * @}
  */
 
+#include <string.h>
+
 #include "irq.h"
 #include "periph/pm.h"
 #include "pm_layered.h"
+#if IS_USED(MODULE_PM_LAYERED_TICKLESS) || IS_USED(MODULE_PM_LAYERED_STATS)
+#include "ztimer.h"
+#endif
+#if IS_USED(MODULE_ENERGY)
+#include "energy.h"
+#endif
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -38,6 +46,70 @@
  */
 static volatile pm_blocker_t pm_blocker = { .val_u32 = PM_BLOCKER_INITIAL };
 
+#if IS_USED(MODULE_PM_LAYERED_STATS)
+static pm_layered_stats_t _stats;
+#endif
+
+#if IS_USED(MODULE_PM_LAYERED_TICKLESS)
+static const uint32_t _latency_us[PM_NUM_MODES] = PM_WAKEUP_LATENCY_US;
+
+/* time in microseconds until the next ztimer triggers */
+static uint32_t _until_next_us(void)
+{
+    uint32_t res = UINT32_MAX;
+
+#if MODULE_ZTIMER_USEC
+    res = ztimer_until_next(ZTIMER_USEC);
+#endif
+#if MODULE_ZTIMER_MSEC
+    uint32_t msec = ztimer_until_next(ZTIMER_MSEC);
+
+    if (msec < (UINT32_MAX / 1000)) {
+        msec *= 1000;
+    }
+    else {
+        msec = UINT32_MAX;
+    }
+    if (msec < res) {
+        res = msec;
+    }
+#endif
+    return res;
+}
+
+/* lightest mode at least as light as mode that wakes up in time */
+static unsigned _mode_for_deadline(unsigned mode)
+{
+    uint32_t until_next = _until_next_us();
+
+    while ((mode < PM_NUM_MODES) && (_latency_us[mode] >= until_next)) {
+        mode++;
+    }
+    return mode;
+}
+#endif
+
+static void _set(unsigned mode)
+{
+#if IS_USED(MODULE_PM_LAYERED_STATS)
+    uint32_t before = ztimer_now(ZTIMER_MSEC);
+#endif
+#if IS_USED(MODULE_ENERGY)
+    energy_set_state(&energy_cpu, mode);
+#endif
+
+    pm_set(mode);
+
+#if IS_USED(MODULE_ENERGY)
+    /* running until the next call, interrupts are still disabled */
+    energy_set_state(&energy_cpu, PM_NUM_MODES + 1);
+#endif
+#if IS_USED(MODULE_PM_LAYERED_STATS)
+    _stats.count[mode]++;
+    _stats.time_ms[mode] += ztimer_now(ZTIMER_MSEC) - before;
+#endif
+}
+
 void pm_set_lowest(void)
 {
     pm_blocker_t blocker = pm_blocker;
@@ -52,8 +124,12 @@ void pm_set_lowest(void)
     /* set lowest mode if blocker is still the same */
     unsigned state = irq_disable();
     if (blocker.val_u32 == pm_blocker.val_u32) {
+#if IS_USED(MODULE_PM_LAYERED_TICKLESS)
+        /* with interrupts disabled, no timer can be set before sleeping */
+        mode = _mode_for_deadline(mode);
+#endif
         DEBUG("pm: setting mode %u\n", mode);
-        pm_set(mode);
+        _set(mode);
     }
     else {
         DEBUG("pm: mode block changed\n");
@@ -84,6 +160,22 @@ pm_blocker_t pm_get_blocker(void)
     return pm_blocker;
 }
 
+#if IS_USED(MODULE_PM_LAYERED_STATS)
+void pm_layered_get_stats(pm_layered_stats_t *stats)
+{
+    unsigned state = irq_disable();
+    *stats = _stats;
+    irq_restore(state);
+}
+
+void pm_layered_reset_stats(void)
+{
+    unsigned state = irq_disable();
+    memset(&_stats, 0, sizeof(_stats));
+    irq_restore(state);
+}
+#endif
+
 #ifndef PROVIDES_PM_LAYERED_OFF
 void pm_off(void)
 {
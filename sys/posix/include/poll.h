@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    posix_poll POSIX poll
+ * @ingroup     posix
+ * @brief       Readiness multiplexing over VFS file descriptors
+ *
+ * poll() and select() wait for any of several file descriptors to become
+ * ready, so a single thread can serve many sockets, stdin and pipes. They
+ * work on all files whose driver implements vfs_file_ops::poll:
+ *
+ * - sockets of `posix_sockets`, based on `sock_async` events
+ * - stdin with `stdio_uart`, stdout and stderr
+ * - pipes bound to a file descriptor with pipe_vfs_bind()
+ *
+ * Files whose driver does not implement vfs_file_ops::poll, e.g. regular
+ * files, are always ready for reading and writing. Closed file descriptors
+ * are reported with `POLLNVAL`.
+ *
+ * @see [The Open Group Base Specification Issue 7, poll.h]
+ *      (https://pubs.opengroup.org/onlinepubs/9699919799/basedefs/poll.h.html)
+ * @{
+ *
+ * @file
+ * @brief   POSIX compatible poll.h definitions
+ *
+ * @author  ML!PA Consulting GmbH
+ */
+
+/* If building on native we need to use the system libraries instead */
+#ifdef CPU_NATIVE
+#pragma GCC system_header
+/* without the GCC pragma above #include_next will trigger a pedantic error */
+#include_next <poll.h>
+#else
+#ifndef POLL_H
+#define POLL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name    Events and revents of struct pollfd
+ * @{
+ */
+#define POLLIN      (0x0001)    /**< Data other than high-priority data may
+                                     be read without blocking */
+#define POLLPRI     (0x0002)    /**< High-priority data may be read without
+                                     blocking, never set */
+#define POLLOUT     (0x0004)    /**< Normal data may be written without
+                                     blocking */
+#define POLLERR     (0x0008)    /**< An error occurred, only in revents */
+#define POLLHUP     (0x0010)    /**< Device has been disconnected, only in
+                                     revents */
+#define POLLNVAL    (0x0020)    /**< Invalid fd member, only in revents */
+#define POLLRDNORM  POLLIN      /**< Same as POLLIN */
+#define POLLWRNORM  POLLOUT     /**< Same as POLLOUT */
+/** @} */
+
+/**
+ * @brief   Type for the number of file descriptors
+ */
+typedef unsigned int nfds_t;
+
+/**
+ * @brief   File descriptor to wait for
+ */
+struct pollfd {
+    int fd;             /**< The file descriptor, ignored if negative */
+    short events;       /**< The events of interest */
+    short revents;      /**< The events that occurred */
+};
+
+/**
+ * @brief   Wait for any of the file descriptors @p fds to become ready
+ *
+ * @param[in,out] fds   file descriptors and their events of interest,
+ *                      the occurred events are written to
+ *                      pollfd::revents
+ * @param[in] nfds      number of elements of @p fds
+ * @param[in] timeout   timeout in milliseconds, -1 to wait forever, 0 to
+ *                      return immediately
+ *
+ * @return  number of elements of @p fds with non-zero pollfd::revents,
+ *          0 on timeout
+ * @return  -1 on error, with errno set
+ */
+int poll(struct pollfd fds[], nfds_t nfds, int timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* POLL_H */
+#endif /* CPU_NATIVE */
+/** @} */
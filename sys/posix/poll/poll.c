@@ -0,0 +1,225 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     posix_poll
+ * @{
+ *
+ * @file
+ * @brief       poll() and select() on top of vfs_poll()
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <limits.h>
+#include <poll.h>
+#include <sys/select.h>
+
+#include "irq.h"
+#include "sched.h"
+#include "thread.h"
+#include "thread_flags.h"
+#include "vfs.h"
+#include "xtimer.h"
+
+/**
+ * @brief   Thread flag set by posix_poll_notify()
+ */
+#ifndef CONFIG_POSIX_POLL_THREAD_FLAG
+#define CONFIG_POSIX_POLL_THREAD_FLAG   (1u << 12)
+#endif
+
+typedef struct _waiter {
+    struct _waiter *next;
+    thread_t *thread;
+} _waiter_t;
+
+/* threads blocked in poll(), their entries live on their stacks */
+static _waiter_t *_waiters;
+
+void posix_poll_notify(void)
+{
+    unsigned state = irq_disable();
+
+    for (_waiter_t *w = _waiters; w; w = w->next) {
+        thread_flags_set(w->thread, CONFIG_POSIX_POLL_THREAD_FLAG);
+    }
+    irq_restore(state);
+}
+
+static void _add(_waiter_t *waiter)
+{
+    unsigned state = irq_disable();
+
+    waiter->next = _waiters;
+    _waiters = waiter;
+    irq_restore(state);
+}
+
+static void _remove(_waiter_t *waiter)
+{
+    unsigned state = irq_disable();
+
+    for (_waiter_t **prev = &_waiters; *prev; prev = &(*prev)->next) {
+        if (*prev == waiter) {
+            *prev = waiter->next;
+            break;
+        }
+    }
+    irq_restore(state);
+}
+
+static int _check(struct pollfd fds[], nfds_t nfds)
+{
+    int ready = 0;
+
+    for (nfds_t i = 0; i < nfds; i++) {
+        if (fds[i].fd < 0) {
+            fds[i].revents = 0;
+            continue;
+        }
+
+        int res = vfs_poll(fds[i].fd);
+
+        if (res == -ENOTSUP) {
+            /* like regular files, files that cannot tell never block */
+            fds[i].revents = fds[i].events & (POLLIN | POLLOUT);
+        }
+        else if (res < 0) {
+            fds[i].revents = POLLNVAL;
+        }
+        else {
+            fds[i].revents = res & (fds[i].events | POLLERR | POLLHUP);
+        }
+        if (fds[i].revents) {
+            ready++;
+        }
+    }
+    return ready;
+}
+
+int poll(struct pollfd fds[], nfds_t nfds, int timeout)
+{
+    _waiter_t waiter = { .thread = (thread_t *)sched_active_thread };
+    xtimer_t timer = { 0 };
+    int ready;
+
+    if ((fds == NULL) && (nfds > 0)) {
+        errno = EFAULT;
+        return -1;
+    }
+
+    /* register before checking, so no notification gets lost in between */
+    _add(&waiter);
+    thread_flags_clear(THREAD_FLAG_TIMEOUT);
+    if (timeout > 0) {
+        xtimer_set_timeout_flag64(&timer, (uint64_t)timeout * US_PER_MS);
+    }
+    while (1) {
+        thread_flags_clear(CONFIG_POSIX_POLL_THREAD_FLAG);
+        ready = _check(fds, nfds);
+        if (ready || (timeout == 0)) {
+            break;
+        }
+
+        thread_flags_t flags = thread_flags_wait_any(
+            CONFIG_POSIX_POLL_THREAD_FLAG | THREAD_FLAG_TIMEOUT);
+
+        if (flags & THREAD_FLAG_TIMEOUT) {
+            ready = _check(fds, nfds);
+            break;
+        }
+    }
+    xtimer_remove(&timer);
+    _remove(&waiter);
+    thread_flags_clear(CONFIG_POSIX_POLL_THREAD_FLAG | THREAD_FLAG_TIMEOUT);
+    return ready;
+}
+
+int select(int nfds, fd_set *readfds, fd_set *writefds, fd_set *errorfds,
+           struct timeval *timeout)
+{
+    struct pollfd fds[VFS_MAX_OPEN_FILES];
+    nfds_t num = 0;
+    int ms = -1;
+
+    if ((nfds < 0) || (nfds > FD_SETSIZE)) {
+        errno = EINVAL;
+        return -1;
+    }
+    for (int fd = 0; fd < nfds; fd++) {
+        short events = 0;
+
+        if (readfds && FD_ISSET(fd, readfds)) {
+            events |= POLLIN;
+        }
+        if (writefds && FD_ISSET(fd, writefds)) {
+            events |= POLLOUT;
+        }
+        if (!events && !(errorfds && FD_ISSET(fd, errorfds))) {
+            continue;
+        }
+        if (fd >= VFS_MAX_OPEN_FILES) {
+            errno = EBADF;
+            return -1;
+        }
+        fds[num++] = (struct pollfd){ .fd = fd, .events = events };
+    }
+    if (timeout) {
+        if ((timeout->tv_sec < 0) || (timeout->tv_usec < 0)) {
+            errno = EINVAL;
+            return -1;
+        }
+        uint64_t total = (uint64_t)timeout->tv_sec * MS_PER_SEC +
+                         (timeout->tv_usec + US_PER_MS - 1) / US_PER_MS;
+        ms = (total > INT_MAX) ? INT_MAX : (int)total;
+    }
+
+    if (poll(fds, num, ms) < 0) {
+        return -1;
+    }
+
+    int ready = 0;
+
+    for (nfds_t i = 0; i < num; i++) {
+        int fd = fds[i].fd;
+
+        if (fds[i].revents & POLLNVAL) {
+            errno = EBADF;
+            return -1;
+        }
+        if (readfds && FD_ISSET(fd, readfds)) {
+            if (fds[i].revents & (POLLIN | POLLHUP)) {
+                ready++;
+            }
+            else {
+                FD_CLR(fd, readfds);
+            }
+        }
+        if (writefds && FD_ISSET(fd, writefds)) {
+            if (fds[i].revents & POLLOUT) {
+                ready++;
+            }
+            else {
+                FD_CLR(fd, writefds);
+            }
+        }
+        if (errorfds && FD_ISSET(fd, errorfds)) {
+            if (fds[i].revents & POLLERR) {
+                ready++;
+            }
+            else {
+                FD_CLR(fd, errorfds);
+            }
+        }
+    }
+    return ready;
+}
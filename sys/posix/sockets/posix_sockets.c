@@ -37,6 +37,11 @@
 #include "net/sock/udp.h"
 #include "net/sock/tcp.h"
 
+#ifdef MODULE_POSIX_POLL
+#include "net/sock/async.h"
+#include "poll.h"
+#endif
+
 /* enough to create sockets both with socket() and accept() */
 #define _ACTUAL_SOCKET_POOL_SIZE   (SOCKET_POOL_SIZE + \
                                     (SOCKET_POOL_SIZE * SOCKET_TCP_QUEUE_SIZE))
@@ -80,6 +85,17 @@ typedef struct {
     unsigned queue_array_len;
 #endif
     sock_tcp_ep_t local;        /* to store bind before connect/listen */
+#ifdef MODULE_POSIX_POLL
+    /* poll() can only test for readability by receiving, so it keeps the
+     * datagram, the first byte of a stream or the accepted connection for
+     * the next call to recvfrom()/accept() */
+    bool ahead;
+    uint8_t ahead_byte;
+    size_t ahead_len;
+    void *ahead_data;
+    void *ahead_ctx;
+    struct _sock_tl_ep ahead_ep;
+#endif
 } socket_t;
 
 static socket_t _socket_pool[_ACTUAL_SOCKET_POOL_SIZE];
@@ -250,6 +266,205 @@ static int _sockaddr_to_ep(const struct sockaddr *address, socklen_t address_len
     return 0;
 }
 
+#ifdef MODULE_POSIX_POLL
+#ifdef MODULE_SOCK_IP
+static void _ip_cb(sock_ip_t *sock, sock_async_flags_t flags, void *arg)
+{
+    (void)sock;
+    (void)flags;
+    (void)arg;
+    vfs_poll_notify();
+}
+#endif
+
+#ifdef MODULE_SOCK_TCP
+static void _tcp_cb(sock_tcp_t *sock, sock_async_flags_t flags, void *arg)
+{
+    (void)sock;
+    (void)flags;
+    (void)arg;
+    vfs_poll_notify();
+}
+
+static void _tcp_queue_cb(sock_tcp_queue_t *queue, sock_async_flags_t flags,
+                          void *arg)
+{
+    (void)queue;
+    (void)flags;
+    (void)arg;
+    vfs_poll_notify();
+}
+#endif
+
+#ifdef MODULE_SOCK_UDP
+static void _udp_cb(sock_udp_t *sock, sock_async_flags_t flags, void *arg)
+{
+    (void)sock;
+    (void)flags;
+    (void)arg;
+    vfs_poll_notify();
+}
+#endif
+
+/* wake up poll() on any event of the sock of s */
+static void _set_cb(socket_t *s)
+{
+    switch (s->type) {
+#ifdef MODULE_SOCK_IP
+        case SOCK_RAW:
+            sock_ip_set_cb(&s->sock->raw, _ip_cb, NULL);
+            break;
+#endif
+#ifdef MODULE_SOCK_TCP
+        case SOCK_STREAM:
+            if (s->queue_array == NULL) {
+                sock_tcp_set_cb(&s->sock->tcp.sock, _tcp_cb, NULL);
+            }
+            else {
+                sock_tcp_queue_set_cb(&s->sock->tcp.queue, _tcp_queue_cb,
+                                      NULL);
+            }
+            break;
+#endif
+#ifdef MODULE_SOCK_UDP
+        case SOCK_DGRAM:
+            sock_udp_set_cb(&s->sock->udp, _udp_cb, NULL);
+            break;
+#endif
+        default:
+            break;
+    }
+}
+
+/* release what poll() received ahead */
+static void _drop_ahead(socket_t *s)
+{
+    if (!s->ahead) {
+        return;
+    }
+    s->ahead = false;
+    switch (s->type) {
+#ifdef MODULE_SOCK_IP
+        case SOCK_RAW:
+            sock_ip_recv_buf(&s->sock->raw, &s->ahead_data, &s->ahead_ctx, 0,
+                             NULL);
+            break;
+#endif
+#ifdef MODULE_SOCK_TCP
+        case SOCK_STREAM:
+            if (s->queue_array != NULL) {
+                sock_tcp_disconnect(s->ahead_data);
+            }
+            break;
+#endif
+#ifdef MODULE_SOCK_UDP
+        case SOCK_DGRAM:
+            sock_udp_recv_buf(&s->sock->udp, &s->ahead_data, &s->ahead_ctx, 0,
+                              NULL);
+            break;
+#endif
+        default:
+            break;
+    }
+}
+
+/* returns the length received ahead or a negative errno, copies at most
+ * length bytes of it to buffer */
+static ssize_t _recv_ahead(socket_t *s, void *buffer, size_t length,
+                           struct _sock_tl_ep *ep)
+{
+    ssize_t res = s->ahead_len;
+
+    if (s->type == SOCK_STREAM) {
+        if (length == 0) {
+            return 0;
+        }
+        s->ahead = false;
+        *(uint8_t *)buffer = s->ahead_byte;
+#ifdef MODULE_SOCK_TCP
+        /* the rest is optional, the byte alone already is a valid read */
+        if (length > 1) {
+            ssize_t rest = sock_tcp_read(&s->sock->tcp.sock,
+                                         (uint8_t *)buffer + 1, length - 1, 0);
+
+            if (rest > 0) {
+                res += rest;
+            }
+        }
+#endif
+        return res;
+    }
+    if ((size_t)res > length) {
+        /* datagrams are dropped if the buffer is too small, like with
+         * sock_udp_recv() */
+        res = -ENOBUFS;
+    }
+    else {
+        memcpy(buffer, s->ahead_data, res);
+        *ep = s->ahead_ep;
+    }
+    _drop_ahead(s);
+    return res;
+}
+
+/* tries to receive ahead without blocking, returns the poll events */
+static int _poll_ahead(socket_t *s)
+{
+    ssize_t res = -EOPNOTSUPP;
+
+    s->ahead_ctx = NULL;
+    switch (s->type) {
+#ifdef MODULE_SOCK_IP
+        case SOCK_RAW:
+            res = sock_ip_recv_buf(&s->sock->raw, &s->ahead_data,
+                                   &s->ahead_ctx, 0,
+                                   (sock_ip_ep_t *)&s->ahead_ep);
+            break;
+#endif
+#ifdef MODULE_SOCK_TCP
+        case SOCK_STREAM:
+            if (s->queue_array != NULL) {
+                sock_tcp_t *sock = NULL;
+
+                res = sock_tcp_accept(&s->sock->tcp.queue, &sock, 0);
+                if (res == 0) {
+                    s->ahead_data = sock;
+                    s->ahead = true;
+                    return POLLIN;
+                }
+                break;
+            }
+            res = sock_tcp_read(&s->sock->tcp.sock, &s->ahead_byte, 1, 0);
+            if (res == 0) {
+                /* connection was closed by the peer, reads return 0 */
+                return POLLIN | POLLHUP;
+            }
+            if ((res < 0) && (res != -EAGAIN) && (res != -ETIMEDOUT)) {
+                return POLLERR | POLLHUP;
+            }
+            break;
+#endif
+#ifdef MODULE_SOCK_UDP
+        case SOCK_DGRAM:
+            res = sock_udp_recv_buf(&s->sock->udp, &s->ahead_data,
+                                    &s->ahead_ctx, 0, &s->ahead_ep);
+            break;
+#endif
+        default:
+            break;
+    }
+    if ((res >= 0) && ((s->type == SOCK_STREAM) || (s->ahead_ctx != NULL))) {
+        s->ahead_len = res;
+        s->ahead = true;
+        return POLLIN;
+    }
+    if ((res < 0) && (res != -EAGAIN) && (res != -ETIMEDOUT)) {
+        return POLLERR;
+    }
+    return 0;
+}
+#endif /* MODULE_POSIX_POLL */
+
 static int socket_close(vfs_file_t *filp)
 {
     socket_t *s = filp->private_data.ptr;
@@ -259,6 +474,9 @@ static int socket_close(vfs_file_t *filp)
     mutex_lock(&_socket_pool_mutex);
     if (s->sock != NULL) {
         int idx = _get_sock_idx(s->sock);
+#ifdef MODULE_POSIX_POLL
+        _drop_ahead(s);
+#endif
         switch (s->type) {
 #ifdef MODULE_SOCK_UDP
             case SOCK_DGRAM:
@@ -322,6 +540,19 @@ static inline ssize_t socket_write(vfs_file_t *filp, const void *buf, size_t n)
     return socket_sendto(filp->private_data.ptr, buf, n, 0, NULL, 0);
 }
 
+#ifdef MODULE_POSIX_POLL
+static int socket_poll(vfs_file_t *filp)
+{
+    socket_t *s = filp->private_data.ptr;
+
+    /* sending never blocks longer than the stack needs to take the data */
+    if ((s->sock == NULL) || s->ahead) {
+        return (s->ahead) ? (POLLIN | POLLOUT) : POLLOUT;
+    }
+    return _poll_ahead(s) | POLLOUT;
+}
+#endif
+
 static const vfs_file_ops_t socket_ops = {
     .close = socket_close,
     .fcntl = NULL,          /* TODO: provide when needed */
@@ -329,6 +560,9 @@ static const vfs_file_ops_t socket_ops = {
     .lseek = socket_lseek,
     .read = socket_read,
     .write = socket_write,
+#ifdef MODULE_POSIX_POLL
+    .poll = socket_poll,
+#endif
 };
 
 int socket(int domain, int type, int protocol)
@@ -367,6 +601,9 @@ int socket(int domain, int type, int protocol)
             }
             s->bound = false;
             s->sock = NULL;
+#ifdef MODULE_POSIX_POLL
+            s->ahead = false;
+#endif
 #ifdef POSIX_SETSOCKOPT
             s->recv_timeout = SOCK_NO_TIMEOUT;
 #endif
@@ -426,6 +663,14 @@ int accept(int socket, struct sockaddr *restrict address,
                 break;
             }
             sock = (sock_tcp_t *)new_s->sock;
+#ifdef MODULE_POSIX_POLL
+            if (s->ahead) {
+                /* connection was already accepted by poll() */
+                sock = s->ahead_data;
+                s->ahead = false;
+            }
+            else
+#endif
             if ((res = sock_tcp_accept(&s->sock->tcp.queue, &sock,
                                        recv_timeout)) < 0) {
                 errno = -res;
@@ -466,6 +711,10 @@ int accept(int socket, struct sockaddr *restrict address,
                 new_s->queue_array_len = 0;
                 new_s->sock = (socket_sock_t *)sock;
                 memset(&s->local, 0, sizeof(sock_tcp_ep_t));
+#ifdef MODULE_POSIX_POLL
+                new_s->ahead = false;
+                _set_cb(new_s);
+#endif
             }
             break;
         default:
@@ -598,6 +847,9 @@ static int _bind_connect(socket_t *s, const struct sockaddr *address,
         return -1;
     }
     s->sock = sock;
+#ifdef MODULE_POSIX_POLL
+    _set_cb(s);
+#endif
     return 0;
 }
 
@@ -797,6 +1049,9 @@ int listen(int socket, int backlog)
     }
     if (res == 0) {
         s->sock = sock;
+#ifdef MODULE_POSIX_POLL
+        _set_cb(s);
+#endif
     }
     else {
         errno = -res;
@@ -844,6 +1099,13 @@ static ssize_t socket_recvfrom(socket_t *s, void *restrict buffer,
     const uint32_t recv_timeout = SOCK_NO_TIMEOUT;
 #endif
 
+#ifdef MODULE_POSIX_POLL
+    if (s->ahead) {
+        (void)recv_timeout;
+        res = _recv_ahead(s, buffer, length, &ep);
+    }
+    else
+#endif
     switch (s->type) {
 #ifdef MODULE_SOCK_IP
         case SOCK_RAW:
@@ -15,6 +15,7 @@
  * @}
  */
 
+#include <inttypes.h>
 #include <stdio.h>
 
 #include "thread.h"
@@ -26,6 +27,10 @@
 #include "schedstatistics.h"
 #endif
 
+#ifdef MODULE_SCHED_EDF
+#include "sched_edf.h"
+#endif
+
 #ifdef MODULE_TLSF_MALLOC
 #include "tlsf.h"
 #include "tlsf-malloc.h"
@@ -68,6 +73,12 @@ void ps(void)
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
            "| runtime  | switches"
+#endif
+#ifdef MODULE_SCHED_STACK_HWM
+           " | hwm  "
+#endif
+#ifdef MODULE_SCHED_EDF
+           " | edf jobs   miss   ovr"
 #endif
            "\n",
 #ifdef DEVELHELP
@@ -131,8 +142,10 @@ void ps(void)
 #ifdef MODULE_SCHEDSTATISTICS
                    " | %2d.%03d%% |  %8u"
 #endif
-                   "\n",
-                   p->pid,
+#ifdef MODULE_SCHED_STACK_HWM
+                   " | %5u"
+#endif
+                   , p->pid,
 #ifdef DEVELHELP
                    p->name,
 #endif
@@ -143,8 +156,19 @@ void ps(void)
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
                    , runtime_major, runtime_minor, switches
+#endif
+#ifdef MODULE_SCHED_STACK_HWM
+                   , (unsigned)thread_measure_stack_hwm(p)
 #endif
                   );
+#ifdef MODULE_SCHED_EDF
+            const sched_edf_t *edf = sched_edf_get(p->pid);
+            if (edf) {
+                printf(" | %8" PRIu32 " %6" PRIu32 " %5" PRIu32,
+                       edf->jobs, edf->deadline_misses, edf->budget_overruns);
+            }
+#endif
+            puts("");
         }
     }
 
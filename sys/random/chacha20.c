@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_random
+ * @{
+ * @file
+ *
+ * @brief       ChaCha20 based CSPRNG with fast key erasure
+ *
+ * Every refill generates a few key stream blocks. The first 32 bytes become
+ * the key for the next refill and are never handed out, the rest is output
+ * and erased as it is consumed.
+ *
+ * @author      ML!PA Consulting GmbH
+ * @}
+ */
+
+#include <string.h>
+
+#include "crypto/chacha.h"
+#include "kernel_defines.h"
+#include "mutex.h"
+#include "random.h"
+
+#define KEY_WORDS       (8U)
+#define BUF_BLOCKS      (2U)
+
+static const uint8_t _nonce[8];
+
+static chacha_ctx _ctx;
+static uint32_t _buf[BUF_BLOCKS * 16];
+static unsigned _pos = ARRAY_SIZE(_buf);
+static unsigned _blocks;
+static mutex_t _lock = MUTEX_INIT;
+
+/* mix fresh entropy into the next key, without blocking on the source */
+static void _mix_pool(uint32_t *key)
+{
+#ifdef MODULE_RANDOM_POOL
+    uint32_t entropy[KEY_WORDS] = { 0 };
+
+    random_pool_read(entropy, sizeof(entropy));
+    for (unsigned i = 0; i < KEY_WORDS; i++) {
+        key[i] ^= entropy[i];
+    }
+    memset(entropy, 0, sizeof(entropy));
+#else
+    (void)key;
+#endif
+}
+
+static void _rekey(uint32_t *key)
+{
+    chacha_init(&_ctx, 20, (const uint8_t *)key, KEY_WORDS * sizeof(uint32_t),
+                _nonce);
+    memset(key, 0, KEY_WORDS * sizeof(uint32_t));
+}
+
+static void _refill(void)
+{
+    for (unsigned i = 0; i < BUF_BLOCKS; i++) {
+        chacha_keystream_bytes(&_ctx, &_buf[16 * i]);
+    }
+
+    _blocks += BUF_BLOCKS;
+    if (_blocks >= CONFIG_PRNG_CHACHA20_RESEED_BLOCKS) {
+        _blocks = 0;
+        _mix_pool(_buf);
+    }
+
+    _rekey(_buf);
+    _pos = KEY_WORDS;
+}
+
+void random_init_by_array(uint32_t init_key[], int key_length)
+{
+    uint32_t key[KEY_WORDS] = { 0 };
+
+    for (int i = 0; i < key_length; i++) {
+        key[i % KEY_WORDS] ^= init_key[i];
+    }
+
+    mutex_lock(&_lock);
+    _mix_pool(key);
+    _rekey(key);
+    memset(_buf, 0, sizeof(_buf));
+    _pos = ARRAY_SIZE(_buf);
+    _blocks = 0;
+    mutex_unlock(&_lock);
+}
+
+void random_init(uint32_t s)
+{
+    random_init_by_array(&s, 1);
+}
+
+uint32_t random_uint32(void)
+{
+    mutex_lock(&_lock);
+
+    if (_pos == ARRAY_SIZE(_buf)) {
+        _refill();
+    }
+    uint32_t res = _buf[_pos];
+    _buf[_pos++] = 0;
+
+    mutex_unlock(&_lock);
+    return res;
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_random
+ * @{
+ * @file
+ *
+ * @brief       Entropy pool fed from the hardware RNG
+ *
+ * The pool is consumed from the end, so the bytes that are handed out are
+ * always the most recently added ones and no index wraps around.
+ *
+ * @author      ML!PA Consulting GmbH
+ * @}
+ */
+
+#include <string.h>
+
+#include "mutex.h"
+#include "random.h"
+
+#ifdef MODULE_PERIPH_HWRNG
+#include "event/thread.h"
+#include "periph/hwrng.h"
+#endif
+#ifdef MODULE_PUF_SRAM
+#include "puf_sram.h"
+#endif
+
+#define POOL_SIZE   CONFIG_RANDOM_POOL_SIZE
+
+static uint8_t _pool[POOL_SIZE];
+static size_t _fill;
+static mutex_t _lock = MUTEX_INIT;
+
+#ifdef MODULE_PERIPH_HWRNG
+static void _refill_handler(event_t *event)
+{
+    (void)event;
+    uint8_t batch[POOL_SIZE];
+
+    mutex_lock(&_lock);
+    size_t len = POOL_SIZE - _fill;
+    mutex_unlock(&_lock);
+
+    /* the slow part runs without the lock, readers are served meanwhile */
+    hwrng_read(batch, len);
+
+    mutex_lock(&_lock);
+    if (len > POOL_SIZE - _fill) {
+        len = POOL_SIZE - _fill;
+    }
+    memcpy(&_pool[_fill], batch, len);
+    _fill += len;
+    mutex_unlock(&_lock);
+
+    memset(batch, 0, sizeof(batch));
+}
+
+static event_t _refill = { .handler = _refill_handler };
+
+static void _schedule_refill(void)
+{
+    /* events posted before the event thread claimed its queue would be
+     * dropped by the queue initialization, try again on the next read */
+    if (EVENT_PRIO_LOWEST->waiter) {
+        event_post(EVENT_PRIO_LOWEST, &_refill);
+    }
+}
+#endif
+
+void random_pool_init(void)
+{
+    mutex_lock(&_lock);
+#ifdef MODULE_PERIPH_HWRNG
+    hwrng_read(_pool, POOL_SIZE);
+    _fill = POOL_SIZE;
+#elif defined(MODULE_PUF_SRAM)
+    _fill = (sizeof(puf_sram_seed) < POOL_SIZE) ? sizeof(puf_sram_seed)
+                                                : POOL_SIZE;
+    memcpy(_pool, &puf_sram_seed, _fill);
+#endif
+    mutex_unlock(&_lock);
+}
+
+size_t random_pool_read(void *buf, size_t len)
+{
+    mutex_lock(&_lock);
+
+    if (len > _fill) {
+        len = _fill;
+    }
+    _fill -= len;
+    memcpy(buf, &_pool[_fill], len);
+    /* entropy is handed out only once */
+    memset(&_pool[_fill], 0, len);
+
+#ifdef MODULE_PERIPH_HWRNG
+    if (_fill < POOL_SIZE / 2) {
+        _schedule_refill();
+    }
+#endif
+
+    mutex_unlock(&_lock);
+    return len;
+}
@@ -42,6 +42,9 @@
 void auto_init_random(void)
 {
     uint32_t seed;
+#ifdef MODULE_RANDOM_POOL
+    random_pool_init();
+#endif
 #ifdef MODULE_PUF_SRAM
     /* TODO: hand state to application? */
     if (puf_sram_state) {
@@ -0,0 +1,254 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_riotboot_flashwrite
+ * @{
+ *
+ * @file
+ * @brief       Streaming delta patch engine for firmware updates
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "riotboot/flashwrite.h"
+
+#define LOG_PREFIX "riotboot_flashwrite_delta: "
+#include "log.h"
+
+enum {
+    _MAGIC,         /**< reading the magic number */
+    _DIFF_LEN,      /**< reading the length of the diff section */
+    _EXTRA_LEN,     /**< reading the length of the extra section */
+    _ADJUST,        /**< reading the source adjustment */
+    _ZEROS,         /**< reading the length of an unchanged run */
+    _LITERALS,      /**< reading the length of a changed run */
+    _DIFF,          /**< reading difference bytes */
+    _EXTRA,         /**< reading literal bytes */
+};
+
+static size_t _slot_len(int slot)
+{
+    switch (slot) {
+        case 0: return SLOT0_LEN;
+#if NUM_SLOTS==2
+        case 1: return SLOT1_LEN;
+#endif
+        default: return 0;
+    }
+}
+
+static int _flush(riotboot_flashwrite_delta_t *delta, bool more)
+{
+    int res = riotboot_flashwrite_putbytes(delta->writer, delta->out,
+                                           delta->out_len, more);
+    delta->out_len = 0;
+    return res;
+}
+
+static int _emit(riotboot_flashwrite_delta_t *delta, uint8_t byte)
+{
+    /* the writer skips the start of the image, e.g. the riotboot magic */
+    if (delta->out_pos++ < delta->skip) {
+        return 0;
+    }
+    /* only flush once more output follows, the last chunk ends the image */
+    if (delta->out_len == sizeof(delta->out)) {
+        if (_flush(delta, true) < 0) {
+            return -1;
+        }
+    }
+    delta->out[delta->out_len++] = byte;
+    return 0;
+}
+
+static int _source(riotboot_flashwrite_delta_t *delta, uint8_t *byte)
+{
+    if (delta->src_pos >= delta->source_len) {
+        LOG_WARNING(LOG_PREFIX "source out of bounds\n");
+        return -1;
+    }
+    /* the bootloader may have marked the source as verified after it was
+     * written, the patch was made against the still erased marker */
+    if (delta->marker_pos &&
+        (delta->src_pos - delta->marker_pos <
+         sizeof(((riotboot_hdr_digest_t *)0)->verified))) {
+        *byte = 0xff;
+        delta->src_pos++;
+        return 0;
+    }
+    *byte = delta->source[delta->src_pos++];
+    return 0;
+}
+
+static void _next_record(riotboot_flashwrite_delta_t *delta)
+{
+    delta->src_pos += delta->adjust;
+    delta->state = _DIFF_LEN;
+}
+
+static void _end_diff(riotboot_flashwrite_delta_t *delta)
+{
+    if (delta->extra_left) {
+        delta->state = _EXTRA;
+    }
+    else {
+        _next_record(delta);
+    }
+}
+
+/* called once the varint of the current state is complete */
+static int _varint_done(riotboot_flashwrite_delta_t *delta, uint32_t val)
+{
+    switch (delta->state) {
+    case _DIFF_LEN:
+        delta->diff_left = val;
+        delta->state = _EXTRA_LEN;
+        break;
+    case _EXTRA_LEN:
+        delta->extra_left = val;
+        delta->state = _ADJUST;
+        break;
+    case _ADJUST:
+        /* zigzag encoded */
+        delta->adjust = (int32_t)(val >> 1) ^ -(int32_t)(val & 1);
+        if (delta->diff_left) {
+            delta->state = _ZEROS;
+        }
+        else {
+            _end_diff(delta);
+        }
+        break;
+    case _ZEROS:
+        if (val > delta->diff_left) {
+            return -1;
+        }
+        /* unchanged bytes are copied from the source */
+        delta->diff_left -= val;
+        while (val--) {
+            uint8_t byte;
+            if ((_source(delta, &byte) < 0) || (_emit(delta, byte) < 0)) {
+                return -1;
+            }
+        }
+        if (delta->diff_left) {
+            delta->state = _LITERALS;
+        }
+        else {
+            _end_diff(delta);
+        }
+        break;
+    case _LITERALS:
+        if ((val == 0) || (val > delta->diff_left)) {
+            return -1;
+        }
+        delta->run = val;
+        delta->state = _DIFF;
+        break;
+    }
+    return 0;
+}
+
+void riotboot_flashwrite_delta_init(riotboot_flashwrite_delta_t *delta,
+                                    riotboot_flashwrite_t *writer,
+                                    int source_slot)
+{
+    memset(delta, 0, sizeof(*delta));
+
+    delta->writer = writer;
+    delta->source = (const uint8_t *)riotboot_slot_get_hdr(source_slot);
+    delta->source_len = _slot_len(source_slot);
+    if (!riotboot_hdr_digest_validate(riotboot_hdr_get_digest(
+                                          riotboot_slot_get_hdr(source_slot)))) {
+        delta->marker_pos = sizeof(riotboot_hdr_t) +
+                            offsetof(riotboot_hdr_digest_t, verified);
+    }
+    delta->skip = writer->offset;
+    delta->state = _MAGIC;
+}
+
+int riotboot_flashwrite_delta_putbytes(riotboot_flashwrite_delta_t *delta,
+                                       const uint8_t *bytes, size_t len,
+                                       bool more)
+{
+    static const char magic[] = RIOTBOOT_FLASHWRITE_DELTA_MAGIC;
+
+    while (len--) {
+        uint8_t b = *bytes++;
+        uint8_t src;
+
+        switch (delta->state) {
+        case _MAGIC:
+            if (b != (uint8_t)magic[delta->run]) {
+                LOG_WARNING(LOG_PREFIX "invalid magic\n");
+                return -1;
+            }
+            if (++delta->run == RIOTBOOT_FLASHWRITE_DELTA_MAGIC_LEN) {
+                delta->run = 0;
+                delta->state = _DIFF_LEN;
+            }
+            break;
+        case _DIFF:
+            if ((_source(delta, &src) < 0) || (_emit(delta, src + b) < 0)) {
+                return -1;
+            }
+            delta->diff_left--;
+            if (--delta->run == 0) {
+                if (delta->diff_left) {
+                    delta->state = _ZEROS;
+                }
+                else {
+                    _end_diff(delta);
+                }
+            }
+            break;
+        case _EXTRA:
+            if (_emit(delta, b) < 0) {
+                return -1;
+            }
+            if (--delta->extra_left == 0) {
+                _next_record(delta);
+            }
+            break;
+        default:
+            /* LEB128 encoded integer */
+            if (delta->shift > 28) {
+                LOG_WARNING(LOG_PREFIX "invalid varint\n");
+                return -1;
+            }
+            delta->varint |= (uint32_t)(b & 0x7f) << delta->shift;
+            delta->shift += 7;
+            if (!(b & 0x80)) {
+                uint32_t val = delta->varint;
+                delta->varint = 0;
+                delta->shift = 0;
+                if (_varint_done(delta, val) < 0) {
+                    LOG_WARNING(LOG_PREFIX "invalid record\n");
+                    return -1;
+                }
+            }
+        }
+    }
+
+    if (more) {
+        return 0;
+    }
+
+    if ((delta->state != _DIFF_LEN) || delta->shift) {
+        LOG_WARNING(LOG_PREFIX "patch truncated\n");
+        return -1;
+    }
+    LOG_INFO(LOG_PREFIX "patched image of %u bytes\n", (unsigned)delta->out_pos);
+    return _flush(delta, false);
+}
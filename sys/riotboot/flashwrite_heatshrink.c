@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_riotboot_flashwrite
+ * @{
+ *
+ * @file
+ * @brief       Streaming heatshrink decompression for firmware updates
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "riotboot/flashwrite.h"
+
+#define LOG_PREFIX "riotboot_flashwrite_heatshrink: "
+#include "log.h"
+
+/* write out all but the last byte, so the final call always has data to
+ * pass along with more == false */
+static int _flush(riotboot_flashwrite_heatshrink_t *hs)
+{
+    size_t len = hs->out_len - 1;
+
+    if (riotboot_flashwrite_putbytes(hs->writer, hs->out, len, true) < 0) {
+        return -1;
+    }
+    hs->out[0] = hs->out[len];
+    hs->out_len = 1;
+    return 0;
+}
+
+static int _poll(riotboot_flashwrite_heatshrink_t *hs)
+{
+    HSD_poll_res res;
+
+    do {
+        size_t n;
+
+        if (hs->out_len == sizeof(hs->out) && _flush(hs) < 0) {
+            return -1;
+        }
+
+        uint8_t *out = hs->out + hs->out_len;
+        res = heatshrink_decoder_poll(&hs->decoder, out,
+                                      sizeof(hs->out) - hs->out_len, &n);
+        if (res < 0) {
+            LOG_WARNING(LOG_PREFIX "decoder error %d\n", res);
+            return -1;
+        }
+
+        /* the writer skips the start of the image, e.g. the riotboot magic */
+        if (hs->skip) {
+            size_t drop = (n < hs->skip) ? n : hs->skip;
+            memmove(out, out + drop, n - drop);
+            hs->skip -= drop;
+            n -= drop;
+        }
+        hs->out_len += n;
+    } while (res == HSDR_POLL_MORE);
+
+    return 0;
+}
+
+void riotboot_flashwrite_heatshrink_init(riotboot_flashwrite_heatshrink_t *hs,
+                                         riotboot_flashwrite_t *writer)
+{
+    hs->writer = writer;
+    hs->skip = writer->offset;
+    hs->out_len = 0;
+    heatshrink_decoder_reset(&hs->decoder);
+}
+
+int riotboot_flashwrite_heatshrink_putbytes(riotboot_flashwrite_heatshrink_t *hs,
+                                            const uint8_t *bytes, size_t len,
+                                            bool more)
+{
+    while (len) {
+        size_t n;
+
+        /* the decoder does not modify the input */
+        if (heatshrink_decoder_sink(&hs->decoder, (uint8_t *)bytes, len, &n) < 0) {
+            return -1;
+        }
+        bytes += n;
+        len -= n;
+
+        if (_poll(hs) < 0) {
+            return -1;
+        }
+    }
+
+    if (more) {
+        return 0;
+    }
+
+    HSD_finish_res res;
+    while ((res = heatshrink_decoder_finish(&hs->decoder)) == HSDR_FINISH_MORE) {
+        if (_poll(hs) < 0) {
+            return -1;
+        }
+    }
+    if ((res != HSDR_FINISH_DONE) || (hs->out_len == 0)) {
+        LOG_WARNING(LOG_PREFIX "image truncated\n");
+        return -1;
+    }
+
+    return riotboot_flashwrite_putbytes(hs->writer, hs->out, hs->out_len, false);
+}
@@ -67,3 +67,18 @@ uint32_t riotboot_hdr_checksum(const riotboot_hdr_t *riotboot_hdr)
 {
     return fletcher32((uint16_t *)riotboot_hdr, offsetof(riotboot_hdr_t, chksum) / sizeof(uint16_t));
 }
+
+int riotboot_hdr_digest_validate(const riotboot_hdr_digest_t *digest)
+{
+    int res = riotboot_hdr_digest_checksum(digest) == digest->chksum ? 0 : -1;
+    if (res) {
+        LOG_INFO("%s: riotboot_hdr digest checksum invalid\n", __func__);
+    }
+
+    return res;
+}
+
+uint32_t riotboot_hdr_digest_checksum(const riotboot_hdr_digest_t *digest)
+{
+    return fletcher32((uint16_t *)digest, offsetof(riotboot_hdr_digest_t, chksum) / sizeof(uint16_t));
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_riotboot_slot
+ * @{
+ *
+ * @file
+ * @brief       Boot time image verification
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "cpu.h"
+#include "hashes/sha256.h"
+#include "log.h"
+#include "periph/flashpage.h"
+#include "riotboot/slot.h"
+
+#define ENABLE_CACHE    (IS_ACTIVE(CONFIG_RIOTBOOT_VERIFY_CACHE) && \
+                         IS_USED(MODULE_PERIPH_FLASHPAGE_RAW))
+
+static void _mark_verified(const riotboot_hdr_digest_t *digest)
+{
+#if ENABLE_CACHE && (FLASHPAGE_RAW_BLOCKSIZE <= 8)
+    static const uint32_t marker[2] = {
+        RIOTBOOT_HDR_VERIFIED, RIOTBOOT_HDR_VERIFIED
+    };
+
+    /* only program the marker into erased flash */
+    for (unsigned i = 0; i < ARRAY_SIZE(marker); i++) {
+        if (digest->verified[i] != UINT32_MAX) {
+            return;
+        }
+    }
+    flashpage_write_raw((void *)digest->verified, marker, FLASHPAGE_RAW_BLOCKSIZE);
+#else
+    (void)digest;
+#endif
+}
+
+int riotboot_slot_verify(unsigned slot)
+{
+    const riotboot_hdr_t *hdr = riotboot_slot_get_hdr(slot);
+    const riotboot_hdr_digest_t *digest = riotboot_hdr_get_digest(hdr);
+    uint8_t img_digest[SHA256_DIGEST_LENGTH];
+
+    if (riotboot_hdr_digest_validate(digest)) {
+        return -1;
+    }
+
+    /* the digest is only checksummed, never hash beyond the flash */
+    uintptr_t flash_end = CPU_FLASH_BASE + FLASHPAGE_SIZE * FLASHPAGE_NUMOF;
+    if ((hdr->start_addr < (uintptr_t)hdr) ||
+        (hdr->start_addr > flash_end) ||
+        (digest->img_len > flash_end - hdr->start_addr)) {
+        LOG_INFO("riotboot: slot %u: image length invalid\n", slot);
+        return -1;
+    }
+
+    if (digest->verified[0] == RIOTBOOT_HDR_VERIFIED) {
+        return 0;
+    }
+
+    sha256((const void *)(uintptr_t)hdr->start_addr, digest->img_len, img_digest);
+    if (memcmp(img_digest, digest->digest, sizeof(img_digest))) {
+        LOG_INFO("riotboot: slot %u: image digest mismatch\n", slot);
+        return -1;
+    }
+
+    _mark_verified(digest);
+    return 0;
+}
@@ -18,18 +18,25 @@
  * @}
  */
 
+#include <assert.h>
 #include <stddef.h>
 #include <stdio.h>
 #include <stdint.h>
 #include <string.h>
 
 #include "saul_reg.h"
+#if IS_USED(MODULE_SAUL_BATCH)
+#include "ztimer.h"
+#endif
 
 /**
  * @brief   Keep the head of the device list as global variable
  */
 saul_reg_t *saul_reg = NULL;
 
+/* last matches of saul_reg_find_type() and saul_reg_find_name() */
+static saul_reg_t *_type_hit;
+static saul_reg_t *_name_hit;
 
 int saul_reg_add(saul_reg_t *dev)
 {
@@ -61,6 +68,8 @@ int saul_reg_rm(saul_reg_t *dev)
     if (saul_reg == NULL || dev == NULL) {
         return -ENODEV;
     }
+    _type_hit = NULL;
+    _name_hit = NULL;
     if (saul_reg == dev) {
         saul_reg = dev->next;
         return 0;
@@ -91,8 +100,12 @@ saul_reg_t *saul_reg_find_type(uint8_t type)
 {
     saul_reg_t *tmp = saul_reg;
 
+    if (_type_hit && (_type_hit->driver->type == type)) {
+        return _type_hit;
+    }
     while (tmp) {
         if (tmp->driver->type == type) {
+            _type_hit = tmp;
             return tmp;
         }
         tmp = tmp->next;
@@ -104,8 +117,12 @@ saul_reg_t *saul_reg_find_name(const char *name)
 {
     saul_reg_t *tmp = saul_reg;
 
+    if (_name_hit && (strcmp(_name_hit->name, name) == 0)) {
+        return _name_hit;
+    }
     while (tmp) {
         if (strcmp(tmp->name, name) == 0) {
+            _name_hit = tmp;
             return tmp;
         }
         tmp = tmp->next;
@@ -128,3 +145,43 @@ int saul_reg_write(saul_reg_t *dev, phydat_t *data)
     }
     return dev->driver->write(dev->dev, data);
 }
+
+#if IS_USED(MODULE_SAUL_BATCH)
+int saul_reg_read_batch(saul_reg_t *dev, saul_batch_t *batch)
+{
+    int res;
+
+    if (dev == NULL) {
+        return -ENODEV;
+    }
+    assert(batch->val && batch->numof);
+    if (dev->driver->read_batch) {
+        res = dev->driver->read_batch(dev->dev, batch);
+    }
+    else {
+        phydat_t data;
+
+        res = dev->driver->read(dev->dev, &data);
+        if (res > 0) {
+            memcpy(batch->val[0], data.val, sizeof(data.val));
+            batch->unit = data.unit;
+            batch->scale = data.scale;
+            batch->period_us = 0;
+            res = 1;
+        }
+    }
+    batch->time = ztimer_now(ZTIMER_USEC);
+    return res;
+}
+
+int saul_reg_fifo_config(saul_reg_t *dev, const saul_fifo_cfg_t *cfg)
+{
+    if (dev == NULL) {
+        return -ENODEV;
+    }
+    if (dev->driver->fifo_config == NULL) {
+        return -ENOTSUP;
+    }
+    return dev->driver->fifo_config(dev->dev, cfg);
+}
+#endif
@@ -0,0 +1,234 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_sched_edf
+ * @{
+ *
+ * @file
+ * @brief       Earliest deadline first scheduling class implementation
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <stdbool.h>
+
+#include "irq.h"
+#include "sched_edf.h"
+#include "thread_flags.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+static sched_edf_t *_by_pid[KERNEL_PID_LAST + 1];
+static sched_edf_t *_edfs[CONFIG_SCHED_EDF_NUMOF];
+
+static inline uint32_t _now(void)
+{
+    return ztimer_now(ZTIMER_USEC);
+}
+
+static bool _runs_before(const sched_edf_t *a, const sched_edf_t *b)
+{
+    if (a->state != b->state) {
+        /* released jobs before idle threads */
+        return a->state == SCHED_EDF_ACTIVE;
+    }
+    return (int32_t)(a->deadline - b->deadline) < 0;
+}
+
+/* must be called with interrupts disabled, does not yield */
+static void _assign_priorities(void)
+{
+    sched_edf_t *sorted[CONFIG_SCHED_EDF_NUMOF];
+    unsigned n = 0;
+
+    for (unsigned i = 0; i < CONFIG_SCHED_EDF_NUMOF; i++) {
+        sched_edf_t *edf = _edfs[i];
+
+        if (edf == NULL) {
+            continue;
+        }
+        if (edf->state == SCHED_EDF_DEPLETED) {
+            sched_change_priority(edf->thread, CONFIG_SCHED_EDF_DEPLETED_PRIO);
+            continue;
+        }
+        unsigned pos = n++;
+        while (pos && _runs_before(edf, sorted[pos - 1])) {
+            sorted[pos] = sorted[pos - 1];
+            pos--;
+        }
+        sorted[pos] = edf;
+    }
+    for (unsigned i = 0; i < n; i++) {
+        sched_change_priority(sorted[i]->thread,
+                              CONFIG_SCHED_EDF_PRIO_BASE + i);
+    }
+}
+
+static void _start_budget(sched_edf_t *edf, uint32_t now)
+{
+    edf->since = now;
+    ztimer_set(ZTIMER_USEC, &edf->budget_timer,
+               (edf->used < edf->budget) ? edf->budget - edf->used : 0);
+}
+
+static void _stop_budget(sched_edf_t *edf, uint32_t now)
+{
+    edf->used += now - edf->since;
+    ztimer_remove(ZTIMER_USEC, &edf->budget_timer);
+}
+
+static void _depleted(void *arg)
+{
+    sched_edf_t *edf = arg;
+
+    DEBUG("sched_edf: pid %" PRIkernel_pid " exhausted its budget\n",
+          edf->thread->pid);
+    edf->used = edf->budget;
+    edf->state = SCHED_EDF_DEPLETED;
+    edf->budget_overruns++;
+    _assign_priorities();
+    thread_yield_higher();
+}
+
+static void _release(void *arg)
+{
+    sched_edf_t *edf = arg;
+    uint32_t now = _now();
+    uint32_t late = now - edf->deadline;
+
+    ztimer_set(ZTIMER_USEC, &edf->release,
+               (late < edf->period) ? edf->period - late : edf->period);
+
+    if (edf->state != SCHED_EDF_IDLE) {
+        DEBUG("sched_edf: pid %" PRIkernel_pid " missed its deadline\n",
+              edf->thread->pid);
+        edf->deadline_misses++;
+    }
+    bool running = (edf->thread == (thread_t *)sched_active_thread);
+    if (running && (edf->state == SCHED_EDF_ACTIVE)) {
+        ztimer_remove(ZTIMER_USEC, &edf->budget_timer);
+    }
+
+    edf->deadline += edf->period;
+    edf->used = 0;
+    edf->state = SCHED_EDF_ACTIVE;
+    edf->jobs++;
+    if (running) {
+        _start_budget(edf, now);
+    }
+    _assign_priorities();
+    thread_flags_set(edf->thread, CONFIG_SCHED_EDF_THREAD_FLAG);
+    thread_yield_higher();
+}
+
+void sched_edf_switch(thread_t *active, thread_t *next)
+{
+    sched_edf_t *edf;
+
+    if (active && (edf = _by_pid[active->pid]) &&
+        (edf->state == SCHED_EDF_ACTIVE)) {
+        _stop_budget(edf, _now());
+    }
+    if ((edf = _by_pid[next->pid]) && (edf->state == SCHED_EDF_ACTIVE)) {
+        _start_budget(edf, _now());
+    }
+}
+
+int sched_edf_add(sched_edf_t *edf, kernel_pid_t pid, uint32_t period,
+                  uint32_t budget)
+{
+    thread_t *thread = (thread_t *)thread_get(pid);
+
+    assert(budget <= period);
+    if ((thread == NULL) || _by_pid[pid]) {
+        return -EINVAL;
+    }
+
+    unsigned state = irq_disable();
+    unsigned slot;
+    for (slot = 0; slot < CONFIG_SCHED_EDF_NUMOF; slot++) {
+        if (_edfs[slot] == NULL) {
+            break;
+        }
+    }
+    if (slot == CONFIG_SCHED_EDF_NUMOF) {
+        irq_restore(state);
+        return -ENOMEM;
+    }
+
+    uint32_t now = _now();
+    *edf = (sched_edf_t){
+        .thread = thread,
+        .release = { .callback = _release, .arg = edf },
+        .budget_timer = { .callback = _depleted, .arg = edf },
+        .period = period,
+        .budget = budget,
+        .deadline = now + period,
+        .state = SCHED_EDF_ACTIVE,
+        .jobs = 1,
+    };
+    _edfs[slot] = edf;
+    _by_pid[pid] = edf;
+
+    ztimer_set(ZTIMER_USEC, &edf->release, period);
+    if (thread == (thread_t *)sched_active_thread) {
+        _start_budget(edf, now);
+    }
+    _assign_priorities();
+    irq_restore(state);
+    thread_yield_higher();
+
+    return 0;
+}
+
+void sched_edf_remove(sched_edf_t *edf)
+{
+    unsigned state = irq_disable();
+
+    ztimer_remove(ZTIMER_USEC, &edf->release);
+    ztimer_remove(ZTIMER_USEC, &edf->budget_timer);
+    _by_pid[edf->thread->pid] = NULL;
+    for (unsigned i = 0; i < CONFIG_SCHED_EDF_NUMOF; i++) {
+        if (_edfs[i] == edf) {
+            _edfs[i] = NULL;
+        }
+    }
+    irq_restore(state);
+}
+
+void sched_edf_wait_period(void)
+{
+    sched_edf_t *edf = _by_pid[thread_getpid()];
+
+    assert(edf);
+
+    unsigned state = irq_disable();
+    /* if the next job was already released, the deadline was missed and
+     * we continue right away */
+    if (!(edf->thread->flags & CONFIG_SCHED_EDF_THREAD_FLAG)) {
+        if (edf->state == SCHED_EDF_ACTIVE) {
+            _stop_budget(edf, _now());
+        }
+        edf->state = SCHED_EDF_IDLE;
+        _assign_priorities();
+    }
+    irq_restore(state);
+
+    thread_flags_wait_any(CONFIG_SCHED_EDF_THREAD_FLAG);
+}
+
+const sched_edf_t *sched_edf_get(kernel_pid_t pid)
+{
+    return pid_is_valid(pid) ? _by_pid[pid] : NULL;
+}
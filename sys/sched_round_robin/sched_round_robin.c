@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_sched_round_robin
+ * @{
+ *
+ * @file
+ * @brief       Round robin time slicing implementation
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+
+#include "clist.h"
+#include "sched.h"
+#include "sched_round_robin.h"
+#include "thread.h"
+#include "ztimer.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/* no quantum running */
+#define PRIO_NONE   (SCHED_PRIO_LEVELS)
+
+static void _slice_end(void *arg);
+
+static ztimer_t _timer = { .callback = _slice_end };
+/* priority level the running quantum belongs to */
+static unsigned _prio = PRIO_NONE;
+
+static bool _contended(unsigned prio)
+{
+    clist_node_t *rq = &sched_runqueues[prio];
+
+    /* the run queue points to its last entry, which links to the first */
+    return rq->next && (rq->next->next != rq->next);
+}
+
+static void _arm(unsigned prio)
+{
+    _prio = prio;
+    ztimer_set(ZTIMER_MSEC, &_timer, CONFIG_SCHED_ROUND_ROBIN_QUANTUM_MS);
+}
+
+static void _disarm(void)
+{
+    if (_prio != PRIO_NONE) {
+        ztimer_remove(ZTIMER_MSEC, &_timer);
+        _prio = PRIO_NONE;
+    }
+}
+
+static void _slice_end(void *arg)
+{
+    (void)arg;
+    thread_t *active = (thread_t *)sched_active_thread;
+    unsigned prio = _prio;
+
+    _prio = PRIO_NONE;
+    if (!active || (active->priority != prio) || !_contended(prio)) {
+        return;
+    }
+    /* only rotate if the running thread is at the head of its queue */
+    if (sched_runqueues[prio].next->next == &active->rq_entry) {
+        DEBUG("sched_round_robin: pid %" PRIkernel_pid " used up its slice\n",
+              active->pid);
+        clist_lpoprpush(&sched_runqueues[prio]);
+        thread_yield_higher();
+    }
+}
+
+void sched_round_robin_switch(thread_t *next)
+{
+    _disarm();
+    if (_contended(next->priority)) {
+        _arm(next->priority);
+    }
+}
+
+void sched_round_robin_runnable(thread_t *thread)
+{
+    thread_t *active = (thread_t *)sched_active_thread;
+
+    if (active && (active->priority == thread->priority) &&
+        (_prio == PRIO_NONE) && _contended(thread->priority)) {
+        _arm(thread->priority);
+    }
+}
@@ -21,12 +21,227 @@
  * @}
  */
 
+#include <errno.h>
+#include <string.h>
+
+#include "metrics.h"
 #include "sched.h"
 #include "xtimer.h"
 #include "schedstatistics.h"
 
+#if IS_USED(MODULE_SCHEDSTATISTICS_EXT)
+#include "bitarithm.h"
+#include "bitfield.h"
+#include "irq.h"
+#endif
+#if IS_USED(MODULE_SCHEDSTATISTICS_IRQ)
+#include "cpu.h"
+#include "periph_conf.h"
+#endif
+
 schedstat_t sched_pidlist[KERNEL_PID_LAST + 1];
 
+#if IS_USED(MODULE_METRICS)
+static const metrics_entry_t _metrics_entries[] = {
+    METRICS_ENTRY(METRICS_UINT, "schedules", schedstat_t, schedules),
+    METRICS_ENTRY(METRICS_U64, "runtime_ticks", schedstat_t, runtime_ticks),
+};
+
+/* one instance per PID */
+metrics_group_t schedstat_metrics = {
+    .name = "sched",
+    .base = sched_pidlist,
+    .entries = _metrics_entries,
+    .numof = ARRAY_SIZE(_metrics_entries),
+    .count = KERNEL_PID_LAST + 1,
+    .stride = sizeof(schedstat_t),
+    .id = 0,
+};
+#endif
+
+#if IS_USED(MODULE_SCHEDSTATISTICS_EXT)
+schedstat_ext_t sched_pidlist_ext[KERNEL_PID_LAST + 1];
+
+#if IS_USED(MODULE_METRICS)
+/* the latency histogram has the buckets of CONFIG_SCHEDSTAT_LATENCY_BUCKETS */
+static const metrics_entry_t _metrics_ext_entries[] = {
+    METRICS_ENTRY(METRICS_HISTOGRAM, "latency", schedstat_ext_t, latency),
+    METRICS_ENTRY(METRICS_U32, "latency_max", schedstat_ext_t, latency_max),
+    METRICS_ENTRY(METRICS_U32, "slice_max", schedstat_ext_t, slice_max),
+    METRICS_ENTRY(METRICS_U32, "mutex_blocked", schedstat_ext_t,
+                  mutex_blocked),
+    METRICS_ENTRY(METRICS_U32, "msg_blocked", schedstat_ext_t, msg_blocked),
+    METRICS_ENTRY(METRICS_U32, "irq_off", schedstat_ext_t, irq_off),
+    METRICS_ENTRY(METRICS_U32, "irq_off_max", schedstat_ext_t, irq_off_max),
+};
+
+metrics_group_t schedstat_ext_metrics = {
+    .name = "sched_ext",
+    .base = sched_pidlist_ext,
+    .entries = _metrics_ext_entries,
+    .numof = ARRAY_SIZE(_metrics_ext_entries),
+    .count = KERNEL_PID_LAST + 1,
+    .stride = sizeof(schedstat_ext_t),
+    .id = 0,
+};
+#endif
+
+/* time stamp of the last wakeup or block of every thread */
+static uint32_t _since[KERNEL_PID_LAST + 1];
+/* threads woken up, but not yet scheduled */
+static BITFIELD(_woken, KERNEL_PID_LAST + 1);
+
+static unsigned _latency_bucket(uint32_t ticks)
+{
+    unsigned bucket = (ticks < 4) ? 0 : (bitarithm_msb(ticks) / 2);
+
+    if (bucket >= CONFIG_SCHEDSTAT_LATENCY_BUCKETS) {
+        bucket = CONFIG_SCHEDSTAT_LATENCY_BUCKETS - 1;
+    }
+    return bucket;
+}
+
+static void _status_cb(kernel_pid_t pid, thread_status_t old_status,
+                       thread_status_t new_status)
+{
+    bool was_queued = (old_status >= STATUS_ON_RUNQUEUE);
+    bool queued = (new_status >= STATUS_ON_RUNQUEUE);
+
+    if (was_queued == queued) {
+        return;
+    }
+
+    uint32_t now = xtimer_now().ticks32;
+
+    if (queued) {
+        schedstat_ext_t *ext = &sched_pidlist_ext[pid];
+        uint32_t blocked = now - _since[pid];
+
+        switch (old_status) {
+            case STATUS_MUTEX_BLOCKED:
+                ext->mutex_blocked += blocked;
+                break;
+            case STATUS_RECEIVE_BLOCKED:
+            case STATUS_SEND_BLOCKED:
+            case STATUS_REPLY_BLOCKED:
+                ext->msg_blocked += blocked;
+                break;
+            default:
+                break;
+        }
+        bf_set(_woken, pid);
+    }
+    _since[pid] = now;
+}
+
+static void _ext_active(kernel_pid_t pid, uint32_t slice)
+{
+    schedstat_ext_t *ext = &sched_pidlist_ext[pid];
+
+    if (slice > ext->slice_max) {
+        ext->slice_max = slice;
+    }
+}
+
+static void _ext_next(kernel_pid_t pid, uint32_t now)
+{
+    if (bf_isset(_woken, pid)) {
+        schedstat_ext_t *ext = &sched_pidlist_ext[pid];
+        uint32_t latency = now - _since[pid];
+
+        bf_unset(_woken, pid);
+        ext->latency[_latency_bucket(latency)]++;
+        if (latency > ext->latency_max) {
+            ext->latency_max = latency;
+        }
+    }
+}
+
+int schedstat_ext_dump(void *buf, size_t len)
+{
+    schedstat_ext_dump_hdr_t *hdr = buf;
+    schedstat_ext_dump_rec_t *rec = (schedstat_ext_dump_rec_t *)(hdr + 1);
+    size_t needed = sizeof(*hdr);
+
+    for (kernel_pid_t i = KERNEL_PID_FIRST; i <= KERNEL_PID_LAST; i++) {
+        if (sched_threads[i] != NULL) {
+            needed += sizeof(*rec);
+        }
+    }
+    if (needed > len) {
+        return -ENOBUFS;
+    }
+
+    hdr->version = SCHEDSTAT_EXT_DUMP_VERSION;
+    hdr->numof = 0;
+    hdr->buckets = CONFIG_SCHEDSTAT_LATENCY_BUCKETS;
+    hdr->record_size = sizeof(*rec);
+    hdr->ticks_hz = XTIMER_HZ;
+#if IS_USED(MODULE_SCHEDSTATISTICS_IRQ) && defined(CLOCK_CORECLOCK)
+    hdr->cycles_hz = CLOCK_CORECLOCK;
+#else
+    hdr->cycles_hz = 0;
+#endif
+    for (kernel_pid_t i = KERNEL_PID_FIRST; i <= KERNEL_PID_LAST; i++) {
+        if (sched_threads[i] == NULL) {
+            continue;
+        }
+        /* a thread started meanwhile will not fit */
+        if ((size_t)((uint8_t *)(rec + 1) - (uint8_t *)buf) > len) {
+            break;
+        }
+
+        unsigned state = irq_disable();
+        rec->pid = i;
+        rec->reserved = 0;
+        rec->stat = sched_pidlist[i];
+        rec->ext = sched_pidlist_ext[i];
+        irq_restore(state);
+        hdr->numof++;
+        rec++;
+    }
+    return (uint8_t *)rec - (uint8_t *)buf;
+}
+
+void schedstat_ext_reset(void)
+{
+    unsigned state = irq_disable();
+    memset(sched_pidlist_ext, 0, sizeof(sched_pidlist_ext));
+    irq_restore(state);
+}
+#endif /* MODULE_SCHEDSTATISTICS_EXT */
+
+#if IS_USED(MODULE_SCHEDSTATISTICS_IRQ)
+static uint32_t _irq_off_start;
+static kernel_pid_t _irq_off_pid = KERNEL_PID_UNDEF;
+
+void schedstat_irq_off(void)
+{
+    /* time spent in ISRs is not accounted to the interrupted thread */
+    if (irq_is_in()) {
+        return;
+    }
+    _irq_off_start = DWT->CYCCNT;
+    _irq_off_pid = sched_active_pid;
+}
+
+void schedstat_irq_on(void)
+{
+    if (_irq_off_pid == KERNEL_PID_UNDEF) {
+        return;
+    }
+
+    schedstat_ext_t *ext = &sched_pidlist_ext[_irq_off_pid];
+    uint32_t cycles = DWT->CYCCNT - _irq_off_start;
+
+    _irq_off_pid = KERNEL_PID_UNDEF;
+    ext->irq_off += cycles;
+    if (cycles > ext->irq_off_max) {
+        ext->irq_off_max = cycles;
+    }
+}
+#endif /* MODULE_SCHEDSTATISTICS_IRQ */
+
 void sched_statistics_cb(kernel_pid_t active_thread, kernel_pid_t next_thread)
 {
     uint32_t now = xtimer_now().ticks32;
@@ -34,7 +249,11 @@ void sched_statistics_cb(kernel_pid_t active_thread, kernel_pid_t next_thread)
     /* Update active thread stats */
     if (active_thread != KERNEL_PID_UNDEF) {
         schedstat_t *active_stat = &sched_pidlist[active_thread];
-        active_stat->runtime_ticks += now - active_stat->laststart;
+        uint32_t slice = now - active_stat->laststart;
+        active_stat->runtime_ticks += slice;
+#if IS_USED(MODULE_SCHEDSTATISTICS_EXT)
+        _ext_active(active_thread, slice);
+#endif
     }
 
     /* Update next_thread stats */
@@ -42,6 +261,9 @@ void sched_statistics_cb(kernel_pid_t active_thread, kernel_pid_t next_thread)
         schedstat_t *next_stat = &sched_pidlist[next_thread];
         next_stat->laststart = now;
         next_stat->schedules++;
+#if IS_USED(MODULE_SCHEDSTATISTICS_EXT)
+        _ext_next(next_thread, now);
+#endif
     }
 }
 
@@ -52,5 +274,13 @@ void init_schedstatistics(void)
     schedstat_t *active_stat = &sched_pidlist[sched_active_pid];
     active_stat->laststart = xtimer_now().ticks32;
     active_stat->schedules = 1;
+#if IS_USED(MODULE_SCHEDSTATISTICS_IRQ)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+#if IS_USED(MODULE_SCHEDSTATISTICS_EXT)
+    sched_register_status_cb(_status_cb);
+#endif
     sched_register_cb(sched_statistics_cb);
 }
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_senml
+ * @{
+ *
+ * @file
+ * @brief       SenML units
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include "senml.h"
+
+/* SenML unit of a phydat unit, values are multiplied by factor * 10^exp */
+typedef struct {
+    const char *name;
+    uint32_t factor;
+    int8_t exp;
+} _unit_t;
+
+/* indexed by phydat unit, see RFC 8428 and RFC 8798 for the symbols */
+static const _unit_t _units[] = {
+    [UNIT_TEMP_C]   = { "Cel", 1, 0 },
+    [UNIT_TEMP_K]   = { "K", 1, 0 },
+    [UNIT_LUX]      = { "lx", 1, 0 },
+    [UNIT_M]        = { "m", 1, 0 },
+    [UNIT_M2]       = { "m2", 1, 0 },
+    [UNIT_M3]       = { "m3", 1, 0 },
+    [UNIT_G]        = { "m/s2", 980665, -5 },
+    [UNIT_DPS]      = { "rad/s", 174533, -7 },
+    [UNIT_GR]       = { "kg", 1, -3 },
+    [UNIT_A]        = { "A", 1, 0 },
+    [UNIT_V]        = { "V", 1, 0 },
+    [UNIT_W]        = { "W", 1, 0 },
+    [UNIT_GS]       = { "T", 1, -4 },
+    [UNIT_DBM]      = { "dBm", 1, 0 },
+    [UNIT_COULOMB]  = { "C", 1, 0 },
+    [UNIT_F]        = { "F", 1, 0 },
+    [UNIT_OHM]      = { "Ohm", 1, 0 },
+    [UNIT_PH]       = { "pH", 1, 0 },
+    [UNIT_BAR]      = { "Pa", 1, 5 },
+    [UNIT_PA]       = { "Pa", 1, 0 },
+    [UNIT_CD]       = { "cd", 1, 0 },
+    [UNIT_CTS]      = { "count", 1, 0 },
+    [UNIT_PERCENT]  = { "%", 1, 0 },
+    [UNIT_PERMILL]  = { "/", 1, -3 },
+    [UNIT_PPM]      = { "/", 1, -6 },
+    [UNIT_PPB]      = { "/", 1, -9 },
+    [UNIT_GPM3]     = { "kg/m3", 1, -3 },
+};
+
+const char *senml_unit(uint8_t unit, senml_decimal_t *val)
+{
+    if ((unit >= ARRAY_SIZE(_units)) || !_units[unit].name) {
+        return NULL;
+    }
+    if (val) {
+        val->m *= _units[unit].factor;
+        val->e += _units[unit].exp;
+    }
+    return _units[unit].name;
+}
+
+void senml_decimal_normalize(senml_decimal_t *val)
+{
+    if (!val->m) {
+        val->e = 0;
+        return;
+    }
+    while ((val->e < 0) && !(val->m % 10)) {
+        val->m /= 10;
+        val->e++;
+    }
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_senml
+ * @{
+ *
+ * @file
+ * @brief       SenML CBOR encoder
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "fmt.h"
+#include "senml.h"
+
+/* CBOR labels, see RFC 8428 section 6 */
+enum {
+    LABEL_BASE_NAME     = -2,
+    LABEL_BASE_TIME     = -3,
+    LABEL_BASE_UNIT     = -4,
+    LABEL_NAME          = 0,
+    LABEL_UNIT          = 1,
+    LABEL_VALUE         = 2,
+    LABEL_BOOL_VALUE    = 4,
+    LABEL_TIME          = 6,
+};
+
+/* tag of a decimal fraction [exponent, mantissa], RFC 8949 section 3.4.4 */
+#define TAG_DECIMAL_FRACTION    (4U)
+
+static void _fmt_decimal(nanocbor_encoder_t *enc, senml_decimal_t val)
+{
+    senml_decimal_normalize(&val);
+    if (!val.e) {
+        nanocbor_fmt_int(enc, val.m);
+        return;
+    }
+    nanocbor_fmt_tag(enc, TAG_DECIMAL_FRACTION);
+    nanocbor_fmt_array(enc, 2);
+    nanocbor_fmt_int(enc, val.e);
+    nanocbor_fmt_int(enc, val.m);
+}
+
+/* appends the index to the name, dimensions are at most 3 digits */
+static size_t _indexed_name(char *buf, const char *name, unsigned i)
+{
+    size_t len = name ? fmt_strnlen(name, CONFIG_SENML_NAME_MAX - 4) : 0;
+
+    if (len) {
+        memcpy(buf, name, len);
+        buf[len++] = ':';
+    }
+    return len + fmt_u32_dec(&buf[len], i);
+}
+
+static void _record(senml_cbor_t *ctx, const senml_phydat_t *rec, unsigned i)
+{
+    nanocbor_encoder_t *enc = ctx->enc;
+    const senml_base_t *base = ctx->base;
+    const char *base_unit = NULL;
+    bool is_bool = (rec->data->unit == UNIT_BOOL);
+    senml_decimal_t val = { .m = rec->data->val[i], .e = rec->data->scale };
+    const char *unit = is_bool ? NULL : senml_unit(rec->data->unit, &val);
+    char name[CONFIG_SENML_NAME_MAX];
+    size_t name_len = 0;
+    unsigned num = 1;
+
+    if (rec->dim > 1) {
+        name_len = _indexed_name(name, rec->name, i);
+    }
+    else if (rec->name) {
+        name_len = strlen(rec->name);
+    }
+    if (unit && (rec->data->unit == base->unit)) {
+        unit = NULL;
+    }
+    num += (name_len > 0) + (unit != NULL) + (rec->time_ms != 0);
+    if (ctx->first) {
+        base_unit = senml_unit(base->unit, NULL);
+        num += (base->name != NULL) + (base->time_ms != 0) +
+               (base_unit != NULL);
+    }
+
+    nanocbor_fmt_map(enc, num);
+    if (ctx->first) {
+        if (base->name) {
+            nanocbor_fmt_int(enc, LABEL_BASE_NAME);
+            nanocbor_put_tstr(enc, base->name);
+        }
+        if (base->time_ms) {
+            nanocbor_fmt_int(enc, LABEL_BASE_TIME);
+            _fmt_decimal(enc, (senml_decimal_t){ .m = base->time_ms,
+                                                 .e = -3 });
+        }
+        if (base_unit) {
+            nanocbor_fmt_int(enc, LABEL_BASE_UNIT);
+            nanocbor_put_tstr(enc, base_unit);
+        }
+        ctx->first = false;
+    }
+    if (name_len) {
+        nanocbor_fmt_int(enc, LABEL_NAME);
+        nanocbor_put_tstrn(enc, (rec->dim > 1) ? name : rec->name, name_len);
+    }
+    if (unit) {
+        nanocbor_fmt_int(enc, LABEL_UNIT);
+        nanocbor_put_tstr(enc, unit);
+    }
+    if (is_bool) {
+        nanocbor_fmt_int(enc, LABEL_BOOL_VALUE);
+        nanocbor_fmt_bool(enc, rec->data->val[i]);
+    }
+    else {
+        nanocbor_fmt_int(enc, LABEL_VALUE);
+        _fmt_decimal(enc, val);
+    }
+    if (rec->time_ms) {
+        nanocbor_fmt_int(enc, LABEL_TIME);
+        _fmt_decimal(enc, (senml_decimal_t){ .m = rec->time_ms, .e = -3 });
+    }
+}
+
+static void _init(senml_cbor_t *ctx, nanocbor_encoder_t *enc,
+                  const senml_base_t *base)
+{
+    ctx->enc = enc;
+    ctx->base = base;
+    ctx->first = true;
+}
+
+void senml_cbor_start(senml_cbor_t *ctx, nanocbor_encoder_t *enc,
+                      const senml_base_t *base)
+{
+    _init(ctx, enc, base);
+    nanocbor_fmt_array_indefinite(enc);
+}
+
+void senml_cbor_add(senml_cbor_t *ctx, const senml_phydat_t *rec)
+{
+    for (unsigned i = 0; i < rec->dim; i++) {
+        _record(ctx, rec, i);
+    }
+}
+
+size_t senml_cbor_finish(senml_cbor_t *ctx)
+{
+    nanocbor_fmt_end_indefinite(ctx->enc);
+    return nanocbor_encoded_len(ctx->enc);
+}
+
+size_t senml_cbor_encode(nanocbor_encoder_t *enc, const senml_base_t *base,
+                         const senml_phydat_t *recs, unsigned numof)
+{
+    senml_cbor_t ctx;
+    unsigned num = 0;
+
+    for (unsigned i = 0; i < numof; i++) {
+        num += recs[i].dim;
+    }
+    /* the number of records is known, saves the break byte */
+    _init(&ctx, enc, base);
+    nanocbor_fmt_array(enc, num);
+    for (unsigned i = 0; i < numof; i++) {
+        senml_cbor_add(&ctx, &recs[i]);
+    }
+    return nanocbor_encoded_len(enc);
+}
@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_senml
+ * @{
+ *
+ * @file
+ * @brief       SenML JSON encoder
+ *
+ * Names are not escaped, SenML restricts them to characters that need no
+ * escaping anyway.
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "fmt.h"
+#include "senml.h"
+
+/* fractions with more leading zeros are written with an exponent */
+#define MAX_LEADING_ZEROS   (6U)
+
+static void _put(senml_json_t *ctx, const char *s, size_t n)
+{
+    if (ctx->len + n <= ctx->size) {
+        memcpy(&ctx->buf[ctx->len], s, n);
+    }
+    ctx->len += n;
+}
+
+static void _put_str(senml_json_t *ctx, const char *s)
+{
+    _put(ctx, s, fmt_strlen(s));
+}
+
+static void _put_zeros(senml_json_t *ctx, size_t n)
+{
+    while (n--) {
+        _put(ctx, "0", 1);
+    }
+}
+
+static void _put_key(senml_json_t *ctx, bool *sep, const char *key)
+{
+    if (*sep) {
+        _put(ctx, ",", 1);
+    }
+    *sep = true;
+    _put(ctx, "\"", 1);
+    _put_str(ctx, key);
+    _put(ctx, "\":", 2);
+}
+
+static void _put_quoted(senml_json_t *ctx, const char *s, size_t n)
+{
+    _put(ctx, "\"", 1);
+    _put(ctx, s, n);
+    _put(ctx, "\"", 1);
+}
+
+static void _put_decimal(senml_json_t *ctx, senml_decimal_t val)
+{
+    char digits[20];    /* "9223372036854775808" */
+    char exp[5];        /* "e-128" */
+    size_t len;
+
+    senml_decimal_normalize(&val);
+    if (val.m < 0) {
+        _put(ctx, "-", 1);
+    }
+    len = fmt_u64_dec(digits, (val.m < 0) ? -(uint64_t)val.m : (uint64_t)val.m);
+
+    size_t frac = (val.e < 0) ? (size_t)-val.e : 0;
+    if (!frac || (frac > len + MAX_LEADING_ZEROS)) {
+        _put(ctx, digits, len);
+        if (val.e) {
+            exp[0] = 'e';
+            _put(ctx, exp, 1 + fmt_s32_dec(&exp[1], val.e));
+        }
+    }
+    else if (frac < len) {
+        _put(ctx, digits, len - frac);
+        _put(ctx, ".", 1);
+        _put(ctx, &digits[len - frac], frac);
+    }
+    else {
+        _put(ctx, "0.", 2);
+        _put_zeros(ctx, frac - len);
+        _put(ctx, digits, len);
+    }
+}
+
+static void _put_name(senml_json_t *ctx, const senml_phydat_t *rec, unsigned i)
+{
+    char index[3];
+    size_t len = rec->name ? fmt_strlen(rec->name) : 0;
+
+    _put(ctx, "\"", 1);
+    if (rec->dim > 1) {
+        /* same limit as for CBOR, dimensions are at most 3 digits */
+        len = rec->name ? fmt_strnlen(rec->name, CONFIG_SENML_NAME_MAX - 4) : 0;
+        if (len) {
+            _put(ctx, rec->name, len);
+            _put(ctx, ":", 1);
+        }
+        _put(ctx, index, fmt_u32_dec(index, i));
+    }
+    else {
+        _put(ctx, rec->name, len);
+    }
+    _put(ctx, "\"", 1);
+}
+
+static void _record(senml_json_t *ctx, const senml_phydat_t *rec, unsigned i)
+{
+    const senml_base_t *base = ctx->base;
+    bool is_bool = (rec->data->unit == UNIT_BOOL);
+    senml_decimal_t val = { .m = rec->data->val[i], .e = rec->data->scale };
+    const char *unit = is_bool ? NULL : senml_unit(rec->data->unit, &val);
+    bool sep = false;
+
+    _put(ctx, ctx->first ? "{" : ",{", ctx->first ? 1 : 2);
+    if (ctx->first) {
+        const char *base_unit = senml_unit(base->unit, NULL);
+
+        if (base->name) {
+            _put_key(ctx, &sep, "bn");
+            _put_quoted(ctx, base->name, fmt_strlen(base->name));
+        }
+        if (base->time_ms) {
+            _put_key(ctx, &sep, "bt");
+            _put_decimal(ctx, (senml_decimal_t){ .m = base->time_ms,
+                                                 .e = -3 });
+        }
+        if (base_unit) {
+            _put_key(ctx, &sep, "bu");
+            _put_quoted(ctx, base_unit, fmt_strlen(base_unit));
+        }
+        ctx->first = false;
+    }
+    if ((rec->dim > 1) || (rec->name && *rec->name)) {
+        _put_key(ctx, &sep, "n");
+        _put_name(ctx, rec, i);
+    }
+    if (unit && (rec->data->unit != base->unit)) {
+        _put_key(ctx, &sep, "u");
+        _put_quoted(ctx, unit, fmt_strlen(unit));
+    }
+    if (is_bool) {
+        _put_key(ctx, &sep, "vb");
+        _put_str(ctx, rec->data->val[i] ? "true" : "false");
+    }
+    else {
+        _put_key(ctx, &sep, "v");
+        _put_decimal(ctx, val);
+    }
+    if (rec->time_ms) {
+        _put_key(ctx, &sep, "t");
+        _put_decimal(ctx, (senml_decimal_t){ .m = rec->time_ms, .e = -3 });
+    }
+    _put(ctx, "}", 1);
+}
+
+void senml_json_start(senml_json_t *ctx, char *buf, size_t size,
+                      const senml_base_t *base)
+{
+    ctx->buf = buf;
+    ctx->size = size;
+    ctx->len = 0;
+    ctx->base = base;
+    ctx->first = true;
+    _put(ctx, "[", 1);
+}
+
+void senml_json_add(senml_json_t *ctx, const senml_phydat_t *rec)
+{
+    for (unsigned i = 0; i < rec->dim; i++) {
+        _record(ctx, rec, i);
+    }
+}
+
+size_t senml_json_finish(senml_json_t *ctx)
+{
+    _put(ctx, "]", 1);
+    return ctx->len;
+}
+
+size_t senml_json_encode(char *buf, size_t size, const senml_base_t *base,
+                         const senml_phydat_t *recs, unsigned numof)
+{
+    senml_json_t ctx;
+
+    senml_json_start(&ctx, buf, size, base);
+    for (unsigned i = 0; i < numof; i++) {
+        senml_json_add(&ctx, &recs[i]);
+    }
+    return senml_json_finish(&ctx);
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_senml
+ * @{
+ *
+ * @file
+ * @brief       SenML readings of SAUL devices
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "senml.h"
+#if IS_USED(MODULE_SAUL_BATCH)
+#include "ztimer.h"
+#endif
+
+saul_reg_t *senml_saul_read(saul_reg_t *dev, senml_phydat_t *rec,
+                            phydat_t *data)
+{
+    for (; dev; dev = dev->next) {
+        int dim = saul_reg_read(dev, data);
+
+        if (dim > 0) {
+            rec->name = dev->name;
+            rec->data = data;
+            rec->dim = dim;
+            rec->time_ms = 0;
+            return dev;
+        }
+    }
+    return NULL;
+}
+
+#if IS_USED(MODULE_SENML_CBOR)
+void senml_saul_cbor(senml_cbor_t *ctx)
+{
+    senml_phydat_t rec;
+    phydat_t data;
+
+    for (saul_reg_t *dev = senml_saul_read(saul_reg, &rec, &data); dev;
+         dev = senml_saul_read(dev->next, &rec, &data)) {
+        senml_cbor_add(ctx, &rec);
+    }
+}
+#endif
+
+#if IS_USED(MODULE_SENML_JSON)
+void senml_saul_json(senml_json_t *ctx)
+{
+    senml_phydat_t rec;
+    phydat_t data;
+
+    for (saul_reg_t *dev = senml_saul_read(saul_reg, &rec, &data); dev;
+         dev = senml_saul_read(dev->next, &rec, &data)) {
+        senml_json_add(ctx, &rec);
+    }
+}
+#endif
+
+#if IS_USED(MODULE_SAUL_BATCH)
+void senml_saul_batch_sample(senml_phydat_t *rec, phydat_t *data,
+                             const saul_batch_t *batch, unsigned n,
+                             unsigned i)
+{
+    uint32_t age_us = (ztimer_now(ZTIMER_USEC) - batch->time) +
+                      (n - 1 - i) * batch->period_us;
+
+    memcpy(data->val, batch->val[i], sizeof(data->val));
+    data->unit = batch->unit;
+    data->scale = batch->scale;
+    rec->data = data;
+    rec->time_ms = -(int32_t)(age_us / 1000);
+}
+#endif
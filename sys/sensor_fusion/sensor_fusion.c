@@ -0,0 +1,373 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_sensor_fusion
+ * @{
+ *
+ * @file
+ * @brief       Fixed-point Madgwick and Mahony filters
+ *
+ * Both filters follow the reference implementations by S. Madgwick, with the
+ * gradient of Madgwick written as J^T f.
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "sensor_fusion.h"
+#include "timex.h"
+
+/* fractional bits of the quaternion and of normalized vectors */
+#define Q               (28)
+#define ONE             ((int32_t)1 << Q)
+#define HALF            ((int32_t)1 << (Q - 1))
+
+/* product of two Q28 numbers */
+static inline int32_t _mul(int32_t a, int32_t b)
+{
+    return ((int64_t)a * b) >> Q;
+}
+
+/* product of a Q28 number and a Q<shift> number, not truncated to 32 bit */
+static inline int64_t _mul64(int32_t a, int32_t b, unsigned shift)
+{
+    return ((int64_t)a * b) >> shift;
+}
+
+/* product of a Q28 number of at most 1 and a 64 bit Q28 number */
+static inline int64_t _mulw(int32_t a, int64_t w)
+{
+    return (a * w) >> Q;
+}
+
+static uint32_t _isqrt64(uint64_t x)
+{
+    uint64_t res = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+
+    while (bit > x) {
+        bit >>= 2;
+    }
+    while (bit) {
+        if (x >= res + bit) {
+            x -= res + bit;
+            res = (res >> 1) + bit;
+        }
+        else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return res;
+}
+
+/* scales v to length ONE, false if v is zero */
+static bool _normalize(const int64_t *v, int32_t *out, unsigned n)
+{
+    uint64_t max = 0;
+    int32_t x[4];
+
+    for (unsigned i = 0; i < n; i++) {
+        uint64_t a = (v[i] < 0) ? -(uint64_t)v[i] : (uint64_t)v[i];
+        if (a > max) {
+            max = a;
+        }
+    }
+    if (max == 0) {
+        return false;
+    }
+
+    /* bring the largest component to [2^29, 2^30), so that the sum of
+     * squares fits and small vectors keep their precision */
+    int shift = 0;
+    while ((max >> shift) >= ((uint64_t)1 << 30)) {
+        shift++;
+    }
+    while ((max << -shift) < ((uint64_t)1 << 29)) {
+        shift--;
+    }
+
+    uint64_t sum = 0;
+    for (unsigned i = 0; i < n; i++) {
+        x[i] = (shift >= 0) ? (int32_t)(v[i] >> shift)
+                            : (int32_t)(v[i] * ((int64_t)1 << -shift));
+        sum += (int64_t)x[i] * x[i];
+    }
+
+    /* x[i] <= norm, so x[i] * r fits into 64 bit */
+    uint64_t r = ((uint64_t)1 << (Q + 32)) / _isqrt64(sum);
+    for (unsigned i = 0; i < n; i++) {
+        out[i] = ((int64_t)x[i] * (int64_t)r) >> 32;
+    }
+    return true;
+}
+
+static bool _normalize_fix16(const fix16_t *v, int32_t *out)
+{
+    int64_t w[3] = { v[0], v[1], v[2] };
+
+    return _normalize(w, out, 3);
+}
+
+/* magnetic field in the earth frame, as horizontal and vertical component */
+static void _earth_field(const int32_t *q, const int32_t *m,
+                         int32_t *bx, int32_t *bz)
+{
+    int32_t q0q1 = _mul(q[0], q[1]);
+    int32_t q0q2 = _mul(q[0], q[2]), q0q3 = _mul(q[0], q[3]);
+    int32_t q1q1 = _mul(q[1], q[1]), q1q2 = _mul(q[1], q[2]);
+    int32_t q1q3 = _mul(q[1], q[3]), q2q2 = _mul(q[2], q[2]);
+    int32_t q2q3 = _mul(q[2], q[3]), q3q3 = _mul(q[3], q[3]);
+
+    int32_t hx = 2 * (_mul(m[0], HALF - q2q2 - q3q3) +
+                      _mul(m[1], q1q2 - q0q3) + _mul(m[2], q1q3 + q0q2));
+    int32_t hy = 2 * (_mul(m[0], q1q2 + q0q3) +
+                      _mul(m[1], HALF - q1q1 - q3q3) +
+                      _mul(m[2], q2q3 - q0q1));
+    *bx = _isqrt64((int64_t)hx * hx + (int64_t)hy * hy);
+    *bz = 2 * (_mul(m[0], q1q3 - q0q2) + _mul(m[1], q2q3 + q0q1) +
+               _mul(m[2], HALF - q1q1 - q2q2));
+}
+
+/* gradient of the Madgwick objective function, zero if there is none */
+static void _madgwick_gradient(const int32_t *q, const int32_t *a,
+                               const int32_t *m, int64_t *s)
+{
+    int32_t _2q0 = 2 * q[0], _2q1 = 2 * q[1], _2q2 = 2 * q[2];
+    int32_t _2q3 = 2 * q[3];
+
+    memset(s, 0, 4 * sizeof(*s));
+    if (a) {
+        /* predicted minus measured gravity */
+        int32_t f1 = 2 * (_mul(q[1], q[3]) - _mul(q[0], q[2])) - a[0];
+        int32_t f2 = 2 * (_mul(q[0], q[1]) + _mul(q[2], q[3])) - a[1];
+        int32_t f3 = ONE - 2 * (_mul(q[1], q[1]) + _mul(q[2], q[2])) - a[2];
+
+        s[0] = -_mul64(_2q2, f1, Q) + _mul64(_2q1, f2, Q);
+        s[1] = _mul64(_2q3, f1, Q) + _mul64(_2q0, f2, Q)
+             - _mul64(2 * _2q1, f3, Q);
+        s[2] = -_mul64(_2q0, f1, Q) + _mul64(_2q3, f2, Q)
+             - _mul64(2 * _2q2, f3, Q);
+        s[3] = _mul64(_2q1, f1, Q) + _mul64(_2q2, f2, Q);
+    }
+    if (m) {
+        int32_t bx, bz;
+        _earth_field(q, m, &bx, &bz);
+
+        /* predicted minus measured field */
+        int32_t f4 = _mul(bx, ONE - 2 * (_mul(q[2], q[2]) + _mul(q[3], q[3])))
+                   + 2 * _mul(bz, _mul(q[1], q[3]) - _mul(q[0], q[2])) - m[0];
+        int32_t f5 = 2 * _mul(bx, _mul(q[1], q[2]) - _mul(q[0], q[3]))
+                   + 2 * _mul(bz, _mul(q[0], q[1]) + _mul(q[2], q[3])) - m[1];
+        int32_t f6 = 2 * _mul(bx, _mul(q[0], q[2]) + _mul(q[1], q[3]))
+                   + _mul(bz, ONE - 2 * (_mul(q[1], q[1]) + _mul(q[2], q[2])))
+                   - m[2];
+        int32_t _2bx = 2 * bx, _2bz = 2 * bz;
+
+        s[0] += -_mul64(_mul(_2bz, q[2]), f4, Q)
+              + _mul64(_mul(_2bz, q[1]) - _mul(_2bx, q[3]), f5, Q)
+              + _mul64(_mul(_2bx, q[2]), f6, Q);
+        s[1] += _mul64(_mul(_2bz, q[3]), f4, Q)
+              + _mul64(_mul(_2bx, q[2]) + _mul(_2bz, q[0]), f5, Q)
+              + _mul64(_mul(_2bx, q[3]) - 2 * _mul(_2bz, q[1]), f6, Q);
+        s[2] += _mul64(-2 * _mul(_2bx, q[2]) - _mul(_2bz, q[0]), f4, Q)
+              + _mul64(_mul(_2bx, q[1]) + _mul(_2bz, q[3]), f5, Q)
+              + _mul64(_mul(_2bx, q[0]) - 2 * _mul(_2bz, q[2]), f6, Q);
+        s[3] += _mul64(_mul(_2bz, q[1]) - 2 * _mul(_2bx, q[3]), f4, Q)
+              + _mul64(_mul(_2bz, q[2]) - _mul(_2bx, q[0]), f5, Q)
+              + _mul64(_mul(_2bx, q[1]), f6, Q);
+    }
+}
+
+/* error between measured and predicted directions, as rotation vector */
+static void _mahony_error(const int32_t *q, const int32_t *a,
+                          const int32_t *m, int32_t *e)
+{
+    memset(e, 0, 3 * sizeof(*e));
+    if (a) {
+        /* half of the predicted gravity */
+        int32_t vx = _mul(q[1], q[3]) - _mul(q[0], q[2]);
+        int32_t vy = _mul(q[0], q[1]) + _mul(q[2], q[3]);
+        int32_t vz = _mul(q[0], q[0]) - HALF + _mul(q[3], q[3]);
+
+        e[0] += _mul(a[1], vz) - _mul(a[2], vy);
+        e[1] += _mul(a[2], vx) - _mul(a[0], vz);
+        e[2] += _mul(a[0], vy) - _mul(a[1], vx);
+    }
+    if (m) {
+        int32_t bx, bz;
+        _earth_field(q, m, &bx, &bz);
+
+        /* half of the predicted field */
+        int32_t wx = _mul(bx, HALF - _mul(q[2], q[2]) - _mul(q[3], q[3]))
+                   + _mul(bz, _mul(q[1], q[3]) - _mul(q[0], q[2]));
+        int32_t wy = _mul(bx, _mul(q[1], q[2]) - _mul(q[0], q[3]))
+                   + _mul(bz, _mul(q[0], q[1]) + _mul(q[2], q[3]));
+        int32_t wz = _mul(bx, _mul(q[0], q[2]) + _mul(q[1], q[3]))
+                   + _mul(bz, HALF - _mul(q[1], q[1]) - _mul(q[2], q[2]));
+
+        e[0] += _mul(m[1], wz) - _mul(m[2], wy);
+        e[1] += _mul(m[2], wx) - _mul(m[0], wz);
+        e[2] += _mul(m[0], wy) - _mul(m[1], wx);
+    }
+}
+
+void sensor_fusion_init(sensor_fusion_t *filter, sensor_fusion_algo_t algo,
+                        fix16_t gain, fix16_t gain_i)
+{
+    memset(filter, 0, sizeof(*filter));
+    filter->q[0] = ONE;
+    filter->algo = algo;
+    filter->gain = gain;
+    filter->gain_i = gain_i;
+}
+
+void sensor_fusion_update(sensor_fusion_t *filter, const fix16_t gyro[3],
+                          const fix16_t acc[3], const fix16_t mag[3],
+                          uint32_t dt_us)
+{
+    const sensor_fusion_calib_t *calib = filter->calib;
+    int32_t *q = filter->q;
+    fix16_t g[3], v[3];
+    int32_t a[3], m[3];
+    bool has_a, has_m = false;
+
+    for (unsigned i = 0; i < 3; i++) {
+        g[i] = calib ? gyro[i] - calib->gyro_bias[i] : gyro[i];
+        v[i] = calib ? acc[i] - calib->acc_bias[i] : acc[i];
+    }
+    has_a = _normalize_fix16(v, a);
+    if (mag) {
+        for (unsigned i = 0; i < 3; i++) {
+            v[i] = calib ? fix16_mul(mag[i] - calib->mag_bias[i],
+                                     calib->mag_scale[i])
+                         : mag[i];
+        }
+        has_m = _normalize_fix16(v, m);
+    }
+
+    /* dt in seconds with 24 fractional bits: 2^48 / 10^6 = 281474976.7 */
+    if (dt_us > US_PER_SEC) {
+        dt_us = US_PER_SEC;
+    }
+    int64_t dt = ((uint64_t)dt_us * 281474977) >> 24;
+
+    /* the rate in Q28 exceeds 32 bit for fast rotations */
+    int64_t w[3];
+    for (unsigned i = 0; i < 3; i++) {
+        w[i] = (int64_t)g[i] << (Q - 16);
+    }
+    if (filter->algo == SENSOR_FUSION_MAHONY) {
+        int32_t e[3];
+        _mahony_error(q, has_a ? a : NULL, has_m ? m : NULL, e);
+        for (unsigned i = 0; i < 3; i++) {
+            /* the error is half of the rotation vector */
+            if (filter->gain_i) {
+                filter->integral[i] +=
+                    (2 * _mul64(e[i], filter->gain_i, 16) * dt) >> 24;
+                w[i] += filter->integral[i];
+            }
+            w[i] += 2 * _mul64(e[i], filter->gain, 16);
+        }
+    }
+
+    /* rate of change of the quaternion, half of q * (0, w) */
+    int64_t dq[4];
+    dq[0] = (-_mulw(q[1], w[0]) - _mulw(q[2], w[1]) - _mulw(q[3], w[2])) / 2;
+    dq[1] = (_mulw(q[0], w[0]) + _mulw(q[2], w[2]) - _mulw(q[3], w[1])) / 2;
+    dq[2] = (_mulw(q[0], w[1]) - _mulw(q[1], w[2]) + _mulw(q[3], w[0])) / 2;
+    dq[3] = (_mulw(q[0], w[2]) + _mulw(q[1], w[1]) - _mulw(q[2], w[0])) / 2;
+
+    if (filter->algo == SENSOR_FUSION_MADGWICK) {
+        int64_t s[4];
+        int32_t n[4];
+        _madgwick_gradient(q, has_a ? a : NULL, has_m ? m : NULL, s);
+        if (_normalize(s, n, 4)) {
+            for (unsigned i = 0; i < 4; i++) {
+                dq[i] -= _mul64(n[i], filter->gain, 16);
+            }
+        }
+    }
+
+    int64_t qn[4];
+    for (unsigned i = 0; i < 4; i++) {
+        qn[i] = q[i] + ((dq[i] * dt) >> 24);
+    }
+    _normalize(qn, q, 4);
+}
+
+void sensor_fusion_quat(const sensor_fusion_t *filter, fix16_t q[4])
+{
+    for (unsigned i = 0; i < 4; i++) {
+        q[i] = filter->q[i] >> (Q - 16);
+    }
+}
+
+void sensor_fusion_euler(const sensor_fusion_t *filter,
+                         sensor_fusion_euler_t *euler)
+{
+    const int32_t *q = filter->q;
+    int32_t sinp = 2 * (_mul(q[0], q[2]) - _mul(q[3], q[1]));
+
+    if (sinp > ONE) {
+        sinp = ONE;
+    }
+    else if (sinp < -ONE) {
+        sinp = -ONE;
+    }
+    euler->roll = fix16_atan2(
+        (2 * (_mul(q[0], q[1]) + _mul(q[2], q[3]))) >> (Q - 16),
+        (ONE - 2 * (_mul(q[1], q[1]) + _mul(q[2], q[2]))) >> (Q - 16));
+    euler->pitch = fix16_asin(sinp >> (Q - 16));
+    euler->yaw = fix16_atan2(
+        (2 * (_mul(q[0], q[3]) + _mul(q[1], q[2]))) >> (Q - 16),
+        (ONE - 2 * (_mul(q[2], q[2]) + _mul(q[3], q[3]))) >> (Q - 16));
+}
+
+void sensor_fusion_calib_init(sensor_fusion_calib_t *calib)
+{
+    memset(calib, 0, sizeof(*calib));
+    for (unsigned i = 0; i < 3; i++) {
+        calib->mag_scale[i] = fix16_one;
+    }
+}
+
+void sensor_fusion_calib_gyro(sensor_fusion_calib_t *calib,
+                              const fix16_t (*gyro)[3], unsigned numof)
+{
+    for (unsigned i = 0; i < 3; i++) {
+        int64_t sum = 0;
+        for (unsigned j = 0; j < numof; j++) {
+            sum += gyro[j][i];
+        }
+        calib->gyro_bias[i] = numof ? sum / (int32_t)numof : 0;
+    }
+}
+
+void sensor_fusion_calib_mag(sensor_fusion_calib_t *calib,
+                             const fix16_t min[3], const fix16_t max[3])
+{
+    int64_t radius[3];
+    int64_t avg = 0;
+
+    for (unsigned i = 0; i < 3; i++) {
+        calib->mag_bias[i] = ((int64_t)min[i] + max[i]) / 2;
+        radius[i] = ((int64_t)max[i] - min[i]) / 2;
+        avg += radius[i];
+    }
+    avg /= 3;
+    /* scale all axes to the average radius */
+    for (unsigned i = 0; i < 3; i++) {
+        calib->mag_scale[i] = radius[i] ? (avg << 16) / radius[i] : fix16_one;
+    }
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_sensor_fusion
+ * @{
+ *
+ * @file
+ * @brief       Calibration storage in a key-value store
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <errno.h>
+
+#include "sensor_fusion.h"
+
+int sensor_fusion_calib_load(mtd_kv_t *kv, const char *key,
+                             sensor_fusion_calib_t *calib)
+{
+    sensor_fusion_calib_t tmp;
+    int res = mtd_kv_get(kv, key, &tmp, sizeof(tmp));
+
+    if (res < 0) {
+        return res;
+    }
+    /* keeps the calibration as is if the value is of another layout */
+    if (res != sizeof(tmp)) {
+        return -EINVAL;
+    }
+    *calib = tmp;
+    return 0;
+}
+
+int sensor_fusion_calib_save(mtd_kv_t *kv, const char *key,
+                             const sensor_fusion_calib_t *calib)
+{
+    return mtd_kv_set(kv, key, calib, sizeof(*calib));
+}
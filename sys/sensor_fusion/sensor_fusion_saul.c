@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_sensor_fusion
+ * @{
+ *
+ * @file
+ * @brief       Sensor fusion of SAUL devices
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <errno.h>
+
+#include "sensor_fusion.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+/* pi / 180 with 24 fractional bits */
+#define RAD_PER_DEG     (292812)
+
+typedef struct {
+    saul_batch_t batch;
+    int16_t val[CONFIG_SENSOR_FUSION_SAUL_BATCH][PHYDAT_DIM];
+    int n;
+} _batch_t;
+
+static int _read(saul_reg_t *dev, _batch_t *b)
+{
+    b->batch.val = b->val;
+    b->batch.numof = CONFIG_SENSOR_FUSION_SAUL_BATCH;
+    b->n = saul_reg_read_batch(dev, &b->batch);
+    return b->n;
+}
+
+/* converts a sample to Q16.16, saturating */
+static void _to_fix16(const _batch_t *b, unsigned i, fix16_t *out)
+{
+    for (unsigned j = 0; j < 3; j++) {
+        int32_t v = (int32_t)b->val[i][j] * fix16_one;
+        int8_t scale = b->batch.scale;
+
+        for (; scale < 0; scale++) {
+            v /= 10;
+        }
+        for (; scale > 0; scale--) {
+            if (v > fix16_maximum / 10) {
+                v = fix16_maximum;
+                break;
+            }
+            if (v < fix16_minimum / 10) {
+                v = fix16_minimum;
+                break;
+            }
+            v *= 10;
+        }
+        out[j] = v;
+    }
+}
+
+int sensor_fusion_saul_update(sensor_fusion_t *filter,
+                              sensor_fusion_saul_t *imu)
+{
+    _batch_t gyro, acc, mag;
+    int n = _read(imu->gyro, &gyro);
+
+    if (n > 0) {
+        n = _read(imu->acc, &acc);
+    }
+    if ((n > 0) && imu->mag) {
+        n = _read(imu->mag, &mag);
+    }
+    if (n <= 0) {
+        DEBUG("sensor_fusion: reading failed\n");
+        return n;
+    }
+    if (gyro.batch.unit != UNIT_DPS) {
+        return -EINVAL;
+    }
+
+    /* the newest samples of all devices are about simultaneous */
+    n = gyro.n;
+    if (acc.n < n) {
+        n = acc.n;
+    }
+    if (imu->mag && mag.n < n) {
+        n = mag.n;
+    }
+
+    for (int i = 0; i < n; i++) {
+        fix16_t g[3], a[3], m[3];
+        unsigned ig = gyro.n - n + i;
+        uint32_t t = gyro.batch.time - (gyro.n - 1 - ig) * gyro.batch.period_us;
+
+        _to_fix16(&gyro, ig, g);
+        for (unsigned j = 0; j < 3; j++) {
+            g[j] = ((int64_t)g[j] * RAD_PER_DEG) >> 24;
+        }
+        _to_fix16(&acc, acc.n - n + i, a);
+        if (imu->mag) {
+            _to_fix16(&mag, mag.n - n + i, m);
+        }
+        /* without a previous sample, only the references are fused */
+        sensor_fusion_update(filter, g, a, imu->mag ? m : NULL,
+                             imu->last ? t - imu->last : 0);
+        imu->last = t;
+    }
+    return n;
+}
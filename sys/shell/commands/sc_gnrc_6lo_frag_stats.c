@@ -30,6 +30,17 @@ int _gnrc_6lo_frag_stats(int argc, char **argv)
 #endif
     printf("frags complete: %u\n", stats->fragments);
     printf("dgs complete: %u\n", stats->datagrams);
+    printf("rbuf lookups: %u (%u entries probed)\n", stats->rbuf_lookups,
+           stats->rbuf_probes);
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    printf("RFRAGs sent: %u (%u retries)\n", stats->sfr_frags,
+           stats->sfr_retries);
+    printf("RFRAGs forwarded: %u\n", stats->sfr_forwarded);
+    printf("RFRAG ACKs sent: %u, received: %u\n", stats->sfr_acks_sent,
+           stats->sfr_acks_recv);
+    printf("ARQ timeouts: %u\n", stats->sfr_timeouts);
+    printf("SFR aborts: %u\n", stats->sfr_aborts);
+#endif
     return 0;
 }
 
@@ -0,0 +1,36 @@
+/*
+ * Copyright (C) 2020 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <stdio.h>
+#include "net/gnrc/icmpv6/error.h"
+
+int _gnrc_icmpv6_error_stats(int argc, char **argv)
+{
+    gnrc_icmpv6_error_stats_t *stats = gnrc_icmpv6_error_stats_get();
+
+    (void)argc;
+    (void)argv;
+    printf("errors sent: %u\n", (unsigned)stats->sent);
+    printf("suppressed destination unreachable: %u\n",
+           (unsigned)stats->suppressed[ICMPV6_DST_UNR - 1]);
+    printf("suppressed packet too big: %u\n",
+           (unsigned)stats->suppressed[ICMPV6_PKT_TOO_BIG - 1]);
+    printf("suppressed time exceeded: %u\n",
+           (unsigned)stats->suppressed[ICMPV6_TIME_EXC - 1]);
+    printf("suppressed parameter problem: %u\n",
+           (unsigned)stats->suppressed[ICMPV6_PARAM_PROB - 1]);
+    return 0;
+}
+
+/** @} */
@@ -13,10 +13,12 @@
  * @author  Martine Lenders <m.lenders@fu-berlin.de>
  */
 
+#include <inttypes.h>
 #include <stdio.h>
 #include <kernel_defines.h>
 
 #include "net/gnrc/ipv6/nib.h"
+#include "net/gnrc/ipv6/route_cache.h"
 #include "net/gnrc/netif.h"
 #include "net/ipv6/addr.h"
 
@@ -84,7 +86,11 @@ static void _usage_nib_prefix(char **argv)
 
 static void _usage_nib_route(char **argv)
 {
+#if IS_USED(MODULE_GNRC_IPV6_ROUTE_CACHE)
+    printf("usage: %s %s [show|add|del|cache|help]\n", argv[0], argv[1]);
+#else
     printf("usage: %s %s [show|add|del|help]\n", argv[0], argv[1]);
+#endif
     printf("       %s %s add <iface> <prefix>[/<prefix_len>] <next_hop> [<ltime in sec>]\n",
            argv[0], argv[1]);
     printf("       %s %s del <iface> <prefix>[/<prefix_len>]\n", argv[0], argv[1]);
@@ -288,6 +294,15 @@ static int _nib_route(int argc, char **argv)
         }
         gnrc_ipv6_nib_ft_del(&pfx, pfx_len);
     }
+#if IS_USED(MODULE_GNRC_IPV6_ROUTE_CACHE)
+    else if ((argc > 2) && (strcmp(argv[2], "cache") == 0)) {
+        const gnrc_ipv6_route_cache_stats_t *stats = gnrc_ipv6_route_cache_stats();
+
+        printf("route cache: %" PRIu32 " hits, %" PRIu32 " misses, "
+               "generation %" PRIu32 "\n", stats->hits, stats->misses,
+               stats->gen);
+    }
+#endif
     else {
         _usage_nib_route(argv);
         return 1;
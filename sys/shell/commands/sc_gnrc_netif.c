@@ -137,6 +137,29 @@ static int _netif_stats(netif_t *iface, unsigned module, bool reset)
                (unsigned) stats->tx_bytes,
                (unsigned) stats->tx_success,
                (unsigned) stats->tx_failed);
+#if IS_USED(MODULE_GNRC_NETIF_PKTQ)
+        if (module == NETSTATS_LAYER2) {
+            printf("            TX queued %u dropped %u\n",
+                   (unsigned) stats->tx_queued,
+                   (unsigned) stats->tx_dropped);
+        }
+#endif
+#if IS_USED(MODULE_L2FILTER)
+        if (module == NETSTATS_LAYER2) {
+            printf("            RX filtered %u\n",
+                   (unsigned) stats->rx_filtered);
+        }
+#endif
+#if IS_USED(MODULE_GNRC_GOMACH)
+        if (module == NETSTATS_LAYER2) {
+            printf("            slots allocated %u granted %u\n",
+                   (unsigned) stats->mac_slots_alloc,
+                   (unsigned) stats->mac_slots_granted);
+            printf("            busy channel %u idle listening %u\n",
+                   (unsigned) stats->mac_collisions,
+                   (unsigned) stats->mac_idle_listen);
+        }
+#endif
         res = 0;
     }
     return res;
@@ -20,7 +20,9 @@
 
 #include "cpu_conf.h"
 
-#if defined(MODULE_NEWLIB_SYSCALLS_DEFAULT) || defined (HAVE_HEAP_STATS)
+#if defined(MODULE_TLSF_MALLOC)
+#include "tlsf-malloc.h"
+#elif defined(MODULE_NEWLIB_SYSCALLS_DEFAULT) || defined (HAVE_HEAP_STATS)
 extern void heap_stats(void);
 #else
 #include <stdio.h>
@@ -31,7 +33,10 @@ int _heap_handler(int argc, char **argv)
     (void) argc;
     (void) argv;
 
-#if defined(MODULE_NEWLIB_SYSCALLS_DEFAULT) || defined (HAVE_HEAP_STATS)
+#if defined(MODULE_TLSF_MALLOC)
+    tlsf_arena_print_stats();
+    return 0;
+#elif defined(MODULE_NEWLIB_SYSCALLS_DEFAULT) || defined (HAVE_HEAP_STATS)
     heap_stats();
     return 0;
 #else
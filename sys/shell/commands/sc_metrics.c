@@ -0,0 +1,31 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell command printing all registered metrics
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include "metrics.h"
+
+int _metrics_handler(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+
+    metrics_print();
+
+    return 0;
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell command for the network benchmark
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "net/netperf.h"
+#include "net/sock/util.h"
+#include "timex.h"
+
+static void _usage(const char *cmd)
+{
+    printf("usage: %s udp_stream <[addr]:port> [<len> [<count> [<gap us>]]]\n"
+           "       %s udp_rr <[addr]:port> [<len> [<count> [<timeout us>]]]\n",
+           cmd, cmd);
+#ifdef MODULE_SOCK_TCP
+    printf("       %s tcp_stream <[addr]:port> [<len> [<count>]]\n", cmd);
+#endif
+    printf("       %s server [<port>]\n"
+           "       %s result\n", cmd, cmd);
+}
+
+static void _print(const char *name, const netperf_result_t *res)
+{
+    /* kbit/s = bits / ms */
+    uint32_t ms = res->time_us / US_PER_MS;
+    uint32_t kbit = ms ? (uint32_t)(((uint64_t)res->bytes * 8) / ms) : 0;
+    uint32_t pps = ms ? (uint32_t)(((uint64_t)res->packets * MS_PER_SEC) / ms)
+                      : 0;
+
+    printf("%s: %" PRIu32 " pkts %" PRIu32 " B %" PRIu32 " us %" PRIu32
+           " kbit/s %" PRIu32 " pkt/s lost %" PRIu32,
+           name, res->packets, res->bytes, res->time_us, kbit, pps,
+           res->lost);
+    if (res->cpu != NETPERF_CPU_UNKNOWN) {
+        printf(" cpu %u%%", res->cpu);
+    }
+    puts("");
+}
+
+static void _print_rtt(const netperf_result_t *res)
+{
+    printf("rtt: min %" PRIu32 " avg %" PRIu32 " max %" PRIu32 " us\n"
+           "rtt histogram (<1, <2, <4, ... ms):",
+           res->rtt_min_us, res->rtt_avg_us, res->rtt_max_us);
+    for (unsigned i = 0; i < CONFIG_NETPERF_RTT_BUCKETS; i++) {
+        printf(" %" PRIu32, res->rtt_hist[i]);
+    }
+    puts("");
+}
+
+int _netperf_handler(int argc, char **argv)
+{
+    netperf_params_t params = {
+        .len = 64,
+        .count = 1000,
+        .timeout_us = US_PER_SEC,
+    };
+    netperf_result_t res;
+    sock_udp_ep_t remote;
+    int err;
+
+    if ((argc > 1) && !strcmp(argv[1], "server")) {
+        uint16_t port = (argc > 2) ? (uint16_t)atoi(argv[2]) : NETPERF_PORT;
+
+        if ((err = netperf_server_start(port)) < 0) {
+            printf("error: cannot start server: %d\n", err);
+            return 1;
+        }
+        printf("netperf server on port %u\n", port);
+        return 0;
+    }
+    if ((argc > 1) && !strcmp(argv[1], "result")) {
+        netperf_server_result(&res);
+        _print("server", &res);
+        printf("jitter: %" PRIu32 " us\n", res.jitter_us);
+        return 0;
+    }
+    if (argc < 3) {
+        _usage(argv[0]);
+        return 1;
+    }
+    /* sock_tcp_ep_t and sock_udp_ep_t are both struct _sock_tl_ep */
+    if (sock_udp_str2ep(&remote, argv[2]) < 0) {
+        printf("error: malformed end point %s\n", argv[2]);
+        return 1;
+    }
+    if (argc > 3) {
+        params.len = atoi(argv[3]);
+    }
+    if (argc > 4) {
+        params.count = strtoul(argv[4], NULL, 10);
+    }
+    if (argc > 5) {
+        params.gap_us = strtoul(argv[5], NULL, 10);
+        params.timeout_us = params.gap_us;
+    }
+
+    if (!strcmp(argv[1], "udp_stream")) {
+        params.timeout_us = 0;
+        err = netperf_udp_stream(&remote, &params, &res);
+    }
+    else if (!strcmp(argv[1], "udp_rr")) {
+        params.gap_us = 0;
+        err = netperf_udp_rr(&remote, &params, &res);
+    }
+#ifdef MODULE_SOCK_TCP
+    else if (!strcmp(argv[1], "tcp_stream")) {
+        err = netperf_tcp_stream(&remote, &params, &res);
+    }
+#endif
+    else {
+        _usage(argv[0]);
+        return 1;
+    }
+
+    if (err < 0) {
+        printf("error: %s failed: %d\n", argv[1], err);
+        return 1;
+    }
+    _print(argv[1], &res);
+    if (!strcmp(argv[1], "udp_rr")) {
+        _print_rtt(&res);
+    }
+    return 0;
+}
@@ -20,6 +20,7 @@
  * @}
  */
 
+#include <inttypes.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -38,6 +39,9 @@ static void _print_usage(void) {
     puts("\tpm block <mode>: manually block power mode");
     puts("\tpm unblock <mode>: manually unblock power mode");
 #endif /* MODULE_PM_LAYERED */
+#ifdef MODULE_PM_LAYERED_STATS
+    puts("\tpm stats: display time spent in each power mode");
+#endif /* MODULE_PM_LAYERED_STATS */
     puts("\tpm off: call pm_off()");
 }
 
@@ -138,6 +142,22 @@ static int cmd_show(char *arg)
 }
 #endif /* MODULE_PM_LAYERED */
 
+#ifdef MODULE_PM_LAYERED_STATS
+static int cmd_stats(char *arg)
+{
+    (void)arg;
+    pm_layered_stats_t stats;
+
+    pm_layered_get_stats(&stats);
+    for (unsigned i = 0; i <= PM_NUM_MODES; i++) {
+        printf("mode %u%s: %" PRIu32 " times, %" PRIu32 " ms\n", i,
+               (i == PM_NUM_MODES) ? " (idle)" : "",
+               stats.count[i], stats.time_ms[i]);
+    }
+    return 0;
+}
+#endif /* MODULE_PM_LAYERED_STATS */
+
 static int cmd_off(char *arg)
 {
     (void)arg;
@@ -189,6 +209,12 @@ int _pm_handler(int argc, char **argv)
     }
 #endif /* MODULE_PM_LAYERED */
 
+#ifdef MODULE_PM_LAYERED_STATS
+    if (!strcmp(argv[1], "stats")) {
+        return cmd_stats(argv[1]);
+    }
+#endif /* MODULE_PM_LAYERED_STATS */
+
     if (!strcmp(argv[1], "off")) {
         return cmd_off(NULL);
     }
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2020 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell command printing the extended scheduler statistics
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "irq.h"
+#include "sched.h"
+#include "schedstatistics.h"
+#include "thread.h"
+#include "xtimer.h"
+#if IS_USED(MODULE_SCHEDSTATISTICS_IRQ)
+#include "periph_conf.h"
+#endif
+
+static uint32_t _usec(uint32_t ticks)
+{
+    xtimer_ticks32_t t = { .ticks32 = ticks };
+
+    return xtimer_usec_from_ticks(t);
+}
+
+#if IS_USED(MODULE_SCHEDSTATISTICS_IRQ) && defined(CLOCK_CORECLOCK)
+static uint32_t _cycles_usec(uint32_t cycles)
+{
+    return cycles / (CLOCK_CORECLOCK / US_PER_SEC);
+}
+#endif
+
+static void _print_thread(kernel_pid_t pid, const schedstat_ext_t *ext)
+{
+#ifdef DEVELHELP
+    const char *name = thread_getname(pid);
+#else
+    const char *name = "";
+#endif
+
+    printf("%3" PRIkernel_pid " %-16s latency max %8" PRIu32 " us"
+           " | slice max %8" PRIu32 " us"
+           " | mutex %10" PRIu32 " us | msg %10" PRIu32 " us\n",
+           pid, name ? name : "", _usec(ext->latency_max),
+           _usec(ext->slice_max), _usec(ext->mutex_blocked),
+           _usec(ext->msg_blocked));
+#if IS_USED(MODULE_SCHEDSTATISTICS_IRQ) && defined(CLOCK_CORECLOCK)
+    printf("    irq off %10" PRIu32 " us, max %8" PRIu32 " us\n",
+           _cycles_usec(ext->irq_off), _cycles_usec(ext->irq_off_max));
+#endif
+    printf("    latency");
+    for (unsigned i = 0; i < CONFIG_SCHEDSTAT_LATENCY_BUCKETS; i++) {
+        printf(" %" PRIu32, ext->latency[i]);
+    }
+    puts("");
+}
+
+int _schedstat_handler(int argc, char **argv)
+{
+    if ((argc > 1) && !strcmp(argv[1], "reset")) {
+        schedstat_ext_reset();
+        return 0;
+    }
+    if (argc > 1) {
+        printf("usage: %s [reset]\n", argv[0]);
+        return 1;
+    }
+
+    printf("latency histogram buckets start at 0");
+    for (unsigned i = 1; i < CONFIG_SCHEDSTAT_LATENCY_BUCKETS; i++) {
+        printf(", %" PRIu32, _usec(1UL << (2 * i)));
+    }
+    puts(" us");
+
+    for (kernel_pid_t i = KERNEL_PID_FIRST; i <= KERNEL_PID_LAST; i++) {
+        if (sched_threads[i] == NULL) {
+            continue;
+        }
+
+        schedstat_ext_t ext;
+        unsigned state = irq_disable();
+        ext = sched_pidlist_ext[i];
+        irq_restore(state);
+        _print_thread(i, &ext);
+    }
+    return 0;
+}
@@ -38,6 +38,10 @@ extern int _sc_dfplayer(int argc, char **argv);
 extern int _heap_handler(int argc, char **argv);
 #endif
 
+#ifdef MODULE_METRICS
+extern int _metrics_handler(int argc, char **argv);
+#endif
+
 #ifdef MODULE_PERIPH_PM
 extern int _pm_handler(int argc, char **argv);
 #endif
@@ -46,6 +50,10 @@ extern int _pm_handler(int argc, char **argv);
 extern int _ps_handler(int argc, char **argv);
 #endif
 
+#ifdef MODULE_SCHEDSTATISTICS_EXT
+extern int _schedstat_handler(int argc, char **argv);
+#endif
+
 #ifdef MODULE_SHT1X
 extern int _get_temperature_handler(int argc, char **argv);
 extern int _get_humidity_handler(int argc, char **argv);
@@ -103,6 +111,10 @@ extern int _gnrc_netif_send(int argc, char **argv);
 extern int _fib_route_handler(int argc, char **argv);
 #endif
 
+#ifdef MODULE_GNRC_ICMPV6_ERROR_RATE_LIMIT
+extern int _gnrc_icmpv6_error_stats(int argc, char **argv);
+#endif
+
 #ifdef MODULE_GNRC_IPV6_EXT_FRAG_STATS
 extern int _gnrc_ipv6_frag_stats(int argc, char **argv);
 #endif
@@ -142,6 +154,10 @@ extern int _ccnl_fib(int argc, char **argv);
 extern int _ntpdate(int argc, char **argv);
 #endif
 
+#ifdef MODULE_NETPERF
+extern int _netperf_handler(int argc, char **argv);
+#endif
+
 #ifdef MODULE_VFS
 extern int _vfs_handler(int argc, char **argv);
 extern int _ls_handler(int argc, char **argv);
@@ -195,12 +211,19 @@ const shell_command_t _shell_command_list[] = {
 #ifdef MODULE_HEAP_CMD
     {"heap", "Prints heap statistics.", _heap_handler},
 #endif
+#ifdef MODULE_METRICS
+    {"metrics", "Prints all registered metrics.", _metrics_handler},
+#endif
 #ifdef MODULE_PERIPH_PM
     { "pm", "interact with layered PM subsystem", _pm_handler },
 #endif
 #ifdef MODULE_PS
     {"ps", "Prints information about running threads.", _ps_handler},
 #endif
+#ifdef MODULE_SCHEDSTATISTICS_EXT
+    {"schedstat", "Prints latency and blocking statistics of all threads",
+     _schedstat_handler},
+#endif
 #ifdef MODULE_SHT1X
     {"temp", "Prints measured temperature.", _get_temperature_handler},
     {"hum", "Prints measured humidity.", _get_humidity_handler},
@@ -245,6 +268,10 @@ const shell_command_t _shell_command_list[] = {
 #ifdef MODULE_FIB
     {"fibroute", "Manipulate the FIB (info: 'fibroute [add|del]')", _fib_route_handler},
 #endif
+#ifdef MODULE_GNRC_ICMPV6_ERROR_RATE_LIMIT
+    {"icmp6_err", "ICMPv6 error rate limit statistics",
+     _gnrc_icmpv6_error_stats },
+#endif
 #ifdef MODULE_GNRC_IPV6_EXT_FRAG_STATS
     {"ip6_frag", "IPv6 fragmentation statistics", _gnrc_ipv6_frag_stats },
 #endif
@@ -278,6 +305,9 @@ const shell_command_t _shell_command_list[] = {
 #ifdef MODULE_SNTP
     { "ntpdate", "synchronizes with a remote time server", _ntpdate },
 #endif
+#ifdef MODULE_NETPERF
+    { "netperf", "measures network throughput and latency", _netperf_handler },
+#endif
 #ifdef MODULE_VFS
     {"vfs", "virtual file system operations", _vfs_handler},
     {"ls", "list files", _ls_handler},
@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_rpc
+ * @{
+ *
+ * @file
+ * @brief       Binary shell RPC framing and dispatching
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "checksum/crc16_ccitt.h"
+#include "shell_rpc.h"
+
+#define FRAME_HDR       (3U)    /* start byte and length */
+#define FRAME_CRC       (2U)
+/* maximum size of the response array header, id and status */
+#define RES_PREFIX      (11U)
+#define RES_MAX         (SHELL_RPC_BUFSIZE - RES_PREFIX)
+
+extern const shell_rpc_command_t _shell_rpc_command_list[];
+
+static const shell_rpc_command_t *_app_cmds;
+static uint8_t _req[FRAME_HDR + SHELL_RPC_BUFSIZE];
+static uint8_t _res[FRAME_HDR + SHELL_RPC_BUFSIZE + FRAME_CRC];
+
+void shell_rpc_set_commands(const shell_rpc_command_t *commands)
+{
+    _app_cmds = commands;
+}
+
+static unsigned _count(const shell_rpc_command_t *entry)
+{
+    unsigned n = 0;
+
+    for (; entry && entry->name; entry++) {
+        n++;
+    }
+    return n;
+}
+
+static void _put_names(nanocbor_encoder_t *res,
+                       const shell_rpc_command_t *entry)
+{
+    for (; entry && entry->name; entry++) {
+        nanocbor_put_tstr(res, entry->name);
+    }
+}
+
+static int _help(nanocbor_value_t *args, nanocbor_encoder_t *res)
+{
+    (void)args;
+
+    nanocbor_fmt_array(res, _count(_app_cmds) +
+                            _count(_shell_rpc_command_list) + 1);
+    _put_names(res, _app_cmds);
+    _put_names(res, _shell_rpc_command_list);
+    nanocbor_put_tstr(res, "help");
+    return 0;
+}
+
+static shell_rpc_handler_t _search(const shell_rpc_command_t *entry,
+                                   const uint8_t *name, size_t len)
+{
+    for (; entry && entry->name; entry++) {
+        if ((strlen(entry->name) == len) &&
+            (memcmp(entry->name, name, len) == 0)) {
+            return entry->handler;
+        }
+    }
+    return NULL;
+}
+
+static shell_rpc_handler_t _find(const uint8_t *name, size_t len)
+{
+    shell_rpc_handler_t handler = _search(_app_cmds, name, len);
+
+    if (handler == NULL) {
+        handler = _search(_shell_rpc_command_list, name, len);
+    }
+    if ((handler == NULL) && (len == 4) && (memcmp(name, "help", 4) == 0)) {
+        handler = _help;
+    }
+    return handler;
+}
+
+static int _read(uint8_t *buf, size_t len, bool store)
+{
+    for (size_t i = 0; i < len; i++) {
+        int c = getchar();
+
+        if (c == EOF) {
+            return EOF;
+        }
+        if (store) {
+            buf[i] = c;
+        }
+    }
+    return 0;
+}
+
+/* sends the response, the result_len bytes of the result have been encoded
+ * behind the space reserved for the prefix */
+static void _send(const uint32_t *id, int status, size_t result_len)
+{
+    uint8_t *data = &_res[FRAME_HDR];
+    uint8_t prefix[RES_PREFIX + 1];
+    nanocbor_encoder_t enc;
+
+    nanocbor_encoder_init(&enc, prefix, sizeof(prefix));
+    nanocbor_fmt_array(&enc, 3);
+    if (id) {
+        nanocbor_fmt_uint(&enc, *id);
+    }
+    else {
+        nanocbor_fmt_null(&enc);
+    }
+    nanocbor_fmt_int(&enc, status);
+    if (status != 0) {
+        nanocbor_fmt_null(&enc);
+        result_len = 0;
+    }
+
+    size_t prefix_len = nanocbor_encoded_len(&enc);
+    size_t len = prefix_len + result_len;
+
+    memmove(data + prefix_len, data + RES_PREFIX, result_len);
+    memcpy(data, prefix, prefix_len);
+
+    _res[0] = SHELL_RPC_FRAME_START;
+    _res[1] = len >> 8;
+    _res[2] = len & 0xff;
+    uint16_t crc = crc16_ccitt_calc(&_res[1], len + 2);
+    data[len] = crc >> 8;
+    data[len + 1] = crc & 0xff;
+
+    /* keep the order with text printed before */
+    fflush(stdout);
+    fwrite(_res, 1, FRAME_HDR + len + FRAME_CRC, stdout);
+    fflush(stdout);
+}
+
+int shell_rpc_handle(void)
+{
+    uint8_t *data = &_req[FRAME_HDR];
+    uint8_t crc[FRAME_CRC];
+
+    if (_read(&_req[1], 2, true) == EOF) {
+        return EOF;
+    }
+
+    size_t len = (_req[1] << 8) | _req[2];
+    bool fits = (len <= SHELL_RPC_BUFSIZE);
+
+    /* always consume the whole frame to stay in sync */
+    if ((_read(data, len, fits) == EOF) || (_read(crc, sizeof(crc), true) == EOF)) {
+        return EOF;
+    }
+
+    nanocbor_value_t req, arr;
+    const uint8_t *name;
+    size_t name_len;
+    uint32_t id;
+
+    nanocbor_decoder_init(&req, data, fits ? len : 0);
+    if (!fits ||
+        (crc16_ccitt_calc(&_req[1], len + 2) != ((crc[0] << 8) | crc[1])) ||
+        (nanocbor_enter_array(&req, &arr) < 0) ||
+        (nanocbor_get_uint32(&arr, &id) < 0)) {
+        _send(NULL, -EBADMSG, 0);
+        return 0;
+    }
+    if (nanocbor_get_tstr(&arr, &name, &name_len) < 0) {
+        _send(&id, -EBADMSG, 0);
+        return 0;
+    }
+
+    shell_rpc_handler_t handler = _find(name, name_len);
+
+    if (handler == NULL) {
+        _send(&id, -ENOENT, 0);
+        return 0;
+    }
+
+    nanocbor_encoder_t enc;
+
+    nanocbor_encoder_init(&enc, &_res[FRAME_HDR + RES_PREFIX], RES_MAX);
+    int res = handler(&arr, &enc);
+    if ((res == 0) && (nanocbor_encoded_len(&enc) > RES_MAX)) {
+        res = -ENOBUFS;
+    }
+    _send(&id, res, nanocbor_encoded_len(&enc));
+
+    return 0;
+}
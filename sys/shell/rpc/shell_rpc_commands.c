@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_rpc
+ * @{
+ *
+ * @file
+ * @brief       Built-in binary shell RPC commands
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdint.h>
+
+#include "sched.h"
+#include "shell_rpc.h"
+#include "thread.h"
+
+#ifdef MODULE_GNRC_IPV6_NIB
+#include "net/gnrc/ipv6/nib.h"
+#endif
+#ifdef MODULE_METRICS_CBOR
+#include "metrics.h"
+#endif
+
+static int _threads(nanocbor_value_t *args, nanocbor_encoder_t *res)
+{
+    unsigned num = 0;
+
+    (void)args;
+
+    for (kernel_pid_t i = KERNEL_PID_FIRST; i <= KERNEL_PID_LAST; i++) {
+        if (thread_get(i)) {
+            num++;
+        }
+    }
+
+    nanocbor_fmt_array(res, num);
+    for (kernel_pid_t i = KERNEL_PID_FIRST; (i <= KERNEL_PID_LAST) && num; i++) {
+        volatile thread_t *t = thread_get(i);
+
+        if (t == NULL) {
+            continue;
+        }
+        num--;
+        nanocbor_fmt_array(res, 6);
+        nanocbor_fmt_uint(res, i);
+#ifdef DEVELHELP
+        nanocbor_put_tstr(res, t->name ? t->name : "");
+#else
+        nanocbor_fmt_null(res);
+#endif
+        nanocbor_fmt_uint(res, t->status);
+        nanocbor_fmt_uint(res, t->priority);
+#ifdef DEVELHELP
+        nanocbor_fmt_uint(res, t->stack_size);
+        nanocbor_fmt_uint(res, thread_measure_stack_free(t->stack_start));
+#else
+        nanocbor_fmt_null(res);
+        nanocbor_fmt_null(res);
+#endif
+    }
+    /* a thread exited in between, keep the array well formed */
+    while (num--) {
+        nanocbor_fmt_null(res);
+    }
+    return 0;
+}
+
+#ifdef MODULE_GNRC_IPV6_NIB
+static int _nib_nc(nanocbor_value_t *args, nanocbor_encoder_t *res)
+{
+    gnrc_ipv6_nib_nc_t nce;
+    uint32_t iface = 0;
+    unsigned num = 0;
+    void *state = NULL;
+
+    if (!nanocbor_at_end(args) && (nanocbor_get_null(args) < 0) &&
+        (nanocbor_get_uint32(args, &iface) < 0)) {
+        return -EINVAL;
+    }
+
+    while (gnrc_ipv6_nib_nc_iter(iface, &state, &nce)) {
+        num++;
+    }
+
+    nanocbor_fmt_array(res, num);
+    state = NULL;
+    while (num && gnrc_ipv6_nib_nc_iter(iface, &state, &nce)) {
+        num--;
+        nanocbor_fmt_array(res, 3);
+        nanocbor_put_bstr(res, nce.ipv6.u8, sizeof(nce.ipv6));
+        nanocbor_put_bstr(res, nce.l2addr, nce.l2addr_len);
+        nanocbor_fmt_uint(res, nce.info);
+    }
+    /* an entry was removed in between, keep the array well formed */
+    while (num--) {
+        nanocbor_fmt_null(res);
+    }
+    return 0;
+}
+#endif
+
+#ifdef MODULE_METRICS_CBOR
+static int _metrics(nanocbor_value_t *args, nanocbor_encoder_t *res)
+{
+    (void)args;
+
+    metrics_cbor(res);
+    return 0;
+}
+#endif
+
+const shell_rpc_command_t _shell_rpc_command_list[] = {
+    { "threads", _threads },
+#ifdef MODULE_GNRC_IPV6_NIB
+    { "nib_nc", _nib_nc },
+#endif
+#ifdef MODULE_METRICS_CBOR
+    { "metrics", _metrics },
+#endif
+    { NULL, NULL }
+};
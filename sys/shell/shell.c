@@ -37,6 +37,9 @@
 
 #include "shell.h"
 #include "shell_commands.h"
+#if IS_USED(MODULE_SHELL_RPC)
+#include "shell_rpc.h"
+#endif
 
 #define ETX '\x03'  /** ASCII "End-of-Text", or ctrl-C */
 #define BS  '\x08'  /** ASCII "Backspace" */
@@ -74,6 +77,9 @@
 
 #define PARSE_ESCAPE_MASK 0x4;
 
+/* readline() read the start of a binary RPC frame */
+#define READLINE_RPC_FRAME  (-EPROTO)
+
 enum parse_state {
     PARSE_BLANK             = 0x0,
 
@@ -368,6 +374,7 @@ static inline void new_line(void)
  *          successful.
  * @return  EOF, if the end of the input stream was reached.
  * @return  -ENOBUFS if the buffer size was exceeded.
+ * @return  READLINE_RPC_FRAME if a line started with a binary RPC frame
  */
 static int readline(char *buf, size_t size)
 {
@@ -414,6 +421,13 @@ static int readline(char *buf, size_t size)
                 }
                 break;
 
+#if IS_USED(MODULE_SHELL_RPC)
+            case SHELL_RPC_FRAME_START:
+                if (curr_pos == 0) {
+                    return READLINE_RPC_FRAME;
+                }
+                /* fall-thru */
+#endif
             default:
                 /* Always consume characters, but do not not always store them */
                 if ((size_t) curr_pos < size - 1) {
@@ -447,6 +461,15 @@ void shell_run_once(const shell_command_t *shell_commands,
                 puts("shell: maximum line length exceeded");
                 break;
 
+#if IS_USED(MODULE_SHELL_RPC)
+            case READLINE_RPC_FRAME:
+                if (shell_rpc_handle() == EOF) {
+                    return;
+                }
+                /* no prompt, the host waits for the response frame only */
+                continue;
+#endif
+
             default:
                 handle_input_line(shell_commands, line_buf);
                 break;
@@ -27,13 +27,17 @@
  * @}
  */
 
+#include <assert.h>
 #include <errno.h>
+#include <stdbool.h>
 
 #include "stdio_uart.h"
 
 #include "board.h"
+#include "irq.h"
 #include "periph/uart.h"
 #include "isrpipe.h"
+#include "mutex.h"
 
 #ifdef MODULE_STDIO_ETHOS
 #include "ethos.h"
@@ -52,13 +56,131 @@ static uint8_t _rx_buf_mem[STDIO_UART_RX_BUFSIZE];
 isrpipe_t stdio_uart_isrpipe = ISRPIPE_INIT(_rx_buf_mem);
 #endif
 
+#if defined(MODULE_STDIO_UART_RX) && defined(MODULE_PERIPH_UART_DMA) && \
+    !defined(MODULE_STDIO_ETHOS)
+#define STDIO_UART_USE_RX_DMA
+static uint8_t _rx_dma_buf[STDIO_UART_RX_DMA_BUFSIZE];
+#endif
+
+#if defined(MODULE_STDIO_UART_TX_ASYNC) && defined(MODULE_PERIPH_UART_DMA) && \
+    !defined(MODULE_STDIO_ETHOS)
+#define STDIO_UART_USE_TX_DMA
+#define TX_MASK     (STDIO_UART_TX_BUFSIZE - 1)
+static uint8_t _tx_buf[STDIO_UART_TX_BUFSIZE];
+static unsigned _tx_head;       /* bytes put into _tx_buf in total */
+static unsigned _tx_tail;       /* bytes sent in total */
+static unsigned _tx_busy;       /* bytes currently sent by the DMA, 0: idle */
+static bool _tx_no_dma;         /* the UART has no TX DMA, use uart_write() */
+static mutex_t _tx_lock = MUTEX_INIT;
+static mutex_t _tx_room = MUTEX_INIT_LOCKED;
+
+/* the free running indices rely on this */
+static_assert((STDIO_UART_TX_BUFSIZE & TX_MASK) == 0,
+              "STDIO_UART_TX_BUFSIZE must be a power of two");
+
+/* selects the next contiguous chunk to send, must be called with IRQs
+ * disabled or from the DMA callback */
+static unsigned _tx_next(void)
+{
+    unsigned pending = _tx_head - _tx_tail;
+    unsigned contiguous = STDIO_UART_TX_BUFSIZE - (_tx_tail & TX_MASK);
+
+    _tx_busy = (pending < contiguous) ? pending : contiguous;
+    return _tx_busy;
+}
+
+static void _tx_done(void *arg)
+{
+    (void)arg;
+
+    _tx_tail += _tx_busy;
+    if (_tx_next()) {
+        uart_write_async(STDIO_UART_DEV, &_tx_buf[_tx_tail & TX_MASK],
+                         _tx_busy, _tx_done, NULL);
+    }
+    /* wake up a writer waiting for room */
+    mutex_unlock(&_tx_room);
+}
+
+/* copies as much as fits into the buffer and starts the DMA if idle */
+static size_t _tx_put(const uint8_t *data, size_t len)
+{
+    unsigned state = irq_disable();
+    size_t room = STDIO_UART_TX_BUFSIZE - (_tx_head - _tx_tail);
+    size_t n = (len < room) ? len : room;
+
+    for (size_t i = 0; i < n; i++) {
+        _tx_buf[(_tx_head + i) & TX_MASK] = data[i];
+    }
+    _tx_head += n;
+    bool start = !_tx_busy && _tx_next();
+    irq_restore(state);
+
+    if (start && (uart_write_async(STDIO_UART_DEV, &_tx_buf[_tx_tail & TX_MASK],
+                                   _tx_busy, _tx_done, NULL) != UART_OK)) {
+        /* no TX DMA, this only happens on the very first write, so the
+         * buffer holds nothing but this chunk */
+        _tx_no_dma = true;
+        _tx_busy = 0;
+        _tx_tail = _tx_head;
+        uart_write(STDIO_UART_DEV, data, n);
+    }
+    return n;
+}
+
+static void _tx_write(const uint8_t *data, size_t len)
+{
+    if (irq_is_in() || _tx_no_dma) {
+        uart_write(STDIO_UART_DEV, data, len);
+        return;
+    }
+
+    mutex_lock(&_tx_lock);
+    while (len) {
+        size_t n = _tx_put(data, len);
+        data += n;
+        len -= n;
+        if (!len || CONFIG_STDIO_UART_TX_DROP) {
+            break;
+        }
+        if (_tx_no_dma) {
+            uart_write(STDIO_UART_DEV, data, len);
+            break;
+        }
+        /* buffer full, wait until the DMA made some room */
+        mutex_lock(&_tx_room);
+    }
+    mutex_unlock(&_tx_lock);
+}
+#endif
+
+#if defined(MODULE_STDIO_UART_RX) && defined(MODULE_POSIX_POLL)
+/* wake up poll() waiting for stdin */
+static void _rx_cb(void *arg, uint8_t data)
+{
+    isrpipe_write_one(arg, data);
+    vfs_poll_notify();
+}
+
+static void _rx_chunk_cb(void *arg, const uint8_t *data, size_t len)
+{
+    isrpipe_write(arg, data, len);
+    vfs_poll_notify();
+}
+#define RX_CB       _rx_cb
+#define RX_CHUNK_CB _rx_chunk_cb
+#else
+#define RX_CB       ((uart_rx_cb_t) isrpipe_write_one)
+#define RX_CHUNK_CB ((uart_rx_chunk_cb_t) isrpipe_write)
+#endif
+
 void stdio_init(void)
 {
     uart_rx_cb_t cb;
     void *arg;
 
 #ifdef MODULE_STDIO_UART_RX
-    cb = (uart_rx_cb_t) isrpipe_write_one;
+    cb = RX_CB;
     arg = &stdio_uart_isrpipe;
 #else
     cb = NULL;
@@ -67,6 +189,13 @@ void stdio_init(void)
 
 #ifdef MODULE_STDIO_ETHOS
     uart_init(ETHOS_UART, ETHOS_BAUDRATE, cb, arg);
+#elif defined(STDIO_UART_USE_RX_DMA)
+    /* prefer chunked DMA reception, fall back to per byte interrupts */
+    uart_init(STDIO_UART_DEV, STDIO_UART_BAUDRATE, NULL, NULL);
+    if (uart_rx_dma_start(STDIO_UART_DEV, _rx_dma_buf, sizeof(_rx_dma_buf),
+                          RX_CHUNK_CB, &stdio_uart_isrpipe) != UART_OK) {
+        uart_init(STDIO_UART_DEV, STDIO_UART_BAUDRATE, cb, arg);
+    }
 #else
     uart_init(STDIO_UART_DEV, STDIO_UART_BAUDRATE, cb, arg);
 #endif
@@ -87,10 +216,19 @@ ssize_t stdio_read(void* buffer, size_t count)
 #endif
 }
 
+#ifdef MODULE_STDIO_UART_RX
+int stdio_available(void)
+{
+    return tsrb_avail(&stdio_uart_isrpipe.tsrb);
+}
+#endif
+
 ssize_t stdio_write(const void* buffer, size_t len)
 {
 #ifdef MODULE_STDIO_ETHOS
     ethos_send_frame(&ethos, (const uint8_t *)buffer, len, ETHOS_FRAME_TYPE_TEXT);
+#elif defined(STDIO_UART_USE_TX_DMA)
+    _tx_write((const uint8_t *)buffer, len);
 #else
     uart_write(STDIO_UART_DEV, (const uint8_t *)buffer, len);
 #endif
@@ -198,6 +198,31 @@ static int _param_get_img_size(suit_manifest_t *manifest,
     return res;
 }
 
+static int _param_get_compression(suit_manifest_t *manifest,
+                                  nanocbor_value_t *it)
+{
+    int32_t algorithm;
+
+    if (nanocbor_get_int32(it, &algorithm) < 0) {
+        LOG_DEBUG("error getting compression info\n");
+        return SUIT_ERR_INVALID_MANIFEST;
+    }
+
+    switch (algorithm) {
+        case SUIT_COMPRESSION_NONE:
+#ifdef MODULE_RIOTBOOT_FLASHWRITE_HEATSHRINK
+        case SUIT_COMPRESSION_HEATSHRINK:
+#endif
+            break;
+        default:
+            LOG_INFO("Unsupported compression %" PRIi32 "\n", algorithm);
+            return SUIT_ERR_UNSUPPORTED;
+    }
+
+    manifest->components[manifest->component_current].compression = algorithm;
+    return SUIT_OK;
+}
+
 static int _dtv_set_param(suit_manifest_t *manifest, int key,
                           nanocbor_value_t *it)
 {
@@ -219,6 +244,9 @@ static int _dtv_set_param(suit_manifest_t *manifest, int key,
             case 6: /* SUIT URI LIST */
                 res = _param_get_uri_list(manifest, &map);
                 break;
+            case 8: /* SUIT COMPRESSION INFO */
+                res = _param_get_compression(manifest, &map);
+                break;
             case 11: /* SUIT DIGEST */
                 res = _param_get_digest(manifest, &map);
                 break;
@@ -267,7 +295,8 @@ static int _dtv_fetch(suit_manifest_t *manifest, int key,
     if (0) {}
 #ifdef MODULE_SUIT_TRANSPORT_COAP
     else if (strncmp(manifest->urlbuf, "coap://", 7) == 0) {
-        res = suit_coap_get_blockwise_url(manifest->urlbuf, COAP_BLOCKSIZE_64,
+        res = suit_coap_get_blockwise_url(manifest->urlbuf,
+                                          CONFIG_SUIT_COAP_BLOCKSIZE,
                                           suit_flashwrite_helper,
                                           manifest);
     }
@@ -23,6 +23,7 @@
 
 #include <cose/sign.h>
 #include <nanocbor/nanocbor.h>
+#include <string.h>
 
 #include "hashes/sha256.h"
 #include "kernel_defines.h"
@@ -102,38 +103,56 @@ static int _auth_handler(suit_manifest_t *manifest, int key,
     return 0;
 }
 
-static int _manifest_handler(suit_manifest_t *manifest, int key,
-                             nanocbor_value_t *it)
+int suit_verify_manifest_digest(suit_manifest_t *manifest,
+                                const uint8_t *digest)
 {
-    (void)key;
-    const uint8_t *manifest_buf;
-    size_t manifest_len;
-
     if (!(manifest->state & SUIT_STATE_COSE_AUTHENTICATED)) {
         return SUIT_ERR_SIGNATURE;
     }
 
-    nanocbor_value_t cbor_buf = *it;
-
-    nanocbor_get_subcbor(&cbor_buf, &manifest_buf, &manifest_len);
-
     uint8_t digest_struct[4 + SHA256_DIGEST_LENGTH] =
         /* CBOR array of length 2, sha256 digest and a bytestring of SHA256
          * length
          */
     { 0x82, 0x02, 0x58, SHA256_DIGEST_LENGTH };
-    sha256(manifest_buf, manifest_len, digest_struct + 4);
+    memcpy(digest_struct + 4, digest, SHA256_DIGEST_LENGTH);
 
     /* The COSE payload and the sha256 of the manifest itself is public info and
      * verification does not depend on secret info. No need for cryptographic
      * memcmp here */
-    if (memcmp(digest_struct, manifest->cose_payload,
+    if ((manifest->cose_payload_len < sizeof(digest_struct)) ||
+        memcmp(digest_struct, manifest->cose_payload,
                sizeof(digest_struct)) != 0) {
         LOG_ERROR("SUIT manifest digest and COSE digest mismatch\n");
         return SUIT_ERR_DIGEST_MISMATCH;
     }
 
     manifest->state |= SUIT_STATE_FULLY_AUTHENTICATED;
+    return SUIT_OK;
+}
+
+static int _manifest_handler(suit_manifest_t *manifest, int key,
+                             nanocbor_value_t *it)
+{
+    (void)key;
+    const uint8_t *manifest_buf;
+    size_t manifest_len;
+
+    if (!(manifest->state & SUIT_STATE_COSE_AUTHENTICATED)) {
+        return SUIT_ERR_SIGNATURE;
+    }
+
+    nanocbor_value_t cbor_buf = *it;
+
+    nanocbor_get_subcbor(&cbor_buf, &manifest_buf, &manifest_len);
+
+    uint8_t digest[SHA256_DIGEST_LENGTH];
+    sha256(manifest_buf, manifest_len, digest);
+
+    int res = suit_verify_manifest_digest(manifest, digest);
+    if (res) {
+        return res;
+    }
 
     LOG_DEBUG("Starting global sequence handler\n");
     return suit_handle_manifest_structure_bstr(manifest, it,
@@ -0,0 +1,355 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+/**
+ * @ingroup     sys_suit
+ * @{
+ *
+ * @file
+ * @brief       Streaming parser for SUIT manifests
+ *
+ * The outer wrapper and the top level of the manifest are walked CBOR head by
+ * CBOR head as the data arrives. Everything below the top level is only
+ * looked at by the regular handlers once the manifest is authenticated.
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <nanocbor/nanocbor.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "hashes/sha256.h"
+#include "log.h"
+#include "suit/handlers.h"
+#include "suit.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+enum {
+    _OUTER_MAP,
+    _AUTH_KEY,
+    _AUTH_HEAD,
+    _AUTH_BODY,
+    _MANIFEST_KEY,
+    _MANIFEST_HEAD,
+    /* all states from here on consume manifest bytes */
+    _MAP_HEAD,
+    _ENTRY_KEY,
+    _ENTRY_HEAD,
+    _ENTRY_BODY,
+    _DONE,
+};
+
+enum {
+    _MAJOR_UINT     = 0,
+    _MAJOR_NINT     = 1,
+    _MAJOR_BSTR     = 2,
+    _MAJOR_TSTR     = 3,
+    _MAJOR_MAP      = 5,
+    _MAJOR_FLOAT    = 7,
+};
+
+/* total length of a CBOR head from its initial byte, 64 bit arguments and
+ * indefinite lengths are not used by manifests */
+static int _head_len(uint8_t initial)
+{
+    uint8_t info = initial & 0x1f;
+
+    if (info < 24) {
+        return 1;
+    }
+    if (info <= 26) {
+        return 1 + (1 << (info - 24));
+    }
+    return -1;
+}
+
+static uint32_t _head_arg(const suit_stream_t *s)
+{
+    uint32_t arg = s->head[0] & 0x1f;
+
+    if (s->head_len > 1) {
+        arg = 0;
+        for (unsigned i = 1; i < s->head_len; i++) {
+            arg = (arg << 8) | s->head[i];
+        }
+    }
+    return arg;
+}
+
+static int _store(suit_stream_t *s, const uint8_t *data, size_t len)
+{
+    if (len > s->size - s->len) {
+        LOG_INFO("suit: manifest buffer too small\n");
+        return SUIT_ERR_NO_MEMORY;
+    }
+    memcpy(s->buf + s->len, data, len);
+    s->len += len;
+    return SUIT_OK;
+}
+
+static int _auth(suit_stream_t *s)
+{
+    nanocbor_value_t it;
+
+    nanocbor_decoder_init(&it, s->buf, s->len);
+    return suit_container_handlers[SUIT_WRAPPER_AUTHENTICATION](
+        s->manifest, SUIT_WRAPPER_AUTHENTICATION, &it);
+}
+
+static int _next_entry(suit_stream_t *s)
+{
+    if (--s->entries) {
+        s->state = _ENTRY_KEY;
+        return SUIT_OK;
+    }
+    s->state = _DONE;
+    return s->remaining ? SUIT_ERR_INVALID_MANIFEST : SUIT_OK;
+}
+
+static int _on_head(suit_stream_t *s)
+{
+    unsigned major = s->head[0] >> 5;
+    uint32_t arg = _head_arg(s);
+
+    switch (s->state) {
+    case _OUTER_MAP:
+        if (major != _MAJOR_MAP) {
+            return SUIT_ERR_INVALID_MANIFEST;
+        }
+        /* authentication wrapper and manifest, nothing else */
+        if (arg > 2) {
+            return SUIT_ERR_UNSUPPORTED;
+        }
+        s->state = _AUTH_KEY;
+        return SUIT_OK;
+    case _AUTH_KEY:
+        if ((major != _MAJOR_UINT) || (arg != SUIT_WRAPPER_AUTHENTICATION)) {
+            return SUIT_ERR_SIGNATURE;
+        }
+        s->state = _AUTH_HEAD;
+        return SUIT_OK;
+    case _AUTH_HEAD:
+        if ((major != _MAJOR_BSTR) || (arg == 0)) {
+            return SUIT_ERR_INVALID_MANIFEST;
+        }
+        s->body = arg;
+        s->state = _AUTH_BODY;
+        return _store(s, s->head, s->head_len);
+    case _MANIFEST_KEY:
+        if ((major != _MAJOR_UINT) || (arg != SUIT_WRAPPER_MANIFEST)) {
+            return SUIT_ERR_INVALID_MANIFEST;
+        }
+        /* the digest covers the byte string head */
+        sha256_init(&s->sha);
+        s->state = _MANIFEST_HEAD;
+        return SUIT_OK;
+    case _MANIFEST_HEAD:
+        if ((major != _MAJOR_BSTR) || (arg == 0)) {
+            return SUIT_ERR_INVALID_MANIFEST;
+        }
+        s->remaining = arg;
+        s->state = _MAP_HEAD;
+        return SUIT_OK;
+    case _MAP_HEAD:
+        if (major != _MAJOR_MAP) {
+            return SUIT_ERR_INVALID_MANIFEST;
+        }
+        /* the entry count is patched to the retained entries at the end */
+        if (!arg) {
+            return SUIT_ERR_INVALID_MANIFEST;
+        }
+        s->map_start = s->len;
+        s->entries = arg;
+        s->state = _ENTRY_KEY;
+        return _store(s, s->head, s->head_len);
+    case _ENTRY_KEY:
+        if ((major != _MAJOR_UINT) && (major != _MAJOR_NINT)) {
+            return SUIT_ERR_INVALID_MANIFEST;
+        }
+        /* the text section is informational only */
+        s->keep = !((major == _MAJOR_UINT) && (arg == SUIT_CONTAINER_TEXT));
+        s->state = _ENTRY_HEAD;
+        if (!s->keep) {
+            return SUIT_OK;
+        }
+        s->kept++;
+        return _store(s, s->head, s->head_len);
+    case _ENTRY_HEAD:
+        if (s->keep) {
+            int res = _store(s, s->head, s->head_len);
+            if (res) {
+                return res;
+            }
+        }
+        switch (major) {
+        case _MAJOR_UINT:
+        case _MAJOR_NINT:
+        case _MAJOR_FLOAT:
+            return _next_entry(s);
+        case _MAJOR_BSTR:
+        case _MAJOR_TSTR:
+            if (arg > s->remaining) {
+                return SUIT_ERR_INVALID_MANIFEST;
+            }
+            if (!arg) {
+                return _next_entry(s);
+            }
+            s->body = arg;
+            s->state = _ENTRY_BODY;
+            return SUIT_OK;
+        default:
+            return SUIT_ERR_UNSUPPORTED;
+        }
+    default:
+        return SUIT_ERR_INVALID_MANIFEST;
+    }
+}
+
+static int _on_body(suit_stream_t *s, const uint8_t *data, size_t len)
+{
+    if ((s->state == _AUTH_BODY) || s->keep) {
+        int res = _store(s, data, len);
+        if (res) {
+            return res;
+        }
+    }
+
+    s->body -= len;
+    if (s->body) {
+        return SUIT_OK;
+    }
+
+    if (s->state == _AUTH_BODY) {
+        s->state = _MANIFEST_KEY;
+        LOG_DEBUG("suit: authentication wrapper complete\n");
+        return _auth(s);
+    }
+    return _next_entry(s);
+}
+
+void suit_stream_init(suit_stream_t *stream, suit_manifest_t *manifest,
+                      uint8_t *buf, size_t size)
+{
+    memset(stream, 0, sizeof(*stream));
+    stream->manifest = manifest;
+    stream->buf = buf;
+    stream->size = size;
+    manifest->buf = buf;
+    manifest->len = 0;
+}
+
+int suit_stream_feed(suit_stream_t *s, const uint8_t *data, size_t len)
+{
+    s->offset += len;
+
+    while (len && (s->res == SUIT_OK)) {
+        if (s->state == _DONE) {
+            s->res = SUIT_ERR_INVALID_MANIFEST;
+            break;
+        }
+
+        bool hash = s->state >= _MANIFEST_HEAD;
+        bool count = s->state >= _MAP_HEAD;
+        bool body = (s->state == _AUTH_BODY) || (s->state == _ENTRY_BODY);
+        size_t n = 1;
+
+        if (body) {
+            n = (len < s->body) ? len : s->body;
+        }
+        else if (count && !s->remaining) {
+            s->res = SUIT_ERR_INVALID_MANIFEST;
+            break;
+        }
+
+        if (hash) {
+            sha256_update(&s->sha, data, n);
+        }
+        if (count) {
+            s->remaining -= n;
+        }
+
+        if (body) {
+            s->res = _on_body(s, data, n);
+        }
+        else {
+            /* CBOR heads are collected byte by byte */
+            s->head[s->head_len++] = *data;
+            int head_len = _head_len(s->head[0]);
+            if (head_len < 0) {
+                s->res = SUIT_ERR_UNSUPPORTED;
+            }
+            else if (s->head_len == head_len) {
+                s->res = _on_head(s);
+                s->head_len = 0;
+            }
+        }
+
+        data += n;
+        len -= n;
+    }
+
+    return s->res;
+}
+
+int suit_stream_finish(suit_stream_t *s)
+{
+    if (s->res) {
+        return s->res;
+    }
+    if (s->state != _DONE) {
+        LOG_INFO("suit: manifest incomplete\n");
+        return SUIT_ERR_INVALID_MANIFEST;
+    }
+
+    uint8_t digest[SHA256_DIGEST_LENGTH];
+    sha256_final(&s->sha, digest);
+
+    int res = suit_verify_manifest_digest(s->manifest, digest);
+    if (res) {
+        return res;
+    }
+
+    /* the retained map head has the width of the original one, which
+     * holds the smaller count as well */
+    uint8_t *head = s->buf + s->map_start;
+    unsigned width = _head_len(head[0]) - 1;
+    if (width) {
+        for (unsigned i = width; i > 0; i--) {
+            head[i] = s->kept >> (8 * (width - i));
+        }
+    }
+    else {
+        head[0] = (_MAJOR_MAP << 5) | s->kept;
+    }
+
+    s->manifest->len = s->len;
+
+    nanocbor_value_t it;
+    nanocbor_decoder_init(&it, head, s->len - s->map_start);
+    LOG_DEBUG("Starting global sequence handler\n");
+    return suit_handle_manifest_structure(s->manifest, &it,
+                                          suit_global_handlers,
+                                          suit_global_handlers_len);
+}
+
+int suit_stream_helper(void *arg, size_t offset, uint8_t *buf, size_t len,
+                       int more)
+{
+    (void)more;
+    suit_stream_t *s = arg;
+
+    if (offset != s->offset) {
+        return 0;
+    }
+    return suit_stream_feed(s, buf, len);
+}
@@ -65,9 +65,15 @@
 #endif
 
 #ifndef SUIT_MANIFEST_BUFSIZE
+/* holds the authentication wrapper and the manifest without its text */
 #define SUIT_MANIFEST_BUFSIZE   640
 #endif
 
+#ifndef SUIT_COAP_BLKSIZE_RAISE
+/* windows received without retransmission before the block size is raised */
+#define SUIT_COAP_BLKSIZE_RAISE 4
+#endif
+
 #define SUIT_MSG_TRIGGER        0x12345
 
 static char _stack[SUIT_COAP_STACKSIZE];
@@ -127,106 +133,239 @@ static inline uint32_t deadline_left(uint32_t deadline)
     return left;
 }
 
-static ssize_t _nanocoap_request(sock_udp_t *sock, coap_pkt_t *pkt, size_t len)
+/**
+ * @brief   State of a block request within the fetch window
+ */
+typedef struct {
+    size_t offset;          /**< offset of the requested block */
+    uint32_t deadline;      /**< time of the next retransmission */
+    uint32_t timeout;       /**< current retransmission timeout */
+    uint16_t id;            /**< message id of the request */
+    uint16_t len;           /**< length of the received payload */
+    uint8_t state;          /**< one of the _SLOT_* values */
+    uint8_t szx;            /**< requested block size */
+    uint8_t tries_left;     /**< retransmissions left */
+    uint8_t more;           /**< more flag of the received block */
+    uint8_t *data;          /**< buffer for the received payload */
+} _slot_t;
+
+enum {
+    _SLOT_FREE,
+    _SLOT_SENT,
+    _SLOT_DONE,
+    _SLOT_ERROR,
+};
+
+/**
+ * @brief   State of a windowed block-wise fetch
+ */
+typedef struct {
+    sock_udp_t *sock;
+    const char *path;
+    uint8_t *buf;           /**< buffer for requests and responses */
+    size_t buf_len;
+    _slot_t *slots;
+    size_t next;            /**< offset of the next block to request */
+    size_t end;             /**< size of the resource once known */
+    unsigned streak;        /**< blocks received without retransmission */
+    uint16_t id;            /**< message id of the next request */
+    uint8_t szx;            /**< block size of new requests */
+    uint8_t max_szx;        /**< largest block size buffers are sized for */
+} _fetch_t;
+
+static ssize_t _send_request(_fetch_t *fetch, const _slot_t *slot)
 {
-    ssize_t res = -EAGAIN;
-    size_t pdu_len = (pkt->payload - (uint8_t *)pkt->hdr) + pkt->payload_len;
-    uint8_t *buf = (uint8_t *)pkt->hdr;
-    uint32_t id = coap_get_id(pkt);
+    uint8_t *pktpos = fetch->buf;
+    coap_hdr_t *hdr = (coap_hdr_t *)fetch->buf;
+    size_t num = slot->offset >> (slot->szx + 4);
+
+    pktpos += coap_build_hdr(hdr, COAP_TYPE_CON, NULL, 0, COAP_METHOD_GET,
+                             slot->id);
+    pktpos += coap_opt_put_uri_path(pktpos, 0, fetch->path);
+    pktpos += coap_opt_put_uint(pktpos, COAP_OPT_URI_PATH, COAP_OPT_BLOCK2,
+                                (num << 4) | slot->szx);
+
+    DEBUG("suit_coap: requesting offset %u, szx %u\n",
+          (unsigned)slot->offset, slot->szx);
+    return sock_udp_send(fetch->sock, fetch->buf, pktpos - fetch->buf, NULL);
+}
 
+static ssize_t _request_next(_fetch_t *fetch, _slot_t *slot)
+{
+    slot->offset = fetch->next;
+    slot->szx = fetch->szx;
+    slot->id = fetch->id++;
+    slot->state = _SLOT_SENT;
+    slot->tries_left = CONFIG_COAP_MAX_RETRANSMIT;
     /* TODO: timeout random between between ACK_TIMEOUT and (ACK_TIMEOUT *
      * ACK_RANDOM_FACTOR) */
-    uint32_t timeout = CONFIG_COAP_ACK_TIMEOUT * US_PER_SEC;
-    uint32_t deadline = deadline_from_interval(timeout);
+    slot->timeout = CONFIG_COAP_ACK_TIMEOUT * US_PER_SEC;
+    slot->deadline = deadline_from_interval(slot->timeout);
 
-    /* add 1 for initial transmit */
-    unsigned tries_left = CONFIG_COAP_MAX_RETRANSMIT + 1;
+    fetch->next += 0x1 << (slot->szx + 4);
 
-    while (tries_left) {
-        if (res == -EAGAIN) {
-            res = sock_udp_send(sock, buf, pdu_len, NULL);
-            if (res <= 0) {
-                DEBUG("nanocoap: error sending coap request, %d\n", (int)res);
-                break;
-            }
-        }
+    return _send_request(fetch, slot);
+}
 
-        res = sock_udp_recv(sock, buf, len, deadline_left(deadline), NULL);
-        if (res <= 0) {
-            if (res == -ETIMEDOUT) {
-                DEBUG("nanocoap: timeout\n");
-
-                tries_left--;
-                if (!tries_left) {
-                    DEBUG("nanocoap: maximum retries reached\n");
-                    break;
-                }
-                else {
-                    timeout *= 2;
-                    deadline = deadline_from_interval(timeout);
-                    res = -EAGAIN;
-                    continue;
-                }
-            }
-            DEBUG("nanocoap: error receiving coap response, %d\n", (int)res);
+static ssize_t _fill_window(_fetch_t *fetch)
+{
+    for (unsigned i = 0; i < CONFIG_SUIT_COAP_WINDOW; i++) {
+        if (fetch->next >= fetch->end) {
             break;
         }
-        else {
-            if (coap_parse(pkt, (uint8_t *)buf, res) < 0) {
-                DEBUG("nanocoap: error parsing packet\n");
-                res = -EBADMSG;
-            }
-            else if (coap_get_id(pkt) != id) {
-                res = -EBADMSG;
-                continue;
+        if (fetch->slots[i].state == _SLOT_FREE) {
+            ssize_t res = _request_next(fetch, &fetch->slots[i]);
+            if (res < 0) {
+                return res;
             }
+        }
+    }
+    return 0;
+}
+
+static void _restart_window(_fetch_t *fetch, size_t offset)
+{
+    /* responses to the dropped requests no longer match any message id */
+    for (unsigned i = 0; i < CONFIG_SUIT_COAP_WINDOW; i++) {
+        fetch->slots[i].state = _SLOT_FREE;
+    }
+    fetch->next = offset;
+}
+
+static _slot_t *_find_slot(_fetch_t *fetch, size_t offset)
+{
+    for (unsigned i = 0; i < CONFIG_SUIT_COAP_WINDOW; i++) {
+        _slot_t *slot = &fetch->slots[i];
+        if ((slot->state != _SLOT_FREE) && (slot->offset == offset)) {
+            return slot;
+        }
+    }
+    return NULL;
+}
+
+static void _handle_response(_fetch_t *fetch, size_t len, size_t delivered)
+{
+    coap_pkt_t pkt;
+    _slot_t *slot = NULL;
 
+    if (coap_parse(&pkt, fetch->buf, len) < 0) {
+        DEBUG("suit_coap: error parsing packet\n");
+        return;
+    }
+
+    for (unsigned i = 0; i < CONFIG_SUIT_COAP_WINDOW; i++) {
+        if ((fetch->slots[i].state == _SLOT_SENT) &&
+            (fetch->slots[i].id == coap_get_id(&pkt))) {
+            slot = &fetch->slots[i];
             break;
         }
     }
+    if (!slot) {
+        DEBUG("suit_coap: ignoring response with id %u\n", coap_get_id(&pkt));
+        return;
+    }
+
+    unsigned code = coap_get_code(&pkt);
+    coap_block1_t block2;
+    coap_get_block2(&pkt, &block2);
+    DEBUG("suit_coap: code=%u offset=%u len=%u\n", code,
+          (unsigned)block2.offset, pkt.payload_len);
+
+    if ((code != 205) || (block2.offset != slot->offset) ||
+        (pkt.payload_len > (0x1u << (slot->szx + 4)))) {
+        /* requests past the end fail, only an error if it gets delivered */
+        slot->state = _SLOT_ERROR;
+        return;
+    }
+
+    if ((block2.more == 1) && (block2.szx < slot->szx)) {
+        /* the server wants smaller blocks, the offsets of all requests in
+         * flight are off now */
+        DEBUG("suit_coap: server reduced szx to %u\n", block2.szx);
+        fetch->max_szx = block2.szx;
+        fetch->szx = block2.szx;
+        _restart_window(fetch, delivered);
+        return;
+    }
 
-    return res;
+    memcpy(slot->data, pkt.payload, pkt.payload_len);
+    slot->len = pkt.payload_len;
+    slot->more = (block2.more == 1);
+    slot->state = _SLOT_DONE;
+
+    if (!slot->more) {
+        fetch->end = slot->offset + slot->len;
+    }
 }
 
-static int _fetch_block(coap_pkt_t *pkt, uint8_t *buf, sock_udp_t *sock,
-                        const char *path, coap_blksize_t blksize, size_t num)
+static int _handle_timeouts(_fetch_t *fetch)
 {
-    uint8_t *pktpos = buf;
+    for (unsigned i = 0; i < CONFIG_SUIT_COAP_WINDOW; i++) {
+        _slot_t *slot = &fetch->slots[i];
 
-    pkt->hdr = (coap_hdr_t *)buf;
+        if ((slot->state != _SLOT_SENT) || deadline_left(slot->deadline)) {
+            continue;
+        }
+        if (!slot->tries_left--) {
+            DEBUG("suit_coap: maximum retries reached\n");
+            return -ETIMEDOUT;
+        }
 
-    pktpos += coap_build_hdr(pkt->hdr, COAP_TYPE_CON, NULL, 0, COAP_METHOD_GET,
-                             num);
-    pktpos += coap_opt_put_uri_path(pktpos, 0, path);
-    pktpos +=
-        coap_opt_put_uint(pktpos, COAP_OPT_URI_PATH, COAP_OPT_BLOCK2,
-                          (num << 4) | blksize);
+        /* loss observed, use smaller blocks for the following requests */
+        if (fetch->szx > COAP_BLOCKSIZE_32) {
+            fetch->szx--;
+        }
+        fetch->streak = 0;
 
-    pkt->payload = pktpos;
-    pkt->payload_len = 0;
+        slot->timeout *= 2;
+        slot->deadline = deadline_from_interval(slot->timeout);
+        if (_send_request(fetch, slot) < 0) {
+            return -EIO;
+        }
+    }
+    return 0;
+}
 
-    int res = _nanocoap_request(sock, pkt, 64 + (0x1 << (blksize + 4)));
-    if (res < 0) {
-        return res;
+static uint32_t _next_timeout(_fetch_t *fetch)
+{
+    uint32_t timeout = UINT32_MAX;
+
+    for (unsigned i = 0; i < CONFIG_SUIT_COAP_WINDOW; i++) {
+        _slot_t *slot = &fetch->slots[i];
+        if (slot->state == _SLOT_SENT) {
+            uint32_t left = deadline_left(slot->deadline);
+            if (left < timeout) {
+                timeout = left;
+            }
+        }
     }
+    return timeout;
+}
 
-    res = coap_get_code(pkt);
-    DEBUG("code=%i\n", res);
-    if (res != 205) {
-        return -res;
+static void _adapt_blksize(_fetch_t *fetch)
+{
+    if (++fetch->streak < SUIT_COAP_BLKSIZE_RAISE * CONFIG_SUIT_COAP_WINDOW) {
+        return;
     }
 
-    return 0;
+    /* larger blocks must start at a multiple of their size */
+    unsigned bigger = 0x1 << (fetch->szx + 5);
+    if ((fetch->szx < fetch->max_szx) && ((fetch->next % bigger) == 0)) {
+        fetch->szx++;
+        fetch->streak = 0;
+        DEBUG("suit_coap: raising szx to %u\n", fetch->szx);
+    }
 }
 
 int suit_coap_get_blockwise(sock_udp_ep_t *remote, const char *path,
                             coap_blksize_t blksize,
                             coap_blockwise_cb_t callback, void *arg)
 {
-    /* mmmmh dynamically sized array */
+    /* mmmmh dynamically sized arrays */
     uint8_t buf[64 + (0x1 << (blksize + 4))];
+    uint8_t data[CONFIG_SUIT_COAP_WINDOW][0x1 << (blksize + 4)];
+    _slot_t slots[CONFIG_SUIT_COAP_WINDOW];
     sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
-    coap_pkt_t pkt;
 
     /* HACK: use random local port */
     local.port = 0x8000 + (xtimer_now_usec() % 0XFFF);
@@ -237,38 +376,72 @@ int suit_coap_get_blockwise(sock_udp_ep_t *remote, const char *path,
         return res;
     }
 
-    int more = 1;
-    size_t num = 0;
-    res = -1;
-    while (more == 1) {
-        DEBUG("fetching block %u\n", (unsigned)num);
-        res = _fetch_block(&pkt, buf, &sock, path, blksize, num);
-        DEBUG("res=%i\n", res);
-
-        if (!res) {
-            coap_block1_t block2;
-            coap_get_block2(&pkt, &block2);
-            more = block2.more;
+    memset(slots, 0, sizeof(slots));
+    for (unsigned i = 0; i < CONFIG_SUIT_COAP_WINDOW; i++) {
+        slots[i].data = data[i];
+    }
 
-            if (callback(arg, block2.offset, pkt.payload, pkt.payload_len,
-                         more)) {
+    _fetch_t fetch = {
+        .sock = &sock,
+        .path = path,
+        .buf = buf,
+        .buf_len = sizeof(buf),
+        .slots = slots,
+        .end = SIZE_MAX,
+        .id = xtimer_now_usec(),
+        .szx = blksize,
+        .max_szx = blksize,
+    };
+
+    /* blocks are requested ahead, but handed to the callback in order */
+    size_t delivered = 0;
+    res = _fill_window(&fetch);
+    while (res == 0) {
+        _slot_t *slot = _find_slot(&fetch, delivered);
+
+        if (slot && (slot->state == _SLOT_DONE)) {
+            if (callback(arg, delivered, slot->data, slot->len, slot->more)) {
                 DEBUG("callback res != 0, aborting.\n");
                 res = -1;
-                goto out;
+                break;
             }
+            delivered += slot->len;
+            slot->state = _SLOT_FREE;
+            if (delivered >= fetch.end) {
+                break;
+            }
+
+            _adapt_blksize(&fetch);
+            res = _fill_window(&fetch);
+            continue;
         }
-        else {
-            DEBUG("error fetching block\n");
+        if (!slot || (slot->state == _SLOT_ERROR)) {
+            DEBUG("error fetching block at offset %u\n", (unsigned)delivered);
             res = -1;
-            goto out;
+            break;
         }
 
-        num += 1;
+        ssize_t len = sock_udp_recv(&sock, buf, sizeof(buf),
+                                    _next_timeout(&fetch), NULL);
+        if (len > 0) {
+            _handle_response(&fetch, len, delivered);
+            if (_find_slot(&fetch, delivered) == NULL) {
+                /* window was restarted with a smaller block size */
+                res = _fill_window(&fetch);
+            }
+        }
+        else if ((len != -ETIMEDOUT) && (len != -EAGAIN)) {
+            DEBUG("nanocoap: error receiving coap response, %d\n", (int)len);
+            res = -1;
+            break;
+        }
+        if (res == 0) {
+            res = _handle_timeouts(&fetch);
+        }
     }
 
-out:
     sock_udp_close(&sock);
-    return res;
+    return (res < 0) ? -1 : 0;
 }
 
 int suit_coap_get_blockwise_url(const char *url,
@@ -339,69 +512,129 @@ ssize_t suit_coap_get_blockwise_url_buf(const char *url,
 
 static void _suit_handle_url(const char *url)
 {
-    LOG_INFO("suit_coap: downloading \"%s\"\n", url);
-    ssize_t size = suit_coap_get_blockwise_url_buf(url, COAP_BLOCKSIZE_64,
-                                                   _manifest_buf,
-                                                   SUIT_MANIFEST_BUFSIZE);
-    if (size >= 0) {
-        LOG_INFO("suit_coap: got manifest with size %u\n", (unsigned)size);
+    riotboot_flashwrite_t writer;
+    suit_manifest_t manifest;
+    suit_stream_t stream;
 
-        riotboot_flashwrite_t writer;
-#ifdef MODULE_SUIT
-        suit_manifest_t manifest;
-        memset(&manifest, 0, sizeof(manifest));
+    memset(&manifest, 0, sizeof(manifest));
+    manifest.writer = &writer;
+    manifest.urlbuf = _url;
+    manifest.urlbuf_len = SUIT_URL_MAX;
 
-        manifest.writer = &writer;
-        manifest.urlbuf = _url;
-        manifest.urlbuf_len = SUIT_URL_MAX;
+    /* the manifest is authenticated while it is downloaded, only the parts
+     * needed to process it end up in _manifest_buf */
+    suit_stream_init(&stream, &manifest, _manifest_buf, SUIT_MANIFEST_BUFSIZE);
 
-        int res;
-        if ((res = suit_parse(&manifest, _manifest_buf, size)) != SUIT_OK) {
-            LOG_INFO("suit_parse() failed. res=%i\n", res);
-            return;
-        }
+    LOG_INFO("suit_coap: downloading \"%s\"\n", url);
+    int res = suit_coap_get_blockwise_url(url, COAP_BLOCKSIZE_64,
+                                          suit_stream_helper, &stream);
+    if (res < 0) {
+        LOG_INFO("suit_coap: error getting manifest, res=%i\n", stream.res);
+        return;
+    }
+    LOG_INFO("suit_coap: got manifest with size %u\n", (unsigned)stream.offset);
 
-        LOG_INFO("suit_parse() success\n");
-        if (!(manifest.state & SUIT_MANIFEST_HAVE_IMAGE)) {
-            LOG_INFO("manifest parsed, but no image fetched\n");
-            return;
-        }
+    if ((res = suit_stream_finish(&stream)) != SUIT_OK) {
+        LOG_INFO("suit_parse() failed. res=%i\n", res);
+        return;
+    }
 
-        res = suit_policy_check(&manifest);
-        if (res) {
-            return;
-        }
+    LOG_INFO("suit_parse() success\n");
+    if (!(manifest.state & SUIT_MANIFEST_HAVE_IMAGE)) {
+        LOG_INFO("manifest parsed, but no image fetched\n");
+        return;
+    }
 
-#endif
-        if (res == 0) {
-            LOG_INFO("suit_coap: finalizing image flash\n");
-            riotboot_flashwrite_finish(&writer);
+    res = suit_policy_check(&manifest);
+    if (res) {
+        return;
+    }
 
-            const riotboot_hdr_t *hdr = riotboot_slot_get_hdr(
-                riotboot_slot_other());
-            riotboot_hdr_print(hdr);
-            xtimer_sleep(1);
+    LOG_INFO("suit_coap: finalizing image flash\n");
+    riotboot_flashwrite_finish(&writer);
 
-            if (riotboot_hdr_validate(hdr) == 0) {
-                LOG_INFO("suit_coap: rebooting...");
-                pm_reboot();
-            }
-            else {
-                LOG_INFO("suit_coap: update failed, hdr invalid");
-            }
-        }
+    const riotboot_hdr_t *hdr = riotboot_slot_get_hdr(riotboot_slot_other());
+    riotboot_hdr_print(hdr);
+    xtimer_sleep(1);
+
+    if (riotboot_hdr_validate(hdr) == 0) {
+        LOG_INFO("suit_coap: rebooting...");
+        pm_reboot();
     }
     else {
-        LOG_INFO("suit_coap: error getting manifest\n");
+        LOG_INFO("suit_coap: update failed, hdr invalid");
     }
 }
 
+#ifdef MODULE_RIOTBOOT_FLASHWRITE_HEATSHRINK
+static riotboot_flashwrite_heatshrink_t _heatshrink;
+static size_t _heatshrink_offset;
+#endif
+
+#ifdef MODULE_RIOTBOOT_FLASHWRITE_DELTA
+static riotboot_flashwrite_delta_t _delta;
+static size_t _delta_offset;
+static bool _delta_active;
+#endif
+
 int suit_flashwrite_helper(void *arg, size_t offset, uint8_t *buf, size_t len,
                            int more)
 {
     suit_manifest_t *manifest = (suit_manifest_t *)arg;
     riotboot_flashwrite_t *writer = manifest->writer;
 
+#ifdef MODULE_RIOTBOOT_FLASHWRITE_HEATSHRINK
+    /* the digest covers the decompressed image */
+    if (manifest->components[0].compression == SUIT_COMPRESSION_HEATSHRINK) {
+        if (offset == 0) {
+            riotboot_flashwrite_heatshrink_init(&_heatshrink, writer);
+            _heatshrink_offset = 0;
+        }
+        if (_heatshrink_offset != offset) {
+            LOG_WARNING("_suit_flashwrite(): compressed offset=%u, offset==%u, "
+                        "aborting\n", (unsigned)_heatshrink_offset,
+                        (unsigned)offset);
+            return -1;
+        }
+        _heatshrink_offset += len;
+        int res = riotboot_flashwrite_heatshrink_putbytes(&_heatshrink, buf,
+                                                          len, more);
+        _print_download_progress(writer->offset, 0,
+                                 manifest->components[0].size);
+        return res;
+    }
+#endif
+
+#ifdef MODULE_RIOTBOOT_FLASHWRITE_DELTA
+    /* the payload is a delta patch against the running image if it starts
+     * with the patch magic, the digest still covers the rebuilt image */
+    if (offset == 0) {
+        _delta_active = (len >= RIOTBOOT_FLASHWRITE_DELTA_MAGIC_LEN)
+                     && !memcmp(buf, RIOTBOOT_FLASHWRITE_DELTA_MAGIC,
+                                RIOTBOOT_FLASHWRITE_DELTA_MAGIC_LEN);
+        if (_delta_active) {
+            LOG_INFO("_suit_flashwrite(): applying delta patch\n");
+            riotboot_flashwrite_delta_init(&_delta, writer,
+                                           riotboot_slot_current());
+            _delta_offset = 0;
+        }
+    }
+
+    if (_delta_active) {
+        if (_delta_offset != offset) {
+            LOG_WARNING("_suit_flashwrite(): delta offset=%u, offset==%u, "
+                        "aborting\n", (unsigned)_delta_offset, (unsigned)offset);
+            return -1;
+        }
+        _delta_offset += len;
+        int res = riotboot_flashwrite_delta_putbytes(&_delta, buf, len, more);
+        /* progress is measured on the rebuilt image */
+        _print_download_progress(writer->offset, 0,
+                                 manifest->components[0].size);
+        return res;
+    }
+#endif
+
     if (offset == 0) {
         if (len < RIOTBOOT_FLASHWRITE_SKIPLEN) {
             LOG_WARNING("_suit_flashwrite(): offset==0, len<4. aborting\n");
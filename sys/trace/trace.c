@@ -23,41 +23,144 @@
 #include <stdio.h>
 
 #include "irq.h"
+#include "periph_conf.h"
+#include "trace.h"
 #include "xtimer.h"
 
 #ifndef CONFIG_TRACE_BUFSIZE
 #define CONFIG_TRACE_BUFSIZE 512
 #endif
 
+/* a slot is claimed by an atomic increment if the CPU has native atomics,
+ * otherwise the fetch-and-add would disable interrupts anyway */
+#if defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_4)
+#define TRACE_LOCK_FREE     (1)
+#else
+#define TRACE_LOCK_FREE     (0)
+#endif
+
+/* maximum length of a LEB128 encoded uint32_t */
+#define LEB128_MAX_LEN      (5U)
+
 typedef struct {
     uint32_t time;
     uint32_t val;
 } tracebuf_entry_t;
 
 static tracebuf_entry_t tracebuf[CONFIG_TRACE_BUFSIZE];
-static size_t tracebuf_pos;
+static uint32_t tracebuf_pos;
+
+static inline uint32_t _now(void)
+{
+#ifdef DWT_CTRL_CYCCNTENA_Msk
+    return DWT->CYCCNT;
+#else
+    return xtimer_now_usec();
+#endif
+}
+
+void trace_init(void)
+{
+#ifdef DWT_CTRL_CYCCNTENA_Msk
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+}
 
 void trace(uint32_t val)
 {
-    unsigned state = irq_disable();
+    if (TRACE_LOCK_FREE) {
+        /* time is taken before the slot is claimed, so a preempting ISR may
+         * add a later entry with an earlier timestamp */
+        uint32_t time = _now();
+        uint32_t pos = __atomic_fetch_add(&tracebuf_pos, 1, __ATOMIC_RELAXED);
 
-    tracebuf[tracebuf_pos % CONFIG_TRACE_BUFSIZE] =
-        (tracebuf_entry_t){ .time = xtimer_now_usec(), .val = val };
-    tracebuf_pos++;
-    irq_restore(state);
+        tracebuf[pos % CONFIG_TRACE_BUFSIZE] =
+            (tracebuf_entry_t){ .time = time, .val = val };
+    }
+    else {
+        unsigned state = irq_disable();
+
+        tracebuf[tracebuf_pos % CONFIG_TRACE_BUFSIZE] =
+            (tracebuf_entry_t){ .time = _now(), .val = val };
+        tracebuf_pos++;
+        irq_restore(state);
+    }
+}
+
+static void _range(size_t *first, size_t *n)
+{
+    uint32_t pos = tracebuf_pos;
+
+    if (pos > CONFIG_TRACE_BUFSIZE) {
+        /* the oldest entry is the one that is overwritten next */
+        *first = pos % CONFIG_TRACE_BUFSIZE;
+        *n = CONFIG_TRACE_BUFSIZE;
+    }
+    else {
+        *first = 0;
+        *n = pos;
+    }
 }
 
 void trace_dump(void)
 {
-    size_t n = tracebuf_pos >
-               CONFIG_TRACE_BUFSIZE ? CONFIG_TRACE_BUFSIZE : tracebuf_pos;
+    size_t first, n;
     uint32_t t_last = 0;
 
+    _range(&first, &n);
     for (size_t i = 0; i < n; i++) {
+        tracebuf_entry_t *e = &tracebuf[(first + i) % CONFIG_TRACE_BUFSIZE];
         printf("n=%4lu t=%s%8" PRIu32 " v=0x%08lx\n", (unsigned long)i,
                i ? "+" : " ",
-               tracebuf[i].time - t_last, (unsigned long)tracebuf[i].val);
-        t_last = tracebuf[i].time;
+               e->time - t_last, (unsigned long)e->val);
+        t_last = e->time;
+    }
+}
+
+static size_t _leb128(uint8_t *buf, uint32_t val)
+{
+    size_t len = 0;
+
+    do {
+        buf[len] = val & 0x7f;
+        val >>= 7;
+        if (val) {
+            buf[len] |= 0x80;
+        }
+        len++;
+    } while (val);
+
+    return len;
+}
+
+void trace_dump_bin(trace_write_t write, void *arg)
+{
+    uint8_t buf[2 * LEB128_MAX_LEN];
+#if defined(DWT_CTRL_CYCCNTENA_Msk) && defined(CLOCK_CORECLOCK)
+    uint32_t hz = CLOCK_CORECLOCK;
+#elif defined(DWT_CTRL_CYCCNTENA_Msk)
+    uint32_t hz = 0;
+#else
+    uint32_t hz = US_PER_SEC;
+#endif
+    uint8_t hdr[] = { 'R', 'T', 'R', 'C', TRACE_BIN_VERSION,
+                      hz, hz >> 8, hz >> 16, hz >> 24 };
+    size_t first, n;
+    uint32_t t_last = 0;
+
+    write(hdr, sizeof(hdr), arg);
+
+    _range(&first, &n);
+    for (size_t i = 0; i < n; i++) {
+        tracebuf_entry_t *e = &tracebuf[(first + i) % CONFIG_TRACE_BUFSIZE];
+        /* zigzag encoding, deltas are negative for reordered entries */
+        int32_t delta = e->time - t_last;
+        size_t len = _leb128(buf, ((uint32_t)delta << 1) ^ (delta >> 31));
+
+        len += _leb128(&buf[len], e->val);
+        write(buf, len, arg);
+        t_last = e->time;
     }
 }
 
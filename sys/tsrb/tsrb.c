@@ -17,16 +17,31 @@
  * @}
  */
 
+#include <stdatomic.h>
+#include <string.h>
+
 #include "tsrb.h"
 
+/* Order the buffer accesses before the index update publishing them. The
+ * indices are volatile, but the buffer contents are not. */
+static inline void _barrier(void)
+{
+    atomic_signal_fence(memory_order_seq_cst);
+}
+
 static void _push(tsrb_t *rb, uint8_t c)
 {
-    rb->buf[rb->writes++ & (rb->size - 1)] = c;
+    rb->buf[rb->writes & (rb->size - 1)] = c;
+    _barrier();
+    rb->writes++;
 }
 
 static uint8_t _pop(tsrb_t *rb)
 {
-    return rb->buf[rb->reads++ & (rb->size - 1)];
+    uint8_t c = rb->buf[rb->reads & (rb->size - 1)];
+    _barrier();
+    rb->reads++;
+    return c;
 }
 
 int tsrb_get_one(tsrb_t *rb)
@@ -39,24 +54,68 @@ int tsrb_get_one(tsrb_t *rb)
     }
 }
 
+unsigned tsrb_peek_contig(const tsrb_t *rb, uint8_t **data)
+{
+    unsigned reads = rb->reads;
+    unsigned pos = reads & (rb->size - 1);
+    unsigned avail = rb->writes - reads;
+    unsigned contig = rb->size - pos;
+
+    *data = &rb->buf[pos];
+    return (avail < contig) ? avail : contig;
+}
+
+unsigned tsrb_reserve_contig(const tsrb_t *rb, uint8_t **data)
+{
+    unsigned writes = rb->writes;
+    unsigned pos = writes & (rb->size - 1);
+    unsigned space = rb->size - (writes - rb->reads);
+    unsigned contig = rb->size - pos;
+
+    *data = &rb->buf[pos];
+    return (space < contig) ? space : contig;
+}
+
+void tsrb_commit(tsrb_t *rb, size_t n)
+{
+    assert(n <= tsrb_free(rb));
+    _barrier();
+    rb->writes += n;
+}
+
 int tsrb_get(tsrb_t *rb, uint8_t *dst, size_t n)
 {
-    size_t tmp = n;
-    while (tmp && !tsrb_empty(rb)) {
-        *dst++ = _pop(rb);
-        tmp--;
+    size_t done = 0;
+
+    /* at most two spans: up to the end of the buffer and from its start */
+    while (done < n) {
+        uint8_t *src;
+        unsigned len = tsrb_peek_contig(rb, &src);
+
+        if (len == 0) {
+            break;
+        }
+        if (len > n - done) {
+            len = n - done;
+        }
+        memcpy(dst + done, src, len);
+        _barrier();
+        rb->reads += len;
+        done += len;
     }
-    return (n - tmp);
+    return done;
 }
 
 int tsrb_drop(tsrb_t *rb, size_t n)
 {
-    size_t tmp = n;
-    while (tmp && !tsrb_empty(rb)) {
-        _pop(rb);
-        tmp--;
+    unsigned avail = tsrb_avail(rb);
+
+    if (n > avail) {
+        n = avail;
     }
-    return (n - tmp);
+    _barrier();
+    rb->reads += n;
+    return n;
 }
 
 int tsrb_add_one(tsrb_t *rb, uint8_t c)
@@ -72,10 +131,21 @@ int tsrb_add_one(tsrb_t *rb, uint8_t c)
 
 int tsrb_add(tsrb_t *rb, const uint8_t *src, size_t n)
 {
-    size_t tmp = n;
-    while (tmp && !tsrb_full(rb)) {
-        _push(rb, *src++);
-        tmp--;
+    size_t done = 0;
+
+    while (done < n) {
+        uint8_t *dst;
+        unsigned len = tsrb_reserve_contig(rb, &dst);
+
+        if (len == 0) {
+            break;
+        }
+        if (len > n - done) {
+            len = n - done;
+        }
+        memcpy(dst, src + done, len);
+        tsrb_commit(rb, len);
+        done += len;
     }
-    return (n - tmp);
+    return done;
 }
@@ -321,12 +321,11 @@ static void _handle_in(usbus_cdcacm_device_t *cdcacm,
     }
     /* copy at most CONFIG_USBUS_CDC_ACM_BULK_EP_SIZE chars from input into ep->buf */
     unsigned old = irq_disable();
-    while (!tsrb_empty(&cdcacm->tsrb)) {
-        int c = tsrb_get_one(&cdcacm->tsrb);
-        ep->buf[cdcacm->occupied++] = (uint8_t)c;
-        if (cdcacm->occupied >= CONFIG_USBUS_CDC_ACM_BULK_EP_SIZE) {
-            break;
-        }
+    if (cdcacm->occupied < CONFIG_USBUS_CDC_ACM_BULK_EP_SIZE) {
+        cdcacm->occupied += tsrb_get(&cdcacm->tsrb,
+                                     ep->buf + cdcacm->occupied,
+                                     CONFIG_USBUS_CDC_ACM_BULK_EP_SIZE -
+                                     cdcacm->occupied);
     }
     irq_restore(old);
     usbdev_ep_ready(ep, cdcacm->occupied);
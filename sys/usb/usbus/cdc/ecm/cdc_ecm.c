@@ -44,6 +44,7 @@ static void _transfer_handler(usbus_t *usbus, usbus_handler_t *handler,
 static void _init(usbus_t *usbus, usbus_handler_t *handler);
 static void _handle_rx_flush_ev(event_t *ev);
 static void _handle_tx_xmit(event_t *ev);
+static void _rx_ready(usbus_cdcecm_device_t *cdcecm);
 
 static size_t _gen_full_ecm_descriptor(usbus_t *usbus, void *arg);
 
@@ -231,6 +232,11 @@ static void _init(usbus_t *usbus, usbus_handler_t *handler)
 
     cdcecm->iface_data.alts = &cdcecm->iface_data_alt;
 
+    cdcecm->multi_packet =
+        !IS_ACTIVE(CONFIG_USBUS_CDC_ECM_NO_MULTI_PACKET) &&
+        usbdev_ep_xfer_supported(cdcecm->ep_out->ep) &&
+        usbdev_ep_xfer_supported(cdcecm->ep_in->ep);
+
     usbus_enable_endpoint(cdcecm->ep_out);
     usbus_enable_endpoint(cdcecm->ep_in);
     usbus_enable_endpoint(cdcecm->ep_ctrl);
@@ -251,7 +257,7 @@ static int _control_handler(usbus_t *usbus, usbus_handler_t *handler,
                   setup->value);
             cdcecm->active_iface = (uint8_t)setup->value;
             if (cdcecm->active_iface == 1) {
-                usbdev_ep_ready(cdcecm->ep_out->ep, 0);
+                _rx_ready(cdcecm);
                 _notify_link_up(cdcecm);
             }
             break;
@@ -290,9 +296,27 @@ static void _handle_tx_xmit(event_t *ev)
         mutex_unlock(&cdcecm->out_lock);
     }
     /* Data prepared by netdev_send, signal ready to usbus */
+#if !IS_ACTIVE(CONFIG_USBUS_CDC_ECM_NO_MULTI_PACKET)
+    if (cdcecm->multi_packet) {
+        usbdev_ep_xfer(cdcecm->ep_in->ep, cdcecm->out_buf, cdcecm->tx_len);
+        return;
+    }
+#endif
     usbdev_ep_ready(cdcecm->ep_in->ep, cdcecm->tx_len);
 }
 
+static void _rx_ready(usbus_cdcecm_device_t *cdcecm)
+{
+    if (cdcecm->multi_packet) {
+        /* receive the whole frame straight into the frame buffer */
+        usbdev_ep_xfer(cdcecm->ep_out->ep, cdcecm->in_buf,
+                       sizeof(cdcecm->in_buf));
+    }
+    else {
+        usbdev_ep_ready(cdcecm->ep_out->ep, 0);
+    }
+}
+
 static void _handle_rx_flush(usbus_cdcecm_device_t *cdcecm)
 {
     cdcecm->len = 0;
@@ -303,8 +327,8 @@ static void _handle_rx_flush_ev(event_t *ev)
     usbus_cdcecm_device_t *cdcecm = container_of(ev, usbus_cdcecm_device_t,
                                                  rx_flush);
 
-    usbdev_ep_ready(cdcecm->ep_out->ep, 0);
     _handle_rx_flush(cdcecm);
+    _rx_ready(cdcecm);
 }
 
 static void _store_frame_chunk(usbus_cdcecm_device_t *cdcecm)
@@ -334,6 +358,18 @@ static void _transfer_handler(usbus_t *usbus, usbus_handler_t *handler,
         }
         size_t len = 0;
         usbdev_ep_get(ep, USBOPT_EP_AVAILABLE, &len, sizeof(size_t));
+        if (cdcecm->multi_packet) {
+            /* the frame is complete, the endpoint stays busy until it is
+             * flushed */
+            cdcecm->len = len;
+            if (len) {
+                netdev_trigger_event_isr(&cdcecm->netdev);
+            }
+            else {
+                _rx_ready(cdcecm);
+            }
+            return;
+        }
         _store_frame_chunk(cdcecm);
         if (len == USBUS_CDCECM_EP_DATA_SIZE) {
             usbdev_ep_ready(ep, 0);
@@ -67,6 +67,25 @@ static int _send(netdev_t *netdev, const iolist_t *iolist)
         return -ENOTCONN;
     }
     DEBUG("CDC_ECM_netdev: sending %u bytes\n", len);
+#if !IS_ACTIVE(CONFIG_USBUS_CDC_ECM_NO_MULTI_PACKET)
+    if (cdcecm->multi_packet) {
+        if (len > sizeof(cdcecm->out_buf)) {
+            return -EMSGSIZE;
+        }
+        /* the whole frame goes out in a single transfer, the zero length
+         * packet is added by the peripheral */
+        mutex_lock(&cdcecm->out_lock);
+        size_t offset = 0;
+        for (; iolist; iolist = iolist->iol_next) {
+            memcpy(cdcecm->out_buf + offset, iolist->iol_base,
+                   iolist->iol_len);
+            offset += iolist->iol_len;
+        }
+        cdcecm->tx_len = len;
+        _signal_tx_xmit(cdcecm);
+        return len;
+    }
+#endif
     /* load packet data into FIFO */
     size_t iol_offset = 0;
     size_t usb_offset = 0;
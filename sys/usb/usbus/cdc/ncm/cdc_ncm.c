@@ -0,0 +1,569 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup usbus_cdc_ncm
+ * @{
+ * @file USBUS implementation for network control model
+ *
+ * @author  ML!PA Consulting GmbH
+ * @}
+ */
+
+#define USB_H_USER_IS_RIOT_INTERNAL
+
+#include <inttypes.h>
+
+#include "event.h"
+#include "fmt.h"
+#include "kernel_defines.h"
+#include "luid.h"
+#include "net/ethernet.h"
+#include "net/eui48.h"
+#include "usb/cdc.h"
+#include "usb/descriptor.h"
+#include "usb/usbus.h"
+#include "usb/usbus/control.h"
+#include "usb/usbus/cdc/ncm.h"
+
+#include <string.h>
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static void _event_handler(usbus_t *usbus, usbus_handler_t *handler,
+                          usbus_event_usb_t event);
+static int _control_handler(usbus_t *usbus, usbus_handler_t *handler,
+                            usbus_control_request_state_t state,
+                            usb_setup_t *setup);
+static void _transfer_handler(usbus_t *usbus, usbus_handler_t *handler,
+                              usbdev_ep_t *ep, usbus_event_transfer_t event);
+static void _init(usbus_t *usbus, usbus_handler_t *handler);
+static void _handle_rx_flush_ev(event_t *ev);
+static void _handle_tx_xmit(event_t *ev);
+
+static size_t _gen_full_ncm_descriptor(usbus_t *usbus, void *arg);
+
+static const usbus_descr_gen_funcs_t _ncm_descriptor = {
+    .fmt_post_descriptor = _gen_full_ncm_descriptor,
+    .len = {
+        .fixed_len = sizeof(usb_desc_cdc_t) +
+                     sizeof(usb_desc_union_t) +
+                     sizeof(usb_desc_ecm_t) +
+                     sizeof(usb_desc_ncm_t),
+    },
+    .len_type = USBUS_DESCR_LEN_FIXED,
+};
+
+static size_t _gen_union_descriptor(usbus_t *usbus, usbus_cdcncm_device_t *cdcncm)
+{
+    usb_desc_union_t uni;
+
+    /* functional union descriptor */
+    uni.length = sizeof(usb_desc_union_t);
+    uni.type = USB_TYPE_DESCRIPTOR_CDC;
+    uni.subtype = USB_CDC_DESCR_SUBTYPE_UNION;
+    uni.master_if = cdcncm->iface_ctrl.idx;
+    uni.slave_if = cdcncm->iface_data.idx;
+    usbus_control_slicer_put_bytes(usbus, (uint8_t *)&uni, sizeof(uni));
+    return sizeof(usb_desc_union_t);
+}
+
+static size_t _gen_ecm_descriptor(usbus_t *usbus, usbus_cdcncm_device_t *cdcncm)
+{
+    usb_desc_ecm_t ecm;
+
+    /* functional ethernet networking descriptor, required by NCM as well */
+    ecm.length = sizeof(usb_desc_ecm_t);
+    ecm.type = USB_TYPE_DESCRIPTOR_CDC;
+    ecm.subtype = USB_CDC_DESCR_SUBTYPE_ETH_NET;
+    ecm.macaddress = cdcncm->mac_str.idx;
+    ecm.ethernetstatistics = 0;
+    ecm.maxsegmentsize = ETHERNET_FRAME_LEN;
+    ecm.numbermcfilters = 0x0000; /* No filtering */
+    ecm.numberpowerfilters = 0;
+    usbus_control_slicer_put_bytes(usbus, (uint8_t *)&ecm, sizeof(ecm));
+    return sizeof(usb_desc_ecm_t);
+}
+
+static size_t _gen_ncm_descriptor(usbus_t *usbus)
+{
+    usb_desc_ncm_t ncm;
+
+    /* functional cdc ncm descriptor */
+    ncm.length = sizeof(usb_desc_ncm_t);
+    ncm.type = USB_TYPE_DESCRIPTOR_CDC;
+    ncm.subtype = USB_CDC_DESCR_SUBTYPE_NCM;
+    ncm.bcd_ncm = USB_CDC_NCM_VERSION_BCD;
+    ncm.capabilities = USB_CDC_NCM_CAP_ETH_FILTER;
+    usbus_control_slicer_put_bytes(usbus, (uint8_t *)&ncm, sizeof(ncm));
+    return sizeof(usb_desc_ncm_t);
+}
+
+static size_t _gen_cdc_descriptor(usbus_t *usbus)
+{
+    usb_desc_cdc_t cdc;
+    /* functional cdc descriptor */
+    cdc.length = sizeof(usb_desc_cdc_t);
+    cdc.bcd_cdc = USB_CDC_VERSION_BCD;
+    cdc.type = USB_TYPE_DESCRIPTOR_CDC;
+    cdc.subtype = 0x00;
+    usbus_control_slicer_put_bytes(usbus, (uint8_t *)&cdc, sizeof(cdc));
+    return sizeof(usb_desc_cdc_t);
+}
+
+static size_t _gen_full_ncm_descriptor(usbus_t *usbus, void *arg)
+{
+    usbus_cdcncm_device_t *cdcncm = (usbus_cdcncm_device_t *)arg;
+    size_t total_size = 0;
+
+    total_size += _gen_cdc_descriptor(usbus);
+    total_size += _gen_union_descriptor(usbus, cdcncm);
+    total_size += _gen_ecm_descriptor(usbus, cdcncm);
+    total_size += _gen_ncm_descriptor(usbus);
+    return total_size;
+}
+
+static void _notify_link_speed(usbus_cdcncm_device_t *cdcncm)
+{
+    DEBUG("CDC NCM: sending link speed indication\n");
+    usb_desc_cdcecm_speed_t *notification =
+        (usb_desc_cdcecm_speed_t *)cdcncm->ep_ctrl->ep->buf;
+    notification->setup.type = USB_SETUP_REQUEST_DEVICE2HOST |
+                               USB_SETUP_REQUEST_TYPE_CLASS |
+                               USB_SETUP_REQUEST_RECIPIENT_INTERFACE;
+    notification->setup.request = USB_CDC_MGNT_NOTIF_CONN_SPEED_CHANGE;
+    notification->setup.value = 0;
+    notification->setup.index = cdcncm->iface_ctrl.idx;
+    notification->setup.length = 8;
+
+    notification->down = CONFIG_USBUS_CDC_NCM_CONFIG_SPEED;
+    notification->up = CONFIG_USBUS_CDC_NCM_CONFIG_SPEED;
+    usbdev_ep_ready(cdcncm->ep_ctrl->ep,
+                    sizeof(usb_desc_cdcecm_speed_t));
+    cdcncm->notif = USBUS_CDCNCM_NOTIF_SPEED;
+}
+
+static void _notify_link_up(usbus_cdcncm_device_t *cdcncm)
+{
+    DEBUG("CDC NCM: sending link up indication\n");
+    usb_setup_t *notification = (usb_setup_t *)cdcncm->ep_ctrl->ep->buf;
+    notification->type = USB_SETUP_REQUEST_DEVICE2HOST |
+                         USB_SETUP_REQUEST_TYPE_CLASS |
+                         USB_SETUP_REQUEST_RECIPIENT_INTERFACE;
+    notification->request = USB_CDC_MGNT_NOTIF_NETWORK_CONNECTION;
+    notification->value = 1;
+    notification->index = cdcncm->iface_ctrl.idx;
+    notification->length = 0;
+    usbdev_ep_ready(cdcncm->ep_ctrl->ep, sizeof(usb_setup_t));
+    cdcncm->notif = USBUS_CDCNCM_NOTIF_LINK_UP;
+}
+
+static const usbus_handler_driver_t cdcncm_driver = {
+    .init = _init,
+    .event_handler = _event_handler,
+    .transfer_handler = _transfer_handler,
+    .control_handler = _control_handler,
+};
+
+static void _fill_ethernet(usbus_cdcncm_device_t *cdcncm)
+{
+    uint8_t ethernet[ETHERNET_ADDR_LEN];
+
+    luid_get_eui48((eui48_t*)ethernet);
+    fmt_bytes_hex(cdcncm->mac_host, ethernet, sizeof(ethernet));
+}
+
+static void _tx_reset(usbus_cdcncm_device_t *cdcncm)
+{
+    mutex_lock(&cdcncm->tx_lock);
+    for (unsigned i = 0; i < ARRAY_SIZE(cdcncm->tx); i++) {
+        cdcncm->tx[i].len = USBUS_CDCNCM_NTB_IN_DATA_OFFSET;
+        cdcncm->tx[i].count = 0;
+    }
+    cdcncm->tx_fill = 0;
+    cdcncm->tx_busy = false;
+    cdcncm->tx_seq = 0;
+    cdcncm->ntb_in_size = CONFIG_USBUS_CDC_NCM_NTB_IN_SIZE;
+    mutex_unlock(&cdcncm->tx_lock);
+    /* wake up a sender waiting for an NTB, it finds the link down */
+    mutex_unlock(&cdcncm->tx_done);
+}
+
+void usbus_cdcncm_init(usbus_t *usbus, usbus_cdcncm_device_t *handler)
+{
+    assert(usbus);
+    assert(handler);
+    memset(handler, 0, sizeof(usbus_cdcncm_device_t));
+    mutex_init(&handler->tx_lock);
+    mutex_init(&handler->tx_done);
+    _tx_reset(handler);
+    _fill_ethernet(handler);
+    handler->usbus = usbus;
+    handler->handler_ctrl.driver = &cdcncm_driver;
+    usbus_register_event_handler(usbus, (usbus_handler_t *)handler);
+}
+
+static void _init(usbus_t *usbus, usbus_handler_t *handler)
+{
+    DEBUG("CDC NCM: initialization\n");
+    usbus_cdcncm_device_t *cdcncm = (usbus_cdcncm_device_t *)handler;
+
+    /* Add event handlers */
+    cdcncm->tx_xmit.handler = _handle_tx_xmit;
+    cdcncm->rx_flush.handler = _handle_rx_flush_ev;
+
+    /* Set up descriptor generators */
+    cdcncm->ncm_descr.next = NULL;
+    cdcncm->ncm_descr.funcs = &_ncm_descriptor;
+    cdcncm->ncm_descr.arg = cdcncm;
+
+    /* Configure Interface 0 as control interface */
+    cdcncm->iface_ctrl.class = USB_CLASS_CDC_CONTROL;
+    cdcncm->iface_ctrl.subclass = USB_CDC_SUBCLASS_NCM;
+    cdcncm->iface_ctrl.protocol = USB_CDC_PROTOCOL_NONE;
+    cdcncm->iface_ctrl.descr_gen = &cdcncm->ncm_descr;
+    cdcncm->iface_ctrl.handler = handler;
+
+    /* Configure second interface to handle data endpoint */
+    cdcncm->iface_data.class = USB_CLASS_CDC_DATA;
+    cdcncm->iface_data.subclass = USB_CDC_SUBCLASS_NONE;
+    cdcncm->iface_data.protocol = USB_CDC_DATA_PROTOCOL_NTB;
+    cdcncm->iface_data.descr_gen = NULL;
+    cdcncm->iface_data.handler = handler;
+
+    /* Add string descriptor for the host mac */
+    usbus_add_string_descriptor(usbus, &cdcncm->mac_str, cdcncm->mac_host);
+
+    /* Create required endpoints */
+    cdcncm->ep_ctrl = usbus_add_endpoint(usbus, &cdcncm->iface_ctrl,
+                                         USB_EP_TYPE_INTERRUPT,
+                                         USB_EP_DIR_IN,
+                                         USBUS_CDCNCM_EP_CTRL_SIZE);
+    cdcncm->ep_ctrl->interval = 0x10;
+
+    cdcncm->ep_out = usbus_add_endpoint(usbus,
+                                        (usbus_interface_t *)&cdcncm->iface_data_alt,
+                                        USB_EP_TYPE_BULK,
+                                        USB_EP_DIR_OUT,
+                                        USBUS_CDCNCM_EP_DATA_SIZE);
+    cdcncm->ep_out->interval = 0; /* Must be 0 for bulk endpoints */
+    cdcncm->ep_in = usbus_add_endpoint(usbus,
+                                       (usbus_interface_t *)&cdcncm->iface_data_alt,
+                                       USB_EP_TYPE_BULK,
+                                       USB_EP_DIR_IN,
+                                       USBUS_CDCNCM_EP_DATA_SIZE);
+    cdcncm->ep_in->interval = 0; /* Must be 0 for bulk endpoints */
+
+    /* Add interfaces to the stack */
+    usbus_add_interface(usbus, &cdcncm->iface_ctrl);
+    usbus_add_interface(usbus, &cdcncm->iface_data);
+
+    cdcncm->iface_data.alts = &cdcncm->iface_data_alt;
+
+    cdcncm->multi_packet = usbdev_ep_xfer_supported(cdcncm->ep_out->ep) &&
+                           usbdev_ep_xfer_supported(cdcncm->ep_in->ep);
+
+    usbus_enable_endpoint(cdcncm->ep_out);
+    usbus_enable_endpoint(cdcncm->ep_in);
+    usbus_enable_endpoint(cdcncm->ep_ctrl);
+    usbus_handler_set_flag(handler, USBUS_HANDLER_FLAG_RESET);
+}
+
+static void _rx_ready(usbus_cdcncm_device_t *cdcncm)
+{
+    cdcncm->rx_fill = 0;
+    if (cdcncm->multi_packet) {
+        /* receive the whole NTB straight into the buffer */
+        usbdev_ep_xfer(cdcncm->ep_out->ep, cdcncm->rx_buf,
+                       sizeof(cdcncm->rx_buf));
+    }
+    else {
+        usbdev_ep_ready(cdcncm->ep_out->ep, 0);
+    }
+}
+
+static void _rx_complete(usbus_cdcncm_device_t *cdcncm, size_t len)
+{
+    if (len) {
+        /* the endpoint stays busy until the netdev flushes the NTB */
+        cdcncm->rx_len = len;
+        netdev_trigger_event_isr(&cdcncm->netdev);
+    }
+    else {
+        _rx_ready(cdcncm);
+    }
+}
+
+static void _tx_packet(usbus_cdcncm_device_t *cdcncm)
+{
+    const uint8_t *ntb = cdcncm->tx[cdcncm->tx_fill ^ 1].buf;
+    size_t len = cdcncm->tx_len - cdcncm->tx_offset;
+
+    if (len > USBUS_CDCNCM_EP_DATA_SIZE) {
+        len = USBUS_CDCNCM_EP_DATA_SIZE;
+    }
+    memcpy(cdcncm->ep_in->ep->buf, ntb + cdcncm->tx_offset, len);
+    cdcncm->tx_offset += len;
+    usbdev_ep_ready(cdcncm->ep_in->ep, len);
+}
+
+/* completes the header and the datagram pointer table */
+static size_t _tx_finalize(usbus_cdcncm_device_t *cdcncm,
+                           usbus_cdcncm_ntb_t *ntb)
+{
+    usb_cdc_ncm_nth16_t *nth = (usb_cdc_ncm_nth16_t *)ntb->buf;
+    usb_cdc_ncm_ndp16_t *ndp = (usb_cdc_ncm_ndp16_t *)(nth + 1);
+    usb_cdc_ncm_dpe16_t *dpe = (usb_cdc_ncm_dpe16_t *)(ndp + 1);
+    size_t len = ntb->len;
+
+    /* never end on a packet boundary, so no zero length packet is needed,
+     * there is always room for the extra byte */
+    if ((len % USBUS_CDCNCM_EP_DATA_SIZE) == 0) {
+        ntb->buf[len++] = 0;
+    }
+
+    nth->signature = USB_CDC_NCM_NTH16_SIGNATURE;
+    nth->header_length = sizeof(usb_cdc_ncm_nth16_t);
+    nth->sequence = cdcncm->tx_seq++;
+    nth->block_length = len;
+    nth->ndp_index = sizeof(usb_cdc_ncm_nth16_t);
+
+    ndp->signature = USB_CDC_NCM_NDP16_SIGNATURE;
+    ndp->length = sizeof(usb_cdc_ncm_ndp16_t) +
+                  (ntb->count + 1) * sizeof(usb_cdc_ncm_dpe16_t);
+    ndp->next_index = 0;
+    dpe[ntb->count].index = 0;
+    dpe[ntb->count].length = 0;
+    return len;
+}
+
+/* sends the NTB being filled if there is one and the endpoint is idle */
+static void _tx_start(usbus_cdcncm_device_t *cdcncm)
+{
+    usbus_t *usbus = cdcncm->usbus;
+
+    mutex_lock(&cdcncm->tx_lock);
+    usbus_cdcncm_ntb_t *ntb = &cdcncm->tx[cdcncm->tx_fill];
+    if (cdcncm->tx_busy || !ntb->count) {
+        mutex_unlock(&cdcncm->tx_lock);
+        return;
+    }
+    if (usbus->state != USBUS_STATE_CONFIGURED || cdcncm->active_iface == 0) {
+        DEBUG("CDC NCM: not configured, dropping NTB\n");
+        ntb->len = USBUS_CDCNCM_NTB_IN_DATA_OFFSET;
+        ntb->count = 0;
+        mutex_unlock(&cdcncm->tx_lock);
+        mutex_unlock(&cdcncm->tx_done);
+        return;
+    }
+    cdcncm->tx_len = _tx_finalize(cdcncm, ntb);
+    cdcncm->tx_offset = 0;
+    cdcncm->tx_busy = true;
+    /* senders continue with the other NTB while this one is sent */
+    cdcncm->tx_fill ^= 1;
+    cdcncm->tx[cdcncm->tx_fill].len = USBUS_CDCNCM_NTB_IN_DATA_OFFSET;
+    cdcncm->tx[cdcncm->tx_fill].count = 0;
+    mutex_unlock(&cdcncm->tx_lock);
+    mutex_unlock(&cdcncm->tx_done);
+
+    DEBUG("CDC NCM: sending NTB of %u datagrams, %u bytes\n",
+          ntb->count, (unsigned)cdcncm->tx_len);
+    if (cdcncm->multi_packet) {
+        usbdev_ep_xfer(cdcncm->ep_in->ep, ntb->buf, cdcncm->tx_len);
+    }
+    else {
+        _tx_packet(cdcncm);
+    }
+}
+
+static int _control_handler(usbus_t *usbus, usbus_handler_t *handler,
+                          usbus_control_request_state_t state,
+                          usb_setup_t *setup)
+{
+    usbus_cdcncm_device_t *cdcncm = (usbus_cdcncm_device_t *)handler;
+    DEBUG("CDC NCM: Request: 0x%x\n", setup->request);
+    switch (setup->request) {
+        case USB_SETUP_REQ_SET_INTERFACE:
+            DEBUG("CDC NCM: Changing active interface to alt %d\n",
+                  setup->value);
+            cdcncm->active_iface = (uint8_t)setup->value;
+            if (cdcncm->active_iface == 1) {
+                _rx_ready(cdcncm);
+                _notify_link_up(cdcncm);
+            }
+            else {
+                /* NCM requires the NTB state to start over */
+                _tx_reset(cdcncm);
+            }
+            break;
+
+        case USB_CDC_MGNT_REQUEST_SET_ETH_PACKET_FILTER:
+            /* While we do answer the request, filters are not really
+             * implemented */
+            DEBUG("CDC NCM: Not modifying filter to 0x%x\n", setup->value);
+            break;
+
+        case USB_CDC_MGNT_REQUEST_GET_NTB_PARAMETERS: {
+            usb_cdc_ncm_ntb_params_t params = {
+                .length = sizeof(usb_cdc_ncm_ntb_params_t),
+                .formats = 0x0001, /* NTB16 only */
+                .in_max_size = CONFIG_USBUS_CDC_NCM_NTB_IN_SIZE,
+                .in_divisor = 4,
+                .in_remainder = 0,
+                .in_alignment = 4,
+                .out_max_size = CONFIG_USBUS_CDC_NCM_NTB_OUT_SIZE,
+                .out_divisor = 4,
+                .out_remainder = 0,
+                .out_alignment = 4,
+                .out_max_datagrams = 0,
+            };
+            usbus_control_slicer_put_bytes(usbus, (uint8_t *)&params,
+                                           sizeof(params));
+            break;
+        }
+
+        case USB_CDC_MGNT_REQUEST_GET_NTB_INPUT_SIZE: {
+            uint32_t size = cdcncm->ntb_in_size;
+            usbus_control_slicer_put_bytes(usbus, (uint8_t *)&size,
+                                           sizeof(size));
+            break;
+        }
+
+        case USB_CDC_MGNT_REQUEST_SET_NTB_INPUT_SIZE:
+            if (state == USBUS_CONTROL_REQUEST_STATE_OUTDATA) {
+                size_t len = 0;
+                uint8_t *data = usbus_control_get_out_data(usbus, &len);
+                uint32_t size;
+
+                if (len < sizeof(size)) {
+                    return -1;
+                }
+                memcpy(&size, data, sizeof(size));
+                if (size < USBUS_CDCNCM_NTB_IN_DATA_OFFSET +
+                           ETHERNET_FRAME_LEN + 1) {
+                    DEBUG("CDC NCM: NTB input size %" PRIu32 " too small\n",
+                          size);
+                    return -1;
+                }
+                cdcncm->ntb_in_size = (size < CONFIG_USBUS_CDC_NCM_NTB_IN_SIZE)
+                                    ? size : CONFIG_USBUS_CDC_NCM_NTB_IN_SIZE;
+            }
+            break;
+
+        default:
+            return -1;
+    }
+
+    return 1;
+}
+
+static void _handle_tx_xmit(event_t *ev)
+{
+    usbus_cdcncm_device_t *cdcncm = container_of(ev, usbus_cdcncm_device_t,
+                                                 tx_xmit);
+
+    DEBUG("CDC NCM: Handling TX xmit from netdev\n");
+    _tx_start(cdcncm);
+}
+
+static void _handle_in_complete(usbus_cdcncm_device_t *cdcncm)
+{
+    if (!cdcncm->multi_packet && cdcncm->tx_offset < cdcncm->tx_len) {
+        _tx_packet(cdcncm);
+        return;
+    }
+    mutex_lock(&cdcncm->tx_lock);
+    cdcncm->tx_busy = false;
+    mutex_unlock(&cdcncm->tx_lock);
+    /* send what accumulated in the meantime */
+    _tx_start(cdcncm);
+}
+
+static void _handle_rx_flush_ev(event_t *ev)
+{
+    usbus_cdcncm_device_t *cdcncm = container_of(ev, usbus_cdcncm_device_t,
+                                                 rx_flush);
+
+    cdcncm->rx_len = 0;
+    if (cdcncm->active_iface == 1) {
+        _rx_ready(cdcncm);
+    }
+}
+
+static void _store_packet(usbus_cdcncm_device_t *cdcncm, size_t len)
+{
+    size_t room = sizeof(cdcncm->rx_buf) - cdcncm->rx_fill;
+
+    if (len > room) {
+        DEBUG("CDC NCM: OUT NTB exceeds the buffer, truncating\n");
+        len = room;
+    }
+    memcpy(cdcncm->rx_buf + cdcncm->rx_fill, cdcncm->ep_out->ep->buf, len);
+    cdcncm->rx_fill += len;
+    if (len == USBUS_CDCNCM_EP_DATA_SIZE &&
+        cdcncm->rx_fill < sizeof(cdcncm->rx_buf)) {
+        usbdev_ep_ready(cdcncm->ep_out->ep, 0);
+    }
+    else {
+        /* a short packet or a full buffer ends the NTB */
+        _rx_complete(cdcncm, cdcncm->rx_fill);
+    }
+}
+
+static void _transfer_handler(usbus_t *usbus, usbus_handler_t *handler,
+                             usbdev_ep_t *ep, usbus_event_transfer_t event)
+{
+    (void)event; /* Only receives TR_COMPLETE events */
+    (void)usbus;
+    usbus_cdcncm_device_t *cdcncm = (usbus_cdcncm_device_t *)handler;
+    if (ep == cdcncm->ep_out->ep) {
+        if (cdcncm->notif == USBUS_CDCNCM_NOTIF_NONE) {
+            _notify_link_up(cdcncm);
+        }
+        size_t len = 0;
+        usbdev_ep_get(ep, USBOPT_EP_AVAILABLE, &len, sizeof(size_t));
+        if (cdcncm->multi_packet) {
+            _rx_complete(cdcncm, len);
+        }
+        else {
+            _store_packet(cdcncm, len);
+        }
+    }
+    else if (ep == cdcncm->ep_in->ep) {
+        _handle_in_complete(cdcncm);
+    }
+    else if (ep == cdcncm->ep_ctrl->ep &&
+             cdcncm->notif == USBUS_CDCNCM_NOTIF_LINK_UP) {
+        _notify_link_speed(cdcncm);
+    }
+}
+
+static void _handle_reset(usbus_cdcncm_device_t *cdcncm)
+{
+    DEBUG("CDC NCM: Reset\n");
+    cdcncm->rx_len = 0;
+    cdcncm->notif = USBUS_CDCNCM_NOTIF_NONE;
+    cdcncm->active_iface = 0;
+    _tx_reset(cdcncm);
+}
+
+static void _event_handler(usbus_t *usbus, usbus_handler_t *handler,
+                          usbus_event_usb_t event)
+{
+    (void)usbus;
+    switch (event) {
+        case USBUS_EVENT_USB_RESET:
+            _handle_reset((usbus_cdcncm_device_t *)handler);
+            break;
+
+        default:
+            DEBUG("Unhandled event :0x%x\n", event);
+            break;
+    }
+}
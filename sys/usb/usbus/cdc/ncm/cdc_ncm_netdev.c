@@ -0,0 +1,265 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup usbus_cdc_ncm
+ * @{
+ * @file Netdev implementation for network control model
+ *
+ * @author  ML!PA Consulting GmbH
+ * @}
+ */
+
+#define USB_H_USER_IS_RIOT_INTERNAL
+
+#include <errno.h>
+#include <string.h>
+
+#include "kernel_defines.h"
+#include "iolist.h"
+#include "luid.h"
+#include "mutex.h"
+#include "net/ethernet.h"
+#include "net/eui48.h"
+#include "net/netdev.h"
+#include "net/netdev/eth.h"
+#include "usb/usbus/cdc/ncm.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static const netdev_driver_t netdev_driver_cdcncm;
+
+static void _signal_rx_flush(usbus_cdcncm_device_t *cdcncm)
+{
+    usbus_event_post(cdcncm->usbus, &cdcncm->rx_flush);
+}
+
+static void _signal_tx_xmit(usbus_cdcncm_device_t *cdcncm)
+{
+    usbus_event_post(cdcncm->usbus, &cdcncm->tx_xmit);
+}
+
+static usbus_cdcncm_device_t *_netdev_to_cdcncm(netdev_t *netdev)
+{
+    return container_of(netdev, usbus_cdcncm_device_t, netdev);
+}
+
+void cdcncm_netdev_setup(usbus_cdcncm_device_t *cdcncm)
+{
+    cdcncm->netdev.driver = &netdev_driver_cdcncm;
+}
+
+static int _send(netdev_t *netdev, const iolist_t *iolist)
+{
+    assert(iolist);
+    usbus_cdcncm_device_t *cdcncm = _netdev_to_cdcncm(netdev);
+    size_t len = iolist_size(iolist);
+    usbus_cdcncm_ntb_t *ntb;
+    size_t offset;
+
+    /* interface with alternative function ID 1 is the interface containing the
+     * data endpoints, no sense trying to transmit data if it is not active */
+    if (cdcncm->active_iface != 1) {
+        return -ENOTCONN;
+    }
+    /* one byte is kept free to avoid zero length packets */
+    if (USBUS_CDCNCM_NTB_IN_DATA_OFFSET + len >= cdcncm->ntb_in_size) {
+        return -EMSGSIZE;
+    }
+    DEBUG("CDC NCM netdev: sending %u bytes\n", (unsigned)len);
+
+    mutex_lock(&cdcncm->tx_lock);
+    for (;;) {
+        ntb = &cdcncm->tx[cdcncm->tx_fill];
+        offset = (ntb->len + 3) & ~3;
+        if (ntb->count < CONFIG_USBUS_CDC_NCM_MAX_DATAGRAMS &&
+            offset + len < cdcncm->ntb_in_size) {
+            break;
+        }
+        /* the NTB is full, wait for the other one to become available */
+        mutex_unlock(&cdcncm->tx_lock);
+        _signal_tx_xmit(cdcncm);
+        mutex_lock(&cdcncm->tx_done);
+        if (cdcncm->active_iface != 1) {
+            return -ENOTCONN;
+        }
+        mutex_lock(&cdcncm->tx_lock);
+    }
+
+    usb_cdc_ncm_dpe16_t *dpe = (usb_cdc_ncm_dpe16_t *)
+        (ntb->buf + sizeof(usb_cdc_ncm_nth16_t) + sizeof(usb_cdc_ncm_ndp16_t));
+    dpe[ntb->count].index = offset;
+    dpe[ntb->count].length = len;
+    ntb->count++;
+    ntb->len = offset + len;
+    for (; iolist; iolist = iolist->iol_next) {
+        memcpy(ntb->buf + offset, iolist->iol_base, iolist->iol_len);
+        offset += iolist->iol_len;
+    }
+    /* the first datagram starts the transmission, the following ones are
+     * aggregated until the endpoint is idle again */
+    bool start = !cdcncm->tx_busy && ntb->count == 1;
+    mutex_unlock(&cdcncm->tx_lock);
+    if (start) {
+        _signal_tx_xmit(cdcncm);
+    }
+    return len;
+}
+
+/* sets up the NDP at offset, which must follow the current one */
+static void _rx_ndp(usbus_cdcncm_device_t *cdcncm, size_t offset)
+{
+    const usb_cdc_ncm_ndp16_t *ndp =
+        (const usb_cdc_ncm_ndp16_t *)(cdcncm->rx_buf + offset);
+
+    /* increasing offsets also rule out loops of NDPs */
+    if (offset <= cdcncm->rx_ndp || (offset & 3) ||
+        offset + sizeof(usb_cdc_ncm_ndp16_t) > cdcncm->rx_len ||
+        ndp->signature != USB_CDC_NCM_NDP16_SIGNATURE ||
+        offset + ndp->length > cdcncm->rx_len) {
+        if (offset) {
+            DEBUG("CDC NCM netdev: invalid NDP at %u\n", (unsigned)offset);
+        }
+        cdcncm->rx_ndp = 0;
+        return;
+    }
+    cdcncm->rx_ndp = offset;
+    cdcncm->rx_dpe = offset + sizeof(usb_cdc_ncm_ndp16_t);
+}
+
+static void _rx_ntb(usbus_cdcncm_device_t *cdcncm)
+{
+    const usb_cdc_ncm_nth16_t *nth = (const usb_cdc_ncm_nth16_t *)cdcncm->rx_buf;
+
+    cdcncm->rx_ndp = 0;
+    if (cdcncm->rx_len < sizeof(usb_cdc_ncm_nth16_t) ||
+        nth->signature != USB_CDC_NCM_NTH16_SIGNATURE ||
+        nth->header_length != sizeof(usb_cdc_ncm_nth16_t) ||
+        nth->block_length > cdcncm->rx_len) {
+        DEBUG("CDC NCM netdev: dropping invalid NTB\n");
+        return;
+    }
+    /* a block length of 0 means the NTB ends with the transfer */
+    if (nth->block_length) {
+        cdcncm->rx_len = nth->block_length;
+    }
+    _rx_ndp(cdcncm, nth->ndp_index);
+}
+
+/* advances to the next valid datagram, false if there is none */
+static bool _rx_next(usbus_cdcncm_device_t *cdcncm)
+{
+    while (cdcncm->rx_ndp) {
+        const usb_cdc_ncm_ndp16_t *ndp =
+            (const usb_cdc_ncm_ndp16_t *)(cdcncm->rx_buf + cdcncm->rx_ndp);
+
+        while (cdcncm->rx_dpe + sizeof(usb_cdc_ncm_dpe16_t) <=
+               cdcncm->rx_ndp + ndp->length) {
+            const usb_cdc_ncm_dpe16_t *dpe =
+                (const usb_cdc_ncm_dpe16_t *)(cdcncm->rx_buf + cdcncm->rx_dpe);
+            if (!dpe->index || !dpe->length) {
+                /* end of the table */
+                break;
+            }
+            if ((size_t)dpe->index + dpe->length <= cdcncm->rx_len) {
+                return true;
+            }
+            DEBUG("CDC NCM netdev: dropping datagram beyond the NTB\n");
+            cdcncm->rx_dpe += sizeof(usb_cdc_ncm_dpe16_t);
+        }
+        _rx_ndp(cdcncm, ndp->next_index);
+    }
+    return false;
+}
+
+static int _recv(netdev_t *netdev, void *buf, size_t max_len, void *info)
+{
+    usbus_cdcncm_device_t *cdcncm = _netdev_to_cdcncm(netdev);
+    const usb_cdc_ncm_dpe16_t *dpe =
+        (const usb_cdc_ncm_dpe16_t *)(cdcncm->rx_buf + cdcncm->rx_dpe);
+    size_t len = dpe->length;
+
+    (void)info;
+    if (buf == NULL) {
+        /* size requested or datagram dropped, _isr moves on either way */
+        return len;
+    }
+    if (len > max_len) {
+        return -ENOBUFS;
+    }
+    memcpy(buf, cdcncm->rx_buf + dpe->index, len);
+    return len;
+}
+
+static int _init(netdev_t *netdev)
+{
+    usbus_cdcncm_device_t *cdcncm = _netdev_to_cdcncm(netdev);
+
+    luid_get_eui48((eui48_t*)cdcncm->mac_netdev);
+    return 0;
+}
+
+static int _get(netdev_t *netdev, netopt_t opt, void *value, size_t max_len)
+{
+    usbus_cdcncm_device_t *cdcncm = _netdev_to_cdcncm(netdev);
+
+    (void)max_len;
+
+    switch (opt) {
+        case NETOPT_ADDRESS:
+            assert(max_len >= ETHERNET_ADDR_LEN);
+            memcpy(value, cdcncm->mac_netdev, ETHERNET_ADDR_LEN);
+            return ETHERNET_ADDR_LEN;
+        default:
+            return netdev_eth_get(netdev, opt, value, max_len);
+    }
+}
+
+static int _set(netdev_t *netdev, netopt_t opt, const void *value,
+                size_t value_len)
+{
+    usbus_cdcncm_device_t *cdcncm = _netdev_to_cdcncm(netdev);
+
+    switch (opt) {
+        case NETOPT_ADDRESS:
+            assert(value_len == ETHERNET_ADDR_LEN);
+            memcpy(cdcncm->mac_netdev, value, ETHERNET_ADDR_LEN);
+            return ETHERNET_ADDR_LEN;
+        default:
+            return netdev_eth_set(netdev, opt, value, value_len);
+    }
+}
+
+static void _isr(netdev_t *dev)
+{
+    usbus_cdcncm_device_t *cdcncm = _netdev_to_cdcncm(dev);
+
+    if (!cdcncm->rx_len) {
+        return;
+    }
+    /* hand all datagrams of the NTB to the stack in one go */
+    _rx_ntb(cdcncm);
+    while (_rx_next(cdcncm)) {
+        cdcncm->netdev.event_callback(&cdcncm->netdev,
+                                      NETDEV_EVENT_RX_COMPLETE);
+        cdcncm->rx_dpe += sizeof(usb_cdc_ncm_dpe16_t);
+    }
+    /* the buffer is only written again once the flush re-arms the endpoint */
+    cdcncm->rx_len = 0;
+    _signal_rx_flush(cdcncm);
+}
+
+static const netdev_driver_t netdev_driver_cdcncm = {
+    .send = _send,
+    .recv = _recv,
+    .init = _init,
+    .isr = _isr,
+    .get = _get,
+    .set = _set,
+};
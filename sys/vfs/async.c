@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_vfs_async
+ * @{
+ *
+ * @file
+ * @brief       Asynchronous VFS I/O worker
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "vfs.h"
+#include "vfs_async.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define VFS_ASYNC_FLAG_PENDING  (1U << 0)
+
+enum {
+    VFS_AIO_READ,
+    VFS_AIO_WRITE,
+};
+
+static void _complete(vfs_async_worker_t *worker, vfs_aio_t *req)
+{
+    event_queue_t *queue = req->queue;
+    event_t *event = req->event;
+    thread_t *thread = req->thread;
+    thread_flags_t flags = req->flags;
+
+    mutex_lock(&worker->lock);
+    worker->stats.completed++;
+    mutex_unlock(&worker->lock);
+
+    /* the request may be reused as soon as it is signaled */
+    if (event) {
+        event_post(queue, event);
+    }
+    if (thread) {
+        thread_flags_set(thread, flags);
+    }
+}
+
+static vfs_aio_t *_pop(vfs_async_worker_t *worker)
+{
+    mutex_lock(&worker->lock);
+    clist_node_t *node = clist_lpop(&worker->queue);
+    if (node) {
+        worker->stats.depth--;
+    }
+    mutex_unlock(&worker->lock);
+
+    return node ? container_of(node, vfs_aio_t, node) : NULL;
+}
+
+#if CONFIG_VFS_ASYNC_COALESCE_SIZE
+/* merge writes to the same fd that directly follow @p req in the queue */
+static void _write_coalesced(vfs_async_worker_t *worker, vfs_aio_t *req)
+{
+    clist_node_t batch = { NULL };
+    size_t len = req->len;
+
+    mutex_lock(&worker->lock);
+    clist_node_t *node;
+    while ((node = clist_lpeek(&worker->queue))) {
+        vfs_aio_t *next = container_of(node, vfs_aio_t, node);
+        if ((next->op != VFS_AIO_WRITE) || (next->fd != req->fd) ||
+            (len + next->len > sizeof(worker->buf))) {
+            break;
+        }
+        clist_lpop(&worker->queue);
+        clist_rpush(&batch, node);
+        worker->stats.depth--;
+        worker->stats.coalesced++;
+        len += next->len;
+    }
+    mutex_unlock(&worker->lock);
+
+    if (batch.next == NULL) {
+        req->res = vfs_write(req->fd, req->buf.src, req->len);
+        _complete(worker, req);
+        return;
+    }
+
+    uint8_t *pos = worker->buf;
+    memcpy(pos, req->buf.src, req->len);
+    pos += req->len;
+    for (node = batch.next->next; ; node = node->next) {
+        vfs_aio_t *next = container_of(node, vfs_aio_t, node);
+        memcpy(pos, next->buf.src, next->len);
+        pos += next->len;
+        if (node == batch.next) {
+            break;
+        }
+    }
+
+    ssize_t res = vfs_write(req->fd, worker->buf, len);
+    DEBUG("vfs_async: coalesced write of %u bytes: %d\n",
+          (unsigned)len, (int)res);
+
+    /* hand out the written bytes in order, errors go to every request */
+    while (req) {
+        if (res < 0) {
+            req->res = res;
+        }
+        else {
+            req->res = ((size_t)res < req->len) ? res : (ssize_t)req->len;
+            res -= req->res;
+        }
+        _complete(worker, req);
+
+        node = clist_lpop(&batch);
+        req = node ? container_of(node, vfs_aio_t, node) : NULL;
+    }
+}
+#endif
+
+static void *_worker_thread(void *arg)
+{
+    vfs_async_worker_t *worker = arg;
+
+    while (1) {
+        thread_flags_wait_any(VFS_ASYNC_FLAG_PENDING);
+
+        vfs_aio_t *req;
+        while ((req = _pop(worker))) {
+            if (req->op == VFS_AIO_READ) {
+                req->res = vfs_read(req->fd, req->buf.dest, req->len);
+                _complete(worker, req);
+                continue;
+            }
+#if CONFIG_VFS_ASYNC_COALESCE_SIZE
+            if (req->len < sizeof(worker->buf)) {
+                _write_coalesced(worker, req);
+                continue;
+            }
+#endif
+            req->res = vfs_write(req->fd, req->buf.src, req->len);
+            _complete(worker, req);
+        }
+    }
+
+    return NULL;
+}
+
+void vfs_async_worker_init(vfs_async_worker_t *worker, char *stack,
+                           int stacksize, uint8_t prio, const char *name)
+{
+    memset(worker, 0, sizeof(*worker));
+    mutex_init(&worker->lock);
+
+    worker->pid = thread_create(stack, stacksize, prio, THREAD_CREATE_STACKTEST,
+                                _worker_thread, worker, name);
+}
+
+static int _queue(vfs_async_worker_t *worker, vfs_aio_t *req)
+{
+    mutex_lock(&worker->lock);
+    clist_rpush(&worker->queue, &req->node);
+    if (++worker->stats.depth > worker->stats.depth_max) {
+        worker->stats.depth_max = worker->stats.depth;
+    }
+    mutex_unlock(&worker->lock);
+
+    thread_flags_set((thread_t *)thread_get(worker->pid),
+                     VFS_ASYNC_FLAG_PENDING);
+    return 0;
+}
+
+int vfs_read_async(vfs_async_worker_t *worker, vfs_aio_t *req, int fd,
+                   void *dest, size_t count)
+{
+    if (dest == NULL) {
+        return -EINVAL;
+    }
+
+    req->op = VFS_AIO_READ;
+    req->fd = fd;
+    req->buf.dest = dest;
+    req->len = count;
+
+    return _queue(worker, req);
+}
+
+int vfs_write_async(vfs_async_worker_t *worker, vfs_aio_t *req, int fd,
+                    const void *src, size_t count)
+{
+    if (src == NULL) {
+        return -EINVAL;
+    }
+
+    req->op = VFS_AIO_WRITE;
+    req->fd = fd;
+    req->buf.src = src;
+    req->len = count;
+
+    return _queue(worker, req);
+}
+
+void vfs_async_stats_get(vfs_async_worker_t *worker, vfs_async_stats_t *stats)
+{
+    mutex_lock(&worker->lock);
+    *stats = worker->stats;
+    mutex_unlock(&worker->lock);
+}
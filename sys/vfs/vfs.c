@@ -28,6 +28,7 @@
 #include "thread.h"
 #include "kernel_types.h"
 #include "clist.h"
+#include "bitarithm.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -50,12 +51,28 @@
  */
 static vfs_file_t _vfs_open_files[VFS_MAX_OPEN_FILES];
 
+/**
+ * @internal
+ * @brief Number of bits per word of the fd bitmap
+ */
+#define VFS_FD_WORD_BITS    (8 * sizeof(unsigned))
+
+/**
+ * @internal
+ * @brief Bitmap of used entries in the _vfs_open_files array
+ *
+ * Allows to find a free fd a word at a time instead of checking every entry.
+ */
+static unsigned _vfs_used_fds[(VFS_MAX_OPEN_FILES + VFS_FD_WORD_BITS - 1) /
+                              VFS_FD_WORD_BITS];
+
 /**
  * @internal
  * @brief List handle for list of all currently mounted file systems
  *
  * This singly linked list is used to dispatch vfs calls to the appropriate file
- * system driver.
+ * system driver. It is kept sorted by descending mount point length, so the
+ * first matching entry is the longest matching prefix.
  */
 static clist_node_t _vfs_mounts_list;
 
@@ -129,7 +146,17 @@ static inline int _find_mount(vfs_mount_t **mountpp, const char *name, const cha
  */
 static inline int _fd_is_valid(int fd);
 
+/**
+ * @internal
+ * @brief Protects _vfs_mounts_list, only held while the list is accessed
+ */
 static mutex_t _mount_mutex = MUTEX_INIT;
+/**
+ * @internal
+ * @brief Serializes mount, umount and format, which call into the file system
+ * driver without holding _mount_mutex
+ */
+static mutex_t _fs_op_mutex = MUTEX_INIT;
 static mutex_t _open_mutex = MUTEX_INIT;
 
 int vfs_close(int fd)
@@ -249,6 +276,39 @@ off_t vfs_lseek(int fd, off_t off, int whence)
     return filp->f_op->lseek(filp, off, whence);
 }
 
+int vfs_mmap(int fd, const void **addr, size_t *len)
+{
+    DEBUG("vfs_mmap: %d, %p, %p\n", fd, (void *)addr, (void *)len);
+    if ((addr == NULL) || (len == NULL)) {
+        return -EFAULT;
+    }
+    int res = _fd_is_valid(fd);
+    if (res < 0) {
+        return res;
+    }
+    vfs_file_t *filp = &_vfs_open_files[fd];
+    if (filp->f_op->mmap == NULL) {
+        /* driver does not implement mmap() */
+        return -ENOTSUP;
+    }
+    return filp->f_op->mmap(filp, addr, len);
+}
+
+int vfs_poll(int fd)
+{
+    DEBUG("vfs_poll: %d\n", fd);
+    int res = _fd_is_valid(fd);
+    if (res < 0) {
+        return res;
+    }
+    vfs_file_t *filp = &_vfs_open_files[fd];
+    if (filp->f_op->poll == NULL) {
+        /* driver does not implement poll() */
+        return -ENOTSUP;
+    }
+    return filp->f_op->poll(filp);
+}
+
 int vfs_open(const char *name, int flags, mode_t mode)
 {
     DEBUG("vfs_open: \"%s\", 0x%x, 0%03lo\n", name, flags, (long unsigned int)mode);
@@ -411,7 +471,7 @@ int vfs_closedir(vfs_DIR *dirp)
 /**
  * @brief Check if the given mount point is mounted
  *
- * If the mount point is not mounted, _mount_mutex will be locked by this function
+ * The caller has to hold _fs_op_mutex, so the result stays valid
  *
  * @param mountp    mount point to check
  * @return 0 on success (mount point is valid and not mounted)
@@ -429,61 +489,83 @@ static int check_mount(vfs_mount_t *mountp)
         DEBUG("vfs: check_mount: not absolute mount_point path\n");
         return -EINVAL;
     }
-    mountp->mount_point_len = strlen(mountp->mount_point);
     mutex_lock(&_mount_mutex);
     /* Check for the same mount in the list of mounts to avoid loops */
     clist_node_t *found = clist_find(&_vfs_mounts_list, &mountp->list_entry);
+    mutex_unlock(&_mount_mutex);
     if (found != NULL) {
         /* Same mount is already mounted */
-        mutex_unlock(&_mount_mutex);
         DEBUG("vfs: check_mount: Already mounted\n");
         return -EBUSY;
     }
+    /* only update the length of mounts that are not in the sorted list */
+    mountp->mount_point_len = strlen(mountp->mount_point);
 
     return 0;
 }
 
+static int _mount_cmp(clist_node_t *a, clist_node_t *b)
+{
+    vfs_mount_t *ma = container_of(a, vfs_mount_t, list_entry);
+    vfs_mount_t *mb = container_of(b, vfs_mount_t, list_entry);
+
+    /* longest mount point first */
+    return (int)mb->mount_point_len - (int)ma->mount_point_len;
+}
+
+static void _mount_insert(vfs_mount_t *mountp)
+{
+    mutex_lock(&_mount_mutex);
+    clist_rpush(&_vfs_mounts_list, &mountp->list_entry);
+    clist_sort(&_vfs_mounts_list, _mount_cmp);
+    mutex_unlock(&_mount_mutex);
+}
+
 int vfs_format(vfs_mount_t *mountp)
 {
     DEBUG("vfs_format: %p\n", (void *)mountp);
+    mutex_lock(&_fs_op_mutex);
     int ret = check_mount(mountp);
     if (ret < 0) {
+        mutex_unlock(&_fs_op_mutex);
         return ret;
     }
-    mutex_unlock(&_mount_mutex);
 
+    /* Format operation not supported */
+    ret = -ENOTSUP;
     if (mountp->fs->fs_op != NULL) {
         if (mountp->fs->fs_op->format != NULL) {
-            return mountp->fs->fs_op->format(mountp);
+            ret = mountp->fs->fs_op->format(mountp);
         }
     }
-
-    /* Format operation not supported */
-    return -ENOTSUP;
+    mutex_unlock(&_fs_op_mutex);
+    return ret;
 }
 
 int vfs_mount(vfs_mount_t *mountp)
 {
     DEBUG("vfs_mount: %p\n", (void *)mountp);
+    mutex_lock(&_fs_op_mutex);
     int ret = check_mount(mountp);
     if (ret < 0) {
+        mutex_unlock(&_fs_op_mutex);
         return ret;
     }
 
+    /* lookups on other mounts continue while the driver mounts */
     if (mountp->fs->fs_op != NULL) {
         if (mountp->fs->fs_op->mount != NULL) {
             /* yes, a file system driver does not need to implement mount/umount */
             int res = mountp->fs->fs_op->mount(mountp);
             if (res < 0) {
                 DEBUG("vfs_mount: error %d\n", res);
-                mutex_unlock(&_mount_mutex);
+                mutex_unlock(&_fs_op_mutex);
                 return res;
             }
         }
     }
-    /* insert last in list */
-    clist_rpush(&_vfs_mounts_list, &mountp->list_entry);
-    mutex_unlock(&_mount_mutex);
+    _mount_insert(mountp);
+    mutex_unlock(&_fs_op_mutex);
     DEBUG("vfs_mount: mount done\n");
     return 0;
 }
@@ -492,44 +574,46 @@ int vfs_mount(vfs_mount_t *mountp)
 int vfs_umount(vfs_mount_t *mountp)
 {
     DEBUG("vfs_umount: %p\n", (void *)mountp);
+    mutex_lock(&_fs_op_mutex);
     int ret = check_mount(mountp);
     switch (ret) {
     case 0:
         DEBUG("vfs_umount: not mounted\n");
-        mutex_unlock(&_mount_mutex);
+        mutex_unlock(&_fs_op_mutex);
         return -EINVAL;
     case -EBUSY:
         /* -EBUSY returned when fs is mounted, just continue */
         break;
     default:
         DEBUG("vfs_umount: invalid fs\n");
+        mutex_unlock(&_fs_op_mutex);
         return -EINVAL;
     }
     DEBUG("vfs_umount: -> \"%s\" open=%d\n", mountp->mount_point, atomic_load(&mountp->open_files));
+    /* _find_mount increments open_files with _mount_mutex held, so once the
+     * mount is removed from the list no new files can be opened on it */
+    mutex_lock(&_mount_mutex);
     if (atomic_load(&mountp->open_files) > 0) {
         mutex_unlock(&_mount_mutex);
+        mutex_unlock(&_fs_op_mutex);
         return -EBUSY;
     }
+    clist_remove(&_vfs_mounts_list, &mountp->list_entry);
+    mutex_unlock(&_mount_mutex);
+
     if (mountp->fs->fs_op != NULL) {
         if (mountp->fs->fs_op->umount != NULL) {
             int res = mountp->fs->fs_op->umount(mountp);
             if (res < 0) {
-                /* umount failed */
+                /* umount failed, make the mount visible again */
                 DEBUG("vfs_umount: ERR %d!\n", res);
-                mutex_unlock(&_mount_mutex);
+                _mount_insert(mountp);
+                mutex_unlock(&_fs_op_mutex);
                 return res;
             }
         }
     }
-    /* find mountp in the list and remove it */
-    clist_node_t *node = clist_remove(&_vfs_mounts_list, &mountp->list_entry);
-    if (node == NULL) {
-        /* not found */
-        DEBUG("vfs_umount: ERR not mounted!\n");
-        mutex_unlock(&_mount_mutex);
-        return -EINVAL;
-    }
-    mutex_unlock(&_mount_mutex);
+    mutex_unlock(&_fs_op_mutex);
     return 0;
 }
 
@@ -867,15 +951,19 @@ const vfs_mount_t *vfs_iterate_mounts(const vfs_mount_t *cur)
 static inline int _allocate_fd(int fd)
 {
     if (fd < 0) {
-        for (fd = 0; fd < VFS_MAX_OPEN_FILES; ++fd) {
-            if ((fd == STDIN_FILENO) || (fd == STDOUT_FILENO) || (fd == STDERR_FILENO)) {
+        fd = VFS_MAX_OPEN_FILES;
+        for (unsigned i = 0; i < ARRAY_SIZE(_vfs_used_fds); ++i) {
+            unsigned free = ~_vfs_used_fds[i];
+            if (i == 0) {
                 /* Do not auto-allocate the stdio file descriptor numbers to
                  * avoid conflicts between normal file system users and stdio
                  * drivers such as stdio_uart, stdio_rtt which need to be able
                  * to bind to these specific file descriptor numbers. */
-                continue;
+                free &= ~((1U << STDIN_FILENO) | (1U << STDOUT_FILENO) |
+                          (1U << STDERR_FILENO));
             }
-            if (_vfs_open_files[fd].pid == KERNEL_PID_UNDEF) {
+            if (free) {
+                fd = i * VFS_FD_WORD_BITS + bitarithm_lsb(free);
                 break;
             }
         }
@@ -895,6 +983,7 @@ static inline int _allocate_fd(int fd)
         pid = -1;
     }
     _vfs_open_files[fd].pid = pid;
+    _vfs_used_fds[fd / VFS_FD_WORD_BITS] |= 1U << (fd % VFS_FD_WORD_BITS);
     return fd;
 }
 
@@ -904,7 +993,10 @@ static inline void _free_fd(int fd)
     if (_vfs_open_files[fd].mp != NULL) {
         atomic_fetch_sub(&_vfs_open_files[fd].mp->open_files, 1);
     }
+    mutex_lock(&_open_mutex);
     _vfs_open_files[fd].pid = KERNEL_PID_UNDEF;
+    _vfs_used_fds[fd / VFS_FD_WORD_BITS] &= ~(1U << (fd % VFS_FD_WORD_BITS));
+    mutex_unlock(&_open_mutex);
 }
 
 static inline int _init_fd(int fd, const vfs_file_ops_t *f_op, vfs_mount_t *mountp, int flags, void *private_data)
@@ -939,10 +1031,6 @@ static inline int _find_mount(vfs_mount_t **mountpp, const char *name, const cha
         node = node->next;
         vfs_mount_t *it = container_of(node, vfs_mount_t, list_entry);
         size_t len = it->mount_point_len;
-        if (len < longest_match) {
-            /* Already found a longer prefix */
-            continue;
-        }
         if (len > name_len) {
             /* path name is shorter than the mount point name */
             continue;
@@ -957,7 +1045,9 @@ static inline int _find_mount(vfs_mount_t **mountpp, const char *name, const cha
             if (len > 1) {
                 longest_match = len;
             }
+            /* the list is sorted, so this is the longest matching prefix */
             mountp = it;
+            break;
         }
     } while (node != _vfs_mounts_list.next);
     if (mountp == NULL) {
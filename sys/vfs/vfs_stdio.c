@@ -29,6 +29,10 @@
 #include "stdio_base.h"
 #include "vfs.h"
 
+#ifdef MODULE_POSIX_POLL
+#include "poll.h"
+#endif
+
 static ssize_t _stdio_read(vfs_file_t *filp, void *dest, size_t nbytes)
 {
     int fd = filp->private_data.value;
@@ -47,12 +51,31 @@ static ssize_t _stdio_write(vfs_file_t *filp, const void *src, size_t nbytes)
     return stdio_write(src, nbytes);
 }
 
+#ifdef MODULE_POSIX_POLL
+static int _stdio_poll(vfs_file_t *filp)
+{
+    int fd = filp->private_data.value;
+    if (fd != STDIN_FILENO) {
+        return POLLOUT;
+    }
+#ifdef MODULE_STDIO_UART_RX
+    return (stdio_available() > 0) ? POLLIN : 0;
+#else
+    /* no way to tell, don't let poll() wait forever */
+    return POLLIN;
+#endif
+}
+#endif
+
 /**
  * @brief   VFS file operation table for stdin/stdout/stderr
  */
 static vfs_file_ops_t _stdio_ops = {
     .read = _stdio_read,
     .write = _stdio_write,
+#ifdef MODULE_POSIX_POLL
+    .poll = _stdio_poll,
+#endif
 };
 
 void vfs_bind_stdio(void)
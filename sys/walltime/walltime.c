@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_walltime
+ * @{
+ *
+ * @file
+ * @brief       Wall-clock time implementation
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <time.h>
+
+#include "irq.h"
+#include "timex.h"
+#include "walltime.h"
+#include "ztimer.h"
+#ifdef MODULE_PERIPH_RTC
+#include "periph/rtc.h"
+#endif
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+/* wall-clock time at _base_tick, without the correction */
+static uint64_t _base_us;
+static uint64_t _base_tick;
+/* correction to apply from _base_tick on */
+static int64_t _slew;
+#ifdef MODULE_PERIPH_RTC
+static uint64_t _rtc_tick;
+#endif
+
+/* part of the correction applied after elapsed µs */
+static int64_t _slewed(uint64_t elapsed)
+{
+    uint64_t max = elapsed >> CONFIG_WALLTIME_SLEW_SHIFT;
+
+    if (_slew >= 0) {
+        return (max < (uint64_t)_slew) ? (int64_t)max : _slew;
+    }
+    return (max < (uint64_t)-_slew) ? -(int64_t)max : _slew;
+}
+
+static uint64_t _now_at(uint64_t tick)
+{
+    uint64_t elapsed = tick - _base_tick;
+
+    return _base_us + elapsed + _slewed(elapsed);
+}
+
+/* moves the base to now, must be called with interrupts disabled */
+static void _rebase(void)
+{
+    uint64_t tick = ztimer_now(ZTIMER_USEC);
+    int64_t slewed = _slewed(tick - _base_tick);
+
+    _base_us += (tick - _base_tick) + slewed;
+    _slew -= slewed;
+    _base_tick = tick;
+}
+
+#ifdef MODULE_PERIPH_RTC
+/* seconds since 1970-01-01 of a date, see "days_from_civil" by H. Hinnant */
+static uint64_t _unix_time(const struct tm *t)
+{
+    int y = t->tm_year + 1900 - (t->tm_mon < 2);
+    unsigned m = t->tm_mon + 1;
+    int era = (y >= 0 ? y : y - 399) / 400;
+    unsigned yoe = (unsigned)(y - era * 400);
+    unsigned doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + t->tm_mday - 1;
+    unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    int64_t days = (int64_t)era * 146097 + doe - 719468;
+
+    return days * 86400 + t->tm_hour * 3600 + t->tm_min * 60 + t->tm_sec;
+}
+
+static void _rtc_read(void)
+{
+    struct tm t;
+
+    if (rtc_get_time(&t) < 0) {
+        return;
+    }
+
+    uint64_t sec = _unix_time(&t);
+    unsigned state = irq_disable();
+    uint64_t tick = ztimer_now(ZTIMER_USEC);
+    int64_t diff = (int64_t)(sec - _now_at(tick) / US_PER_SEC);
+
+    /* the RTC only has a resolution of a second */
+    if (diff > 1 || diff < -1) {
+        DEBUG("walltime: stepping by %" PRId32 " s to the RTC\n", (int32_t)diff);
+        _base_us += diff * (int64_t)US_PER_SEC;
+    }
+    _rtc_tick = tick;
+    irq_restore(state);
+}
+
+static void _rtc_write(uint64_t us)
+{
+    struct tm t;
+    time_t sec = us / US_PER_SEC;
+
+    gmtime_r(&sec, &t);
+    rtc_set_time(&t);
+}
+#endif
+
+void walltime_init(void)
+{
+#ifdef MODULE_PERIPH_RTC
+    _rtc_read();
+#endif
+}
+
+uint64_t walltime_now_us(void)
+{
+    unsigned state = irq_disable();
+    uint64_t tick = ztimer_now(ZTIMER_USEC);
+    uint64_t now = _now_at(tick);
+
+    irq_restore(state);
+#ifdef MODULE_PERIPH_RTC
+    if (CONFIG_WALLTIME_RTC_RESYNC_S && !irq_is_in() &&
+        (tick - _rtc_tick >
+         (uint64_t)CONFIG_WALLTIME_RTC_RESYNC_S * US_PER_SEC)) {
+        _rtc_read();
+        state = irq_disable();
+        now = _now_at(ztimer_now(ZTIMER_USEC));
+        irq_restore(state);
+    }
+#endif
+    return now;
+}
+
+void walltime_gettimeofday(struct timeval *tv)
+{
+    uint64_t now = walltime_now_us();
+
+    tv->tv_sec = now / US_PER_SEC;
+    tv->tv_usec = now - (uint64_t)tv->tv_sec * US_PER_SEC;
+}
+
+void walltime_set_us(uint64_t us)
+{
+    unsigned state = irq_disable();
+
+    _base_tick = ztimer_now(ZTIMER_USEC);
+    _base_us = us;
+    _slew = 0;
+    irq_restore(state);
+#ifdef MODULE_PERIPH_RTC
+    _rtc_write(us);
+#endif
+}
+
+static void _correct(int64_t slew)
+{
+    if (slew > (int64_t)CONFIG_WALLTIME_STEP_US ||
+        slew < -(int64_t)CONFIG_WALLTIME_STEP_US) {
+        DEBUG("walltime: stepping by %" PRId32 " ms\n",
+              (int32_t)(slew / (int64_t)US_PER_MS));
+        _base_us += slew;
+        _slew = 0;
+    }
+    else {
+        _slew = slew;
+    }
+}
+
+void walltime_adjust(int64_t delta_us)
+{
+    unsigned state = irq_disable();
+
+    _rebase();
+    _correct(_slew + delta_us);
+    irq_restore(state);
+}
+
+void walltime_sync_us(uint64_t us)
+{
+    unsigned state = irq_disable();
+
+    _rebase();
+    _correct((int64_t)(us - _base_us));
+    irq_restore(state);
+#ifdef MODULE_PERIPH_RTC
+    /* keeps the RTC from drifting away, it is read again on resync */
+    _rtc_write(us);
+#endif
+}
@@ -23,6 +23,8 @@
  * @}
  */
 #include <assert.h>
+#include <stdatomic.h>
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "kernel_defines.h"
@@ -31,6 +33,9 @@
 #include "pm_layered.h"
 #endif
 #include "ztimer.h"
+#ifdef MODULE_ZTIMER_WHEEL
+#include "ztimer/wheel.h"
+#endif
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -59,6 +64,13 @@ static unsigned _is_set(const ztimer_clock_t *clock, const ztimer_t *t)
 
 void ztimer_remove(ztimer_clock_t *clock, ztimer_t *timer)
 {
+#ifdef MODULE_ZTIMER_WHEEL
+    if (clock->wheel) {
+        ztimer_wheel_remove(clock, timer);
+        return;
+    }
+#endif
+
     unsigned state = irq_disable();
 
     if (_is_set(clock, timer)) {
@@ -76,6 +88,13 @@ void ztimer_set(ztimer_clock_t *clock, ztimer_t *timer, uint32_t val)
     DEBUG("ztimer_set(): %p: set %p at %" PRIu32 " offset %" PRIu32 "\n",
           (void *)clock, (void *)timer, clock->ops->now(clock), val);
 
+#ifdef MODULE_ZTIMER_WHEEL
+    if (clock->wheel) {
+        ztimer_wheel_set(clock, timer, val);
+        return;
+    }
+#endif
+
     unsigned state = irq_disable();
 
     ztimer_update_head_offset(clock);
@@ -95,7 +114,7 @@ void ztimer_set(ztimer_clock_t *clock, ztimer_t *timer, uint32_t val)
     _add_entry_to_list(clock, &timer->base);
     if (clock->list.next == &timer->base) {
 #ifdef MODULE_ZTIMER_EXTEND
-        if (clock->max_value < UINT32_MAX) {
+        if (_ztimer_is_extended(clock)) {
             val = _min_u32(val, clock->max_value >> 1);
         }
         DEBUG("ztimer_set(): %p setting %" PRIu32 "\n", (void *)clock, val);
@@ -106,6 +125,58 @@ void ztimer_set(ztimer_clock_t *clock, ztimer_t *timer, uint32_t val)
     irq_restore(state);
 }
 
+static uint32_t _lazy_target(ztimer_clock_t *clock, ztimer_t *timer,
+                             uint32_t val, uint32_t slack)
+{
+    uint32_t max = (val > UINT32_MAX - slack) ? UINT32_MAX : val + slack;
+
+#ifdef MODULE_ZTIMER_WHEEL
+    if (!clock->wheel)
+#endif
+    {
+        uint32_t delta_sum = 0;
+
+        /* join the first timer due within the window */
+        ztimer_update_head_offset(clock);
+        for (ztimer_base_t *entry = clock->list.next; entry;
+             entry = entry->next) {
+            /* ztimer_set() will subtract the adjustment again */
+            uint32_t target;
+
+            delta_sum += entry->offset;
+            target = delta_sum + clock->adjust;
+            if (target > max) {
+                break;
+            }
+            if ((target >= val) && (entry != &timer->base)) {
+                return target;
+            }
+        }
+    }
+#if MODULE_ZTIMER_MSEC && CONFIG_ZTIMER_LAZY_GRID_MSEC
+    if (clock == ZTIMER_MSEC) {
+        uint32_t rem = ((uint32_t)ztimer_now(clock) + val) %
+                       CONFIG_ZTIMER_LAZY_GRID_MSEC;
+
+        if ((rem != 0) && (CONFIG_ZTIMER_LAZY_GRID_MSEC - rem <= slack)) {
+            return val + (CONFIG_ZTIMER_LAZY_GRID_MSEC - rem);
+        }
+    }
+#endif
+    (void)timer;
+    (void)max;
+    return val;
+}
+
+void ztimer_set_lazy(ztimer_clock_t *clock, ztimer_t *timer, uint32_t val,
+                     uint32_t slack)
+{
+    unsigned state = irq_disable();
+
+    ztimer_set(clock, timer, _lazy_target(clock, timer, val, slack));
+    irq_restore(state);
+}
+
 static void _add_entry_to_list(ztimer_clock_t *clock, ztimer_base_t *entry)
 {
     uint32_t delta_sum = 0;
@@ -157,22 +228,97 @@ static uint32_t _add_modulo(uint32_t a, uint32_t b, uint32_t mod)
 ztimer_now_t _ztimer_now_extend(ztimer_clock_t *clock)
 {
     assert(clock->max_value);
-    unsigned state = irq_disable();
-    uint32_t lower_now = clock->ops->now(clock);
+    ztimer_now_t checkpoint;
+    uint32_t lower_last, lower_now, seq;
+
+    /* lock-free read, retried if a checkpoint was taken in between */
+    do {
+        seq = clock->seq;
+        atomic_thread_fence(memory_order_acquire);
+        checkpoint = clock->checkpoint;
+        lower_last = clock->lower_last;
+        lower_now = clock->ops->now(clock);
+        atomic_thread_fence(memory_order_acquire);
+    } while ((seq & 1) || (seq != clock->seq));
+
+    uint32_t diff = _add_modulo(lower_now, lower_last, clock->max_value);
+
     DEBUG(
         "ztimer_now() checkpoint=%" PRIu32 " lower_last=%" PRIu32 " lower_now=%" PRIu32 " diff=%" PRIu32 "\n",
-        (uint32_t)clock->checkpoint, clock->lower_last, lower_now,
-        _add_modulo(lower_now, clock->lower_last, clock->max_value));
+        (uint32_t)checkpoint, lower_last, lower_now, diff);
+    if (diff <= (clock->max_value >> 2)) {
+        return checkpoint + diff;
+    }
+
+    /* checkpoint well before the lower clock wraps around again */
+    unsigned state = irq_disable();
+    clock->seq++;
+    atomic_thread_fence(memory_order_release);
+    lower_now = clock->ops->now(clock);
     clock->checkpoint += _add_modulo(lower_now, clock->lower_last,
                                      clock->max_value);
     clock->lower_last = lower_now;
-    DEBUG("ztimer_now() returning %" PRIu32 "\n", (uint32_t)clock->checkpoint);
-    ztimer_now_t now = clock->checkpoint;
+    checkpoint = clock->checkpoint;
+    atomic_thread_fence(memory_order_release);
+    clock->seq++;
     irq_restore(state);
-    return now;
+    DEBUG("ztimer_now() new checkpoint %" PRIu32 "\n", (uint32_t)checkpoint);
+    return checkpoint;
 }
 #endif /* MODULE_ZTIMER_EXTEND */
 
+uint32_t ztimer_until_next(ztimer_clock_t *clock)
+{
+#ifdef MODULE_ZTIMER_WHEEL
+    if (clock->wheel) {
+        return ztimer_wheel_until_next(clock);
+    }
+#endif
+
+    uint32_t res = UINT32_MAX;
+    unsigned state = irq_disable();
+
+    if (clock->list.next) {
+        uint32_t elapsed = ztimer_now(clock) - clock->list.offset;
+        uint32_t offset = clock->list.next->offset;
+
+        res = (elapsed < offset) ? (offset - elapsed) : 0;
+    }
+
+    irq_restore(state);
+    return res;
+}
+
+uint32_t ztimer_left(ztimer_clock_t *clock, const ztimer_t *timer)
+{
+#ifdef MODULE_ZTIMER_WHEEL
+    if (clock->wheel) {
+        return ztimer_wheel_left(clock, timer);
+    }
+#endif
+
+    uint32_t res = 0;
+    unsigned state = irq_disable();
+
+    if (_is_set(clock, timer)) {
+        uint32_t elapsed = ztimer_now(clock) - clock->list.offset;
+        uint32_t target = 0;
+
+        /* a triggered timer may still look set, so search for it */
+        for (ztimer_base_t *entry = clock->list.next; entry;
+             entry = entry->next) {
+            target += entry->offset;
+            if (entry == &timer->base) {
+                res = (elapsed < target) ? (target - elapsed) : 0;
+                break;
+            }
+        }
+    }
+
+    irq_restore(state);
+    return res;
+}
+
 void ztimer_update_head_offset(ztimer_clock_t *clock)
 {
     uint32_t old_base = clock->list.offset;
@@ -278,7 +424,7 @@ static ztimer_t *_now_next(ztimer_clock_t *clock)
 static void _ztimer_update(ztimer_clock_t *clock)
 {
 #ifdef MODULE_ZTIMER_EXTEND
-    if (clock->max_value < UINT32_MAX) {
+    if (_ztimer_is_extended(clock)) {
         if (clock->list.next) {
             clock->ops->set(clock,
                             _min_u32(clock->list.next->offset,
@@ -303,6 +449,13 @@ static void _ztimer_update(ztimer_clock_t *clock)
 
 void ztimer_handler(ztimer_clock_t *clock)
 {
+#ifdef MODULE_ZTIMER_WHEEL
+    if (clock->wheel) {
+        ztimer_wheel_handler(clock);
+        return;
+    }
+#endif
+
     DEBUG("ztimer_handler(): %p now=%" PRIu32 "\n", (void *)clock, clock->ops->now(
               clock));
     if (ENABLE_DEBUG) {
@@ -310,8 +463,9 @@ void ztimer_handler(ztimer_clock_t *clock)
     }
 
 #if MODULE_ZTIMER_EXTEND || MODULE_ZTIMER_NOW64
-    if (IS_USED(MODULE_ZTIMER_NOW64) || clock->max_value < UINT32_MAX) {
-        /* calling now triggers checkpointing */
+    if (_ztimer_is_extended(clock)) {
+        /* calling now checkpoints, an intermediate timer is always late
+         * enough for that */
         uint32_t now = ztimer_now(clock);
 
         if (clock->list.next) {
@@ -130,7 +130,5 @@ void ztimer_mock_init(ztimer_mock_t *self, unsigned width)
     };
     DEBUG("zmock_init: %p width=%u mask=0x%08" PRIx32 "\n", (void *)self, width,
           self->mask);
-    if (max_value < UINT32_MAX) {
-        self->super.ops->set(&self->super, self->super.max_value >> 1);
-    }
+    ztimer_init_extend(&self->super);
 }
@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_ztimer_periodic
+ * @{
+ *
+ * @file
+ * @brief       ztimer periodic timer implementation
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <assert.h>
+
+#include "irq.h"
+#include "ztimer.h"
+#include "ztimer/periodic.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+/* skips passed periods and sets the timer to the end of the next one,
+ * returns the number of periods skipped */
+static unsigned _arm(ztimer_periodic_t *timer, uint32_t now)
+{
+    /* negative if the clock adjustment triggered the timer early */
+    int32_t late = now - timer->last;
+    unsigned skipped = 0;
+
+    if (late >= (int32_t)timer->period) {
+        skipped = (uint32_t)late / timer->period;
+        timer->last += skipped * timer->period;
+    }
+    ztimer_set(timer->clock, &timer->timer,
+               timer->last + timer->period - now);
+    return skipped;
+}
+
+static void _trigger(void *arg)
+{
+    ztimer_periodic_t *timer = arg;
+    uint32_t now = ztimer_now(timer->clock);
+
+    timer->last += timer->period;
+    unsigned missed = _arm(timer, now);
+    if (missed) {
+        DEBUG("ztimer_periodic: %p missed %u periods\n", (void *)timer, missed);
+        timer->missed += missed;
+    }
+
+    if (!timer->callback(timer->arg, missed)) {
+        ztimer_remove(timer->clock, &timer->timer);
+    }
+}
+
+void ztimer_periodic_init(ztimer_clock_t *clock, ztimer_periodic_t *timer,
+                          uint32_t period, ztimer_periodic_cb_t callback,
+                          void *arg)
+{
+    assert(period);
+
+    *timer = (ztimer_periodic_t){
+        .timer = { .callback = _trigger, .arg = timer },
+        .clock = clock,
+        .callback = callback,
+        .arg = arg,
+        .period = period,
+    };
+}
+
+void ztimer_periodic_start_at(ztimer_periodic_t *timer, uint32_t reference)
+{
+    unsigned state = irq_disable();
+
+    timer->last = reference;
+    _arm(timer, ztimer_now(timer->clock));
+    irq_restore(state);
+}
+
+void ztimer_periodic_start(ztimer_periodic_t *timer)
+{
+    uint32_t now = ztimer_now(timer->clock);
+
+    ztimer_periodic_start_at(timer, now - (now % timer->period));
+}
+
+void ztimer_periodic_stop(ztimer_periodic_t *timer)
+{
+    ztimer_remove(timer->clock, &timer->timer);
+}
+
+#ifdef MODULE_EVENT
+static bool _post(void *arg, unsigned missed)
+{
+    ztimer_periodic_event_t *timer = arg;
+
+    (void)missed;
+    if (timer->event->list_node.next) {
+        /* the handler did not keep up */
+        timer->periodic.missed++;
+    }
+    else {
+        event_post(timer->queue, timer->event);
+    }
+    return true;
+}
+
+void ztimer_periodic_event_init(ztimer_clock_t *clock,
+                                ztimer_periodic_event_t *timer,
+                                uint32_t period, event_queue_t *queue,
+                                event_t *event)
+{
+    ztimer_periodic_init(clock, &timer->periodic, period, _post, timer);
+    timer->queue = queue;
+    timer->event = event;
+}
+#endif
@@ -22,16 +22,22 @@
  */
 #include <assert.h>
 #include <errno.h>
+#include <stdatomic.h>
 
 #include "irq.h"
+#include "list.h"
 #include "mutex.h"
+#include "rmutex.h"
 #include "thread.h"
 #include "ztimer.h"
 
 typedef struct {
     mutex_t *mutex;
     thread_t *thread;
-    int timeout;
+    /* set when the timeout removed the thread from the waiting queue */
+    volatile uint8_t dequeued;
+    /* cleared by the timeout, so _mutex_lock() no longer blocks */
+    volatile uint8_t blocking;
 } mutex_thread_t;
 
 static void _callback_unlock_mutex(void *arg)
@@ -55,13 +61,13 @@ void ztimer_sleep(ztimer_clock_t *clock, uint32_t duration)
     mutex_lock(&mutex);
 }
 
-void ztimer_periodic_wakeup(ztimer_clock_t *clock, ztimer_now_t *last_wakeup,
+void ztimer_periodic_wakeup(ztimer_clock_t *clock, uint32_t *last_wakeup,
                             uint32_t period)
 {
     unsigned state = irq_disable();
-    ztimer_now_t now = ztimer_now(clock);
-    ztimer_now_t target = *last_wakeup + period;
-    ztimer_now_t offset = target - now;
+    uint32_t now = ztimer_now(clock);
+    uint32_t target = *last_wakeup + period;
+    uint32_t offset = target - now;
 
     irq_restore(state);
 
@@ -140,6 +146,69 @@ void ztimer_set_timeout_flag(ztimer_clock_t *clock, ztimer_t *t,
 }
 #endif
 
+static void _mutex_timeout(void *arg)
+{
+    unsigned state = irq_disable();
+    mutex_thread_t *mt = (mutex_thread_t *)arg;
+    mutex_t *mutex = mt->mutex;
+
+    mt->blocking = 0;
+    if ((mutex->queue.next != MUTEX_LOCKED) && (mutex->queue.next != NULL) &&
+        list_remove(&mutex->queue, (list_node_t *)&mt->thread->rq_entry)) {
+        if (mutex->queue.next == NULL) {
+            mutex->queue.next = MUTEX_LOCKED;
+        }
+        mt->dequeued = 1;
+        sched_set_status(mt->thread, STATUS_PENDING);
+        irq_restore(state);
+        sched_switch(mt->thread->priority);
+        return;
+    }
+    irq_restore(state);
+}
+
+int ztimer_mutex_lock_timeout(ztimer_clock_t *clock, mutex_t *mutex,
+                              uint32_t timeout)
+{
+    if (mutex_trylock(mutex)) {
+        return 0;
+    }
+    if (timeout == 0) {
+        return -ECANCELED;
+    }
+
+    mutex_thread_t mt = {
+        .mutex = mutex,
+        .thread = (thread_t *)sched_active_thread,
+        .blocking = 1,
+    };
+    ztimer_t t = {
+        .callback = _mutex_timeout,
+        .arg = &mt,
+    };
+
+    ztimer_set(clock, &t, timeout);
+    int locked = _mutex_lock(mutex, &mt.blocking);
+    ztimer_remove(clock, &t);
+
+    return (locked && !mt.dequeued) ? 0 : -ECANCELED;
+}
+
+int ztimer_rmutex_lock_timeout(ztimer_clock_t *clock, rmutex_t *rmutex,
+                               uint32_t timeout)
+{
+    if (rmutex_trylock(rmutex)) {
+        return 0;
+    }
+    if (ztimer_mutex_lock_timeout(clock, &rmutex->mutex, timeout) == 0) {
+        atomic_store_explicit(&rmutex->owner, thread_getpid(),
+                              memory_order_relaxed);
+        rmutex->refcount++;
+        return 0;
+    }
+    return -ECANCELED;
+}
+
 static void _callback_wakeup(void *arg)
 {
     thread_wakeup((kernel_pid_t)((intptr_t)arg));
@@ -155,3 +224,41 @@ void ztimer_set_wakeup(ztimer_clock_t *clock, ztimer_t *timer, uint32_t offset,
 
     ztimer_set(clock, timer, offset);
 }
+
+#if MODULE_ZTIMER_NOW64
+static void _ztimer64_arm(ztimer64_t *timer, uint64_t now)
+{
+    uint64_t left = timer->target - now;
+
+    ztimer_set(timer->clock, &timer->timer,
+               (left > UINT32_MAX) ? UINT32_MAX : left);
+}
+
+static void _ztimer64_callback(void *arg)
+{
+    ztimer64_t *timer = arg;
+    uint64_t now = ztimer_now(timer->clock);
+
+    /* the clock adjustment may let the underlying timer trigger early */
+    if ((now + timer->clock->adjust) >= timer->target) {
+        timer->callback(timer->arg);
+    }
+    else {
+        _ztimer64_arm(timer, now);
+    }
+}
+
+void ztimer64_set_at(ztimer_clock_t *clock, ztimer64_t *timer,
+                     uint64_t target)
+{
+    unsigned state = irq_disable();
+    uint64_t now = ztimer_now(clock);
+
+    timer->clock = clock;
+    timer->target = (target > now) ? target : now;
+    timer->timer.callback = _ztimer64_callback;
+    timer->timer.arg = timer;
+    _ztimer64_arm(timer, now);
+    irq_restore(state);
+}
+#endif
@@ -0,0 +1,371 @@
+/*
+ * Copyright (C) 2020 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for more
+ * details.
+ */
+
+/**
+ * @ingroup     sys_ztimer_wheel
+ * @{
+ *
+ * @file
+ * @brief       ztimer hierarchical timing wheel implementation
+ *
+ * The wheel keeps every timer with its absolute 32 bit target in
+ * ztimer_base_t::offset. A timer is linked into the slot of the highest
+ * digit in which its target differs from ztimer_wheel_t::now. Targets that
+ * lie beyond the 32 bit overflow of the wheel time always go to the top
+ * level, whose slots are only reached again after the overflow.
+ *
+ * Invariant: the slot of the current digit of every level is empty, except
+ * for top level timers waiting for the next overflow. So when the wheel time
+ * reaches the start of a slot, all timers in that slot are re-inserted and
+ * end up on a lower level or, on the lowest level, in the expired list.
+ *
+ * @}
+ */
+#include <assert.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "bitarithm.h"
+#include "irq.h"
+#ifdef MODULE_PM_LAYERED
+#include "pm_layered.h"
+#endif
+#include "thread.h"
+#include "ztimer.h"
+#include "ztimer/wheel.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define BITS    CONFIG_ZTIMER_WHEEL_SLOT_BITS
+#define MASK    (ZTIMER_WHEEL_SLOTS - 1)
+#define TOP     (ZTIMER_WHEEL_LEVELS - 1)
+
+static inline unsigned _digit(uint32_t time, unsigned level)
+{
+    return (time >> (level * BITS)) & MASK;
+}
+
+static bool _is_empty(const ztimer_wheel_t *wheel)
+{
+    if (wheel->expired) {
+        return false;
+    }
+    for (unsigned level = 0; level < ZTIMER_WHEEL_LEVELS; level++) {
+        if (wheel->used[level]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void _pm_block(ztimer_clock_t *clock)
+{
+#ifdef MODULE_PM_LAYERED
+    if (clock->required_pm_mode != ZTIMER_CLOCK_NO_REQUIRED_PM_MODE) {
+        pm_block(clock->required_pm_mode);
+    }
+#else
+    (void)clock;
+#endif
+}
+
+static void _pm_unblock(ztimer_clock_t *clock)
+{
+#ifdef MODULE_PM_LAYERED
+    if (clock->required_pm_mode != ZTIMER_CLOCK_NO_REQUIRED_PM_MODE) {
+        pm_unblock(clock->required_pm_mode);
+    }
+#else
+    (void)clock;
+#endif
+}
+
+static void _insert(ztimer_wheel_t *wheel, ztimer_base_t *entry)
+{
+    uint32_t diff = entry->offset ^ wheel->now;
+
+    if (!diff) {
+        /* due now, append to the expired list to keep triggering order */
+        entry->next = NULL;
+        entry->pprev = wheel->expired_tail;
+        *wheel->expired_tail = entry;
+        wheel->expired_tail = &entry->next;
+        return;
+    }
+
+    unsigned level = TOP;
+    if (entry->offset > wheel->now) {
+        for (level = 0; diff >>= BITS; level++) {}
+    }
+
+    unsigned slot = _digit(entry->offset, level);
+    ztimer_base_t **head = &wheel->slots[level][slot];
+
+    entry->next = *head;
+    entry->pprev = head;
+    if (entry->next) {
+        entry->next->pprev = &entry->next;
+    }
+    *head = entry;
+    wheel->used[level] |= 1U << slot;
+}
+
+static void _unlink(ztimer_wheel_t *wheel, ztimer_base_t *entry)
+{
+    ztimer_base_t **slots = &wheel->slots[0][0];
+
+    *entry->pprev = entry->next;
+    if (entry->next) {
+        entry->next->pprev = entry->pprev;
+    }
+    else if (wheel->expired_tail == &entry->next) {
+        wheel->expired_tail = entry->pprev;
+    }
+    else if ((entry->pprev >= slots) &&
+             (entry->pprev < (slots + ZTIMER_WHEEL_LEVELS * ZTIMER_WHEEL_SLOTS))) {
+        /* entry was the only timer in its slot */
+        unsigned idx = entry->pprev - slots;
+        wheel->used[idx / ZTIMER_WHEEL_SLOTS] &= ~(1U << (idx & MASK));
+    }
+    entry->next = NULL;
+    entry->pprev = NULL;
+}
+
+/**
+ * @brief   Get the ticks until the wheel reaches its next non-empty slot
+ *
+ * @return  false, if all slots are empty
+ */
+static bool _next(const ztimer_wheel_t *wheel, uint32_t *ticks)
+{
+    /* slots of a level are always reached before those of higher levels */
+    for (unsigned level = 0; level < ZTIMER_WHEEL_LEVELS; level++) {
+        unsigned used = wheel->used[level];
+
+        if (!used) {
+            continue;
+        }
+
+        unsigned digit = _digit(wheel->now, level);
+        unsigned ahead = used & ~((2U << digit) - 1);
+        uint32_t start;
+
+        if (ahead) {
+            start = (uint32_t)bitarithm_lsb(ahead) << (level * BITS);
+            if (level < TOP) {
+                start |= wheel->now & ~(UINT32_MAX >> (32 - (level + 1) * BITS));
+            }
+        }
+        else {
+            /* only top level timers wait for the overflow */
+            assert(level == TOP);
+            start = (uint32_t)bitarithm_lsb(used) << (TOP * BITS);
+        }
+
+        *ticks = start - wheel->now;
+        if (!*ticks) {
+            /* reached again after a full overflow only */
+            *ticks = UINT32_MAX;
+        }
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief   Move the timers of all slots starting at the current wheel time
+ *          one level down
+ */
+static void _cascade(ztimer_wheel_t *wheel)
+{
+    for (unsigned level = ZTIMER_WHEEL_LEVELS; level-- > 0;) {
+        if (wheel->now & ~(UINT32_MAX << (level * BITS))) {
+            /* the current slot of this level started earlier */
+            continue;
+        }
+
+        unsigned slot = _digit(wheel->now, level);
+        ztimer_base_t *entry = wheel->slots[level][slot];
+
+        wheel->slots[level][slot] = NULL;
+        wheel->used[level] &= ~(1U << slot);
+        while (entry) {
+            ztimer_base_t *next = entry->next;
+            _insert(wheel, entry);
+            entry = next;
+        }
+    }
+}
+
+static void _advance(ztimer_wheel_t *wheel, uint32_t now)
+{
+    uint32_t ticks;
+
+    while (_next(wheel, &ticks) && (ticks <= (now - wheel->now))) {
+        wheel->now += ticks;
+        _cascade(wheel);
+    }
+    wheel->now = now;
+}
+
+static void _update(ztimer_clock_t *clock)
+{
+    ztimer_wheel_t *wheel = clock->wheel;
+    uint32_t ticks = 0;
+    bool pending = wheel->expired || _next(wheel, &ticks);
+
+#ifdef MODULE_ZTIMER_EXTEND
+    if (_ztimer_is_extended(clock)) {
+        if (pending && (ticks < (clock->max_value >> 1))) {
+            clock->ops->set(clock, ticks);
+        }
+        else {
+            clock->ops->set(clock, clock->max_value >> 1);
+        }
+        return;
+    }
+#endif
+    if (pending) {
+        clock->ops->set(clock, ticks);
+    }
+    else {
+        clock->ops->cancel(clock);
+    }
+}
+
+void ztimer_wheel_init(ztimer_clock_t *clock, ztimer_wheel_t *wheel)
+{
+    static_assert((BITS == 1) || (BITS == 2) || (BITS == 4),
+                  "CONFIG_ZTIMER_WHEEL_SLOT_BITS must be 1, 2 or 4");
+    assert(!clock->list.next);
+
+    memset(wheel, 0, sizeof(*wheel));
+    wheel->expired_tail = &wheel->expired;
+    wheel->now = ztimer_now(clock);
+    clock->wheel = wheel;
+}
+
+void ztimer_wheel_set(ztimer_clock_t *clock, ztimer_t *timer, uint32_t val)
+{
+    ztimer_wheel_t *wheel = clock->wheel;
+    unsigned state = irq_disable();
+
+    _advance(wheel, ztimer_now(clock));
+    if (timer->base.pprev) {
+        _unlink(wheel, &timer->base);
+    }
+    else if (_is_empty(wheel)) {
+        _pm_block(clock);
+    }
+
+    /* optionally subtract a configurable adjustment value */
+    if (val > clock->adjust) {
+        val -= clock->adjust;
+    }
+    else {
+        val = 0;
+    }
+
+    timer->base.offset = wheel->now + val;
+    _insert(wheel, &timer->base);
+    DEBUG("ztimer_wheel_set(): %p: set %p at %" PRIu32 "\n",
+          (void *)clock, (void *)timer, timer->base.offset);
+    _update(clock);
+
+    irq_restore(state);
+}
+
+void ztimer_wheel_remove(ztimer_clock_t *clock, ztimer_t *timer)
+{
+    ztimer_wheel_t *wheel = clock->wheel;
+    unsigned state = irq_disable();
+
+    if (timer->base.pprev) {
+        _advance(wheel, ztimer_now(clock));
+        _unlink(wheel, &timer->base);
+        if (_is_empty(wheel)) {
+            _pm_unblock(clock);
+        }
+        _update(clock);
+    }
+
+    irq_restore(state);
+}
+
+uint32_t ztimer_wheel_until_next(ztimer_clock_t *clock)
+{
+    ztimer_wheel_t *wheel = clock->wheel;
+    uint32_t ticks = UINT32_MAX;
+    unsigned state = irq_disable();
+
+    _advance(wheel, ztimer_now(clock));
+    if (wheel->expired) {
+        ticks = 0;
+    }
+    else {
+        /* leaves ticks untouched if the wheel is empty */
+        _next(wheel, &ticks);
+    }
+
+    irq_restore(state);
+    return ticks;
+}
+
+uint32_t ztimer_wheel_left(ztimer_clock_t *clock, const ztimer_t *timer)
+{
+    ztimer_wheel_t *wheel = clock->wheel;
+    uint32_t ticks = 0;
+    unsigned state = irq_disable();
+
+    if (timer->base.pprev) {
+        _advance(wheel, ztimer_now(clock));
+        ticks = timer->base.offset - wheel->now;
+        for (ztimer_base_t *entry = wheel->expired; entry; entry = entry->next) {
+            if (entry == &timer->base) {
+                ticks = 0;
+                break;
+            }
+        }
+    }
+
+    irq_restore(state);
+    return ticks;
+}
+
+void ztimer_wheel_handler(ztimer_clock_t *clock)
+{
+    ztimer_wheel_t *wheel = clock->wheel;
+
+    /* calling now triggers checkpointing */
+    _advance(wheel, ztimer_now(clock));
+
+    while (wheel->expired) {
+        ztimer_t *entry = (ztimer_t *)wheel->expired;
+
+        _unlink(wheel, &entry->base);
+        if (_is_empty(wheel)) {
+            _pm_unblock(clock);
+        }
+        DEBUG("ztimer_wheel_handler(): trigger %p at %" PRIu32 "\n",
+              (void *)entry, entry->base.offset);
+        entry->callback(entry->arg);
+        if (!wheel->expired) {
+            /* See if any more alarms expired during callback processing */
+            _advance(wheel, ztimer_now(clock));
+        }
+    }
+
+    _update(clock);
+
+    if (!irq_is_in()) {
+        thread_yield_higher();
+    }
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       CRC throughput benchmark application
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "test_utils/expect.h"
+
+#include "checksum/crc8.h"
+#include "checksum/crc16_ccitt.h"
+#include "checksum/crc32.h"
+#include "checksum/ucrc16.h"
+#include "xtimer.h"
+
+#ifndef REPEAT
+#define REPEAT          (100U)
+#endif
+
+#ifndef BUF_SIZE
+#define BUF_SIZE        (1024U)
+#endif
+
+/* one byte more, so that the data can start at an odd address */
+static uint8_t _buf[BUF_SIZE + 1];
+static volatile uint32_t _sink;
+
+static void _print(const char *name, uint32_t total)
+{
+    printf("%30s %8"PRIu32" / %u = %"PRIu32"\n", name, total, REPEAT,
+           total / REPEAT);
+}
+
+static void _crc8(const uint8_t *buf)
+{
+    _sink = crc8(buf, BUF_SIZE, 0x31, 0xff);
+}
+
+static void _ucrc16(const uint8_t *buf)
+{
+    _sink = ucrc16_calc_be(buf, BUF_SIZE, UCRC16_CCITT_POLY_BE, 0x1d0f);
+}
+
+static void _crc16_ccitt(const uint8_t *buf)
+{
+    _sink = crc16_ccitt_update(0x1d0f, buf, BUF_SIZE);
+}
+
+static void _crc32(const uint8_t *buf)
+{
+    _sink = crc32_update(0, buf, BUF_SIZE);
+}
+
+static void _run(const char *name, void (*func)(const uint8_t *))
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < REPEAT; i++) {
+        func(&_buf[1]);
+    }
+
+    _print(name, xtimer_now_usec() - start);
+}
+
+int main(void)
+{
+    puts("checksum benchmark application.");
+
+    for (unsigned i = 0; i < sizeof(_buf); i++) {
+        _buf[i] = i;
+    }
+
+    /* the optimized paths must agree with the bit-wise reference */
+    expect(crc16_ccitt_update(0x1d0f, &_buf[1], BUF_SIZE) ==
+           ucrc16_calc_be(&_buf[1], BUF_SIZE, UCRC16_CCITT_POLY_BE, 0x1d0f));
+    expect(crc32_update(crc32_calc(&_buf[1], 3), &_buf[4], BUF_SIZE - 3) ==
+           crc32_calc(&_buf[1], BUF_SIZE));
+
+    _run("crc8", _crc8);
+    _run("ucrc16_calc_be", _ucrc16);
+    _run("crc16_ccitt_update", _crc16_ccitt);
+    _run("crc32_update", _crc32);
+
+    puts("done.");
+
+    return 0;
+}
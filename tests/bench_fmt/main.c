@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark of fmt number formatting against the C library
+ *
+ * Every case prints one JSON line with percentiles of the duration of a
+ * single conversion. Each fmt case is followed by the snprintf() call
+ * producing the same output.
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "fmt.h"
+
+#ifndef RUNS
+#define RUNS                (1000U)
+#endif
+
+#ifndef BENCHMARK_CSV
+#define BENCHMARK_CSV       (0)
+#endif
+
+static uint32_t _buf[RUNS];
+static benchmark_samples_t _set = BENCHMARK_SAMPLES_INIT(_buf);
+
+static char _out[64];
+static char _line[64];
+/* volatile, so the compiler can't format at compile time */
+static volatile uint32_t _small = 42;
+static volatile uint32_t _max = UINT32_MAX;
+static volatile int32_t _temp = -1234;
+
+static void _print(const char *name)
+{
+    if (BENCHMARK_CSV) {
+        benchmark_print_csv(name, &_set);
+    }
+    else {
+        benchmark_print_json(name, &_set);
+    }
+    _set.numof = 0;
+}
+
+static void _discard(void *arg, const char *s, size_t n)
+{
+    (void)arg;
+    (void)s;
+    (void)n;
+}
+
+static void _writer_line(void)
+{
+    fmt_writer_t w;
+
+    fmt_writer_init(&w, _line, sizeof(_line), _discard, NULL);
+    fmt_writer_str(&w, "t=");
+    fmt_writer_u32_dec(&w, _max);
+    fmt_writer_str(&w, " temp=");
+    fmt_writer_s32_dfp(&w, _temp, -2);
+    fmt_writer_char(&w, '\n');
+    fmt_writer_flush(&w);
+}
+
+int main(void)
+{
+    puts("fmt benchmark");
+    benchmark_clock_init();
+
+    /* what is left of the time source overhead after its subtraction */
+    BENCHMARK_SAMPLE(&_set, RUNS, (void)0);
+    _print("overhead");
+
+    BENCHMARK_SAMPLE(&_set, RUNS, fmt_u32_dec(_out, _small));
+    _print("fmt_u32_dec_small");
+    BENCHMARK_SAMPLE(&_set, RUNS,
+                     snprintf(_out, sizeof(_out), "%" PRIu32, _small));
+    _print("snprintf_u32_small");
+
+    BENCHMARK_SAMPLE(&_set, RUNS, fmt_u32_dec(_out, _max));
+    _print("fmt_u32_dec_max");
+    BENCHMARK_SAMPLE(&_set, RUNS,
+                     snprintf(_out, sizeof(_out), "%" PRIu32, _max));
+    _print("snprintf_u32_max");
+
+    BENCHMARK_SAMPLE(&_set, RUNS, fmt_s32_dfp(_out, _temp, -2));
+    _print("fmt_s32_dfp");
+    BENCHMARK_SAMPLE(&_set, RUNS,
+                     snprintf(_out, sizeof(_out), "-%" PRIu32 ".%02" PRIu32,
+                              (uint32_t)-_temp / 100, (uint32_t)-_temp % 100));
+    _print("snprintf_dfp");
+
+    BENCHMARK_SAMPLE(&_set, RUNS, _writer_line());
+    _print("fmt_writer_line");
+    BENCHMARK_SAMPLE(&_set, RUNS,
+                     snprintf(_line, sizeof(_line), "t=%" PRIu32 " temp=-%"
+                              PRIu32 ".%02" PRIu32 "\n", _max,
+                              (uint32_t)-_temp / 100, (uint32_t)-_temp % 100));
+    _print("snprintf_line");
+
+    puts("done");
+    return 0;
+}
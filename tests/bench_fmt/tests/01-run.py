@@ -0,0 +1,38 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 ML!PA Consulting GmbH
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import json
+import sys
+from testrunner import run
+
+CASES = [
+    "overhead",
+    "fmt_u32_dec_small",
+    "snprintf_u32_small",
+    "fmt_u32_dec_max",
+    "snprintf_u32_max",
+    "fmt_s32_dfp",
+    "snprintf_dfp",
+    "fmt_writer_line",
+    "snprintf_line",
+]
+
+
+def testfunc(child):
+    child.expect_exact("fmt benchmark")
+    for case in CASES:
+        child.expect(r"(\{.*\})\r\n")
+        res = json.loads(child.match.group(1))
+        assert res["name"] == case
+        assert res["n"] > 0
+        assert res["min"] <= res["p50"] <= res["p90"] <= res["p99"] <= res["max"]
+    child.expect_exact("done")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,220 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark of the core IPC primitives
+ *
+ * Every case prints one JSON line with percentiles of the per-operation
+ * duration. Cases waking a thread measure the round trip: main wakes a
+ * higher priority helper thread, which blocks again right away.
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "cond.h"
+#include "event.h"
+#include "mbox.h"
+#include "msg.h"
+#include "mutex.h"
+#include "rmutex.h"
+#include "thread.h"
+#include "thread_flags.h"
+#include "ztimer.h"
+
+#ifndef RUNS
+#define RUNS                (1000U)
+#endif
+
+#ifndef BENCHMARK_CSV
+#define BENCHMARK_CSV       (0)
+#endif
+
+#define HELPER_FLAG         (0x1)
+
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+static uint32_t _buf[RUNS];
+static benchmark_samples_t _set = BENCHMARK_SAMPLES_INIT(_buf);
+static volatile bool _running;
+
+static msg_t _mbox_queue[4];
+static mbox_t _mbox = MBOX_INIT(_mbox_queue, ARRAY_SIZE(_mbox_queue));
+static mutex_t _mutex = MUTEX_INIT;
+static rmutex_t _rmutex = RMUTEX_INIT;
+static mutex_t _cond_mutex = MUTEX_INIT;
+static cond_t _cond = COND_INIT;
+static event_queue_t _queue;
+static event_t _event;
+
+static void *_msg_helper(void *arg)
+{
+    (void)arg;
+    msg_t m;
+
+    while (1) {
+        msg_receive(&m);
+        if (!_running) {
+            break;
+        }
+        msg_reply(&m, &m);
+    }
+    return NULL;
+}
+
+static void *_mbox_helper(void *arg)
+{
+    (void)arg;
+    msg_t m;
+
+    do {
+        mbox_get(&_mbox, &m);
+    } while (_running);
+    return NULL;
+}
+
+static void *_mutex_helper(void *arg)
+{
+    (void)arg;
+
+    do {
+        mutex_lock(&_mutex);
+    } while (_running);
+    return NULL;
+}
+
+static void *_cond_helper(void *arg)
+{
+    (void)arg;
+
+    mutex_lock(&_cond_mutex);
+    do {
+        cond_wait(&_cond, &_cond_mutex);
+    } while (_running);
+    mutex_unlock(&_cond_mutex);
+    return NULL;
+}
+
+static void *_flags_helper(void *arg)
+{
+    (void)arg;
+
+    do {
+        thread_flags_wait_any(HELPER_FLAG);
+    } while (_running);
+    return NULL;
+}
+
+static void *_event_helper(void *arg)
+{
+    (void)arg;
+
+    event_queue_init(&_queue);
+    do {
+        event_wait(&_queue);
+    } while (_running);
+    return NULL;
+}
+
+static kernel_pid_t _start_helper(thread_task_func_t func)
+{
+    _running = true;
+    /* the helper has a higher priority, so it runs until it blocks */
+    return thread_create(_stack, sizeof(_stack), THREAD_PRIORITY_MAIN - 1, 0,
+                         func, NULL, "helper");
+}
+
+static void _print(const char *name)
+{
+    if (BENCHMARK_CSV) {
+        benchmark_print_csv(name, &_set);
+    }
+    else {
+        benchmark_print_json(name, &_set);
+    }
+    _set.numof = 0;
+}
+
+static void _dummy_cb(void *arg)
+{
+    (void)arg;
+}
+
+int main(void)
+{
+    kernel_pid_t pid;
+    msg_t m;
+
+    puts("IPC benchmark");
+    benchmark_clock_init();
+
+    /* what is left of the time source overhead after its subtraction */
+    BENCHMARK_SAMPLE(&_set, RUNS, (void)0);
+    _print("overhead");
+
+    pid = _start_helper(_msg_helper);
+    BENCHMARK_SAMPLE(&_set, RUNS, msg_send_receive(&m, &m, pid));
+    _print("msg_send_receive");
+    _running = false;
+    msg_send(&m, pid);
+
+    pid = _start_helper(_mbox_helper);
+    BENCHMARK_SAMPLE(&_set, RUNS, mbox_put(&_mbox, &m));
+    _print("mbox_put");
+    _running = false;
+    mbox_put(&_mbox, &m);
+
+    mutex_lock(&_mutex);
+    pid = _start_helper(_mutex_helper);
+    BENCHMARK_SAMPLE(&_set, RUNS, mutex_unlock(&_mutex));
+    _print("mutex_unlock");
+    _running = false;
+    mutex_unlock(&_mutex);
+    mutex_unlock(&_mutex);
+
+    BENCHMARK_SAMPLE(&_set, RUNS,
+                     (mutex_lock(&_mutex), mutex_unlock(&_mutex)));
+    _print("mutex_lock_unlock_uncontended");
+
+    BENCHMARK_SAMPLE(&_set, RUNS,
+                     (rmutex_lock(&_rmutex), rmutex_unlock(&_rmutex)));
+    _print("rmutex_lock_unlock_uncontended");
+
+    pid = _start_helper(_cond_helper);
+    BENCHMARK_SAMPLE(&_set, RUNS, cond_signal(&_cond));
+    _print("cond_signal");
+    _running = false;
+    cond_signal(&_cond);
+
+    pid = _start_helper(_flags_helper);
+    thread_t *helper = (thread_t *)thread_get(pid);
+    BENCHMARK_SAMPLE(&_set, RUNS, thread_flags_set(helper, HELPER_FLAG));
+    _print("thread_flags_set");
+    _running = false;
+    thread_flags_set(helper, HELPER_FLAG);
+
+    pid = _start_helper(_event_helper);
+    BENCHMARK_SAMPLE(&_set, RUNS, event_post(&_queue, &_event));
+    _print("event_post");
+    _running = false;
+    event_post(&_queue, &_event);
+
+    ztimer_t timer = { .callback = _dummy_cb };
+    BENCHMARK_SAMPLE(&_set, RUNS, ztimer_set(ZTIMER_USEC, &timer, US_PER_SEC);
+                     ztimer_remove(ZTIMER_USEC, &timer));
+    _print("ztimer_set_remove");
+
+    puts("done");
+    return 0;
+}
@@ -0,0 +1,236 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark of the handoff from an interrupt to a thread
+ *
+ * Every case prints one JSON line with percentiles of the latency from
+ * setting OUT_PIN, which is connected to IRQ_PIN, to the end of the handoff.
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "event.h"
+#include "msg.h"
+#include "periph/gpio.h"
+#include "thread.h"
+#include "thread_flags.h"
+#include "ztimer.h"
+
+#ifndef RUNS
+#define RUNS                (1000U)
+#endif
+
+#ifndef BENCHMARK_CSV
+#define BENCHMARK_CSV       (0)
+#endif
+
+#ifndef OUT_PIN
+#define OUT_PIN             GPIO_PIN(0, 0)
+#endif
+
+#ifndef IRQ_PIN
+#define IRQ_PIN             GPIO_PIN(0, 1)
+#endif
+
+#define HELPER_FLAG         (0x1)
+
+typedef enum {
+    MODE_IRQ,
+    MODE_THREAD_FLAGS,
+    MODE_MSG,
+    MODE_EVENT,
+    MODE_THREAD_FLAGS_LOW,
+} handoff_mode_t;
+
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+static char _low_stack[THREAD_STACKSIZE_DEFAULT];
+static uint32_t _buf[RUNS];
+static benchmark_samples_t _set = BENCHMARK_SAMPLES_INIT(_buf);
+
+static volatile handoff_mode_t _mode;
+static volatile bool _running;
+static volatile bool _done;
+static volatile uint32_t _start;
+static thread_t *_helper;
+static msg_t _msg;
+static event_queue_t _queue;
+static event_t _event;
+
+static void _handoff_done(void)
+{
+    if (_running) {
+        benchmark_record(&_set, benchmark_elapsed(_start));
+    }
+    _done = true;
+}
+
+static void _isr(void *arg)
+{
+    (void)arg;
+
+    switch (_mode) {
+    case MODE_IRQ:
+        _handoff_done();
+        break;
+    case MODE_THREAD_FLAGS:
+        thread_flags_set(_helper, HELPER_FLAG);
+        break;
+    case MODE_MSG:
+        msg_send_int(&_msg, _helper->pid);
+        break;
+    case MODE_EVENT:
+        event_post(&_queue, &_event);
+        break;
+    case MODE_THREAD_FLAGS_LOW:
+        thread_flags_set(_helper, HELPER_FLAG);
+        /* main measures the return to itself */
+        _done = true;
+        break;
+    }
+}
+
+static void *_flags_helper(void *arg)
+{
+    (void)arg;
+
+    do {
+        thread_flags_wait_any(HELPER_FLAG);
+        _handoff_done();
+    } while (_running);
+    return NULL;
+}
+
+static void *_msg_helper(void *arg)
+{
+    (void)arg;
+    msg_t m;
+
+    do {
+        msg_receive(&m);
+        _handoff_done();
+    } while (_running);
+    return NULL;
+}
+
+static void *_event_helper(void *arg)
+{
+    (void)arg;
+
+    event_queue_init(&_queue);
+    do {
+        event_wait(&_queue);
+        _handoff_done();
+    } while (_running);
+    return NULL;
+}
+
+static void *_low_helper(void *arg)
+{
+    (void)arg;
+
+    /* runs whenever main sleeps */
+    while (1) {
+        thread_flags_wait_any(HELPER_FLAG);
+    }
+    return NULL;
+}
+
+static void _start_helper(thread_task_func_t func)
+{
+    _running = true;
+    /* the helper has a higher priority, so it runs until it blocks */
+    kernel_pid_t pid = thread_create(_stack, sizeof(_stack),
+                                     THREAD_PRIORITY_MAIN - 1, 0,
+                                     func, NULL, "helper");
+    _helper = (thread_t *)thread_get(pid);
+}
+
+static void _trigger(void)
+{
+    _done = false;
+    _start = benchmark_now();
+    gpio_set(OUT_PIN);
+    while (!_done) {}
+    gpio_clear(OUT_PIN);
+}
+
+static void _print(const char *name)
+{
+    if (BENCHMARK_CSV) {
+        benchmark_print_csv(name, &_set);
+    }
+    else {
+        benchmark_print_json(name, &_set);
+    }
+    _set.numof = 0;
+}
+
+static void _run(handoff_mode_t mode, const char *name)
+{
+    _mode = mode;
+    for (unsigned i = 0; i < RUNS; i++) {
+        _trigger();
+    }
+    _print(name);
+
+    /* let the helper exit */
+    _running = false;
+    if (mode != MODE_IRQ) {
+        _trigger();
+    }
+}
+
+int main(void)
+{
+    puts("ISR handoff benchmark");
+    benchmark_clock_init();
+
+    gpio_init(OUT_PIN, GPIO_OUT);
+    gpio_clear(OUT_PIN);
+    if (gpio_init_int(IRQ_PIN, GPIO_IN, GPIO_RISING, _isr, NULL)) {
+        puts("failed to initialize IRQ_PIN");
+        return 1;
+    }
+
+    _running = true;
+    _run(MODE_IRQ, "irq");
+
+    _start_helper(_flags_helper);
+    _run(MODE_THREAD_FLAGS, "thread_flags");
+
+    _start_helper(_msg_helper);
+    _run(MODE_MSG, "msg");
+
+    _start_helper(_event_helper);
+    _run(MODE_EVENT, "event");
+
+    kernel_pid_t pid = thread_create(_low_stack, sizeof(_low_stack),
+                                     THREAD_PRIORITY_MAIN + 1, 0,
+                                     _low_helper, NULL, "low");
+    _helper = (thread_t *)thread_get(pid);
+    _mode = MODE_THREAD_FLAGS_LOW;
+    for (unsigned i = 0; i < RUNS; i++) {
+        /* let the lower priority helper block again */
+        ztimer_sleep(ZTIMER_USEC, 100);
+        _trigger();
+        benchmark_record(&_set, benchmark_elapsed(_start));
+    }
+    _print("thread_flags_low");
+
+    puts("done");
+    return 0;
+}
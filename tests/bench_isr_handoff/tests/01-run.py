@@ -0,0 +1,34 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 ML!PA Consulting GmbH
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import json
+import sys
+from testrunner import run
+
+CASES = [
+    "irq",
+    "thread_flags",
+    "msg",
+    "event",
+    "thread_flags_low",
+]
+
+
+def testfunc(child):
+    child.expect_exact("ISR handoff benchmark")
+    for case in CASES:
+        child.expect(r"(\{.*\})\r\n")
+        res = json.loads(child.match.group(1))
+        assert res["name"] == case
+        assert res["n"] > 0
+        assert res["min"] <= res["p50"] <= res["p90"] <= res["p99"] <= res["max"]
+    child.expect_exact("done")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
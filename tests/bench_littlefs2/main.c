@@ -0,0 +1,320 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       littlefs2 file system benchmark application
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "board.h"
+#include "fs/littlefs2_fs.h"
+#include "mtd.h"
+#ifdef MODULE_MTD_CACHE
+#include "mtd_cache.h"
+#endif
+#include "test_utils/expect.h"
+#include "timex.h"
+#include "vfs.h"
+#include "xtimer.h"
+
+#ifndef NUM_FILES
+#define NUM_FILES           (16U)
+#endif
+
+#ifndef SMALL_SIZE
+#define SMALL_SIZE          (64U)
+#endif
+
+#ifndef BIG_SIZE
+#define BIG_SIZE            (8192U)
+#endif
+
+#ifndef CHUNK_SIZE
+#define CHUNK_SIZE          (128U)
+#endif
+
+#define MOUNT_POINT         "/bench"
+
+/* Define MTD_0 in board.h to use the board mtd if any */
+#ifdef MTD_0
+#define _backing (MTD_0)
+#else
+/* RAM-based mtd, so that only the file system is measured */
+#ifndef SECTOR_COUNT
+#define SECTOR_COUNT 16
+#endif
+#ifndef PAGE_PER_SECTOR
+#define PAGE_PER_SECTOR 8
+#endif
+#ifndef PAGE_SIZE
+#define PAGE_SIZE 256
+#endif
+
+static uint8_t dummy_memory[PAGE_PER_SECTOR * PAGE_SIZE * SECTOR_COUNT];
+
+static int _init(mtd_dev_t *dev)
+{
+    (void)dev;
+
+    return 0;
+}
+
+static int _read(mtd_dev_t *dev, void *buff, uint32_t addr, uint32_t size)
+{
+    (void)dev;
+
+    if (addr + size > sizeof(dummy_memory)) {
+        return -EOVERFLOW;
+    }
+    memcpy(buff, dummy_memory + addr, size);
+
+    return 0;
+}
+
+static int _write(mtd_dev_t *dev, const void *buff, uint32_t addr, uint32_t size)
+{
+    (void)dev;
+
+    if (addr + size > sizeof(dummy_memory)) {
+        return -EOVERFLOW;
+    }
+    if (size > PAGE_SIZE) {
+        return -EOVERFLOW;
+    }
+    memcpy(dummy_memory + addr, buff, size);
+
+    return 0;
+}
+
+static int _erase(mtd_dev_t *dev, uint32_t addr, uint32_t size)
+{
+    (void)dev;
+
+    if (size % (PAGE_PER_SECTOR * PAGE_SIZE) != 0) {
+        return -EOVERFLOW;
+    }
+    if (addr % (PAGE_PER_SECTOR * PAGE_SIZE) != 0) {
+        return -EOVERFLOW;
+    }
+    if (addr + size > sizeof(dummy_memory)) {
+        return -EOVERFLOW;
+    }
+    memset(dummy_memory + addr, 0xff, size);
+
+    return 0;
+}
+
+static int _power(mtd_dev_t *dev, enum mtd_power_state power)
+{
+    (void)dev;
+    (void)power;
+    return 0;
+}
+
+static const mtd_desc_t driver = {
+    .init = _init,
+    .read = _read,
+    .write = _write,
+    .erase = _erase,
+    .power = _power,
+};
+
+static mtd_dev_t dev = {
+    .driver = &driver,
+    .sector_count = SECTOR_COUNT,
+    .pages_per_sector = PAGE_PER_SECTOR,
+    .page_size = PAGE_SIZE,
+};
+
+static mtd_dev_t *_backing = &dev;
+#endif /* MTD_0 */
+
+#ifdef MODULE_MTD_CACHE
+#ifndef MTD_CACHE_PAGE_SIZE
+#define MTD_CACHE_PAGE_SIZE (256U)
+#endif
+
+static uint8_t _cache_buf[MTD_CACHE_PAGES * MTD_CACHE_PAGE_SIZE];
+static mtd_cache_entry_t _cache_entries[MTD_CACHE_PAGES];
+static mtd_cache_t _cache;
+#endif
+
+#if LFS_LOOKAHEAD_SIZE
+static uint8_t _lookahead_buf[LFS_LOOKAHEAD_SIZE];
+#endif
+
+static littlefs_desc_t _fs_desc = {
+    .config = {
+        .cache_size = LFS_CACHE_SIZE,
+#if LFS_LOOKAHEAD_SIZE
+        .lookahead_size = LFS_LOOKAHEAD_SIZE,
+        .lookahead_buffer = _lookahead_buf,
+#endif
+    },
+};
+
+static vfs_mount_t _mount = {
+    .fs = &littlefs2_file_system,
+    .mount_point = MOUNT_POINT,
+    .private_data = &_fs_desc,
+};
+
+static uint8_t _buf[CHUNK_SIZE];
+static char _path[32];
+
+static const char *_name(unsigned i)
+{
+    snprintf(_path, sizeof(_path), MOUNT_POINT "/f%u", i);
+    return _path;
+}
+
+static void _print(const char *name, unsigned ops, uint32_t bytes,
+                   uint32_t start)
+{
+    uint32_t us = xtimer_now_usec() - start;
+    uint32_t ops_s = us ? (uint32_t)(((uint64_t)ops * US_PER_SEC) / us) : 0;
+    uint32_t kib_s = us ? (uint32_t)(((uint64_t)bytes * US_PER_SEC) /
+                                     (1024ULL * us))
+                        : 0;
+
+    printf("%12s %6u ops %10" PRIu32 " us %8" PRIu32 " ops/s %6" PRIu32
+           " KiB/s\n", name, ops, us, ops_s, kib_s);
+}
+
+static void _create(void)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < NUM_FILES; i++) {
+        int fd = vfs_open(_name(i), O_CREAT | O_TRUNC | O_WRONLY, 0);
+
+        expect(fd >= 0);
+        expect(vfs_write(fd, _buf, SMALL_SIZE) == SMALL_SIZE);
+        expect(vfs_close(fd) == 0);
+    }
+    _print("create", NUM_FILES, NUM_FILES * SMALL_SIZE, start);
+}
+
+static void _stat(void)
+{
+    uint32_t start = xtimer_now_usec();
+    struct stat st;
+
+    for (unsigned i = 0; i < NUM_FILES; i++) {
+        expect(vfs_stat(_name(i), &st) == 0);
+    }
+    _print("stat", NUM_FILES, 0, start);
+}
+
+static void _read_small(void)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < NUM_FILES; i++) {
+        int fd = vfs_open(_name(i), O_RDONLY, 0);
+
+        expect(fd >= 0);
+        expect(vfs_read(fd, _buf, SMALL_SIZE) == SMALL_SIZE);
+        expect(vfs_close(fd) == 0);
+    }
+    _print("read small", NUM_FILES, NUM_FILES * SMALL_SIZE, start);
+}
+
+static void _append(void)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < NUM_FILES; i++) {
+        int fd = vfs_open(_name(i), O_WRONLY | O_APPEND, 0);
+
+        expect(fd >= 0);
+        expect(vfs_write(fd, _buf, SMALL_SIZE / 4) == SMALL_SIZE / 4);
+        expect(vfs_close(fd) == 0);
+    }
+    _print("append", NUM_FILES, NUM_FILES * SMALL_SIZE / 4, start);
+}
+
+static void _unlink(void)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < NUM_FILES; i++) {
+        expect(vfs_unlink(_name(i)) == 0);
+    }
+    _print("unlink", NUM_FILES, 0, start);
+}
+
+static void _seq_write(void)
+{
+    uint32_t start = xtimer_now_usec();
+    int fd = vfs_open(MOUNT_POINT "/big", O_CREAT | O_TRUNC | O_WRONLY, 0);
+
+    expect(fd >= 0);
+    for (unsigned i = 0; i < BIG_SIZE / CHUNK_SIZE; i++) {
+        expect(vfs_write(fd, _buf, CHUNK_SIZE) == CHUNK_SIZE);
+    }
+    expect(vfs_close(fd) == 0);
+    _print("seq write", BIG_SIZE / CHUNK_SIZE, BIG_SIZE, start);
+}
+
+static void _seq_read(void)
+{
+    uint32_t start = xtimer_now_usec();
+    int fd = vfs_open(MOUNT_POINT "/big", O_RDONLY, 0);
+
+    expect(fd >= 0);
+    for (unsigned i = 0; i < BIG_SIZE / CHUNK_SIZE; i++) {
+        expect(vfs_read(fd, _buf, CHUNK_SIZE) == CHUNK_SIZE);
+    }
+    expect(vfs_close(fd) == 0);
+    expect(vfs_unlink(MOUNT_POINT "/big") == 0);
+    _print("seq read", BIG_SIZE / CHUNK_SIZE, BIG_SIZE, start);
+}
+
+int main(void)
+{
+    puts("littlefs2 benchmark application.");
+
+#ifdef MODULE_MTD_CACHE
+    expect(_backing->page_size * MTD_CACHE_PAGES <= sizeof(_cache_buf));
+    _cache = (mtd_cache_t)MTD_CACHE_INIT(_backing, _cache_buf, _cache_entries,
+                                         MTD_CACHE_PAGES);
+    _fs_desc.dev = &_cache.mtd;
+#else
+    _fs_desc.dev = _backing;
+#endif
+    memset(_buf, 0xa5, sizeof(_buf));
+
+    expect(vfs_format(&_mount) == 0);
+    expect(vfs_mount(&_mount) == 0);
+
+    _create();
+    _stat();
+    _read_small();
+    _append();
+    _unlink();
+    _seq_write();
+    _seq_read();
+
+    expect(vfs_umount(&_mount) == 0);
+
+    puts("done.");
+
+    return 0;
+}
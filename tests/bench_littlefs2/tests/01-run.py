@@ -0,0 +1,22 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 ML!PA Consulting GmbH
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("littlefs2 benchmark application.\r\n")
+    for i in range(7):
+        child.expect(r"\s+[\w ]+\s+\d+ ops\s+\d+ us\s+\d+ ops/s\s+\d+ KiB/s\r\n")
+
+    child.expect_exact("done.\r\n")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=120))
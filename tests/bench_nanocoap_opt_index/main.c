@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2020 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       nanocoap option parsing and lookup benchmark application
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "test_utils/expect.h"
+
+#include "net/nanocoap.h"
+#include "xtimer.h"
+
+#ifndef REPEAT
+#define REPEAT          (10000U)
+#endif
+
+/* options a typical handler looks up, in ascending order */
+static const unsigned _lookups[] = {
+    COAP_OPT_OBSERVE,
+    COAP_OPT_URI_PATH,
+    COAP_OPT_CONTENT_FORMAT,
+    COAP_OPT_URI_QUERY,
+    COAP_OPT_BLOCK2,
+};
+
+static uint8_t _buf[128];
+static size_t _len;
+
+static void _build_request(void)
+{
+    uint8_t token[] = { 0xde, 0xad };
+    uint8_t *pos = _buf;
+    coap_block1_t block2 = { .blknum = 3, .szx = 2 };
+
+    pos += coap_build_hdr((coap_hdr_t *)pos, COAP_TYPE_CON, token,
+                          sizeof(token), COAP_METHOD_GET, 1);
+    pos += coap_opt_put_uint(pos, 0, COAP_OPT_OBSERVE, 0);
+    pos += coap_opt_put_uri_path(pos, COAP_OPT_OBSERVE, "/sensors/temp/1");
+    pos += coap_put_option_ct(pos, COAP_OPT_URI_PATH, COAP_FORMAT_CBOR);
+    pos += coap_opt_put_uri_query(pos, COAP_OPT_CONTENT_FORMAT,
+                                  "unit=C&avg=60");
+    pos += coap_opt_put_block2_control(pos, COAP_OPT_URI_QUERY, &block2);
+    _len = pos - _buf;
+}
+
+int main(void)
+{
+    coap_pkt_t pkt;
+    uint8_t *value;
+    uint32_t before, total;
+
+    puts("nanocoap option lookup benchmark application.");
+#ifdef MODULE_NANOCOAP_OPT_INDEX
+    puts("option index: on");
+#else
+    puts("option index: off");
+#endif
+
+    _build_request();
+    expect(coap_parse(&pkt, _buf, _len) == 0);
+    for (unsigned i = 0; i < ARRAY_SIZE(_lookups); i++) {
+        expect(coap_opt_get_opaque(&pkt, _lookups[i], &value) >= 0);
+    }
+    expect(coap_opt_get_opaque(&pkt, COAP_OPT_BLOCK1, &value) == -ENOENT);
+
+    before = xtimer_now_usec();
+    for (unsigned n = 0; n < REPEAT; n++) {
+        coap_parse(&pkt, _buf, _len);
+    }
+    total = xtimer_now_usec() - before;
+    printf("%30s %8"PRIu32" / %u = %"PRIu32"\n", "parse", total, REPEAT,
+           total / REPEAT);
+
+    before = xtimer_now_usec();
+    for (unsigned n = 0; n < REPEAT; n++) {
+        for (unsigned i = 0; i < ARRAY_SIZE(_lookups); i++) {
+            coap_opt_get_opaque(&pkt, _lookups[i], &value);
+        }
+    }
+    total = xtimer_now_usec() - before;
+    printf("%30s %8"PRIu32" / %u = %"PRIu32"\n", "lookup x5", total, REPEAT,
+           total / REPEAT);
+
+    puts("done.");
+    return 0;
+}
@@ -0,0 +1,23 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 ML!PA Consulting GmbH
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("nanocoap option lookup benchmark application.\r\n")
+    child.expect(r"option index: (on|off)\r\n")
+    for i in range(2):
+        child.expect(r"\s+[\w ]+\s+\d+ / \d+ = \d+\r\n")
+
+    child.expect_exact("done.\r\n")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       SHA-256 throughput benchmark application
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "test_utils/expect.h"
+
+#include "hashes/sha256.h"
+#include "kernel_defines.h"
+#include "xtimer.h"
+
+#ifndef REPEAT
+#define REPEAT          (64U)
+#endif
+
+#define BUF_SIZE        (4096U)
+
+#if IS_USED(MODULE_PERIPH_CRYPTO_SHA256) && IS_ACTIVE(CONFIG_HASHES_SHA256_PERIPH)
+#define BACKEND         "hardware"
+#else
+#define BACKEND         "software"
+#endif
+
+/* word aligned, so the engine can read it directly */
+static uint32_t _buf[BUF_SIZE / sizeof(uint32_t)];
+
+int main(void)
+{
+    sha256_context_t ctx;
+    uint8_t digest[SHA256_DIGEST_LENGTH];
+    uint8_t ref[SHA256_DIGEST_LENGTH];
+
+    puts("sha256 benchmark application.");
+
+    memset(_buf, 0xa5, sizeof(_buf));
+
+    /* hashing the same data in one go and in pieces must agree */
+    sha256(_buf, sizeof(_buf), ref);
+    sha256_init(&ctx);
+    sha256_update(&ctx, _buf, 1);
+    sha256_update(&ctx, (uint8_t *)_buf + 1, sizeof(_buf) - 1);
+    sha256_final(&ctx, digest);
+    expect(memcmp(digest, ref, sizeof(ref)) == 0);
+
+    uint32_t start = xtimer_now_usec();
+    sha256_init(&ctx);
+    for (unsigned i = 0; i < REPEAT; i++) {
+        sha256_update(&ctx, _buf, sizeof(_buf));
+    }
+    sha256_final(&ctx, digest);
+    uint32_t total = xtimer_now_usec() - start;
+
+    uint64_t kib_s = (uint64_t)REPEAT * BUF_SIZE * 1000000 / 1024 / total;
+    printf("%30s %8"PRIu32" us = %"PRIu32" KiB/s\n", "sha256 (" BACKEND ")",
+           total, (uint32_t)kib_s);
+
+    puts("done.");
+
+    return 0;
+}
@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) 2020 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       IPHC compression with and without header templates benchmark
+ *              application
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "test_utils/expect.h"
+
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6/hdr.h"
+#include "net/gnrc/netif/ieee802154.h"
+#include "net/gnrc/sixlowpan/ctx.h"
+#include "net/gnrc/sixlowpan/iphc.h"
+#include "net/gnrc/udp.h"
+#include "net/netdev_test.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef REPEAT
+#define REPEAT          (1000U)
+#endif
+
+#define TEST_SRC_L2     { 0x2a, 0xab, 0xdc, 0x15, 0x54, 0x01, 0x64, 0x79 }
+#define TEST_DST_L2     { 0x5a, 0x9d, 0x93, 0x86, 0x22, 0x08, 0x65, 0x79 }
+#define TEST_PORT       (0xf0b5)
+#define TEST_PAYLOAD_LEN    (32U)
+#define TEST_FL         (0x12345)
+
+/* some time to let the lower priority interface thread process its queue */
+#define DRAIN_US        (100U * US_PER_MS)
+
+static const uint8_t _src_l2[] = TEST_SRC_L2;
+static const uint8_t _dst_l2[] = TEST_DST_L2;
+static const uint8_t _payload[TEST_PAYLOAD_LEN];
+
+static char _netif_stack[THREAD_STACKSIZE_DEFAULT];
+static netdev_test_t _dev;
+static gnrc_netif_t _netif;
+
+static uint8_t _frame[128];
+static size_t _frame_len;
+
+static gnrc_pktsnip_t *_build(const ipv6_addr_t *src, const ipv6_addr_t *dst)
+{
+    gnrc_pktsnip_t *pkt, *ipv6, *netif_hdr;
+    ipv6_hdr_t *hdr;
+
+    pkt = gnrc_pktbuf_add(NULL, _payload, sizeof(_payload),
+                          GNRC_NETTYPE_UNDEF);
+    expect(pkt != NULL);
+    pkt = gnrc_udp_hdr_build(pkt, TEST_PORT, TEST_PORT);
+    expect(pkt != NULL);
+    ipv6 = gnrc_ipv6_hdr_build(pkt, src, dst);
+    expect(ipv6 != NULL);
+    hdr = ipv6->data;
+    hdr->len = byteorder_htons(gnrc_pkt_len(pkt));
+    hdr->nh = PROTNUM_UDP;
+    hdr->hl = 64;
+    ipv6_hdr_set_fl(hdr, TEST_FL);
+    netif_hdr = gnrc_netif_hdr_build(NULL, 0, _dst_l2, sizeof(_dst_l2));
+    expect(netif_hdr != NULL);
+    gnrc_netif_hdr_set_netif(netif_hdr->data, &_netif);
+    netif_hdr->next = ipv6;
+    return netif_hdr;
+}
+
+static uint32_t _send(const ipv6_addr_t *src, const ipv6_addr_t *dst,
+                      bool cached)
+{
+    gnrc_pktsnip_t *pkt = _build(src, dst);
+    uint32_t before;
+
+    if (!cached) {
+        gnrc_sixlowpan_iphc_cache_invalidate();
+    }
+    before = xtimer_now_usec();
+    gnrc_sixlowpan_iphc_send(pkt, NULL, 0);
+    return xtimer_now_usec() - before;
+}
+
+/* returns the length of the frame compressed for src and dst, copies the
+ * frame to buf */
+static size_t _sent_frame(const ipv6_addr_t *src, const ipv6_addr_t *dst,
+                          bool cached, uint8_t *buf)
+{
+    xtimer_usleep(DRAIN_US);
+    _frame_len = 0;
+    _send(src, dst, cached);
+    xtimer_usleep(DRAIN_US);
+    expect(_frame_len > 0);
+    memcpy(buf, _frame, _frame_len);
+    return _frame_len;
+}
+
+static void _bench(const char *desc, const ipv6_addr_t *src,
+                   const ipv6_addr_t *dst)
+{
+    static uint8_t compressed[sizeof(_frame)], from_template[sizeof(_frame)];
+    size_t len;
+    uint32_t total;
+
+    printf("%s:\n", desc);
+    /* both ways result in the same frame */
+    len = _sent_frame(src, dst, false, compressed);
+    expect(_sent_frame(src, dst, true, from_template) == len);
+    expect(memcmp(compressed, from_template, len) == 0);
+
+    for (unsigned cached = 0; cached < 2; cached++) {
+        xtimer_usleep(DRAIN_US);
+        total = 0;
+        for (unsigned n = 0; n < REPEAT; n++) {
+            total += _send(src, dst, cached);
+        }
+        printf("%30s %8"PRIu32" / %u = %"PRIu32"\n",
+               cached ? "template" : "compress", total, REPEAT,
+               total / REPEAT);
+    }
+}
+
+static int _send_cb(netdev_t *dev, const iolist_t *iolist)
+{
+    (void)dev;
+    _frame_len = 0;
+    /* skip MAC header */
+    for (iolist = iolist->iol_next; iolist != NULL; iolist = iolist->iol_next) {
+        expect((_frame_len + iolist->iol_len) <= sizeof(_frame));
+        memcpy(&_frame[_frame_len], iolist->iol_base, iolist->iol_len);
+        _frame_len += iolist->iol_len;
+    }
+    return _frame_len;
+}
+
+static int _get_device_type(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    expect(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = NETDEV_TYPE_IEEE802154;
+    return sizeof(uint16_t);
+}
+
+static int _get_proto(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    expect(max_len == sizeof(gnrc_nettype_t));
+    *((gnrc_nettype_t *)value) = GNRC_NETTYPE_SIXLOWPAN;
+    return sizeof(gnrc_nettype_t);
+}
+
+static int _get_max_pdu_size(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    expect(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = 102U;
+    return sizeof(uint16_t);
+}
+
+static int _get_src_len(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    expect(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = sizeof(_src_l2);
+    return sizeof(uint16_t);
+}
+
+static int _get_addr_long(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    expect(max_len >= sizeof(_src_l2));
+    memcpy(value, _src_l2, sizeof(_src_l2));
+    return sizeof(_src_l2);
+}
+
+static void _init_netif(void)
+{
+    netdev_test_setup(&_dev, NULL);
+    netdev_test_set_send_cb(&_dev, _send_cb);
+    netdev_test_set_get_cb(&_dev, NETOPT_DEVICE_TYPE, _get_device_type);
+    netdev_test_set_get_cb(&_dev, NETOPT_PROTO, _get_proto);
+    netdev_test_set_get_cb(&_dev, NETOPT_MAX_PDU_SIZE, _get_max_pdu_size);
+    netdev_test_set_get_cb(&_dev, NETOPT_SRC_LEN, _get_src_len);
+    netdev_test_set_get_cb(&_dev, NETOPT_ADDRESS_LONG, _get_addr_long);
+    /* lower priority than the benchmark so only compression is measured:
+     * once its queue is full, frames are dropped right away */
+    gnrc_netif_ieee802154_create(&_netif, _netif_stack, sizeof(_netif_stack),
+                                 THREAD_PRIORITY_MAIN + 1, "bench_netif",
+                                 (netdev_t *)&_dev);
+    xtimer_usleep(DRAIN_US);
+}
+
+/* IPv6 address from prefix and an IEEE 802.15.4 long address */
+static void _addr(ipv6_addr_t *addr, const char *pfx, const uint8_t *l2addr)
+{
+    expect(ipv6_addr_from_str(addr, pfx) != NULL);
+    memcpy(&addr->u8[8], l2addr, 8);
+    addr->u8[8] ^= 0x02;
+}
+
+int main(void)
+{
+    ipv6_addr_t src, dst, pfx;
+
+    puts("6LoWPAN IPHC header template benchmark application.\n");
+
+    _init_netif();
+
+    _addr(&src, "fe80::", _src_l2);
+    _addr(&dst, "fe80::", _dst_l2);
+    _bench("link-local", &src, &dst);
+
+    _addr(&src, "2001:db8::", _src_l2);
+    _addr(&dst, "2001:db8::", _dst_l2);
+    _bench("global, inline", &src, &dst);
+
+    ipv6_addr_from_str(&pfx, "2001:db8::");
+    expect(gnrc_sixlowpan_ctx_update(0, &pfx, 64, UINT16_MAX, true) != NULL);
+    _bench("global, context", &src, &dst);
+
+    puts("done.");
+
+    return 0;
+}
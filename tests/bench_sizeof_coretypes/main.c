@@ -30,6 +30,7 @@
 #include "mbox.h"
 #include "msg.h"
 #include "mutex.h"
+#include "priority_heap.h"
 #include "priority_queue.h"
 #include "ringbuffer.h"
 #include "rmutex.h"
@@ -69,6 +70,10 @@ int main(void)
 #endif
     printf("sizeof(mutex_t):                %3u\n",
            (unsigned)sizeof(mutex_t));
+    printf("sizeof(priority_heap_node_t):   %3u\n",
+           (unsigned)sizeof(priority_heap_node_t));
+    printf("sizeof(priority_heap_t):        %3u\n",
+           (unsigned)sizeof(priority_heap_t));
     printf("sizeof(priority_queue_node_t):  %3u\n",
            (unsigned)sizeof(priority_queue_node_t));
     printf("sizeof(priority_queue_t):       %3u\n",
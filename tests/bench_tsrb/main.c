@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       tsrb throughput benchmark application
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "test_utils/expect.h"
+
+#include "tsrb.h"
+#include "xtimer.h"
+
+#ifndef REPEAT
+#define REPEAT          (1000U)
+#endif
+
+#ifndef CHUNK
+#define CHUNK           (64U)
+#endif
+
+/* not a multiple of CHUNK, so that transfers regularly wrap around */
+#define BUF_SIZE        (256U)
+
+static uint8_t _rb_buf[BUF_SIZE];
+static tsrb_t _rb = TSRB_INIT(_rb_buf);
+static uint8_t _in[CHUNK];
+static uint8_t _out[CHUNK];
+
+static void _print(const char *name, uint32_t total)
+{
+    printf("%30s %8"PRIu32" / %u = %"PRIu32"\n", name, total, REPEAT,
+           total / REPEAT);
+}
+
+static void _bytewise(void)
+{
+    for (unsigned i = 0; i < CHUNK; i++) {
+        tsrb_add_one(&_rb, _in[i]);
+    }
+    for (unsigned i = 0; i < CHUNK; i++) {
+        _out[i] = tsrb_get_one(&_rb);
+    }
+}
+
+static void _bulk(void)
+{
+    tsrb_add(&_rb, _in, CHUNK);
+    tsrb_get(&_rb, _out, CHUNK);
+}
+
+static void _contig(void)
+{
+    uint8_t *data;
+    unsigned done = 0;
+
+    /* producer writes in place, e.g. as a DMA transfer would */
+    while (done < CHUNK) {
+        unsigned len = tsrb_reserve_contig(&_rb, &data);
+        if (len > CHUNK - done) {
+            len = CHUNK - done;
+        }
+        memcpy(data, &_in[done], len);
+        tsrb_commit(&_rb, len);
+        done += len;
+    }
+    /* consumer processes in place, e.g. hands the span to a driver */
+    while ((done = tsrb_peek_contig(&_rb, &data))) {
+        memcpy(_out, data, done);
+        tsrb_drop(&_rb, done);
+    }
+}
+
+static void _run(const char *name, void (*func)(void))
+{
+    uint32_t before;
+
+    /* offset the indices so that the chunks straddle the buffer end */
+    tsrb_init(&_rb, _rb_buf, BUF_SIZE);
+    tsrb_add(&_rb, _in, CHUNK / 2 + 1);
+    tsrb_drop(&_rb, CHUNK / 2 + 1);
+
+    before = xtimer_now_usec();
+    for (unsigned n = 0; n < REPEAT; n++) {
+        func();
+    }
+    _print(name, xtimer_now_usec() - before);
+    expect(tsrb_empty(&_rb));
+}
+
+int main(void)
+{
+    puts("tsrb benchmark application.");
+    expect(CHUNK <= BUF_SIZE);
+
+    for (unsigned i = 0; i < CHUNK; i++) {
+        _in[i] = i;
+    }
+
+    _run("tsrb_add_one/tsrb_get_one", _bytewise);
+    expect(memcmp(_in, _out, CHUNK) == 0);
+    _run("tsrb_add/tsrb_get", _bulk);
+    expect(memcmp(_in, _out, CHUNK) == 0);
+    _run("reserve/commit/peek/drop", _contig);
+
+    puts("done.");
+    return 0;
+}
@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2020 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       ztimer list vs. timing wheel benchmark application
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "test_utils/expect.h"
+
+#include "ztimer.h"
+#include "ztimer/mock.h"
+#include "ztimer/wheel.h"
+
+#ifndef NUMOF_TIMERS
+#define NUMOF_TIMERS    (100U)
+#endif
+
+#ifndef REPEAT
+#define REPEAT          (1000U)
+#endif
+
+#ifndef BASE
+#define BASE            (100000000LU)
+#endif
+
+#ifndef SPREAD
+#define SPREAD          (10000LU)
+#endif
+
+#ifndef PERIOD
+#define PERIOD          (1000LU)
+#endif
+
+static ztimer_mock_t _mock_list;
+static ztimer_mock_t _mock_wheel;
+static ztimer_wheel_t _wheel;
+
+static ztimer_t _timers[NUMOF_TIMERS];
+static ztimer_clock_t *_clock;
+
+/* incremented by every timer that triggers */
+static unsigned _triggers;
+
+static void _callback(void *arg)
+{
+    (void)arg;
+    _triggers++;
+}
+
+static void _periodic(void *arg)
+{
+    ztimer_t *timer = arg;
+
+    _triggers++;
+    /* vary the period a bit so timers do not trigger in lockstep */
+    ztimer_set(_clock, timer, PERIOD + (timer - _timers) * 7);
+}
+
+/* the mock clock does not advance, so timer 'n' always ends up at position
+ * 'n' of the list */
+static void _timer_set(unsigned n)
+{
+    ztimer_set(_clock, &_timers[n], BASE + (SPREAD * n));
+}
+
+static void _timer_remove(unsigned n)
+{
+    ztimer_remove(_clock, &_timers[n]);
+}
+
+static void _print_result(const char *desc, unsigned n, uint32_t total)
+{
+    printf("%30s %8"PRIu32" / %u = %"PRIu32"\n", desc, total, n, total/n);
+}
+
+static void _bench_reset(const char *desc, unsigned idx)
+{
+    uint32_t before = ztimer_now(ZTIMER_USEC);
+
+    for (unsigned n = 0; n < REPEAT; n++) {
+        _timer_set(idx);
+    }
+    _print_result(desc, REPEAT, ztimer_now(ZTIMER_USEC) - before);
+    expect(!_triggers);
+}
+
+static void _bench_remove_set(const char *desc, unsigned idx)
+{
+    uint32_t before = ztimer_now(ZTIMER_USEC);
+
+    for (unsigned n = 0; n < REPEAT; n++) {
+        _timer_remove(idx);
+        _timer_set(idx);
+    }
+    _print_result(desc, REPEAT, ztimer_now(ZTIMER_USEC) - before);
+    expect(!_triggers);
+}
+
+static void _bench(const char *name, ztimer_mock_t *mock)
+{
+    uint32_t before;
+
+    printf("%s:\n", name);
+    _clock = &mock->super;
+    _triggers = 0;
+    for (unsigned n = 0; n < NUMOF_TIMERS; n++) {
+        _timers[n].callback = _callback;
+        _timers[n].arg = &_timers[n];
+    }
+
+    before = ztimer_now(ZTIMER_USEC);
+    for (unsigned n = 0; n < NUMOF_TIMERS; n++) {
+        _timer_set(n);
+    }
+    _print_result("set() many increasing target", NUMOF_TIMERS,
+                  ztimer_now(ZTIMER_USEC) - before);
+    expect(!_triggers);
+
+    _bench_reset("re-set()  first", 0);
+    _bench_reset("re-set() middle", NUMOF_TIMERS / 2);
+    _bench_reset("re-set()   last", NUMOF_TIMERS - 1);
+    _bench_remove_set("remove() + set()  first", 0);
+    _bench_remove_set("remove() + set() middle", NUMOF_TIMERS / 2);
+    _bench_remove_set("remove() + set()   last", NUMOF_TIMERS - 1);
+
+    before = ztimer_now(ZTIMER_USEC);
+    for (unsigned n = 0; n < NUMOF_TIMERS; n++) {
+        _timer_remove(NUMOF_TIMERS - n - 1);
+    }
+    _print_result("remove() many decreasing", NUMOF_TIMERS,
+                  ztimer_now(ZTIMER_USEC) - before);
+    expect(!_triggers);
+
+    before = ztimer_now(ZTIMER_USEC);
+    for (unsigned n = 0; n < NUMOF_TIMERS; n++) {
+        ztimer_set(_clock, &_timers[n], 1 + (n * 37) % SPREAD);
+    }
+    ztimer_mock_advance(mock, SPREAD);
+    _print_result("trigger many", NUMOF_TIMERS,
+                  ztimer_now(ZTIMER_USEC) - before);
+    expect(_triggers == NUMOF_TIMERS);
+
+    _triggers = 0;
+    before = ztimer_now(ZTIMER_USEC);
+    for (unsigned n = 0; n < NUMOF_TIMERS; n++) {
+        _timers[n].callback = _periodic;
+        ztimer_set(_clock, &_timers[n], PERIOD + n * 7);
+    }
+    while (_triggers < REPEAT) {
+        ztimer_mock_advance(mock, PERIOD);
+    }
+    _print_result("trigger + set() periodic", _triggers,
+                  ztimer_now(ZTIMER_USEC) - before);
+    for (unsigned n = 0; n < NUMOF_TIMERS; n++) {
+        _timer_remove(n);
+    }
+}
+
+int main(void)
+{
+    puts("ztimer timing wheel benchmark application.\n");
+
+    ztimer_mock_init(&_mock_list, 32);
+    ztimer_mock_init(&_mock_wheel, 32);
+    ztimer_wheel_init(&_mock_wheel.super, &_wheel);
+
+    _bench("list", &_mock_list);
+    _bench("wheel", &_mock_wheel);
+
+    printf("sizeof(ztimer_wheel_t): %u\n", (unsigned)sizeof(ztimer_wheel_t));
+    puts("done.");
+
+    return 0;
+}
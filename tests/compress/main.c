@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for streaming compression
+ *
+ * Compresses a SenML pack written in small pieces, decompresses it again
+ * and compares the result.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "compress.h"
+#include "test_utils/expect.h"
+
+#define PIECE       (7U)
+
+static const char _pack[] =
+    "[{\"bn\":\"urn:dev:mac:0024befffe804ff1:\",\"bt\":1612345678,"
+    "\"n\":\"temp\",\"u\":\"Cel\",\"v\":21.5},"
+    "{\"n\":\"temp\",\"u\":\"Cel\",\"v\":21.6,\"t\":60},"
+    "{\"n\":\"temp\",\"u\":\"Cel\",\"v\":21.6,\"t\":120},"
+    "{\"n\":\"temp\",\"u\":\"Cel\",\"v\":21.7,\"t\":180},"
+    "{\"n\":\"hum\",\"u\":\"%RH\",\"v\":45.2},"
+    "{\"n\":\"hum\",\"u\":\"%RH\",\"v\":45.3,\"t\":60},"
+    "{\"n\":\"hum\",\"u\":\"%RH\",\"v\":45.3,\"t\":120},"
+    "{\"n\":\"hum\",\"u\":\"%RH\",\"v\":45.1,\"t\":180}]";
+
+static uint8_t _compressed[sizeof(_pack)];
+static size_t _compressed_len;
+static char _out[sizeof(_pack)];
+static size_t _out_len;
+static unsigned _chunks;
+
+static compress_t _ctx;
+static decompress_t _dctx;
+
+static int _collect(void *arg, const void *data, size_t len)
+{
+    (void)arg;
+    expect(len <= CONFIG_COMPRESS_CHUNK_SIZE);
+    expect(_compressed_len + len <= sizeof(_compressed));
+    memcpy(_compressed + _compressed_len, data, len);
+    _compressed_len += len;
+    _chunks++;
+    return 0;
+}
+
+static int _collect_out(void *arg, const void *data, size_t len)
+{
+    (void)arg;
+    if (_out_len + len > sizeof(_out)) {
+        return -ENOBUFS;
+    }
+    memcpy(_out + _out_len, data, len);
+    _out_len += len;
+    return 0;
+}
+
+static void _print_stats(const char *name, const compress_stats_t *stats)
+{
+    printf("%s: %u bytes in, %u bytes out, %u.%u %%, %u us\n", name,
+           (unsigned)stats->in, (unsigned)stats->out,
+           compress_ratio(stats) / 10, compress_ratio(stats) % 10,
+           (unsigned)stats->time_us);
+}
+
+int main(void)
+{
+    puts("compress test application\n");
+
+    /* the pack is written as it would be encoded, piece by piece */
+    compress_init(&_ctx, _collect, NULL);
+    for (size_t i = 0; i < sizeof(_pack) - 1; i += PIECE) {
+        size_t n = sizeof(_pack) - 1 - i;
+        expect(compress_write(&_ctx, _pack + i, (n < PIECE) ? n : PIECE) == 0);
+    }
+    expect(compress_finish(&_ctx) == 0);
+    _print_stats("compress", &_ctx.stats);
+    expect(_ctx.stats.in == sizeof(_pack) - 1);
+    expect(_ctx.stats.out == _compressed_len);
+    expect(_compressed_len < sizeof(_pack) - 1);
+    /* all chunks but the last are full */
+    expect(_chunks == (_compressed_len + CONFIG_COMPRESS_CHUNK_SIZE - 1) /
+                      CONFIG_COMPRESS_CHUNK_SIZE);
+
+    decompress_init(&_dctx, _collect_out, NULL);
+    for (size_t i = 0; i < _compressed_len; i += PIECE) {
+        size_t n = _compressed_len - i;
+        expect(decompress_write(&_dctx, _compressed + i,
+                                (n < PIECE) ? n : PIECE) == 0);
+    }
+    expect(decompress_finish(&_dctx) == 0);
+    _print_stats("decompress", &_dctx.stats);
+    expect(_out_len == sizeof(_pack) - 1);
+    expect(memcmp(_out, _pack, _out_len) == 0);
+
+    /* in one go, into a buffer that is too small or just fits */
+    compress_stats_t stats;
+    expect(compress_buf(_pack, sizeof(_pack) - 1, _out, _compressed_len - 1,
+                        NULL) == -ENOBUFS);
+    expect(compress_buf(_pack, sizeof(_pack) - 1, _out, _compressed_len,
+                        &stats) == (ssize_t)_compressed_len);
+    expect(memcmp(_out, _compressed, _compressed_len) == 0);
+    _print_stats("buffer", &stats);
+
+    puts("[SUCCESS]");
+    return 0;
+}
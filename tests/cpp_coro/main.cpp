@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief test coroutine tasks
+ *
+ * @author ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <cstdio>
+
+#include "event.h"
+#include "riot/coro.hpp"
+#include "ztimer.h"
+
+#include "test_utils/expect.h"
+
+using namespace riot::coro;
+
+static event_queue_t queue;
+static flags done;
+static mutex m;
+static unsigned counter;
+
+static task<unsigned> square(unsigned x) {
+  co_await sleep(10);
+  co_return x * x;
+}
+
+static task<> worker(unsigned id) {
+  for (unsigned i = 0; i < 3; i++) {
+    co_await m.lock();
+    unsigned before = counter;
+    co_await sleep(5);
+    counter = before + 1;
+    m.unlock();
+  }
+  done.set(1u << id);
+}
+
+static task<> test() {
+  puts("Await result ...");
+  unsigned res = co_await square(7);
+  expect(res == 49);
+  puts("Done");
+
+  puts("Sleep ...");
+  uint32_t start = ztimer_now(ZTIMER_MSEC);
+  co_await sleep(100);
+  expect(ztimer_now(ZTIMER_MSEC) - start >= 100);
+  puts("Done");
+
+  puts("Mutex and flags ...");
+  for (unsigned id = 0; id < 4; id++) {
+    expect(spawn(&queue, worker(id)) == 0);
+  }
+  uint32_t got = co_await done.wait_all(0xf);
+  expect(got == 0xf);
+  /* the mutex keeps the read-modify-write across the sleep consistent */
+  expect(counter == 12);
+  puts("Done");
+
+  puts("Bye, bye.");
+  puts("*****************************************");
+}
+
+int main() {
+  puts("\n*********** C++ coroutine test **********");
+
+  event_queue_init(&queue);
+  expect(spawn(&queue, test()) == 0);
+  event_loop(&queue);
+
+  return 0;
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for the DSP pipeline
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "dsp_pipeline.h"
+#include "event/thread.h"
+#include "mutex.h"
+#include "test_utils/expect.h"
+
+#define BLOCK_SIZE      (64U)
+#define BLOCKS          (3U)
+#define NUM_TAPS        (4U)
+#define RUNS            (8U)
+
+static dsp_pipeline_t _pipe;
+static dsp_block_t _blocks[BLOCKS];
+static q15_t _samples[BLOCKS][BLOCK_SIZE];
+
+/* moving average of four samples */
+static const q15_t _fir_coeffs[NUM_TAPS] = { 0x2000, 0x2000, 0x2000, 0x2000 };
+static q15_t _fir_state[NUM_TAPS + BLOCK_SIZE - 1];
+/* b0 = 0.5 with a post shift of 1, passes the signal unchanged */
+static const q15_t _iir_coeffs[6] = { 0x4000, 0, 0, 0, 0, 0 };
+static q15_t _iir_state[4];
+
+static dsp_fir_t _fir;
+static dsp_iir_t _iir;
+static dsp_rms_t _rms;
+static dsp_sink_t _sink;
+
+static mutex_t _done = MUTEX_INIT_LOCKED;
+static unsigned _received;
+static q15_t _result;
+
+static void _sink_cb(void *arg, const q15_t *data, size_t len)
+{
+    (void)arg;
+
+    expect(len == 1);
+    _result = data[0];
+    _received++;
+    mutex_unlock(&_done);
+}
+
+int main(void)
+{
+    puts("dsp_pipeline test");
+
+    dsp_pipeline_init(&_pipe, EVENT_PRIO_MEDIUM, _blocks, BLOCKS,
+                      _samples[0], BLOCK_SIZE);
+    expect(dsp_fir_init(&_fir, &_pipe, _fir_coeffs, NUM_TAPS,
+                        _fir_state) == 0);
+    dsp_iir_init(&_iir, &_pipe, 1, _iir_coeffs, _iir_state, 1);
+    dsp_rms_init(&_rms, &_pipe);
+    dsp_sink_init(&_sink, &_pipe, _sink_cb, NULL);
+    dsp_stage_connect(&_fir.super, &_iir.super);
+    dsp_stage_connect(&_iir.super, &_rms.super);
+    dsp_stage_connect(&_rms.super, &_sink.super);
+
+    for (unsigned i = 0; i < RUNS; i++) {
+        dsp_block_t *block = dsp_block_alloc(&_pipe);
+
+        expect(block);
+        for (unsigned j = 0; j < block->len; j++) {
+            /* DC of 0.5 with an alternating ripple the average removes */
+            block->data[j] = (j & 1) ? 0x4400 : 0x3c00;
+        }
+        dsp_stage_push(&_fir.super, block);
+        mutex_lock(&_done);
+    }
+
+    /* check the last result, the first block includes the filter start */
+    printf("rms: 0x%04x\n", (unsigned)_result);
+    expect(_received == RUNS);
+    expect(abs(_result - 0x4000) <= 2);
+
+    /* all blocks are back in the pool */
+    for (unsigned i = 0; i < BLOCKS; i++) {
+        expect(dsp_block_alloc(&_pipe));
+    }
+    expect(dsp_block_alloc(&_pipe) == NULL);
+
+    dsp_pipeline_print(&_pipe);
+    puts("SUCCESS");
+    return 0;
+}
@@ -0,0 +1,24 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 ML!PA Consulting GmbH
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("dsp_pipeline test")
+    child.expect_exact("rms: 0x")
+    child.expect(r"fir\s+8\s+0\s+\d+\s+\d+")
+    child.expect(r"iir\s+8\s+0\s+\d+\s+\d+")
+    child.expect(r"rms\s+8\s+0\s+\d+\s+\d+")
+    child.expect(r"sink\s+8\s+0\s+\d+\s+\d+")
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for deferred work items
+ *
+ * The work items run on the lowest priority event thread, so they only run
+ * while main sleeps. Posts until then are coalesced.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "event/deferred.h"
+#include "event/thread.h"
+#include "test_utils/expect.h"
+#include "ztimer.h"
+
+#define ISR_POSTS       (5U)
+#define DEADLINE_US     (1000U)
+
+static event_deferred_t _work;
+static event_deferred_t _requeue;
+static unsigned _handled;
+static volatile unsigned _isr_posts;
+static ztimer_t _timer;
+
+static void _count(event_deferred_t *work)
+{
+    (void)work;
+    _handled++;
+}
+
+static void _post_self_once(event_deferred_t *work)
+{
+    if (work->stats.runs == 1) {
+        event_deferred_post(work);
+    }
+}
+
+static void _isr_cb(void *arg)
+{
+    (void)arg;
+    event_deferred_post(&_work);
+    if (++_isr_posts < ISR_POSTS) {
+        ztimer_set(ZTIMER_USEC, &_timer, 100);
+    }
+}
+
+/* keeps main running, so that the work items cannot run meanwhile */
+static void _busy_wait(uint32_t us)
+{
+    uint32_t start = ztimer_now(ZTIMER_USEC);
+
+    while (ztimer_now(ZTIMER_USEC) - start < us) {}
+}
+
+static void _print_stats(const char *name, const event_deferred_t *work)
+{
+    printf("%s: runs %u, coalesced %u, misses %u, latency max %u us, "
+           "exec max %u us\n", name, (unsigned)work->stats.runs,
+           (unsigned)work->stats.coalesced, (unsigned)work->stats.misses,
+           (unsigned)work->stats.latency_max, (unsigned)work->stats.exec_max);
+}
+
+int main(void)
+{
+    puts("event_deferred test application\n");
+
+    /* repeated posts are coalesced into one run */
+    event_deferred_init(&_work, EVENT_PRIO_LOWEST, _count, 0);
+    for (unsigned i = 0; i < 3; i++) {
+        event_deferred_post(&_work);
+    }
+    expect(event_deferred_is_pending(&_work));
+    ztimer_sleep(ZTIMER_USEC, 1000);
+    _print_stats("coalesced", &_work);
+    expect(_handled == 1);
+    expect(_work.stats.runs == 1);
+    expect(_work.stats.coalesced == 2);
+    expect(!event_deferred_is_pending(&_work));
+
+    /* posts from ISR context while main is busy */
+    event_deferred_stats_reset(&_work);
+    _handled = 0;
+    _timer.callback = _isr_cb;
+    ztimer_set(ZTIMER_USEC, &_timer, 100);
+    while (_isr_posts < ISR_POSTS) {}
+    ztimer_sleep(ZTIMER_USEC, 1000);
+    _print_stats("isr", &_work);
+    expect(_handled == 1);
+    expect(_work.stats.coalesced == ISR_POSTS - 1);
+
+    /* a run starting after the deadline counts as miss */
+    event_deferred_init(&_work, EVENT_PRIO_LOWEST, _count, DEADLINE_US);
+    event_deferred_post(&_work);
+    _busy_wait(2 * DEADLINE_US);
+    ztimer_sleep(ZTIMER_USEC, 1000);
+    _print_stats("deadline", &_work);
+    expect(_work.stats.misses == 1);
+    expect(_work.stats.latency_max >= 2 * DEADLINE_US);
+
+    /* a cancelled item does not run */
+    event_deferred_post(&_work);
+    event_deferred_cancel(&_work);
+    ztimer_sleep(ZTIMER_USEC, 1000);
+    expect(_work.stats.runs == 1);
+
+    /* a post while the handler runs is not lost */
+    event_deferred_init(&_requeue, EVENT_PRIO_LOWEST, _post_self_once, 0);
+    event_deferred_post(&_requeue);
+    ztimer_sleep(ZTIMER_USEC, 1000);
+    _print_stats("requeue", &_requeue);
+    expect(_requeue.stats.runs == 2);
+    expect(_requeue.stats.coalesced == 0);
+
+    puts("[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2020 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for the lock-free event_post()
+ *
+ * Several threads and a timer ISR post events at high rate while the main
+ * thread handles them. Every post must be followed by at least one run of
+ * the handler and the order of the handled events must be kept.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "event.h"
+#include "test_utils/expect.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define PRODUCERS       (3U)
+#define ROUNDS          (1000U)
+#define ISR_PERIOD_US   (200U)
+
+typedef struct {
+    event_t super;
+    unsigned posted;
+    unsigned handled;
+} counting_event_t;
+
+static char _stacks[PRODUCERS][THREAD_STACKSIZE_DEFAULT];
+static counting_event_t _events[PRODUCERS];
+static counting_event_t _isr_event;
+static event_t _order[3];
+static unsigned _order_idx;
+static event_queue_t _queue;
+static xtimer_t _timer;
+
+static void _count(event_t *event)
+{
+    counting_event_t *ev = container_of(event, counting_event_t, super);
+
+    ev->handled++;
+}
+
+static void _check_order(event_t *event)
+{
+    expect(event == &_order[_order_idx]);
+    _order_idx++;
+}
+
+static void _isr_cb(void *arg)
+{
+    (void)arg;
+    _isr_event.posted++;
+    event_post(&_queue, &_isr_event.super);
+    if (_isr_event.posted < ROUNDS) {
+        xtimer_set(&_timer, ISR_PERIOD_US);
+    }
+}
+
+static void *_producer(void *arg)
+{
+    counting_event_t *ev = arg;
+
+    for (unsigned i = 0; i < ROUNDS; i++) {
+        ev->posted++;
+        event_post(&_queue, &ev->super);
+        thread_yield_higher();
+    }
+    return NULL;
+}
+
+static bool _done(void)
+{
+    if (_isr_event.posted < ROUNDS) {
+        return false;
+    }
+    for (unsigned i = 0; i < PRODUCERS; i++) {
+        if (_events[i].posted < ROUNDS) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(void)
+{
+    puts("event_lockfree test application\n");
+
+    event_queue_init(&_queue);
+
+    /* events are handled in the order they were posted */
+    for (unsigned i = 0; i < ARRAY_SIZE(_order); i++) {
+        _order[i].handler = _check_order;
+        event_post(&_queue, &_order[i]);
+    }
+    /* posting a queued event again does not change its position */
+    event_post(&_queue, &_order[0]);
+    event_t *ev;
+    while ((ev = event_get(&_queue))) {
+        ev->handler(ev);
+    }
+    expect(_order_idx == ARRAY_SIZE(_order));
+
+    _isr_event.super.handler = _count;
+    _timer.callback = _isr_cb;
+    xtimer_set(&_timer, ISR_PERIOD_US);
+    for (unsigned i = 0; i < PRODUCERS; i++) {
+        _events[i].super.handler = _count;
+        thread_create(_stacks[i], sizeof(_stacks[i]), THREAD_PRIORITY_MAIN - 1,
+                      THREAD_CREATE_WOUT_YIELD | THREAD_CREATE_STACKTEST,
+                      _producer, &_events[i], "producer");
+    }
+
+    /* once all posts are done, the queue runs empty eventually */
+    while ((ev = event_wait_timeout(&_queue, 10 * US_PER_MS)) || !_done()) {
+        if (ev) {
+            ev->handler(ev);
+        }
+    }
+
+    for (unsigned i = 0; i < PRODUCERS; i++) {
+        printf("producer %u: posted %u, handled %u\n", i, _events[i].posted,
+               _events[i].handled);
+        expect(_events[i].handled > 0);
+        expect(_events[i].handled <= _events[i].posted);
+        expect(_events[i].super.list_node.next == NULL);
+    }
+    printf("isr: posted %u, handled %u\n", _isr_event.posted,
+           _isr_event.handled);
+    expect(_isr_event.handled > 0);
+
+    puts("[SUCCESS]");
+    return 0;
+}
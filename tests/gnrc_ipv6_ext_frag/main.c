@@ -23,7 +23,7 @@
 #include <string.h>
 
 #include "byteorder.h"
-#include "clist.h"
+#include "bitfield.h"
 #include "embUnit.h"
 #include "net/ipv6/addr.h"
 #include "net/ipv6/ext/frag.h"
@@ -100,6 +100,17 @@ static void tear_down_tests(void)
     gnrc_pktbuf_init();
 }
 
+static bool _units_received(gnrc_ipv6_ext_frag_rbuf_t *rbuf,
+                            size_t start, size_t end)
+{
+    for (unsigned i = start / 8; i < ((end + 7) / 8); i++) {
+        if (!bf_isset(rbuf->received_map, i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 static void test_ipv6_ext_frag_rbuf_get(void)
 {
     static ipv6_hdr_t ipv6 = { .src = { .u8 = TEST_SRC },
@@ -134,7 +145,7 @@ static void test_ipv6_ext_frag_rbuf_free(void)
     rbuf->pkt = pkt;
     gnrc_ipv6_ext_frag_rbuf_free(rbuf);
     TEST_ASSERT_NULL(rbuf->ipv6);
-    TEST_ASSERT_NULL(rbuf->limits.next);
+    TEST_ASSERT_EQUAL_INT(0, rbuf->received);
     TEST_ASSERT_EQUAL_INT(1, pkt->users);
     gnrc_pktbuf_release(pkt);
     TEST_ASSERT(gnrc_pktbuf_is_sane());
@@ -154,7 +165,7 @@ static void test_ipv6_ext_frag_rbuf_del(void)
     gnrc_ipv6_ext_frag_rbuf_del(rbuf);
     TEST_ASSERT_NULL(rbuf->pkt);
     TEST_ASSERT_NULL(rbuf->ipv6);
-    TEST_ASSERT_NULL(rbuf->limits.next);
+    TEST_ASSERT_EQUAL_INT(0, rbuf->received);
     TEST_ASSERT(gnrc_pktbuf_is_sane());
     TEST_ASSERT(gnrc_pktbuf_is_empty());
 }
@@ -177,7 +188,7 @@ static void test_ipv6_ext_frag_rbuf_gc(void)
     gnrc_ipv6_ext_frag_rbuf_gc();
     TEST_ASSERT_NULL(rbuf->pkt);
     TEST_ASSERT_NULL(rbuf->ipv6);
-    TEST_ASSERT_NULL(rbuf->limits.next);
+    TEST_ASSERT_EQUAL_INT(0, rbuf->received);
 }
 
 static void test_ipv6_ext_frag_reass_in_order(void)
@@ -189,7 +200,6 @@ static void test_ipv6_ext_frag_reass_in_order(void)
     ipv6_hdr_t *ipv6 = ipv6_snip->data;
     ipv6_ext_frag_t *frag = pkt->data;
     gnrc_ipv6_ext_frag_rbuf_t *rbuf;
-    gnrc_ipv6_ext_frag_limits_t *ptr;
 
     ipv6->nh = PROTNUM_IPV6_EXT_FRAG;
     ipv6->hl = TEST_HL;
@@ -209,13 +219,8 @@ static void test_ipv6_ext_frag_reass_in_order(void)
     TEST_ASSERT_MESSAGE(ipv6 == rbuf->ipv6, "IPv6 header is not the same");
     TEST_ASSERT_EQUAL_INT(TEST_ID, rbuf->id);
     TEST_ASSERT(!rbuf->last);
-    ptr = (gnrc_ipv6_ext_frag_limits_t *)rbuf->limits.next;
-    TEST_ASSERT_NOT_NULL(ptr);
-    ptr = ptr->next;
-    TEST_ASSERT_NOT_NULL(ptr);
-    TEST_ASSERT_EQUAL_INT(0, ptr->start);
-    TEST_ASSERT_EQUAL_INT(TEST_FRAG2_OFFSET / 8, ptr->end);
-    TEST_ASSERT(((clist_node_t *)ptr) == rbuf->limits.next);
+    TEST_ASSERT_EQUAL_INT(TEST_FRAG2_OFFSET, rbuf->received);
+    TEST_ASSERT(_units_received(rbuf, 0, TEST_FRAG2_OFFSET));
     TEST_ASSERT(memcmp(_exp_payload, rbuf->pkt->data, rbuf->pkt->size) == 0);
 
     /* prepare 2nd fragment */
@@ -243,18 +248,8 @@ static void test_ipv6_ext_frag_reass_in_order(void)
                           rbuf->pkt->size);
     TEST_ASSERT_EQUAL_INT(TEST_ID, rbuf->id);
     TEST_ASSERT(!rbuf->last);
-    ptr = (gnrc_ipv6_ext_frag_limits_t *)rbuf->limits.next;
-    TEST_ASSERT_NOT_NULL(ptr);
-    ptr = ptr->next;
-    TEST_ASSERT_NOT_NULL(ptr);
-    TEST_ASSERT_EQUAL_INT(0, ptr->start);
-    TEST_ASSERT_EQUAL_INT(TEST_FRAG2_OFFSET / 8, ptr->end);
-    TEST_ASSERT_NOT_NULL(ptr->next);
-    ptr = ptr->next;
-    TEST_ASSERT_NOT_NULL(ptr);
-    TEST_ASSERT_EQUAL_INT(TEST_FRAG2_OFFSET / 8, ptr->start);
-    TEST_ASSERT_EQUAL_INT(TEST_FRAG3_OFFSET / 8, ptr->end);
-    TEST_ASSERT(((clist_node_t *)ptr) == rbuf->limits.next);
+    TEST_ASSERT_EQUAL_INT(TEST_FRAG3_OFFSET, rbuf->received);
+    TEST_ASSERT(_units_received(rbuf, 0, TEST_FRAG3_OFFSET));
     TEST_ASSERT(memcmp(_exp_payload, rbuf->pkt->data, rbuf->pkt->size) == 0);
 
     /* prepare 3rd fragment */
@@ -299,7 +294,6 @@ static void test_ipv6_ext_frag_reass_out_of_order(void)
     ipv6_hdr_t *ipv6 = ipv6_snip->data;
     ipv6_ext_frag_t *frag = pkt->data;
     gnrc_ipv6_ext_frag_rbuf_t *rbuf;
-    gnrc_ipv6_ext_frag_limits_t *ptr;
 
 
     ipv6->nh = PROTNUM_IPV6_EXT_FRAG;
@@ -317,13 +311,8 @@ static void test_ipv6_ext_frag_reass_out_of_order(void)
     TEST_ASSERT_EQUAL_INT(sizeof(_exp_payload), rbuf->pkt->size);
     TEST_ASSERT_EQUAL_INT(TEST_ID, rbuf->id);
     TEST_ASSERT(rbuf->last);
-    ptr = (gnrc_ipv6_ext_frag_limits_t *)rbuf->limits.next;
-    TEST_ASSERT_NOT_NULL(ptr);
-    ptr = ptr->next;
-    TEST_ASSERT_NOT_NULL(ptr);
-    TEST_ASSERT_EQUAL_INT(TEST_FRAG3_OFFSET / 8, ptr->start);
-    TEST_ASSERT_EQUAL_INT(sizeof(_exp_payload) / 8, ptr->end);
-    TEST_ASSERT(((clist_node_t *)ptr) == rbuf->limits.next);
+    TEST_ASSERT_EQUAL_INT(sizeof(_exp_payload) - TEST_FRAG3_OFFSET, rbuf->received);
+    TEST_ASSERT(_units_received(rbuf, TEST_FRAG3_OFFSET, sizeof(_exp_payload)));
     TEST_ASSERT(memcmp(&_exp_payload[TEST_FRAG3_OFFSET],
                        (uint8_t *)rbuf->pkt->data + TEST_FRAG3_OFFSET,
                        rbuf->pkt->size - TEST_FRAG3_OFFSET) == 0);
@@ -350,18 +339,8 @@ static void test_ipv6_ext_frag_reass_out_of_order(void)
     TEST_ASSERT_NOT_NULL(rbuf->pkt);
     TEST_ASSERT_EQUAL_INT(sizeof(_exp_payload), rbuf->pkt->size);
     TEST_ASSERT(rbuf->last);
-    ptr = (gnrc_ipv6_ext_frag_limits_t *)rbuf->limits.next;
-    TEST_ASSERT_NOT_NULL(ptr);
-    ptr = ptr->next;
-    TEST_ASSERT_NOT_NULL(ptr);
-    TEST_ASSERT_EQUAL_INT(TEST_FRAG2_OFFSET / 8, ptr->start);
-    TEST_ASSERT_EQUAL_INT(TEST_FRAG3_OFFSET / 8, ptr->end);
-    ptr = ptr->next;
-    TEST_ASSERT_NOT_NULL(ptr);
-    TEST_ASSERT_EQUAL_INT(TEST_FRAG3_OFFSET / 8, ptr->start);
-    TEST_ASSERT_EQUAL_INT(sizeof(_exp_payload) / 8, ptr->end);
-    TEST_ASSERT_NOT_NULL(ptr->next);
-    TEST_ASSERT(((clist_node_t *)ptr) == rbuf->limits.next);
+    TEST_ASSERT_EQUAL_INT(sizeof(_exp_payload) - TEST_FRAG2_OFFSET, rbuf->received);
+    TEST_ASSERT(_units_received(rbuf, TEST_FRAG2_OFFSET, sizeof(_exp_payload)));
     TEST_ASSERT(memcmp(&_exp_payload[TEST_FRAG2_OFFSET],
                        (uint8_t *)rbuf->pkt->data + TEST_FRAG2_OFFSET,
                        rbuf->pkt->size - TEST_FRAG2_OFFSET) == 0);
@@ -408,7 +387,6 @@ static void test_ipv6_ext_frag_reass_out_of_order_rbuf_full(void)
     ipv6_hdr_t *ipv6 = ipv6_snip->data;
     ipv6_ext_frag_t *frag = pkt->data;
     gnrc_ipv6_ext_frag_rbuf_t *rbuf;
-    gnrc_ipv6_ext_frag_limits_t *ptr;
     static const uint32_t foreign_id = TEST_ID + 44U;
 
 
@@ -430,13 +408,8 @@ static void test_ipv6_ext_frag_reass_out_of_order_rbuf_full(void)
     TEST_ASSERT_EQUAL_INT(sizeof(_exp_payload), rbuf->pkt->size);
     TEST_ASSERT_EQUAL_INT(foreign_id, rbuf->id);
     TEST_ASSERT(rbuf->last);
-    ptr = (gnrc_ipv6_ext_frag_limits_t *)rbuf->limits.next;
-    TEST_ASSERT_NOT_NULL(ptr);
-    ptr = ptr->next;
-    TEST_ASSERT_NOT_NULL(ptr);
-    TEST_ASSERT_EQUAL_INT(TEST_FRAG3_OFFSET / 8, ptr->start);
-    TEST_ASSERT_EQUAL_INT(sizeof(_exp_payload) / 8, ptr->end);
-    TEST_ASSERT(((clist_node_t *)ptr) == rbuf->limits.next);
+    TEST_ASSERT_EQUAL_INT(sizeof(_exp_payload) - TEST_FRAG3_OFFSET, rbuf->received);
+    TEST_ASSERT(_units_received(rbuf, TEST_FRAG3_OFFSET, sizeof(_exp_payload)));
     TEST_ASSERT(memcmp(&_exp_payload[TEST_FRAG3_OFFSET],
                        (uint8_t *)rbuf->pkt->data + TEST_FRAG3_OFFSET,
                        rbuf->pkt->size - TEST_FRAG3_OFFSET) == 0);
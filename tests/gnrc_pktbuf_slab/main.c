@@ -0,0 +1,219 @@
+/*
+ * Copyright (C) 2020 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests the size-class slab packet buffer
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/pktbuf_slab.h"
+
+#define FRAME_LEN   (127U)
+
+static uint8_t _data[CONFIG_GNRC_PKTBUF_SLAB_LARGE_SIZE];
+
+static void set_up(void)
+{
+    gnrc_pktbuf_init();
+}
+
+static unsigned _used(gnrc_pktbuf_slab_class_t cls)
+{
+    gnrc_pktbuf_slab_stats_t stats;
+
+    if (gnrc_pktbuf_slab_get_stats(cls, &stats) < 0) {
+        return UINT16_MAX;
+    }
+    return stats.used;
+}
+
+static void test_pktbuf_slab_get_stats__EINVAL(void)
+{
+    gnrc_pktbuf_slab_stats_t stats;
+
+    TEST_ASSERT_EQUAL_INT(-EINVAL,
+                          gnrc_pktbuf_slab_get_stats(GNRC_PKTBUF_SLAB_NUMOF,
+                                                     &stats));
+}
+
+static void test_pktbuf_slab_add__size_class(void)
+{
+    gnrc_pktsnip_t *hdr, *frame, *large;
+
+    hdr = gnrc_pktbuf_add(NULL, _data, 8, GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(hdr);
+    frame = gnrc_pktbuf_add(NULL, _data, FRAME_LEN, GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(frame);
+    large = gnrc_pktbuf_add(NULL, _data, sizeof(_data), GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(large);
+    TEST_ASSERT_EQUAL_INT(3, _used(GNRC_PKTBUF_SLAB_SNIP));
+    TEST_ASSERT_EQUAL_INT(1, _used(GNRC_PKTBUF_SLAB_SMALL));
+    TEST_ASSERT_EQUAL_INT(1, _used(GNRC_PKTBUF_SLAB_FRAME));
+    TEST_ASSERT_EQUAL_INT(1, _used(GNRC_PKTBUF_SLAB_LARGE));
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_release(hdr);
+    gnrc_pktbuf_release(frame);
+    gnrc_pktbuf_release(large);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_slab_add__too_large(void)
+{
+    TEST_ASSERT_NULL(gnrc_pktbuf_add(NULL, NULL,
+                                     CONFIG_GNRC_PKTBUF_SLAB_LARGE_SIZE + 1,
+                                     GNRC_NETTYPE_UNDEF));
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_slab_add__fallback(void)
+{
+    gnrc_pktsnip_t *pkts[3];
+    gnrc_pktbuf_slab_stats_t stats;
+
+    /* exhaust small class, third allocation goes to frame class */
+    for (unsigned i = 0; i < 3; i++) {
+        pkts[i] = gnrc_pktbuf_add(NULL, _data, 8, GNRC_NETTYPE_UNDEF);
+        TEST_ASSERT_NOT_NULL(pkts[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(2, _used(GNRC_PKTBUF_SLAB_SMALL));
+    TEST_ASSERT_EQUAL_INT(1, _used(GNRC_PKTBUF_SLAB_FRAME));
+    gnrc_pktbuf_slab_get_stats(GNRC_PKTBUF_SLAB_SMALL, &stats);
+    TEST_ASSERT_EQUAL_INT(1, stats.fallbacks);
+    TEST_ASSERT_EQUAL_INT(2, stats.max_used);
+    for (unsigned i = 0; i < 3; i++) {
+        gnrc_pktbuf_release(pkts[i]);
+    }
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+    /* high-water mark persists after release */
+    gnrc_pktbuf_slab_get_stats(GNRC_PKTBUF_SLAB_SMALL, &stats);
+    TEST_ASSERT_EQUAL_INT(2, stats.max_used);
+    gnrc_pktbuf_slab_reset_stats();
+    gnrc_pktbuf_slab_get_stats(GNRC_PKTBUF_SLAB_SMALL, &stats);
+    TEST_ASSERT_EQUAL_INT(0, stats.max_used);
+    TEST_ASSERT_EQUAL_INT(0, stats.fallbacks);
+}
+
+static void test_pktbuf_slab_add__memfull(void)
+{
+    gnrc_pktsnip_t *large;
+    gnrc_pktbuf_slab_stats_t stats;
+
+    large = gnrc_pktbuf_add(NULL, NULL, sizeof(_data), GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(large);
+    TEST_ASSERT_NULL(gnrc_pktbuf_add(NULL, NULL, sizeof(_data),
+                                     GNRC_NETTYPE_UNDEF));
+    gnrc_pktbuf_slab_get_stats(GNRC_PKTBUF_SLAB_LARGE, &stats);
+    TEST_ASSERT_EQUAL_INT(1, stats.failures);
+    /* snip header of the failed allocation was returned */
+    TEST_ASSERT_EQUAL_INT(1, _used(GNRC_PKTBUF_SLAB_SNIP));
+    gnrc_pktbuf_release(large);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_slab_mark__shared_block(void)
+{
+    gnrc_pktsnip_t *pkt, *hdr;
+
+    for (unsigned i = 0; i < FRAME_LEN; i++) {
+        _data[i] = i;
+    }
+    pkt = gnrc_pktbuf_add(NULL, _data, FRAME_LEN, GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(pkt);
+    hdr = gnrc_pktbuf_mark(pkt, 3, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(hdr);
+    /* no additional data block required */
+    TEST_ASSERT_EQUAL_INT(1, _used(GNRC_PKTBUF_SLAB_FRAME));
+    TEST_ASSERT_EQUAL_INT(0, _used(GNRC_PKTBUF_SLAB_SMALL));
+    TEST_ASSERT_EQUAL_INT(3, hdr->size);
+    TEST_ASSERT_EQUAL_INT(FRAME_LEN - 3, pkt->size);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_data, hdr->data, hdr->size));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&_data[3], pkt->data, pkt->size));
+    /* block is kept as long as one of the snips references it */
+    pkt = gnrc_pktbuf_remove_snip(pkt, hdr);
+    TEST_ASSERT_EQUAL_INT(1, _used(GNRC_PKTBUF_SLAB_FRAME));
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_slab_realloc_data__in_place(void)
+{
+    gnrc_pktsnip_t *pkt;
+    void *data;
+
+    pkt = gnrc_pktbuf_add(NULL, _data, 80, GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(pkt);
+    data = pkt->data;
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(pkt, 20));
+    TEST_ASSERT(data == pkt->data);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(pkt, FRAME_LEN));
+    TEST_ASSERT(data == pkt->data);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(pkt, 200));
+    TEST_ASSERT(data != pkt->data);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_data, pkt->data, 20));
+    TEST_ASSERT_EQUAL_INT(0, _used(GNRC_PKTBUF_SLAB_FRAME));
+    TEST_ASSERT_EQUAL_INT(1, _used(GNRC_PKTBUF_SLAB_LARGE));
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_slab_realloc_data__shared_block(void)
+{
+    gnrc_pktsnip_t *pkt, *hdr;
+
+    pkt = gnrc_pktbuf_add(NULL, _data, 40, GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(pkt);
+    hdr = gnrc_pktbuf_mark(pkt, 8, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(hdr);
+    /* must not grow into the data of pkt */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(hdr, 16));
+    TEST_ASSERT(((uint8_t *)hdr->data + 16) <= (uint8_t *)pkt->data ||
+                (uint8_t *)hdr->data >= ((uint8_t *)pkt->data + pkt->size));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_data, hdr->data, 8));
+    TEST_ASSERT_EQUAL_INT(2, _used(GNRC_PKTBUF_SLAB_SMALL));
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static Test *tests_gnrc_pktbuf_slab(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_pktbuf_slab_get_stats__EINVAL),
+        new_TestFixture(test_pktbuf_slab_add__size_class),
+        new_TestFixture(test_pktbuf_slab_add__too_large),
+        new_TestFixture(test_pktbuf_slab_add__fallback),
+        new_TestFixture(test_pktbuf_slab_add__memfull),
+        new_TestFixture(test_pktbuf_slab_mark__shared_block),
+        new_TestFixture(test_pktbuf_slab_realloc_data__in_place),
+        new_TestFixture(test_pktbuf_slab_realloc_data__shared_block),
+    };
+
+    EMB_UNIT_TESTCALLER(tests, set_up, NULL, fixtures);
+
+    return (Test *)&tests;
+}
+
+int main(void)
+{
+    TESTS_START();
+    TESTS_RUN(tests_gnrc_pktbuf_slab());
+    TESTS_END();
+
+    return 0;
+}
@@ -19,6 +19,7 @@
  * @}
  */
 
+#include <errno.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
@@ -199,6 +200,39 @@ static void test_rpl_srh_nexthop_prefix_elided(void)
     TEST_ASSERT(ipv6_addr_equal(&hdr.dst, &expected2));
 }
 
+static void test_rpl_srh_build(void)
+{
+    static const ipv6_addr_t route[] = { IPV6_ADDR1, IPV6_ADDR2, IPV6_DST };
+    gnrc_rpl_srh_t *srh;
+    uint8_t *vec;
+    void *err_ptr;
+    int res;
+
+    _init_hdrs(&srh, &vec, &route[0]);
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS, gnrc_rpl_srh_build(srh, 8, route, 3));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, gnrc_rpl_srh_build(srh, sizeof(buf),
+                                                      route, 1));
+
+    /* one octet per address and 6 octets of padding */
+    res = gnrc_rpl_srh_build(srh, sizeof(buf), route, 3);
+    TEST_ASSERT_EQUAL_INT(16, res);
+    TEST_ASSERT_EQUAL_INT(1, srh->len);
+    TEST_ASSERT_EQUAL_INT(2, srh->seg_left);
+    TEST_ASSERT_EQUAL_INT((15 << 4) | 15, srh->compr);
+    TEST_ASSERT_EQUAL_INT(6 << 4, srh->pad_resv);
+    TEST_ASSERT_EQUAL_INT(0x03, vec[0]);
+    TEST_ASSERT_EQUAL_INT(0x01, vec[1]);
+
+    /* the built header is processed along the route */
+    res = gnrc_rpl_srh_process(&hdr, srh, &err_ptr);
+    TEST_ASSERT_EQUAL_INT(res, GNRC_IPV6_EXT_RH_FORWARDED);
+    TEST_ASSERT(ipv6_addr_equal(&hdr.dst, &route[1]));
+    res = gnrc_rpl_srh_process(&hdr, srh, &err_ptr);
+    TEST_ASSERT_EQUAL_INT(res, GNRC_IPV6_EXT_RH_FORWARDED);
+    TEST_ASSERT_EQUAL_INT(0, srh->seg_left);
+    TEST_ASSERT(ipv6_addr_equal(&hdr.dst, &route[2]));
+}
+
 /* tools for external interaction */
 static inline void _ipreg_usage(char *cmd)
 {
@@ -242,6 +276,7 @@ static void run_unittests(void)
         new_TestFixture(test_rpl_srh_too_many_seg_left),
         new_TestFixture(test_rpl_srh_nexthop_no_prefix_elided),
         new_TestFixture(test_rpl_srh_nexthop_prefix_elided),
+        new_TestFixture(test_rpl_srh_build),
     };
 
     EMB_UNIT_TESTCALLER(rpl_srh_tests, set_up_tests, NULL, fixtures);
@@ -23,6 +23,9 @@
 #include "net/gnrc/netreg.h"
 #include "net/gnrc/sixlowpan/frag.h"
 #include "net/gnrc/sixlowpan/frag/rb.h"
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR)
+#include "net/sixlowpan/sfr.h"
+#endif
 #include "xtimer.h"
 
 #define TEST_NETIF_HDR_SRC      { 0xb3, 0x47, 0x60, 0x49, \
@@ -34,6 +37,9 @@
 #define TEST_PAGE               (0)
 #define TEST_RECEIVE_TIMEOUT    (100U)
 #define TEST_GC_TIMEOUT         (CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_TIMEOUT_US + TEST_RECEIVE_TIMEOUT)
+#define TEST_RFRAG_TAG          (0x0e)
+#define TEST_RFRAG_DG_SIZE      (200U)
+#define TEST_RFRAG_SIZE         (100U)
 
 /* test date taken from an experimental run (uncompressed ICMPv6 echo reply with
  * 300 byte payload)*/
@@ -235,10 +241,25 @@ static void _test_entry(const gnrc_sixlowpan_frag_rb_t *entry,
                         "entry->super.dst != TEST_NETIF_HDR_DST");
     TEST_ASSERT_EQUAL_INT(TEST_TAG, entry->super.tag);
     TEST_ASSERT_EQUAL_INT(exp_current_size, entry->super.current_size);
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_RB_BITMAP)
+    /* bf_isset() does not take const */
+    gnrc_sixlowpan_frag_rb_bitmap_t *bitmap =
+        (gnrc_sixlowpan_frag_rb_bitmap_t *)&entry->super.bitmap;
+
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_RB_BITMAP_UNITS; i++) {
+        bool exp_received = ((i >= (exp_int_start / 8U)) &&
+                             (i <= (exp_int_end / 8U)));
+
+        TEST_ASSERT(bf_isset(bitmap->received, i) == exp_received);
+        TEST_ASSERT(bf_isset(bitmap->starts, i) ==
+                    (i == (exp_int_start / 8U)));
+    }
+#else
     TEST_ASSERT_NOT_NULL(entry->super.ints);
     TEST_ASSERT_NULL(entry->super.ints->next);
     TEST_ASSERT_EQUAL_INT(exp_int_start, entry->super.ints->start);
     TEST_ASSERT_EQUAL_INT(exp_int_end, entry->super.ints->end);
+#endif
 }
 
 static void _check_pktbuf(const gnrc_sixlowpan_frag_rb_t *entry)
@@ -620,6 +641,93 @@ static void test_rbuf_gc__timed(void)
     _check_pktbuf(NULL);
 }
 
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR)
+static gnrc_pktsnip_t *_create_rfrag(uint8_t seq, uint16_t offset)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL,
+                                          sizeof(sixlowpan_sfr_rfrag_t) +
+                                          TEST_RFRAG_SIZE,
+                                          GNRC_NETTYPE_SIXLOWPAN);
+    sixlowpan_sfr_rfrag_t *hdr;
+
+    if (pkt == NULL) {
+        return NULL;
+    }
+    hdr = pkt->data;
+    memset(hdr, 0, sizeof(*hdr));
+    sixlowpan_sfr_rfrag_set_disp(&hdr->base);
+    hdr->base.tag = TEST_RFRAG_TAG;
+    sixlowpan_sfr_rfrag_set_seq(hdr, seq);
+    sixlowpan_sfr_rfrag_set_frag_size(hdr, TEST_RFRAG_SIZE);
+    sixlowpan_sfr_rfrag_set_offset(hdr, offset);
+    /* mark payload with its sequence number */
+    memset(hdr + 1, seq + 1, TEST_RFRAG_SIZE);
+    return pkt;
+}
+
+static void test_rbuf_add__rfrag(void)
+{
+    gnrc_pktsnip_t *pkt;
+    gnrc_sixlowpan_frag_rb_t *entry1, *entry2;
+    uint8_t *data;
+
+    /* a subsequent fragment can not start reassembly ... */
+    TEST_ASSERT_NOT_NULL((pkt = _create_rfrag(1, TEST_RFRAG_SIZE)));
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_rb_add(&_test_netif_hdr.hdr, pkt, 0,
+                                                TEST_PAGE));
+    /* ... but the first fragment, carrying the size of the datagram, can */
+    TEST_ASSERT_NOT_NULL((pkt = _create_rfrag(0, TEST_RFRAG_DG_SIZE)));
+    TEST_ASSERT_NOT_NULL((entry1 = gnrc_sixlowpan_frag_rb_add(
+            &_test_netif_hdr.hdr, pkt, 0, TEST_PAGE
+        )));
+    /* datagram is reassembled in compressed form */
+    TEST_ASSERT_EQUAL_INT(GNRC_NETTYPE_SIXLOWPAN, entry1->pkt->type);
+    TEST_ASSERT_EQUAL_INT(TEST_RFRAG_DG_SIZE, entry1->super.datagram_size);
+    TEST_ASSERT_EQUAL_INT(TEST_RFRAG_TAG, entry1->super.tag);
+    TEST_ASSERT_EQUAL_INT(TEST_RFRAG_SIZE, entry1->super.current_size);
+    TEST_ASSERT(bf_isset(entry1->received, 0));
+    TEST_ASSERT(!bf_isset(entry1->received, 1));
+    /* duplicates are not counted twice */
+    TEST_ASSERT_NOT_NULL((pkt = _create_rfrag(0, TEST_RFRAG_DG_SIZE)));
+    TEST_ASSERT_NOT_NULL((entry2 = gnrc_sixlowpan_frag_rb_add(
+            &_test_netif_hdr.hdr, pkt, 0, TEST_PAGE
+        )));
+    TEST_ASSERT(entry1 == entry2);
+    TEST_ASSERT_EQUAL_INT(TEST_RFRAG_SIZE, entry1->super.current_size);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_sixlowpan_frag_rb_dispatch_when_complete(
+            entry1, &_test_netif_hdr.hdr
+        ));
+    TEST_ASSERT_NOT_NULL((pkt = _create_rfrag(1, TEST_RFRAG_SIZE)));
+    TEST_ASSERT_NOT_NULL((entry2 = gnrc_sixlowpan_frag_rb_add(
+            &_test_netif_hdr.hdr, pkt, 0, TEST_PAGE
+        )));
+    TEST_ASSERT(entry1 == entry2);
+    TEST_ASSERT_EQUAL_INT(TEST_RFRAG_DG_SIZE, entry1->super.current_size);
+    TEST_ASSERT(bf_isset(entry1->received, 1));
+    data = entry1->pkt->data;
+    TEST_ASSERT_EQUAL_INT(1, data[0]);
+    TEST_ASSERT_EQUAL_INT(1, data[TEST_RFRAG_SIZE - 1]);
+    TEST_ASSERT_EQUAL_INT(2, data[TEST_RFRAG_SIZE]);
+    TEST_ASSERT_EQUAL_INT(2, data[TEST_RFRAG_DG_SIZE - 1]);
+    _check_pktbuf(entry1);
+}
+
+static void test_rbuf_add__rfrag_too_big(void)
+{
+    gnrc_pktsnip_t *pkt;
+
+    TEST_ASSERT_NOT_NULL((pkt = _create_rfrag(0, TEST_RFRAG_DG_SIZE)));
+    TEST_ASSERT_NOT_NULL(gnrc_sixlowpan_frag_rb_add(&_test_netif_hdr.hdr, pkt,
+                                                    0, TEST_PAGE));
+    /* fragment exceeds the datagram size => datagram is discarded */
+    TEST_ASSERT_NOT_NULL((pkt = _create_rfrag(2, 2 * TEST_RFRAG_SIZE)));
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_rb_add(&_test_netif_hdr.hdr, pkt, 0,
+                                                TEST_PAGE));
+    TEST_ASSERT_NULL(_first_non_empty_rbuf());
+    _check_pktbuf(NULL);
+}
+#endif
+
 static void run_unittests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -636,6 +744,10 @@ static void run_unittests(void)
         new_TestFixture(test_rbuf_rm),
         new_TestFixture(test_rbuf_gc__manually),
         new_TestFixture(test_rbuf_gc__timed),
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR)
+        new_TestFixture(test_rbuf_add__rfrag),
+        new_TestFixture(test_rbuf_add__rfrag_too_big),
+#endif
     };
 
     EMB_UNIT_TESTCALLER(sixlo_frag_tests, _set_up, NULL, fixtures);
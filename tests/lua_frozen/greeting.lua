@@ -0,0 +1,7 @@
+local M = {}
+
+function M.greet(who)
+    return "Hello " .. who .. " from flash"
+end
+
+return M
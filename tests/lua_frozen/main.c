@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       Test Lua modules precompiled to bytecode at build time
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * The scripts listed in LUA_FROZEN are built into the lua module table, the
+ * application only runs the "main" module, which requires "greeting".
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "lua_run.h"
+
+#include "test_utils/expect.h"
+
+#define LUA_MEM_SIZE (11000)
+static char lua_mem[LUA_MEM_SIZE] __attribute__ ((aligned(__BIGGEST_ALIGNMENT__)));
+
+int main(void)
+{
+    int status;
+
+    status = lua_riot_do_module("main", lua_mem, LUA_MEM_SIZE,
+                                LUAR_LOAD_BASE | LUAR_LOAD_PACKAGE |
+                                LUAR_LOAD_STRING, NULL);
+    expect(status == LUAR_EXIT);
+
+    puts("[SUCCESS]");
+
+    return 0;
+}
@@ -0,0 +1,4 @@
+local greeting = require("greeting")
+
+print(greeting.greet("RIOT"))
+print(string.format("2^10 = %d", 1 << 10))
@@ -81,6 +81,46 @@ void fill_memory(struct block_t *head)
     }
 }
 
+static void check_stats(size_t used, size_t used_max)
+{
+    memarray_stats_t stats;
+
+    memarray_stats(&block_storage, &stats);
+    if ((stats.used != used) || (stats.used_max != used_max)) {
+        printf("\tstats: FAILED, used %u (expected %u), max %u (expected %u)\n",
+               (unsigned)stats.used, (unsigned)used,
+               (unsigned)stats.used_max, (unsigned)used_max);
+    }
+    else {
+        printf("\tstats: used %u, max %u\n", (unsigned)used,
+               (unsigned)used_max);
+    }
+}
+
+static void check_poison(void)
+{
+    unsigned char *block = memarray_alloc(&block_storage);
+    unsigned poisoned = 0;
+
+    memset(block, 0, sizeof(struct block_t));
+    memarray_free(&block_storage, block);
+
+    /* everything but the free list pointer is poisoned */
+    for (size_t i = sizeof(void *); i < sizeof(struct block_t); i++) {
+        if (block[i] == MEMARRAY_POISON) {
+            poisoned++;
+        }
+    }
+    printf("poison: %s\n",
+           (poisoned == sizeof(struct block_t) - sizeof(void *)) ? "OK"
+                                                                 : "FAILED");
+
+    /* the block passes the poison check on allocation */
+    if (memarray_alloc(&block_storage) == block) {
+        memarray_free(&block_storage, block);
+    }
+}
+
 void free_memory(struct block_t *head)
 {
     struct block_t *old;
@@ -122,7 +162,9 @@ int main(void)
 
         printf("TEST #%i:\n", count + 1 );
         fill_memory(head);
+        check_stats(MAX_NUMBER_BLOCKS, MAX_NUMBER_BLOCKS);
         free_memory(head);
+        check_stats(0, MAX_NUMBER_BLOCKS);
 
         count++;
     }
@@ -141,6 +183,11 @@ int main(void)
         count++;
     }
 
+    memory_block_init();
+    check_stats(0, 0);
+    check_poison();
+    check_stats(0, 1);
+
     printf("Finishing\n");
     _ps_handler(0, NULL);
 
@@ -24,9 +24,18 @@ def testfunc(child):
             for i in range(max_number_blocks):
                 child.expect(r'\({}, @@@@@@@\) Allocated \d+ Bytes at 0x[a-z0-9]+,'
                              r' total [0-9]+\r\n'.format(i))
+            if loop == 0:
+                child.expect_exact("stats: used {0}, max {0}".format(
+                    max_number_blocks))
             for i in range(max_number_blocks):
                 child.expect(r'Free \({}\) \d+ Bytes at 0x[a-z0-9]+,'
                              ' total [0-9]+\r\n'.format(i))
+            if loop == 0:
+                child.expect_exact("stats: used 0, max {}".format(
+                    max_number_blocks))
+    child.expect_exact("stats: used 0, max 0")
+    child.expect_exact("poison: OK")
+    child.expect_exact("stats: used 0, max 1")
     child.expect_exact("Finishing")
 
 
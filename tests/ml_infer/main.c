@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for the inference manager
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "ml_infer.h"
+#include "mutex.h"
+#include "test_utils/expect.h"
+
+/* fake framework allocating persistent tensors at the head of the arena at
+ * load time and scratch buffers at the tail during the run */
+typedef struct {
+    uint8_t id;
+    size_t head;
+    size_t tail;
+    uint8_t *arena;
+    size_t size;
+} fake_model_t;
+
+static int _load(ml_infer_model_t *model, void *arena, size_t size)
+{
+    fake_model_t *fake = model->ctx;
+
+    if (fake->head + fake->tail > size) {
+        return -ENOMEM;
+    }
+    fake->arena = arena;
+    fake->size = size;
+    memset(fake->arena, fake->id, fake->head);
+    return 0;
+}
+
+static int _run(ml_infer_model_t *model, void *arg)
+{
+    fake_model_t *fake = model->ctx;
+
+    (void)arg;
+
+    /* another model in between must have caused a reload */
+    for (unsigned i = 0; i < fake->head; i++) {
+        if (fake->arena[i] != fake->id) {
+            return -EFAULT;
+        }
+    }
+    memset(fake->arena + fake->size - fake->tail, 0, fake->tail);
+    return fake->id;
+}
+
+static int _run_cancel(ml_infer_model_t *model, void *arg)
+{
+    (void)model;
+    (void)arg;
+
+    ml_infer_cancel();
+    return ml_infer_yield();
+}
+
+static const ml_infer_driver_t _driver = {
+    .load = _load,
+    .run = _run,
+};
+
+static const ml_infer_driver_t _driver_cancel = {
+    .load = _load,
+    .run = _run_cancel,
+};
+
+static fake_model_t _small_ctx = { .id = 1, .head = 256, .tail = 128 };
+static fake_model_t _large_ctx = { .id = 2, .head = 2048, .tail = 512 };
+static fake_model_t _huge_ctx = { .id = 3, .head = 4096, .tail = 4096 };
+
+static ml_infer_model_t _small = {
+    .name = "small", .driver = &_driver, .ctx = &_small_ctx
+};
+static ml_infer_model_t _large = {
+    .name = "large", .driver = &_driver, .ctx = &_large_ctx
+};
+static ml_infer_model_t _huge = {
+    .name = "huge", .driver = &_driver, .ctx = &_huge_ctx
+};
+static ml_infer_model_t _cancel = {
+    .name = "cancel", .driver = &_driver_cancel, .ctx = &_small_ctx
+};
+
+static mutex_t _done = MUTEX_INIT_LOCKED;
+
+static void _cb(ml_infer_job_t *job)
+{
+    printf("posted %s: %d\n", job->model->name, job->res);
+    mutex_unlock(&_done);
+}
+
+static void _print(const ml_infer_model_t *model)
+{
+    printf("%s: runs %" PRIu32 " errors %" PRIu32 " loads %" PRIu32
+           " arena %" PRIi32 "\n", model->name, model->stats.runs,
+           model->stats.errors, model->stats.loads, model->stats.arena_used);
+}
+
+int main(void)
+{
+    ml_infer_job_t job;
+
+    puts("ml_infer test");
+
+    expect(ml_infer_run(&_small, NULL) == 1);
+    expect(ml_infer_run(&_large, NULL) == 2);
+    expect(ml_infer_run(&_small, NULL) == 1);
+    expect(ml_infer_run(&_small, NULL) == 1);
+    expect(ml_infer_run(&_huge, NULL) == -ENOMEM);
+    expect(ml_infer_run(&_cancel, NULL) == -ECANCELED);
+
+    ml_infer_post(&job, &_large, NULL, _cb);
+    mutex_lock(&_done);
+
+    _print(&_small);
+    _print(&_large);
+    _print(&_huge);
+    _print(&_cancel);
+
+    puts("SUCCESS");
+    return 0;
+}
@@ -0,0 +1,24 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 ML!PA Consulting GmbH
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("ml_infer test")
+    child.expect_exact("posted large: 2")
+    child.expect_exact("small: runs 3 errors 0 loads 2 arena 384")
+    child.expect_exact("large: runs 2 errors 0 loads 2 arena 2560")
+    child.expect_exact("huge: runs 0 errors 1 loads 0 arena 0")
+    child.expect_exact("cancel: runs 0 errors 1 loads 1 arena 0")
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
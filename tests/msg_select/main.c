@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief   msg_select() test application
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "msg_select.h"
+#include "thread.h"
+
+#define MBOX_QUEUE_SIZE     (2U)
+#define FLAG_STOP           (0x1)
+
+static char _stack[THREAD_STACKSIZE_MAIN];
+static msg_t _thread_queue[2];
+static msg_t _mbox_queues[2][MBOX_QUEUE_SIZE];
+static mbox_t _mbox_a = MBOX_INIT(_mbox_queues[0], MBOX_QUEUE_SIZE);
+static mbox_t _mbox_b = MBOX_INIT(_mbox_queues[1], MBOX_QUEUE_SIZE);
+static mbox_t *const _mboxes[] = { &_mbox_a, &_mbox_b };
+
+static void *_thread(void *arg)
+{
+    (void)arg;
+
+    msg_init_queue(_thread_queue, ARRAY_SIZE(_thread_queue));
+
+    while (1) {
+        msg_t msg;
+        thread_flags_t flags;
+
+        puts("thread(): selecting");
+        int res = msg_select(_mboxes, ARRAY_SIZE(_mboxes), FLAG_STOP, &msg,
+                             &flags);
+
+        if (res == MSG_SELECT_FLAGS) {
+            printf("thread(): flags 0x%04x\n", (unsigned)flags);
+            break;
+        }
+        else if (res == MSG_SELECT_QUEUE) {
+            printf("thread(): queue, type 0x%04x\n", msg.type);
+        }
+        else {
+            printf("thread(): mbox %d, type 0x%04x\n", res, msg.type);
+        }
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    msg_t msg;
+
+    puts("START");
+    /* higher priority than main, so each event is handled immediately */
+    kernel_pid_t pid = thread_create(_stack, sizeof(_stack),
+                                     THREAD_PRIORITY_MAIN - 1,
+                                     THREAD_CREATE_STACKTEST, _thread, NULL,
+                                     "select");
+
+    puts("main(): put into mbox 1");
+    msg.type = 0x1111;
+    mbox_put(&_mbox_b, &msg);
+
+    puts("main(): send to thread");
+    msg.type = 0x2222;
+    msg_send(&msg, pid);
+    /* queueing a message wakes the thread, but does not yield */
+    thread_yield_higher();
+
+    puts("main(): put into mbox 0");
+    msg.type = 0x3333;
+    mbox_put(&_mbox_a, &msg);
+
+    puts("main(): set flag 0x0001");
+    thread_flags_set((thread_t *)thread_get(pid), FLAG_STOP);
+
+    puts("SUCCESS");
+    return 0;
+}
@@ -0,0 +1,31 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 ML!PA Consulting GmbH
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect("START")
+    child.expect_exact("thread(): selecting")
+    child.expect_exact("main(): put into mbox 1")
+    child.expect_exact("thread(): mbox 1, type 0x1111")
+    child.expect_exact("thread(): selecting")
+    child.expect_exact("main(): send to thread")
+    child.expect_exact("thread(): queue, type 0x2222")
+    child.expect_exact("thread(): selecting")
+    child.expect_exact("main(): put into mbox 0")
+    child.expect_exact("thread(): mbox 0, type 0x3333")
+    child.expect_exact("thread(): selecting")
+    child.expect_exact("main(): set flag 0x0001")
+    child.expect_exact("thread(): flags 0x0001")
+    child.expect("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,300 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       mtd_cache module test
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "mtd.h"
+#include "mtd_cache.h"
+
+/* Test mock object implementing a simple RAM-based mtd */
+#ifndef SECTOR_COUNT
+#define SECTOR_COUNT 8
+#endif
+#ifndef PAGE_PER_SECTOR
+#define PAGE_PER_SECTOR 4
+#endif
+#ifndef PAGE_SIZE
+#define PAGE_SIZE 64
+#endif
+
+#define MEMORY_SIZE         PAGE_SIZE * PAGE_PER_SECTOR * SECTOR_COUNT
+#define SECTOR_SIZE         PAGE_SIZE * PAGE_PER_SECTOR
+
+#define CACHE_PAGES         3
+
+static uint8_t _dummy_memory[MEMORY_SIZE];
+
+static uint8_t _buffer[PAGE_SIZE];
+
+static unsigned _reads;
+static unsigned _writes;
+
+static int _init(mtd_dev_t *dev)
+{
+    (void)dev;
+
+    return 0;
+}
+
+static int _read(mtd_dev_t *dev, void *buff, uint32_t addr, uint32_t size)
+{
+    (void)dev;
+
+    if (addr + size > sizeof(_dummy_memory)) {
+        return -EOVERFLOW;
+    }
+    memcpy(buff, _dummy_memory + addr, size);
+    _reads++;
+
+    return 0;
+}
+
+static int _write(mtd_dev_t *dev, const void *buff, uint32_t addr,
+                  uint32_t size)
+{
+    (void)dev;
+
+    if (addr + size > sizeof(_dummy_memory)) {
+        return -EOVERFLOW;
+    }
+    if (size > PAGE_SIZE) {
+        return -EOVERFLOW;
+    }
+    memcpy(_dummy_memory + addr, buff, size);
+    _writes++;
+
+    return 0;
+}
+
+static int _erase(mtd_dev_t *dev, uint32_t addr, uint32_t size)
+{
+    (void)dev;
+
+    if (size % SECTOR_SIZE != 0) {
+        return -EOVERFLOW;
+    }
+    if (addr % SECTOR_SIZE != 0) {
+        return -EOVERFLOW;
+    }
+    if (addr + size > sizeof(_dummy_memory)) {
+        return -EOVERFLOW;
+    }
+    memset(_dummy_memory + addr, 0xff, size);
+
+    return 0;
+}
+
+static int _power(mtd_dev_t *dev, enum mtd_power_state power)
+{
+    (void)dev;
+    (void)power;
+    return 0;
+}
+
+static const mtd_desc_t driver = {
+    .init = _init,
+    .read = _read,
+    .write = _write,
+    .erase = _erase,
+    .power = _power,
+};
+
+static mtd_dev_t dev = {
+    .driver = &driver,
+    .sector_count = SECTOR_COUNT,
+    .pages_per_sector = PAGE_PER_SECTOR,
+    .page_size = PAGE_SIZE,
+};
+
+static uint8_t _cache_buf[CACHE_PAGES * PAGE_SIZE];
+static mtd_cache_entry_t _cache_entries[CACHE_PAGES];
+
+static mtd_cache_t _cache = MTD_CACHE_INIT(&dev, _cache_buf, _cache_entries,
+                                           CACHE_PAGES);
+
+static mtd_dev_t *_dev = &_cache.mtd;
+
+static void _test_mem(uint8_t *buffer, size_t len, uint8_t expected)
+{
+    for (size_t i = 0; i < len; i++) {
+        TEST_ASSERT_EQUAL_INT(expected, buffer[i]);
+    }
+}
+
+static void test_mtd_init(void)
+{
+    int ret = mtd_init(_dev);
+
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    TEST_ASSERT_EQUAL_INT(SECTOR_COUNT, _dev->sector_count);
+    TEST_ASSERT_EQUAL_INT(PAGE_PER_SECTOR, _dev->pages_per_sector);
+    TEST_ASSERT_EQUAL_INT(PAGE_SIZE, _dev->page_size);
+}
+
+static void test_mtd_erase(void)
+{
+    int ret = mtd_erase(_dev, 0, MEMORY_SIZE);
+
+    TEST_ASSERT_EQUAL_INT(0, ret);
+
+    ret = mtd_erase(_dev, MEMORY_SIZE, SECTOR_SIZE);
+    TEST_ASSERT_EQUAL_INT(-EOVERFLOW, ret);
+}
+
+static void test_mtd_read_hit(void)
+{
+    mtd_cache_stats_t stats;
+
+    mtd_cache_stats_get(&_cache, &stats);
+    _reads = 0;
+
+    /* small reads from the same page only access the backing device once */
+    for (uint32_t i = 0; i < PAGE_SIZE; i += 8) {
+        TEST_ASSERT_EQUAL_INT(0, mtd_read(_dev, _buffer, i, 8));
+        _test_mem(_buffer, 8, 0xff);
+    }
+    TEST_ASSERT_EQUAL_INT(1, _reads);
+
+    mtd_cache_stats_get(&_cache, &stats);
+    TEST_ASSERT_EQUAL_INT(1, stats.misses);
+    TEST_ASSERT_EQUAL_INT(PAGE_SIZE / 8 - 1, stats.hits);
+}
+
+static void test_mtd_readahead(void)
+{
+    mtd_cache_stats_t stats;
+
+    if (!IS_ACTIVE(CONFIG_MTD_CACHE_READAHEAD)) {
+        return;
+    }
+
+    mtd_cache_stats_get(&_cache, &stats);
+
+    /* page 1 follows page 0, so page 2 is loaded ahead */
+    TEST_ASSERT_EQUAL_INT(0, mtd_read(_dev, _buffer, PAGE_SIZE, 8));
+    TEST_ASSERT_EQUAL_INT(0, mtd_read(_dev, _buffer, 2 * PAGE_SIZE, 8));
+
+    mtd_cache_stats_get(&_cache, &stats);
+    TEST_ASSERT_EQUAL_INT(1, stats.misses);
+    TEST_ASSERT_EQUAL_INT(1, stats.hits);
+    TEST_ASSERT_EQUAL_INT(1, stats.readaheads);
+}
+
+static void test_mtd_write_back(void)
+{
+    mtd_cache_stats_t stats;
+
+    mtd_cache_flush(&_cache);
+    mtd_cache_stats_get(&_cache, &stats);
+    _writes = 0;
+
+    /* partial writes to one page are coalesced */
+    memset(_buffer, 0xAA, PAGE_SIZE);
+    for (uint32_t i = 0; i < PAGE_SIZE; i += 16) {
+        TEST_ASSERT_EQUAL_INT(0, mtd_write(_dev, _buffer, 4 * PAGE_SIZE + i, 16));
+    }
+    TEST_ASSERT_EQUAL_INT(0, _writes);
+    _test_mem(&_dummy_memory[4 * PAGE_SIZE], PAGE_SIZE, 0xff);
+
+    /* cached content is returned before it is written back */
+    memset(_buffer, 0, PAGE_SIZE);
+    TEST_ASSERT_EQUAL_INT(0, mtd_read(_dev, _buffer, 4 * PAGE_SIZE, PAGE_SIZE));
+    _test_mem(_buffer, PAGE_SIZE, 0xAA);
+
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_flush(&_cache));
+    TEST_ASSERT_EQUAL_INT(1, _writes);
+    _test_mem(&_dummy_memory[4 * PAGE_SIZE], PAGE_SIZE, 0xAA);
+
+    mtd_cache_stats_get(&_cache, &stats);
+    TEST_ASSERT_EQUAL_INT(1, stats.writebacks);
+}
+
+static void test_mtd_evict(void)
+{
+    _writes = 0;
+
+    /* dirty pages are written back when they get evicted */
+    memset(_buffer, 0xBB, PAGE_SIZE);
+    for (uint32_t page = 8; page < 8 + 2 * CACHE_PAGES; page++) {
+        TEST_ASSERT_EQUAL_INT(0, mtd_write(_dev, _buffer, page * PAGE_SIZE, 4));
+    }
+    TEST_ASSERT_EQUAL_INT(CACHE_PAGES, _writes);
+    _test_mem(&_dummy_memory[8 * PAGE_SIZE], 4, 0xBB);
+
+    /* erase drops pending writes to the erased range */
+    TEST_ASSERT_EQUAL_INT(0, mtd_erase(_dev, 2 * SECTOR_SIZE, 2 * SECTOR_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_flush(&_cache));
+    TEST_ASSERT_EQUAL_INT(CACHE_PAGES, _writes);
+
+    TEST_ASSERT_EQUAL_INT(0, mtd_read(_dev, _buffer, 8 * PAGE_SIZE, PAGE_SIZE));
+    _test_mem(_buffer, PAGE_SIZE, 0xff);
+}
+
+static void test_mtd_read_batch(void)
+{
+    static uint8_t buf[4 * PAGE_SIZE];
+
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_flush(&_cache));
+    _reads = 0;
+
+    /* consecutive whole pages that are not cached are read at once */
+    TEST_ASSERT_EQUAL_INT(0, mtd_read(_dev, buf, 16 * PAGE_SIZE, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(1, _reads);
+    _test_mem(buf, sizeof(buf), 0xff);
+
+    /* a cached page splits the batch */
+    memset(_buffer, 0xCC, PAGE_SIZE);
+    TEST_ASSERT_EQUAL_INT(0, mtd_write(_dev, _buffer, 21 * PAGE_SIZE, 4));
+    _reads = 0;
+    TEST_ASSERT_EQUAL_INT(0, mtd_read(_dev, buf, 20 * PAGE_SIZE, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(2, _reads);
+    _test_mem(buf, PAGE_SIZE, 0xff);
+    _test_mem(&buf[PAGE_SIZE], 4, 0xCC);
+    _test_mem(&buf[PAGE_SIZE + 4], 3 * PAGE_SIZE - 4, 0xff);
+}
+
+Test *tests_mtd_cache_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_mtd_init),
+        new_TestFixture(test_mtd_erase),
+        new_TestFixture(test_mtd_read_hit),
+        new_TestFixture(test_mtd_readahead),
+        new_TestFixture(test_mtd_write_back),
+        new_TestFixture(test_mtd_evict),
+        new_TestFixture(test_mtd_read_batch),
+    };
+
+    EMB_UNIT_TESTCALLER(mtd_cache_tests, NULL, NULL, fixtures);
+
+    return (Test *)&mtd_cache_tests;
+}
+
+int main(void)
+{
+    TESTS_START();
+    TESTS_RUN(tests_mtd_cache_tests());
+    TESTS_END();
+    return 0;
+}
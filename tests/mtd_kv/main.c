@@ -0,0 +1,291 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       mtd_kv module test
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "mtd.h"
+#include "mtd_kv.h"
+
+/* Test mock object implementing a simple RAM-based mtd */
+#ifndef SECTOR_COUNT
+#define SECTOR_COUNT 3
+#endif
+#ifndef PAGE_PER_SECTOR
+#define PAGE_PER_SECTOR 4
+#endif
+#ifndef PAGE_SIZE
+#define PAGE_SIZE 64
+#endif
+
+#define MEMORY_SIZE         PAGE_SIZE * PAGE_PER_SECTOR * SECTOR_COUNT
+#define SECTOR_SIZE         PAGE_SIZE * PAGE_PER_SECTOR
+
+#define INDEX_SIZE          8
+
+static uint8_t _dummy_memory[MEMORY_SIZE];
+
+static uint8_t _buffer[SECTOR_SIZE];
+
+static unsigned _erases;
+
+static int _init(mtd_dev_t *dev)
+{
+    (void)dev;
+
+    return 0;
+}
+
+static int _read(mtd_dev_t *dev, void *buff, uint32_t addr, uint32_t size)
+{
+    (void)dev;
+
+    if (addr + size > sizeof(_dummy_memory)) {
+        return -EOVERFLOW;
+    }
+    memcpy(buff, _dummy_memory + addr, size);
+
+    return 0;
+}
+
+static int _write(mtd_dev_t *dev, const void *buff, uint32_t addr,
+                  uint32_t size)
+{
+    (void)dev;
+
+    if (addr + size > sizeof(_dummy_memory)) {
+        return -EOVERFLOW;
+    }
+    if (size > PAGE_SIZE) {
+        return -EOVERFLOW;
+    }
+    /* NOR flash can only clear bits */
+    for (uint32_t i = 0; i < size; i++) {
+        _dummy_memory[addr + i] &= ((const uint8_t *)buff)[i];
+    }
+
+    return 0;
+}
+
+static int _erase(mtd_dev_t *dev, uint32_t addr, uint32_t size)
+{
+    (void)dev;
+
+    if (size % SECTOR_SIZE != 0) {
+        return -EOVERFLOW;
+    }
+    if (addr % SECTOR_SIZE != 0) {
+        return -EOVERFLOW;
+    }
+    if (addr + size > sizeof(_dummy_memory)) {
+        return -EOVERFLOW;
+    }
+    memset(_dummy_memory + addr, 0xff, size);
+    _erases += size / SECTOR_SIZE;
+
+    return 0;
+}
+
+static int _power(mtd_dev_t *dev, enum mtd_power_state power)
+{
+    (void)dev;
+    (void)power;
+    return 0;
+}
+
+static const mtd_desc_t driver = {
+    .init = _init,
+    .read = _read,
+    .write = _write,
+    .erase = _erase,
+    .power = _power,
+};
+
+static mtd_dev_t dev = {
+    .driver = &driver,
+    .sector_count = SECTOR_COUNT,
+    .pages_per_sector = PAGE_PER_SECTOR,
+    .page_size = PAGE_SIZE,
+};
+
+static mtd_kv_slot_t _index[INDEX_SIZE];
+static mtd_kv_t _kv;
+
+static void _init_kv(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, mtd_kv_init(&_kv, &dev, _index, INDEX_SIZE));
+}
+
+static void _check_u32(const char *key, uint32_t expected)
+{
+    uint32_t val = 0;
+
+    TEST_ASSERT_EQUAL_INT(sizeof(val), mtd_kv_get(&_kv, key, &val, sizeof(val)));
+    TEST_ASSERT_EQUAL_INT(expected, val);
+}
+
+static void test_mtd_kv_init(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, mtd_init(&dev));
+    memset(_dummy_memory, 0x00, sizeof(_dummy_memory));
+
+    TEST_ASSERT_EQUAL_INT(-EINVAL, mtd_kv_init(&_kv, &dev, _index, 6));
+    _init_kv();
+
+    TEST_ASSERT_EQUAL_INT(0, _kv.keys);
+    TEST_ASSERT_EQUAL_INT(-ENOENT, mtd_kv_get(&_kv, "foo", _buffer,
+                                              sizeof(_buffer)));
+}
+
+static void test_mtd_kv_set_get(void)
+{
+    uint32_t val = 1;
+
+    TEST_ASSERT_EQUAL_INT(-EINVAL, mtd_kv_set(&_kv, "", &val, sizeof(val)));
+    TEST_ASSERT_EQUAL_INT(0, mtd_kv_set(&_kv, "foo", &val, sizeof(val)));
+    TEST_ASSERT_EQUAL_INT(0, mtd_kv_set(&_kv, "bar", "hello", 5));
+    _check_u32("foo", 1);
+
+    val = 2;
+    TEST_ASSERT_EQUAL_INT(0, mtd_kv_set(&_kv, "foo", &val, sizeof(val)));
+    _check_u32("foo", 2);
+
+    TEST_ASSERT_EQUAL_INT(5, mtd_kv_get(&_kv, "bar", _buffer, 3));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_buffer, "hel", 3));
+    TEST_ASSERT_EQUAL_INT(2, _kv.keys);
+
+    /* the latest values are recovered from flash */
+    _init_kv();
+    _check_u32("foo", 2);
+    TEST_ASSERT_EQUAL_INT(5, mtd_kv_get(&_kv, "bar", _buffer, sizeof(_buffer)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_buffer, "hello", 5));
+}
+
+static void test_mtd_kv_delete(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, mtd_kv_delete(&_kv, "bar"));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, mtd_kv_get(&_kv, "bar", _buffer,
+                                              sizeof(_buffer)));
+    TEST_ASSERT_EQUAL_INT(0, mtd_kv_delete(&_kv, "none"));
+
+    _init_kv();
+    TEST_ASSERT_EQUAL_INT(-ENOENT, mtd_kv_get(&_kv, "bar", _buffer,
+                                              sizeof(_buffer)));
+    _check_u32("foo", 2);
+}
+
+static void test_mtd_kv_multi(void)
+{
+    uint32_t a = 10, b = 20;
+    const mtd_kv_pair_t pairs[] = {
+        { .key = "a", .val = &a, .len = sizeof(a) },
+        { .key = "b", .val = &b, .len = sizeof(b) },
+    };
+
+    TEST_ASSERT_EQUAL_INT(0, mtd_kv_set_multi(&_kv, pairs, 2));
+    _check_u32("a", 10);
+    _check_u32("b", 20);
+
+    /* tear the last entry of a second commit */
+    a = 11;
+    b = 21;
+    uint32_t end = _kv.head_sector * SECTOR_SIZE + _kv.head_off;
+    TEST_ASSERT_EQUAL_INT(0, mtd_kv_set_multi(&_kv, pairs, 2));
+    /* the entry of "b" takes 16 bytes, flip its first value byte */
+    uint32_t torn = _kv.head_sector * SECTOR_SIZE + _kv.head_off - 16 + 9;
+    TEST_ASSERT(torn > end);
+    _dummy_memory[torn] ^= 0xff;
+
+    /* neither update survives */
+    _init_kv();
+    _check_u32("a", 10);
+    _check_u32("b", 20);
+}
+
+static void test_mtd_kv_wear(void)
+{
+    char key[] = "k0";
+
+    /* fill the index */
+    for (unsigned i = 0; _kv.keys < INDEX_SIZE; i++) {
+        key[1] = '0' + i;
+        TEST_ASSERT_EQUAL_INT(0, mtd_kv_set(&_kv, key, &i, sizeof(i)));
+    }
+    TEST_ASSERT_EQUAL_INT(-ENOMEM, mtd_kv_set(&_kv, "new", "x", 1));
+
+    /* a frequently updated counter rotates through all sectors */
+    _erases = 0;
+    uint32_t counter;
+    for (counter = 0; counter < 200; counter++) {
+        TEST_ASSERT_EQUAL_INT(0, mtd_kv_set(&_kv, "foo", &counter,
+                                            sizeof(counter)));
+    }
+    TEST_ASSERT(_erases >= 2 * SECTOR_COUNT);
+    _check_u32("foo", counter - 1);
+    _check_u32("a", 10);
+
+    /* compaction has dropped the tombstone of "bar" */
+    TEST_ASSERT_EQUAL_INT(INDEX_SIZE - 1, _kv.keys);
+
+    _init_kv();
+    _check_u32("foo", counter - 1);
+    _check_u32("b", 20);
+    TEST_ASSERT_EQUAL_INT(INDEX_SIZE - 1, _kv.keys);
+}
+
+static void test_mtd_kv_full(void)
+{
+    /* a value larger than the free space of the store */
+    TEST_ASSERT_EQUAL_INT(-EINVAL, mtd_kv_set(&_kv, "foo", _dummy_memory,
+                                              SECTOR_SIZE));
+
+    memset(_buffer, 0x5a, sizeof(_buffer));
+    TEST_ASSERT_EQUAL_INT(0, mtd_kv_set(&_kv, "foo", _buffer, 200));
+    TEST_ASSERT_EQUAL_INT(-ENOSPC, mtd_kv_set(&_kv, "k0", _buffer, 200));
+    TEST_ASSERT_EQUAL_INT(200, mtd_kv_get(&_kv, "foo", _buffer,
+                                          sizeof(_buffer)));
+}
+
+Test *tests_mtd_kv_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_mtd_kv_init),
+        new_TestFixture(test_mtd_kv_set_get),
+        new_TestFixture(test_mtd_kv_delete),
+        new_TestFixture(test_mtd_kv_multi),
+        new_TestFixture(test_mtd_kv_wear),
+        new_TestFixture(test_mtd_kv_full),
+    };
+
+    EMB_UNIT_TESTCALLER(mtd_kv_tests, NULL, NULL, fixtures);
+
+    return (Test *)&mtd_kv_tests;
+}
+
+int main(void)
+{
+    TESTS_START();
+    TESTS_RUN(tests_mtd_kv_tests());
+    TESTS_END();
+    return 0;
+}
@@ -0,0 +1,270 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       mtd_log module test
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "mtd.h"
+#include "mtd_log.h"
+
+/* Test mock object implementing a simple RAM-based mtd */
+#ifndef SECTOR_COUNT
+#define SECTOR_COUNT 4
+#endif
+#ifndef PAGE_PER_SECTOR
+#define PAGE_PER_SECTOR 4
+#endif
+#ifndef PAGE_SIZE
+#define PAGE_SIZE 64
+#endif
+
+#define MEMORY_SIZE         PAGE_SIZE * PAGE_PER_SECTOR * SECTOR_COUNT
+#define SECTOR_SIZE         PAGE_SIZE * PAGE_PER_SECTOR
+
+#define SLOT_SIZE           32
+#define SLOTS               (SECTOR_SIZE / SLOT_SIZE)
+#define PAYLOAD_MAX         (SLOT_SIZE - MTD_LOG_RECORD_HDR_SIZE)
+
+static uint8_t _dummy_memory[MEMORY_SIZE];
+
+static uint8_t _slot_buf[SLOT_SIZE];
+static uint8_t _buffer[PAYLOAD_MAX];
+
+static unsigned _erases;
+
+static int _init(mtd_dev_t *dev)
+{
+    (void)dev;
+
+    return 0;
+}
+
+static int _read(mtd_dev_t *dev, void *buff, uint32_t addr, uint32_t size)
+{
+    (void)dev;
+
+    if (addr + size > sizeof(_dummy_memory)) {
+        return -EOVERFLOW;
+    }
+    memcpy(buff, _dummy_memory + addr, size);
+
+    return 0;
+}
+
+static int _write(mtd_dev_t *dev, const void *buff, uint32_t addr,
+                  uint32_t size)
+{
+    (void)dev;
+
+    if (addr + size > sizeof(_dummy_memory)) {
+        return -EOVERFLOW;
+    }
+    if (size > PAGE_SIZE) {
+        return -EOVERFLOW;
+    }
+    /* NOR flash can only clear bits */
+    for (uint32_t i = 0; i < size; i++) {
+        _dummy_memory[addr + i] &= ((const uint8_t *)buff)[i];
+    }
+
+    return 0;
+}
+
+static int _erase(mtd_dev_t *dev, uint32_t addr, uint32_t size)
+{
+    (void)dev;
+
+    if (size % SECTOR_SIZE != 0) {
+        return -EOVERFLOW;
+    }
+    if (addr % SECTOR_SIZE != 0) {
+        return -EOVERFLOW;
+    }
+    if (addr + size > sizeof(_dummy_memory)) {
+        return -EOVERFLOW;
+    }
+    memset(_dummy_memory + addr, 0xff, size);
+    _erases += size / SECTOR_SIZE;
+
+    return 0;
+}
+
+static int _power(mtd_dev_t *dev, enum mtd_power_state power)
+{
+    (void)dev;
+    (void)power;
+    return 0;
+}
+
+static const mtd_desc_t driver = {
+    .init = _init,
+    .read = _read,
+    .write = _write,
+    .erase = _erase,
+    .power = _power,
+};
+
+static mtd_dev_t dev = {
+    .driver = &driver,
+    .sector_count = SECTOR_COUNT,
+    .pages_per_sector = PAGE_PER_SECTOR,
+    .page_size = PAGE_SIZE,
+};
+
+static mtd_log_t _log;
+
+static void _append(uint32_t n)
+{
+    memset(_buffer, n, sizeof(_buffer));
+    TEST_ASSERT_EQUAL_INT(0, mtd_log_append(&_log, _buffer, 1 + n % PAYLOAD_MAX));
+}
+
+/* check that the log holds the records first ... first + count - 1 */
+static void _check(uint32_t first, uint32_t count)
+{
+    mtd_log_iter_t it;
+    uint32_t seq;
+    int res;
+
+    mtd_log_iter_init(&_log, &it);
+    for (uint32_t n = first; n < first + count; n++) {
+        memset(_buffer, 0, sizeof(_buffer));
+        res = mtd_log_iter_next(&_log, &it, _buffer, sizeof(_buffer), &seq);
+        TEST_ASSERT_EQUAL_INT(1 + n % PAYLOAD_MAX, res);
+        TEST_ASSERT_EQUAL_INT(n, seq);
+        TEST_ASSERT_EQUAL_INT((uint8_t)n, _buffer[res - 1]);
+    }
+    TEST_ASSERT_EQUAL_INT(0, mtd_log_iter_next(&_log, &it, _buffer,
+                                               sizeof(_buffer), NULL));
+}
+
+static void test_mtd_log_init(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, mtd_init(&dev));
+    memset(_dummy_memory, 0xff, sizeof(_dummy_memory));
+
+    TEST_ASSERT_EQUAL_INT(-EINVAL, mtd_log_init(&_log, &dev, _slot_buf, 48));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, mtd_log_init(&_log, &dev, _slot_buf, 8));
+    TEST_ASSERT_EQUAL_INT(0, mtd_log_init(&_log, &dev, _slot_buf, SLOT_SIZE));
+
+    TEST_ASSERT_EQUAL_INT(0, _log.seq);
+    _check(0, 0);
+}
+
+static void test_mtd_log_append(void)
+{
+    TEST_ASSERT_EQUAL_INT(-EINVAL, mtd_log_append(&_log, _buffer, 0));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, mtd_log_append(&_log, _buffer,
+                                                  PAYLOAD_MAX + 1));
+
+    for (uint32_t n = 0; n < 10; n++) {
+        _append(n);
+    }
+    _check(0, 10);
+
+    /* the position is recovered from flash */
+    TEST_ASSERT_EQUAL_INT(0, mtd_log_init(&_log, &dev, _slot_buf, SLOT_SIZE));
+    TEST_ASSERT_EQUAL_INT(10, _log.seq);
+    _append(10);
+    _check(0, 11);
+}
+
+static void test_mtd_log_wrap(void)
+{
+    /* fill the log several times, sectors are reused round robin */
+    _erases = 0;
+    uint32_t n;
+    for (n = 11; n < 11 + 3 * SECTOR_COUNT * (SLOTS - 1); n++) {
+        _append(n);
+    }
+    TEST_ASSERT(_erases >= 2 * SECTOR_COUNT);
+
+    /* the oldest sector has been dropped, the rest is intact */
+    uint32_t head_records = _log.head_slot - 1;
+    uint32_t first = n - head_records - (SECTOR_COUNT - 1) * (SLOTS - 1);
+    _check(first, n - first);
+
+    TEST_ASSERT_EQUAL_INT(0, mtd_log_init(&_log, &dev, _slot_buf, SLOT_SIZE));
+    TEST_ASSERT_EQUAL_INT(n, _log.seq);
+    _check(first, n - first);
+}
+
+static void test_mtd_log_corrupt(void)
+{
+    uint32_t seq = _log.seq;
+
+    _append(seq);
+    _append(seq + 1);
+
+    /* tear the first of the two records */
+    uint32_t addr = _log.head_sector * SECTOR_SIZE
+                  + (_log.head_slot - 2) * SLOT_SIZE;
+    _dummy_memory[addr + MTD_LOG_RECORD_HDR_SIZE] ^= 0x01;
+
+    mtd_log_iter_t it;
+    uint32_t last = 0;
+    int res;
+    mtd_log_iter_init(&_log, &it);
+    while ((res = mtd_log_iter_next(&_log, &it, _buffer, sizeof(_buffer),
+                                    &last)) > 0) {
+        TEST_ASSERT(last != seq);
+    }
+    TEST_ASSERT_EQUAL_INT(0, res);
+    TEST_ASSERT_EQUAL_INT(seq + 1, last);
+}
+
+static void test_mtd_log_clear(void)
+{
+    uint32_t seq = _log.seq;
+
+    TEST_ASSERT_EQUAL_INT(0, mtd_log_clear(&_log));
+    _check(0, 0);
+
+    TEST_ASSERT_EQUAL_INT(0, mtd_log_init(&_log, &dev, _slot_buf, SLOT_SIZE));
+    TEST_ASSERT_EQUAL_INT(seq, _log.seq);
+    _append(seq);
+    _check(seq, 1);
+}
+
+Test *tests_mtd_log_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_mtd_log_init),
+        new_TestFixture(test_mtd_log_append),
+        new_TestFixture(test_mtd_log_wrap),
+        new_TestFixture(test_mtd_log_corrupt),
+        new_TestFixture(test_mtd_log_clear),
+    };
+
+    EMB_UNIT_TESTCALLER(mtd_log_tests, NULL, NULL, fixtures);
+
+    return (Test *)&mtd_log_tests;
+}
+
+int main(void)
+{
+    TESTS_START();
+    TESTS_RUN(tests_mtd_log_tests());
+    TESTS_END();
+    return 0;
+}
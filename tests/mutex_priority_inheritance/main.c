@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2020 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for mutex priority inheritance
+ *
+ * A low priority thread holds a mutex the main thread blocks on, while a
+ * thread of medium priority is ready to run. With priority inheritance, the
+ * low priority thread runs with the priority of the main thread until it
+ * unlocks the mutex, so the medium priority thread can not delay the main
+ * thread.
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "mutex.h"
+#include "sched.h"
+#include "thread.h"
+
+#define PRIO_MID    (THREAD_PRIORITY_MAIN + 1)
+#define PRIO_LOW    (THREAD_PRIORITY_MAIN + 2)
+
+static char _stack_low[THREAD_STACKSIZE_DEFAULT];
+static char _stack_mid[THREAD_STACKSIZE_DEFAULT];
+
+static mutex_t _mutex = MUTEX_INIT;
+static kernel_pid_t _main_pid;
+static volatile bool _mid_done;
+static bool _mid_ran_while_boosted;
+static uint8_t _prio_boosted;
+static uint8_t _prio_after_unlock;
+
+static uint8_t _own_priority(void)
+{
+    return sched_active_thread->priority;
+}
+
+static void *_low(void *arg)
+{
+    (void)arg;
+
+    mutex_lock(&_mutex);
+    puts("low: locked mutex");
+    /* main preempts us and blocks on the mutex */
+    thread_wakeup(_main_pid);
+
+    _prio_boosted = _own_priority();
+    _mid_ran_while_boosted = _mid_done;
+    printf("low: priority while main waits: %u\n", (unsigned)_prio_boosted);
+    mutex_unlock(&_mutex);
+
+    _prio_after_unlock = _own_priority();
+    printf("low: priority after unlock: %u\n", (unsigned)_prio_after_unlock);
+    thread_wakeup(_main_pid);
+    return NULL;
+}
+
+static void *_mid(void *arg)
+{
+    (void)arg;
+
+    _mid_done = true;
+    puts("mid: done");
+    return NULL;
+}
+
+int main(void)
+{
+    bool mid_ran_before_main;
+
+    puts("mutex priority inheritance test");
+    _main_pid = thread_getpid();
+
+    thread_create(_stack_low, sizeof(_stack_low), PRIO_LOW,
+                  THREAD_CREATE_STACKTEST, _low, NULL, "low");
+    thread_sleep();
+
+    thread_create(_stack_mid, sizeof(_stack_mid), PRIO_MID,
+                  THREAD_CREATE_STACKTEST, _mid, NULL, "mid");
+    mutex_lock(&_mutex);
+    mid_ran_before_main = _mid_done;
+    printf("main: got mutex, priority %u\n", (unsigned)_own_priority());
+    mutex_unlock(&_mutex);
+
+    /* wait for both threads to finish */
+    thread_sleep();
+
+    if (!_mid_ran_while_boosted && !mid_ran_before_main &&
+        (_prio_boosted == THREAD_PRIORITY_MAIN) &&
+        (_prio_after_unlock == PRIO_LOW)) {
+        puts("SUCCESS");
+    }
+    else {
+        puts("FAILURE");
+    }
+
+    return 0;
+}
@@ -0,0 +1,26 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 ML!PA Consulting GmbH
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("low: locked mutex")
+    child.expect(r"low: priority while main waits: (\d+)")
+    boosted = int(child.match.group(1))
+    child.expect(r"main: got mutex, priority (\d+)")
+    assert int(child.match.group(1)) == boosted
+    child.expect_exact("mid: done")
+    child.expect(r"low: priority after unlock: (\d+)")
+    assert int(child.match.group(1)) > boosted
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,249 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for the crypto accelerator peripheral
+ *
+ * @author      ML!PA Consulting GmbH
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "crypto/aes.h"
+#include "crypto/ciphers.h"
+#include "crypto/modes/ecb.h"
+#include "periph/crypto.h"
+
+#define BLOCKS  (3)
+
+/* FIPS-197, appendix C.1 */
+static const uint8_t key[] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+};
+static const uint8_t plain[] = {
+    0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+    0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff,
+};
+static const uint8_t cipher[] = {
+    0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30,
+    0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a,
+};
+
+/* one spare byte to test unaligned buffers */
+static uint32_t _in[BLOCKS * AES_BLOCK_SIZE / sizeof(uint32_t) + 1];
+static uint32_t _out[BLOCKS * AES_BLOCK_SIZE / sizeof(uint32_t) + 1];
+
+static bool _check_blocks(const uint8_t *buf, const uint8_t *expected)
+{
+    for (unsigned i = 0; i < BLOCKS; i++) {
+        if (memcmp(buf + i * AES_BLOCK_SIZE, expected, AES_BLOCK_SIZE)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool _test_ecb(unsigned offset)
+{
+    uint8_t *in = (uint8_t *)_in + offset;
+    uint8_t *out = (uint8_t *)_out + offset;
+
+    for (unsigned i = 0; i < BLOCKS; i++) {
+        memcpy(in + i * AES_BLOCK_SIZE, plain, AES_BLOCK_SIZE);
+    }
+
+    if (crypto_aes_ecb(key, sizeof(key), in, out, BLOCKS, true) ||
+        !_check_blocks(out, cipher)) {
+        printf("encryption with offset %u failed\n", offset);
+        return false;
+    }
+
+    /* in place */
+    if (crypto_aes_ecb(key, sizeof(key), out, out, BLOCKS, false) ||
+        !_check_blocks(out, plain)) {
+        printf("decryption with offset %u failed\n", offset);
+        return false;
+    }
+
+    return true;
+}
+
+static bool _test_cipher(void)
+{
+    cipher_t c;
+    uint8_t buf[BLOCKS * AES_BLOCK_SIZE];
+
+    if (cipher_init(&c, CIPHER_AES_128, key, sizeof(key)) < 0) {
+        puts("cipher_init failed");
+        return false;
+    }
+
+    for (unsigned i = 0; i < BLOCKS; i++) {
+        memcpy(buf + i * AES_BLOCK_SIZE, plain, AES_BLOCK_SIZE);
+    }
+    if ((cipher_encrypt_ecb(&c, buf, sizeof(buf), buf) != sizeof(buf)) ||
+        !_check_blocks(buf, cipher)) {
+        puts("cipher_encrypt_ecb failed");
+        return false;
+    }
+
+    /* the software implementation must agree with the hardware */
+    if ((aes_decrypt(&c.context, buf, buf) != 1) ||
+        memcmp(buf, plain, AES_BLOCK_SIZE)) {
+        puts("software decryption failed");
+        return false;
+    }
+
+    return true;
+}
+
+#ifdef MODULE_PERIPH_CRYPTO_ECC
+/* P-256 base point */
+static const uint8_t p256_g[2 * CRYPTO_ECC_P256_SIZE] = {
+    0x6b, 0x17, 0xd1, 0xf2, 0xe1, 0x2c, 0x42, 0x47,
+    0xf8, 0xbc, 0xe6, 0xe5, 0x63, 0xa4, 0x40, 0xf2,
+    0x77, 0x03, 0x7d, 0x81, 0x2d, 0xeb, 0x33, 0xa0,
+    0xf4, 0xa1, 0x39, 0x45, 0xd8, 0x98, 0xc2, 0x96,
+    0x4f, 0xe3, 0x42, 0xe2, 0xfe, 0x1a, 0x7f, 0x9b,
+    0x8e, 0xe7, 0xeb, 0x4a, 0x7c, 0x0f, 0x9e, 0x16,
+    0x2b, 0xce, 0x33, 0x57, 0x6b, 0x31, 0x5e, 0xce,
+    0xcb, 0xb6, 0x40, 0x68, 0x37, 0xbf, 0x51, 0xf5,
+};
+
+/* 2G and 3G */
+static const uint8_t p256_2g[2 * CRYPTO_ECC_P256_SIZE] = {
+    0x7c, 0xf2, 0x7b, 0x18, 0x8d, 0x03, 0x4f, 0x7e,
+    0x8a, 0x52, 0x38, 0x03, 0x04, 0xb5, 0x1a, 0xc3,
+    0xc0, 0x89, 0x69, 0xe2, 0x77, 0xf2, 0x1b, 0x35,
+    0xa6, 0x0b, 0x48, 0xfc, 0x47, 0x66, 0x99, 0x78,
+    0x07, 0x77, 0x55, 0x10, 0xdb, 0x8e, 0xd0, 0x40,
+    0x29, 0x3d, 0x9a, 0xc6, 0x9f, 0x74, 0x30, 0xdb,
+    0xba, 0x7d, 0xad, 0xe6, 0x3c, 0xe9, 0x82, 0x29,
+    0x9e, 0x04, 0xb7, 0x9d, 0x22, 0x78, 0x73, 0xd1,
+};
+
+static const uint8_t p256_3g[2 * CRYPTO_ECC_P256_SIZE] = {
+    0x5e, 0xcb, 0xe4, 0xd1, 0xa6, 0x33, 0x0a, 0x44,
+    0xc8, 0xf7, 0xef, 0x95, 0x1d, 0x4b, 0xf1, 0x65,
+    0xe6, 0xc6, 0xb7, 0x21, 0xef, 0xad, 0xa9, 0x85,
+    0xfb, 0x41, 0x66, 0x1b, 0xc6, 0xe7, 0xfd, 0x6c,
+    0x87, 0x34, 0x64, 0x0c, 0x49, 0x98, 0xff, 0x7e,
+    0x37, 0x4b, 0x06, 0xce, 0x1a, 0x64, 0xa2, 0xec,
+    0xd8, 0x2a, 0xb0, 0x36, 0x38, 0x4f, 0xb8, 0x3d,
+    0x9a, 0x79, 0xb1, 0x27, 0xa2, 0x7d, 0x50, 0x32,
+};
+
+/* RFC 5903, section 8.1: initiator private key i */
+static const uint8_t rfc5903_i[CRYPTO_ECC_P256_SIZE] = {
+    0xc8, 0x8f, 0x01, 0xf5, 0x10, 0xd9, 0xac, 0x3f,
+    0x70, 0xa2, 0x92, 0xda, 0xa2, 0x31, 0x6d, 0xe5,
+    0x44, 0xe9, 0xaa, 0xb8, 0xaf, 0xe8, 0x40, 0x49,
+    0xc6, 0x2a, 0x9c, 0x57, 0x86, 0x2d, 0x14, 0x33,
+};
+
+/* initiator public key g^i */
+static const uint8_t rfc5903_gi[2 * CRYPTO_ECC_P256_SIZE] = {
+    0xda, 0xd0, 0xb6, 0x53, 0x94, 0x22, 0x1c, 0xf9,
+    0xb0, 0x51, 0xe1, 0xfe, 0xca, 0x57, 0x87, 0xd0,
+    0x98, 0xdf, 0xe6, 0x37, 0xfc, 0x90, 0xb9, 0xef,
+    0x94, 0x5d, 0x0c, 0x37, 0x72, 0x58, 0x11, 0x80,
+    0x52, 0x71, 0xa0, 0x46, 0x1c, 0xdb, 0x82, 0x52,
+    0xd6, 0x1f, 0x1c, 0x45, 0x6f, 0xa3, 0xe5, 0x9a,
+    0xb1, 0xf4, 0x5b, 0x33, 0xac, 0xcf, 0x5f, 0x58,
+    0x38, 0x9e, 0x05, 0x77, 0xb8, 0x99, 0x0b, 0xb3,
+};
+
+/* responder private key r */
+static const uint8_t rfc5903_r[CRYPTO_ECC_P256_SIZE] = {
+    0xc6, 0xef, 0x9c, 0x5d, 0x78, 0xae, 0x01, 0x2a,
+    0x01, 0x11, 0x64, 0xac, 0xb3, 0x97, 0xce, 0x20,
+    0x88, 0x68, 0x5d, 0x8f, 0x06, 0xbf, 0x9b, 0xe0,
+    0xb2, 0x83, 0xab, 0x46, 0x47, 0x6b, 0xee, 0x53,
+};
+
+/* responder public key g^r */
+static const uint8_t rfc5903_gr[2 * CRYPTO_ECC_P256_SIZE] = {
+    0xd1, 0x2d, 0xfb, 0x52, 0x89, 0xc8, 0xd4, 0xf8,
+    0x12, 0x08, 0xb7, 0x02, 0x70, 0x39, 0x8c, 0x34,
+    0x22, 0x96, 0x97, 0x0a, 0x0b, 0xcc, 0xb7, 0x4c,
+    0x73, 0x6f, 0xc7, 0x55, 0x44, 0x94, 0xbf, 0x63,
+    0x56, 0xfb, 0xf3, 0xca, 0x36, 0x6c, 0xc2, 0x3e,
+    0x81, 0x57, 0x85, 0x4c, 0x13, 0xc5, 0x8d, 0x6a,
+    0xac, 0x23, 0xf0, 0x46, 0xad, 0xa3, 0x0f, 0x83,
+    0x53, 0xe7, 0x4f, 0x33, 0x03, 0x98, 0x72, 0xab,
+};
+
+/* shared secret g^ir, x coordinate */
+static const uint8_t rfc5903_gir[CRYPTO_ECC_P256_SIZE] = {
+    0xd6, 0x84, 0x0f, 0x6b, 0x42, 0xf6, 0xed, 0xaf,
+    0xd1, 0x31, 0x16, 0xe0, 0xe1, 0x25, 0x65, 0x20,
+    0x2f, 0xef, 0x8e, 0x9e, 0xce, 0x7d, 0xce, 0x03,
+    0x81, 0x24, 0x64, 0xd0, 0x4b, 0x94, 0x42, 0xde,
+};
+
+static bool _test_ecc(void)
+{
+    uint8_t k[CRYPTO_ECC_P256_SIZE] = { 0 };
+    uint8_t res[sizeof(p256_g)];
+
+    k[CRYPTO_ECC_P256_SIZE - 1] = 2;
+    if (crypto_ecc_p256_mul(k, p256_g, res) ||
+        memcmp(res, p256_2g, sizeof(res)) ||
+        crypto_ecc_p256_add(p256_g, p256_g, res) ||
+        memcmp(res, p256_2g, sizeof(res))) {
+        puts("ECC doubling failed");
+        return false;
+    }
+
+    k[CRYPTO_ECC_P256_SIZE - 1] = 3;
+    if (crypto_ecc_p256_mul(k, p256_g, res) ||
+        memcmp(res, p256_3g, sizeof(res)) ||
+        crypto_ecc_p256_add(p256_2g, p256_g, res) ||
+        memcmp(res, p256_3g, sizeof(res))) {
+        puts("ECC addition failed");
+        return false;
+    }
+
+    /* ECDH from both sides */
+    if (crypto_ecc_p256_mul(rfc5903_i, p256_g, res) ||
+        memcmp(res, rfc5903_gi, sizeof(res)) ||
+        crypto_ecc_p256_mul(rfc5903_r, p256_g, res) ||
+        memcmp(res, rfc5903_gr, sizeof(res)) ||
+        crypto_ecc_p256_mul(rfc5903_i, rfc5903_gr, res) ||
+        memcmp(res, rfc5903_gir, sizeof(rfc5903_gir)) ||
+        crypto_ecc_p256_mul(rfc5903_r, rfc5903_gi, res) ||
+        memcmp(res, rfc5903_gir, sizeof(rfc5903_gir))) {
+        puts("ECDH failed");
+        return false;
+    }
+
+    return true;
+}
+#else
+static bool _test_ecc(void)
+{
+    return true;
+}
+#endif
+
+int main(void)
+{
+    bool ok = _test_ecb(0) && _test_ecb(1) && _test_cipher() && _test_ecc();
+
+    puts(ok ? "SUCCESS" : "FAILED");
+    return 0;
+}
@@ -17,6 +17,8 @@
  * @}
  */
 
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <fcntl.h>
 #include <string.h>
@@ -27,6 +29,7 @@
 #include "mtd.h"
 
 #include "kernel_defines.h"
+#include "xtimer.h"
 
 #ifdef MODULE_MTD_SDCARD
 #include "mtd_sdcard.h"
@@ -48,6 +51,15 @@
 #define FULL_FNAME_RNMD  (MNT_PATH "/" FNAME_RNMD)
 #define FULL_FNAME_NXIST (MNT_PATH "/" FNAME_NXIST)
 #define DIR_NAME "SOMEDIR"
+#define FNAME_BENCH "BENCH.BIN"
+#define FULL_FNAME_BENCH (MNT_PATH "/" FNAME_BENCH)
+
+#ifndef BENCH_SIZE
+#define BENCH_SIZE  (1024UL * 1024UL)
+#endif
+#ifndef BENCH_CHUNK
+#define BENCH_CHUNK (512U)
+#endif
 
 static const char test_txt[]  = "the test file content 123 abc";
 static const char test_txt2[] = "another text";
@@ -304,6 +316,78 @@ static void test_create(void)
     print_test_result("test_create__umount", vfs_umount(&_test_vfs_mount) == 0);
 }
 
+static void test_preallocate(void)
+{
+    struct stat st;
+    int fd;
+
+    print_test_result("test_preallocate__mount",
+                      vfs_mount(&_test_vfs_mount) == 0);
+
+    fd = vfs_open(FULL_FNAME2, O_WRONLY | O_CREAT | O_TRUNC, 0);
+    print_test_result("test_preallocate__open", fd >= 0);
+    print_test_result("test_preallocate__write1",
+                      vfs_write(fd, test_txt, sizeof(test_txt)) ==
+                      sizeof(test_txt));
+    print_test_result("test_preallocate__preallocate",
+                      vfs_fcntl(fd, VFS_F_PREALLOCATE, 4096) == 0);
+    /* the file covers the reserved space, the position stays */
+    print_test_result("test_preallocate__size",
+                      (vfs_fstat(fd, &st) == 0) &&
+                      (st.st_size == sizeof(test_txt) + 4096));
+    print_test_result("test_preallocate__pos",
+                      vfs_lseek(fd, 0, SEEK_CUR) == sizeof(test_txt));
+    print_test_result("test_preallocate__write2",
+                      vfs_write(fd, test_txt, sizeof(test_txt)) ==
+                      sizeof(test_txt));
+    print_test_result("test_preallocate__truncate",
+                      vfs_fcntl(fd, VFS_F_TRUNCATE, 0) == 0);
+    print_test_result("test_preallocate__truncated_size",
+                      (vfs_fstat(fd, &st) == 0) &&
+                      (st.st_size == 2 * sizeof(test_txt)));
+    print_test_result("test_preallocate__close", vfs_close(fd) == 0);
+
+    print_test_result("test_preallocate__unlink",
+                      vfs_unlink(FULL_FNAME2) == 0);
+    print_test_result("test_preallocate__umount",
+                      vfs_umount(&_test_vfs_mount) == 0);
+}
+
+static void test_bench(void)
+{
+    static uint8_t buf[BENCH_CHUNK];
+    bool ok = true;
+    int fd;
+
+    print_test_result("test_bench__mount", vfs_mount(&_test_vfs_mount) == 0);
+
+    fd = vfs_open(FULL_FNAME_BENCH, O_WRONLY | O_CREAT | O_TRUNC, 0);
+    print_test_result("test_bench__open", fd >= 0);
+
+    uint32_t start = xtimer_now_usec();
+    print_test_result("test_bench__preallocate",
+                      vfs_fcntl(fd, VFS_F_PREALLOCATE, BENCH_SIZE) == 0);
+    for (uint32_t written = 0; written < BENCH_SIZE; written += sizeof(buf)) {
+        memset(buf, written / sizeof(buf), sizeof(buf));
+        if (vfs_write(fd, buf, sizeof(buf)) != sizeof(buf)) {
+            ok = false;
+            break;
+        }
+    }
+    print_test_result("test_bench__write", ok);
+    print_test_result("test_bench__close", vfs_close(fd) == 0);
+    uint32_t usec = xtimer_now_usec() - start;
+
+    /* bytes per millisecond are kB/s */
+    uint32_t kbps = (uint64_t)BENCH_SIZE * 1000 / (usec ? usec : 1);
+    printf("bench: %lu bytes in %lu us, %lu.%03lu MB/s\n",
+           (unsigned long)BENCH_SIZE, (unsigned long)usec,
+           (unsigned long)kbps / 1000, (unsigned long)kbps % 1000);
+
+    print_test_result("test_bench__unlink", vfs_unlink(FULL_FNAME_BENCH) == 0);
+    print_test_result("test_bench__umount", vfs_umount(&_test_vfs_mount) == 0);
+}
+
 #ifdef MODULE_NEWLIB
 static void test_newlib(void)
 {
@@ -399,6 +483,8 @@ int main(void)
     test_unlink();
     test_mkrmdir();
     test_create();
+    test_preallocate();
+    test_bench();
 #ifdef MODULE_NEWLIB
     test_newlib();
 #endif
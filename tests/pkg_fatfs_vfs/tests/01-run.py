@@ -22,9 +22,10 @@ def testfunc(child):
     while True:
         res = child.expect([r"[^\n]*:\[OK\]\r\n",
                             r"Test end.\r\n",
+                            r"bench: [^\n]*MB/s\r\n",
                             r".[^\n]*:\[FAILED\]\r\n",
                             r".*\r\n"])
-        if res > 1:
+        if res > 2:
             raise TestFailed(child.after.split(':', 1)[0] + " test failed!")
         elif res == 1:
             break
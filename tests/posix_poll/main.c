@@ -0,0 +1,277 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief   Test application for poll() and select()
+ *
+ * @author  ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+
+#include "pipe.h"
+#include "thread.h"
+#include "vfs.h"
+#include "xtimer.h"
+
+#define TEST_PORT       (4711)
+#define TEST_TIMEOUT_MS (100)
+#define PIPE_BUF_SIZE   (16)
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            printf("%s: FAILED at line %u\n", __func__, __LINE__); \
+            return; \
+        } \
+    } while (0)
+
+static char _pipe_buf[PIPE_BUF_SIZE];
+static ringbuffer_t _rb;
+static pipe_t _pipe;
+
+static char _writer_stack[THREAD_STACKSIZE_DEFAULT];
+
+static ssize_t _dummy_read(vfs_file_t *filp, void *dest, size_t nbytes)
+{
+    (void)filp;
+    (void)dest;
+    (void)nbytes;
+    return 0;
+}
+
+/* a driver without the poll operation */
+static const vfs_file_ops_t _dummy_ops = {
+    .read = _dummy_read,
+};
+
+static int _pipe_open(void)
+{
+    ringbuffer_init(&_rb, _pipe_buf, sizeof(_pipe_buf));
+    pipe_init(&_pipe, &_rb, NULL);
+    return pipe_vfs_bind(&_pipe, O_RDWR);
+}
+
+static void *_writer(void *arg)
+{
+    xtimer_usleep(TEST_TIMEOUT_MS * US_PER_MS);
+    vfs_write((int)(intptr_t)arg, "x", 1);
+    return NULL;
+}
+
+static void test_timeout(void)
+{
+    int fd = _pipe_open();
+    struct pollfd pfd = { .fd = fd, .events = POLLIN };
+
+    CHECK(fd >= 0);
+
+    /* nothing to wait for, sleeps for the timeout */
+    uint32_t start = xtimer_now_usec();
+    CHECK(poll(NULL, 0, TEST_TIMEOUT_MS) == 0);
+    CHECK(xtimer_now_usec() - start >= TEST_TIMEOUT_MS * US_PER_MS);
+
+    /* zero timeout returns immediately */
+    pfd.revents = -1;
+    CHECK(poll(&pfd, 1, 0) == 0);
+    CHECK(pfd.revents == 0);
+
+    start = xtimer_now_usec();
+    CHECK(poll(&pfd, 1, TEST_TIMEOUT_MS) == 0);
+    CHECK(xtimer_now_usec() - start >= TEST_TIMEOUT_MS * US_PER_MS);
+    CHECK(pfd.revents == 0);
+
+    CHECK(vfs_close(fd) == 0);
+    puts("test_timeout: OK");
+}
+
+static void test_fds(void)
+{
+    int fd = _pipe_open();
+    int dummy = vfs_bind(VFS_ANY_FD, O_RDWR, &_dummy_ops, NULL);
+    struct pollfd pfds[3];
+
+    CHECK(fd >= 0);
+    CHECK(dummy >= 0);
+
+    /* negative fds are ignored */
+    pfds[0] = (struct pollfd){ .fd = -1, .events = POLLIN, .revents = -1 };
+    /* files without a poll operation are always ready */
+    pfds[1] = (struct pollfd){ .fd = dummy, .events = POLLIN };
+    /* closed files are invalid */
+    pfds[2] = (struct pollfd){ .fd = fd, .events = POLLIN };
+    CHECK(vfs_close(fd) == 0);
+
+    CHECK(poll(pfds, 3, -1) == 2);
+    CHECK(pfds[0].revents == 0);
+    CHECK(pfds[1].revents == POLLIN);
+    CHECK(pfds[2].revents == POLLNVAL);
+
+    pfds[1].events = POLLIN | POLLOUT;
+    CHECK(poll(&pfds[1], 1, 0) == 1);
+    CHECK(pfds[1].revents == (POLLIN | POLLOUT));
+
+    CHECK(vfs_close(dummy) == 0);
+    puts("test_fds: OK");
+}
+
+static void test_pipe(void)
+{
+    int fd = _pipe_open();
+    struct pollfd pfd = { .fd = fd, .events = POLLIN | POLLOUT };
+    char buf[PIPE_BUF_SIZE] = { 0 };
+
+    CHECK(fd >= 0);
+
+    /* empty */
+    CHECK(poll(&pfd, 1, 0) == 1);
+    CHECK(pfd.revents == POLLOUT);
+
+    /* neither empty nor full */
+    CHECK(vfs_write(fd, "abc", 3) == 3);
+    CHECK(poll(&pfd, 1, 0) == 1);
+    CHECK(pfd.revents == (POLLIN | POLLOUT));
+
+    /* full */
+    CHECK(vfs_write(fd, buf, sizeof(buf) - 3) == sizeof(buf) - 3);
+    CHECK(poll(&pfd, 1, 0) == 1);
+    CHECK(pfd.revents == POLLIN);
+
+    /* drained, a writer thread wakes up the blocked poll() */
+    CHECK(vfs_read(fd, buf, sizeof(buf)) == sizeof(buf));
+    thread_create(_writer_stack, sizeof(_writer_stack),
+                  THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                  _writer, (void *)(intptr_t)fd, "writer");
+    pfd.events = POLLIN;
+    CHECK(poll(&pfd, 1, -1) == 1);
+    CHECK(pfd.revents == POLLIN);
+    CHECK(vfs_read(fd, buf, sizeof(buf)) == 1);
+
+    CHECK(vfs_close(fd) == 0);
+    puts("test_pipe: OK");
+}
+
+static void test_select(void)
+{
+    int fd = _pipe_open();
+    fd_set rfds, wfds;
+    struct timeval tv = { .tv_sec = 0, .tv_usec = 0 };
+
+    CHECK(fd >= 0);
+
+    /* only the ready fds are left in the sets */
+    FD_ZERO(&rfds);
+    FD_ZERO(&wfds);
+    FD_SET(fd, &rfds);
+    FD_SET(STDOUT_FILENO, &wfds);
+    CHECK(select(fd + 1, &rfds, &wfds, NULL, &tv) == 1);
+    CHECK(!FD_ISSET(fd, &rfds));
+    CHECK(FD_ISSET(STDOUT_FILENO, &wfds));
+
+    /* an fd counts once per set it is ready in */
+    CHECK(vfs_write(fd, "abc", 3) == 3);
+    FD_ZERO(&rfds);
+    FD_ZERO(&wfds);
+    FD_SET(fd, &rfds);
+    FD_SET(fd, &wfds);
+    CHECK(select(fd + 1, &rfds, &wfds, NULL, &tv) == 2);
+    CHECK(FD_ISSET(fd, &rfds));
+    CHECK(FD_ISSET(fd, &wfds));
+
+    /* fds at or above nfds are not looked at */
+    FD_ZERO(&rfds);
+    FD_SET(fd, &rfds);
+    tv.tv_usec = TEST_TIMEOUT_MS * US_PER_MS;
+    CHECK(select(fd, &rfds, NULL, NULL, &tv) == 0);
+
+    CHECK(vfs_close(fd) == 0);
+
+    /* closed files fail */
+    FD_ZERO(&rfds);
+    FD_SET(fd, &rfds);
+    tv.tv_usec = 0;
+    errno = 0;
+    CHECK(select(fd + 1, &rfds, NULL, NULL, &tv) == -1);
+    CHECK(errno == EBADF);
+
+    puts("test_select: OK");
+}
+
+static void test_udp(void)
+{
+    struct sockaddr_in6 addr = { .sin6_family = AF_INET6,
+                                 .sin6_port = htons(TEST_PORT) };
+    struct sockaddr_in6 src;
+    socklen_t src_len = sizeof(src);
+    char buf[8];
+    int server = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+    int client = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+    struct pollfd pfd = { .fd = server, .events = POLLIN };
+
+    CHECK(server >= 0);
+    CHECK(client >= 0);
+    CHECK(inet_pton(AF_INET6, "::1", &addr.sin6_addr) == 1);
+    CHECK(bind(server, (struct sockaddr *)&addr, sizeof(addr)) == 0);
+
+    CHECK(poll(&pfd, 1, 0) == 0);
+
+    CHECK(sendto(client, "hello", 5, 0, (struct sockaddr *)&addr,
+                 sizeof(addr)) == 5);
+    CHECK(poll(&pfd, 1, 1000) == 1);
+    CHECK(pfd.revents == POLLIN);
+    /* polling again does not consume the datagram */
+    CHECK(poll(&pfd, 1, 0) == 1);
+    CHECK(recvfrom(server, buf, sizeof(buf), 0, (struct sockaddr *)&src,
+                   &src_len) == 5);
+    CHECK(memcmp(buf, "hello", 5) == 0);
+    CHECK(poll(&pfd, 1, 0) == 0);
+
+    CHECK(close(client) == 0);
+    CHECK(close(server) == 0);
+    puts("test_udp: OK");
+}
+
+static void test_stdin(void)
+{
+    struct pollfd pfd = { .fd = STDIN_FILENO, .events = POLLIN };
+    char buf[8];
+
+    puts("test_stdin: waiting for input");
+    CHECK(poll(&pfd, 1, -1) == 1);
+    CHECK(pfd.revents == POLLIN);
+    CHECK(vfs_read(STDIN_FILENO, buf, sizeof(buf)) > 0);
+    puts("test_stdin: OK");
+}
+
+int main(void)
+{
+    test_timeout();
+    test_fds();
+    test_pipe();
+    test_select();
+    test_udp();
+    test_stdin();
+
+    puts("TEST DONE");
+    return 0;
+}
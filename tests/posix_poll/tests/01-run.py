@@ -0,0 +1,26 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 ML!PA Consulting GmbH
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("test_timeout: OK")
+    child.expect_exact("test_fds: OK")
+    child.expect_exact("test_pipe: OK")
+    child.expect_exact("test_select: OK")
+    child.expect_exact("test_udp: OK")
+    child.expect_exact("test_stdin: waiting for input")
+    child.sendline("poll")
+    child.expect_exact("test_stdin: OK")
+    child.expect_exact("TEST DONE")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       Tests for the entropy pool and the ChaCha20 CSPRNG
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "crypto/chacha.h"
+#include "random.h"
+#include "xtimer.h"
+
+#include "embUnit.h"
+
+#define KEY_SIZE        (32U)
+#define BLOCK_SIZE      (64U)
+/* the event thread has refilled the pool after this time */
+#define REFILL_WAIT_US  (100U * US_PER_MS)
+
+/* RFC 8439, A.1, test vector #1: all zero key and nonce, block counter 0 */
+static const uint8_t _block_0[] = {
+    0x76, 0xb8, 0xe0, 0xad, 0xa0, 0xf1, 0x3d, 0x90,
+    0x40, 0x5d, 0x6a, 0xe5, 0x53, 0x86, 0xbd, 0x28,
+    0xbd, 0xd2, 0x19, 0xb8, 0xa0, 0x8d, 0xed, 0x1a,
+    0xa8, 0x36, 0xef, 0xcc, 0x8b, 0x77, 0x0d, 0xc7,
+    0xda, 0x41, 0x59, 0x7c, 0x51, 0x57, 0x48, 0x8d,
+    0x77, 0x24, 0xe0, 0x3f, 0xb8, 0xd8, 0x4a, 0x37,
+    0x6a, 0x43, 0xb8, 0xf4, 0x15, 0x18, 0xa1, 0x1c,
+    0xc3, 0x87, 0xb6, 0x69, 0xb2, 0xee, 0x65, 0x86,
+};
+
+/* RFC 8439, A.1, test vector #2: all zero key and nonce, block counter 1 */
+static const uint8_t _block_1[] = {
+    0x9f, 0x07, 0xe7, 0xbe, 0x55, 0x51, 0x38, 0x7a,
+    0x98, 0xba, 0x97, 0x7c, 0x73, 0x2d, 0x08, 0x0d,
+    0xcb, 0x0f, 0x29, 0xa0, 0x48, 0xe3, 0x65, 0x69,
+    0x12, 0xc6, 0x53, 0x3e, 0x32, 0xee, 0x7a, 0xed,
+    0x29, 0xb7, 0x21, 0x76, 0x9c, 0xe6, 0x4e, 0x43,
+    0xd5, 0x71, 0x33, 0xb0, 0x74, 0xd8, 0x39, 0xd5,
+    0x31, 0xed, 0x1f, 0x28, 0x51, 0x0a, 0xfb, 0x45,
+    0xac, 0xe1, 0x0a, 0x1f, 0x4b, 0x79, 0x4d, 0x6f,
+};
+
+/* RFC 8439, A.1, test vector #3: key ending in 0x01, block counter 1 */
+static const uint8_t _key_3[KEY_SIZE] = {
+    [KEY_SIZE - 1] = 0x01,
+};
+
+static const uint8_t _block_3[] = {
+    0x3a, 0xeb, 0x52, 0x24, 0xec, 0xf8, 0x49, 0x92,
+    0x9b, 0x9d, 0x82, 0x8d, 0xb1, 0xce, 0xd4, 0xdd,
+    0x83, 0x20, 0x25, 0xe8, 0x01, 0x8b, 0x81, 0x60,
+    0xb8, 0x22, 0x84, 0xf3, 0xc9, 0x49, 0xaa, 0x5a,
+    0x8e, 0xca, 0x00, 0xbb, 0xb4, 0xa7, 0x3b, 0xda,
+    0xd1, 0x92, 0xb5, 0xc4, 0x2f, 0x73, 0xf2, 0xfd,
+    0x4e, 0x27, 0x36, 0x44, 0xc8, 0xb3, 0x61, 0x25,
+    0xa6, 0x4a, 0xdd, 0xeb, 0x00, 0x6c, 0x13, 0xa0,
+};
+
+static const uint8_t _nonce[8];
+
+/* an empty pool mixes nothing into the key, so the output is deterministic
+ * as long as the event thread does not get to refill it */
+static void _drain_pool(void)
+{
+    uint8_t buf[CONFIG_RANDOM_POOL_SIZE];
+
+    while (random_pool_read(buf, sizeof(buf))) {}
+}
+
+static void _seed(const uint8_t *key)
+{
+    uint32_t words[KEY_SIZE / sizeof(uint32_t)];
+
+    memcpy(words, key, sizeof(words));
+    _drain_pool();
+    random_init_by_array(words, ARRAY_SIZE(words));
+}
+
+static void test_random_pool__read(void)
+{
+    uint8_t buf[CONFIG_RANDOM_POOL_SIZE + 1];
+    uint8_t zero[CONFIG_RANDOM_POOL_SIZE] = { 0 };
+
+    TEST_ASSERT_EQUAL_INT(0, random_pool_read(buf, 0));
+
+    /* never more than the pool holds, and nothing once it is empty */
+    TEST_ASSERT(random_pool_read(buf, sizeof(buf)) <= CONFIG_RANDOM_POOL_SIZE);
+    _drain_pool();
+    TEST_ASSERT_EQUAL_INT(0, random_pool_read(buf, sizeof(buf)));
+
+    /* the event thread refills the pool in one batch */
+    xtimer_usleep(REFILL_WAIT_US);
+    memset(buf, 0, sizeof(buf));
+    if (IS_USED(MODULE_PERIPH_HWRNG)) {
+        TEST_ASSERT_EQUAL_INT(CONFIG_RANDOM_POOL_SIZE,
+                              random_pool_read(buf, sizeof(buf)));
+        TEST_ASSERT(memcmp(buf, zero, sizeof(zero)));
+    }
+    else {
+        TEST_ASSERT_EQUAL_INT(0, random_pool_read(buf, sizeof(buf)));
+    }
+}
+
+static void test_prng_chacha20__rfc8439_zero_key(void)
+{
+    static const uint8_t key[KEY_SIZE];
+    uint8_t out[BLOCK_SIZE - KEY_SIZE + BLOCK_SIZE];
+
+    /* the first KEY_SIZE bytes of the key stream are never handed out */
+    _seed(key);
+    random_bytes(out, sizeof(out));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(out, &_block_0[KEY_SIZE],
+                                    BLOCK_SIZE - KEY_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&out[BLOCK_SIZE - KEY_SIZE], _block_1,
+                                    BLOCK_SIZE));
+}
+
+static void test_prng_chacha20__rfc8439_key(void)
+{
+    uint8_t out[BLOCK_SIZE - KEY_SIZE + BLOCK_SIZE];
+
+    _seed(_key_3);
+    random_bytes(out, sizeof(out));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&out[BLOCK_SIZE - KEY_SIZE], _block_3,
+                                    BLOCK_SIZE));
+}
+
+static void test_prng_chacha20__reseed(void)
+{
+    static const uint8_t key[KEY_SIZE];
+    uint8_t out[BLOCK_SIZE - KEY_SIZE + BLOCK_SIZE];
+    uint8_t expected[BLOCK_SIZE];
+    chacha_ctx ctx;
+
+    _seed(key);
+    random_bytes(out, sizeof(out));
+    /* the same seed gives the same output */
+    _seed(key);
+    random_bytes(expected, sizeof(expected));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(out, expected, sizeof(expected)));
+
+    /* fast key erasure: the withheld start of the key stream keys the next
+     * refill */
+    chacha_init(&ctx, 20, _block_0, KEY_SIZE, _nonce);
+    chacha_keystream_bytes(&ctx, expected);
+    _seed(key);
+    random_bytes(out, sizeof(out));
+    random_bytes(out, BLOCK_SIZE - KEY_SIZE);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(out, &expected[KEY_SIZE],
+                                    BLOCK_SIZE - KEY_SIZE));
+}
+
+static Test *tests_prng_chacha20(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_random_pool__read),
+        new_TestFixture(test_prng_chacha20__rfc8439_zero_key),
+        new_TestFixture(test_prng_chacha20__rfc8439_key),
+        new_TestFixture(test_prng_chacha20__reseed),
+    };
+
+    EMB_UNIT_TESTCALLER(prng_chacha20_tests, NULL, NULL, fixtures);
+
+    return (Test *)&prng_chacha20_tests;
+}
+
+int main(void)
+{
+    TESTS_START();
+    TESTS_RUN(tests_prng_chacha20());
+    TESTS_END();
+
+    return 0;
+}
+/** @} */
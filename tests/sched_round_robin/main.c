@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief   Round robin time slicing test application
+ *
+ * Two CPU bound threads of equal priority never yield. Both must make
+ * progress.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "sched_round_robin.h"
+#include "thread.h"
+#include "ztimer.h"
+
+#define WORKER_NUMOF    (2U)
+#define WORKER_PRIO     (THREAD_PRIORITY_MAIN + 1)
+
+static char _stacks[WORKER_NUMOF][THREAD_STACKSIZE_SMALL];
+static volatile unsigned _counters[WORKER_NUMOF];
+
+static void *_worker(void *arg)
+{
+    volatile unsigned *counter = arg;
+
+    while (1) {
+        (*counter)++;
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    puts("START");
+
+    for (unsigned i = 0; i < WORKER_NUMOF; i++) {
+        thread_create(_stacks[i], sizeof(_stacks[i]), WORKER_PRIO,
+                      THREAD_CREATE_WOUT_YIELD, _worker,
+                      (void *)&_counters[i], "worker");
+    }
+
+    /* main has a higher priority than the workers and regains the CPU
+     * once the sleep is over */
+    ztimer_sleep(ZTIMER_MSEC, 20 * CONFIG_SCHED_ROUND_ROBIN_QUANTUM_MS);
+
+    for (unsigned i = 0; i < WORKER_NUMOF; i++) {
+        printf("worker %u: %s\n", i, _counters[i] ? "ran" : "starved");
+        if (!_counters[i]) {
+            puts("FAILURE");
+            return 1;
+        }
+    }
+
+    puts("SUCCESS");
+    return 0;
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for the fixed-point sensor fusion
+ *
+ * Feeds the filters with readings of an IMU at rest, rolled by 0.5 rad,
+ * and checks that they converge to that orientation. Afterwards the time
+ * taken by a single update is measured.
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "sensor_fusion.h"
+#include "test_utils/expect.h"
+
+#define RUNS                (100U)
+/* 20 s at 200 Hz */
+#define STEPS               (4000U)
+#define DT_US               (5000U)
+#define ROLL                F16(0.5)
+/* 0.5 degree */
+#define TOLERANCE           F16(0.0087)
+
+static uint32_t _buf[RUNS];
+static benchmark_samples_t _set = BENCHMARK_SAMPLES_INIT(_buf);
+
+static sensor_fusion_t _filter;
+
+/* gravity (0, 0, 1) and field (0.4, 0, -0.9) seen by the rolled IMU */
+static const fix16_t _gyro[3] = { 0, 0, 0 };
+static const fix16_t _acc[3] = { 0, F16(0.4794), F16(0.8776) };
+static const fix16_t _mag[3] = { F16(0.4), F16(-0.4315), F16(-0.7898) };
+
+static fix16_t _abs(fix16_t x)
+{
+    return (x < 0) ? -x : x;
+}
+
+static void _converge(const char *name, sensor_fusion_algo_t algo,
+                      fix16_t gain, const fix16_t *mag)
+{
+    sensor_fusion_euler_t e;
+
+    sensor_fusion_init(&_filter, algo, gain, 0);
+    for (unsigned i = 0; i < STEPS; i++) {
+        sensor_fusion_update(&_filter, _gyro, _acc, mag, DT_US);
+    }
+    sensor_fusion_euler(&_filter, &e);
+    printf("%s: roll %" PRId32 ", pitch %" PRId32 ", yaw %" PRId32
+           " mrad\n", name, (e.roll * 1000) >> 16, (e.pitch * 1000) >> 16,
+           (e.yaw * 1000) >> 16);
+    expect(_abs(e.roll - ROLL) < TOLERANCE);
+    expect(_abs(e.pitch) < TOLERANCE);
+    if (mag && algo == SENSOR_FUSION_MADGWICK) {
+        expect(_abs(e.yaw) < TOLERANCE);
+    }
+}
+
+static void _gyro_only(void)
+{
+    /* 0.5 rad/s around z for 2 s without references */
+    const fix16_t gyro[3] = { 0, 0, F16(0.5) };
+    const fix16_t none[3] = { 0, 0, 0 };
+    sensor_fusion_euler_t e;
+
+    sensor_fusion_init(&_filter, SENSOR_FUSION_MADGWICK,
+                       CONFIG_SENSOR_FUSION_MADGWICK_BETA, 0);
+    for (unsigned i = 0; i < 400; i++) {
+        sensor_fusion_update(&_filter, gyro, none, NULL, DT_US);
+    }
+    sensor_fusion_euler(&_filter, &e);
+    printf("gyro only: yaw %" PRId32 " mrad\n", (e.yaw * 1000) >> 16);
+    expect(_abs(e.yaw - F16(1.0)) < TOLERANCE);
+}
+
+static void _print(const char *name)
+{
+    benchmark_print_json(name, &_set);
+    _set.numof = 0;
+}
+
+int main(void)
+{
+    puts("sensor fusion test application\n");
+
+    _converge("madgwick imu", SENSOR_FUSION_MADGWICK,
+              CONFIG_SENSOR_FUSION_MADGWICK_BETA, NULL);
+    _converge("madgwick marg", SENSOR_FUSION_MADGWICK,
+              CONFIG_SENSOR_FUSION_MADGWICK_BETA, _mag);
+    _converge("mahony imu", SENSOR_FUSION_MAHONY,
+              CONFIG_SENSOR_FUSION_MAHONY_KP, NULL);
+    _gyro_only();
+
+    benchmark_clock_init();
+    BENCHMARK_SAMPLE(&_set, RUNS,
+                     sensor_fusion_update(&_filter, _gyro, _acc, NULL, DT_US));
+    _print("madgwick imu");
+    BENCHMARK_SAMPLE(&_set, RUNS,
+                     sensor_fusion_update(&_filter, _gyro, _acc, _mag, DT_US));
+    _print("madgwick marg");
+    sensor_fusion_init(&_filter, SENSOR_FUSION_MAHONY,
+                       CONFIG_SENSOR_FUSION_MAHONY_KP,
+                       CONFIG_SENSOR_FUSION_MAHONY_KI);
+    BENCHMARK_SAMPLE(&_set, RUNS,
+                     sensor_fusion_update(&_filter, _gyro, _acc, _mag, DT_US));
+    _print("mahony marg");
+
+    puts("[SUCCESS]");
+    return 0;
+}
@@ -34,6 +34,8 @@
 #include TEST_MANIFEST_INCLUDE(manifest3.bin.h)
 
 #define SUIT_URL_MAX            128
+#define STREAM_BUF_SIZE         1024
+#define STREAM_CHUNK_SIZE       16
 
 typedef struct {
     const unsigned char *data;
@@ -75,6 +77,37 @@ static int test_suit_manifest(const unsigned char *manifest_bin,
     return res;
 }
 
+static int test_suit_manifest_stream(const unsigned char *manifest_bin,
+                                     size_t manifest_bin_len)
+{
+    static uint8_t buf[STREAM_BUF_SIZE];
+    char _url[SUIT_URL_MAX];
+    suit_manifest_t manifest;
+    suit_stream_t stream;
+    riotboot_flashwrite_t writer;
+
+    memset(&manifest, 0, sizeof(manifest));
+    memset(&writer, 0, sizeof(writer));
+
+    manifest.writer = &writer;
+    manifest.urlbuf = _url;
+    manifest.urlbuf_len = SUIT_URL_MAX;
+
+    suit_stream_init(&stream, &manifest, buf, sizeof(buf));
+    for (size_t pos = 0; pos < manifest_bin_len; pos += STREAM_CHUNK_SIZE) {
+        size_t len = manifest_bin_len - pos;
+        if (len > STREAM_CHUNK_SIZE) {
+            len = STREAM_CHUNK_SIZE;
+        }
+        int res = suit_stream_feed(&stream, manifest_bin + pos, len);
+        if (res != SUIT_OK) {
+            return res;
+        }
+    }
+
+    return suit_stream_finish(&stream);
+}
+
 static void test_suit_manifest_01_manifests(void)
 {
     for (unsigned i = 0; i < manifest_blobs_numof; i++) {
@@ -86,10 +119,22 @@ static void test_suit_manifest_01_manifests(void)
     }
 }
 
+static void test_suit_manifest_02_stream(void)
+{
+    for (unsigned i = 0; i < manifest_blobs_numof; i++) {
+        printf("\n--- streaming manifest %u\n", i);
+        int res = test_suit_manifest_stream(manifest_blobs[i].data,
+                                            manifest_blobs[i].len);
+        printf("---- res=%i (expected=%i)\n", res, manifest_blobs[i].expected);
+        TEST_ASSERT_EQUAL_INT(manifest_blobs[i].expected, res);
+    }
+}
+
 Test *tests_suit_manifest(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_suit_manifest_01_manifests),
+        new_TestFixture(test_suit_manifest_02_stream),
     };
 
     EMB_UNIT_TESTCALLER(suit_manifest_tests, NULL, NULL, fixtures);
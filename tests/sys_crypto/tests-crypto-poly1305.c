@@ -8,6 +8,7 @@
  */
 
 #include "embUnit/embUnit.h"
+#include "kernel_defines.h"
 #include "tests-crypto.h"
 
 #include "crypto/poly1305.h"
@@ -275,6 +276,24 @@ static void test_crypto_poly1305_11(void)
     _test_poly1305(key_11, msg_11, sizeof(msg_11), tag_11);
 }
 
+static void test_crypto_poly1305_update(void)
+{
+    static const size_t chunks[] = { 1, 7, 16, 17, 40 };
+    uint8_t gen_tag[16];
+    poly1305_ctx_t ctx;
+
+    /* splitting the message must not change the tag */
+    for (unsigned i = 0; i < ARRAY_SIZE(chunks); i++) {
+        poly1305_init(&ctx, key_2);
+        for (size_t pos = 0; pos < sizeof(msg_2); pos += chunks[i]) {
+            size_t len = sizeof(msg_2) - pos;
+            poly1305_update(&ctx, &msg_2[pos], len < chunks[i] ? len : chunks[i]);
+        }
+        poly1305_finish(&ctx, gen_tag);
+        TEST_ASSERT_EQUAL_INT(0, memcmp(gen_tag, tag_2, sizeof(gen_tag)));
+    }
+}
+
 Test *tests_crypto_poly1305_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -289,6 +308,7 @@ Test *tests_crypto_poly1305_tests(void)
         new_TestFixture(test_crypto_poly1305_9),
         new_TestFixture(test_crypto_poly1305_10),
         new_TestFixture(test_crypto_poly1305_11),
+        new_TestFixture(test_crypto_poly1305_update),
     };
     EMB_UNIT_TESTCALLER(crypto_poly1305_tests, NULL, NULL, fixtures);
     return (Test *) &crypto_poly1305_tests;
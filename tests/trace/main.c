@@ -22,8 +22,20 @@
  * @}
  */
 
+#include <stdio.h>
+
 #include "trace.h"
 
+static void _print_hex(const void *data, size_t len, void *arg)
+{
+    const uint8_t *bytes = data;
+
+    (void)arg;
+    for (size_t i = 0; i < len; i++) {
+        printf("%02x", bytes[i]);
+    }
+}
+
 int main(void)
 {
     trace(0);
@@ -31,5 +43,8 @@ int main(void)
 
     trace_dump();
 
+    trace_dump_bin(_print_hex, NULL);
+    puts("");
+
     return 0;
 }
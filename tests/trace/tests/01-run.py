@@ -7,6 +7,8 @@ from testrunner import run
 def testfunc(child):
     child.expect("n=   0 t=\ +\d+ v=0x00000000\r\n")
     child.expect("n=   1 t=\+\ +\d+ v=0x00000001\r\n")
+    # binary dump: magic, version, clock rate, entries ending with value 1
+    child.expect("5254524301[0-9a-f]{8}[0-9a-f]+01\r\n")
 
 
 if __name__ == "__main__":
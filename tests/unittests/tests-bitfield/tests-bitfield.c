@@ -197,6 +197,70 @@ static void test_bf_get_unset_lastbyte(void)
     TEST_ASSERT_EQUAL_INT(39, res);
 }
 
+static void test_bf_find_first(void)
+{
+    uint8_t field[9];
+
+    memset(field, 0, sizeof(field));
+    TEST_ASSERT_EQUAL_INT(-1, bf_find_first_set(field, 70));
+    TEST_ASSERT_EQUAL_INT(0, bf_find_first_unset(field, 70));
+
+    /* in the trailing bytes after the last full word */
+    bf_set(field, 67);
+    TEST_ASSERT_EQUAL_INT(67, bf_find_first_set(field, 70));
+    bf_set(field, 37);
+    TEST_ASSERT_EQUAL_INT(37, bf_find_first_set(field, 70));
+    /* bits beyond the size are ignored */
+    TEST_ASSERT_EQUAL_INT(-1, bf_find_first_set(field, 37));
+
+    memset(field, 0xff, sizeof(field));
+    TEST_ASSERT_EQUAL_INT(-1, bf_find_first_unset(field, 70));
+    bf_unset(field, 69);
+    TEST_ASSERT_EQUAL_INT(69, bf_find_first_unset(field, 70));
+    TEST_ASSERT_EQUAL_INT(-1, bf_find_first_unset(field, 69));
+    bf_unset(field, 31);
+    TEST_ASSERT_EQUAL_INT(31, bf_find_first_unset(field, 70));
+}
+
+static void test_bf_range(void)
+{
+    uint8_t field[5];
+
+    memset(field, 0, sizeof(field));
+    bf_set_range(field, 3, 30);
+    TEST_ASSERT_EQUAL_INT(0x1f, field[0]);
+    TEST_ASSERT_EQUAL_INT(0xff, field[1]);
+    TEST_ASSERT_EQUAL_INT(0xff, field[2]);
+    TEST_ASSERT_EQUAL_INT(0xff, field[3]);
+    TEST_ASSERT_EQUAL_INT(0x80, field[4]);
+    TEST_ASSERT_EQUAL_INT(30, bf_popcnt(field, 40));
+
+    bf_unset_range(field, 5, 2);
+    TEST_ASSERT_EQUAL_INT(0x19, field[0]);
+    bf_unset_range(field, 8, 16);
+    TEST_ASSERT_EQUAL_INT(0x00, field[1]);
+    TEST_ASSERT_EQUAL_INT(0x00, field[2]);
+    TEST_ASSERT_EQUAL_INT(0xff, field[3]);
+    TEST_ASSERT_EQUAL_INT(12, bf_popcnt(field, 40));
+    /* bits beyond the size are not counted */
+    TEST_ASSERT_EQUAL_INT(11, bf_popcnt(field, 32));
+    TEST_ASSERT_EQUAL_INT(7, bf_popcnt(field, 28));
+}
+
+static void test_bf_and_or(void)
+{
+    uint8_t a[2] = { 0xf0, 0x0f };
+    uint8_t b[2] = { 0x3c, 0x3c };
+    uint8_t out[2];
+
+    bf_and(out, a, b, 16);
+    TEST_ASSERT_EQUAL_INT(0x30, out[0]);
+    TEST_ASSERT_EQUAL_INT(0x0c, out[1]);
+    bf_or(a, a, b, 16);
+    TEST_ASSERT_EQUAL_INT(0xfc, a[0]);
+    TEST_ASSERT_EQUAL_INT(0x3f, a[1]);
+}
+
 Test *tests_bitfield_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -208,6 +272,9 @@ Test *tests_bitfield_tests(void)
         new_TestFixture(test_bf_get_unset_firstbyte),
         new_TestFixture(test_bf_get_unset_middle),
         new_TestFixture(test_bf_get_unset_lastbyte),
+        new_TestFixture(test_bf_find_first),
+        new_TestFixture(test_bf_range),
+        new_TestFixture(test_bf_and_or),
     };
 
     EMB_UNIT_TESTCALLER(bitfield_tests, NULL, NULL, fixtures);
@@ -34,6 +34,19 @@ hashfp_t hashes[TESTS_BLOOM_HASHF] = {
                      (hashfp_t) dek_hash,
                     };
 
+#define TESTS_BLOOM_DH_BITS (2 * CONFIG_BLOOM_BLOCK_BITS)
+#define TESTS_BLOOM_DH_K (6)
+#define TESTS_BLOOM_COUNTERS (128)
+
+static bloom_t bloom_dh;
+BITFIELD(bf_dh, TESTS_BLOOM_DH_BITS);
+static bloom_counting_t bloom_cnt;
+static uint8_t counters[TESTS_BLOOM_COUNTERS / 2];
+hashfp_t hashes_dh[2] = {
+                     (hashfp_t) fnv_hash,
+                     (hashfp_t) sdbm_hash,
+                    };
+
 static void load_dictionary_fixture(void)
 {
     for (int i = 0; i < lenB; i++)
@@ -85,11 +98,96 @@ static void test_bloom_based_on_dictionary_fixture(void)
     TEST_ASSERT(false_positive_rate < TESTS_BLOOM_FALSE_POS_RATE_THR);
 }
 
+static int _false_positives(bool (*check)(const void *, const uint8_t *, size_t),
+                            const void *filter)
+{
+    int in = 0;
+
+    for (int i = 0; i < lenA; i++) {
+        if (check(filter, (const uint8_t *) A[i], strlen(A[i]))) {
+            in++;
+        }
+    }
+    return in;
+}
+
+static bool _check(const void *filter, const uint8_t *buf, size_t len)
+{
+    return bloom_check((bloom_t *)filter, buf, len);
+}
+
+static bool _check_counting(const void *filter, const uint8_t *buf, size_t len)
+{
+    return bloom_counting_check(filter, buf, len);
+}
+
+static void _test_double_hashing(uint8_t flags)
+{
+    memset(bf_dh, 0, sizeof(bf_dh));
+    bloom_init_double(&bloom_dh, TESTS_BLOOM_DH_BITS, bf_dh, hashes_dh,
+                      TESTS_BLOOM_DH_K, flags);
+
+    for (int i = 0; i < lenB; i++) {
+        bloom_add(&bloom_dh, (const uint8_t *) B[i], strlen(B[i]));
+    }
+    for (int i = 0; i < lenB; i++) {
+        TEST_ASSERT(bloom_check(&bloom_dh, (const uint8_t *) B[i],
+                                strlen(B[i])));
+    }
+    TEST_ASSERT(_false_positives(_check, &bloom_dh) <
+                lenA * TESTS_BLOOM_FALSE_POS_RATE_THR);
+}
+
+static void test_bloom_double_hashing(void)
+{
+    _test_double_hashing(0);
+}
+
+static void test_bloom_double_hashing_blocked(void)
+{
+    _test_double_hashing(BLOOM_FLAG_BLOCKED);
+}
+
+static void test_bloom_counting(void)
+{
+    memset(counters, 0, sizeof(counters));
+    bloom_counting_init(&bloom_cnt, TESTS_BLOOM_COUNTERS, counters, hashes_dh,
+                        TESTS_BLOOM_DH_K);
+
+    for (int i = 0; i < lenB; i++) {
+        bloom_counting_add(&bloom_cnt, (const uint8_t *) B[i], strlen(B[i]));
+    }
+    for (int i = 0; i < lenB; i++) {
+        TEST_ASSERT(bloom_counting_check(&bloom_cnt, (const uint8_t *) B[i],
+                                         strlen(B[i])));
+    }
+    TEST_ASSERT(_false_positives(_check_counting, &bloom_cnt) <
+                lenA * TESTS_BLOOM_FALSE_POS_RATE_THR * 4);
+
+    /* removing half of the strings keeps the other half */
+    for (int i = 0; i < lenB / 2; i++) {
+        bloom_counting_remove(&bloom_cnt, (const uint8_t *) B[i], strlen(B[i]));
+    }
+    for (int i = lenB / 2; i < lenB; i++) {
+        TEST_ASSERT(bloom_counting_check(&bloom_cnt, (const uint8_t *) B[i],
+                                         strlen(B[i])));
+    }
+    for (int i = lenB / 2; i < lenB; i++) {
+        bloom_counting_remove(&bloom_cnt, (const uint8_t *) B[i], strlen(B[i]));
+    }
+    for (unsigned i = 0; i < sizeof(counters); i++) {
+        TEST_ASSERT_EQUAL_INT(0, counters[i]);
+    }
+}
+
 Test *tests_bloom_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_bloom_parameters_bytes_hashf),
         new_TestFixture(test_bloom_based_on_dictionary_fixture),
+        new_TestFixture(test_bloom_double_hashing),
+        new_TestFixture(test_bloom_double_hashing_blocked),
+        new_TestFixture(test_bloom_counting),
     };
 
     EMB_UNIT_TESTCALLER(bloom_tests, set_up_bloom, tear_down_bloom, fixtures);
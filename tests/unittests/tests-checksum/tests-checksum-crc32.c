@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <stdint.h>
+
+#include "embUnit/embUnit.h"
+
+#include "checksum/crc32.h"
+
+#include "tests-checksum.h"
+
+static int calc_and_compare_crc_with_update(const unsigned char *buf,
+        size_t len, size_t split, uint32_t expected)
+{
+    uint32_t result = crc32_calc(buf, split);
+
+    result = crc32_update(result, buf + split, len - split);
+
+    return result == expected;
+}
+
+static int calc_and_compare_crc(const unsigned char *buf, size_t len,
+        uint32_t expected)
+{
+    uint32_t result = crc32_calc(buf, len);
+
+    return result == expected;
+}
+
+static void test_checksum_crc32_sequence_empty(void)
+{
+    unsigned char buf[] = "";
+    uint32_t expect = 0x00000000;
+
+    TEST_ASSERT(calc_and_compare_crc(buf, sizeof(buf) - 1, expect));
+    TEST_ASSERT(calc_and_compare_crc_with_update(buf, sizeof(buf) - 1,
+                (sizeof(buf) - 1) / 2, expect));
+}
+
+static void test_checksum_crc32_sequence_1a(void)
+{
+    unsigned char buf[] = "A";
+    uint32_t expect = 0xD3D99E8B;
+
+    TEST_ASSERT(calc_and_compare_crc(buf, sizeof(buf) - 1, expect));
+    TEST_ASSERT(calc_and_compare_crc_with_update(buf, sizeof(buf) - 1,
+                (sizeof(buf) - 1) / 2, expect));
+}
+
+static void test_checksum_crc32_sequence_256a(void)
+{
+    unsigned char buf[] = "AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA"
+                          "AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA"
+                          "AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA"
+                          "AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA"
+                          "AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA"
+                          "AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA"
+                          "AAAA";
+    uint32_t expect = 0x49975B13;
+
+    TEST_ASSERT(calc_and_compare_crc(buf, sizeof(buf) - 1, expect));
+    TEST_ASSERT(calc_and_compare_crc_with_update(buf, sizeof(buf) - 1,
+                (sizeof(buf) - 1) / 2, expect));
+}
+
+static void test_checksum_crc32_sequence_1to9(void)
+{
+    unsigned char buf[] = "123456789";
+    uint32_t expect = 0xCBF43926;
+
+    TEST_ASSERT(calc_and_compare_crc(buf, sizeof(buf) - 1, expect));
+    TEST_ASSERT(calc_and_compare_crc_with_update(buf, sizeof(buf)
+                - 1, (sizeof(buf) - 1) / 2, expect));
+}
+
+static void test_checksum_crc32_sequence_4bytes(void)
+{
+    unsigned char buf[] = { 0x12, 0x34, 0x56, 0x78 };
+    uint32_t expect = 0x4A090E98;
+
+    TEST_ASSERT(calc_and_compare_crc(buf, sizeof(buf), expect));
+    TEST_ASSERT(calc_and_compare_crc_with_update(buf, sizeof(buf),
+                sizeof(buf) / 2, expect));
+}
+
+static void test_checksum_crc32_sequence_unaligned(void)
+{
+    uint32_t mem[104 / sizeof(uint32_t)];
+    unsigned char *buf = (unsigned char *)mem;
+    uint32_t expect = 0x58C932F5;
+
+    /* exercise all alignments of the data */
+    for (unsigned offset = 0; offset < sizeof(uint32_t); offset++) {
+        for (unsigned i = 0; i < 100; i++) {
+            buf[offset + i] = i;
+        }
+        TEST_ASSERT(calc_and_compare_crc(buf + offset, 100, expect));
+        TEST_ASSERT(calc_and_compare_crc_with_update(buf + offset, 100, 33,
+                    expect));
+    }
+}
+
+Test *tests_checksum_crc32_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_checksum_crc32_sequence_empty),
+        new_TestFixture(test_checksum_crc32_sequence_1a),
+        new_TestFixture(test_checksum_crc32_sequence_256a),
+        new_TestFixture(test_checksum_crc32_sequence_1to9),
+        new_TestFixture(test_checksum_crc32_sequence_4bytes),
+        new_TestFixture(test_checksum_crc32_sequence_unaligned),
+    };
+
+    EMB_UNIT_TESTCALLER(checksum_crc32_tests, NULL, NULL, fixtures);
+
+    return (Test *)&checksum_crc32_tests;
+}
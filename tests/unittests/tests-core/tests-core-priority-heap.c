@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "priority_heap.h"
+
+#include "tests-core.h"
+
+#define H_LEN (8)
+
+static priority_heap_t h = PRIORITY_HEAP_INIT;
+static priority_heap_node_t he[H_LEN];
+
+static void set_up(void)
+{
+    priority_heap_init(&h);
+    for (unsigned i = 0; i < ARRAY_SIZE(he); ++i) {
+        priority_heap_node_init(&(he[i]));
+        he[i].data = i;
+    }
+}
+
+static void test_priority_heap_remove_head_empty(void)
+{
+    TEST_ASSERT_NULL(priority_heap_head(&h));
+    TEST_ASSERT_NULL(priority_heap_remove_head(&h));
+    TEST_ASSERT_EQUAL_INT(0, h.numof);
+}
+
+static void test_priority_heap_add_one(void)
+{
+    he[1].priority = 713643658;
+
+    priority_heap_add(&h, &he[1]);
+
+    TEST_ASSERT(priority_heap_head(&h) == &he[1]);
+    TEST_ASSERT_EQUAL_INT(1, h.numof);
+    TEST_ASSERT(priority_heap_remove_head(&h) == &he[1]);
+    TEST_ASSERT_NULL(priority_heap_remove_head(&h));
+    TEST_ASSERT_EQUAL_INT(0, h.numof);
+}
+
+static void test_priority_heap_order(void)
+{
+    static const uint32_t prio[H_LEN] = { 5, 3, 7, 3, 0, 5, 9, 3 };
+    /* ascending priority, nodes of equal priority in the order added */
+    static const unsigned order[H_LEN] = { 4, 1, 3, 7, 0, 5, 2, 6 };
+
+    for (unsigned i = 0; i < H_LEN; i++) {
+        he[i].priority = prio[i];
+        priority_heap_add(&h, &he[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(H_LEN, h.numof);
+    for (unsigned i = 0; i < H_LEN; i++) {
+        priority_heap_node_t *node = priority_heap_remove_head(&h);
+
+        TEST_ASSERT_NOT_NULL(node);
+        TEST_ASSERT_EQUAL_INT(order[i], node->data);
+    }
+    TEST_ASSERT_NULL(priority_heap_remove_head(&h));
+}
+
+static void test_priority_heap_order_seq_wrap(void)
+{
+    /* nodes of equal priority stay in order across the wrap around */
+    h.seq = UINT32_MAX - 2;
+    for (unsigned i = 0; i < H_LEN; i++) {
+        he[i].priority = 42;
+        priority_heap_add(&h, &he[i]);
+    }
+    for (unsigned i = 0; i < H_LEN; i++) {
+        TEST_ASSERT(priority_heap_remove_head(&h) == &he[i]);
+    }
+}
+
+static void test_priority_heap_remove(void)
+{
+    for (unsigned i = 0; i < H_LEN; i++) {
+        he[i].priority = H_LEN - i;
+        priority_heap_add(&h, &he[i]);
+    }
+    /* the head, an inner node and the last one */
+    priority_heap_remove(&h, &he[H_LEN - 1]);
+    priority_heap_remove(&h, &he[3]);
+    priority_heap_remove(&h, &he[0]);
+    TEST_ASSERT_EQUAL_INT(H_LEN - 3, h.numof);
+
+    for (unsigned i = H_LEN - 2; i > 0; i--) {
+        if (i == 3) {
+            continue;
+        }
+        TEST_ASSERT(priority_heap_remove_head(&h) == &he[i]);
+    }
+    TEST_ASSERT_NULL(priority_heap_remove_head(&h));
+}
+
+Test *tests_core_priority_heap_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_priority_heap_remove_head_empty),
+        new_TestFixture(test_priority_heap_add_one),
+        new_TestFixture(test_priority_heap_order),
+        new_TestFixture(test_priority_heap_order_seq_wrap),
+        new_TestFixture(test_priority_heap_remove),
+    };
+
+    EMB_UNIT_TESTCALLER(core_priority_heap_tests, set_up, NULL,
+                        fixtures);
+
+    return (Test *)&core_priority_heap_tests;
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include "embUnit.h"
+
+#include "rwlock.h"
+#include "seqlock.h"
+
+#include "tests-core.h"
+
+static rwlock_t _rwlock;
+static seqlock_t _seqlock;
+
+static void set_up(void)
+{
+    rwlock_init(&_rwlock);
+    seqlock_init(&_seqlock);
+}
+
+static void test_rwlock_readers_share(void)
+{
+    TEST_ASSERT(rwlock_read_trylock(&_rwlock));
+    TEST_ASSERT(rwlock_read_trylock(&_rwlock));
+    TEST_ASSERT(!rwlock_write_trylock(&_rwlock));
+    rwlock_read_unlock(&_rwlock);
+    TEST_ASSERT(!rwlock_write_trylock(&_rwlock));
+    rwlock_read_unlock(&_rwlock);
+    TEST_ASSERT(rwlock_write_trylock(&_rwlock));
+    rwlock_write_unlock(&_rwlock);
+}
+
+static void test_rwlock_writer_excludes(void)
+{
+    rwlock_write_lock(&_rwlock);
+    TEST_ASSERT(!rwlock_read_trylock(&_rwlock));
+    TEST_ASSERT(!rwlock_write_trylock(&_rwlock));
+    rwlock_write_unlock(&_rwlock);
+    rwlock_read_lock(&_rwlock);
+    rwlock_read_unlock(&_rwlock);
+}
+
+static void test_seqlock_retry(void)
+{
+    unsigned seq = seqlock_read_begin(&_seqlock);
+
+    TEST_ASSERT(!seqlock_read_retry(&_seqlock, seq));
+
+    seqlock_write_lock(&_seqlock);
+    seqlock_write_unlock(&_seqlock);
+    TEST_ASSERT(seqlock_read_retry(&_seqlock, seq));
+
+    seq = seqlock_read_begin(&_seqlock);
+    TEST_ASSERT(!seqlock_read_retry(&_seqlock, seq));
+}
+
+Test *tests_core_rwlock_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_rwlock_readers_share),
+        new_TestFixture(test_rwlock_writer_excludes),
+        new_TestFixture(test_seqlock_retry),
+    };
+
+    EMB_UNIT_TESTCALLER(core_rwlock_tests, set_up, NULL, fixtures);
+
+    return (Test *)&core_rwlock_tests;
+}
@@ -262,6 +262,66 @@ static void test_fmt_u32_dec(void)
     TEST_ASSERT_EQUAL_STRING("zzzz", &out[11]);
 }
 
+static void test_fmt_u32_dec_digits(void)
+{
+    static const uint32_t vals[] = { 0, 9, 10, 99, 100, 101, 999, 1000,
+                                     90909, 4294967295 };
+    static const char *const strs[] = { "0", "9", "10", "99", "100", "101",
+                                         "999", "1000", "90909",
+                                         "4294967295" };
+    char out[12];
+
+    for (unsigned i = 0; i < ARRAY_SIZE(vals); i++) {
+        size_t chars = fmt_u32_dec(out, vals[i]);
+        TEST_ASSERT_EQUAL_INT(strlen(strs[i]), chars);
+        TEST_ASSERT_EQUAL_INT(chars, fmt_u32_dec(NULL, vals[i]));
+        out[chars] = '\0';
+        TEST_ASSERT_EQUAL_STRING(strs[i], (char *)out);
+    }
+}
+
+static char _sink_buf[64];
+static size_t _sink_len;
+static unsigned _sink_calls;
+
+static void _sink(void *arg, const char *s, size_t n)
+{
+    TEST_ASSERT(arg == &_sink_calls);
+    memcpy(&_sink_buf[_sink_len], s, n);
+    _sink_len += n;
+    _sink_calls++;
+}
+
+static void test_fmt_writer(void)
+{
+    char buf[12];
+    fmt_writer_t w;
+
+    _sink_len = 0;
+    _sink_calls = 0;
+    fmt_writer_init(&w, buf, sizeof(buf), _sink, &_sink_calls);
+
+    fmt_writer_str(&w, "v=");
+    fmt_writer_s32_dec(&w, -42);
+    fmt_writer_char(&w, ' ');
+    /* nothing passed to the sink while the buffer has room */
+    TEST_ASSERT_EQUAL_INT(0, _sink_calls);
+
+    fmt_writer_u32_dec(&w, 4294967295);
+    TEST_ASSERT_EQUAL_INT(1, _sink_calls);
+    fmt_writer_s32_dfp(&w, -1234, -2);
+    fmt_writer_u64_dec(&w, 18446744073709551615ull);
+    fmt_writer_u32_hex(&w, 0xcafe);
+    /* longer than the buffer, passed on right away */
+    fmt_writer_str(&w, "|0123456789abcdef|");
+    fmt_writer_flush(&w);
+    fmt_writer_flush(&w);
+
+    _sink_buf[_sink_len] = '\0';
+    TEST_ASSERT_EQUAL_STRING("v=-42 4294967295-12.3418446744073709551615"
+                             "0000CAFE|0123456789abcdef|", _sink_buf);
+}
+
 static void test_fmt_u16_dec(void)
 {
     char out[8] = "zzzzzzz";
@@ -859,6 +919,7 @@ Test *tests_fmt_tests(void)
         new_TestFixture(test_fmt_u32_hex),
         new_TestFixture(test_fmt_u64_hex),
         new_TestFixture(test_fmt_u32_dec),
+        new_TestFixture(test_fmt_u32_dec_digits),
         new_TestFixture(test_fmt_u64_dec_a),
         new_TestFixture(test_fmt_u64_dec_b),
         new_TestFixture(test_fmt_u64_dec_c),
@@ -879,6 +940,7 @@ Test *tests_fmt_tests(void)
         new_TestFixture(test_scn_u32_dec),
         new_TestFixture(test_scn_u32_hex),
         new_TestFixture(test_fmt_lpad),
+        new_TestFixture(test_fmt_writer),
     };
 
     EMB_UNIT_TESTCALLER(fmt_tests, NULL, NULL, fixtures);
@@ -178,6 +178,45 @@ static void test_nib_ft_get__success4(void)
     TEST_ASSERT_EQUAL_INT(IFACE, fte.iface);
 }
 
+/*
+ * Adds three nested routes to the forwarding table, then tries to get an
+ * address within all three prefixes while removing the routes from the longest
+ * to the shortest prefix.
+ * Expected result: gnrc_ipv6_nib_ft_get() returns the route with the longest
+ * prefix left in the forwarding table
+ */
+static void test_nib_ft_get__success5(void)
+{
+    gnrc_ipv6_nib_ft_t fte;
+    static const ipv6_addr_t dst = { .u64 = { { .u8 = GLOBAL_PREFIX },
+                                              { .u64 = TEST_UINT64 } } };
+    ipv6_addr_t next_hop = { .u64 = { { .u8 = LINK_LOCAL_PREFIX },
+                                    { .u64 = TEST_UINT64 } } };
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_add(&dst, 64,
+                                                  &next_hop, IFACE, 0));
+    next_hop.u16[0].u16++;
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_add(&dst, GLOBAL_PREFIX_LEN,
+                                                  &next_hop, IFACE, 0));
+    next_hop.u16[0].u16++;
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_add(&dst, 96,
+                                                  &next_hop, IFACE, 0));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_get(&dst, NULL, &fte));
+    TEST_ASSERT(ipv6_addr_equal(&next_hop, &fte.next_hop));
+    TEST_ASSERT_EQUAL_INT(96, fte.dst_len);
+    gnrc_ipv6_nib_ft_del(&dst, 96);
+    next_hop.u16[0].u16 -= 2;
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_get(&dst, NULL, &fte));
+    TEST_ASSERT(ipv6_addr_equal(&next_hop, &fte.next_hop));
+    TEST_ASSERT_EQUAL_INT(64, fte.dst_len);
+    gnrc_ipv6_nib_ft_del(&dst, 64);
+    next_hop.u16[0].u16++;
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_get(&dst, NULL, &fte));
+    TEST_ASSERT(ipv6_addr_equal(&next_hop, &fte.next_hop));
+    TEST_ASSERT_EQUAL_INT(GLOBAL_PREFIX_LEN, fte.dst_len);
+    TEST_ASSERT_EQUAL_INT(IFACE, fte.iface);
+}
+
 /*
  * Tries to create a forwarding table entry for the default route (::) with
  * NULL as next hop.
@@ -727,6 +766,7 @@ Test *tests_gnrc_ipv6_nib_ft_tests(void)
         new_TestFixture(test_nib_ft_get__success2),
         new_TestFixture(test_nib_ft_get__success3),
         new_TestFixture(test_nib_ft_get__success4),
+        new_TestFixture(test_nib_ft_get__success5),
         new_TestFixture(test_nib_ft_add__EINVAL_def_route_next_hop_NULL),
         new_TestFixture(test_nib_ft_add__EINVAL_iface0),
         new_TestFixture(test_nib_ft_add__ENOMEM_diff_def_router),
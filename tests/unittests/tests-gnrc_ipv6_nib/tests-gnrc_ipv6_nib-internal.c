@@ -532,6 +532,38 @@ static void test_nib_nc_add__cache_out_crash(void)
     }
 }
 
+/*
+ * Creates CONFIG_GNRC_IPV6_NIB_NUMOF + 1 neighbor cache entries with different
+ * IP addresses and a garbage-collectible AR state and then looks all of them
+ * up.
+ * Expected result: the last entry replaced exactly one of the others, the
+ * replaced one can not be found by its address anymore
+ */
+static void test_nib_nc_add__cache_out_lookup(void)
+{
+    _nib_onl_entry_t *node;
+    ipv6_addr_t addr = { .u64 = { { .u8 = GLOBAL_PREFIX },
+                                  { .u64 = TEST_UINT64 } } };
+    unsigned found = 0;
+
+    for (int i = 0; i < CONFIG_GNRC_IPV6_NIB_NUMOF; i++) {
+        TEST_ASSERT_NOT_NULL(_nib_nc_add(&addr, IFACE,
+                                         GNRC_IPV6_NIB_NC_INFO_NUD_STATE_STALE));
+        addr.u64[1].u64++;
+    }
+    TEST_ASSERT_NOT_NULL((node = _nib_nc_add(&addr, IFACE,
+                                             GNRC_IPV6_NIB_NC_INFO_NUD_STATE_STALE)));
+    TEST_ASSERT(node == _nib_onl_get(&addr, IFACE));
+    for (int i = 0; i < CONFIG_GNRC_IPV6_NIB_NUMOF; i++) {
+        addr.u64[1].u64--;
+        if ((node = _nib_onl_get(&addr, IFACE)) != NULL) {
+            TEST_ASSERT(ipv6_addr_equal(&addr, &node->ipv6));
+            found++;
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(CONFIG_GNRC_IPV6_NIB_NUMOF - 1, found);
+}
+
 /*
  * Creates a neighbor cache entry and sets it reachable
  * Expected result: node->info flags set to NUD_STATE_REACHABLE and NIB's event
@@ -2028,6 +2060,7 @@ Test *tests_gnrc_ipv6_nib_internal_tests(void)
         new_TestFixture(test_nib_nc_add__success),
         new_TestFixture(test_nib_nc_add__success_full_but_garbage_collectible),
         new_TestFixture(test_nib_nc_add__cache_out_crash),
+        new_TestFixture(test_nib_nc_add__cache_out_lookup),
         new_TestFixture(test_nib_nc_remove__uncleared),
         new_TestFixture(test_nib_nc_remove__cleared),
         new_TestFixture(test_nib_nc_set_reachable__success),
@@ -18,6 +18,7 @@
 
 #include "net/gnrc/ipv6/nib.h"
 #include "net/gnrc/ipv6/nib/nc.h"
+#include "net/gnrc/ipv6/route_cache.h"
 
 #include "_nib-internal.h"
 
@@ -127,6 +128,53 @@ static void test_nib_nc_set__success(void)
     TEST_ASSERT(!gnrc_ipv6_nib_nc_iter(0, &iter_state, &nce));
 }
 
+#if IS_USED(MODULE_GNRC_IPV6_ROUTE_CACHE)
+/*
+ * Adds a neighbor cache entry to the route cache, gets it, and then sets
+ * another neighbor cache entry.
+ * Expected result: the route cache entry is found with the next hop and source
+ * address it was added with, and is gone after gnrc_ipv6_nib_nc_set()
+ */
+static void test_nib_nc_set__route_cache(void)
+{
+    void *iter_state = NULL;
+    static const ipv6_addr_t addr = { .u64 = { { .u8 = GLOBAL_PREFIX },
+                                             { .u64 = TEST_UINT64 } } };
+    static const ipv6_addr_t src = { .u64 = { { .u8 = LINK_LOCAL_PREFIX },
+                                            { .u64 = TEST_UINT64 } } };
+    static const uint8_t l2addr[] = L2ADDR;
+    const gnrc_ipv6_route_cache_stats_t *stats = gnrc_ipv6_route_cache_stats();
+    uint32_t hits = stats->hits, misses = stats->misses;
+    gnrc_ipv6_nib_nc_t nce, cached;
+    ipv6_addr_t cached_src;
+    uint32_t gen;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_nc_set(&addr, IFACE, l2addr,
+                                                  sizeof(l2addr)));
+    gen = gnrc_ipv6_route_cache_gen();
+    TEST_ASSERT(!gnrc_ipv6_route_cache_get(&addr, 0, &cached, &cached_src));
+    TEST_ASSERT(gnrc_ipv6_nib_nc_iter(0, &iter_state, &nce));
+    gnrc_ipv6_route_cache_add(&addr, 0, gen, &nce, NULL);
+    TEST_ASSERT(gnrc_ipv6_route_cache_get(&addr, 0, &cached, &cached_src));
+    TEST_ASSERT(ipv6_addr_is_unspecified(&cached_src));
+    gnrc_ipv6_route_cache_add(&addr, 0, gen, &nce, &src);
+    TEST_ASSERT(gnrc_ipv6_route_cache_get(&addr, 0, &cached, &cached_src));
+    TEST_ASSERT(ipv6_addr_equal(&src, &cached_src));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&nce, &cached, sizeof(nce)));
+    /* entries are per requested interface */
+    TEST_ASSERT(!gnrc_ipv6_route_cache_get(&addr, IFACE, &cached, &cached_src));
+    TEST_ASSERT_EQUAL_INT(hits + 2, stats->hits);
+    TEST_ASSERT_EQUAL_INT(misses + 2, stats->misses);
+    /* any change to the NIB invalidates the cache */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_nc_set(&src, IFACE, l2addr,
+                                                  sizeof(l2addr)));
+    TEST_ASSERT(!gnrc_ipv6_route_cache_get(&addr, 0, &cached, &cached_src));
+    /* results looked up before the change are not added */
+    gnrc_ipv6_route_cache_add(&addr, 0, gen, &nce, &src);
+    TEST_ASSERT(!gnrc_ipv6_route_cache_get(&addr, 0, &cached, &cached_src));
+}
+#endif  /* MODULE_GNRC_IPV6_ROUTE_CACHE */
+
 /*
  * Creates CONFIG_GNRC_IPV6_NIB_NUMOF neighbor cache entries with different IP
  * addresses and interface identifiers and then tries to add another that is
@@ -311,6 +359,9 @@ Test *tests_gnrc_ipv6_nib_nc_tests(void)
         new_TestFixture(test_nib_nc_set__ENOMEM_diff_iface),
         new_TestFixture(test_nib_nc_set__ENOMEM_diff_addr_iface),
         new_TestFixture(test_nib_nc_set__success),
+#if IS_USED(MODULE_GNRC_IPV6_ROUTE_CACHE)
+        new_TestFixture(test_nib_nc_set__route_cache),
+#endif
         new_TestFixture(test_nib_nc_set__success_duplicate),
         new_TestFixture(test_nib_nc_del__unknown),
         new_TestFixture(test_nib_nc_del__success),
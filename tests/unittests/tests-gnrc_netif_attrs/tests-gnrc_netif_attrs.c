@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @author      ML!PA Consulting GmbH
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/attrs.h"
+#include "net/gnrc/netif/internal.h"
+#include "net/netdev.h"
+
+#include "tests-gnrc_netif_attrs.h"
+
+#define TEST_PID        (KERNEL_PID_LAST)
+#define TEST_NID        (0x2342U)
+#define TEST_PDU_SIZE   (102U)
+#define TEST_MTU        (1280U)
+
+static const uint8_t _addr[] = { 0xbe, 0xef };
+
+static int _get(gnrc_netif_t *netif, gnrc_netapi_opt_t *opt);
+
+static const gnrc_netif_ops_t _ops = {
+    .get = _get,
+};
+
+static gnrc_netif_t _netif;
+static unsigned _gets;
+
+static int _get_u16(gnrc_netapi_opt_t *opt, uint16_t val)
+{
+    memcpy(opt->data, &val, sizeof(val));
+    return sizeof(val);
+}
+
+static int _get(gnrc_netif_t *netif, gnrc_netapi_opt_t *opt)
+{
+    (void)netif;
+    _gets++;
+    switch (opt->opt) {
+        case NETOPT_ADDRESS:
+            memcpy(opt->data, _addr, sizeof(_addr));
+            return sizeof(_addr);
+        case NETOPT_SRC_LEN:
+            return _get_u16(opt, sizeof(_addr));
+        case NETOPT_NID:
+            return _get_u16(opt, TEST_NID);
+        case NETOPT_MAX_PDU_SIZE:
+            return _get_u16(opt, TEST_PDU_SIZE);
+        default:
+            return -ENOTSUP;
+    }
+}
+
+static void set_up(void)
+{
+    static bool registered;
+
+    if (!registered) {
+        /* the list of interfaces can not be emptied again */
+        netif_register(&_netif.netif);
+        registered = true;
+    }
+    _netif.ops = &_ops;
+    _netif.pid = TEST_PID;
+    _netif.device_type = NETDEV_TYPE_IEEE802154;
+    _netif.ipv6.mtu = TEST_MTU;
+    _netif.attrs.gen = 0;
+    rmutex_init(&_netif.mutex);
+    _gets = 0;
+}
+
+static void test_gnrc_netif_attrs__unpublished(void)
+{
+    gnrc_netif_attrs_t attrs;
+    uint16_t val;
+    gnrc_netapi_opt_t opt = {
+        .opt = NETOPT_NID,
+        .data = &val,
+        .data_len = sizeof(val),
+    };
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netif_attrs_get(&_netif.attrs, &attrs));
+    /* nothing to refresh before the first full update */
+    gnrc_netif_attrs_update_ipv6(&_netif);
+    TEST_ASSERT_EQUAL_INT(0, _netif.attrs.gen);
+    TEST_ASSERT_EQUAL_INT(-ENOTSUP, gnrc_netif_attrs_netapi_get(TEST_PID, &opt));
+}
+
+static void test_gnrc_netif_attrs__update(void)
+{
+    gnrc_netif_attrs_t attrs;
+
+    gnrc_netif_attrs_update(&_netif);
+    TEST_ASSERT_EQUAL_INT(2, gnrc_netif_attrs_get(&_netif.attrs, &attrs));
+    TEST_ASSERT_EQUAL_INT(GNRC_NETIF_ATTRS_ADDRESS | GNRC_NETIF_ATTRS_SRC_LEN |
+                          GNRC_NETIF_ATTRS_NID | GNRC_NETIF_ATTRS_MAX_PDU_SIZE |
+                          GNRC_NETIF_ATTRS_IPV6_MTU, attrs.valid);
+    TEST_ASSERT_EQUAL_INT(sizeof(_addr), attrs.addr_len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_addr, attrs.addr, sizeof(_addr)));
+    TEST_ASSERT_EQUAL_INT(sizeof(_addr), attrs.src_len);
+    TEST_ASSERT_EQUAL_INT(TEST_NID, attrs.nid);
+    TEST_ASSERT_EQUAL_INT(TEST_PDU_SIZE, attrs.max_pdu_size);
+    TEST_ASSERT_EQUAL_INT(TEST_MTU, attrs.ipv6_mtu);
+    TEST_ASSERT_EQUAL_INT(NETDEV_TYPE_IEEE802154, attrs.device_type);
+}
+
+static void test_gnrc_netif_attrs__update_ipv6(void)
+{
+    gnrc_netif_attrs_t attrs;
+    unsigned gets;
+
+    gnrc_netif_attrs_update(&_netif);
+    gets = _gets;
+    /* as the NIB does on a router advertisement */
+    _netif.ipv6.mtu = 1500;
+    gnrc_netif_attrs_update_ipv6(&_netif);
+    TEST_ASSERT_EQUAL_INT(gets, _gets);
+    TEST_ASSERT_EQUAL_INT(4, gnrc_netif_attrs_get(&_netif.attrs, &attrs));
+    TEST_ASSERT_EQUAL_INT(1500, attrs.ipv6_mtu);
+    TEST_ASSERT_EQUAL_INT(TEST_NID, attrs.nid);
+}
+
+static void test_gnrc_netif_attrs__torn(void)
+{
+    gnrc_netif_attrs_t attrs;
+
+    gnrc_netif_attrs_update(&_netif);
+    /* an update in progress */
+    _netif.attrs.gen++;
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netif_attrs_get(&_netif.attrs, &attrs));
+}
+
+static void test_gnrc_netif_attrs__netapi_get(void)
+{
+    uint16_t val = 0;
+    gnrc_netapi_opt_t opt = {
+        .opt = NETOPT_MAX_PDU_SIZE,
+        .data = &val,
+        .data_len = sizeof(val),
+    };
+
+    gnrc_netif_attrs_update(&_netif);
+    _gets = 0;
+    TEST_ASSERT_EQUAL_INT(sizeof(val),
+                          gnrc_netif_attrs_netapi_get(TEST_PID, &opt));
+    TEST_ASSERT_EQUAL_INT(TEST_PDU_SIZE, val);
+
+    _netif.ipv6.mtu = 1500;
+    gnrc_netif_attrs_update_ipv6(&_netif);
+    opt.context = GNRC_NETTYPE_IPV6;
+    TEST_ASSERT_EQUAL_INT(sizeof(val),
+                          gnrc_netif_attrs_netapi_get(TEST_PID, &opt));
+    TEST_ASSERT_EQUAL_INT(1500, val);
+
+    /* not cached, so left to the interface */
+    opt.opt = NETOPT_ADDRESS_LONG;
+    TEST_ASSERT_EQUAL_INT(-ENOTSUP,
+                          gnrc_netif_attrs_netapi_get(TEST_PID, &opt));
+    opt.opt = NETOPT_CHANNEL;
+    TEST_ASSERT_EQUAL_INT(-ENOTSUP,
+                          gnrc_netif_attrs_netapi_get(TEST_PID, &opt));
+    /* all of it was served from the snapshot */
+    TEST_ASSERT_EQUAL_INT(0, _gets);
+}
+
+static void test_gnrc_netif_attrs__affected(void)
+{
+    TEST_ASSERT(gnrc_netif_attrs_affected(NETOPT_ADDRESS));
+    TEST_ASSERT(gnrc_netif_attrs_affected(NETOPT_MAX_PDU_SIZE));
+    TEST_ASSERT(gnrc_netif_attrs_affected(NETOPT_ENCRYPTION));
+    TEST_ASSERT(!gnrc_netif_attrs_affected(NETOPT_CHANNEL));
+    TEST_ASSERT(!gnrc_netif_attrs_affected(NETOPT_TX_POWER));
+}
+
+Test *tests_gnrc_netif_attrs_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_gnrc_netif_attrs__unpublished),
+        new_TestFixture(test_gnrc_netif_attrs__update),
+        new_TestFixture(test_gnrc_netif_attrs__update_ipv6),
+        new_TestFixture(test_gnrc_netif_attrs__torn),
+        new_TestFixture(test_gnrc_netif_attrs__netapi_get),
+        new_TestFixture(test_gnrc_netif_attrs__affected),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_netif_attrs_tests, set_up, NULL, fixtures);
+
+    return (Test *)&gnrc_netif_attrs_tests;
+}
+
+void tests_gnrc_netif_attrs(void)
+{
+    TESTS_RUN(tests_gnrc_netif_attrs_tests());
+}
+/** @} */
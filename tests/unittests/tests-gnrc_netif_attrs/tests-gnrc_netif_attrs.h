@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  unittests
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the cached interface attributes of GNRC
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+#ifndef TESTS_GNRC_NETIF_ATTRS_H
+#define TESTS_GNRC_NETIF_ATTRS_H
+
+#include "embUnit.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Entry point of the test suite
+ */
+void tests_gnrc_netif_attrs(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TESTS_GNRC_NETIF_ATTRS_H */
+/** @} */
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2020 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "net/gnrc/netif/pktq.h"
+#include "net/ipv6/hdr.h"
+
+#include "tests-gnrc_netif_pktq.h"
+
+#define PKT_INIT_ELEM(len, data, next, type) \
+    { (next), (void *)(data), (len), 1, (type) }
+
+static gnrc_netif_pktq_t q;
+static ipv6_hdr_t hdrs[CONFIG_GNRC_NETIF_PKTQ_LEN + 1];
+static gnrc_pktsnip_t ipv6[CONFIG_GNRC_NETIF_PKTQ_LEN + 1];
+static gnrc_pktsnip_t pkts[CONFIG_GNRC_NETIF_PKTQ_LEN + 1];
+
+static void set_up(void)
+{
+    gnrc_netif_pktq_init(&q, KERNEL_PID_UNDEF);
+    memset(hdrs, 0, sizeof(hdrs));
+    for (unsigned i = 0; i < ARRAY_SIZE(pkts); i++) {
+        gnrc_pktsnip_t ipv6_snip = PKT_INIT_ELEM(sizeof(hdrs[i]), &hdrs[i],
+                                                 NULL, GNRC_NETTYPE_IPV6);
+        gnrc_pktsnip_t netif_snip = PKT_INIT_ELEM(0, NULL, &ipv6[i],
+                                                  GNRC_NETTYPE_NETIF);
+
+        ipv6_hdr_set_version(&hdrs[i]);
+        ipv6[i] = ipv6_snip;
+        pkts[i] = netif_snip;
+    }
+}
+
+static void test_pktq_get_empty(void)
+{
+    TEST_ASSERT(gnrc_netif_pktq_empty(&q));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_usage(&q));
+    TEST_ASSERT_NULL(gnrc_netif_pktq_get(&q));
+}
+
+static void test_pktq_prio(void)
+{
+    /* without IPv6 header */
+    gnrc_pktsnip_t netif_snip = PKT_INIT_ELEM(0, NULL, NULL,
+                                              GNRC_NETTYPE_NETIF);
+
+    TEST_ASSERT_EQUAL_INT(CONFIG_GNRC_NETIF_PKTQ_PRIO_NUMOF - 1,
+                          gnrc_netif_pktq_prio(&netif_snip));
+    TEST_ASSERT_EQUAL_INT(CONFIG_GNRC_NETIF_PKTQ_PRIO_NUMOF - 1,
+                          gnrc_netif_pktq_prio(&pkts[0]));
+    /* class selector 7 (network control) */
+    ipv6_hdr_set_tc(&hdrs[0], 0xe0);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_prio(&pkts[0]));
+    /* expedited forwarding, class selector 5 */
+    ipv6_hdr_set_tc(&hdrs[0], 0xb8);
+    TEST_ASSERT(gnrc_netif_pktq_prio(&pkts[0]) <
+                (CONFIG_GNRC_NETIF_PKTQ_PRIO_NUMOF / 2U));
+    /* ECN bits do not matter */
+    ipv6_hdr_set_tc(&hdrs[0], 0x03);
+    TEST_ASSERT_EQUAL_INT(CONFIG_GNRC_NETIF_PKTQ_PRIO_NUMOF - 1,
+                          gnrc_netif_pktq_prio(&pkts[0]));
+}
+
+static void test_pktq_put_get_fifo(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_put(&q, &pkts[0]));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_put(&q, &pkts[1]));
+    TEST_ASSERT(!gnrc_netif_pktq_empty(&q));
+    TEST_ASSERT_EQUAL_INT(2, gnrc_netif_pktq_usage(&q));
+    TEST_ASSERT(&pkts[0] == gnrc_netif_pktq_get(&q));
+    TEST_ASSERT(&pkts[1] == gnrc_netif_pktq_get(&q));
+    TEST_ASSERT_NULL(gnrc_netif_pktq_get(&q));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_usage(&q));
+}
+
+static void test_pktq_put_get_prio(void)
+{
+    ipv6_hdr_set_tc(&hdrs[1], 0xe0);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_put(&q, &pkts[0]));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_put(&q, &pkts[1]));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_put(&q, &pkts[2]));
+    /* network control first */
+    TEST_ASSERT(&pkts[1] == gnrc_netif_pktq_get(&q));
+    TEST_ASSERT(&pkts[0] == gnrc_netif_pktq_get(&q));
+    TEST_ASSERT(&pkts[2] == gnrc_netif_pktq_get(&q));
+    TEST_ASSERT(gnrc_netif_pktq_empty(&q));
+}
+
+static void test_pktq_push_back(void)
+{
+    gnrc_pktsnip_t *pkt;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_put(&q, &pkts[0]));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_put(&q, &pkts[1]));
+    pkt = gnrc_netif_pktq_get(&q);
+    TEST_ASSERT(&pkts[0] == pkt);
+    /* device still busy */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_push_back(&q, pkt));
+    TEST_ASSERT(&pkts[0] == gnrc_netif_pktq_get(&q));
+    TEST_ASSERT(&pkts[1] == gnrc_netif_pktq_get(&q));
+}
+
+static void test_pktq_put_full(void)
+{
+    for (unsigned i = 0; i < CONFIG_GNRC_NETIF_PKTQ_LEN; i++) {
+        TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_put(&q, &pkts[i]));
+    }
+    TEST_ASSERT_EQUAL_INT(CONFIG_GNRC_NETIF_PKTQ_LEN,
+                          gnrc_netif_pktq_usage(&q));
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS,
+                          gnrc_netif_pktq_put(&q,
+                                              &pkts[CONFIG_GNRC_NETIF_PKTQ_LEN]));
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS,
+                          gnrc_netif_pktq_push_back(&q,
+                                                    &pkts[CONFIG_GNRC_NETIF_PKTQ_LEN]));
+    /* a taken packet frees its slot */
+    TEST_ASSERT(&pkts[0] == gnrc_netif_pktq_get(&q));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_put(&q,
+                                                 &pkts[CONFIG_GNRC_NETIF_PKTQ_LEN]));
+}
+
+Test *tests_gnrc_netif_pktq_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_pktq_get_empty),
+        new_TestFixture(test_pktq_prio),
+        new_TestFixture(test_pktq_put_get_fifo),
+        new_TestFixture(test_pktq_put_get_prio),
+        new_TestFixture(test_pktq_push_back),
+        new_TestFixture(test_pktq_put_full),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_netif_pktq_tests, set_up, NULL, fixtures);
+
+    return (Test *)&gnrc_netif_pktq_tests;
+}
+
+void tests_gnrc_netif_pktq(void)
+{
+    TESTS_RUN(tests_gnrc_netif_pktq_tests());
+}
+/** @} */
@@ -0,0 +1,235 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @author      ML!PA Consulting GmbH
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "net/gnrc/netif.h"
+#include "net/gnrc/tsch/tsch.h"
+#include "net/ieee802154.h"
+#include "net/netdev/ieee802154.h"
+
+#include "include/tsch_internal.h"
+
+#include "tests-gnrc_tsch.h"
+
+#define TEST_ASN            (0x0504030201ULL)
+#define TEST_JOIN_METRIC    (3U)
+
+/* IEEE 802.15.4-2015 beacon with long source address, an HT1 header IE and
+ * an MLME payload IE holding only the TSCH synchronization sub-IE */
+static const uint8_t _eb[] = {
+    0x00, 0xe2,                                     /* FCF */
+    0x17,                                           /* sequence number */
+    0x34, 0x12,                                     /* source PAN */
+    0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01, /* source address */
+    0x00, 0x3f,                                     /* HT1 */
+    0x08, 0x88,                                     /* MLME, 8 bytes */
+    0x06, 0x1a,                                     /* TSCH sync, 6 bytes */
+    0x01, 0x02, 0x03, 0x04, 0x05,                   /* ASN */
+    TEST_JOIN_METRIC,                               /* join metric */
+};
+
+static const uint8_t _addr[] = {
+    0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08
+};
+
+static netdev_ieee802154_t _dev;
+static gnrc_netif_t _netif;
+
+static void set_up(void)
+{
+    memset(&_dev, 0, sizeof(_dev));
+    memset(&_netif, 0, sizeof(_netif));
+    rmutex_init(&_netif.mutex);
+    _netif.dev = &_dev.netdev;
+    memcpy(_netif.l2addr, _addr, sizeof(_addr));
+    _netif.l2addr_len = sizeof(_addr);
+    _dev.pan = 0x1234;
+}
+
+static void test_gnrc_tsch__parse(void)
+{
+    uint64_t asn = 0;
+    uint8_t join_metric = 0;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_tsch_eb_parse(_eb, sizeof(_eb), &asn,
+                                                &join_metric));
+    TEST_ASSERT(asn == TEST_ASN);
+    TEST_ASSERT_EQUAL_INT(TEST_JOIN_METRIC, join_metric);
+}
+
+static void test_gnrc_tsch__parse_truncated(void)
+{
+    uint64_t asn;
+    uint8_t join_metric;
+
+    /* too short for the frame control field and sequence number, buf must
+     * not even be looked at */
+    TEST_ASSERT_EQUAL_INT(-EINVAL, gnrc_tsch_eb_parse(NULL, 0, &asn,
+                                                      &join_metric));
+    /* any truncation of the beacon is rejected */
+    for (size_t len = 1; len < sizeof(_eb); len++) {
+        TEST_ASSERT(gnrc_tsch_eb_parse(_eb, len, &asn, &join_metric) < 0);
+    }
+}
+
+static void test_gnrc_tsch__parse_invalid(void)
+{
+    uint8_t eb[sizeof(_eb)];
+    uint64_t asn;
+    uint8_t join_metric;
+
+    /* frame version 2006 */
+    memcpy(eb, _eb, sizeof(eb));
+    eb[1] = (eb[1] & ~IEEE802154_FCF_VERS_MASK) | IEEE802154_FCF_VERS_V1;
+    TEST_ASSERT_EQUAL_INT(-EINVAL, gnrc_tsch_eb_parse(eb, sizeof(eb), &asn,
+                                                      &join_metric));
+
+    /* no information elements */
+    memcpy(eb, _eb, sizeof(eb));
+    eb[1] &= ~IEEE802154_FCF_IE_PRESENT;
+    TEST_ASSERT_EQUAL_INT(-EINVAL, gnrc_tsch_eb_parse(eb, sizeof(eb), &asn,
+                                                      &join_metric));
+
+    /* payload IE longer than the frame */
+    memcpy(eb, _eb, sizeof(eb));
+    eb[15] = 0x09;
+    TEST_ASSERT_EQUAL_INT(-EINVAL, gnrc_tsch_eb_parse(eb, sizeof(eb), &asn,
+                                                      &join_metric));
+
+    /* sub-IE other than TSCH synchronization */
+    memcpy(eb, _eb, sizeof(eb));
+    eb[18] = 0x1b;
+    TEST_ASSERT_EQUAL_INT(-ENOENT, gnrc_tsch_eb_parse(eb, sizeof(eb), &asn,
+                                                      &join_metric));
+
+    /* HT2, no payload IEs follow */
+    memcpy(eb, _eb, sizeof(eb));
+    eb[13] = 0x80;
+    TEST_ASSERT_EQUAL_INT(-ENOENT, gnrc_tsch_eb_parse(eb, sizeof(eb), &asn,
+                                                      &join_metric));
+}
+
+static void test_gnrc_tsch__build(void)
+{
+    gnrc_tsch_t *tsch = &_netif.mac.prot.tsch;
+    uint8_t eb[IEEE802154_FRAME_LEN_MAX];
+    uint64_t asn = 0;
+    uint8_t join_metric = 0;
+    size_t len;
+
+    tsch->asn = TEST_ASN;
+    tsch->join_metric = TEST_JOIN_METRIC;
+    gnrc_tsch_schedule_minimal(&_netif);
+
+    len = gnrc_tsch_eb_build(&_netif, eb);
+    TEST_ASSERT(len <= sizeof(eb));
+    /* same header and synchronization IE as the reference beacon */
+    TEST_ASSERT_EQUAL_INT(IEEE802154_FCF_TYPE_BEACON,
+                          eb[0] & IEEE802154_FCF_TYPE_MASK);
+    TEST_ASSERT_EQUAL_INT(_eb[1], eb[1]);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&eb[3], &_eb[3], 12));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&eb[17], &_eb[17], 8));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_tsch_eb_parse(eb, len, &asn,
+                                                &join_metric));
+    TEST_ASSERT(asn == TEST_ASN);
+    TEST_ASSERT_EQUAL_INT(TEST_JOIN_METRIC, join_metric);
+}
+
+static void test_gnrc_tsch__schedule_minimal(void)
+{
+    gnrc_tsch_t *tsch = &_netif.mac.prot.tsch;
+
+    gnrc_tsch_schedule_minimal(&_netif);
+    TEST_ASSERT_EQUAL_INT(1, tsch->links_numof);
+    TEST_ASSERT_EQUAL_INT(0, tsch->links[0].timeslot);
+    TEST_ASSERT_EQUAL_INT(0, tsch->links[0].channel_offset);
+    TEST_ASSERT_EQUAL_INT(0, tsch->links[0].addr_len);
+    TEST_ASSERT_EQUAL_INT(GNRC_TSCH_LINK_TX | GNRC_TSCH_LINK_RX |
+                          GNRC_TSCH_LINK_SHARED | GNRC_TSCH_LINK_TIMEKEEPING,
+                          tsch->links[0].options);
+}
+
+static void test_gnrc_tsch__link_add_remove(void)
+{
+    gnrc_tsch_t *tsch = &_netif.mac.prot.tsch;
+
+    gnrc_tsch_schedule_minimal(&_netif);
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_tsch_link_add(&_netif, 3, 2,
+                                                GNRC_TSCH_LINK_TX, _addr));
+    TEST_ASSERT_EQUAL_INT(2, tsch->links_numof);
+    TEST_ASSERT_EQUAL_INT(3, tsch->links[1].timeslot);
+    TEST_ASSERT_EQUAL_INT(2, tsch->links[1].channel_offset);
+    TEST_ASSERT_EQUAL_INT(IEEE802154_LONG_ADDRESS_LEN,
+                          tsch->links[1].addr_len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(tsch->links[1].addr, _addr,
+                                    sizeof(_addr)));
+
+    /* one link per timeslot, within the slotframe */
+    TEST_ASSERT_EQUAL_INT(-EEXIST, gnrc_tsch_link_add(&_netif, 3, 0,
+                                                      GNRC_TSCH_LINK_RX,
+                                                      NULL));
+    TEST_ASSERT_EQUAL_INT(-EINVAL,
+                          gnrc_tsch_link_add(&_netif,
+                                             CONFIG_GNRC_TSCH_SLOTFRAME_LENGTH,
+                                             0, GNRC_TSCH_LINK_RX, NULL));
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_tsch_link_remove(&_netif, 0));
+    TEST_ASSERT_EQUAL_INT(1, tsch->links_numof);
+    TEST_ASSERT_EQUAL_INT(3, tsch->links[0].timeslot);
+    TEST_ASSERT_EQUAL_INT(-ENOENT, gnrc_tsch_link_remove(&_netif, 0));
+}
+
+static void test_gnrc_tsch__link_full(void)
+{
+    gnrc_tsch_t *tsch = &_netif.mac.prot.tsch;
+    unsigned i;
+
+    for (i = 0; i < CONFIG_GNRC_TSCH_LINK_NUMOF; i++) {
+        TEST_ASSERT_EQUAL_INT(0, gnrc_tsch_link_add(&_netif, i, 0,
+                                                    GNRC_TSCH_LINK_RX, NULL));
+    }
+    TEST_ASSERT_EQUAL_INT(CONFIG_GNRC_TSCH_LINK_NUMOF, tsch->links_numof);
+    TEST_ASSERT_EQUAL_INT(-ENOMEM, gnrc_tsch_link_add(&_netif, i, 0,
+                                                      GNRC_TSCH_LINK_RX,
+                                                      NULL));
+}
+
+Test *tests_gnrc_tsch_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_gnrc_tsch__parse),
+        new_TestFixture(test_gnrc_tsch__parse_truncated),
+        new_TestFixture(test_gnrc_tsch__parse_invalid),
+        new_TestFixture(test_gnrc_tsch__build),
+        new_TestFixture(test_gnrc_tsch__schedule_minimal),
+        new_TestFixture(test_gnrc_tsch__link_add_remove),
+        new_TestFixture(test_gnrc_tsch__link_full),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_tsch_tests, set_up, NULL, fixtures);
+
+    return (Test *)&gnrc_tsch_tests;
+}
+
+void tests_gnrc_tsch(void)
+{
+    TESTS_RUN(tests_gnrc_tsch_tests());
+}
+/** @} */
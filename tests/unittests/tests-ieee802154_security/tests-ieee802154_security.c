@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @author      ML!PA Consulting GmbH
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "net/ieee802154_security.h"
+
+#include "tests-ieee802154_security.h"
+
+/* parameters of the examples in IEEE 802.15.4-2006, Annex C.2 */
+static const uint8_t _key[] = {
+    0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7,
+    0xc8, 0xc9, 0xca, 0xcb, 0xcc, 0xcd, 0xce, 0xcf,
+};
+
+static const uint8_t _src[] = {
+    0xac, 0xde, 0x48, 0x00, 0x00, 0x00, 0x00, 0x01,
+};
+
+/* MAC header of the data frame of Annex C.2.2 */
+static const uint8_t _mhr[] = {
+    0x69, 0xdc, 0x84, 0x21, 0x43, 0x02, 0x00, 0x00, 0x00, 0x00, 0x48, 0xde,
+    0xac, 0x01, 0x00, 0x00, 0x00, 0x00, 0x48, 0xde, 0xac,
+};
+
+static const uint8_t _plain[] = { 0x61, 0x62, 0x63, 0x64 };
+
+#define FRAME_COUNTER   (5U)
+#define KEY_INDEX       (1U)
+
+static ieee802154_sec_context_t _ctx;
+static uint8_t _frame[sizeof(_mhr) + IEEE802154_SEC_MAX_AUX_HDR_LEN +
+                      sizeof(_plain) + IEEE802154_SEC_MAX_MIC_LEN];
+
+static void set_up(void)
+{
+    ieee802154_sec_init(&_ctx);
+    ieee802154_sec_set_key(&_ctx, KEY_INDEX, _key);
+    _ctx.frame_counter = FRAME_COUNTER;
+}
+
+/* builds the frame at _frame */
+static void _encrypt(uint8_t level, unsigned *len)
+{
+    uint8_t hdr_len = sizeof(_mhr);
+    uint8_t *payload = &_frame[sizeof(_mhr) + IEEE802154_SEC_MAX_AUX_HDR_LEN];
+    uint8_t mic_len = 0xff;
+
+    _ctx.security_level = level;
+    memcpy(_frame, _mhr, sizeof(_mhr));
+    memcpy(payload, _plain, sizeof(_plain));
+    TEST_ASSERT_EQUAL_INT(0, ieee802154_sec_encrypt_frame(&_ctx, _frame,
+                                                          &hdr_len, payload,
+                                                          sizeof(_plain),
+                                                          payload + sizeof(_plain),
+                                                          &mic_len, _src));
+    TEST_ASSERT_EQUAL_INT(sizeof(_mhr) + IEEE802154_SEC_MAX_AUX_HDR_LEN,
+                          hdr_len);
+    *len = hdr_len + sizeof(_plain) + mic_len;
+}
+
+static int _decrypt(unsigned len)
+{
+    uint8_t hdr_len = sizeof(_mhr);
+    uint8_t *payload, *mic;
+    uint16_t payload_len;
+    uint8_t mic_len;
+    int res;
+
+    res = ieee802154_sec_decrypt_frame(&_ctx, len, _frame, &hdr_len,
+                                       &payload, &payload_len,
+                                       &mic, &mic_len, _src);
+    if ((res == 0) && ((payload_len != sizeof(_plain)) ||
+                       memcmp(_plain, payload, sizeof(_plain)))) {
+        /* decrypted, but to the wrong payload */
+        return -EBADMSG;
+    }
+    return res;
+}
+
+static void test_ieee802154_sec_annex_c_enc(void)
+{
+    static const uint8_t expected[] = {
+        /* auxiliary security header, key identifier mode 1 */
+        0x0c, 0x05, 0x00, 0x00, 0x00, 0x01,
+        /* secured payload of Annex C.2.2 */
+        0xd4, 0x3e, 0x02, 0x2b,
+    };
+    unsigned len;
+
+    _encrypt(IEEE802154_SEC_SCF_SECLEVEL_ENC, &len);
+
+    TEST_ASSERT_EQUAL_INT(sizeof(_mhr) + sizeof(expected), len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_mhr, _frame, sizeof(_mhr)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(expected, &_frame[sizeof(_mhr)],
+                                    sizeof(expected)));
+    TEST_ASSERT_EQUAL_INT(0, _decrypt(len));
+}
+
+/* Annex C.2 only authenticates frames with implicit keys, so the MICs with
+ * the key index of this implementation were computed with an independent
+ * CCM* implementation that reproduces Annex C.2.2 and RFC 3610 */
+static void test_ieee802154_sec_annex_c_enc_mic64(void)
+{
+    static const uint8_t expected[] = {
+        0x0e, 0x05, 0x00, 0x00, 0x00, 0x01,
+        0x77, 0xcb, 0x04, 0xd0,
+        0x32, 0x87, 0xe4, 0xf9, 0x80, 0x05, 0x66, 0x03,
+    };
+    unsigned len;
+
+    _encrypt(IEEE802154_SEC_SCF_SECLEVEL_ENC_MIC64, &len);
+
+    TEST_ASSERT_EQUAL_INT(sizeof(_mhr) + sizeof(expected), len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(expected, &_frame[sizeof(_mhr)],
+                                    sizeof(expected)));
+    TEST_ASSERT_EQUAL_INT(0, _decrypt(len));
+}
+
+static void test_ieee802154_sec_annex_c_mic64(void)
+{
+    static const uint8_t expected[] = {
+        0x0a, 0x05, 0x00, 0x00, 0x00, 0x01,
+        0x61, 0x62, 0x63, 0x64,
+        0x6b, 0x57, 0x96, 0x16, 0xea, 0xae, 0x10, 0xe3,
+    };
+    unsigned len;
+
+    _encrypt(IEEE802154_SEC_SCF_SECLEVEL_MIC64, &len);
+
+    TEST_ASSERT_EQUAL_INT(sizeof(_mhr) + sizeof(expected), len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(expected, &_frame[sizeof(_mhr)],
+                                    sizeof(expected)));
+    TEST_ASSERT_EQUAL_INT(0, _decrypt(len));
+}
+
+static void test_ieee802154_sec_tampered(void)
+{
+    unsigned len;
+
+    _encrypt(IEEE802154_SEC_SCF_SECLEVEL_ENC_MIC64, &len);
+
+    /* the header is authenticated as well */
+    _frame[2] ^= 0x01;
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, _decrypt(len));
+}
+
+static void test_ieee802154_sec_replay(void)
+{
+    unsigned len;
+
+    _encrypt(IEEE802154_SEC_SCF_SECLEVEL_ENC_MIC64, &len);
+    uint8_t copy[sizeof(_frame)];
+
+    memcpy(copy, _frame, len);
+    TEST_ASSERT_EQUAL_INT(0, _decrypt(len));
+    memcpy(_frame, copy, len);
+    TEST_ASSERT_EQUAL_INT(-EALREADY, _decrypt(len));
+}
+
+static void test_ieee802154_sec_downgrade(void)
+{
+    unsigned len;
+
+    _encrypt(IEEE802154_SEC_SCF_SECLEVEL_MIC64, &len);
+
+    /* only frames at the configured level are accepted */
+    _ctx.security_level = IEEE802154_SEC_SCF_SECLEVEL_ENC_MIC64;
+    TEST_ASSERT_EQUAL_INT(-EINVAL, _decrypt(len));
+}
+
+Test *tests_ieee802154_security_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_ieee802154_sec_annex_c_enc),
+        new_TestFixture(test_ieee802154_sec_annex_c_enc_mic64),
+        new_TestFixture(test_ieee802154_sec_annex_c_mic64),
+        new_TestFixture(test_ieee802154_sec_tampered),
+        new_TestFixture(test_ieee802154_sec_replay),
+        new_TestFixture(test_ieee802154_sec_downgrade),
+    };
+
+    EMB_UNIT_TESTCALLER(ieee802154_security_tests, set_up, NULL, fixtures);
+
+    return (Test *)&ieee802154_security_tests;
+}
+
+void tests_ieee802154_security(void)
+{
+    TESTS_RUN(tests_ieee802154_security_tests());
+}
+/** @} */
@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  unittests
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the IEEE 802.15.4 security sublayer
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+#ifndef TESTS_IEEE802154_SECURITY_H
+#define TESTS_IEEE802154_SECURITY_H
+
+#include "embUnit.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Entry point of the test suite
+ */
+void tests_ieee802154_security(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TESTS_IEEE802154_SECURITY_H */
+/** @} */
@@ -165,6 +165,89 @@ static void test_inet_csum__empty_app_buffer(void)
     TEST_ASSERT_EQUAL_INT(hdr_expected, pyld_sum);
 }
 
+/* byte-wise reference implementation of RFC 1071 */
+static uint16_t _ref_csum(uint16_t sum, const uint8_t *buf, uint16_t len)
+{
+    uint32_t csum = sum;
+
+    for (unsigned i = 0; i < len; i++) {
+        csum += (i & 1) ? buf[i] : (uint16_t)(buf[i] << 8);
+    }
+    while (csum >> 16) {
+        csum = (csum & 0xffff) + (csum >> 16);
+    }
+    return csum;
+}
+
+static void test_inet_csum__alignment(void)
+{
+    /* word aligned so the offset below determines the alignment */
+    static uint32_t words[40];
+    uint8_t *data = (uint8_t *)words;
+
+    for (unsigned i = 0; i < sizeof(words); i++) {
+        /* plenty of carries */
+        data[i] = 0xff - ((i * 7) & 0x1f);
+    }
+    for (unsigned offset = 0; offset < 8; offset++) {
+        for (unsigned len = 0; len < (sizeof(words) - offset); len += 13) {
+            TEST_ASSERT_EQUAL_INT(_ref_csum(0x1234, &data[offset], len),
+                                  inet_csum(0x1234, &data[offset], len));
+        }
+    }
+}
+
+static void test_inet_csum__alignment_slices(void)
+{
+    static uint32_t words[16];
+    uint8_t *data = (uint8_t *)words;
+    uint16_t expected;
+
+    for (unsigned i = 0; i < sizeof(words); i++) {
+        data[i] = i * 31;
+    }
+    expected = _ref_csum(0, data, sizeof(words));
+    for (unsigned split = 0; split <= sizeof(words); split++) {
+        uint16_t sum = inet_csum_slice(0, data, split, 0);
+
+        sum = inet_csum_slice(sum, &data[split], sizeof(words) - split, split);
+        TEST_ASSERT_EQUAL_INT(expected, sum);
+    }
+}
+
+static void test_inet_csum__words(void)
+{
+    static const uint32_t words[] = {
+        0xffffffff, 0x80000000, 0x80000001, 0x12345678, 0xfedcba98,
+        0xffff0000, 0x0000ffff, 0xdeadbeef, 0x00000001,
+    };
+    static const struct {
+        uint32_t sum;
+        uint8_t words;
+        uint32_t expected;
+    } vectors[] = {
+        { 0x00000000, 0, 0x00000000 },
+        { 0x00001234, 0, 0x00001234 },
+        { 0x00000000, 1, 0xffffffff },
+        { 0x00000001, 1, 0x00000001 },
+        { 0x00000000, 3, 0x00000002 },
+        { 0x00000000, 4, 0x1234567a },
+        { 0x00000000, 5, 0x11111113 },
+        { 0x00000000, 8, 0xefbed002 },
+        { 0xffffffff, 9, 0xefbed003 },
+    };
+
+    /* the CPU specific implementation must match the portable one */
+    for (unsigned i = 0; i < ARRAY_SIZE(vectors); i++) {
+        TEST_ASSERT_EQUAL_INT(vectors[i].expected,
+                              inet_csum_words_generic(vectors[i].sum, words,
+                                                      vectors[i].words));
+        TEST_ASSERT_EQUAL_INT(vectors[i].expected,
+                              inet_csum_words(vectors[i].sum, words,
+                                              vectors[i].words));
+    }
+}
+
 Test *tests_inet_csum_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -176,6 +259,9 @@ Test *tests_inet_csum_tests(void)
         new_TestFixture(test_inet_csum__odd_len),
         new_TestFixture(test_inet_csum__two_app_snips),
         new_TestFixture(test_inet_csum__empty_app_buffer),
+        new_TestFixture(test_inet_csum__alignment),
+        new_TestFixture(test_inet_csum__alignment_slices),
+        new_TestFixture(test_inet_csum__words),
     };
 
     EMB_UNIT_TESTCALLER(inet_csum_tests, NULL, NULL, fixtures);
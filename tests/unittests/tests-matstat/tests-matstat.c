@@ -6,6 +6,8 @@
  * directory for more details.
  */
 
+#include <inttypes.h>
+#include <stdlib.h>
 #include <string.h>
 #include "embUnit.h"
 #include "tests-matstat.h"
@@ -272,6 +274,81 @@ static void test_matstat_accuracy(void)
     TEST_ASSERT_EQUAL_INT(12293, mean);
 }
 
+static void test_matstat_p2_few(void)
+{
+    matstat_p2_t p2;
+
+    matstat_p2_init(&p2, MATSTAT_QUANTILE(0.5));
+    TEST_ASSERT_EQUAL_INT(0, matstat_p2_get(&p2));
+    matstat_p2_add(&p2, 30);
+    matstat_p2_add(&p2, 10);
+    matstat_p2_add(&p2, 20);
+    /* exact while all samples are stored */
+    TEST_ASSERT_EQUAL_INT(20, matstat_p2_get(&p2));
+}
+
+static void test_matstat_p2_uniform(void)
+{
+    matstat_p2_t p50, p99;
+
+    matstat_p2_init(&p50, MATSTAT_QUANTILE(0.5));
+    matstat_p2_init(&p99, MATSTAT_QUANTILE(0.99));
+    /* 0 ... 9999 in scrambled order */
+    for (int32_t i = 0; i < 10000; i++) {
+        int32_t value = (i * 7919) % 10000;
+        matstat_p2_add(&p50, value);
+        matstat_p2_add(&p99, value);
+    }
+    DEBUG("p50 %" PRId32 " p99 %" PRId32 "\n",
+          matstat_p2_get(&p50), matstat_p2_get(&p99));
+    TEST_ASSERT(abs(matstat_p2_get(&p50) - 5000) < 200);
+    TEST_ASSERT(abs(matstat_p2_get(&p99) - 9900) < 50);
+}
+
+static void test_matstat_hist_quantile(void)
+{
+    uint32_t buckets[MATSTAT_HIST_NUMOF(3, 16)];
+    matstat_hist_t hist;
+
+    matstat_hist_init(&hist, buckets, ARRAY_SIZE(buckets), 3);
+    TEST_ASSERT_EQUAL_INT(0, matstat_hist_quantile(&hist, MATSTAT_QUANTILE(0.5)));
+    for (uint32_t i = 0; i < 10000; i++) {
+        matstat_hist_add(&hist, i);
+    }
+    uint32_t p50 = matstat_hist_quantile(&hist, MATSTAT_QUANTILE(0.5));
+    uint32_t p99 = matstat_hist_quantile(&hist, MATSTAT_QUANTILE(0.99));
+    /* upper bound of the bucket, at most 1/8 above */
+    TEST_ASSERT(p50 >= 5000 && p50 <= 5000 + 5000 / 8);
+    TEST_ASSERT(p99 >= 9900 && p99 <= 9900 + 9900 / 8);
+    /* small values are exact */
+    matstat_hist_init(&hist, buckets, ARRAY_SIZE(buckets), 3);
+    matstat_hist_add(&hist, 5);
+    TEST_ASSERT_EQUAL_INT(5, matstat_hist_quantile(&hist, MATSTAT_QUANTILE(0.5)));
+    /* beyond the range */
+    matstat_hist_add(&hist, UINT32_MAX - 1);
+    TEST_ASSERT(matstat_hist_quantile(&hist, MATSTAT_QUANTILE(1.0)) == UINT32_MAX);
+}
+
+static void test_matstat_hist_merge(void)
+{
+    uint32_t buckets_a[MATSTAT_HIST_NUMOF(2, 8)];
+    uint32_t buckets_b[MATSTAT_HIST_NUMOF(2, 8)];
+    uint32_t buckets_c[MATSTAT_HIST_NUMOF(3, 8)];
+    matstat_hist_t a, b, c;
+
+    matstat_hist_init(&a, buckets_a, ARRAY_SIZE(buckets_a), 2);
+    matstat_hist_init(&b, buckets_b, ARRAY_SIZE(buckets_b), 2);
+    matstat_hist_init(&c, buckets_c, ARRAY_SIZE(buckets_c), 3);
+    matstat_hist_add(&a, 1);
+    matstat_hist_add(&b, 100);
+    matstat_hist_add(&b, 100);
+    TEST_ASSERT_EQUAL_INT(0, matstat_hist_merge(&a, &b));
+    TEST_ASSERT_EQUAL_INT(3, a.count);
+    TEST_ASSERT_EQUAL_INT(1, matstat_hist_quantile(&a, 0));
+    TEST_ASSERT(matstat_hist_quantile(&a, MATSTAT_QUANTILE(0.5)) >= 100);
+    TEST_ASSERT(matstat_hist_merge(&a, &c) < 0);
+}
+
 Test *tests_matstat_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -283,6 +360,10 @@ Test *tests_matstat_tests(void)
         new_TestFixture(test_matstat_merge_variance_regr1),
         new_TestFixture(test_matstat_accuracy),
         new_TestFixture(test_matstat_negative_variance),
+        new_TestFixture(test_matstat_p2_few),
+        new_TestFixture(test_matstat_p2_uniform),
+        new_TestFixture(test_matstat_hist_quantile),
+        new_TestFixture(test_matstat_hist_merge),
     };
 
     EMB_UNIT_TESTCALLER(matstat_tests, NULL, NULL, fixtures);
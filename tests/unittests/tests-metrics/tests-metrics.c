@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @author      ML!PA Consulting GmbH
+ */
+
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "metrics.h"
+
+#include "tests-metrics.h"
+
+typedef struct {
+    metrics_counter_t count;
+    metrics_gauge_t level;
+    metrics_histogram_t len;
+    uint64_t total;
+    unsigned legacy;
+} _metrics_t;
+
+static _metrics_t _single;
+static _metrics_t _array[3];
+
+static const metrics_entry_t _entries[] = {
+    METRICS_ENTRY(METRICS_COUNTER, "count", _metrics_t, count),
+    METRICS_ENTRY(METRICS_GAUGE, "level", _metrics_t, level),
+    METRICS_ENTRY(METRICS_HISTOGRAM, "len", _metrics_t, len),
+    METRICS_ENTRY(METRICS_U64, "total", _metrics_t, total),
+    METRICS_ENTRY(METRICS_UINT, "legacy", _metrics_t, legacy),
+};
+
+static metrics_group_t _single_group = METRICS_GROUP("single", _single,
+                                                     _entries);
+static metrics_group_t _array_group = {
+    .name = "array",
+    .base = _array,
+    .entries = _entries,
+    .numof = ARRAY_SIZE(_entries),
+    .count = ARRAY_SIZE(_array),
+    .stride = sizeof(_array[0]),
+    .id = 1,
+};
+
+static int _registered(const metrics_group_t *group)
+{
+    for (metrics_group_t *g = metrics_groups(); g; g = g->next) {
+        if (g == group) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void set_up(void)
+{
+    memset(&_single, 0, sizeof(_single));
+    memset(_array, 0, sizeof(_array));
+}
+
+static void tear_down(void)
+{
+    metrics_unregister(&_single_group);
+    metrics_unregister(&_array_group);
+}
+
+static void test_metrics__entry(void)
+{
+    TEST_ASSERT_EQUAL_STRING("level", _entries[1].name);
+    TEST_ASSERT_EQUAL_INT(offsetof(_metrics_t, level), _entries[1].offset);
+    TEST_ASSERT_EQUAL_INT(METRICS_GAUGE, _entries[1].type);
+    TEST_ASSERT_EQUAL_INT(sizeof(metrics_gauge_t), _entries[1].size);
+    TEST_ASSERT_EQUAL_INT(ARRAY_SIZE(_entries), _single_group.numof);
+    TEST_ASSERT_EQUAL_INT(1, _single_group.count);
+    TEST_ASSERT_EQUAL_INT(-1, _single_group.id);
+}
+
+static void test_metrics__counter(void)
+{
+    metrics_counter_inc(&_single.count);
+    metrics_counter_add(&_single.count, 41);
+    TEST_ASSERT_EQUAL_INT(42, metrics_read(&_single_group, 0, &_entries[0]));
+
+    /* wraps around like the uint32_t it is */
+    metrics_counter_add(&_single.count, UINT32_MAX);
+    TEST_ASSERT_EQUAL_INT(41, metrics_read(&_single_group, 0, &_entries[0]));
+}
+
+static void test_metrics__gauge(void)
+{
+    metrics_gauge_set(&_single.level, 10);
+    metrics_gauge_add(&_single.level, -15);
+    /* sign extended */
+    TEST_ASSERT(metrics_read(&_single_group, 0, &_entries[1]) == -5);
+    metrics_gauge_add(&_single.level, 7);
+    TEST_ASSERT(metrics_read(&_single_group, 0, &_entries[1]) == 2);
+}
+
+static void test_metrics__histogram(void)
+{
+    const uint32_t *bucket;
+    unsigned num;
+
+    metrics_histogram_observe(&_single.len, 0);
+    metrics_histogram_observe(&_single.len, 1);
+    metrics_histogram_observe(&_single.len, 2);
+    metrics_histogram_observe(&_single.len, 3);
+    metrics_histogram_observe(&_single.len, 4);
+    metrics_histogram_observe(&_single.len, UINT32_MAX);
+
+    bucket = metrics_buckets(&_single_group, 0, &_entries[2], &num);
+    TEST_ASSERT_EQUAL_INT(CONFIG_METRICS_HISTOGRAM_BUCKETS, num);
+    TEST_ASSERT_EQUAL_INT(1, bucket[0]);
+    TEST_ASSERT_EQUAL_INT(1, bucket[1]);
+    TEST_ASSERT_EQUAL_INT(2, bucket[2]);
+    TEST_ASSERT_EQUAL_INT(1, bucket[3]);
+    /* larger values end up in the last bucket */
+    TEST_ASSERT_EQUAL_INT(1, bucket[num - 1]);
+}
+
+static void test_metrics__legacy(void)
+{
+    _single.total = 0x123456789aULL;
+    _single.legacy = 23;
+    TEST_ASSERT(metrics_read(&_single_group, 0, &_entries[3]) ==
+                0x123456789aLL);
+    TEST_ASSERT_EQUAL_INT(23, metrics_read(&_single_group, 0, &_entries[4]));
+}
+
+static void test_metrics__group_instances(void)
+{
+    TEST_ASSERT(metrics_is_zero(&_array_group, 0));
+    TEST_ASSERT(metrics_is_zero(&_array_group, 1));
+    TEST_ASSERT(metrics_is_zero(&_array_group, 2));
+
+    metrics_counter_inc(&_array[1].count);
+    metrics_histogram_observe(&_array[2].len, 100);
+
+    TEST_ASSERT(metrics_is_zero(&_array_group, 0));
+    TEST_ASSERT(!metrics_is_zero(&_array_group, 1));
+    TEST_ASSERT(!metrics_is_zero(&_array_group, 2));
+    TEST_ASSERT_EQUAL_INT(0, metrics_read(&_array_group, 0, &_entries[0]));
+    TEST_ASSERT_EQUAL_INT(1, metrics_read(&_array_group, 1, &_entries[0]));
+    TEST_ASSERT_EQUAL_INT(0, metrics_read(&_array_group, 2, &_entries[0]));
+}
+
+static void test_metrics__register(void)
+{
+    metrics_group_t *g;
+
+    TEST_ASSERT(!_registered(&_single_group));
+    metrics_register(&_single_group);
+    metrics_register(&_array_group);
+    TEST_ASSERT(_registered(&_single_group));
+    TEST_ASSERT(_registered(&_array_group));
+
+    /* groups are kept in the order of registration */
+    for (g = metrics_groups(); g != &_single_group; g = g->next) {}
+    TEST_ASSERT(g->next == &_array_group);
+    TEST_ASSERT_NULL(_array_group.next);
+
+    metrics_unregister(&_single_group);
+    TEST_ASSERT(!_registered(&_single_group));
+    TEST_ASSERT(_registered(&_array_group));
+
+    /* registering again appends */
+    metrics_register(&_single_group);
+    TEST_ASSERT(_array_group.next == &_single_group);
+    TEST_ASSERT_NULL(_single_group.next);
+}
+
+Test *tests_metrics_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_metrics__entry),
+        new_TestFixture(test_metrics__counter),
+        new_TestFixture(test_metrics__gauge),
+        new_TestFixture(test_metrics__histogram),
+        new_TestFixture(test_metrics__legacy),
+        new_TestFixture(test_metrics__group_instances),
+        new_TestFixture(test_metrics__register),
+    };
+
+    EMB_UNIT_TESTCALLER(metrics_tests, set_up, tear_down, fixtures);
+
+    return (Test *)&metrics_tests;
+}
+
+void tests_metrics(void)
+{
+    TESTS_RUN(tests_metrics_tests());
+}
+/** @} */
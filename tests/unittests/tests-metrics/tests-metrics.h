@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  unittests
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the metrics registry
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+#ifndef TESTS_METRICS_H
+#define TESTS_METRICS_H
+
+#include "embUnit.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Entry point of the test suite
+ */
+void tests_metrics(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TESTS_METRICS_H */
+/** @} */
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit/embUnit.h"
+
+#include "msg_buf.h"
+#include "thread.h"
+#include "tests-msg_buf.h"
+
+#define BLOCK_SIZE          (100U)
+#define BLOCK_NUMOF         (3U)
+
+static void *_storage[BLOCK_NUMOF * MSG_BUF_BLOCK_SIZE(BLOCK_SIZE) /
+                      sizeof(void *)];
+static msg_buf_pool_t _pool;
+static msg_t _queue[2];
+
+static void set_up(void)
+{
+    msg_buf_pool_init(&_pool, _storage, BLOCK_SIZE, BLOCK_NUMOF);
+}
+
+static void test_alloc_exhaust(void)
+{
+    msg_buf_t *bufs[BLOCK_NUMOF];
+
+    for (unsigned i = 0; i < BLOCK_NUMOF; i++) {
+        bufs[i] = msg_buf_alloc(&_pool);
+        TEST_ASSERT_NOT_NULL(bufs[i]);
+        TEST_ASSERT(bufs[i]->pool == &_pool);
+        TEST_ASSERT_EQUAL_INT(0, bufs[i]->len);
+        /* whole payload must be usable without touching other blocks */
+        memset(bufs[i]->data, i, BLOCK_SIZE);
+    }
+    TEST_ASSERT_NULL(msg_buf_alloc(&_pool));
+
+    for (unsigned i = 0; i < BLOCK_NUMOF; i++) {
+        for (unsigned j = 0; j < BLOCK_SIZE; j++) {
+            TEST_ASSERT_EQUAL_INT(i, bufs[i]->data[j]);
+        }
+    }
+
+    msg_buf_free(bufs[1]);
+    TEST_ASSERT(msg_buf_alloc(&_pool) == bufs[1]);
+}
+
+static void test_send_to_self(void)
+{
+    msg_t m;
+    msg_buf_t *buf = msg_buf_alloc(&_pool);
+
+    TEST_ASSERT_NOT_NULL(buf);
+    /* sending to ourselves needs a message queue */
+    msg_init_queue(_queue, ARRAY_SIZE(_queue));
+    memcpy(buf->data, "abc", 3);
+    buf->len = 3;
+
+    TEST_ASSERT_EQUAL_INT(1, msg_buf_send(buf, 0x4242, thread_getpid()));
+    msg_receive(&m);
+    TEST_ASSERT_EQUAL_INT(0x4242, m.type);
+    TEST_ASSERT(msg_buf_get(&m) == buf);
+    TEST_ASSERT_EQUAL_INT(3, msg_buf_get(&m)->len);
+    msg_buf_free(msg_buf_get(&m));
+}
+
+static Test *tests_msg_buf_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_alloc_exhaust),
+        new_TestFixture(test_send_to_self),
+    };
+
+    EMB_UNIT_TESTCALLER(msg_buf_tests, set_up, NULL, fixtures);
+
+    return (Test *)&msg_buf_tests;
+}
+
+void tests_msg_buf(void)
+{
+    TESTS_RUN(tests_msg_buf_tests());
+}
+/** @} */
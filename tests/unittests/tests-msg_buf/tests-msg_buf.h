@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  unittests
+ * @{
+ *
+ * @file
+ * @brief       Unittests for zero-copy message buffers
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+#ifndef TESTS_MSG_BUF_H
+#define TESTS_MSG_BUF_H
+
+#include "embUnit.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Entry point of the test suite
+ */
+void tests_msg_buf(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TESTS_MSG_BUF_H */
+/** @} */
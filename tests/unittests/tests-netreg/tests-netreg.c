@@ -14,6 +14,7 @@
 #include <errno.h>
 
 #include "embUnit.h"
+#include "kernel_defines.h"
 
 #include "net/gnrc/netreg.h"
 #include "net/gnrc/nettype.h"
@@ -26,6 +27,15 @@ static gnrc_netreg_entry_t entries[] = {
     GNRC_NETREG_ENTRY_INIT_PID(TEST_UINT16, TEST_UINT8 + 1)
 };
 
+static gnrc_netreg_entry_t ports[] = {
+    GNRC_NETREG_ENTRY_INIT_PID(53, TEST_UINT8),
+    GNRC_NETREG_ENTRY_INIT_PID(123, TEST_UINT8),
+    GNRC_NETREG_ENTRY_INIT_PID(5683, TEST_UINT8),
+    GNRC_NETREG_ENTRY_INIT_PID(49152, TEST_UINT8),
+    GNRC_NETREG_ENTRY_INIT_PID(49153, TEST_UINT8),
+    GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL, TEST_UINT8),
+};
+
 static void set_up(void)
 {
     gnrc_netreg_init();
@@ -139,6 +149,43 @@ void test_netreg_getnext__2_entries(void)
     TEST_ASSERT_NOT_NULL(gnrc_netreg_getnext(res));
 }
 
+void test_netreg_lookup__many_ports(void)
+{
+    for (unsigned i = 0; i < ARRAY_SIZE(ports); i++) {
+        TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &ports[i]));
+    }
+    for (unsigned i = 0; i < ARRAY_SIZE(ports); i++) {
+        TEST_ASSERT(&ports[i] == gnrc_netreg_lookup(GNRC_NETTYPE_TEST,
+                                                    ports[i].demux_ctx));
+        TEST_ASSERT_NULL(gnrc_netreg_getnext(&ports[i]));
+    }
+    TEST_ASSERT_NULL(gnrc_netreg_lookup(GNRC_NETTYPE_TEST, 5684));
+    gnrc_netreg_unregister(GNRC_NETTYPE_TEST, &ports[2]);
+    TEST_ASSERT_NULL(gnrc_netreg_lookup(GNRC_NETTYPE_TEST, 5683));
+    TEST_ASSERT(&ports[3] == gnrc_netreg_lookup(GNRC_NETTYPE_TEST, 49152));
+}
+
+#ifdef MODULE_GNRC_NETREG_STATS
+void test_netreg_get_stats(void)
+{
+    gnrc_netreg_stats_t stats;
+
+    gnrc_netreg_get_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(0, stats.lookups);
+    TEST_ASSERT_EQUAL_INT(0, stats.visited);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &entries[0]));
+    TEST_ASSERT_NOT_NULL(gnrc_netreg_lookup(GNRC_NETTYPE_TEST, TEST_UINT16));
+    gnrc_netreg_get_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(1, stats.lookups);
+    TEST_ASSERT_EQUAL_INT(1, stats.visited);
+    gnrc_netreg_reset_stats();
+    /* invalid types are not searched */
+    TEST_ASSERT_NULL(gnrc_netreg_lookup(GNRC_NETTYPE_NUMOF, TEST_UINT16));
+    gnrc_netreg_get_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(0, stats.lookups);
+}
+#endif
+
 Test *tests_netreg_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -155,6 +202,10 @@ Test *tests_netreg_tests(void)
         new_TestFixture(test_netreg_num__2_entries),
         new_TestFixture(test_netreg_getnext__NULL),
         new_TestFixture(test_netreg_getnext__2_entries),
+        new_TestFixture(test_netreg_lookup__many_ports),
+#ifdef MODULE_GNRC_NETREG_STATS
+        new_TestFixture(test_netreg_get_stats),
+#endif
     };
 
     EMB_UNIT_TESTCALLER(netreg_tests, set_up, NULL, fixtures);
@@ -813,6 +813,45 @@ static void test_pktbuf_start_write__pkt_users_2(void)
     TEST_ASSERT(gnrc_pktbuf_is_empty());
 }
 
+static void test_pktbuf_clone_headers__pkt_users_1(void)
+{
+    gnrc_pktsnip_t *payload = gnrc_pktbuf_add(NULL, TEST_STRING16, sizeof(TEST_STRING16),
+                                              GNRC_NETTYPE_UNDEF);
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(payload, TEST_STRING8, 8, GNRC_NETTYPE_TEST);
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT(pkt == gnrc_pktbuf_clone_headers(pkt, payload));
+    TEST_ASSERT(pkt->next == payload);
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_clone_headers__pkt_users_2(void)
+{
+    gnrc_pktsnip_t *payload = gnrc_pktbuf_add(NULL, TEST_STRING16, sizeof(TEST_STRING16),
+                                              GNRC_NETTYPE_UNDEF);
+    gnrc_pktsnip_t *hdr = gnrc_pktbuf_add(payload, TEST_STRING4, 4, GNRC_NETTYPE_TEST);
+    gnrc_pktsnip_t *clone, *pkt = gnrc_pktbuf_add(hdr, TEST_STRING8, 8, GNRC_NETTYPE_TEST);
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    gnrc_pktbuf_hold(pkt, 1);
+    TEST_ASSERT_NOT_NULL((clone = gnrc_pktbuf_clone_headers(pkt, payload)));
+    TEST_ASSERT(pkt != clone);
+    TEST_ASSERT(hdr != clone->next);
+    TEST_ASSERT_EQUAL_STRING(TEST_STRING4, clone->next->data);
+    /* payload is shared, headers are not */
+    TEST_ASSERT(payload == clone->next->next);
+    TEST_ASSERT_EQUAL_INT(2, payload->users);
+    TEST_ASSERT_EQUAL_INT(1, hdr->users);
+    TEST_ASSERT_EQUAL_INT(1, pkt->users);
+    TEST_ASSERT_EQUAL_INT(1, clone->users);
+
+    gnrc_pktbuf_release(clone);
+    TEST_ASSERT_EQUAL_INT(1, payload->users);
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
 #ifndef MODULE_GNRC_PKTBUF_MALLOC
 static void test_pktbuf_reverse_snips__too_full(void)
 {
@@ -906,6 +945,8 @@ Test *tests_pktbuf_tests(void)
         new_TestFixture(test_pktbuf_start_write__NULL),
         new_TestFixture(test_pktbuf_start_write__pkt_users_1),
         new_TestFixture(test_pktbuf_start_write__pkt_users_2),
+        new_TestFixture(test_pktbuf_clone_headers__pkt_users_1),
+        new_TestFixture(test_pktbuf_clone_headers__pkt_users_2),
 #ifndef MODULE_GNRC_PKTBUF_MALLOC
         new_TestFixture(test_pktbuf_reverse_snips__too_full),
 #endif /* MODULE_GNRC_PKTBUF_MALLOC */
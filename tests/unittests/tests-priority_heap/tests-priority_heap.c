@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       Microbenchmark of priority_heap against priority_queue
+ *
+ * Both queues are kept at QUEUE_LEN - 1 nodes, every sample adds a node
+ * with a pseudo-random priority and removes the head, i.e. the steady
+ * state of a busy packet queue. The results are printed as JSON lines,
+ * the removed nodes must match between both queues.
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include "embUnit.h"
+#include "tests-priority_heap.h"
+
+#include "benchmark.h"
+#include "priority_heap.h"
+#include "priority_queue.h"
+
+#define QUEUE_LEN       (32U)
+#define RUNS            (256U)
+
+static priority_queue_t _queue;
+static priority_queue_node_t _queue_nodes[QUEUE_LEN];
+static priority_heap_t _heap;
+static priority_heap_node_t _heap_nodes[QUEUE_LEN];
+static unsigned _queue_out[RUNS];
+static unsigned _heap_out[RUNS];
+static uint32_t _buf[RUNS];
+static benchmark_samples_t _set = BENCHMARK_SAMPLES_INIT(_buf);
+
+/* same sequence of priorities for both queues */
+static uint32_t _prio(uint32_t *state)
+{
+    *state = *state * 1664525 + 1013904223;
+    return *state >> 28;
+}
+
+static void _queue_step(uint32_t *state, unsigned *out)
+{
+    priority_queue_node_t *node = priority_queue_remove_head(&_queue);
+
+    *out = node->data;
+    node->priority = _prio(state);
+    priority_queue_add(&_queue, node);
+}
+
+static void _heap_step(uint32_t *state, unsigned *out)
+{
+    priority_heap_node_t *node = priority_heap_remove_head(&_heap);
+
+    *out = node->data;
+    node->priority = _prio(state);
+    priority_heap_add(&_heap, node);
+}
+
+static void test_priority_heap_bench(void)
+{
+    uint32_t state;
+
+    benchmark_clock_init();
+
+    state = 1;
+    priority_queue_init(&_queue);
+    for (unsigned i = 0; i < QUEUE_LEN; i++) {
+        priority_queue_node_init(&_queue_nodes[i]);
+        _queue_nodes[i].data = i;
+        _queue_nodes[i].priority = _prio(&state);
+        priority_queue_add(&_queue, &_queue_nodes[i]);
+    }
+    BENCHMARK_SAMPLE(&_set, RUNS, _queue_step(&state, &_queue_out[_benchmark_i]));
+    benchmark_print_json("priority_queue_n32", &_set);
+    _set.numof = 0;
+
+    state = 1;
+    priority_heap_init(&_heap);
+    for (unsigned i = 0; i < QUEUE_LEN; i++) {
+        priority_heap_node_init(&_heap_nodes[i]);
+        _heap_nodes[i].data = i;
+        _heap_nodes[i].priority = _prio(&state);
+        priority_heap_add(&_heap, &_heap_nodes[i]);
+    }
+    BENCHMARK_SAMPLE(&_set, RUNS, _heap_step(&state, &_heap_out[_benchmark_i]));
+    benchmark_print_json("priority_heap_n32", &_set);
+    _set.numof = 0;
+
+    for (unsigned i = 0; i < RUNS; i++) {
+        TEST_ASSERT_EQUAL_INT(_queue_out[i], _heap_out[i]);
+    }
+}
+
+Test *tests_priority_heap_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_priority_heap_bench),
+    };
+
+    EMB_UNIT_TESTCALLER(priority_heap_tests, NULL, NULL, fixtures);
+
+    return (Test *)&priority_heap_tests;
+}
+
+void tests_priority_heap(void)
+{
+    TESTS_RUN(tests_priority_heap_tests());
+}
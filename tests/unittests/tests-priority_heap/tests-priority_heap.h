@@ -0,0 +1,38 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  unittests
+ * @{
+ *
+ * @file
+ * @brief       Microbenchmark of priority_heap against priority_queue
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+
+#ifndef TESTS_PRIORITY_HEAP_H
+#define TESTS_PRIORITY_HEAP_H
+
+#include "embUnit.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   The entry point of this test suite.
+ */
+void tests_priority_heap(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TESTS_PRIORITY_HEAP_H */
+/** @} */
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the senml module
+ *
+ * @author      ML!PA Consulting GmbH
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "embUnit.h"
+#include "tests-senml.h"
+
+#include "senml.h"
+
+static char _buf[256];
+
+static void _assert_json(const char *exp, const senml_base_t *base,
+                         const senml_phydat_t *recs, unsigned numof)
+{
+    size_t len = senml_json_encode(_buf, sizeof(_buf) - 1, base, recs, numof);
+
+    TEST_ASSERT_EQUAL_INT(strlen(exp), len);
+    _buf[len] = '\0';
+    TEST_ASSERT_EQUAL_STRING(exp, _buf);
+}
+
+static void test_senml_json_base(void)
+{
+    const phydat_t temp = { .val = { 2350 }, .unit = UNIT_TEMP_C, .scale = -2 };
+    const phydat_t hum = { .val = { 451 }, .unit = UNIT_PERCENT, .scale = -1 };
+    const senml_phydat_t recs[] = {
+        { .name = "temp", .data = &temp, .dim = 1 },
+        { .name = "hum", .data = &hum, .dim = 1, .time_ms = -250 },
+    };
+    const senml_base_t base = { .name = "dev:", .time_ms = 1634567890000,
+                                .unit = UNIT_TEMP_C };
+
+    _assert_json("[{\"bn\":\"dev:\",\"bt\":1634567890,\"bu\":\"Cel\","
+                 "\"n\":\"temp\",\"v\":23.5},"
+                 "{\"n\":\"hum\",\"u\":\"%\",\"v\":45.1,\"t\":-0.25}]",
+                 &base, recs, ARRAY_SIZE(recs));
+}
+
+static void test_senml_json_values(void)
+{
+    const phydat_t acc = { .val = { -1000, 0, 5 }, .unit = UNIT_G,
+                           .scale = -3 };
+    const phydat_t btn = { .val = { 1 }, .unit = UNIT_BOOL };
+    const phydat_t press = { .val = { 1013 }, .unit = UNIT_PA, .scale = 2 };
+    const phydat_t tvoc = { .val = { 5 }, .unit = UNIT_PPB };
+    const phydat_t deg_f = { .val = { -4 }, .unit = UNIT_TEMP_F };
+    const senml_phydat_t recs[] = {
+        { .name = "acc", .data = &acc, .dim = 3 },
+        { .name = "btn", .data = &btn, .dim = 1 },
+        { .name = "press", .data = &press, .dim = 1 },
+        { .name = "tvoc", .data = &tvoc, .dim = 1 },
+        { .data = &deg_f, .dim = 1 },
+    };
+    const senml_base_t base = { .name = NULL };
+
+    _assert_json("[{\"n\":\"acc:0\",\"u\":\"m/s2\",\"v\":-9.80665},"
+                 "{\"n\":\"acc:1\",\"u\":\"m/s2\",\"v\":0},"
+                 "{\"n\":\"acc:2\",\"u\":\"m/s2\",\"v\":0.04903325},"
+                 "{\"n\":\"btn\",\"vb\":true},"
+                 "{\"n\":\"press\",\"u\":\"Pa\",\"v\":1013e2},"
+                 "{\"n\":\"tvoc\",\"u\":\"/\",\"v\":5e-9},"
+                 "{\"v\":-4}]",
+                 &base, recs, ARRAY_SIZE(recs));
+}
+
+static void test_senml_json_overflow(void)
+{
+    const phydat_t temp = { .val = { 2350 }, .unit = UNIT_TEMP_C, .scale = -2 };
+    const senml_phydat_t rec = { .name = "temp", .data = &temp, .dim = 1 };
+    const senml_base_t base = { .name = NULL };
+    const char exp[] = "[{\"n\":\"temp\",\"u\":\"Cel\",\"v\":23.5}]";
+
+    memset(_buf, 'z', sizeof(_buf));
+    /* the length needed is returned, nothing is written past the buffer */
+    TEST_ASSERT_EQUAL_INT(sizeof(exp) - 1,
+                          senml_json_encode(_buf, 8, &base, &rec, 1));
+    TEST_ASSERT_EQUAL_INT('z', _buf[8]);
+}
+
+Test *tests_senml_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_senml_json_base),
+        new_TestFixture(test_senml_json_values),
+        new_TestFixture(test_senml_json_overflow),
+    };
+
+    EMB_UNIT_TESTCALLER(senml_tests, NULL, NULL, fixtures);
+
+    return (Test *)&senml_tests;
+}
+
+void tests_senml(void)
+{
+    TESTS_RUN(tests_senml_tests());
+}
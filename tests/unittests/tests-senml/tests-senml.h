@@ -0,0 +1,38 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  unittests
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the senml module
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+
+#ifndef TESTS_SENML_H
+#define TESTS_SENML_H
+
+#include "embUnit.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   The entry point of this test suite.
+ */
+void tests_senml(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TESTS_SENML_H */
+/** @} */
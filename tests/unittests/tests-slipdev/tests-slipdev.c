@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @author      ML!PA Consulting GmbH
+ */
+
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "slipdev.h"
+#include "slipdev_internal.h"
+
+#include "tests-slipdev.h"
+
+/* two frames with escaped END and ESC bytes, the escape of the first frame
+ * ends a word aligned run of plain bytes */
+static const uint8_t _encoded[] = {
+    SLIPDEV_END, 0x61, 0x62, SLIPDEV_ESC, SLIPDEV_END_ESC, 0x63, 0x64, 0x65,
+    0x66, SLIPDEV_ESC, SLIPDEV_ESC_ESC, 0x67, SLIPDEV_END,
+    0x68, SLIPDEV_ESC, SLIPDEV_ESC_ESC, SLIPDEV_ESC, SLIPDEV_END_ESC,
+    SLIPDEV_END_ESC, 0x69, SLIPDEV_END,
+};
+static const uint8_t _frame1[] = {
+    0x61, 0x62, SLIPDEV_END, 0x63, 0x64, 0x65, 0x66, SLIPDEV_ESC, 0x67,
+};
+static const uint8_t _frame2[] = {
+    0x68, SLIPDEV_ESC, SLIPDEV_END, SLIPDEV_END_ESC, 0x69,
+};
+
+static slipdev_t _dev;
+
+static void set_up(void)
+{
+    static const slipdev_params_t params = { 0 };
+
+    memset(&_dev, 0, sizeof(_dev));
+    slipdev_setup(&_dev, &params);
+    /* what the driver's init does, without the UART */
+    tsrb_init(&_dev.inbuf, _dev.rxmem, sizeof(_dev.rxmem));
+    cib_init(&_dev.rx_frames, CONFIG_SLIPDEV_RX_FRAMES);
+}
+
+static void _check_frames(void)
+{
+    netdev_t *netdev = &_dev.netdev;
+    uint8_t buf[sizeof(_encoded)];
+
+    TEST_ASSERT_EQUAL_INT(sizeof(_frame1),
+                          netdev->driver->recv(netdev, NULL, 0, NULL));
+    TEST_ASSERT_EQUAL_INT(sizeof(_frame1),
+                          netdev->driver->recv(netdev, buf, sizeof(buf), NULL));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_frame1, buf, sizeof(_frame1)));
+    TEST_ASSERT_EQUAL_INT(sizeof(_frame2),
+                          netdev->driver->recv(netdev, buf, sizeof(buf), NULL));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_frame2, buf, sizeof(_frame2)));
+    TEST_ASSERT_EQUAL_INT(0, netdev->driver->recv(netdev, NULL, 0, NULL));
+}
+
+static void test_slipdev_rx_byte(void)
+{
+    for (unsigned i = 0; i < sizeof(_encoded); i++) {
+        slipdev_rx_byte(&_dev, _encoded[i]);
+    }
+    _check_frames();
+}
+
+static void test_slipdev_rx_chunk(void)
+{
+    slipdev_rx_chunk(&_dev, _encoded, sizeof(_encoded));
+    _check_frames();
+}
+
+static void test_slipdev_rx_chunk_split(void)
+{
+    /* split right after each ESC, so the escaped byte starts a chunk */
+    static const size_t splits[] = { 4, 10, 15, 17, sizeof(_encoded) };
+    size_t pos = 0;
+
+    for (unsigned i = 0; i < ARRAY_SIZE(splits); i++) {
+        slipdev_rx_chunk(&_dev, &_encoded[pos], splits[i] - pos);
+        pos = splits[i];
+    }
+    _check_frames();
+}
+
+Test *tests_slipdev_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_slipdev_rx_byte),
+        new_TestFixture(test_slipdev_rx_chunk),
+        new_TestFixture(test_slipdev_rx_chunk_split),
+    };
+
+    EMB_UNIT_TESTCALLER(slipdev_tests, set_up, NULL, fixtures);
+
+    return (Test *)&slipdev_tests;
+}
+
+void tests_slipdev(void)
+{
+    TESTS_RUN(tests_slipdev_tests());
+}
+/** @} */
@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  unittests
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the SLIP decoder of slipdev
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+#ifndef TESTS_SLIPDEV_H
+#define TESTS_SLIPDEV_H
+
+#include "embUnit.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Entry point of the test suite
+ */
+void tests_slipdev(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TESTS_SLIPDEV_H */
+/** @} */
@@ -162,6 +162,61 @@ static void test_add(void)
     }
 }
 
+static void test_wrap_around(void)
+{
+    for (int i = 0; i < (int)sizeof(_io_buffer); i++) {
+        _io_buffer[i] = TEST_INPUT + i;
+    }
+    /* move the indices to the middle of the buffer */
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE / 2, tsrb_add(&_tsrb, _io_buffer,
+                                                    BUFFER_SIZE / 2));
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE / 2, tsrb_drop(&_tsrb, BUFFER_SIZE));
+
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE, tsrb_add(&_tsrb, _io_buffer,
+                                                sizeof(_io_buffer)));
+    memset(_io_buffer, IO_BUFFER_CANARY, sizeof(_io_buffer));
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE, tsrb_get(&_tsrb, _io_buffer,
+                                                sizeof(_io_buffer)));
+    for (int i = 0; i < BUFFER_SIZE; i++) {
+        TEST_ASSERT_EQUAL_INT((uint8_t)(TEST_INPUT + i), _io_buffer[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(IO_BUFFER_CANARY, _io_buffer[BUFFER_SIZE]);
+}
+
+static void test_contig(void)
+{
+    uint8_t *data;
+
+    TEST_ASSERT_EQUAL_INT(0, tsrb_peek_contig(&_tsrb, &data));
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE, tsrb_reserve_contig(&_tsrb, &data));
+    TEST_ASSERT(data == _tsrb_buffer);
+
+    /* write 3/4 in place, nothing is visible before committing */
+    memset(data, TEST_INPUT, (3 * BUFFER_SIZE) / 4);
+    TEST_ASSERT_EQUAL_INT(1, tsrb_empty(&_tsrb));
+    tsrb_commit(&_tsrb, (3 * BUFFER_SIZE) / 4);
+    TEST_ASSERT_EQUAL_INT((3 * BUFFER_SIZE) / 4, tsrb_avail(&_tsrb));
+
+    TEST_ASSERT_EQUAL_INT((3 * BUFFER_SIZE) / 4,
+                          tsrb_peek_contig(&_tsrb, &data));
+    TEST_ASSERT_EQUAL_INT(TEST_INPUT, data[0]);
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE / 2, tsrb_drop(&_tsrb, BUFFER_SIZE / 2));
+
+    /* free space wraps: only the part up to the end is contiguous */
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE / 4, tsrb_reserve_contig(&_tsrb, &data));
+    TEST_ASSERT(data == &_tsrb_buffer[(3 * BUFFER_SIZE) / 4]);
+    tsrb_commit(&_tsrb, BUFFER_SIZE / 4);
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE / 2, tsrb_reserve_contig(&_tsrb, &data));
+    TEST_ASSERT(data == _tsrb_buffer);
+    tsrb_commit(&_tsrb, BUFFER_SIZE / 2);
+    TEST_ASSERT_EQUAL_INT(1, tsrb_full(&_tsrb));
+    TEST_ASSERT_EQUAL_INT(0, tsrb_reserve_contig(&_tsrb, &data));
+
+    /* readable data wraps as well */
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE / 2, tsrb_peek_contig(&_tsrb, &data));
+    TEST_ASSERT(data == &_tsrb_buffer[BUFFER_SIZE / 2]);
+}
+
 static Test *tests_tsrb_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -174,6 +229,8 @@ static Test *tests_tsrb_tests(void)
         new_TestFixture(test_drop),
         new_TestFixture(test_add_one),
         new_TestFixture(test_add),
+        new_TestFixture(test_wrap_around),
+        new_TestFixture(test_contig),
     };
 
     EMB_UNIT_TESTCALLER(tsrb_tests, NULL, tear_down, fixtures);
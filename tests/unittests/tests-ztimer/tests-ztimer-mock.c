@@ -249,6 +249,91 @@ static void test_ztimer_mock_set16(void)
     TEST_ASSERT_EQUAL_INT(0x100207d2, now);
 }
 
+/**
+ * @brief   Testing the time until the next timer triggers
+ */
+static void test_ztimer_mock_until_next(void)
+{
+    ztimer_mock_t zmock;
+    ztimer_clock_t *z = &zmock.super;
+
+    ztimer_mock_init(&zmock, 32);
+    TEST_ASSERT_EQUAL_INT(UINT32_MAX, ztimer_until_next(z));
+
+    uint32_t count = 0;
+    ztimer_t alarm1 = { .callback = cb_incr, .arg = &count, };
+    ztimer_t alarm2 = { .callback = cb_incr, .arg = &count, };
+    ztimer_set(z, &alarm1, 1000);
+    ztimer_set(z, &alarm2, 300);
+    TEST_ASSERT_EQUAL_INT(300, ztimer_until_next(z));
+    ztimer_mock_advance(&zmock, 100);
+    TEST_ASSERT_EQUAL_INT(200, ztimer_until_next(z));
+    ztimer_mock_advance(&zmock, 200);
+    TEST_ASSERT_EQUAL_INT(1, count);
+    TEST_ASSERT_EQUAL_INT(700, ztimer_until_next(z));
+    ztimer_remove(z, &alarm1);
+    TEST_ASSERT_EQUAL_INT(UINT32_MAX, ztimer_until_next(z));
+}
+
+/**
+ * @brief   Testing lazy timers joining the target of a set timer
+ */
+static void test_ztimer_mock_set_lazy(void)
+{
+    ztimer_mock_t zmock;
+    ztimer_clock_t *z = &zmock.super;
+
+    ztimer_mock_init(&zmock, 32);
+
+    uint32_t count = 0;
+    ztimer_t alarm1 = { .callback = cb_incr, .arg = &count, };
+    ztimer_t alarm2 = { .callback = cb_incr, .arg = &count, };
+    ztimer_t alarm3 = { .callback = cb_incr, .arg = &count, };
+    ztimer_set(z, &alarm1, 1000);
+    /* window reaches alarm1 */
+    ztimer_set_lazy(z, &alarm2, 900, 200);
+    TEST_ASSERT_EQUAL_INT(1000, ztimer_until_next(z));
+    /* window ends before alarm1 */
+    ztimer_set_lazy(z, &alarm3, 500, 100);
+    TEST_ASSERT_EQUAL_INT(500, ztimer_until_next(z));
+    ztimer_mock_advance(&zmock, 500);
+    TEST_ASSERT_EQUAL_INT(1, count);
+    ztimer_mock_advance(&zmock, 499);
+    TEST_ASSERT_EQUAL_INT(1, count);
+    ztimer_mock_advance(&zmock, 1);
+    TEST_ASSERT_EQUAL_INT(3, count);
+    TEST_ASSERT_EQUAL_INT(UINT32_MAX, ztimer_until_next(z));
+}
+
+/**
+ * @brief   Testing the time left until a timer triggers
+ */
+static void test_ztimer_mock_left(void)
+{
+    ztimer_mock_t zmock;
+    ztimer_clock_t *z = &zmock.super;
+
+    ztimer_mock_init(&zmock, 32);
+
+    uint32_t count = 0;
+    ztimer_t alarm1 = { .callback = cb_incr, .arg = &count, };
+    ztimer_t alarm2 = { .callback = cb_incr, .arg = &count, };
+    TEST_ASSERT_EQUAL_INT(0, ztimer_left(z, &alarm1));
+    ztimer_set(z, &alarm1, 1000);
+    ztimer_set(z, &alarm2, 300);
+    TEST_ASSERT_EQUAL_INT(1000, ztimer_left(z, &alarm1));
+    TEST_ASSERT_EQUAL_INT(300, ztimer_left(z, &alarm2));
+    ztimer_mock_advance(&zmock, 100);
+    TEST_ASSERT_EQUAL_INT(900, ztimer_left(z, &alarm1));
+    TEST_ASSERT_EQUAL_INT(200, ztimer_left(z, &alarm2));
+    ztimer_mock_advance(&zmock, 200);
+    TEST_ASSERT_EQUAL_INT(1, count);
+    TEST_ASSERT_EQUAL_INT(0, ztimer_left(z, &alarm2));
+    TEST_ASSERT_EQUAL_INT(700, ztimer_left(z, &alarm1));
+    ztimer_remove(z, &alarm1);
+    TEST_ASSERT_EQUAL_INT(0, ztimer_left(z, &alarm1));
+}
+
 Test *tests_ztimer_mock_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -258,6 +343,9 @@ Test *tests_ztimer_mock_tests(void)
         new_TestFixture(test_ztimer_mock_now3),
         new_TestFixture(test_ztimer_mock_set32),
         new_TestFixture(test_ztimer_mock_set16),
+        new_TestFixture(test_ztimer_mock_until_next),
+        new_TestFixture(test_ztimer_mock_set_lazy),
+        new_TestFixture(test_ztimer_mock_left),
     };
 
     EMB_UNIT_TESTCALLER(ztimer_tests, NULL, NULL, fixtures);
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the ztimer periodic timer
+ *
+ */
+
+#include "ztimer.h"
+#include "ztimer/mock.h"
+#include "ztimer/periodic.h"
+
+#include "embUnit/embUnit.h"
+
+#include "tests-ztimer.h"
+
+typedef struct {
+    unsigned count;
+    unsigned missed;
+    unsigned limit;
+    uint32_t at;
+} _state_t;
+
+static ztimer_mock_t zmock;
+
+static bool cb_count(void *arg, unsigned missed)
+{
+    _state_t *state = arg;
+
+    state->count++;
+    state->missed += missed;
+    state->at = ztimer_now(&zmock.super);
+    return state->count < state->limit;
+}
+
+/**
+ * @brief   Testing that the targets do not drift
+ */
+static void test_ztimer_periodic_drift(void)
+{
+    ztimer_periodic_t timer;
+    _state_t state = { .limit = UINT32_MAX };
+
+    ztimer_mock_init(&zmock, 32);
+    ztimer_mock_advance(&zmock, 123);
+    ztimer_periodic_init(&zmock.super, &timer, 1000, cb_count, &state);
+    ztimer_periodic_start_at(&timer, 100);
+    ztimer_mock_advance(&zmock, 976);
+    TEST_ASSERT_EQUAL_INT(0, state.count);
+    ztimer_mock_advance(&zmock, 1);
+    TEST_ASSERT_EQUAL_INT(1, state.count);
+    TEST_ASSERT_EQUAL_INT(1100, state.at);
+    for (unsigned i = 0; i < 10; i++) {
+        ztimer_mock_advance(&zmock, 1000);
+    }
+    TEST_ASSERT_EQUAL_INT(11, state.count);
+    TEST_ASSERT_EQUAL_INT(11100, state.at);
+    TEST_ASSERT_EQUAL_INT(0, state.missed);
+    ztimer_periodic_stop(&timer);
+    TEST_ASSERT_EQUAL_INT(UINT32_MAX, ztimer_until_next(&zmock.super));
+}
+
+/**
+ * @brief   Testing the report of missed periods
+ */
+static void test_ztimer_periodic_missed(void)
+{
+    ztimer_periodic_t timer;
+    _state_t state = { .limit = 3 };
+
+    ztimer_mock_init(&zmock, 32);
+    ztimer_periodic_init(&zmock.super, &timer, 100, cb_count, &state);
+    ztimer_periodic_start(&timer);
+    /* the timer triggers late, periods end at 200, 300 and 400 */
+    ztimer_mock_jump(&zmock, 450);
+    ztimer_mock_fire(&zmock);
+    TEST_ASSERT_EQUAL_INT(1, state.count);
+    TEST_ASSERT_EQUAL_INT(3, state.missed);
+    TEST_ASSERT_EQUAL_INT(3, timer.missed);
+    TEST_ASSERT_EQUAL_INT(50, ztimer_until_next(&zmock.super));
+    ztimer_mock_advance(&zmock, 50);
+    ztimer_mock_advance(&zmock, 100);
+    TEST_ASSERT_EQUAL_INT(3, state.count);
+    /* stopped by the callback */
+    TEST_ASSERT_EQUAL_INT(UINT32_MAX, ztimer_until_next(&zmock.super));
+}
+
+/**
+ * @brief   Testing that timers of the same period are aligned
+ */
+static void test_ztimer_periodic_align(void)
+{
+    ztimer_periodic_t timer1, timer2;
+    _state_t state1 = { .limit = UINT32_MAX };
+    _state_t state2 = { .limit = UINT32_MAX };
+
+    ztimer_mock_init(&zmock, 32);
+    ztimer_mock_advance(&zmock, 30);
+    ztimer_periodic_init(&zmock.super, &timer1, 100, cb_count, &state1);
+    ztimer_periodic_start(&timer1);
+    ztimer_mock_advance(&zmock, 40);
+    ztimer_periodic_init(&zmock.super, &timer2, 100, cb_count, &state2);
+    ztimer_periodic_start(&timer2);
+    TEST_ASSERT_EQUAL_INT(30, ztimer_until_next(&zmock.super));
+    ztimer_mock_advance(&zmock, 30);
+    TEST_ASSERT_EQUAL_INT(1, state1.count);
+    TEST_ASSERT_EQUAL_INT(1, state2.count);
+    ztimer_periodic_stop(&timer1);
+    ztimer_periodic_stop(&timer2);
+}
+
+Test *tests_ztimer_periodic_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_ztimer_periodic_drift),
+        new_TestFixture(test_ztimer_periodic_missed),
+        new_TestFixture(test_ztimer_periodic_align),
+    };
+
+    EMB_UNIT_TESTCALLER(ztimer_tests, NULL, NULL, fixtures);
+
+    return (Test *)&ztimer_tests;
+}
+
+/** @} */
@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2020 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the ztimer timing wheel
+ *
+ */
+
+#include "kernel_defines.h"
+#include "ztimer.h"
+#include "ztimer/mock.h"
+#include "ztimer/wheel.h"
+
+#include "embUnit/embUnit.h"
+
+#include "tests-ztimer.h"
+
+typedef struct {
+    ztimer_clock_t *clock;
+    ztimer_t timer;
+    uint32_t target;
+    uint32_t fired;
+    unsigned count;
+} _alarm_t;
+
+static ztimer_mock_t zmock;
+static ztimer_wheel_t wheel;
+
+static void cb_fired(void *arg)
+{
+    _alarm_t *alarm = arg;
+
+    alarm->fired = ztimer_now(alarm->clock);
+    alarm->count++;
+}
+
+static void _alarm_set(_alarm_t *alarm, uint32_t val)
+{
+    alarm->clock = &zmock.super;
+    alarm->timer.callback = cb_fired;
+    alarm->timer.arg = alarm;
+    alarm->target = ztimer_now(&zmock.super) + val;
+    ztimer_set(&zmock.super, &alarm->timer, val);
+}
+
+static void _init(unsigned width, uint32_t start)
+{
+    ztimer_mock_init(&zmock, width);
+    ztimer_mock_jump(&zmock, start);
+    ztimer_wheel_init(&zmock.super, &wheel);
+}
+
+/**
+ * @brief   Testing timers trigger at their exact target
+ */
+static void test_ztimer_wheel_order(void)
+{
+    static const uint32_t vals[] = {
+        5, 1, 16, 17, 15, 255, 256, 257, 4095, 4096, 70000, 1, 0, 65536, 99999,
+    };
+    _alarm_t alarms[ARRAY_SIZE(vals)] = { 0 };
+
+    _init(32, 0);
+    for (unsigned i = 0; i < ARRAY_SIZE(vals); i++) {
+        _alarm_set(&alarms[i], vals[i]);
+    }
+    ztimer_mock_advance(&zmock, 100000);
+    for (unsigned i = 0; i < ARRAY_SIZE(vals); i++) {
+        TEST_ASSERT_EQUAL_INT(1, alarms[i].count);
+        TEST_ASSERT_EQUAL_INT(alarms[i].target, alarms[i].fired);
+    }
+    /* timers set from within the wheel time keep working */
+    _alarm_set(&alarms[0], 3);
+    _alarm_set(&alarms[1], 300);
+    ztimer_mock_advance(&zmock, 299);
+    TEST_ASSERT_EQUAL_INT(2, alarms[0].count);
+    TEST_ASSERT_EQUAL_INT(alarms[0].target, alarms[0].fired);
+    TEST_ASSERT_EQUAL_INT(1, alarms[1].count);
+    ztimer_mock_advance(&zmock, 1);
+    TEST_ASSERT_EQUAL_INT(2, alarms[1].count);
+    TEST_ASSERT_EQUAL_INT(alarms[1].target, alarms[1].fired);
+    TEST_ASSERT_EQUAL_INT(0, zmock.armed);
+}
+
+/**
+ * @brief   Testing removing and re-setting timers
+ */
+static void test_ztimer_wheel_remove(void)
+{
+    _alarm_t alarms[3] = { 0 };
+
+    _init(32, 1234);
+    /* all in the same slot */
+    _alarm_set(&alarms[0], 1000);
+    _alarm_set(&alarms[1], 1000);
+    _alarm_set(&alarms[2], 1000);
+    ztimer_remove(&zmock.super, &alarms[1].timer);
+    /* removing a timer twice does nothing */
+    ztimer_remove(&zmock.super, &alarms[1].timer);
+    ztimer_mock_advance(&zmock, 500);
+    /* re-set to a later target */
+    _alarm_set(&alarms[2], 1000);
+    ztimer_mock_advance(&zmock, 500);
+    TEST_ASSERT_EQUAL_INT(1, alarms[0].count);
+    TEST_ASSERT_EQUAL_INT(0, alarms[1].count);
+    TEST_ASSERT_EQUAL_INT(0, alarms[2].count);
+    ztimer_remove(&zmock.super, &alarms[2].timer);
+    TEST_ASSERT_EQUAL_INT(0, zmock.armed);
+    ztimer_mock_advance(&zmock, 1000);
+    TEST_ASSERT_EQUAL_INT(0, alarms[2].count);
+}
+
+/**
+ * @brief   Testing timers crossing the 32 bit overflow
+ */
+static void test_ztimer_wheel_overflow(void)
+{
+    _alarm_t alarms[3] = { 0 };
+
+    _init(32, 0xfffffff0ul);
+    _alarm_set(&alarms[0], 0x20);
+    _alarm_set(&alarms[1], 0xffffff00ul);
+    _alarm_set(&alarms[2], UINT32_MAX);
+    ztimer_mock_advance(&zmock, 0x1f);
+    TEST_ASSERT_EQUAL_INT(0, alarms[0].count);
+    ztimer_mock_advance(&zmock, 0x1);
+    TEST_ASSERT_EQUAL_INT(1, alarms[0].count);
+    TEST_ASSERT_EQUAL_INT(0x10, alarms[0].fired);
+    ztimer_mock_advance(&zmock, 0xffffff00ul - 0x21);
+    TEST_ASSERT_EQUAL_INT(0, alarms[1].count);
+    ztimer_mock_advance(&zmock, 0x1);
+    TEST_ASSERT_EQUAL_INT(1, alarms[1].count);
+    TEST_ASSERT_EQUAL_INT(alarms[1].target, alarms[1].fired);
+    ztimer_mock_advance(&zmock, 0xfe);
+    TEST_ASSERT_EQUAL_INT(0, alarms[2].count);
+    ztimer_mock_advance(&zmock, 0x1);
+    TEST_ASSERT_EQUAL_INT(1, alarms[2].count);
+    TEST_ASSERT_EQUAL_INT(alarms[2].target, alarms[2].fired);
+}
+
+/**
+ * @brief   Testing the wheel on a 16 bit wide clock
+ */
+static void test_ztimer_wheel_extend16(void)
+{
+    _alarm_t alarms[2] = { 0 };
+
+    _init(16, 0);
+    _alarm_set(&alarms[0], 100000ul);
+    _alarm_set(&alarms[1], 0x10000000ul);
+    ztimer_mock_advance(&zmock, 99999ul);
+    TEST_ASSERT_EQUAL_INT(0, alarms[0].count);
+    ztimer_mock_advance(&zmock, 1);
+    TEST_ASSERT_EQUAL_INT(1, alarms[0].count);
+    TEST_ASSERT_EQUAL_INT(100000ul, alarms[0].fired);
+    ztimer_mock_advance(&zmock, 0x10000000ul - 100001ul);
+    TEST_ASSERT_EQUAL_INT(0, alarms[1].count);
+    ztimer_mock_advance(&zmock, 1);
+    TEST_ASSERT_EQUAL_INT(1, alarms[1].count);
+    TEST_ASSERT_EQUAL_INT(0x10000000ul, alarms[1].fired);
+}
+
+/**
+ * @brief   Testing the time until the next timer triggers
+ */
+static void test_ztimer_wheel_until_next(void)
+{
+    _alarm_t alarms[2] = { 0 };
+
+    _init(32, 0x1234);
+    TEST_ASSERT_EQUAL_INT(UINT32_MAX, ztimer_until_next(&zmock.super));
+    _alarm_set(&alarms[0], 70000);
+    _alarm_set(&alarms[1], 300);
+    TEST_ASSERT(ztimer_until_next(&zmock.super) <= 300);
+    ztimer_mock_advance(&zmock, 299);
+    TEST_ASSERT_EQUAL_INT(1, ztimer_until_next(&zmock.super));
+    ztimer_mock_advance(&zmock, 1);
+    TEST_ASSERT_EQUAL_INT(1, alarms[1].count);
+    TEST_ASSERT(ztimer_until_next(&zmock.super) <= 70000 - 300);
+    ztimer_remove(&zmock.super, &alarms[0].timer);
+    TEST_ASSERT_EQUAL_INT(UINT32_MAX, ztimer_until_next(&zmock.super));
+}
+
+Test *tests_ztimer_wheel_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_ztimer_wheel_order),
+        new_TestFixture(test_ztimer_wheel_remove),
+        new_TestFixture(test_ztimer_wheel_overflow),
+        new_TestFixture(test_ztimer_wheel_extend16),
+        new_TestFixture(test_ztimer_wheel_until_next),
+    };
+
+    EMB_UNIT_TESTCALLER(ztimer_tests, NULL, NULL, fixtures);
+
+    return (Test *)&ztimer_tests;
+}
+
+/** @} */
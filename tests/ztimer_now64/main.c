@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2021 ML!PA Consulting GmbH
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       Tests for 64 bit ztimer time and timers on mock clocks
+ *
+ * @author      ML!PA Consulting GmbH
+ */
+
+#include <stdint.h>
+
+#include "ztimer.h"
+#include "ztimer/mock.h"
+
+#include "embUnit.h"
+
+static ztimer_mock_t _zmock;
+static ztimer_clock_t *const _z = &_zmock.super;
+static unsigned _fired;
+
+static void _cb(void *arg)
+{
+    (void)arg;
+    _fired++;
+}
+
+static void _advance(uint64_t ticks)
+{
+    while (ticks) {
+        uint32_t step = (ticks > UINT32_MAX) ? UINT32_MAX : ticks;
+        ztimer_mock_advance(&_zmock, step);
+        ticks -= step;
+    }
+}
+
+static void set_up(void)
+{
+    _fired = 0;
+}
+
+static void test_ztimer_now64__16bit(void)
+{
+    ztimer_mock_init(&_zmock, 16);
+    TEST_ASSERT(ztimer_now(_z) == 0);
+
+    _advance(0x12345678);
+    TEST_ASSERT(ztimer_now(_z) == 0x12345678);
+
+    _advance(0xffffffff);
+    TEST_ASSERT(ztimer_now(_z) == 0x112345677ULL);
+}
+
+static void test_ztimer_now64__32bit(void)
+{
+    ztimer_mock_init(&_zmock, 32);
+
+    /* nothing reads the time in between, the intermediate timer keeps the
+     * checkpoint up to date */
+    _advance(0x3123456789ULL);
+    TEST_ASSERT(ztimer_now(_z) == 0x3123456789ULL);
+}
+
+static void test_ztimer_now64__checkpoint(void)
+{
+    ztimer_mock_init(&_zmock, 16);
+    ztimer_now(_z);
+    uint32_t seq = _z->seq;
+
+    /* reads within a quarter of the range leave the checkpoint alone */
+    _advance(0x3000);
+    TEST_ASSERT(ztimer_now(_z) == 0x3000);
+    TEST_ASSERT_EQUAL_INT(seq, _z->seq);
+
+    /* later reads take a new checkpoint, the sequence stays even */
+    _advance(0x1800);
+    TEST_ASSERT(ztimer_now(_z) == 0x4800);
+    TEST_ASSERT_EQUAL_INT(seq + 2, _z->seq);
+    TEST_ASSERT_EQUAL_INT(0x4800, _z->lower_last);
+    TEST_ASSERT(_z->checkpoint == 0x4800);
+}
+
+static void test_ztimer64_set(void)
+{
+    ztimer64_t t = { .callback = _cb };
+
+    ztimer_mock_init(&_zmock, 16);
+    _advance(0x1234);
+
+    ztimer64_set(_z, &t, 0x123456789ULL);
+    TEST_ASSERT(t.target == 0x123456789ULL + 0x1234);
+    _advance(0x123456788ULL);
+    TEST_ASSERT_EQUAL_INT(0, _fired);
+    _advance(1);
+    TEST_ASSERT_EQUAL_INT(1, _fired);
+    _advance(0x123456789ULL);
+    TEST_ASSERT_EQUAL_INT(1, _fired);
+}
+
+static void test_ztimer64_set_at(void)
+{
+    ztimer64_t t = { .callback = _cb };
+
+    ztimer_mock_init(&_zmock, 32);
+    _advance(0x100000000ULL);
+
+    ztimer64_set_at(_z, &t, 0x280000000ULL);
+    _advance(0x17fffffffULL);
+    TEST_ASSERT_EQUAL_INT(0, _fired);
+    _advance(1);
+    TEST_ASSERT_EQUAL_INT(1, _fired);
+    TEST_ASSERT(ztimer_now(_z) == 0x280000000ULL);
+
+    /* a target that passed already triggers right away */
+    ztimer64_set_at(_z, &t, 0x100000000ULL);
+    TEST_ASSERT(t.target == 0x280000000ULL);
+    _advance(1);
+    TEST_ASSERT_EQUAL_INT(2, _fired);
+}
+
+static void test_ztimer64_remove(void)
+{
+    ztimer64_t t = { .callback = _cb };
+
+    ztimer_mock_init(&_zmock, 16);
+
+    ztimer64_set(_z, &t, 0x20000);
+    _advance(0x10000);
+    ztimer64_remove(&t);
+    _advance(0x20000);
+    TEST_ASSERT_EQUAL_INT(0, _fired);
+}
+
+static Test *tests_ztimer_now64(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_ztimer_now64__16bit),
+        new_TestFixture(test_ztimer_now64__32bit),
+        new_TestFixture(test_ztimer_now64__checkpoint),
+        new_TestFixture(test_ztimer64_set),
+        new_TestFixture(test_ztimer64_set_at),
+        new_TestFixture(test_ztimer64_remove),
+    };
+
+    EMB_UNIT_TESTCALLER(ztimer_now64_tests, set_up, NULL, fixtures);
+
+    return (Test *)&ztimer_now64_tests;
+}
+
+int main(void)
+{
+    TESTS_START();
+    TESTS_RUN(tests_ztimer_now64());
+    TESTS_END();
+
+    return 0;
+}
+/** @} */